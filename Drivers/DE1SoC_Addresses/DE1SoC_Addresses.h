@@ -13,6 +13,7 @@
  *
  * Date       | Changes
  * -----------+--------------------------------------
+ * 14/10/2026 | Add HPS-to-FPGA bridge window sizes
  * 12/11/2024 | Update for 2024/25 Leeds SoC Computer
  * 10/02/2024 | Create Header
  */
@@ -26,6 +27,13 @@
 #define HPS_AXIMASTER_BASE ((uint32_t *)0xC0000000U)
 #define HPS_LWMASTER_BASE  ((uint32_t *)0xFF200000U)
 
+// HPS-to-FPGA Bridge Windows
+//  - The heavyweight (H2F) bridge is a 32/64/128-bit AXI master for bulk
+//    data, the lightweight (LW) bridge a 32-bit master for control registers.
+//  - See Util/fpga_bridge.h for bridge enable and burst copy helpers.
+#define HPS_AXIMASTER_SIZE 0x3C000000U   // 960MB (0xC0000000 to 0xFBFFFFFF)
+#define HPS_LWMASTER_SIZE  0x00200000U   // 2MB   (0xFF200000 to 0xFF3FFFFF)
+
 // List of Common Peripherals
 //      Peripheral             Base Address                   Description                                           Driver
 #define LSC_BASE_BOOTLDR_RAM   ((uint8_t  *)0x01000040U)   // ~16MB Reserved DDR RAM for bootloader
@@ -0,0 +1,339 @@
+/*
+ * WM8731 Zero-Copy Audio Processing Graph
+ * ---------------------------------------
+ * Description:
+ * Runs a graph of audio processing nodes on blocks from the WM8731 streaming mode
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_AudioGraph.h"
+#include "Util/mem_pool.h"
+
+#include <string.h>
+
+/*
+ * Internal Functions
+ */
+
+//Codec input node
+// - Converts the block acquired at the start of the pass.
+static HpsErr_t _AudioGraph_inputNode( AudioGraphCtx_t* graph, void* param, AudioBlock_t** in, unsigned int numIn, AudioBlock_t** out ) {
+    (void)param;
+    (void)in;
+    (void)numIn;
+    AudioBlock_t* block = AudioGraph_alloc(graph);
+    if (!block) return ERR_ALLOCFAIL;
+    DSP_fromCodecStereo((const uint32_t*)graph->inBlock, block->left, block->right, graph->blockSize);
+    *out = block;
+    return ERR_SUCCESS;
+}
+
+//Release the references still held for consumers of each node
+static void _AudioGraph_releaseAll( AudioGraphCtx_t* ctx ) {
+    for (unsigned int idx = 0; idx < ctx->numNodes; idx++) {
+        AudioGraphNode_t* node = &ctx->nodes[idx];
+        while (node->held) {
+            AudioGraph_release(ctx, node->out);
+            node->held--;
+        }
+        node->out = NULL;
+    }
+}
+
+//Make one pass of the graph
+// - On success, the output node's block (if any) is converted to outBlock.
+static HpsErr_t _AudioGraph_pass( AudioGraphCtx_t* ctx ) {
+    AudioBlock_t* in[AUDIOGRAPH_MAX_INPUTS];
+    HpsErr_t status = ERR_SUCCESS;
+    for (unsigned int idx = 0; idx < ctx->numNodes; idx++) {
+        AudioGraphNode_t* node = &ctx->nodes[idx];
+        //Hand over one reference to each input. Earlier nodes have already run.
+        for (unsigned int inIdx = 0; inIdx < node->numIn; inIdx++) {
+            AudioGraphNode_t* src = &ctx->nodes[node->in[inIdx]];
+            in[inIdx] = src->out;
+            src->held--;
+        }
+        AudioBlock_t* out = NULL;
+        status = node->func(ctx, node->param, in, node->numIn, &out);
+        //Anything not taken by the node is finished with
+        for (unsigned int inIdx = 0; inIdx < node->numIn; inIdx++) {
+            if (in[inIdx]) AudioGraph_release(ctx, in[inIdx]);
+        }
+        if (ERR_IS_SUCCESS(status) && !out && node->consumers) status = ERR_NULLPTR;
+        if (ERR_IS_ERROR(status)) {
+            if (out) AudioGraph_release(ctx, out);
+            break;
+        }
+        //One reference for each consumer this pass, or none if unused
+        node->out = out;
+        node->held = node->consumers;
+        if (!node->consumers) {
+            if (out) AudioGraph_release(ctx, out);
+        } else {
+            out->refs += node->consumers - 1;
+        }
+    }
+    //Convert the output block while its reference is still held
+    if (ERR_IS_SUCCESS(status) && (ctx->outputNode >= 0)) {
+        AudioBlock_t* block = ctx->nodes[ctx->outputNode].out;
+        DSP_toCodecStereo(block->left, block->right, (uint32_t*)ctx->outBlock, ctx->blockSize);
+    }
+    _AudioGraph_releaseAll(ctx);
+    return status;
+}
+
+//Cleanup
+static void _AudioGraph_cleanup( AudioGraphCtx_t* ctx ) {
+    MemPool_free(ctx->blocks);
+    MemPool_free(ctx->samples);
+    MemPool_free(ctx->inBlock);
+    MemPool_free(ctx->outBlock);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the graph
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE. Blocks are the same size as the streaming blocks.
+// - blockCount is the number of blocks in the pool. This must cover the
+//   most blocks alive at once in a pass, see AudioGraph_getPoolUsage().
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t AudioGraph_initialise( WM8731Ctx_t* audio, unsigned int blockCount, AudioGraphCtx_t** pCtx ) {
+    //Check if the audio codec has been initialised and is streaming (required)
+    if (!WM8731_isInitialised(audio)) return ERR_BADDEVICE;
+    if (!audio->streaming) return ERR_WRONGMODE;
+    if (!blockCount) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_AudioGraph_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    AudioGraphCtx_t* ctx = *pCtx;
+    ctx->audio = audio;
+    ctx->blockSize = audio->blockSize;
+    ctx->blockCount = blockCount;
+    //Allocate the pool and codec blocks
+    ctx->blocks   = MemPool_calloc(blockCount, sizeof(AudioBlock_t));
+    ctx->samples  = MemPool_malloc(blockCount * 2 * ctx->blockSize * sizeof(q31_t));
+    ctx->inBlock  = MemPool_malloc(ctx->blockSize * sizeof(WM8731Sample_t));
+    ctx->outBlock = MemPool_malloc(ctx->blockSize * sizeof(WM8731Sample_t));
+    if (!ctx->blocks || !ctx->samples || !ctx->inBlock || !ctx->outBlock) {
+        return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    }
+    //All blocks start on the free list
+    ctx->freeList = NULL;
+    for (unsigned int idx = blockCount; idx-- > 0;) {
+        AudioBlock_t* block = &ctx->blocks[idx];
+        block->left  = ctx->samples + (2 * idx * ctx->blockSize);
+        block->right = block->left + ctx->blockSize;
+        block->next  = ctx->freeList;
+        ctx->freeList = block;
+    }
+    ctx->inUse = 0;
+    ctx->peakInUse = 0;
+    ctx->numNodes = 0;
+    ctx->hasInput = false;
+    ctx->outputNode = -1;
+    ctx->outPending = false;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool AudioGraph_isInitialised( AudioGraphCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Add a node
+// - func is called each pass with param and the outputs of the numIn nodes
+//   listed in inputs. Inputs must already have been added.
+// - Returns the node number (>= 0), or ERR_NOSPACE if the graph is full.
+HpsErr_t AudioGraph_addNode( AudioGraphCtx_t* ctx, AudioGraphFunc_t func, void* param, const unsigned int* inputs, unsigned int numIn ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!func || (numIn && !inputs)) return ERR_NULLPTR;
+    if (numIn > AUDIOGRAPH_MAX_INPUTS) return ERR_TOOBIG;
+    if (ctx->numNodes >= AUDIOGRAPH_MAX_NODES) return ERR_NOSPACE;
+    //Inputs must run first
+    for (unsigned int inIdx = 0; inIdx < numIn; inIdx++) {
+        if (inputs[inIdx] >= ctx->numNodes) return ERR_NOTFOUND;
+    }
+    AudioGraphNode_t* node = &ctx->nodes[ctx->numNodes];
+    node->func = func;
+    node->param = param;
+    node->numIn = numIn;
+    node->consumers = 0;
+    node->out = NULL;
+    node->held = 0;
+    for (unsigned int inIdx = 0; inIdx < numIn; inIdx++) {
+        node->in[inIdx] = (unsigned char)inputs[inIdx];
+        ctx->nodes[inputs[inIdx]].consumers++;
+    }
+    return (HpsErr_t)(ctx->numNodes++);
+}
+
+//Add the codec input node
+// - Outputs each block acquired from the WM8731 ADC ring.
+// - Returns the node number (>= 0), or ERR_BUSY if already added.
+HpsErr_t AudioGraph_addInput( AudioGraphCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->hasInput) return ERR_BUSY;
+    status = AudioGraph_addNode(ctx, &_AudioGraph_inputNode, NULL, NULL, 0);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->hasInput = true;
+    return status;
+}
+
+//Select the codec output node
+// - The output of node is submitted to the WM8731 DAC ring each pass.
+// - Returns ERR_BUSY if an output has already been selected.
+HpsErr_t AudioGraph_setOutput( AudioGraphCtx_t* ctx, unsigned int node ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->outputNode >= 0) return ERR_BUSY;
+    if (node >= ctx->numNodes) return ERR_NOTFOUND;
+    //The output counts as a consumer so the block is kept until converted
+    ctx->nodes[node].consumers++;
+    ctx->outputNode = (int)node;
+    return ERR_SUCCESS;
+}
+
+//Run the graph
+// - Makes passes until no input block is available, or the DAC ring is full.
+//   If there is neither an input nor an output node, makes a single pass.
+// - Returns the number of passes made (>= 0), or an error code.
+HpsErr_t AudioGraph_process( AudioGraphCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    bool hasOutput = (ctx->outputNode >= 0);
+    unsigned int passes = 0;
+    do {
+        //A block which didn't fit last time goes first, so no audio is lost
+        if (ctx->outPending) {
+            status = WM8731_submitBlock(ctx->audio, ctx->outBlock);
+            if (status == ERR_NOSPACE) break;
+            if (ERR_IS_ERROR(status)) return status;
+            ctx->outPending = false;
+        }
+        //Wait for input before running anything, so sources stay in step
+        if (ctx->hasInput) {
+            status = WM8731_acquireBlock(ctx->audio, ctx->inBlock);
+            if (ERR_IS_RETRY(status)) break;
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        status = _AudioGraph_pass(ctx);
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->outPending = hasOutput;
+        passes++;
+    } while (ctx->hasInput || hasOutput);
+    return (HpsErr_t)passes;
+}
+
+//Get block pool usage
+// - inUse is the number of blocks currently allocated, peak the most
+//   allocated at once since initialisation. Either may be NULL.
+HpsErr_t AudioGraph_getPoolUsage( AudioGraphCtx_t* ctx, unsigned int* inUse, unsigned int* peak ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (inUse) *inUse = ctx->inUse;
+    if (peak) *peak = ctx->peakInUse;
+    return ERR_SUCCESS;
+}
+
+//Allocate a block from the pool
+// - The block contents are undefined. It has a single reference.
+// - Returns NULL if the pool is empty.
+AudioBlock_t* AudioGraph_alloc( AudioGraphCtx_t* ctx ) {
+    AudioBlock_t* block = ctx->freeList;
+    if (!block) return NULL;
+    ctx->freeList = block->next;
+    block->next = NULL;
+    block->refs = 1;
+    if (++ctx->inUse > ctx->peakInUse) ctx->peakInUse = ctx->inUse;
+    return block;
+}
+
+//Release a reference to a block
+// - The block returns to the pool when its last reference is released.
+void AudioGraph_release( AudioGraphCtx_t* ctx, AudioBlock_t* block ) {
+    if (!block || !block->refs) return;
+    if (--block->refs) return;
+    block->next = ctx->freeList;
+    ctx->freeList = block;
+    ctx->inUse--;
+}
+
+//Take an input block to modify
+// - slot is an entry in the in[] array passed to a node. The node's
+//   reference is transferred to the returned block, and *slot set to NULL.
+// - If no other node holds a reference the block itself is returned,
+//   otherwise a copy is made.
+// - Returns NULL if a copy was needed and the pool is empty.
+AudioBlock_t* AudioGraph_take( AudioGraphCtx_t* ctx, AudioBlock_t** slot ) {
+    AudioBlock_t* block = *slot;
+    if (!block) return NULL;
+    if (block->refs == 1) {
+        *slot = NULL;
+        return block;
+    }
+    //Shared, so copy on write
+    AudioBlock_t* copy = AudioGraph_alloc(ctx);
+    if (!copy) return NULL;
+    memcpy(copy->left, block->left, 2 * ctx->blockSize * sizeof(q31_t));
+    AudioGraph_release(ctx, block);
+    *slot = NULL;
+    return copy;
+}
+
+//Gain node
+// - Applies the AudioGraphGain_t passed as param to its one input, in place.
+HpsErr_t AudioGraph_gainNode( AudioGraphCtx_t* graph, void* param, AudioBlock_t** in, unsigned int numIn, AudioBlock_t** out ) {
+    AudioGraphGain_t* gain = (AudioGraphGain_t*)param;
+    if (!gain) return ERR_NULLPTR;
+    if (numIn != 1) return ERR_BADID;
+    AudioBlock_t* block = AudioGraph_take(graph, &in[0]);
+    if (!block) return ERR_ALLOCFAIL;
+    DSP_gainQ31(block->left,  block->left,  gain->left,  graph->blockSize);
+    DSP_gainQ31(block->right, block->right, gain->right, graph->blockSize);
+    *out = block;
+    return ERR_SUCCESS;
+}
+
+//Mixer node
+// - Sums its inputs, each scaled by a gain from the array of numIn
+//   q31_t passed as param, with saturation. The first input is mixed
+//   into in place.
+HpsErr_t AudioGraph_mixNode( AudioGraphCtx_t* graph, void* param, AudioBlock_t** in, unsigned int numIn, AudioBlock_t** out ) {
+    const q31_t* gains = (const q31_t*)param;
+    if (!gains) return ERR_NULLPTR;
+    if (!numIn) return ERR_BADID;
+    AudioBlock_t* mix = AudioGraph_take(graph, &in[0]);
+    if (!mix) return ERR_ALLOCFAIL;
+    DSP_gainQ31(mix->left,  mix->left,  gains[0], graph->blockSize);
+    DSP_gainQ31(mix->right, mix->right, gains[0], graph->blockSize);
+    for (unsigned int idx = 1; idx < numIn; idx++) {
+        DSP_macQ31(in[idx]->left,  gains[idx], mix->left,  graph->blockSize);
+        DSP_macQ31(in[idx]->right, gains[idx], mix->right, graph->blockSize);
+    }
+    *out = mix;
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,238 @@
+/*
+ * WM8731 Zero-Copy Audio Processing Graph
+ * ---------------------------------------
+ * Description:
+ * Runs a graph of audio processing nodes on blocks from the WM8731 streaming mode
+ *
+ * Each node (source, effect, mixer, analyser, ...) is a callback which
+ * is given the blocks output by its input nodes, and produces one block
+ * of its own. Rather than each stage copying samples into its own
+ * arrays, blocks are taken from a preallocated pool and are reference
+ * counted, so a block is passed along the graph by pointer:
+ *
+ *  - A node which only reads its inputs (e.g. a level meter) uses them
+ *    as they are, and may pass one through as its output with
+ *    AudioGraph_retain().
+ *  - A node which modifies an input (e.g. a gain or filter) calls
+ *    AudioGraph_take(). If no other node still needs the block, it is
+ *    handed over to be processed in place. Only if it is shared with a
+ *    node which has not yet run is a copy made.
+ *  - A node which generates samples (e.g. an oscillator) allocates a
+ *    new block with AudioGraph_alloc().
+ *
+ * So adding a stage which processes in place costs no extra copying.
+ * Blocks are returned to the pool when their last reference is released,
+ * which the graph does for each node's inputs and outputs once they have
+ * been used. Nodes which read a shared block should be added before
+ * nodes which modify it, so that the last user gets it without a copy.
+ *
+ * Blocks hold blockSize samples for each channel, as separate Q31 left
+ * and right arrays to suit the Util/dsp kernels.
+ *
+ * Codec Input and Output
+ * ----------------------
+ *
+ * The WM8731 driver must already be streaming. AudioGraph_addInput()
+ * adds a node which outputs each block acquired from the ADC ring, and
+ * AudioGraph_setOutput() selects the node whose output is submitted to
+ * the DAC ring. These are the only places samples are converted and
+ * copied. Call AudioGraph_process() regularly from the main loop:
+ *
+ *    WM8731_startStreaming(audio, IRQ_LSC_AUDIO, 64, 8);
+ *    AudioGraph_initialise(audio, 8, &graph);
+ *    HpsErr_t in   = AudioGraph_addInput(graph);
+ *    HpsErr_t fx   = AudioGraph_addNode(graph, &myFilterNode, &filter, (unsigned int[]){in}, 1);
+ *    HpsErr_t vol  = AudioGraph_addNode(graph, &AudioGraph_gainNode, &gain, (unsigned int[]){fx}, 1);
+ *    AudioGraph_setOutput(graph, vol);
+ *    while (1) {
+ *        AudioGraph_process(graph);
+ *        ...
+ *    }
+ *
+ * Each pass of the graph runs when an input block is available (if there
+ * is an input node) and the previous output block has been submitted (if
+ * there is an output node). A block which doesn't fit in the DAC ring is
+ * kept and submitted first next time, so no audio is lost.
+ *
+ * Nodes
+ * -----
+ *
+ *    HpsErr_t myNode(AudioGraphCtx_t* graph, void* param, AudioBlock_t** in, unsigned int numIn, AudioBlock_t** out);
+ *
+ * in[] holds the output of each input node, in the order given to
+ * AudioGraph_addNode(). The node must set *out to a block it owns (from
+ * AudioGraph_alloc(), AudioGraph_take() or AudioGraph_retain()), unless
+ * no other node uses its output, in which case it may leave it NULL.
+ * Returning an error stops the pass, and all blocks are released.
+ *
+ * Nodes are run in the order they are added, and may only use nodes
+ * added before them as inputs, so the graph can't contain loops.
+ *
+ * The graph is not thread safe, so must be used from one context. The
+ * WM8731 streaming interrupt has its own rings, so is unaffected.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_AUDIOGRAPH_H_
+#define DE1SOC_AUDIOGRAPH_H_
+
+//Include required header files
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "Util/driver_ctx.h"
+#include "Util/dsp.h"
+
+//Maximum number of nodes in a graph
+#ifndef AUDIOGRAPH_MAX_NODES
+#define AUDIOGRAPH_MAX_NODES  16
+#endif
+
+//Maximum number of inputs to each node
+#define AUDIOGRAPH_MAX_INPUTS 4
+
+// Pooled sample block
+typedef struct AudioBlock_s {
+    unsigned int refs;          // Number of owners, 0 if free
+    struct AudioBlock_s* next;  // Next free block
+    q31_t* left;                // blockSize samples per channel
+    q31_t* right;
+} AudioBlock_t;
+
+// Forward declaration of the context for the node callback
+typedef struct AudioGraphCtx_s AudioGraphCtx_t;
+
+// Node callback
+// - in holds the numIn input blocks, which are borrowed. Use AudioGraph_take()
+//   to modify one in place.
+// - *out is NULL on entry, and must be set to a block owned by the node if
+//   any other node uses its output.
+// - Returns an error code to stop the pass.
+typedef HpsErr_t (*AudioGraphFunc_t)(AudioGraphCtx_t* graph, void* param, AudioBlock_t** in, unsigned int numIn, AudioBlock_t** out);
+
+// Graph node
+typedef struct {
+    AudioGraphFunc_t func;
+    void* param;
+    unsigned int numIn;
+    unsigned char in[AUDIOGRAPH_MAX_INPUTS];    // Input node numbers
+    unsigned int consumers;     // Number of references to output needed each pass
+    AudioBlock_t* out;          // Output of current pass
+    unsigned int held;          // References to out still held for consumers
+} AudioGraphNode_t;
+
+// Per-channel gain for AudioGraph_gainNode (Q31)
+typedef struct {
+    q31_t left;
+    q31_t right;
+} AudioGraphGain_t;
+
+// Driver context
+struct AudioGraphCtx_s {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    WM8731Ctx_t* audio;
+    unsigned int blockSize;
+    // Block pool
+    unsigned int blockCount;
+    AudioBlock_t* blocks;
+    q31_t* samples;             // Storage for all blocks
+    AudioBlock_t* freeList;
+    unsigned int inUse;
+    unsigned int peakInUse;
+    // Nodes
+    unsigned int numNodes;
+    AudioGraphNode_t nodes[AUDIOGRAPH_MAX_NODES];
+    // Codec endpoints
+    bool hasInput;
+    int outputNode;             // -1 if none
+    WM8731Sample_t* inBlock;    // Block acquired from ADC ring
+    WM8731Sample_t* outBlock;   // Block to submit to DAC ring
+    bool outPending;            // outBlock is ready but the ring was full
+};
+
+//Initialise the graph
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE. Blocks are the same size as the streaming blocks.
+// - blockCount is the number of blocks in the pool. This must cover the
+//   most blocks alive at once in a pass, see AudioGraph_getPoolUsage().
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t AudioGraph_initialise( WM8731Ctx_t* audio, unsigned int blockCount, AudioGraphCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool AudioGraph_isInitialised( AudioGraphCtx_t* ctx );
+
+//Add a node
+// - func is called each pass with param and the outputs of the numIn nodes
+//   listed in inputs. Inputs must already have been added.
+// - Returns the node number (>= 0), or ERR_NOSPACE if the graph is full.
+HpsErr_t AudioGraph_addNode( AudioGraphCtx_t* ctx, AudioGraphFunc_t func, void* param, const unsigned int* inputs, unsigned int numIn );
+
+//Add the codec input node
+// - Outputs each block acquired from the WM8731 ADC ring.
+// - Returns the node number (>= 0), or ERR_BUSY if already added.
+HpsErr_t AudioGraph_addInput( AudioGraphCtx_t* ctx );
+
+//Select the codec output node
+// - The output of node is submitted to the WM8731 DAC ring each pass.
+// - Returns ERR_BUSY if an output has already been selected.
+HpsErr_t AudioGraph_setOutput( AudioGraphCtx_t* ctx, unsigned int node );
+
+//Run the graph
+// - Makes passes until no input block is available, or the DAC ring is full.
+//   If there is neither an input nor an output node, makes a single pass.
+// - Returns the number of passes made (>= 0), or an error code.
+HpsErr_t AudioGraph_process( AudioGraphCtx_t* ctx );
+
+//Get block pool usage
+// - inUse is the number of blocks currently allocated, peak the most
+//   allocated at once since initialisation. Either may be NULL.
+HpsErr_t AudioGraph_getPoolUsage( AudioGraphCtx_t* ctx, unsigned int* inUse, unsigned int* peak );
+
+//Allocate a block from the pool
+// - The block contents are undefined. It has a single reference.
+// - Returns NULL if the pool is empty.
+AudioBlock_t* AudioGraph_alloc( AudioGraphCtx_t* ctx );
+
+//Add a reference to a block
+// - e.g. for a node to pass an input straight through as its output.
+// - Returns block.
+static inline AudioBlock_t* AudioGraph_retain( AudioBlock_t* block ) {
+    block->refs++;
+    return block;
+}
+
+//Release a reference to a block
+// - The block returns to the pool when its last reference is released.
+void AudioGraph_release( AudioGraphCtx_t* ctx, AudioBlock_t* block );
+
+//Take an input block to modify
+// - slot is an entry in the in[] array passed to a node. The node's
+//   reference is transferred to the returned block, and *slot set to NULL.
+// - If no other node holds a reference the block itself is returned,
+//   otherwise a copy is made.
+// - Returns NULL if a copy was needed and the pool is empty.
+AudioBlock_t* AudioGraph_take( AudioGraphCtx_t* ctx, AudioBlock_t** slot );
+
+//Gain node
+// - Applies the AudioGraphGain_t passed as param to its one input, in place.
+HpsErr_t AudioGraph_gainNode( AudioGraphCtx_t* graph, void* param, AudioBlock_t** in, unsigned int numIn, AudioBlock_t** out );
+
+//Mixer node
+// - Sums its inputs, each scaled by a gain from the array of numIn
+//   q31_t passed as param, with saturation. The first input is mixed
+//   into in place.
+HpsErr_t AudioGraph_mixNode( AudioGraphCtx_t* graph, void* param, AudioBlock_t** in, unsigned int numIn, AudioBlock_t** out );
+
+#endif /* DE1SOC_AUDIOGRAPH_H_ */
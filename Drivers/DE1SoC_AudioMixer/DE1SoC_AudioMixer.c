@@ -0,0 +1,194 @@
+/*
+ * WM8731 Multi-Voice Audio Mixer
+ * ------------------------------
+ * Description:
+ * Mixes several audio sources into blocks for the WM8731 streaming mode
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_AudioMixer.h"
+#include "Util/mem_pool.h"
+
+#include <string.h>
+
+/*
+ * Internal Functions
+ */
+
+//Calculate the channel gains of a voice
+// - Balance law, so a centred voice plays at full gain in both channels,
+//   and panning turns down the opposite channel.
+static void _AudioMix_setGain( AudioMixVoice_t* voice, q15_t gain, q15_t pan ) {
+    int32_t left  = (pan > 0) ? (INT16_MAX - pan) : INT16_MAX;
+    int32_t right = (pan < 0) ? (INT16_MAX + pan) : INT16_MAX;
+    if (right < 0) right = 0;
+    //Q15 * Q15 is Q30, so one more shift for Q31
+    voice->gainLeft  = (q31_t)(((int32_t)gain * left ) * 2);
+    voice->gainRight = (q31_t)(((int32_t)gain * right) * 2);
+}
+
+//Mix one block from all active voices
+static void _AudioMix_mixBlock( AudioMixCtx_t* ctx ) {
+    unsigned int count = ctx->blockSize;
+    memset(ctx->mixLeft,  0, count * sizeof(q31_t));
+    memset(ctx->mixRight, 0, count * sizeof(q31_t));
+    for (unsigned int idx = 0; idx < ctx->maxVoices; idx++) {
+        AudioMixVoice_t* voice = &ctx->voices[idx];
+        if (!voice->source) continue;
+        q31_t* srcRight = voice->stereo ? ctx->srcRight : NULL;
+        HpsErr_t status = voice->source(voice->param, ctx->srcLeft, srcRight, count);
+        unsigned int filled = ERR_IS_ERROR(status) ? 0 : (unsigned int)status;
+        if (filled > count) filled = count;
+        if (filled < count) {
+            //Source has ended, so this is its last block
+            voice->source = NULL;
+            if (!filled) continue;
+        }
+        //Mono sources feed both channels
+        DSP_macQ31(ctx->srcLeft, voice->gainLeft, ctx->mixLeft, filled);
+        DSP_macQ31(srcRight ? srcRight : ctx->srcLeft, voice->gainRight, ctx->mixRight, filled);
+    }
+    DSP_toCodecStereo(ctx->mixLeft, ctx->mixRight, (uint32_t*)ctx->block, count);
+}
+
+//Cleanup
+static void _AudioMix_cleanup( AudioMixCtx_t* ctx ) {
+    MemPool_free(ctx->voices);
+    MemPool_free(ctx->mixLeft);
+    MemPool_free(ctx->mixRight);
+    MemPool_free(ctx->srcLeft);
+    MemPool_free(ctx->srcRight);
+    MemPool_free(ctx->block);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the mixer
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE. Blocks are the same size as the streaming blocks.
+// - maxVoices is the number of voices which can be active at once.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t AudioMix_initialise( WM8731Ctx_t* audio, unsigned int maxVoices, AudioMixCtx_t** pCtx ) {
+    //Check if the audio codec has been initialised and is streaming (required)
+    if (!WM8731_isInitialised(audio)) return ERR_BADDEVICE;
+    if (!audio->streaming) return ERR_WRONGMODE;
+    if (!maxVoices) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_AudioMix_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    AudioMixCtx_t* ctx = *pCtx;
+    ctx->audio = audio;
+    ctx->blockSize = audio->blockSize;
+    ctx->maxVoices = maxVoices;
+    //Allocate voices and working buffers
+    ctx->voices   = MemPool_calloc(maxVoices, sizeof(AudioMixVoice_t));
+    ctx->mixLeft  = MemPool_malloc(ctx->blockSize * sizeof(q31_t));
+    ctx->mixRight = MemPool_malloc(ctx->blockSize * sizeof(q31_t));
+    ctx->srcLeft  = MemPool_malloc(ctx->blockSize * sizeof(q31_t));
+    ctx->srcRight = MemPool_malloc(ctx->blockSize * sizeof(q31_t));
+    ctx->block    = MemPool_malloc(ctx->blockSize * sizeof(WM8731Sample_t));
+    if (!ctx->voices || !ctx->mixLeft || !ctx->mixRight || !ctx->srcLeft || !ctx->srcRight || !ctx->block) {
+        return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    }
+    ctx->blockPending = false;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool AudioMix_isInitialised( AudioMixCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Add a voice
+// - source is called for each block, with param. stereo indicates whether
+//   the source fills both channels.
+// - gain is the voice level (Q15), pan from AUDIOMIX_PAN_LEFT to AUDIOMIX_PAN_RIGHT.
+// - Returns the voice number (>= 0), or ERR_NOSPACE if all voices are in use.
+HpsErr_t AudioMix_addVoice( AudioMixCtx_t* ctx, AudioMixSource_t source, void* param, bool stereo, q15_t gain, q15_t pan ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!source) return ERR_NULLPTR;
+    //Find a free voice
+    for (unsigned int idx = 0; idx < ctx->maxVoices; idx++) {
+        AudioMixVoice_t* voice = &ctx->voices[idx];
+        if (voice->source) continue;
+        voice->param = param;
+        voice->stereo = stereo;
+        _AudioMix_setGain(voice, gain, pan);
+        voice->source = source;
+        return (HpsErr_t)idx;
+    }
+    return ERR_NOSPACE;
+}
+
+//Change the gain and pan of a voice
+// - Takes effect from the next block.
+// - Returns ERR_NOTFOUND if the voice is not active.
+HpsErr_t AudioMix_setVoice( AudioMixCtx_t* ctx, unsigned int voice, q15_t gain, q15_t pan ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((voice >= ctx->maxVoices) || !ctx->voices[voice].source) return ERR_NOTFOUND;
+    _AudioMix_setGain(&ctx->voices[voice], gain, pan);
+    return ERR_SUCCESS;
+}
+
+//Remove a voice
+// - Returns ERR_NOTFOUND if the voice is not active.
+HpsErr_t AudioMix_removeVoice( AudioMixCtx_t* ctx, unsigned int voice ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((voice >= ctx->maxVoices) || !ctx->voices[voice].source) return ERR_NOTFOUND;
+    ctx->voices[voice].source = NULL;
+    return ERR_SUCCESS;
+}
+
+//Mix and submit blocks
+// - Submits blocks to the WM8731 ring buffer until it is full.
+// - Returns the number of blocks submitted (>= 0), or an error code.
+HpsErr_t AudioMix_process( AudioMixCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int submitted = 0;
+    while (true) {
+        //A block which didn't fit last time goes first, so no audio is lost
+        if (!ctx->blockPending) {
+            _AudioMix_mixBlock(ctx);
+            ctx->blockPending = true;
+        }
+        status = WM8731_submitBlock(ctx->audio, ctx->block);
+        if (status == ERR_NOSPACE) break;
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->blockPending = false;
+        submitted++;
+    }
+    return (HpsErr_t)submitted;
+}
+
+//Oscillator source
+// - Mono source for a DspNco_t oscillator, passed as param.
+HpsErr_t AudioMix_ncoSource( void* param, q31_t* left, q31_t* right, unsigned int count ) {
+    (void)right;
+    if (!param) return ERR_NULLPTR;
+    DSP_ncoQ31((DspNco_t*)param, left, count);
+    return (HpsErr_t)count;
+}
@@ -0,0 +1,139 @@
+/*
+ * WM8731 Multi-Voice Audio Mixer
+ * ------------------------------
+ * Description:
+ * Mixes several audio sources into blocks for the WM8731 streaming mode
+ *
+ * Writing each sample of each voice with WM8731_writeSample() does not
+ * scale past a couple of voices. Instead, the mixer pulls a block of
+ * samples from each active source, applies the voice gain and pan,
+ * and accumulates it into a stereo mix with saturation (DSP_macQ31,
+ * which uses NEON where available). The mix is then converted to the
+ * codec format and passed to WM8731_submitBlock().
+ *
+ * Sources
+ * -------
+ *
+ * A source is a callback which fills a block of Q31 samples, e.g. from
+ * an oscillator, a WAV file being streamed from the SD card, or a
+ * sound effect in memory:
+ *
+ *    HpsErr_t wavSource(void* param, q31_t* left, q31_t* right, unsigned int count);
+ *
+ * Mono sources fill only left (right is NULL). The callback returns the
+ * number of samples it wrote. If fewer than count, the rest of the block
+ * is silent and the voice is removed, as it is if an error is returned.
+ * AudioMix_ncoSource() is a source for a DspNco_t oscillator (Util/dsp.h).
+ *
+ * Usage
+ * -----
+ *
+ * The WM8731 driver must already be streaming. Call AudioMix_process()
+ * regularly from the main loop. It mixes and submits blocks until the
+ * codec ring buffer is full:
+ *
+ *    WM8731_startStreaming(audio, IRQ_LSC_AUDIO, 64, 8);
+ *    AudioMix_initialise(audio, 8, &mixer);
+ *    DSP_ncoInit(&tone, 440, 48000, INT32_MAX / 4);
+ *    AudioMix_addVoice(mixer, &AudioMix_ncoSource, &tone, false, AUDIOMIX_GAIN_UNITY, AUDIOMIX_PAN_CENTRE);
+ *    while (1) {
+ *        AudioMix_process(mixer);
+ *        ...
+ *    }
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_AUDIOMIXER_H_
+#define DE1SOC_AUDIOMIXER_H_
+
+//Include required header files
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "Util/driver_ctx.h"
+#include "Util/dsp.h"
+
+//Gain and pan values (Q15)
+#define AUDIOMIX_GAIN_UNITY   INT16_MAX
+#define AUDIOMIX_PAN_LEFT     INT16_MIN
+#define AUDIOMIX_PAN_CENTRE   0
+#define AUDIOMIX_PAN_RIGHT    INT16_MAX
+
+// Source callback
+// - Fills left (and right, if not NULL) with up to count samples.
+// - Returns the number of samples written, or an error code.
+typedef HpsErr_t (*AudioMixSource_t)(void* param, q31_t* left, q31_t* right, unsigned int count);
+
+// Mixer voice
+typedef struct {
+    AudioMixSource_t source;    // NULL if voice is free
+    void* param;
+    bool stereo;
+    q31_t gainLeft;
+    q31_t gainRight;
+} AudioMixVoice_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    WM8731Ctx_t* audio;
+    unsigned int blockSize;
+    unsigned int maxVoices;
+    AudioMixVoice_t* voices;
+    // Working buffers of blockSize samples
+    q31_t* mixLeft;
+    q31_t* mixRight;
+    q31_t* srcLeft;
+    q31_t* srcRight;
+    WM8731Sample_t* block;
+    bool blockPending;          // block is mixed but the ring was full
+} AudioMixCtx_t;
+
+//Initialise the mixer
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE. Blocks are the same size as the streaming blocks.
+// - maxVoices is the number of voices which can be active at once.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t AudioMix_initialise( WM8731Ctx_t* audio, unsigned int maxVoices, AudioMixCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool AudioMix_isInitialised( AudioMixCtx_t* ctx );
+
+//Add a voice
+// - source is called for each block, with param. stereo indicates whether
+//   the source fills both channels.
+// - gain is the voice level (Q15), pan from AUDIOMIX_PAN_LEFT to AUDIOMIX_PAN_RIGHT.
+// - Returns the voice number (>= 0), or ERR_NOSPACE if all voices are in use.
+HpsErr_t AudioMix_addVoice( AudioMixCtx_t* ctx, AudioMixSource_t source, void* param, bool stereo, q15_t gain, q15_t pan );
+
+//Change the gain and pan of a voice
+// - Takes effect from the next block.
+// - Returns ERR_NOTFOUND if the voice is not active.
+HpsErr_t AudioMix_setVoice( AudioMixCtx_t* ctx, unsigned int voice, q15_t gain, q15_t pan );
+
+//Remove a voice
+// - Returns ERR_NOTFOUND if the voice is not active.
+HpsErr_t AudioMix_removeVoice( AudioMixCtx_t* ctx, unsigned int voice );
+
+//Mix and submit blocks
+// - Submits blocks to the WM8731 ring buffer until it is full.
+// - Returns the number of blocks submitted (>= 0), or an error code.
+HpsErr_t AudioMix_process( AudioMixCtx_t* ctx );
+
+//Oscillator source
+// - Mono source for a DspNco_t oscillator, passed as param.
+HpsErr_t AudioMix_ncoSource( void* param, q31_t* left, q31_t* right, unsigned int count );
+
+#endif /* DE1SOC_AUDIOMIXER_H_ */
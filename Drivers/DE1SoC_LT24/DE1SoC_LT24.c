@@ -42,6 +42,18 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add DMA solid fills from a fixed source
+ * 14/10/2026 | Add shared buffer descriptor DMA copy
+ * 14/10/2026 | Add hardware rotation and mirroring
+ * 14/10/2026 | Add colour streaming into current window
+ * 14/10/2026 | Add tearing effect synchronised DMA copies
+ * 14/10/2026 | Add hardware vertical scrolling
+ * 14/10/2026 | Add burst command table writes
+ * 14/10/2026 | Add non-blocking initialisation steps
+ * 14/10/2026 | Use GPIO fast path for control pins if available
+ * 14/10/2026 | Add rectangle and line fills. Faster clear and copy in hwOpt mode
+ * 14/10/2026 | Add pixel streaming into current window
+ * 14/10/2026 | Add DMA frame buffer copy for hardware optimised mode
  * 21/11/2024 | Use external GPIO instance
  * 31/01/2024 | Update to new driver contexts
  * 20/10/2017 | Update driver to match new styles
@@ -54,6 +66,8 @@
 #include "Util/watchdog.h"
 #include "Util/delay.h"
 #include "Util/bit_helpers.h"
+#include "Util/dma_buffer.h"
+#include "Util/lowlevel_arm.h"
 
 //
 // Useful Defines
@@ -74,105 +88,111 @@
 #define LT24_DEDCMD  (0x00/sizeof(unsigned short))
 #define LT24_DEDDATA (0x02/sizeof(unsigned short))
 
+//Memory Access Control (MADCTL) bits
+#define LT24_MADCTL_MY  0x0080 //Row address order
+#define LT24_MADCTL_MX  0x0040 //Column address order
+#define LT24_MADCTL_MV  0x0020 //Row/column exchange
+#define LT24_MADCTL_BGR 0x0008 //BGR colour filter panel
+
 //Display Initialisation Data
 //You don't need to worry about what all these registers are.
 //The LT24 LCDs are complicated things with many settings that need
 //to be configured - Contrast/Brightness/Data Format/etc.
-#define LT24_INIT_DATA_LEN (sizeof(LT24_initData)/sizeof(LT24_initData[0]))
-unsigned short LT24_initData [][2] = {
-   //isDat, value
-    {false, 0x00EF}, //Undocumented write sequence!
-    {true , 0x0003},
-    {true , 0x0080},
-    {true , 0x0002},
-    {false, 0x00CF}, //Power control B
-    {true , 0x0000},
-    {true , 0x0081},
-    {true , 0x00C0},
-    {false, 0x00ED}, //Power on sequence control
-    {true , 0x0064},
-    {true , 0x0003},
-    {true , 0x0012},
-    {true , 0x0081},
-    {false, 0x00E8}, //Driver timing control A
-    {true , 0x0085},
-    {true , 0x0001},
-    {true , 0x0078},
-    {false, 0x00CB}, //Power controlA
-    {true , 0x0039},
-    {true , 0x002C},
-    {true , 0x0000},
-    {true , 0x0034},
-    {true , 0x0002},
-    {false, 0x00F7}, //Pump ratio control
-    {true , 0x0020},
-    {false, 0x00EA}, //Driver timing control B
-    {true , 0x0000}, //NOP
-    {true , 0x0000}, //NOP
-    {false, 0x00C0}, //Power control 1
-    {true , 0x0023}, //  VRH[5:0]
-    {false, 0x00C1}, //Power control 2
-    {true , 0x0010}, //  SAP[2:0];BT[3:0]
-    {false, 0x00C5}, //VCOM Control 1
-    {true , 0x003E},
-    {true , 0x0028},
-    {false, 0x00C7}, //VCOM Control 2
-    {true , 0x0086},
-    {false, 0x0036}, //Memory Access Control (MADCTL)
-    {true , 0x0048},
-    {false, 0x003A}, //Pixel Format Set
-    {true , 0x0055}, //  16 bit RGB Interface, 16 bit MCU
-    {false, 0x00B1}, //Frame Control
-    {true , 0x0000}, //  No-clock oscillator division
-    {true , 0x001B}, //  27 clock/line, 70 Hz default
-    {false, 0x00B6}, //Display Function Control
-    {true , 0x0008}, //  Non-Display Area Inaccessible
-    {true , 0x0082}, //  Normally White, Normal Scan Direction (A2 = Reverse Scan Direction)
-    {true , 0x0027}, //  320 Lines
-    {false, 0x00F2}, //3-Gamma Function Disable
-    {true , 0x0000},
-    {false, 0x0026}, //Gamma curve selected
-    {true , 0x0001},
-    {false, 0x00E0}, //Positive Gamma Correction
-    {true , 0x000F},
-    {true , 0x0031},
-    {true , 0x002B},
-    {true , 0x000C},
-    {true , 0x000E},
-    {true , 0x0008},
-    {true , 0x004E},
-    {true , 0x00F1},
-    {true , 0x0037},
-    {true , 0x0007},
-    {true , 0x0010},
-    {true , 0x0003},
-    {true , 0x000E},
-    {true , 0x0009},
-    {true , 0x0000},
-    {false, 0x00E1}, //Negative Gamma Correction
-    {true , 0x0000},
-    {true , 0x000E},
-    {true , 0x0014},
-    {true , 0x0003},
-    {true , 0x0011},
-    {true , 0x0007},
-    {true , 0x0031},
-    {true , 0x00C1},
-    {true , 0x0048},
-    {true , 0x0008},
-    {true , 0x000F},
-    {true , 0x000C},
-    {true , 0x0031},
-    {true , 0x0036},
-    {true , 0x000f},
-    {false, 0x00B1}, //Frame Rate
-    {true , 0x0000},
-    {true , 0x0001},
-    {false, 0x00F6}, //Interface Control
-    {true , 0x0001},
-    {true , 0x0010},
-    {true , 0x0000},
-    {false, 0x0011}, //Disable Internal Sleep
+#define LT24_INIT_CMDS_LEN (sizeof(LT24_initCmds)/sizeof(LT24_initCmds[0]))
+static const unsigned short LT24_initCmds [] = {
+   //LT24_COMMAND(command, parameter count), parameters...
+    LT24_COMMAND(0x00EF,  3), //Undocumented write sequence!
+        0x0003,
+        0x0080,
+        0x0002,
+    LT24_COMMAND(0x00CF,  3), //Power control B
+        0x0000,
+        0x0081,
+        0x00C0,
+    LT24_COMMAND(0x00ED,  4), //Power on sequence control
+        0x0064,
+        0x0003,
+        0x0012,
+        0x0081,
+    LT24_COMMAND(0x00E8,  3), //Driver timing control A
+        0x0085,
+        0x0001,
+        0x0078,
+    LT24_COMMAND(0x00CB,  5), //Power controlA
+        0x0039,
+        0x002C,
+        0x0000,
+        0x0034,
+        0x0002,
+    LT24_COMMAND(0x00F7,  1), //Pump ratio control
+        0x0020,
+    LT24_COMMAND(0x00EA,  2), //Driver timing control B
+        0x0000, //NOP
+        0x0000, //NOP
+    LT24_COMMAND(0x00C0,  1), //Power control 1
+        0x0023, //  VRH[5:0]
+    LT24_COMMAND(0x00C1,  1), //Power control 2
+        0x0010, //  SAP[2:0];BT[3:0]
+    LT24_COMMAND(0x00C5,  2), //VCOM Control 1
+        0x003E,
+        0x0028,
+    LT24_COMMAND(0x00C7,  1), //VCOM Control 2
+        0x0086,
+    LT24_COMMAND(0x0036,  1), //Memory Access Control (MADCTL)
+        LT24_MADCTL_BGR | LT24_MADCTL_MX, //  Portrait
+    LT24_COMMAND(0x003A,  1), //Pixel Format Set
+        0x0055, //  16 bit RGB Interface, 16 bit MCU
+    LT24_COMMAND(0x00B1,  2), //Frame Control
+        0x0000, //  No-clock oscillator division
+        0x001B, //  27 clock/line, 70 Hz default
+    LT24_COMMAND(0x00B6,  3), //Display Function Control
+        0x0008, //  Non-Display Area Inaccessible
+        0x0082, //  Normally White, Normal Scan Direction (A2 = Reverse Scan Direction)
+        0x0027, //  320 Lines
+    LT24_COMMAND(0x00F2,  1), //3-Gamma Function Disable
+        0x0000,
+    LT24_COMMAND(0x0026,  1), //Gamma curve selected
+        0x0001,
+    LT24_COMMAND(0x00E0, 15), //Positive Gamma Correction
+        0x000F,
+        0x0031,
+        0x002B,
+        0x000C,
+        0x000E,
+        0x0008,
+        0x004E,
+        0x00F1,
+        0x0037,
+        0x0007,
+        0x0010,
+        0x0003,
+        0x000E,
+        0x0009,
+        0x0000,
+    LT24_COMMAND(0x00E1, 15), //Negative Gamma Correction
+        0x0000,
+        0x000E,
+        0x0014,
+        0x0003,
+        0x0011,
+        0x0007,
+        0x0031,
+        0x00C1,
+        0x0048,
+        0x0008,
+        0x000F,
+        0x000C,
+        0x0031,
+        0x0036,
+        0x000f,
+    LT24_COMMAND(0x00B1,  2), //Frame Rate
+        0x0000,
+        0x0001,
+    LT24_COMMAND(0x00F6,  3), //Interface Control
+        0x0001,
+        0x0010,
+        0x0000,
+    LT24_COMMAND(0x0011,  0), //Disable Internal Sleep
 };
 
 /*
@@ -199,6 +219,12 @@ static HpsErr_t _LT24_write( LT24Ctx_t* ctx, bool isData, unsigned short value )
             //For command we don't set the RS bit
             regVal |= LT24_RDn;
         }
+        if (ctx->fast) {
+            //Fast path, the GPIO was validated when we were initialised
+            GPIO_fastWrite(ctx->fast, regVal, LT24_CMDDATMASK);
+            GPIO_fastWrite(ctx->fast, regVal | LT24_WRn, LT24_CMDDATMASK);
+            return ERR_SUCCESS;
+        }
         //Write to the PIO controller, changing only the command and data bits
         HpsErr_t status = GPIO_setOutput(ctx->cntrl, regVal, LT24_CMDDATMASK);
         if (ERR_IS_ERROR(status)) return status;
@@ -209,6 +235,115 @@ static HpsErr_t _LT24_write( LT24Ctx_t* ctx, bool isData, unsigned short value )
     }
 }
 
+//Internal function to write the same pixel colour many times
+// - Window must have been configured first.
+static HpsErr_t _LT24_fillPixels( LT24Ctx_t* ctx, unsigned short colour, unsigned int count ) {
+    if (ctx->hwOpt) {
+        // Use data interface in hwOpt mode, unrolled to reduce loop overhead
+        volatile unsigned short* port = &ctx->hwOpt[LT24_DEDDATA];
+        while (count >= 16) {
+            *port = colour; *port = colour; *port = colour; *port = colour;
+            *port = colour; *port = colour; *port = colour; *port = colour;
+            *port = colour; *port = colour; *port = colour; *port = colour;
+            *port = colour; *port = colour; *port = colour; *port = colour;
+            count -= 16;
+        }
+        while (count--) {
+            *port = colour;
+        }
+        return ERR_SUCCESS;
+    } else {
+        //Register values are the same for every pixel, so only build once
+        unsigned int regVal = colour | LT24_RS | LT24_RDn;
+        if (ctx->fast) {
+            while (count--) {
+                GPIO_fastWrite(ctx->fast, regVal, LT24_CMDDATMASK);
+                GPIO_fastWrite(ctx->fast, regVal | LT24_WRn, LT24_CMDDATMASK);
+            }
+            return ERR_SUCCESS;
+        }
+        while (count--) {
+            HpsErr_t status = GPIO_setOutput(ctx->cntrl, regVal, LT24_CMDDATMASK);
+            if (ERR_IS_ERROR(status)) return status;
+            status = GPIO_setOutput(ctx->cntrl, regVal | LT24_WRn, LT24_CMDDATMASK);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        return ERR_SUCCESS;
+    }
+}
+
+//Internal function to write an array of pixels
+// - Window must have been configured first.
+static HpsErr_t _LT24_writePixels( LT24Ctx_t* ctx, const unsigned short* pixels, unsigned int count ) {
+    if (ctx->hwOpt) {
+        // Use data interface in hwOpt mode. Same unrolled copy as for Soft DMA.
+        LT24_softDmaCopy((void*)&ctx->hwOpt[LT24_DEDDATA], (void*)pixels, count * sizeof(*pixels), NULL);
+        return ERR_SUCCESS;
+    } else {
+        while (count--) {
+            HpsErr_t status = _LT24_write(ctx, true, *pixels++);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        return ERR_SUCCESS;
+    }
+}
+
+//Internal function to write a command table
+// - See LT24_writeCommands() for the table format. Table must have been checked.
+// - In hwOpt mode the parameters of each command are sent as a burst
+//   to the data port.
+static HpsErr_t _LT24_writeCommands( LT24Ctx_t* ctx, const unsigned short* table, unsigned int len ) {
+    unsigned int idx = 0;
+    while (idx < len) {
+        unsigned short command = table[idx++];
+        unsigned int count = table[idx++];
+        if (ctx->hwOpt) {
+            ctx->hwOpt[LT24_DEDCMD] = command;
+            LT24_softDmaCopy((void*)&ctx->hwOpt[LT24_DEDDATA], (void*)&table[idx], count * sizeof(*table), NULL);
+        } else {
+            HpsErr_t status = _LT24_write(ctx, false, command);
+            if (ERR_IS_ERROR(status)) return status;
+            status = _LT24_writePixels(ctx, &table[idx], count);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        idx += count;
+    }
+    return ERR_SUCCESS;
+}
+
+//Check a command table is complete
+// - Returns ERR_BEYONDEND if any command has fewer parameters than its count.
+static HpsErr_t _LT24_checkCommands( const unsigned short* table, unsigned int len ) {
+    unsigned int idx = 0;
+    while (idx < len) {
+        if ((len - idx) < 2) return ERR_BEYONDEND;
+        unsigned int count = table[idx + 1];
+        idx += 2;
+        if ((len - idx) < count) return ERR_BEYONDEND;
+        idx += count;
+    }
+    return ERR_SUCCESS;
+}
+
+//Check whether any DMA frame buffer copy has completed
+// - Returns ERR_SUCCESS if no DMA running, or ERR_BUSY if still running
+static HpsErr_t _LT24_dmaCheckDone( LT24Ctx_t* ctx ) {
+    //Copies waiting for tearing effect are as good as running
+    if (ctx->teCopy.pending) return ERR_BUSY;
+    if (!ctx->dma) return ERR_SUCCESS;
+    HpsErr_t status;
+    if (ctx->dmaBuf) {
+        status = BufDesc_transferDone(ctx->dma, ctx->dmaBuf, BUF_DEVICE_READS);
+    } else {
+        status = DmaBuffer_transferDone(ctx->dma, &ctx->dmaXfer);
+    }
+    if (status == ERR_BUSY) return ERR_BUSY;
+    //Done (or failed). Either way the transfer is no longer ours.
+    ctx->dma = NULL;
+    ctx->dmaBuf = NULL;
+    return ERR_IS_ERROR(status) ? status : ERR_SUCCESS;
+}
+
 //Internal function to generate Red/Green corner of test pattern
 static HpsErr_t _LT24_redGreen( LT24Ctx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
     HpsErr_t status;
@@ -306,6 +441,15 @@ static HpsErr_t _LT24_powerConfig( LT24Ctx_t* ctx, bool isOn ) {
 
 // Cleanup function called when driver destroyed.
 static void _LT24_cleanup( LT24Ctx_t* ctx ) {
+    // Drop any copy waiting for tearing effect
+    ctx->teCopy.pending = false;
+    if (ctx->dma) {
+        // Stop any running frame buffer copy
+        DMA_abortTransfer(ctx->dma, DMA_ABORT_FORCE);
+        if (ctx->dmaBuf) BufDesc_release(ctx->dmaBuf);
+        ctx->dma = NULL;
+        ctx->dmaBuf = NULL;
+    }
     if (ctx->cntrl) {
         // Turn off LCD
         _LT24_write(ctx, false, 0x0028);
@@ -317,13 +461,13 @@ static void _LT24_cleanup( LT24Ctx_t* ctx ) {
  * User Facing APIs
  */
 
-//Function to initialise the LCD
-//  - cntrl is a GPIO instance used to configure the control pins for the LT24.
-//  - dataBase if non-NULL indicates using hardware optimised mode. Must be base
-//    address of the optimised data transfer buffer
+//Start initialising the LCD without waiting
+//  - As LT24_initialise(), but only configures the control pins. The context
+//    is not initialised until LT24_initialiseStep() returns ERR_SUCCESS.
+//  - For use with Util/init_seq to power up several drivers at once.
 //  - Returns Util/error Code
 //  - Returns context pointer to *ctx
-HpsErr_t LT24_initialise( GpioCtx_t* cntrl, void* dataBase, LT24Ctx_t** pCtx ) {
+HpsErr_t LT24_initialiseStart( GpioCtx_t* cntrl, void* dataBase, LT24Ctx_t** pCtx ) {
     //Control GPIO must be valid and initialised
     if (!GPIO_isInitialised(cntrl)) return ERR_BADDEVICE;
     //Optimised data address must be integer aligned (NULL is allowed)
@@ -334,6 +478,8 @@ HpsErr_t LT24_initialise( GpioCtx_t* cntrl, void* dataBase, LT24Ctx_t** pCtx ) {
     //Save base address pointers
     LT24Ctx_t* ctx = *pCtx;
     ctx->cntrl = cntrl;
+    ctx->fast  = GPIO_getFast(cntrl);
+    if (ctx->fast && !ctx->fast->out) ctx->fast = NULL;
     ctx->hwOpt  = (unsigned short*)dataBase;
     
     //Initialise LCD PIO direction. All data/cmd bits are outputs
@@ -343,30 +489,78 @@ HpsErr_t LT24_initialise( GpioCtx_t* cntrl, void* dataBase, LT24Ctx_t** pCtx ) {
     //to idle. Set the HW opt bit if enabled.
     GPIO_setOutput(ctx->cntrl, (LT24_CSn | LT24_WRn | LT24_RDn | LT24_HW_OPT(ctx->hwOpt != NULL)), LT24_PIOMASK);
     
-    //LCD requires specific reset sequence:
-    _LT24_powerConfig(ctx, true);  //turn on for 1ms
-    usleep(1000);
-    _LT24_powerConfig(ctx, false); //then off for 10ms
-    usleep(10000);
-    _LT24_powerConfig(ctx, true);  //finally back on and wait 120ms for LCD to power on
-    usleep(120000);
+    //Nothing queued for tearing effect
+    ctx->teCopy.pending = false;
     
-    //Upload Initialisation Data
-    for (unsigned int idx = 0; idx < LT24_INIT_DATA_LEN; idx++) {
-        _LT24_write(ctx, LT24_initData[idx][0], LT24_initData[idx][1]);
-    }
-    
-    //Allow 120ms time for LCD to wake up
-    usleep(120000);
+    //Initialisation table sets native portrait orientation
+    ctx->orientation = LT24_PORTRAIT;
+    ctx->mirror = false;
+    ctx->width  = LT24_WIDTH;
+    ctx->height = LT24_HEIGHT;
     
-    //Turn on display drivers
-    _LT24_write(ctx, false, 0x0029);
+    //Reset sequence is done by the init steps
+    ctx->initStage = LT24_INIT_POWERON;
+    return ERR_SUCCESS;
+}
 
-    //Mark as initialised so later functions know we are ready
-    DriverContextSetInit(ctx);
-    
-    //And clear the display
-    return LT24_clearDisplay(ctx, LT24_BLACK);
+//Make the next step of LCD initialisation
+//  - ctx must have been returned by LT24_initialiseStart().
+//  - Returns ERR_AGAIN if more steps are needed, with the number of microseconds
+//    to wait before the next in *delay.
+//  - Returns ERR_SUCCESS once initialised and the display cleared.
+HpsErr_t LT24_initialiseStep( LT24Ctx_t* ctx, unsigned int* delay ) {
+    if (!ctx || !delay) return ERR_NULLPTR;
+    if (DriverContextCheckInit(ctx)) return ERR_SUCCESS;
+    //LCD requires specific reset sequence:
+    switch (ctx->initStage) {
+        case LT24_INIT_POWERON:
+            _LT24_powerConfig(ctx, true);  //turn on for 1ms
+            *delay = 1000;
+            break;
+        case LT24_INIT_RESET:
+            _LT24_powerConfig(ctx, false); //then off for 10ms
+            *delay = 10000;
+            break;
+        case LT24_INIT_WAKE:
+            _LT24_powerConfig(ctx, true);  //finally back on and wait 120ms for LCD to power on
+            *delay = 120000;
+            break;
+        case LT24_INIT_UPLOAD:
+            //Upload Initialisation Data
+            _LT24_writeCommands(ctx, LT24_initCmds, LT24_INIT_CMDS_LEN);
+            //Allow 120ms time for LCD to wake up
+            *delay = 120000;
+            break;
+        default:
+            //Turn on display drivers
+            _LT24_write(ctx, false, 0x0029);
+            //Mark as initialised so later functions know we are ready
+            DriverContextSetInit(ctx);
+            //And clear the display
+            return LT24_clearDisplay(ctx, LT24_BLACK);
+    }
+    ctx->initStage++;
+    return ERR_AGAIN;
+}
+
+//Function to initialise the LCD
+//  - cntrl is a GPIO instance used to configure the control pins for the LT24.
+//  - dataBase if non-NULL indicates using hardware optimised mode. Must be base
+//    address of the optimised data transfer buffer
+//  - Waits around 250ms for the LCD to power up. See LT24_initialiseStart() to
+//    initialise without waiting.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t LT24_initialise( GpioCtx_t* cntrl, void* dataBase, LT24Ctx_t** pCtx ) {
+    HpsErr_t status = LT24_initialiseStart(cntrl, dataBase, pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Run the init steps, sleeping for each delay
+    do {
+        unsigned int delay = 0;
+        status = LT24_initialiseStep(*pCtx, &delay);
+        if (ERR_IS_RETRY(status) && delay) usleep(delay);
+    } while (ERR_IS_RETRY(status));
+    return status;
 }
 
 //Check if driver initialised
@@ -379,10 +573,38 @@ HpsErr_t LT24_write( LT24Ctx_t* ctx, bool isData, unsigned short value ) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    //Can't write while a DMA copy is running
+    status = _LT24_dmaCheckDone(ctx);
+    if (ERR_IS_ERROR(status)) return status;
     //Then perform write
     return _LT24_write(ctx, isData, value);
 }
 
+//Write a table of commands and their parameters
+// - table is len words made up of LT24_COMMAND(command, count) followed
+//   by count parameter words, for as many commands as needed. e.g.:
+//       const unsigned short gamma[] = {
+//           LT24_COMMAND(0x0026, 1), 0x0002  //Gamma curve 2
+//       };
+// - In hardware optimised mode the parameters are written as a burst.
+// - Fast enough for register changes (gamma, scrolling, etc.) between frames.
+// - Use LT24_setOrientation() to rotate rather than writing MADCTL directly,
+//   so that the window limits are kept up to date.
+// - Returns ERR_BEYONDEND if the last command is missing parameters. Nothing is written.
+HpsErr_t LT24_writeCommands( LT24Ctx_t* ctx, const unsigned short* table, unsigned int len ) {
+    if (!table && len) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't write while a DMA copy is running
+    status = _LT24_dmaCheckDone(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check the whole table before writing any of it
+    status = _LT24_checkCommands(table, len);
+    if (ERR_IS_ERROR(status)) return status;
+    return _LT24_writeCommands(ctx, table, len);
+}
+
 //Function for configuring LCD reset/power (using PIO)
 //You must check LT24_isInitialised() before calling this function
 HpsErr_t LT24_powerConfig( LT24Ctx_t* ctx, bool isOn ) {
@@ -397,14 +619,14 @@ HpsErr_t LT24_powerConfig( LT24Ctx_t* ctx, bool isOn ) {
 // - Returns true if successful
 HpsErr_t LT24_clearDisplay( LT24Ctx_t* ctx, unsigned short colour) {
     ResetWDT();
-    //Define window as entire display (LT24_setWindow will check if we are initialised).
-    HpsErr_t status = LT24_setWindow(ctx, 0, 0, LT24_WIDTH, LT24_HEIGHT);
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    //Loop through each pixel in the window writing the required colour
-    for(unsigned int idx=0; idx<(LT24_WIDTH*LT24_HEIGHT); idx++) {
-        _LT24_write(ctx, true, colour);
-    }
-    return ERR_SUCCESS;
+    //Define window as entire display
+    status = LT24_setWindow(ctx, 0, 0, ctx->width, ctx->height);
+    if (ERR_IS_ERROR(status)) return status;
+    //Write the required colour to every pixel in the window
+    return _LT24_fillPixels(ctx, colour, ctx->width * ctx->height);
 }
 
 //Function to convert Red/Green/Blue to RGB565 encoded colour value 
@@ -419,50 +641,97 @@ unsigned short LT24_makeColour( unsigned int R, unsigned int G, unsigned int B )
     return colour;
 }
 
+//Set the display orientation
+// - Rotates the mapping of window coordinates onto the panel. If mirror
+//   is true, the display is also flipped left to right.
+// - Content already on the display is not moved, so redraw afterwards.
+// - Returns ERR_OUTRANGE if orientation is not a valid LT24Orientation.
+HpsErr_t LT24_setOrientation( LT24Ctx_t* ctx, LT24Orientation orientation, bool mirror ) {
+    //MADCTL value for each orientation
+    static const unsigned short madctl[LT24_ORIENTATION_COUNT] = {
+        [LT24_PORTRAIT         ] = LT24_MADCTL_BGR | LT24_MADCTL_MX,
+        [LT24_LANDSCAPE        ] = LT24_MADCTL_BGR | LT24_MADCTL_MV,
+        [LT24_PORTRAIT_FLIPPED ] = LT24_MADCTL_BGR | LT24_MADCTL_MY,
+        [LT24_LANDSCAPE_FLIPPED] = LT24_MADCTL_BGR | LT24_MADCTL_MV | LT24_MADCTL_MX | LT24_MADCTL_MY
+    };
+    if ((unsigned int)orientation >= LT24_ORIENTATION_COUNT) return ERR_OUTRANGE;
+    bool landscape = (orientation == LT24_LANDSCAPE) || (orientation == LT24_LANDSCAPE_FLIPPED);
+    //Window x runs along panel columns in portrait, but along rows once exchanged
+    unsigned short value = madctl[orientation];
+    if (mirror) value ^= landscape ? LT24_MADCTL_MY : LT24_MADCTL_MX;
+    const unsigned short rotate[] = {
+        LT24_COMMAND(0x0036, 1), value
+    };
+    //writeCommands validates context and checks for running DMA for us
+    HpsErr_t status = LT24_writeCommands(ctx, rotate, sizeof(rotate)/sizeof(rotate[0]));
+    if (ERR_IS_ERROR(status)) return status;
+    //Windows now use the rotated size
+    ctx->orientation = orientation;
+    ctx->mirror = mirror;
+    ctx->width  = landscape ? LT24_HEIGHT : LT24_WIDTH;
+    ctx->height = landscape ? LT24_WIDTH  : LT24_HEIGHT;
+    return ERR_SUCCESS;
+}
+
+//Get the display size for the current orientation
+// - Returns the width and height windows must fit within via *width and *height.
+HpsErr_t LT24_getSize( LT24Ctx_t* ctx, unsigned int* width, unsigned int* height ) {
+    if (!width || !height) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    *width  = ctx->width;
+    *height = ctx->height;
+    return ERR_SUCCESS;
+}
+
 //Function to set the drawing window on the display
 //  Returns 0 if successful
 HpsErr_t LT24_setWindow( LT24Ctx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    //Can't change window while a DMA copy is running
+    status = _LT24_dmaCheckDone(ctx);
+    if (ERR_IS_ERROR(status)) return status;
     //Calculate bottom right corner location
     unsigned int xright = xleft + width - 1;
     unsigned int ybottom = ytop + height - 1;
     //Ensure end coordinates are in range
-    if (xright >= LT24_WIDTH)   return LT24_INVALIDSIZE; //Invalid size
-    if (ybottom >= LT24_HEIGHT) return LT24_INVALIDSIZE; //Invalid size
+    if (xright >= ctx->width)   return LT24_INVALIDSIZE; //Invalid size
+    if (ybottom >= ctx->height) return LT24_INVALIDSIZE; //Invalid size
     //Ensure start coordinates are in range (top left must be <= bottom right)
     if (xleft > xright) return LT24_INVALIDSHAPE; //Invalid shape
     if (ytop > ybottom) return LT24_INVALIDSHAPE; //Invalid shape
-    //Define the left and right of the display
-    _LT24_write(ctx, false, 0x002A);
-    _LT24_write(ctx, true , (xleft >> 8) & 0xFF);
-    _LT24_write(ctx, true , xleft & 0xFF);
-    _LT24_write(ctx, true , (xright >> 8) & 0xFF);
-    _LT24_write(ctx, true , xright & 0xFF);
-    //Define the top and bottom of the display
-    _LT24_write(ctx, false, 0x002B);
-    _LT24_write(ctx, true , (ytop >> 8) & 0xFF);
-    _LT24_write(ctx, true , ytop & 0xFF);
-    _LT24_write(ctx, true , (ybottom >> 8) & 0xFF);
-    _LT24_write(ctx, true , ybottom & 0xFF);
-    //Create window and prepare for data
-    _LT24_write(ctx, false, 0x002c);
-    return ERR_SUCCESS;
+    const unsigned short window[] = {
+        //Define the left and right of the display
+        LT24_COMMAND(0x002A, 4),
+            (xleft >> 8) & 0xFF, xleft & 0xFF, (xright >> 8) & 0xFF, xright & 0xFF,
+        //Define the top and bottom of the display
+        LT24_COMMAND(0x002B, 4),
+            (ytop >> 8) & 0xFF, ytop & 0xFF, (ybottom >> 8) & 0xFF, ybottom & 0xFF,
+        //Create window and prepare for data
+        LT24_COMMAND(0x002C, 0)
+    };
+    return _LT24_writeCommands(ctx, window, sizeof(window)/sizeof(window[0]));
 }
 
 //Generates test pattern on display
 // - returns 0 if successful
 HpsErr_t LT24_testPattern( LT24Ctx_t* ctx ) {
-    //Generate different test pattern for each corner of the display (test pattern funtion will validate ctx)
-    HpsErr_t status;
-    status = _LT24_redGreen  ( ctx,            0,            0,LT24_WIDTH/2,LT24_HEIGHT/2 );
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Generate different test pattern for each corner of the display
+    unsigned int halfW = ctx->width / 2;
+    unsigned int halfH = ctx->height / 2;
+    status = _LT24_redGreen  ( ctx,     0,     0, halfW, halfH );
     if (ERR_IS_ERROR(status)) return status;
-    status = _LT24_greenBlue ( ctx,            0,LT24_HEIGHT/2,LT24_WIDTH/2,LT24_HEIGHT/2 );
+    status = _LT24_greenBlue ( ctx,     0, halfH, halfW, halfH );
     if (ERR_IS_ERROR(status)) return status;
-    status = _LT24_blueRed   ( ctx, LT24_WIDTH/2,            0,LT24_WIDTH/2,LT24_HEIGHT/2 );
+    status = _LT24_blueRed   ( ctx, halfW,     0, halfW, halfH );
     if (ERR_IS_ERROR(status)) return status;
-    status = _LT24_colourBars( ctx, LT24_WIDTH/2,LT24_HEIGHT/2,LT24_WIDTH/2,LT24_HEIGHT/2 );
+    status = _LT24_colourBars( ctx, halfW, halfH, halfW, halfH );
     return status;
 }
 
@@ -473,13 +742,277 @@ HpsErr_t LT24_copyFrameBuffer( LT24Ctx_t* ctx, const unsigned short* framebuffer
     HpsErr_t status = LT24_setWindow(ctx, xleft, ytop, width, height);
     if (ERR_IS_ERROR(status)) return status;
     //And copy the required number of pixels
-    unsigned int cnt = (height * width);
-    while (cnt--) {
-        _LT24_write(ctx, true, *framebuffer++);
+    return _LT24_writePixels(ctx, framebuffer, height * width);
+}
+
+//Stream pixels into the current window
+// - Writes count pixels from the pixels array to the display.
+// - Must be preceded by LT24_setWindow(). Multiple calls can be used to
+//   fill a single window, e.g. one call per row of a larger frame buffer.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_streamPixels( LT24Ctx_t* ctx, const unsigned short* pixels, unsigned int count ) {
+    if (!pixels) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't write while a DMA copy is running
+    status = _LT24_dmaCheckDone(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //And copy the required number of pixels
+    return _LT24_writePixels(ctx, pixels, count);
+}
+
+//Stream a single colour into the current window
+// - Writes count pixels of colour to the display.
+// - Must be preceded by LT24_setWindow(). Can be mixed with LT24_streamPixels()
+//   to fill a window, e.g. when decoding run-length encoded images.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_streamColour( LT24Ctx_t* ctx, unsigned short colour, unsigned int count ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't write while a DMA copy is running
+    status = _LT24_dmaCheckDone(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //And fill the required number of pixels
+    return _LT24_fillPixels(ctx, colour, count);
+}
+
+//Start a DMA frame buffer copy
+// - desc is the shared descriptor for framebuffer, or NULL for a plain buffer.
+static HpsErr_t _LT24_copyFrameBufferDma( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, const unsigned short* framebuffer, BufDesc_t* desc, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    if (!DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    //Define Window (setWindow validates context and checks for running DMA for us)
+    HpsErr_t status = LT24_setWindow(ctx, xleft, ytop, width, height);
+    if (ERR_IS_ERROR(status)) return status;
+    //DMA only possible to dedicated data port
+    if (!ctx->hwOpt) return ERR_NOSUPPORT;
+    //Stream all pixels into the fixed data register
+    ctx->dmaXfer.readAddr  = (uintptr_t)framebuffer;
+    ctx->dmaXfer.writeAddr = (uintptr_t)&ctx->hwOpt[LT24_DEDDATA];
+    ctx->dmaXfer.length    = (height * width) * sizeof(*framebuffer);
+    ctx->dmaXfer.isLast    = true;
+    ctx->dmaXfer.index     = 0;
+    ctx->dmaXfer.params    = dmaParams;
+    if (desc) {
+        status = BufDesc_setupTransfer(dma, &ctx->dmaXfer, desc, BUF_DEVICE_READS, true);
+    } else {
+        status = DmaBuffer_setupTransfer(dma, &ctx->dmaXfer, true);
     }
+    //Keep track of the controller so we know when it is done
+    if (ERR_IS_SUCCESS(status)) {
+        ctx->dma = dma;
+        ctx->dmaBuf = desc;
+    }
+    return status;
+}
+
+//Copy frame buffer to display using DMA
+// - Requires hardware optimised mode (returns ERR_NOSUPPORT otherwise).
+// - dma is the DMA controller to use. The transfer writes 16-bit pixels
+//   to a fixed (non-incrementing) data register address:
+//    - For HPS_DMAController, pass dmaParams with destType set to
+//      HPS_DMA_DESTINATION_REGISTER and transferWidth to HPS_DMA_BURSTSIZE_2BYTE.
+//    - For Soft_DMAController, initialise with SOFT_DMA_WORDSIZE_16BIT and
+//      LT24_softDmaCopy as the copy function, and pass dmaParams as NULL.
+// - Returns immediately once the transfer is started. The framebuffer must
+//   remain valid until LT24_copyFrameBufferDone() returns success.
+// - Source cache maintenance is handled automatically (Util/dma_buffer.h).
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous DMA copy is still running.
+// - Other LT24 APIs will return ERR_BUSY while the DMA copy is running.
+HpsErr_t LT24_copyFrameBufferDma( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, const unsigned short* framebuffer, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    if (!framebuffer) return ERR_NULLPTR;
+    return _LT24_copyFrameBufferDma(ctx, dma, dmaParams, framebuffer, NULL, xleft, ytop, width, height);
+}
+
+//Copy a shared frame buffer to display using DMA
+// - As LT24_copyFrameBufferDma(), but the frame buffer is a shared
+//   descriptor (Util/buf_desc.h), which must hold at least width*height
+//   pixels. A reference is held until the copy is done, so the caller
+//   may release it straight away.
+// - Source cleaning is skipped if the frame was drawn by another DMA.
+// - Returns ERR_TOOSMALL if the descriptor is too short for the window.
+HpsErr_t LT24_copyFrameBufferDmaBuf( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, BufDesc_t* framebuffer, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    if (!framebuffer || !framebuffer->data) return ERR_NULLPTR;
+    if (framebuffer->length < (height * width) * sizeof(unsigned short)) return ERR_TOOSMALL;
+    return _LT24_copyFrameBufferDma(ctx, dma, dmaParams, (const unsigned short*)framebuffer->data, framebuffer, xleft, ytop, width, height);
+}
+
+//Enable or disable the tearing effect output
+// - When enabled the panel TE output pulses at the start of each
+//   vertical blanking period.
+HpsErr_t LT24_setTearingEffect( LT24Ctx_t* ctx, bool enable ) {
+    const unsigned short teOn[] = {
+        //Tearing Effect Line ON (TEON), V-blanking only
+        LT24_COMMAND(0x0035, 1), 0x0000
+    };
+    const unsigned short teOff[] = {
+        //Tearing Effect Line OFF (TEOFF)
+        LT24_COMMAND(0x0034, 0)
+    };
+    //writeCommands validates context for us
+    if (enable) {
+        return LT24_writeCommands(ctx, teOn, sizeof(teOn)/sizeof(teOn[0]));
+    } else {
+        return LT24_writeCommands(ctx, teOff, sizeof(teOff)/sizeof(teOff[0]));
+    }
+}
+
+//Queue a DMA frame buffer copy for the next tearing effect edge
+// - As LT24_copyFrameBufferDma(), but the window is set and the transfer
+//   started by LT24_tearingEdge(), so that it begins in vertical blanking.
+// - LT24_copyFrameBufferDone() and other LT24 APIs return ERR_BUSY from when
+//   queued until the copy is complete.
+// - Returns ERR_BUSY if a previous copy is queued or still running.
+HpsErr_t LT24_copyFrameBufferDmaSync( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, const unsigned short* framebuffer, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    if (!framebuffer) return ERR_NULLPTR;
+    if (!DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //DMA only possible to dedicated data port
+    if (!ctx->hwOpt) return ERR_NOSUPPORT;
+    //Can't queue while another copy is queued or running
+    status = _LT24_dmaCheckDone(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check the window now, so that errors are seen by the caller
+    if (!width || !height) return LT24_INVALIDSHAPE;
+    if ((xleft >= ctx->width) || (width > (ctx->width - xleft))) return LT24_INVALIDSIZE;
+    if ((ytop >= ctx->height) || (height > (ctx->height - ytop))) return LT24_INVALIDSIZE;
+    //Then queue for the edge. Pending is set last as the edge handler may run at any time.
+    ctx->teCopy.dma = dma;
+    ctx->teCopy.dmaParams = dmaParams;
+    ctx->teCopy.framebuffer = framebuffer;
+    ctx->teCopy.xleft = xleft;
+    ctx->teCopy.ytop = ytop;
+    ctx->teCopy.width = width;
+    ctx->teCopy.height = height;
+    __DMB();
+    ctx->teCopy.pending = true;
     return ERR_SUCCESS;
 }
 
+//Fill a rectangle on the display using DMA
+// - Requires hardware optimised mode (returns ERR_NOSUPPORT otherwise).
+// - The transfer reads the same 16-bit colour from a fixed source address,
+//   and writes it to the fixed data register, so neither address increments:
+//    - For HPS_DMAController, pass dmaParams with srcType set to
+//      HPS_DMA_SOURCE_REGISTER, destType to HPS_DMA_DESTINATION_REGISTER
+//      and transferWidth to HPS_DMA_BURSTSIZE_2BYTE.
+//    - For Soft_DMAController, initialise with SOFT_DMA_WORDSIZE_16BIT and
+//      LT24_softDmaFill as the copy function with the LT24 context as
+//      copyFuncCtx, and pass dmaParams as NULL.
+// - Returns immediately once the transfer is started. Check for completion
+//   with LT24_copyFrameBufferDone().
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous DMA copy or fill is still running.
+HpsErr_t LT24_fillRectDma( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, unsigned short colour, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    if (!DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    //Define Window (setWindow validates context and checks for running DMA for us)
+    HpsErr_t status = LT24_setWindow(ctx, xleft, ytop, width, height);
+    if (ERR_IS_ERROR(status)) return status;
+    //DMA only possible to dedicated data port
+    if (!ctx->hwOpt) return ERR_NOSUPPORT;
+    //Only the source word needs to be visible to the controller. The
+    //whole length is not cleaned as the source address never moves.
+    ctx->dmaFill = colour;
+    status = DmaBuffer_cleanRange(&ctx->dmaFill, sizeof(ctx->dmaFill));
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->dmaXfer.readAddr  = (uintptr_t)&ctx->dmaFill;
+    ctx->dmaXfer.writeAddr = (uintptr_t)&ctx->hwOpt[LT24_DEDDATA];
+    ctx->dmaXfer.length    = (height * width) * sizeof(colour);
+    ctx->dmaXfer.isLast    = true;
+    ctx->dmaXfer.index     = 0;
+    ctx->dmaXfer.params    = dmaParams;
+    status = DMA_setupTransfer(dma, &ctx->dmaXfer, true);
+    //Keep track of the controller so we know when it is done
+    if (ERR_IS_SUCCESS(status)) {
+        ctx->dma = dma;
+        ctx->dmaBuf = NULL;
+    }
+    return status;
+}
+
+//Clear the display to a colour using DMA
+// - As LT24_fillRectDma() for the whole display.
+HpsErr_t LT24_clearDisplayDma( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, unsigned short colour ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return LT24_fillRectDma(ctx, dma, dmaParams, colour, 0, 0, ctx->width, ctx->height);
+}
+
+//Handle a tearing effect edge
+// - Call from the interrupt handler for the TE input.
+// - Starts any copy queued by LT24_copyFrameBufferDmaSync().
+// - Returns ERR_SKIPPED if nothing was queued, otherwise the result of
+//   starting the copy.
+HpsErr_t LT24_tearingEdge( LT24Ctx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->teCopy.pending) return ERR_SKIPPED;
+    //No longer queued, so the normal DMA copy can take over
+    ctx->teCopy.pending = false;
+    return LT24_copyFrameBufferDma(ctx, ctx->teCopy.dma, ctx->teCopy.dmaParams, ctx->teCopy.framebuffer,
+                                   ctx->teCopy.xleft, ctx->teCopy.ytop, ctx->teCopy.width, ctx->teCopy.height);
+}
+
+//Check if DMA frame buffer copy is complete
+// - Returns ERR_SUCCESS if there is no DMA copy running.
+// - Returns ERR_BUSY if the DMA copy is still running.
+HpsErr_t LT24_copyFrameBufferDone( LT24Ctx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check the DMA state
+    return _LT24_dmaCheckDone(ctx);
+}
+
+//Soft_DMAController copy function for hardware optimised data port.
+// - Writes 16-bit words from src to the fixed address dest.
+// - Compatible with SoftDmaMemcpyFunc_t.
+void* LT24_softDmaCopy( void* dest, void* src, size_t len, void* ctx ) {
+    volatile unsigned short* port = (volatile unsigned short*)dest;
+    const unsigned short* pixels = (const unsigned short*)src;
+    size_t cnt = len / sizeof(*pixels);
+    //Unrolled to reduce loop overhead per pixel
+    while (cnt >= 8) {
+        *port = pixels[0]; *port = pixels[1]; *port = pixels[2]; *port = pixels[3];
+        *port = pixels[4]; *port = pixels[5]; *port = pixels[6]; *port = pixels[7];
+        pixels += 8;
+        cnt -= 8;
+    }
+    while (cnt--) {
+        *port = *pixels++;
+    }
+    return dest;
+}
+
+//Soft_DMAController fill function for hardware optimised data port.
+// - Writes the colour of the current DMA fill len/2 times to the fixed
+//   address dest. src is ignored, as the Soft DMA always moves it on.
+//   ctx must be the LT24 context.
+// - Compatible with SoftDmaMemcpyFunc_t.
+void* LT24_softDmaFill( void* dest, void* src, size_t len, void* ctx ) {
+    (void)src;
+    if (!ctx) return NULL;
+    volatile unsigned short* port = (volatile unsigned short*)dest;
+    unsigned short colour = ((LT24Ctx_t*)ctx)->dmaFill;
+    size_t cnt = len / sizeof(colour);
+    //Unrolled to reduce loop overhead per pixel
+    while (cnt >= 8) {
+        *port = colour; *port = colour; *port = colour; *port = colour;
+        *port = colour; *port = colour; *port = colour; *port = colour;
+        cnt -= 8;
+    }
+    while (cnt--) {
+        *port = colour;
+    }
+    return dest;
+}
+
 //Plot a single pixel on the LT24 display
 // - returns 0 if successful
 HpsErr_t LT24_drawPixel( LT24Ctx_t* ctx, unsigned short colour, unsigned int x, unsigned int y ) {
@@ -490,3 +1023,62 @@ HpsErr_t LT24_drawPixel( LT24Ctx_t* ctx, unsigned short colour, unsigned int x,
     return _LT24_write(ctx, true, colour);
 }
 
+//Fill a rectangle on the LT24 display with a colour
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_fillRect( LT24Ctx_t* ctx, unsigned short colour, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    //Define Window (setWindow validates context for us)
+    HpsErr_t status = LT24_setWindow(ctx, xleft, ytop, width, height);
+    if (ERR_IS_ERROR(status)) return status;
+    //Write the required colour to every pixel in the window
+    return _LT24_fillPixels(ctx, colour, height * width);
+}
+
+//Draw a horizontal line on the LT24 display
+// - Line starts at (x,y) and extends length pixels to the right
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_hLine( LT24Ctx_t* ctx, unsigned short colour, unsigned int x, unsigned int y, unsigned int length ) {
+    return LT24_fillRect(ctx, colour, x, y, length, 1);
+}
+
+//Draw a vertical line on the LT24 display
+// - Line starts at (x,y) and extends length pixels downwards
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_vLine( LT24Ctx_t* ctx, unsigned short colour, unsigned int x, unsigned int y, unsigned int length ) {
+    return LT24_fillRect(ctx, colour, x, y, 1, length);
+}
+
+//Define the vertical scrolling area
+// - Rows top to top+height-1 of the display scroll, rows above and below stay fixed.
+// - Drawing APIs always use frame memory rows. Within the scroll area, frame
+//   memory row LT24_setScrollStart() is shown at display row top, wrapping
+//   round to top after the end of the area.
+// - Rows are along the panel's native portrait axis (LT24_HEIGHT lines)
+//   whichever orientation is set.
+// - Returns LT24_INVALIDSIZE if the area doesn't fit on the display.
+HpsErr_t LT24_setScrollArea( LT24Ctx_t* ctx, unsigned int top, unsigned int height ) {
+    if ((top > LT24_HEIGHT) || (height > (LT24_HEIGHT - top))) return LT24_INVALIDSIZE;
+    //Fixed areas above and below must add up to the full height with the scroll area
+    unsigned int bottom = LT24_HEIGHT - top - height;
+    const unsigned short scroll[] = {
+        //Vertical Scrolling Definition (VSCRDEF)
+        LT24_COMMAND(0x0033, 6),
+            (top >> 8) & 0xFF, top & 0xFF, (height >> 8) & 0xFF, height & 0xFF, (bottom >> 8) & 0xFF, bottom & 0xFF
+    };
+    //writeCommands validates context for us
+    return LT24_writeCommands(ctx, scroll, sizeof(scroll)/sizeof(scroll[0]));
+}
+
+//Set the vertical scroll position
+// - line is the frame memory row to show at the top of the scroll area, from
+//   top to top+height-1 of the area set by LT24_setScrollArea().
+// - Setting line to the top of the area shows frame memory unscrolled.
+// - Returns LT24_INVALIDSIZE if line is outside the display.
+HpsErr_t LT24_setScrollStart( LT24Ctx_t* ctx, unsigned int line ) {
+    if (line >= LT24_HEIGHT) return LT24_INVALIDSIZE;
+    const unsigned short start[] = {
+        //Vertical Scrolling Start Address (VSCRSADD)
+        LT24_COMMAND(0x0037, 2),
+            (line >> 8) & 0xFF, line & 0xFF
+    };
+    return LT24_writeCommands(ctx, start, sizeof(start)/sizeof(start[0]));
+}
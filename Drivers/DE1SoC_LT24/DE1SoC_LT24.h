@@ -32,6 +32,39 @@
  * 
  *     MyGraphicDriver_initialise(LT24Ctx_t* display, ...);
  * 
+ * Orientation
+ * -----------
+ * 
+ * The panel is natively portrait, LT24_WIDTH x LT24_HEIGHT. The
+ * controller can instead map the frame memory in any of four
+ * rotations, optionally mirrored, with LT24_setOrientation(). The
+ * window coordinates used by all drawing and copy APIs then follow
+ * the new orientation, so landscape frame buffers can be copied
+ * directly without rotating them in software. Use LT24_getSize()
+ * to find the current width and height. Hardware scrolling always
+ * runs along the panel's native 320 line axis.
+ * 
+ * Tearing Effect
+ * --------------
+ * 
+ * If the panel TE output is wired to a PIO input, frame copies
+ * can be started at the beginning of vertical blanking so they
+ * don't tear. Enable the output with LT24_setTearingEffect(),
+ * queue copies with LT24_copyFrameBufferDmaSync(), and call
+ * LT24_tearingEdge() from the PIO interrupt handler:
+ * 
+ *     void __irq teIsr(HPSIRQSource id, void* param, bool* handled) {
+ *         unsigned int flags;
+ *         FPGA_PIO_getInterruptFlags(tePio, &flags, TE_MASK, true);
+ *         if (flags) LT24_tearingEdge((LT24Ctx_t*)param);
+ *         *handled = true;
+ *     }
+ *     HPS_IRQ_registerHandler(IRQ_TE_PIO, &teIsr, lt24);
+ * 
+ * The panel scans from the top at its refresh rate (70Hz), so
+ * the copy must stay ahead of the scan. The DMA copy (DMA-330 to
+ * the hardware optimised port) is fast enough for a full frame.
+ * 
  * 
  * 
  * 
@@ -42,6 +75,18 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add DMA solid fills from a fixed source
+ * 14/10/2026 | Add shared buffer descriptor DMA copy
+ * 14/10/2026 | Add hardware rotation and mirroring
+ * 14/10/2026 | Add colour streaming into current window
+ * 14/10/2026 | Add tearing effect synchronised DMA copies
+ * 14/10/2026 | Add hardware vertical scrolling
+ * 14/10/2026 | Add burst command table writes
+ * 14/10/2026 | Add non-blocking initialisation steps
+ * 14/10/2026 | Use GPIO fast path for control pins if available
+ * 14/10/2026 | Add rectangle and line fills. Faster clear and copy in hwOpt mode
+ * 14/10/2026 | Add pixel streaming into current window
+ * 14/10/2026 | Add DMA frame buffer copy for hardware optimised mode
  * 21/11/2024 | Use external GPIO instance
  * 31/01/2024 | Update to new driver contexts
  * 20/10/2017 | Update driver to match new styles
@@ -56,6 +101,8 @@
 #include <stdint.h>
 #include "Util/driver_ctx.h"
 #include "Util/driver_gpio.h"
+#include "Util/driver_dma.h"
+#include "Util/buf_desc.h"
 
 //Map some error codes to their use
 #define LT24_INVALIDSIZE  ERR_BEYONDEND
@@ -65,6 +112,15 @@
 #define LT24_WIDTH  240
 #define LT24_HEIGHT 320
 
+//Display orientations for LT24_setOrientation()
+typedef enum {
+    LT24_PORTRAIT,          // 240 x 320, native orientation (default)
+    LT24_LANDSCAPE,         // 320 x 240, rotated 90 degrees
+    LT24_PORTRAIT_FLIPPED,  // 240 x 320, rotated 180 degrees
+    LT24_LANDSCAPE_FLIPPED, // 320 x 240, rotated 270 degrees
+    LT24_ORIENTATION_COUNT
+} LT24Orientation;
+
 //Some basic colours
 enum {
     LT24_BLACK   = (0x0000),
@@ -77,23 +133,76 @@ enum {
     LT24_MAGENTA = (LT24_BLUE  | LT24_RED  )
 };
 
+//Command table entry, followed by paramCount parameter words
+#define LT24_COMMAND(cmd, paramCount) (cmd), (paramCount)
+
 // Driver context
 typedef struct {
     // Context Header
     DrvCtx_t header;
     // Context Body
     GpioCtx_t* cntrl;
+    GpioFast_t* fast;               // Unchecked fast path of cntrl, or NULL if not supported
     volatile unsigned short* hwOpt; // Uses hardware optimised interface if non-NULL
+    // Orientation
+    LT24Orientation orientation;
+    bool         mirror;
+    unsigned int width;             // Window limits for the current orientation
+    unsigned int height;
+    // DMA frame buffer copy
+    DmaCtx_t*  dma;                 // DMA controller of in progress copy, or NULL if none.
+    DmaChunk_t dmaXfer;
+    BufDesc_t* dmaBuf;              // Shared frame buffer held by the copy, or NULL if a plain buffer.
+    unsigned short dmaFill;         // Fixed source word of a DMA fill
+    // Copy queued for the next tearing effect edge
+    struct {
+        volatile bool pending;
+        DmaCtx_t*     dma;
+        void*         dmaParams;
+        const unsigned short* framebuffer;
+        unsigned int  xleft;
+        unsigned int  ytop;
+        unsigned int  width;
+        unsigned int  height;
+    } teCopy;
+    // Initialisation
+    unsigned int initStage;         // Next step for LT24_initialiseStep()
 } LT24Ctx_t;
 
+// Initialisation steps
+enum {
+    LT24_INIT_POWERON,
+    LT24_INIT_RESET,
+    LT24_INIT_WAKE,
+    LT24_INIT_UPLOAD,
+    LT24_INIT_ENABLE
+};
+
 //Function to initialise the LCD
 //  - cntrl is a GPIO instance used to configure the control pins for the LT24.
 //  - dataBase if non-NULL indicates using hardware optimised mode. Must be base
 //    address of the optimised data transfer buffer
+//  - Waits around 250ms for the LCD to power up. See LT24_initialiseStart() to
+//    initialise without waiting.
 //  - Returns Util/error Code
 //  - Returns context pointer to *ctx
 HpsErr_t LT24_initialise( GpioCtx_t* cntrl, void* dataBase, LT24Ctx_t** pCtx );
 
+//Start initialising the LCD without waiting
+//  - As LT24_initialise(), but only configures the control pins. The context
+//    is not initialised until LT24_initialiseStep() returns ERR_SUCCESS.
+//  - For use with Util/init_seq to power up several drivers at once.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t LT24_initialiseStart( GpioCtx_t* cntrl, void* dataBase, LT24Ctx_t** pCtx );
+
+//Make the next step of LCD initialisation
+//  - ctx must have been returned by LT24_initialiseStart().
+//  - Returns ERR_AGAIN if more steps are needed, with the number of microseconds
+//    to wait before the next in *delay.
+//  - Returns ERR_SUCCESS once initialised and the display cleared.
+HpsErr_t LT24_initialiseStep( LT24Ctx_t* ctx, unsigned int* delay );
+
 //Check if driver initialised
 // - returns true if initialised
 bool LT24_isInitialised( LT24Ctx_t* ctx );
@@ -102,6 +211,19 @@ bool LT24_isInitialised( LT24Ctx_t* ctx );
 //You must check LT24_isInitialised() before calling this function
 HpsErr_t LT24_write( LT24Ctx_t* ctx, bool isData, unsigned short value );
 
+//Write a table of commands and their parameters
+// - table is len words made up of LT24_COMMAND(command, count) followed
+//   by count parameter words, for as many commands as needed. e.g.:
+//       const unsigned short gamma[] = {
+//           LT24_COMMAND(0x0026, 1), 0x0002  //Gamma curve 2
+//       };
+// - In hardware optimised mode the parameters are written as a burst.
+// - Fast enough for register changes (gamma, scrolling, etc.) between frames.
+// - Use LT24_setOrientation() to rotate rather than writing MADCTL directly,
+//   so that the window limits are kept up to date.
+// - Returns ERR_BEYONDEND if the last command is missing parameters. Nothing is written.
+HpsErr_t LT24_writeCommands( LT24Ctx_t* ctx, const unsigned short* table, unsigned int len );
+
 //Function for configuring LCD reset/power (using PIO)
 //You must check LT24_isInitialised() before calling this function
 HpsErr_t LT24_powerConfig( LT24Ctx_t* ctx, bool isOn );
@@ -113,6 +235,17 @@ HpsErr_t LT24_clearDisplay( LT24Ctx_t* ctx, unsigned short colour );
 //Function to convert Red/Green/Blue to RGB565 encoded colour value 
 unsigned short LT24_makeColour( unsigned int R, unsigned int G, unsigned int B );
 
+//Set the display orientation
+// - Rotates the mapping of window coordinates onto the panel. If mirror
+//   is true, the display is also flipped left to right.
+// - Content already on the display is not moved, so redraw afterwards.
+// - Returns ERR_OUTRANGE if orientation is not a valid LT24Orientation.
+HpsErr_t LT24_setOrientation( LT24Ctx_t* ctx, LT24Orientation orientation, bool mirror );
+
+//Get the display size for the current orientation
+// - Returns the width and height windows must fit within via *width and *height.
+HpsErr_t LT24_getSize( LT24Ctx_t* ctx, unsigned int* width, unsigned int* height );
+
 //Function to set the drawing window on the display
 //  Returns ERR_SUCCESS if successful
 HpsErr_t LT24_setWindow( LT24Ctx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height);
@@ -126,10 +259,138 @@ HpsErr_t LT24_testPattern( LT24Ctx_t* ctx );
 HpsErr_t LT24_copyFrameBuffer( LT24Ctx_t* ctx, const unsigned short* framebuffer,
     unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height);
 
+//Stream pixels into the current window
+// - Writes count pixels from the pixels array to the display.
+// - Must be preceded by LT24_setWindow(). Multiple calls can be used to
+//   fill a single window, e.g. one call per row of a larger frame buffer.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_streamPixels( LT24Ctx_t* ctx, const unsigned short* pixels, unsigned int count );
+
+//Stream a single colour into the current window
+// - Writes count pixels of colour to the display.
+// - Must be preceded by LT24_setWindow(). Can be mixed with LT24_streamPixels()
+//   to fill a window, e.g. when decoding run-length encoded images.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_streamColour( LT24Ctx_t* ctx, unsigned short colour, unsigned int count );
+
+//Copy frame buffer to display using DMA
+// - Requires hardware optimised mode (returns ERR_NOSUPPORT otherwise).
+// - dma is the DMA controller to use. The transfer writes 16-bit pixels
+//   to a fixed (non-incrementing) data register address:
+//    - For HPS_DMAController, pass dmaParams with destType set to
+//      HPS_DMA_DESTINATION_REGISTER and transferWidth to HPS_DMA_BURSTSIZE_2BYTE.
+//    - For Soft_DMAController, initialise with SOFT_DMA_WORDSIZE_16BIT and
+//      LT24_softDmaCopy as the copy function, and pass dmaParams as NULL.
+// - Returns immediately once the transfer is started. The framebuffer must
+//   remain valid until LT24_copyFrameBufferDone() returns success.
+// - Source cache maintenance is handled automatically (Util/dma_buffer.h).
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous DMA copy is still running.
+// - Other LT24 APIs will return ERR_BUSY while the DMA copy is running.
+HpsErr_t LT24_copyFrameBufferDma( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, const unsigned short* framebuffer,
+    unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height);
+
+//Copy a shared frame buffer to display using DMA
+// - As LT24_copyFrameBufferDma(), but the frame buffer is a shared
+//   descriptor (Util/buf_desc.h), which must hold at least width*height
+//   pixels. A reference is held until the copy is done, so the caller
+//   may release it straight away.
+// - Source cleaning is skipped if the frame was drawn by another DMA.
+// - Returns ERR_TOOSMALL if the descriptor is too short for the window.
+HpsErr_t LT24_copyFrameBufferDmaBuf( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, BufDesc_t* framebuffer, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Enable or disable the tearing effect output
+// - When enabled the panel TE output pulses at the start of each
+//   vertical blanking period.
+HpsErr_t LT24_setTearingEffect( LT24Ctx_t* ctx, bool enable );
+
+//Queue a DMA frame buffer copy for the next tearing effect edge
+// - As LT24_copyFrameBufferDma(), but the window is set and the transfer
+//   started by LT24_tearingEdge(), so that it begins in vertical blanking.
+// - LT24_copyFrameBufferDone() and other LT24 APIs return ERR_BUSY from when
+//   queued until the copy is complete.
+// - Returns ERR_BUSY if a previous copy is queued or still running.
+HpsErr_t LT24_copyFrameBufferDmaSync( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, const unsigned short* framebuffer, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Fill a rectangle on the display using DMA
+// - Requires hardware optimised mode (returns ERR_NOSUPPORT otherwise).
+// - The transfer reads the same 16-bit colour from a fixed source address,
+//   and writes it to the fixed data register, so neither address increments:
+//    - For HPS_DMAController, pass dmaParams with srcType set to
+//      HPS_DMA_SOURCE_REGISTER, destType to HPS_DMA_DESTINATION_REGISTER
+//      and transferWidth to HPS_DMA_BURSTSIZE_2BYTE.
+//    - For Soft_DMAController, initialise with SOFT_DMA_WORDSIZE_16BIT and
+//      LT24_softDmaFill as the copy function with the LT24 context as
+//      copyFuncCtx, and pass dmaParams as NULL.
+// - Returns immediately once the transfer is started. Check for completion
+//   with LT24_copyFrameBufferDone().
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous DMA copy or fill is still running.
+HpsErr_t LT24_fillRectDma( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, unsigned short colour, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Clear the display to a colour using DMA
+// - As LT24_fillRectDma() for the whole display.
+HpsErr_t LT24_clearDisplayDma( LT24Ctx_t* ctx, DmaCtx_t* dma, void* dmaParams, unsigned short colour );
+
+//Handle a tearing effect edge
+// - Call from the interrupt handler for the TE input.
+// - Starts any copy queued by LT24_copyFrameBufferDmaSync().
+// - Returns ERR_SKIPPED if nothing was queued, otherwise the result of
+//   starting the copy.
+HpsErr_t LT24_tearingEdge( LT24Ctx_t* ctx );
+
+//Check if DMA frame buffer copy is complete
+// - Returns ERR_SUCCESS if there is no DMA copy running.
+// - Returns ERR_BUSY if the DMA copy is still running.
+HpsErr_t LT24_copyFrameBufferDone( LT24Ctx_t* ctx );
+
+//Soft_DMAController copy function for hardware optimised data port.
+// - Writes 16-bit words from src to the fixed address dest.
+// - Compatible with SoftDmaMemcpyFunc_t.
+void* LT24_softDmaCopy( void* dest, void* src, size_t len, void* ctx );
+
+//Soft_DMAController fill function for hardware optimised data port.
+// - Writes the colour of the current DMA fill len/2 times to the fixed
+//   address dest. src is ignored, as the Soft DMA always moves it on.
+//   ctx must be the LT24 context.
+// - Compatible with SoftDmaMemcpyFunc_t.
+void* LT24_softDmaFill( void* dest, void* src, size_t len, void* ctx );
+
 //Plot a single pixel on the LT24 display
 // - returns ERR_SUCCESS if successful
 HpsErr_t LT24_drawPixel( LT24Ctx_t* ctx, unsigned short colour, unsigned int x, unsigned int y);
 
+//Fill a rectangle on the LT24 display with a colour
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_fillRect( LT24Ctx_t* ctx, unsigned short colour, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Draw a horizontal line on the LT24 display
+// - Line starts at (x,y) and extends length pixels to the right
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_hLine( LT24Ctx_t* ctx, unsigned short colour, unsigned int x, unsigned int y, unsigned int length );
+
+//Draw a vertical line on the LT24 display
+// - Line starts at (x,y) and extends length pixels downwards
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24_vLine( LT24Ctx_t* ctx, unsigned short colour, unsigned int x, unsigned int y, unsigned int length );
+
+//Define the vertical scrolling area
+// - Rows top to top+height-1 of the display scroll, rows above and below stay fixed.
+// - Drawing APIs always use frame memory rows. Within the scroll area, frame
+//   memory row LT24_setScrollStart() is shown at display row top, wrapping
+//   round to top after the end of the area.
+// - Rows are along the panel's native portrait axis (LT24_HEIGHT lines)
+//   whichever orientation is set.
+// - Returns LT24_INVALIDSIZE if the area doesn't fit on the display.
+HpsErr_t LT24_setScrollArea( LT24Ctx_t* ctx, unsigned int top, unsigned int height );
+
+//Set the vertical scroll position
+// - line is the frame memory row to show at the top of the scroll area, from
+//   top to top+height-1 of the area set by LT24_setScrollArea().
+// - Setting line to the top of the area shows frame memory unscrolled.
+// - Returns LT24_INVALIDSIZE if line is outside the display.
+HpsErr_t LT24_setScrollStart( LT24Ctx_t* ctx, unsigned int line );
+
 #endif /*DE1SoC_LT24_H_*/
 
 /*
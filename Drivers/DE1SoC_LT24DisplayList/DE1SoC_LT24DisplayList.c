@@ -0,0 +1,340 @@
+/*
+ * LT24 Display List Renderer
+ * --------------------------
+ * Description:
+ * Retained primitive list for the LT24 Display Controller
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_LT24DisplayList.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "BasicFont/BasicFont.h"
+#include "Util/bit_helpers.h"
+
+//First character in the font table
+#define LT24DL_FIRST_CHAR  ' '
+#define LT24DL_GLYPH_COUNT (96 + numberOfCustomCharacters)
+
+/*
+ * Internal Functions
+ */
+
+//Area of a rectangle in pixels
+static unsigned int _LT24DL_area( LT24FBRect_t rect ) {
+    return (rect.xright - rect.xleft) * (rect.ybottom - rect.ytop);
+}
+
+//Bounding box of two rectangles
+static LT24FBRect_t _LT24DL_union( LT24FBRect_t a, LT24FBRect_t b ) {
+    if (b.xleft   < a.xleft  ) a.xleft   = b.xleft;
+    if (b.ytop    < a.ytop   ) a.ytop    = b.ytop;
+    if (b.xright  > a.xright ) a.xright  = b.xright;
+    if (b.ybottom > a.ybottom) a.ybottom = b.ybottom;
+    return a;
+}
+
+//Whether rectangle a lies entirely inside rectangle b
+static bool _LT24DL_inside( LT24FBRect_t a, LT24FBRect_t b ) {
+    return (a.xleft >= b.xleft) && (a.ytop >= b.ytop) && (a.xright <= b.xright) && (a.ybottom <= b.ybottom);
+}
+
+//Whether two rectangles overlap
+static bool _LT24DL_overlaps( LT24FBRect_t a, LT24FBRect_t b ) {
+    return (a.xleft < b.xright) && (b.xleft < a.xright) && (a.ytop < b.ybottom) && (b.ytop < a.ybottom);
+}
+
+//Add a rectangle to the region list
+// - Merges with any existing regions where cheaper to do so, and with the
+//   closest region if the list is full.
+static void _LT24DL_addRegion( LT24DLCtx_t* ctx, LT24FBRect_t rect ) {
+    while (true) {
+        //Merge with any region for which the merged area costs less than two windows
+        unsigned int idx = 0;
+        while (idx < ctx->regionCount) {
+            LT24FBRect_t merged = _LT24DL_union(rect, ctx->regions[idx]);
+            if (_LT24DL_area(merged) <= (_LT24DL_area(rect) + _LT24DL_area(ctx->regions[idx]) + LT24DL_MERGE_COST)) {
+                //Remove the existing entry, and rescan as the merged rectangle may now overlap others
+                rect = merged;
+                ctx->regions[idx] = ctx->regions[--ctx->regionCount];
+                idx = 0;
+            } else {
+                idx++;
+            }
+        }
+        //If there is space, add the new rectangle
+        if (ctx->regionCount < LT24DL_MAX_REGIONS) {
+            ctx->regions[ctx->regionCount++] = rect;
+            return;
+        }
+        //Otherwise merge with whichever region causes the least growth, then try again
+        unsigned int best = 0;
+        unsigned int bestGrowth = UINT32_MAX;
+        for (idx = 0; idx < ctx->regionCount; idx++) {
+            unsigned int growth = _LT24DL_area(_LT24DL_union(rect, ctx->regions[idx])) - _LT24DL_area(ctx->regions[idx]);
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                best = idx;
+            }
+        }
+        rect = _LT24DL_union(rect, ctx->regions[best]);
+        ctx->regions[best] = ctx->regions[--ctx->regionCount];
+    }
+}
+
+//Append a primitive to the list
+// - Bounds are given in 64-bit so large sizes and offsets can't wrap, and
+//   are clipped to the display.
+static HpsErr_t _LT24DL_add( LT24DLCtx_t* ctx, LT24DLItem_t* item, int64_t xleft, int64_t ytop, int64_t xright, int64_t ybottom ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int width, height;
+    status = LT24_getSize(ctx->strip->display, &width, &height);
+    if (ERR_IS_ERROR(status)) return status;
+    //Clip to the display
+    if (xleft   < 0     ) xleft   = 0;
+    if (ytop    < 0     ) ytop    = 0;
+    if (xright  > width ) xright  = width;
+    if (ybottom > height) ybottom = height;
+    if ((xright <= xleft) || (ybottom <= ytop)) return ERR_SKIPPED;
+    if (ctx->count >= LT24DL_MAX_ITEMS) return ERR_NOSPACE;
+    //Then record
+    item->bounds = (LT24FBRect_t){ (unsigned short)xleft, (unsigned short)ytop, (unsigned short)xright, (unsigned short)ybottom };
+    item->culled = false;
+    ctx->items[ctx->count++] = *item;
+    return ERR_SUCCESS;
+}
+
+//Plot a pixel in screen coordinates if it is within the band
+static inline void _LT24DL_plot( LT24SBBand_t* band, int x, int y, unsigned short colour ) {
+    if ((x < (int)band->xleft) || (y < (int)band->ytop)) return;
+    unsigned int col = (unsigned int)x - band->xleft;
+    unsigned int row = (unsigned int)y - band->ytop;
+    if ((col >= band->width) || (row >= band->height)) return;
+    band->pixels[row * band->width + col] = colour;
+}
+
+//Draw a line into a band
+// - Bresenham's algorithm over the whole line, plotting only the points
+//   within the band.
+static void _LT24DL_drawLine( LT24SBBand_t* band, const LT24DLItem_t* item ) {
+    int x = item->x;
+    int y = item->y;
+    int dx =  abs(item->x1 - x);
+    int dy = -abs(item->y1 - y);
+    int sx = (x < item->x1) ? 1 : -1;
+    int sy = (y < item->y1) ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+        _LT24DL_plot(band, x, y, item->colour);
+        if ((x == item->x1) && (y == item->y1)) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+//Draw text into a band
+// - Only the rows and columns of each cell within the band are drawn.
+static void _LT24DL_drawText( LT24SBBand_t* band, const LT24DLItem_t* item ) {
+    const char* str = (const char*)item->data;
+    //Rows of the cells within the band
+    int rowStart = max((int)band->ytop - item->y, 0);
+    int rowEnd   = min((int)(band->ytop + band->height) - item->y, LT24DL_CHAR_HEIGHT);
+    for (int idx = 0; idx < item->x1; idx++) {
+        int cellX = item->x + idx * LT24DL_CHAR_WIDTH;
+        //Skip cells entirely outside the band
+        if ((cellX + LT24DL_CHAR_WIDTH <= (int)band->xleft) || (cellX >= (int)(band->xleft + band->width))) continue;
+        unsigned int glyph = (unsigned char)str[idx] - LT24DL_FIRST_CHAR;
+        //Map unknown characters to '?'
+        if (glyph >= LT24DL_GLYPH_COUNT) glyph = '?' - LT24DL_FIRST_CHAR;
+        for (int col = 0; col < LT24DL_CHAR_WIDTH; col++) {
+            unsigned char column = (col < 5) ? (unsigned char)BF_fontMap[glyph][col] : 0;
+            //Bit n of a column is row n
+            for (int row = rowStart; row < rowEnd; row++) {
+                if (column & _BV(row)) {
+                    _LT24DL_plot(band, cellX + col, item->y + row, item->colour);
+                } else if (item->opaque) {
+                    _LT24DL_plot(band, cellX + col, item->y + row, item->colour2);
+                }
+            }
+        }
+    }
+}
+
+//Draw every primitive which overlaps a band, in the order recorded
+static HpsErr_t _LT24DL_drawBand( void* param, LT24SBBand_t* band ) {
+    LT24DLCtx_t* ctx = (LT24DLCtx_t*)param;
+    LT24FBRect_t area = { (unsigned short)band->xleft, (unsigned short)band->ytop, (unsigned short)(band->xleft + band->width), (unsigned short)(band->ytop + band->height) };
+    LT24SB_fill(band, ctx->background);
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        const LT24DLItem_t* item = &ctx->items[idx];
+        if (item->culled || !_LT24DL_overlaps(item->bounds, area)) continue;
+        switch (item->type) {
+            case LT24DL_ITEM_RECT:
+                LT24SB_fillRect(band, item->colour, item->x, item->y, (unsigned int)item->x1, (unsigned int)item->y1);
+                break;
+            case LT24DL_ITEM_LINE:
+                _LT24DL_drawLine(band, item);
+                break;
+            case LT24DL_ITEM_TEXT:
+                _LT24DL_drawText(band, item);
+                break;
+            case LT24DL_ITEM_IMAGE:
+                LT24SB_blit(band, (const LT24FBImage_t*)item->data, item->x, item->y);
+                break;
+            case LT24DL_ITEM_IMAGE_KEYED:
+                LT24SB_blitKeyed(band, (const LT24FBImage_t*)item->data, item->x, item->y, item->colour2);
+                break;
+            default:
+                break;
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the display list driver
+// - strip is an initialised strip buffer driver instance used to
+//   rasterise and send each region.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24DL_initialise( LT24SBCtx_t* strip, LT24DLCtx_t** pCtx ) {
+    //Check if the strip buffer has been initialised (required)
+    if (!LT24SB_isInitialised(strip)) return ERR_BADDEVICE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save strip buffer pointer. List starts empty.
+    LT24DLCtx_t* ctx = *pCtx;
+    ctx->strip = strip;
+    ctx->background = LT24_BLACK;
+    ctx->count = 0;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+bool LT24DL_isInitialised( LT24DLCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Set the background colour
+// - Used for any part of a region not covered by a primitive.
+HpsErr_t LT24DL_setBackground( LT24DLCtx_t* ctx, unsigned short colour ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->background = colour;
+    return ERR_SUCCESS;
+}
+
+//Start a new display list
+// - Discards any primitives recorded since the last render.
+HpsErr_t LT24DL_begin( LT24DLCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->count = 0;
+    return ERR_SUCCESS;
+}
+
+//Record a filled rectangle
+// - Primitives may be partly or wholly off the display.
+// - Returns ERR_SKIPPED if the primitive is entirely off the display.
+// - Returns ERR_NOSPACE if the list is full.
+HpsErr_t LT24DL_rect( LT24DLCtx_t* ctx, unsigned short colour, int xleft, int ytop, unsigned int width, unsigned int height ) {
+    if ((width > INT32_MAX) || (height > INT32_MAX)) return LT24_INVALIDSIZE;
+    LT24DLItem_t item = { .type = LT24DL_ITEM_RECT, .colour = colour, .x = xleft, .y = ytop, .x1 = (int)width, .y1 = (int)height };
+    return _LT24DL_add(ctx, &item, xleft, ytop, (int64_t)xleft + width, (int64_t)ytop + height);
+}
+
+//Record a line from (x0,y0) to (x1,y1) inclusive
+HpsErr_t LT24DL_line( LT24DLCtx_t* ctx, unsigned short colour, int x0, int y0, int x1, int y1 ) {
+    LT24DLItem_t item = { .type = LT24DL_ITEM_LINE, .colour = colour, .x = x0, .y = y0, .x1 = x1, .y1 = y1 };
+    return _LT24DL_add(ctx, &item, min(x0, x1), min(y0, y1), (int64_t)max(x0, x1) + 1, (int64_t)max(y0, y1) + 1);
+}
+
+//Record a string of BasicFont text
+// - Characters are LT24DL_CHAR_WIDTH x LT24DL_CHAR_HEIGHT cells, with
+//   the top left of the first at (x,y).
+// - If opaque, the cell background is filled with bgColour, otherwise
+//   only the character pixels are drawn.
+HpsErr_t LT24DL_text( LT24DLCtx_t* ctx, const char* str, int x, int y, unsigned short fgColour, unsigned short bgColour, bool opaque ) {
+    if (!str) return ERR_NULLPTR;
+    size_t len = strlen(str);
+    if (!len) return ERR_SKIPPED;
+    if (len > (INT32_MAX / LT24DL_CHAR_WIDTH)) return LT24_INVALIDSIZE;
+    LT24DLItem_t item = { .type = LT24DL_ITEM_TEXT, .colour = fgColour, .colour2 = bgColour, .opaque = opaque, .x = x, .y = y, .x1 = (int)len, .data = str };
+    return _LT24DL_add(ctx, &item, x, y, (int64_t)x + len * LT24DL_CHAR_WIDTH, (int64_t)y + LT24DL_CHAR_HEIGHT);
+}
+
+//Record an image
+HpsErr_t LT24DL_image( LT24DLCtx_t* ctx, const LT24FBImage_t* image, int x, int y ) {
+    if (!image || !image->pixels) return ERR_NULLPTR;
+    LT24DLItem_t item = { .type = LT24DL_ITEM_IMAGE, .x = x, .y = y, .data = image };
+    return _LT24DL_add(ctx, &item, x, y, (int64_t)x + image->width, (int64_t)y + image->height);
+}
+
+//Record an image with transparent pixels
+// - Pixels equal to key are not drawn.
+HpsErr_t LT24DL_imageKeyed( LT24DLCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned short key ) {
+    if (!image || !image->pixels) return ERR_NULLPTR;
+    LT24DLItem_t item = { .type = LT24DL_ITEM_IMAGE_KEYED, .colour2 = key, .x = x, .y = y, .data = image };
+    return _LT24DL_add(ctx, &item, x, y, (int64_t)x + image->width, (int64_t)y + image->height);
+}
+
+//Render the display list
+// - Sends each region covered by the recorded primitives.
+// - The list is kept, so can be rendered again or added to. Call
+//   LT24DL_begin() to start the next frame.
+// - Returns ERR_SKIPPED if there was nothing to send.
+HpsErr_t LT24DL_render( LT24DLCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Drop primitives hidden behind a later rectangle. Those still visible
+    //make up the regions to send.
+    ctx->regionCount = 0;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        LT24DLItem_t* item = &ctx->items[idx];
+        item->culled = false;
+        for (unsigned int later = idx + 1; later < ctx->count; later++) {
+            if ((ctx->items[later].type == LT24DL_ITEM_RECT) && _LT24DL_inside(item->bounds, ctx->items[later].bounds)) {
+                item->culled = true;
+                break;
+            }
+        }
+        if (!item->culled) _LT24DL_addRegion(ctx, item->bounds);
+    }
+    if (!ctx->regionCount) return ERR_SKIPPED;
+    //Then rasterise and send each region as a single window
+    for (unsigned int idx = 0; idx < ctx->regionCount; idx++) {
+        LT24FBRect_t region = ctx->regions[idx];
+        status = LT24SB_renderRect(ctx->strip, region.xleft, region.ytop, region.xright - region.xleft, region.ybottom - region.ytop, &_LT24DL_drawBand, ctx);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*
+ * LT24 Display List Renderer
+ * --------------------------
+ * Description:
+ * Retained primitive list for the LT24 Display Controller
+ *
+ * Drawing each widget immediately costs a window setup and a
+ * burst of pixels per primitive, and overlapping primitives are
+ * sent more than once. This driver instead records the primitives
+ * for a frame (rectangles, lines, text and images) into a display
+ * list, then renders the whole list in one go:
+ *
+ *    LT24DL_begin(dl);
+ *    LT24DL_rect(dl, LT24_BLUE, 10, 10, 100, 40);
+ *    LT24DL_text(dl, "Volume", 14, 14, LT24_WHITE, LT24_BLUE, false);
+ *    LT24DL_imageKeyed(dl, &knob, knobX, 20, LT24_MAGENTA);
+ *    LT24DL_render(dl);
+ *
+ * When rendered:
+ *
+ *  - The bounding box of each primitive is clipped to the display.
+ *  - Primitives hidden behind a later filled rectangle are dropped.
+ *  - The boxes are merged into regions where the merged area is not
+ *    much larger than the sum of the parts, in the same way as the
+ *    DE1SoC_LT24FrameBuffer dirty rectangles.
+ *  - Each region is rasterised a band at a time by
+ *    DE1SoC_LT24StripBuffer, drawing every primitive which overlaps
+ *    the band in the order recorded, so each region is sent to the
+ *    panel as one window of pixel bursts.
+ *
+ * Any part of a region not covered by a primitive is filled with
+ * the background colour (LT24DL_setBackground()). Record a complete
+ * scene each frame, or widgets which paint their own background.
+ *
+ * Text and images are referenced rather than copied, so must remain
+ * valid until LT24DL_render() returns.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_LT24DISPLAYLIST_H_
+#define DE1SOC_LT24DISPLAYLIST_H_
+
+//Include required header files
+#include <stdint.h>
+#include "Util/driver_ctx.h"
+#include "DE1SoC_LT24StripBuffer/DE1SoC_LT24StripBuffer.h"
+
+//Maximum number of primitives in a display list
+#ifndef LT24DL_MAX_ITEMS
+#define LT24DL_MAX_ITEMS   64
+#endif
+
+//Maximum number of regions sent per render
+#ifndef LT24DL_MAX_REGIONS
+#define LT24DL_MAX_REGIONS 8
+#endif
+
+//Overhead of a window setup expressed in pixels, as LT24FB_MERGE_COST.
+#ifndef LT24DL_MERGE_COST
+#define LT24DL_MERGE_COST  64
+#endif
+
+//Size of a text character cell
+#define LT24DL_CHAR_WIDTH  6
+#define LT24DL_CHAR_HEIGHT 8
+
+//Primitive types
+typedef enum {
+    LT24DL_ITEM_RECT,
+    LT24DL_ITEM_LINE,
+    LT24DL_ITEM_TEXT,
+    LT24DL_ITEM_IMAGE,
+    LT24DL_ITEM_IMAGE_KEYED
+} LT24DLItemType;
+
+//Recorded primitive
+typedef struct {
+    LT24DLItemType type;
+    unsigned short colour;   // Fill, line or text colour
+    unsigned short colour2;  // Text background, or image colour key
+    bool           opaque;   // Text background is drawn
+    int            x;        // Top left, or line start
+    int            y;
+    int            x1;       // Rectangle width/height, or line end
+    int            y1;
+    const void*    data;     // String or LT24FBImage_t
+    LT24FBRect_t   bounds;   // Bounding box clipped to the display
+    bool           culled;   // Hidden behind a later rectangle
+} LT24DLItem_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    LT24SBCtx_t* strip;
+    unsigned short background;
+    // Display list
+    LT24DLItem_t items[LT24DL_MAX_ITEMS];
+    unsigned int count;
+    // Regions for the current render
+    LT24FBRect_t regions[LT24DL_MAX_REGIONS];
+    unsigned int regionCount;
+} LT24DLCtx_t;
+
+//Initialise the display list driver
+// - strip is an initialised strip buffer driver instance used to
+//   rasterise and send each region.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24DL_initialise( LT24SBCtx_t* strip, LT24DLCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool LT24DL_isInitialised( LT24DLCtx_t* ctx );
+
+//Set the background colour
+// - Used for any part of a region not covered by a primitive.
+HpsErr_t LT24DL_setBackground( LT24DLCtx_t* ctx, unsigned short colour );
+
+//Start a new display list
+// - Discards any primitives recorded since the last render.
+HpsErr_t LT24DL_begin( LT24DLCtx_t* ctx );
+
+//Record a filled rectangle
+// - Primitives may be partly or wholly off the display.
+// - Returns ERR_SKIPPED if the primitive is entirely off the display.
+// - Returns ERR_NOSPACE if the list is full.
+HpsErr_t LT24DL_rect( LT24DLCtx_t* ctx, unsigned short colour, int xleft, int ytop, unsigned int width, unsigned int height );
+
+//Record a line from (x0,y0) to (x1,y1) inclusive
+HpsErr_t LT24DL_line( LT24DLCtx_t* ctx, unsigned short colour, int x0, int y0, int x1, int y1 );
+
+//Record a string of BasicFont text
+// - Characters are LT24DL_CHAR_WIDTH x LT24DL_CHAR_HEIGHT cells, with
+//   the top left of the first at (x,y).
+// - If opaque, the cell background is filled with bgColour, otherwise
+//   only the character pixels are drawn.
+HpsErr_t LT24DL_text( LT24DLCtx_t* ctx, const char* str, int x, int y, unsigned short fgColour, unsigned short bgColour, bool opaque );
+
+//Record an image
+HpsErr_t LT24DL_image( LT24DLCtx_t* ctx, const LT24FBImage_t* image, int x, int y );
+
+//Record an image with transparent pixels
+// - Pixels equal to key are not drawn.
+HpsErr_t LT24DL_imageKeyed( LT24DLCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned short key );
+
+//Render the display list
+// - Sends each region covered by the recorded primitives.
+// - The list is kept, so can be rendered again or added to. Call
+//   LT24DL_begin() to start the next frame.
+// - Returns ERR_SKIPPED if there was nothing to send.
+HpsErr_t LT24DL_render( LT24DLCtx_t* ctx );
+
+#endif /* DE1SOC_LT24DISPLAYLIST_H_ */
@@ -0,0 +1,847 @@
+/*
+ * LT24 Double Buffered Frame Buffer
+ * ---------------------------------
+ * Description:
+ * Double buffered display layer for the LT24 Display Controller
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add scaled blits with nearest and bilinear filtering
+ * 14/10/2026 | Add DMA presentation paced at a fixed frame rate
+ * 14/10/2026 | Add palettised 8-bit frame buffer mode
+ * 14/10/2026 | Add clipped sprite blits with colour key and alpha blend
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_LT24FrameBuffer.h"
+#include "Util/mem_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Util/watchdog.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+//Size of one frame buffer
+#define LT24FB_PIXELS   (LT24_WIDTH * LT24_HEIGHT)
+#define LT24FB_BUFSIZE  (LT24FB_PIXELS * sizeof(unsigned short))
+#define LT24FB_BUFSIZE8 (LT24FB_PIXELS * sizeof(uint8_t))
+
+//Pixel address helper
+#define LT24FB_PIXEL(buf, x, y) (&(buf)[(y) * LT24_WIDTH + (x)])
+
+/*
+ * Internal Functions
+ */
+
+//Area of a rectangle in pixels
+static unsigned int _LT24FB_area( LT24FBRect_t rect ) {
+    return (rect.xright - rect.xleft) * (rect.ybottom - rect.ytop);
+}
+
+//Bounding box of two rectangles
+static LT24FBRect_t _LT24FB_union( LT24FBRect_t a, LT24FBRect_t b ) {
+    if (b.xleft   < a.xleft  ) a.xleft   = b.xleft;
+    if (b.ytop    < a.ytop   ) a.ytop    = b.ytop;
+    if (b.xright  > a.xright ) a.xright  = b.xright;
+    if (b.ybottom > a.ybottom) a.ybottom = b.ybottom;
+    return a;
+}
+
+//Validate a drawing region
+// - Same checks as LT24_setWindow so that errors are consistent
+static HpsErr_t _LT24FB_checkRegion( unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    if (!width || !height) return LT24_INVALIDSHAPE;
+    if ((xleft >= LT24_WIDTH ) || (width  > (LT24_WIDTH  - xleft))) return LT24_INVALIDSIZE;
+    if ((ytop  >= LT24_HEIGHT) || (height > (LT24_HEIGHT - ytop ))) return LT24_INVALIDSIZE;
+    return ERR_SUCCESS;
+}
+
+//Add a rectangle to the dirty list
+// - Merges with any existing rectangles where cheaper to do so.
+static void _LT24FB_addDirty( LT24FBCtx_t* ctx, LT24FBRect_t rect ) {
+    while (true) {
+        //Merge with any rectangle for which the merged area costs less than two windows
+        unsigned int idx = 0;
+        while (idx < ctx->dirtyCount) {
+            LT24FBRect_t merged = _LT24FB_union(rect, ctx->dirty[idx]);
+            if (_LT24FB_area(merged) <= (_LT24FB_area(rect) + _LT24FB_area(ctx->dirty[idx]) + LT24FB_MERGE_COST)) {
+                //Remove the existing entry, and rescan as the merged rectangle may now overlap others
+                rect = merged;
+                ctx->dirty[idx] = ctx->dirty[--ctx->dirtyCount];
+                idx = 0;
+            } else {
+                idx++;
+            }
+        }
+        //If there is space, add the new rectangle
+        if (ctx->dirtyCount < LT24FB_MAX_DIRTY) {
+            ctx->dirty[ctx->dirtyCount++] = rect;
+            return;
+        }
+        //Otherwise merge with whichever rectangle causes the least growth, then try again
+        unsigned int best = 0;
+        unsigned int bestGrowth = UINT32_MAX;
+        for (idx = 0; idx < ctx->dirtyCount; idx++) {
+            unsigned int growth = _LT24FB_area(_LT24FB_union(rect, ctx->dirty[idx])) - _LT24FB_area(ctx->dirty[idx]);
+            if (growth < bestGrowth) {
+                bestGrowth = growth;
+                best = idx;
+            }
+        }
+        rect = _LT24FB_union(rect, ctx->dirty[best]);
+        ctx->dirty[best] = ctx->dirty[--ctx->dirtyCount];
+    }
+}
+
+//Shrink a rectangle to the bounding box of pixels which differ between front and back
+// - Returns false if there are no differences.
+static bool _LT24FB_trimRect( LT24FBCtx_t* ctx, LT24FBRect_t* rect ) {
+    unsigned int xleft   = rect->xright;
+    unsigned int xright  = rect->xleft;
+    unsigned int ytop    = rect->ybottom;
+    unsigned int ybottom = rect->ytop;
+    for (unsigned int y = rect->ytop; y < rect->ybottom; y++) {
+        const unsigned short* front = LT24FB_PIXEL(ctx->front, 0, y);
+        const unsigned short* back  = LT24FB_PIXEL(ctx->back,  0, y);
+        //Find first differing pixel, skipping identical rows
+        unsigned int x = rect->xleft;
+        while ((x < rect->xright) && (front[x] == back[x])) x++;
+        if (x == rect->xright) continue;
+        if (x < xleft) xleft = x;
+        //Find last differing pixel. Only need to search as far as the current right edge.
+        x = rect->xright;
+        while ((x > xright) && (front[x-1] == back[x-1])) x--;
+        if (x > xright) xright = x;
+        //Row contains a difference
+        if (y < ytop) ytop = y;
+        ybottom = y + 1;
+    }
+    if ((xright <= xleft) || (ybottom <= ytop)) return false;
+    rect->xleft   = xleft;
+    rect->xright  = xright;
+    rect->ytop    = ytop;
+    rect->ybottom = ybottom;
+    return true;
+}
+
+//Shrink a rectangle to the pixels which differ, for indexed buffers
+// - As _LT24FB_trimRect(), comparing palette indices.
+static bool _LT24FB_trimRect8( LT24FBCtx_t* ctx, LT24FBRect_t* rect ) {
+    unsigned int xleft   = rect->xright;
+    unsigned int xright  = rect->xleft;
+    unsigned int ytop    = rect->ybottom;
+    unsigned int ybottom = rect->ytop;
+    for (unsigned int y = rect->ytop; y < rect->ybottom; y++) {
+        const uint8_t* front = LT24FB_PIXEL(ctx->front8, 0, y);
+        const uint8_t* back  = LT24FB_PIXEL(ctx->back8,  0, y);
+        unsigned int x = rect->xleft;
+        while ((x < rect->xright) && (front[x] == back[x])) x++;
+        if (x == rect->xright) continue;
+        if (x < xleft) xleft = x;
+        x = rect->xright;
+        while ((x > xright) && (front[x-1] == back[x-1])) x--;
+        if (x > xright) xright = x;
+        if (y < ytop) ytop = y;
+        ybottom = y + 1;
+    }
+    if ((xright <= xleft) || (ybottom <= ytop)) return false;
+    rect->xleft   = xleft;
+    rect->xright  = xright;
+    rect->ytop    = ytop;
+    rect->ybottom = ybottom;
+    return true;
+}
+
+//Expand a row of palette indices to RGB565
+// - Only one lookup per pixel, so four are done at a time to hide the
+//   load latency. NEON table lookups (VTBL) can index at most 32 bytes,
+//   too small for a 256 entry palette.
+static void _LT24FB_rowExpand( unsigned short* dst, const uint8_t* src, unsigned int count, const unsigned short* palette ) {
+    unsigned int x = 0;
+    for (; x + 4 <= count; x += 4) {
+        unsigned short p0 = palette[src[x+0]];
+        unsigned short p1 = palette[src[x+1]];
+        unsigned short p2 = palette[src[x+2]];
+        unsigned short p3 = palette[src[x+3]];
+        dst[x+0] = p0;
+        dst[x+1] = p1;
+        dst[x+2] = p2;
+        dst[x+3] = p3;
+    }
+    for (; x < count; x++) {
+        dst[x] = palette[src[x]];
+    }
+}
+
+//Send a rectangle of the indexed back buffer to the display
+static HpsErr_t _LT24FB_sendRect8( LT24FBCtx_t* ctx, LT24FBRect_t rect ) {
+    //If front buffer is valid, only send what has actually changed
+    if (ctx->frontValid && !_LT24FB_trimRect8(ctx, &rect)) return ERR_SKIPPED;
+    unsigned int width  = rect.xright  - rect.xleft;
+    unsigned int height = rect.ybottom - rect.ytop;
+    //Single window for the whole rectangle, streamed row by row through the palette
+    HpsErr_t status = LT24_setWindow(ctx->display, rect.xleft, rect.ytop, width, height);
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int y = rect.ytop; y < rect.ybottom; y++) {
+        const uint8_t* back = LT24FB_PIXEL(ctx->back8, rect.xleft, y);
+        _LT24FB_rowExpand(ctx->line, back, width, ctx->palette);
+        status = LT24_streamPixels(ctx->display, ctx->line, width);
+        if (ERR_IS_ERROR(status)) return status;
+        memcpy(LT24FB_PIXEL(ctx->front8, rect.xleft, y), back, width * sizeof(uint8_t));
+    }
+    return ERR_SUCCESS;
+}
+
+//Send a rectangle of the back buffer to the display
+static HpsErr_t _LT24FB_sendRect( LT24FBCtx_t* ctx, LT24FBRect_t rect ) {
+    if (ctx->indexed) return _LT24FB_sendRect8(ctx, rect);
+    //If front buffer is valid, only send what has actually changed
+    if (ctx->frontValid && !_LT24FB_trimRect(ctx, &rect)) return ERR_SKIPPED;
+    unsigned int width  = rect.xright  - rect.xleft;
+    unsigned int height = rect.ybottom - rect.ytop;
+    //Single window for the whole rectangle
+    HpsErr_t status = LT24_setWindow(ctx->display, rect.xleft, rect.ytop, width, height);
+    if (ERR_IS_ERROR(status)) return status;
+    if (width == LT24_WIDTH) {
+        //Full width rows are contiguous, so stream in one go
+        const unsigned short* back = LT24FB_PIXEL(ctx->back, 0, rect.ytop);
+        status = LT24_streamPixels(ctx->display, back, width * height);
+        if (ERR_IS_ERROR(status)) return status;
+        memcpy(LT24FB_PIXEL(ctx->front, 0, rect.ytop), back, width * height * sizeof(unsigned short));
+    } else {
+        //Otherwise stream row by row into the same window
+        for (unsigned int y = rect.ytop; y < rect.ybottom; y++) {
+            const unsigned short* back = LT24FB_PIXEL(ctx->back, rect.xleft, y);
+            status = LT24_streamPixels(ctx->display, back, width);
+            if (ERR_IS_ERROR(status)) return status;
+            memcpy(LT24FB_PIXEL(ctx->front, rect.xleft, y), back, width * sizeof(unsigned short));
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+//Blit operations
+typedef enum {
+    LT24FB_BLIT_COPY,
+    LT24FB_BLIT_KEYED,
+    LT24FB_BLIT_ALPHA
+} LT24FBBlitOp;
+
+//Copy a row of pixels, skipping those equal to key
+static void _LT24FB_rowKeyed( unsigned short* dst, const unsigned short* src, unsigned int count, unsigned short key ) {
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    //Select the destination wherever the source matches the key
+    uint16x8_t keys = vdupq_n_u16(key);
+    for (; x + 8 <= count; x += 8) {
+        uint16x8_t s = vld1q_u16(&src[x]);
+        uint16x8_t d = vld1q_u16(&dst[x]);
+        vst1q_u16(&dst[x], vbslq_u16(vceqq_u16(s, keys), d, s));
+    }
+#endif
+    for (; x < count; x++) {
+        if (src[x] != key) dst[x] = src[x];
+    }
+}
+
+//Blend a row of pixels over the destination
+// - Each channel is blended separately. The 6-bit green channel times 256
+//   still fits in 16 bits, so the sum of both terms can't overflow.
+static void _LT24FB_rowAlpha( unsigned short* dst, const unsigned short* src, unsigned int count, unsigned int alpha ) {
+    unsigned int inv = LT24FB_ALPHA_OPAQUE - alpha;
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint16x8_t red   = vdupq_n_u16(0x1F);
+    uint16x8_t green = vdupq_n_u16(0x3F);
+    for (; x + 8 <= count; x += 8) {
+        uint16x8_t s = vld1q_u16(&src[x]);
+        uint16x8_t d = vld1q_u16(&dst[x]);
+        uint16x8_t r = vmlaq_n_u16(vmulq_n_u16(vshrq_n_u16(s, 11), alpha), vshrq_n_u16(d, 11), inv);
+        uint16x8_t g = vmlaq_n_u16(vmulq_n_u16(vandq_u16(vshrq_n_u16(s, 5), green), alpha), vandq_u16(vshrq_n_u16(d, 5), green), inv);
+        uint16x8_t b = vmlaq_n_u16(vmulq_n_u16(vandq_u16(s, red), alpha), vandq_u16(d, red), inv);
+        //Back to 565. Red is already in range after the shift, so needs no mask.
+        uint16x8_t out = vshlq_n_u16(vshrq_n_u16(r, 8), 11);
+        out = vorrq_u16(out, vshlq_n_u16(vshrq_n_u16(g, 8), 5));
+        out = vorrq_u16(out, vshrq_n_u16(b, 8));
+        vst1q_u16(&dst[x], out);
+    }
+#endif
+    for (; x < count; x++) {
+        unsigned int s = src[x];
+        unsigned int d = dst[x];
+        unsigned int r = (((s >> 11)        ) * alpha + ((d >> 11)        ) * inv) >> 8;
+        unsigned int g = (((s >>  5) & 0x3F) * alpha + ((d >>  5) & 0x3F) * inv) >> 8;
+        unsigned int b = (((s      ) & 0x1F) * alpha + ((d      ) & 0x1F) * inv) >> 8;
+        dst[x] = (unsigned short)((r << 11) | (g << 5) | b);
+    }
+}
+
+//Clip an image at (x,y) to the display
+// - Done in 64-bit so large images and offsets can't wrap.
+// - Returns false if the image is entirely off the display.
+static bool _LT24FB_clipImage( int x, int y, unsigned int width, unsigned int height, LT24FBRect_t* rect ) {
+    int64_t xleft   = x;
+    int64_t ytop    = y;
+    int64_t xright  = xleft + width;
+    int64_t ybottom = ytop  + height;
+    if (xleft   < 0          ) xleft   = 0;
+    if (ytop    < 0          ) ytop    = 0;
+    if (xright  > LT24_WIDTH ) xright  = LT24_WIDTH;
+    if (ybottom > LT24_HEIGHT) ybottom = LT24_HEIGHT;
+    if ((xright <= xleft) || (ybottom <= ytop)) return false;
+    *rect = (LT24FBRect_t){ (unsigned short)xleft, (unsigned short)ytop, (unsigned short)xright, (unsigned short)ybottom };
+    return true;
+}
+
+//Clip an image to the display and draw it with the given operation
+static HpsErr_t _LT24FB_blit( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y, LT24FBBlitOp op, unsigned int param ) {
+    if (!image || !image->pixels) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->indexed) return ERR_WRONGMODE;
+    unsigned int stride = image->stride ? image->stride : image->width;
+    if (stride < image->width) return LT24_INVALIDSHAPE;
+    LT24FBRect_t rect;
+    if (!_LT24FB_clipImage(x, y, image->width, image->height, &rect)) return ERR_SKIPPED;
+    unsigned int width = rect.xright - rect.xleft;
+    //Then draw each visible row
+    const unsigned short* src = image->pixels + (((int64_t)rect.ytop - y) * stride) + ((int64_t)rect.xleft - x);
+    for (unsigned int row = rect.ytop; row < rect.ybottom; row++) {
+        unsigned short* dst = LT24FB_PIXEL(ctx->back, rect.xleft, row);
+        switch (op) {
+            case LT24FB_BLIT_KEYED:
+                _LT24FB_rowKeyed(dst, src, width, (unsigned short)param);
+                break;
+            case LT24FB_BLIT_ALPHA:
+                _LT24FB_rowAlpha(dst, src, width, param);
+                break;
+            default:
+                memcpy(dst, src, width * sizeof(unsigned short));
+                break;
+        }
+        src += stride;
+    }
+    _LT24FB_addDirty(ctx, rect);
+    return ERR_SUCCESS;
+}
+
+//Copy a row of palette indices, skipping those equal to key
+static void _LT24FB_rowKeyed8( uint8_t* dst, const uint8_t* src, unsigned int count, uint8_t key ) {
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    //Select the destination wherever the source matches the key
+    uint8x16_t keys = vdupq_n_u8(key);
+    for (; x + 16 <= count; x += 16) {
+        uint8x16_t s = vld1q_u8(&src[x]);
+        uint8x16_t d = vld1q_u8(&dst[x]);
+        vst1q_u8(&dst[x], vbslq_u8(vceqq_u8(s, keys), d, s));
+    }
+#endif
+    for (; x < count; x++) {
+        if (src[x] != key) dst[x] = src[x];
+    }
+}
+
+//Clip an indexed image to the display and draw it, optionally with a colour key
+static HpsErr_t _LT24FB_blitIndexed( LT24FBCtx_t* ctx, const LT24FBIndexedImage_t* image, int x, int y, bool keyed, uint8_t key ) {
+    if (!image || !image->pixels) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->indexed) return ERR_WRONGMODE;
+    unsigned int stride = image->stride ? image->stride : image->width;
+    if (stride < image->width) return LT24_INVALIDSHAPE;
+    LT24FBRect_t rect;
+    if (!_LT24FB_clipImage(x, y, image->width, image->height, &rect)) return ERR_SKIPPED;
+    unsigned int width = rect.xright - rect.xleft;
+    //Then draw each visible row
+    const uint8_t* src = image->pixels + (((int64_t)rect.ytop - y) * stride) + ((int64_t)rect.xleft - x);
+    for (unsigned int row = rect.ytop; row < rect.ybottom; row++) {
+        uint8_t* dst = LT24FB_PIXEL(ctx->back8, rect.xleft, row);
+        if (keyed) {
+            _LT24FB_rowKeyed8(dst, src, width, key);
+        } else {
+            memcpy(dst, src, width * sizeof(uint8_t));
+        }
+        src += stride;
+    }
+    _LT24FB_addDirty(ctx, rect);
+    return ERR_SUCCESS;
+}
+
+//Frame tick for paced presentation
+// - Sends the latched rows from the front buffer.
+static HpsErr_t _LT24FB_presentTick( Event_t* event, void* param ) {
+    LT24FBCtx_t* ctx = (LT24FBCtx_t*)param;
+    //Previous frame still going out, so this one waits for the next tick
+    if (LT24_copyFrameBufferDone(ctx->display) == ERR_BUSY) {
+        ctx->presentStats.late++;
+        return ERR_AGAIN;
+    }
+    if (ctx->presentTop == ctx->presentBottom) {
+        ctx->presentStats.idle++;
+        return ERR_AGAIN;
+    }
+    unsigned int ytop = ctx->presentTop;
+    unsigned int height = ctx->presentBottom - ytop;
+    const unsigned short* front = LT24FB_PIXEL(ctx->front, 0, ytop);
+    HpsErr_t status;
+    if (ctx->presentSync) {
+        status = LT24_copyFrameBufferDmaSync(ctx->display, ctx->presentDma, ctx->presentDmaParams, front, 0, ytop, LT24_WIDTH, height);
+    } else {
+        status = LT24_copyFrameBufferDma(ctx->display, ctx->presentDma, ctx->presentDmaParams, front, 0, ytop, LT24_WIDTH, height);
+    }
+    if (ERR_IS_ERROR(status) && (status != ERR_SKIPPED)) {
+        //Keep the frame latched to try again next tick
+        ctx->presentStats.errors++;
+        return ERR_AGAIN;
+    }
+    ctx->presentTop = ctx->presentBottom = 0;
+    ctx->presentStats.presented++;
+    ctx->frontValid = true;
+    return ERR_AGAIN;
+}
+
+//Cleanup
+static void _LT24FB_cleanup( LT24FBCtx_t* ctx ) {
+    if (ctx->presentEvent) {
+        Event_destroy(ctx->presentEvent);
+        ctx->presentEvent = NULL;
+    }
+    if (ctx->front) {
+        MemPool_free(ctx->front);
+        ctx->front = NULL;
+    }
+    if (ctx->back) {
+        MemPool_free(ctx->back);
+        ctx->back = NULL;
+    }
+    if (ctx->front8) {
+        MemPool_free(ctx->front8);
+        ctx->front8 = NULL;
+    }
+    if (ctx->back8) {
+        MemPool_free(ctx->back8);
+        ctx->back8 = NULL;
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the frame buffer driver
+// - display is an initialised LT24 driver instance.
+// - The back buffer is initially cleared to black, and the whole
+//   display is marked dirty.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24FB_initialise( LT24Ctx_t* display, LT24FBCtx_t** pCtx ) {
+    //Check if the LT24 display has been initialised (required)
+    if (!LT24_isInitialised(display)) return ERR_BADDEVICE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_LT24FB_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save display pointer
+    LT24FBCtx_t* ctx = *pCtx;
+    ctx->display = display;
+    //Allocate the frame buffers
+    ctx->front = MemPool_malloc(LT24FB_BUFSIZE);
+    ctx->back  = MemPool_malloc(LT24FB_BUFSIZE);
+    if (!ctx->front || !ctx->back) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    //Start with a black back buffer. Display content is unknown so redraw everything on first flip.
+    memset(ctx->back, 0, LT24FB_BUFSIZE);
+    ctx->frontValid = false;
+    ctx->dirty[0] = (LT24FBRect_t){ 0, 0, LT24_WIDTH, LT24_HEIGHT };
+    ctx->dirtyCount = 1;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Initialise the frame buffer driver in indexed colour mode
+// - As LT24FB_initialise(), but with 8-bit palette index buffers.
+// - The back buffer is cleared to index 0, and the palette set to 3-3-2 RGB.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24FB_initialiseIndexed( LT24Ctx_t* display, LT24FBCtx_t** pCtx ) {
+    //Check if the LT24 display has been initialised (required)
+    if (!LT24_isInitialised(display)) return ERR_BADDEVICE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_LT24FB_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save display pointer
+    LT24FBCtx_t* ctx = *pCtx;
+    ctx->display = display;
+    ctx->indexed = true;
+    //Allocate the frame buffers
+    ctx->front8 = MemPool_malloc(LT24FB_BUFSIZE8);
+    ctx->back8  = MemPool_malloc(LT24FB_BUFSIZE8);
+    if (!ctx->front8 || !ctx->back8) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    //Default 3-3-2 palette. Each field is scaled up to the full 565 range.
+    for (unsigned int idx = 0; idx < LT24FB_PALETTE_SIZE; idx++) {
+        unsigned int r = (idx >> 5) & 0x7;
+        unsigned int g = (idx >> 2) & 0x7;
+        unsigned int b = (idx     ) & 0x3;
+        ctx->palette[idx] = LT24_makeColour((r * 0x1F) / 0x7, (g * 0x3F) / 0x7, (b * 0x1F) / 0x3);
+    }
+    //Start with a black back buffer. Display content is unknown so redraw everything on first flip.
+    memset(ctx->back8, 0, LT24FB_BUFSIZE8);
+    ctx->frontValid = false;
+    ctx->dirty[0] = (LT24FBRect_t){ 0, 0, LT24_WIDTH, LT24_HEIGHT };
+    ctx->dirtyCount = 1;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+bool LT24FB_isInitialised( LT24FBCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Get the back buffer
+// - Returns pointer to LT24_WIDTH x LT24_HEIGHT RGB565 buffer via *buf.
+//   Pixel (x,y) is at (*buf)[y * LT24_WIDTH + x].
+// - Any area changed must be reported with LT24FB_markDirty().
+HpsErr_t LT24FB_getBackBuffer( LT24FBCtx_t* ctx, unsigned short** buf ) {
+    if (!buf) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->indexed) return ERR_WRONGMODE;
+    *buf = ctx->back;
+    return ERR_SUCCESS;
+}
+
+//Get the indexed back buffer
+// - Returns pointer to LT24_WIDTH x LT24_HEIGHT palette index buffer via *buf.
+//   Pixel (x,y) is at (*buf)[y * LT24_WIDTH + x].
+// - Any area changed must be reported with LT24FB_markDirty().
+// - Returns ERR_WRONGMODE if not in indexed mode.
+HpsErr_t LT24FB_getIndexedBuffer( LT24FBCtx_t* ctx, uint8_t** buf ) {
+    if (!buf) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->indexed) return ERR_WRONGMODE;
+    *buf = ctx->back8;
+    return ERR_SUCCESS;
+}
+
+//Set palette entries
+// - Sets count entries starting from first to the RGB565 colours array.
+// - If any entry changes, the whole display is redrawn on the next flip.
+// - Returns ERR_WRONGMODE if not in indexed mode.
+// - Returns ERR_OUTRANGE if the entries are beyond the end of the palette.
+HpsErr_t LT24FB_setPalette( LT24FBCtx_t* ctx, unsigned int first, unsigned int count, const unsigned short* colours ) {
+    if (!colours && count) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->indexed) return ERR_WRONGMODE;
+    if ((first > LT24FB_PALETTE_SIZE) || (count > (LT24FB_PALETTE_SIZE - first))) return ERR_OUTRANGE;
+    //Update the palette, checking if anything changed
+    bool changed = false;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        if (ctx->palette[first + idx] != colours[idx]) {
+            ctx->palette[first + idx] = colours[idx];
+            changed = true;
+        }
+    }
+    //Pixels with changed entries may be anywhere, so redraw everything
+    if (changed) return LT24FB_invalidate(ctx);
+    return ERR_SUCCESS;
+}
+
+//Mark a region of the back buffer as changed
+// - The region is clipped to the display.
+// - Returns ERR_SKIPPED if the clipped region is empty.
+HpsErr_t LT24FB_markDirty( LT24FBCtx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Clip to the display
+    if ((xleft >= LT24_WIDTH) || (ytop >= LT24_HEIGHT)) return ERR_SKIPPED;
+    if (width  > (LT24_WIDTH  - xleft)) width  = LT24_WIDTH  - xleft;
+    if (height > (LT24_HEIGHT - ytop )) height = LT24_HEIGHT - ytop;
+    if (!width || !height) return ERR_SKIPPED;
+    //And add to the list
+    _LT24FB_addDirty(ctx, (LT24FBRect_t){ xleft, ytop, xleft + width, ytop + height });
+    return ERR_SUCCESS;
+}
+
+//Invalidate the whole display
+// - Next flip will redraw the entire display regardless of
+//   the contents of the front buffer.
+HpsErr_t LT24FB_invalidate( LT24FBCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Whole display dirty, and don't trust front buffer.
+    ctx->frontValid = false;
+    ctx->dirty[0] = (LT24FBRect_t){ 0, 0, LT24_WIDTH, LT24_HEIGHT };
+    ctx->dirtyCount = 1;
+    return ERR_SUCCESS;
+}
+
+//Plot a single pixel in the back buffer
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24FB_drawPixel( LT24FBCtx_t* ctx, unsigned short colour, unsigned int x, unsigned int y ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Ensure pixel is on the display
+    if ((x >= LT24_WIDTH) || (y >= LT24_HEIGHT)) return LT24_INVALIDSIZE;
+    //Draw and mark dirty
+    if (ctx->indexed) {
+        if (colour >= LT24FB_PALETTE_SIZE) return ERR_OUTRANGE;
+        *LT24FB_PIXEL(ctx->back8, x, y) = (uint8_t)colour;
+    } else {
+        *LT24FB_PIXEL(ctx->back, x, y) = colour;
+    }
+    _LT24FB_addDirty(ctx, (LT24FBRect_t){ x, y, x + 1, y + 1 });
+    return ERR_SUCCESS;
+}
+
+//Fill a rectangle of the back buffer with a colour
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24FB_fillRect( LT24FBCtx_t* ctx, unsigned short colour, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Ensure region is on the display
+    status = _LT24FB_checkRegion(xleft, ytop, width, height);
+    if (ERR_IS_ERROR(status)) return status;
+    //Fill each row
+    if (ctx->indexed) {
+        if (colour >= LT24FB_PALETTE_SIZE) return ERR_OUTRANGE;
+        for (unsigned int y = ytop; y < ytop + height; y++) {
+            memset(LT24FB_PIXEL(ctx->back8, xleft, y), colour, width);
+        }
+    } else {
+        for (unsigned int y = ytop; y < ytop + height; y++) {
+            unsigned short* row = LT24FB_PIXEL(ctx->back, xleft, y);
+            for (unsigned int x = 0; x < width; x++) {
+                row[x] = colour;
+            }
+        }
+    }
+    _LT24FB_addDirty(ctx, (LT24FBRect_t){ xleft, ytop, xleft + width, ytop + height });
+    return ERR_SUCCESS;
+}
+
+//Copy an image into the back buffer
+// - image is a width x height RGB565 array, stored row by row.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24FB_copyRect( LT24FBCtx_t* ctx, const unsigned short* image, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    if (!image) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->indexed) return ERR_WRONGMODE;
+    //Ensure region is on the display
+    status = _LT24FB_checkRegion(xleft, ytop, width, height);
+    if (ERR_IS_ERROR(status)) return status;
+    //Copy each row
+    for (unsigned int y = ytop; y < ytop + height; y++) {
+        memcpy(LT24FB_PIXEL(ctx->back, xleft, y), image, width * sizeof(unsigned short));
+        image += width;
+    }
+    _LT24FB_addDirty(ctx, (LT24FBRect_t){ xleft, ytop, xleft + width, ytop + height });
+    return ERR_SUCCESS;
+}
+
+//Copy an image into the back buffer, clipped to the display
+// - (x,y) is the position of the top left of the image, which may be
+//   off the display.
+// - Returns ERR_SKIPPED if the image is entirely off the display.
+HpsErr_t LT24FB_blit( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y ) {
+    return _LT24FB_blit(ctx, image, x, y, LT24FB_BLIT_COPY, 0);
+}
+
+//Copy an image into the back buffer, skipping transparent pixels
+// - As LT24FB_blit(), but pixels equal to key are not drawn.
+HpsErr_t LT24FB_blitKeyed( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned short key ) {
+    return _LT24FB_blit(ctx, image, x, y, LT24FB_BLIT_KEYED, key);
+}
+
+//Blend an image over the back buffer
+// - As LT24FB_blit(), but each pixel is blended as
+//   (image * alpha + back * (LT24FB_ALPHA_OPAQUE - alpha)) / LT24FB_ALPHA_OPAQUE
+// - alpha is from 0 (transparent) to LT24FB_ALPHA_OPAQUE.
+// - Returns ERR_OUTRANGE if alpha is above LT24FB_ALPHA_OPAQUE.
+HpsErr_t LT24FB_blitAlpha( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned int alpha ) {
+    if (alpha > LT24FB_ALPHA_OPAQUE) return ERR_OUTRANGE;
+    //A plain copy if opaque
+    if (alpha == LT24FB_ALPHA_OPAQUE) return _LT24FB_blit(ctx, image, x, y, LT24FB_BLIT_COPY, 0);
+    return _LT24FB_blit(ctx, image, x, y, LT24FB_BLIT_ALPHA, alpha);
+}
+
+//Draw an image scaled to a new size, clipped to the display
+// - The image is scaled to width x height pixels with its top left at
+//   (x,y), which may be off the display. Only the visible part is scaled.
+// - filter is IMAGE_SCALE_NEAREST or IMAGE_SCALE_BILINEAR.
+// - Returns ERR_SKIPPED if the scaled image is entirely off the display.
+// - Returns ERR_TOOBIG if the image or scaled size is over IMAGE_SCALE_MAX_SIZE.
+HpsErr_t LT24FB_blitScaled( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned int width, unsigned int height, ImageScaleFilter filter ) {
+    if (!image || !image->pixels) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->indexed) return ERR_WRONGMODE;
+    unsigned int stride = image->stride ? image->stride : image->width;
+    if (stride < image->width) return LT24_INVALIDSHAPE;
+    LT24FBRect_t rect;
+    if (!_LT24FB_clipImage(x, y, width, height, &rect)) return ERR_SKIPPED;
+    //Scale only the visible window
+    ImageScaleWindow_t window = {
+        width, height,
+        (unsigned int)((int64_t)rect.xleft - x), (unsigned int)((int64_t)rect.ytop - y),
+        rect.xright - rect.xleft, rect.ybottom - rect.ytop
+    };
+    status = ImageScale_rgb565(LT24FB_PIXEL(ctx->back, rect.xleft, rect.ytop), LT24_WIDTH, image->pixels, stride,
+                               image->width, image->height, &window, filter);
+    if (ERR_IS_ERROR(status)) return status;
+    _LT24FB_addDirty(ctx, rect);
+    return ERR_SUCCESS;
+}
+
+//Copy an indexed image into the back buffer, clipped to the display
+// - As LT24FB_blit(), for indexed mode.
+// - Returns ERR_WRONGMODE if not in indexed mode.
+HpsErr_t LT24FB_blitIndexed( LT24FBCtx_t* ctx, const LT24FBIndexedImage_t* image, int x, int y ) {
+    return _LT24FB_blitIndexed(ctx, image, x, y, false, 0);
+}
+
+//Copy an indexed image into the back buffer, skipping transparent pixels
+// - As LT24FB_blitIndexed(), but pixels equal to index key are not drawn.
+HpsErr_t LT24FB_blitIndexedKeyed( LT24FBCtx_t* ctx, const LT24FBIndexedImage_t* image, int x, int y, uint8_t key ) {
+    return _LT24FB_blitIndexed(ctx, image, x, y, true, key);
+}
+
+//Send all changes to the display
+// - Only the dirty rectangles, trimmed to the pixels which differ
+//   from the front buffer, are sent.
+// - Returns ERR_SKIPPED if there was nothing to send.
+// - If an error occurs, any rectangles not yet sent remain dirty and
+//   will be sent on the next call.
+HpsErr_t LT24FB_flip( LT24FBCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Send each dirty rectangle, removing it from the list once sent
+    bool sent = false;
+    while (ctx->dirtyCount) {
+        ResetWDT();
+        status = _LT24FB_sendRect(ctx, ctx->dirty[ctx->dirtyCount - 1]);
+        if (ERR_IS_ERROR(status)) return status;
+        if (status != ERR_SKIPPED) sent = true;
+        ctx->dirtyCount--;
+    }
+    //Front buffer now matches the display
+    ctx->frontValid = true;
+    return sent ? ERR_SUCCESS : ERR_SKIPPED;
+}
+
+//Present frames by DMA at a fixed rate
+// - evtMgr is the event manager which times the frames, and fps the frame rate.
+//   If pacing is already set up, the rate and DMA settings are changed.
+// - dma and dmaParams are as for LT24_copyFrameBufferDma().
+// - If teSync is true, copies start on the next tearing effect edge, as for
+//   LT24_copyFrameBufferDmaSync().
+// - Pass fps as 0 to stop pacing. Any latched frame is discarded.
+// - Returns ERR_WRONGMODE in indexed mode.
+HpsErr_t LT24FB_setPacing( LT24FBCtx_t* ctx, EventMgrCtx_t* evtMgr, unsigned int fps, DmaCtx_t* dma, void* dmaParams, bool teSync ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->indexed) return ERR_WRONGMODE;
+    //Stopping
+    ctx->presentTop = ctx->presentBottom = 0;
+    if (!fps) {
+        if (ctx->presentEvent) {
+            Event_destroy(ctx->presentEvent);
+            ctx->presentEvent = NULL;
+        }
+        return ERR_SUCCESS;
+    }
+    if (!EventMgr_isInitialised(evtMgr)) return ERR_BADDEVICE;
+    if (!DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    if (ctx->presentEvent && (ctx->presentEvent->evtMgrCtx != evtMgr)) return ERR_INUSE;
+    //Convert the frame rate to event timer ticks
+    unsigned int rate;
+    status = Timer_getRate(evtMgr->timer, UINT32_MAX, &rate);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!rate) return ERR_NOSUPPORT;
+    unsigned int interval = (rate + fps / 2) / fps;
+    if (!interval) return ERR_TOOBIG;
+    ctx->presentDma = dma;
+    ctx->presentDmaParams = dmaParams;
+    ctx->presentSync = teSync;
+    if (ctx->presentEvent) {
+        status = Event_state(ctx->presentEvent, EVENT_CNTRL_RESTART, interval);
+        return ERR_IS_ERROR(status) ? status : ERR_SUCCESS;
+    }
+    memset(&ctx->presentStats, 0, sizeof(ctx->presentStats));
+    return Event_create(evtMgr, EVENT_TYPE_REPEAT, interval, &_LT24FB_presentTick, ctx, &ctx->presentEvent);
+}
+
+//Submit the back buffer as the next frame
+// - Copies the rows covering all dirty rectangles to the front buffer, to be
+//   sent on the next frame tick. The back buffer can be drawn to straight away.
+// - If a frame is already waiting, the two are combined and the earlier one
+//   is counted as dropped.
+// - Returns ERR_BUSY if the previous frame is still being copied.
+// - Returns ERR_SKIPPED if nothing is dirty.
+// - Returns ERR_WRONGMODE if not pacing.
+HpsErr_t LT24FB_submit( LT24FBCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->presentEvent) return ERR_WRONGMODE;
+    //The front buffer can't change while the DMA is reading it
+    if (LT24_copyFrameBufferDone(ctx->display) == ERR_BUSY) return ERR_BUSY;
+    if (!ctx->dirtyCount) return ERR_SKIPPED;
+    //Band of rows covering all dirty rectangles
+    unsigned int ytop = LT24_HEIGHT;
+    unsigned int ybottom = 0;
+    for (unsigned int idx = 0; idx < ctx->dirtyCount; idx++) {
+        if (ctx->dirty[idx].ytop    < ytop   ) ytop    = ctx->dirty[idx].ytop;
+        if (ctx->dirty[idx].ybottom > ybottom) ybottom = ctx->dirty[idx].ybottom;
+    }
+    memcpy(LT24FB_PIXEL(ctx->front, 0, ytop), LT24FB_PIXEL(ctx->back, 0, ytop), (ybottom - ytop) * LT24_WIDTH * sizeof(unsigned short));
+    ctx->dirtyCount = 0;
+    //Combine with any frame not yet sent
+    if (ctx->presentTop != ctx->presentBottom) {
+        ctx->presentStats.dropped++;
+        if (ctx->presentTop    < ytop   ) ytop    = ctx->presentTop;
+        if (ctx->presentBottom > ybottom) ybottom = ctx->presentBottom;
+    }
+    ctx->presentTop = ytop;
+    ctx->presentBottom = ybottom;
+    return ERR_SUCCESS;
+}
+
+//Get the paced presentation statistics
+// - Copies the counts to *stats. If clear is true, they are then reset.
+HpsErr_t LT24FB_getPresentStats( LT24FBCtx_t* ctx, LT24FBPresentStats_t* stats, bool clear ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!stats) return ERR_NULLPTR;
+    *stats = ctx->presentStats;
+    if (clear) memset(&ctx->presentStats, 0, sizeof(ctx->presentStats));
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,351 @@
+/*
+ * LT24 Double Buffered Frame Buffer
+ * ---------------------------------
+ * Description:
+ * Double buffered display layer for the LT24 Display Controller
+ *
+ * Maintains a pair of full screen RGB565 frame buffers on top
+ * of an LT24Ctx_t instance:
+ *
+ *  - The back buffer is where all drawing takes place.
+ *  - The front buffer is a copy of what is currently shown on
+ *    the display.
+ *
+ * Every drawing operation records the rectangle it changed.
+ * When LT24FB_flip() is called, only those rectangles are sent
+ * to the display, each using a single LT24_setWindow() followed
+ * by a stream of pixels. Before sending, each rectangle is
+ * compared against the front buffer and shrunk to the area
+ * which actually differs, so redrawing unchanged content costs
+ * no bus traffic.
+ *
+ * Nearby rectangles are merged when the merged area is not much
+ * larger than the sum of the two, as the window setup overhead
+ * would otherwise outweigh the extra pixels. At most
+ * LT24FB_MAX_DIRTY rectangles are tracked at once. Beyond that
+ * the closest pair are merged.
+ *
+ * If drawing directly into the back buffer (LT24FB_getBackBuffer),
+ * call LT24FB_markDirty() with the affected area before flipping.
+ * If the display is written to by anything other than this driver,
+ * call LT24FB_invalidate() so that the next flip redraws everything.
+ *
+ * The two frame buffers are allocated from the heap, requiring
+ * 2 x 150kB of memory.
+ *
+ * Blitting
+ * --------
+ *
+ * Images (sprites, gauge needles, etc.) can be drawn into the back
+ * buffer at any position, including partly or wholly off screen, as
+ * they are clipped to the display:
+ *
+ *  - LT24FB_blit() copies the image.
+ *  - LT24FB_blitKeyed() skips pixels matching a colour key, so the
+ *    image can have a transparent background.
+ *  - LT24FB_blitAlpha() blends the image over the back buffer with
+ *    a constant alpha.
+ *  - LT24FB_blitScaled() draws the image scaled to any size, with
+ *    nearest neighbour or bilinear filtering (Util/image_scale.h),
+ *    e.g. for thumbnails or zoomed views. Only the visible part of
+ *    the scaled image is computed.
+ *
+ * When built with NEON support, keyed, blended and bilinear scaled
+ * blits process 8 pixels per instruction.
+ *
+ * Indexed Colour
+ * --------------
+ *
+ * Initialising with LT24FB_initialiseIndexed() instead uses 8-bit
+ * frame buffers, where each pixel is an index into a 256 entry
+ * RGB565 palette, halving the memory (2 x 75kB) and the drawing
+ * bandwidth. Pixels are expanded to RGB565 through the palette
+ * one row at a time as they are sent by LT24FB_flip().
+ *
+ *  - LT24FB_drawPixel() and LT24FB_fillRect() take a palette index
+ *    as the colour.
+ *  - LT24FB_getIndexedBuffer(), LT24FB_blitIndexed() and
+ *    LT24FB_blitIndexedKeyed() replace the RGB565 buffer and blit
+ *    APIs, which return ERR_WRONGMODE in this mode.
+ *  - LT24FB_setPalette() changes palette entries. If any entry
+ *    changes, the next flip redraws the whole display, so palette
+ *    animation (colour cycling, fades) needs no drawing at all.
+ *
+ * The default palette is 3-3-2 RGB (index bits RRRGGGBB).
+ *
+ * Paced Presentation
+ * ------------------
+ *
+ * Instead of flipping, the display can be updated by DMA at a fixed
+ * frame rate, timed by an event manager (Util/event.h), so that the
+ * renderer never waits for the display bus:
+ *
+ *    LT24FB_setPacing(fb, evtMgr, 30, dma, &dmaParams, false);
+ *    while (1) {
+ *        drawScene(fb);
+ *        while (LT24FB_submit(fb) == ERR_BUSY) {
+ *            Event_process(evtMgr);  // Or render ahead
+ *        }
+ *        Event_process(evtMgr);
+ *    }
+ *
+ * LT24FB_submit() latches the finished frame: the band of rows
+ * covering all dirty rectangles is copied from the back buffer to
+ * the front buffer, and the back buffer may be drawn to straight
+ * away. On each frame tick the latched band is sent from the front
+ * buffer with LT24_copyFrameBufferDma() (full width rows are
+ * contiguous, so one transfer covers the band), or queued for the
+ * tearing effect edge with LT24_copyFrameBufferDmaSync().
+ *
+ * As the DMA reads the front buffer, LT24FB_submit() returns
+ * ERR_BUSY while a copy is in progress. A frame submitted twice
+ * between ticks replaces the first, which is counted as dropped.
+ * A tick on which the previous copy is still running is counted as
+ * late, and the frame waits for the next tick. LT24FB_getPresentStats()
+ * reports these counts.
+ *
+ * Call LT24FB_submit() from the same core and context as the event
+ * manager's Event_process. While pacing, don't use LT24FB_flip() or
+ * other LT24 APIs on the display. Pacing needs RGB565 buffers, so is
+ * not available in indexed mode.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add scaled blits with nearest and bilinear filtering
+ * 14/10/2026 | Add DMA presentation paced at a fixed frame rate
+ * 14/10/2026 | Add palettised 8-bit frame buffer mode
+ * 14/10/2026 | Add clipped sprite blits with colour key and alpha blend
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_LT24FRAMEBUFFER_H_
+#define DE1SOC_LT24FRAMEBUFFER_H_
+
+//Include required header files
+#include <stdint.h>
+#include "Util/driver_ctx.h"
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "Util/event.h"
+#include "Util/image_scale.h"
+
+//Maximum number of dirty rectangles tracked between flips
+#ifndef LT24FB_MAX_DIRTY
+#define LT24FB_MAX_DIRTY  8
+#endif
+
+//Overhead of a window setup expressed in pixels. Two rectangles
+//will be merged if the merged rectangle contains no more than this
+//many pixels in addition to those in the two rectangles.
+#ifndef LT24FB_MERGE_COST
+#define LT24FB_MERGE_COST 64
+#endif
+
+//Dirty rectangle
+// - Right and bottom edges are exclusive
+typedef struct {
+    unsigned short xleft;
+    unsigned short ytop;
+    unsigned short xright;
+    unsigned short ybottom;
+} LT24FBRect_t;
+
+//Blit source image
+// - Pixel (x,y) is at pixels[y * stride + x]. A stride of 0 means the
+//   same as the width, so a sub-image of a sprite sheet can be used.
+typedef struct {
+    const unsigned short* pixels;
+    unsigned int width;
+    unsigned int height;
+    unsigned int stride;
+} LT24FBImage_t;
+
+//Indexed blit source image
+// - As LT24FBImage_t, but each pixel is a palette index.
+typedef struct {
+    const uint8_t* pixels;
+    unsigned int width;
+    unsigned int height;
+    unsigned int stride;
+} LT24FBIndexedImage_t;
+
+//Paced presentation statistics
+typedef struct {
+    unsigned int presented;  // Frames sent to the display
+    unsigned int dropped;    // Submitted frames replaced before being sent
+    unsigned int late;       // Ticks on which the previous copy was still running
+    unsigned int idle;       // Ticks with no new frame to send
+    unsigned int errors;     // Ticks on which the copy failed to start
+} LT24FBPresentStats_t;
+
+//Number of palette entries in indexed mode
+#define LT24FB_PALETTE_SIZE 256
+
+//Fully opaque blend alpha
+#define LT24FB_ALPHA_OPAQUE 256
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    LT24Ctx_t* display;
+    unsigned short* front;   // Copy of what is currently on the display
+    unsigned short* back;    // Drawing buffer
+    bool frontValid;         // Whether front buffer is known to match display
+    // Indexed colour mode
+    bool indexed;            // Whether 8-bit buffers are used instead of front/back
+    uint8_t* front8;
+    uint8_t* back8;
+    unsigned short palette[LT24FB_PALETTE_SIZE];
+    unsigned short line[LT24_WIDTH]; // Row expanded through the palette for sending
+    // Dirty rectangle list
+    LT24FBRect_t dirty[LT24FB_MAX_DIRTY];
+    unsigned int dirtyCount;
+    // Paced presentation
+    Event_t*     presentEvent; // Frame tick, or NULL if not paced
+    DmaCtx_t*    presentDma;
+    void*        presentDmaParams;
+    bool         presentSync;  // Queue copies for the tearing effect edge
+    unsigned int presentTop;   // Rows latched for the next tick, none if top == bottom
+    unsigned int presentBottom;
+    LT24FBPresentStats_t presentStats;
+} LT24FBCtx_t;
+
+//Initialise the frame buffer driver
+// - display is an initialised LT24 driver instance.
+// - The back buffer is initially cleared to black, and the whole
+//   display is marked dirty.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24FB_initialise( LT24Ctx_t* display, LT24FBCtx_t** pCtx );
+
+//Initialise the frame buffer driver in indexed colour mode
+// - As LT24FB_initialise(), but with 8-bit palette index buffers.
+// - The back buffer is cleared to index 0, and the palette set to 3-3-2 RGB.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24FB_initialiseIndexed( LT24Ctx_t* display, LT24FBCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool LT24FB_isInitialised( LT24FBCtx_t* ctx );
+
+//Get the back buffer
+// - Returns pointer to LT24_WIDTH x LT24_HEIGHT RGB565 buffer via *buf.
+//   Pixel (x,y) is at (*buf)[y * LT24_WIDTH + x].
+// - Any area changed must be reported with LT24FB_markDirty().
+HpsErr_t LT24FB_getBackBuffer( LT24FBCtx_t* ctx, unsigned short** buf );
+
+//Get the indexed back buffer
+// - Returns pointer to LT24_WIDTH x LT24_HEIGHT palette index buffer via *buf.
+//   Pixel (x,y) is at (*buf)[y * LT24_WIDTH + x].
+// - Any area changed must be reported with LT24FB_markDirty().
+// - Returns ERR_WRONGMODE if not in indexed mode.
+HpsErr_t LT24FB_getIndexedBuffer( LT24FBCtx_t* ctx, uint8_t** buf );
+
+//Set palette entries
+// - Sets count entries starting from first to the RGB565 colours array.
+// - If any entry changes, the whole display is redrawn on the next flip.
+// - Returns ERR_WRONGMODE if not in indexed mode.
+// - Returns ERR_OUTRANGE if the entries are beyond the end of the palette.
+HpsErr_t LT24FB_setPalette( LT24FBCtx_t* ctx, unsigned int first, unsigned int count, const unsigned short* colours );
+
+//Mark a region of the back buffer as changed
+// - The region is clipped to the display.
+// - Returns ERR_SKIPPED if the clipped region is empty.
+HpsErr_t LT24FB_markDirty( LT24FBCtx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Invalidate the whole display
+// - Next flip will redraw the entire display regardless of
+//   the contents of the front buffer.
+HpsErr_t LT24FB_invalidate( LT24FBCtx_t* ctx );
+
+//Plot a single pixel in the back buffer
+// - In indexed mode, colour is a palette index.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24FB_drawPixel( LT24FBCtx_t* ctx, unsigned short colour, unsigned int x, unsigned int y );
+
+//Fill a rectangle of the back buffer with a colour
+// - In indexed mode, colour is a palette index.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24FB_fillRect( LT24FBCtx_t* ctx, unsigned short colour, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Copy an image into the back buffer
+// - image is a width x height RGB565 array, stored row by row.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24FB_copyRect( LT24FBCtx_t* ctx, const unsigned short* image, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Copy an image into the back buffer, clipped to the display
+// - (x,y) is the position of the top left of the image, which may be
+//   off the display.
+// - Returns ERR_SKIPPED if the image is entirely off the display.
+HpsErr_t LT24FB_blit( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y );
+
+//Copy an image into the back buffer, skipping transparent pixels
+// - As LT24FB_blit(), but pixels equal to key are not drawn.
+HpsErr_t LT24FB_blitKeyed( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned short key );
+
+//Blend an image over the back buffer
+// - As LT24FB_blit(), but each pixel is blended as
+//   (image * alpha + back * (LT24FB_ALPHA_OPAQUE - alpha)) / LT24FB_ALPHA_OPAQUE
+// - alpha is from 0 (transparent) to LT24FB_ALPHA_OPAQUE.
+// - Returns ERR_OUTRANGE if alpha is above LT24FB_ALPHA_OPAQUE.
+HpsErr_t LT24FB_blitAlpha( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned int alpha );
+
+//Draw an image scaled to a new size, clipped to the display
+// - The image is scaled to width x height pixels with its top left at
+//   (x,y), which may be off the display. Only the visible part is scaled.
+// - filter is IMAGE_SCALE_NEAREST or IMAGE_SCALE_BILINEAR.
+// - Returns ERR_SKIPPED if the scaled image is entirely off the display.
+// - Returns ERR_TOOBIG if the image or scaled size is over IMAGE_SCALE_MAX_SIZE.
+HpsErr_t LT24FB_blitScaled( LT24FBCtx_t* ctx, const LT24FBImage_t* image, int x, int y, unsigned int width, unsigned int height, ImageScaleFilter filter );
+
+//Copy an indexed image into the back buffer, clipped to the display
+// - As LT24FB_blit(), for indexed mode.
+// - Returns ERR_WRONGMODE if not in indexed mode.
+HpsErr_t LT24FB_blitIndexed( LT24FBCtx_t* ctx, const LT24FBIndexedImage_t* image, int x, int y );
+
+//Copy an indexed image into the back buffer, skipping transparent pixels
+// - As LT24FB_blitIndexed(), but pixels equal to index key are not drawn.
+HpsErr_t LT24FB_blitIndexedKeyed( LT24FBCtx_t* ctx, const LT24FBIndexedImage_t* image, int x, int y, uint8_t key );
+
+//Send all changes to the display
+// - Only the dirty rectangles, trimmed to the pixels which differ
+//   from the front buffer, are sent.
+// - Returns ERR_SKIPPED if there was nothing to send.
+// - If an error occurs, any rectangles not yet sent remain dirty and
+//   will be sent on the next call.
+HpsErr_t LT24FB_flip( LT24FBCtx_t* ctx );
+
+//Present frames by DMA at a fixed rate
+// - evtMgr is the event manager which times the frames, and fps the frame rate.
+//   If pacing is already set up, the rate and DMA settings are changed.
+// - dma and dmaParams are as for LT24_copyFrameBufferDma().
+// - If teSync is true, copies start on the next tearing effect edge, as for
+//   LT24_copyFrameBufferDmaSync().
+// - Pass fps as 0 to stop pacing. Any latched frame is discarded.
+// - Returns ERR_WRONGMODE in indexed mode.
+HpsErr_t LT24FB_setPacing( LT24FBCtx_t* ctx, EventMgrCtx_t* evtMgr, unsigned int fps, DmaCtx_t* dma, void* dmaParams, bool teSync );
+
+//Submit the back buffer as the next frame
+// - Copies the rows covering all dirty rectangles to the front buffer, to be
+//   sent on the next frame tick. The back buffer can be drawn to straight away.
+// - If a frame is already waiting, the two are combined and the earlier one
+//   is counted as dropped.
+// - Returns ERR_BUSY if the previous frame is still being copied.
+// - Returns ERR_SKIPPED if nothing is dirty.
+// - Returns ERR_WRONGMODE if not pacing.
+HpsErr_t LT24FB_submit( LT24FBCtx_t* ctx );
+
+//Get the paced presentation statistics
+// - Copies the counts to *stats. If clear is true, they are then reset.
+HpsErr_t LT24FB_getPresentStats( LT24FBCtx_t* ctx, LT24FBPresentStats_t* stats, bool clear );
+
+#endif /* DE1SOC_LT24FRAMEBUFFER_H_ */
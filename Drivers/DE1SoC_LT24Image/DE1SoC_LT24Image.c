@@ -0,0 +1,91 @@
+/*
+ * LT24 Compressed Image Decoder
+ * -----------------------------
+ * Description:
+ * Draws run-length encoded RGB565 images on the LT24 Display Controller
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_LT24Image.h"
+
+#include "Util/watchdog.h"
+
+/*
+ * Internal Functions
+ */
+
+//Check the packets of an image describe the right number of pixels
+static HpsErr_t _LT24Image_check( const unsigned short* image, unsigned int length ) {
+    if (length < LT24IMAGE_HEADER_LEN) return ERR_CORRUPT;
+    if (image[0] != LT24IMAGE_MAGIC) return ERR_CORRUPT;
+    unsigned int remain = (unsigned int)image[1] * image[2];
+    unsigned int idx = LT24IMAGE_HEADER_LEN;
+    while (remain) {
+        if (idx >= length) return ERR_CORRUPT;
+        unsigned int control = image[idx++];
+        unsigned int count = (control & LT24IMAGE_COUNT_MASK) + 1;
+        unsigned int words = (control & LT24IMAGE_RUN) ? 1 : count;
+        if ((count > remain) || (words > (length - idx))) return ERR_CORRUPT;
+        remain -= count;
+        idx += words;
+    }
+    return ERR_SUCCESS;
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Get the size of an image
+// - image is length words of encoded image data.
+// - Returns ERR_CORRUPT if the image is not in the compressed format,
+//   or its packets don't describe exactly width * height pixels.
+HpsErr_t LT24Image_getSize( const unsigned short* image, unsigned int length, unsigned int* width, unsigned int* height ) {
+    if (!image || !width || !height) return ERR_NULLPTR;
+    HpsErr_t status = _LT24Image_check(image, length);
+    if (ERR_IS_ERROR(status)) return status;
+    *width = image[1];
+    *height = image[2];
+    return ERR_SUCCESS;
+}
+
+//Draw an image
+// - (x,y) is the top left of the image on the display.
+// - The whole image must fit on the display.
+// - The image is checked before anything is drawn.
+// - Returns ERR_CORRUPT if the image data is invalid (see LT24Image_getSize).
+HpsErr_t LT24Image_draw( LT24Ctx_t* display, const unsigned short* image, unsigned int length, unsigned int x, unsigned int y ) {
+    if (!image) return ERR_NULLPTR;
+    HpsErr_t status = _LT24Image_check(image, length);
+    if (ERR_IS_ERROR(status)) return status;
+    ResetWDT();
+    //One window for the whole image (setWindow validates display and size for us)
+    status = LT24_setWindow(display, x, y, image[1], image[2]);
+    if (ERR_IS_ERROR(status)) return status;
+    //Then decode straight into it
+    unsigned int remain = (unsigned int)image[1] * image[2];
+    const unsigned short* packet = &image[LT24IMAGE_HEADER_LEN];
+    while (remain) {
+        unsigned int control = *packet++;
+        unsigned int count = (control & LT24IMAGE_COUNT_MASK) + 1;
+        if (control & LT24IMAGE_RUN) {
+            status = LT24_streamColour(display, *packet, count);
+            packet++;
+        } else {
+            status = LT24_streamPixels(display, packet, count);
+            packet += count;
+        }
+        if (ERR_IS_ERROR(status)) return status;
+        remain -= count;
+    }
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,78 @@
+/*
+ * LT24 Compressed Image Decoder
+ * -----------------------------
+ * Description:
+ * Draws run-length encoded RGB565 images on the LT24 Display Controller
+ *
+ * Raw RGB565 arrays take two bytes for every pixel, even for large
+ * areas of a single colour. This format stores images as runs of
+ * one colour and literal sequences of pixels, which is typically
+ * several times smaller for icons, sprites and UI graphics.
+ *
+ * Images are decoded straight into an LT24 display window, so no
+ * frame buffer is needed. Runs are written with LT24_streamColour()
+ * and literals streamed from the image with LT24_streamPixels(), so
+ * drawing takes the same display bandwidth as a raw image.
+ *
+ * Format
+ * ------
+ *
+ * An image is an array of 16-bit words:
+ *
+ *    [0] LT24IMAGE_MAGIC
+ *    [1] width in pixels
+ *    [2] height in pixels
+ *    [3...] packets, until width * height pixels are described
+ *
+ * Each packet starts with a control word:
+ *
+ *    1nnn nnnn nnnn nnnn  Run. Next word is a colour to repeat n+1 times.
+ *    0nnn nnnn nnnn nnnn  Literal. Next n+1 words are pixel colours.
+ *
+ * Packets may cross the end of a row. Use the 'rle' option of
+ * SampleCode/Unit3-2/Convert565.m to generate images:
+ *
+ *    Convert565('logo.png', 'logoImage', 'rle');
+ *
+ *    LT24Image_draw(lt24, logoImage, ARRAYSIZE(logoImage), 0, 0);
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_LT24IMAGE_H_
+#define DE1SOC_LT24IMAGE_H_
+
+//Include required header files
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+
+//Image header
+#define LT24IMAGE_MAGIC       0x524C
+#define LT24IMAGE_HEADER_LEN  3
+
+//Packet control word
+#define LT24IMAGE_RUN         0x8000
+#define LT24IMAGE_COUNT_MASK  0x7FFF
+
+//Get the size of an image
+// - image is length words of encoded image data.
+// - Returns ERR_CORRUPT if the image is not in the compressed format,
+//   or its packets don't describe exactly width * height pixels.
+HpsErr_t LT24Image_getSize( const unsigned short* image, unsigned int length, unsigned int* width, unsigned int* height );
+
+//Draw an image
+// - (x,y) is the top left of the image on the display.
+// - The whole image must fit on the display.
+// - The image is checked before anything is drawn.
+// - Returns ERR_CORRUPT if the image data is invalid (see LT24Image_getSize).
+HpsErr_t LT24Image_draw( LT24Ctx_t* display, const unsigned short* image, unsigned int length, unsigned int x, unsigned int y );
+
+#endif /* DE1SOC_LT24IMAGE_H_ */
@@ -0,0 +1,418 @@
+/*
+ * LT24 Streaming Image File Loader
+ * --------------------------------
+ * Description:
+ * Draws BMP and compressed RGB565 image files from a FatFS volume
+ * on the LT24 Display Controller
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_LT24ImageFile.h"
+#include "Util/mem_pool.h"
+
+#include <string.h>
+
+#include "Util/watchdog.h"
+
+#if (LT24IMAGEFILE_CHUNK_SIZE % FF_MAX_SS) != 0
+#error "LT24IMAGEFILE_CHUNK_SIZE must be a multiple of the maximum sector size"
+#endif
+
+//BMP file header fields
+#define LT24IMAGEFILE_BMP_MAGIC     0x4D42  // "BM"
+#define LT24IMAGEFILE_BMP_OFFBITS   10
+#define LT24IMAGEFILE_BMP_INFOSIZE  14
+#define LT24IMAGEFILE_BMP_WIDTH     18
+#define LT24IMAGEFILE_BMP_HEIGHT    22
+#define LT24IMAGEFILE_BMP_BITCOUNT  28
+#define LT24IMAGEFILE_BMP_COMPRESS  30
+#define LT24IMAGEFILE_BMP_MASKS     54
+#define LT24IMAGEFILE_BMP_HDRLEN    54
+#define LT24IMAGEFILE_BMP_INFOLEN   40
+
+//BMP compression types
+#define LT24IMAGEFILE_BI_RGB        0
+#define LT24IMAGEFILE_BI_BITFIELDS  3
+
+//State of a file being read
+typedef struct {
+    FIL file;
+    uint8_t* chunk;         // Read buffer of LT24IMAGEFILE_CHUNK_SIZE bytes
+    unsigned int chunkLen;  // Bytes of the read buffer which are valid
+    unsigned int chunkPos;  // Next byte of the read buffer to be used
+    //Image properties from the header
+    bool isRle;
+    bool bottomUp;
+    unsigned int width;
+    unsigned int height;
+    unsigned int bpp;
+    unsigned int stride;    // Bytes per row in the file, including padding
+} LT24ImageFileReader_t;
+
+/*
+ * Internal Functions
+ */
+
+//Little endian field accessors
+static inline unsigned int _LT24ImageFile_le16( const uint8_t* data ) {
+    return (unsigned int)data[0] | ((unsigned int)data[1] << 8);
+}
+
+static inline uint32_t _LT24ImageFile_le32( const uint8_t* data ) {
+    return (uint32_t)_LT24ImageFile_le16(data) | ((uint32_t)_LT24ImageFile_le16(&data[2]) << 16);
+}
+
+//Convert a FatFS result into an error code
+static HpsErr_t _LT24ImageFile_result( FRESULT res ) {
+    switch (res) {
+        case FR_OK:              return ERR_SUCCESS;
+        case FR_NO_FILE:
+        case FR_NO_PATH:
+        case FR_INVALID_NAME:
+        case FR_INVALID_DRIVE:   return ERR_NOTFOUND;
+        case FR_NOT_READY:       return ERR_NOTREADY;
+        case FR_NOT_ENABLED:
+        case FR_NO_FILESYSTEM:   return ERR_BADDISK;
+        case FR_TIMEOUT:         return ERR_TIMEOUT;
+        case FR_NOT_ENOUGH_CORE: return ERR_ALLOCFAIL;
+        default:                 return ERR_IOFAIL;
+    }
+}
+
+//Read the next chunk of the file
+// - Returns ERR_CORRUPT if the end of the file has been reached.
+static HpsErr_t _LT24ImageFile_fill( LT24ImageFileReader_t* reader ) {
+    UINT br;
+    FRESULT res = f_read(&reader->file, reader->chunk, LT24IMAGEFILE_CHUNK_SIZE, &br);
+    if (res != FR_OK) return _LT24ImageFile_result(res);
+    if (!br) return ERR_CORRUPT;
+    reader->chunkLen = br;
+    reader->chunkPos = 0;
+    return ERR_SUCCESS;
+}
+
+//Copy the next len bytes of the file to dest
+static HpsErr_t _LT24ImageFile_getBytes( LT24ImageFileReader_t* reader, uint8_t* dest, unsigned int len ) {
+    while (len) {
+        if (reader->chunkPos == reader->chunkLen) {
+            HpsErr_t status = _LT24ImageFile_fill(reader);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        unsigned int count = reader->chunkLen - reader->chunkPos;
+        if (count > len) count = len;
+        memcpy(dest, &reader->chunk[reader->chunkPos], count);
+        reader->chunkPos += count;
+        dest += count;
+        len -= count;
+    }
+    return ERR_SUCCESS;
+}
+
+//Get a pointer to the next len bytes of the file
+// - Points into the read buffer if the bytes are all in it and the
+//   address is a multiple of align, otherwise they are copied to rowBuf.
+static HpsErr_t _LT24ImageFile_getRow( LT24ImageFileReader_t* reader, uint8_t* rowBuf, unsigned int len, unsigned int align, const uint8_t** row ) {
+    const uint8_t* data = &reader->chunk[reader->chunkPos];
+    if (((reader->chunkLen - reader->chunkPos) >= len) && !((uintptr_t)data & (align - 1))) {
+        reader->chunkPos += len;
+        *row = data;
+        return ERR_SUCCESS;
+    }
+    *row = rowBuf;
+    return _LT24ImageFile_getBytes(reader, rowBuf, len);
+}
+
+//Parse a BMP header in the first chunk
+static HpsErr_t _LT24ImageFile_parseBmp( LT24ImageFileReader_t* reader, uint32_t* dataOfs ) {
+    const uint8_t* hdr = reader->chunk;
+    if (reader->chunkLen < LT24IMAGEFILE_BMP_HDRLEN) return ERR_CORRUPT;
+    //Only Windows BMP headers (BITMAPINFOHEADER and later) are supported
+    if (_LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_INFOSIZE]) < LT24IMAGEFILE_BMP_INFOLEN) return ERR_NOSUPPORT;
+    int32_t width  = (int32_t)_LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_WIDTH]);
+    int32_t height = (int32_t)_LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_HEIGHT]);
+    unsigned int bpp = _LT24ImageFile_le16(&hdr[LT24IMAGEFILE_BMP_BITCOUNT]);
+    uint32_t compress = _LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_COMPRESS]);
+    if ((width <= 0) || !height || (height == INT32_MIN)) return ERR_CORRUPT;
+    //Negative height means rows are stored top-down
+    reader->bottomUp = (height > 0);
+    reader->width = (unsigned int)width;
+    reader->height = (unsigned int)(reader->bottomUp ? height : -height);
+    reader->bpp = bpp;
+    //Check the pixel format is one we can convert
+    uint32_t red = 0, green = 0, blue = 0;
+    if (compress == LT24IMAGEFILE_BI_BITFIELDS) {
+        if (reader->chunkLen < LT24IMAGEFILE_BMP_MASKS + 12) return ERR_CORRUPT;
+        red   = _LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_MASKS]);
+        green = _LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_MASKS + 4]);
+        blue  = _LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_MASKS + 8]);
+    } else if (compress != LT24IMAGEFILE_BI_RGB) {
+        return ERR_NOSUPPORT;
+    }
+    if (bpp == 16) {
+        //Uncompressed 16-bit is RGB555, so only RGB565 bit fields can be copied
+        if ((red != 0xF800) || (green != 0x07E0) || (blue != 0x001F)) return ERR_NOSUPPORT;
+    } else if (bpp == 32) {
+        if ((compress == LT24IMAGEFILE_BI_BITFIELDS) &&
+            ((red != 0x00FF0000) || (green != 0x0000FF00) || (blue != 0x000000FF))) return ERR_NOSUPPORT;
+    } else if ((bpp != 24) || (compress != LT24IMAGEFILE_BI_RGB)) {
+        return ERR_NOSUPPORT;
+    }
+    //Rows are padded to a multiple of 4 bytes
+    if (reader->width > (UINT32_MAX / 4)) return ERR_CORRUPT;
+    reader->stride = ((reader->width * (bpp / 8)) + 3) & ~3U;
+    *dataOfs = _LT24ImageFile_le32(&hdr[LT24IMAGEFILE_BMP_OFFBITS]);
+    //Make sure all of the rows are in the file
+    if ((uint64_t)*dataOfs + (uint64_t)reader->stride * reader->height > f_size(&reader->file)) return ERR_CORRUPT;
+    return ERR_SUCCESS;
+}
+
+//Parse a compressed image header in the first chunk
+static HpsErr_t _LT24ImageFile_parseRle( LT24ImageFileReader_t* reader, uint32_t* dataOfs ) {
+    const uint8_t* hdr = reader->chunk;
+    if (reader->chunkLen < LT24IMAGE_HEADER_LEN * 2) return ERR_CORRUPT;
+    reader->isRle = true;
+    reader->bottomUp = false;
+    reader->width = _LT24ImageFile_le16(&hdr[2]);
+    reader->height = _LT24ImageFile_le16(&hdr[4]);
+    reader->bpp = 16;
+    reader->stride = reader->width * 2;
+    *dataOfs = LT24IMAGE_HEADER_LEN * 2;
+    return ERR_SUCCESS;
+}
+
+//Close the file and free the reader
+static void _LT24ImageFile_close( LT24ImageFileReader_t* reader ) {
+    if (!reader) return;
+    f_close(&reader->file);
+    MemPool_free(reader->chunk);
+    MemPool_free(reader);
+}
+
+//Open a file and read its header
+// - On success the read position is at the start of the pixel data.
+static HpsErr_t _LT24ImageFile_open( const TCHAR* path, LT24ImageFileReader_t** pReader ) {
+    if (!path) return ERR_NULLPTR;
+    LT24ImageFileReader_t* reader = MemPool_calloc(1, sizeof(LT24ImageFileReader_t));
+    if (!reader) return ERR_ALLOCFAIL;
+    reader->chunk = MemPool_malloc(LT24IMAGEFILE_CHUNK_SIZE);
+    if (!reader->chunk) {
+        MemPool_free(reader);
+        return ERR_ALLOCFAIL;
+    }
+    FRESULT res = f_open(&reader->file, path, FA_READ);
+    if (res != FR_OK) {
+        MemPool_free(reader->chunk);
+        MemPool_free(reader);
+        return _LT24ImageFile_result(res);
+    }
+    //Header is in the first chunk
+    HpsErr_t status = _LT24ImageFile_fill(reader);
+    uint32_t dataOfs = 0;
+    if (ERR_IS_ERROR(status)) {
+        //Nothing to read
+    } else if (reader->chunkLen < 2) {
+        status = ERR_CORRUPT;
+    } else if (_LT24ImageFile_le16(reader->chunk) == LT24IMAGEFILE_BMP_MAGIC) {
+        status = _LT24ImageFile_parseBmp(reader, &dataOfs);
+    } else if (_LT24ImageFile_le16(reader->chunk) == LT24IMAGE_MAGIC) {
+        status = _LT24ImageFile_parseRle(reader, &dataOfs);
+    } else {
+        status = ERR_CORRUPT;
+    }
+    if (ERR_IS_SUCCESS(status)) {
+        if (dataOfs < reader->chunkLen) {
+            //Pixels start in the chunk we already have
+            reader->chunkPos = dataOfs;
+        } else {
+            //Otherwise seek to the sector they start in, so reads stay sector aligned
+            FSIZE_t sector = (FSIZE_t)dataOfs & ~(FSIZE_t)(FF_MAX_SS - 1);
+            res = f_lseek(&reader->file, sector);
+            status = _LT24ImageFile_result(res);
+            if (ERR_IS_SUCCESS(status)) status = _LT24ImageFile_fill(reader);
+            if (ERR_IS_SUCCESS(status) && ((dataOfs - sector) >= reader->chunkLen)) status = ERR_CORRUPT;
+            if (ERR_IS_SUCCESS(status)) reader->chunkPos = dataOfs - sector;
+        }
+    }
+    if (ERR_IS_ERROR(status)) {
+        _LT24ImageFile_close(reader);
+        return status;
+    }
+    *pReader = reader;
+    return ERR_SUCCESS;
+}
+
+//Wait for any DMA copy to the display to finish
+static HpsErr_t _LT24ImageFile_waitDma( LT24Ctx_t* display ) {
+    HpsErr_t status;
+    do {
+        ResetWDT();
+        status = LT24_copyFrameBufferDone(display);
+    } while (ERR_IS_BUSY(status));
+    return status;
+}
+
+//Copy a band of converted rows to the display
+static HpsErr_t _LT24ImageFile_copyBand( LT24Ctx_t* display, DmaCtx_t* dma, void* dmaParams, const unsigned short* band,
+                                         unsigned int x, unsigned int y, unsigned int width, unsigned int rows ) {
+    if (!dma) return LT24_copyFrameBuffer(display, band, x, y, width, rows);
+    //Only one copy can run at once, so wait for the previous band
+    HpsErr_t status = _LT24ImageFile_waitDma(display);
+    if (ERR_IS_ERROR(status)) return status;
+    status = LT24_copyFrameBufferDma(display, dma, dmaParams, band, x, y, width, rows);
+    return ERR_IS_SKIPPED(status) ? ERR_SUCCESS : status;
+}
+
+//Draw the rows of a BMP file
+static HpsErr_t _LT24ImageFile_drawBmp( LT24ImageFileReader_t* reader, LT24Ctx_t* display, DmaCtx_t* dma, void* dmaParams,
+                                        unsigned int x, unsigned int y, PixelDither dither ) {
+    unsigned int width = reader->width;
+    unsigned int height = reader->height;
+    unsigned int bandRows = (height < LT24IMAGEFILE_BAND_ROWS) ? height : LT24IMAGEFILE_BAND_ROWS;
+    size_t bandSize = (size_t)width * bandRows * sizeof(unsigned short);
+    //Second band is only needed to overlap with DMA
+    unsigned short* bands[2];
+    bands[0] = MemPool_malloc(bandSize);
+    bands[1] = dma ? MemPool_malloc(bandSize) : bands[0];
+    uint8_t* rowBuf = MemPool_malloc(reader->stride);
+    HpsErr_t status = ERR_SUCCESS;
+    if (!bands[0] || !bands[1] || !rowBuf) status = ERR_ALLOCFAIL;
+    unsigned int bandIdx = 0;
+    unsigned int row = 0;
+    while (ERR_IS_SUCCESS(status) && (row < height)) {
+        ResetWDT();
+        unsigned int rows = height - row;
+        if (rows > bandRows) rows = bandRows;
+        unsigned short* band = bands[bandIdx];
+        //Convert each row as it arrives. Bottom-up files fill the band in reverse.
+        for (unsigned int idx = 0; ERR_IS_SUCCESS(status) && (idx < rows); idx++) {
+            unsigned int bandRow = reader->bottomUp ? (rows - 1 - idx) : idx;
+            unsigned int dispRow = reader->bottomUp ? (height - 1 - (row + idx)) : (row + idx);
+            unsigned short* dest = &band[bandRow * width];
+            const uint8_t* src;
+            status = _LT24ImageFile_getRow(reader, rowBuf, reader->stride, (reader->bpp == 32) ? 4 : 1, &src);
+            if (ERR_IS_ERROR(status)) break;
+            if (reader->bpp == 32) {
+                status = Pixel_argb8888ToRgb565(dest, (const uint32_t*)src, width, y + dispRow, dither);
+            } else if (reader->bpp == 24) {
+                status = Pixel_bgr888ToRgb565(dest, src, width, y + dispRow, dither);
+            } else {
+                memcpy(dest, src, width * sizeof(unsigned short));
+            }
+        }
+        if (ERR_IS_ERROR(status)) break;
+        unsigned int top = reader->bottomUp ? (height - row - rows) : row;
+        status = _LT24ImageFile_copyBand(display, dma, dmaParams, band, x, y + top, width, rows);
+        row += rows;
+        if (dma) bandIdx ^= 1;
+    }
+    //Bands can't be freed until the last copy is done with them
+    if (dma) {
+        HpsErr_t waitStatus = _LT24ImageFile_waitDma(display);
+        if (ERR_IS_SUCCESS(status)) status = waitStatus;
+        MemPool_free(bands[1]);
+    }
+    MemPool_free(bands[0]);
+    MemPool_free(rowBuf);
+    return status;
+}
+
+//Draw the packets of a compressed image file
+static HpsErr_t _LT24ImageFile_drawRle( LT24ImageFileReader_t* reader, LT24Ctx_t* display, unsigned int x, unsigned int y ) {
+    HpsErr_t status = LT24_setWindow(display, x, y, reader->width, reader->height);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int remain = reader->width * reader->height;
+    uint8_t word[2];
+    while (remain) {
+        ResetWDT();
+        status = _LT24ImageFile_getBytes(reader, word, sizeof(word));
+        if (ERR_IS_ERROR(status)) return status;
+        unsigned int control = _LT24ImageFile_le16(word);
+        unsigned int count = (control & LT24IMAGE_COUNT_MASK) + 1;
+        if (count > remain) return ERR_CORRUPT;
+        remain -= count;
+        if (control & LT24IMAGE_RUN) {
+            status = _LT24ImageFile_getBytes(reader, word, sizeof(word));
+            if (ERR_IS_ERROR(status)) return status;
+            status = LT24_streamColour(display, (unsigned short)_LT24ImageFile_le16(word), count);
+            if (ERR_IS_ERROR(status)) return status;
+            continue;
+        }
+        //Literals are streamed straight from the read buffer, a chunk at a time
+        while (count) {
+            unsigned int avail = (reader->chunkLen - reader->chunkPos) / sizeof(unsigned short);
+            if (avail > count) avail = count;
+            if (avail) {
+                status = LT24_streamPixels(display, (const unsigned short*)&reader->chunk[reader->chunkPos], avail);
+                reader->chunkPos += avail * sizeof(unsigned short);
+            } else {
+                //Pixel split across chunks
+                status = _LT24ImageFile_getBytes(reader, word, sizeof(word));
+                if (ERR_IS_SUCCESS(status)) status = LT24_streamColour(display, (unsigned short)_LT24ImageFile_le16(word), 1);
+                avail = 1;
+            }
+            if (ERR_IS_ERROR(status)) return status;
+            count -= avail;
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Get the size of an image file
+// - Reads only the header of the file.
+// - Returns ERR_NOTFOUND if the file doesn't exist, or ERR_IOFAIL if it
+//   could not be read.
+// - Returns ERR_CORRUPT if the file is not a valid image, or ERR_NOSUPPORT
+//   if it is a BMP file in an unsupported format.
+HpsErr_t LT24ImageFile_getSize( const TCHAR* path, unsigned int* width, unsigned int* height ) {
+    if (!width || !height) return ERR_NULLPTR;
+    LT24ImageFileReader_t* reader;
+    HpsErr_t status = _LT24ImageFile_open(path, &reader);
+    if (ERR_IS_ERROR(status)) return status;
+    *width = reader->width;
+    *height = reader->height;
+    _LT24ImageFile_close(reader);
+    return ERR_SUCCESS;
+}
+
+//Draw an image file
+// - (x,y) is the top left of the image on the display.
+// - The whole image must fit on the display (returns LT24_INVALIDSIZE otherwise).
+// - dma is the controller used to copy BMP rows to the display, or NULL to
+//   copy them with the CPU. See LT24_copyFrameBufferDma() for dmaParams.
+// - dither is applied when converting 24-bit and 32-bit BMP files.
+// - Returns once the whole image has been drawn.
+// - Errors are as LT24ImageFile_getSize(), or from the display.
+HpsErr_t LT24ImageFile_draw( LT24Ctx_t* display, DmaCtx_t* dma, void* dmaParams, const TCHAR* path,
+                             unsigned int x, unsigned int y, PixelDither dither ) {
+    //Check the display before reading anything
+    HpsErr_t status = DriverContextValidate(display);
+    if (ERR_IS_ERROR(status)) return status;
+    LT24ImageFileReader_t* reader;
+    status = _LT24ImageFile_open(path, &reader);
+    if (ERR_IS_ERROR(status)) return status;
+    //Bands are copied separately, so check the whole image fits first
+    if (!reader->width || !reader->height ||
+        (x >= LT24_WIDTH) || (reader->width > (LT24_WIDTH - x)) ||
+        (y >= LT24_HEIGHT) || (reader->height > (LT24_HEIGHT - y))) {
+        status = LT24_INVALIDSIZE;
+    } else if (reader->isRle) {
+        status = _LT24ImageFile_drawRle(reader, display, x, y);
+    } else {
+        status = _LT24ImageFile_drawBmp(reader, display, dma, dmaParams, x, y, dither);
+    }
+    _LT24ImageFile_close(reader);
+    return status;
+}
@@ -0,0 +1,99 @@
+/*
+ * LT24 Streaming Image File Loader
+ * --------------------------------
+ * Description:
+ * Draws BMP and compressed RGB565 image files from a FatFS volume
+ * on the LT24 Display Controller
+ *
+ * Loading a whole image into RAM before drawing it needs up to 230kB
+ * for a full screen 24-bit bitmap, and the display sits idle while
+ * the card is read. Instead, files are read in whole sector chunks
+ * so that FatFS can transfer them straight from the card into the
+ * read buffer, and each row is converted to RGB565 as soon as it
+ * has arrived.
+ *
+ * BMP Files
+ * ---------
+ *
+ * Converted rows are gathered into bands of LT24IMAGEFILE_BAND_ROWS
+ * rows. If a DMA controller is given, two band buffers are used in
+ * turn, so the next band is read and converted while the previous
+ * one is copied to the display by LT24_copyFrameBufferDma(). Without
+ * a DMA controller, each band is copied with LT24_copyFrameBuffer().
+ *
+ * Supported formats are uncompressed 24-bit and 32-bit BMP files,
+ * and 16-bit BI_BITFIELDS files with RGB565 masks. Rows may be stored
+ * either bottom-up (the usual case) or top-down. Palette and RLE
+ * compressed BMP files return ERR_NOSUPPORT.
+ *
+ * Compressed Files
+ * ----------------
+ *
+ * Files in the DE1SoC_LT24Image format, stored as little endian 16-bit
+ * words, are decoded straight into a display window as they are read.
+ * Use the 'rlebin' option of SampleCode/Unit3-2/Convert565.m to make
+ * them. Unlike LT24Image_draw(), the packets are checked as they are
+ * drawn, so a corrupt file might be partly drawn before ERR_CORRUPT
+ * is returned.
+ *
+ * Usage
+ * -----
+ *
+ * The format is detected from the start of the file:
+ *
+ *    LT24ImageFile_draw(lt24, dma, &dmaParams, "0:/splash.bmp", 0, 0, PIXEL_DITHER_ORDERED);
+ *
+ * The read buffer and band buffers are allocated from the memory pool
+ * (Util/mem_pool.h) for the duration of the call only.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_LT24IMAGEFILE_H_
+#define DE1SOC_LT24IMAGEFILE_H_
+
+//Include required header files
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "DE1SoC_LT24Image/DE1SoC_LT24Image.h"
+#include "FatFS/ff.h"
+#include "Util/pixel_convert.h"
+
+//Size of the file read buffer in bytes. Must be a whole number of sectors.
+#ifndef LT24IMAGEFILE_CHUNK_SIZE
+#define LT24IMAGEFILE_CHUNK_SIZE  4096
+#endif
+
+//Number of rows converted before each copy to the display
+#ifndef LT24IMAGEFILE_BAND_ROWS
+#define LT24IMAGEFILE_BAND_ROWS   16
+#endif
+
+//Get the size of an image file
+// - Reads only the header of the file.
+// - Returns ERR_NOTFOUND if the file doesn't exist, or ERR_IOFAIL if it
+//   could not be read.
+// - Returns ERR_CORRUPT if the file is not a valid image, or ERR_NOSUPPORT
+//   if it is a BMP file in an unsupported format.
+HpsErr_t LT24ImageFile_getSize( const TCHAR* path, unsigned int* width, unsigned int* height );
+
+//Draw an image file
+// - (x,y) is the top left of the image on the display.
+// - The whole image must fit on the display (returns LT24_INVALIDSIZE otherwise).
+// - dma is the controller used to copy BMP rows to the display, or NULL to
+//   copy them with the CPU. See LT24_copyFrameBufferDma() for dmaParams.
+// - dither is applied when converting 24-bit and 32-bit BMP files.
+// - Returns once the whole image has been drawn.
+// - Errors are as LT24ImageFile_getSize(), or from the display.
+HpsErr_t LT24ImageFile_draw( LT24Ctx_t* display, DmaCtx_t* dma, void* dmaParams, const TCHAR* path,
+                             unsigned int x, unsigned int y, PixelDither dither );
+
+#endif /* DE1SOC_LT24IMAGEFILE_H_ */
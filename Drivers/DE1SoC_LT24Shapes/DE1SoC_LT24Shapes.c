@@ -0,0 +1,249 @@
+/*
+ * LT24 Shape Rasteriser
+ * ---------------------
+ * Description:
+ * Draws lines, circles and polygons on the LT24 Display Controller
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_LT24Shapes.h"
+
+#include <stdlib.h>
+
+#include "Util/macros.h"
+
+//Fixed point fraction bits for polygon edge intersections
+#define LT24SHAPES_FRAC_BITS 16
+#define LT24SHAPES_ONE       (1LL << LT24SHAPES_FRAC_BITS)
+#define LT24SHAPES_HALF      (LT24SHAPES_ONE / 2)
+
+//Display being drawn to, with its current size for clipping
+typedef struct {
+    LT24Ctx_t* display;
+    int64_t width;
+    int64_t height;
+} LT24ShapesTarget_t;
+
+/*
+ * Internal Functions
+ */
+
+//Look up display size ready for clipping
+static HpsErr_t _LT24Shapes_target( LT24Ctx_t* display, LT24ShapesTarget_t* target ) {
+    unsigned int width, height;
+    //getSize validates context for us
+    HpsErr_t status = LT24_getSize(display, &width, &height);
+    if (ERR_IS_ERROR(status)) return status;
+    target->display = display;
+    target->width = width;
+    target->height = height;
+    return ERR_SUCCESS;
+}
+
+//Draw a run of pixels
+// - Covers x0 to x1 and y0 to y1 inclusive, in either order. Clipped to display.
+static HpsErr_t _LT24Shapes_run( LT24ShapesTarget_t* target, unsigned short colour, int64_t x0, int64_t y0, int64_t x1, int64_t y1 ) {
+    if (x1 < x0) { int64_t t = x0; x0 = x1; x1 = t; }
+    if (y1 < y0) { int64_t t = y0; y0 = y1; y1 = t; }
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 >= target->width ) x1 = target->width  - 1;
+    if (y1 >= target->height) y1 = target->height - 1;
+    if ((x1 < x0) || (y1 < y0)) return ERR_SUCCESS;
+    //One window and burst fill for the whole run
+    return LT24_fillRect(target->display, colour, (unsigned int)x0, (unsigned int)y0, (unsigned int)(x1 - x0 + 1), (unsigned int)(y1 - y0 + 1));
+}
+
+//Draw a line as runs of pixels
+static HpsErr_t _LT24Shapes_line( LT24ShapesTarget_t* target, unsigned short colour, int x0, int y0, int x1, int y1 ) {
+    //Skip lines which are entirely off the display
+    if ((max(x0, x1) < 0) || (min(x0, x1) >= target->width) || (max(y0, y1) < 0) || (min(y0, y1) >= target->height)) return ERR_SUCCESS;
+    //Bresenham's algorithm along the major axis, gathering pixels with the same
+    //minor axis position into a single run
+    bool steep = llabs((int64_t)y1 - y0) > llabs((int64_t)x1 - x0);
+    int64_t major  = steep ? y0 : x0;
+    int64_t minor  = steep ? x0 : y0;
+    int64_t dMajor = llabs(steep ? ((int64_t)y1 - y0) : ((int64_t)x1 - x0));
+    int64_t dMinor = llabs(steep ? ((int64_t)x1 - x0) : ((int64_t)y1 - y0));
+    int64_t sMajor = ((steep ? y1 : x1) < major) ? -1 : 1;
+    int64_t sMinor = ((steep ? x1 : y1) < minor) ? -1 : 1;
+    int64_t err = 2 * dMinor - dMajor;
+    int64_t start = major;
+    HpsErr_t status;
+    for (int64_t step = 0; step < dMajor; step++) {
+        int64_t next = major + sMajor;
+        if (err > 0) {
+            //Minor axis steps, so finish this run
+            status = steep ? _LT24Shapes_run(target, colour, minor, start, minor, major) :
+                             _LT24Shapes_run(target, colour, start, minor, major, minor);
+            if (ERR_IS_ERROR(status)) return status;
+            minor += sMinor;
+            start = next;
+            err += 2 * (dMinor - dMajor);
+        } else {
+            err += 2 * dMinor;
+        }
+        major = next;
+    }
+    //Then the final run
+    return steep ? _LT24Shapes_run(target, colour, minor, start, minor, major) :
+                   _LT24Shapes_run(target, colour, start, minor, major, minor);
+}
+
+//Half width of a filled circle at a row
+// - Largest x for which x^2 + dy^2 <= r^2 + r, searching down from x.
+// - The extra r places the edge half a pixel out, giving rounder circles.
+static int64_t _LT24Shapes_halfWidth( int64_t limit, int64_t dy, int64_t x ) {
+    while ((x >= 0) && ((x * x + dy * dy) > limit)) x--;
+    return x;
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Draw a line from (x0,y0) to (x1,y1) inclusive
+// - display is an initialised LT24 driver instance.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_line( LT24Ctx_t* display, unsigned short colour, int x0, int y0, int x1, int y1 ) {
+    LT24ShapesTarget_t target;
+    HpsErr_t status = _LT24Shapes_target(display, &target);
+    if (ERR_IS_ERROR(status)) return status;
+    return _LT24Shapes_line(&target, colour, x0, y0, x1, y1);
+}
+
+//Draw the outline of a circle
+// - Centred on (xc,yc) with the given radius in pixels.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_circle( LT24Ctx_t* display, unsigned short colour, int xc, int yc, unsigned int radius ) {
+    if (radius > INT32_MAX) return LT24_INVALIDSIZE;
+    LT24ShapesTarget_t target;
+    HpsErr_t status = _LT24Shapes_target(display, &target);
+    if (ERR_IS_ERROR(status)) return status;
+    int64_t r = radius;
+    int64_t limit = r * r + r;
+    int64_t outer = r;
+    for (int64_t dy = 0; dy <= r; dy++) {
+        //The outline of each row is the part of the filled span not covered
+        //by the row further from the centre, or a single pixel if it is.
+        int64_t inner = (dy < r) ? _LT24Shapes_halfWidth(limit, dy + 1, outer) : -1;
+        int64_t first = (inner < outer) ? (inner + 1) : outer;
+        for (int64_t row = yc - dy; row <= (yc + dy); row += ((dy) ? (2 * dy) : 1)) {
+            if (first <= 0) {
+                //Span crosses the centre, so draw it as one
+                status = _LT24Shapes_run(&target, colour, xc - outer, row, xc + outer, row);
+            } else {
+                status = _LT24Shapes_run(&target, colour, xc + first, row, xc + outer, row);
+                if (ERR_IS_ERROR(status)) return status;
+                status = _LT24Shapes_run(&target, colour, xc - outer, row, xc - first, row);
+            }
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        outer = inner;
+    }
+    return ERR_SUCCESS;
+}
+
+//Draw a filled circle
+// - Centred on (xc,yc) with the given radius in pixels.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_fillCircle( LT24Ctx_t* display, unsigned short colour, int xc, int yc, unsigned int radius ) {
+    if (radius > INT32_MAX) return LT24_INVALIDSIZE;
+    LT24ShapesTarget_t target;
+    HpsErr_t status = _LT24Shapes_target(display, &target);
+    if (ERR_IS_ERROR(status)) return status;
+    int64_t r = radius;
+    int64_t limit = r * r + r;
+    int64_t halfWidth = r;
+    for (int64_t dy = 0; dy <= r; dy++) {
+        //One span above and below the centre
+        halfWidth = _LT24Shapes_halfWidth(limit, dy, halfWidth);
+        status = _LT24Shapes_run(&target, colour, xc - halfWidth, yc + dy, xc + halfWidth, yc + dy);
+        if (ERR_IS_ERROR(status)) return status;
+        if (!dy) continue;
+        status = _LT24Shapes_run(&target, colour, xc - halfWidth, yc - dy, xc + halfWidth, yc - dy);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Draw the outline of a polygon
+// - Lines are drawn between each of the count points, and from the last
+//   back to the first.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_polygon( LT24Ctx_t* display, unsigned short colour, const LT24ShapesPoint_t* points, unsigned int count ) {
+    if (!points) return ERR_NULLPTR;
+    if (count < 2) return LT24_INVALIDSHAPE;
+    LT24ShapesTarget_t target;
+    HpsErr_t status = _LT24Shapes_target(display, &target);
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        const LT24ShapesPoint_t* next = &points[(idx + 1) % count];
+        status = _LT24Shapes_line(&target, colour, points[idx].x, points[idx].y, next->x, next->y);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Draw a filled polygon
+// - Polygon may be concave or self intersecting, and is filled with the
+//   even-odd rule.
+// - Returns LT24_INVALIDSHAPE if there are fewer than 3 points, or more
+//   than LT24SHAPES_MAX_VERTICES.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_fillPolygon( LT24Ctx_t* display, unsigned short colour, const LT24ShapesPoint_t* points, unsigned int count ) {
+    if (!points) return ERR_NULLPTR;
+    if ((count < 3) || (count > LT24SHAPES_MAX_VERTICES)) return LT24_INVALIDSHAPE;
+    LT24ShapesTarget_t target;
+    HpsErr_t status = _LT24Shapes_target(display, &target);
+    if (ERR_IS_ERROR(status)) return status;
+    //Rows covered by the polygon, clipped to the display
+    int64_t ytop = points[0].y;
+    int64_t ybottom = points[0].y;
+    for (unsigned int idx = 1; idx < count; idx++) {
+        ytop    = min(ytop,    (int64_t)points[idx].y);
+        ybottom = max(ybottom, (int64_t)points[idx].y);
+    }
+    if (ytop < 0) ytop = 0;
+    if (ybottom > target.height) ybottom = target.height;
+    //Each row is sampled at its pixel centres, y + 0.5
+    int64_t crossings[LT24SHAPES_MAX_VERTICES];
+    for (int64_t y = ytop; y < ybottom; y++) {
+        //Find where each edge crosses the row, in fixed point. Edges include
+        //their top vertex but not their bottom one, so each vertex is only
+        //counted once.
+        unsigned int found = 0;
+        for (unsigned int idx = 0; idx < count; idx++) {
+            const LT24ShapesPoint_t* a = &points[idx];
+            const LT24ShapesPoint_t* b = &points[(idx + 1) % count];
+            if ((a->y <= y) == (b->y <= y)) continue;
+            int64_t x = ((int64_t)a->x * LT24SHAPES_ONE) +
+                        ((2 * (y - a->y) + 1) * ((int64_t)b->x - a->x) * LT24SHAPES_ONE) / (2 * ((int64_t)b->y - a->y));
+            //Insertion sort as we go. Lists are short.
+            unsigned int pos = found++;
+            while (pos && (crossings[pos - 1] > x)) {
+                crossings[pos] = crossings[pos - 1];
+                pos--;
+            }
+            crossings[pos] = x;
+        }
+        //Fill pixels whose centres lie between each pair of crossings
+        for (unsigned int idx = 0; (idx + 1) < found; idx += 2) {
+            int64_t first = (crossings[idx]     + LT24SHAPES_HALF - 1) >> LT24SHAPES_FRAC_BITS;
+            int64_t last  = ((crossings[idx + 1] + LT24SHAPES_HALF - 1) >> LT24SHAPES_FRAC_BITS) - 1;
+            if (last < first) continue;
+            status = _LT24Shapes_run(&target, colour, first, y, last, y);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+    }
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/*
+ * LT24 Shape Rasteriser
+ * ---------------------
+ * Description:
+ * Draws lines, circles and polygons on the LT24 Display Controller
+ *
+ * Each shape is converted into runs of pixels, each of which is drawn
+ * with a single LT24_fillRect(), so costs one display window and a
+ * burst fill rather than a window per pixel as with LT24_drawPixel().
+ *
+ *  - Lines are split into horizontal runs for shallow lines, and
+ *    vertical runs for steep ones.
+ *  - Filled circles and polygons are drawn as one horizontal span per
+ *    row. Circle outlines use the parts of those spans not covered by
+ *    the next row in.
+ *
+ * Coordinates are signed, and shapes may be partly or wholly off the
+ * display, in which case each run is clipped to fit. Shapes are clipped
+ * to the current display size (see LT24_setOrientation()).
+ *
+ * Polygons are filled with the even-odd rule, sampling each row at its
+ * pixel centres, so edges shared between neighbouring polygons are
+ * only drawn once.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_LT24SHAPES_H_
+#define DE1SOC_LT24SHAPES_H_
+
+//Include required header files
+#include <stdint.h>
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+
+//Maximum number of vertices in a polygon
+#ifndef LT24SHAPES_MAX_VERTICES
+#define LT24SHAPES_MAX_VERTICES 32
+#endif
+
+//Polygon vertex
+typedef struct {
+    int x;
+    int y;
+} LT24ShapesPoint_t;
+
+//Draw a line from (x0,y0) to (x1,y1) inclusive
+// - display is an initialised LT24 driver instance.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_line( LT24Ctx_t* display, unsigned short colour, int x0, int y0, int x1, int y1 );
+
+//Draw the outline of a circle
+// - Centred on (xc,yc) with the given radius in pixels.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_circle( LT24Ctx_t* display, unsigned short colour, int xc, int yc, unsigned int radius );
+
+//Draw a filled circle
+// - Centred on (xc,yc) with the given radius in pixels.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_fillCircle( LT24Ctx_t* display, unsigned short colour, int xc, int yc, unsigned int radius );
+
+//Draw the outline of a polygon
+// - Lines are drawn between each of the count points, and from the last
+//   back to the first.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_polygon( LT24Ctx_t* display, unsigned short colour, const LT24ShapesPoint_t* points, unsigned int count );
+
+//Draw a filled polygon
+// - Polygon may be concave or self intersecting, and is filled with the
+//   even-odd rule.
+// - Returns LT24_INVALIDSHAPE if there are fewer than 3 points, or more
+//   than LT24SHAPES_MAX_VERTICES.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Shapes_fillPolygon( LT24Ctx_t* display, unsigned short colour, const LT24ShapesPoint_t* points, unsigned int count );
+
+#endif /* DE1SOC_LT24SHAPES_H_ */
@@ -0,0 +1,311 @@
+/*
+ * LT24 Strip Buffered Renderer
+ * ----------------------------
+ * Description:
+ * Band-at-a-time display layer for the LT24 Display Controller
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add scaled blits with nearest and bilinear filtering
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_LT24StripBuffer.h"
+#include "Util/mem_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Util/watchdog.h"
+#include "Util/macros.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * Internal Functions
+ */
+
+//Clipped area of a band
+// - Right and bottom edges are exclusive. Offsets are relative to the band.
+typedef struct {
+    unsigned int xleft;
+    unsigned int ytop;
+    unsigned int xright;
+    unsigned int ybottom;
+} LT24SBClip_t;
+
+//Clip a rectangle in screen coordinates to a band
+// - Done in 64-bit so large sizes and offsets can't wrap.
+// - Returns false if the rectangle does not overlap the band.
+static bool _LT24SB_clip( LT24SBBand_t* band, int x, int y, unsigned int width, unsigned int height, LT24SBClip_t* clip ) {
+    int64_t xleft   = (int64_t)x - band->xleft;
+    int64_t ytop    = (int64_t)y - band->ytop;
+    int64_t xright  = xleft + width;
+    int64_t ybottom = ytop  + height;
+    if (xleft   < 0           ) xleft   = 0;
+    if (ytop    < 0           ) ytop    = 0;
+    if (xright  > band->width ) xright  = band->width;
+    if (ybottom > band->height) ybottom = band->height;
+    if ((xright <= xleft) || (ybottom <= ytop)) return false;
+    clip->xleft   = (unsigned int)xleft;
+    clip->ytop    = (unsigned int)ytop;
+    clip->xright  = (unsigned int)xright;
+    clip->ybottom = (unsigned int)ybottom;
+    return true;
+}
+
+//Fill a row of pixels with a colour
+static void _LT24SB_rowFill( unsigned short* dst, unsigned int count, unsigned short colour ) {
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint16x8_t colours = vdupq_n_u16(colour);
+    for (; x + 8 <= count; x += 8) {
+        vst1q_u16(&dst[x], colours);
+    }
+#endif
+    for (; x < count; x++) {
+        dst[x] = colour;
+    }
+}
+
+//Copy a row of pixels, skipping those equal to key
+static void _LT24SB_rowKeyed( unsigned short* dst, const unsigned short* src, unsigned int count, unsigned short key ) {
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    //Select the destination wherever the source matches the key
+    uint16x8_t keys = vdupq_n_u16(key);
+    for (; x + 8 <= count; x += 8) {
+        uint16x8_t s = vld1q_u16(&src[x]);
+        uint16x8_t d = vld1q_u16(&dst[x]);
+        vst1q_u16(&dst[x], vbslq_u16(vceqq_u16(s, keys), d, s));
+    }
+#endif
+    for (; x < count; x++) {
+        if (src[x] != key) dst[x] = src[x];
+    }
+}
+
+//Clip an image to a band and copy it, optionally with a colour key
+static HpsErr_t _LT24SB_blit( LT24SBBand_t* band, const LT24FBImage_t* image, int x, int y, bool keyed, unsigned short key ) {
+    if (!band || !band->pixels || !image || !image->pixels) return ERR_NULLPTR;
+    unsigned int stride = image->stride ? image->stride : image->width;
+    if (stride < image->width) return LT24_INVALIDSHAPE;
+    LT24SBClip_t clip;
+    if (!_LT24SB_clip(band, x, y, image->width, image->height, &clip)) return ERR_SKIPPED;
+    unsigned int width = clip.xright - clip.xleft;
+    //Image pixel at the top left of the clipped area
+    const unsigned short* src = image->pixels + (((int64_t)band->ytop + clip.ytop - y) * stride) + ((int64_t)band->xleft + clip.xleft - x);
+    for (unsigned int row = clip.ytop; row < clip.ybottom; row++) {
+        unsigned short* dst = &band->pixels[row * band->width + clip.xleft];
+        if (keyed) {
+            _LT24SB_rowKeyed(dst, src, width, key);
+        } else {
+            memcpy(dst, src, width * sizeof(unsigned short));
+        }
+        src += stride;
+    }
+    return ERR_SUCCESS;
+}
+
+//Wait for any band copy to finish
+static HpsErr_t _LT24SB_wait( LT24SBCtx_t* ctx ) {
+    HpsErr_t status;
+    while ((status = LT24_copyFrameBufferDone(ctx->display)) == ERR_BUSY) {
+        ResetWDT();
+    }
+    return status;
+}
+
+//Send a drawn band to the display
+// - With DMA, the previous band must have finished before the next can be
+//   started, but drawing into the other buffer can carry on meanwhile.
+static HpsErr_t _LT24SB_send( LT24SBCtx_t* ctx, LT24SBBand_t* band ) {
+    if (!ctx->dma) {
+        return LT24_copyFrameBuffer(ctx->display, band->pixels, band->xleft, band->ytop, band->width, band->height);
+    }
+    HpsErr_t status = _LT24SB_wait(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    status = LT24_copyFrameBufferDma(ctx->display, ctx->dma, ctx->dmaParams, band->pixels, band->xleft, band->ytop, band->width, band->height);
+    if (status == ERR_SKIPPED) status = ERR_SUCCESS;
+    return status;
+}
+
+//Cleanup
+static void _LT24SB_cleanup( LT24SBCtx_t* ctx ) {
+    //A band copy may still be reading the buffers
+    if (ctx->dma) _LT24SB_wait(ctx);
+    for (unsigned int idx = 0; idx < 2; idx++) {
+        if (ctx->buf[idx]) {
+            MemPool_free(ctx->buf[idx]);
+            ctx->buf[idx] = NULL;
+        }
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the strip buffer driver
+// - display is an initialised LT24 driver instance.
+// - bandLines is the number of scanlines in each band (1 to LT24_HEIGHT).
+// - dma is an optional DMA controller to copy each band while the next
+//   is drawn, with dmaParams as for LT24_copyFrameBufferDma(). If NULL,
+//   bands are copied directly by the CPU.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24SB_initialise( LT24Ctx_t* display, unsigned int bandLines, DmaCtx_t* dma, void* dmaParams, LT24SBCtx_t** pCtx ) {
+    //Check if the LT24 display has been initialised (required)
+    if (!LT24_isInitialised(display)) return ERR_BADDEVICE;
+    if (dma && !DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    if (!bandLines || (bandLines > LT24_HEIGHT)) return ERR_OUTRANGE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_LT24SB_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save display and DMA settings
+    LT24SBCtx_t* ctx = *pCtx;
+    ctx->display = display;
+    ctx->dma = dma;
+    ctx->dmaParams = dmaParams;
+    ctx->bandLines = bandLines;
+    //Allocate the band buffers. A second is only needed to overlap with DMA.
+    for (unsigned int idx = 0; idx < (dma ? 2 : 1); idx++) {
+        ctx->buf[idx] = MemPool_malloc(LT24_WIDTH * bandLines * sizeof(unsigned short));
+        if (!ctx->buf[idx]) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    }
+    ctx->next = 0;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+bool LT24SB_isInitialised( LT24SBCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Render the whole display
+// - Calls draw for each band from the top of the display down, sending
+//   each band once drawn.
+// - With DMA, returns once the last band copy has started. Use LT24SB_done()
+//   to check it has finished before using other LT24 APIs.
+HpsErr_t LT24SB_render( LT24SBCtx_t* ctx, LT24SBDrawFunc_t draw, void* param ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Whole display in its current orientation
+    unsigned int width, height;
+    status = LT24_getSize(ctx->display, &width, &height);
+    if (ERR_IS_ERROR(status)) return status;
+    return LT24SB_renderRect(ctx, 0, 0, width, height, draw, param);
+}
+
+//Render a region of the display
+// - As LT24SB_render(), but only the given region is drawn and sent. The
+//   bands are the width of the region, so may be taller than bandLines
+//   for narrow regions.
+HpsErr_t LT24SB_renderRect( LT24SBCtx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height, LT24SBDrawFunc_t draw, void* param ) {
+    if (!draw) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Same checks as LT24_setWindow so that errors are consistent
+    unsigned int dispWidth, dispHeight;
+    status = LT24_getSize(ctx->display, &dispWidth, &dispHeight);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!width || !height) return LT24_INVALIDSHAPE;
+    if ((xleft >= dispWidth ) || (width  > (dispWidth  - xleft))) return LT24_INVALIDSIZE;
+    if ((ytop  >= dispHeight) || (height > (dispHeight - ytop ))) return LT24_INVALIDSIZE;
+    //As many rows of the region as fit in a band buffer
+    unsigned int bandRows = (LT24_WIDTH * ctx->bandLines) / width;
+    LT24SBBand_t band = { .xleft = xleft, .width = width };
+    for (unsigned int row = 0; row < height; row += band.height) {
+        ResetWDT();
+        //Draw into the buffer not being sent. The other is free once the
+        //previous copy completes, which _LT24SB_send() waits for.
+        band.pixels = ctx->buf[ctx->next];
+        band.ytop   = ytop + row;
+        band.height = min(bandRows, height - row);
+        status = draw(param, &band);
+        if (ERR_IS_ERROR(status)) return status;
+        status = _LT24SB_send(ctx, &band);
+        if (ERR_IS_ERROR(status)) return status;
+        if (ctx->dma) ctx->next ^= 1;
+    }
+    return ERR_SUCCESS;
+}
+
+//Check if the last band has been sent
+// - Returns ERR_SUCCESS if there is no band copy running.
+// - Returns ERR_BUSY if the last band is still being copied.
+HpsErr_t LT24SB_done( LT24SBCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return LT24_copyFrameBufferDone(ctx->display);
+}
+
+//Fill the whole band with a colour
+HpsErr_t LT24SB_fill( LT24SBBand_t* band, unsigned short colour ) {
+    if (!band || !band->pixels) return ERR_NULLPTR;
+    _LT24SB_rowFill(band->pixels, band->width * band->height, colour);
+    return ERR_SUCCESS;
+}
+
+//Fill a rectangle with a colour
+// - The rectangle is in screen coordinates, and is clipped to the band.
+// - Returns ERR_SKIPPED if the rectangle does not overlap the band.
+HpsErr_t LT24SB_fillRect( LT24SBBand_t* band, unsigned short colour, int xleft, int ytop, unsigned int width, unsigned int height ) {
+    if (!band || !band->pixels) return ERR_NULLPTR;
+    LT24SBClip_t clip;
+    if (!_LT24SB_clip(band, xleft, ytop, width, height, &clip)) return ERR_SKIPPED;
+    for (unsigned int row = clip.ytop; row < clip.ybottom; row++) {
+        _LT24SB_rowFill(&band->pixels[row * band->width + clip.xleft], clip.xright - clip.xleft, colour);
+    }
+    return ERR_SUCCESS;
+}
+
+//Copy an image into the band
+// - (x,y) is the screen position of the top left of the image. The image
+//   is clipped to the band.
+// - Returns ERR_SKIPPED if the image does not overlap the band.
+HpsErr_t LT24SB_blit( LT24SBBand_t* band, const LT24FBImage_t* image, int x, int y ) {
+    return _LT24SB_blit(band, image, x, y, false, 0);
+}
+
+//Copy an image into the band, skipping transparent pixels
+// - As LT24SB_blit(), but pixels equal to key are not drawn.
+HpsErr_t LT24SB_blitKeyed( LT24SBBand_t* band, const LT24FBImage_t* image, int x, int y, unsigned short key ) {
+    return _LT24SB_blit(band, image, x, y, true, key);
+}
+
+//Draw an image scaled to a new size into the band
+// - The image is scaled to width x height pixels with its top left at
+//   screen position (x,y), and clipped to the band. Only the part within
+//   the band is scaled.
+// - filter is IMAGE_SCALE_NEAREST or IMAGE_SCALE_BILINEAR.
+// - Returns ERR_SKIPPED if the scaled image does not overlap the band.
+// - Returns ERR_TOOBIG if the image or scaled size is over IMAGE_SCALE_MAX_SIZE.
+HpsErr_t LT24SB_blitScaled( LT24SBBand_t* band, const LT24FBImage_t* image, int x, int y, unsigned int width, unsigned int height, ImageScaleFilter filter ) {
+    if (!band || !band->pixels || !image || !image->pixels) return ERR_NULLPTR;
+    unsigned int stride = image->stride ? image->stride : image->width;
+    if (stride < image->width) return LT24_INVALIDSHAPE;
+    LT24SBClip_t clip;
+    if (!_LT24SB_clip(band, x, y, width, height, &clip)) return ERR_SKIPPED;
+    //Scale only the window within the band
+    ImageScaleWindow_t window = {
+        width, height,
+        (unsigned int)((int64_t)band->xleft + clip.xleft - x), (unsigned int)((int64_t)band->ytop + clip.ytop - y),
+        clip.xright - clip.xleft, clip.ybottom - clip.ytop
+    };
+    return ImageScale_rgb565(&band->pixels[clip.ytop * band->width + clip.xleft], band->width, image->pixels, stride,
+                             image->width, image->height, &window, filter);
+}
@@ -0,0 +1,157 @@
+/*
+ * LT24 Strip Buffered Renderer
+ * ----------------------------
+ * Description:
+ * Band-at-a-time display layer for the LT24 Display Controller
+ *
+ * A full screen RGB565 frame buffer is 150kB, too large for
+ * builds which run entirely from on-chip RAM. This driver instead
+ * renders the display as a series of horizontal bands of a few
+ * scanlines each, so full screen compositing needs only a small
+ * band buffer:
+ *
+ *  - A draw callback is called once per band, and draws everything
+ *    which overlaps the band (background, sprites, text, etc.) into
+ *    the band buffer, in screen coordinates.
+ *  - Each finished band is sent to the display before the callback
+ *    is called for the next band.
+ *
+ *    HpsErr_t drawScene(void* param, LT24SBBand_t* band) {
+ *        LT24SB_fill(band, LT24_BLACK);
+ *        LT24SB_blitKeyed(band, &ship, shipX, shipY, LT24_MAGENTA);
+ *        return ERR_SUCCESS;
+ *    }
+ *    LT24SB_initialise(lt24, 16, dma, dmaParams, &strip);
+ *    LT24SB_render(strip, &drawScene, NULL);
+ *
+ * The band drawing functions clip everything to the band, so the
+ * callback can draw the whole scene each time without checking
+ * which items are visible. LT24SB_blitScaled() only scales the part
+ * of the image which falls within the band, so a scaled background
+ * costs no more in total than when drawn into a full frame buffer.
+ *
+ * If a DMA controller is given, two band buffers are used. Each
+ * band is copied with LT24_copyFrameBufferDma() while the next one
+ * is drawn into the other buffer, so drawing and sending overlap.
+ * Without DMA a single buffer is used and each band is sent with
+ * LT24_copyFrameBuffer(). Either way the memory needed is one or two
+ * bands of LT24_WIDTH x bandLines pixels, e.g. 7.5kB for 16 lines.
+ * The display orientation (LT24_setOrientation()) is followed, so
+ * in landscape each band holds fewer, wider, scanlines.
+ *
+ * Images are described with LT24FBImage_t from the
+ * DE1SoC_LT24FrameBuffer header. Only the type is used, so that
+ * driver need not be built.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add scaled blits with nearest and bilinear filtering
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_LT24STRIPBUFFER_H_
+#define DE1SOC_LT24STRIPBUFFER_H_
+
+//Include required header files
+#include <stdint.h>
+#include "Util/driver_ctx.h"
+#include "Util/driver_dma.h"
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "DE1SoC_LT24FrameBuffer/DE1SoC_LT24FrameBuffer.h"
+
+//Band being drawn
+// - Pixel (x,y) in screen coordinates is at
+//   pixels[(y - ytop) * width + (x - xleft)].
+typedef struct {
+    unsigned short* pixels;
+    unsigned int xleft;
+    unsigned int ytop;
+    unsigned int width;
+    unsigned int height;
+} LT24SBBand_t;
+
+//Band draw callback
+// - Must draw everything which overlaps the band.
+// - Returning an error stops the render, which returns the same error.
+typedef HpsErr_t (*LT24SBDrawFunc_t)(void* param, LT24SBBand_t* band);
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    LT24Ctx_t* display;
+    DmaCtx_t*  dma;          // DMA controller for band copies, or NULL to copy directly
+    void*      dmaParams;    // Parameters for the DMA copies (see LT24_copyFrameBufferDma)
+    unsigned int bandLines;  // Maximum number of scanlines in each band
+    unsigned short* buf[2];  // Band buffers. Only the first is used without DMA.
+    unsigned int next;       // Buffer to draw the next band into
+} LT24SBCtx_t;
+
+//Initialise the strip buffer driver
+// - display is an initialised LT24 driver instance.
+// - bandLines is the number of scanlines in each band (1 to LT24_HEIGHT).
+// - dma is an optional DMA controller to copy each band while the next
+//   is drawn, with dmaParams as for LT24_copyFrameBufferDma(). If NULL,
+//   bands are copied directly by the CPU.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24SB_initialise( LT24Ctx_t* display, unsigned int bandLines, DmaCtx_t* dma, void* dmaParams, LT24SBCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool LT24SB_isInitialised( LT24SBCtx_t* ctx );
+
+//Render the whole display
+// - Calls draw for each band from the top of the display down, sending
+//   each band once drawn.
+// - With DMA, returns once the last band copy has started. Use LT24SB_done()
+//   to check it has finished before using other LT24 APIs.
+HpsErr_t LT24SB_render( LT24SBCtx_t* ctx, LT24SBDrawFunc_t draw, void* param );
+
+//Render a region of the display
+// - As LT24SB_render(), but only the given region is drawn and sent. The
+//   bands are the width of the region, so may be taller than bandLines
+//   for narrow regions.
+HpsErr_t LT24SB_renderRect( LT24SBCtx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height, LT24SBDrawFunc_t draw, void* param );
+
+//Check if the last band has been sent
+// - Returns ERR_SUCCESS if there is no band copy running.
+// - Returns ERR_BUSY if the last band is still being copied.
+HpsErr_t LT24SB_done( LT24SBCtx_t* ctx );
+
+//Fill the whole band with a colour
+HpsErr_t LT24SB_fill( LT24SBBand_t* band, unsigned short colour );
+
+//Fill a rectangle with a colour
+// - The rectangle is in screen coordinates, and is clipped to the band.
+// - Returns ERR_SKIPPED if the rectangle does not overlap the band.
+HpsErr_t LT24SB_fillRect( LT24SBBand_t* band, unsigned short colour, int xleft, int ytop, unsigned int width, unsigned int height );
+
+//Copy an image into the band
+// - (x,y) is the screen position of the top left of the image. The image
+//   is clipped to the band.
+// - Returns ERR_SKIPPED if the image does not overlap the band.
+HpsErr_t LT24SB_blit( LT24SBBand_t* band, const LT24FBImage_t* image, int x, int y );
+
+//Copy an image into the band, skipping transparent pixels
+// - As LT24SB_blit(), but pixels equal to key are not drawn.
+HpsErr_t LT24SB_blitKeyed( LT24SBBand_t* band, const LT24FBImage_t* image, int x, int y, unsigned short key );
+
+//Draw an image scaled to a new size into the band
+// - The image is scaled to width x height pixels with its top left at
+//   screen position (x,y), and clipped to the band. Only the part within
+//   the band is scaled.
+// - filter is IMAGE_SCALE_NEAREST or IMAGE_SCALE_BILINEAR.
+// - Returns ERR_SKIPPED if the scaled image does not overlap the band.
+// - Returns ERR_TOOBIG if the image or scaled size is over IMAGE_SCALE_MAX_SIZE.
+HpsErr_t LT24SB_blitScaled( LT24SBBand_t* band, const LT24FBImage_t* image, int x, int y, unsigned int width, unsigned int height, ImageScaleFilter filter );
+
+#endif /* DE1SOC_LT24STRIPBUFFER_H_ */
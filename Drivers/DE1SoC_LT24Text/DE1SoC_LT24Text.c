@@ -0,0 +1,434 @@
+/*
+ * LT24 Text Renderer
+ * ------------------
+ * Description:
+ * Draws BasicFont text on the LT24 Display Controller
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add scaled and multi-size font rendering
+ * 14/10/2026 | Add hardware scrolling console
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_LT24Text.h"
+
+#include "Util/bit_helpers.h"
+
+//First character in the font table
+#define LT24TEXT_FIRST_CHAR ' '
+
+//BasicFont, as used by default
+const LT24TextFont_t LT24Text_basicFont = {
+    .bitmap = (const unsigned char*)BF_fontMap,
+    .width = 5,
+    .height = LT24TEXT_CHAR_HEIGHT,
+    .spacing = LT24TEXT_CHAR_WIDTH - 5,
+    .lineSpacing = 0,
+    .first = LT24TEXT_FIRST_CHAR,
+    .count = LT24TEXT_GLYPH_COUNT
+};
+
+/*
+ * Internal Functions
+ */
+
+//Get cached glyph for a character, expanding it if required
+static const unsigned short* _LT24Text_glyph( LT24TextCtx_t* ctx, char c, unsigned int row ) {
+    unsigned int idx = (unsigned char)c - LT24TEXT_FIRST_CHAR;
+    //Map unknown characters to '?'
+    if (idx >= LT24TEXT_GLYPH_COUNT) idx = '?' - LT24TEXT_FIRST_CHAR;
+    if (!ctx->cached[idx]) {
+        //Expand each column of the bitmap. Bit n of a column is row n.
+        for (unsigned int x = 0; x < LT24TEXT_CHAR_WIDTH; x++) {
+            unsigned char column = (x < 5) ? (unsigned char)BF_fontMap[idx][x] : 0;
+            for (unsigned int y = 0; y < LT24TEXT_CHAR_HEIGHT; y++) {
+                ctx->glyphs[idx][y][x] = (column & _BV(y)) ? ctx->fgColour : ctx->bgColour;
+            }
+        }
+        ctx->cached[idx] = true;
+    }
+    return ctx->glyphs[idx][row];
+}
+
+//Glyph index of a character in the current font
+// - Unknown characters map to '?', or the first glyph if there is no '?'.
+static unsigned int _LT24Text_fontGlyph( const LT24TextFont_t* font, char c ) {
+    unsigned int idx = (unsigned char)c - font->first;
+    if (idx < font->count) return idx;
+    idx = '?' - font->first;
+    return (idx < font->count) ? idx : 0;
+}
+
+//Check whether a pixel of a glyph is foreground
+static bool _LT24Text_fontPixel( const LT24TextFont_t* font, unsigned int idx, unsigned int x, unsigned int y ) {
+    unsigned int bytesPerColumn = (font->height + 7) / 8;
+    const unsigned char* column = font->bitmap + ((idx * font->width) + x) * bytesPerColumn;
+    return column[y / 8] & _BV(y % 8);
+}
+
+//Find the next run of foreground pixels in a glyph row
+// - Searches from *x. Returns the run length, and moves *x to its start.
+static unsigned int _LT24Text_fontRun( const LT24TextFont_t* font, unsigned int idx, unsigned int* x, unsigned int y ) {
+    unsigned int start = *x;
+    while ((start < font->width) && !_LT24Text_fontPixel(font, idx, start, y)) start++;
+    unsigned int end = start;
+    while ((end < font->width) && _LT24Text_fontPixel(font, idx, end, y)) end++;
+    *x = start;
+    return end - start;
+}
+
+//Get cached spans for a glyph, building them if required
+// - Each run of foreground pixels in a row extends a span from the row
+//   above with the same columns, otherwise starts a new one.
+// - Returns UINT8_MAX if the glyph has too many spans to cache.
+static unsigned int _LT24Text_spans( LT24TextCtx_t* ctx, unsigned int idx ) {
+    if (ctx->spanCached[idx]) return ctx->spanCount[idx];
+    const LT24TextFont_t* font = ctx->font;
+    LT24TextSpan_t* spans = ctx->spans[idx];
+    unsigned int count = 0;
+    for (unsigned int y = 0; (y < font->height) && (count != UINT8_MAX); y++) {
+        unsigned int x = 0;
+        unsigned int width;
+        while ((width = _LT24Text_fontRun(font, idx, &x, y))) {
+            unsigned int span = 0;
+            while ((span < count) && !((spans[span].x == x) && (spans[span].width == width) && ((spans[span].y + spans[span].height) == y))) span++;
+            if (span < count) {
+                spans[span].height++;
+            } else if (count < LT24TEXT_MAX_SPANS) {
+                spans[count++] = (LT24TextSpan_t){ (unsigned char)x, (unsigned char)y, (unsigned char)width, 1 };
+            } else {
+                count = UINT8_MAX;
+                break;
+            }
+            x += width;
+        }
+    }
+    ctx->spanCount[idx] = count;
+    ctx->spanCached[idx] = true;
+    return count;
+}
+
+//Draw the foreground of a glyph
+// - (x,y) is the top left of the scaled glyph.
+static HpsErr_t _LT24Text_drawGlyphSpans( LT24TextCtx_t* ctx, unsigned int idx, unsigned int x, unsigned int y ) {
+    const unsigned int scale = ctx->scale;
+    unsigned int count = _LT24Text_spans(ctx, idx);
+    HpsErr_t status;
+    if (count != UINT8_MAX) {
+        //One fill per cached span
+        for (unsigned int span = 0; span < count; span++) {
+            const LT24TextSpan_t* sp = &ctx->spans[idx][span];
+            status = LT24_fillRect(ctx->display, ctx->fgColour, x + sp->x * scale, y + sp->y * scale, sp->width * scale, sp->height * scale);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        return ERR_SUCCESS;
+    }
+    //Too many spans to cache, so fill each run of each row as found
+    for (unsigned int row = 0; row < ctx->font->height; row++) {
+        unsigned int col = 0;
+        unsigned int width;
+        while ((width = _LT24Text_fontRun(ctx->font, idx, &col, row))) {
+            status = LT24_fillRect(ctx->display, ctx->fgColour, x + col * scale, y + row * scale, width * scale, scale);
+            if (ERR_IS_ERROR(status)) return status;
+            col += width;
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+//Size of a character cell for the current font and scale
+static unsigned int _LT24Text_cellWidth( LT24TextCtx_t* ctx ) {
+    return (ctx->font->width + ctx->font->spacing) * ctx->scale;
+}
+static unsigned int _LT24Text_cellHeight( LT24TextCtx_t* ctx ) {
+    return (ctx->font->height + ctx->font->lineSpacing) * ctx->scale;
+}
+
+//Draw a line of characters in BasicFont at 1x
+// - count characters from str are drawn. Must fit on display.
+static HpsErr_t _LT24Text_drawLineBasic( LT24TextCtx_t* ctx, const char* str, unsigned int count, unsigned int x, unsigned int y ) {
+    //One window for the whole line
+    HpsErr_t status = LT24_setWindow(ctx->display, x, y, count * LT24TEXT_CHAR_WIDTH, LT24TEXT_CHAR_HEIGHT);
+    if (ERR_IS_ERROR(status)) return status;
+    //Stream each row of each glyph in turn
+    for (unsigned int row = 0; row < LT24TEXT_CHAR_HEIGHT; row++) {
+        for (unsigned int idx = 0; idx < count; idx++) {
+            status = LT24_streamPixels(ctx->display, _LT24Text_glyph(ctx, str[idx], row), LT24TEXT_CHAR_WIDTH);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+//Draw a line of characters in the current font and scale
+// - count characters from str are drawn. Must fit on display.
+static HpsErr_t _LT24Text_drawLine( LT24TextCtx_t* ctx, const char* str, unsigned int count, unsigned int x, unsigned int y ) {
+    //BasicFont at 1x uses the pre-expanded glyphs
+    if ((ctx->font == &LT24Text_basicFont) && (ctx->scale == 1)) return _LT24Text_drawLineBasic(ctx, str, count, x, y);
+    //Otherwise the background of the whole line in one go, then the spans of
+    //each glyph on top.
+    unsigned int cellWidth = _LT24Text_cellWidth(ctx);
+    HpsErr_t status = LT24_fillRect(ctx->display, ctx->bgColour, x, y, count * cellWidth, _LT24Text_cellHeight(ctx));
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        status = _LT24Text_drawGlyphSpans(ctx, _LT24Text_fontGlyph(ctx->font, str[idx]), x + idx * cellWidth, y);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Frame memory row of a console text line
+// - line is counted from the top of the console as currently displayed.
+static unsigned int _LT24Text_consoleRow( LT24TextCtx_t* ctx, unsigned int line ) {
+    return ctx->console.top + ((ctx->console.offset + (line * LT24TEXT_CHAR_HEIGHT)) % ctx->console.height);
+}
+
+//Move console cursor to a new line
+// - Once on the last line, scrolls up. Only the newly exposed line needs
+//   to be cleared, as everything else moves with the scroll position.
+static HpsErr_t _LT24Text_consoleNewLine( LT24TextCtx_t* ctx ) {
+    ctx->console.column = 0;
+    if ((ctx->console.line + 1) < (ctx->console.height / LT24TEXT_CHAR_HEIGHT)) {
+        ctx->console.line++;
+        return ERR_SUCCESS;
+    }
+    //The top line becomes the new bottom one, so clear it first
+    HpsErr_t status = LT24_fillRect(ctx->display, ctx->bgColour, 0, _LT24Text_consoleRow(ctx, 0), LT24_WIDTH, LT24TEXT_CHAR_HEIGHT);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->console.offset = (ctx->console.offset + LT24TEXT_CHAR_HEIGHT) % ctx->console.height;
+    return LT24_setScrollStart(ctx->display, ctx->console.top + ctx->console.offset);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the text renderer
+// - display is an initialised LT24 driver instance.
+// - Colours default to white text on a black background.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24Text_initialise( LT24Ctx_t* display, LT24TextCtx_t** pCtx ) {
+    //Check if the LT24 display has been initialised (required)
+    if (!LT24_isInitialised(display)) return ERR_BADDEVICE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save display pointer and default colours. Cache starts empty.
+    LT24TextCtx_t* ctx = *pCtx;
+    ctx->display  = display;
+    ctx->fgColour = LT24_WHITE;
+    ctx->bgColour = LT24_BLACK;
+    for (unsigned int idx = 0; idx < LT24TEXT_GLYPH_COUNT; idx++) {
+        ctx->cached[idx] = false;
+    }
+    ctx->font = &LT24Text_basicFont;
+    ctx->scale = 1;
+    for (unsigned int idx = 0; idx < LT24TEXT_FONT_MAX_GLYPHS; idx++) {
+        ctx->spanCached[idx] = false;
+    }
+    ctx->console.active = false;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+bool LT24Text_isInitialised( LT24TextCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Set the text colours
+// - Clears the glyph cache if the colours have changed.
+HpsErr_t LT24Text_setColour( LT24TextCtx_t* ctx, unsigned short fgColour, unsigned short bgColour ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Nothing to do if colours are unchanged
+    if ((ctx->fgColour == fgColour) && (ctx->bgColour == bgColour)) return ERR_SUCCESS;
+    ctx->fgColour = fgColour;
+    ctx->bgColour = bgColour;
+    //Cached glyphs are for the old colours
+    for (unsigned int idx = 0; idx < LT24TEXT_GLYPH_COUNT; idx++) {
+        ctx->cached[idx] = false;
+    }
+    return ERR_SUCCESS;
+}
+
+//Set the font and scale
+// - font is the font to use, or NULL for BasicFont.
+// - scale is the integer scale factor, 1 to LT24TEXT_MAX_SCALE.
+// - Clears the span cache if the font has changed.
+// - Returns LT24_INVALIDSIZE if the font or scale is outside the limits.
+HpsErr_t LT24Text_setFont( LT24TextCtx_t* ctx, const LT24TextFont_t* font, unsigned int scale ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!font) font = &LT24Text_basicFont;
+    if (!font->bitmap) return ERR_NULLPTR;
+    if (!scale || (scale > LT24TEXT_MAX_SCALE)) return LT24_INVALIDSIZE;
+    if (!font->width || (font->width > LT24TEXT_FONT_MAX_SIZE) || !font->height || (font->height > LT24TEXT_FONT_MAX_SIZE)) return LT24_INVALIDSIZE;
+    if (!font->count || (font->count > LT24TEXT_FONT_MAX_GLYPHS)) return LT24_INVALIDSIZE;
+    ctx->scale = scale;
+    //Spans are in font pixels, so only need clearing for a new font
+    if (ctx->font == font) return ERR_SUCCESS;
+    ctx->font = font;
+    for (unsigned int idx = 0; idx < LT24TEXT_FONT_MAX_GLYPHS; idx++) {
+        ctx->spanCached[idx] = false;
+    }
+    return ERR_SUCCESS;
+}
+
+//Get the size of a character cell
+// - Size in pixels for the current font and scale, including spacing.
+HpsErr_t LT24Text_getCellSize( LT24TextCtx_t* ctx, unsigned int* width, unsigned int* height ) {
+    if (!width || !height) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    *width = _LT24Text_cellWidth(ctx);
+    *height = _LT24Text_cellHeight(ctx);
+    return ERR_SUCCESS;
+}
+
+//Draw a single character
+// - (x,y) is the top left of the character cell.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Text_drawChar( LT24TextCtx_t* ctx, char c, unsigned int x, unsigned int y ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Draw as a line of one character
+    return _LT24Text_drawLine(ctx, &c, 1, x, y);
+}
+
+//Draw a string
+// - (x,y) is the top left of the first character cell.
+// - A '\n' character moves to the next line, starting again at x.
+// - Each line is clipped at the right hand edge of the display. Drawing
+//   stops at the bottom of the display.
+// - Returns number of characters drawn if successful, or error code.
+HpsErr_t LT24Text_drawString( LT24TextCtx_t* ctx, const char* str, unsigned int x, unsigned int y ) {
+    if (!str) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (x >= LT24_WIDTH) return LT24_INVALIDSIZE;
+    //Number of characters that will fit on each line
+    unsigned int cellHeight = _LT24Text_cellHeight(ctx);
+    unsigned int maxChars = (LT24_WIDTH - x) / _LT24Text_cellWidth(ctx);
+    HpsErr_t drawn = 0;
+    while (*str && (y <= LT24_HEIGHT) && (cellHeight <= (LT24_HEIGHT - y))) {
+        //Find the end of the line
+        unsigned int len = 0;
+        while (str[len] && (str[len] != '\n')) len++;
+        //Draw what fits
+        unsigned int count = (len > maxChars) ? maxChars : len;
+        if (count) {
+            status = _LT24Text_drawLine(ctx, str, count, x, y);
+            if (ERR_IS_ERROR(status)) return status;
+            drawn += count;
+        }
+        //Then move on to the next line
+        str += len;
+        if (*str == '\n') str++;
+        y += cellHeight;
+    }
+    return drawn;
+}
+
+//Start a scrolling text console
+// - top is the first display row of the console, and height the number of
+//   rows. height is rounded down to a whole number of text lines.
+// - The console rows are cleared to the background colour.
+// - Returns LT24_INVALIDSIZE if the rows don't fit, or hold no text lines.
+HpsErr_t LT24Text_consoleStart( LT24TextCtx_t* ctx, unsigned int top, unsigned int height ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Whole number of text lines only, so that lines never wrap round the scroll area
+    height -= height % LT24TEXT_CHAR_HEIGHT;
+    if (!height || (top > LT24_HEIGHT) || (height > (LT24_HEIGHT - top))) return LT24_INVALIDSIZE;
+    //Clear console rows and define them as the scroll area
+    status = LT24_fillRect(ctx->display, ctx->bgColour, 0, top, LT24_WIDTH, height);
+    if (ERR_IS_ERROR(status)) return status;
+    status = LT24_setScrollArea(ctx->display, top, height);
+    if (ERR_IS_ERROR(status)) return status;
+    status = LT24_setScrollStart(ctx->display, top);
+    if (ERR_IS_ERROR(status)) return status;
+    //Cursor starts at top left
+    ctx->console.top = top;
+    ctx->console.height = height;
+    ctx->console.offset = 0;
+    ctx->console.line = 0;
+    ctx->console.column = 0;
+    ctx->console.active = true;
+    return ERR_SUCCESS;
+}
+
+//Write text to the console
+// - '\n' starts a new line, '\r' returns to the start of the current line.
+// - Text past the right hand edge wraps to a new line.
+// - New lines at the bottom scroll the console up by one line.
+// - Returns number of characters drawn if successful, or error code.
+// - Returns ERR_NOTREADY if the console has not been started.
+HpsErr_t LT24Text_consoleWrite( LT24TextCtx_t* ctx, const char* str ) {
+    if (!str) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->console.active) return ERR_NOTREADY;
+    const unsigned int maxChars = LT24_WIDTH / LT24TEXT_CHAR_WIDTH;
+    HpsErr_t drawn = 0;
+    while (*str) {
+        if (*str == '\n') {
+            status = _LT24Text_consoleNewLine(ctx);
+            if (ERR_IS_ERROR(status)) return status;
+            str++;
+            continue;
+        }
+        if (*str == '\r') {
+            ctx->console.column = 0;
+            str++;
+            continue;
+        }
+        //Wrap if the line is full
+        if (ctx->console.column >= maxChars) {
+            status = _LT24Text_consoleNewLine(ctx);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        //Draw as much as fits on this line in one go
+        unsigned int count = 0;
+        while (str[count] && (str[count] != '\n') && (str[count] != '\r') && ((ctx->console.column + count) < maxChars)) count++;
+        status = _LT24Text_drawLineBasic(ctx, str, count, ctx->console.column * LT24TEXT_CHAR_WIDTH, _LT24Text_consoleRow(ctx, ctx->console.line));
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->console.column += count;
+        str += count;
+        drawn += count;
+    }
+    return drawn;
+}
+
+//Stop the scrolling text console
+// - Returns the whole display to unscrolled. The console rows keep their
+//   frame memory contents, so will appear out of order until redrawn.
+HpsErr_t LT24Text_consoleStop( LT24TextCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->console.active) return ERR_SUCCESS;
+    //Whole display unscrolled
+    status = LT24_setScrollArea(ctx->display, 0, LT24_HEIGHT);
+    if (ERR_IS_ERROR(status)) return status;
+    status = LT24_setScrollStart(ctx->display, 0);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->console.active = false;
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,213 @@
+/*
+ * LT24 Text Renderer
+ * ------------------
+ * Description:
+ * Draws BasicFont text on the LT24 Display Controller
+ *
+ * Characters from the BasicFont table are drawn in a 6x8 pixel
+ * cell (5 columns of glyph plus 1 column of spacing).
+ *
+ * Rather than plotting each pixel of a character individually,
+ * glyphs are expanded into RGB565 pixel blocks for the current
+ * foreground and background colours the first time they are
+ * used. The expanded glyphs are cached, so subsequent uses only
+ * need to stream the cached pixels to the display.
+ *
+ * Strings are drawn using a single LT24_setWindow() per line of
+ * text. Changing colours with LT24Text_setColour() clears the
+ * cache.
+ *
+ * Characters not in the font table are drawn as '?'. Custom
+ * characters at the end of the table are accessed with values
+ * following '~' (e.g. "\x7F" for the first custom character).
+ *
+ * Fonts and Scaling
+ * -----------------
+ *
+ * Text can be drawn at an integer scale, and in other fonts which use
+ * the same column format as BasicFont (bit n of each column is row n).
+ * Fonts taller than 8 rows use several bytes per column, least
+ * significant row first:
+ *
+ *     LT24Text_setFont(text, &myLargeFont, 1);
+ *     LT24Text_setFont(text, NULL, 3);   //BasicFont at 3x
+ *
+ * Other than BasicFont at 1x, glyphs are cached as lists of spans, each
+ * a rectangle of foreground pixels merged across rows where columns line
+ * up. A line of text is drawn by filling its background in one window,
+ * then filling each span of each glyph, so large text costs one fill per
+ * stroke rather than streaming every pixel. The span cache does not
+ * depend on colour, so is only cleared when changing font.
+ *
+ * Console
+ * -------
+ *
+ * A band of rows on the display can be used as a scrolling text
+ * console, e.g. for logging:
+ *
+ *     LT24Text_consoleStart(text, 0, LT24_HEIGHT);
+ *     LT24Text_consoleWrite(text, "Hello\n");
+ *
+ * Once the console is full, each new line scrolls the display up
+ * using the LT24 hardware vertical scrolling, so only the newly
+ * exposed line is cleared and drawn rather than the whole console.
+ * Lines longer than the display width wrap.
+ *
+ * While the console is running, frame memory in the console rows
+ * is shown rotated by the scroll position, so other drawing should
+ * keep to the rows outside it. The console always uses BasicFont at 1x.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add scaled and multi-size font rendering
+ * 14/10/2026 | Add hardware scrolling console
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_LT24TEXT_H_
+#define DE1SOC_LT24TEXT_H_
+
+//Include required header files
+#include <stdint.h>
+#include "Util/driver_ctx.h"
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "BasicFont/BasicFont.h"
+
+//Size of a character cell in pixels
+#define LT24TEXT_CHAR_WIDTH  6
+#define LT24TEXT_CHAR_HEIGHT 8
+
+//Number of glyphs in BasicFont table
+#define LT24TEXT_GLYPH_COUNT (96 + numberOfCustomCharacters)
+
+//Limits on fonts for the span cache
+#define LT24TEXT_FONT_MAX_GLYPHS 128
+#define LT24TEXT_FONT_MAX_SIZE   16
+#define LT24TEXT_MAX_SCALE       8
+
+//Maximum number of spans cached per glyph. Glyphs needing more are drawn
+//row by row each time instead.
+#ifndef LT24TEXT_MAX_SPANS
+#define LT24TEXT_MAX_SPANS       32
+#endif
+
+//Font description
+// - bitmap holds count glyphs, each width columns of (height + 7) / 8
+//   bytes. Bit n of a column is row n.
+typedef struct {
+    const unsigned char* bitmap;
+    unsigned char width;        // Columns per glyph
+    unsigned char height;       // Rows per glyph
+    unsigned char spacing;      // Blank columns between glyphs
+    unsigned char lineSpacing;  // Blank rows between lines
+    unsigned char first;        // Character of first glyph
+    unsigned char count;        // Number of glyphs
+} LT24TextFont_t;
+
+//Rectangle of foreground pixels in a glyph, in unscaled font pixels
+typedef struct {
+    unsigned char x;
+    unsigned char y;
+    unsigned char width;
+    unsigned char height;
+} LT24TextSpan_t;
+
+//BasicFont, as used by default
+extern const LT24TextFont_t LT24Text_basicFont;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    LT24Ctx_t* display;
+    unsigned short fgColour;
+    unsigned short bgColour;
+    // Glyph cache. Each glyph is stored row by row for streaming to display.
+    bool cached[LT24TEXT_GLYPH_COUNT];
+    unsigned short glyphs[LT24TEXT_GLYPH_COUNT][LT24TEXT_CHAR_HEIGHT][LT24TEXT_CHAR_WIDTH];
+    // Current font and scale
+    const LT24TextFont_t* font;
+    unsigned int scale;
+    // Span cache for the current font. A count of UINT8_MAX marks a glyph with too many spans.
+    bool spanCached[LT24TEXT_FONT_MAX_GLYPHS];
+    unsigned char spanCount[LT24TEXT_FONT_MAX_GLYPHS];
+    LT24TextSpan_t spans[LT24TEXT_FONT_MAX_GLYPHS][LT24TEXT_MAX_SPANS];
+    // Scrolling console
+    struct {
+        bool         active;
+        unsigned int top;     // First display row of console
+        unsigned int height;  // Rows in console, whole number of text lines
+        unsigned int offset;  // Scroll position, in rows from top
+        unsigned int line;    // Text line of cursor on display
+        unsigned int column;  // Character column of cursor
+    } console;
+} LT24TextCtx_t;
+
+//Initialise the text renderer
+// - display is an initialised LT24 driver instance.
+// - Colours default to white text on a black background.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t LT24Text_initialise( LT24Ctx_t* display, LT24TextCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool LT24Text_isInitialised( LT24TextCtx_t* ctx );
+
+//Set the text colours
+// - Clears the glyph cache if the colours have changed.
+HpsErr_t LT24Text_setColour( LT24TextCtx_t* ctx, unsigned short fgColour, unsigned short bgColour );
+
+//Set the font and scale
+// - font is the font to use, or NULL for BasicFont.
+// - scale is the integer scale factor, 1 to LT24TEXT_MAX_SCALE.
+// - Clears the span cache if the font has changed.
+// - Returns LT24_INVALIDSIZE if the font or scale is outside the limits.
+HpsErr_t LT24Text_setFont( LT24TextCtx_t* ctx, const LT24TextFont_t* font, unsigned int scale );
+
+//Get the size of a character cell
+// - Size in pixels for the current font and scale, including spacing.
+HpsErr_t LT24Text_getCellSize( LT24TextCtx_t* ctx, unsigned int* width, unsigned int* height );
+
+//Draw a single character
+// - (x,y) is the top left of the character cell.
+// - returns ERR_SUCCESS if successful
+HpsErr_t LT24Text_drawChar( LT24TextCtx_t* ctx, char c, unsigned int x, unsigned int y );
+
+//Draw a string
+// - (x,y) is the top left of the first character cell.
+// - A '\n' character moves to the next line, starting again at x.
+// - Each line is clipped at the right hand edge of the display. Drawing
+//   stops at the bottom of the display.
+// - Returns number of characters drawn if successful, or error code.
+HpsErr_t LT24Text_drawString( LT24TextCtx_t* ctx, const char* str, unsigned int x, unsigned int y );
+
+//Start a scrolling text console
+// - top is the first display row of the console, and height the number of
+//   rows. height is rounded down to a whole number of text lines.
+// - The console rows are cleared to the background colour.
+// - Returns LT24_INVALIDSIZE if the rows don't fit, or hold no text lines.
+HpsErr_t LT24Text_consoleStart( LT24TextCtx_t* ctx, unsigned int top, unsigned int height );
+
+//Write text to the console
+// - '\n' starts a new line, '\r' returns to the start of the current line.
+// - Text past the right hand edge wraps to a new line.
+// - New lines at the bottom scroll the console up by one line.
+// - Returns number of characters drawn if successful, or error code.
+// - Returns ERR_NOTREADY if the console has not been started.
+HpsErr_t LT24Text_consoleWrite( LT24TextCtx_t* ctx, const char* str );
+
+//Stop the scrolling text console
+// - Returns the whole display to unscrolled. The console rows keep their
+//   frame memory contents, so will appear out of order until redrawn.
+HpsErr_t LT24Text_consoleStop( LT24TextCtx_t* ctx );
+
+#endif /* DE1SOC_LT24TEXT_H_ */
@@ -7,6 +7,17 @@
 
 #include "DE1SoC_Mandelbrot.h"
 #include "Util/bit_helpers.h"
+#include "Util/mem_pool.h"
+#include "Util/lowlevel_arm.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 /*
  * Registers
@@ -41,47 +52,77 @@
 #define MANDELBROT_YMIN(YSIZE, YCENTRE)  (YCENTRE - (YSIZE/2))
 
 #define MANDELBROT_DEFAULT_MAG   2.0
+#define MANDELBROT_DEFAULT_RADIUS 2.60
+
+//Software backend frame. Real axis runs down the rows, imaginary across the columns.
+#define MANDELBROT_ROWS    LT24_HEIGHT
+#define MANDELBROT_COLS    LT24_WIDTH
+#define MANDELBROT_PIXELS  (MANDELBROT_ROWS * MANDELBROT_COLS)
+
+//Software backend escape codes and palette
+#define MANDELBROT_CODE_MASK        0x7FFF
+#define MANDELBROT_DEFAULT_PALETTE  64
+
+//Largest distance from a whole number of pixels for a move to count as a pan
+#define MANDELBROT_PAN_TOLERANCE    1.0e-3
 
 /*
  * Internal Functions
  */
 
-static void _Mandelbrot_setCoordinates( MandelbrotCtx_t* ctx, double radius, double xcentre, double ycentre ) {
+static void _Mandelbrot_prepareView( MandelbrotView_t* view, double radius, double xcentre, double ycentre ) {
     double xsize = MANDELBROT_XSIZE(radius);
     double ysize = MANDELBROT_YSIZE(radius);
-    double xmin = MANDELBROT_XMIN(xsize, xcentre);
-    double ymin = MANDELBROT_YMIN(ysize, ycentre);
-    double xstep = xsize / LT24_HEIGHT;
-    double ystep = ysize / LT24_WIDTH;
+    view->radius = radius;
+    view->xcentre = xcentre;
+    view->ycentre = ycentre;
+    view->xmin = MANDELBROT_XMIN(xsize, xcentre);
+    view->ymin = MANDELBROT_YMIN(ysize, ycentre);
+    view->xstep = xsize / LT24_HEIGHT;
+    view->ystep = ysize / LT24_WIDTH;
+    //Reduced precision copies, so either precision can be loaded without conversion
+    view->xminf = (float)view->xmin;
+    view->yminf = (float)view->ymin;
+    view->xstepf = (float)view->xstep;
+    view->ystepf = (float)view->ystep;
+}
+
+static void _Mandelbrot_setView( MandelbrotCtx_t* ctx, const MandelbrotView_t* view ) {
     //Update internally
-    ctx->magnitude = radius;
-    ctx->xcentre = xcentre;
-    ctx->ycentre = ycentre;
-    //Update device
-    if (ctx->precision == MANDELBROT_FLOAT_PRECISION) {
+    ctx->radius = view->radius;
+    ctx->xcentre = view->xcentre;
+    ctx->ycentre = view->ycentre;
+    ctx->view = *view;
+    //Update device. Values are ready, so registers are written back to back.
+    if (!ctx->base) {
+        //Software backend only needs internal copy
+    } else if (ctx->precision == MANDELBROT_FLOAT_PRECISION) {
         //If single precision, get pointer as float
         volatile float* coeffsPtr = (float*)&ctx->base[MANDELBROT_COEFFS];
         //And store reduced precision values
-        coeffsPtr[MANDELBROT_COEFF_XMIN(float)] = (float)xmin;
-        coeffsPtr[MANDELBROT_COEFF_YMIN(float)] = (float)ymin;
-        coeffsPtr[MANDELBROT_COEFF_XSTEP(float)] = (float)xstep;
-        coeffsPtr[MANDELBROT_COEFF_YSTEP(float)] = (float)ystep;
+        coeffsPtr[MANDELBROT_COEFF_XMIN(float)] = view->xminf;
+        coeffsPtr[MANDELBROT_COEFF_YMIN(float)] = view->yminf;
+        coeffsPtr[MANDELBROT_COEFF_XSTEP(float)] = view->xstepf;
+        coeffsPtr[MANDELBROT_COEFF_YSTEP(float)] = view->ystepf;
     } else {
         //If double precision, get pointer as double
     	volatile double* coeffsPtr = (double*)&ctx->base[MANDELBROT_COEFFS];
         //And store double values
-        coeffsPtr[MANDELBROT_COEFF_XMIN(double)] = xmin;
-        coeffsPtr[MANDELBROT_COEFF_YMIN(double)] = ymin;
-        coeffsPtr[MANDELBROT_COEFF_XSTEP(double)] = xstep;
-        coeffsPtr[MANDELBROT_COEFF_YSTEP(double)] = ystep;
+        coeffsPtr[MANDELBROT_COEFF_XMIN(double)] = view->xmin;
+        coeffsPtr[MANDELBROT_COEFF_YMIN(double)] = view->ymin;
+        coeffsPtr[MANDELBROT_COEFF_XSTEP(double)] = view->xstep;
+        coeffsPtr[MANDELBROT_COEFF_YSTEP(double)] = view->ystep;
     }
 }
 
 static void _Mandelbrot_setZnMax( MandelbrotCtx_t* ctx, double znMax ) {
     //Update internally
     ctx->magnitude = znMax;
+    ctx->soft.znMax2 = znMax * znMax;
     //Update device
-    if (ctx->precision == MANDELBROT_FLOAT_PRECISION) {
+    if (!ctx->base) {
+        //Software backend only needs internal copy
+    } else if (ctx->precision == MANDELBROT_FLOAT_PRECISION) {
         //If single precision, get pointer as float
     	volatile float* coeffsPtr = (float*)&ctx->base[MANDELBROT_COEFFS];
         //And store reduced precision value (square it as register expects zn^2)
@@ -96,14 +137,410 @@ static void _Mandelbrot_setZnMax( MandelbrotCtx_t* ctx, double znMax ) {
 
 static void _Mandelbrot_setCalculationPrecision( MandelbrotCtx_t* ctx, MandelbrotPrecision precision ) {
     ctx->precision = precision;
-    if (precision == MANDELBROT_FLOAT_PRECISION) {
+    if (!ctx->base) {
+        //Software pattern state is stored at the old precision, so must be restarted
+        ctx->soft.init = false;
+    } else if (precision == MANDELBROT_FLOAT_PRECISION) {
         ctx->base[MANDELBROT_CONTROL] = 0;
     } else {
         ctx->base[MANDELBROT_CONTROL] = MANDELBROT_DBL_MODE;
     }
     //Reload existing coordinates to ensure correct precision.
     _Mandelbrot_setZnMax(ctx, ctx->magnitude);
-    _Mandelbrot_setCoordinates(ctx, ctx->radius, ctx->xcentre, ctx->ycentre);
+    _Mandelbrot_setView(ctx, &ctx->view);
+}
+
+static void _Mandelbrot_setDefaults( MandelbrotCtx_t* ctx ) {
+    //Set default co-ordinates
+    ctx->magnitude  =  2.00;
+    ctx->radius     =  MANDELBROT_DEFAULT_RADIUS;
+    ctx->xcentre    = -0.75;
+    ctx->ycentre    =  0.00;
+    _Mandelbrot_prepareView(&ctx->view, ctx->radius, ctx->xcentre, ctx->ycentre);
+    //Start as float precision (will also write our initial co-ordinates)
+    _Mandelbrot_setCalculationPrecision(ctx, MANDELBROT_FLOAT_PRECISION);
+    //Render scheduler starts a pattern of the initial view on first call
+    ctx->render.pending = true;
+    ctx->render.view = ctx->view;
+    ctx->render.maxIterations = 0;
+    ctx->render.adaptive = false;
+}
+
+//Precision needed to resolve the pixels of a view
+// - Single precision while the pixel step is a large enough number of
+//   float steps at the biggest coordinate in the view.
+static MandelbrotPrecision _Mandelbrot_viewPrecision( const MandelbrotView_t* view ) {
+    double xmag = fmax(fabs(view->xmin), fabs(view->xmin + LT24_HEIGHT * view->xstep));
+    double ymag = fmax(fabs(view->ymin), fabs(view->ymin + LT24_WIDTH * view->ystep));
+    double step = fmin(view->xstep, view->ystep);
+    return (step >= fmax(xmag, ymag) * FLT_EPSILON * MANDELBROT_ADAPTIVE_FLOAT_MARGIN) ?
+            MANDELBROT_FLOAT_PRECISION : MANDELBROT_DOUBLE_PRECISION;
+}
+
+//Iteration limit for the zoom of a view
+// - Grows by octaveIterations for each halving of the radius from the default.
+static unsigned int _Mandelbrot_viewIterations( MandelbrotCtx_t* ctx, const MandelbrotView_t* view ) {
+    double octaves = log2(MANDELBROT_DEFAULT_RADIUS / view->radius);
+    if (!(octaves > 0.0)) return ctx->render.baseIterations;
+    return ctx->render.baseIterations + (unsigned int)(octaves * ctx->render.octaveIterations);
+}
+
+//Set the precision and iteration limit for a view in adaptive mode
+// - Must be called between iterations, before the view is loaded.
+static void _Mandelbrot_adaptView( MandelbrotCtx_t* ctx, const MandelbrotView_t* view ) {
+    MandelbrotPrecision precision = _Mandelbrot_viewPrecision(view);
+    if (precision != ctx->precision) {
+        _Mandelbrot_setCalculationPrecision(ctx, precision);
+    }
+    ctx->render.maxIterations = _Mandelbrot_viewIterations(ctx, view);
+}
+
+/*
+ * Software Backend
+ */
+
+//Escape code stored for pixels which escape on a given iteration
+// - Keeps the low bits of (iteration - 1) for palette lookup. 0 is never escaped.
+static inline unsigned short _Mandelbrot_softCode( unsigned int iteration ) {
+    return (unsigned short)(((iteration - 1) & MANDELBROT_CODE_MASK) + 1);
+}
+
+//Colour for an escape code
+static inline unsigned short _Mandelbrot_softColour( MandelbrotCtx_t* ctx, unsigned short code ) {
+    if (!code) return ctx->soft.inside;
+    return ctx->soft.palette[(code - 1 + ctx->soft.paletteOffset) & ctx->soft.paletteMask];
+}
+
+//Load the default palette of blue to red/green bands
+static void _Mandelbrot_softDefaultPalette( MandelbrotCtx_t* ctx ) {
+    for (unsigned int idx = 0; idx < MANDELBROT_DEFAULT_PALETTE; idx++) {
+        unsigned int red = ((idx + 1) * 8) & 0xFF;
+        unsigned int green = ((idx + 1) * 4) & 0xFF;
+        unsigned int blue = 0xFF - red;
+        ctx->soft.palette[idx] = (unsigned short)(((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3));
+    }
+    ctx->soft.paletteMask = MANDELBROT_DEFAULT_PALETTE - 1;
+    ctx->soft.paletteOffset = 0;
+    ctx->soft.inside = 0;
+}
+
+//Recolour the whole frame from the escape codes
+static void _Mandelbrot_softRecolour( MandelbrotCtx_t* ctx ) {
+    const unsigned short* escape = ctx->soft.escape;
+    unsigned short* frame = ctx->soft.frame;
+    for (unsigned int idx = 0; idx < MANDELBROT_PIXELS; idx++) {
+        frame[idx] = _Mandelbrot_softColour(ctx, escape[idx]);
+    }
+}
+
+//Iterate one row of pixels in single precision
+static void _Mandelbrot_softRowFloat( MandelbrotCtx_t* ctx, unsigned int row, unsigned short code, unsigned short colour ) {
+    float* zr = (float*)ctx->soft.z + (row * MANDELBROT_COLS);
+    float* zi = zr + MANDELBROT_PIXELS;
+    unsigned short* escape = &ctx->soft.escape[row * MANDELBROT_COLS];
+    unsigned short* frame = &ctx->soft.frame[row * MANDELBROT_COLS];
+    float bound = (float)ctx->soft.znMax2;
+    float cr = (float)(ctx->view.xmin + row * ctx->view.xstep);
+    float ymin = (float)ctx->view.ymin;
+    float ystep = (float)ctx->view.ystep;
+    unsigned int col = 0;
+#if defined(__ARM_NEON)
+    static const float lanes[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+    float32x4_t vlanes = vld1q_f32(lanes);
+    float32x4_t vcr = vdupq_n_f32(cr);
+    float32x4_t vbound = vdupq_n_f32(bound);
+    uint16x4_t vcode = vdup_n_u16(code);
+    uint16x4_t vcolour = vdup_n_u16(colour);
+    for (; col + 4 <= MANDELBROT_COLS; col += 4) {
+        float32x4_t ci = vmlaq_n_f32(vdupq_n_f32(ymin), vaddq_f32(vdupq_n_f32((float)col), vlanes), ystep);
+        float32x4_t r = vld1q_f32(&zr[col]);
+        float32x4_t i = vld1q_f32(&zi[col]);
+        float32x4_t r2 = vmulq_f32(r, r);
+        float32x4_t i2 = vmulq_f32(i, i);
+        //Pixels which have already escaped keep their last value
+        uint32x4_t active = vcleq_f32(vaddq_f32(r2, i2), vbound);
+        float32x4_t nr = vaddq_f32(vsubq_f32(r2, i2), vcr);
+        float32x4_t ni = vmlaq_f32(ci, vaddq_f32(r, r), i);
+        uint32x4_t escaped = vandq_u32(active, vcgtq_f32(vmlaq_f32(vmulq_f32(nr, nr), ni, ni), vbound));
+        vst1q_f32(&zr[col], vbslq_f32(active, nr, r));
+        vst1q_f32(&zi[col], vbslq_f32(active, ni, i));
+        //Record and colour any which escaped this time
+        uint16x4_t escaped16 = vmovn_u32(escaped);
+        vst1_u16(&escape[col], vbsl_u16(escaped16, vcode, vld1_u16(&escape[col])));
+        vst1_u16(&frame[col], vbsl_u16(escaped16, vcolour, vld1_u16(&frame[col])));
+    }
+#endif
+    for (; col < MANDELBROT_COLS; col++) {
+        float r = zr[col];
+        float i = zi[col];
+        if ((r * r + i * i) > bound) continue;
+        float ci = ymin + (float)col * ystep;
+        float nr = r * r - i * i + cr;
+        float ni = 2.0f * r * i + ci;
+        zr[col] = nr;
+        zi[col] = ni;
+        if ((nr * nr + ni * ni) > bound) {
+            escape[col] = code;
+            frame[col] = colour;
+        }
+    }
+}
+
+//Iterate one row of pixels in double precision
+static void _Mandelbrot_softRowDouble( MandelbrotCtx_t* ctx, unsigned int row, unsigned short code, unsigned short colour ) {
+    double* zr = (double*)ctx->soft.z + (row * MANDELBROT_COLS);
+    double* zi = zr + MANDELBROT_PIXELS;
+    unsigned short* escape = &ctx->soft.escape[row * MANDELBROT_COLS];
+    unsigned short* frame = &ctx->soft.frame[row * MANDELBROT_COLS];
+    double bound = ctx->soft.znMax2;
+    double cr = ctx->view.xmin + row * ctx->view.xstep;
+    for (unsigned int col = 0; col < MANDELBROT_COLS; col++) {
+        double r = zr[col];
+        double i = zi[col];
+        if ((r * r + i * i) > bound) continue;
+        double ci = ctx->view.ymin + col * ctx->view.ystep;
+        double nr = r * r - i * i + cr;
+        double ni = 2.0 * r * i + ci;
+        zr[col] = nr;
+        zi[col] = ni;
+        if ((nr * nr + ni * ni) > bound) {
+            escape[col] = code;
+            frame[col] = colour;
+        }
+    }
+}
+
+//Iterate rows [first, last) of the pattern
+static void _Mandelbrot_softRows( MandelbrotCtx_t* ctx, unsigned int first, unsigned int last ) {
+    unsigned short code = _Mandelbrot_softCode(ctx->soft.iteration);
+    unsigned short colour = _Mandelbrot_softColour(ctx, code);
+    for (unsigned int row = first; row < last; row++) {
+        if (ctx->precision == MANDELBROT_FLOAT_PRECISION) {
+            _Mandelbrot_softRowFloat(ctx, row, code, colour);
+        } else {
+            _Mandelbrot_softRowDouble(ctx, row, code, colour);
+        }
+    }
+}
+
+//CPU1 work item. Iterates rows from arg to the end of the frame.
+static void _Mandelbrot_softWork( void* param, unsigned int arg ) {
+    MandelbrotCtx_t* ctx = (MandelbrotCtx_t*)param;
+    _Mandelbrot_softRows(ctx, arg, MANDELBROT_ROWS);
+    //Results must be visible before CPU0 sees we are done
+    __DMB();
+    ctx->soft.cpu1Busy = false;
+}
+
+//Start a new software pattern
+static HpsErr_t _Mandelbrot_softReset( MandelbrotCtx_t* ctx ) {
+    if (ctx->soft.cpu1Busy) return ERR_BUSY;
+    size_t zSize = (ctx->precision == MANDELBROT_FLOAT_PRECISION) ? sizeof(float) : sizeof(double);
+    memset(ctx->soft.z, 0, 2 * MANDELBROT_PIXELS * zSize);
+    memset(ctx->soft.escape, 0, MANDELBROT_PIXELS * sizeof(unsigned short));
+    _Mandelbrot_softRecolour(ctx);
+    ctx->soft.iteration = 0;
+    ctx->soft.init = true;
+    ctx->soft.copyPending = true;
+    return ERR_SUCCESS;
+}
+
+//Run a software iteration
+static HpsErr_t _Mandelbrot_softIterate( MandelbrotCtx_t* ctx ) {
+    ctx->soft.iteration++;
+    unsigned int split = MANDELBROT_ROWS;
+    if (ctx->soft.smp) {
+        //Bottom half to CPU1. If its queue is full, do the whole lot here.
+        ctx->soft.cpu1Busy = true;
+        __DMB();
+        HpsErr_t status = SMP_post(ctx->soft.smp, SMP_CPU1, &_Mandelbrot_softWork, ctx, MANDELBROT_ROWS / 2);
+        if (ERR_IS_ERROR(status)) {
+            ctx->soft.cpu1Busy = false;
+        } else {
+            split = MANDELBROT_ROWS / 2;
+        }
+    }
+    _Mandelbrot_softRows(ctx, 0, split);
+    ctx->soft.copyPending = true;
+    return ERR_SUCCESS;
+}
+
+//Check if a software iteration is done
+// - Copies the frame to the display once both halves are complete.
+static HpsErr_t _Mandelbrot_softDone( MandelbrotCtx_t* ctx ) {
+    if (!ctx->soft.init) return ERR_NOTREADY;
+    if (ctx->soft.cpu1Busy) return ERR_BUSY;
+    if (ctx->soft.copyPending) {
+        __DMB();
+        HpsErr_t status = LT24_copyFrameBuffer(ctx->lt24, ctx->soft.frame, 0, 0, MANDELBROT_COLS, MANDELBROT_ROWS);
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->soft.copyPending = false;
+    }
+    return ERR_SUCCESS;
+}
+
+//Move a plane of the software pattern by a number of pixels
+// - New pixel (row, col) takes the value of old pixel (row + drow, col + dcol).
+//   Pixels with no old value are left for _Mandelbrot_softCatchUp().
+static void _Mandelbrot_softShift( void* plane, size_t size, int drow, int dcol ) {
+    unsigned char* bytes = (unsigned char*)plane;
+    size_t rowSize = MANDELBROT_COLS * size;
+    size_t keep = (MANDELBROT_COLS - abs(dcol)) * size;
+    size_t dstCol = (dcol < 0) ? (-dcol * size) : 0;
+    size_t srcCol = (dcol > 0) ? (dcol * size) : 0;
+    //Rows are visited in the order which never overwrites a row still to be read
+    unsigned int rows = MANDELBROT_ROWS - abs(drow);
+    for (unsigned int idx = 0; idx < rows; idx++) {
+        unsigned int row = (drow >= 0) ? idx : (MANDELBROT_ROWS - 1 - idx);
+        memmove(&bytes[row * rowSize + dstCol], &bytes[(row + drow) * rowSize + srcCol], keep);
+    }
+}
+
+//Bring a newly exposed pixel up to the current iteration in single precision
+static void _Mandelbrot_softPixelFloat( MandelbrotCtx_t* ctx, unsigned int row, unsigned int col ) {
+    float* zr = (float*)ctx->soft.z + (row * MANDELBROT_COLS + col);
+    float* zi = zr + MANDELBROT_PIXELS;
+    float bound = (float)ctx->soft.znMax2;
+    float cr = (float)(ctx->view.xmin + row * ctx->view.xstep);
+    float ci = (float)ctx->view.ymin + (float)col * (float)ctx->view.ystep;
+    float r = 0.0f;
+    float i = 0.0f;
+    unsigned short code = 0;
+    for (unsigned int iteration = 1; iteration <= ctx->soft.iteration; iteration++) {
+        float nr = r * r - i * i + cr;
+        i = 2.0f * r * i + ci;
+        r = nr;
+        if ((r * r + i * i) > bound) {
+            code = _Mandelbrot_softCode(iteration);
+            break;
+        }
+    }
+    *zr = r;
+    *zi = i;
+    ctx->soft.escape[row * MANDELBROT_COLS + col] = code;
+    ctx->soft.frame[row * MANDELBROT_COLS + col] = _Mandelbrot_softColour(ctx, code);
+}
+
+//Bring a newly exposed pixel up to the current iteration in double precision
+static void _Mandelbrot_softPixelDouble( MandelbrotCtx_t* ctx, unsigned int row, unsigned int col ) {
+    double* zr = (double*)ctx->soft.z + (row * MANDELBROT_COLS + col);
+    double* zi = zr + MANDELBROT_PIXELS;
+    double bound = ctx->soft.znMax2;
+    double cr = ctx->view.xmin + row * ctx->view.xstep;
+    double ci = ctx->view.ymin + col * ctx->view.ystep;
+    double r = 0.0;
+    double i = 0.0;
+    unsigned short code = 0;
+    for (unsigned int iteration = 1; iteration <= ctx->soft.iteration; iteration++) {
+        double nr = r * r - i * i + cr;
+        i = 2.0 * r * i + ci;
+        r = nr;
+        if ((r * r + i * i) > bound) {
+            code = _Mandelbrot_softCode(iteration);
+            break;
+        }
+    }
+    *zr = r;
+    *zi = i;
+    ctx->soft.escape[row * MANDELBROT_COLS + col] = code;
+    ctx->soft.frame[row * MANDELBROT_COLS + col] = _Mandelbrot_softColour(ctx, code);
+}
+
+//Bring columns [first, last) of a row up to the current iteration
+// - Must be called after the new view is loaded.
+static void _Mandelbrot_softCatchUp( MandelbrotCtx_t* ctx, unsigned int row, unsigned int first, unsigned int last ) {
+    for (unsigned int col = first; col < last; col++) {
+        if (ctx->precision == MANDELBROT_FLOAT_PRECISION) {
+            _Mandelbrot_softPixelFloat(ctx, row, col);
+        } else {
+            _Mandelbrot_softPixelDouble(ctx, row, col);
+        }
+    }
+}
+
+//Load a view, keeping the software pattern if it is only panned
+// - If the view has the same pixel step as the current one and is moved by
+//   a whole number of pixels, the pattern is shifted and only the newly
+//   exposed strips are iterated, up to the current iteration.
+// - Returns true if the pattern was kept. Otherwise the view is loaded as
+//   normal, and a new pattern must be started.
+static bool _Mandelbrot_panView( MandelbrotCtx_t* ctx, const MandelbrotView_t* view ) {
+    //FPGA controller draws straight to the display, so has no pattern to keep
+    if (ctx->base || !ctx->soft.init || ctx->soft.cpu1Busy ||
+        (view->xstep != ctx->view.xstep) || (view->ystep != ctx->view.ystep)) {
+        _Mandelbrot_setView(ctx, view);
+        return false;
+    }
+    double rows = (view->xmin - ctx->view.xmin) / view->xstep;
+    double cols = (view->ymin - ctx->view.ymin) / view->ystep;
+    //Must move by whole pixels, and keep some of the pattern
+    if ((fabs(rows) >= MANDELBROT_ROWS) || (fabs(cols) >= MANDELBROT_COLS) ||
+        (fabs(rows - round(rows)) > MANDELBROT_PAN_TOLERANCE) || (fabs(cols - round(cols)) > MANDELBROT_PAN_TOLERANCE)) {
+        _Mandelbrot_setView(ctx, view);
+        return false;
+    }
+    int drow = (int)round(rows);
+    int dcol = (int)round(cols);
+    //Move what is still in view
+    size_t zSize = (ctx->precision == MANDELBROT_FLOAT_PRECISION) ? sizeof(float) : sizeof(double);
+    _Mandelbrot_softShift(ctx->soft.z, zSize, drow, dcol);
+    _Mandelbrot_softShift((unsigned char*)ctx->soft.z + MANDELBROT_PIXELS * zSize, zSize, drow, dcol);
+    _Mandelbrot_softShift(ctx->soft.escape, sizeof(unsigned short), drow, dcol);
+    _Mandelbrot_softShift(ctx->soft.frame, sizeof(unsigned short), drow, dcol);
+    _Mandelbrot_setView(ctx, view);
+    //Then iterate the exposed strips
+    unsigned int keepFirst = (drow < 0) ? -drow : 0;
+    unsigned int keepLast = (drow > 0) ? (MANDELBROT_ROWS - drow) : MANDELBROT_ROWS;
+    unsigned int colFirst = (dcol < 0) ? -dcol : 0;
+    unsigned int colLast = (dcol > 0) ? (MANDELBROT_COLS - dcol) : MANDELBROT_COLS;
+    for (unsigned int row = 0; row < MANDELBROT_ROWS; row++) {
+        if ((row < keepFirst) || (row >= keepLast)) {
+            _Mandelbrot_softCatchUp(ctx, row, 0, MANDELBROT_COLS);
+        } else {
+            _Mandelbrot_softCatchUp(ctx, row, 0, colFirst);
+            _Mandelbrot_softCatchUp(ctx, row, colLast, MANDELBROT_COLS);
+        }
+    }
+    ctx->soft.copyPending = true;
+    _Mandelbrot_softDone(ctx);
+    return true;
+}
+
+//Get the part of a view drawn by one engine of a pool
+// - Strips run along the real axis, so only the real minimum moves.
+static void _MandelbrotPool_tileView( const MandelbrotView_t* view, unsigned int index, unsigned int count, MandelbrotView_t* tile ) {
+    unsigned int rows = LT24_HEIGHT / count;
+    *tile = *view;
+    tile->xmin = view->xmin + (double)(index * rows) * view->xstep;
+    tile->xminf = (float)tile->xmin;
+    tile->xcentre = tile->xmin + (double)rows * view->xstep / 2.0;
+}
+
+//Pool Cleanup
+static void _MandelbrotPool_cleanup( MandelbrotPoolCtx_t* ctx ) {
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        if (ctx->engines[idx]) {
+            DriverContextFree(&ctx->engines[idx]);
+        }
+    }
+}
+
+//Cleanup
+static void _Mandelbrot_cleanup( MandelbrotCtx_t* ctx ) {
+    //CPU1 may still be using the pattern state
+    while (ctx->soft.cpu1Busy);
+    if (ctx->soft.z) {
+        MemPool_free(ctx->soft.z);
+        ctx->soft.z = NULL;
+    }
+    if (ctx->soft.escape) {
+        MemPool_free(ctx->soft.escape);
+        ctx->soft.escape = NULL;
+    }
+    if (ctx->soft.frame) {
+        MemPool_free(ctx->soft.frame);
+        ctx->soft.frame = NULL;
+    }
 }
 
 /*
@@ -120,18 +557,44 @@ HpsErr_t Mandelbrot_initialise( void* base, LT24Ctx_t* lt24ctx, MandelbrotCtx_t*
     //Check if the LT24 display has been initialised (required)
     if (!LT24_isInitialised(lt24ctx)) return ERR_NOINIT;
     //Allocate the driver context, validating return value.
-    HpsErr_t status = DriverContextAllocate(pCtx);
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_Mandelbrot_cleanup);
     if (ERR_IS_ERROR(status)) return status;
     //Save base address pointers
     MandelbrotCtx_t* ctx = *pCtx;
     ctx->base = (unsigned char*)base;
-    //Set default co-ordinates
-    ctx->magnitude  =  2.00;
-    ctx->radius     =  2.60;
-    ctx->xcentre    = -0.75;
-    ctx->ycentre    =  0.00;
-    //Start as float precision (will also write our initial co-ordinates)
-    _Mandelbrot_setCalculationPrecision(ctx, MANDELBROT_FLOAT_PRECISION);
+    ctx->lt24 = lt24ctx;
+    //Set default co-ordinates and precision
+    _Mandelbrot_setDefaults(ctx);
+    //And done
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Function to initialise the Mandelbrot software backend
+// - Requires that the LT24 controller has already been initialised.
+// - smp is an SMP context with CPU1 running, to share each iteration with
+//   CPU1, or NULL to run only on the calling core.
+// - Allocates about 1.3MB for the pattern state.
+// - Returns 0 if successful
+HpsErr_t Mandelbrot_initialiseSoftware( LT24Ctx_t* lt24ctx, SmpCtx_t* smp, MandelbrotCtx_t** pCtx ) {
+    //Check if the LT24 display has been initialised (required)
+    if (!LT24_isInitialised(lt24ctx)) return ERR_NOINIT;
+    if (smp && !SMP_isInitialised(smp)) return ERR_NOINIT;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_Mandelbrot_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //No controller, so base stays NULL
+    MandelbrotCtx_t* ctx = *pCtx;
+    ctx->lt24 = lt24ctx;
+    ctx->soft.smp = smp;
+    //Pattern state is big enough for double precision
+    ctx->soft.z = MemPool_malloc(2 * MANDELBROT_PIXELS * sizeof(double));
+    ctx->soft.escape = MemPool_malloc(MANDELBROT_PIXELS * sizeof(unsigned short));
+    ctx->soft.frame = MemPool_malloc(MANDELBROT_PIXELS * sizeof(unsigned short));
+    if (!ctx->soft.z || !ctx->soft.escape || !ctx->soft.frame) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    _Mandelbrot_softDefaultPalette(ctx);
+    //Set default co-ordinates and precision
+    _Mandelbrot_setDefaults(ctx);
     //And done
     DriverContextSetInit(ctx);
     return ERR_SUCCESS;
@@ -181,12 +644,39 @@ HpsErr_t Mandelbrot_setZnMax( MandelbrotCtx_t* ctx, double znMax ) {
 //Set Coordinates
 // - Sets coordinates and radius of pattern.
 // - Change this to change the zoom.
+// - With the software backend, a pan by whole pixels at the same radius
+//   keeps the pattern (see Panning), so it must not be reset.
 HpsErr_t Mandelbrot_setCoordinates( MandelbrotCtx_t* ctx, double radius, double xcentre, double ycentre ) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
     //Set coordinates
-    _Mandelbrot_setCoordinates(ctx, radius, xcentre, ycentre);
+    MandelbrotView_t view;
+    _Mandelbrot_prepareView(&view, radius, xcentre, ycentre);
+    _Mandelbrot_panView(ctx, &view);
+    return ERR_SUCCESS;
+}
+
+//Prepare a view
+// - Calculates the coefficients for a view ahead of time, e.g. for each
+//   step of a zoom animation, so that it can be loaded by Mandelbrot_setView()
+//   with only the register writes.
+// - Views can be loaded with either precision.
+HpsErr_t Mandelbrot_prepareView( double radius, double xcentre, double ycentre, MandelbrotView_t* view ) {
+    if (!view) return ERR_NULLPTR;
+    _Mandelbrot_prepareView(view, radius, xcentre, ycentre);
+    return ERR_SUCCESS;
+}
+
+//Set a prepared view
+// - As Mandelbrot_setCoordinates(), for a view from Mandelbrot_prepareView().
+HpsErr_t Mandelbrot_setView( MandelbrotCtx_t* ctx, const MandelbrotView_t* view ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!view) return ERR_NULLPTR;
+    //Load coefficients
+    _Mandelbrot_panView(ctx, view);
     return ERR_SUCCESS;
 }
 
@@ -198,6 +688,7 @@ HpsErr_t Mandelbrot_currentIteration( MandelbrotCtx_t* ctx ) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->base) return (ctx->soft.iteration & INT32_MAX);
     //Return current iteration
     unsigned int iteration = *((unsigned int*)&ctx->base[MANDELBROT_ITERATION]);
     return (iteration & INT32_MAX); //Ensure the iteration value doesn't accidentally become error status code.
@@ -211,6 +702,7 @@ HpsErr_t Mandelbrot_resetPattern( MandelbrotCtx_t* ctx ) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->base) return _Mandelbrot_softReset(ctx);
     //Check if generator is busy with existing iteration
     if (!(ctx->base[MANDELBROT_FLAGS] & MANDELBROT_ITERATE)) {
         //If busy, don't allow reset:
@@ -236,6 +728,7 @@ HpsErr_t Mandelbrot_startIteration( MandelbrotCtx_t* ctx ) {
     //Check if busy (will also validate context)
     HpsErr_t status = Mandelbrot_iterationDone(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->base) return _Mandelbrot_softIterate(ctx);
     //Perform iteration.
     ctx->base[MANDELBROT_FLAGS] = MANDELBROT_ITERATE;
     return ERR_SUCCESS;
@@ -248,6 +741,7 @@ HpsErr_t Mandelbrot_iterationDone( MandelbrotCtx_t* ctx ) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->base) return _Mandelbrot_softDone(ctx);
     //Check if generator is initialised
     unsigned char flags = ctx->base[MANDELBROT_FLAGS];
     if (!(flags & MANDELBROT_INIT)) return ERR_NOTREADY;
@@ -257,3 +751,343 @@ HpsErr_t Mandelbrot_iterationDone( MandelbrotCtx_t* ctx ) {
     return ERR_SUCCESS;
 }
 
+
+//Request a new view for the render scheduler
+// - The view is applied by Mandelbrot_render() as soon as the iteration
+//   in progress finishes, abandoning the rest of the current pattern
+//   (unless a software pattern is panned, see Panning).
+// - Only the latest request is kept, so views can be requested faster
+//   than the controller can draw them, e.g. every step of a zoom.
+HpsErr_t Mandelbrot_requestView( MandelbrotCtx_t* ctx, double radius, double xcentre, double ycentre ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Replaces any view not yet applied
+    _Mandelbrot_prepareView(&ctx->render.view, radius, xcentre, ycentre);
+    ctx->render.pending = true;
+    return ERR_SUCCESS;
+}
+
+//Request a prepared view for the render scheduler
+// - As Mandelbrot_requestView(), with a view from Mandelbrot_prepareView().
+HpsErr_t Mandelbrot_requestPreparedView( MandelbrotCtx_t* ctx, const MandelbrotView_t* view ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!view) return ERR_NULLPTR;
+    //Replaces any view not yet applied
+    ctx->render.view = *view;
+    ctx->render.pending = true;
+    return ERR_SUCCESS;
+}
+
+//Set the iteration limit for the render scheduler
+// - No more iterations are started once a pattern reaches maxIterations,
+//   until a new view is requested.
+// - 0 for no limit (default).
+HpsErr_t Mandelbrot_setMaxIterations( MandelbrotCtx_t* ctx, unsigned int maxIterations ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->render.maxIterations = maxIterations;
+    return ERR_SUCCESS;
+}
+
+//Set adaptive precision and iteration limit for the render scheduler
+// - When enabled, each view applied by the render scheduler picks single
+//   precision while its pixel step can be resolved in a float, and double
+//   precision at deeper zooms (see Adaptive Zoom).
+// - The iteration limit of each view is set to baseIterations, plus
+//   octaveIterations for each halving of the radius from the default view.
+//   This replaces any limit from Mandelbrot_setMaxIterations().
+// - Disabling keeps the current precision and limit.
+HpsErr_t Mandelbrot_setAdaptive( MandelbrotCtx_t* ctx, bool enable, unsigned int baseIterations, unsigned int octaveIterations ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->render.adaptive = enable;
+    ctx->render.baseIterations = baseIterations;
+    ctx->render.octaveIterations = octaveIterations;
+    //Re-apply the current view so the new settings take effect
+    if (enable && !ctx->render.pending) {
+        ctx->render.view = ctx->view;
+        ctx->render.pending = true;
+    }
+    return ERR_SUCCESS;
+}
+
+//Run the render scheduler
+// - Never waits for the controller. Call regularly from the main loop.
+// - Once the last iteration is done, applies any requested view and then
+//   starts the next iteration.
+// - Returns ERR_BUSY while the pattern is being rendered.
+// - Returns ERR_SUCCESS once the pattern has reached the iteration limit.
+HpsErr_t Mandelbrot_render( MandelbrotCtx_t* ctx ) {
+    //Check if the last iteration is done (will also validate context)
+    HpsErr_t status = Mandelbrot_iterationDone(ctx);
+    if (ERR_IS_BUSY(status)) return ERR_BUSY;
+    if (ERR_IS_NOTREADY(status)) {
+        //Generator never started, so start a pattern of the current view
+        if (!ctx->render.pending) {
+            ctx->render.view = ctx->view;
+            ctx->render.pending = true;
+        }
+    } else if (ERR_IS_ERROR(status)) {
+        return status;
+    }
+    //Coefficients can only be changed between iterations
+    bool restart = false;
+    if (ctx->render.pending) {
+        if (ctx->render.adaptive) {
+            _Mandelbrot_adaptView(ctx, &ctx->render.view);
+        }
+        //A panned software pattern carries on from where it was
+        restart = !_Mandelbrot_panView(ctx, &ctx->render.view);
+        if (restart) {
+            status = Mandelbrot_resetPattern(ctx);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        ctx->render.pending = false;
+    }
+    if (!restart && ctx->render.maxIterations) {
+        status = Mandelbrot_currentIteration(ctx);
+        if (ERR_IS_ERROR(status)) return status;
+        if ((unsigned int)status >= ctx->render.maxIterations) return ERR_SUCCESS;
+    }
+    //Refine the pattern
+    status = Mandelbrot_startIteration(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return ERR_BUSY;
+}
+
+//Set the colour palette
+// - Software backend only. The FPGA controller colours pixels itself
+//   (returns ERR_NOSUPPORT).
+// - Pixels which escape on iteration n are coloured palette[(n - 1 + offset) % length],
+//   and pixels which have not escaped are coloured inside.
+// - length must be a power of two up to MANDELBROT_PALETTE_MAX (returns ERR_OUTRANGE).
+// - The palette is copied. The frame is recoloured and copied to the display,
+//   without iterating the pattern again.
+// - Returns ERR_BUSY if an iteration is in progress.
+HpsErr_t Mandelbrot_setPalette( MandelbrotCtx_t* ctx, const unsigned short* palette, unsigned int length, unsigned short inside ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->base) return ERR_NOSUPPORT;
+    if (!palette) return ERR_NULLPTR;
+    if (!length || (length > MANDELBROT_PALETTE_MAX) || (length & (length - 1))) return ERR_OUTRANGE;
+    if (ctx->soft.cpu1Busy) return ERR_BUSY;
+    memcpy(ctx->soft.palette, palette, length * sizeof(unsigned short));
+    ctx->soft.paletteMask = length - 1;
+    ctx->soft.inside = inside;
+    return Mandelbrot_recolour(ctx);
+}
+
+//Set the palette offset
+// - Software backend only (returns ERR_NOSUPPORT otherwise).
+// - Rotates the palette by offset entries, then recolours as Mandelbrot_setPalette().
+//   Incrementing the offset each frame gives a palette cycling animation.
+// - Returns ERR_BUSY if an iteration is in progress.
+HpsErr_t Mandelbrot_setPaletteOffset( MandelbrotCtx_t* ctx, unsigned int offset ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->base) return ERR_NOSUPPORT;
+    if (ctx->soft.cpu1Busy) return ERR_BUSY;
+    ctx->soft.paletteOffset = offset;
+    return Mandelbrot_recolour(ctx);
+}
+
+//Recolour the pattern
+// - Software backend only (returns ERR_NOSUPPORT otherwise).
+// - Maps the stored escape iteration of every pixel through the palette,
+//   and copies the result to the display. The pattern is not iterated.
+// - Returns ERR_BUSY if an iteration is in progress.
+HpsErr_t Mandelbrot_recolour( MandelbrotCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->base) return ERR_NOSUPPORT;
+    if (ctx->soft.cpu1Busy) return ERR_BUSY;
+    //Nothing to show until a pattern is started
+    if (!ctx->soft.init) return ERR_SUCCESS;
+    _Mandelbrot_softRecolour(ctx);
+    ctx->soft.copyPending = true;
+    return _Mandelbrot_softDone(ctx);
+}
+
+//Render scheduler event handler
+// - Runs Mandelbrot_render(). Register as a repeating event with Event_create,
+//   with the Mandelbrot context as param.
+// - Always returns ERR_AGAIN to keep the event running.
+HpsErr_t Mandelbrot_renderEventHandler( Event_t* event, void* param ) {
+    (void)event;
+    Mandelbrot_render((MandelbrotCtx_t*)param);
+    return ERR_AGAIN;
+}
+
+//Initialise a pool of Mandelbrot controllers
+// - bases is an array of count controller base addresses, in the order of
+//   the display strips they draw from the top.
+// - count must divide LT24_HEIGHT, up to MANDELBROT_POOL_MAX (returns ERR_OUTRANGE).
+// - Requires that the LT24 controller has already been initialised.
+// - Returns 0 if successful
+HpsErr_t MandelbrotPool_initialise( void* const bases[], unsigned int count, LT24Ctx_t* lt24ctx, MandelbrotPoolCtx_t** pCtx ) {
+    //Ensure user pointers valid.
+    if (!bases) return ERR_NULLPTR;
+    if (!count || (count > MANDELBROT_POOL_MAX) || (LT24_HEIGHT % count)) return ERR_OUTRANGE;
+    //Check if the LT24 display has been initialised (required)
+    if (!LT24_isInitialised(lt24ctx)) return ERR_NOINIT;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_MandelbrotPool_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    MandelbrotPoolCtx_t* ctx = *pCtx;
+    //Initialise each engine
+    for (unsigned int idx = 0; idx < count; idx++) {
+        status = Mandelbrot_initialise(bases[idx], lt24ctx, &ctx->engines[idx]);
+        if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+        ctx->count = idx + 1;
+    }
+    //Split the default view across the engines
+    ctx->view = ctx->engines[0]->view;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        MandelbrotView_t tile;
+        _MandelbrotPool_tileView(&ctx->view, idx, count, &tile);
+        _Mandelbrot_setView(ctx->engines[idx], &tile);
+    }
+    //And done
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if pool initialised
+// - returns true if initialised
+bool MandelbrotPool_isInitialised( MandelbrotPoolCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Get an engine of the pool
+// - Returns the context of engine index to *engine, e.g. for its iteration count.
+// - Returns ERR_OUTRANGE if there is no such engine.
+HpsErr_t MandelbrotPool_getEngine( MandelbrotPoolCtx_t* ctx, unsigned int index, MandelbrotCtx_t** engine ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!engine) return ERR_NULLPTR;
+    if (index >= ctx->count) return ERR_OUTRANGE;
+    *engine = ctx->engines[index];
+    return ERR_SUCCESS;
+}
+
+//Set Precision of all engines
+// - As Mandelbrot_setCalculationPrecision().
+// - Returns ERR_BUSY if any engine is mid iteration.
+HpsErr_t MandelbrotPool_setCalculationPrecision( MandelbrotPoolCtx_t* ctx, MandelbrotPrecision precision ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //All engines must change together
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        if (ERR_IS_BUSY(Mandelbrot_iterationDone(ctx->engines[idx]))) return ERR_BUSY;
+    }
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        status = Mandelbrot_setCalculationPrecision(ctx->engines[idx], precision);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Request a new view for the pool
+// - As Mandelbrot_requestView(), for the whole display. Each engine is
+//   given the part of the view covering its strip.
+HpsErr_t MandelbrotPool_requestView( MandelbrotPoolCtx_t* ctx, double radius, double xcentre, double ycentre ) {
+    MandelbrotView_t view;
+    _Mandelbrot_prepareView(&view, radius, xcentre, ycentre);
+    return MandelbrotPool_requestPreparedView(ctx, &view);
+}
+
+//Request a prepared view for the pool
+// - As MandelbrotPool_requestView(), with a view from Mandelbrot_prepareView().
+HpsErr_t MandelbrotPool_requestPreparedView( MandelbrotPoolCtx_t* ctx, const MandelbrotView_t* view ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!view) return ERR_NULLPTR;
+    //Each engine applies its part at its next iteration boundary
+    ctx->view = *view;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        _MandelbrotPool_tileView(view, idx, ctx->count, &ctx->engines[idx]->render.view);
+        ctx->engines[idx]->render.pending = true;
+    }
+    return ERR_SUCCESS;
+}
+
+//Set the iteration limit for all engines
+// - As Mandelbrot_setMaxIterations().
+HpsErr_t MandelbrotPool_setMaxIterations( MandelbrotPoolCtx_t* ctx, unsigned int maxIterations ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        ctx->engines[idx]->render.maxIterations = maxIterations;
+    }
+    return ERR_SUCCESS;
+}
+
+//Set adaptive precision and iteration limit for all engines
+// - As Mandelbrot_setAdaptive(). Each engine picks the precision needed by
+//   its own strip of the view.
+HpsErr_t MandelbrotPool_setAdaptive( MandelbrotPoolCtx_t* ctx, bool enable, unsigned int baseIterations, unsigned int octaveIterations ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        status = Mandelbrot_setAdaptive(ctx->engines[idx], enable, baseIterations, octaveIterations);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Run the render scheduler on all engines
+// - As Mandelbrot_render(). Each engine which has finished its iteration
+//   is restarted straight away, independently of the others.
+// - Returns ERR_BUSY while any engine is rendering.
+// - Returns ERR_SUCCESS once every engine has reached the iteration limit.
+HpsErr_t MandelbrotPool_render( MandelbrotPoolCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Restart every engine which has finished, without waiting for the rest
+    HpsErr_t result = ERR_SUCCESS;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        status = Mandelbrot_render(ctx->engines[idx]);
+        if (ERR_IS_BUSY(status)) {
+            if (result == ERR_SUCCESS) result = ERR_BUSY;
+        } else if (ERR_IS_ERROR(status)) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+//Signal that an engine has finished an iteration
+// - For use from an interrupt handler for the engine's done output.
+// - Runs the render scheduler for that engine only.
+// - Returns ERR_OUTRANGE if there is no such engine, otherwise as Mandelbrot_render().
+HpsErr_t MandelbrotPool_engineDone( MandelbrotPoolCtx_t* ctx, unsigned int index ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (index >= ctx->count) return ERR_OUTRANGE;
+    return Mandelbrot_render(ctx->engines[index]);
+}
+
+//Pool render scheduler event handler
+// - Runs MandelbrotPool_render(). Register as a repeating event with Event_create,
+//   with the pool context as param.
+// - Always returns ERR_AGAIN to keep the event running.
+HpsErr_t MandelbrotPool_renderEventHandler( Event_t* event, void* param ) {
+    (void)event;
+    MandelbrotPool_render((MandelbrotPoolCtx_t*)param);
+    return ERR_AGAIN;
+}
@@ -4,6 +4,110 @@
  * Description: 
  * Driver for the Leeds SoC Computer Mandelbrot Controller
  *
+ * Software Backend
+ * ----------------
+ *
+ * If the Mandelbrot IP is not in the FPGA design, the same APIs can
+ * be used with a context from Mandelbrot_initialiseSoftware(), which
+ * iterates the pattern on the CPU. Single precision uses NEON to work
+ * on four pixels at a time, and double precision uses the VFP. Each
+ * iteration updates a frame of colours which is copied to the display
+ * once the iteration is done. This also gives a baseline to benchmark
+ * the FPGA against.
+ *
+ * The software backend records the iteration on which each pixel
+ * escaped, and colours it through a palette of up to 256 RGB565
+ * entries. Mandelbrot_setPalette() and Mandelbrot_setPaletteOffset()
+ * re-run only the palette lookup and copy to the display, so palette
+ * cycling runs at display speed whatever the iteration count.
+ *
+ * If an SMP context (Util/smp.h) is given, the bottom half of each
+ * iteration is posted to CPU1, which must be running a loop calling
+ * SMP_wait(). Mandelbrot_startIteration() returns once CPU0 has done
+ * the top half, and Mandelbrot_iterationDone() returns ERR_BUSY until
+ * CPU1 has finished.
+ *
+ * Panning
+ * -------
+ *
+ * With the software backend, a new view at the same radius which moves
+ * the centre by a whole number of pixels keeps the pattern. The escape
+ * codes, colours and z values still in view are shifted by the pan,
+ * and only the newly exposed strips are iterated, straight up to the
+ * current iteration, so that panning does not restart the pattern.
+ * This applies to Mandelbrot_setCoordinates(), Mandelbrot_setView()
+ * and the render scheduler. Pans are easiest to keep to whole pixels
+ * by moving the centre in multiples of the view's xstep and ystep.
+ *
+ * The FPGA controller writes each result straight to the display and
+ * has no pattern which can be read back, so it always starts again.
+ *
+ * Render Scheduler
+ * ----------------
+ *
+ * The controller iterates every pixel of the LT24 frame at once, and
+ * writes each result straight to the display, refining the pattern a
+ * little more with every iteration. Waiting for a pattern to finish
+ * before showing the next view makes interactive zooming sluggish.
+ *
+ * Instead, new views can be given to Mandelbrot_requestView(). Calling
+ * Mandelbrot_render() from the main loop (or as an event handler) then
+ * starts each iteration as soon as the previous one finishes, and
+ * moves to the latest requested view at the next iteration boundary,
+ * so the new view starts coarse and is refined while the main loop
+ * carries on with other work:
+ *
+ *    Mandelbrot_setMaxIterations(mandelbrot, 200);
+ *    while (1) {
+ *        if (zoomIn) Mandelbrot_requestView(mandelbrot, radius *= 0.9, x, y);
+ *        Mandelbrot_render(mandelbrot);
+ *    }
+ *
+ * Adaptive Zoom
+ * -------------
+ *
+ * Single precision is faster, but once the pixel step is too small to
+ * be resolved in a float at the view's coordinates, neighbouring pixels
+ * run together and the pattern becomes blocky. Deeper zooms also need
+ * more iterations before the detail at the edge of the set appears.
+ *
+ * Mandelbrot_setAdaptive() makes the render scheduler pick the precision
+ * and iteration limit of each view as it is applied. Single precision is
+ * used while the pixel step is at least MANDELBROT_ADAPTIVE_FLOAT_MARGIN
+ * float steps at the largest coordinate of the view, and double below
+ * that. The limit grows by a fixed number of iterations for each halving
+ * of the radius from the default view:
+ *
+ *    Mandelbrot_setAdaptive(mandelbrot, true, 64, 32); // 64 + 32 per zoom octave
+ *    while (1) {
+ *        if (zoomIn) Mandelbrot_requestView(mandelbrot, radius *= 0.9, x, y);
+ *        Mandelbrot_render(mandelbrot);
+ *    }
+ *
+ * A change of precision restarts the pattern.
+ *
+ * Engine Pools
+ * ------------
+ *
+ * An FPGA design may instantiate several controllers, each drawing an
+ * equal strip of the display along the real axis (the 320 pixel LT24
+ * height), so that each engine iterates fewer pixels. A pool context
+ * from MandelbrotPool_initialise() takes the base of each engine in
+ * strip order, and programs each with the part of the requested view
+ * covering its strip. The engine count must divide LT24_HEIGHT.
+ *
+ * MandelbrotPool_render() runs the render scheduler on every engine,
+ * restarting each one as soon as it finishes rather than waiting for
+ * the slowest, so the throughput scales with the number of engines.
+ * If the design routes each engine's done output to a PIO interrupt,
+ * call MandelbrotPool_engineDone() from the handler for that engine
+ * instead of polling.
+ *
+ *    void* bases[] = { ENGINE0_BASE, ENGINE1_BASE, ENGINE2_BASE, ENGINE3_BASE };
+ *    MandelbrotPool_initialise(bases, 4, lt24, &pool);
+ *    MandelbrotPool_requestView(pool, radius, x, y);
+ *    while (1) MandelbrotPool_render(pool);
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -11,6 +115,13 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add adaptive precision and iteration limit
+ * 14/10/2026 | Keep the software pattern when panning
+ * 14/10/2026 | Add engine pools for multiple controllers
+ * 14/10/2026 | Add prepared views for faster coefficient updates
+ * 14/10/2026 | Add palette lookup and recolouring to software backend
+ * 14/10/2026 | Add software backend using NEON/VFP and CPU1
+ * 14/10/2026 | Add non-blocking render scheduler
  * 05/03/2018 | Creation of driver
  * 
  */
@@ -22,6 +133,11 @@
 #include <stdint.h>
 #include "Util/driver_ctx.h"
 #include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "Util/event.h"
+#include "Util/smp.h"
+
+//Maximum software backend palette length
+#define MANDELBROT_PALETTE_MAX 256
 
 //Precision
 typedef enum {
@@ -29,6 +145,22 @@ typedef enum {
     MANDELBROT_DOUBLE_PRECISION
 } MandelbrotPrecision;
 
+// Prepared view
+// - Coefficient register values for a view, in both precisions.
+typedef struct {
+    double radius;
+    double xcentre;
+    double ycentre;
+    double xmin;
+    double ymin;
+    double xstep;
+    double ystep;
+    float xminf;
+    float yminf;
+    float xstepf;
+    float ystepf;
+} MandelbrotView_t;
+
 // Driver context
 typedef struct {
     // Context Header
@@ -41,13 +173,68 @@ typedef struct {
     double radius;
     double xcentre;
     double ycentre;
+    MandelbrotView_t view;
+    // Display, updated by the software backend
+    LT24Ctx_t* lt24;
+    // Software backend state (used if base is NULL)
+    struct {
+        SmpCtx_t* smp;              // Runs half of each iteration on CPU1 if not NULL
+        void* z;                    // Real then imaginary planes of z for each pixel
+        unsigned short* escape;     // Escape code of each pixel, 0 if not escaped
+        unsigned short* frame;      // Pattern colours, copied to the display after each iteration
+        unsigned short palette[MANDELBROT_PALETTE_MAX];
+        unsigned int paletteMask;   // Palette length - 1
+        unsigned int paletteOffset;
+        unsigned short inside;      // Colour of pixels which have not escaped
+        bool init;                  // Pattern has been started
+        bool copyPending;           // Frame needs copying to the display
+        volatile bool cpu1Busy;     // CPU1 is working on its half of the iteration
+        unsigned int iteration;
+        double znMax2;
+    } soft;
+    // Render scheduler state
+    struct {
+        bool pending;           // A view is waiting to be applied
+        MandelbrotView_t view;
+        unsigned int maxIterations;
+        bool adaptive;          // Precision and limit follow the zoom
+        unsigned int baseIterations;
+        unsigned int octaveIterations;
+    } render;
 } MandelbrotCtx_t;
 
+//Smallest pixel step, in float steps at the view's coordinates, for
+//adaptive mode to use single precision
+#ifndef MANDELBROT_ADAPTIVE_FLOAT_MARGIN
+#define MANDELBROT_ADAPTIVE_FLOAT_MARGIN 16.0
+#endif
+
+//Maximum number of engines in a pool
+#define MANDELBROT_POOL_MAX 16
+
+// Engine pool context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    MandelbrotCtx_t* engines[MANDELBROT_POOL_MAX];
+    unsigned int count;
+    MandelbrotView_t view;          // Whole display view last requested
+} MandelbrotPoolCtx_t;
+
 //Function to initialise the Mandelbrot driver
 // - Requires that the LT24 controller has already been initialised.
 // - Returns 0 if successful
 HpsErr_t Mandelbrot_initialise( void* base, LT24Ctx_t* lt24ctx, MandelbrotCtx_t** pCtx );
 
+//Function to initialise the Mandelbrot software backend
+// - Requires that the LT24 controller has already been initialised.
+// - smp is an SMP context with CPU1 running, to share each iteration with
+//   CPU1, or NULL to run only on the calling core.
+// - Allocates about 1.3MB for the pattern state.
+// - Returns 0 if successful
+HpsErr_t Mandelbrot_initialiseSoftware( LT24Ctx_t* lt24ctx, SmpCtx_t* smp, MandelbrotCtx_t** pCtx );
+
 //Check if driver initialised
 // - returns true if initialised
 bool Mandelbrot_isInitialised( MandelbrotCtx_t* ctx );
@@ -71,8 +258,21 @@ HpsErr_t Mandelbrot_setZnMax( MandelbrotCtx_t* ctx, double znMax );
 //Set Coordinates
 // - Sets coordinates and radius of pattern.
 // - Change this to change the zoom.
+// - With the software backend, a pan by whole pixels at the same radius
+//   keeps the pattern (see Panning), so it must not be reset.
 HpsErr_t Mandelbrot_setCoordinates( MandelbrotCtx_t* ctx, double radius, double xcentre, double ycentre );
 
+//Prepare a view
+// - Calculates the coefficients for a view ahead of time, e.g. for each
+//   step of a zoom animation, so that it can be loaded by Mandelbrot_setView()
+//   with only the register writes.
+// - Views can be loaded with either precision.
+HpsErr_t Mandelbrot_prepareView( double radius, double xcentre, double ycentre, MandelbrotView_t* view );
+
+//Set a prepared view
+// - As Mandelbrot_setCoordinates(), for a view from Mandelbrot_prepareView().
+HpsErr_t Mandelbrot_setView( MandelbrotCtx_t* ctx, const MandelbrotView_t* view );
+
 //Current iteration
 // - Returns how many iterations have been made on the current pattern.
 // - If >=0 is current iteration of this pattern
@@ -95,4 +295,130 @@ HpsErr_t Mandelbrot_startIteration( MandelbrotCtx_t* ctx );
 // - Return ERR_BUSY if still running.
 HpsErr_t Mandelbrot_iterationDone( MandelbrotCtx_t* ctx );
 
+//Request a new view for the render scheduler
+// - The view is applied by Mandelbrot_render() as soon as the iteration
+//   in progress finishes, abandoning the rest of the current pattern
+//   (unless a software pattern is panned, see Panning).
+// - Only the latest request is kept, so views can be requested faster
+//   than the controller can draw them, e.g. every step of a zoom.
+HpsErr_t Mandelbrot_requestView( MandelbrotCtx_t* ctx, double radius, double xcentre, double ycentre );
+
+//Request a prepared view for the render scheduler
+// - As Mandelbrot_requestView(), with a view from Mandelbrot_prepareView().
+HpsErr_t Mandelbrot_requestPreparedView( MandelbrotCtx_t* ctx, const MandelbrotView_t* view );
+
+//Set the iteration limit for the render scheduler
+// - No more iterations are started once a pattern reaches maxIterations,
+//   until a new view is requested.
+// - 0 for no limit (default).
+HpsErr_t Mandelbrot_setMaxIterations( MandelbrotCtx_t* ctx, unsigned int maxIterations );
+
+//Set adaptive precision and iteration limit for the render scheduler
+// - When enabled, each view applied by the render scheduler picks single
+//   precision while its pixel step can be resolved in a float, and double
+//   precision at deeper zooms (see Adaptive Zoom).
+// - The iteration limit of each view is set to baseIterations, plus
+//   octaveIterations for each halving of the radius from the default view.
+//   This replaces any limit from Mandelbrot_setMaxIterations().
+// - Disabling keeps the current precision and limit.
+HpsErr_t Mandelbrot_setAdaptive( MandelbrotCtx_t* ctx, bool enable, unsigned int baseIterations, unsigned int octaveIterations );
+
+//Run the render scheduler
+// - Never waits for the controller. Call regularly from the main loop.
+// - Once the last iteration is done, applies any requested view and then
+//   starts the next iteration.
+// - Returns ERR_BUSY while the pattern is being rendered.
+// - Returns ERR_SUCCESS once the pattern has reached the iteration limit.
+HpsErr_t Mandelbrot_render( MandelbrotCtx_t* ctx );
+
+//Set the colour palette
+// - Software backend only. The FPGA controller colours pixels itself
+//   (returns ERR_NOSUPPORT).
+// - Pixels which escape on iteration n are coloured palette[(n - 1 + offset) % length],
+//   and pixels which have not escaped are coloured inside.
+// - length must be a power of two up to MANDELBROT_PALETTE_MAX (returns ERR_OUTRANGE).
+// - The palette is copied. The frame is recoloured and copied to the display,
+//   without iterating the pattern again.
+// - Returns ERR_BUSY if an iteration is in progress.
+HpsErr_t Mandelbrot_setPalette( MandelbrotCtx_t* ctx, const unsigned short* palette, unsigned int length, unsigned short inside );
+
+//Set the palette offset
+// - Software backend only (returns ERR_NOSUPPORT otherwise).
+// - Rotates the palette by offset entries, then recolours as Mandelbrot_setPalette().
+//   Incrementing the offset each frame gives a palette cycling animation.
+// - Returns ERR_BUSY if an iteration is in progress.
+HpsErr_t Mandelbrot_setPaletteOffset( MandelbrotCtx_t* ctx, unsigned int offset );
+
+//Recolour the pattern
+// - Software backend only (returns ERR_NOSUPPORT otherwise).
+// - Maps the stored escape iteration of every pixel through the palette,
+//   and copies the result to the display. The pattern is not iterated.
+// - Returns ERR_BUSY if an iteration is in progress.
+HpsErr_t Mandelbrot_recolour( MandelbrotCtx_t* ctx );
+
+//Render scheduler event handler
+// - Runs Mandelbrot_render(). Register as a repeating event with Event_create,
+//   with the Mandelbrot context as param.
+// - Always returns ERR_AGAIN to keep the event running.
+HpsErr_t Mandelbrot_renderEventHandler( Event_t* event, void* param );
+
+//Initialise a pool of Mandelbrot controllers
+// - bases is an array of count controller base addresses, in the order of
+//   the display strips they draw from the top.
+// - count must divide LT24_HEIGHT, up to MANDELBROT_POOL_MAX (returns ERR_OUTRANGE).
+// - Requires that the LT24 controller has already been initialised.
+// - Returns 0 if successful
+HpsErr_t MandelbrotPool_initialise( void* const bases[], unsigned int count, LT24Ctx_t* lt24ctx, MandelbrotPoolCtx_t** pCtx );
+
+//Check if pool initialised
+// - returns true if initialised
+bool MandelbrotPool_isInitialised( MandelbrotPoolCtx_t* ctx );
+
+//Get an engine of the pool
+// - Returns the context of engine index to *engine, e.g. for its iteration count.
+// - Returns ERR_OUTRANGE if there is no such engine.
+HpsErr_t MandelbrotPool_getEngine( MandelbrotPoolCtx_t* ctx, unsigned int index, MandelbrotCtx_t** engine );
+
+//Set Precision of all engines
+// - As Mandelbrot_setCalculationPrecision().
+// - Returns ERR_BUSY if any engine is mid iteration.
+HpsErr_t MandelbrotPool_setCalculationPrecision( MandelbrotPoolCtx_t* ctx, MandelbrotPrecision precision );
+
+//Request a new view for the pool
+// - As Mandelbrot_requestView(), for the whole display. Each engine is
+//   given the part of the view covering its strip.
+HpsErr_t MandelbrotPool_requestView( MandelbrotPoolCtx_t* ctx, double radius, double xcentre, double ycentre );
+
+//Request a prepared view for the pool
+// - As MandelbrotPool_requestView(), with a view from Mandelbrot_prepareView().
+HpsErr_t MandelbrotPool_requestPreparedView( MandelbrotPoolCtx_t* ctx, const MandelbrotView_t* view );
+
+//Set the iteration limit for all engines
+// - As Mandelbrot_setMaxIterations().
+HpsErr_t MandelbrotPool_setMaxIterations( MandelbrotPoolCtx_t* ctx, unsigned int maxIterations );
+
+//Set adaptive precision and iteration limit for all engines
+// - As Mandelbrot_setAdaptive(). Each engine picks the precision needed by
+//   its own strip of the view.
+HpsErr_t MandelbrotPool_setAdaptive( MandelbrotPoolCtx_t* ctx, bool enable, unsigned int baseIterations, unsigned int octaveIterations );
+
+//Run the render scheduler on all engines
+// - As Mandelbrot_render(). Each engine which has finished its iteration
+//   is restarted straight away, independently of the others.
+// - Returns ERR_BUSY while any engine is rendering.
+// - Returns ERR_SUCCESS once every engine has reached the iteration limit.
+HpsErr_t MandelbrotPool_render( MandelbrotPoolCtx_t* ctx );
+
+//Signal that an engine has finished an iteration
+// - For use from an interrupt handler for the engine's done output.
+// - Runs the render scheduler for that engine only.
+// - Returns ERR_OUTRANGE if there is no such engine, otherwise as Mandelbrot_render().
+HpsErr_t MandelbrotPool_engineDone( MandelbrotPoolCtx_t* ctx, unsigned int index );
+
+//Pool render scheduler event handler
+// - Runs MandelbrotPool_render(). Register as a repeating event with Event_create,
+//   with the pool context as param.
+// - Always returns ERR_AGAIN to keep the event running.
+HpsErr_t MandelbrotPool_renderEventHandler( Event_t* event, void* param );
+
 #endif /* DE1SOC_MANDELBROT_H_ */
@@ -12,6 +12,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add synchronised servo groups
  * 20/11/2024 | Separate Servo Channel Instances
  * 31/01/2024 | Update to new driver contexts
  * 05/12/2018 | Add Servo_readInput Function to get value
@@ -22,6 +23,7 @@
 
 #include "DE1SoC_Servo.h"
 #include "Util/bit_helpers.h"
+#include "HPS_IRQ/HPS_IRQ.h"
 
 //
 // Register Maps
@@ -57,6 +59,15 @@ static void _Servo_cleanup( ServoCtx_t* ctx ) {
     }
 }
 
+// Check if any servo in a group is busy
+// - Reads the ready flags directly, as the group has already checked the servos.
+static bool _ServoGroup_busy( ServoGroupCtx_t* ctx ) {
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        if (!MaskCheck(ctx->servos[idx]->base[SERVO_CONTROL], SERVO_FLAGMASK, SERVO_READY)) return true;
+    }
+    return false;
+}
+
 /*
  * User Facing APIs
  */
@@ -206,3 +217,118 @@ HpsErr_t Servo_pulseWidth( ServoCtx_t* ctx, signed char width) {
     return ERR_SUCCESS;
 }
 
+
+//Initialise a Servo Group
+// - "servos" is an array of "count" initialised servo contexts,
+//   from 1 to SERVO_MAX_COUNT. Index i in the group is servos[i].
+// - The servo contexts must not be freed before the group.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t ServoGroup_initialise( ServoCtx_t* const servos[], unsigned int count, ServoGroupCtx_t** pCtx ) {
+    //Ensure user pointers valid
+    if (!servos) return ERR_NULLPTR;
+    if (!count) return ERR_TOOSMALL;
+    if (count > SERVO_MAX_COUNT) return ERR_TOOBIG;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        if (!Servo_isInitialised(servos[idx])) return ERR_BADDEVICE;
+    }
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save the servos
+    ServoGroupCtx_t* ctx = *pCtx;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        ctx->servos[idx] = servos[idx];
+    }
+    ctx->count = count;
+    ctx->stagedMask = 0;
+    //Mark as initialised so later functions know we are ready
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if group initialised
+bool ServoGroup_isInitialised( ServoGroupCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Enable/Disable all servos in the group
+// - "enable" is true to enable, false to disable.
+// - The channels are switched back to back, so that they start together.
+HpsErr_t ServoGroup_enable( ServoGroupCtx_t* ctx, bool enable ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Work out the new control values first, so only the stores are in the burst
+    unsigned char control[SERVO_MAX_COUNT];
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        control[idx] = MaskModify(ctx->servos[idx]->base[SERVO_CONTROL], enable, SERVO_FLAGMASK, SERVO_ENABLE);
+    }
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        ctx->servos[idx]->base[SERVO_CONTROL] = control[idx];
+    }
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Stage a pulse width for one servo in the group
+// - "index" is the position of the servo in the group.
+// - "width" is as for Servo_pulseWidth().
+// - Nothing is written until ServoGroup_commit().
+HpsErr_t ServoGroup_stage( ServoGroupCtx_t* ctx, unsigned int index, signed char width ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (index >= ctx->count) return ERR_BADID;
+    ctx->staged[index] = width;
+    ctx->stagedMask |= _BV(index);
+    return ERR_SUCCESS;
+}
+
+//Stage pulse widths for all servos in the group
+// - "widths" is an array with one width for each servo in the group.
+// - Nothing is written until ServoGroup_commit().
+HpsErr_t ServoGroup_stageAll( ServoGroupCtx_t* ctx, const signed char widths[] ) {
+    if (!widths) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        ctx->staged[idx] = widths[idx];
+    }
+    ctx->stagedMask = _BV(ctx->count) - 1;
+    return ERR_SUCCESS;
+}
+
+//Check if any servo in the group is busy
+// - Will return ERR_BUSY if any servo is not ready for an update
+// - Will return ERR_SUCCESS once all are ready.
+HpsErr_t ServoGroup_busy( ServoGroupCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return _ServoGroup_busy(ctx) ? ERR_BUSY : ERR_SUCCESS;
+}
+
+//Commit the staged pulse widths
+// - Writes every staged width in one burst, then clears the staged set.
+// - Will return ERR_BUSY without writing anything if any servo is busy.
+// - Will return ERR_SKIPPED if nothing is staged.
+// - Will return ERR_SUCCESS if updated successfully.
+HpsErr_t ServoGroup_commit( ServoGroupCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int staged = ctx->stagedMask;
+    if (!staged) return ERR_SKIPPED;
+    //All or nothing, so that no axis is a period behind the others
+    if (_ServoGroup_busy(ctx)) return ERR_BUSY;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        if (staged & _BV(idx)) ctx->servos[idx]->base[SERVO_POSITN] = ctx->staged[idx];
+    }
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    ctx->stagedMask = 0;
+    return ERR_SUCCESS;
+}
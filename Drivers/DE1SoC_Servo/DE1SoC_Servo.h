@@ -5,6 +5,31 @@
  * Driver for the Servo Controller in the DE1-SoC
  * Computer
  *
+ * Servo Groups
+ * ------------
+ *
+ * For multi-axis rigs, several channels can be combined into a group
+ * which is updated as one. Pulse widths are staged for any of the
+ * channels, then committed together once every channel in the group
+ * is ready for an update:
+ *
+ *    ServoCtx_t* axes[] = {pan, tilt};
+ *    ServoGroup_initialise(axes, 2, &rig);
+ *    ServoGroup_enable(rig, true);
+ *    ...
+ *    ServoGroup_stageAll(rig, (signed char[]){ 20, -15 });
+ *    while (ServoGroup_commit(rig) == ERR_BUSY);
+ *
+ * The commit only writes if no channel is busy, so each channel takes
+ * its new width at its next PWM period boundary rather than one axis
+ * updating a whole period before another. The register writes are
+ * made back to back with interrupts disabled, and the channels are not
+ * re-validated for each write, so a commit costs little more than the
+ * stores themselves.
+ *
+ * The group keeps pointers to the channel contexts, so it must be
+ * freed before any of them.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -12,6 +37,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add synchronised servo groups
  * 20/11/2024 | Separate Servo Channel Instances
  * 31/01/2024 | Update to new driver contexts
  * 05/12/2018 | Add Servo_readInput Function to get value
@@ -47,6 +73,17 @@ typedef struct {
     GpioCtx_t gpio;
 } ServoCtx_t;
 
+// Servo Group Context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    ServoCtx_t* servos[SERVO_MAX_COUNT];
+    unsigned int count;
+    signed char staged[SERVO_MAX_COUNT];
+    unsigned int stagedMask;        // Bit mask of channels with a staged width
+} ServoGroupCtx_t;
+
 //Function to initialise the Servo Controller
 // - "channel" is the servo channel to initialise the context for.
 //  - Returns Util/error Code
@@ -116,4 +153,44 @@ HpsErr_t Servo_calibrate( ServoCtx_t* ctx, signed char calibration );
 // - Will return ERR_SUCCESS if updated successfully.
 HpsErr_t Servo_pulseWidth( ServoCtx_t* ctx, signed char width );
 
+//Initialise a Servo Group
+// - "servos" is an array of "count" initialised servo contexts,
+//   from 1 to SERVO_MAX_COUNT. Index i in the group is servos[i].
+// - The servo contexts must not be freed before the group.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t ServoGroup_initialise( ServoCtx_t* const servos[], unsigned int count, ServoGroupCtx_t** pCtx );
+
+//Check if group initialised
+// - returns true if initialised
+bool ServoGroup_isInitialised( ServoGroupCtx_t* ctx );
+
+//Enable/Disable all servos in the group
+// - "enable" is true to enable, false to disable.
+// - The channels are switched back to back, so that they start together.
+HpsErr_t ServoGroup_enable( ServoGroupCtx_t* ctx, bool enable );
+
+//Stage a pulse width for one servo in the group
+// - "index" is the position of the servo in the group.
+// - "width" is as for Servo_pulseWidth().
+// - Nothing is written until ServoGroup_commit().
+HpsErr_t ServoGroup_stage( ServoGroupCtx_t* ctx, unsigned int index, signed char width );
+
+//Stage pulse widths for all servos in the group
+// - "widths" is an array with one width for each servo in the group.
+// - Nothing is written until ServoGroup_commit().
+HpsErr_t ServoGroup_stageAll( ServoGroupCtx_t* ctx, const signed char widths[] );
+
+//Check if any servo in the group is busy
+// - Will return ERR_BUSY if any servo is not ready for an update
+// - Will return ERR_SUCCESS once all are ready.
+HpsErr_t ServoGroup_busy( ServoGroupCtx_t* ctx );
+
+//Commit the staged pulse widths
+// - Writes every staged width in one burst, then clears the staged set.
+// - Will return ERR_BUSY without writing anything if any servo is busy.
+// - Will return ERR_SKIPPED if nothing is staged.
+// - Will return ERR_SUCCESS if updated successfully.
+HpsErr_t ServoGroup_commit( ServoGroupCtx_t* ctx );
+
 #endif /*DE1SoC_Servo_H_*/
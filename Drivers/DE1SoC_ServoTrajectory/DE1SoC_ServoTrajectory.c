@@ -0,0 +1,247 @@
+/*
+ * Servo Trajectory Playback
+ * -------------------------
+ * Description:
+ * Plays back a precomputed table of servo positions on a servo
+ * group, driven by a repeating event from an event manager.
+ *
+ * Positions are tracked in Q16 fixed point. At each keyframe the
+ * per-update step towards the next keyframe is found with a single
+ * division per channel, so each update is only an add and a round.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_ServoTrajectory.h"
+
+/*
+ * Internal Functions
+ */
+
+static void _ServoTraj_cleanup(ServoTrajCtx_t* ctx) {
+    //Stop updating
+    if (ctx->event) {
+        Event_destroy(ctx->event);
+        ctx->event = NULL;
+    }
+    ctx->playing = false;
+}
+
+// Move to a keyframe
+//  - Sets the current widths to the keyframe, and the step towards the next.
+static void _ServoTraj_loadFrame(ServoTrajCtx_t* ctx, unsigned int frame) {
+    const ServoTrajectory_t* traj = ctx->traj;
+    unsigned int count = ctx->group->count;
+    unsigned int next = frame + 1;
+    if (next >= traj->frames) {
+        //Either wrap round, or hold once at the end
+        next = traj->loop ? 0 : frame;
+    }
+    const signed char* cur = &traj->table[frame * count];
+    const signed char* tgt = &traj->table[next * count];
+    for (unsigned int ch = 0; ch < count; ch++) {
+        ctx->pos[ch] = (signed int)cur[ch] * 65536;
+        ctx->delta[ch] = (((signed int)tgt[ch] - cur[ch]) * 65536) / (signed int)traj->stepPeriods;
+    }
+    ctx->frame = frame;
+    ctx->step = 0;
+}
+
+// Check if the final keyframe has been reached
+static bool _ServoTraj_atEnd(ServoTrajCtx_t* ctx) {
+    return !ctx->traj->loop && (ctx->step == 0) && (ctx->frame + 1 >= ctx->traj->frames);
+}
+
+// Move on by one update
+static void _ServoTraj_advance(ServoTrajCtx_t* ctx) {
+    ctx->step++;
+    if (ctx->step >= ctx->traj->stepPeriods) {
+        //Reached the next keyframe. Load it exactly to avoid rounding drift.
+        unsigned int next = ctx->frame + 1;
+        _ServoTraj_loadFrame(ctx, (next >= ctx->traj->frames) ? 0 : next);
+    } else {
+        for (unsigned int ch = 0; ch < ctx->group->count; ch++) {
+            ctx->pos[ch] += ctx->delta[ch];
+        }
+    }
+}
+
+// Stage the current widths on the group
+static HpsErr_t _ServoTraj_stage(ServoTrajCtx_t* ctx) {
+    signed char widths[SERVO_MAX_COUNT];
+    for (unsigned int ch = 0; ch < ctx->group->count; ch++) {
+        //Round to nearest
+        widths[ch] = (signed char)((ctx->pos[ch] + 32768) >> 16);
+    }
+    HpsErr_t status = ServoGroup_stageAll(ctx->group, widths);
+    if (ERR_IS_SUCCESS(status)) ctx->pending = true;
+    return status;
+}
+
+// Commit any staged widths to the group
+//  - Returns ERR_BUSY if the group was not ready, leaving them staged.
+static HpsErr_t _ServoTraj_commit(ServoTrajCtx_t* ctx) {
+    HpsErr_t status = ServoGroup_commit(ctx->group);
+    if (ERR_IS_SUCCESS(status)) ctx->pending = false;
+    return status;
+}
+
+// Make the next update
+//  - Called from the update event.
+static HpsErr_t _ServoTraj_update(Event_t* event, void* param) {
+    ServoTrajCtx_t* ctx = (ServoTrajCtx_t*)param;
+    if (!ctx->playing) return ERR_SUCCESS;
+    HpsErr_t status;
+    //If the last update was delayed, try it again rather than skipping it
+    if (!ctx->pending) {
+        _ServoTraj_advance(ctx);
+        status = _ServoTraj_stage(ctx);
+        if (ERR_IS_ERROR(status)) {
+            ctx->playing = false;
+            return status;
+        }
+    }
+    status = _ServoTraj_commit(ctx);
+    if (status == ERR_BUSY) {
+        ctx->late++;
+        return ERR_AGAIN;
+    }
+    if (ERR_IS_ERROR(status)) {
+        ctx->playing = false;
+        return status;
+    }
+    //Stop once the final keyframe has been committed
+    if (_ServoTraj_atEnd(ctx)) {
+        ctx->playing = false;
+        return ERR_SUCCESS;
+    }
+    return ERR_AGAIN;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Servo Trajectory Playback
+// - group is the servo group to update. It should already be enabled.
+// - evtMgr is the event manager used to time the updates.
+// - period is the time between updates in microseconds.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t ServoTraj_initialise( ServoGroupCtx_t* group, EventMgrCtx_t* evtMgr, unsigned int period, ServoTrajCtx_t** pCtx ) {
+    if (!ServoGroup_isInitialised(group)) return ERR_BADDEVICE;
+    if (!EventMgr_isInitialised(evtMgr)) return ERR_BADDEVICE;
+    //Convert the update period to event timer ticks
+    unsigned int rate;
+    HpsErr_t status = Timer_getRate(evtMgr->timer, UINT32_MAX, &rate);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!rate) return ERR_NOSUPPORT;
+    unsigned long long interval = ((unsigned long long)period * rate + 500000ULL) / 1000000ULL;
+    if (!interval) return ERR_TOOSMALL;
+    if (interval > UINT32_MAX) return ERR_TOOBIG;
+    //Allocate the driver context, validating return value.
+    status = DriverContextAllocateWithCleanup(pCtx, &_ServoTraj_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save context values
+    ServoTrajCtx_t* ctx = *pCtx;
+    ctx->group = group;
+    ctx->evtMgr = evtMgr;
+    ctx->traj = NULL;
+    ctx->playing = false;
+    ctx->pending = false;
+    ctx->late = 0;
+    //Create the update event, which starts disabled until a trajectory is played
+    status = Event_create(evtMgr, EVENT_TYPE_DISABLED, (unsigned int)interval, &_ServoTraj_update, ctx, &ctx->event);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+// - Returns true if driver previously initialised
+bool ServoTraj_isInitialised( ServoTrajCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Start playing a trajectory
+// - The first keyframe is committed straight away, then the rest follow
+//   from the update event.
+// - Any trajectory already playing is replaced.
+// - Returns ERR_BUSY if the group was busy, in which case the first keyframe
+//   is committed on the first update instead.
+HpsErr_t ServoTraj_start( ServoTrajCtx_t* ctx, const ServoTrajectory_t* traj ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!traj || !traj->table) return ERR_NULLPTR;
+    if (!traj->frames || !traj->stepPeriods) return ERR_TOOSMALL;
+    //Stop anything already playing
+    Event_state(ctx->event, EVENT_CNTRL_CANCEL, EVENT_INTERVAL_UNCHANGED);
+    ctx->playing = false;
+    //Move to the first keyframe
+    ctx->traj = traj;
+    ctx->late = 0;
+    _ServoTraj_loadFrame(ctx, 0);
+    status = _ServoTraj_stage(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t commit = _ServoTraj_commit(ctx);
+    if (ERR_IS_ERROR(commit) && (commit != ERR_BUSY)) return commit;
+    //Nothing more to do for a single keyframe which has been committed
+    if (!ctx->pending && _ServoTraj_atEnd(ctx)) return ERR_SUCCESS;
+    //Otherwise start the update event
+    ctx->playing = true;
+    status = Event_setMode(ctx->event, EVENT_TYPE_REPEAT, EVENT_INTERVAL_UNCHANGED);
+    if (ERR_IS_ERROR(status)) {
+        ctx->playing = false;
+        return status;
+    }
+    if (!EVENT_STATE_SUCCESS(Event_state(ctx->event, EVENT_CNTRL_RESTART, EVENT_INTERVAL_UNCHANGED))) {
+        ctx->playing = false;
+        return ERR_UNKNOWN;
+    }
+    return commit;
+}
+
+// Stop playing
+// - The servos are held at their current positions.
+HpsErr_t ServoTraj_stop( ServoTrajCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->playing = false;
+    ctx->pending = false;
+    Event_state(ctx->event, EVENT_CNTRL_CANCEL, EVENT_INTERVAL_UNCHANGED);
+    return ERR_SUCCESS;
+}
+
+// Check if playing
+// - Returns ERR_BUSY while a trajectory is playing, otherwise ERR_SUCCESS.
+HpsErr_t ServoTraj_isPlaying( ServoTrajCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return ctx->playing ? ERR_BUSY : ERR_SUCCESS;
+}
+
+// Get playback statistics
+// - frame is the keyframe most recently reached or passed.
+// - late is the number of updates delayed as the group was busy.
+// - Either may be NULL if not needed.
+HpsErr_t ServoTraj_getStats( ServoTrajCtx_t* ctx, unsigned int* frame, unsigned int* late ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (frame) *frame = ctx->frame;
+    if (late) *late = ctx->late;
+    return ERR_SUCCESS;
+}
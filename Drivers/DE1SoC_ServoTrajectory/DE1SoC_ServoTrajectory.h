@@ -0,0 +1,124 @@
+/*
+ * Servo Trajectory Playback
+ * -------------------------
+ * Description:
+ * Plays back a precomputed table of servo positions on a servo
+ * group, driven by a repeating event from an event manager.
+ *
+ * A trajectory is a table of keyframes, each holding one pulse
+ * width for every channel in the group (interleaved, in the order
+ * the channels were given to ServoGroup_initialise()). Each event
+ * stages the next set of widths and commits them to the group, so
+ * the CPU only needs to run when an update is due. Between keyframes
+ * the widths can be linearly interpolated, so a coarse table still
+ * gives a smooth motion:
+ *
+ *    static const signed char wave[][2] = {
+ *        { -40, 0 }, { 40, 20 }, { -40, 0 }
+ *    };
+ *    static const ServoTrajectory_t waveTraj = {
+ *        .table = &wave[0][0], .frames = 3, .stepPeriods = 25, .loop = true
+ *    };
+ *    ServoTraj_initialise(rig, evtMgr, 20000, &traj);
+ *    ServoTraj_start(traj, &waveTraj);
+ *    while (1) {
+ *        Event_sleep(evtMgr);
+ *        Event_process(evtMgr);
+ *    }
+ *
+ * The update period should be no shorter than the PWM period of the
+ * servos, as each channel only takes a new width at the end of its
+ * period. If the group is still busy when an update is due, the update
+ * is counted as late and the same widths are committed on the next
+ * event instead, so the motion is delayed rather than skipped.
+ *
+ * Once the last keyframe has been reached, the servos are held there
+ * and playback stops, unless the trajectory loops, in which case it
+ * carries on back towards the first keyframe.
+ *
+ * The trajectory table is not copied, so must remain valid for as long
+ * as it is playing. The driver keeps pointers to the group and event
+ * manager, so must be freed before either of them.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_SERVOTRAJECTORY_H_
+#define DE1SOC_SERVOTRAJECTORY_H_
+
+//Include required header files
+#include <stdbool.h>
+#include "DE1SoC_Servo/DE1SoC_Servo.h"
+#include "Util/driver_ctx.h"
+#include "Util/event.h"
+
+// Servo Trajectory
+typedef struct {
+    const signed char* table;       // frames keyframes of one width per group channel
+    unsigned int       frames;      // Number of keyframes. Must be >0.
+    unsigned int       stepPeriods; // Updates from one keyframe to the next. 1 for no interpolation.
+    bool               loop;        // Whether to restart from the first keyframe at the end
+} ServoTrajectory_t;
+
+// Servo Trajectory Context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    ServoGroupCtx_t*         group;
+    EventMgrCtx_t*           evtMgr;
+    Event_t*                 event;     // Repeating update event
+    const ServoTrajectory_t* traj;
+    volatile bool            playing;
+    unsigned int             frame;     // Keyframe being moved away from
+    unsigned int             step;      // Updates made since that keyframe
+    signed int               pos[SERVO_MAX_COUNT];   // Current widths, Q16
+    signed int               delta[SERVO_MAX_COUNT]; // Change per update, Q16
+    bool                     pending;   // Widths staged but not yet committed
+    unsigned int             late;      // Updates delayed by a busy group
+} ServoTrajCtx_t;
+
+// Initialise Servo Trajectory Playback
+// - group is the servo group to update. It should already be enabled.
+// - evtMgr is the event manager used to time the updates.
+// - period is the time between updates in microseconds.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t ServoTraj_initialise( ServoGroupCtx_t* group, EventMgrCtx_t* evtMgr, unsigned int period, ServoTrajCtx_t** pCtx );
+
+// Check if driver initialised
+// - Returns true if driver previously initialised
+bool ServoTraj_isInitialised( ServoTrajCtx_t* ctx );
+
+// Start playing a trajectory
+// - The first keyframe is committed straight away, then the rest follow
+//   from the update event.
+// - Any trajectory already playing is replaced.
+// - Returns ERR_BUSY if the group was busy, in which case the first keyframe
+//   is committed on the first update instead.
+HpsErr_t ServoTraj_start( ServoTrajCtx_t* ctx, const ServoTrajectory_t* traj );
+
+// Stop playing
+// - The servos are held at their current positions.
+HpsErr_t ServoTraj_stop( ServoTrajCtx_t* ctx );
+
+// Check if playing
+// - Returns ERR_BUSY while a trajectory is playing, otherwise ERR_SUCCESS.
+HpsErr_t ServoTraj_isPlaying( ServoTrajCtx_t* ctx );
+
+// Get playback statistics
+// - frame is the keyframe most recently reached or passed.
+// - late is the number of updates delayed as the group was busy.
+// - Either may be NULL if not needed.
+HpsErr_t ServoTraj_getStats( ServoTrajCtx_t* ctx, unsigned int* frame, unsigned int* late );
+
+#endif /* DE1SOC_SERVOTRAJECTORY_H_ */
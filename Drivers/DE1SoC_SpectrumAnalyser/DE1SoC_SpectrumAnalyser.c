@@ -0,0 +1,346 @@
+/*
+ * Audio Spectrum Analyser
+ * -----------------------
+ * Description:
+ * Real-time bar graph of the WM8731 line input spectrum on the LT24
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_SpectrumAnalyser.h"
+#include "Util/mem_pool.h"
+#include "Util/bit_helpers.h"
+#include "Util/lowlevel_arm.h"
+
+#include <string.h>
+#include <math.h>
+
+//Level of a full scale sine wave, in 1/8ths of a bit of the squared magnitude.
+//The FFT scales by 1/size and the Hann window halves the peak, so the bin
+//magnitude is 1/4 of full scale, or 2^27 once squared.
+#define SPECTRUM_TOP_LEVEL  (27 * 8)
+
+/*
+ * Internal Functions
+ */
+
+//Level of a squared magnitude, as log2 in 1/8ths of a bit
+static inline unsigned int _Spectrum_level( q31_t magSq ) {
+    if (magSq <= 0) return 0;
+    unsigned int msb = 31 - __clz((unsigned int)magSq);
+    //Next three bits below the leading one approximate the fraction
+    unsigned int frac = ((unsigned int)magSq << (31 - msb)) >> 28;
+    return msb * 8 + (frac & 7);
+}
+
+//Frequency bins for each bar
+// - Logarithmically spaced from bin 1 (bin 0 is DC) to fftSize / 2, with at
+//   least one bin in each bar.
+static void _Spectrum_makeEdges( SpectrumCtx_t* ctx ) {
+    unsigned int numBins = ctx->fft.size / 2;
+    unsigned int numBars = ctx->numBars;
+    ctx->edges[0] = 1;
+    for (unsigned int bar = 1; bar <= numBars; bar++) {
+        unsigned int edge = (unsigned int)(pow((double)numBins, (double)bar / numBars) + 0.5);
+        if (edge <= ctx->edges[bar - 1]) edge = ctx->edges[bar - 1] + 1;
+        //Leave room for the bars above
+        if (edge > numBins - (numBars - bar)) edge = numBins - (numBars - bar);
+        ctx->edges[bar] = edge;
+    }
+}
+
+//Analyse a frame
+static void _Spectrum_analyse( SpectrumCtx_t* ctx, unsigned int buf ) {
+    unsigned int size = ctx->fft.size;
+    DSP_fftLoadRealQ31(ctx->frame[buf], ctx->window, ctx->work, size);
+    DSP_fftQ31(&ctx->fft, ctx->work);
+    //Real input, so only the first half of the bins are needed
+    DSP_cmplxMagSqQ31(ctx->work, ctx->work, size / 2);
+    unsigned int range = SPECTRUM_TOP_LEVEL - ctx->floorLevel;
+    for (unsigned int bar = 0; bar < ctx->numBars; bar++) {
+        q31_t peak = 0;
+        for (unsigned int bin = ctx->edges[bar]; bin < ctx->edges[bar + 1]; bin++) {
+            if (ctx->work[bin] > peak) peak = ctx->work[bin];
+        }
+        unsigned int level = _Spectrum_level(peak);
+        if (level <= ctx->floorLevel) {
+            ctx->levels[bar] = 0;
+        } else if (level >= SPECTRUM_TOP_LEVEL) {
+            ctx->levels[bar] = ctx->height;
+        } else {
+            ctx->levels[bar] = ((level - ctx->floorLevel) * ctx->height) / range;
+        }
+    }
+}
+
+//CPU1 work item. Analyses frame buffer arg.
+static void _Spectrum_analyseWork( void* param, unsigned int arg ) {
+    SpectrumCtx_t* ctx = (SpectrumCtx_t*)param;
+    _Spectrum_analyse(ctx, arg);
+    //Results must be visible before CPU0 sees we are done
+    __DMB();
+    ctx->computeBusy = false;
+}
+
+//Start analysing the frame just captured
+// - The frame is dropped if the previous one has not been drawn yet.
+static void _Spectrum_frameDone( SpectrumCtx_t* ctx ) {
+    if (ctx->computeBusy || ctx->resultPending) {
+        ctx->dropped++;
+        return;
+    }
+    ctx->computeBuf = ctx->captureBuf;
+    ctx->captureBuf ^= 1;
+    ctx->resultPending = true;
+    if (ctx->smp) {
+        ctx->computeBusy = true;
+        __DMB();
+        HpsErr_t status = SMP_post(ctx->smp, SMP_CPU1, &_Spectrum_analyseWork, ctx, ctx->computeBuf);
+        if (ERR_IS_SUCCESS(status)) return;
+        //Queue full, so do it here
+        ctx->computeBusy = false;
+    }
+    _Spectrum_analyse(ctx, ctx->computeBuf);
+}
+
+//Draw the bars
+static HpsErr_t _Spectrum_draw( SpectrumCtx_t* ctx ) {
+    HpsErr_t status;
+    if (ctx->redraw) {
+        status = LT24FB_fillRect(ctx->fb, ctx->background, ctx->xleft, ctx->ytop, ctx->width, ctx->height);
+        if (ERR_IS_ERROR(status)) return status;
+        memset(ctx->drawn, 0, ctx->numBars * sizeof(unsigned short));
+        ctx->redraw = false;
+    }
+    unsigned int barWidth = ctx->width / ctx->numBars;
+    //Gap between bars if there is room
+    unsigned int fillWidth = (barWidth > 2) ? (barWidth - 1) : barWidth;
+    unsigned int bottom = ctx->ytop + ctx->height;
+    for (unsigned int bar = 0; bar < ctx->numBars; bar++) {
+        unsigned int x = ctx->xleft + bar * barWidth;
+        unsigned int level = ctx->levels[bar];
+        unsigned int old = ctx->drawn[bar];
+        //Fall gradually
+        if ((level < old) && (old - level > SPECTRUM_FALL_STEP)) level = old - SPECTRUM_FALL_STEP;
+        //Only the part which changed is filled
+        if (level > old) {
+            status = LT24FB_fillRect(ctx->fb, ctx->barColour, x, bottom - level, fillWidth, level - old);
+        } else if (level < old) {
+            status = LT24FB_fillRect(ctx->fb, ctx->background, x, bottom - old, fillWidth, old - level);
+        } else {
+            continue;
+        }
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->drawn[bar] = level;
+    }
+    status = LT24FB_flip(ctx->fb);
+    return ERR_IS_SKIPPED(status) ? ERR_SUCCESS : status;
+}
+
+//Cleanup
+static void _Spectrum_cleanup( SpectrumCtx_t* ctx ) {
+    //CPU1 may still be analysing
+    while (ctx->computeBusy);
+    MemPool_free(ctx->edges);
+    MemPool_free(ctx->levels);
+    MemPool_free(ctx->drawn);
+    MemPool_free(ctx->block);
+    MemPool_free(ctx->left);
+    MemPool_free(ctx->right);
+    MemPool_free(ctx->frame[0]);
+    MemPool_free(ctx->frame[1]);
+    MemPool_free(ctx->twiddles);
+    MemPool_free(ctx->window);
+    MemPool_free(ctx->work);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the spectrum analyser
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE.
+// - fb is the frame buffer to draw in. The graph fills the display until
+//   Spectrum_setArea() is called.
+// - smp is an SMP context to run the analysis on CPU1, or NULL.
+// - fftSize is the number of samples in each frame, a power of 4 from 16
+//   to 4096 (e.g. 256 or 1024).
+// - numBars is the number of bars, at most fftSize / 2 - 1.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t Spectrum_initialise( WM8731Ctx_t* audio, LT24FBCtx_t* fb, SmpCtx_t* smp, unsigned int fftSize, unsigned int numBars, SpectrumCtx_t** pCtx ) {
+    //Check if the drivers have been initialised (required)
+    if (!WM8731_isInitialised(audio)) return ERR_BADDEVICE;
+    if (!audio->streaming) return ERR_WRONGMODE;
+    if (!LT24FB_isInitialised(fb)) return ERR_BADDEVICE;
+    if (smp && !SMP_isInitialised(smp)) return ERR_NOINIT;
+    if (!numBars) return ERR_TOOSMALL;
+    if ((numBars > LT24_WIDTH) || (numBars >= fftSize / 2)) return ERR_TOOBIG;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_Spectrum_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    SpectrumCtx_t* ctx = *pCtx;
+    ctx->audio = audio;
+    ctx->fb = fb;
+    ctx->smp = smp;
+    ctx->numBars = numBars;
+    ctx->xleft = 0;
+    ctx->ytop = 0;
+    ctx->width = LT24_WIDTH;
+    ctx->height = LT24_HEIGHT;
+    ctx->barColour = LT24_GREEN;
+    ctx->background = LT24_BLACK;
+    ctx->redraw = true;
+    Spectrum_setRange(ctx, SPECTRUM_DEFAULT_RANGE);
+    //Allocate buffers
+    unsigned int blockSize = audio->blockSize;
+    ctx->edges    = MemPool_malloc((numBars + 1) * sizeof(unsigned short));
+    ctx->levels   = MemPool_calloc(numBars, sizeof(unsigned short));
+    ctx->drawn    = MemPool_calloc(numBars, sizeof(unsigned short));
+    ctx->block    = MemPool_malloc(blockSize * sizeof(WM8731Sample_t));
+    ctx->left     = MemPool_malloc(blockSize * sizeof(q31_t));
+    ctx->right    = MemPool_malloc(blockSize * sizeof(q31_t));
+    ctx->frame[0] = MemPool_malloc(fftSize * sizeof(q31_t));
+    ctx->frame[1] = MemPool_malloc(fftSize * sizeof(q31_t));
+    ctx->twiddles = MemPool_malloc(DSP_FFT_TWIDDLE_SIZE(fftSize) * sizeof(q31_t));
+    ctx->window   = MemPool_malloc(fftSize * sizeof(q31_t));
+    ctx->work     = MemPool_malloc(2 * fftSize * sizeof(q31_t));
+    if (!ctx->edges || !ctx->levels || !ctx->drawn || !ctx->block || !ctx->left || !ctx->right ||
+        !ctx->frame[0] || !ctx->frame[1] || !ctx->twiddles || !ctx->window || !ctx->work) {
+        return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    }
+    //Prepare the analysis
+    status = DSP_fftInitQ31(&ctx->fft, fftSize, ctx->twiddles);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    DSP_windowHannQ31(ctx->window, fftSize);
+    _Spectrum_makeEdges(ctx);
+    ctx->captureBuf = 0;
+    ctx->captureFill = 0;
+    ctx->computeBusy = false;
+    ctx->resultPending = false;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool Spectrum_isInitialised( SpectrumCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Set the area of the display used for the graph
+// - The area is cleared and the bars redrawn on the next frame.
+// - Returns ERR_BEYONDEND if the area is not on the display, or
+//   ERR_TOOSMALL if it is narrower than the number of bars.
+HpsErr_t Spectrum_setArea( SpectrumCtx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!height || (xleft + width > LT24_WIDTH) || (ytop + height > LT24_HEIGHT)) return ERR_BEYONDEND;
+    if (width < ctx->numBars) return ERR_TOOSMALL;
+    //Clear the old area, as the new one may not cover it
+    status = LT24FB_fillRect(ctx->fb, ctx->background, ctx->xleft, ctx->ytop, ctx->width, ctx->height);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->xleft = xleft;
+    ctx->ytop = ytop;
+    ctx->width = width;
+    ctx->height = height;
+    //Levels from the last analysis are for the old height
+    memset(ctx->levels, 0, ctx->numBars * sizeof(unsigned short));
+    ctx->redraw = true;
+    return ERR_SUCCESS;
+}
+
+//Set the colours of the graph
+// - The area is cleared and the bars redrawn on the next frame.
+HpsErr_t Spectrum_setColours( SpectrumCtx_t* ctx, unsigned short barColour, unsigned short background ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->barColour = barColour;
+    ctx->background = background;
+    ctx->redraw = true;
+    return ERR_SUCCESS;
+}
+
+//Set the dynamic range of the graph
+// - A full scale sine wave reaches the top of the graph, and a level
+//   rangeDb below that is an empty bar.
+HpsErr_t Spectrum_setRange( SpectrumCtx_t* ctx, unsigned int rangeDb ) {
+    //Ensure context valid. This is also used during initialisation.
+    if (!ctx) return ERR_NULLPTR;
+    //Each bit of the squared magnitude is 3.01dB
+    unsigned int range = (rangeDb * 8 * 100) / 301;
+    if (!range) return ERR_TOOSMALL;
+    if (range >= SPECTRUM_TOP_LEVEL) return ERR_TOOBIG;
+    ctx->floorLevel = SPECTRUM_TOP_LEVEL - range;
+    return ERR_SUCCESS;
+}
+
+//Run the pipeline
+// - Draws the result of the last analysis if it has finished, then takes
+//   blocks from the ADC ring, starting an analysis for each full frame.
+// - Returns the number of frames drawn (>= 0), or an error code.
+HpsErr_t Spectrum_process( SpectrumCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int drawn = 0;
+    //Display stage. Drawing first frees the results for the next frame.
+    if (ctx->resultPending && !ctx->computeBusy) {
+        __DMB();
+        status = _Spectrum_draw(ctx);
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->resultPending = false;
+        ctx->frames++;
+        drawn++;
+    }
+    //Capture stage, for as many blocks as are ready
+    unsigned int blockSize = ctx->audio->blockSize;
+    unsigned int size = ctx->fft.size;
+    while (true) {
+        status = WM8731_acquireBlock(ctx->audio, ctx->block);
+        if (ERR_IS_RETRY(status)) break;
+        if (ERR_IS_ERROR(status)) return status;
+        //Mono mix of the two channels
+        DSP_fromCodecStereo((const uint32_t*)ctx->block, ctx->left, ctx->right, blockSize);
+        DSP_mixQ31(ctx->left, INT32_MAX / 2, ctx->right, INT32_MAX / 2, ctx->left, blockSize);
+        //Frames need not be a whole number of blocks
+        unsigned int pos = 0;
+        while (pos < blockSize) {
+            unsigned int count = size - ctx->captureFill;
+            if (count > blockSize - pos) count = blockSize - pos;
+            memcpy(&ctx->frame[ctx->captureBuf][ctx->captureFill], &ctx->left[pos], count * sizeof(q31_t));
+            ctx->captureFill += count;
+            pos += count;
+            if (ctx->captureFill == size) {
+                _Spectrum_frameDone(ctx);
+                ctx->captureFill = 0;
+            }
+        }
+    }
+    return (HpsErr_t)drawn;
+}
+
+//Get statistics
+// - frames is the number of frames drawn, and dropped the number of frames
+//   skipped because the previous one was still in progress. Either may be NULL.
+HpsErr_t Spectrum_getStats( SpectrumCtx_t* ctx, unsigned int* frames, unsigned int* dropped ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (frames) *frames = ctx->frames;
+    if (dropped) *dropped = ctx->dropped;
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/*
+ * Audio Spectrum Analyser
+ * -----------------------
+ * Description:
+ * Real-time bar graph of the WM8731 line input spectrum on the LT24
+ *
+ * The analyser is a pipeline of three stages:
+ *
+ *  1. Capture. Blocks from the WM8731 ADC ring (WM8731_acquireBlock)
+ *     are mixed to mono and gathered into frames of fftSize samples.
+ *     Two frame buffers are used, so the next frame is captured while
+ *     the previous one is analysed.
+ *  2. Analysis. Each frame has a Hann window applied, is transformed
+ *     with the radix-4 FFT (DSP_fftQ31), and the squared magnitude of
+ *     each bin is taken (Util/dsp.h). The bins are grouped into
+ *     logarithmically spaced bars, and the peak of each bar converted
+ *     to a height on a decibel scale.
+ *  3. Display. Each bar is grown or shrunk by filling only the part
+ *     which changed in the LT24FB back buffer, then LT24FB_flip()
+ *     sends just the dirty rectangles to the display. Bars fall
+ *     gradually rather than dropping straight to the new level.
+ *
+ * If an SMP context is given, the analysis runs on CPU1 while CPU0
+ * carries on capturing and drawing, otherwise it runs inline. CPU1
+ * must be running a loop which calls SMP_wait() (see Util/smp.h).
+ *
+ * If a frame is complete while the previous one is still being
+ * analysed or drawn, it is dropped so that the display keeps up
+ * with the audio rather than falling behind.
+ *
+ * Usage
+ * -----
+ *
+ *    WM8731_startStreaming(audio, IRQ_LSC_AUDIO, 64, 8);
+ *    LT24FB_initialise(lt24, &fb);
+ *    Spectrum_initialise(audio, fb, smp, 256, 32, &spectrum);
+ *    while (1) {
+ *        Spectrum_process(spectrum);
+ *        ...
+ *    }
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_SPECTRUMANALYSER_H_
+#define DE1SOC_SPECTRUMANALYSER_H_
+
+//Include required header files
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "DE1SoC_LT24FrameBuffer/DE1SoC_LT24FrameBuffer.h"
+#include "Util/driver_ctx.h"
+#include "Util/dsp.h"
+#include "Util/smp.h"
+
+//Number of pixels a bar may fall by in each frame
+#ifndef SPECTRUM_FALL_STEP
+#define SPECTRUM_FALL_STEP  8
+#endif
+
+//Default dynamic range of the graph in dB
+#define SPECTRUM_DEFAULT_RANGE  60
+
+// Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    WM8731Ctx_t* audio;
+    LT24FBCtx_t* fb;
+    SmpCtx_t* smp;
+    //Graph
+    unsigned int xleft;
+    unsigned int ytop;
+    unsigned int width;
+    unsigned int height;
+    unsigned short barColour;
+    unsigned short background;
+    unsigned int floorLevel;    // Level of an empty bar, in 1/8ths of a bit
+    unsigned int numBars;
+    unsigned short* edges;      // First FFT bin of each bar, plus one past the last
+    unsigned short* levels;     // Heights from the last analysis
+    unsigned short* drawn;      // Heights currently drawn
+    bool redraw;
+    //Capture
+    WM8731Sample_t* block;
+    q31_t* left;
+    q31_t* right;
+    q31_t* frame[2];
+    unsigned int captureBuf;
+    unsigned int captureFill;
+    //Analysis
+    DspFftQ31_t fft;
+    q31_t* twiddles;
+    q31_t* window;
+    q31_t* work;
+    unsigned int computeBuf;
+    volatile bool computeBusy;
+    bool resultPending;
+    //Statistics
+    unsigned int frames;
+    unsigned int dropped;
+} SpectrumCtx_t;
+
+//Initialise the spectrum analyser
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE.
+// - fb is the frame buffer to draw in. The graph fills the display until
+//   Spectrum_setArea() is called.
+// - smp is an SMP context to run the analysis on CPU1, or NULL.
+// - fftSize is the number of samples in each frame, a power of 4 from 16
+//   to 4096 (e.g. 256 or 1024).
+// - numBars is the number of bars, at most fftSize / 2 - 1.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t Spectrum_initialise( WM8731Ctx_t* audio, LT24FBCtx_t* fb, SmpCtx_t* smp, unsigned int fftSize, unsigned int numBars, SpectrumCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool Spectrum_isInitialised( SpectrumCtx_t* ctx );
+
+//Set the area of the display used for the graph
+// - The area is cleared and the bars redrawn on the next frame.
+// - Returns ERR_BEYONDEND if the area is not on the display, or
+//   ERR_TOOSMALL if it is narrower than the number of bars.
+HpsErr_t Spectrum_setArea( SpectrumCtx_t* ctx, unsigned int xleft, unsigned int ytop, unsigned int width, unsigned int height );
+
+//Set the colours of the graph
+// - The area is cleared and the bars redrawn on the next frame.
+HpsErr_t Spectrum_setColours( SpectrumCtx_t* ctx, unsigned short barColour, unsigned short background );
+
+//Set the dynamic range of the graph
+// - A full scale sine wave reaches the top of the graph, and a level
+//   rangeDb below that is an empty bar.
+HpsErr_t Spectrum_setRange( SpectrumCtx_t* ctx, unsigned int rangeDb );
+
+//Run the pipeline
+// - Draws the result of the last analysis if it has finished, then takes
+//   blocks from the ADC ring, starting an analysis for each full frame.
+// - Returns the number of frames drawn (>= 0), or an error code.
+HpsErr_t Spectrum_process( SpectrumCtx_t* ctx );
+
+//Get statistics
+// - frames is the number of frames drawn, and dropped the number of frames
+//   skipped because the previous one was still in progress. Either may be NULL.
+HpsErr_t Spectrum_getStats( SpectrumCtx_t* ctx, unsigned int* frames, unsigned int* dropped );
+
+#endif /* DE1SOC_SPECTRUMANALYSER_H_ */
@@ -26,6 +26,9 @@
  * changing registers in the audio codec, e.g. to configure the
  * volume or filtering settings.
  * 
+ * An interrupt driven streaming mode, and DMA based FIFO transfers
+ * are also available. See DE1SoC_WM8731.h for details.
+ * 
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -33,6 +36,16 @@
  *
  * Date       | Changes
  * -----------+-------------------------------
+ * 14/10/2026 | Add partial 16-bit frame submission to the DAC ring
+ * 14/10/2026 | Add shared buffer descriptor DMA transfers
+ * 14/10/2026 | Add interleaved block sample APIs
+ * 14/10/2026 | Add streaming statistics and latency measurement
+ * 14/10/2026 | Add non-blocking initialisation steps
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Add unchecked inline sample accessors
+ * 14/10/2026 | Add register write sequences and register cache
+ * 14/10/2026 | Add DMA FIFO transfers
+ * 14/10/2026 | Add interrupt driven streaming mode
  * 21/11/2024 | Use generic I2C interface
  * 10/02/2024 | Add new API for FIFO access
  * 31/01/2024 | Update to new driver contexts
@@ -42,18 +55,27 @@
  */
 
 #include "DE1SoC_WM8731.h"
+#include "Util/mem_pool.h"
 #include "Util/bit_helpers.h"
 #include "Util/macros.h"
+#include "Util/lowlevel_arm.h"
+#include "Util/dma_buffer.h"
+#include "Util/profile.h"
+
+#include <string.h>
+#include <stdlib.h>
 
 //WM8731 ARM Address Offsets
 #define WM8731_CONTROL    (0x0/sizeof(unsigned int))
 #define WM8731_FIFOSPACE  (0x4/sizeof(unsigned int))
-#define WM8731_LEFTFIFO   (0x8/sizeof(unsigned int))
-#define WM8731_RIGHTFIFO  (0xC/sizeof(unsigned int))
 
 //Bits
+#define WM8731_IRQ_ADC_EN     0
+#define WM8731_IRQ_DAC_EN     1
 #define WM8731_FIFO_RESET_ADC 2
 #define WM8731_FIFO_RESET_DAC 3
+#define WM8731_IRQ_ADC_PEND   8
+#define WM8731_IRQ_DAC_PEND   9
 
 //FIFO Offsets
 #define WM8731_FIFO_RARC 0
@@ -70,41 +92,464 @@
 
 #define WM8731_I2C_ADDRESS 0x1A
 
+//Latency measurement pulse, half scale for a few samples so the codec filters don't lose it
+#define WM8731_LATENCY_PULSE_LEVEL  0x400000
+#define WM8731_LATENCY_PULSE_LENGTH 8
+//Number of block periods to wait for the rings before giving up
+#define WM8731_LATENCY_TIMEOUT      4
+
+//Record a completed register write in the cache
+static inline void _WM8731_cacheUpdate(WM8731Ctx_t* ctx, WM8731RegAddress regAddr, unsigned int regVal, bool valid) {
+    ctx->regCache[regAddr] = regVal;
+    if (valid) {
+        ctx->regCacheValid |= (1U << regAddr);
+    } else {
+        ctx->regCacheValid &= ~(1U << regAddr);
+    }
+}
+
+//Start the next register write of a sequence
+// - Skips writes of the value a register already holds.
+// - Returns ERR_AGAIN if a write is in progress, or ERR_SUCCESS once all are done.
+static HpsErr_t _WM8731_seqStart(WM8731Ctx_t* ctx) {
+    while (ctx->seq.index < ctx->seq.count) {
+        const WM8731RegWrite_t* entry = &ctx->seq.table[ctx->seq.index];
+        unsigned int regVal = entry->value & WM8731_I2C_REGDATA_MASK;
+        if ((ctx->regCacheValid & (1U << entry->reg)) && (ctx->regCache[entry->reg] == regVal)) {
+            ctx->seq.index++;
+            continue;
+        }
+        //Build write data value
+        uint16_t writeData = MaskInsert(entry->reg, WM8731_I2C_REGADDR_MASK, WM8731_I2C_REGADDR_OFFS) | 
+                             MaskInsert(regVal,     WM8731_I2C_REGDATA_MASK, WM8731_I2C_REGDATA_OFFS);
+        //Remap data to big-endian. Kept in the context in case the I2C driver needs it until done.
+        ctx->seq.data = reverseShort(writeData);
+        //Send data as array
+        HpsErr_t status = I2C_write(ctx->i2c, ctx->i2cAddr, (uint8_t*)&ctx->seq.data, sizeof(ctx->seq.data));
+        if (ERR_IS_RETRY(status)) {
+            ctx->seq.running = true;
+            return ERR_AGAIN;
+        }
+        //Unknown what the register holds if it failed
+        _WM8731_cacheUpdate(ctx, entry->reg, regVal, ERR_IS_SUCCESS(status));
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->seq.index++;
+    }
+    return ERR_SUCCESS;
+}
+
+//Progress a register write sequence
+// - Checks if the write in progress is complete, then starts the next.
+// - Returns ERR_AGAIN while running, then the result of the sequence.
+static HpsErr_t _WM8731_seqService(WM8731Ctx_t* ctx) {
+    if (!ctx->seq.table) return ctx->seq.status;
+    HpsErr_t status = ERR_SUCCESS;
+    if (ctx->seq.running) {
+        //Check result by passing len=0
+        status = I2C_write(ctx->i2c, ctx->i2cAddr, NULL, 0);
+        if (ERR_IS_RETRY(status)) return ERR_AGAIN;
+        ctx->seq.running = false;
+        const WM8731RegWrite_t* entry = &ctx->seq.table[ctx->seq.index];
+        _WM8731_cacheUpdate(ctx, entry->reg, entry->value & WM8731_I2C_REGDATA_MASK, ERR_IS_SUCCESS(status));
+        if (ERR_IS_SUCCESS(status)) ctx->seq.index++;
+    }
+    if (ERR_IS_SUCCESS(status)) {
+        status = _WM8731_seqStart(ctx);
+        if (ERR_IS_RETRY(status)) return ERR_AGAIN;
+    }
+    //Finished
+    ctx->seq.table = NULL;
+    ctx->seq.status = ERR_IS_ERROR(status) ? status : ERR_SUCCESS;
+    return ctx->seq.status;
+}
+
+//Start a register write sequence
+static HpsErr_t _WM8731_seqBegin(WM8731Ctx_t* ctx, const WM8731RegWrite_t* table, unsigned int count) {
+    ctx->seq.table = table;
+    ctx->seq.count = count;
+    ctx->seq.index = 0;
+    ctx->seq.running = false;
+    return _WM8731_seqService(ctx);
+}
+
+//Write a table of registers, waiting until done
+static HpsErr_t _WM8731_writeTable(WM8731Ctx_t* ctx, const WM8731RegWrite_t* table, unsigned int count) {
+    HpsErr_t status = _WM8731_seqBegin(ctx, table, count);
+    while(ERR_IS_RETRY(status)) {
+        status = _WM8731_seqService(ctx);
+    }
+    return status;
+}
+
 //I2C Register Write
 static HpsErr_t _WM8731_writeRegister(WM8731Ctx_t* ctx, WM8731RegAddress regAddr, unsigned int regVal) {
-    //Build write data value
-    uint16_t writeData = MaskInsert(regAddr, WM8731_I2C_REGADDR_MASK, WM8731_I2C_REGADDR_OFFS) | 
-                         MaskInsert(regVal,  WM8731_I2C_REGDATA_MASK, WM8731_I2C_REGDATA_OFFS);
-    //Remap data to big-endian
-    writeData = reverseShort(writeData);
-    //Send data as array
-    HpsErr_t status = I2C_write(ctx->i2c, ctx->i2cAddr, (uint8_t*)&writeData, sizeof(writeData));
-    while(ERR_IS_RETRY(status)) {
-        //If ERR_IS_RETRY for I2C_write, then means still in progress. 
-        //Check result by passing len=0, and keep going until complete.
-        status = I2C_write(ctx->i2c, ctx->i2cAddr, NULL, 0);
+    WM8731RegWrite_t entry = { .reg = regAddr, .value = regVal };
+    return _WM8731_writeTable(ctx, &entry, 1);
+}
+
+//Number of samples in a ring
+static inline unsigned int _WM8731_ringFill(WM8731Ring_t* ring) {
+    unsigned int fill = ring->head + (2 * ring->size) - ring->tail;
+    if (fill >= (2 * ring->size)) fill -= (2 * ring->size);
+    return fill;
+}
+
+//Number of free samples in a ring
+static inline unsigned int _WM8731_ringSpace(WM8731Ring_t* ring) {
+    return ring->size - _WM8731_ringFill(ring);
+}
+
+//Buffer index for a head/tail position
+static inline unsigned int _WM8731_ringIndex(WM8731Ring_t* ring, unsigned int pos) {
+    return (pos >= ring->size) ? (pos - ring->size) : pos;
+}
+
+//Advance a head/tail position
+static inline unsigned int _WM8731_ringAdvance(WM8731Ring_t* ring, unsigned int pos, unsigned int count) {
+    pos += count;
+    if (pos >= (2 * ring->size)) pos -= (2 * ring->size);
+    return pos;
+}
+
+//Copy samples into a ring
+// - Caller must ensure there is space
+static void _WM8731_ringWrite(WM8731Ring_t* ring, const WM8731Sample_t* samples, unsigned int count) {
+    unsigned int idx = _WM8731_ringIndex(ring, ring->head);
+    for (unsigned int cnt = 0; cnt < count; cnt++) {
+        ring->buf[idx] = samples[cnt];
+        if (++idx == ring->size) idx = 0;
+    }
+    //Ensure data is written before the consumer can see it
+    __DMB();
+    ring->head = _WM8731_ringAdvance(ring, ring->head, count);
+}
+
+//Copy samples out of a ring
+// - Caller must ensure there are enough samples
+static void _WM8731_ringRead(WM8731Ring_t* ring, WM8731Sample_t* samples, unsigned int count) {
+    unsigned int idx = _WM8731_ringIndex(ring, ring->tail);
+    for (unsigned int cnt = 0; cnt < count; cnt++) {
+        samples[cnt] = ring->buf[idx];
+        if (++idx == ring->size) idx = 0;
+    }
+    //Ensure data is read before the producer can overwrite it
+    __DMB();
+    ring->tail = _WM8731_ringAdvance(ring, ring->tail, count);
+}
+
+//Set up the streaming statistics
+static void _WM8731_statsInit(WM8731Ctx_t* ctx) {
+    WM8731Stats_t* stats = &ctx->stats;
+    stats->adcFill   = (ProfileHistogram_t)PROFILE_HISTOGRAM_INIT("WM8731 ADC FIFO fill",  stats->adcFillBins,   WM8731_STATS_FIFO_BINS, WM8731_STATS_FIFO_WIDTH);
+    stats->dacSpace  = (ProfileHistogram_t)PROFILE_HISTOGRAM_INIT("WM8731 DAC FIFO space", stats->dacSpaceBins,  WM8731_STATS_FIFO_BINS, WM8731_STATS_FIFO_WIDTH);
+    stats->blockLoad = (ProfileHistogram_t)PROFILE_HISTOGRAM_INIT("WM8731 block load %",   stats->blockLoadBins, WM8731_STATS_LOAD_BINS, WM8731_STATS_LOAD_WIDTH);
+    stats->underrunCount = (ProfileCounter_t)PROFILE_COUNTER_INIT("WM8731 underruns",       &ctx->underruns);
+    stats->overrunCount  = (ProfileCounter_t)PROFILE_COUNTER_INIT("WM8731 overruns",        &ctx->overruns);
+    stats->missCount     = (ProfileCounter_t)PROFILE_COUNTER_INIT("WM8731 deadline misses", &stats->deadlineMisses);
+}
+
+//Clear the streaming statistics
+// - IRQs must be disabled if streaming, as the handler also modifies them.
+static void _WM8731_statsClear(WM8731Ctx_t* ctx) {
+    WM8731Stats_t* stats = &ctx->stats;
+    Profile_histogramClear(&stats->adcFill);
+    Profile_histogramClear(&stats->dacSpace);
+    Profile_histogramClear(&stats->blockLoad);
+    stats->deadlineMisses = 0;
+    ctx->underruns = 0;
+    ctx->overruns = 0;
+}
+
+//Add or remove the statistics in the profiling report
+static void _WM8731_statsPublish(WM8731Ctx_t* ctx, bool publish) {
+    WM8731Stats_t* stats = &ctx->stats;
+    if (publish) {
+        Profile_addCounter(&stats->underrunCount);
+        Profile_addCounter(&stats->overrunCount);
+        Profile_addCounter(&stats->missCount);
+        Profile_addHistogram(&stats->adcFill);
+        Profile_addHistogram(&stats->dacSpace);
+        Profile_addHistogram(&stats->blockLoad);
+    } else {
+        Profile_removeCounter(&stats->underrunCount);
+        Profile_removeCounter(&stats->overrunCount);
+        Profile_removeCounter(&stats->missCount);
+        Profile_removeHistogram(&stats->adcFill);
+        Profile_removeHistogram(&stats->dacSpace);
+        Profile_removeHistogram(&stats->blockLoad);
+    }
+    stats->published = publish;
+}
+
+//Block period in global timer ticks
+static unsigned int _WM8731_statsDeadline(WM8731Ctx_t* ctx) {
+    //Only needs working out once, as the rate can't change while streaming
+    if (!ctx->stats.deadline) {
+        ctx->stats.deadline = (unsigned int)(((uint64_t)ctx->blockSize * Profile_timestampRate()) / ctx->sampleRate);
+    }
+    return ctx->stats.deadline;
+}
+
+//Wait for a block of input samples
+static HpsErr_t _WM8731_waitAcquire(WM8731Ctx_t* ctx, WM8731Sample_t* block, uint64_t timeout) {
+    uint64_t start = Profile_timestamp();
+    HpsErr_t status;
+    while (ERR_IS_RETRY(status = WM8731_acquireBlock(ctx, block))) {
+        if ((Profile_timestamp() - start) > timeout) return ERR_TIMEOUT;
+    }
+    return status;
+}
+
+//Wait for space to submit a block of output samples
+static HpsErr_t _WM8731_waitSubmit(WM8731Ctx_t* ctx, const WM8731Sample_t* block, uint64_t timeout) {
+    uint64_t start = Profile_timestamp();
+    HpsErr_t status;
+    while ((status = WM8731_submitBlock(ctx, block)) == ERR_NOSPACE) {
+        if ((Profile_timestamp() - start) > timeout) return ERR_TIMEOUT;
     }
     return status;
 }
 
+//Streaming interrupt handler
+// - Moves samples between the FIFOs and the rings
+static __irq void _WM8731_streamIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    WM8731Ctx_t* ctx = (WM8731Ctx_t*)param;
+    if (!ctx) return;
+    unsigned int control = ctx->base[WM8731_CONTROL];
+    unsigned int fifo = ctx->base[WM8731_FIFOSPACE];
+    //ADC FIFO filling up
+    if (control & _BV(WM8731_IRQ_ADC_PEND)) {
+        WM8731Ring_t* ring = &ctx->adcRing;
+        unsigned int avail = min(MaskExtract(fifo, WM8731_FIFO_MASK, WM8731_FIFO_RARC), MaskExtract(fifo, WM8731_FIFO_MASK, WM8731_FIFO_RALC));
+        unsigned int space = _WM8731_ringSpace(ring);
+        unsigned int count = min(avail, space);
+        unsigned int idx = _WM8731_ringIndex(ring, ring->head);
+        Profile_histogramAdd(&ctx->stats.adcFill, avail);
+        for (unsigned int cnt = 0; cnt < count; cnt++) {
+            ring->buf[idx].left  = ctx->base[WM8731_LEFTFIFO];
+            ring->buf[idx].right = ctx->base[WM8731_RIGHTFIFO];
+            if (++idx == ring->size) idx = 0;
+        }
+        __DMB();
+        ring->head = _WM8731_ringAdvance(ring, ring->head, count);
+        //Anything that doesn't fit must still be drained, or the IRQ will keep firing
+        for (unsigned int cnt = count; cnt < avail; cnt++) {
+            (void)ctx->base[WM8731_LEFTFIFO];
+            (void)ctx->base[WM8731_RIGHTFIFO];
+        }
+        ctx->overruns += (avail - count);
+    }
+    //DAC FIFO emptying
+    if (control & _BV(WM8731_IRQ_DAC_PEND)) {
+        WM8731Ring_t* ring = &ctx->dacRing;
+        unsigned int space = min(MaskExtract(fifo, WM8731_FIFO_MASK, WM8731_FIFO_WSRC), MaskExtract(fifo, WM8731_FIFO_MASK, WM8731_FIFO_WSLC));
+        unsigned int avail = _WM8731_ringFill(ring);
+        unsigned int count = min(avail, space);
+        unsigned int idx = _WM8731_ringIndex(ring, ring->tail);
+        Profile_histogramAdd(&ctx->stats.dacSpace, space);
+        for (unsigned int cnt = 0; cnt < count; cnt++) {
+            ctx->base[WM8731_LEFTFIFO]  = ring->buf[idx].left;
+            ctx->base[WM8731_RIGHTFIFO] = ring->buf[idx].right;
+            if (++idx == ring->size) idx = 0;
+        }
+        __DMB();
+        ring->tail = _WM8731_ringAdvance(ring, ring->tail, count);
+        //If ring has run dry, stop DAC interrupts until more data is submitted
+        if (count == avail) {
+            ctx->base[WM8731_CONTROL] &= ~_BV(WM8731_IRQ_DAC_EN);
+            ctx->underruns++;
+        }
+    }
+    *handled = true;
+}
+
+//Stop streaming
+static void _WM8731_stopStreaming(WM8731Ctx_t* ctx) {
+    //Disable interrupts in the controller, then remove the handler
+    ctx->base[WM8731_CONTROL] &= ~(_BV(WM8731_IRQ_ADC_EN) | _BV(WM8731_IRQ_DAC_EN));
+    HPS_IRQ_unregisterHandler(ctx->irqID);
+    ctx->streaming = false;
+    //Free the ring buffers
+    MemPool_free(ctx->adcRing.buf);
+    ctx->adcRing.buf = NULL;
+    MemPool_free(ctx->dacRing.buf);
+    ctx->dacRing.buf = NULL;
+}
+
+//Finish with the shared descriptor of a DMA transfer
+// - Completes the device access and drops the reference taken when started.
+static void _WM8731_dmaRelease(WM8731Dma_t* dma, bool dac) {
+    if (!dma->buf) return;
+    BufDesc_completeDevice(dma->buf, dac ? BUF_DEVICE_READS : BUF_DEVICE_WRITES);
+    BufDesc_release(dma->buf);
+    dma->buf = NULL;
+}
+
+//Start a stage of a DMA transfer
+// - Stage 1 is the left FIFO, stage 2 is the right FIFO.
+// - Returns ERR_SKIPPED if both stages complete immediately.
+static HpsErr_t _WM8731_dmaStart(WM8731Ctx_t* ctx, WM8731Dma_t* dma, bool dac, unsigned int stage) {
+    HpsErr_t status;
+    for (; stage <= 2; stage++) {
+        uintptr_t fifo = (uintptr_t)&ctx->base[(stage == 1) ? WM8731_LEFTFIFO : WM8731_RIGHTFIFO];
+        uintptr_t buf = dma->bufs[stage - 1];
+        dma->xfer.readAddr  = dac ? buf  : fifo;
+        dma->xfer.writeAddr = dac ? fifo : buf;
+        dma->xfer.length    = dma->length;
+        dma->xfer.isLast    = true;
+        dma->xfer.index     = (dac ? 0 : 2) + (stage - 1);
+        dma->xfer.params    = dma->params;
+        dma->stage = stage;
+        //Shared descriptors are maintained once for the whole block
+        if (dma->buf) {
+            status = DMA_setupTransfer(dma->dma, &dma->xfer, true);
+        } else {
+            status = DmaBuffer_setupTransfer(dma->dma, &dma->xfer, true);
+        }
+        //If not completed immediately, we are done for now.
+        if (status != ERR_SKIPPED) {
+            if (ERR_IS_ERROR(status)) {
+                dma->stage = 0;
+                _WM8731_dmaRelease(dma, dac);
+            }
+            return status;
+        }
+    }
+    //Both stages completed immediately
+    dma->stage = 0;
+    _WM8731_dmaRelease(dma, dac);
+    return ERR_SKIPPED;
+}
+
+//Progress a DMA transfer
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+static HpsErr_t _WM8731_dmaProgress(WM8731Ctx_t* ctx, WM8731Dma_t* dma, bool dac) {
+    if (!dma->stage) return ERR_SUCCESS;
+    HpsErr_t status;
+    if (dma->buf) {
+        status = DMA_transferDone(dma->dma);
+    } else {
+        status = DmaBuffer_transferDone(dma->dma, &dma->xfer);
+    }
+    if (status == ERR_BUSY) return ERR_BUSY;
+    if (ERR_IS_ERROR(status) || (dma->stage == 2)) {
+        //All done (or failed)
+        dma->stage = 0;
+        _WM8731_dmaRelease(dma, dac);
+        return ERR_IS_ERROR(status) ? status : ERR_SUCCESS;
+    }
+    //Left FIFO done, move on to right
+    status = _WM8731_dmaStart(ctx, dma, dac, 2);
+    if (status == ERR_SKIPPED) return ERR_SUCCESS;
+    if (ERR_IS_ERROR(status)) return status;
+    return ERR_BUSY;
+}
+
+//Setup a DMA transfer for either direction
+// - desc is the shared descriptor holding left and right, or NULL for plain buffers.
+static HpsErr_t _WM8731_setupDma(WM8731Ctx_t* ctx, bool dac, const unsigned int* left, const unsigned int* right, unsigned int count, BufDesc_t* desc) {
+    if (!left || !right) return ERR_NULLPTR;
+    if (!count) return ERR_TOOSMALL;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check if we have the I2S interface
+    if (!ctx->base) return ERR_NOSUPPORT;
+    //Can't access FIFOs directly while streaming
+    if (ctx->streaming) return ERR_WRONGMODE;
+    //Must have a DMA controller, and not be running
+    WM8731Dma_t* dma = dac ? &ctx->dacDma : &ctx->adcDma;
+    if (!dma->dma) return ERR_NOSUPPORT;
+    status = _WM8731_dmaProgress(ctx, dma, dac);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check FIFO has enough space/samples for the whole block
+    unsigned int avail;
+    if (dac) {
+        WM8731_getFIFOSpace(ctx, &avail);
+        if (avail < count) return ERR_NOSPACE;
+    } else {
+        WM8731_getFIFOFill(ctx, &avail);
+        if (avail < count) return ERR_AGAIN;
+    }
+    //Hold a shared descriptor for the whole transfer
+    if (desc) {
+        if (!dac) desc->length = 2 * count * sizeof(unsigned int);
+        status = BufDesc_prepareDevice(desc, dac ? BUF_DEVICE_READS : BUF_DEVICE_WRITES);
+        if (ERR_IS_ERROR(status)) return status;
+        BufDesc_retain(desc);
+        dma->buf = desc;
+    }
+    //Start the transfer
+    dma->bufs[0] = (uintptr_t)left;
+    dma->bufs[1] = (uintptr_t)right;
+    dma->length  = count * sizeof(unsigned int);
+    return _WM8731_dmaStart(ctx, dma, dac, 1);
+}
 
 //Driver Cleanup
 static void _WM8731_cleanup(WM8731Ctx_t* ctx) {
+    if (ctx->stats.published) {
+        _WM8731_statsPublish(ctx, false);
+    }
+    if (ctx->adcDma.stage) {
+        DMA_abortTransfer(ctx->adcDma.dma, DMA_ABORT_FORCE);
+        _WM8731_dmaRelease(&ctx->adcDma, false);
+    }
+    if (ctx->dacDma.stage) {
+        DMA_abortTransfer(ctx->dacDma.dma, DMA_ABORT_FORCE);
+        _WM8731_dmaRelease(&ctx->dacDma, true);
+    }
+    if (ctx->streaming) {
+        _WM8731_stopStreaming(ctx);
+    }
     if (ctx->base) {
         // Assert FIFO resets
         ctx->base[WM8731_CONTROL] |= ((1<<WM8731_FIFO_RESET_ADC) | (1<<WM8731_FIFO_RESET_DAC));
     }
     if (ctx->i2c) {
-        // Power down the codec if we have an I2C device context
+        // Let any register sequence finish, then power down the codec if we have an I2C device context
+        while(ERR_IS_RETRY(_WM8731_seqService(ctx)));
         _WM8731_writeRegister(ctx, WM8731_REG_POWERCNTRL, 0x00); // Power down outputs
     }
 }
 
+//Codec initialisation sequence
+static const WM8731RegWrite_t _WM8731_initTable[] = {
+    {WM8731_REG_POWERCNTRL,    0x12}, //Power-up chip. Leave mic off as not used.
+    {WM8731_REG_LEFTINCNTRL,   0x17}, //+4.5dB Volume. Unmute.
+    {WM8731_REG_RIGHTINCNTRL,  0x17}, //+4.5dB Volume. Unmute.
+    {WM8731_REG_LEFTOUTCNTRL,  0x70}, //-24dB Volume. Unmute.
+    {WM8731_REG_RIGHTOUTCNTRL, 0x70}, //-24dB Volume. Unmute.
+    {WM8731_REG_ANLGPATHCNTRL, 0x12}, //Use Line In. Disable Bypass. Use DAC
+    {WM8731_REG_DGTLPATHCNTRL, 0x06}, //Enable High-Pass filter. 48kHz sample rate.
+    {WM8731_REG_DATAFMTCNTRL,  0x4E}, //I2S Mode, 24bit, Master Mode (do not change this!)
+    {WM8731_REG_SMPLINGCNTRL,  0x00}, //Normal Mode, 48kHz sample rate
+    {WM8731_REG_ACTIVECNTRL,   0x01}, //Enable Codec
+    {WM8731_REG_POWERCNTRL,    0x02}  //Power-up output.
+};
+
 //Initialise Audio Codec
 // - base is memory-mapped address of audio controller data interface
 //   - If base is NULL, provides access to the I2C configuration interface only.
 // - i2c is a generic I2C driver instance used to configure the controller.
 HpsErr_t WM8731_initialise( void* base, I2CCtx_t* i2c, WM8731Ctx_t** pCtx ) {
+    HpsErr_t status = WM8731_initialiseStart(base, i2c, pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Run the init steps until the sequence is written
+    do {
+        unsigned int delay = 0;
+        status = WM8731_initialiseStep(*pCtx, &delay);
+    } while (ERR_IS_RETRY(status));
+    if (ERR_IS_ERROR(status) && !WM8731_isInitialised(*pCtx)) return DriverContextInitFail(pCtx, status);
+    return status;
+}
+
+//Start initialising Audio Codec without waiting
+// - As WM8731_initialise(), but only starts the I2C initialisation sequence.
+//   The context is not initialised until WM8731_initialiseStep() returns ERR_SUCCESS.
+// - For use with Util/init_seq to power up several drivers at once.
+HpsErr_t WM8731_initialiseStart( void* base, I2CCtx_t* i2c, WM8731Ctx_t** pCtx ) {
     //Ensure user pointers valid
     if (!pointerIsAligned(base, sizeof(unsigned int))) return ERR_ALIGNMENT;
     if (!I2C_isInitialised(i2c)) return ERR_BADDEVICE;
@@ -118,29 +563,25 @@ HpsErr_t WM8731_initialise( void* base, I2CCtx_t* i2c, WM8731Ctx_t** pCtx ) {
     ctx->i2cAddr = WM8731_I2C_ADDRESS;
     // - For the time being this is hard-coded to 48kHz, but could be changed later.
     ctx->sampleRate = 48000;
+    _WM8731_statsInit(ctx);
     //Initialise the WM8731 codec over I2C. See Page 46 of datasheet.
-    status = _WM8731_writeRegister(ctx, WM8731_REG_POWERCNTRL,    0x12); //Power-up chip. Leave mic off as not used.
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_LEFTINCNTRL,   0x17); //+4.5dB Volume. Unmute.
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_RIGHTINCNTRL,  0x17); //+4.5dB Volume. Unmute.
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_LEFTOUTCNTRL,  0x70); //-24dB Volume. Unmute.
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_RIGHTOUTCNTRL, 0x70); //-24dB Volume. Unmute.
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_ANLGPATHCNTRL, 0x12); //Use Line In. Disable Bypass. Use DAC
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_DGTLPATHCNTRL, 0x06); //Enable High-Pass filter. 48kHz sample rate.
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_DATAFMTCNTRL,  0x4E); //I2S Mode, 24bit, Master Mode (do not change this!)
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_SMPLINGCNTRL,  0x00); //Normal Mode, 48kHz sample rate
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_ACTIVECNTRL,   0x01); //Enable Codec
-    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
-    status = _WM8731_writeRegister(ctx, WM8731_REG_POWERCNTRL,    0x02); //Power-up output.
+    //Register values are unknown until written, so nothing is skipped.
+    ctx->regCacheValid = 0;
+    status = _WM8731_seqBegin(ctx, _WM8731_initTable, sizeof(_WM8731_initTable)/sizeof(_WM8731_initTable[0]));
     if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    return ERR_SUCCESS;
+}
+
+//Make the next step of Audio Codec initialisation
+// - ctx must have been returned by WM8731_initialiseStart().
+// - Returns ERR_AGAIN while the I2C sequence is still being written. *delay
+//   is left as 0 to be called again as soon as possible.
+// - Returns ERR_SUCCESS once initialised and the FIFOs cleared.
+HpsErr_t WM8731_initialiseStep( WM8731Ctx_t* ctx, unsigned int* delay ) {
+    if (!ctx || !delay) return ERR_NULLPTR;
+    if (DriverContextCheckInit(ctx)) return ERR_SUCCESS;
+    HpsErr_t status = _WM8731_seqService(ctx);
+    if (ERR_IS_RETRY(status) || ERR_IS_ERROR(status)) return status;
     //Initialised
     DriverContextSetInit(ctx);
     return WM8731_clearFIFO(ctx,true,true);
@@ -167,16 +608,50 @@ HpsErr_t WM8731_getSampleRate( WM8731Ctx_t* ctx, unsigned int* sampleRate ) {
 //Configure an I2C register
 // - Allows changing settings for codec (e.g. volumen control, filtering, etc)
 // - Refer to Page 46 of WM8731 codec datasheet.
+// - Skipped if the register already holds the value.
+// - Returns ERR_BUSY if a register sequence is running.
 HpsErr_t WM8731_writeRegister( WM8731Ctx_t* ctx, WM8731RegAddress regAddr, unsigned int regVal ) {
     //Can't modify format register as this is fixed in DPGA hardware
     if (regAddr == WM8731_REG_DATAFMTCNTRL) return ERR_WRITEPROT;
+    if ((unsigned int)regAddr >= WM8731_REG_COUNT) return ERR_OUTRANGE;
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    if (ctx->seq.table) return ERR_BUSY;
     //Modify register
     return _WM8731_writeRegister(ctx, regAddr, regVal);
 }
 
+//Start a sequence of register writes
+// - table is an array of count register writes, made in order. It must remain
+//   valid until WM8731_sequenceDone() no longer returns ERR_AGAIN.
+// - Writes of the value a register already holds are skipped.
+// - Returns ERR_AGAIN if started, or ERR_SUCCESS if there was nothing to write.
+// - Returns ERR_BUSY if a sequence is already running.
+HpsErr_t WM8731_writeSequence( WM8731Ctx_t* ctx, const WM8731RegWrite_t* table, unsigned int count ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!table && count) return ERR_NULLPTR;
+    if (ctx->seq.table) return ERR_BUSY;
+    //Check the whole table before writing anything
+    for (unsigned int idx = 0; idx < count; idx++) {
+        if (table[idx].reg == WM8731_REG_DATAFMTCNTRL) return ERR_WRITEPROT;
+        if ((unsigned int)table[idx].reg >= WM8731_REG_COUNT) return ERR_OUTRANGE;
+    }
+    return _WM8731_seqBegin(ctx, table, count);
+}
+
+//Check if a register sequence is done
+// - Starts the next write once the previous is complete, so call periodically.
+// - Returns ERR_AGAIN while running, then the result of the sequence.
+HpsErr_t WM8731_sequenceDone( WM8731Ctx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return _WM8731_seqService(ctx);
+}
+
 //Clears FIFOs
 // - returns 0 if successful
 HpsErr_t WM8731_clearFIFO( WM8731Ctx_t* ctx, bool adc, bool dac) {
@@ -231,6 +706,10 @@ HpsErr_t WM8731_writeSample( WM8731Ctx_t* ctx, unsigned int left, unsigned int r
     if (ERR_IS_ERROR(status)) return status;
     //Check if we have the I2S interface
     if (!ctx->base) return ERR_NOSUPPORT;
+    //Can't access FIFOs directly while streaming
+    if (ctx->streaming) return ERR_WRONGMODE;
+    //Can't access FIFOs directly while DMA is running
+    if (ctx->dacDma.stage) return ERR_BUSY;
 	//Write the sample
     ctx->base[WM8731_LEFTFIFO] = left;
     ctx->base[WM8731_RIGHTFIFO] = right;
@@ -247,6 +726,10 @@ HpsErr_t WM8731_readSample( WM8731Ctx_t* ctx, unsigned int* left, unsigned int*
     if (ERR_IS_ERROR(status)) return status;
     //Check if we have the I2S interface
     if (!ctx->base) return ERR_NOSUPPORT;
+    //Can't access FIFOs directly while streaming
+    if (ctx->streaming) return ERR_WRONGMODE;
+    //Can't access FIFOs directly while DMA is running
+    if (ctx->adcDma.stage) return ERR_BUSY;
 	//Write the sample
     *left = ctx->base[WM8731_LEFTFIFO];
     *right = ctx->base[WM8731_RIGHTFIFO];
@@ -254,3 +737,503 @@ HpsErr_t WM8731_readSample( WM8731Ctx_t* ctx, unsigned int* left, unsigned int*
 
 }
 
+//Check a block transfer can be made, and get the number of frames to move
+// - Reads the FIFO level register once. Returns the frame count, or an error code.
+static HpsErr_t _WM8731_framesAvailable( WM8731Ctx_t* ctx, const void* frames, unsigned int count, bool dac ) {
+    if (!frames) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check if we have the I2S interface
+    if (!ctx->base) return ERR_NOSUPPORT;
+    //Can't access FIFOs directly while streaming
+    if (ctx->streaming) return ERR_WRONGMODE;
+    //Can't access FIFOs directly while DMA is running
+    if (dac ? ctx->dacDma.stage : ctx->adcDma.stage) return ERR_BUSY;
+    //Limit to the space/fill of the emptiest/fullest channel
+    unsigned int level = ctx->base[WM8731_FIFOSPACE];
+    unsigned int avail;
+    if (dac) {
+        avail = min(MaskExtract(level, WM8731_FIFO_MASK, WM8731_FIFO_WSRC), MaskExtract(level, WM8731_FIFO_MASK, WM8731_FIFO_WSLC));
+    } else {
+        avail = min(MaskExtract(level, WM8731_FIFO_MASK, WM8731_FIFO_RARC), MaskExtract(level, WM8731_FIFO_MASK, WM8731_FIFO_RALC));
+    }
+    return (HpsErr_t)min(avail, count);
+}
+
+//Write a block of interleaved 16-bit frames to the FIFO
+// - frames holds count stereo frames as left, right, left, right, ...
+// - Each sample is scaled up to the 24-bit FIFO width.
+// - The FIFO space is read once, and up to that many frames are written.
+// - Returns the number of frames written (may be 0), or an error code.
+HOT_CODE HpsErr_t WM8731_writeFrames16( WM8731Ctx_t* ctx, const int16_t* frames, unsigned int count ) {
+    HpsErr_t moved = _WM8731_framesAvailable(ctx, frames, count, true);
+    if (ERR_IS_ERROR(moved)) return moved;
+    volatile unsigned int* base = ctx->base;
+    const int16_t* end = frames + 2 * (unsigned int)moved;
+    while (frames != end) {
+        base[WM8731_LEFTFIFO ] = (unsigned int)(int32_t)frames[0] << 8;
+        base[WM8731_RIGHTFIFO] = (unsigned int)(int32_t)frames[1] << 8;
+        frames += 2;
+    }
+    return moved;
+}
+
+//Write a block of interleaved 32-bit frames to the FIFO
+// - frames holds count stereo frames as left, right, left, right, ...
+// - Each sample is a 24-bit value in the lower bits.
+// - The FIFO space is read once, and up to that many frames are written.
+// - Returns the number of frames written (may be 0), or an error code.
+HOT_CODE HpsErr_t WM8731_writeFrames32( WM8731Ctx_t* ctx, const int32_t* frames, unsigned int count ) {
+    HpsErr_t moved = _WM8731_framesAvailable(ctx, frames, count, true);
+    if (ERR_IS_ERROR(moved)) return moved;
+    volatile unsigned int* base = ctx->base;
+    const int32_t* end = frames + 2 * (unsigned int)moved;
+    while (frames != end) {
+        base[WM8731_LEFTFIFO ] = (unsigned int)frames[0];
+        base[WM8731_RIGHTFIFO] = (unsigned int)frames[1];
+        frames += 2;
+    }
+    return moved;
+}
+
+//Read a block of interleaved 16-bit frames from the FIFO
+// - frames has room for count stereo frames as left, right, left, right, ...
+// - Each sample is the upper 16 bits of the 24-bit FIFO sample.
+// - The FIFO fill is read once, and up to that many frames are read.
+// - Returns the number of frames read (may be 0), or an error code.
+HOT_CODE HpsErr_t WM8731_readFrames16( WM8731Ctx_t* ctx, int16_t* frames, unsigned int count ) {
+    HpsErr_t moved = _WM8731_framesAvailable(ctx, frames, count, false);
+    if (ERR_IS_ERROR(moved)) return moved;
+    volatile unsigned int* base = ctx->base;
+    int16_t* end = frames + 2 * (unsigned int)moved;
+    while (frames != end) {
+        frames[0] = (int16_t)(base[WM8731_LEFTFIFO ] >> 8);
+        frames[1] = (int16_t)(base[WM8731_RIGHTFIFO] >> 8);
+        frames += 2;
+    }
+    return moved;
+}
+
+//Read a block of interleaved 32-bit frames from the FIFO
+// - frames has room for count stereo frames as left, right, left, right, ...
+// - Each sample is the 24-bit FIFO sample sign extended to 32 bits.
+// - The FIFO fill is read once, and up to that many frames are read.
+// - Returns the number of frames read (may be 0), or an error code.
+HOT_CODE HpsErr_t WM8731_readFrames32( WM8731Ctx_t* ctx, int32_t* frames, unsigned int count ) {
+    HpsErr_t moved = _WM8731_framesAvailable(ctx, frames, count, false);
+    if (ERR_IS_ERROR(moved)) return moved;
+    volatile unsigned int* base = ctx->base;
+    int32_t* end = frames + 2 * (unsigned int)moved;
+    while (frames != end) {
+        frames[0] = ((int32_t)(base[WM8731_LEFTFIFO ] << 8)) >> 8;
+        frames[1] = ((int32_t)(base[WM8731_RIGHTFIFO] << 8)) >> 8;
+        frames += 2;
+    }
+    return moved;
+}
+
+//Start interrupt driven streaming
+// - irqID is the interrupt ID of the audio controller (e.g. IRQ_LSC_AUDIO).
+// - blockSize is the number of stereo samples in each block.
+// - blockCount is the number of blocks in each ring buffer.
+// - HPS_IRQ driver must be initialised first.
+// - Returns ERR_BUSY if already streaming.
+HpsErr_t WM8731_startStreaming( WM8731Ctx_t* ctx, HPSIRQSource irqID, unsigned int blockSize, unsigned int blockCount ) {
+    if (!blockSize || !blockCount) return ERR_TOOSMALL;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check if we have the I2S interface
+    if (!ctx->base) return ERR_NOSUPPORT;
+    if (ctx->streaming) return ERR_BUSY;
+    //FIFOs can't be shared with DMA transfers
+    if (ctx->adcDma.stage || ctx->dacDma.stage) return ERR_BUSY;
+    //Allocate the rings
+    unsigned int size = blockSize * blockCount;
+    ctx->adcRing = (WM8731Ring_t){ .buf = MemPool_malloc(size * sizeof(WM8731Sample_t)), .size = size, .head = 0, .tail = 0 };
+    ctx->dacRing = (WM8731Ring_t){ .buf = MemPool_malloc(size * sizeof(WM8731Sample_t)), .size = size, .head = 0, .tail = 0 };
+    if (!ctx->adcRing.buf || !ctx->dacRing.buf) {
+        MemPool_free(ctx->adcRing.buf);
+        ctx->adcRing.buf = NULL;
+        MemPool_free(ctx->dacRing.buf);
+        ctx->dacRing.buf = NULL;
+        return ERR_ALLOCFAIL;
+    }
+    ctx->blockSize = blockSize;
+    ctx->stats.deadline = 0;
+    ctx->stats.inBlock = false;
+    _WM8731_statsClear(ctx);
+    //Register the handler
+    ctx->irqID = irqID;
+    status = HPS_IRQ_registerHandler(irqID, &_WM8731_streamIsr, ctx);
+    if (ERR_IS_ERROR(status)) {
+        MemPool_free(ctx->adcRing.buf);
+        ctx->adcRing.buf = NULL;
+        MemPool_free(ctx->dacRing.buf);
+        ctx->dacRing.buf = NULL;
+        return status;
+    }
+    ctx->streaming = true;
+    //Start from empty FIFOs, and enable ADC interrupt. DAC interrupt is enabled once there is data.
+    WM8731_clearFIFO(ctx, true, true);
+    ctx->base[WM8731_CONTROL] |= _BV(WM8731_IRQ_ADC_EN);
+    return ERR_SUCCESS;
+}
+
+//Stop interrupt driven streaming
+// - Unregisters the interrupt handler and frees the ring buffers.
+// - Returns ERR_SKIPPED if not streaming.
+HpsErr_t WM8731_stopStreaming( WM8731Ctx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->streaming) return ERR_SKIPPED;
+    _WM8731_stopStreaming(ctx);
+    return ERR_SUCCESS;
+}
+
+//Submit a block of samples for output
+// - block is an array of blockSize samples, which is copied into the DAC ring.
+// - Returns ERR_NOSPACE if the ring does not have space for the block.
+HpsErr_t WM8731_submitBlock( WM8731Ctx_t* ctx, const WM8731Sample_t* block ) {
+    if (!block) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->streaming) return ERR_WRONGMODE;
+    //Copy in the block if there is space
+    if (_WM8731_ringSpace(&ctx->dacRing) < ctx->blockSize) return ERR_NOSPACE;
+    _WM8731_ringWrite(&ctx->dacRing, block, ctx->blockSize);
+    //Ensure DAC interrupt is enabled. IRQs disabled as the handler also modifies the control register.
+    if (!(ctx->base[WM8731_CONTROL] & _BV(WM8731_IRQ_DAC_EN))) {
+        HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+        ctx->base[WM8731_CONTROL] |= _BV(WM8731_IRQ_DAC_EN);
+        HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    }
+    return ERR_SUCCESS;
+}
+
+//Submit 16-bit frames for output
+// - frames holds count stereo frames as left, right, left, right, ...
+//   Each sample is scaled to the 24-bit FIFO range and queued in the DAC ring.
+// - As many frames as fit are queued, whole blocks not being required.
+// - Returns the number of frames queued (may be 0), or an error code.
+HpsErr_t WM8731_submitFrames16( WM8731Ctx_t* ctx, const int16_t* frames, unsigned int count ) {
+    if (!frames) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->streaming) return ERR_WRONGMODE;
+    WM8731Ring_t* ring = &ctx->dacRing;
+    unsigned int space = _WM8731_ringSpace(ring);
+    if (count > space) count = space;
+    if (!count) return 0;
+    //Convert straight into the ring
+    unsigned int idx = _WM8731_ringIndex(ring, ring->head);
+    for (unsigned int cnt = 0; cnt < count; cnt++) {
+        ring->buf[idx].left  = (unsigned int)(int32_t)frames[0] << 8;
+        ring->buf[idx].right = (unsigned int)(int32_t)frames[1] << 8;
+        frames += 2;
+        if (++idx == ring->size) idx = 0;
+    }
+    //Ensure data is written before the consumer can see it
+    __DMB();
+    ring->head = _WM8731_ringAdvance(ring, ring->head, count);
+    //Ensure DAC interrupt is enabled. IRQs disabled as the handler also modifies the control register.
+    if (!(ctx->base[WM8731_CONTROL] & _BV(WM8731_IRQ_DAC_EN))) {
+        HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+        ctx->base[WM8731_CONTROL] |= _BV(WM8731_IRQ_DAC_EN);
+        HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    }
+    return (HpsErr_t)count;
+}
+
+//Get the space in the DAC ring
+// - Returns the number of stereo samples which can be submitted, or an
+//   error code. Returns ERR_WRONGMODE if not streaming.
+HpsErr_t WM8731_getStreamSpace( WM8731Ctx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->streaming) return ERR_WRONGMODE;
+    return (HpsErr_t)_WM8731_ringSpace(&ctx->dacRing);
+}
+
+//Acquire a block of input samples
+// - block is an array of blockSize samples, which is filled from the ADC ring.
+// - Returns ERR_AGAIN if a complete block is not yet available.
+HpsErr_t WM8731_acquireBlock( WM8731Ctx_t* ctx, WM8731Sample_t* block ) {
+    if (!block) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->streaming) return ERR_WRONGMODE;
+    //Copy out a block if there is one
+    if (_WM8731_ringFill(&ctx->adcRing) < ctx->blockSize) return ERR_AGAIN;
+    _WM8731_ringRead(&ctx->adcRing, block, ctx->blockSize);
+    return ERR_SUCCESS;
+}
+
+//Get streaming error counts
+// - underruns is the number of times the DAC ring has run dry.
+// - overruns is the number of input samples dropped due to the ADC ring being full.
+// - Either pointer may be NULL if not required.
+// - If clear is true, the counts are reset.
+HpsErr_t WM8731_getStreamErrors( WM8731Ctx_t* ctx, unsigned int* underruns, unsigned int* overruns, bool clear ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Read and optionally clear counts. IRQs disabled as the handler also modifies them.
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (underruns) *underruns = ctx->underruns;
+    if (overruns) *overruns = ctx->overruns;
+    if (clear) {
+        ctx->underruns = 0;
+        ctx->overruns = 0;
+    }
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Add or remove the streaming statistics in the Util/profile report
+// - publish adds the statistics if true, or removes them if false.
+// - Statistics are kept whether or not they are published.
+// - Returns ERR_SKIPPED if already in the requested state.
+HpsErr_t WM8731_publishStats( WM8731Ctx_t* ctx, bool publish ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->stats.published == publish) return ERR_SKIPPED;
+    _WM8731_statsPublish(ctx, publish);
+    return ERR_SUCCESS;
+}
+
+//Clear the streaming statistics
+// - Clears the histograms, deadline misses, and the underrun/overrun counts.
+HpsErr_t WM8731_clearStats( WM8731Ctx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //IRQs disabled as the handler also modifies them.
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    _WM8731_statsClear(ctx);
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Mark the start of processing a block
+// - Call immediately before acquiring (or generating) each block.
+// - Returns ERR_WRONGMODE if not streaming.
+// - Returns ERR_NOINIT if profiling is not initialised, as the global timer is used.
+HpsErr_t WM8731_blockBegin( WM8731Ctx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->streaming) return ERR_WRONGMODE;
+    if (!Profile_isInitialised()) return ERR_NOINIT;
+    _WM8731_statsDeadline(ctx);
+    ctx->stats.inBlock = true;
+    ctx->stats.blockStart = Profile_timestamp();
+    return ERR_SUCCESS;
+}
+
+//Mark the end of processing a block
+// - Call once the block has been submitted, to record the time since
+//   WM8731_blockBegin() as a percentage of the block period.
+// - load is the percentage for this block, or NULL if not required.
+// - Returns ERR_SKIPPED if WM8731_blockBegin() was not called first.
+HpsErr_t WM8731_blockEnd( WM8731Ctx_t* ctx, unsigned int* load ) {
+    uint64_t end = Profile_timestamp();
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    WM8731Stats_t* stats = &ctx->stats;
+    if (!stats->inBlock) return ERR_SKIPPED;
+    stats->inBlock = false;
+    uint64_t elapsed = end - stats->blockStart;
+    unsigned int percent = (unsigned int)((elapsed * 100) / stats->deadline);
+    Profile_histogramAdd(&stats->blockLoad, percent);
+    if (elapsed > stats->deadline) stats->deadlineMisses++;
+    if (load) *load = percent;
+    return ERR_SUCCESS;
+}
+
+//Measure the round trip latency with a loopback cable
+// - The line out must be connected to the line in, and the input
+//   otherwise silent.
+// - Each block acquired is matched by one submitted, starting with an
+//   impulse, so the DAC ring keeps its current fill. The result is the
+//   latency seen by a block processing loop with the same buffering.
+// - threshold is the input level (positive 24-bit sample) which counts
+//   as the impulse arriving.
+// - maxBlocks is the number of blocks to wait for the impulse.
+// - latency is the number of samples from the start of the input block
+//   the impulse was submitted in reply to, until the impulse is acquired.
+//   For a loop which passes input straight to output, this is the delay
+//   from a sample arriving to its echo arriving.
+// - Blocks the caller until complete. Any other use of the rings must
+//   stop while measuring.
+// - Returns ERR_NOTFOUND if the impulse was not seen, or ERR_TIMEOUT if
+//   blocks stopped arriving.
+// - Returns ERR_NOINIT if profiling is not initialised, as the global timer is used.
+HpsErr_t WM8731_measureLatency( WM8731Ctx_t* ctx, unsigned int threshold, unsigned int maxBlocks, unsigned int* latency ) {
+    if (!latency) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->streaming) return ERR_WRONGMODE;
+    if (!Profile_isInitialised()) return ERR_NOINIT;
+    if (!maxBlocks) return ERR_TOOSMALL;
+    unsigned int blockSize = ctx->blockSize;
+    WM8731Sample_t* block = MemPool_malloc(blockSize * sizeof(WM8731Sample_t));
+    if (!block) return ERR_ALLOCFAIL;
+    uint64_t timeout = (uint64_t)_WM8731_statsDeadline(ctx) * WM8731_LATENCY_TIMEOUT;
+    //Block 0 is answered with the pulse, and later blocks with silence
+    status = ERR_NOTFOUND;
+    for (unsigned int blk = 0; blk <= maxBlocks; blk++) {
+        HpsErr_t xferStatus = _WM8731_waitAcquire(ctx, block, timeout);
+        if (ERR_IS_ERROR(xferStatus)) {
+            status = xferStatus;
+            break;
+        }
+        //Look for the start of the pulse, either polarity
+        if (blk) {
+            unsigned int idx;
+            for (idx = 0; idx < blockSize; idx++) {
+                int32_t left  = ((int32_t)(block[idx].left  << 8)) >> 8;
+                int32_t right = ((int32_t)(block[idx].right << 8)) >> 8;
+                if ((unsigned int)abs(left) >= threshold || (unsigned int)abs(right) >= threshold) break;
+            }
+            if (idx < blockSize) {
+                *latency = blk * blockSize + idx;
+                status = ERR_SUCCESS;
+                break;
+            }
+        }
+        //Reply, keeping the DAC ring fill the same
+        memset(block, 0, blockSize * sizeof(WM8731Sample_t));
+        if (!blk) {
+            for (unsigned int idx = 0; idx < min(blockSize, WM8731_LATENCY_PULSE_LENGTH); idx++) {
+                block[idx].left  = WM8731_LATENCY_PULSE_LEVEL;
+                block[idx].right = WM8731_LATENCY_PULSE_LEVEL;
+            }
+        }
+        xferStatus = _WM8731_waitSubmit(ctx, block, timeout);
+        if (ERR_IS_ERROR(xferStatus)) {
+            status = xferStatus;
+            break;
+        }
+    }
+    MemPool_free(block);
+    return status;
+}
+
+//Assign a DMA controller for FIFO transfers
+// - dac selects whether this is for the DAC (true) or ADC (false) direction.
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transfer is running in this direction.
+HpsErr_t WM8731_setDma( WM8731Ctx_t* ctx, bool dac, DmaCtx_t* dma, void* dmaParams ) {
+    if (dma && !DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check if we have the I2S interface
+    if (!ctx->base) return ERR_NOSUPPORT;
+    //Can't change while running
+    WM8731Dma_t* dmaState = dac ? &ctx->dacDma : &ctx->adcDma;
+    status = _WM8731_dmaProgress(ctx, dmaState, dac);
+    if (ERR_IS_ERROR(status)) return status;
+    dmaState->dma = dma;
+    dmaState->params = dmaParams;
+    return ERR_SUCCESS;
+}
+
+//Write a block of samples to the DAC FIFOs using DMA
+// - left and right are arrays of count samples.
+// - Buffers must remain valid until WM8731_dmaDone() returns success.
+// - Returns ERR_NOSPACE if there is not enough space in the FIFOs.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous DAC transfer is still running.
+HpsErr_t WM8731_writeBlockDma( WM8731Ctx_t* ctx, const unsigned int* left, const unsigned int* right, unsigned int count ) {
+    return _WM8731_setupDma(ctx, true, left, right, count, NULL);
+}
+
+//Read a block of samples from the ADC FIFOs using DMA
+// - left and right are arrays of count samples.
+// - Buffers must not be accessed until WM8731_dmaDone() returns success.
+// - Returns ERR_AGAIN if there are not yet enough samples in the FIFOs.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous ADC transfer is still running.
+HpsErr_t WM8731_readBlockDma( WM8731Ctx_t* ctx, unsigned int* left, unsigned int* right, unsigned int count ) {
+    return _WM8731_setupDma(ctx, false, left, right, count, NULL);
+}
+
+//Write a shared block of samples to the DAC FIFOs using DMA
+// - block holds count left samples followed by count right samples.
+// - A reference is held until the transfer is done.
+// - Returns ERR_TOOSMALL if block holds fewer than 2*count samples.
+// - Otherwise as WM8731_writeBlockDma().
+HpsErr_t WM8731_writeBlockDmaBuf( WM8731Ctx_t* ctx, BufDesc_t* block, unsigned int count ) {
+    if (!block || !block->data) return ERR_NULLPTR;
+    if (block->length < 2 * count * sizeof(unsigned int)) return ERR_TOOSMALL;
+    const unsigned int* samples = (const unsigned int*)block->data;
+    return _WM8731_setupDma(ctx, true, samples, samples + count, count, block);
+}
+
+//Read a shared block of samples from the ADC FIFOs using DMA
+// - block receives count left samples followed by count right samples,
+//   and its length is set to match. A reference is held until the
+//   transfer is done.
+// - Returns ERR_TOOBIG if block can't hold 2*count samples.
+// - Otherwise as WM8731_readBlockDma().
+HpsErr_t WM8731_readBlockDmaBuf( WM8731Ctx_t* ctx, BufDesc_t* block, unsigned int count ) {
+    if (!block || !block->data) return ERR_NULLPTR;
+    if (block->size < 2 * count * sizeof(unsigned int)) return ERR_TOOBIG;
+    const unsigned int* samples = (const unsigned int*)block->data;
+    return _WM8731_setupDma(ctx, false, samples, samples + count, count, block);
+}
+
+//Check if a DMA transfer is done
+// - dac selects whether to check the DAC (true) or ADC (false) direction.
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+HpsErr_t WM8731_dmaDone( WM8731Ctx_t* ctx, bool dac ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check progress
+    return _WM8731_dmaProgress(ctx, dac ? &ctx->dacDma : &ctx->adcDma, dac);
+}
+
+//Soft_DMAController copy function for the FIFOs
+// - Reads from or writes to the fixed FIFO address, depending on which
+//   of src or dest is a FIFO. ctx must be the WM8731 context.
+// - Compatible with SoftDmaMemcpyFunc_t.
+void* WM8731_softDmaCopy( void* dest, void* src, size_t len, void* ctx ) {
+    WM8731Ctx_t* audio = (WM8731Ctx_t*)ctx;
+    if (!audio || !audio->base) return NULL;
+    volatile unsigned int* left  = &audio->base[WM8731_LEFTFIFO];
+    volatile unsigned int* right = &audio->base[WM8731_RIGHTFIFO];
+    size_t cnt = len / sizeof(unsigned int);
+    if ((dest == left) || (dest == right)) {
+        //Writing to a FIFO
+        volatile unsigned int* fifo = (volatile unsigned int*)dest;
+        const unsigned int* samples = (const unsigned int*)src;
+        while (cnt--) {
+            *fifo = *samples++;
+        }
+    } else if ((src == left) || (src == right)) {
+        //Reading from a FIFO
+        volatile unsigned int* fifo = (volatile unsigned int*)src;
+        unsigned int* samples = (unsigned int*)dest;
+        while (cnt--) {
+            *samples++ = *fifo;
+        }
+    } else {
+        //Neither is a FIFO, so normal copy
+        memcpy(dest, src, len);
+    }
+    return dest;
+}
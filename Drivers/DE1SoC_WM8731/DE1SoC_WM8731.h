@@ -26,6 +26,130 @@
  * changing registers in the audio codec, e.g. to configure the
  * volume or filtering settings.
  * 
+ * Register Sequences
+ * ------------------
+ * 
+ * A table of register writes can be made without waiting for the
+ * I2C bus, e.g. for volume ramps or switching settings while audio
+ * is running:
+ * 
+ *    static const WM8731RegWrite_t mute[] = {
+ *        {WM8731_REG_LEFTOUTCNTRL,  0x30},
+ *        {WM8731_REG_RIGHTOUTCNTRL, 0x30}
+ *    };
+ *    WM8731_writeSequence(audio, mute, 2);
+ *    ... 
+ *    if (WM8731_sequenceDone(audio) != ERR_AGAIN) ...
+ * 
+ * Each write is started without waiting, and WM8731_sequenceDone()
+ * moves on to the next once the previous has finished, so it should
+ * be called periodically (e.g. once per audio block) until it no
+ * longer returns ERR_AGAIN. The table must remain valid until then.
+ * 
+ * A copy of each register value written is kept, and writes of the
+ * value a register already holds are skipped, both for sequences and
+ * WM8731_writeRegister().
+ * 
+ * Streaming Mode
+ * --------------
+ * 
+ * As an alternative to polling the FIFOs, an interrupt driven
+ * streaming mode is available. Calling WM8731_startStreaming()
+ * registers an interrupt handler with the HPS_IRQ driver (which
+ * must already be initialised) and allocates a pair of ring buffers,
+ * one for each direction.
+ * 
+ * The interrupt handler moves samples between the rings and the
+ * FIFOs in bursts whenever the ADC FIFO is filling up or the DAC
+ * FIFO is emptying. The application then works in blocks:
+ * 
+ *    WM8731Sample_t block[BLOCK_SIZE];
+ *    if (ERR_IS_SUCCESS(WM8731_acquireBlock(audio, block))) {
+ *        ... process block ...
+ *        WM8731_submitBlock(audio, block);
+ *    }
+ * 
+ * The rings are single-producer/single-consumer, so the APIs must
+ * only be called from one (non-interrupt) context. While streaming,
+ * the polling sample read/write APIs return ERR_WRONGMODE.
+ * 
+ * If the DAC ring runs dry, the DAC interrupt is disabled until the
+ * next block is submitted. If the ADC ring is full, incoming samples
+ * are dropped. Both events are counted, see WM8731_getStreamErrors().
+ * 
+ * Streaming Statistics
+ * --------------------
+ * 
+ * To help choose the block size and count, the streaming layer keeps
+ * histograms of the ADC FIFO fill and DAC FIFO space seen by each
+ * interrupt. Either creeping up towards the FIFO depth means the
+ * interrupt is being serviced too late to avoid losing samples.
+ * 
+ * The time the application takes to process each block can also be
+ * measured against the block period (blockSize / sampleRate), which is
+ * the deadline for keeping up with the codec:
+ * 
+ *    WM8731_blockBegin(audio);
+ *    ... acquire, process and submit block ...
+ *    WM8731_blockEnd(audio, NULL);
+ * 
+ * The load is recorded as a percentage of the deadline, with the last
+ * bin of the histogram counting blocks that missed it. The spread of
+ * the histogram is the jitter in processing time.
+ * 
+ * WM8731_publishStats() adds the histograms, the underrun/overrun
+ * counts and the deadline misses to the Util/profile report, which
+ * prints them with Profile_report(). Block timing uses the global
+ * timer, so profiling must be initialised (Profile_initialise()).
+ * 
+ * With the line out looped back to the line in by a cable, the round
+ * trip latency through the rings, FIFOs and codec can be measured with
+ * WM8731_measureLatency().
+ * 
+ * Block Sample Transfers
+ * ----------------------
+ * 
+ * When polling, blocks of interleaved frames (left, right, left, ...)
+ * can be moved with one call, which reads the FIFO level once and then
+ * moves as many frames as will fit in a single burst:
+ * 
+ *    int16_t frames[2*64];
+ *    int moved = WM8731_writeFrames16(audio, frames, 64);
+ * 
+ * The return value is the number of frames moved, which may be fewer
+ * than requested (including zero) if the FIFO is full/empty, so the
+ * remainder should be passed again later. 16-bit frames are scaled to
+ * and from the 24-bit codec samples, 32-bit frames hold the 24-bit
+ * samples sign extended.
+ * 
+ * DMA Transfers
+ * -------------
+ * 
+ * Blocks of samples can also be moved between memory and the FIFOs
+ * by a DMA controller, leaving the CPU free while the copy runs.
+ * Samples are stored in separate left and right buffers, which are
+ * transferred to/from the fixed left and right FIFO addresses in turn.
+ * Assign a DMA controller to each direction with WM8731_setDma():
+ * 
+ *  - For HPS_DMAController, pass dmaParams with transferWidth set to
+ *    HPS_DMA_BURSTSIZE_4BYTE, and for the DAC destType set to
+ *    HPS_DMA_DESTINATION_REGISTER, or for the ADC srcType set to
+ *    HPS_DMA_SOURCE_REGISTER.
+ *  - For Soft_DMAController, initialise with SOFT_DMA_WORDSIZE_32BIT and
+ *    WM8731_softDmaCopy as the copy function with the WM8731 context
+ *    as copyFuncCtx, and pass dmaParams as NULL.
+ * 
+ * Then call WM8731_writeBlockDma()/WM8731_readBlockDma() to start a
+ * transfer, and WM8731_dmaDone() to check for completion. Cache
+ * maintenance is handled automatically (Util/dma_buffer.h).
+ * 
+ * WM8731_writeBlockDmaBuf()/WM8731_readBlockDmaBuf() take a shared
+ * buffer descriptor (Util/buf_desc.h) holding count left samples
+ * followed by count right samples, so a block can be passed on from
+ * or to another driver (e.g. read from SD card) without copying. A
+ * reference is held until the transfer is done, and maintenance is
+ * only performed where the descriptor's cache state needs it.
+ * 
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -33,6 +157,16 @@
  *
  * Date       | Changes
  * -----------+-------------------------------
+ * 14/10/2026 | Add partial 16-bit frame submission and DAC ring space
+ * 14/10/2026 | Add shared buffer descriptor DMA transfers
+ * 14/10/2026 | Add interleaved block sample APIs
+ * 14/10/2026 | Add streaming statistics and latency measurement
+ * 14/10/2026 | Add non-blocking initialisation steps
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Add unchecked inline sample accessors
+ * 14/10/2026 | Add register write sequences and register cache
+ * 14/10/2026 | Add DMA FIFO transfers
+ * 14/10/2026 | Add interrupt driven streaming mode
  * 21/11/2024 | Use generic I2C interface
  * 10/02/2024 | Add new API for FIFO access
  * 31/01/2024 | Update to new driver contexts
@@ -48,6 +182,14 @@
 #include <stdint.h>
 #include "Util/driver_ctx.h"
 #include "Util/driver_i2c.h"
+#include "Util/driver_dma.h"
+#include "Util/buf_desc.h"
+#include "Util/profile.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+
+//WM8731 ARM FIFO Address Offsets
+#define WM8731_LEFTFIFO   (0x8/sizeof(unsigned int))
+#define WM8731_RIGHTFIFO  (0xC/sizeof(unsigned int))
 
 //I2C Register Addresses
 typedef enum {
@@ -63,6 +205,71 @@ typedef enum {
     WM8731_REG_ACTIVECNTRL   = (0x12/sizeof(unsigned short))
 } WM8731RegAddress;
 
+//Number of registers
+#define WM8731_REG_COUNT (WM8731_REG_ACTIVECNTRL + 1)
+
+// Register write, for sequences
+typedef struct {
+    WM8731RegAddress reg;
+    unsigned short   value;
+} WM8731RegWrite_t;
+
+// Stereo sample
+typedef struct {
+    unsigned int left;
+    unsigned int right;
+} WM8731Sample_t;
+
+// Single-producer/single-consumer sample ring
+// - head and tail count from 0 to (2*size)-1 so that a
+//   full ring can be distinguished from an empty one.
+typedef struct {
+    WM8731Sample_t* buf;
+    unsigned int size;
+    volatile unsigned int head; // Only written by producer
+    volatile unsigned int tail; // Only written by consumer
+} WM8731Ring_t;
+
+//Number and width of bins in the FIFO level histograms
+#ifndef WM8731_STATS_FIFO_BINS
+#define WM8731_STATS_FIFO_BINS  16
+#endif
+#define WM8731_STATS_FIFO_WIDTH 16
+
+//Number of 10% bins in the block load histogram. The last bin counts
+//missed deadlines along with everything above 100%.
+#define WM8731_STATS_LOAD_BINS  11
+#define WM8731_STATS_LOAD_WIDTH 10
+
+// Streaming statistics
+typedef struct {
+    ProfileHistogram_t adcFill;     // ADC FIFO fill at each interrupt
+    ProfileHistogram_t dacSpace;    // DAC FIFO space at each interrupt
+    ProfileHistogram_t blockLoad;   // Block processing time, % of block period
+    ProfileCounter_t underrunCount;
+    ProfileCounter_t overrunCount;
+    ProfileCounter_t missCount;
+    volatile unsigned int adcFillBins [WM8731_STATS_FIFO_BINS];
+    volatile unsigned int dacSpaceBins[WM8731_STATS_FIFO_BINS];
+    volatile unsigned int blockLoadBins[WM8731_STATS_LOAD_BINS];
+    unsigned int deadline;          // Block period in global timer ticks, 0 if not yet known
+    uint64_t blockStart;            // Timestamp of WM8731_blockBegin()
+    bool inBlock;                   // Between WM8731_blockBegin() and WM8731_blockEnd()
+    unsigned int deadlineMisses;
+    bool published;                 // In Util/profile report
+} WM8731Stats_t;
+
+// DMA transfer state for one direction
+typedef struct {
+    DmaCtx_t* dma;          // DMA controller, or NULL if not assigned
+    void* params;           // Optional DMA controller parameters
+    DmaChunk_t xfer;
+    uintptr_t bufs[2];      // Left and right sample buffers of current transfer
+    unsigned int length;    // Length of each buffer in bytes
+    unsigned int stage;     // 0 = idle, 1 = left running, 2 = right running
+    BufDesc_t* buf;         // Descriptor held while running, or NULL for plain buffers
+} WM8731Dma_t;
+
 // Driver context
 typedef struct {
     // Context Header
@@ -72,6 +279,30 @@ typedef struct {
     I2CCtx_t* i2c; // I2C peripheral used by Audio Codec
     unsigned short i2cAddr;
     unsigned int sampleRate;
+    // Streaming mode
+    bool streaming;
+    HPSIRQSource irqID;
+    unsigned int blockSize;
+    WM8731Ring_t adcRing;       // Filled by IRQ, emptied by WM8731_acquireBlock
+    WM8731Ring_t dacRing;       // Filled by WM8731_submitBlock, emptied by IRQ
+    volatile unsigned int underruns;
+    volatile unsigned int overruns;
+    WM8731Stats_t stats;
+    // DMA transfers
+    WM8731Dma_t adcDma;
+    WM8731Dma_t dacDma;
+    // Register cache
+    unsigned short regCache[WM8731_REG_COUNT];
+    unsigned int   regCacheValid;   // Bit mask of registers with known value
+    // Register write sequence
+    struct {
+        const WM8731RegWrite_t* table;  // NULL if idle
+        unsigned int count;
+        unsigned int index;
+        bool         running;           // I2C write of table[index] in progress
+        uint16_t     data;
+        HpsErr_t     status;            // Result of last sequence
+    } seq;
 } WM8731Ctx_t;
 
 //Initialise Audio Codec
@@ -80,6 +311,19 @@ typedef struct {
 // - i2c is a generic I2C driver instance used to configure the controller.
 HpsErr_t WM8731_initialise( void* base, I2CCtx_t* i2c, WM8731Ctx_t** pCtx );
 
+//Start initialising Audio Codec without waiting
+// - As WM8731_initialise(), but only starts the I2C initialisation sequence.
+//   The context is not initialised until WM8731_initialiseStep() returns ERR_SUCCESS.
+// - For use with Util/init_seq to power up several drivers at once.
+HpsErr_t WM8731_initialiseStart( void* base, I2CCtx_t* i2c, WM8731Ctx_t** pCtx );
+
+//Make the next step of Audio Codec initialisation
+// - ctx must have been returned by WM8731_initialiseStart().
+// - Returns ERR_AGAIN while the I2C sequence is still being written. *delay
+//   is left as 0 to be called again as soon as possible.
+// - Returns ERR_SUCCESS once initialised and the FIFOs cleared.
+HpsErr_t WM8731_initialiseStep( WM8731Ctx_t* ctx, unsigned int* delay );
+
 //Check if driver initialised
 // - Returns true if driver previously initialised
 // - WM8731_initialise() must be called if false.
@@ -88,8 +332,23 @@ bool WM8731_isInitialised( WM8731Ctx_t* ctx );
 //Configure an I2C register
 // - Allows changing settings for codec (e.g. volumen control, filtering, etc)
 // - Refer to Page 46 of WM8731 codec datasheet.
+// - Skipped if the register already holds the value.
+// - Returns ERR_BUSY if a register sequence is running.
 HpsErr_t WM8731_writeRegister( WM8731Ctx_t* ctx, WM8731RegAddress regAddr, unsigned int regVal );
 
+//Start a sequence of register writes
+// - table is an array of count register writes, made in order. It must remain
+//   valid until WM8731_sequenceDone() no longer returns ERR_AGAIN.
+// - Writes of the value a register already holds are skipped.
+// - Returns ERR_AGAIN if started, or ERR_SUCCESS if there was nothing to write.
+// - Returns ERR_BUSY if a sequence is already running.
+HpsErr_t WM8731_writeSequence( WM8731Ctx_t* ctx, const WM8731RegWrite_t* table, unsigned int count );
+
+//Check if a register sequence is done
+// - Starts the next write once the previous is complete, so call periodically.
+// - Returns ERR_AGAIN while running, then the result of the sequence.
+HpsErr_t WM8731_sequenceDone( WM8731Ctx_t* ctx );
+
 //Get the sample rate for the ADC/DAC
 HpsErr_t WM8731_getSampleRate( WM8731Ctx_t* ctx, unsigned int* sampleRate );
 
@@ -111,4 +370,183 @@ HpsErr_t WM8731_writeSample( WM8731Ctx_t* ctx, unsigned int left, unsigned int r
 // - You must check there is space in the FIFO before calling this function.
 HpsErr_t WM8731_readSample( WM8731Ctx_t* ctx, unsigned int* left, unsigned int* right);
 
+//Write a sample to the FIFO for both channels, unchecked
+// - For inner loops. The context must be initialised with the I2S interface,
+//   and not be streaming or running DMA. You must check there is space.
+static inline void WM8731_writeSampleFast( WM8731Ctx_t* ctx, unsigned int left, unsigned int right) {
+    ctx->base[WM8731_LEFTFIFO ] = left;
+    ctx->base[WM8731_RIGHTFIFO] = right;
+}
+
+//Read a sample from the FIFO for both channels, unchecked
+// - For inner loops. The context must be initialised with the I2S interface,
+//   and not be streaming or running DMA. You must check there is data available.
+static inline void WM8731_readSampleFast( WM8731Ctx_t* ctx, unsigned int* left, unsigned int* right) {
+    *left  = ctx->base[WM8731_LEFTFIFO ];
+    *right = ctx->base[WM8731_RIGHTFIFO];
+}
+
+//Write a block of interleaved 16-bit frames to the FIFO
+// - frames holds count stereo frames as left, right, left, right, ...
+// - Each sample is scaled up to the 24-bit FIFO width.
+// - The FIFO space is read once, and up to that many frames are written.
+// - Returns the number of frames written (may be 0), or an error code.
+HpsErr_t WM8731_writeFrames16( WM8731Ctx_t* ctx, const int16_t* frames, unsigned int count );
+
+//Write a block of interleaved 32-bit frames to the FIFO
+// - frames holds count stereo frames as left, right, left, right, ...
+// - Each sample is a 24-bit value in the lower bits.
+// - The FIFO space is read once, and up to that many frames are written.
+// - Returns the number of frames written (may be 0), or an error code.
+HpsErr_t WM8731_writeFrames32( WM8731Ctx_t* ctx, const int32_t* frames, unsigned int count );
+
+//Read a block of interleaved 16-bit frames from the FIFO
+// - frames has room for count stereo frames as left, right, left, right, ...
+// - Each sample is the upper 16 bits of the 24-bit FIFO sample.
+// - The FIFO fill is read once, and up to that many frames are read.
+// - Returns the number of frames read (may be 0), or an error code.
+HpsErr_t WM8731_readFrames16( WM8731Ctx_t* ctx, int16_t* frames, unsigned int count );
+
+//Read a block of interleaved 32-bit frames from the FIFO
+// - frames has room for count stereo frames as left, right, left, right, ...
+// - Each sample is the 24-bit FIFO sample sign extended to 32 bits.
+// - The FIFO fill is read once, and up to that many frames are read.
+// - Returns the number of frames read (may be 0), or an error code.
+HpsErr_t WM8731_readFrames32( WM8731Ctx_t* ctx, int32_t* frames, unsigned int count );
+
+//Start interrupt driven streaming
+// - irqID is the interrupt ID of the audio controller (e.g. IRQ_LSC_AUDIO).
+// - blockSize is the number of stereo samples in each block.
+// - blockCount is the number of blocks in each ring buffer.
+// - HPS_IRQ driver must be initialised first.
+// - Returns ERR_BUSY if already streaming.
+HpsErr_t WM8731_startStreaming( WM8731Ctx_t* ctx, HPSIRQSource irqID, unsigned int blockSize, unsigned int blockCount );
+
+//Stop interrupt driven streaming
+// - Unregisters the interrupt handler and frees the ring buffers.
+// - Returns ERR_SKIPPED if not streaming.
+HpsErr_t WM8731_stopStreaming( WM8731Ctx_t* ctx );
+
+//Submit a block of samples for output
+// - block is an array of blockSize samples, which is copied into the DAC ring.
+// - Returns ERR_NOSPACE if the ring does not have space for the block.
+HpsErr_t WM8731_submitBlock( WM8731Ctx_t* ctx, const WM8731Sample_t* block );
+
+//Submit 16-bit frames for output
+// - frames holds count stereo frames as left, right, left, right, ...
+//   Each sample is scaled to the 24-bit FIFO range and queued in the DAC ring.
+// - As many frames as fit are queued, whole blocks not being required.
+// - Returns the number of frames queued (may be 0), or an error code.
+HpsErr_t WM8731_submitFrames16( WM8731Ctx_t* ctx, const int16_t* frames, unsigned int count );
+
+//Get the space in the DAC ring
+// - Returns the number of stereo samples which can be submitted, or an
+//   error code. Returns ERR_WRONGMODE if not streaming.
+HpsErr_t WM8731_getStreamSpace( WM8731Ctx_t* ctx );
+
+//Acquire a block of input samples
+// - block is an array of blockSize samples, which is filled from the ADC ring.
+// - Returns ERR_AGAIN if a complete block is not yet available.
+HpsErr_t WM8731_acquireBlock( WM8731Ctx_t* ctx, WM8731Sample_t* block );
+
+//Get streaming error counts
+// - underruns is the number of times the DAC ring has run dry.
+// - overruns is the number of input samples dropped due to the ADC ring being full.
+// - Either pointer may be NULL if not required.
+// - If clear is true, the counts are reset.
+HpsErr_t WM8731_getStreamErrors( WM8731Ctx_t* ctx, unsigned int* underruns, unsigned int* overruns, bool clear );
+
+//Add or remove the streaming statistics in the Util/profile report
+// - publish adds the statistics if true, or removes them if false.
+// - Statistics are kept whether or not they are published.
+// - Returns ERR_SKIPPED if already in the requested state.
+HpsErr_t WM8731_publishStats( WM8731Ctx_t* ctx, bool publish );
+
+//Clear the streaming statistics
+// - Clears the histograms, deadline misses, and the underrun/overrun counts.
+HpsErr_t WM8731_clearStats( WM8731Ctx_t* ctx );
+
+//Mark the start of processing a block
+// - Call immediately before acquiring (or generating) each block.
+// - Returns ERR_WRONGMODE if not streaming.
+// - Returns ERR_NOINIT if profiling is not initialised, as the global timer is used.
+HpsErr_t WM8731_blockBegin( WM8731Ctx_t* ctx );
+
+//Mark the end of processing a block
+// - Call once the block has been submitted, to record the time since
+//   WM8731_blockBegin() as a percentage of the block period.
+// - load is the percentage for this block, or NULL if not required.
+// - Returns ERR_SKIPPED if WM8731_blockBegin() was not called first.
+HpsErr_t WM8731_blockEnd( WM8731Ctx_t* ctx, unsigned int* load );
+
+//Measure the round trip latency with a loopback cable
+// - The line out must be connected to the line in, and the input
+//   otherwise silent.
+// - Each block acquired is matched by one submitted, starting with an
+//   impulse, so the DAC ring keeps its current fill. The result is the
+//   latency seen by a block processing loop with the same buffering.
+// - threshold is the input level (positive 24-bit sample) which counts
+//   as the impulse arriving.
+// - maxBlocks is the number of blocks to wait for the impulse.
+// - latency is the number of samples from the start of the input block
+//   the impulse was submitted in reply to, until the impulse is acquired.
+//   For a loop which passes input straight to output, this is the delay
+//   from a sample arriving to its echo arriving.
+// - Blocks the caller until complete. Any other use of the rings must
+//   stop while measuring.
+// - Returns ERR_NOTFOUND if the impulse was not seen, or ERR_TIMEOUT if
+//   blocks stopped arriving.
+// - Returns ERR_NOINIT if profiling is not initialised, as the global timer is used.
+HpsErr_t WM8731_measureLatency( WM8731Ctx_t* ctx, unsigned int threshold, unsigned int maxBlocks, unsigned int* latency );
+
+//Assign a DMA controller for FIFO transfers
+// - dac selects whether this is for the DAC (true) or ADC (false) direction.
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transfer is running in this direction.
+HpsErr_t WM8731_setDma( WM8731Ctx_t* ctx, bool dac, DmaCtx_t* dma, void* dmaParams );
+
+//Write a block of samples to the DAC FIFOs using DMA
+// - left and right are arrays of count samples.
+// - Buffers must remain valid until WM8731_dmaDone() returns success.
+// - Returns ERR_NOSPACE if there is not enough space in the FIFOs.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous DAC transfer is still running.
+HpsErr_t WM8731_writeBlockDma( WM8731Ctx_t* ctx, const unsigned int* left, const unsigned int* right, unsigned int count );
+
+//Read a block of samples from the ADC FIFOs using DMA
+// - left and right are arrays of count samples.
+// - Buffers must not be accessed until WM8731_dmaDone() returns success.
+// - Returns ERR_AGAIN if there are not yet enough samples in the FIFOs.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous ADC transfer is still running.
+HpsErr_t WM8731_readBlockDma( WM8731Ctx_t* ctx, unsigned int* left, unsigned int* right, unsigned int count );
+
+//Write a shared block of samples to the DAC FIFOs using DMA
+// - block holds count left samples followed by count right samples.
+// - A reference is held until the transfer is done.
+// - Returns ERR_TOOSMALL if block holds fewer than 2*count samples.
+// - Otherwise as WM8731_writeBlockDma().
+HpsErr_t WM8731_writeBlockDmaBuf( WM8731Ctx_t* ctx, BufDesc_t* block, unsigned int count );
+
+//Read a shared block of samples from the ADC FIFOs using DMA
+// - block receives count left samples followed by count right samples,
+//   and its length is set to match. A reference is held until the
+//   transfer is done.
+// - Returns ERR_TOOBIG if block can't hold 2*count samples.
+// - Otherwise as WM8731_readBlockDma().
+HpsErr_t WM8731_readBlockDmaBuf( WM8731Ctx_t* ctx, BufDesc_t* block, unsigned int count );
+
+//Check if a DMA transfer is done
+// - dac selects whether to check the DAC (true) or ADC (false) direction.
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+HpsErr_t WM8731_dmaDone( WM8731Ctx_t* ctx, bool dac );
+
+//Soft_DMAController copy function for the FIFOs
+// - Reads from or writes to the fixed FIFO address, depending on which
+//   of src or dest is a FIFO. ctx must be the WM8731 context.
+// - Compatible with SoftDmaMemcpyFunc_t.
+void* WM8731_softDmaCopy( void* dest, void* src, size_t len, void* ctx );
+
 #endif /*DE1SoC_WM8731_H_*/
@@ -0,0 +1,452 @@
+/*
+ * WM8731 Streaming WAV Player
+ * ---------------------------
+ * Description:
+ * Plays PCM WAV files from a FatFS volume through the WM8731 streaming mode
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_WavPlayer.h"
+#include "FatFS/ff_fastseek.h"
+#include "Util/mem_pool.h"
+#include "Util/hwlib/alt_cache.h"
+
+#include <string.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+//Reads must be whole sectors, and start on a sector boundary
+#if (WAVPLAYER_CHUNK_SIZE % FF_MAX_SS) != 0
+#error "WAVPLAYER_CHUNK_SIZE must be a multiple of FF_MAX_SS"
+#endif
+
+//Space in front of each read buffer for a sample which straddles the buffers.
+//A whole cache line so that it is not touched by the DMA cache maintenance.
+#define WAVPLAYER_GUARD_SIZE  ALT_CACHE_LINE_SIZE
+
+//WAV format tags
+#define WAVPLAYER_FORMAT_PCM         0x0001
+#define WAVPLAYER_FORMAT_EXTENSIBLE  0xFFFE
+
+/*
+ * Internal Functions
+ */
+
+//Little endian field access
+static inline unsigned int _WavPlayer_le16( const uint8_t* p ) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
+
+static inline uint32_t _WavPlayer_le32( const uint8_t* p ) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+//Map a FatFS result to an error code
+static HpsErr_t _WavPlayer_result( FRESULT res ) {
+    switch (res) {
+        case FR_OK:              return ERR_SUCCESS;
+        case FR_NO_FILE:
+        case FR_NO_PATH:
+        case FR_INVALID_NAME:
+        case FR_INVALID_DRIVE:   return ERR_NOTFOUND;
+        case FR_NOT_READY:       return ERR_NOTREADY;
+        case FR_NOT_ENABLED:
+        case FR_NO_FILESYSTEM:   return ERR_BADDISK;
+        case FR_TIMEOUT:         return ERR_TIMEOUT;
+        case FR_NOT_ENOUGH_CORE: return ERR_ALLOCFAIL;
+        default:                 return ERR_IOFAIL;
+    }
+}
+
+//Read part of the header
+// - Returns ERR_CORRUPT if the end of the file is reached first.
+static HpsErr_t _WavPlayer_readHeader( WavPlayerCtx_t* ctx, uint8_t* buf, UINT len ) {
+    UINT br;
+    FRESULT res = f_read(&ctx->file, buf, len, &br);
+    if (res != FR_OK) return _WavPlayer_result(res);
+    return (br == len) ? ERR_SUCCESS : ERR_CORRUPT;
+}
+
+//Parse the format chunk
+static HpsErr_t _WavPlayer_parseFormat( WavPlayerCtx_t* ctx, const uint8_t* fmt, unsigned int len ) {
+    unsigned int tag = _WavPlayer_le16(&fmt[0]);
+    if ((tag == WAVPLAYER_FORMAT_EXTENSIBLE) && (len >= 26)) {
+        //First two bytes of the sub-format GUID are the format tag
+        tag = _WavPlayer_le16(&fmt[24]);
+    }
+    if (tag != WAVPLAYER_FORMAT_PCM) return ERR_NOSUPPORT;
+    ctx->info.channels = _WavPlayer_le16(&fmt[2]);
+    ctx->info.sampleRate = _WavPlayer_le32(&fmt[4]);
+    ctx->info.bitsPerSample = _WavPlayer_le16(&fmt[14]);
+    ctx->frameSize = _WavPlayer_le16(&fmt[12]);
+    if ((ctx->info.channels < 1) || (ctx->info.channels > 2)) return ERR_NOSUPPORT;
+    switch (ctx->info.bitsPerSample) {
+        case 8: case 16: case 24: case 32: break;
+        default: return ERR_NOSUPPORT;
+    }
+    if (ctx->frameSize != ctx->info.channels * ctx->info.bitsPerSample / 8) return ERR_CORRUPT;
+    return ERR_SUCCESS;
+}
+
+//Find the format and data chunks
+// - Leaves the file pointer at the first sample.
+static HpsErr_t _WavPlayer_parseFile( WavPlayerCtx_t* ctx ) {
+    uint8_t hdr[40];
+    HpsErr_t status = _WavPlayer_readHeader(ctx, hdr, 12);
+    if (ERR_IS_ERROR(status)) return status;
+    if (memcmp(&hdr[0], "RIFF", 4) || memcmp(&hdr[8], "WAVE", 4)) return ERR_CORRUPT;
+    bool haveFormat = false;
+    while (true) {
+        status = _WavPlayer_readHeader(ctx, hdr, 8);
+        if (ERR_IS_ERROR(status)) return status;
+        uint32_t size = _WavPlayer_le32(&hdr[4]);
+        FSIZE_t start = f_tell(&ctx->file);
+        if (!memcmp(&hdr[0], "data", 4)) {
+            if (!haveFormat) return ERR_CORRUPT;
+            //Size may be wrong (e.g. 0xFFFFFFFF if recording was interrupted)
+            FSIZE_t length = f_size(&ctx->file) - start;
+            if (length > size) length = size;
+            ctx->info.frames = (unsigned int)(length / ctx->frameSize);
+            ctx->dataEnd = start + (FSIZE_t)ctx->info.frames * ctx->frameSize;
+            return ERR_SUCCESS;
+        }
+        if (!memcmp(&hdr[0], "fmt ", 4)) {
+            if (size < 16) return ERR_CORRUPT;
+            unsigned int len = (size < sizeof(hdr)) ? size : sizeof(hdr);
+            status = _WavPlayer_readHeader(ctx, hdr, len);
+            if (ERR_IS_ERROR(status)) return status;
+            status = _WavPlayer_parseFormat(ctx, hdr, len);
+            if (ERR_IS_ERROR(status)) return status;
+            haveFormat = true;
+        }
+        //Chunks are padded to an even length
+        FSIZE_t next = start + size + (size & 1);
+        if (next >= f_size(&ctx->file)) return ERR_CORRUPT;
+        FRESULT res = f_lseek(&ctx->file, next);
+        if (res != FR_OK) return _WavPlayer_result(res);
+    }
+}
+
+//Read completion
+// - Called from f_async_poll() or the SDMMC interrupt.
+static void _WavPlayer_readDone( FIL* fp, FRESULT res, UINT bytes, void* param ) {
+    WavPlayerCtx_t* ctx = (WavPlayerCtx_t*)param;
+    unsigned int idx = ctx->fillBuf;
+    if (res != FR_OK) {
+        ctx->readResult = res;
+        ctx->bufState[idx] = WAVPLAYER_EMPTY;
+        return;
+    }
+    //Anything after the data chunk is not part of the samples
+    FSIZE_t remain = ctx->dataEnd - ctx->readOffset;
+    if (bytes > remain) bytes = (UINT)remain;
+    ctx->bufLen[idx] = bytes;
+    //A short read is the end of the file
+    ctx->readOffset = (bytes < WAVPLAYER_CHUNK_SIZE) ? ctx->dataEnd : (ctx->readOffset + bytes);
+    ctx->fillBuf = idx ^ 1;
+    ctx->bufState[idx] = WAVPLAYER_FULL;
+}
+
+//Start reading into the next buffer, if it is free
+// - Returns ERR_SKIPPED if there is nothing to read, or ERR_BUSY if
+//   another transfer is using the card.
+static HpsErr_t _WavPlayer_startRead( WavPlayerCtx_t* ctx ) {
+    unsigned int idx = ctx->fillBuf;
+    if ((ctx->bufState[idx] != WAVPLAYER_EMPTY) || (ctx->readOffset >= ctx->dataEnd)) return ERR_SKIPPED;
+    ctx->bufState[idx] = WAVPLAYER_READING;
+    FRESULT res = f_read_async(&ctx->file, ctx->buf[idx], WAVPLAYER_CHUNK_SIZE, &_WavPlayer_readDone, ctx);
+    if (res == FR_OK) return ERR_SUCCESS;
+    ctx->bufState[idx] = WAVPLAYER_EMPTY;
+    return (res == FR_TIMEOUT) ? ERR_BUSY : _WavPlayer_result(res);
+}
+
+//Check if a read is in progress
+static inline bool _WavPlayer_reading( WavPlayerCtx_t* ctx ) {
+    return (ctx->bufState[0] == WAVPLAYER_READING) || (ctx->bufState[1] == WAVPLAYER_READING);
+}
+
+//Read one sample as codec format (24-bit in 32-bit word)
+static inline unsigned int _WavPlayer_sample( const uint8_t* p, unsigned int bits ) {
+    switch (bits) {
+        case 8:  return (unsigned int)((int32_t)p[0] - 128) << 16;
+        case 16: return (unsigned int)(int32_t)(int16_t)_WavPlayer_le16(p) << 8;
+        case 24: return (unsigned int)((int32_t)(((uint32_t)p[2] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[0] << 8)) >> 8);
+        default: return (unsigned int)((int32_t)_WavPlayer_le32(p) >> 8);
+    }
+}
+
+//Convert frames from the file into codec samples
+static void _WavPlayer_convert( WavPlayerCtx_t* ctx, const uint8_t* src, WM8731Sample_t* out, unsigned int count ) {
+    unsigned int bits = ctx->info.bitsPerSample;
+    bool stereo = (ctx->info.channels == 2);
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    //16-bit is by far the most common, so do 8 frames at a time
+    if (bits == 16) {
+        if (stereo) {
+            for (; n + 8 <= count; n += 8) {
+                int16x8x2_t px = vld2q_s16((const int16_t*)&src[4 * n]);
+                int32x4x2_t lo = { { vshll_n_s16(vget_low_s16 (px.val[0]), 8), vshll_n_s16(vget_low_s16 (px.val[1]), 8) } };
+                int32x4x2_t hi = { { vshll_n_s16(vget_high_s16(px.val[0]), 8), vshll_n_s16(vget_high_s16(px.val[1]), 8) } };
+                vst2q_s32((int32_t*)&out[n],     lo);
+                vst2q_s32((int32_t*)&out[n + 4], hi);
+            }
+        } else {
+            for (; n + 8 <= count; n += 8) {
+                int16x8_t px = vld1q_s16((const int16_t*)&src[2 * n]);
+                int32x4_t l = vshll_n_s16(vget_low_s16 (px), 8);
+                int32x4_t h = vshll_n_s16(vget_high_s16(px), 8);
+                int32x4x2_t lo = { { l, l } };
+                int32x4x2_t hi = { { h, h } };
+                vst2q_s32((int32_t*)&out[n],     lo);
+                vst2q_s32((int32_t*)&out[n + 4], hi);
+            }
+        }
+    }
+#endif
+    unsigned int step = bits / 8;
+    src += n * ctx->frameSize;
+    for (; n < count; n++) {
+        out[n].left  = _WavPlayer_sample(src, bits);
+        out[n].right = stereo ? _WavPlayer_sample(src + step, bits) : out[n].left;
+        src += ctx->frameSize;
+    }
+}
+
+//Convert buffered samples into the block
+// - Returns ERR_SUCCESS once the block is full, ERR_AGAIN if waiting for
+//   a read to finish, or ERR_BEYONDEND at the end of the samples.
+static HpsErr_t _WavPlayer_fillBlock( WavPlayerCtx_t* ctx ) {
+    while (ctx->blockFill < ctx->blockSize) {
+        unsigned int idx = ctx->playBuf;
+        if (ctx->bufState[idx] != WAVPLAYER_FULL) {
+            if ((ctx->bufState[idx] == WAVPLAYER_EMPTY) && (ctx->readOffset >= ctx->dataEnd)) return ERR_BEYONDEND;
+            return ERR_AGAIN;
+        }
+        const uint8_t* end = ctx->buf[idx] + ctx->bufLen[idx];
+        unsigned int avail = (ctx->playPtr < end) ? (unsigned int)(end - ctx->playPtr) : 0;
+        unsigned int frames = avail / ctx->frameSize;
+        if (frames) {
+            unsigned int count = ctx->blockSize - ctx->blockFill;
+            if (count > frames) count = frames;
+            _WavPlayer_convert(ctx, ctx->playPtr, &ctx->block[ctx->blockFill], count);
+            ctx->playPtr += count * ctx->frameSize;
+            ctx->blockFill += count;
+            continue;
+        }
+        //Buffer used up. Any part of a sample left must go in front of the next buffer.
+        unsigned int other = idx ^ 1;
+        if (ctx->bufState[other] == WAVPLAYER_FULL) {
+            memcpy(ctx->buf[other] - avail, ctx->playPtr, avail);
+            ctx->playPtr = ctx->buf[other] - avail;
+        } else if ((ctx->bufState[other] == WAVPLAYER_READING) || (ctx->readOffset < ctx->dataEnd)) {
+            return ERR_AGAIN;
+        } else {
+            ctx->playPtr = ctx->buf[other];
+        }
+        ctx->bufState[idx] = WAVPLAYER_EMPTY;
+        ctx->playBuf = other;
+    }
+    return ERR_SUCCESS;
+}
+
+//Cleanup
+static void _WavPlayer_cleanup( WavPlayerCtx_t* ctx ) {
+    if (ctx->open) {
+        while (_WavPlayer_reading(ctx) && f_async_poll());
+        f_close_fastseek(&ctx->file);
+    }
+    MemPool_free(ctx->alloc);
+    MemPool_free(ctx->block);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the WAV player
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE. Blocks are the same size as the streaming blocks.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t WavPlayer_initialise( WM8731Ctx_t* audio, WavPlayerCtx_t** pCtx ) {
+    //Check if the audio codec has been initialised and is streaming (required)
+    if (!WM8731_isInitialised(audio)) return ERR_BADDEVICE;
+    if (!audio->streaming) return ERR_WRONGMODE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_WavPlayer_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    WavPlayerCtx_t* ctx = *pCtx;
+    ctx->audio = audio;
+    ctx->blockSize = audio->blockSize;
+    ctx->open = false;
+    //Allocate block and read buffers. The read buffers are cache line aligned for
+    //the SDMMC DMA, each with a guard area in front.
+    ctx->block = MemPool_malloc(ctx->blockSize * sizeof(WM8731Sample_t));
+    ctx->alloc = MemPool_malloc(2 * (WAVPLAYER_GUARD_SIZE + WAVPLAYER_CHUNK_SIZE) + ALT_CACHE_LINE_SIZE);
+    if (!ctx->block || !ctx->alloc) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    uintptr_t base = ((uintptr_t)ctx->alloc + ALT_CACHE_LINE_SIZE - 1) & ~(uintptr_t)(ALT_CACHE_LINE_SIZE - 1);
+    ctx->buf[0] = (uint8_t*)base + WAVPLAYER_GUARD_SIZE;
+    ctx->buf[1] = ctx->buf[0] + WAVPLAYER_CHUNK_SIZE + WAVPLAYER_GUARD_SIZE;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool WavPlayer_isInitialised( WavPlayerCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Open a WAV file for playback
+// - Any file already playing is closed first.
+// - Reads the header, then starts reading the samples. Playback begins
+//   with the next call to WavPlayer_process().
+// - Returns ERR_NOTFOUND if the file doesn't exist, or ERR_IOFAIL if it
+//   could not be read.
+// - Returns ERR_CORRUPT if the file is not a valid WAV file, ERR_NOSUPPORT
+//   if it is not in a supported format, or ERR_MISMATCH if the sample rate
+//   is not that of the codec.
+HpsErr_t WavPlayer_open( WavPlayerCtx_t* ctx, const TCHAR* path ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!path) return ERR_NULLPTR;
+    WavPlayer_close(ctx);
+    //Fast seek mode is required for asynchronous reads
+    FRESULT res = f_open_fastseek(&ctx->file, path, FA_READ);
+    if (res != FR_OK) return _WavPlayer_result(res);
+    ctx->open = true;
+    status = _WavPlayer_parseFile(ctx);
+    if (ERR_IS_SUCCESS(status)) {
+        unsigned int sampleRate;
+        if (ERR_IS_SUCCESS(WM8731_getSampleRate(ctx->audio, &sampleRate)) && (sampleRate != ctx->info.sampleRate)) {
+            status = ERR_MISMATCH;
+        }
+    }
+    //Reads start from the sector containing the first sample
+    FSIZE_t start = f_tell(&ctx->file);
+    FSIZE_t aligned = start & ~(FSIZE_t)(FF_MAX_SS - 1);
+    if (ERR_IS_SUCCESS(status)) {
+        status = _WavPlayer_result(f_lseek(&ctx->file, aligned));
+    }
+    if (ERR_IS_ERROR(status)) {
+        WavPlayer_close(ctx);
+        return status;
+    }
+    ctx->readOffset = aligned;
+    ctx->readResult = FR_OK;
+    ctx->bufState[0] = WAVPLAYER_EMPTY;
+    ctx->bufState[1] = WAVPLAYER_EMPTY;
+    ctx->fillBuf = 0;
+    ctx->playBuf = 0;
+    ctx->playPtr = ctx->buf[0] + (start - aligned);
+    ctx->blockFill = 0;
+    ctx->blockPending = false;
+    //Get the first read going. If the card is busy, WavPlayer_process() will retry.
+    status = _WavPlayer_startRead(ctx);
+    if (ERR_IS_ERROR(status) && !ERR_IS_BUSY(status) && !ERR_IS_SKIPPED(status)) {
+        WavPlayer_close(ctx);
+        return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Get information about the open file
+// - Returns ERR_SKIPPED if no file is open.
+HpsErr_t WavPlayer_getInfo( WavPlayerCtx_t* ctx, WavInfo_t* info ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!info) return ERR_NULLPTR;
+    if (!ctx->open) return ERR_SKIPPED;
+    *info = ctx->info;
+    return ERR_SUCCESS;
+}
+
+//Close the file
+// - Waits for any read in progress to finish. Samples already submitted
+//   to the codec will still be played.
+// - Returns ERR_SKIPPED if no file is open.
+HpsErr_t WavPlayer_close( WavPlayerCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->open) return ERR_SKIPPED;
+    //The DMA must finish with the buffer before it can be reused
+    while (_WavPlayer_reading(ctx) && f_async_poll());
+    ctx->open = false;
+    return _WavPlayer_result(f_close_fastseek(&ctx->file));
+}
+
+//Check if a file is playing
+// - Returns true until the last block of the file has been submitted.
+bool WavPlayer_isPlaying( WavPlayerCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx) && ctx->open;
+}
+
+//Continue playback
+// - Starts the next read if a buffer is free, then submits blocks until
+//   the codec ring buffer is full or the buffered samples run out.
+// - The last block of the file is padded with silence, and the file is
+//   closed once it has been submitted.
+// - Returns the number of blocks submitted (>= 0), ERR_SKIPPED if no file
+//   is playing, or an error code if a read failed (the file is closed).
+HpsErr_t WavPlayer_process( WavPlayerCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->open) return ERR_SKIPPED;
+    //Check for a completed read, and start the next
+    f_async_poll();
+    status = (ctx->readResult != FR_OK) ? _WavPlayer_result(ctx->readResult) : _WavPlayer_startRead(ctx);
+    if (ERR_IS_ERROR(status) && !ERR_IS_BUSY(status) && !ERR_IS_SKIPPED(status)) {
+        WavPlayer_close(ctx);
+        return status;
+    }
+    unsigned int submitted = 0;
+    while (true) {
+        bool last = false;
+        //A block which didn't fit last time goes first
+        if (!ctx->blockPending) {
+            status = _WavPlayer_fillBlock(ctx);
+            if (ERR_IS_RETRY(status)) break;
+            if (status == ERR_BEYONDEND) {
+                if (!ctx->blockFill) {
+                    WavPlayer_close(ctx);
+                    break;
+                }
+                //Pad the last block with silence
+                memset(&ctx->block[ctx->blockFill], 0, (ctx->blockSize - ctx->blockFill) * sizeof(WM8731Sample_t));
+                last = true;
+            }
+            ctx->blockPending = true;
+        }
+        status = WM8731_submitBlock(ctx->audio, ctx->block);
+        if (status == ERR_NOSPACE) break;
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->blockPending = false;
+        ctx->blockFill = 0;
+        submitted++;
+        if (last) {
+            WavPlayer_close(ctx);
+            break;
+        }
+    }
+    //A buffer may have been freed up, so refill it straight away
+    if (ctx->open) _WavPlayer_startRead(ctx);
+    return (HpsErr_t)submitted;
+}
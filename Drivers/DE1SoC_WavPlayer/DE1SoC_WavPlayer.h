@@ -0,0 +1,162 @@
+/*
+ * WM8731 Streaming WAV Player
+ * ---------------------------
+ * Description:
+ * Plays PCM WAV files from a FatFS volume through the WM8731 streaming mode
+ *
+ * Reading a file with f_read() blocks the main loop until the card has
+ * transferred the data, so the codec ring buffer drains while it waits
+ * and playback stutters. Instead, the file is read with f_read_async()
+ * (FatFS/ff_async.h) in large sector aligned chunks into two buffers.
+ * While samples are converted from one buffer and passed to the codec
+ * with WM8731_submitBlock(), the SDMMC DMA refills the other.
+ *
+ * The data chunk of a WAV file rarely starts on a sector boundary, so
+ * reading starts from the sector containing it and the header bytes
+ * are skipped. Samples which straddle the two buffers are copied into
+ * a guard area in front of the next buffer, so conversion always works
+ * on contiguous data.
+ *
+ * Formats
+ * -------
+ *
+ * Uncompressed PCM (including WAVE_FORMAT_EXTENSIBLE PCM), mono or stereo,
+ * with 8, 16, 24 or 32 bits per sample. Mono files are played on both
+ * channels. The sample rate must match that of the codec.
+ *
+ * Usage
+ * -----
+ *
+ * The WM8731 driver must already be streaming. Call WavPlayer_process()
+ * regularly from the main loop. It starts the next read when a buffer
+ * is free, and converts and submits blocks until the codec ring buffer
+ * is full:
+ *
+ *    WM8731_startStreaming(audio, IRQ_LSC_AUDIO, 128, 8);
+ *    WavPlayer_initialise(audio, &player);
+ *    WavPlayer_open(player, "0:/music.wav");
+ *    while (WavPlayer_isPlaying(player)) {
+ *        WavPlayer_process(player);
+ *        ...
+ *    }
+ *
+ * Completion of the reads is checked by WavPlayer_process(). Reads finish
+ * sooner if f_async_irqHandler is also registered for IRQ_SDMMC. Other
+ * accesses to the card return FR_NOT_READY while a read is in progress.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_WAVPLAYER_H_
+#define DE1SOC_WAVPLAYER_H_
+
+//Include required header files
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "FatFS/ff.h"
+#include "FatFS/ff_async.h"
+#include "Util/driver_ctx.h"
+
+//Size of each read buffer in bytes. Must be a multiple of FF_MAX_SS so
+//that every read is whole sectors.
+#ifndef WAVPLAYER_CHUNK_SIZE
+#define WAVPLAYER_CHUNK_SIZE  16384
+#endif
+
+// WAV file information
+typedef struct {
+    unsigned int sampleRate;
+    unsigned int channels;
+    unsigned int bitsPerSample;
+    unsigned int frames;        // Number of samples in each channel
+} WavInfo_t;
+
+// Read buffer state
+typedef enum {
+    WAVPLAYER_EMPTY,
+    WAVPLAYER_READING,
+    WAVPLAYER_FULL
+} WavPlayerBufState;
+
+// Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    WM8731Ctx_t* audio;
+    unsigned int blockSize;
+    WM8731Sample_t* block;
+    unsigned int blockFill;
+    bool blockPending;
+    //File
+    FIL file;
+    bool open;
+    WavInfo_t info;
+    unsigned int frameSize;
+    FSIZE_t readOffset;         // File offset of the next read
+    FSIZE_t dataEnd;            // File offset of the end of the samples
+    //Read buffers
+    uint8_t* alloc;
+    uint8_t* buf[2];
+    volatile UINT bufLen[2];
+    volatile WavPlayerBufState bufState[2];
+    volatile FRESULT readResult;
+    unsigned int fillBuf;       // Buffer for the next read
+    unsigned int playBuf;       // Buffer being converted
+    const uint8_t* playPtr;
+} WavPlayerCtx_t;
+
+//Initialise the WAV player
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE. Blocks are the same size as the streaming blocks.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t WavPlayer_initialise( WM8731Ctx_t* audio, WavPlayerCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool WavPlayer_isInitialised( WavPlayerCtx_t* ctx );
+
+//Open a WAV file for playback
+// - Any file already playing is closed first.
+// - Reads the header, then starts reading the samples. Playback begins
+//   with the next call to WavPlayer_process().
+// - Returns ERR_NOTFOUND if the file doesn't exist, or ERR_IOFAIL if it
+//   could not be read.
+// - Returns ERR_CORRUPT if the file is not a valid WAV file, ERR_NOSUPPORT
+//   if it is not in a supported format, or ERR_MISMATCH if the sample rate
+//   is not that of the codec.
+HpsErr_t WavPlayer_open( WavPlayerCtx_t* ctx, const TCHAR* path );
+
+//Get information about the open file
+// - Returns ERR_SKIPPED if no file is open.
+HpsErr_t WavPlayer_getInfo( WavPlayerCtx_t* ctx, WavInfo_t* info );
+
+//Close the file
+// - Waits for any read in progress to finish. Samples already submitted
+//   to the codec will still be played.
+// - Returns ERR_SKIPPED if no file is open.
+HpsErr_t WavPlayer_close( WavPlayerCtx_t* ctx );
+
+//Check if a file is playing
+// - Returns true until the last block of the file has been submitted.
+bool WavPlayer_isPlaying( WavPlayerCtx_t* ctx );
+
+//Continue playback
+// - Starts the next read if a buffer is free, then submits blocks until
+//   the codec ring buffer is full or the buffered samples run out.
+// - The last block of the file is padded with silence, and the file is
+//   closed once it has been submitted.
+// - Returns the number of blocks submitted (>= 0), ERR_SKIPPED if no file
+//   is playing, or an error code if a read failed (the file is closed).
+HpsErr_t WavPlayer_process( WavPlayerCtx_t* ctx );
+
+#endif /* DE1SOC_WAVPLAYER_H_ */
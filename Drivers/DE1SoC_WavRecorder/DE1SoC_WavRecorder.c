@@ -0,0 +1,374 @@
+/*
+ * WM8731 WAV Recorder
+ * -------------------
+ * Description:
+ * Records the WM8731 line input to PCM WAV files on a FatFS volume
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "DE1SoC_WavRecorder.h"
+#include "FatFS/ff_fastseek.h"
+#include "Util/mem_pool.h"
+#include "Util/hwlib/alt_cache.h"
+
+#include <string.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if !FF_USE_EXPAND || FF_FS_READONLY
+#error "DE1SoC_WavRecorder requires f_expand (FF_USE_EXPAND == 1)"
+#endif
+
+//Writes must be whole sectors
+#if (WAVRECORDER_CHUNK_SIZE % FF_MAX_SS) != 0
+#error "WAVRECORDER_CHUNK_SIZE must be a multiple of FF_MAX_SS"
+#endif
+
+//Size of the canonical WAV header
+#define WAVRECORDER_HEADER_SIZE  44
+
+/*
+ * Internal Functions
+ */
+
+//Little endian field access
+static inline void _WavRecorder_le16( uint8_t* p, unsigned int val ) {
+    p[0] = (uint8_t)val;
+    p[1] = (uint8_t)(val >> 8);
+}
+
+static inline void _WavRecorder_le32( uint8_t* p, uint32_t val ) {
+    _WavRecorder_le16(&p[0], val);
+    _WavRecorder_le16(&p[2], val >> 16);
+}
+
+//Map a FatFS result to an error code
+static HpsErr_t _WavRecorder_result( FRESULT res ) {
+    switch (res) {
+        case FR_OK:              return ERR_SUCCESS;
+        case FR_NO_FILE:
+        case FR_NO_PATH:
+        case FR_INVALID_NAME:
+        case FR_INVALID_DRIVE:   return ERR_NOTFOUND;
+        case FR_DENIED:          return ERR_NOSPACE;
+        case FR_WRITE_PROTECTED: return ERR_WRITEPROT;
+        case FR_NOT_READY:       return ERR_NOTREADY;
+        case FR_NOT_ENABLED:
+        case FR_NO_FILESYSTEM:   return ERR_BADDISK;
+        case FR_TIMEOUT:         return ERR_TIMEOUT;
+        case FR_NOT_ENOUGH_CORE: return ERR_ALLOCFAIL;
+        default:                 return ERR_IOFAIL;
+    }
+}
+
+//Build the WAV header for frames samples of each channel
+static void _WavRecorder_header( WavRecorderCtx_t* ctx, uint8_t* hdr, unsigned int frames, unsigned int sampleRate ) {
+    uint32_t dataSize = frames * ctx->frameSize;
+    memcpy(&hdr[0], "RIFF", 4);
+    _WavRecorder_le32(&hdr[4], WAVRECORDER_HEADER_SIZE - 8 + dataSize);
+    memcpy(&hdr[8], "WAVEfmt ", 8);
+    _WavRecorder_le32(&hdr[16], 16);
+    _WavRecorder_le16(&hdr[20], 1);                                 //PCM
+    _WavRecorder_le16(&hdr[22], 2);                                 //Stereo
+    _WavRecorder_le32(&hdr[24], sampleRate);
+    _WavRecorder_le32(&hdr[28], sampleRate * ctx->frameSize);      //Byte rate
+    _WavRecorder_le16(&hdr[32], ctx->frameSize);
+    _WavRecorder_le16(&hdr[34], ctx->bitsPerSample);
+    memcpy(&hdr[36], "data", 4);
+    _WavRecorder_le32(&hdr[40], dataSize);
+}
+
+//Convert codec samples (24-bit in 32-bit word) to little endian PCM
+static void _WavRecorder_convert( WavRecorderCtx_t* ctx, const WM8731Sample_t* in, uint8_t* out, unsigned int count ) {
+    unsigned int n = 0;
+    if (ctx->bitsPerSample == 16) {
+#if defined(__ARM_NEON)
+        for (; n + 4 <= count; n += 4) {
+            uint32x4x2_t px = vld2q_u32((const uint32_t*)&in[n]);
+            uint16x4x2_t pcm = { { vshrn_n_u32(px.val[0], 8), vshrn_n_u32(px.val[1], 8) } };
+            vst2_u16((uint16_t*)&out[4 * n], pcm);
+        }
+#endif
+        for (; n < count; n++) {
+            _WavRecorder_le16(&out[4 * n],     in[n].left  >> 8);
+            _WavRecorder_le16(&out[4 * n + 2], in[n].right >> 8);
+        }
+    } else {
+        for (; n < count; n++) {
+            uint8_t* p = &out[6 * n];
+            p[0] = (uint8_t)in[n].left;
+            p[1] = (uint8_t)(in[n].left >> 8);
+            p[2] = (uint8_t)(in[n].left >> 16);
+            p[3] = (uint8_t)in[n].right;
+            p[4] = (uint8_t)(in[n].right >> 8);
+            p[5] = (uint8_t)(in[n].right >> 16);
+        }
+    }
+}
+
+//Write completion
+// - Called from f_async_poll() or the SDMMC interrupt.
+static void _WavRecorder_writeDone( FIL* fp, FRESULT res, UINT bytes, void* param ) {
+    WavRecorderCtx_t* ctx = (WavRecorderCtx_t*)param;
+    unsigned int idx = ctx->writeBuf;
+    if (res != FR_OK) ctx->writeResult = res;
+    ctx->writeBuf = idx ^ 1;
+    ctx->bufState[idx] = WAVRECORDER_EMPTY;
+}
+
+//Start writing the next buffer, if it is full
+// - Returns ERR_SKIPPED if there is nothing to write, or ERR_BUSY if
+//   another transfer is using the card.
+static HpsErr_t _WavRecorder_startWrite( WavRecorderCtx_t* ctx ) {
+    unsigned int idx = ctx->writeBuf;
+    if (ctx->bufState[idx] != WAVRECORDER_FULL) return ERR_SKIPPED;
+    ctx->bufState[idx] = WAVRECORDER_WRITING;
+    FRESULT res = f_write_async(&ctx->file, ctx->buf[idx], WAVRECORDER_CHUNK_SIZE, &_WavRecorder_writeDone, ctx);
+    if (res == FR_OK) return ERR_SUCCESS;
+    ctx->bufState[idx] = WAVRECORDER_FULL;
+    return (res == FR_TIMEOUT) ? ERR_BUSY : _WavRecorder_result(res);
+}
+
+//Check if a write is in progress
+static inline bool _WavRecorder_writing( WavRecorderCtx_t* ctx ) {
+    return (ctx->bufState[0] == WAVRECORDER_WRITING) || (ctx->bufState[1] == WAVRECORDER_WRITING);
+}
+
+//Bytes which can be added to the write buffers
+static unsigned int _WavRecorder_space( WavRecorderCtx_t* ctx ) {
+    unsigned int idx = ctx->fillBuf;
+    if (ctx->bufState[idx] != WAVRECORDER_EMPTY) return 0;
+    unsigned int space = WAVRECORDER_CHUNK_SIZE - ctx->fillLen;
+    if (ctx->bufState[idx ^ 1] == WAVRECORDER_EMPTY) space += WAVRECORDER_CHUNK_SIZE;
+    return space;
+}
+
+//Add data to the write buffers
+// - Caller must check there is space.
+static void _WavRecorder_append( WavRecorderCtx_t* ctx, const uint8_t* src, unsigned int len ) {
+    while (len) {
+        unsigned int idx = ctx->fillBuf;
+        unsigned int count = WAVRECORDER_CHUNK_SIZE - ctx->fillLen;
+        if (count > len) count = len;
+        if (src) memcpy(&ctx->buf[idx][ctx->fillLen], src, count);
+        ctx->fillLen += count;
+        len -= count;
+        if (src) src += count;
+        if (ctx->fillLen == WAVRECORDER_CHUNK_SIZE) {
+            ctx->bufState[idx] = WAVRECORDER_FULL;
+            ctx->fillBuf = idx ^ 1;
+            ctx->fillLen = 0;
+        }
+    }
+}
+
+//Finish the file
+// - Writes any buffered data synchronously, then the final header, and
+//   trims the file to its length.
+static HpsErr_t _WavRecorder_finish( WavRecorderCtx_t* ctx ) {
+    UINT bw;
+    FRESULT res = FR_OK;
+    //Full buffers first, in order, then the one being filled
+    for (unsigned int i = 0; (i < 2) && (res == FR_OK); i++) {
+        unsigned int idx = ctx->writeBuf ^ i;
+        if (ctx->bufState[idx] != WAVRECORDER_FULL) continue;
+        res = f_write(&ctx->file, ctx->buf[idx], WAVRECORDER_CHUNK_SIZE, &bw);
+        ctx->bufState[idx] = WAVRECORDER_EMPTY;
+    }
+    if ((res == FR_OK) && ctx->fillLen) {
+        res = f_write(&ctx->file, ctx->buf[ctx->fillBuf], ctx->fillLen, &bw);
+    }
+    //Header now has the real length
+    FSIZE_t length = WAVRECORDER_HEADER_SIZE + (FSIZE_t)ctx->frames * ctx->frameSize;
+    if (res == FR_OK) {
+        uint8_t hdr[WAVRECORDER_HEADER_SIZE];
+        unsigned int sampleRate = 0;
+        WM8731_getSampleRate(ctx->audio, &sampleRate);
+        _WavRecorder_header(ctx, hdr, ctx->frames, sampleRate);
+        res = f_lseek(&ctx->file, 0);
+        if (res == FR_OK) res = f_write(&ctx->file, hdr, sizeof(hdr), &bw);
+    }
+    //Release the unused part of the allocation
+    if (res == FR_OK) res = f_lseek(&ctx->file, length);
+    if (res == FR_OK) res = f_truncate(&ctx->file);
+    return _WavRecorder_result(res);
+}
+
+//Cleanup
+static void _WavRecorder_cleanup( WavRecorderCtx_t* ctx ) {
+    if (ctx->open) WavRecorder_stop(ctx);
+    MemPool_free(ctx->alloc);
+    MemPool_free(ctx->stage);
+    MemPool_free(ctx->block);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the WAV recorder
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE.
+// - bitsPerSample is 16 or 24. Files are always stereo.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t WavRecorder_initialise( WM8731Ctx_t* audio, unsigned int bitsPerSample, WavRecorderCtx_t** pCtx ) {
+    //Check if the audio codec has been initialised and is streaming (required)
+    if (!WM8731_isInitialised(audio)) return ERR_BADDEVICE;
+    if (!audio->streaming) return ERR_WRONGMODE;
+    if ((bitsPerSample != 16) && (bitsPerSample != 24)) return ERR_NOSUPPORT;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_WavRecorder_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    WavRecorderCtx_t* ctx = *pCtx;
+    ctx->audio = audio;
+    ctx->blockSize = audio->blockSize;
+    ctx->bitsPerSample = bitsPerSample;
+    ctx->frameSize = 2 * bitsPerSample / 8;
+    ctx->open = false;
+    //Allocate block, staging and write buffers. The write buffers are cache line
+    //aligned for the SDMMC DMA.
+    ctx->block = MemPool_malloc(ctx->blockSize * sizeof(WM8731Sample_t));
+    ctx->stage = MemPool_malloc(ctx->blockSize * ctx->frameSize);
+    ctx->alloc = MemPool_malloc(2 * WAVRECORDER_CHUNK_SIZE + ALT_CACHE_LINE_SIZE);
+    if (!ctx->block || !ctx->stage || !ctx->alloc) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    uintptr_t base = ((uintptr_t)ctx->alloc + ALT_CACHE_LINE_SIZE - 1) & ~(uintptr_t)(ALT_CACHE_LINE_SIZE - 1);
+    ctx->buf[0] = (uint8_t*)base;
+    ctx->buf[1] = ctx->buf[0] + WAVRECORDER_CHUNK_SIZE;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool WavRecorder_isInitialised( WavRecorderCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Start recording to a file
+// - Creates (or replaces) the file at path, allocating space for maxFrames
+//   samples of each channel. Recording stops once they have been taken.
+// - Any samples already in the ADC ring buffer are discarded.
+// - Returns ERR_BUSY if already recording.
+// - Returns ERR_NOSPACE if there is no contiguous free space large enough,
+//   ERR_NOTFOUND if the path is invalid, or ERR_IOFAIL if the file could
+//   not be created.
+HpsErr_t WavRecorder_start( WavRecorderCtx_t* ctx, const TCHAR* path, unsigned int maxFrames ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!path) return ERR_NULLPTR;
+    if (ctx->open) return ERR_BUSY;
+    if (!maxFrames) return ERR_TOOSMALL;
+    //Allocate whole buffers, so that every asynchronous write is within the file
+    FSIZE_t length = WAVRECORDER_HEADER_SIZE + (FSIZE_t)maxFrames * ctx->frameSize;
+    length = ((length + WAVRECORDER_CHUNK_SIZE - 1) / WAVRECORDER_CHUNK_SIZE) * WAVRECORDER_CHUNK_SIZE;
+    FRESULT res = f_create_contiguous(&ctx->file, path, length);
+    if (res != FR_OK) return _WavRecorder_result(res);
+    ctx->open = true;
+    ctx->frames = 0;
+    ctx->maxFrames = maxFrames;
+    ctx->writeResult = FR_OK;
+    ctx->bufState[0] = WAVRECORDER_EMPTY;
+    ctx->bufState[1] = WAVRECORDER_EMPTY;
+    ctx->fillBuf = 0;
+    ctx->fillLen = 0;
+    ctx->writeBuf = 0;
+    //Header for the full length, so the file is still readable if recording is cut short
+    unsigned int sampleRate = 0;
+    WM8731_getSampleRate(ctx->audio, &sampleRate);
+    _WavRecorder_header(ctx, ctx->buf[0], maxFrames, sampleRate);
+    _WavRecorder_append(ctx, NULL, WAVRECORDER_HEADER_SIZE);
+    //Start from fresh samples
+    while (ERR_IS_SUCCESS(WM8731_acquireBlock(ctx->audio, ctx->block)));
+    return ERR_SUCCESS;
+}
+
+//Continue recording
+// - Takes blocks from the ADC ring buffer while there is space in the write
+//   buffers, and starts writing a buffer when it is full.
+// - Stops recording once maxFrames samples have been taken.
+// - Returns the number of blocks taken (>= 0), ERR_SKIPPED if not recording,
+//   or an error code if a write failed (recording is stopped).
+HpsErr_t WavRecorder_process( WavRecorderCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->open) return ERR_SKIPPED;
+    //Check for a completed write, and start the next
+    f_async_poll();
+    status = (ctx->writeResult != FR_OK) ? _WavRecorder_result(ctx->writeResult) : _WavRecorder_startWrite(ctx);
+    if (ERR_IS_ERROR(status) && !ERR_IS_BUSY(status) && !ERR_IS_SKIPPED(status)) {
+        WavRecorder_stop(ctx);
+        return status;
+    }
+    unsigned int acquired = 0;
+    while (ctx->frames < ctx->maxFrames) {
+        //Leave blocks in the ADC ring until there is room for them
+        unsigned int count = ctx->maxFrames - ctx->frames;
+        if (count > ctx->blockSize) count = ctx->blockSize;
+        unsigned int len = count * ctx->frameSize;
+        if (_WavRecorder_space(ctx) < len) break;
+        status = WM8731_acquireBlock(ctx->audio, ctx->block);
+        if (ERR_IS_RETRY(status)) break;
+        if (ERR_IS_ERROR(status)) return status;
+        acquired++;
+        //Convert straight into the write buffer unless the block straddles two
+        if (WAVRECORDER_CHUNK_SIZE - ctx->fillLen >= len) {
+            _WavRecorder_convert(ctx, ctx->block, &ctx->buf[ctx->fillBuf][ctx->fillLen], count);
+            _WavRecorder_append(ctx, NULL, len);
+        } else {
+            _WavRecorder_convert(ctx, ctx->block, ctx->stage, count);
+            _WavRecorder_append(ctx, ctx->stage, len);
+        }
+        ctx->frames += count;
+        _WavRecorder_startWrite(ctx);
+    }
+    if (ctx->frames >= ctx->maxFrames) {
+        status = WavRecorder_stop(ctx);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return (HpsErr_t)acquired;
+}
+
+//Stop recording
+// - Writes the remaining samples and the final header, then closes the file.
+//   Blocks until the writes are complete.
+// - Returns ERR_SKIPPED if not recording.
+HpsErr_t WavRecorder_stop( WavRecorderCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->open) return ERR_SKIPPED;
+    //Let the write in progress finish
+    while (_WavRecorder_writing(ctx) && f_async_poll());
+    status = _WavRecorder_result(ctx->writeResult);
+    if (ERR_IS_SUCCESS(status)) status = _WavRecorder_finish(ctx);
+    HpsErr_t closeStatus = _WavRecorder_result(f_close_fastseek(&ctx->file));
+    ctx->open = false;
+    return ERR_IS_ERROR(status) ? status : closeStatus;
+}
+
+//Check if recording
+bool WavRecorder_isRecording( WavRecorderCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx) && ctx->open;
+}
+
+//Get the number of samples of each channel recorded
+unsigned int WavRecorder_getFrames( WavRecorderCtx_t* ctx ) {
+    if (!DriverContextCheckInit(ctx)) return 0;
+    return ctx->frames;
+}
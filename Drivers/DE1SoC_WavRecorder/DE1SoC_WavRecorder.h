@@ -0,0 +1,148 @@
+/*
+ * WM8731 WAV Recorder
+ * -------------------
+ * Description:
+ * Records the WM8731 line input to PCM WAV files on a FatFS volume
+ *
+ * When a file grows, FatFS has to find and link a free cluster, which
+ * means reading and writing the FAT in the middle of the recording.
+ * Each of these stalls the main loop long enough for the ADC ring
+ * buffer to overflow. Instead, the whole file is allocated up front as
+ * one contiguous run of clusters with f_create_contiguous() (f_expand),
+ * so no FAT updates are needed until the recording is finished.
+ *
+ * Samples are taken from the ADC ring with WM8731_acquireBlock() and
+ * packed into two large buffers. A full buffer is written with
+ * f_write_async() (FatFS/ff_async.h) while the other is being filled.
+ * The file starts on a cluster boundary and each write is a whole
+ * buffer, so with the default buffer size each write is one cluster
+ * on most cards.
+ *
+ * When recording stops, the rest of the samples are written, the
+ * header is updated with the final length, and the unused part of
+ * the file is released with f_truncate().
+ *
+ * Usage
+ * -----
+ *
+ * The WM8731 driver must already be streaming. Call WavRecorder_process()
+ * regularly from the main loop:
+ *
+ *    WM8731_startStreaming(audio, IRQ_LSC_AUDIO, 128, 16);
+ *    WavRecorder_initialise(audio, 16, &recorder);
+ *    WavRecorder_start(recorder, "0:/take1.wav", 48000 * 60 * 5);
+ *    while (WavRecorder_isRecording(recorder)) {
+ *        WavRecorder_process(recorder);
+ *        if (stopPressed) WavRecorder_stop(recorder);
+ *    }
+ *
+ * If both buffers are waiting to be written, no more blocks are taken,
+ * so the ADC ring buffer absorbs slow writes. Any samples lost once it
+ * is full are counted by WM8731_getStreamErrors().
+ *
+ * Other accesses to the card return FR_NOT_READY while a write is in
+ * progress.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef DE1SOC_WAVRECORDER_H_
+#define DE1SOC_WAVRECORDER_H_
+
+//Include required header files
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "FatFS/ff.h"
+#include "FatFS/ff_async.h"
+#include "Util/driver_ctx.h"
+
+//Size of each write buffer in bytes. Must be a multiple of FF_MAX_SS.
+//Ideally a multiple of the cluster size of the card.
+#ifndef WAVRECORDER_CHUNK_SIZE
+#define WAVRECORDER_CHUNK_SIZE  32768
+#endif
+
+// Write buffer state
+typedef enum {
+    WAVRECORDER_EMPTY,
+    WAVRECORDER_FULL,
+    WAVRECORDER_WRITING
+} WavRecorderBufState;
+
+// Driver context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    WM8731Ctx_t* audio;
+    unsigned int blockSize;
+    WM8731Sample_t* block;
+    uint8_t* stage;
+    unsigned int bitsPerSample;
+    unsigned int frameSize;
+    //File
+    FIL file;
+    bool open;
+    unsigned int frames;
+    unsigned int maxFrames;
+    //Write buffers
+    uint8_t* alloc;
+    uint8_t* buf[2];
+    volatile WavRecorderBufState bufState[2];
+    volatile FRESULT writeResult;
+    unsigned int fillBuf;       // Buffer being filled
+    unsigned int fillLen;
+    unsigned int writeBuf;      // Buffer for the next write
+} WavRecorderCtx_t;
+
+//Initialise the WAV recorder
+// - audio must be streaming (see WM8731_startStreaming), otherwise returns
+//   ERR_WRONGMODE.
+// - bitsPerSample is 16 or 24. Files are always stereo.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t WavRecorder_initialise( WM8731Ctx_t* audio, unsigned int bitsPerSample, WavRecorderCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool WavRecorder_isInitialised( WavRecorderCtx_t* ctx );
+
+//Start recording to a file
+// - Creates (or replaces) the file at path, allocating space for maxFrames
+//   samples of each channel. Recording stops once they have been taken.
+// - Any samples already in the ADC ring buffer are discarded.
+// - Returns ERR_BUSY if already recording.
+// - Returns ERR_NOSPACE if there is no contiguous free space large enough,
+//   ERR_NOTFOUND if the path is invalid, or ERR_IOFAIL if the file could
+//   not be created.
+HpsErr_t WavRecorder_start( WavRecorderCtx_t* ctx, const TCHAR* path, unsigned int maxFrames );
+
+//Continue recording
+// - Takes blocks from the ADC ring buffer while there is space in the write
+//   buffers, and starts writing a buffer when it is full.
+// - Stops recording once maxFrames samples have been taken.
+// - Returns the number of blocks taken (>= 0), ERR_SKIPPED if not recording,
+//   or an error code if a write failed (recording is stopped).
+HpsErr_t WavRecorder_process( WavRecorderCtx_t* ctx );
+
+//Stop recording
+// - Writes the remaining samples and the final header, then closes the file.
+//   Blocks until the writes are complete.
+// - Returns ERR_SKIPPED if not recording.
+HpsErr_t WavRecorder_stop( WavRecorderCtx_t* ctx );
+
+//Check if recording
+bool WavRecorder_isRecording( WavRecorderCtx_t* ctx );
+
+//Get the number of samples of each channel recorded
+unsigned int WavRecorder_getFrames( WavRecorderCtx_t* ctx );
+
+#endif /* DE1SOC_WAVRECORDER_H_ */
@@ -5,6 +5,9 @@
  * Driver for interfacing with an Altera
  * CSR compatible IrDA controller.
  *
+ * An interrupt driven buffered mode is provided which services
+ * software ring buffers, see FPGA_IrDAController.h for details.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -12,12 +15,18 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add interrupt driven buffered mode.
  * 18/02/2024 | Creation of driver.
  *
  */
 
 #include "FPGA_IrDAController.h"
 
+#include "Util/lowlevel_arm.h"
+#include "Util/mem_pool.h"
+
+#include <string.h>
+
 /*
  *
  * CSR Map
@@ -163,9 +172,124 @@ static HpsErr_t _FPGA_IrDA_read(FPGAIrDACtx_t* ctx, uint8_t* data, uint8_t lengt
     return (parityErr ? ERR_CHECKSUM : numRead);
 }
 
+// Number of bytes in a ring
+static inline unsigned int _FPGA_IrDA_ringFill(FPGAIrDARing_t* ring) {
+    return ring->head - ring->tail;
+}
+
+// Number of free bytes in a ring
+static inline unsigned int _FPGA_IrDA_ringSpace(FPGAIrDARing_t* ring) {
+    return ring->size - _FPGA_IrDA_ringFill(ring);
+}
+
+// Copy data into a ring
+// - Copies as much as there is space for, returning the amount copied.
+static unsigned int _FPGA_IrDA_ringWrite(FPGAIrDARing_t* ring, const uint8_t* data, unsigned int length) {
+    unsigned int count = min(length, _FPGA_IrDA_ringSpace(ring));
+    unsigned int idx = ring->head & (ring->size - 1);
+    unsigned int first = min(count, ring->size - idx);
+    memcpy(&ring->buf[idx], data, first);
+    memcpy(ring->buf, data + first, count - first);
+    //Ensure data is written before the consumer can see it
+    __DMB();
+    ring->head = ring->head + count;
+    return count;
+}
+
+// Copy data out of a ring
+// - Copies as much as is available, returning the amount copied.
+static unsigned int _FPGA_IrDA_ringRead(FPGAIrDARing_t* ring, uint8_t* data, unsigned int length) {
+    unsigned int count = min(length, _FPGA_IrDA_ringFill(ring));
+    //Ensure data is read only after the fill level
+    __DMB();
+    unsigned int idx = ring->tail & (ring->size - 1);
+    unsigned int first = min(count, ring->size - idx);
+    memcpy(data, &ring->buf[idx], first);
+    memcpy(data + first, ring->buf, count - first);
+    //Ensure data is read before the producer can overwrite it
+    __DMB();
+    ring->tail = ring->tail + count;
+    return count;
+}
+
+// Enable the TX empty interrupt
+// - IRQs disabled as the handler also modifies the enable register.
+static void _FPGA_IrDA_startBufferedTx(FPGAIrDACtx_t* ctx) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    FPGAIRDA_REG_IRQMASK(ctx->base) = FPGAIRDA_REG_IRQMASK(ctx->base) | MaskCreate(FPGA_IrDA_IRQ_TXEMPTY, FPGAIRDA_FLAGS_IRQ_OFFS);
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+}
+
+// Buffered mode interrupt handler
+// - Moves data between the FIFOs and the rings
+static __irq void _FPGA_IrDA_bufferedIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    FPGAIrDACtx_t* ctx = (FPGAIrDACtx_t*)param;
+    if (!ctx) return;
+    // Clear the RX flag before draining, so anything arriving after is caught by the next IRQ
+    FPGAIRDA_REG_IRQFLAGS(ctx->base) = MaskCreate(FPGA_IrDA_IRQ_RXAVAIL, FPGAIRDA_FLAGS_IRQ_OFFS);
+    // Drain the RX FIFO, passing each byte through the decoder
+    FPGAIrDARing_t* ring = &ctx->rxRing;
+    unsigned int avail = _FPGA_IrDA_available(ctx);
+    unsigned int pos = ring->head;
+    unsigned int space = _FPGA_IrDA_ringSpace(ring);
+    for (unsigned int cnt = 0; cnt < avail; cnt++) {
+        uint16_t rxReg = FPGAIRDA_REG_RXFIFO(ctx->base);
+        uint8_t rxData = MaskExtract(rxReg, FPGAIRDA_FIFO_DATA_MASK, FPGAIRDA_FIFO_DATA_OFFS);
+        bool parityErr = MaskExtract(rxReg, FPGAIRDA_RXFIFO_PARITY_MASK, FPGAIRDA_RXFIFO_PARITY_OFFS);
+        if (parityErr) ctx->parityErrors++;
+        if (ctx->decoder && ctx->decoder(ctx->decoderParam, rxData, parityErr)) continue;
+        // Anything that doesn't fit is dropped, as it must still be drained
+        if (!space) {
+            ctx->overruns++;
+            continue;
+        }
+        ring->buf[pos++ & (ring->size - 1)] = rxData;
+        space--;
+    }
+    __DMB();
+    ring->head = pos;
+    // Refill the TX FIFO
+    ring = &ctx->txRing;
+    avail = _FPGA_IrDA_ringFill(ring);
+    unsigned int count = min(avail, _FPGA_IrDA_writeSpace(ctx));
+    if (count) {
+        // Clear the TX empty flag first so that it marks the end of this run
+        FPGAIRDA_REG_IRQFLAGS(ctx->base) = MaskCreate(FPGA_IrDA_IRQ_TXEMPTY, FPGAIRDA_FLAGS_IRQ_OFFS);
+        ctx->txRunning = true;
+    }
+    pos = ring->tail;
+    for (unsigned int cnt = 0; cnt < count; cnt++) {
+        FPGAIRDA_REG_TXFIFO(ctx->base) = MaskInsert(ring->buf[pos++ & (ring->size - 1)], FPGAIRDA_FIFO_DATA_MASK, FPGAIRDA_FIFO_DATA_OFFS);
+    }
+    __DMB();
+    ring->tail = pos;
+    // If ring has run dry, stop TX interrupts until more data is written. The TX empty
+    // flag is left asserted when idle so that txIdle can see it.
+    if (count == avail) {
+        FPGAIRDA_REG_IRQMASK(ctx->base) = FPGAIRDA_REG_IRQMASK(ctx->base) & ~MaskCreate(FPGA_IrDA_IRQ_TXEMPTY, FPGAIRDA_FLAGS_IRQ_OFFS);
+    }
+    *handled = true;
+}
+
+// Stop buffered mode
+static void _FPGA_IrDA_stopBuffered(FPGAIrDACtx_t* ctx) {
+    // Disable interrupts in the controller, then remove the handler
+    FPGAIRDA_REG_IRQMASK(ctx->base) = 0;
+    HPS_IRQ_unregisterHandler(ctx->irqID);
+    ctx->buffered = false;
+    // Free the ring buffers
+    MemPool_free(ctx->txRing.buf);
+    ctx->txRing.buf = NULL;
+    MemPool_free(ctx->rxRing.buf);
+    ctx->rxRing.buf = NULL;
+}
+
 static void _FPGA_IrDA_cleanup(FPGAIrDACtx_t* ctx) {
     //Disable interrupts and reset FIFOs
     if (ctx->base) {
+        if (ctx->buffered) {
+            _FPGA_IrDA_stopBuffered(ctx);
+        }
         FPGAIRDA_REG_IRQMASK(ctx->base)   = 0;
         FPGAIRDA_REG_IRQFLAGS(ctx->base)  = MaskCreate(FPGAIRDA_FLAGS_IRQ_MASK, FPGAIRDA_FLAGS_IRQ_OFFS);
         FPGAIRDA_REG_CLEARFIFO(ctx->base) = MaskCreate(FPGAIRDA_CLEARFIFO_RX_MASK, FPGAIRDA_CLEARFIFO_RX_OFFS) |
@@ -178,6 +302,8 @@ static HpsErr_t _FPGA_IrDA_txFifoSpace(FPGAIrDACtx_t* ctx) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    // Return ring space if buffered
+    if (ctx->buffered) return (HpsErr_t)min(_FPGA_IrDA_ringSpace(&ctx->txRing), (unsigned int)INT32_MAX);
     // Return FIFO space
     return (HpsErr_t)_FPGA_IrDA_writeSpace(ctx);
 }
@@ -186,6 +312,8 @@ static HpsErr_t _FPGA_IrDA_rxFifoAvailable(FPGAIrDACtx_t* ctx) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    // Return ring availability if buffered
+    if (ctx->buffered) return (HpsErr_t)min(_FPGA_IrDA_ringFill(&ctx->rxRing), (unsigned int)INT32_MAX);
     // Return FIFO availability
     return (HpsErr_t)_FPGA_IrDA_available(ctx);
 }
@@ -196,7 +324,8 @@ static HpsErr_t _FPGA_IrDA_txIdle(FPGAIrDACtx_t* ctx, bool clearFlag) {
     if (ERR_IS_ERROR(status)) return status;
     // Check the Tx empty IRQ (clearing flag if requested). This will also update txRunning flag
     _FPGA_IrDA_getInterruptFlags(ctx, FPGA_IrDA_IRQ_TXEMPTY, clearFlag);
-    // Return whether TX is running
+    // Return whether TX is running. If buffered, the ring must also be empty.
+    if (ctx->buffered && _FPGA_IrDA_ringFill(&ctx->txRing)) return false;
     return !ctx->txRunning;
 }
 
@@ -205,6 +334,7 @@ static HpsErr_t _FPGA_IrDA_rxReady(FPGAIrDACtx_t* ctx, bool clearFlag) {
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
     // Ready whenever there is data available
+    if (ctx->buffered) return _FPGA_IrDA_ringFill(&ctx->rxRing) > 0;
     return _FPGA_IrDA_available(ctx) > 0;
 }
 
@@ -241,6 +371,7 @@ HpsErr_t FPGA_IrDA_initialise(void* csr, FPGAIrDACtx_t** pCtx) {
     FPGAIRDA_REG_IRQMASK(ctx->base)   = 0;
     FPGAIRDA_REG_IRQFLAGS(ctx->base)  = MaskCreate(FPGAIRDA_FLAGS_IRQ_MASK, FPGAIRDA_FLAGS_IRQ_OFFS);
     FPGAIRDA_REG_CLEARFIFO(ctx->base) = 0;
+    ctx->buffered = false;
     //Initialised
     DriverContextSetInit(ctx);
     return ERR_SUCCESS;
@@ -301,8 +432,8 @@ HpsErr_t FPGA_IrDA_writeSpace(FPGAIrDACtx_t* ctx, unsigned int* space) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    // Check the space
-    unsigned int _space = _FPGA_IrDA_writeSpace(ctx);
+    // Check the space, in the ring if buffered
+    unsigned int _space = ctx->buffered ? _FPGA_IrDA_ringSpace(&ctx->txRing) : _FPGA_IrDA_writeSpace(ctx);
     if (space) *space = _space;
     return _space ? ERR_SUCCESS : ERR_NOSPACE;
 }
@@ -319,7 +450,9 @@ HpsErr_t FPGA_IrDA_write(FPGAIrDACtx_t* ctx, const uint8_t data[], uint8_t lengt
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    // And read
+    // Queue in the ring if buffered
+    if (ctx->buffered) return FPGA_IrDA_writeBuffered(ctx, data, length);
+    // And write
     return _FPGA_IrDA_write(ctx, data, length);
 }
 
@@ -330,8 +463,8 @@ HpsErr_t FPGA_IrDA_available(FPGAIrDACtx_t* ctx, unsigned int* available) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    // Read the FIFO available level
-    unsigned int _available = _FPGA_IrDA_available(ctx);
+    // Read the FIFO available level, or ring level if buffered
+    unsigned int _available = ctx->buffered ? _FPGA_IrDA_ringFill(&ctx->rxRing) : _FPGA_IrDA_available(ctx);
     if (available) *available = _available;
     return _available ? ERR_SUCCESS : ERR_ISEMPTY;
 }
@@ -344,8 +477,15 @@ UartRxData_t FPGA_IrDA_readWord(FPGAIrDACtx_t* ctx) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_SUCCESS(status)) {
-        // And read
-        _FPGA_IrDA_readWord(ctx, &data);
+        if (ctx->buffered) {
+            // Take from the ring if buffered. No per-word error information.
+            uint8_t byte;
+            data.valid = (_FPGA_IrDA_ringRead(&ctx->rxRing, &byte, 1) > 0);
+            if (data.valid) data.rxData = byte;
+        } else {
+            // And read
+            _FPGA_IrDA_readWord(ctx, &data);
+        }
     }
     return data;
 }
@@ -361,6 +501,134 @@ HpsErr_t FPGA_IrDA_read(FPGAIrDACtx_t* ctx, uint8_t data[], uint8_t length) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    // Take from the ring if buffered
+    if (ctx->buffered) return FPGA_IrDA_readBuffered(ctx, data, length);
     // And read
     return _FPGA_IrDA_read(ctx, data, length);
 }
+
+// Start interrupt driven buffered mode
+// - irqID is the interrupt ID of the IrDA controller (e.g. IRQ_LSC_IrDA).
+// - txSize and rxSize are the ring buffer sizes in bytes, rounded up to a power of two.
+// - HPS_IRQ driver must be initialised first.
+// - Returns ERR_BUSY if already buffered.
+HpsErr_t FPGA_IrDA_startBuffered(FPGAIrDACtx_t* ctx, HPSIRQSource irqID, unsigned int txSize, unsigned int rxSize) {
+    if (!txSize || !rxSize) return ERR_TOOSMALL;
+    if ((txSize > _BV(31)) || (rxSize > _BV(31))) return ERR_TOOBIG;
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->buffered) return ERR_BUSY;
+    // Round sizes up to a power of two so positions can be masked
+    unsigned int txLen = 1;
+    while (txLen < txSize) txLen = txLen * 2;
+    unsigned int rxLen = 1;
+    while (rxLen < rxSize) rxLen = rxLen * 2;
+    // Allocate the rings
+    ctx->txRing = (FPGAIrDARing_t){ .buf = MemPool_malloc(txLen), .size = txLen, .head = 0, .tail = 0 };
+    ctx->rxRing = (FPGAIrDARing_t){ .buf = MemPool_malloc(rxLen), .size = rxLen, .head = 0, .tail = 0 };
+    if (!ctx->txRing.buf || !ctx->rxRing.buf) {
+        MemPool_free(ctx->txRing.buf);
+        ctx->txRing.buf = NULL;
+        MemPool_free(ctx->rxRing.buf);
+        ctx->rxRing.buf = NULL;
+        return ERR_ALLOCFAIL;
+    }
+    ctx->overruns = 0;
+    ctx->parityErrors = 0;
+    // Register the handler
+    ctx->irqID = irqID;
+    status = HPS_IRQ_registerHandler(irqID, &_FPGA_IrDA_bufferedIsr, ctx);
+    if (ERR_IS_ERROR(status)) {
+        MemPool_free(ctx->txRing.buf);
+        ctx->txRing.buf = NULL;
+        MemPool_free(ctx->rxRing.buf);
+        ctx->rxRing.buf = NULL;
+        return status;
+    }
+    ctx->buffered = true;
+    // Enable RX interrupt, clearing any stale flag. TX interrupt is enabled once there is data.
+    FPGAIRDA_REG_IRQFLAGS(ctx->base) = MaskCreate(FPGA_IrDA_IRQ_RXAVAIL, FPGAIRDA_FLAGS_IRQ_OFFS);
+    FPGAIRDA_REG_IRQMASK(ctx->base) = MaskCreate(FPGA_IrDA_IRQ_RXAVAIL, FPGAIRDA_FLAGS_IRQ_OFFS);
+    return ERR_SUCCESS;
+}
+
+// Stop interrupt driven buffered mode
+// - Unregisters the interrupt handler and frees the ring buffers.
+// - Any data still in the TX ring is not sent.
+// - Returns ERR_SKIPPED if not buffered.
+HpsErr_t FPGA_IrDA_stopBuffered(FPGAIrDACtx_t* ctx) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->buffered) return ERR_SKIPPED;
+    _FPGA_IrDA_stopBuffered(ctx);
+    return ERR_SUCCESS;
+}
+
+// Queue data for buffered transmission
+// - Copies as much of data[] as fits in the TX ring, without waiting.
+// - Returns the number of bytes queued, or ERR_WRONGMODE if not buffered.
+HpsErr_t FPGA_IrDA_writeBuffered(FPGAIrDACtx_t* ctx, const uint8_t data[], size_t length) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->buffered) return ERR_WRONGMODE;
+    if (!length) return 0;
+    if (!data) return ERR_NULLPTR;
+    // Copy in what fits, and make sure the handler will send it
+    unsigned int count = _FPGA_IrDA_ringWrite(&ctx->txRing, data, min(length, (size_t)INT32_MAX));
+    if (count) _FPGA_IrDA_startBufferedTx(ctx);
+    return (HpsErr_t)count;
+}
+
+// Read buffered received data
+// - Copies up to length bytes from the RX ring, without waiting.
+// - Returns the number of bytes read, or ERR_WRONGMODE if not buffered.
+HpsErr_t FPGA_IrDA_readBuffered(FPGAIrDACtx_t* ctx, uint8_t data[], size_t length) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->buffered) return ERR_WRONGMODE;
+    if (!length) return 0;
+    if (!data) return ERR_NULLPTR;
+    // Copy out what is available
+    return (HpsErr_t)_FPGA_IrDA_ringRead(&ctx->rxRing, data, min(length, (size_t)INT32_MAX));
+}
+
+// Set the receive decoder
+// - decoder is called from the interrupt handler for each byte received
+//   in buffered mode, or NULL to store all bytes in the RX ring.
+// - param is passed to the decoder.
+HpsErr_t FPGA_IrDA_setDecoder(FPGAIrDACtx_t* ctx, FPGAIrDADecodeFunc_t decoder, void* param) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    // IRQs disabled so the handler never sees the new function with the old parameter
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    ctx->decoder = decoder;
+    ctx->decoderParam = param;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+// Get buffered mode error counts
+// - overruns is the number of received bytes dropped due to the RX ring being full.
+// - parityErrors is the number of bytes received with a parity error.
+// - Either pointer may be NULL if not required.
+// - If clear is true, the counts are reset.
+HpsErr_t FPGA_IrDA_getBufferErrors(FPGAIrDACtx_t* ctx, unsigned int* overruns, unsigned int* parityErrors, bool clear) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    // Read and optionally clear counts. IRQs disabled as the handler also modifies them.
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (overruns) *overruns = ctx->overruns;
+    if (parityErrors) *parityErrors = ctx->parityErrors;
+    if (clear) {
+        ctx->overruns = 0;
+        ctx->parityErrors = 0;
+    }
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
@@ -5,6 +5,43 @@
  * Driver for interfacing with an Altera
  * CSR compatible IrDA controller.
  *
+ * Buffered Mode
+ * -------------
+ *
+ * The basic write/read APIs poll the hardware FIFOs, so received
+ * data must be collected by a tight loop before the RX FIFO fills.
+ * As an alternative, an interrupt driven buffered mode is available.
+ * Calling FPGA_IrDA_startBuffered() registers an interrupt handler
+ * with the HPS_IRQ driver (which must already be initialised) and
+ * allocates a pair of software ring buffers, one for each direction.
+ *
+ * The interrupt handler drains the whole RX FIFO into the RX ring
+ * each time data arrives, and refills the TX FIFO from the TX ring
+ * each time it empties, so transfers of any length can be queued
+ * without waiting:
+ *
+ *    FPGA_IrDA_startBuffered(irda, IRQ_LSC_IrDA, 256, 256);
+ *    ...
+ *    FPGA_IrDA_writeBuffered(irda, packet, sizeof(packet));
+ *
+ * While buffered, FPGA_IrDA_write/read (and so the generic UART
+ * interface) also go through the rings. The rings are single
+ * producer/single consumer, so the APIs must only be called from
+ * one (non-interrupt) context. If the RX ring is full, incoming
+ * bytes are dropped and counted, see FPGA_IrDA_getBufferErrors().
+ *
+ * Receive Decoder
+ * ---------------
+ *
+ * A decoder function can be attached with FPGA_IrDA_setDecoder().
+ * It is called from the interrupt handler with each byte as it is
+ * received, before it is stored in the RX ring, so that a protocol
+ * framer can recognise commands (e.g. from a remote control sending
+ * fixed length packets) and act on them, or post an event, without
+ * the main loop having to poll. The decoder returns true if it has
+ * consumed the byte, or false to store it in the RX ring as normal.
+ * It runs in interrupt context, so must be short.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -12,6 +49,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add interrupt driven buffered mode.
  * 18/02/2024 | Creation of driver.
  *
  */
@@ -27,6 +65,8 @@
 #include "Util/driver_ctx.h"
 #include "Util/driver_uart.h"
 
+#include "HPS_IRQ/HPS_IRQ.h"
+
 #include "Util/ct_assert.h"
 #include "Util/macros.h"
 #include "Util/bit_helpers.h"
@@ -38,6 +78,22 @@ typedef enum PACKED {
     FPGA_IrDA_IRQ_ALL      = (FPGA_IrDA_IRQ_RXAVAIL | FPGA_IrDA_IRQ_TXEMPTY)
 } FPGAIrDAIrqSources;
 
+// Ring buffer for buffered mode
+// - size is a power of two. head and tail are free running
+//   positions, so (head - tail) is the fill level.
+typedef struct {
+    uint8_t* buf;
+    unsigned int size;
+    volatile unsigned int head; // Only written by producer
+    volatile unsigned int tail; // Only written by consumer
+} FPGAIrDARing_t;
+
+// Receive decoder for buffered mode
+//  - Called from the interrupt handler for each byte received.
+//  - parityError is true if the byte had a parity error.
+//  - Returns true if the byte was consumed, or false to store it in the RX ring.
+typedef bool (*FPGAIrDADecodeFunc_t)(void* param, uint8_t data, bool parityError);
+
 typedef struct {
     //Header
     DrvCtx_t header;
@@ -45,6 +101,15 @@ typedef struct {
     UartCtx_t uart;
     volatile unsigned int* base;
     bool txRunning;
+    // Buffered mode
+    bool buffered;
+    HPSIRQSource irqID;
+    FPGAIrDARing_t txRing;      // Filled by FPGA_IrDA_writeBuffered, emptied by IRQ
+    FPGAIrDARing_t rxRing;      // Filled by IRQ, emptied by FPGA_IrDA_readBuffered
+    FPGAIrDADecodeFunc_t decoder;
+    void* decoderParam;
+    volatile unsigned int overruns;
+    volatile unsigned int parityErrors;
 } FPGAIrDACtx_t;
 
 
@@ -107,4 +172,40 @@ UartRxData_t FPGA_IrDA_readWord(FPGAIrDACtx_t* ctx);
 //  - If the return value is negative, an error occurred in one of the words
 HpsErr_t FPGA_IrDA_read(FPGAIrDACtx_t* ctx, uint8_t data[], uint8_t length);
 
+// Start interrupt driven buffered mode
+// - irqID is the interrupt ID of the IrDA controller (e.g. IRQ_LSC_IrDA).
+// - txSize and rxSize are the ring buffer sizes in bytes, rounded up to a power of two.
+// - HPS_IRQ driver must be initialised first.
+// - Returns ERR_BUSY if already buffered.
+HpsErr_t FPGA_IrDA_startBuffered(FPGAIrDACtx_t* ctx, HPSIRQSource irqID, unsigned int txSize, unsigned int rxSize);
+
+// Stop interrupt driven buffered mode
+// - Unregisters the interrupt handler and frees the ring buffers.
+// - Any data still in the TX ring is not sent.
+// - Returns ERR_SKIPPED if not buffered.
+HpsErr_t FPGA_IrDA_stopBuffered(FPGAIrDACtx_t* ctx);
+
+// Queue data for buffered transmission
+// - Copies as much of data[] as fits in the TX ring, without waiting.
+// - Returns the number of bytes queued, or ERR_WRONGMODE if not buffered.
+HpsErr_t FPGA_IrDA_writeBuffered(FPGAIrDACtx_t* ctx, const uint8_t data[], size_t length);
+
+// Read buffered received data
+// - Copies up to length bytes from the RX ring, without waiting.
+// - Returns the number of bytes read, or ERR_WRONGMODE if not buffered.
+HpsErr_t FPGA_IrDA_readBuffered(FPGAIrDACtx_t* ctx, uint8_t data[], size_t length);
+
+// Set the receive decoder
+// - decoder is called from the interrupt handler for each byte received
+//   in buffered mode, or NULL to store all bytes in the RX ring.
+// - param is passed to the decoder.
+HpsErr_t FPGA_IrDA_setDecoder(FPGAIrDACtx_t* ctx, FPGAIrDADecodeFunc_t decoder, void* param);
+
+// Get buffered mode error counts
+// - overruns is the number of received bytes dropped due to the RX ring being full.
+// - parityErrors is the number of bytes received with a parity error.
+// - Either pointer may be NULL if not required.
+// - If clear is true, the counts are reset.
+HpsErr_t FPGA_IrDA_getBufferErrors(FPGAIrDACtx_t* ctx, unsigned int* overruns, unsigned int* parityErrors, bool clear);
+
 #endif /* FPGA_IRDACONTROLLER_H_ */
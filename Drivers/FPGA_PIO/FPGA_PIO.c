@@ -16,6 +16,10 @@
  * directly, the cached value is used in any R-M-W
  * operations.
  *
+ * The GPIO instance (ctx->gpio) provides a fast path for the
+ * unchecked GPIO_fast*() accessors in Util/driver_gpio.h, using
+ * the bit set/clear registers if the PIO has them.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -23,6 +27,9 @@
  *
  * Date       | Changes
  * -----------+-----------------------------------------
+ * 14/10/2026 | Add streaming, strobed and DMA block transfers
+ * 14/10/2026 | Add compile-time static instances
+ * 14/10/2026 | Provide GPIO fast path
  * 21/11/2024 | Add output cache to allow getOutput in all modes
  * 21/02/2024 | Conversion from struct to array indexing
  * 30/12/2023 | Creation of driver.
@@ -33,6 +40,7 @@
 
 #include "Util/irq.h"
 #include "Util/bit_helpers.h"
+#include "Util/dma_buffer.h"
 
 #include "FPGA_PIORegs.h"
 
@@ -141,40 +149,132 @@ static HpsErr_t _FPGA_PIO_clearInterruptFlags(FPGAPIOCtx_t* ctx, unsigned int ma
     return ERR_SUCCESS;
 }
 
-/*
- * User Facing APIs
- */
+static void _FPGA_PIO_writeStream(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count) {
+    volatile unsigned int* reg = &ctx->base[GPIO_OUTPUT];
+    //Unrolled to one store per word, with the loads grouped so they can be combined
+    for (; count >= 8; count -= 8, data += 8) {
+        unsigned int d0 = data[0], d1 = data[1], d2 = data[2], d3 = data[3];
+        unsigned int d4 = data[4], d5 = data[5], d6 = data[6], d7 = data[7];
+        *reg = d0; *reg = d1; *reg = d2; *reg = d3;
+        *reg = d4; *reg = d5; *reg = d6; *reg = d7;
+    }
+    for (; count; count--) {
+        *reg = *data++;
+    }
+}
 
+static void _FPGA_PIO_readStream(FPGAPIOCtx_t* ctx, unsigned int* data, unsigned int count) {
+    volatile unsigned int* reg = &ctx->base[ctx->splitData ? GPIO_SPLITINPUT : GPIO_INPUT];
+    //Unrolled to one load per word, with the stores grouped so they can be combined
+    for (; count >= 8; count -= 8, data += 8) {
+        unsigned int d0 = *reg, d1 = *reg, d2 = *reg, d3 = *reg;
+        unsigned int d4 = *reg, d5 = *reg, d6 = *reg, d7 = *reg;
+        data[0] = d0; data[1] = d1; data[2] = d2; data[3] = d3;
+        data[4] = d4; data[5] = d5; data[6] = d6; data[7] = d7;
+    }
+    for (; count; count--) {
+        *data++ = *reg;
+    }
+}
 
-// Initialise FPGA PIO Driver
-//  - base is a pointer to the PIO csr
-//  - pioType indicates whether we have inputs, outputs, both, and/or a direction pin.
-//  - splitData indicates a special case where the direction register is used for reading inputs instead of the data register.
-//  - hasEdge indicates whether we have an edge capture capability
-//  - hasIrq indicates whether we have an interrupt capability
-//  - hasBitset indicates whether this PIO uses the extended CSR
-//  - dir is the default direction for GPIO pins
-//  - port is the default output value for GPIO pins
-//  - Returns Util/error Code
-//  - Returns context pointer to *ctx
-HpsErr_t FPGA_PIO_initialise(void* base, FPGAPIODirectionType pioType, bool splitData, bool hasBitset, bool hasEdge, bool hasIrq, unsigned int dir, unsigned int port, FPGAPIOCtx_t** pCtx) {
+static void _FPGA_PIO_writeStrobed(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count, unsigned int dataMask, unsigned int strobe) {
+    unsigned int port = _FPGA_PIO_getOutputRegValue(ctx);
+    if (ctx->hasBitset) {
+        //Clear the zero data bits along with the strobe, set the one data bits, then raise the strobe
+        volatile unsigned int* set = &ctx->base[GPIO_OUT_SET];
+        volatile unsigned int* clr = &ctx->base[GPIO_OUT_CLEAR];
+        for (unsigned int idx = 0; idx < count; idx++) {
+            unsigned int word = data[idx] & dataMask;
+            *clr = (~word & dataMask) | strobe;
+            *set = word;
+            *set = strobe;
+            port = (port & ~dataMask) | word;
+        }
+        *clr = strobe;
+    } else {
+        //Write the data with the strobe low, then again with it high
+        volatile unsigned int* reg = &ctx->base[GPIO_OUTPUT];
+        port &= ~strobe;
+        for (unsigned int idx = 0; idx < count; idx++) {
+            port = (port & ~dataMask) | (data[idx] & dataMask);
+            *reg = port;
+            *reg = port | strobe;
+        }
+        *reg = port;
+    }
+    ctx->outPort = port & ~strobe;
+}
+
+// Start a DMA transfer between a buffer and the data register
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+static HpsErr_t _FPGA_PIO_dmaStart(FPGAPIOCtx_t* ctx, bool write, uintptr_t buf, unsigned int count) {
+    uintptr_t reg = (uintptr_t)&ctx->base[write ? GPIO_OUTPUT : (ctx->splitData ? GPIO_SPLITINPUT : GPIO_INPUT)];
+    ctx->dmaXfer.readAddr  = write ? buf : reg;
+    ctx->dmaXfer.writeAddr = write ? reg : buf;
+    ctx->dmaXfer.length    = count * sizeof(unsigned int);
+    ctx->dmaXfer.isLast    = true;
+    ctx->dmaXfer.index     = 0;
+    ctx->dmaXfer.params    = ctx->dmaParams;
+    ctx->dmaRunning = true;
+    HpsErr_t status = DmaBuffer_setupTransfer(ctx->dma, &ctx->dmaXfer, true);
+    if ((status == ERR_SKIPPED) || ERR_IS_ERROR(status)) ctx->dmaRunning = false;
+    return status;
+}
+
+// Progress a DMA transfer
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+static HpsErr_t _FPGA_PIO_dmaProgress(FPGAPIOCtx_t* ctx) {
+    if (!ctx->dmaRunning) return ERR_SUCCESS;
+    HpsErr_t status = DmaBuffer_transferDone(ctx->dma, &ctx->dmaXfer);
+    if (status == ERR_BUSY) return ERR_BUSY;
+    ctx->dmaRunning = false;
+    return ERR_IS_ERROR(status) ? status : ERR_SUCCESS;
+}
+
+// Setup a DMA transfer for either direction
+static HpsErr_t _FPGA_PIO_setupDma(FPGAPIOCtx_t* ctx, bool write, uintptr_t buf, unsigned int count) {
+    if (!buf) return ERR_NULLPTR;
+    if (!count) return ERR_TOOSMALL;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!(ctx->pioType & (write ? FPGA_PIO_DIRECTION_OUT : FPGA_PIO_DIRECTION_IN))) return ERR_NOSUPPORT;
+    //Must have a DMA controller, and not be running
+    if (!ctx->dma) return ERR_NOSUPPORT;
+    status = _FPGA_PIO_dmaProgress(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _FPGA_PIO_dmaStart(ctx, write, buf, count);
+    //Output will be left holding the last word
+    if (write && (ERR_IS_SUCCESS(status) || (status == ERR_SKIPPED))) {
+        ctx->outPort = ((const unsigned int*)buf)[count - 1];
+    }
+    return status;
+}
+
+// Initialise from a descriptor
+//  - Allocates the context unless desc->store is provided.
+static HpsErr_t _FPGA_PIO_initialise(const FPGAPIODesc_t* desc, FPGAPIOCtx_t** pCtx) {
     //Ensure user pointers valid
-    if (!base) return ERR_NULLPTR;
-    if (!pointerIsAligned(base, sizeof(unsigned int))) return ERR_ALIGNMENT;
-    if ((pioType == FPGA_PIO_DIRECTION_BIDIR) && splitData) return ERR_WRONGMODE;
-    //Allocate the driver context, validating return value.
-    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_FPGA_PIO_cleanup);
+    if (!desc->base) return ERR_NULLPTR;
+    if (!pointerIsAligned((void*)desc->base, sizeof(unsigned int))) return ERR_ALIGNMENT;
+    if ((desc->pioType == FPGA_PIO_DIRECTION_BIDIR) && desc->splitData) return ERR_WRONGMODE;
+    //Allocate the driver context (or claim the static one), validating return value.
+    HpsErr_t status = desc->store ? DriverContextAllocateStatic(desc->store, pCtx, &_FPGA_PIO_cleanup)
+                                  : DriverContextAllocateWithCleanup(pCtx, &_FPGA_PIO_cleanup);
     if (ERR_IS_ERROR(status)) return status;
     //Save base address pointers
     FPGAPIOCtx_t* ctx = *pCtx;
-    ctx->base = (unsigned int*)base;
+    FPGAPIODirectionType pioType = desc->pioType;
+    bool splitData = desc->splitData;
+    ctx->base = desc->base;
     ctx->pioType = pioType;
     ctx->splitData = splitData;
-    ctx->hasBitset = hasBitset;
-    ctx->hasEdge = hasEdge;
-    ctx->hasIrq = hasIrq;
-    ctx->initDir = dir;
-    ctx->initPort = port;
+    ctx->hasBitset = desc->hasBitset;
+    ctx->hasEdge = desc->hasEdge;
+    ctx->hasIrq = desc->hasIrq;
+    ctx->initDir = desc->dir;
+    ctx->initPort = desc->port;
     //Ensure no interrupts are enabled.
     ctx->base[GPIO_INTR_MASK] = 0x0;
     ctx->base[GPIO_INTR_FLAGS] = UINT32_MAX;
@@ -185,7 +285,7 @@ HpsErr_t FPGA_PIO_initialise(void* base, FPGAPIODirectionType pioType, bool spli
         ctx->gpio.getDirection = (GpioReadFunc_t)&FPGA_PIO_getDirection;
         ctx->gpio.setDirection = (GpioWriteFunc_t)&FPGA_PIO_setDirection;
         //Initialise the direction register
-        ctx->base[GPIO_DIRECTION] = dir;
+        ctx->base[GPIO_DIRECTION] = desc->dir;
     }
     if (pioType & FPGA_PIO_DIRECTION_OUT) {
         //Enable write APIs
@@ -193,8 +293,8 @@ HpsErr_t FPGA_PIO_initialise(void* base, FPGAPIODirectionType pioType, bool spli
         ctx->gpio.setOutput    = (GpioWriteFunc_t)&FPGA_PIO_setOutput;
         ctx->gpio.toggleOutput = (GpioToggleFunc_t)&FPGA_PIO_toggleOutput;
         //Initialise the output register
-        ctx->base[GPIO_OUTPUT] = port;
-        ctx->outPort           = port;
+        ctx->base[GPIO_OUTPUT] = desc->port;
+        ctx->outPort           = desc->port;
     }
     if (pioType & FPGA_PIO_DIRECTION_IN) {
         //Enable read APIs
@@ -205,11 +305,62 @@ HpsErr_t FPGA_PIO_initialise(void* base, FPGAPIODirectionType pioType, bool spli
         // unless the hardware uses the special splitData mode.
         ctx->usePortCache = !splitData;
     }
+    //Populate the GPIO fast path
+    if (pioType & FPGA_PIO_DIRECTION_OUT) {
+        ctx->gpio.fast.out = &ctx->base[GPIO_OUTPUT];
+        if (desc->hasBitset) {
+            ctx->gpio.fast.outSet   = &ctx->base[GPIO_OUT_SET];
+            ctx->gpio.fast.outClear = &ctx->base[GPIO_OUT_CLEAR];
+        }
+        if (ctx->usePortCache) {
+            ctx->gpio.fast.cache = &ctx->outPort;
+        }
+    }
+    if (pioType & FPGA_PIO_DIRECTION_IN) {
+        ctx->gpio.fast.in = &ctx->base[splitData ? GPIO_SPLITINPUT : GPIO_INPUT];
+    }
     //Initialised
     DriverContextSetInit(ctx);
     return ERR_SUCCESS;
 }
 
+
+/*
+ * User Facing APIs
+ */
+
+
+// Initialise FPGA PIO Driver
+//  - base is a pointer to the PIO csr
+//  - pioType indicates whether we have inputs, outputs, both, and/or a direction pin.
+//  - splitData indicates a special case where the direction register is used for reading inputs instead of the data register.
+//  - hasEdge indicates whether we have an edge capture capability
+//  - hasIrq indicates whether we have an interrupt capability
+//  - hasBitset indicates whether this PIO uses the extended CSR
+//  - dir is the default direction for GPIO pins
+//  - port is the default output value for GPIO pins
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t FPGA_PIO_initialise(void* base, FPGAPIODirectionType pioType, bool splitData, bool hasBitset, bool hasEdge, bool hasIrq, unsigned int dir, unsigned int port, FPGAPIOCtx_t** pCtx) {
+    FPGAPIODesc_t desc = {
+        .base = (volatile unsigned int*)base, .pioType = pioType, .splitData = splitData,
+        .hasBitset = hasBitset, .hasEdge = hasEdge, .hasIrq = hasIrq,
+        .dir = dir, .port = port, .store = NULL
+    };
+    return _FPGA_PIO_initialise(&desc, pCtx);
+}
+
+// Initialise FPGA PIO Driver from a static descriptor
+//  - desc is a descriptor declared with FPGA_PIO_STATIC().
+//  - Uses the descriptor's storage for the context, so does not allocate.
+//  - Returns ERR_INUSE if the instance is already initialised.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t FPGA_PIO_initialiseStatic(const FPGAPIODesc_t* desc, FPGAPIOCtx_t** pCtx) {
+    if (!desc || !desc->store) return ERR_NULLPTR;
+    return _FPGA_PIO_initialise(desc, pCtx);
+}
+
 // Check if driver initialised
 //  - Returns true if driver previously initialised
 bool FPGA_PIO_isInitialised(FPGAPIOCtx_t* ctx) {
@@ -358,3 +509,117 @@ HpsErr_t FPGA_PIO_clearInterruptFlags(FPGAPIOCtx_t* ctx, unsigned int mask) {
     if (!ctx->hasEdge) return ERR_NOSUPPORT;
     return _FPGA_PIO_clearInterruptFlags(ctx, mask);
 }
+
+//Write a stream of words
+// - Writes count words from data to the output register in turn.
+// - The output cache is left holding the last word.
+// - Only supported if pio type has FPGA_PIO_DIRECTION_OUT capability.
+// - Returns ERR_BUSY if a DMA transfer is running.
+HpsErr_t FPGA_PIO_writeStream(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count) {
+    if (!data) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!(ctx->pioType & FPGA_PIO_DIRECTION_OUT)) return ERR_NOSUPPORT;
+    if (ctx->dmaRunning) return ERR_BUSY;
+    if (!count) return ERR_SUCCESS;
+    //Write the words, then update our shadow copy
+    _FPGA_PIO_writeStream(ctx, data, count);
+    ctx->outPort = data[count - 1];
+    return ERR_SUCCESS;
+}
+
+//Read a stream of words
+// - Reads the input register count times into data.
+// - Only supported if pio type has FPGA_PIO_DIRECTION_IN capability.
+// - Returns ERR_BUSY if a DMA transfer is running.
+HpsErr_t FPGA_PIO_readStream(FPGAPIOCtx_t* ctx, unsigned int* data, unsigned int count) {
+    if (!data) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!(ctx->pioType & FPGA_PIO_DIRECTION_IN)) return ERR_NOSUPPORT;
+    if (ctx->dmaRunning) return ERR_BUSY;
+    _FPGA_PIO_readStream(ctx, data, count);
+    return ERR_SUCCESS;
+}
+
+//Write a stream of words with a strobe
+// - For each of count words, sets the dataMask pins to the word with the
+//   strobe pins low, then raises the strobe pins. The strobe is lowered
+//   again after the last word.
+// - Pins not in dataMask or strobe are unchanged.
+// - Uses the bit set/clear registers if the PIO has them.
+// - Returns ERR_BADID if strobe is zero or overlaps dataMask.
+// - Only supported if pio type has FPGA_PIO_DIRECTION_OUT capability.
+HpsErr_t FPGA_PIO_writeStrobed(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count, unsigned int dataMask, unsigned int strobe) {
+    if (!data) return ERR_NULLPTR;
+    if (!strobe || (strobe & dataMask)) return ERR_BADID;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!(ctx->pioType & FPGA_PIO_DIRECTION_OUT)) return ERR_NOSUPPORT;
+    if (ctx->dmaRunning) return ERR_BUSY;
+    _FPGA_PIO_writeStrobed(ctx, data, count, dataMask, strobe);
+    return ERR_SUCCESS;
+}
+
+//Assign a DMA controller for stream transfers
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transfer is running.
+HpsErr_t FPGA_PIO_setDma(FPGAPIOCtx_t* ctx, DmaCtx_t* dma, void* dmaParams) {
+    if (dma && !DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't change while running
+    status = _FPGA_PIO_dmaProgress(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->dma = dma;
+    ctx->dmaParams = dmaParams;
+    return ERR_SUCCESS;
+}
+
+//Write a stream of words using DMA
+// - As FPGA_PIO_writeStream(), but performed by the DMA controller.
+// - data must remain valid until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous transfer is still running.
+HpsErr_t FPGA_PIO_writeStreamDma(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count) {
+    return _FPGA_PIO_setupDma(ctx, true, (uintptr_t)data, count);
+}
+
+//Read a stream of words using DMA
+// - As FPGA_PIO_readStream(), but performed by the DMA controller.
+// - data must not be accessed until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous transfer is still running.
+HpsErr_t FPGA_PIO_readStreamDma(FPGAPIOCtx_t* ctx, unsigned int* data, unsigned int count) {
+    return _FPGA_PIO_setupDma(ctx, false, (uintptr_t)data, count);
+}
+
+//Check if a DMA stream transfer is done
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+HpsErr_t FPGA_PIO_streamDmaDone(FPGAPIOCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check progress
+    return _FPGA_PIO_dmaProgress(ctx);
+}
+
+//Signal that a DMA stream transfer has completed
+// - For use from a DMA completion callback, passing the callback result.
+// - Returns the result, or ERR_SKIPPED if no transfer was running.
+HpsErr_t FPGA_PIO_streamDmaCompleted(FPGAPIOCtx_t* ctx, HpsErr_t result) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->dmaRunning) return ERR_SKIPPED;
+    //Completion maintenance, as DmaBuffer_transferDone() would have done
+    if (ERR_IS_SUCCESS(result)) DmaBuffer_complete(&ctx->dmaXfer);
+    ctx->dmaRunning = false;
+    return result;
+}
@@ -16,6 +16,62 @@
  * directly, the cached value is used in any R-M-W
  * operations.
  *
+ * The GPIO instance (ctx->gpio) provides a fast path for the
+ * unchecked GPIO_fast*() accessors in Util/driver_gpio.h, using
+ * the bit set/clear registers if the PIO has them.
+ *
+ * Streaming
+ * ---------
+ *
+ * For FPGA cores which use a PIO as a streaming port, blocks of
+ * words can be written to or read from the data register with
+ * FPGA_PIO_writeStream()/FPGA_PIO_readStream(), which use unrolled
+ * register accesses to keep the per-word overhead to a single
+ * bus access.
+ *
+ * Where the core latches data on a strobe pin, use
+ * FPGA_PIO_writeStrobed(). For each word, the data pins are
+ * updated with the strobe low, then the strobe is raised. With
+ * the bit set/clear registers, only the data and strobe pins are
+ * changed, so other pins of the PIO can be safely driven from
+ * elsewhere (e.g. an ISR), otherwise the output register is
+ * written from the output cache.
+ *
+ * Alternatively, a DMA controller can be assigned with
+ * FPGA_PIO_setDma(), and FPGA_PIO_writeStreamDma()/
+ * FPGA_PIO_readStreamDma() used to start a transfer, polling
+ * FPGA_PIO_streamDmaDone() for completion. For HPS_DMAController,
+ * pass the ->dma of an allocated channel, with dmaParams from
+ * HPS_DMA_initParameters() and then transferWidth set to
+ * HPS_DMA_BURSTSIZE_4BYTE, and destType (for writes) or srcType
+ * (for reads) set to _REGISTER so that the data register address
+ * is not incremented. As with HPS_UART, a channel callback can
+ * call FPGA_PIO_streamDmaCompleted() instead of polling. Cache
+ * maintenance is handled automatically (Util/dma_buffer.h).
+ *
+ * Only one DMA transfer can run at a time, and while it is, the
+ * other stream and output APIs should not be used.
+ *
+ * Static Instances
+ * ----------------
+ *
+ * A PIO can be declared at file scope with FPGA_PIO_STATIC(), which
+ * places its base address and configuration in a const descriptor
+ * alongside static storage for its context. The arguments are
+ * checked at compile time, and FPGA_PIO_initialiseStatic() then
+ * brings it up without allocating:
+ *
+ *    FPGA_PIO_STATIC(ledPio, LSC_BASE_RED_LEDS, FPGA_PIO_DIRECTION_OUT, false, false, false, false, 0, 0);
+ *
+ *    FPGA_PIO_initialiseStatic(&ledPio, &leds);
+ *    FPGA_PIO_staticSetOutput(&ledPio, 0x3FF, UINT32_MAX);
+ *
+ * The FPGA_PIO_static*() helpers are unchecked inline accessors
+ * given the descriptor. As it is const, the compiler can fold the
+ * base address and capabilities into the caller. They keep the
+ * context's output cache up to date, so can be mixed with the
+ * other APIs, but must only be used once initialised.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -23,6 +79,9 @@
  *
  * Date       | Changes
  * -----------+-----------------------------------------
+ * 14/10/2026 | Add streaming, strobed and DMA block transfers
+ * 14/10/2026 | Add compile-time static instances
+ * 14/10/2026 | Provide GPIO fast path
  * 21/11/2024 | Add output cache to allow getOutput in all modes
  * 21/02/2024 | Conversion from struct to array indexing
  * 30/12/2023 | Creation of driver.
@@ -37,6 +96,7 @@
 #include "Util/macros.h"
 #include "Util/driver_ctx.h"
 #include "Util/driver_gpio.h"
+#include "Util/driver_dma.h"
 
 typedef enum {
     FPGA_PIO_DIRECTION_IN    = _BV(0),
@@ -77,8 +137,41 @@ typedef struct {
     unsigned int initDir;
     unsigned int outPort;
     GpioCtx_t gpio;
+    // DMA streaming
+    DmaCtx_t* dma;          // DMA controller, or NULL if not assigned
+    void* dmaParams;        // Optional DMA controller parameters
+    DmaChunk_t dmaXfer;
+    bool dmaRunning;
 } FPGAPIOCtx_t;
 
+// Static PIO instance descriptor. See FPGA_PIO_STATIC().
+typedef struct {
+    volatile unsigned int* base;
+    FPGAPIODirectionType pioType;
+    bool splitData;
+    bool hasBitset;
+    bool hasEdge;
+    bool hasIrq;
+    unsigned int dir;
+    unsigned int port;
+    FPGAPIOCtx_t* store;    // Static storage for the context
+} FPGAPIODesc_t;
+
+// Declare a static PIO instance
+//  - Defines a const descriptor called name, and storage for its context.
+//  - Arguments are as for FPGA_PIO_initialise(). base must be a constant address.
+//  - Fails to compile if base is NULL or unaligned, or if a BIDIR PIO uses splitData.
+#define FPGA_PIO_STATIC(name, pBase, pType, pSplit, pBitset, pEdge, pIrq, pDir, pPort)       \
+    ct_assert_expr(name##_base, (size_t)(pBase) != 0);                                         \
+    ct_assert_aligned(name##_align, (size_t)(pBase), sizeof(unsigned int), 0);                 \
+    ct_assert_expr(name##_mode, !(((pType) == FPGA_PIO_DIRECTION_BIDIR) && (pSplit)));         \
+    static FPGAPIOCtx_t name##_store;                                                          \
+    static const FPGAPIODesc_t name = {                                                        \
+        .base = (volatile unsigned int*)(pBase), .pioType = (pType), .splitData = (pSplit),    \
+        .hasBitset = (pBitset), .hasEdge = (pEdge), .hasIrq = (pIrq),                          \
+        .dir = (pDir), .port = (pPort), .store = &name##_store                                 \
+    }
+
 // Initialise FPGA PIO Driver
 //  - base is a pointer to the PIO csr
 //  - pioType indicates whether we have inputs, outputs, both, and/or a direction pin.
@@ -92,10 +185,121 @@ typedef struct {
 //  - Returns context pointer to *ctx
 HpsErr_t FPGA_PIO_initialise(void* base, FPGAPIODirectionType pioType, bool splitData, bool hasBitset, bool hasEdge, bool hasIrq, unsigned int dir, unsigned int port, FPGAPIOCtx_t** pCtx);
 
+// Initialise FPGA PIO Driver from a static descriptor
+//  - desc is a descriptor declared with FPGA_PIO_STATIC().
+//  - Uses the descriptor's storage for the context, so does not allocate.
+//  - Returns ERR_INUSE if the instance is already initialised.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t FPGA_PIO_initialiseStatic(const FPGAPIODesc_t* desc, FPGAPIOCtx_t** pCtx);
+
 // Check if driver initialised
 //  - Returns true if driver previously initialised
 bool FPGA_PIO_isInitialised(FPGAPIOCtx_t* ctx);
 
+//Write a stream of words
+// - Writes count words from data to the output register in turn.
+// - The output cache is left holding the last word.
+// - Only supported if pio type has FPGA_PIO_DIRECTION_OUT capability.
+// - Returns ERR_BUSY if a DMA transfer is running.
+HpsErr_t FPGA_PIO_writeStream(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count);
+
+//Read a stream of words
+// - Reads the input register count times into data.
+// - Only supported if pio type has FPGA_PIO_DIRECTION_IN capability.
+// - Returns ERR_BUSY if a DMA transfer is running.
+HpsErr_t FPGA_PIO_readStream(FPGAPIOCtx_t* ctx, unsigned int* data, unsigned int count);
+
+//Write a stream of words with a strobe
+// - For each of count words, sets the dataMask pins to the word with the
+//   strobe pins low, then raises the strobe pins. The strobe is lowered
+//   again after the last word.
+// - Pins not in dataMask or strobe are unchanged.
+// - Uses the bit set/clear registers if the PIO has them.
+// - Returns ERR_BADID if strobe is zero or overlaps dataMask.
+// - Only supported if pio type has FPGA_PIO_DIRECTION_OUT capability.
+HpsErr_t FPGA_PIO_writeStrobed(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count, unsigned int dataMask, unsigned int strobe);
+
+//Assign a DMA controller for stream transfers
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transfer is running.
+HpsErr_t FPGA_PIO_setDma(FPGAPIOCtx_t* ctx, DmaCtx_t* dma, void* dmaParams);
+
+//Write a stream of words using DMA
+// - As FPGA_PIO_writeStream(), but performed by the DMA controller.
+// - data must remain valid until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous transfer is still running.
+HpsErr_t FPGA_PIO_writeStreamDma(FPGAPIOCtx_t* ctx, const unsigned int* data, unsigned int count);
+
+//Read a stream of words using DMA
+// - As FPGA_PIO_readStream(), but performed by the DMA controller.
+// - data must not be accessed until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous transfer is still running.
+HpsErr_t FPGA_PIO_readStreamDma(FPGAPIOCtx_t* ctx, unsigned int* data, unsigned int count);
+
+//Check if a DMA stream transfer is done
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+HpsErr_t FPGA_PIO_streamDmaDone(FPGAPIOCtx_t* ctx);
+
+//Signal that a DMA stream transfer has completed
+// - For use from a DMA completion callback, passing the callback result.
+// - Returns the result, or ERR_SKIPPED if no transfer was running.
+HpsErr_t FPGA_PIO_streamDmaCompleted(FPGAPIOCtx_t* ctx, HpsErr_t result);
+
+/*
+ * Static Instance Accessors
+ *  - Unchecked. The instance must be initialised, and have the
+ *    required direction capability.
+ */
+
+// Register offsets used by the accessors. Match FPGA_PIORegs.h.
+#define FPGA_PIO_REG_DATA    (0x00 / sizeof(unsigned int))
+#define FPGA_PIO_REG_SPLITIN (0x04 / sizeof(unsigned int))
+#define FPGA_PIO_REG_OUTSET  (0x10 / sizeof(unsigned int))
+#define FPGA_PIO_REG_OUTCLR  (0x14 / sizeof(unsigned int))
+
+// Set the value of masked output pins
+static inline void FPGA_PIO_staticSetOutput(const FPGAPIODesc_t* desc, unsigned int port, unsigned int mask) {
+    FPGAPIOCtx_t* ctx = desc->store;
+    if (mask != UINT32_MAX) {
+        unsigned int cur = ctx->usePortCache ? ctx->outPort : desc->base[FPGA_PIO_REG_DATA];
+        port = (port & mask) | (cur & ~mask);
+    }
+    desc->base[FPGA_PIO_REG_DATA] = port;
+    ctx->outPort = port;
+}
+
+// Set masked output pins high
+//  - Uses the bit set register if the PIO has one.
+static inline void FPGA_PIO_staticBitset(const FPGAPIODesc_t* desc, unsigned int mask) {
+    if (desc->hasBitset) {
+        desc->base[FPGA_PIO_REG_OUTSET] = mask;
+        desc->store->outPort |= mask;
+    } else {
+        FPGA_PIO_staticSetOutput(desc, UINT32_MAX, mask);
+    }
+}
+
+// Set masked output pins low
+//  - Uses the bit clear register if the PIO has one.
+static inline void FPGA_PIO_staticBitclear(const FPGAPIODesc_t* desc, unsigned int mask) {
+    if (desc->hasBitset) {
+        desc->base[FPGA_PIO_REG_OUTCLR] = mask;
+        desc->store->outPort &= ~mask;
+    } else {
+        FPGA_PIO_staticSetOutput(desc, 0, mask);
+    }
+}
+
+// Read the value of masked input pins
+static inline unsigned int FPGA_PIO_staticGetInput(const FPGAPIODesc_t* desc, unsigned int mask) {
+    return desc->base[desc->splitData ? FPGA_PIO_REG_SPLITIN : FPGA_PIO_REG_DATA] & mask;
+}
+
 //Set direction
 // - Setting a bit to 1 means output, while 0 means input.
 // - Will perform read-modify-write such that only pins with
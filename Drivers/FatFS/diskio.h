@@ -30,9 +30,45 @@ DSTATUS disk_initialize (BYTE pdrv);
 DSTATUS disk_status (BYTE pdrv);
 DRESULT disk_read (BYTE pdrv, BYTE* buff, LBA_t sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count);
-DRESULT disk_verify (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
+DRESULT disk_verify (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count);
+DRESULT disk_verify_crc (BYTE pdrv, LBA_t sector, UINT count, DWORD crc);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 
+/* Asynchronous (non-blocking) sector access */
+DRESULT disk_read_start (BYTE pdrv, BYTE* buff, LBA_t sector, UINT count);
+DRESULT disk_write_start (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count);
+DRESULT disk_xfer_poll (BYTE pdrv);
+
+/* Physical drives */
+#define DEV_MMC		0	/* SD/MMC card */
+#define DEV_RAM		1	/* RAM disk (see FF_RAMDISK_SIZE) */
+
+/* RAM disk memory, if not given by FF_RAMDISK_SIZE */
+DRESULT disk_ramdisk_set (BYTE* base, LBA_t count);
+
+/* Binary trace of card transfers (enabled by FF_SDMMC_TRACE_DEPTH) */
+typedef struct {
+	DWORD	seq;		/* Sequence number of the transfer */
+	LBA_t	sector;		/* Start sector */
+	DWORD	count;		/* Number of sectors */
+	BYTE	op;			/* DISK_TRACE_xxx */
+	int		result;		/* Status code from the SDMMC driver (0 = success) */
+} DISK_TRACE;
+
+#define DISK_TRACE_READ			0
+#define DISK_TRACE_WRITE		1
+#define DISK_TRACE_VERIFY		2
+#define DISK_TRACE_ASYNC_READ	3
+#define DISK_TRACE_ASYNC_WRITE	4
+
+UINT disk_trace_get (DISK_TRACE* buff, UINT len);
+
+/* Sector cache preload (MMC_CACHE_PRELOAD) */
+typedef struct {
+	LBA_t	sector;		/* First sector */
+	UINT	count;		/* Number of sectors. Set to the number loaded into the cache */
+} DISK_PRELOAD;
+
 
 /* Disk Status Bits (DSTATUS) */
 
@@ -62,6 +98,8 @@ DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 #define MMC_GET_CID			12	/* Get CID */
 #define MMC_GET_OCR			13	/* Get OCR */
 #define MMC_GET_SDSTAT		14	/* Get SD status */
+#define MMC_PRE_ERASE		15	/* Enable/disable ACMD23 pre-erase and allocation unit aligned writes (BYTE) */
+#define MMC_CACHE_PRELOAD	16	/* Read a run of sectors into the sector cache in one transfer (DISK_PRELOAD) */
 #define ISDIO_READ			55	/* Read data form SD iSDIO register */
 #define ISDIO_WRITE			56	/* Write data to SD iSDIO register */
 #define ISDIO_MRITE			57	/* Masked write data to SD iSDIO register */
@@ -14,24 +14,38 @@
 #include "diskio.h"		/* Declarations of disk functions */
 // Minimal Altera HWLib for SD-Card (hwlib/)
 #include "Util/hwlib/alt_sdmmc.h"
+#include "Util/hwlib/alt_cache.h"
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include "Util/watchdog.h"
+#include "Util/irq.h"
+#include "Util/crc32.h"
 
 
+// Debug messages
+//  - Define FF_DEBUG to print messages through the verbosity levels of
+//    Util/verbosity.h, i.e. errors as VERBOSE_ERROR, card details as
+//    VERBOSE_INFO and each transfer as VERBOSE_EXTRAINFO. Without FF_DEBUG
+//    all messages are compiled out.
 #ifdef FF_DEBUG
-    //Include printf headers if debugging
     #include <stdio.h>
+    #include "Util/verbosity.h"
+    #define FF_LOG(level, ...) DbgPrintf(level, __VA_ARGS__)
 #else
-    //Disable printf if not debugging
-    #define printf(...) (0)
+    #define FF_LOG(level, ...) ((void)0)
 #endif
 
-#ifdef FF_MULTI_PARTITION
-PARTITION VolToPart[] __attribute__((weak)) = {};
+#if FF_MULTI_PARTITION
+// Default drives: "0:" is the SD card, "1:" the RAM disk
+PARTITION VolToPart[FF_VOLUMES] __attribute__((weak)) = {
+    {DEV_MMC, 0},
+    {DEV_RAM, 0}
+};
 #endif
 
+// Widest bus width to use. The widest width supported by both this and the
+// card is chosen during initialisation.
 #ifndef FF_SDMMC_BUS_WIDTH
     #ifdef __ARRIA10__
     #define FF_SDMMC_BUS_WIDTH ALT_SDMMC_BUS_WIDTH_1
@@ -40,6 +54,76 @@ PARTITION VolToPart[] __attribute__((weak)) = {};
     #endif
 #endif
 
+// Fastest card clock to use in Hz. If the card supports High-Speed mode it is
+// switched into it with CMD6 and clocked at 50MHz, otherwise the fastest rate
+// from its CSD (at most 25MHz) is used. The Arria 10 HWLib does not support
+// switching, so is limited to default speed.
+#ifndef FF_SDMMC_MAX_SPEED
+    #ifdef __ARRIA10__
+    #define FF_SDMMC_MAX_SPEED ALT_SDMMC_TRANSFER_SPEED_DEFAULT
+    #else
+    #define FF_SDMMC_MAX_SPEED ALT_SDMMC_TRANSFER_SPEED_HIGH
+    #endif
+#endif
+
+// Maximum number of sectors per multi-block transfer. Larger requests are
+// split into several transfers so that the watchdog can be reset between them.
+#ifndef FF_SDMMC_MAX_BURST
+#define FF_SDMMC_MAX_BURST 128
+#endif
+
+// Set to 1 to prepare SD cards for multi-block writes. Before each CMD25 the
+// card is told how many blocks are coming (ACMD23) so it can erase them ahead
+// of the data, and writes are split so that no transfer crosses an allocation
+// unit (AU) boundary, with the AU size read from the SD status register. This
+// reduces the internal garbage collection stalls a card makes during long
+// sequential writes. Can be changed at run time with the MMC_PRE_ERASE ioctl.
+#ifndef FF_SDMMC_PRE_ERASE
+#define FF_SDMMC_PRE_ERASE 1
+#endif
+
+// Size in bytes of the aligned bounce buffer used for transfers to/from buffers
+// which are not 32-bit aligned (the SDMMC DMA requires aligned addresses). Must
+// hold at least one sector.
+#ifndef FF_SDMMC_BOUNCE_SIZE
+#define FF_SDMMC_BOUNCE_SIZE 4096
+#endif
+#if FF_SDMMC_BOUNCE_SIZE < 512
+#error "FF_SDMMC_BOUNCE_SIZE must be at least one sector (512 bytes)"
+#endif
+
+// Number of 512 byte sectors held in the sector cache. Set to 0 to disable the cache.
+#ifndef FF_SDMMC_CACHE_SECTORS
+#define FF_SDMMC_CACHE_SECTORS 32
+#endif
+
+// Number of sectors read into the cache on a miss (limited by FF_SDMMC_BOUNCE_SIZE)
+#ifndef FF_SDMMC_READ_AHEAD
+#define FF_SDMMC_READ_AHEAD 8
+#endif
+
+// Transfers of more than this many sectors bypass the cache
+#ifndef FF_SDMMC_CACHE_MAX_XFER
+#define FF_SDMMC_CACHE_MAX_XFER 2
+#endif
+
+// Number of entries in the binary trace of card transfers (see disk_trace_get).
+// Much cheaper than FF_DEBUG messages, so can be left on while profiling. Set
+// to 0 to disable.
+#ifndef FF_SDMMC_TRACE_DEPTH
+#define FF_SDMMC_TRACE_DEPTH 0
+#endif
+
+// Size in bytes of the RAM disk (drive DEV_RAM). If FF_RAMDISK_BASE is defined
+// the RAM disk is held at that address, otherwise in a static buffer. Set to 0
+// to provide the memory at run time with disk_ramdisk_set() instead.
+#ifndef FF_RAMDISK_SIZE
+#define FF_RAMDISK_SIZE 0
+#endif
+#if (FF_RAMDISK_SIZE % 512) != 0
+#error "FF_RAMDISK_SIZE must be a whole number of sectors (512 bytes)"
+#endif
+
 
 
 /*-----------------------------------------------------------------------*/
@@ -78,6 +162,240 @@ static uint32_t Sdmmc_Sector_Size;
 // Card Initialised
 static bool Sdmmc_Initialised = false;
 
+// SD status register (ACMD13) of SD cards, in the order sent by the card
+static uint32_t Sdmmc_Sd_Status[ALT_SDMMC_SD_STATUS_SIZE/sizeof(uint32_t)] __attribute__((aligned(ALT_CACHE_LINE_SIZE)));
+static bool Sdmmc_Sd_Status_Valid = false;
+
+// Allocation unit size in sectors from the SD status, 0 if unknown.
+static uint32_t Sdmmc_Au_Sectors = 0;
+
+// Whether multi-block writes are pre-erased and kept within an allocation unit
+static bool Sdmmc_Pre_Erase = false;
+static bool Sdmmc_Pre_Erase_Enabled = FF_SDMMC_PRE_ERASE;
+
+// Aligned bounce buffer for non-aligned transfers, and number of sectors it holds
+static uint32_t Sdmmc_Bounce_Buff[FF_SDMMC_BOUNCE_SIZE/sizeof(uint32_t)] __attribute__((aligned(ALT_CACHE_LINE_SIZE)));
+static UINT Sdmmc_Bounce_Sectors;
+
+// Asynchronous transfer in progress (see disk_read_start). Blocking accesses
+// are refused while this is set.
+static volatile bool Sdmmc_Async_Active = false;
+
+// Check that a run of sectors lies within the card
+static inline bool sdmmc_in_range (LBA_t sector, UINT count) {
+    uint64_t total = Sdmmc_Device_Size / Sdmmc_Sector_Size;
+    return (sector < total) && (count <= (total - sector));
+}
+
+// Convert a sector to a card block number. SD/MMC block numbers are 32-bit,
+// so cards of up to 2TB (SDXC) can be addressed with 512 byte blocks.
+static inline uint32_t sdmmc_block (LBA_t sector) {
+    return (uint32_t)(((uint64_t)sector * Sdmmc_Sector_Size) / Sdmmc_Block_Size);
+}
+
+#if FF_SDMMC_CACHE_SECTORS > 0
+// Sector cache (see below)
+static void sdmmc_cache_reset (void);
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Transfer Trace                                                        */
+/*-----------------------------------------------------------------------*/
+// Ring of the most recent card transfers. Each entry is a few words written
+// with no formatting, so tracing barely changes the timing being measured.
+
+#if FF_SDMMC_TRACE_DEPTH > 0
+static DISK_TRACE Sdmmc_Trace[FF_SDMMC_TRACE_DEPTH];
+static DWORD Sdmmc_Trace_Seq = 0;
+
+// Record a card transfer
+static void sdmmc_trace (BYTE op, LBA_t sector, UINT count, int result) {
+    DISK_TRACE* entry = &Sdmmc_Trace[Sdmmc_Trace_Seq % FF_SDMMC_TRACE_DEPTH];
+    entry->seq = Sdmmc_Trace_Seq++;
+    entry->sector = sector;
+    entry->count = count;
+    entry->op = op;
+    entry->result = result;
+}
+#else
+#define sdmmc_trace(op, sector, count, result) ((void)0)
+#endif
+
+// Get the transfer trace
+//  - Copies up to len of the most recent entries to buff, oldest first, and
+//    returns the number copied. Gaps in seq show entries which were overwritten.
+//  - Returns 0 if FF_SDMMC_TRACE_DEPTH is 0.
+UINT disk_trace_get (
+    DISK_TRACE* buff,   /* Buffer to receive the entries */
+    UINT len            /* Size of buff in entries */
+)
+{
+#if FF_SDMMC_TRACE_DEPTH > 0
+    if (!buff) return 0;
+    HpsErr_t irqState = IRQ_globalEnable(false);
+    DWORD seq = Sdmmc_Trace_Seq;
+    UINT num = (seq > FF_SDMMC_TRACE_DEPTH) ? FF_SDMMC_TRACE_DEPTH : (UINT)seq;
+    if (num > len) num = len;
+    for (UINT idx = 0; idx < num; idx++) {
+        buff[idx] = Sdmmc_Trace[(seq - num + idx) % FF_SDMMC_TRACE_DEPTH];
+    }
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+    return num;
+#else
+    (void)buff;
+    (void)len;
+    return 0;
+#endif
+}
+
+/*-----------------------------------------------------------------------*/
+/* RAM Disk                                                              */
+/*-----------------------------------------------------------------------*/
+// Drive DEV_RAM is a region of memory, normally DDR, with 512 byte sectors.
+// Transfers are simple copies, so are much faster than the card and leave it
+// free, e.g. for scratch files or copies of SD assets made at boot. Nothing
+// is kept over a power cycle, so format it with f_mkfs before first use.
+//
+// Asynchronous transfers complete as they are started, so use polling or an
+// event to complete them rather than the SDMMC interrupt.
+
+#if FF_RAMDISK_SIZE > 0 && !defined(FF_RAMDISK_BASE)
+static uint32_t Ramdisk_Buff[FF_RAMDISK_SIZE/sizeof(uint32_t)];
+#define FF_RAMDISK_BASE Ramdisk_Buff
+#endif
+
+#if FF_RAMDISK_SIZE > 0
+static BYTE* Ramdisk_Base = (BYTE*)(FF_RAMDISK_BASE);
+static LBA_t Ramdisk_Sectors = FF_RAMDISK_SIZE / FF_MIN_SS;
+#else
+static BYTE* Ramdisk_Base = NULL;
+static LBA_t Ramdisk_Sectors = 0;
+#endif
+static bool Ramdisk_Initialised = false;
+static DRESULT Ramdisk_Async_Result = RES_OK;
+
+// Set the RAM disk memory
+//  - The RAM disk is held in the count sectors at base, which must stay
+//    valid while the drive is in use. Replaces any FF_RAMDISK_SIZE region.
+//  - Unmount the drive first. It must be initialised again before use.
+DRESULT disk_ramdisk_set (
+    BYTE* base,         /* Start of the RAM disk memory */
+    LBA_t count         /* Size of the RAM disk in sectors */
+)
+{
+    if (!base || !count) {
+        return RES_PARERR;
+    }
+    Ramdisk_Initialised = false;
+    Ramdisk_Base = base;
+    Ramdisk_Sectors = count;
+    return RES_OK;
+}
+
+// Check that a run of sectors lies within the RAM disk
+static inline bool ramdisk_in_range (LBA_t sector, UINT count) {
+    return (sector < Ramdisk_Sectors) && (count <= (Ramdisk_Sectors - sector));
+}
+
+// Address of a RAM disk sector
+static inline BYTE* ramdisk_addr (LBA_t sector) {
+    return Ramdisk_Base + ((uintptr_t)sector * FF_MIN_SS);
+}
+
+static DSTATUS ramdisk_status (void) {
+    if (!Ramdisk_Base) {
+        return STA_NOINIT + STA_NODISK; //No memory given.
+    }
+    return Ramdisk_Initialised ? 0 : STA_NOINIT;
+}
+
+static DSTATUS ramdisk_initialize (void) {
+    Ramdisk_Initialised = (Ramdisk_Base != NULL);
+    Ramdisk_Async_Result = RES_OK;
+    FF_LOG(VERBOSE_INFO, "INFO: RAM disk of %u sectors at 0x%08x.\n", (UINT)Ramdisk_Sectors, (UINT)Ramdisk_Base);
+    return ramdisk_status();
+}
+
+static DRESULT ramdisk_read (BYTE* buff, LBA_t sector, UINT count) {
+    if (!Ramdisk_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    if (!buff || !ramdisk_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+    memcpy(buff, ramdisk_addr(sector), count * FF_MIN_SS);
+    return RES_OK;
+}
+
+static DRESULT ramdisk_write (const BYTE* buff, LBA_t sector, UINT count) {
+    if (!Ramdisk_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    if (!buff || !ramdisk_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+    memcpy(ramdisk_addr(sector), buff, count * FF_MIN_SS);
+    return RES_OK;
+}
+
+static DRESULT ramdisk_verify (const BYTE* buff, LBA_t sector, UINT count) {
+    if (!Ramdisk_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    if (!ramdisk_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+    const BYTE* data = ramdisk_addr(sector);
+    if (buff) {
+        return memcmp(buff, data, count * FF_MIN_SS) ? RES_ERROR : RES_OK;
+    }
+    // No buffer, verify against being all zeros.
+    for (UINT idx = 0; idx < (count * FF_MIN_SS); idx++) {
+        if (data[idx]) {
+            return RES_ERROR;
+        }
+    }
+    return RES_OK;
+}
+
+static DRESULT ramdisk_verify_crc (LBA_t sector, UINT count, DWORD crc) {
+    if (!Ramdisk_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    if (!ramdisk_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+    uint32_t readCrc = crc32(0, ramdisk_addr(sector), count * FF_MIN_SS);
+    return (readCrc != crc) ? RES_ERROR : RES_OK;
+}
+
+static DRESULT ramdisk_ioctl (BYTE cmd, void* buff) {
+    if (!Ramdisk_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    switch (cmd) {
+        case CTRL_SYNC:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *(LBA_t*)buff = Ramdisk_Sectors;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *(WORD*)buff = FF_MIN_SS;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *(DWORD*)buff = 1;
+            return RES_OK;
+        case MMC_CACHE_PRELOAD:
+            // Already in RAM
+            ((DISK_PRELOAD*)buff)->count = 0;
+            return RES_OK;
+    };
+    return RES_PARERR; //Invalid parameter
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Get Drive Status                                                      */
 /*-----------------------------------------------------------------------*/
@@ -87,7 +405,10 @@ DSTATUS disk_status (
 )
 {
 	DSTATUS stat = 0;
-    if (pdrv != 0) {
+    if (pdrv == DEV_RAM) {
+        return ramdisk_status();
+    }
+    if (pdrv != DEV_MMC) {
         return STA_NOINIT; //No status if out of range.
     }
     
@@ -110,6 +431,88 @@ DSTATUS disk_status (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Bus Negotiation                                                       */
+/*-----------------------------------------------------------------------*/
+// After identification the card is still in 1-bit mode at the 400kHz
+// identification clock. Switch it to the widest bus and fastest clock that
+// both it and FF_SDMMC_BUS_WIDTH/FF_SDMMC_MAX_SPEED allow.
+
+// Select the widest supported bus width
+static ALT_STATUS_CODE sdmmc_negotiate_width (void) {
+    // SCR bus widths has a bit set for each supported width (bit 0 = 1-bit, bit 2 = 4-bit)
+    ALT_SDMMC_BUS_WIDTH_t width = ALT_SDMMC_BUS_WIDTH_1;
+    if ((FF_SDMMC_BUS_WIDTH >= ALT_SDMMC_BUS_WIDTH_4) && (Card_Info.scr_bus_widths & ALT_SDMMC_BUS_WIDTH_4)) {
+        width = ALT_SDMMC_BUS_WIDTH_4;
+    }
+    return alt_sdmmc_card_bus_width_set(&Card_Info, width);
+}
+
+// Read the SD status register to find the allocation unit size
+//  - MMC cards have no SD status, so are left with no AU size and no pre-erase.
+//    A card which reports no AU size is pre-erased without AU alignment.
+static void sdmmc_read_sd_status (void) {
+    // AU_SIZE codes in units of 16kB (SD Physical Layer, SD status bits 431:428)
+    static const uint16_t auSize16k[16] = { 0, 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 768, 1024, 1536, 2048, 4096 };
+    Sdmmc_Sd_Status_Valid = false;
+    Sdmmc_Au_Sectors = 0;
+    Sdmmc_Pre_Erase = false;
+    if ((Card_Info.card_type != ALT_SDMMC_CARD_TYPE_SD) && (Card_Info.card_type != ALT_SDMMC_CARD_TYPE_SDHC)) {
+        return;
+    }
+    alt_cache_system_purge(Sdmmc_Sd_Status, sizeof(Sdmmc_Sd_Status));
+    if (alt_sdmmc_card_sd_status_get(Sdmmc_Sd_Status) != ALT_E_SUCCESS) {
+        FF_LOG(VERBOSE_WARNING, "WARN: Failed to read SD status.\n");
+        return;
+    }
+    alt_cache_system_purge(Sdmmc_Sd_Status, sizeof(Sdmmc_Sd_Status));
+    Sdmmc_Sd_Status_Valid = true;
+    BYTE auSize = ((const BYTE*)Sdmmc_Sd_Status)[10] >> 4;
+    Sdmmc_Au_Sectors = (uint32_t)auSize16k[auSize] * (16384 / Sdmmc_Sector_Size);
+    Sdmmc_Pre_Erase = Sdmmc_Pre_Erase_Enabled;
+    FF_LOG(VERBOSE_INFO, "INFO: Card AU size = %u sectors.\n", (UINT)Sdmmc_Au_Sectors);
+}
+
+// Prepare the card for a write burst
+//  - Limits a multi-block burst so that it does not cross an allocation unit
+//    boundary, then tells the card how many blocks to pre-erase (ACMD23).
+//  - Returns the number of sectors to write in the burst.
+static UINT sdmmc_pre_erase (LBA_t sector, UINT burst) {
+    if (!Sdmmc_Pre_Erase || (burst < 2)) {
+        return burst;
+    }
+    if (Sdmmc_Au_Sectors) {
+        uint32_t toBoundary = Sdmmc_Au_Sectors - (uint32_t)(sector % Sdmmc_Au_Sectors);
+        if (burst > toBoundary) {
+            burst = toBoundary;
+        }
+    }
+    // The count is only a hint, so a card which rejects it is still written
+    if ((burst > 1) && (alt_sdmmc_card_pre_erase_set((burst * Sdmmc_Sector_Size) / Sdmmc_Block_Size) != ALT_E_SUCCESS)) {
+        FF_LOG(VERBOSE_WARNING, "WARN: Pre-erase of %u sectors failed.\n", (UINT)burst);
+    }
+    return burst;
+}
+
+// Select the fastest supported card clock
+static ALT_STATUS_CODE sdmmc_negotiate_speed (void) {
+    if ((FF_SDMMC_MAX_SPEED >= ALT_SDMMC_TRANSFER_SPEED_HIGH) && Card_Info.high_speed) {
+        // Switch to High-Speed mode with CMD6, then raise the clock to match
+        ResetWDT();
+        if (alt_sdmmc_card_speed_set(&Card_Info, ALT_SDMMC_TRANSFER_SPEED_HIGH) == ALT_E_SUCCESS) {
+            return ALT_E_SUCCESS;
+        }
+        FF_LOG(VERBOSE_WARNING, "WARN: High-Speed switch failed. Using default speed.\n");
+    }
+    // Default speed, limited by the rate in the CSD (e.g. 20MHz for legacy MMC)
+    uint32_t speed = ALT_SDMMC_TRANSFER_SPEED_DEFAULT;
+    if (Card_Info.xfer_speed && (Card_Info.xfer_speed < speed)) speed = Card_Info.xfer_speed;
+    if (FF_SDMMC_MAX_SPEED < speed) speed = FF_SDMMC_MAX_SPEED;
+    return alt_sdmmc_card_speed_set(&Card_Info, speed);
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Inidialize a Drive                                                    */
 /*-----------------------------------------------------------------------*/
@@ -121,15 +524,21 @@ DSTATUS disk_initialize (
 	DSTATUS stat = 0;
     ALT_SDMMC_CARD_MISC_t card_misc_cfg;
     
-    if (pdrv != 0) {
-        printf("ERROR: Invalid Drive.\n");
+    if (pdrv == DEV_RAM) {
+        return ramdisk_initialize();
+    }
+    if (pdrv != DEV_MMC) {
+        FF_LOG(VERBOSE_ERROR, "ERROR: Invalid Drive.\n");
         return STA_NOINIT; //Don't try and initialise if out of range.
     }
+    if (Sdmmc_Async_Active) {
+        return disk_status(pdrv); //Can't reinitialise during an asynchronous transfer.
+    }
     
-    printf("INFO: System Initialization.\n");
+    FF_LOG(VERBOSE_INFO, "INFO: System Initialization.\n");
 
     // Setting up SD/MMC
-    printf("INFO: Setting up SDMMC.\n");
+    FF_LOG(VERBOSE_INFO, "INFO: Setting up SDMMC.\n");
     if(alt_sdmmc_init() != ALT_E_SUCCESS) {
         goto error;
     }
@@ -148,27 +557,27 @@ DSTATUS disk_initialize (
     switch(Card_Info.card_type)
     {
         case ALT_SDMMC_CARD_TYPE_MMC:
-            printf("INFO: MMC Card detected.\n");
+            FF_LOG(VERBOSE_INFO, "INFO: MMC Card detected.\n");
             break;
         case ALT_SDMMC_CARD_TYPE_SD:
-            printf("INFO: SD Card detected.\n");
+            FF_LOG(VERBOSE_INFO, "INFO: SD Card detected.\n");
             break;
         case ALT_SDMMC_CARD_TYPE_SDIOIO:
-            printf("INFO: SDIO Card detected.\n");
+            FF_LOG(VERBOSE_INFO, "INFO: SDIO Card detected.\n");
             break;
         case ALT_SDMMC_CARD_TYPE_SDIOCOMBO:
-            printf("INFO: SDIOCOMBO Card detected.\n");
+            FF_LOG(VERBOSE_INFO, "INFO: SDIOCOMBO Card detected.\n");
             break;
         case ALT_SDMMC_CARD_TYPE_SDHC:
-            printf("INFO: SDHC Card detected.\n");
+            FF_LOG(VERBOSE_INFO, "INFO: SDHC Card detected.\n");
             break;
         default:
-            printf("INFO: Card type unknown.\n");
+            FF_LOG(VERBOSE_INFO, "INFO: Card type unknown.\n");
             stat = stat + STA_NODISK; //Set the no-disk flag if unknown
             goto error;
     }
     
-    if(alt_sdmmc_card_bus_width_set(&Card_Info, FF_SDMMC_BUS_WIDTH) != ALT_E_SUCCESS) {
+    if(sdmmc_negotiate_width() != ALT_E_SUCCESS) {
         goto error;
     }
 
@@ -179,29 +588,43 @@ DSTATUS disk_initialize (
         goto error;
     }
 
+    if(sdmmc_negotiate_speed() != ALT_E_SUCCESS) {
+        goto error;
+    }
+    ResetWDT();
+
     if (alt_sdmmc_card_misc_get(&card_misc_cfg) != ALT_E_SUCCESS) {
         goto error;
     }
 
-    printf("INFO: Card width = %d.\n", card_misc_cfg.card_width);
-    printf("INFO: Card block size = %d.\n", (int)card_misc_cfg.block_size);
+    FF_LOG(VERBOSE_INFO, "INFO: Card width = %d.\n", card_misc_cfg.card_width);
+    FF_LOG(VERBOSE_INFO, "INFO: Card clock = %u Hz.\n", (UINT)alt_sdmmc_card_speed_get());
+    FF_LOG(VERBOSE_INFO, "INFO: Card block size = %d.\n", (int)card_misc_cfg.block_size);
     Sdmmc_Block_Size = card_misc_cfg.block_size;
     Sdmmc_Device_Size = ((uint64_t)Card_Info.blk_number_high << 32) + Card_Info.blk_number_low;
     Sdmmc_Device_Size *= Card_Info.max_r_blkln;
     Sdmmc_Sector_Size = (Card_Info.max_r_blkln > 512) ? 512 : Card_Info.max_r_blkln;
-    printf("INFO: Card size = %lld.\n", Sdmmc_Device_Size);
+    Sdmmc_Bounce_Sectors = FF_SDMMC_BOUNCE_SIZE / Sdmmc_Sector_Size;
+#if FF_SDMMC_CACHE_SECTORS > 0
+    // Discard anything cached from a previous card
+    sdmmc_cache_reset();
+#endif
+    FF_LOG(VERBOSE_INFO, "INFO: Card size = %lld.\n", Sdmmc_Device_Size);
 
     if(alt_sdmmc_dma_enable() != ALT_E_SUCCESS) {
         goto error;
     }
+
+    // Check the allocation unit size for aligning multi-block writes
+    sdmmc_read_sd_status();
     
     if (alt_sdmmc_card_is_write_protected()) {
-        printf("WARN: Card is write protected.\n");
+        FF_LOG(VERBOSE_WARNING, "WARN: Card is write protected.\n");
         //If the disk is write protected, set the STA_PROTECT flag (this is not an error).
         stat = stat + STA_PROTECT;
     }
     
-    printf("\n");
+    FF_LOG(VERBOSE_INFO, "\n");
     
     Sdmmc_Initialised = true; //Now we are initialised.
     return stat;
@@ -215,65 +638,73 @@ error:
 
 
 /*-----------------------------------------------------------------------*/
-/* Read Sector(s)                                                        */
+/* Raw Sector Access                                                     */
 /*-----------------------------------------------------------------------*/
+// Transfers directly to/from the card, bypassing the sector cache.
 
-DRESULT disk_read (
-	BYTE pdrv,		/* Physical drive number to identify the drive */
+// The SDMMC DMA is not cache coherent, so every transfer goes through these.
+//  - Before a read, any dirty lines are written back so that they cannot be
+//    evicted over the DMA data, and after it the stale lines are discarded.
+//  - Before a write, the buffer is cleaned so the card gets what the CPU wrote.
+static ALT_STATUS_CODE sdmmc_dma_read (void* buff, uint32_t block, size_t size) {
+    alt_cache_system_purge(buff, size);
+    ALT_STATUS_CODE sdmmcStat = alt_sdmmc_block_read(&Card_Info, buff, block, size);
+    alt_cache_system_purge(buff, size);
+    return sdmmcStat;
+}
+
+static ALT_STATUS_CODE sdmmc_dma_write (uint32_t block, const void* buff, size_t size) {
+    alt_cache_system_clean((void*)buff, size);
+    return alt_sdmmc_block_write(&Card_Info, block, (void*)buff, size);
+}
+
+static DRESULT sdmmc_read_sectors (
 	BYTE *buff,		/* Data buffer to store read data */
-	DWORD sector,	/* Start sector in LBA */
+	LBA_t sector,	/* Start sector in LBA */
 	UINT count		/* Number of sectors to read */
 )
 {
-    // Validate disk condition
-    if (pdrv != 0) {
-        return RES_PARERR; //Don't try if out of range.
-    }
-    if (!Sdmmc_Initialised) {
-        return RES_NOTRDY; //Not ready.
-    }
-    // Must have a read buffer
-    if (!buff) {
-        return RES_PARERR;
-    }
-
-    // 32-bit aligned data buffer for sector reads used if incoming buffer is not aligned.
-    uint32_t alignedBuff[Sdmmc_Sector_Size/sizeof(uint32_t)];
-
-    // Work through each sector to be read
+    // Work through the sectors to be read. Aligned buffers are read in bursts of
+    // up to FF_SDMMC_MAX_BURST sectors as a single multi-block (CMD18) transfer.
     UINT remain = count;
     UINT start = sector;
     ALT_STATUS_CODE sdmmcStat;
-    printf("FatFS: Block Read %u Sectors. Start at %u (@ 0x%08x).\n", (UINT)count, (UINT)sector, (UINT)(sector * Sdmmc_Sector_Size));
-    while (remain--) {
-        //Convert current sector to byte address
-        unsigned int address = sector * Sdmmc_Sector_Size;
+    FF_LOG(VERBOSE_EXTRAINFO, "FatFS: Block Read %u Sectors. Start at %u.\n", (UINT)count, (UINT)sector);
+    while (remain) {
+        //Convert current sector to card block
+        uint32_t block = sdmmc_block(sector);
 
         //Ensure aligned data buffer.
-        const BYTE* readBuff;
+        BYTE* readBuff;
+        UINT burst;
         if (((uint32_t)buff) & 3) {
-            //If the memory buffer is non-aligned to the 32bit boundary, so use our
-            //internal aligned buffer for the read.
-            readBuff = (BYTE*)alignedBuff;
+            //If the memory buffer is non-aligned to the 32bit boundary, read as many
+            //sectors as will fit into our aligned bounce buffer, then copy them out.
+            readBuff = (BYTE*)Sdmmc_Bounce_Buff;
+            burst = (remain > Sdmmc_Bounce_Sectors) ? Sdmmc_Bounce_Sectors : remain;
         } else {
-            //Otherwise we can save some time by using the already aligned buffer.
+            //Otherwise we can save some time by reading directly into the already
+            //aligned buffer, and reading as many sectors as possible at once.
             readBuff = buff;
+            burst = (remain > FF_SDMMC_MAX_BURST) ? FF_SDMMC_MAX_BURST : remain;
         }
 
-        sdmmcStat = alt_sdmmc_read(&Card_Info, (void*)readBuff, (void*)address, Sdmmc_Sector_Size);
+        sdmmcStat = sdmmc_dma_read(readBuff, block, burst * Sdmmc_Sector_Size);
+        sdmmc_trace(DISK_TRACE_READ, sector, burst, sdmmcStat);
         if (sdmmcStat != ALT_E_SUCCESS) {
-            printf("FatFS: Sec %u/%u (@ 0x%08x) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+            FF_LOG(VERBOSE_ERROR, "FatFS: Sec %u+%u/%u (@ blk %u) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)burst, (UINT)count, (UINT)block, sdmmcStat);
             return RES_ERROR;
         }
 
-        if (((uint32_t)buff) & 3) {
-            //If it was a non-aligned read, copy from our internal buffer to the user
-            memcpy(buff, alignedBuff, Sdmmc_Sector_Size);
+        if (readBuff != buff) {
+            //If it was a non-aligned read, copy from our bounce buffer to the user
+            memcpy(buff, readBuff, burst * Sdmmc_Sector_Size);
         }
 
-        // Move on to the next sector
-        sector++;
-        buff += Sdmmc_Sector_Size;
+        // Move on to the next sector(s)
+        sector += burst;
+        buff += burst * Sdmmc_Sector_Size;
+        remain -= burst;
         ResetWDT();
     }
     return RES_OK;
@@ -281,73 +712,68 @@ DRESULT disk_read (
 
 
 
-/*-----------------------------------------------------------------------*/
-/* Write Sector(s)                                                       */
-/*-----------------------------------------------------------------------*/
 // Special write case: if `buff == NULL`, will zero out each sector.
 
-DRESULT disk_write (
-	BYTE pdrv,			/* Physical drive number to identify the drive */
+static DRESULT sdmmc_write_sectors (
 	const BYTE *buff,	/* Data to be written */
-	DWORD sector,		/* Start sector in LBA */
+	LBA_t sector,		/* Start sector in LBA */
 	UINT count			/* Number of sectors to write */
 )
 {
-    // Validate disk condition
-    if (pdrv != 0) {
-        return RES_PARERR; //Don't try if out of range.
-    }
-    if (!Sdmmc_Initialised) {
-        return RES_NOTRDY; //Not ready.
-    }
-    if (alt_sdmmc_card_is_write_protected()) {
-        return RES_WRPRT; //Write protected. Error.
-    }
-
-    // 32-bit aligned data buffer for sector writes used if incoming buffer is not aligned.
-    uint32_t alignedBuff[Sdmmc_Sector_Size/sizeof(uint32_t)];
     if (!buff) {
-        // If no write buffer, we are going to write 0's, so zero out the aligned buffer
-        memset(alignedBuff, 0, Sdmmc_Sector_Size);
+        // If no write buffer, we are going to write 0's, so zero out the bounce buffer
+        memset(Sdmmc_Bounce_Buff, 0, sizeof(Sdmmc_Bounce_Buff));
     }
     
-    // Work through each sector to be written
+    // Work through the sectors to be written. Aligned buffers are written in bursts of
+    // up to FF_SDMMC_MAX_BURST sectors as a single multi-block (CMD25) transfer.
     UINT remain = count;
     UINT start = sector;
     ALT_STATUS_CODE sdmmcStat;
-    printf("FatFS: Block Write %u Sectors. Start at %u (@ 0x%08x).\n", (UINT)count, (UINT)sector, (UINT)(sector * Sdmmc_Sector_Size));
-    while (remain--) {
-        //Convert current sector to byte address
-        unsigned int address = sector * Sdmmc_Sector_Size;
+    FF_LOG(VERBOSE_EXTRAINFO, "FatFS: Block Write %u Sectors. Start at %u.\n", (UINT)count, (UINT)sector);
+    while (remain) {
+        //Convert current sector to card block
+        uint32_t block = sdmmc_block(sector);
 
         //Ensure aligned data buffer.
         const BYTE* writeBuff;
+        UINT burst;
         if (!buff) {
-            //If no write buffer, use aligned buffer (zero filled)
-            writeBuff = (BYTE*)alignedBuff;
+            //If no write buffer, use bounce buffer (zero filled)
+            writeBuff = (BYTE*)Sdmmc_Bounce_Buff;
+            burst = (remain > Sdmmc_Bounce_Sectors) ? Sdmmc_Bounce_Sectors : remain;
         } else if (((uint32_t)buff) & 3) {
-            //If the memory buffer is non-aligned to the 32bit boundary, copy it
-            //into our internal correctly aligned buffer
-            memcpy(alignedBuff, buff, Sdmmc_Sector_Size);
-            //Our aligned buffer is the one we want to write
-            writeBuff = (BYTE*)alignedBuff;
+            //If the memory buffer is non-aligned to the 32bit boundary, copy as many
+            //sectors as will fit into our correctly aligned bounce buffer
+            burst = (remain > Sdmmc_Bounce_Sectors) ? Sdmmc_Bounce_Sectors : remain;
+            memcpy(Sdmmc_Bounce_Buff, buff, burst * Sdmmc_Sector_Size);
+            //Our bounce buffer is the one we want to write
+            writeBuff = (BYTE*)Sdmmc_Bounce_Buff;
         } else {
-            //Otherwise we can save some time by using the already aligned buffer.
+            //Otherwise we can save some time by using the already aligned buffer,
+            //and writing as many sectors as possible at once.
             writeBuff = buff;
+            burst = (remain > FF_SDMMC_MAX_BURST) ? FF_SDMMC_MAX_BURST : remain;
         }
 
-        // Write the sector
-        sdmmcStat = alt_sdmmc_write(&Card_Info, (void*)address, (void*)writeBuff, Sdmmc_Sector_Size);
+        // Pre-erase multi-block writes. Any sectors beyond an allocation unit boundary
+        // are left for the next burst (a copied bounce buffer is written from the start).
+        burst = sdmmc_pre_erase(sector, burst);
+
+        // Write the sector(s)
+        sdmmcStat = sdmmc_dma_write(block, writeBuff, burst * Sdmmc_Sector_Size);
+        sdmmc_trace(DISK_TRACE_WRITE, sector, burst, sdmmcStat);
         if (sdmmcStat != ALT_E_SUCCESS) {
-            printf("FatFS: Sec %u/%u (@ 0x%08x) Write Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+            FF_LOG(VERBOSE_ERROR, "FatFS: Sec %u+%u/%u (@ blk %u) Write Err %d.\n", (UINT)(sector - start + 1), (UINT)burst, (UINT)count, (UINT)block, sdmmcStat);
             return RES_ERROR;
         }
 
-        // Move on to the next sector
-        sector++;
+        // Move on to the next sector(s)
+        sector += burst;
         if (buff) {
-            buff += Sdmmc_Sector_Size;
+            buff += burst * Sdmmc_Sector_Size;
         }
+        remain -= burst;
         ResetWDT();
     }
     return RES_OK;
@@ -355,6 +781,360 @@ DRESULT disk_write (
 
 
 
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Sector Cache                                                          */
+/*-----------------------------------------------------------------------*/
+// Small LRU cache of recently used sectors below FatFS. Directory and FAT
+// sectors are read again and again, so are served from here rather than
+// the card. A miss reads ahead FF_SDMMC_READ_AHEAD sectors in one transfer.
+//
+// Writes are held in the cache (write-back). When a dirty sector is evicted
+// it is written on its own. On CTRL_SYNC, all dirty sectors are written with
+// runs of consecutive sectors combined into single transfers.
+//
+// Transfers of more than FF_SDMMC_CACHE_MAX_XFER sectors (e.g. file data
+// reads of whole clusters) bypass the cache to avoid flushing useful entries.
+
+#if FF_SDMMC_CACHE_SECTORS > 0
+
+// Cache only supports 512 byte sectors
+#define SDMMC_CACHE_SECTOR_SIZE 512
+
+typedef struct {
+    LBA_t    sector;   // Sector held in this entry
+    uint32_t lastUse;  // Cache tick when last accessed, for LRU replacement
+    bool     valid;    // Entry holds a sector
+    bool     dirty;    // Entry modified since read from the card
+} SdmmcCacheEntry_t;
+
+static SdmmcCacheEntry_t Sdmmc_Cache_Entry[FF_SDMMC_CACHE_SECTORS];
+static uint32_t Sdmmc_Cache_Data[FF_SDMMC_CACHE_SECTORS][SDMMC_CACHE_SECTOR_SIZE/sizeof(uint32_t)] __attribute__((aligned(ALT_CACHE_LINE_SIZE)));
+static uint32_t Sdmmc_Cache_Tick;
+static bool Sdmmc_Cache_Enabled = false;
+
+// Drop all entries without writing them back
+static void sdmmc_cache_reset (void) {
+    for (UINT idx = 0; idx < FF_SDMMC_CACHE_SECTORS; idx++) {
+        Sdmmc_Cache_Entry[idx].valid = false;
+        Sdmmc_Cache_Entry[idx].dirty = false;
+    }
+    Sdmmc_Cache_Tick = 0;
+    Sdmmc_Cache_Enabled = (Sdmmc_Sector_Size == SDMMC_CACHE_SECTOR_SIZE);
+}
+
+// Find the entry holding a sector
+//  - Returns -1 if not cached
+static int sdmmc_cache_find (LBA_t sector) {
+    for (UINT idx = 0; idx < FF_SDMMC_CACHE_SECTORS; idx++) {
+        if (Sdmmc_Cache_Entry[idx].valid && (Sdmmc_Cache_Entry[idx].sector == sector)) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+// Mark an entry as most recently used
+static void sdmmc_cache_touch (int idx) {
+    Sdmmc_Cache_Entry[idx].lastUse = ++Sdmmc_Cache_Tick;
+}
+
+// Discard any cached copies of a range of sectors, including dirty ones
+//  - Used when the range has been overwritten on the card directly.
+static void sdmmc_cache_invalidate (LBA_t sector, UINT count) {
+    for (UINT idx = 0; idx < FF_SDMMC_CACHE_SECTORS; idx++) {
+        SdmmcCacheEntry_t* entry = &Sdmmc_Cache_Entry[idx];
+        if (entry->valid && (entry->sector >= sector) && (entry->sector - sector < count)) {
+            entry->valid = false;
+            entry->dirty = false;
+        }
+    }
+}
+
+// Allocate an entry for a new sector, evicting the least recently used
+//  - If the evicted entry is dirty it is written back first.
+//  - Returns -1 if write back fails, with the error in *res.
+static int sdmmc_cache_alloc (LBA_t sector, DRESULT* res) {
+    int victim = 0;
+    for (UINT idx = 0; idx < FF_SDMMC_CACHE_SECTORS; idx++) {
+        if (!Sdmmc_Cache_Entry[idx].valid) {
+            victim = idx;
+            break;
+        }
+        if ((int32_t)(Sdmmc_Cache_Entry[idx].lastUse - Sdmmc_Cache_Entry[victim].lastUse) < 0) {
+            victim = idx;
+        }
+    }
+    SdmmcCacheEntry_t* entry = &Sdmmc_Cache_Entry[victim];
+    if (entry->valid && entry->dirty) {
+        // Entry data is aligned, so can be written directly
+        *res = sdmmc_write_sectors((BYTE*)Sdmmc_Cache_Data[victim], entry->sector, 1);
+        if (*res != RES_OK) return -1;
+    }
+    entry->sector = sector;
+    entry->valid = true;
+    entry->dirty = false;
+    sdmmc_cache_touch(victim);
+    return victim;
+}
+
+// Write back all dirty entries
+//  - Runs of consecutive dirty sectors are gathered into the bounce buffer
+//    and written as a single multi-block transfer. The raw write cleans the
+//    bounce buffer first, so the card gets the copied data, not stale DDR.
+static DRESULT sdmmc_cache_flush (void) {
+    while (true) {
+        // Find the lowest dirty sector
+        int first = -1;
+        for (UINT idx = 0; idx < FF_SDMMC_CACHE_SECTORS; idx++) {
+            SdmmcCacheEntry_t* entry = &Sdmmc_Cache_Entry[idx];
+            if (entry->valid && entry->dirty && ((first < 0) || (entry->sector < Sdmmc_Cache_Entry[first].sector))) {
+                first = idx;
+            }
+        }
+        if (first < 0) return RES_OK;
+        // Gather as many consecutive dirty sectors as will fit
+        LBA_t sector = Sdmmc_Cache_Entry[first].sector;
+        UINT run = 0;
+        int idx = first;
+        while ((idx >= 0) && (run < Sdmmc_Bounce_Sectors)) {
+            memcpy((BYTE*)Sdmmc_Bounce_Buff + run * SDMMC_CACHE_SECTOR_SIZE, Sdmmc_Cache_Data[idx], SDMMC_CACHE_SECTOR_SIZE);
+            run++;
+            idx = sdmmc_cache_find(sector + run);
+            if ((idx >= 0) && !Sdmmc_Cache_Entry[idx].dirty) idx = -1;
+        }
+        DRESULT res = sdmmc_write_sectors((BYTE*)Sdmmc_Bounce_Buff, sector, run);
+        if (res != RES_OK) return res;
+        // Those sectors now match the card
+        for (UINT ofs = 0; ofs < run; ofs++) {
+            Sdmmc_Cache_Entry[sdmmc_cache_find(sector + ofs)].dirty = false;
+        }
+    }
+}
+
+// Read sectors through the cache
+static DRESULT sdmmc_cache_read (BYTE *buff, LBA_t sector, UINT count) {
+    DRESULT res;
+    if (count > FF_SDMMC_CACHE_MAX_XFER) {
+        // Large read bypasses the cache. Any dirty cached sectors in the range
+        // are newer than the card so must be copied over the top.
+        res = sdmmc_read_sectors(buff, sector, count);
+        if (res != RES_OK) return res;
+        for (UINT idx = 0; idx < FF_SDMMC_CACHE_SECTORS; idx++) {
+            SdmmcCacheEntry_t* entry = &Sdmmc_Cache_Entry[idx];
+            if (entry->valid && entry->dirty && (entry->sector >= sector) && (entry->sector - sector < count)) {
+                memcpy(buff + (entry->sector - sector) * SDMMC_CACHE_SECTOR_SIZE, Sdmmc_Cache_Data[idx], SDMMC_CACHE_SECTOR_SIZE);
+            }
+        }
+        return RES_OK;
+    }
+    LBA_t total = Sdmmc_Device_Size / SDMMC_CACHE_SECTOR_SIZE;
+    while (count) {
+        int idx = sdmmc_cache_find(sector);
+        if (idx < 0) {
+            // Miss. Read this sector and those following it into the bounce buffer.
+            // The raw read purges it around the DMA, so no stale lines are copied.
+            if (sector >= total) return RES_PARERR;
+            UINT ahead = (count > FF_SDMMC_READ_AHEAD) ? count : FF_SDMMC_READ_AHEAD;
+            if (ahead > Sdmmc_Bounce_Sectors) ahead = Sdmmc_Bounce_Sectors;
+            if (ahead > FF_SDMMC_CACHE_SECTORS) ahead = FF_SDMMC_CACHE_SECTORS;
+            if (ahead > total - sector) ahead = total - sector;
+            // Stop at the next sector which is already cached. It may be dirty, and
+            // ensures none of the new entries can evict a sector in the range.
+            for (UINT ofs = 1; ofs < ahead; ofs++) {
+                if (sdmmc_cache_find(sector + ofs) >= 0) {
+                    ahead = ofs;
+                    break;
+                }
+            }
+            res = sdmmc_read_sectors((BYTE*)Sdmmc_Bounce_Buff, sector, ahead);
+            if (res != RES_OK) return res;
+            // And add them to the cache
+            for (UINT ofs = 0; ofs < ahead; ofs++) {
+                int slot = sdmmc_cache_alloc(sector + ofs, &res);
+                if (slot < 0) return res;
+                memcpy(Sdmmc_Cache_Data[slot], (BYTE*)Sdmmc_Bounce_Buff + ofs * SDMMC_CACHE_SECTOR_SIZE, SDMMC_CACHE_SECTOR_SIZE);
+            }
+            continue;
+        }
+        // Hit
+        memcpy(buff, Sdmmc_Cache_Data[idx], SDMMC_CACHE_SECTOR_SIZE);
+        sdmmc_cache_touch(idx);
+        buff += SDMMC_CACHE_SECTOR_SIZE;
+        sector++;
+        count--;
+    }
+    return RES_OK;
+}
+
+// Read a run of sectors straight into the cache
+//  - The sectors are read with one multi-block transfer into consecutive
+//    entries, replacing the run of entries which were used least recently.
+//    Dirty entries are written back first, so none are lost.
+//  - At most FF_SDMMC_CACHE_SECTORS are read. Returns the number read in *count.
+static DRESULT sdmmc_cache_preload (LBA_t sector, UINT* count) {
+    LBA_t total = Sdmmc_Device_Size / SDMMC_CACHE_SECTOR_SIZE;
+    if (sector >= total) return RES_PARERR;
+    UINT run = *count;
+    if (run > FF_SDMMC_CACHE_SECTORS) run = FF_SDMMC_CACHE_SECTORS;
+    if (run > total - sector) run = total - sector;
+    *count = 0;
+    if (!run) return RES_OK;
+    DRESULT res = sdmmc_cache_flush();
+    if (res != RES_OK) return res;
+    // Drop existing copies so that no sector is cached twice
+    sdmmc_cache_invalidate(sector, run);
+    // Find the run of entries whose most recent use is oldest
+    UINT first = 0;
+    uint32_t bestAge = 0;
+    for (UINT start = 0; start + run <= FF_SDMMC_CACHE_SECTORS; start++) {
+        uint32_t age = UINT32_MAX;
+        for (UINT idx = start; idx < start + run; idx++) {
+            SdmmcCacheEntry_t* entry = &Sdmmc_Cache_Entry[idx];
+            uint32_t entryAge = entry->valid ? (Sdmmc_Cache_Tick - entry->lastUse) : UINT32_MAX;
+            if (entryAge < age) age = entryAge;
+        }
+        if ((start == 0) || (age > bestAge)) {
+            first = start;
+            bestAge = age;
+        }
+    }
+    // Entry data is contiguous and aligned, so can be read into directly. The
+    // raw read purges the entries around the DMA so no stale lines hide it.
+    for (UINT ofs = 0; ofs < run; ofs++) {
+        Sdmmc_Cache_Entry[first + ofs].valid = false;
+    }
+    res = sdmmc_read_sectors((BYTE*)Sdmmc_Cache_Data[first], sector, run);
+    if (res != RES_OK) return res;
+    for (UINT ofs = 0; ofs < run; ofs++) {
+        SdmmcCacheEntry_t* entry = &Sdmmc_Cache_Entry[first + ofs];
+        entry->sector = sector + ofs;
+        entry->valid = true;
+        entry->dirty = false;
+        sdmmc_cache_touch(first + ofs);
+    }
+    *count = run;
+    return RES_OK;
+}
+
+// Write sectors through the cache
+//  - If `buff == NULL`, will zero out each sector.
+static DRESULT sdmmc_cache_write (const BYTE *buff, LBA_t sector, UINT count) {
+    DRESULT res;
+    if (!buff || (count > FF_SDMMC_CACHE_MAX_XFER)) {
+        // Large write bypasses the cache. Any cached copies in the range are now stale.
+        res = sdmmc_write_sectors(buff, sector, count);
+        sdmmc_cache_invalidate(sector, count);
+        return res;
+    }
+    while (count) {
+        int idx = sdmmc_cache_find(sector);
+        if (idx < 0) {
+            idx = sdmmc_cache_alloc(sector, &res);
+            if (idx < 0) return res;
+        }
+        memcpy(Sdmmc_Cache_Data[idx], buff, SDMMC_CACHE_SECTOR_SIZE);
+        Sdmmc_Cache_Entry[idx].dirty = true;
+        sdmmc_cache_touch(idx);
+        buff += SDMMC_CACHE_SECTOR_SIZE;
+        sector++;
+        count--;
+    }
+    return RES_OK;
+}
+
+#endif
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Read Sector(s)                                                        */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_read (
+	BYTE pdrv,		/* Physical drive number to identify the drive */
+	BYTE *buff,		/* Data buffer to store read data */
+	LBA_t sector,	/* Start sector in LBA */
+	UINT count		/* Number of sectors to read */
+)
+{
+    // Validate disk condition
+    if (pdrv == DEV_RAM) {
+        return ramdisk_read(buff, sector, count);
+    }
+    if (pdrv != DEV_MMC) {
+        return RES_PARERR; //Don't try if out of range.
+    }
+    if (!Sdmmc_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    if (Sdmmc_Async_Active) {
+        return RES_NOTRDY; //Busy with an asynchronous transfer.
+    }
+    // Sectors must be on the card
+    if (!sdmmc_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+    // Must have a read buffer
+    if (!buff) {
+        return RES_PARERR;
+    }
+
+#if FF_SDMMC_CACHE_SECTORS > 0
+    if (Sdmmc_Cache_Enabled) {
+        return sdmmc_cache_read(buff, sector, count);
+    }
+#endif
+    return sdmmc_read_sectors(buff, sector, count);
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Write Sector(s)                                                       */
+/*-----------------------------------------------------------------------*/
+// Special write case: if `buff == NULL`, will zero out each sector.
+
+DRESULT disk_write (
+	BYTE pdrv,			/* Physical drive number to identify the drive */
+	const BYTE *buff,	/* Data to be written */
+	LBA_t sector,		/* Start sector in LBA */
+	UINT count			/* Number of sectors to write */
+)
+{
+    // Validate disk condition
+    if (pdrv == DEV_RAM) {
+        return ramdisk_write(buff, sector, count);
+    }
+    if (pdrv != DEV_MMC) {
+        return RES_PARERR; //Don't try if out of range.
+    }
+    if (!Sdmmc_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    if (Sdmmc_Async_Active) {
+        return RES_NOTRDY; //Busy with an asynchronous transfer.
+    }
+    // Sectors must be on the card
+    if (!sdmmc_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+    if (alt_sdmmc_card_is_write_protected()) {
+        return RES_WRPRT; //Write protected. Error.
+    }
+
+#if FF_SDMMC_CACHE_SECTORS > 0
+    if (Sdmmc_Cache_Enabled) {
+        return sdmmc_cache_write(buff, sector, count);
+    }
+#endif
+    return sdmmc_write_sectors(buff, sector, count);
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Verify Sector(s)                                                      */
 /*-----------------------------------------------------------------------*/
@@ -363,64 +1143,348 @@ DRESULT disk_write (
 DRESULT disk_verify (
     BYTE pdrv,          /* Physical drive number to identify the drive */
     const BYTE *buff,   /* Data buffer that was written */
-    DWORD sector,       /* Start sector in LBA */
+    LBA_t sector,       /* Start sector in LBA */
     UINT count          /* Number of sectors to verify */
 )
 {
     // Validate disk condition
-    if (pdrv != 0) {
+    if (pdrv == DEV_RAM) {
+        return ramdisk_verify(buff, sector, count);
+    }
+    if (pdrv != DEV_MMC) {
         return RES_PARERR; //Don't try if out of range.
     }
     if (!Sdmmc_Initialised) {
         return RES_NOTRDY; //Not ready.
     }
+    if (Sdmmc_Async_Active) {
+        return RES_NOTRDY; //Busy with an asynchronous transfer.
+    }
+    // Sectors must be on the card
+    if (!sdmmc_in_range(sector, count)) {
+        return RES_PARERR;
+    }
 
-    // 32-bit aligned data buffer for sector reads used if incoming buffer is not aligned.
-    uint32_t alignedBuff[Sdmmc_Sector_Size/sizeof(uint32_t)];
+#if FF_SDMMC_CACHE_SECTORS > 0
+    // Ensure the card holds any data still in the cache
+    if (Sdmmc_Cache_Enabled && (sdmmc_cache_flush() != RES_OK)) {
+        return RES_ERROR;
+    }
+#endif
 
-    // Work through each sector to be read
+    // Work through the sectors to be read, as many at a time as fit in the bounce buffer
     UINT remain = count;
     UINT start = sector;
     ALT_STATUS_CODE sdmmcStat;
-    printf("FatFS: Block Verify %u Sectors. Start at %u (@ 0x%08x).\n", (UINT)count, (UINT)sector, (UINT)(sector * Sdmmc_Sector_Size));
-    while (remain--) {
-        //Convert current sector to byte address
-        unsigned int address = sector * Sdmmc_Sector_Size;
+    FF_LOG(VERBOSE_EXTRAINFO, "FatFS: Block Verify %u Sectors. Start at %u.\n", (UINT)count, (UINT)sector);
+    while (remain) {
+        //Convert current sector to card block
+        uint32_t block = sdmmc_block(sector);
 
-        //Read the sector into the alignedBuff which we will compare against the input buff
-        const BYTE* verifyBuff = (BYTE*)alignedBuff;
+        //Read the sectors into the bounce buffer which we will compare against the input buff
+        const BYTE* verifyBuff = (BYTE*)Sdmmc_Bounce_Buff;
+        UINT burst = (remain > Sdmmc_Bounce_Sectors) ? Sdmmc_Bounce_Sectors : remain;
 
-        sdmmcStat = alt_sdmmc_read(&Card_Info, (void*)verifyBuff, (void*)address, Sdmmc_Sector_Size);
+        sdmmcStat = sdmmc_dma_read((void*)verifyBuff, block, burst * Sdmmc_Sector_Size);
+        sdmmc_trace(DISK_TRACE_VERIFY, sector, burst, sdmmcStat);
         if (sdmmcStat != ALT_E_SUCCESS) {
-            printf("FatFS: Sec %u/%u (@ 0x%08x) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+            FF_LOG(VERBOSE_ERROR, "FatFS: Sec %u+%u/%u (@ blk %u) Read Err %d.\n", (UINT)(sector - start + 1), (UINT)burst, (UINT)count, (UINT)block, sdmmcStat);
             return RES_ERROR;
         }
         if (!buff) {
             // No buffer, verify against being all zeros.
-            for (unsigned int idx = 0; idx < (Sdmmc_Sector_Size/sizeof(uint32_t)); idx++) {
-                if (alignedBuff[idx]) {
+            for (unsigned int idx = 0; idx < (burst * Sdmmc_Sector_Size/sizeof(uint32_t)); idx++) {
+                if (Sdmmc_Bounce_Buff[idx]) {
                     goto verifyError;
                 }
             }
         } else {
-            if (memcmp(buff, verifyBuff, Sdmmc_Sector_Size)) {
+            if (memcmp(buff, verifyBuff, burst * Sdmmc_Sector_Size)) {
 verifyError:
-                printf("FatFS: Sec %u/%u (@ 0x%08x) Verify Err %d.\n", (UINT)(sector - start + 1), (UINT)count, (UINT)address, sdmmcStat);
+                FF_LOG(VERBOSE_ERROR, "FatFS: Sec %u+%u/%u (@ blk %u) Verify Err %d.\n", (UINT)(sector - start + 1), (UINT)burst, (UINT)count, (UINT)block, sdmmcStat);
                 return RES_ERROR;
             }
         }
 
-        // Move on to the next sector
-        sector++;
+        // Move on to the next sector(s)
+        sector += burst;
         if (buff) {
-            buff += Sdmmc_Sector_Size;
+            buff += burst * Sdmmc_Sector_Size;
+        }
+        remain -= burst;
+        ResetWDT();
+    }
+    return RES_OK;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Verify Sector(s) by CRC                                               */
+/*-----------------------------------------------------------------------*/
+// Reads the sectors back in bursts which fill the bounce buffer, and checks
+// the CRC32 of the whole span against the CRC of the data that was written.
+// The data only passes through the CRC engine once, rather than being
+// compared a sector at a time, and the written data need not still be held
+// in memory (e.g. a firmware image with a known checksum).
+//
+// The CRC is calculated with crc32() (Util/crc32.h), so uses the hardware CRC
+// engine if crc32_setCtx() has been called. A larger FF_SDMMC_BOUNCE_SIZE
+// means fewer, longer transfers.
+
+DRESULT disk_verify_crc (
+    BYTE pdrv,          /* Physical drive number to identify the drive */
+    LBA_t sector,       /* Start sector in LBA */
+    UINT count,         /* Number of sectors to verify */
+    DWORD crc           /* Expected CRC32 of the sectors */
+)
+{
+    // Validate disk condition
+    if (pdrv == DEV_RAM) {
+        return ramdisk_verify_crc(sector, count, crc);
+    }
+    if (pdrv != DEV_MMC) {
+        return RES_PARERR; //Don't try if out of range.
+    }
+    if (!Sdmmc_Initialised) {
+        return RES_NOTRDY; //Not ready.
+    }
+    if (Sdmmc_Async_Active) {
+        return RES_NOTRDY; //Busy with an asynchronous transfer.
+    }
+    // Sectors must be on the card
+    if (!sdmmc_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+
+#if FF_SDMMC_CACHE_SECTORS > 0
+    // Ensure the card holds any data still in the cache
+    if (Sdmmc_Cache_Enabled && (sdmmc_cache_flush() != RES_OK)) {
+        return RES_ERROR;
+    }
+#endif
+
+    // Work through the sectors, as many at a time as fit in the bounce buffer
+    UINT remain = count;
+    ALT_STATUS_CODE sdmmcStat;
+    uint32_t readCrc = 0;
+    FF_LOG(VERBOSE_EXTRAINFO, "FatFS: Block CRC Verify %u Sectors. Start at %u.\n", (UINT)count, (UINT)sector);
+    while (remain) {
+        //Convert current sector to card block
+        uint32_t block = sdmmc_block(sector);
+        UINT burst = (remain > Sdmmc_Bounce_Sectors) ? Sdmmc_Bounce_Sectors : remain;
+
+        sdmmcStat = sdmmc_dma_read(Sdmmc_Bounce_Buff, block, burst * Sdmmc_Sector_Size);
+        sdmmc_trace(DISK_TRACE_VERIFY, sector, burst, sdmmcStat);
+        if (sdmmcStat != ALT_E_SUCCESS) {
+            FF_LOG(VERBOSE_ERROR, "FatFS: Sec %u+%u/%u (@ blk %u) Read Err %d.\n", (UINT)(count - remain + 1), (UINT)burst, (UINT)count, (UINT)block, sdmmcStat);
+            return RES_ERROR;
         }
+        // Chain the CRC on to the previous bursts
+        readCrc = crc32(readCrc, (const uint8_t*)Sdmmc_Bounce_Buff, burst * Sdmmc_Sector_Size);
+
+        // Move on to the next sector(s)
+        sector += burst;
+        remain -= burst;
         ResetWDT();
     }
+    if (readCrc != crc) {
+        FF_LOG(VERBOSE_ERROR, "FatFS: CRC Verify Err 0x%08x != 0x%08x.\n", (UINT)readCrc, (UINT)crc);
+        return RES_ERROR;
+    }
     return RES_OK;
 }
 
 
+/*-----------------------------------------------------------------------*/
+/* Asynchronous Sector Access                                            */
+/*-----------------------------------------------------------------------*/
+// disk_read_start/disk_write_start begin a transfer. The SDMMC IDMAC then
+// moves the data, and disk_xfer_poll is called to check for completion. A
+// burst must fit in the IDMAC descriptor ring, so longer transfers are split
+// and disk_xfer_poll starts each following burst.
+//
+// The buffer must be aligned to a cache line. Before starting, the data cache
+// over it is cleaned (writes) or cleaned and invalidated (reads). Do not touch
+// the buffer until the transfer completes. Async transfers bypass the sector
+// cache: reads flush dirty cached sectors first, and writes discard any cached
+// copies of their range.
+
+typedef struct {
+    BYTE*   buff;       // Data for next burst
+    LBA_t   sector;     // Start sector of next burst
+    UINT    remain;     // Sectors left to start
+    UINT    burst;      // Sectors in the burst in progress, 0 if none
+    bool    write;      // Write (true) or read (false)
+    DRESULT result;     // Result of the last completed transfer
+} SdmmcAsync_t;
+
+static SdmmcAsync_t Sdmmc_Async = { .result = RES_OK };
+
+// Start the next burst of an asynchronous transfer
+static DRESULT sdmmc_async_next (void) {
+    UINT maxBurst = ALT_SDMMC_DMA_MAX_TRANSFER / Sdmmc_Sector_Size;
+    if (maxBurst > FF_SDMMC_MAX_BURST) maxBurst = FF_SDMMC_MAX_BURST;
+    UINT burst = (Sdmmc_Async.remain > maxBurst) ? maxBurst : Sdmmc_Async.remain;
+    uint32_t block = sdmmc_block(Sdmmc_Async.sector);
+    ALT_STATUS_CODE sdmmcStat;
+    if (Sdmmc_Async.write) {
+        burst = sdmmc_pre_erase(Sdmmc_Async.sector, burst);
+        sdmmcStat = alt_sdmmc_block_write_start(&Card_Info, block, (void*)Sdmmc_Async.buff, burst * Sdmmc_Sector_Size);
+    } else {
+        sdmmcStat = alt_sdmmc_block_read_start(&Card_Info, (void*)Sdmmc_Async.buff, block, burst * Sdmmc_Sector_Size);
+    }
+    if (sdmmcStat != ALT_E_SUCCESS) {
+        sdmmc_trace(Sdmmc_Async.write ? DISK_TRACE_ASYNC_WRITE : DISK_TRACE_ASYNC_READ, Sdmmc_Async.sector, burst, sdmmcStat);
+        FF_LOG(VERBOSE_ERROR, "FatFS: Async Sec %u+%u (@ blk %u) Start Err %d.\n", (UINT)Sdmmc_Async.sector, (UINT)burst, (UINT)block, sdmmcStat);
+        return RES_ERROR;
+    }
+    Sdmmc_Async.burst = burst;
+    return RES_OK;
+}
+
+// Validate and start an asynchronous transfer
+static DRESULT sdmmc_async_start (BYTE pdrv, BYTE *buff, LBA_t sector, UINT count, bool write) {
+    // Validate disk condition
+    if (pdrv == DEV_RAM) {
+        // Copies complete straight away. Keep the result for disk_xfer_poll.
+        DRESULT res = write ? ramdisk_write(buff, sector, count) : ramdisk_read(buff, sector, count);
+        Ramdisk_Async_Result = res;
+        return res;
+    }
+    if (pdrv != DEV_MMC) {
+        return RES_PARERR; //Don't try if out of range.
+    }
+    if (!Sdmmc_Initialised || Sdmmc_Async_Active) {
+        return RES_NOTRDY; //Not ready, or already busy.
+    }
+    if (write && alt_sdmmc_card_is_write_protected()) {
+        return RES_WRPRT; //Write protected. Error.
+    }
+    // Buffer must be cache line aligned for the cache maintenance
+    if (!buff || !count || (((uint32_t)buff) & (ALT_CACHE_LINE_SIZE - 1))) {
+        return RES_PARERR;
+    }
+    // Sectors must be on the card
+    if (!sdmmc_in_range(sector, count)) {
+        return RES_PARERR;
+    }
+
+#if FF_SDMMC_CACHE_SECTORS > 0
+    if (Sdmmc_Cache_Enabled) {
+        if (write) {
+            // The card copy is about to be replaced
+            sdmmc_cache_invalidate(sector, count);
+        } else if (sdmmc_cache_flush() != RES_OK) {
+            // Card must hold any dirty sectors before we read it
+            return RES_ERROR;
+        }
+    }
+#endif
+
+    // Make the buffer coherent with memory for the DMA
+    if (write) {
+        alt_cache_system_clean(buff, count * Sdmmc_Sector_Size);
+    } else {
+        alt_cache_system_purge(buff, count * Sdmmc_Sector_Size);
+    }
+
+    FF_LOG(VERBOSE_EXTRAINFO, "FatFS: Async Block %s %u Sectors. Start at %u.\n", write ? "Write" : "Read", (UINT)count, (UINT)sector);
+    Sdmmc_Async.buff = buff;
+    Sdmmc_Async.sector = sector;
+    Sdmmc_Async.remain = count;
+    Sdmmc_Async.burst = 0;
+    Sdmmc_Async.write = write;
+    DRESULT res = sdmmc_async_next();
+    Sdmmc_Async.result = res;
+    Sdmmc_Async_Active = (res == RES_OK);
+    return res;
+}
+
+// Start reading sector(s) without waiting for completion
+//  - Returns RES_NOTRDY if another asynchronous transfer is in progress.
+//  - Returns RES_PARERR if buff is not aligned to ALT_CACHE_LINE_SIZE.
+DRESULT disk_read_start (
+    BYTE pdrv,          /* Physical drive number to identify the drive */
+    BYTE *buff,         /* Data buffer to store read data */
+    LBA_t sector,       /* Start sector in LBA */
+    UINT count          /* Number of sectors to read */
+)
+{
+    return sdmmc_async_start(pdrv, buff, sector, count, false);
+}
+
+// Start writing sector(s) without waiting for completion
+//  - Returns RES_NOTRDY if another asynchronous transfer is in progress.
+//  - Returns RES_PARERR if buff is not aligned to ALT_CACHE_LINE_SIZE.
+DRESULT disk_write_start (
+    BYTE pdrv,          /* Physical drive number to identify the drive */
+    const BYTE *buff,   /* Data to be written */
+    LBA_t sector,       /* Start sector in LBA */
+    UINT count          /* Number of sectors to write */
+)
+{
+    return sdmmc_async_start(pdrv, (BYTE*)buff, sector, count, true);
+}
+
+// Check for completion of an asynchronous transfer
+//  - Does not block. Starts the next burst if the previous one has completed.
+//  - Returns RES_NOTRDY while still in progress. Otherwise returns the result
+//    of the last transfer (RES_OK or RES_ERROR).
+//  - A write only completes once the card has finished programming. No
+//    interrupt signals this, so keep polling to complete writes.
+//  - May be called from the SDMMC interrupt handler.
+DRESULT disk_xfer_poll (
+    BYTE pdrv           /* Physical drive number to identify the drive */
+)
+{
+    if (pdrv == DEV_RAM) {
+        return Ramdisk_Async_Result;
+    }
+    if (pdrv != DEV_MMC) {
+        return RES_PARERR; //Don't try if out of range.
+    }
+    if (!Sdmmc_Async_Active) {
+        // Nothing in progress. Quieten any interrupt raised by a blocking transfer.
+        alt_sdmmc_int_signal_disable();
+        return Sdmmc_Async.result;
+    }
+    if (Sdmmc_Async.burst) {
+        // Check the burst in progress
+        ALT_STATUS_CODE sdmmcStat = alt_sdmmc_transfer_is_done();
+        if (sdmmcStat == ALT_E_FALSE) {
+            return RES_NOTRDY;
+        }
+        // Async bursts are recorded as they complete
+        sdmmc_trace(Sdmmc_Async.write ? DISK_TRACE_ASYNC_WRITE : DISK_TRACE_ASYNC_READ, Sdmmc_Async.sector, Sdmmc_Async.burst,
+                    (sdmmcStat == ALT_E_TRUE) ? ALT_E_SUCCESS : sdmmcStat);
+        if (sdmmcStat != ALT_E_TRUE) {
+            FF_LOG(VERBOSE_ERROR, "FatFS: Async Sec %u+%u Err %d.\n", (UINT)Sdmmc_Async.sector, (UINT)Sdmmc_Async.burst, sdmmcStat);
+            Sdmmc_Async.result = RES_ERROR;
+            Sdmmc_Async_Active = false;
+            return RES_ERROR;
+        }
+        // Move on to the next sector(s)
+        Sdmmc_Async.sector += Sdmmc_Async.burst;
+        Sdmmc_Async.buff += Sdmmc_Async.burst * Sdmmc_Sector_Size;
+        Sdmmc_Async.remain -= Sdmmc_Async.burst;
+        Sdmmc_Async.burst = 0;
+    }
+    // Let the card finish programming before we complete or send another
+    // command, so that we never block waiting for it.
+    if (alt_sdmmc_card_is_busy()) {
+        return RES_NOTRDY;
+    }
+    DRESULT res = RES_OK;
+    if (Sdmmc_Async.remain) {
+        res = sdmmc_async_next();
+        if (res == RES_OK) return RES_NOTRDY;
+    }
+    Sdmmc_Async.result = res;
+    Sdmmc_Async_Active = false;
+    return res;
+}
+
+
 /*-----------------------------------------------------------------------*/
 /* Miscellaneous Functions                                               */
 /*-----------------------------------------------------------------------*/
@@ -433,7 +1497,10 @@ DRESULT disk_ioctl (
 )
 {
 	
-    if (pdrv != 0) {
+    if (pdrv == DEV_RAM) {
+        return ramdisk_ioctl(cmd, buff);
+    }
+    if (pdrv != DEV_MMC) {
         return RES_PARERR; //Don't try if out of range.
     }
     
@@ -443,6 +1510,15 @@ DRESULT disk_ioctl (
     
     switch (cmd) {
         case CTRL_SYNC:
+            if (Sdmmc_Async_Active) {
+                return RES_NOTRDY; //Busy with an asynchronous transfer.
+            }
+#if FF_SDMMC_CACHE_SECTORS > 0
+            // Write back any dirty cached sectors
+            if (Sdmmc_Cache_Enabled) {
+                return sdmmc_cache_flush();
+            }
+#endif
             return RES_OK;
         case GET_SECTOR_COUNT:
             *(LBA_t*)buff = Sdmmc_Device_Size / Sdmmc_Sector_Size;
@@ -451,8 +1527,34 @@ DRESULT disk_ioctl (
             *(WORD*)buff = Sdmmc_Sector_Size;
             return RES_OK;
         case GET_BLOCK_SIZE:
-            *(DWORD*)buff = Sdmmc_Block_Size;
+            // Erase block in sectors is the allocation unit, if the card gave one
+            *(DWORD*)buff = Sdmmc_Au_Sectors ? Sdmmc_Au_Sectors : Sdmmc_Block_Size;
+            return RES_OK;
+        case MMC_GET_SDSTAT:
+            if (!Sdmmc_Sd_Status_Valid) {
+                return RES_PARERR; //No SD status (e.g. MMC card)
+            }
+            memcpy(buff, Sdmmc_Sd_Status, sizeof(Sdmmc_Sd_Status));
             return RES_OK;
+        case MMC_PRE_ERASE:
+            // Only SD cards understand ACMD23
+            Sdmmc_Pre_Erase_Enabled = !!*(BYTE*)buff;
+            Sdmmc_Pre_Erase = Sdmmc_Pre_Erase_Enabled && Sdmmc_Sd_Status_Valid;
+            return RES_OK;
+        case MMC_CACHE_PRELOAD: {
+            DISK_PRELOAD* preload = (DISK_PRELOAD*)buff;
+            if (Sdmmc_Async_Active) {
+                return RES_NOTRDY; //Busy with an asynchronous transfer.
+            }
+#if FF_SDMMC_CACHE_SECTORS > 0
+            if (Sdmmc_Cache_Enabled) {
+                return sdmmc_cache_preload(preload->sector, &preload->count);
+            }
+#endif
+            // No cache, so nothing is loaded
+            preload->count = 0;
+            return RES_OK;
+        }
     };
     return RES_PARERR; //Invalid parameter
 }
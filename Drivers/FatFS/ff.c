@@ -22,6 +22,10 @@
 #include <string.h>
 #include "ff.h"			/* Declarations of FatFs API */
 #include "diskio.h"		/* Declarations of device I/O functions */
+#if FF_FAT_BITMAP && !FF_FS_READONLY
+#include <stdlib.h>
+#include "Util/bit_helpers.h"	/* findFirstZero() */
+#endif
 
 
 /*--------------------------------------------------------------------------
@@ -1231,6 +1235,82 @@ static DWORD get_fat (		/* 0xFFFFFFFF:Disk error, 1:Internal error, 2..0x7FFFFFF
 
 
 
+#if FF_FAT_BITMAP && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* FAT12/16/FAT32: Cached allocation bitmap                              */
+/*-----------------------------------------------------------------------*/
+/* A bit per cluster (1:in use) held in RAM, built a few entries at a    */
+/* time by f_fatmap() and kept up to date by put_fat(). Entries beyond   */
+/* fmap_next have not been read yet, so are left for the build. Once it  */
+/* is complete, free clusters are found from the bitmap, a word at a     */
+/* time, instead of reading the FAT.                                     */
+
+#define FMAP_DONE(fs)	((fs)->fmap && (fs)->fmap_next >= (fs)->n_fatent)
+
+
+/* Free the bitmap */
+static void fmap_discard (
+	FATFS* fs		/* Filesystem object */
+)
+{
+	free(fs->fmap);
+	fs->fmap = 0;
+}
+
+
+/* Record a change to a FAT entry in the bitmap */
+static void fmap_update (
+	FATFS* fs,		/* Filesystem object */
+	DWORD clst,		/* Cluster number */
+	DWORD val		/* New value of the FAT entry */
+)
+{
+	DWORD *w, bit;
+
+
+	if (!fs->fmap || clst >= fs->fmap_next) return;	/* Not read by the build yet */
+	w = &fs->fmap[clst / 32];
+	bit = 1UL << (clst % 32);
+	if (val != 0 && !(*w & bit)) {			/* Free -> in use */
+		*w |= bit;
+		fs->fmap_free--;
+	} else if (val == 0 && (*w & bit)) {	/* In use -> free */
+		*w &= ~bit;
+		fs->fmap_free++;
+	}
+}
+
+
+/* Find a free cluster in a complete bitmap */
+static DWORD fmap_find (	/* 0:No free cluster, >=2:Free cluster# */
+	FATFS* fs,		/* Filesystem object */
+	DWORD scl		/* Search from the cluster after this, wrapping around */
+)
+{
+	DWORD ncl, end, w;
+	UINT pass;
+
+
+	ncl = scl + 1; end = fs->n_fatent;
+	for (pass = 0; pass < 2; pass++) {
+		while (ncl < end) {
+			w = fs->fmap[ncl / 32] | ((1UL << (ncl % 32)) - 1);	/* Skip clusters before ncl */
+			if (w != 0xFFFFFFFF) {
+				ncl = (ncl & ~31UL) + findFirstZero(w);
+				return (ncl < end) ? ncl : 0;
+			}
+			ncl = (ncl & ~31UL) + 32;
+		}
+		ncl = 2; end = scl + 1;				/* Wrap around */
+	}
+	return 0;
+}
+
+#endif	/* FF_FAT_BITMAP && !FF_FS_READONLY */
+
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* FAT access - Change value of an FAT entry                             */
@@ -1283,6 +1363,9 @@ static FRESULT put_fat (	/* FR_OK(0):succeeded, !=0:error */
 			fs->wflag = 1;
 			break;
 		}
+#if FF_FAT_BITMAP
+		if (res == FR_OK && fs->fs_type != FS_EXFAT) fmap_update(fs, clst, val);
+#endif
 	}
 	return res;
 }
@@ -1584,17 +1667,25 @@ static DWORD create_chain (	/* 0:No free cluster, 1:Internal error, 0xFFFFFFFF:D
 			}
 		}
 		if (ncl == 0) {	/* The new cluster cannot be contiguous and find another fragment */
-			ncl = scl;	/* Start cluster */
-			for (;;) {
-				ncl++;							/* Next cluster */
-				if (ncl >= fs->n_fatent) {		/* Check wrap-around */
-					ncl = 2;
-					if (ncl > scl) return 0;	/* No free cluster found? */
+#if FF_FAT_BITMAP
+			if (FMAP_DONE(fs)) {				/* Find from the cached bitmap */
+				ncl = fmap_find(fs, scl);
+				if (ncl == 0) return 0;			/* No free cluster found? */
+			} else
+#endif
+			{
+				ncl = scl;	/* Start cluster */
+				for (;;) {
+					ncl++;							/* Next cluster */
+					if (ncl >= fs->n_fatent) {		/* Check wrap-around */
+						ncl = 2;
+						if (ncl > scl) return 0;	/* No free cluster found? */
+					}
+					cs = get_fat(obj, ncl);			/* Get the cluster status */
+					if (cs == 0) break;				/* Found a free cluster? */
+					if (cs == 1 || cs == 0xFFFFFFFF) return cs;	/* Test for error */
+					if (ncl == scl) return 0;		/* No free cluster found? */
 				}
-				cs = get_fat(obj, ncl);			/* Get the cluster status */
-				if (cs == 0) break;				/* Found a free cluster? */
-				if (cs == 1 || cs == 0xFFFFFFFF) return cs;	/* Test for error */
-				if (ncl == scl) return 0;		/* No free cluster found? */
 			}
 		}
 		res = put_fat(fs, ncl, 0xFFFFFFFF);		/* Mark the new cluster 'EOC' */
@@ -2457,6 +2548,149 @@ static FRESULT dir_find (	/* FR_OK(0):succeeded, !=0:error */
 
 
 
+#if FF_PATH_CACHE
+/*-----------------------------------------------------------------------*/
+/* Directory path cache                                                  */
+/*-----------------------------------------------------------------------*/
+/* Maps the directory part of recently followed paths to the directory   */
+/* object, so that follow_path() only has to search the last directory.  */
+/* The last segment is always looked up, so creating or removing files   */
+/* does not affect the cache. Entries of a volume are discarded when a   */
+/* sub-directory is removed or renamed (or stretched on exFAT), and are  */
+/* not matched after the volume is mounted again.                        */
+
+typedef struct {
+	FATFS*	fs;			/* Volume (NULL:unused entry) */
+	WORD	id;			/* Volume mount ID */
+	WORD	len;		/* Length of the directory path */
+	DWORD	tick;		/* Last use */
+	DWORD	sclust;		/* Directory start cluster */
+#if FF_FS_EXFAT
+	FSIZE_t	objsize;	/* exFAT: Directory size */
+	BYTE	stat;		/* exFAT: Directory allocation status */
+	DWORD	c_scl;		/* exFAT: Containing directory start cluster */
+	DWORD	c_size;		/* exFAT: Containing directory size and status */
+	DWORD	c_ofs;		/* exFAT: Offset in the containing directory */
+#endif
+	TCHAR	path[FF_PATH_CACHE_LEN];	/* Directory path without heading separators */
+} PCENT;
+
+#if FF_FS_REENTRANT
+static PCENT PathCache[FF_VOLUMES][FF_PATH_CACHE];	/* Each volume's entries are protected by its lock */
+static DWORD PathTick[FF_VOLUMES];
+#define PCACHE(fs)	PathCache[(fs)->ldrv]
+#define PTICK(fs)	PathTick[(fs)->ldrv]
+#else
+static PCENT PathCache[FF_PATH_CACHE];
+static DWORD PathTick;
+#define PCACHE(fs)	PathCache
+#define PTICK(fs)	PathTick
+#endif
+
+
+/* Get length of the directory part of a path (0:no directory part or not cacheable) */
+static UINT pcache_dirlen (
+	const TCHAR* path		/* Path without heading separators */
+)
+{
+	UINT i, len = 0;
+
+	for (i = 0; !IsTerminator(path[i]); i++) {
+		if (IsSeparator(path[i]) && !IsSeparator(path[i - 1])) len = i;	/* Start of the last separator */
+	}
+	if (!i || IsSeparator(path[i - 1])) return 0;	/* Empty or trailing separator */
+	return (len < FF_PATH_CACHE_LEN) ? len : 0;
+}
+
+
+/* Find the directory part of a path in the cache */
+static int pcache_find (	/* 1:found and dp opened on the directory, 0:not found */
+	DIR* dp,				/* Directory object to open */
+	const TCHAR** path,		/* Path, moved on to the last segment if found */
+	UINT len				/* Length of the directory part */
+)
+{
+	FATFS *fs = dp->obj.fs;
+	PCENT *ent;
+	UINT i;
+
+
+	for (i = 0; i < FF_PATH_CACHE; i++) {
+		ent = &PCACHE(fs)[i];
+		if (ent->fs == fs && ent->id == fs->id && ent->len == len && !memcmp(ent->path, *path, len * sizeof (TCHAR))) {
+			ent->tick = ++PTICK(fs);
+			dp->obj.sclust = ent->sclust;
+#if FF_FS_EXFAT
+			dp->obj.objsize = ent->objsize;
+			dp->obj.stat = ent->stat;
+			dp->obj.c_scl = ent->c_scl;
+			dp->obj.c_size = ent->c_size;
+			dp->obj.c_ofs = ent->c_ofs;
+#endif
+			*path += len;
+			while (IsSeparator(**path)) (*path)++;	/* Strip separators */
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+/* Add the directory dp is open on to the cache, replacing the least recently used entry */
+static void pcache_add (
+	DIR* dp,				/* Directory object open on the directory */
+	const TCHAR* path,		/* Directory path */
+	UINT len				/* Length of the directory path */
+)
+{
+	FATFS *fs = dp->obj.fs;
+	PCENT *ent, *victim = &PCACHE(fs)[0];
+	UINT i;
+
+
+	for (i = 0; i < FF_PATH_CACHE; i++) {
+		ent = &PCACHE(fs)[i];
+		if (!ent->fs || ent->fs != fs || ent->id != fs->id) {	/* Unused or stale */
+			victim = ent; break;
+		}
+		if ((int)(ent->tick - victim->tick) < 0) victim = ent;
+	}
+	victim->fs = fs;
+	victim->id = fs->id;
+	victim->len = (WORD)len;
+	victim->tick = ++PTICK(fs);
+	victim->sclust = dp->obj.sclust;
+#if FF_FS_EXFAT
+	victim->objsize = dp->obj.objsize;
+	victim->stat = dp->obj.stat;
+	victim->c_scl = dp->obj.c_scl;
+	victim->c_size = dp->obj.c_size;
+	victim->c_ofs = dp->obj.c_ofs;
+#endif
+	memcpy(victim->path, path, len * sizeof (TCHAR));
+}
+
+
+/* Discard the cached directories of a volume */
+static void pcache_invalidate (
+	FATFS* fs		/* Volume */
+)
+{
+	UINT i;
+
+
+	for (i = 0; i < FF_PATH_CACHE; i++) {
+		if (PCACHE(fs)[i].fs == fs) PCACHE(fs)[i].fs = 0;
+	}
+}
+
+#else
+#define pcache_invalidate(fs)
+#endif	/* FF_PATH_CACHE */
+
+
+
+
 #if !FF_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* Register an object to the directory                                   */
@@ -2492,6 +2726,7 @@ static FRESULT dir_register (	/* FR_OK:succeeded, FR_DENIED:no free entry or too
 			if (dp->obj.sclust != 0) {		/* Is it a sub-directory? */
 				DIR dj;
 
+				pcache_invalidate(fs);		/* Cached directories may hold the old size */
 				res = load_obj_xdir(&dj, &dp->obj);	/* Load the object status */
 				if (res != FR_OK) return res;
 				dp->obj.objsize += (DWORD)fs->csize * SS(fs);		/* Increase the directory size by cluster size */
@@ -3089,6 +3324,15 @@ static FRESULT follow_path (	/* FR_OK(0): successful, !=0: error code */
 		res = dir_sdi(dp, 0);
 
 	} else {								/* Follow path */
+#if FF_PATH_CACHE
+		const TCHAR *dpath = path;
+		UINT dlen = 0;
+
+		if (!dp->obj.sclust) {				/* Paths from the root directory can be cached */
+			dlen = pcache_dirlen(path);
+			if (dlen && pcache_find(dp, &path, dlen)) dlen = 0;	/* Start at the cached directory */
+		}
+#endif
 		for (;;) {
 			res = create_name(dp, &path);	/* Get a segment name of the path */
 			if (res != FR_OK) break;
@@ -3122,6 +3366,12 @@ static FRESULT follow_path (	/* FR_OK(0): successful, !=0: error code */
 			{
 				dp->obj.sclust = ld_clust(fs, fs->win + dp->dptr % SS(fs));	/* Open next directory */
 			}
+#if FF_PATH_CACHE
+			if (dlen && path > dpath + dlen) {	/* Opened the directory part of the path */
+				pcache_add(dp, dpath, dlen);
+				dlen = 0;
+			}
+#endif
 		}
 	}
 
@@ -3425,6 +3675,9 @@ static FRESULT mount_volume (	/* FR_OK(0): successful, !=0: an error occurred */
 	/* Following code attempts to mount the volume. (find an FAT volume, analyze the BPB and initialize the filesystem object) */
 
 	fs->fs_type = 0;					/* Invalidate the filesystem object */
+#if FF_FAT_BITMAP && !FF_FS_READONLY
+	fmap_discard(fs);					/* Bitmap of the old volume is no longer valid */
+#endif
 	stat = disk_initialize(fs->pdrv);	/* Initialize the volume hosting physical drive */
 	if (stat & STA_NOINIT) { 			/* Check if the initialization succeeded */
 		return FR_NOT_READY;			/* Failed to initialize due to no medium or hard error */
@@ -3580,6 +3833,11 @@ static FRESULT mount_volume (	/* FR_OK(0): successful, !=0: an error occurred */
 #if (FF_FS_NOFSINFO & 2) == 0
 				fs->last_clst = ld_dword(fs->win + FSI_Nxt_Free);
 #endif
+				/* A count beyond the volume means the FSInfo is stale, so don't trust either value */
+				if (fs->free_clst != 0xFFFFFFFF && fs->free_clst > nclst) {
+					fs->last_clst = fs->free_clst = 0xFFFFFFFF;
+				}
+				if (fs->last_clst < 2 || fs->last_clst >= fs->n_fatent) fs->last_clst = 0xFFFFFFFF;
 			}
 		}
 #endif	/* (FF_FS_NOFSINFO & 3) != 3 */
@@ -3680,10 +3938,16 @@ FRESULT f_mount (
 		ff_mutex_delete(vol);
 #endif
 		cfs->fs_type = 0;		/* Invalidate the filesystem object to be unregistered */
+#if FF_FAT_BITMAP && !FF_FS_READONLY
+		fmap_discard(cfs);		/* Free the cached allocation bitmap */
+#endif
 	}
 
 	if (fs) {					/* Register new filesystem object */
 		fs->pdrv = LD2PD(vol);	/* Volume hosting physical drive */
+#if FF_FAT_BITMAP && !FF_FS_READONLY
+		fs->fmap = 0;			/* No cached allocation bitmap yet */
+#endif
 #if FF_FS_REENTRANT				/* Create a volume mutex */
 		fs->ldrv = (BYTE)vol;	/* Owner volume ID */
 		if (!ff_mutex_create(vol)) return FR_INT_ERR;
@@ -4204,6 +4468,38 @@ FRESULT f_sync (
 	LEAVE_FF(fs, res);
 }
 
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Synchronize the File with a Shorter Recorded Size                     */
+/*-----------------------------------------------------------------------*/
+/* Writes the directory entry with fsz as the file size, leaving the     */
+/* file object (and its allocation) as it is. Used to checkpoint a       */
+/* preallocated file which is being filled. The entry is written again   */
+/* with the real size when the file is next synced or closed.            */
+
+FRESULT f_sync_size (
+	FIL* fp,		/* Open file to be synced */
+	FSIZE_t fsz		/* Size to record, no larger than the file size */
+)
+{
+	FRESULT res;
+	FSIZE_t size;
+
+
+	if (!fp || !fp->obj.fs) return FR_INVALID_OBJECT;
+	if (!(fp->flag & FA_WRITE)) return FR_DENIED;
+	size = fp->obj.objsize;
+	if (fsz > size) return FR_INVALID_PARAMETER;
+	fp->obj.objsize = fsz;
+	fp->flag |= FA_MODIFIED;
+	res = f_sync(fp);
+	fp->obj.objsize = size;
+	fp->flag |= FA_MODIFIED;	/* Directory entry no longer matches the file object */
+	return res;
+}
+
 #endif /* !FF_FS_READONLY */
 
 
@@ -4834,6 +5130,11 @@ FRESULT f_getfree (
 		/* If free_clst is valid, return it without full FAT scan */
 		if (fs->free_clst <= fs->n_fatent - 2) {
 			*nclst = fs->free_clst;
+#if FF_FAT_BITMAP
+		} else if (FMAP_DONE(fs)) {	/* Count kept with the cached bitmap */
+			*nclst = fs->free_clst = fs->fmap_free;
+			fs->fsi_flag |= 1;
+#endif
 		} else {
 			/* Scan FAT to obtain number of free clusters */
 			nfree = 0;
@@ -4905,6 +5206,71 @@ FRESULT f_getfree (
 
 
 
+#if FF_FAT_BITMAP && !FF_FS_READONLY
+/*-----------------------------------------------------------------------*/
+/* Build the Cached Allocation Bitmap                                    */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_fatmap (
+	const TCHAR* path,	/* Logical drive number */
+	DWORD count,		/* Number of FAT entries to read in this call */
+	DWORD* remain		/* Pointer to return number of FAT entries still to be read */
+)
+{
+	FRESULT res;
+	FATFS *fs;
+	FFOBJID obj;
+	DWORD clst, stat, nw;
+
+
+	/* Get logical drive */
+	res = mount_volume(&path, &fs, 0);
+	if (res == FR_OK) {
+		if (fs->fs_type == FS_EXFAT) {	/* exFAT: Allocation bitmap is already on the volume */
+			if (remain) *remain = 0;
+			LEAVE_FF(fs, FR_OK);
+		}
+		if (!fs->fmap) {				/* Start a new bitmap */
+			nw = (fs->n_fatent + 31) / 32;
+			fs->fmap = malloc(nw * sizeof (DWORD));
+			if (!fs->fmap) LEAVE_FF(fs, FR_NOT_ENOUGH_CORE);
+			memset(fs->fmap, 0, nw * sizeof (DWORD));
+			fs->fmap[0] = 3;			/* Entries 0 and 1 are reserved */
+			if (fs->n_fatent % 32) fs->fmap[nw - 1] |= ~0UL << (fs->n_fatent % 32);	/* Past the end of the FAT */
+			fs->fmap_next = 2;
+			fs->fmap_free = 0;
+		}
+		obj.fs = fs;
+		for (clst = fs->fmap_next; count && clst < fs->n_fatent; count--, clst++) {
+			stat = get_fat(&obj, clst);
+			if (stat == 0xFFFFFFFF) {
+				res = FR_DISK_ERR; break;
+			}
+			if (stat == 1) {
+				res = FR_INT_ERR; break;
+			}
+			if (stat == 0) {
+				fs->fmap_free++;
+			} else {
+				fs->fmap[clst / 32] |= 1UL << (clst % 32);
+			}
+			fs->fmap_next = clst + 1;
+		}
+		if (res == FR_OK && FMAP_DONE(fs)) {	/* Complete, so the free count is known */
+			fs->free_clst = fs->fmap_free;
+			fs->fsi_flag |= 1;
+		}
+		if (remain) *remain = fs->n_fatent - fs->fmap_next;
+	}
+
+	LEAVE_FF(fs, res);
+}
+
+#endif	/* FF_FAT_BITMAP && !FF_FS_READONLY */
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Truncate File                                                         */
 /*-----------------------------------------------------------------------*/
@@ -5029,6 +5395,7 @@ FRESULT f_unlink (
 				}
 			}
 			if (res == FR_OK) {
+				if (dj.obj.attr & AM_DIR) pcache_invalidate(fs);	/* Paths through it are no longer valid */
 				res = dir_remove(&dj);			/* Remove the directory entry */
 				if (res == FR_OK && dclst != 0) {	/* Remove the cluster chain if exist */
 #if FF_FS_EXFAT
@@ -5163,6 +5530,7 @@ FRESULT f_rename (
 		}
 #endif
 		if (res == FR_OK) {					/* Object to be renamed is found */
+			if (djo.obj.attr & AM_DIR) pcache_invalidate(fs);	/* Paths through it are no longer valid */
 #if FF_FS_EXFAT
 			if (fs->fs_type == FS_EXFAT) {	/* At exFAT volume */
 				BYTE nf, nn;
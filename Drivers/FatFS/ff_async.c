@@ -0,0 +1,308 @@
+/*-----------------------------------------------------------------------*/
+/* Asynchronous file access for FatFs     (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_async.h for usage.                                             */
+/*                                                                       */
+/* A transfer is split into runs of sectors which are contiguous on the  */
+/* card, found from the file's cluster link map table. Each run is       */
+/* passed to disk_read_start/disk_write_start, and the next one started  */
+/* from f_async_poll once disk_xfer_poll reports it complete.            */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_async.h"
+#include "diskio.h"
+#include <string.h>
+
+#if FF_USE_FASTSEEK
+
+#if FF_FS_TINY
+#error "ff_async requires the file private sector buffer (FF_FS_TINY == 0)"
+#endif
+
+#if FF_MAX_SS == FF_MIN_SS
+#define FF_ASYNC_SS(fs) ((UINT)FF_MAX_SS)
+#else
+#define FF_ASYNC_SS(fs) ((UINT)(fs)->ssize)
+#endif
+
+typedef struct {
+    FIL*              fp;       // File being accessed
+    BYTE*             start;    // Start of the caller's buffer
+    BYTE*             buff;     // Buffer position of the next run
+    FSIZE_t           fptr;     // File offset of the next run
+    UINT              length;   // Bytes requested (clipped at end of file for reads)
+    UINT              remain;   // Bytes left to start, a whole number of sectors
+    UINT              run;      // Bytes in the run in progress, 0 if none
+    UINT              done;     // Bytes completed so far
+    bool              write;    // Write (true) or read (false)
+    FfAsyncCallback_t cb;
+    void*             param;
+    FRESULT           result;   // Result of the last completed transfer
+    UINT              bytes;    // Bytes transferred by the last completed transfer
+} FfAsync_t;
+
+static FfAsync_t Ff_Async = { .result = FR_OK };
+static volatile bool Ff_Async_Active = false;
+
+
+/*-----------------------------------------------------------------------*/
+/* Internal Functions                                                    */
+/*-----------------------------------------------------------------------*/
+
+// Map a file offset to its sector using the link map table
+//  - Returns the number of sectors from ofs to the end of its fragment, or
+//    0 if ofs is beyond the end of the table.
+//  - The sector is returned to *sect, and the cluster to *clst.
+static DWORD f_async_map (FIL* fp, FSIZE_t ofs, LBA_t* sect, DWORD* clst)
+{
+    FATFS* fs = fp->obj.fs;
+    UINT ss = FF_ASYNC_SS(fs);
+    DWORD cl = (DWORD)(ofs / ss / fs->csize);                  // Cluster offset in file
+    DWORD csect = (DWORD)(ofs / ss) & (DWORD)(fs->csize - 1);  // Sector offset in cluster
+    // Table is {size, {length, start cluster}..., 0}
+    DWORD* tbl = fp->cltbl + 1;
+    DWORD ncl;
+    while (true) {
+        ncl = tbl[0];
+        if (!ncl) return 0;
+        if (cl < ncl) break;
+        cl -= ncl;
+        tbl += 2;
+    }
+    *clst = tbl[1] + cl;
+    *sect = fs->database + (LBA_t)fs->csize * (*clst - 2) + csect;
+    return (ncl - cl) * fs->csize - csect;
+}
+
+// Start the next contiguous run of the transfer
+static FRESULT f_async_next (void)
+{
+    FIL* fp = Ff_Async.fp;
+    FATFS* fs = fp->obj.fs;
+    UINT ss = FF_ASYNC_SS(fs);
+    LBA_t sect;
+    DWORD clst;
+    DWORD avail = f_async_map(fp, Ff_Async.fptr, &sect, &clst);
+    if (!avail) return FR_INT_ERR;
+    UINT count = Ff_Async.remain / ss;
+    if (count > avail) count = avail;
+    DRESULT res;
+    if (Ff_Async.write) {
+        res = disk_write_start(fs->pdrv, Ff_Async.buff, sect, count);
+    } else {
+        res = disk_read_start(fs->pdrv, Ff_Async.buff, sect, count);
+    }
+    switch (res) {
+        case RES_OK:     Ff_Async.run = count * ss; return FR_OK;
+        case RES_PARERR: return FR_INVALID_PARAMETER;
+        case RES_NOTRDY: return FR_NOT_READY;
+        case RES_WRPRT:  return FR_WRITE_PROTECTED;
+        default:         return FR_DISK_ERR;
+    }
+}
+
+// End the transfer, updating the file object to match
+//  - Must be called with interrupts masked.
+static void f_async_finish (FRESULT res)
+{
+    FIL* fp = Ff_Async.fp;
+    FATFS* fs = fp->obj.fs;
+    UINT ss = FF_ASYNC_SS(fs);
+    UINT bytes = (Ff_Async.done > Ff_Async.length) ? Ff_Async.length : Ff_Async.done;
+    // Advance the file pointer, keeping the current cluster in step as f_lseek would.
+    FSIZE_t end = fp->fptr + bytes;
+    fp->fptr = end;
+    // The private buffer may hold a sector we have just overwritten, so discard it.
+    fp->sect = 0;
+    if (bytes) {
+        LBA_t sect;
+        DWORD clst;
+        if (f_async_map(fp, end - 1, &sect, &clst)) {
+            fp->clust = clst;
+            if (!Ff_Async.write && (end % ss)) {
+                // Stopped part way through the last sector (end of file). FatFs expects
+                // the private buffer to hold it, so copy it from the caller's buffer.
+                memcpy(fp->buf, Ff_Async.start + (bytes - (UINT)(end % ss)), ss);
+                fp->sect = sect;
+            }
+        }
+    }
+    Ff_Async.result = res;
+    Ff_Async.bytes = bytes;
+    Ff_Async_Active = false;
+}
+
+// Validate and start a transfer
+static FRESULT f_async_start (FIL* fp, BYTE* buff, UINT len, bool write, FfAsyncCallback_t cb, void* param)
+{
+    if (!fp || !fp->obj.fs) return FR_INVALID_OBJECT;
+    if (!buff || !fp->cltbl) return FR_INVALID_PARAMETER;    // Must be in fast seek mode
+    if (fp->err) return (FRESULT)fp->err;
+    if (!(fp->flag & (write ? FA_WRITE : FA_READ))) return FR_DENIED;
+    FATFS* fs = fp->obj.fs;
+    UINT ss = FF_ASYNC_SS(fs);
+    if (fp->fptr % ss) return FR_INVALID_PARAMETER;
+    if (write) {
+        // Whole sectors only, and fast seek mode cannot extend the file
+        if (len % ss) return FR_INVALID_PARAMETER;
+        if (len > fp->obj.objsize - fp->fptr) return FR_DENIED;
+#if !FF_FS_READONLY
+        // Write back anything buffered by f_write, so the card is up to date
+        FRESULT res = f_sync(fp);
+        if (res != FR_OK) return res;
+#endif
+    } else if (len > fp->obj.objsize - fp->fptr) {
+        // Clip reads at the end of the file
+        len = (UINT)(fp->obj.objsize - fp->fptr);
+    }
+    HpsErr_t irqState = IRQ_globalEnable(false);
+    if (Ff_Async_Active) {
+        IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+        return FR_TIMEOUT;
+    }
+    Ff_Async.fp = fp;
+    Ff_Async.start = buff;
+    Ff_Async.buff = buff;
+    Ff_Async.fptr = fp->fptr;
+    Ff_Async.length = len;
+    Ff_Async.remain = ((len + ss - 1) / ss) * ss;
+    Ff_Async.run = 0;
+    Ff_Async.done = 0;
+    Ff_Async.write = write;
+    Ff_Async.cb = cb;
+    Ff_Async.param = param;
+    FRESULT res = FR_OK;
+    if (Ff_Async.remain) {
+        res = f_async_next();
+    }
+    // Nothing to do is completed by the next call to f_async_poll
+    Ff_Async_Active = (res == FR_OK);
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+    return res;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Start an asynchronous read
+//  - Reads up to btr bytes from the file pointer into buff. cb may be NULL.
+//  - Returns FR_TIMEOUT if a transfer is already in progress.
+//  - Returns FR_INVALID_PARAMETER if the file or buffer are not suitable.
+FRESULT f_read_async (FIL* fp, void* buff, UINT btr, FfAsyncCallback_t cb, void* param)
+{
+    return f_async_start(fp, (BYTE*)buff, btr, false, cb, param);
+}
+
+// Start an asynchronous write
+//  - Writes btw bytes from buff at the file pointer. cb may be NULL.
+//  - Returns FR_DENIED if the write would extend the file.
+//  - Returns FR_TIMEOUT if a transfer is already in progress.
+//  - Returns FR_INVALID_PARAMETER if the file or buffer are not suitable.
+FRESULT f_write_async (FIL* fp, const void* buff, UINT btw, FfAsyncCallback_t cb, void* param)
+{
+    return f_async_start(fp, (BYTE*)buff, btw, true, cb, param);
+}
+
+// Check for completion of the asynchronous transfer
+//  - Starts the next part of the transfer if needed, and calls the
+//    callback once complete.
+//  - Returns true while a transfer is still in progress.
+bool f_async_poll (void)
+{
+    HpsErr_t irqState = IRQ_globalEnable(false);
+    if (!Ff_Async_Active) {
+        IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+        return false;
+    }
+    FRESULT res = FR_OK;
+    if (Ff_Async.run) {
+        // Check the run in progress
+        DRESULT dres = disk_xfer_poll(Ff_Async.fp->obj.fs->pdrv);
+        if (dres == RES_NOTRDY) {
+            IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+            return true;
+        }
+        if (dres == RES_OK) {
+            Ff_Async.buff += Ff_Async.run;
+            Ff_Async.fptr += Ff_Async.run;
+            Ff_Async.remain -= Ff_Async.run;
+            Ff_Async.done += Ff_Async.run;
+            Ff_Async.run = 0;
+        } else {
+            res = FR_DISK_ERR;
+        }
+    }
+    if ((res == FR_OK) && Ff_Async.remain) {
+        // Start the next fragment
+        res = f_async_next();
+        if (res == FR_OK) {
+            IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+            return true;
+        }
+    }
+    // Transfer complete
+    f_async_finish(res);
+    FIL* fp = Ff_Async.fp;
+    FfAsyncCallback_t cb = Ff_Async.cb;
+    void* param = Ff_Async.param;
+    UINT bytes = Ff_Async.bytes;
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+    // Callback may start another transfer
+    if (cb) cb(fp, res, bytes, param);
+    return Ff_Async_Active;
+}
+
+// Get the result of the last asynchronous transfer
+//  - Returns FR_OK if none has been started. *bytes (if not NULL) is set
+//    to the number of bytes transferred.
+FRESULT f_async_result (UINT* bytes)
+{
+    if (bytes) *bytes = Ff_Async.bytes;
+    return Ff_Async.result;
+}
+
+// Task wait helper
+//  - Polls the transfer. For use with Task_waitUntil (Util/task.h).
+//  - Returns ERR_BUSY while in progress, ERR_SUCCESS once complete, or
+//    ERR_IOFAIL if the transfer failed.
+HpsErr_t f_async_done (void* param)
+{
+    (void)param;
+    if (f_async_poll()) return ERR_BUSY;
+    return (Ff_Async.result == FR_OK) ? ERR_SUCCESS : ERR_IOFAIL;
+}
+
+// Event handler
+//  - Polls the transfer. Register as a repeating event with Event_create.
+//  - Always returns ERR_AGAIN to keep the event running.
+HpsErr_t f_async_eventHandler (Event_t* event, void* param)
+{
+    (void)event;
+    (void)param;
+    f_async_poll();
+    return ERR_AGAIN;
+}
+
+#if defined(__arm__)
+
+// SDMMC IRQ handler
+//  - Register for IRQ_SDMMC with HPS_IRQ_registerHandler. param is unused.
+void __irq f_async_irqHandler (HPSIRQSource interruptID, void* param, bool* handled)
+{
+    (void)interruptID;
+    (void)param;
+    if (!f_async_poll()) {
+        // Nothing in progress. Quieten the controller if a blocking
+        // transfer raised the interrupt.
+        disk_xfer_poll(DEV_MMC);
+    }
+    *handled = true;
+}
+
+#endif
+
+#endif /* FF_USE_FASTSEEK */
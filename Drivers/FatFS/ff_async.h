@@ -0,0 +1,110 @@
+/*-----------------------------------------------------------------------*/
+/* Asynchronous file access for FatFs     (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* f_read and f_write block until the SD card transfer is complete.      */
+/* f_read_async and f_write_async instead start the transfer using the   */
+/* SDMMC DMA and return straight away, so that the main loop can carry   */
+/* on with other work while the data is moved:                           */
+/*                                                                       */
+/*    f_open_fastseek(&fil, "0:/music.wav", FA_READ);                    */
+/*    f_read_async(&fil, block, sizeof(block), &blockDone, NULL);        */
+/*    while (1) {                                                        */
+/*        f_async_poll();      // Calls blockDone() when complete        */
+/*        ... other work ...                                             */
+/*    }                                                                  */
+/*                                                                       */
+/* Completion can be checked by:                                         */
+/*   - Calling f_async_poll from the main loop.                          */
+/*   - Registering f_async_eventHandler as a repeating event with the    */
+/*     event manager (Util/event.h).                                     */
+/*   - Waiting in a task with Task_waitUntil(mgr, &f_async_done, NULL).  */
+/*   - Registering f_async_irqHandler for IRQ_SDMMC with HPS_IRQ. This   */
+/*     completes reads as soon as the data arrives. Writes end when the  */
+/*     card finishes programming, which raises no interrupt, so one of   */
+/*     the above is still needed to complete writes. Files on the RAM    */
+/*     disk ("1:") are copied as each run starts and raise no interrupt  */
+/*     either.                                                           */
+/*                                                                       */
+/* Restrictions:                                                         */
+/*   - The file must be opened in fast seek mode (ff_fastseek.h), so     */
+/*     that file offsets can be mapped to sectors without reading the    */
+/*     FAT during the transfer.                                          */
+/*   - The file pointer must be on a sector boundary, and the buffer     */
+/*     aligned to a cache line (ALT_CACHE_LINE_SIZE).                    */
+/*   - Reads are clipped at the end of the file, but always transfer     */
+/*     whole sectors, so the buffer must be a whole number of sectors.   */
+/*   - Writes must be a whole number of sectors within the file size     */
+/*     (e.g. a file preallocated with f_create_contiguous).              */
+/*   - Only one transfer may be in progress at a time. Other accesses    */
+/*     to the card fail with FR_NOT_READY until it completes.            */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_ASYNC_H_
+#define FF_ASYNC_H_
+
+#include "ff.h"
+#include "ff_fastseek.h"
+
+#include <stdbool.h>
+
+#include "Util/error.h"
+#include "Util/event.h"
+#include "Util/irq.h"
+
+#if FF_USE_FASTSEEK
+
+// Completion callback
+//  - res is the result of the transfer, and bytes the number of bytes
+//    transferred. The file pointer has been advanced by bytes.
+//  - Called from f_async_poll (or the event/IRQ handler), so may be in
+//    interrupt context. A new transfer may be started from the callback.
+typedef void (*FfAsyncCallback_t)(FIL* fp, FRESULT res, UINT bytes, void* param);
+
+// Start an asynchronous read
+//  - Reads up to btr bytes from the file pointer into buff. cb may be NULL.
+//  - Returns FR_TIMEOUT if a transfer is already in progress.
+//  - Returns FR_INVALID_PARAMETER if the file or buffer are not suitable.
+FRESULT f_read_async (FIL* fp, void* buff, UINT btr, FfAsyncCallback_t cb, void* param);
+
+// Start an asynchronous write
+//  - Writes btw bytes from buff at the file pointer. cb may be NULL.
+//  - Returns FR_DENIED if the write would extend the file.
+//  - Returns FR_TIMEOUT if a transfer is already in progress.
+//  - Returns FR_INVALID_PARAMETER if the file or buffer are not suitable.
+FRESULT f_write_async (FIL* fp, const void* buff, UINT btw, FfAsyncCallback_t cb, void* param);
+
+// Check for completion of the asynchronous transfer
+//  - Starts the next part of the transfer if needed, and calls the
+//    callback once complete.
+//  - Returns true while a transfer is still in progress.
+bool f_async_poll (void);
+
+// Get the result of the last asynchronous transfer
+//  - Returns FR_OK if none has been started. *bytes (if not NULL) is set
+//    to the number of bytes transferred.
+FRESULT f_async_result (UINT* bytes);
+
+// Task wait helper
+//  - Polls the transfer. For use with Task_waitUntil (Util/task.h).
+//  - Returns ERR_BUSY while in progress, ERR_SUCCESS once complete, or
+//    ERR_IOFAIL if the transfer failed.
+HpsErr_t f_async_done (void* param);
+
+// Event handler
+//  - Polls the transfer. Register as a repeating event with Event_create.
+//  - Always returns ERR_AGAIN to keep the event running.
+HpsErr_t f_async_eventHandler (Event_t* event, void* param);
+
+#if defined(__arm__)
+
+// SDMMC IRQ handler
+//  - Register for IRQ_SDMMC with HPS_IRQ_registerHandler. param is unused.
+void __irq f_async_irqHandler (HPSIRQSource interruptID, void* param, bool* handled);
+
+#endif
+
+#endif /* FF_USE_FASTSEEK */
+
+#endif /* FF_ASYNC_H_ */
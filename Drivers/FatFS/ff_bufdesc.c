@@ -0,0 +1,36 @@
+/*-----------------------------------------------------------------------*/
+/* Shared buffer descriptor file access   (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_bufdesc.h for usage.                                           */
+/*                                                                       */
+/* FatFs and the disk driver only see a plain buffer. Any DMA performed  */
+/* by the disk driver does its own maintenance, so the descriptor only   */
+/* needs to be made valid for the CPU beforehand, and is then left in    */
+/* the CPU state after a read as the data may have been copied in.       */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_bufdesc.h"
+
+FRESULT f_read_buf (FIL* fp, BufDesc_t* buf, UINT btr, UINT* br)
+{
+    if (!buf || !buf->data || !br) return FR_INVALID_PARAMETER;
+    *br = 0;
+    if (buf->length >= buf->size) return FR_OK;
+    if (btr > buf->size - buf->length) btr = (UINT)(buf->size - buf->length);
+    if (ERR_IS_ERROR(BufDesc_prepareCpu(buf, true))) return FR_INVALID_PARAMETER;
+    FRESULT res = f_read(fp, (BYTE*)buf->data + buf->length, btr, br);
+    buf->length += *br;
+    return res;
+}
+
+#if !FF_FS_READONLY
+FRESULT f_write_buf (FIL* fp, BufDesc_t* buf, UINT* bw)
+{
+    if (!buf || !buf->data || !bw) return FR_INVALID_PARAMETER;
+    *bw = 0;
+    if (ERR_IS_ERROR(BufDesc_prepareCpu(buf, false))) return FR_INVALID_PARAMETER;
+    return f_write(fp, buf->data, (UINT)buf->length, bw);
+}
+#endif
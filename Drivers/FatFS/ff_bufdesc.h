@@ -0,0 +1,44 @@
+/*-----------------------------------------------------------------------*/
+/* Shared buffer descriptor file access   (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* Reads into and writes from a shared buffer descriptor (Util/buf_desc) */
+/* so that file data can be handed straight to or from another driver    */
+/* without copying, e.g. streaming audio blocks from the SD card:        */
+/*                                                                       */
+/*    BufDesc_alloc(dmaBufCtx, 2 * count * 4, &block);                   */
+/*    f_read_buf(&fil, block, 2 * count * 4, &br);                       */
+/*    WM8731_writeBlockDmaBuf(audio, block, count);                      */
+/*    BufDesc_release(block);   // Freed once the DMA is done            */
+/*                                                                       */
+/* The descriptor's cache state is kept up to date, so a buffer that was */
+/* last written by a device is invalidated before FatFs reads it, and    */
+/* one that FatFs has filled is cleaned before a device reads it.        */
+/*                                                                       */
+/* Restrictions:                                                         */
+/*   - The buffer must not be in use by a device while it is accessed.   */
+/*   - f_read_buf appends from buf->length, so set it to zero to refill. */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_BUFDESC_H_
+#define FF_BUFDESC_H_
+
+#include "ff.h"
+
+#include "Util/buf_desc.h"
+
+// Read from a file into a shared buffer
+//  - Appends up to btr bytes after the valid data, limited by the buffer
+//    size, and adds the number read to buf->length.
+//  - The number of bytes read is returned to *br.
+FRESULT f_read_buf (FIL* fp, BufDesc_t* buf, UINT btr, UINT* br);
+
+#if !FF_FS_READONLY
+// Write a shared buffer to a file
+//  - Writes the buf->length valid bytes.
+//  - The number of bytes written is returned to *bw.
+FRESULT f_write_buf (FIL* fp, BufDesc_t* buf, UINT* bw);
+#endif
+
+#endif /* FF_BUFDESC_H_ */
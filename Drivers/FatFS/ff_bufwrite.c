@@ -0,0 +1,256 @@
+/*-----------------------------------------------------------------------*/
+/* Buffered file writer for FatFs         (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_bufwrite.h for usage.                                          */
+/*                                                                       */
+/* The half being filled starts at file offset pos and is written once   */
+/* it holds limit bytes. limit is the half size, except for the first    */
+/* half which is shortened so that the next one starts on a cluster      */
+/* boundary. A latency flush writes only the bytes added since the last  */
+/* one (from synced), and the whole half is written again once full.     */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_bufwrite.h"
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "Util/timestamp.h"
+#include "Util/watchdog.h"
+
+#if FF_USE_FASTSEEK && !FF_FS_READONLY
+
+#if FF_MAX_SS == FF_MIN_SS
+#define FF_BUFW_SS(fs) ((UINT)FF_MAX_SS)
+#else
+#define FF_BUFW_SS(fs) ((UINT)(fs)->ssize)
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Internal Functions                                                    */
+/*-----------------------------------------------------------------------*/
+
+// Asynchronous write completion
+static void f_bufw_done (FIL* fp, FRESULT res, UINT bytes, void* param)
+{
+    (void)fp;
+    (void)bytes;
+    FfBufWriter_t* bw = (FfBufWriter_t*)param;
+    if ((res != FR_OK) && (bw->err == FR_OK)) bw->err = res;
+    bw->busy = false;
+}
+
+// Wait for the asynchronous transfer to finish
+//  - Waits for any transfer, as only one can be in progress at a time.
+static FRESULT f_bufw_wait (FfBufWriter_t* bw)
+{
+    while (f_async_poll()) {
+        ResetWDT();
+    }
+    bw->busy = false;
+    return bw->err;
+}
+
+// Synchronously write part of the half being filled
+static FRESULT f_bufw_write_sync (FfBufWriter_t* bw, UINT start, UINT end)
+{
+    FIL* fp = bw->fp;
+    // Fast seek mode cannot extend the file
+    if (fp->cltbl && ((bw->pos + end) > f_size(fp))) return FR_DENIED;
+    FRESULT res = f_lseek(fp, bw->pos + start);
+    if (res != FR_OK) return res;
+    UINT len = end - start;
+    UINT written;
+    res = f_write(fp, bw->buff[bw->fill] + start, len, &written);
+    if ((res == FR_OK) && (written != len)) res = FR_DENIED; // Volume full
+    return res;
+}
+
+// Write the half being filled once full, and move on to the other half
+static FRESULT f_bufw_write_half (FfBufWriter_t* bw)
+{
+    FRESULT res = f_bufw_wait(bw);
+    if (res != FR_OK) return res;
+    FIL* fp = bw->fp;
+    UINT ss = FF_BUFW_SS(fp->obj.fs);
+    UINT len = bw->used;
+    res = FR_INVALID_PARAMETER;
+    if (fp->cltbl && !(bw->pos % ss) && !(len % ss) && ((bw->pos + len) <= f_size(fp))) {
+        // Within a fast seek file, so can be written while the other half fills
+        res = f_lseek(fp, bw->pos);
+        if (res != FR_OK) return res;
+        bw->busy = true;
+        res = f_write_async(fp, bw->buff[bw->fill], len, &f_bufw_done, bw);
+        if (res != FR_OK) bw->busy = false;
+    }
+    if ((res == FR_INVALID_PARAMETER) || (res == FR_DENIED)) {
+        // Not suitable for an asynchronous write (e.g. buffer not aligned, or
+        // growing the file), so write it straight away.
+        res = f_bufw_write_sync(bw, 0, len);
+    }
+    if (res != FR_OK) return res;
+    bw->fill ^= 1;
+    bw->pos += len;
+    bw->used = 0;
+    bw->synced = 0;
+    bw->limit = bw->size;
+    return FR_OK;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Open a buffered writer
+//  - Appends to fp from its current file pointer. buff is split into two
+//    halves, each rounded down to a whole number of clusters (or sectors
+//    if smaller than a cluster).
+//  - maxLatency is the longest time in ms that data is buffered before
+//    f_bufw_poll writes it. Pass 0 to only write whole halves.
+//  - Returns FR_INVALID_PARAMETER if buff cannot hold two sectors.
+FRESULT f_bufw_open (FfBufWriter_t* bw, FIL* fp, void* buff, UINT size, UINT maxLatency)
+{
+    if (!bw || !fp || !fp->obj.fs) return FR_INVALID_OBJECT;
+    if (!buff) return FR_INVALID_PARAMETER;
+    if (!(fp->flag & FA_WRITE)) return FR_DENIED;
+    FATFS* fs = fp->obj.fs;
+    UINT ss = FF_BUFW_SS(fs);
+    UINT cs = (UINT)fs->csize * ss;
+    // Split into halves of whole clusters, or whole sectors if too small
+    UINT half = size / 2;
+    UINT align = (half >= cs) ? cs : ss;
+    half -= half % align;
+    if (!half) return FR_INVALID_PARAMETER;
+    bw->fp = fp;
+    bw->buff[0] = (BYTE*)buff;
+    bw->buff[1] = (BYTE*)buff + half;
+    bw->size = half;
+    bw->fill = 0;
+    bw->used = 0;
+    bw->synced = 0;
+    bw->pos = f_tell(fp);
+    // Shorten the first half so the next starts on a boundary
+    bw->limit = half - (UINT)(bw->pos % align);
+    bw->latency = 0;
+    if (maxLatency && time_rate()) {
+        bw->latency = time_nsToCycles((uint64_t)maxLatency * 1000000);
+    }
+    bw->due = 0;
+    bw->busy = false;
+    bw->err = FR_OK;
+    return FR_OK;
+}
+
+// Write to a buffered writer
+//  - Copies btw bytes from buff. Blocks only when a half is full and the
+//    previous half is still being written.
+//  - Returns the first error from an earlier write if one failed.
+FRESULT f_bufw_write (FfBufWriter_t* bw, const void* buff, UINT btw)
+{
+    if (!bw || !bw->fp) return FR_INVALID_OBJECT;
+    if (bw->err != FR_OK) return bw->err;
+    if (!buff) return FR_INVALID_PARAMETER;
+    const BYTE* src = (const BYTE*)buff;
+    while (btw) {
+        UINT len = bw->limit - bw->used;
+        if (len > btw) len = btw;
+        if (bw->latency && (bw->used == bw->synced)) {
+            // First data since the last flush
+            bw->due = time_now_cycles() + bw->latency;
+        }
+        memcpy(bw->buff[bw->fill] + bw->used, src, len);
+        bw->used += len;
+        src += len;
+        btw -= len;
+        if (bw->used == bw->limit) {
+            FRESULT res = f_bufw_write_half(bw);
+            if (res != FR_OK) {
+                bw->err = res;
+                return res;
+            }
+        }
+    }
+    return FR_OK;
+}
+
+// Write a string to a buffered writer
+//  - Returns the number of characters written, or a negative value on error.
+int f_bufw_puts (FfBufWriter_t* bw, const TCHAR* str)
+{
+    if (!str) return -1;
+    UINT len = strlen(str);
+    return (f_bufw_write(bw, str, len) == FR_OK) ? (int)len : -1;
+}
+
+// Write a formatted string to a buffered writer
+//  - As f_printf, formatted with vsnprintf into a FF_BUFW_LINE_MAX buffer.
+//  - Returns the number of characters written, or a negative value on error.
+int f_bufw_printf (FfBufWriter_t* bw, const char* fmt, ...)
+{
+    char line[FF_BUFW_LINE_MAX];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (len < 0) return -1;
+    if (len >= (int)sizeof(line)) len = sizeof(line) - 1;
+    return (f_bufw_write(bw, line, (UINT)len) == FR_OK) ? len : -1;
+}
+
+// Poll a buffered writer
+//  - Completes any asynchronous write, then flushes if buffered data has
+//    waited longer than the maximum latency.
+//  - Call regularly, e.g. from the main loop or an event.
+FRESULT f_bufw_poll (FfBufWriter_t* bw)
+{
+    if (!bw || !bw->fp) return FR_INVALID_OBJECT;
+    if (bw->busy) f_async_poll();
+    if (bw->err != FR_OK) return bw->err;
+    if (bw->latency && (bw->used > bw->synced) && (time_now_cycles() >= bw->due)) {
+        return f_bufw_flush(bw);
+    }
+    return FR_OK;
+}
+
+// Flush a buffered writer
+//  - Writes all buffered data to the card and syncs the file.
+FRESULT f_bufw_flush (FfBufWriter_t* bw)
+{
+    if (!bw || !bw->fp) return FR_INVALID_OBJECT;
+    FRESULT res = f_bufw_wait(bw);
+    if ((res == FR_OK) && (bw->used > bw->synced)) {
+        // Write just the new data. The half stays in the buffer to be written
+        // again in full, keeping later writes aligned.
+        res = f_bufw_write_sync(bw, bw->synced, bw->used);
+        if (res == FR_OK) bw->synced = bw->used;
+    }
+    if (res == FR_OK) res = f_sync(bw->fp);
+    if (res != FR_OK) bw->err = res;
+    return res;
+}
+
+// Close a buffered writer
+//  - Flushes, then leaves the file pointer at the end of the data written.
+//  - If truncate is true, any preallocated space after it is freed.
+//  - The file itself is left open.
+FRESULT f_bufw_close (FfBufWriter_t* bw, bool truncate)
+{
+    FRESULT res = f_bufw_flush(bw);
+    if (res != FR_OK) return res;
+    FIL* fp = bw->fp;
+    FSIZE_t end = bw->pos + bw->used;
+    res = f_lseek(fp, end);
+    if ((res == FR_OK) && truncate && (f_size(fp) > end)) {
+        res = f_truncate(fp);
+        if (res == FR_OK) res = f_sync(fp);
+    }
+    bw->fp = NULL;
+    return res;
+}
+
+#endif /* FF_USE_FASTSEEK && !FF_FS_READONLY */
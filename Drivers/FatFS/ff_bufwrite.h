@@ -0,0 +1,117 @@
+/*-----------------------------------------------------------------------*/
+/* Buffered file writer for FatFs         (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* Small writes with f_write or f_printf each update part of a sector,   */
+/* so FatFs reads, modifies and writes the sector for every record. A    */
+/* buffered writer instead collects records in a RAM buffer, split into  */
+/* two halves of whole clusters, and writes each half once it is full:   */
+/*                                                                       */
+/*    static BYTE logBuff[32768] __attribute__((aligned(64)));           */
+/*    f_create_contiguous(&fil, "0:/log.txt", 64 * 1024 * 1024);         */
+/*    f_bufw_open(&logw, &fil, logBuff, sizeof(logBuff), 500);           */
+/*    while (1) {                                                        */
+/*        f_bufw_printf(&logw, "%u: %d\n", seq++, reading);              */
+/*        f_bufw_poll(&logw);  // Flushes after 500ms                    */
+/*    }                                                                  */
+/*    f_bufw_close(&logw, true);                                         */
+/*    f_close_fastseek(&fil);                                            */
+/*                                                                       */
+/* Writes after the first start on a cluster boundary. If the file is in */
+/* fast seek mode and preallocated (f_create_contiguous), each full half */
+/* is written with f_write_async (ff_async.h) while the other is filled. */
+/* Otherwise it is written with f_write, which still transfers the whole */
+/* clusters directly without the sector buffer. Either way, the file     */
+/* pointer belongs to the writer until it is closed.                     */
+/*                                                                       */
+/* If a maximum latency is given, f_bufw_poll writes out buffered data   */
+/* that has waited longer than that and syncs the file, so that little   */
+/* is lost on a reset. The part-filled half is kept and written in full  */
+/* again once it fills, so later writes stay aligned. This needs the     */
+/* time base (Util/timestamp.h) to be initialised.                       */
+/*                                                                       */
+/* Restrictions:                                                         */
+/*   - The buffer must be aligned to a cache line (ALT_CACHE_LINE_SIZE)  */
+/*     for asynchronous writes. Otherwise f_write is always used.        */
+/*   - A file in fast seek mode cannot grow, so writes past its size     */
+/*     fail with FR_DENIED.                                              */
+/*   - A writer is not locked, so use each from one task only.           */
+/*   - The asynchronous transfer is shared by all files, so a writer     */
+/*     waits for any other transfer in progress before starting one.     */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_BUFWRITE_H_
+#define FF_BUFWRITE_H_
+
+#include "ff.h"
+#include "ff_async.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if FF_USE_FASTSEEK && !FF_FS_READONLY
+
+// Maximum length of one f_bufw_printf record. Longer records are truncated.
+#ifndef FF_BUFW_LINE_MAX
+#define FF_BUFW_LINE_MAX 128
+#endif
+
+typedef struct {
+    FIL*          fp;           // File being written
+    BYTE*         buff[2];      // Halves of the buffer
+    UINT          size;         // Bytes in each half, a whole number of clusters
+    UINT          fill;         // Index of the half being filled
+    UINT          used;         // Bytes in the half being filled
+    UINT          limit;        // Bytes the half being filled takes before it is written
+    UINT          synced;       // Bytes of the half being filled written by a flush
+    FSIZE_t       pos;          // File offset of the half being filled
+    uint64_t      latency;      // Maximum latency in timer cycles, 0 for none
+    uint64_t      due;          // Time by which the buffered data must be written
+    volatile bool busy;         // Other half being written asynchronously
+    volatile FRESULT err;       // First error from an asynchronous write
+} FfBufWriter_t;
+
+// Open a buffered writer
+//  - Appends to fp from its current file pointer. buff is split into two
+//    halves, each rounded down to a whole number of clusters (or sectors
+//    if smaller than a cluster).
+//  - maxLatency is the longest time in ms that data is buffered before
+//    f_bufw_poll writes it. Pass 0 to only write whole halves.
+//  - Returns FR_INVALID_PARAMETER if buff cannot hold two sectors.
+FRESULT f_bufw_open (FfBufWriter_t* bw, FIL* fp, void* buff, UINT size, UINT maxLatency);
+
+// Write to a buffered writer
+//  - Copies btw bytes from buff. Blocks only when a half is full and the
+//    previous half is still being written.
+//  - Returns the first error from an earlier write if one failed.
+FRESULT f_bufw_write (FfBufWriter_t* bw, const void* buff, UINT btw);
+
+// Write a string to a buffered writer
+//  - Returns the number of characters written, or a negative value on error.
+int f_bufw_puts (FfBufWriter_t* bw, const TCHAR* str);
+
+// Write a formatted string to a buffered writer
+//  - As f_printf, formatted with vsnprintf into a FF_BUFW_LINE_MAX buffer.
+//  - Returns the number of characters written, or a negative value on error.
+int f_bufw_printf (FfBufWriter_t* bw, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Poll a buffered writer
+//  - Completes any asynchronous write, then flushes if buffered data has
+//    waited longer than the maximum latency.
+//  - Call regularly, e.g. from the main loop or an event.
+FRESULT f_bufw_poll (FfBufWriter_t* bw);
+
+// Flush a buffered writer
+//  - Writes all buffered data to the card and syncs the file.
+FRESULT f_bufw_flush (FfBufWriter_t* bw);
+
+// Close a buffered writer
+//  - Flushes, then leaves the file pointer at the end of the data written.
+//  - If truncate is true, any preallocated space after it is freed.
+//  - The file itself is left open.
+FRESULT f_bufw_close (FfBufWriter_t* bw, bool truncate);
+
+#endif /* FF_USE_FASTSEEK && !FF_FS_READONLY */
+
+#endif /* FF_BUFWRITE_H_ */
@@ -0,0 +1,264 @@
+/*-----------------------------------------------------------------------*/
+/* In-RAM directory index for FatFs       (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_dirindex.h for usage.                                          */
+/*                                                                       */
+/* The entry and name arrays grow by doubling while the directory is     */
+/* read. Once complete, a second array of entry numbers is sorted by     */
+/* hash, so a lookup is a binary search followed by a name compare for   */
+/* each entry with the same hash.                                        */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_dirindex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Initial sizes of the entry and name arrays
+#define FF_DIRINDEX_INITIAL_ENTRIES 32
+#define FF_DIRINDEX_INITIAL_NAMES   (32 * 16)
+
+// Size of a directory entry
+#define FF_DIRINDEX_SZDIRE 32
+
+// Index being sorted, for the qsort comparison
+static FfDirIndex_t* DirIndex_Sorting;
+
+
+/*-----------------------------------------------------------------------*/
+/* Internal Functions                                                    */
+/*-----------------------------------------------------------------------*/
+
+// Fold an ASCII letter to upper case
+static TCHAR dirindex_fold (TCHAR chr)
+{
+    return ((chr >= 'a') && (chr <= 'z')) ? (TCHAR)(chr - 'a' + 'A') : chr;
+}
+
+// FNV-1a hash of a case folded name
+static DWORD dirindex_hash (const TCHAR* name)
+{
+    DWORD hash = 2166136261U;
+    while (*name) {
+        hash = (hash ^ (BYTE)dirindex_fold(*name++)) * 16777619U;
+    }
+    return hash;
+}
+
+// Compare names without case
+static bool dirindex_equal (const TCHAR* a, const TCHAR* b)
+{
+    while (*a && (dirindex_fold(*a) == dirindex_fold(*b))) {
+        a++;
+        b++;
+    }
+    return dirindex_fold(*a) == dirindex_fold(*b);
+}
+
+// Match a name against a '*' and '?' pattern without case
+static bool dirindex_pattern (const TCHAR* pat, const TCHAR* name)
+{
+    const TCHAR* star = NULL;
+    const TCHAR* retry = NULL;
+    while (*name) {
+        if ((*pat == '?') || ((*pat != '*') && *pat && (dirindex_fold(*pat) == dirindex_fold(*name)))) {
+            pat++;
+            name++;
+        } else if (*pat == '*') {
+            // Try matching nothing first, coming back to take one more character
+            star = pat++;
+            retry = name;
+        } else if (star) {
+            pat = star + 1;
+            name = ++retry;
+        } else {
+            return false;
+        }
+    }
+    while (*pat == '*') pat++;
+    return !*pat;
+}
+
+// Fill in file information from an entry
+static void dirindex_info (FfDirIndex_t* idx, UINT pos, FILINFO* fno)
+{
+    if (!fno) return;
+    const FfDirEntry_t* entry = &idx->entries[pos];
+    fno->fsize = entry->fsize;
+    fno->fdate = entry->fdate;
+    fno->ftime = entry->ftime;
+    fno->fattrib = entry->fattrib;
+    strncpy(fno->fname, idx->names + entry->name, sizeof(fno->fname) - 1);
+    fno->fname[sizeof(fno->fname) - 1] = '\0';
+#if FF_USE_LFN
+    fno->altname[0] = '\0';
+#endif
+}
+
+// Order entry numbers by hash
+static int dirindex_compare (const void* a, const void* b)
+{
+    DWORD ha = DirIndex_Sorting->entries[*(const UINT*)a].hash;
+    DWORD hb = DirIndex_Sorting->entries[*(const UINT*)b].hash;
+    return (ha > hb) - (ha < hb);
+}
+
+// Read the directory into the index
+static FRESULT dirindex_read (FfDirIndex_t* idx, DIR* dir)
+{
+    FILINFO fno;
+    UINT entrySize = 0;
+    UINT nameSize = 0;
+    UINT nameUsed = 0;
+    while (true) {
+        FRESULT res = f_readdir(dir, &fno);
+        if (res != FR_OK) return res;
+        if (!fno.fname[0]) break;
+        // The read moves on to the next entry unless it was the last one
+        DWORD ofs = dir->sect ? (dir->dptr - FF_DIRINDEX_SZDIRE) : dir->dptr;
+#if FF_USE_LFN
+        // Start of the entry block, including any long name entries
+        if (dir->blk_ofs != 0xFFFFFFFF) ofs = dir->blk_ofs;
+#endif
+        // Grow the arrays as needed
+        if (idx->count == entrySize) {
+            UINT size = entrySize ? (2 * entrySize) : FF_DIRINDEX_INITIAL_ENTRIES;
+            FfDirEntry_t* entries = (FfDirEntry_t*)realloc(idx->entries, size * sizeof(FfDirEntry_t));
+            if (!entries) return FR_NOT_ENOUGH_CORE;
+            idx->entries = entries;
+            entrySize = size;
+        }
+        UINT len = strlen(fno.fname) + 1;
+        if (nameUsed + len > nameSize) {
+            UINT size = nameSize ? (2 * nameSize) : FF_DIRINDEX_INITIAL_NAMES;
+            while (nameUsed + len > size) size *= 2;
+            TCHAR* names = (TCHAR*)realloc(idx->names, size * sizeof(TCHAR));
+            if (!names) return FR_NOT_ENOUGH_CORE;
+            idx->names = names;
+            nameSize = size;
+        }
+        // Record the entry
+        FfDirEntry_t* entry = &idx->entries[idx->count++];
+        entry->hash = dirindex_hash(fno.fname);
+        entry->ofs = ofs;
+        entry->name = nameUsed;
+        entry->fsize = fno.fsize;
+        entry->fdate = fno.fdate;
+        entry->ftime = fno.ftime;
+        entry->fattrib = fno.fattrib;
+        memcpy(idx->names + nameUsed, fno.fname, len * sizeof(TCHAR));
+        nameUsed += len;
+    }
+    return FR_OK;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Build an index of a directory
+//  - Reads every entry of the directory at path. Any previous contents
+//    of idx are not freed, so close it first if rebuilding.
+//  - Returns FR_NOT_ENOUGH_CORE if the index could not be allocated.
+FRESULT f_dirindex_open (FfDirIndex_t* idx, const TCHAR* path)
+{
+    if (!idx) return FR_INVALID_OBJECT;
+    memset(idx, 0, sizeof(*idx));
+    DIR dir;
+    FRESULT res = f_opendir(&dir, path);
+    if (res != FR_OK) return res;
+    idx->sclust = dir.obj.sclust;
+    res = dirindex_read(idx, &dir);
+    f_closedir(&dir);
+    if ((res == FR_OK) && idx->count) {
+        // Sort entry numbers by hash for lookups
+        idx->byHash = (UINT*)malloc(idx->count * sizeof(UINT));
+        if (!idx->byHash) {
+            res = FR_NOT_ENOUGH_CORE;
+        } else {
+            for (UINT pos = 0; pos < idx->count; pos++) idx->byHash[pos] = pos;
+            DirIndex_Sorting = idx;
+            qsort(idx->byHash, idx->count, sizeof(UINT), &dirindex_compare);
+        }
+    }
+    if (res != FR_OK) f_dirindex_close(idx);
+    return res;
+}
+
+// Free an index
+void f_dirindex_close (FfDirIndex_t* idx)
+{
+    if (!idx) return;
+    free(idx->entries);
+    free(idx->byHash);
+    free(idx->names);
+    memset(idx, 0, sizeof(*idx));
+}
+
+// Find an entry by name
+//  - Returns its information to *fno (which may be NULL to just check).
+//  - Returns FR_NO_FILE if there is no entry with that name.
+FRESULT f_dirindex_find (FfDirIndex_t* idx, const TCHAR* name, FILINFO* fno)
+{
+    if (!idx) return FR_INVALID_OBJECT;
+    if (!name) return FR_INVALID_PARAMETER;
+    DWORD hash = dirindex_hash(name);
+    // First entry with a hash not less than the one wanted
+    UINT lo = 0;
+    UINT hi = idx->count;
+    while (lo < hi) {
+        UINT mid = lo + (hi - lo) / 2;
+        if (idx->entries[idx->byHash[mid]].hash < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (; (lo < idx->count) && (idx->entries[idx->byHash[lo]].hash == hash); lo++) {
+        UINT pos = idx->byHash[lo];
+        if (dirindex_equal(idx->names + idx->entries[pos].name, name)) {
+            dirindex_info(idx, pos, fno);
+            return FR_OK;
+        }
+    }
+    return FR_NO_FILE;
+}
+
+// Find the next entry matching a pattern
+//  - Searches from entry *pos, which should start at 0. On a match, returns
+//    its information to *fno and sets *pos to the entry after it.
+//  - Returns FR_NO_FILE once there are no more matches.
+FRESULT f_dirindex_match (FfDirIndex_t* idx, const TCHAR* pattern, UINT* pos, FILINFO* fno)
+{
+    if (!idx) return FR_INVALID_OBJECT;
+    if (!pattern || !pos) return FR_INVALID_PARAMETER;
+    for (UINT cur = *pos; cur < idx->count; cur++) {
+        if (dirindex_pattern(pattern, idx->names + idx->entries[cur].name)) {
+            dirindex_info(idx, cur, fno);
+            *pos = cur + 1;
+            return FR_OK;
+        }
+    }
+    *pos = idx->count;
+    return FR_NO_FILE;
+}
+
+// Get an entry by number
+//  - Entries are numbered from 0 to f_dirindex_count() - 1, in directory order.
+//  - Returns FR_NO_FILE if pos is beyond the last entry.
+FRESULT f_dirindex_get (FfDirIndex_t* idx, UINT pos, FILINFO* fno)
+{
+    if (!idx) return FR_INVALID_OBJECT;
+    if (pos >= idx->count) return FR_NO_FILE;
+    dirindex_info(idx, pos, fno);
+    return FR_OK;
+}
+
+// Get the number of entries in an index
+UINT f_dirindex_count (FfDirIndex_t* idx)
+{
+    return idx ? idx->count : 0;
+}
@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------*/
+/* In-RAM directory index for FatFs       (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* Listing or searching a directory with f_readdir or f_findfirst reads  */
+/* every entry from the card and decodes its long file name each time.   */
+/* For large folders (e.g. sample libraries) that are browsed often, a   */
+/* directory index reads the folder once and keeps each entry's name,    */
+/* size and attributes in RAM, with a hash of the name for lookups:      */
+/*                                                                       */
+/*    FfDirIndex_t samples;                                              */
+/*    f_dirindex_open(&samples, "0:/samples");                           */
+/*    f_dirindex_find(&samples, "Kick01.wav", &fno);    // Hash lookup   */
+/*    UINT pos = 0;                                                      */
+/*    while (f_dirindex_match(&samples, "*.wav", &pos, &fno) == FR_OK) { */
+/*        ...                                                            */
+/*    }                                                                  */
+/*    f_dirindex_close(&samples);                                        */
+/*                                                                       */
+/* Entries are kept in directory order. Each records the offset of its   */
+/* entry block in the directory, and the index the start cluster of the  */
+/* directory, so an entry can be related back to where it is stored.     */
+/*                                                                       */
+/* Names are compared without case for ASCII letters, as FatFs does.     */
+/* Patterns use '*' and '?' as for f_findfirst, which is also enabled    */
+/* (FF_USE_FIND) for one-off searches where building an index is not     */
+/* worth it.                                                             */
+/*                                                                       */
+/* The index is a snapshot. If files are added, removed or renamed in    */
+/* the directory, rebuild it with f_dirindex_open.                       */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_DIRINDEX_H_
+#define FF_DIRINDEX_H_
+
+#include "ff.h"
+
+typedef struct {
+    DWORD   hash;           // Hash of the case folded name
+    DWORD   ofs;            // Offset of the entry block in the directory
+    UINT    name;           // Offset of the name in the name pool
+    FSIZE_t fsize;
+    WORD    fdate;
+    WORD    ftime;
+    BYTE    fattrib;
+} FfDirEntry_t;
+
+typedef struct {
+    FfDirEntry_t* entries;  // In directory order
+    UINT*   byHash;         // Entry numbers sorted by hash
+    TCHAR*  names;          // Name pool, each terminated
+    UINT    count;
+    DWORD   sclust;         // Start cluster of the directory (0 for the FAT12/16 root)
+} FfDirIndex_t;
+
+// Build an index of a directory
+//  - Reads every entry of the directory at path. Any previous contents
+//    of idx are not freed, so close it first if rebuilding.
+//  - Returns FR_NOT_ENOUGH_CORE if the index could not be allocated.
+FRESULT f_dirindex_open (FfDirIndex_t* idx, const TCHAR* path);
+
+// Free an index
+void f_dirindex_close (FfDirIndex_t* idx);
+
+// Find an entry by name
+//  - Returns its information to *fno (which may be NULL to just check).
+//  - Returns FR_NO_FILE if there is no entry with that name.
+FRESULT f_dirindex_find (FfDirIndex_t* idx, const TCHAR* name, FILINFO* fno);
+
+// Find the next entry matching a pattern
+//  - Searches from entry *pos, which should start at 0. On a match, returns
+//    its information to *fno and sets *pos to the entry after it.
+//  - Returns FR_NO_FILE once there are no more matches.
+FRESULT f_dirindex_match (FfDirIndex_t* idx, const TCHAR* pattern, UINT* pos, FILINFO* fno);
+
+// Get an entry by number
+//  - Entries are numbered from 0 to f_dirindex_count() - 1, in directory order.
+//  - Returns FR_NO_FILE if pos is beyond the last entry.
+FRESULT f_dirindex_get (FfDirIndex_t* idx, UINT pos, FILINFO* fno);
+
+// Get the number of entries in an index
+UINT f_dirindex_count (FfDirIndex_t* idx);
+
+#endif /* FF_DIRINDEX_H_ */
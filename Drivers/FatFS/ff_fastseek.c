@@ -0,0 +1,241 @@
+/*-----------------------------------------------------------------------*/
+/* Fast seek helpers for FatFs            (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_fastseek.h for usage.                                          */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_fastseek.h"
+#include <stdlib.h>
+#include <stdbool.h>
+
+#if FF_USE_FASTSEEK
+
+// Initial table size in DWORDs. Enough for three fragments. The table is
+// enlarged to the size reported by FatFs if the file has more fragments.
+#define FF_FASTSEEK_INITIAL_LEN (2 + 2 * 3)
+
+typedef struct {
+    DWORD*  tbl;        // Link map table, NULL if entry unused
+    FATFS*  fs;         // Volume the file is on
+    WORD    id;         // Mount ID of the volume when the table was built
+    DWORD   sclust;     // Start cluster of the file
+    FSIZE_t size;       // File size when the table was built
+    UINT    refs;       // Number of open files using the table
+    UINT    lastUse;    // Tick of last open for LRU replacement
+} FastSeekEntry_t;
+
+#if FF_FASTSEEK_CACHE_ENTRIES > 0
+static FastSeekEntry_t FastSeek_Cache[FF_FASTSEEK_CACHE_ENTRIES] = {{0}};
+static UINT FastSeek_Tick = 0;
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Link Map Table Cache                                                  */
+/*-----------------------------------------------------------------------*/
+
+// Build a link map table for an open file
+static FRESULT fastseek_build (FIL* fp, DWORD** pTbl)
+{
+    DWORD len = FF_FASTSEEK_INITIAL_LEN;
+    DWORD* tbl = NULL;
+    FRESULT res = FR_NOT_ENOUGH_CORE;
+    // At most two attempts: the first reports the required size if too small
+    for (UINT attempt = 0; (attempt < 2) && (res == FR_NOT_ENOUGH_CORE); attempt++) {
+        DWORD* newTbl = (DWORD*)realloc(tbl, len * sizeof(DWORD));
+        if (!newTbl) {
+            res = FR_NOT_ENOUGH_CORE;
+            break;
+        }
+        tbl = newTbl;
+        tbl[0] = len;
+        fp->cltbl = tbl;
+        res = f_lseek(fp, CREATE_LINKMAP);
+        len = tbl[0];
+    }
+    if (res != FR_OK) {
+        // Leave the file in normal seek mode
+        fp->cltbl = NULL;
+        free(tbl);
+        return res;
+    }
+    // Table now valid. Return the file pointer to the start.
+    res = f_lseek(fp, 0);
+    if (res != FR_OK) {
+        fp->cltbl = NULL;
+        free(tbl);
+        return res;
+    }
+    *pTbl = tbl;
+    return FR_OK;
+}
+
+// Attach a link map table to an open file, from the cache if possible
+static FRESULT fastseek_attach (FIL* fp, bool cacheable)
+{
+#if FF_FASTSEEK_CACHE_ENTRIES > 0
+    FATFS* fs = fp->obj.fs;
+    FastSeekEntry_t* entry;
+    if (cacheable) {
+        // Check for a table previously built for this file
+        for (entry = FastSeek_Cache; entry < &FastSeek_Cache[FF_FASTSEEK_CACHE_ENTRIES]; entry++) {
+            if (entry->tbl && (entry->fs == fs) && (entry->id == fs->id) &&
+                (entry->sclust == fp->obj.sclust) && (entry->size == fp->obj.objsize)) {
+                entry->refs++;
+                entry->lastUse = ++FastSeek_Tick;
+                fp->cltbl = entry->tbl;
+                return FR_OK;
+            }
+        }
+    }
+#endif
+    // Otherwise build a new one
+    DWORD* tbl;
+    FRESULT res = fastseek_build(fp, &tbl);
+    if (res != FR_OK) return res;
+#if FF_FASTSEEK_CACHE_ENTRIES > 0
+    if (cacheable) {
+        // Add to the cache, replacing the least recently used table not in use.
+        FastSeekEntry_t* victim = NULL;
+        for (entry = FastSeek_Cache; entry < &FastSeek_Cache[FF_FASTSEEK_CACHE_ENTRIES]; entry++) {
+            if (!entry->tbl) {
+                victim = entry;
+                break;
+            }
+            if (entry->refs) continue;
+            if (!victim || ((int)(entry->lastUse - victim->lastUse) < 0)) victim = entry;
+        }
+        // If every table is in use, the new one is left uncached and freed on close.
+        if (victim) {
+            free(victim->tbl);
+            victim->tbl = tbl;
+            victim->fs = fs;
+            victim->id = fs->id;
+            victim->sclust = fp->obj.sclust;
+            victim->size = fp->obj.objsize;
+            victim->refs = 1;
+            victim->lastUse = ++FastSeek_Tick;
+        }
+    }
+#endif
+    return FR_OK;
+}
+
+// Release the link map table of a closed file
+static void fastseek_release (DWORD* tbl)
+{
+    if (!tbl) return;
+#if FF_FASTSEEK_CACHE_ENTRIES > 0
+    for (FastSeekEntry_t* entry = FastSeek_Cache; entry < &FastSeek_Cache[FF_FASTSEEK_CACHE_ENTRIES]; entry++) {
+        if (entry->tbl == tbl) {
+            // Keep cached for the next open
+            if (entry->refs) entry->refs--;
+            return;
+        }
+    }
+#endif
+    // Uncached table
+    free(tbl);
+}
+
+// Drop any unused cached tables for a volume
+static void fastseek_invalidate (FATFS* fs)
+{
+#if FF_FASTSEEK_CACHE_ENTRIES > 0
+    for (FastSeekEntry_t* entry = FastSeek_Cache; entry < &FastSeek_Cache[FF_FASTSEEK_CACHE_ENTRIES]; entry++) {
+        if (entry->tbl && !entry->refs && (!fs || (entry->fs == fs))) {
+            free(entry->tbl);
+            entry->tbl = NULL;
+        }
+    }
+#else
+    (void)fs;
+#endif
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Open a file in fast seek mode
+//  - mode must not include FA_CREATE_ALWAYS, FA_OPEN_APPEND or FA_CREATE_NEW
+//    as the file cannot be extended in fast seek mode.
+//  - Returns FR_NOT_ENOUGH_CORE if the table could not be allocated.
+FRESULT f_open_fastseek (FIL* fp, const TCHAR* path, BYTE mode)
+{
+    if (!fp) return FR_INVALID_OBJECT;
+    if ((mode & (FA_CREATE_ALWAYS | FA_CREATE_NEW)) || ((mode & FA_OPEN_APPEND) == FA_OPEN_APPEND)) {
+        return FR_INVALID_PARAMETER;
+    }
+    FRESULT res = f_open(fp, path, mode);
+    if (res != FR_OK) return res;
+    // Files opened for writing could be truncated, so their tables are not cached.
+    res = fastseek_attach(fp, !(mode & FA_WRITE));
+    if (res != FR_OK) f_close(fp);
+    return res;
+}
+
+// Close a file opened with f_open_fastseek or f_create_contiguous
+//  - The link map table is kept in the cache for reuse.
+FRESULT f_close_fastseek (FIL* fp)
+{
+    if (!fp) return FR_INVALID_OBJECT;
+    DWORD* tbl = fp->cltbl;
+    FRESULT res = f_close(fp);
+    if (res == FR_OK) {
+        fp->cltbl = NULL;
+        fastseek_release(tbl);
+    }
+    return res;
+}
+
+#if FF_USE_EXPAND && !FF_FS_READONLY
+
+// Create a contiguous file in fast seek mode
+//  - Creates (or replaces) the file at path, and preallocates fsz bytes
+//    of contiguous clusters. The file size is set to fsz.
+//  - Returns FR_DENIED if there is no contiguous free space large enough.
+FRESULT f_create_contiguous (FIL* fp, const TCHAR* path, FSIZE_t fsz)
+{
+    if (!fp) return FR_INVALID_OBJECT;
+    FRESULT res = f_open(fp, path, FA_CREATE_ALWAYS | FA_WRITE | FA_READ);
+    if (res != FR_OK) return res;
+    // Replacing a file frees its clusters, so cached tables for the volume may be stale
+    fastseek_invalidate(fp->obj.fs);
+    res = f_expand(fp, fsz, 1);
+    if (res == FR_OK) res = f_sync(fp);
+    if (res == FR_OK) res = fastseek_attach(fp, false);
+    if (res != FR_OK) f_close(fp);
+    return res;
+}
+
+#endif
+
+// Get the first sector of a contiguous file
+//  - If the file opened in fast seek mode consists of a single fragment,
+//    returns the physical sector of the start of the file to *sect, so that
+//    the file can be streamed with disk_read/disk_write directly.
+//  - Returns FR_DENIED if the file is fragmented or empty.
+FRESULT f_contiguous_sector (FIL* fp, LBA_t* sect)
+{
+    if (!fp || !fp->obj.fs || !fp->cltbl) return FR_INVALID_OBJECT;
+    if (!sect) return FR_INVALID_PARAMETER;
+    // Table is {size, {length, start cluster}..., 0}
+    DWORD* tbl = fp->cltbl;
+    if (!tbl[1] || tbl[3]) return FR_DENIED;
+    FATFS* fs = fp->obj.fs;
+    *sect = fs->database + (LBA_t)fs->csize * (tbl[2] - 2);
+    return FR_OK;
+}
+
+// Flush the link map table cache
+//  - Frees all cached tables which are not in use by an open file.
+void f_fastseek_flush (void)
+{
+    fastseek_invalidate(NULL);
+}
+
+#endif /* FF_USE_FASTSEEK */
@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------------*/
+/* Fast seek helpers for FatFs            (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* FatFs normally follows the FAT chain from the start of the file (or   */
+/* the current cluster) on every f_lseek, which is slow for random       */
+/* access into large fragmented files. In fast seek mode it instead uses */
+/* a cluster link map table (CLMT) listing each fragment of the file.    */
+/*                                                                       */
+/* These helpers build the CLMT when a file is opened, sizing it to the  */
+/* number of fragments, and keep a small cache of recently used tables   */
+/* so that reopening the same file does not walk the chain again:        */
+/*                                                                       */
+/*    FIL fil;                                                           */
+/*    f_open_fastseek(&fil, "0:/sample.wav", FA_READ);                   */
+/*    f_lseek(&fil, offset);     // No FAT access                        */
+/*    f_read(&fil, buff, len, &br);                                      */
+/*    f_close_fastseek(&fil);                                            */
+/*                                                                       */
+/* In fast seek mode a file cannot grow, so files may only be opened for */
+/* reading, or for writing within the existing size. f_create_contiguous */
+/* preallocates a contiguous file with f_expand, which needs a CLMT with */
+/* only one fragment and can be streamed with f_contiguous_sector.       */
+/*                                                                       */
+/* Cached tables are matched on volume, start cluster and file size.     */
+/* If a file is rewritten in place with a different cluster chain but    */
+/* the same size, call f_fastseek_flush() before reopening it.           */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_FASTSEEK_H_
+#define FF_FASTSEEK_H_
+
+#include "ff.h"
+
+#if FF_USE_FASTSEEK
+
+// Number of link map tables kept cached after their file is closed.
+#ifndef FF_FASTSEEK_CACHE_ENTRIES
+#define FF_FASTSEEK_CACHE_ENTRIES 4
+#endif
+
+// Open a file in fast seek mode
+//  - mode must not include FA_CREATE_ALWAYS, FA_OPEN_APPEND or FA_CREATE_NEW
+//    as the file cannot be extended in fast seek mode.
+//  - Returns FR_NOT_ENOUGH_CORE if the table could not be allocated.
+FRESULT f_open_fastseek (FIL* fp, const TCHAR* path, BYTE mode);
+
+// Close a file opened with f_open_fastseek or f_create_contiguous
+//  - The link map table is kept in the cache for reuse.
+FRESULT f_close_fastseek (FIL* fp);
+
+#if FF_USE_EXPAND && !FF_FS_READONLY
+
+// Create a contiguous file in fast seek mode
+//  - Creates (or replaces) the file at path, and preallocates fsz bytes
+//    of contiguous clusters. The file size is set to fsz.
+//  - Returns FR_DENIED if there is no contiguous free space large enough.
+FRESULT f_create_contiguous (FIL* fp, const TCHAR* path, FSIZE_t fsz);
+
+#endif
+
+// Get the first sector of a contiguous file
+//  - If the file opened in fast seek mode consists of a single fragment,
+//    returns the physical sector of the start of the file to *sect, so that
+//    the file can be streamed with disk_read/disk_write directly.
+//  - Returns FR_DENIED if the file is fragmented or empty.
+FRESULT f_contiguous_sector (FIL* fp, LBA_t* sect);
+
+// Flush the link map table cache
+//  - Frees all cached tables which are not in use by an open file.
+void f_fastseek_flush (void);
+
+#endif /* FF_USE_FASTSEEK */
+
+#endif /* FF_FASTSEEK_H_ */
@@ -0,0 +1,115 @@
+/*-----------------------------------------------------------------------*/
+/* Forwarding file data to drivers        (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_forward.h for usage.                                           */
+/*                                                                       */
+/* f_forward first calls the callback with no data to check whether the  */
+/* sink is ready, then with each run of data within a sector. A callback */
+/* must accept at least some of the data it is given, or FatFs aborts    */
+/* with FR_INT_ERR, so each sink reports ready only if it has room for   */
+/* at least one unit.                                                    */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_forward.h"
+
+#if FF_USE_FORWARD
+
+// Sink of the forward in progress
+static void* Ff_Forward_Sink;
+
+
+/*-----------------------------------------------------------------------*/
+/* Internal Functions                                                    */
+/*-----------------------------------------------------------------------*/
+
+// LT24 pixel sink
+static UINT f_forward_lt24_sink (const BYTE* data, UINT len)
+{
+    LT24Ctx_t* lt24 = (LT24Ctx_t*)Ff_Forward_Sink;
+    if (!len) return (LT24_copyFrameBufferDone(lt24) != ERR_BUSY) ? 1 : 0;
+    UINT count = len / sizeof(unsigned short);
+    if (ERR_IS_ERROR(LT24_streamPixels(lt24, (const unsigned short*)data, count))) return 0;
+    return count * sizeof(unsigned short);
+}
+
+// WM8731 DAC ring sink
+static UINT f_forward_wm8731_sink (const BYTE* data, UINT len)
+{
+    WM8731Ctx_t* audio = (WM8731Ctx_t*)Ff_Forward_Sink;
+    if (!len) return (WM8731_getStreamSpace(audio) > 0) ? 1 : 0;
+    HpsErr_t count = WM8731_submitFrames16(audio, (const int16_t*)data, len / (2 * sizeof(int16_t)));
+    if (ERR_IS_ERROR(count)) return 0;
+    return (UINT)count * 2 * sizeof(int16_t);
+}
+
+#if !FF_FS_TINY
+// HPS UART DMA sink
+static UINT f_forward_uart_sink (const BYTE* data, UINT len)
+{
+    HPSUARTCtx_t* uart = (HPSUARTCtx_t*)Ff_Forward_Sink;
+    if (!len) return (HPS_UART_dmaDone(uart, true) == ERR_SUCCESS) ? 1 : 0;
+    HpsErr_t status = HPS_UART_writeDma(uart, data, len);
+    if (ERR_IS_ERROR(status) && (status != ERR_SKIPPED)) return 0;
+    return len;
+}
+#endif
+
+// Forward through a sink in whole units
+static FRESULT f_forward_sink (FIL* fp, void* sink, UINT (*func)(const BYTE*,UINT), UINT unit, UINT btf, UINT* bf)
+{
+    if (!bf) return FR_INVALID_PARAMETER;
+    *bf = 0;
+    if (!fp) return FR_INVALID_OBJECT;
+    if ((btf % unit) || (f_tell(fp) % unit)) return FR_INVALID_PARAMETER;
+    Ff_Forward_Sink = sink;
+    return f_forward(fp, func, btf, bf);
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Forward pixels to the LT24 display
+//  - Writes up to btf bytes of RGB565 pixels into the current window, which
+//    must first be set with LT24_setWindow().
+//  - Stops early if a DMA copy to the display is running.
+//  - Returns FR_INVALID_PARAMETER if btf or the file pointer is odd.
+FRESULT f_forward_lt24 (FIL* fp, LT24Ctx_t* lt24, UINT btf, UINT* bf)
+{
+    if (bf) *bf = 0;
+    if (!LT24_isInitialised(lt24)) return FR_INVALID_PARAMETER;
+    return f_forward_sink(fp, lt24, &f_forward_lt24_sink, sizeof(unsigned short), btf, bf);
+}
+
+// Forward 16-bit stereo frames to the WM8731 DAC ring
+//  - Queues up to btf bytes, stopping early once the ring is full.
+//  - The codec must be streaming (WM8731_startStreaming), otherwise returns
+//    FR_DENIED.
+//  - Returns FR_INVALID_PARAMETER if btf or the file pointer is not a
+//    multiple of 4.
+FRESULT f_forward_wm8731 (FIL* fp, WM8731Ctx_t* audio, UINT btf, UINT* bf)
+{
+    if (bf) *bf = 0;
+    if (!WM8731_isInitialised(audio)) return FR_INVALID_PARAMETER;
+    if (!audio->streaming) return FR_DENIED;
+    return f_forward_sink(fp, audio, &f_forward_wm8731_sink, 2 * sizeof(int16_t), btf, bf);
+}
+
+#if !FF_FS_TINY
+// Forward bytes to an HPS UART by DMA
+//  - Starts a TX DMA transfer from the file's sector buffer for the rest of
+//    the current sector, then returns. Call again to send the next sector
+//    once HPS_UART_dmaDone() no longer returns ERR_BUSY.
+//  - The UART must have a TX DMA controller (HPS_UART_setDma).
+FRESULT f_forward_uart (FIL* fp, HPSUARTCtx_t* uart, UINT btf, UINT* bf)
+{
+    if (bf) *bf = 0;
+    if (!HPS_UART_isInitialised(uart)) return FR_INVALID_PARAMETER;
+    return f_forward_sink(fp, uart, &f_forward_uart_sink, 1, btf, bf);
+}
+#endif
+
+#endif /* FF_USE_FORWARD */
@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------------*/
+/* Forwarding file data to drivers        (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* f_forward passes file data to a callback straight from the sector     */
+/* buffer that FatFs reads it into, so it never has to be copied into    */
+/* a user buffer first. These wrappers provide ready made callbacks for  */
+/* display, audio and serial drivers:                                    */
+/*                                                                       */
+/*    LT24_setWindow(lt24, 0, 0, LT24_WIDTH, LT24_HEIGHT);               */
+/*    f_forward_lt24(&img, lt24, LT24_WIDTH * LT24_HEIGHT * 2, &bf);     */
+/*                                                                       */
+/*    while (playing) {                                                  */
+/*        f_forward_wm8731(&wav, audio, 4096, &bf);  // Up to ring space */
+/*        ...                                                            */
+/*    }                                                                  */
+/*                                                                       */
+/* f_forward_lt24 writes RGB565 pixels into the current LT24 window.     */
+/* f_forward_wm8731 converts interleaved 16-bit stereo frames (as in a   */
+/* WAV file) into the DAC ring of a streaming WM8731 instance.           */
+/* f_forward_uart starts a DMA transfer of each sector straight from the */
+/* file's sector buffer to an HPS UART with a TX DMA controller set.     */
+/*                                                                       */
+/* Each wrapper returns as soon as the sink can take no more, with the   */
+/* number of bytes forwarded in *bf (possibly 0), so they can be called  */
+/* from a polling loop. For the UART this is after each sector, as the   */
+/* next sector can't be read into the buffer until the DMA is done.      */
+/*                                                                       */
+/* Restrictions:                                                         */
+/*   - The file pointer must be a multiple of the sink's unit (2 bytes   */
+/*     for pixels, 4 for audio frames), and whole units are forwarded.   */
+/*   - The sink is held in a static variable, so forward to one sink at  */
+/*     a time, and not from interrupt handlers.                          */
+/*   - While a UART transfer is running, don't read or write the file    */
+/*     other than with f_forward_uart, as that would reuse its buffer.   */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_FORWARD_H_
+#define FF_FORWARD_H_
+
+#include "ff.h"
+
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "HPS_UART/HPS_UART.h"
+
+#if FF_USE_FORWARD
+
+// Forward pixels to the LT24 display
+//  - Writes up to btf bytes of RGB565 pixels into the current window, which
+//    must first be set with LT24_setWindow().
+//  - Stops early if a DMA copy to the display is running.
+//  - Returns FR_INVALID_PARAMETER if btf or the file pointer is odd.
+FRESULT f_forward_lt24 (FIL* fp, LT24Ctx_t* lt24, UINT btf, UINT* bf);
+
+// Forward 16-bit stereo frames to the WM8731 DAC ring
+//  - Queues up to btf bytes, stopping early once the ring is full.
+//  - The codec must be streaming (WM8731_startStreaming), otherwise returns
+//    FR_DENIED.
+//  - Returns FR_INVALID_PARAMETER if btf or the file pointer is not a
+//    multiple of 4.
+FRESULT f_forward_wm8731 (FIL* fp, WM8731Ctx_t* audio, UINT btf, UINT* bf);
+
+#if !FF_FS_TINY
+// Forward bytes to an HPS UART by DMA
+//  - Starts a TX DMA transfer from the file's sector buffer for the rest of
+//    the current sector, then returns. Call again to send the next sector
+//    once HPS_UART_dmaDone() no longer returns ERR_BUSY.
+//  - The UART must have a TX DMA controller (HPS_UART_setDma).
+FRESULT f_forward_uart (FIL* fp, HPSUARTCtx_t* uart, UINT btf, UINT* bf);
+#endif
+
+#endif /* FF_USE_FORWARD */
+
+#endif /* FF_FORWARD_H_ */
@@ -0,0 +1,59 @@
+/*-----------------------------------------------------------------------*/
+/* Bare-metal volume locks for FatFs      (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* With FF_FS_REENTRANT enabled in ffconf.h, FatFs takes a lock for each */
+/* volume on entry to every file function, so files on the same volume   */
+/* can be used from several tasks, or from both cores, at once. The      */
+/* locks are provided by ffsystem.c (OS_TYPE 5) as spinlocks:            */
+/*                                                                       */
+/*   - An uncontended lock costs a single exclusive load/store pair, so  */
+/*     single threaded code is barely slowed.                            */
+/*   - While waiting, the yield function set by ff_mutex_set_yield is    */
+/*     called so that cooperative tasks can run (and so let the task     */
+/*     holding the lock finish). Otherwise the caller spins, which is    */
+/*     right when the holder is on the other core.                       */
+/*   - Waits time out after FF_FS_TIMEOUT milliseconds with FR_TIMEOUT,  */
+/*     measured with Util/timestamp. If time_initialise has not been     */
+/*     called, waits never time out.                                     */
+/*                                                                       */
+/*    TaskMgr_initialise(evtMgr, &taskMgr);                              */
+/*    ff_mutex_set_yield((TaskWaitFunc_t)&Task_yield, taskMgr);          */
+/*                                                                       */
+/* Restrictions:                                                         */
+/*   - The yield function is only called from thread mode, never from    */
+/*     an interrupt handler. File functions should not be called from    */
+/*     interrupt handlers, as a lock held by the code interrupted can    */
+/*     only time out.                                                    */
+/*   - Between cores, the MMU and caches must be enabled so that the     */
+/*     exclusive accesses work (see Util/lowlevel_arm.h).                */
+/*   - The locks protect the volume, not the file. Opening one file more */
+/*     than once for writing still needs FF_FS_LOCK.                     */
+/*   - Long file names are worked on in a buffer of about 1.1kB on the   */
+/*     stack (FF_USE_LFN 2), as re-entrancy rules out a static buffer.   */
+/*     This includes the exFAT directory entry block. Allow for this in  */
+/*     the stack size of tasks which use file functions.                 */
+/*   - Asynchronous transfers (ff_async.h) run outside the locks. Other  */
+/*     accesses to the card fail with FR_NOT_READY until they complete,  */
+/*     so should be started from the same core as the file functions.    */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_LOCK_H_
+#define FF_LOCK_H_
+
+#include "ff.h"
+
+#include "Util/task.h"
+
+#if FF_FS_REENTRANT
+
+// Set the wait function
+//  - yield is called with param while waiting for a lock held elsewhere,
+//    e.g. Task_yield with the task manager. It may return any value.
+//  - NULL (the default) spins instead.
+void ff_mutex_set_yield (TaskWaitFunc_t yield, void* param);
+
+#endif /* FF_FS_REENTRANT */
+
+#endif /* FF_LOCK_H_ */
@@ -0,0 +1,77 @@
+/*-----------------------------------------------------------------------*/
+/* FAT region preload for FatFs           (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_preload.h for usage.                                           */
+/*                                                                       */
+/* Each run of sectors is passed to the disk layer as MMC_CACHE_PRELOAD, */
+/* which reads it into consecutive cache entries in a single transfer.   */
+/* A disk layer without the command returns RES_PARERR, which is treated */
+/* as having no cache.                                                   */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_preload.h"
+#include "diskio.h"
+
+#if FF_MAX_SS == FF_MIN_SS
+#define FF_PRELOAD_SS(fs) ((UINT)FF_MAX_SS)
+#else
+#define FF_PRELOAD_SS(fs) ((UINT)(fs)->ssize)
+#endif
+
+/*-----------------------------------------------------------------------*/
+/* Internal Functions                                                    */
+/*-----------------------------------------------------------------------*/
+
+// Preload a run of sectors into the cache
+//  - Returns the number of sectors loaded.
+static UINT f_preload_run (FATFS* fs, LBA_t sector, UINT count)
+{
+    if (!count) return 0;
+    DISK_PRELOAD preload = { sector, count };
+    if (disk_ioctl(fs->pdrv, MMC_CACHE_PRELOAD, &preload) != RES_OK) return 0;
+    return preload.count;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Mount a volume and preload its FAT and root directory
+//  - Mounts the volume at path straight away, as f_mount with opt = 1.
+//  - Then reads the first nfat sectors of the FAT and the start of the root
+//    directory into the sector cache.
+//  - Returns the number of sectors loaded into the cache in *loaded (may be NULL).
+//  - A failed preload is not an error, as the volume is still usable.
+FRESULT f_mount_preload (FATFS* fs, const TCHAR* path, UINT nfat, UINT* loaded)
+{
+    if (loaded) *loaded = 0;
+    if (!fs) return FR_INVALID_OBJECT;
+    FRESULT res = f_mount(fs, path, 1);
+    if (res != FR_OK) return res;
+    // Start of the root directory
+    LBA_t dsect;
+    UINT dcount;
+    if ((fs->fs_type == FS_FAT12) || (fs->fs_type == FS_FAT16)) {
+        dsect = fs->dirbase;
+        dcount = fs->n_rootdir / (FF_PRELOAD_SS(fs) / 32);
+    } else {
+        dsect = fs->database + (LBA_t)fs->csize * (fs->dirbase - 2);
+        dcount = fs->csize;
+    }
+    if (dcount > FF_PRELOAD_DIR_SECTORS) dcount = FF_PRELOAD_DIR_SECTORS;
+    // Start of the first FAT
+    if (nfat > fs->fsize) nfat = fs->fsize;
+    UINT count;
+    if (nfat && (fs->fatbase + nfat == dsect)) {
+        // Runs straight on into the root directory
+        count = f_preload_run(fs, fs->fatbase, nfat + dcount);
+    } else {
+        count = f_preload_run(fs, fs->fatbase, nfat);
+        count += f_preload_run(fs, dsect, dcount);
+    }
+    if (loaded) *loaded = count;
+    return FR_OK;
+}
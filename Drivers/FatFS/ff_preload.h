@@ -0,0 +1,53 @@
+/*-----------------------------------------------------------------------*/
+/* FAT region preload for FatFs           (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* After mounting, the first file opened walks the root directory and    */
+/* follows the FAT, each a sector at a time, so the time from boot to    */
+/* the first file read is mostly spent waiting on single block reads.    */
+/* f_mount_preload mounts the volume and then loads the start of the FAT */
+/* and of the root directory into the diskio sector cache, each with     */
+/* one multi-block read:                                                 */
+/*                                                                       */
+/*    FATFS fs;                                                          */
+/*    f_mount_preload(&fs, "0:", 16, NULL);  // First 16 FAT sectors     */
+/*    f_open(&fil, "0:/config.txt", FA_READ); // Served from the cache   */
+/*                                                                       */
+/* Up to FF_PRELOAD_DIR_SECTORS of the root directory are loaded (the    */
+/* first cluster on FAT32 and exFAT). On FAT12/16, where the root        */
+/* directory follows the FATs, the two are loaded as one transfer if the */
+/* FAT preload reaches it. Choose nfat so that nfat plus the directory   */
+/* sectors fit in the cache (FF_SDMMC_CACHE_SECTORS), otherwise the      */
+/* directory replaces the oldest FAT sectors.                            */
+/*                                                                       */
+/* The FAT32 FSInfo sector is read while mounting, and its free cluster  */
+/* count and next free cluster are used as long as they are within the   */
+/* volume, so f_getfree and the first allocation need no FAT scan.       */
+/*                                                                       */
+/* Restrictions:                                                         */
+/*   - The preload goes to the disk outside the volume lock, so call it  */
+/*     before other tasks or the other core use the volume.              */
+/*   - Drives without a sector cache (such as the RAM disk) are mounted  */
+/*     but nothing is preloaded.                                         */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_PRELOAD_H_
+#define FF_PRELOAD_H_
+
+#include "ff.h"
+
+// Most root directory sectors to preload
+#ifndef FF_PRELOAD_DIR_SECTORS
+#define FF_PRELOAD_DIR_SECTORS 8
+#endif
+
+// Mount a volume and preload its FAT and root directory
+//  - Mounts the volume at path straight away, as f_mount with opt = 1.
+//  - Then reads the first nfat sectors of the FAT and the start of the root
+//    directory into the sector cache.
+//  - Returns the number of sectors loaded into the cache in *loaded (may be NULL).
+//  - A failed preload is not an error, as the volume is still usable.
+FRESULT f_mount_preload (FATFS* fs, const TCHAR* path, UINT nfat, UINT* loaded);
+
+#endif /* FF_PRELOAD_H_ */
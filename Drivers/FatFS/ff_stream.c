@@ -0,0 +1,166 @@
+/*-----------------------------------------------------------------------*/
+/* Streaming file writer for FatFs        (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_stream.h for usage.                                            */
+/*                                                                       */
+/* The file is a single fragment starting at st->sect, so the sector for */
+/* any offset is found without the FAT or link map table. The file       */
+/* object private buffer is never used while streaming (fp->sect stays   */
+/* 0), so FatFs has nothing stale to write back when the file is closed. */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_stream.h"
+#include "ff_fastseek.h"
+#include "diskio.h"
+#include <string.h>
+
+#if FF_USE_FASTSEEK && FF_USE_EXPAND && !FF_FS_READONLY
+
+#if FF_MAX_SS == FF_MIN_SS
+#define FF_STREAM_SS(fs) ((UINT)FF_MAX_SS)
+#else
+#define FF_STREAM_SS(fs) ((UINT)(fs)->ssize)
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Internal Functions                                                    */
+/*-----------------------------------------------------------------------*/
+
+// Write sectors of the file
+//  - ofs is the sector offset from the start of the file.
+static FRESULT f_stream_disk (FfStream_t* st, const BYTE* buff, DWORD ofs, UINT count)
+{
+    switch (disk_write(st->fp->obj.fs->pdrv, buff, st->sect + ofs, count)) {
+        case RES_OK:     return FR_OK;
+        case RES_PARERR: return FR_INVALID_PARAMETER;
+        case RES_NOTRDY: return FR_NOT_READY;
+        case RES_WRPRT:  return FR_WRITE_PROTECTED;
+        default:         return FR_DISK_ERR;
+    }
+}
+
+// Write out the partial sector
+//  - The data is kept, so the sector is written again once it fills.
+static FRESULT f_stream_flush_tail (FfStream_t* st)
+{
+    if (!st->part) return FR_OK;
+    UINT ss = FF_STREAM_SS(st->fp->obj.fs);
+    return f_stream_disk(st, (const BYTE*)st->tail, (DWORD)(st->pos / ss), 1);
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Open a streaming writer
+//  - Creates (or replaces) the file at path with fsz bytes of contiguous
+//    preallocated space, using f_create_contiguous (ff_fastseek.h).
+//  - fp is the file object to use. It is opened in fast seek mode.
+//  - Returns FR_DENIED if there is no contiguous free space large enough.
+FRESULT f_stream_open (FfStream_t* st, FIL* fp, const TCHAR* path, FSIZE_t fsz)
+{
+    if (!st || !fp) return FR_INVALID_OBJECT;
+    if (!fsz) return FR_INVALID_PARAMETER;
+    st->fp = NULL;
+    FRESULT res = f_create_contiguous(fp, path, fsz);
+    if (res != FR_OK) return res;
+    res = f_contiguous_sector(fp, &st->sect);
+    if (res != FR_OK) {
+        f_close_fastseek(fp);
+        return res;
+    }
+    st->fp = fp;
+    st->size = fsz;
+    st->pos = 0;
+    st->part = 0;
+    memset(st->tail, 0, sizeof(st->tail));
+    return FR_OK;
+}
+
+// Write to a streaming writer
+//  - Whole sectors are written directly from buff. Any partial sector at
+//    the end is kept in the stream until it fills.
+//  - The number of bytes accepted is returned to *bw.
+//  - Returns FR_DENIED if btw bytes would pass the preallocated size. As
+//    much as fits is still written.
+FRESULT f_stream_write (FfStream_t* st, const void* buff, UINT btw, UINT* bw)
+{
+    if (!bw) return FR_INVALID_PARAMETER;
+    *bw = 0;
+    if (!st || !st->fp) return FR_INVALID_OBJECT;
+    if (!buff) return FR_INVALID_PARAMETER;
+    FRESULT full = FR_OK;
+    if (btw > st->size - st->pos) {
+        btw = (UINT)(st->size - st->pos);
+        full = FR_DENIED;
+    }
+    UINT ss = FF_STREAM_SS(st->fp->obj.fs);
+    const BYTE* src = (const BYTE*)buff;
+    FRESULT res = FR_OK;
+    while (btw && (res == FR_OK)) {
+        UINT len;
+        if (st->part || (btw < ss)) {
+            // Fill the partial sector, writing it once full
+            len = ss - st->part;
+            if (len > btw) len = btw;
+            memcpy((BYTE*)st->tail + st->part, src, len);
+            st->part += len;
+            if (st->part == ss) {
+                res = f_stream_disk(st, (const BYTE*)st->tail, (DWORD)(st->pos / ss), 1);
+                if (res != FR_OK) break;
+                st->part = 0;
+                memset(st->tail, 0, sizeof(st->tail));
+            }
+        } else {
+            // Whole sectors go straight from the caller's buffer in one transfer
+            UINT count = btw / ss;
+            len = count * ss;
+            res = f_stream_disk(st, src, (DWORD)(st->pos / ss), count);
+            if (res != FR_OK) break;
+        }
+        st->pos += len;
+        src += len;
+        btw -= len;
+        *bw += len;
+    }
+    return (res != FR_OK) ? res : full;
+}
+
+// Sync a streaming writer
+//  - Writes any partial sector, flushes the disk, then updates the
+//    directory entry with the size written so far.
+FRESULT f_stream_sync (FfStream_t* st)
+{
+    if (!st || !st->fp) return FR_INVALID_OBJECT;
+    FIL* fp = st->fp;
+    FRESULT res = f_stream_flush_tail(st);
+    if (res != FR_OK) return res;
+    if (disk_ioctl(fp->obj.fs->pdrv, CTRL_SYNC, NULL) != RES_OK) return FR_DISK_ERR;
+    // The file object keeps covering the whole preallocation
+    return f_sync_size(fp, st->pos);
+}
+
+// Close a streaming writer
+//  - Writes any partial sector and closes the file.
+//  - If truncate is true, the file size is set to the data written and
+//    the rest of the preallocation is freed. Otherwise the file keeps the
+//    whole preallocated size.
+FRESULT f_stream_close (FfStream_t* st, bool truncate)
+{
+    if (!st || !st->fp) return FR_INVALID_OBJECT;
+    FIL* fp = st->fp;
+    FRESULT res = f_stream_flush_tail(st);
+    if ((res == FR_OK) && truncate && (st->pos < st->size)) {
+        res = f_lseek(fp, st->pos);
+        if (res == FR_OK) res = f_truncate(fp);
+    }
+    FRESULT cres = f_close_fastseek(fp);
+    st->fp = NULL;
+    return (res != FR_OK) ? res : cres;
+}
+
+#endif /* FF_USE_FASTSEEK && FF_USE_EXPAND && !FF_FS_READONLY */
@@ -0,0 +1,88 @@
+/*-----------------------------------------------------------------------*/
+/* Streaming file writer for FatFs        (C)T Carpenter, 2026           */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* High rate captures (audio, ADC samples, video) spend much of their    */
+/* time in f_write looking up clusters, staging partial sectors in the   */
+/* file's private buffer and updating the FAT. A streaming writer avoids */
+/* all of this: the file is preallocated as one contiguous fragment, so  */
+/* each write goes straight to its sectors on the card:                  */
+/*                                                                       */
+/*    FIL fil;                                                           */
+/*    FfStream_t cap;                                                    */
+/*    f_stream_open(&cap, &fil, "0:/capture.raw", 256 * 1024 * 1024);    */
+/*    while (capturing) {                                                */
+/*        f_stream_write(&cap, block, sizeof(block), &bw);               */
+/*    }                                                                  */
+/*    f_stream_close(&cap, true);  // Free space after the data          */
+/*                                                                       */
+/* Whole sectors are written from the caller's buffer with one multiple  */
+/* block transfer per call, so writes of whole clusters run at close to  */
+/* the raw card speed. Only a partial sector at the end of a write is    */
+/* copied, into a sector buffer in the stream, and written once full.    */
+/*                                                                       */
+/* The directory entry is only updated by f_stream_sync and by closing.  */
+/* f_stream_sync writes out the partial sector and sets the file size to */
+/* the data written so far, so a capture survives a reset. The rest of   */
+/* the preallocation is kept until closing, so after a reset without a   */
+/* close it shows as lost clusters to a disk check.                      */
+/*                                                                       */
+/* Restrictions:                                                         */
+/*   - Writes past the preallocated size fail with FR_DENIED.            */
+/*   - The stream owns the file until closed. Don't use f_write, f_read  */
+/*     or f_lseek on it meanwhile.                                       */
+/*   - Transfers go directly to the disk outside the volume lock, as for */
+/*     ff_async.h, so don't use other files on the same volume from      */
+/*     another task or core while a write is in progress.                */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_STREAM_H_
+#define FF_STREAM_H_
+
+#include "ff.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#if FF_USE_FASTSEEK && FF_USE_EXPAND && !FF_FS_READONLY
+
+typedef struct {
+    FIL*      fp;               // File being written
+    LBA_t     sect;             // First sector of the file
+    FSIZE_t   size;             // Preallocated bytes
+    FSIZE_t   pos;              // Bytes written so far, including the partial sector
+    UINT      part;             // Bytes in the partial sector
+    DWORD     tail[FF_MAX_SS / sizeof(DWORD)];   // Partial sector, zero padded
+} FfStream_t;
+
+// Open a streaming writer
+//  - Creates (or replaces) the file at path with fsz bytes of contiguous
+//    preallocated space, using f_create_contiguous (ff_fastseek.h).
+//  - fp is the file object to use. It is opened in fast seek mode.
+//  - Returns FR_DENIED if there is no contiguous free space large enough.
+FRESULT f_stream_open (FfStream_t* st, FIL* fp, const TCHAR* path, FSIZE_t fsz);
+
+// Write to a streaming writer
+//  - Whole sectors are written directly from buff. Any partial sector at
+//    the end is kept in the stream until it fills.
+//  - The number of bytes accepted is returned to *bw.
+//  - Returns FR_DENIED if btw bytes would pass the preallocated size. As
+//    much as fits is still written.
+FRESULT f_stream_write (FfStream_t* st, const void* buff, UINT btw, UINT* bw);
+
+// Sync a streaming writer
+//  - Writes any partial sector, flushes the disk, then updates the
+//    directory entry with the size written so far.
+FRESULT f_stream_sync (FfStream_t* st);
+
+// Close a streaming writer
+//  - Writes any partial sector and closes the file.
+//  - If truncate is true, the file size is set to the data written and
+//    the rest of the preallocation is freed. Otherwise the file keeps the
+//    whole preallocated size.
+FRESULT f_stream_close (FfStream_t* st, bool truncate);
+
+#endif /* FF_USE_FASTSEEK && FF_USE_EXPAND && !FF_FS_READONLY */
+
+#endif /* FF_STREAM_H_ */
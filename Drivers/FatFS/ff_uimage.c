@@ -0,0 +1,99 @@
+/*-----------------------------------------------------------------------*/
+/* Pipelined U-Boot image loading for FatFs  (C)T Carpenter, 2026        */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* See ff_uimage.h for usage.                                            */
+/*                                                                       */
+/* The first chunk is read on its own so that the header can be checked  */
+/* and the image size found. After that, each chunk read is started      */
+/* before the previous chunk is CRCed, so the two overlap. Chunks are    */
+/* whole sectors, so the DMA and CRC never share a cache line.           */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#include "ff_uimage.h"
+
+#include "Util/watchdog.h"
+
+#if FF_USE_FASTSEEK
+
+#if FF_MAX_SS == FF_MIN_SS
+#define FF_UIMAGE_SS(fs) ((UINT)FF_MAX_SS)
+#else
+#define FF_UIMAGE_SS(fs) ((UINT)(fs)->ssize)
+#endif
+
+
+/*-----------------------------------------------------------------------*/
+/* Internal Functions                                                    */
+/*-----------------------------------------------------------------------*/
+
+// Wait for the asynchronous read to finish
+//  - Returns ERR_IOFAIL if it failed, otherwise the bytes read to *bytes.
+static HpsErr_t f_uimage_wait (UINT* bytes)
+{
+    while (f_async_poll()) {
+        ResetWDT();
+    }
+    return (f_async_result(bytes) == FR_OK) ? ERR_SUCCESS : ERR_IOFAIL;
+}
+
+
+/*-----------------------------------------------------------------------*/
+/* Public Functions                                                      */
+/*-----------------------------------------------------------------------*/
+
+// Load and verify a U-Boot image
+//  - Loads the image at the file pointer to dest, which has space for
+//    maxSize bytes, checking the header and data CRCs while loading.
+//  - chunk is the number of bytes to read at a time, rounded down to a
+//    whole number of sectors. Pass 0 to use CHUNKSZ_CRC32.
+//  - Returns ERR_CORRUPT if the header is invalid or the file is too short.
+//  - Returns ERR_CHECKSUM if either CRC check fails.
+//  - Returns ERR_TOOBIG if the image does not fit in maxSize bytes.
+//  - Returns ERR_IOFAIL if a read fails.
+HpsErr_t f_load_uimage (FIL* fp, struct legacy_img_hdr* dest, UINT maxSize, UINT chunk)
+{
+    if (!fp || !fp->obj.fs || !dest) return ERR_NULLPTR;
+    UINT ss = FF_UIMAGE_SS(fp->obj.fs);
+    if (!chunk) chunk = CHUNKSZ_CRC32;
+    chunk = (chunk / ss) * ss;
+    if (!chunk) chunk = ss;
+    maxSize = (maxSize / ss) * ss;
+    if (maxSize < image_get_header_size()) return ERR_TOOBIG;
+    BYTE* buff = (BYTE*)dest;
+    // Read the first chunk to get the header
+    UINT len = (chunk < maxSize) ? chunk : maxSize;
+    if (f_read_async(fp, buff, len, NULL, NULL) != FR_OK) return ERR_IOFAIL;
+    UINT loaded;
+    HpsErr_t status = f_uimage_wait(&loaded);
+    if (ERR_IS_ERROR(status)) return status;
+    if (loaded < image_get_header_size()) return ERR_CORRUPT;
+    if (!image_check_magic(dest)) return ERR_CORRUPT;
+    if (!image_check_hcrc(dest)) return ERR_CHECKSUM;
+    // Whole sectors of the image must fit
+    UINT total = image_get_image_size(dest);
+    if ((total < image_get_header_size()) || (((total + ss - 1) / ss) > (maxSize / ss))) return ERR_TOOBIG;
+    struct image_dcrc_stream stream;
+    image_dcrc_stream_init(&stream, dest);
+    UINT checked = image_get_header_size();
+    while (loaded < total) {
+        // Start reading the next chunk
+        len = ((total - loaded) + ss - 1) / ss * ss;
+        if (len > chunk) len = chunk;
+        if (f_read_async(fp, buff + loaded, len, NULL, NULL) != FR_OK) return ERR_IOFAIL;
+        // CRC the previous chunk while it is read
+        image_dcrc_stream_update(&stream, buff + checked, loaded - checked);
+        checked = loaded;
+        UINT bytes;
+        status = f_uimage_wait(&bytes);
+        if (ERR_IS_ERROR(status)) return status;
+        if (!bytes) return ERR_CORRUPT;
+        loaded += bytes;
+    }
+    // CRC the last chunk
+    image_dcrc_stream_update(&stream, buff + checked, loaded - checked);
+    return image_dcrc_stream_check(&stream) ? ERR_SUCCESS : ERR_CHECKSUM;
+}
+
+#endif /* FF_USE_FASTSEEK */
@@ -0,0 +1,52 @@
+/*-----------------------------------------------------------------------*/
+/* Pipelined U-Boot image loading for FatFs  (C)T Carpenter, 2026        */
+/*-----------------------------------------------------------------------*/
+/*                                                                       */
+/* Loads a legacy U-Boot image (Util/uboot_image.h) from a file into     */
+/* memory and checks its data CRC at the same time. The image is read    */
+/* in chunks with f_read_async (ff_async.h), and each chunk is CRCed     */
+/* while the SDMMC DMA reads the next, so the CRC check finishes         */
+/* almost as soon as the load does rather than needing a second pass:    */
+/*                                                                       */
+/*    f_open_fastseek(&fil, "0:/app.uimg", FA_READ);                     */
+/*    if (ERR_IS_SUCCESS(f_load_uimage(&fil, loadAddr, loadSize, 0))) {  */
+/*        ... jump to image_get_ep(loadAddr) ...                         */
+/*    }                                                                  */
+/*                                                                       */
+/* Compressed images can be loaded to a staging buffer then unpacked     */
+/* to their load address with image_decomp() (e.g. IH_COMP_LZ4).         */
+/*                                                                       */
+/* The image, including its header, is loaded to dest so that it has     */
+/* the layout image_get_data() expects. The same restrictions as         */
+/* f_read_async apply: the file must be opened in fast seek mode, the    */
+/* file pointer must be on a sector boundary, and dest aligned to a      */
+/* cache line. Whole sectors are always read, so up to one sector past   */
+/* the end of the image may be overwritten.                              */
+/*                                                                       */
+/*-----------------------------------------------------------------------*/
+
+#ifndef FF_UIMAGE_H_
+#define FF_UIMAGE_H_
+
+#include "ff.h"
+#include "ff_async.h"
+
+#include "Util/uboot_image.h"
+#include "Util/error.h"
+
+#if FF_USE_FASTSEEK
+
+// Load and verify a U-Boot image
+//  - Loads the image at the file pointer to dest, which has space for
+//    maxSize bytes, checking the header and data CRCs while loading.
+//  - chunk is the number of bytes to read at a time, rounded down to a
+//    whole number of sectors. Pass 0 to use CHUNKSZ_CRC32.
+//  - Returns ERR_CORRUPT if the header is invalid or the file is too short.
+//  - Returns ERR_CHECKSUM if either CRC check fails.
+//  - Returns ERR_TOOBIG if the image does not fit in maxSize bytes.
+//  - Returns ERR_IOFAIL if a read fails.
+HpsErr_t f_load_uimage (FIL* fp, struct legacy_img_hdr* dest, UINT maxSize, UINT chunk);
+
+#endif /* FF_USE_FASTSEEK */
+
+#endif /* FF_UIMAGE_H_ */
@@ -25,7 +25,7 @@
 /   3: f_lseek() function is removed in addition to 2. */
 
 
-#define FF_USE_FIND		0
+#define FF_USE_FIND		1
 /* This option switches filtered directory read functions, f_findfirst() and
 /  f_findnext(). (0:Disable, 1:Enable 2:Enable with matching altname[] too) */
 
@@ -34,11 +34,11 @@
 /* This option switches f_mkfs() function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FASTSEEK	0
+#define FF_USE_FASTSEEK	1
 /* This option switches fast seek function. (0:Disable or 1:Enable) */
 
 
-#define FF_USE_EXPAND	0
+#define FF_USE_EXPAND	1
 /* This option switches f_expand function. (0:Disable or 1:Enable) */
 
 
@@ -52,7 +52,7 @@
 /  (0:Disable or 1:Enable) */
 
 
-#define FF_USE_FORWARD	0
+#define FF_USE_FORWARD	1
 /* This option switches f_forward() function. (0:Disable or 1:Enable) */
 
 
@@ -113,7 +113,7 @@
 */
 
 
-#define FF_USE_LFN		1
+#define FF_USE_LFN		2
 #define FF_MAX_LFN		255
 /* The FF_USE_LFN switches the support for LFN (long file name).
 /
@@ -166,8 +166,9 @@
 / Drive/Volume Configurations
 /---------------------------------------------------------------------------*/
 
-#define FF_VOLUMES		1 //DO NOT CHANGE!
-/* Number of volumes (logical drives) to be used. (1-10) */
+#define FF_VOLUMES		2 //"0:" is SD (DEV_MMC), "1:" is the RAM disk (DEV_RAM). Must match VolToPart.
+/* Number of volumes (logical drives) to be used. (1-10)
+/  Volume 0 is the SD card, and volume 1 the DDR RAM disk (see diskio_socfpga.c). */
 
 
 #define FF_STR_VOLUME_ID	0
@@ -203,7 +204,7 @@
 /  GET_SECTOR_SIZE command. */
 
 
-#define FF_LBA64		0
+#define FF_LBA64		1
 /* This option switches support for 64-bit LBA. (0:Disable or 1:Enable)
 /  To enable the 64-bit LBA, also exFAT needs to be enabled. (FF_FS_EXFAT == 1) */
 
@@ -231,7 +232,7 @@
 /  buffer in the filesystem object (FATFS) is used for the file data transfer. */
 
 
-#define FF_FS_EXFAT		0
+#define FF_FS_EXFAT		1
 /* This option switches support for exFAT filesystem. (0:Disable or 1:Enable)
 /  To enable exFAT, also LFN needs to be enabled. (FF_USE_LFN >= 1)
 /  Note that enabling exFAT discards ANSI C (C89) compatibility. */
@@ -263,6 +264,26 @@
 */
 
 
+#define FF_PATH_CACHE	16
+#define FF_PATH_CACHE_LEN	64
+/* The option FF_PATH_CACHE sets the number of directories kept in the path
+/  cache (0:Disable). Opening files by full path then only searches the last
+/  directory when the rest of the path has been followed recently. Each entry
+/  holds up to FF_PATH_CACHE_LEN - 1 characters of the directory path, and
+/  longer paths are not cached. Each volume has its own entries when
+/  FF_FS_REENTRANT == 1. */
+
+
+#define FF_FAT_BITMAP	1
+/* The option FF_FAT_BITMAP switches the cached allocation bitmap for FAT12/16/32
+/  volumes. (0:Disable or 1:Enable) When enabled, f_fatmap() reads count FAT
+/  entries per call into a bitmap of one bit per cluster, allocated with malloc
+/  (e.g. 128kB for a 32GB FAT32 card with 32kB clusters). Call it from idle time
+/  after mounting until it reports no entries remain. From then on free clusters
+/  are found from the bitmap, and f_getfree() needs no FAT scan. The bitmap is
+/  freed when the volume is unmounted. exFAT volumes have their own bitmap. */
+
+
 #define FF_FS_LOCK		0
 /* The option FF_FS_LOCK switches file lock function to control duplicated file open
 /  and illegal operation to open objects. This option must be 0 when FF_FS_READONLY
@@ -275,7 +296,7 @@
 /      lock control is independent of re-entrancy. */
 
 
-#define FF_FS_REENTRANT	0
+#define FF_FS_REENTRANT	1
 #define FF_FS_TIMEOUT	1000
 /* The option FF_FS_REENTRANT switches the re-entrancy (thread safe) of the FatFs
 /  module itself. Note that regardless of this option, file access to different
@@ -288,7 +309,8 @@
 /      ff_mutex_create(), ff_mutex_delete(), ff_mutex_take() and ff_mutex_give()
 /      function, must be added to the project. Samples are available in ffsystem.c.
 /
-/  The FF_FS_TIMEOUT defines timeout period in unit of O/S time tick.
+/  The FF_FS_TIMEOUT defines timeout period in unit of O/S time tick. For the
+/  bare-metal locks in ffsystem.c (see ff_lock.h) this is in milliseconds.
 */
 
 
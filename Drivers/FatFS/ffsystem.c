@@ -39,7 +39,7 @@ void ff_memfree (
 /* Definitions of Mutex                                                   */
 /*------------------------------------------------------------------------*/
 
-#define OS_TYPE	0	/* 0:Win32, 1:uITRON4.0, 2:uC/OS-II, 3:FreeRTOS, 4:CMSIS-RTOS */
+#define OS_TYPE	5	/* 0:Win32, 1:uITRON4.0, 2:uC/OS-II, 3:FreeRTOS, 4:CMSIS-RTOS, 5:Bare-metal (ff_lock.h) */
 
 
 #if   OS_TYPE == 0	/* Win32 */
@@ -64,6 +64,61 @@ static SemaphoreHandle_t Mutex[FF_VOLUMES + 1];	/* Table of mutex handle */
 #include "cmsis_os.h"
 static osMutexId Mutex[FF_VOLUMES + 1];	/* Table of mutex ID */
 
+#elif OS_TYPE == 5	/* Bare-metal */
+#include "ff_lock.h"
+#include "Util/irq.h"
+#include "Util/timestamp.h"
+#if defined(__arm__)
+#include "Util/lowlevel_arm.h"
+#endif
+static volatile unsigned int Mutex[FF_VOLUMES + 1];	/* Table of spinlocks */
+static TaskWaitFunc_t Mutex_Yield = NULL;	/* Called while waiting for a lock */
+static void* Mutex_Yield_Param = NULL;
+
+/* Try to take a lock without waiting */
+static int ff_mutex_try (volatile unsigned int* lock)
+{
+#if defined(__arm__)
+	return (int)__SPIN_TRYLOCK(lock);
+#else
+	HpsErr_t irqState = IRQ_globalEnable(false);
+	int taken = (*lock == 0);
+	if (taken) *lock = 1;
+	IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+	return taken;
+#endif
+}
+
+/* Let something else run while waiting for a lock */
+static void ff_mutex_wait (void)
+{
+	if (!Mutex_Yield) return;
+#if defined(__arm__)
+	/* Never switch tasks from an interrupt handler */
+	ProcState state = __current_proc_state();
+	if ((state == PROC_STATE_IRQ) || (state == PROC_STATE_FIQ)) return;
+#endif
+	Mutex_Yield(Mutex_Yield_Param);
+}
+
+
+/*------------------------------------------------------------------------*/
+/* Set the Wait Function                                                  */
+/*------------------------------------------------------------------------*/
+/* See ff_lock.h.
+*/
+
+void ff_mutex_set_yield (
+	TaskWaitFunc_t yield,	/* Function to call while waiting, or NULL to spin */
+	void* param				/* Parameter for yield */
+)
+{
+	HpsErr_t irqState = IRQ_globalEnable(false);
+	Mutex_Yield = yield;
+	Mutex_Yield_Param = param;
+	IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+}
+
 #endif
 
 
@@ -106,6 +161,10 @@ int ff_mutex_create (	/* Returns 1:Function succeeded or 0:Could not create the
 	Mutex[vol] = osMutexCreate(osMutex(cmsis_os_mutex));
 	return (int)(Mutex[vol] != NULL);
 
+#elif OS_TYPE == 5	/* Bare-metal */
+	Mutex[vol] = 0;
+	return 1;
+
 #endif
 }
 
@@ -138,6 +197,9 @@ void ff_mutex_delete (	/* Returns 1:Function succeeded or 0:Could not delete due
 #elif OS_TYPE == 4	/* CMSIS-RTOS */
 	osMutexDelete(Mutex[vol]);
 
+#elif OS_TYPE == 5	/* Bare-metal */
+	Mutex[vol] = 0;
+
 #endif
 }
 
@@ -171,6 +233,17 @@ int ff_mutex_take (	/* Returns 1:Succeeded or 0:Timeout */
 #elif OS_TYPE == 4	/* CMSIS-RTOS */
 	return (int)(osMutexWait(Mutex[vol], FF_FS_TIMEOUT) == osOK);
 
+#elif OS_TYPE == 5	/* Bare-metal */
+	if (ff_mutex_try(&Mutex[vol])) return 1;	/* Uncontended */
+	/* Timeout is in milliseconds. Wait forever if timestamps are not initialised. */
+	uint64_t deadline = 0;
+	if (time_rate()) deadline = time_now_cycles() + time_nsToCycles((uint64_t)FF_FS_TIMEOUT * 1000000);
+	while (!ff_mutex_try(&Mutex[vol])) {
+		if (deadline && (time_now_cycles() > deadline)) return 0;
+		ff_mutex_wait();
+	}
+	return 1;
+
 #endif
 }
 
@@ -201,6 +274,13 @@ void ff_mutex_give (
 #elif OS_TYPE == 4	/* CMSIS-RTOS */
 	osMutexRelease(Mutex[vol]);
 
+#elif OS_TYPE == 5	/* Bare-metal */
+#if defined(__arm__)
+	__SPIN_UNLOCK(&Mutex[vol]);
+#else
+	Mutex[vol] = 0;
+#endif
+
 #endif
 }
 
@@ -40,6 +40,39 @@
  * from the HPSDmaCacheable enum (see HPS_DMAControllerEnums.h).
  *
  * 
+ * Programs for HPS_DMA_setupTransfer() are generated into a
+ * buffer kept for each channel, along with the shape of the
+ * transfer (source/destination types, settings, length and
+ * address alignment). If the next transfer on that channel has
+ * the same shape, such as repeated FIFO or buffer copies, the
+ * program is reused with only its source and destination
+ * addresses patched, avoiding regenerating it.
+ * 
+ * Several chunks can be performed back-to-back as a single
+ * program on one channel with HPS_DMA_setupTransferList().
+ * 
+ * To run independent transfers concurrently, for example a
+ * display blit alongside audio FIFO transfers, each user can
+ * allocate its own channel with HPS_DMA_allocateChannel(). This
+ * returns a channel context whose ->dma member is a generic DMA
+ * interface for that channel alone. Allocated channels are
+ * ignored by the standard controller APIs.
+ * 
+ * Instead of polling for completion, HPS_DMA_enableCallbacks()
+ * registers the DMA interrupts with HPS_IRQ, and a callback can
+ * then be set for each channel with HPS_DMA_setCallbackCh(). It
+ * is called when each transfer on that channel completes, and
+ * may queue the next one. Callbacks can optionally be deferred
+ * to a work queue (Util/work.h) to run from the main loop.
+ * 
+ * For continuous streams such as audio or display buffers,
+ * HPS_DMA_setupCircular() builds a program which loops over a
+ * set of blocks (e.g. ping-pong buffers) until aborted, issuing
+ * the channel event at the end of each block. With callbacks
+ * enabled, the channel callback is called at each boundary so
+ * the finished block can be refilled or consumed while the DMA
+ * carries on with the next one.
+ * 
  * The DMA controller is a highly configurable device with its
  * own 8-core processor and custom instruction set to allow all
  * manner of weird transfers to be performed. This capability can
@@ -56,6 +89,16 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add per-channel utilisation statistics
+ * 14/10/2026 | Add FPGA FIFO streaming helpers
+ * 14/10/2026 | Find free channels with a bitmask
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Reuse cached per-channel program templates.
+ *            | Add scatter-gather transfers.
+ *            | Add per-channel contexts for concurrent transfers.
+ *            | Add interrupt driven completion callbacks.
+ *            | Add circular transfers for continuous streams.
+ *            | Add peripheral flow controlled transfers.
  * 18/02/2024 | Creation of driver.
  *
  */
@@ -63,6 +106,8 @@
 #define HPS_DMACONTROLLER_C
 
 #include "HPS_DMAController.h"
+#include "Util/mem_pool.h"
+#include "Util/timestamp.h"
 #include "HPS_DMAControllerProgram.h"
 #include "HPS_DMAControllerRegs.h"
 
@@ -74,6 +119,16 @@
 #define HPS_DMA_SHORT_TRANSFER_WORDS 2
 #endif
 
+// Size of the program buffer for standard transfers
+#define HPS_DMA_MAIN_PROGRAM_SIZE 256
+
+// Marker for no address instruction in a template
+#define HPS_DMA_TEMPLATE_NOADDR UINT32_MAX
+
+// Maximum status polls in the channel interrupt waiting for the
+// thread to reach the DMAEND following its done event.
+#define HPS_DMA_IRQ_STOP_POLLS 16
+
 /*
  * Internal Functions
  */
@@ -85,8 +140,10 @@ static HpsErr_t HPS_DMA_initialiseProgram(HPSDmaProgram_t* prog) {
     prog->buf[0] = _HPS_DMA_ENDVAL;
     // The last word is always an end marker.
     prog->buf[prog->size] = _HPS_DMA_ENDVAL;
-    // Set initial program length to zero.
+    // Set initial program length to zero, with no open loops.
     prog->len = 0;
+    prog->loopLvl = 0;
+    prog->loopCtrUse = 0;
     return ERR_SUCCESS;
 }
 
@@ -95,11 +152,12 @@ static HpsErr_t HPS_DMA_allocateProgram(unsigned int maxSize, bool autoFree, HPS
     if (!pProg) return ERR_NULLPTR;
     if (!maxSize) return ERR_TOOSMALL; // No point allocating a program with no space for any instructions.
     // Allocate the program structure
-    HPSDmaProgram_t* prog = malloc(sizeof(*prog) + maxSize);
+    HPSDmaProgram_t* prog = MemPool_malloc(sizeof(*prog) + maxSize);
     if (!prog) return ERR_ALLOCFAIL;
     prog->size = maxSize - 1; // Account for space taken up by END marker.
     // Set auto-free marker.
     prog->autoFree = autoFree;
+    prog->nonSecure = false;
     // Initialise the program
     HPS_DMA_initialiseProgram(prog);
     // And return the allocated program.
@@ -114,7 +172,7 @@ static HpsErr_t HPS_DMA_freeProgram(HPSDmaProgram_t** pProg, bool onlyAuto) {
     // Check if skipping manual free objects
     if (onlyAuto && !(*pProg)->autoFree) return ERR_SKIPPED;
     // Free the program and NULL out the program pointer
-    free(*pProg);
+    MemPool_free(*pProg);
     *pProg = NULL;
     return ERR_SUCCESS;
 }
@@ -193,6 +251,31 @@ static HpsErr_t _HPS_DMA_killThread(HPSDmaCtx_t* ctx, HPSDmaThreadType thread, H
     return _HPS_DMA_issueDebugCommand(ctx, thread, channel);
 }
 
+//Check if an abort is pending for a channel
+static bool _HPS_DMA_abortPending(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
+    return ctx->abortPending || MaskCheck(ctx->chAbortPending, 0x1, channel);
+}
+
+//Record the end of a running transfer in the channel statistics
+static void _HPS_DMA_recordEnd(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
+    HPSDmaChStats_t* stats = &ctx->chStats[channel];
+    stats->busyCycles += time_now_cycles() - ctx->chStart[channel];
+    switch (ctx->channelState[channel]) {
+        case HPS_DMA_STATE_CHNL_DONE:
+            stats->transfers++;
+            stats->bytes += ctx->chLength[channel];
+            break;
+        case HPS_DMA_STATE_CHNL_ERROR:
+            stats->faults++;
+            break;
+        case HPS_DMA_STATE_CHNL_ABORTED:
+            stats->aborts++;
+            break;
+        default:
+            break;
+    }
+}
+
 //Check the current state of all channel threads.
 static HpsErr_t _HPS_DMA_checkState(HPSDmaCtx_t* ctx) {
     HpsErr_t status;
@@ -210,6 +293,7 @@ static HpsErr_t _HPS_DMA_checkState(HPSDmaCtx_t* ctx) {
     bool allChannelsAborted = true;
     for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
         // Check the channel state
+        HPSDmaChannelState lastState = ctx->channelState[channel];
         unsigned int state;
         status = _HPS_DMA_getState(ctx, HPS_DMA_THREADTYPE_CH, channel, &state);
         if (ERR_IS_ERROR(status)) return status;
@@ -217,7 +301,7 @@ static HpsErr_t _HPS_DMA_checkState(HPSDmaCtx_t* ctx) {
         switch (channelStatus) {
             case HPS_DMA_CHSTAT_STOPPED:
                 // Channel is in stopped state
-                if (ctx->abortPending) {
+                if (_HPS_DMA_abortPending(ctx, channel)) {
                     // If an abort is pending and we are now stopped, then abort is complete for this channel
                     ctx->channelState[channel] = HPS_DMA_STATE_CHNL_ABORTED;
                 } else if (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_BUSY) {
@@ -240,11 +324,21 @@ static HpsErr_t _HPS_DMA_checkState(HPSDmaCtx_t* ctx) {
             status = _HPS_DMA_getFault(ctx, HPS_DMA_THREADTYPE_CH, channel, &ctx->channelFault[channel]);
             if (ERR_IS_ERROR(status)) return status;
             ctx->channelState[channel] = HPS_DMA_STATE_CHNL_ERROR;
-        } else {
+        } else if (ctx->channelState[channel] != HPS_DMA_STATE_CHNL_ERROR) {
+            // Keep the last fault of a killed channel until it is reused
             ctx->channelFault[channel] = 0;
         }
+        // Count transfers which have just finished
+        if ((lastState == HPS_DMA_STATE_CHNL_BUSY) && (ctx->channelState[channel] != HPS_DMA_STATE_CHNL_BUSY)) {
+            _HPS_DMA_recordEnd(ctx, (HPSDmaChannelId)channel);
+        }
         // Check if channel is in abort state, and abort is done (status of stopped)
-        allChannelsAborted = allChannelsAborted && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_ABORTED) && (channelStatus == HPS_DMA_CHSTAT_STOPPED);
+        bool channelAborted = (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_ABORTED) && (channelStatus == HPS_DMA_CHSTAT_STOPPED);
+        allChannelsAborted = allChannelsAborted && channelAborted;
+        // Clear the channel abort pending flag once this channel is aborted.
+        if (channelAborted) {
+            ctx->chAbortPending &= ~_BV(channel);
+        }
     }
     // Clear abort pending flag if all channels are now aborted.
     if (allChannelsAborted) {
@@ -269,25 +363,35 @@ static HpsErr_t _HPS_DMA_startTransferCh(HPSDmaCtx_t* ctx, HPSDmaChannelId chann
     if (ERR_IS_ERROR(HPS_DMA_instMgrDMAGO(ctx->dbgProg, channel, prog->nonSecure, (uint32_t)prog->buf))) return ERR_NOSPACE;
     _HPS_DMA_issueDebugCommand(ctx, HPS_DMA_THREADTYPE_MGR, HPS_DMA_CHANNEL_MGR);
     //Now running
+    ctx->chStart[channel] = time_now_cycles();
     ctx->channelState[channel] = HPS_DMA_STATE_CHNL_BUSY;
     return ERR_SUCCESS;
 }
 
-//Setup transfer for the specified channel
-static HpsErr_t _HPS_DMA_setupTransfer(HPSDmaCtx_t* ctx, HPSDmaProgram_t* prog, HPSDmaChCtlParams_t* params, bool autoStart) {
+//Check whether the specified channel can be configured
+// - Returns ERR_INUSE if a transfer has been configured but not started.
+// - Returns ERR_BUSY if a transfer is running.
+static HpsErr_t _HPS_DMA_channelAvailable(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
     //Update channel status flags to check if any previously running 
     //transfers have finished so we know if we can reuse this channel.
     HpsErr_t status = _HPS_DMA_checkState(ctx);
     if (ERR_IS_ERROR(status)) return status;
     //Check if channel is in use
-    HPSDmaChannelId channel = params->channel;
     if (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_READY) {
         return ERR_INUSE;
     }
     if (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_BUSY) {
         return ERR_BUSY;
     }
-    //Any other state means we are free to use the channel. Configure it.
+    //Any other state means we are free to use the channel.
+    return ERR_SUCCESS;
+}
+
+//Commit a transfer to a channel already checked as available
+// - length is the number of bytes the program moves, for the channel statistics.
+static HpsErr_t _HPS_DMA_commitTransfer(HPSDmaCtx_t* ctx, HPSDmaProgram_t* prog, HPSDmaChCtlParams_t* params, uint64_t length, bool autoStart) {
+    HpsErr_t status = ERR_SUCCESS;
+    HPSDmaChannelId channel = params->channel;
     //Ensure program buffer is non-null, the final instruction is DMAEND,
     //and all loops are terminated.
     if (!prog || !prog->size) return ERR_NULLPTR;
@@ -297,6 +401,8 @@ static HpsErr_t _HPS_DMA_setupTransfer(HPSDmaCtx_t* ctx, HPSDmaProgram_t* prog,
     //Mark as ready to go
     ctx->chProg[channel] = prog;
     ctx->channelState[channel] = HPS_DMA_STATE_CHNL_READY;
+    ctx->chCircular &= ~_BV(channel);
+    ctx->chLength[channel] = length;
     //Ensure the IRQ flag for this channel is clear in case they are enabled.
     HPSDMA_REG_CTRL_IRQCLEAR(ctx->base) = MaskCreate(0x1, params->channel);
     //Start immediately if required.
@@ -310,6 +416,14 @@ static HpsErr_t _HPS_DMA_setupTransfer(HPSDmaCtx_t* ctx, HPSDmaProgram_t* prog,
     return status;
 }
 
+//Setup transfer for the specified channel
+static HpsErr_t _HPS_DMA_setupTransfer(HPSDmaCtx_t* ctx, HPSDmaProgram_t* prog, HPSDmaChCtlParams_t* params, bool autoStart) {
+    HpsErr_t status = _HPS_DMA_channelAvailable(ctx, params->channel);
+    if (ERR_IS_ERROR(status)) return status;
+    //Configure it.
+    return _HPS_DMA_commitTransfer(ctx, prog, params, 0, autoStart);
+}
+
 //Basic copy program
 static HpsErr_t _HPS_DMA_loadStoreProgram(HPSDmaCtx_t* ctx, HPSDmaProgram_t* prog, bool storeZero) {
     if (storeZero) {
@@ -322,26 +436,107 @@ static HpsErr_t _HPS_DMA_loadStoreProgram(HPSDmaCtx_t* ctx, HPSDmaProgram_t* pro
 }
 
 
-//Create the default program
-static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer, HPSDmaProgram_t** pProg) {
-    //Allocate our program memory
-    HpsErr_t status = HPS_DMA_allocateProgram(256, true, pProg);
-    if (ERR_IS_ERROR(status)) return status;
-    HPSDmaProgram_t* prog = *pProg;
-    //Get transfer params
-    HPSDmaChCtlParams_t* params = (HPSDmaChCtlParams_t*)xfer->params;
+//Append a loop of peripheral requests
+// - Each of the count iterations waits for a reqType request from the peripheral,
+//   then transfers one burst as configured by the current CCR value.
+static HpsErr_t _HPS_DMA_generatePeriphLoop(HPSDmaProgram_t* prog, HPSDmaChCtlParams_t* params, bool srcPeriph, HPSDmaRequestType reqType, unsigned int count) {
+    HpsErr_t status;
+    bool burst = (reqType == HPS_DMA_REQUEST_BURST);
+    while (count) {
+        // Nested loops give up to 256 x 256 iterations. Short counts only need the inner loop.
+        unsigned int outer = min(count / HPS_DMA_LOOP_COUNTER_MAX, HPS_DMA_LOOP_COUNTER_MAX);
+        unsigned int inner = outer ? HPS_DMA_LOOP_COUNTER_MAX : count;
+        unsigned int lpStartOuter = prog->len;
+        if (outer) {
+            if (ERR_IS_ERROR(HPS_DMA_instChDMALP(prog, outer, HPS_DMA_TARGET_CNTR1, 0))) return ERR_NOSPACE;
+            lpStartOuter = prog->len;
+        }
+        if (ERR_IS_ERROR(HPS_DMA_instChDMALP(prog, inner, HPS_DMA_TARGET_CNTR0, 0))) return ERR_NOSPACE;
+        unsigned int lpStartInner = prog->len;
+        // Wait for the request, then transfer, acknowledging the request at the peripheral end.
+        if (ERR_IS_ERROR(HPS_DMA_instChDMAWFP(prog, params->periph, reqType))) return ERR_NOSPACE;
+        if (srcPeriph) {
+            status = burst ? HPS_DMA_instChDMALDPB(prog, params->periph) : HPS_DMA_instChDMALDPS(prog, params->periph);
+            if (ERR_IS_ERROR(status)) return ERR_NOSPACE;
+            if (ERR_IS_ERROR(HPS_DMA_instChDMAST(prog))) return ERR_NOSPACE;
+        } else {
+            if (ERR_IS_ERROR(HPS_DMA_instChDMALD(prog))) return ERR_NOSPACE;
+            status = burst ? HPS_DMA_instChDMASTPB(prog, params->periph) : HPS_DMA_instChDMASTPS(prog, params->periph);
+            if (ERR_IS_ERROR(status)) return ERR_NOSPACE;
+        }
+        status = HPS_DMA_instChDMALPEND(prog, lpStartInner, false, HPS_DMA_TARGET_CNTR0);
+        if (ERR_IS_ERROR(status)) return status;
+        if (outer) {
+            status = HPS_DMA_instChDMALPEND(prog, lpStartOuter, false, HPS_DMA_TARGET_CNTR1);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        count -= outer ? (outer * HPS_DMA_LOOP_COUNTER_MAX) : inner;
+    }
+    return ERR_SUCCESS;
+}
+
+//Append the instructions for a peripheral flow controlled chunk
+// - Whole bursts are transferred on burst requests, and the remaining words on single requests.
+static HpsErr_t _HPS_DMA_generatePeriphChunk(HPSDmaProgram_t* prog, HPSDmaChCtlParams_t* params, unsigned int words, bool srcPeriph) {
+    HpsErr_t status;
+    // Clear any stale request state in the peripheral interface
+    if (ERR_IS_ERROR(HPS_DMA_instChDMAFLUSHP(prog, params->periph))) return ERR_NOSPACE;
+    unsigned int burstLen = params->burstDisable ? 1 : min(max(params->periphBurstLen, 1U), (unsigned int)HPS_DMA_BURSTLEN_MAX);
+    unsigned int bursts = (burstLen > 1) ? (words / burstLen) : 0;
+    unsigned int singles = words - (bursts * burstLen);
+    params->_srcBurstSize  = params->transferWidth;
+    params->_destBurstSize = params->transferWidth;
+    if (bursts) {
+        params->_srcBurstLen  = burstLen;
+        params->_destBurstLen = burstLen;
+        if (ERR_IS_ERROR(HPS_DMA_instChDMAMOVCCR(prog, params))) return ERR_NOSPACE;
+        status = _HPS_DMA_generatePeriphLoop(prog, params, srcPeriph, HPS_DMA_REQUEST_BURST, bursts);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    if (singles) {
+        params->_srcBurstLen  = 1;
+        params->_destBurstLen = 1;
+        if (ERR_IS_ERROR(HPS_DMA_instChDMAMOVCCR(prog, params))) return ERR_NOSPACE;
+        status = _HPS_DMA_generatePeriphLoop(prog, params, srcPeriph, HPS_DMA_REQUEST_SINGLE, singles);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+//Maximum program length of one chunk
+// - Fixed instructions, plus one outer loop per HPS_DMA_LOOP_COUNTER_MAX bursts.
+static unsigned int _HPS_DMA_chunkProgramSize(DmaChunk_t* xfer, HPSDmaChCtlParams_t* params) {
+    uint64_t bursts = (xfer->length >> params->transferWidth) / HPS_DMA_BURSTLEN_MAX;
+    return 64 + 10 * (unsigned int)(bursts / HPS_DMA_LOOP_COUNTER_MAX + 1);
+}
+
+//Append the instructions for one chunk to a program
+// - The offsets of the address instructions are returned to *sarPos and *darPos
+//   (HPS_DMA_TEMPLATE_NOADDR if none) so that they can be patched for reuse.
+// - *memToMem is cleared if the chunk is not memory to memory.
+static HpsErr_t _HPS_DMA_generateChunk(HPSDmaCtx_t* ctx, DmaChunk_t* xfer, HPSDmaChCtlParams_t* params, HPSDmaProgram_t* prog, unsigned int* sarPos, unsigned int* darPos, bool* pMemToMem) {
+    HpsErr_t status;
+    *sarPos = HPS_DMA_TEMPLATE_NOADDR;
+    *darPos = HPS_DMA_TEMPLATE_NOADDR;
     //Build the DMA program from op-codes
     unsigned int readAddr = xfer->readAddr;
     unsigned int writeAddr = xfer->writeAddr;
     unsigned int wordSize = params->transferWidth;
     bool storeZero = false;
     bool memToMem = true;
+    bool srcPeriph = false;
+    bool destPeriph = false;
     bool mustBeAligned = (params->endian != HPS_DMA_ENDIAN_NOSWAP); // Don't support endian swap on unaligned to make life easier.
     //Default to incrementing address
     params->_destAddrInc = true;
     params->_srcAddrInc  = true;
     //Check source type
     switch (params->srcType) {
+        case HPS_DMA_SOURCE_PERIPH:
+            // Peripheral is a register with flow control
+            srcPeriph = true;
+            FALLTHROUGH;
+            //no break
         case HPS_DMA_SOURCE_REGISTER:
             // Register mode requires strict alignment of source/destination.
             mustBeAligned = true;
@@ -353,6 +548,7 @@ static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer,
             //no break
         case HPS_DMA_SOURCE_MEMORY:
             // Load source address
+            *sarPos = prog->len;
             if (ERR_IS_ERROR(HPS_DMA_instChDMAMOV(prog, HPS_DMA_TARGET_SAR, xfer->readAddr ))) return ERR_NOSPACE;
             break;
         case HPS_DMA_SOURCE_ZERO:
@@ -364,11 +560,15 @@ static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer,
             memToMem = false;
             break;
         default:
-            // e.g. PERIPHERAL mode is not yet supported.
             return ERR_WRONGMODE;
     }
     //Check destination type
     switch (params->destType) {
+        case HPS_DMA_DESTINATION_PERIPH:
+            // Peripheral is a register with flow control
+            destPeriph = true;
+            FALLTHROUGH;
+            //no break
         case HPS_DMA_DESTINATION_REGISTER:
             // Register mode requires strict alignment of source/destination.
             mustBeAligned = true;
@@ -380,10 +580,10 @@ static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer,
             //no break
         case HPS_DMA_DESTINATION_MEMORY:
             // Load destination address
+            *darPos = prog->len;
             if (ERR_IS_ERROR(HPS_DMA_instChDMAMOV(prog, HPS_DMA_TARGET_DAR, xfer->writeAddr))) return ERR_NOSPACE;
             break;
         default:
-            // e.g. PERIPHERAL mode is not yet supported.
             return ERR_WRONGMODE;
     }
     //Alignment of source/destination addresses affect how we are going to program our DMA transfer
@@ -399,6 +599,14 @@ static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer,
     if (writeInitial > xfer->length) writeInitial = xfer->length;
     // Check if address must be aligned. If not, return alignment error
     if (mustBeAligned && (readInitial || writeInitial)) return ERR_ALIGNMENT;
+    // Peripheral transfers are whole words paced by the peripheral requests. Only one
+    // end can be a peripheral, and the other must be readable.
+    if (srcPeriph || destPeriph) {
+        if ((srcPeriph && destPeriph) || (params->srcType == HPS_DMA_SOURCE_ZERO)) return ERR_WRONGMODE;
+        if (xfer->length & wordMask) return ERR_ALIGNMENT;
+        *pMemToMem = false;
+        return _HPS_DMA_generatePeriphChunk(prog, params, (unsigned int)(xfer->length >> wordSize), srcPeriph);
+    }
     // If we have a non-aligned source, then we start by reading enough words to align it
     // Not used in register mode as strict alignment is enabled.
     if (readInitial) {
@@ -505,6 +713,12 @@ static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer,
         if (ERR_IS_ERROR(HPS_DMA_instChDMAMOVCCR(prog, params))) return ERR_NOSPACE;
         if (ERR_IS_ERROR(HPS_DMA_instChDMAST(prog))) return ERR_NOSPACE;
     }
+    if (!memToMem) *pMemToMem = false;
+    return ERR_SUCCESS;
+}
+
+//Append the done event of a program
+static HpsErr_t _HPS_DMA_generateDoneEvent(HPSDmaProgram_t* prog, HPSDmaChCtlParams_t* params, bool memToMem) {
     // If an event on done is requested, issue it. This will assert the corresponding IRQ if enabled.
     if (!params->doneEvent) {
         // Add memory barrier to ensure all transfers are complete. Can skip if not memory to memory.
@@ -512,10 +726,91 @@ static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer,
         // And issue event
         if (ERR_IS_ERROR(HPS_DMA_instChDMASEV(prog, (HPSDmaEventId)params->channel))) return ERR_NOSPACE;
     }
+    return ERR_SUCCESS;
+}
+
+//Append the end of a program
+static HpsErr_t _HPS_DMA_generateEnd(HPSDmaProgram_t* prog, HPSDmaChCtlParams_t* params, bool memToMem) {
+    HpsErr_t status = _HPS_DMA_generateDoneEvent(prog, params, memToMem);
+    if (ERR_IS_ERROR(status)) return status;
     // End of the program
     return HPS_DMA_instChDMAEND(prog);
 }
 
+//Create the default program
+// - Generated into the template program buffer. The offsets of the address
+//   instructions are recorded so that they can be patched for reuse.
+static HpsErr_t _HPS_DMA_generateMainProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer, HPSDmaChCtlParams_t* params, HPSDmaTemplate_t* tmpl) {
+    HPSDmaProgram_t* prog = tmpl->prog;
+    HPS_DMA_initialiseProgram(prog);
+    bool memToMem = true;
+    HpsErr_t status = _HPS_DMA_generateChunk(ctx, xfer, params, prog, &tmpl->sarPos, &tmpl->darPos, &memToMem);
+    if (ERR_IS_ERROR(status)) return status;
+    return _HPS_DMA_generateEnd(prog, params, memToMem);
+}
+
+//Build the template key describing the shape of a transfer
+static void _HPS_DMA_templateKey(DmaChunk_t* xfer, HPSDmaChCtlParams_t* params, HPSDmaTemplateKey_t* key) {
+    unsigned int wordMask = (1 << params->transferWidth) - 1;
+    //Zero first so that padding compares equal
+    memset(key, 0, sizeof(*key));
+    key->srcType       = params->srcType;
+    key->srcProtCtrl   = params->srcProtCtrl;
+    key->srcCacheCtrl  = params->srcCacheCtrl;
+    key->destType      = params->destType;
+    key->destProtCtrl  = params->destProtCtrl;
+    key->destCacheCtrl = params->destCacheCtrl;
+    key->transferWidth = params->transferWidth;
+    key->endian        = params->endian;
+    key->burstDisable  = params->burstDisable;
+    key->doneEvent     = params->doneEvent;
+    key->periph        = params->periph;
+    key->periphBurstLen = params->periphBurstLen;
+    key->readAlign     = xfer->readAddr  & wordMask;
+    key->writeAlign    = xfer->writeAddr & wordMask;
+    key->length        = xfer->length;
+}
+
+//Patch the address of a DMAMOV instruction in a program
+static void _HPS_DMA_patchAddress(HPSDmaProgram_t* prog, unsigned int pos, uint32_t addr) {
+    if (pos == HPS_DMA_TEMPLATE_NOADDR) return;
+    //Immediate follows the opcode and register bytes. May not be word aligned.
+    uint8_t* imm = &prog->buf[pos + 2];
+    imm[0] = (addr      ) & 0xFF;
+    imm[1] = (addr >>  8) & 0xFF;
+    imm[2] = (addr >> 16) & 0xFF;
+    imm[3] = (addr >> 24) & 0xFF;
+}
+
+//Get the program for a standard transfer
+// - Reuses the channel template if the shape matches, otherwise
+//   regenerates it. The channel must not be in use.
+static HpsErr_t _HPS_DMA_templateProgram(HPSDmaCtx_t* ctx, DmaChunk_t* xfer, HPSDmaChCtlParams_t* params, HPSDmaProgram_t** pProg) {
+    HPSDmaTemplate_t* tmpl = &ctx->chTemplate[params->channel];
+    //Allocate the program buffer on first use. It is kept until cleanup.
+    if (!tmpl->prog) {
+        HpsErr_t status = HPS_DMA_allocateProgram(HPS_DMA_MAIN_PROGRAM_SIZE, false, &tmpl->prog);
+        if (ERR_IS_ERROR(status)) return status;
+        tmpl->valid = false;
+    }
+    HPSDmaTemplateKey_t key;
+    _HPS_DMA_templateKey(xfer, params, &key);
+    if (tmpl->valid && !memcmp(&key, &tmpl->key, sizeof(key))) {
+        //Same shape. Only the addresses change.
+        _HPS_DMA_patchAddress(tmpl->prog, tmpl->sarPos, xfer->readAddr);
+        _HPS_DMA_patchAddress(tmpl->prog, tmpl->darPos, xfer->writeAddr);
+    } else {
+        //New shape. Generate the program.
+        tmpl->valid = false;
+        HpsErr_t status = _HPS_DMA_generateMainProgram(ctx, xfer, params, tmpl);
+        if (ERR_IS_ERROR(status)) return status;
+        tmpl->key = key;
+        tmpl->valid = true;
+    }
+    *pProg = tmpl->prog;
+    return ERR_SUCCESS;
+}
+
 //Initialise hardware
 static HpsErr_t _HPS_DMA_initHardware(HPSDmaCtx_t* ctx, HPSDmaHwInit_t* hwInit) {
     HpsErr_t status;
@@ -551,8 +846,126 @@ static HpsErr_t _HPS_DMA_initHardware(HPSDmaCtx_t* ctx, HPSDmaHwInit_t* hwInit)
     return ERR_SUCCESS;
 }
 
+//Take the result of a finished transfer for the channel callback
+// - Completion is acknowledged before the callback so that it can queue the
+//   next transfer. Faulted channels are left for HPS_DMA_transferError().
+// - Returns false if there is no callback or nothing to report.
+static bool _HPS_DMA_takeResult(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, HpsErr_t* result) {
+    if (!ctx->chCallback[channel]) return false;
+    if (MaskCheck(ctx->chCircular, 0x1, channel) && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_BUSY)) {
+        //End of a block. The transfer carries on.
+        *result = ERR_AGAIN;
+        return true;
+    }
+    if (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_DONE) {
+        ctx->channelState[channel] = HPS_DMA_STATE_CHNL_FREE;
+        if (ctx->chProg[channel]) HPS_DMA_freeProgram(&ctx->chProg[channel], true);
+        *result = ERR_SUCCESS;
+        return true;
+    }
+    if (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_ERROR) {
+        *result = ERR_IOFAIL;
+        return true;
+    }
+    return false;
+}
+
+//Work item used to run a callback from thread context
+static void _HPS_DMA_workCallback(void* param, unsigned int arg) {
+    HPSDmaCtx_t* ctx = (HPSDmaCtx_t*)param;
+    HPSDmaChannelId channel = (HPSDmaChannelId)arg;
+    //Check the state is still current, as the channel may have been polled since.
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    HpsErr_t result;
+    bool report = ERR_IS_SUCCESS(_HPS_DMA_checkState(ctx)) && _HPS_DMA_takeResult(ctx, channel, &result);
+    HPSDmaCallback_t callback = ctx->chCallback[channel];
+    void* cbParam = ctx->chCallbackParam[channel];
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    //Call with interrupts enabled
+    if (report) callback(channel, result, cbParam);
+}
+
+//Run or defer the callback for a channel from an interrupt
+static void _HPS_DMA_dispatchCallback(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
+    if (!ctx->chCallback[channel]) return;
+    if (ctx->work) {
+        //If the queue is full the callback is dropped, and counted by the queue.
+        Work_post(ctx->work, &_HPS_DMA_workCallback, ctx, channel);
+    } else {
+        HpsErr_t result;
+        if (_HPS_DMA_takeResult(ctx, channel, &result)) {
+            ctx->chCallback[channel](channel, result, ctx->chCallbackParam[channel]);
+        }
+    }
+}
+
+//Channel event interrupt handler
+// - The done event is issued just before the DMAEND instruction, so wait briefly
+//   for the thread to stop before updating its state. Circular transfers issue
+//   the event at the end of each block and never stop, so are counted instead.
+static __irq void _HPS_DMA_channelIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    HPSDmaCtx_t* ctx = (HPSDmaCtx_t*)param;
+    if (!ctx) return;
+    HPSDmaChannelId channel = (HPSDmaChannelId)(interruptID - IRQ_DMA0);
+    if ((channel < HPS_DMA_CHANNEL_MIN) || (channel >= HPS_DMA_CHANNEL_COUNT)) return;
+    //Acknowledge the interrupt
+    HPSDMA_REG_CTRL_IRQCLEAR(ctx->base) = MaskCreate(0x1, channel);
+    bool circular = MaskCheck(ctx->chCircular, 0x1, channel);
+    for (unsigned int poll = 0; !circular && (poll < HPS_DMA_IRQ_STOP_POLLS); poll++) {
+        unsigned int state;
+        if (ERR_IS_ERROR(_HPS_DMA_getState(ctx, HPS_DMA_THREADTYPE_CH, channel, &state))) break;
+        if (state == HPS_DMA_CHSTAT_STOPPED) break;
+    }
+    //If the thread has stopped, the transfer is done. An event issued part way
+    //through a custom program leaves the channel busy, so is ignored.
+    if (ERR_IS_SUCCESS(_HPS_DMA_checkState(ctx))) {
+        if (circular && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_BUSY)) {
+            ctx->chBlocks[channel]++;
+            ctx->chStats[channel].transfers++;
+            if (!(ctx->chBlocks[channel] % ctx->chLoopBlocks[channel])) {
+                ctx->chStats[channel].bytes += ctx->chLength[channel];
+            }
+        }
+        _HPS_DMA_dispatchCallback(ctx, channel);
+    }
+    *handled = true;
+}
+
+//Abort interrupt handler
+// - Raised while any thread is faulted. Faulted channel threads are killed to
+//   clear the interrupt, leaving the channel in the error state.
+static __irq void _HPS_DMA_abortIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    HPSDmaCtx_t* ctx = (HPSDmaCtx_t*)param;
+    if (!ctx) return;
+    //Find the faulting channels before their state is updated
+    unsigned int channelIsFault = HPSDMA_REG_CTRL_CHFAULTSTAT(ctx->base);
+    if (ERR_IS_SUCCESS(_HPS_DMA_checkState(ctx))) {
+        for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+            if (!MaskCheck(channelIsFault, 0x1, channel)) continue;
+            _HPS_DMA_killThread(ctx, HPS_DMA_THREADTYPE_CH, (HPSDmaChannelId)channel);
+            _HPS_DMA_dispatchCallback(ctx, (HPSDmaChannelId)channel);
+        }
+        //Manager faults also raise the interrupt
+        if (ctx->managerFault) {
+            _HPS_DMA_killThread(ctx, HPS_DMA_THREADTYPE_MGR, HPS_DMA_CHANNEL_MGR);
+        }
+    }
+    *handled = true;
+}
+
+//Unregister the DMA interrupts
+static void _HPS_DMA_unregisterIrqs(HPSDmaCtx_t* ctx) {
+    for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        HPS_IRQ_unregisterHandler((HPSIRQSource)(IRQ_DMA0 + channel));
+    }
+    HPS_IRQ_unregisterHandler(IRQ_DMA_ABORT);
+    ctx->irqRegistered = false;
+}
+
 //Cleanup
 static void _HPS_DMA_cleanup(HPSDmaCtx_t* ctx) {
+    // Remove the interrupt handlers
+    if (ctx->irqRegistered) _HPS_DMA_unregisterIrqs(ctx);
     if (ctx->base) {
         // Kill all threads
         for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
@@ -560,11 +973,282 @@ static void _HPS_DMA_cleanup(HPSDmaCtx_t* ctx) {
         }
         // Free constructor allocated debug program memory
         HPS_DMA_freeProgram(&ctx->dbgProg, false);
+        // And any template programs
+        for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+            if (ctx->chTemplate[channel].prog) HPS_DMA_freeProgram(&ctx->chTemplate[channel].prog, false);
+        }
+    }
+    // Detach any channel contexts so that they report not initialised
+    for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        if (ctx->chCtx[channel]) {
+            ctx->chCtx[channel]->dmaCtx = NULL;
+            ctx->chCtx[channel]->header.initialised = false;
+            ctx->chCtx[channel] = NULL;
+        }
     }
+    ctx->chAllocated = 0;
     // Place the DMA controller in reset
     *HPS_DMA_RSTMGR_DMAREG |= HPS_DMA_RSTMGR_DMAMASK;
 }
 
+//Configure a standard transfer
+// - If chCtx is not NULL, the transfer is performed on its channel. Otherwise channels
+//   allocated to a channel context cannot be used.
+static HpsErr_t _HPS_DMA_setupStandardTransfer(HPSDmaCtx_t* ctx, DmaChunk_t* xfer, bool autoStart, HPSDmaChCtx_t* chCtx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Check if we have been given optional parameters
+    HPSDmaChCtlParams_t defaultParams;
+    HPSDmaChCtlParams_t* params = (HPSDmaChCtlParams_t*)xfer->params;
+    if (!params) {
+        //Check if auto-start is requested, and there is only a small number of words to transfer
+#if (HPS_DMA_SHORT_TRANSFER_WORDS > 0)
+        if (autoStart && (xfer->length <= (HPS_DMA_SHORT_TRANSFER_WORDS * ctx->wordBytes))) {
+            //If so, the overhead of setting up the DMA to perform a simple transfer
+            //is not worth it, we might as well just copy manually.
+            if ((xfer->readAddr > UINT32_MAX) || (xfer->writeAddr > UINT32_MAX)) return ERR_BEYONDEND;
+            memcpy((void*)xfer->writeAddr, (void*)xfer->readAddr, xfer->length);
+            return ERR_SKIPPED;
+        }
+#endif
+        //Use default parameters, as HPS_DMA_initDmaChunkParam would, but without allocating them.
+        params = &defaultParams;
+        status = HPS_DMA_initParameters(ctx, params, HPS_DMA_SOURCE_MEMORY, HPS_DMA_DESTINATION_MEMORY);
+        if (ERR_IS_ERROR(status)) return status;
+        params->channel = (HPSDmaChannelId)(xfer->index % HPS_DMA_CHANNEL_COUNT);
+    }
+    //Channel contexts always use their own channel
+    if (chCtx) params->channel = chCtx->channel;
+    //The channel template can only be changed if the channel is not in use
+    if ((params->channel < HPS_DMA_CHANNEL_USER0) || (params->channel > HPS_DMA_CHANNEL_USER7)) {
+        status = ERR_BADID;
+    } else if (!chCtx && ctx->chCtx[params->channel]) {
+        status = ERR_INUSE;
+    } else {
+        status = _HPS_DMA_channelAvailable(ctx, params->channel);
+    }
+    //Get the memory copy program, reusing the channel template if possible
+    HPSDmaProgram_t* prog;
+    if (ERR_IS_SUCCESS(status)) {
+        status = _HPS_DMA_templateProgram(ctx, xfer, params, &prog);
+    }
+    //Setup the transfer
+    if (ERR_IS_SUCCESS(status)) {
+        status = _HPS_DMA_commitTransfer(ctx, prog, params, xfer->length, autoStart);
+    }
+    //Free the optional parameters if required
+    if ((params != &defaultParams) && params->autoFreeParams) {
+        xfer->params = NULL;
+        MemPool_free(params);
+    }
+    return status;
+}
+
+//Configure a scatter-gather transfer
+// - If chCtx is not NULL, the transfer is performed on its channel. Otherwise channels
+//   allocated to a channel context cannot be used.
+// - If circular, the chunks are wrapped in a forever loop with the done event issued
+//   after each one.
+static HpsErr_t _HPS_DMA_setupTransferList(HPSDmaCtx_t* ctx, DmaChunk_t* xfers, unsigned int count, bool autoStart, bool circular, HPSDmaChCtx_t* chCtx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!xfers) return ERR_NULLPTR;
+    if (!count) return ERR_TOOSMALL;
+    //Work out the channel parameters from the first chunk
+    HPSDmaChCtlParams_t listParams;
+    if (xfers[0].params) {
+        listParams = *(HPSDmaChCtlParams_t*)xfers[0].params;
+    } else {
+        status = HPS_DMA_initParameters(ctx, &listParams, HPS_DMA_SOURCE_MEMORY, HPS_DMA_DESTINATION_MEMORY);
+        if (ERR_IS_ERROR(status)) return status;
+        listParams.channel = (HPSDmaChannelId)(xfers[0].index % HPS_DMA_CHANNEL_COUNT);
+    }
+    //Channel contexts always use their own channel
+    if (chCtx) listParams.channel = chCtx->channel;
+    HPSDmaChannelId channel = listParams.channel;
+    if ((channel < HPS_DMA_CHANNEL_USER0) || (channel > HPS_DMA_CHANNEL_USER7)) {
+        status = ERR_BADID;
+    } else if (!chCtx && ctx->chCtx[channel]) {
+        status = ERR_INUSE;
+    } else {
+        status = _HPS_DMA_channelAvailable(ctx, channel);
+    }
+    //Size and allocate the program. It is free'd automatically once complete.
+    HPSDmaProgram_t* prog = NULL;
+    if (ERR_IS_SUCCESS(status)) {
+        unsigned int progSize = HPS_DMA_INSTCH_DMAWMB_LEN + HPS_DMA_INSTCH_DMASEV_LEN + HPS_DMA_INSTCH_DMAEND_LEN + 1;
+        if (circular) progSize += HPS_DMA_INSTCH_DMALPEND_LEN;
+        for (unsigned int idx = 0; idx < count; idx++) {
+            HPSDmaChCtlParams_t* params = xfers[idx].params ? (HPSDmaChCtlParams_t*)xfers[idx].params : &listParams;
+            progSize += _HPS_DMA_chunkProgramSize(&xfers[idx], params);
+            if (circular) progSize += HPS_DMA_INSTCH_DMAWMB_LEN + HPS_DMA_INSTCH_DMASEV_LEN;
+        }
+        status = HPS_DMA_allocateProgram(progSize, true, &prog);
+    }
+    //Open the stream loop for circular transfers
+    unsigned int lpStart = 0;
+    if (circular && ERR_IS_SUCCESS(status)) {
+        status = HPS_DMA_instChDMALPFE(prog);
+        lpStart = prog->len;
+    }
+    //Append each chunk in turn
+    bool memToMem = true;
+    for (unsigned int idx = 0; ERR_IS_SUCCESS(status) && (idx < count); idx++) {
+        HPSDmaChCtlParams_t chunkParams;
+        if (xfers[idx].params) {
+            chunkParams = *(HPSDmaChCtlParams_t*)xfers[idx].params;
+        } else {
+            status = HPS_DMA_initParameters(ctx, &chunkParams, HPS_DMA_SOURCE_MEMORY, HPS_DMA_DESTINATION_MEMORY);
+        }
+        unsigned int sarPos, darPos;
+        chunkParams.channel = channel;
+        if (ERR_IS_SUCCESS(status)) {
+            status = _HPS_DMA_generateChunk(ctx, &xfers[idx], &chunkParams, prog, &sarPos, &darPos, &memToMem);
+        }
+        //Each block of a circular transfer signals its own end
+        if (circular && ERR_IS_SUCCESS(status)) {
+            status = _HPS_DMA_generateDoneEvent(prog, &listParams, memToMem);
+            memToMem = true;
+        }
+    }
+    if (circular && ERR_IS_SUCCESS(status)) {
+        status = HPS_DMA_instChDMALPEND(prog, lpStart, true, HPS_DMA_TARGET_CNTR0);
+        if (ERR_IS_SUCCESS(status)) status = HPS_DMA_instChDMAEND(prog);
+    } else if (ERR_IS_SUCCESS(status)) {
+        status = _HPS_DMA_generateEnd(prog, &listParams, memToMem);
+    }
+    //Setup the transfer. Circular transfers are marked before starting so that
+    //the first block event is counted.
+    if (ERR_IS_SUCCESS(status)) {
+        uint64_t length = 0;
+        for (unsigned int idx = 0; idx < count; idx++) {
+            length += xfers[idx].length;
+        }
+        status = _HPS_DMA_commitTransfer(ctx, prog, &listParams, length, autoStart && !circular);
+        if (circular && ERR_IS_SUCCESS(status)) {
+            ctx->chCircular |= _BV(channel);
+            ctx->chBlocks[channel] = 0;
+            ctx->chLoopBlocks[channel] = count;
+            if (autoStart) {
+                status = _HPS_DMA_startTransferCh(ctx, channel);
+                if (ERR_IS_ERROR(status) && (status != ERR_NOTREADY)) {
+                    ctx->channelState[channel] = HPS_DMA_STATE_CHNL_FREE;
+                }
+            }
+        }
+        //If it failed to start, the channel is free again and the program no longer needed
+        if (ERR_IS_ERROR(status) && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_FREE)) {
+            ctx->chProg[channel] = NULL;
+            ctx->chCircular &= ~_BV(channel);
+            HPS_DMA_freeProgram(&prog, false);
+        }
+    } else if (prog) {
+        HPS_DMA_freeProgram(&prog, false);
+    }
+    //Free the optional parameters if required
+    for (unsigned int idx = 0; idx < count; idx++) {
+        HPSDmaChCtlParams_t* params = (HPSDmaChCtlParams_t*)xfers[idx].params;
+        if (params && params->autoFreeParams) {
+            xfers[idx].params = NULL;
+            MemPool_free(params);
+        }
+    }
+    return status;
+}
+
+//Validate a channel context and the controller it belongs to
+static HpsErr_t _HPS_DMA_channelValidate(HPSDmaChCtx_t* chCtx) {
+    HpsErr_t status = DriverContextValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    return DriverContextValidate(chCtx->dmaCtx);
+}
+
+//Cleanup function called when a channel context is freed
+static void _HPS_DMA_channelCleanup(HPSDmaChCtx_t* chCtx) {
+    HPSDmaCtx_t* ctx = chCtx->dmaCtx;
+    if (ctx && (ctx->chCtx[chCtx->channel] == chCtx)) {
+        // Return the channel to the controller
+        ctx->chCtx[chCtx->channel] = NULL;
+        ctx->chAllocated &= ~_BV(chCtx->channel);
+        ctx->chAbortPending &= ~_BV(chCtx->channel);
+    }
+}
+
+//Generic DMA interface for channel contexts
+// - Each maps to the xxxCh() API of the controller for the allocated channel.
+static HpsErr_t _HPS_DMA_channelInitDmaChunkParam(HPSDmaChCtx_t* chCtx, DmaChunk_t* xfer) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    status = HPS_DMA_initDmaChunkParam(chCtx->dmaCtx, xfer);
+    if (ERR_IS_ERROR(status)) return status;
+    ((HPSDmaChCtlParams_t*)xfer->params)->channel = chCtx->channel;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _HPS_DMA_channelSetupTransfer(HPSDmaChCtx_t* chCtx, DmaChunk_t* xfer, bool autoStart) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    return _HPS_DMA_setupStandardTransfer(chCtx->dmaCtx, xfer, autoStart, chCtx);
+}
+
+static HpsErr_t _HPS_DMA_channelSetupTransferList(HPSDmaChCtx_t* chCtx, DmaChunk_t* xfers, unsigned int count, bool autoStart) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    return _HPS_DMA_setupTransferList(chCtx->dmaCtx, xfers, count, autoStart, false, chCtx);
+}
+
+static HpsErr_t _HPS_DMA_channelStartTransfer(HPSDmaChCtx_t* chCtx) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    return HPS_DMA_startTransferCh(chCtx->dmaCtx, chCtx->channel);
+}
+
+static HpsErr_t _HPS_DMA_channelBusy(HPSDmaChCtx_t* chCtx) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    return HPS_DMA_busyCh(chCtx->dmaCtx, chCtx->channel);
+}
+
+static HpsErr_t _HPS_DMA_channelCompleted(HPSDmaChCtx_t* chCtx) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    return HPS_DMA_completedCh(chCtx->dmaCtx, chCtx->channel);
+}
+
+static HpsErr_t _HPS_DMA_channelTransferError(HPSDmaChCtx_t* chCtx, unsigned int* errorInfo) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    status = HPS_DMA_checkState(chCtx->dmaCtx, chCtx->channel, errorInfo);
+    if (ERR_IS_ERROR(status)) return status;
+    return (status == HPS_DMA_STATE_CHNL_ERROR) ? ERR_IOFAIL : ERR_SUCCESS;
+}
+
+// Both safe and forced aborts kill only the thread of this channel. Resetting the
+// whole controller would also stop transfers on other channels.
+static HpsErr_t _HPS_DMA_channelAbort(HPSDmaChCtx_t* chCtx, DmaAbortType abort) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    HPSDmaCtx_t* ctx = chCtx->dmaCtx;
+    if (abort == DMA_ABORT_NONE) {
+        //Clear the abort pending flag, whether or not we have actually competed
+        ctx->chAbortPending &= ~_BV(chCtx->channel);
+    } else {
+        //Mark as abort pending and kill the thread
+        ctx->chAbortPending |= _BV(chCtx->channel);
+        _HPS_DMA_killThread(ctx, HPS_DMA_THREADTYPE_CH, chCtx->channel);
+    }
+    //Refresh states
+    return _HPS_DMA_checkState(ctx);
+}
+
+static HpsErr_t _HPS_DMA_channelAborted(HPSDmaChCtx_t* chCtx) {
+    HpsErr_t status = _HPS_DMA_channelValidate(chCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    return HPS_DMA_abortedCh(chCtx->dmaCtx, chCtx->channel);
+}
+
 /*
  * User Facing APIs
  */
@@ -592,6 +1276,7 @@ HpsErr_t HPS_DMA_initialise(void* base, HPSDmaBurstSize wordSize, HPSDmaHwInit_t
     ctx->dma.transferSpace = NULL;//(DmaXferSpaceFunc_t)&HPS_DMA_transferRequestSpace;
     ctx->dma.initXferParams = (DmaXferParamFunc_t)&HPS_DMA_initDmaChunkParam;
     ctx->dma.setupTransfer = (DmaXferFunc_t)&HPS_DMA_setupTransfer;
+    ctx->dma.setupTransferList = (DmaXferListFunc_t)&HPS_DMA_setupTransferList;
     ctx->dma.startTransfer = (DmaXferStartFunc_t)&HPS_DMA_startTransfer;
     ctx->dma.abortTransfer = (DmaAbortFunc_t)&HPS_DMA_abort;
     ctx->dma.transferBusy = (DmaStatusFunc_t)&HPS_DMA_busy;
@@ -607,6 +1292,11 @@ HpsErr_t HPS_DMA_initialise(void* base, HPSDmaBurstSize wordSize, HPSDmaHwInit_t
     //Set a sane default in the debug prog memory.
     HPS_DMA_INIT_DBGPROG(ctx);
     HPS_DMA_instChDMANOP(ctx->dbgProg);
+    //Statistics run from now
+    uint64_t now = time_now_cycles();
+    for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        ctx->chStatsSince[channel] = now;
+    }
     //Initialised
     DriverContextSetInit(ctx);
     return ERR_SUCCESS;
@@ -672,12 +1362,12 @@ HpsErr_t HPS_DMA_clearInterruptFlags(HPSDmaCtx_t* ctx, unsigned int mask) {
 HpsErr_t HPS_DMA_initDmaChunkParam(HPSDmaCtx_t* ctx, DmaChunk_t* xfer) {
     if (!xfer) return ERR_NULLPTR;
     // Allocate parameters
-    HPSDmaChCtlParams_t* params = malloc(sizeof(*params));
+    HPSDmaChCtlParams_t* params = MemPool_malloc(sizeof(*params));
     if (!params) return ERR_ALLOCFAIL;
     // Initialise the parameters
     HpsErr_t status = HPS_DMA_initParameters(ctx, params, HPS_DMA_SOURCE_MEMORY, HPS_DMA_DESTINATION_MEMORY);
     if (ERR_IS_ERROR(status)) {
-        free(params);
+        MemPool_free(params);
         return status;
     }
     // Default to auto-free
@@ -716,8 +1406,11 @@ HpsErr_t HPS_DMA_initParameters(HPSDmaCtx_t* ctx, HPSDmaChCtlParams_t* params, H
     // Configure the common defaults.
     params->transferWidth = ctx->wordSize;
     params->doneEvent = false;
+    params->burstDisable = false;
     params->autoFreeParams = false;
     params->endian = HPS_DMA_ENDIAN_NOSWAP;
+    params->periph = HPS_DMA_PERIPH_FPGA_0;
+    params->periphBurstLen = 1;
     return ERR_SUCCESS;
 }
  
@@ -737,37 +1430,171 @@ HpsErr_t HPS_DMA_initParameters(HPSDmaCtx_t* ctx, HPSDmaChCtlParams_t* params, H
 //    - Use HPS_DMA_busy*()/HPS_DMA_completed*()/HPS_DMA_aborted*() to check the status of the transfer.
 //    - Use HPS_DMA_abort() to stop any running transfers.
 HpsErr_t HPS_DMA_setupTransfer(HPSDmaCtx_t* ctx, DmaChunk_t* xfer, bool autoStart) {
+    return _HPS_DMA_setupStandardTransfer(ctx, xfer, autoStart, NULL);
+}
+
+// Configure a scatter-gather DMA transfer
+//  - Performs count chunks from the xfers array back-to-back as a single program
+//    on one channel, without CPU intervention between chunks.
+//  - The channel and done event are taken from the parameters of the first chunk,
+//    or (xfers[0].index % CH_COUNT) if it has none. Each chunk may have its own
+//    parameters for source/destination types and settings.
+//  - If selected DMA channel is in use, returns ERR_BUSY.
+//  - The xfers array is not needed once this returns.
+//  - Will return ERR_SUCCESS if the transfer was successfully queued, after which
+//    it is handled in the same way as HPS_DMA_setupTransfer().
+HpsErr_t HPS_DMA_setupTransferList(HPSDmaCtx_t* ctx, DmaChunk_t* xfers, unsigned int count, bool autoStart) {
+    return _HPS_DMA_setupTransferList(ctx, xfers, count, autoStart, false, NULL);
+}
+
+// Configure a circular DMA transfer for a continuous stream
+//  - Performs count blocks from the blocks array in order, then starts again
+//    from the first block, repeating until aborted with HPS_DMA_abort*().
+//  - The channel event is issued at the end of every block (unless doneEvent is
+//    set in the parameters of the first block), so with HPS_DMA_enableCallbacks()
+//    the channel callback is called with ERR_AGAIN at each block boundary.
+//  - The channel is taken from the parameters of the first block, or from
+//    (blocks[0].index % CH_COUNT) if it has none, as for HPS_DMA_setupTransferList().
+//  - The looped blocks must fit in 255 bytes of program, returning ERR_OUTRANGE
+//    if not. A few simple memory or register blocks (e.g. two ping-pong buffers)
+//    fit comfortably.
+//  - The transfer never completes, so HPS_DMA_completed*() will not report it.
+HpsErr_t HPS_DMA_setupCircular(HPSDmaCtx_t* ctx, DmaChunk_t* blocks, unsigned int count, bool autoStart) {
+    return _HPS_DMA_setupTransferList(ctx, blocks, count, autoStart, true, NULL);
+}
+
+// Get the number of blocks completed by a circular transfer
+//  - Blocks are counted by the channel interrupt, so callbacks must be enabled.
+//    The count restarts from zero each time a transfer is set up on the channel.
+//  - The block which has just finished is ((*blocks - 1) % count).
+//  - Returns ERR_WRONGMODE if the channel is not running a circular transfer.
+HpsErr_t HPS_DMA_circularBlocksCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, unsigned int* blocks) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    //Check if we have been given optional parameters
-    if (!xfer->params) {
-        //Check if auto-start is requested, and there is only a small number of words to transfer
-#if (HPS_DMA_SHORT_TRANSFER_WORDS > 0)
-        if (autoStart && (xfer->length <= (HPS_DMA_SHORT_TRANSFER_WORDS * ctx->wordBytes))) {
-            //If so, the overhead of setting up the DMA to perform a simple transfer
-            //is not worth it, we might as well just copy manually.
-            if ((xfer->readAddr > UINT32_MAX) || (xfer->writeAddr > UINT32_MAX)) return ERR_BEYONDEND;
-            memcpy((void*)xfer->writeAddr, (void*)xfer->readAddr, xfer->length);
-            return ERR_SKIPPED;
-        }
-#endif
-        //Make default parameter structure
-        status = HPS_DMA_initDmaChunkParam(ctx, xfer);
-        if (ERR_IS_ERROR(status)) return status;
+    if (!blocks) return ERR_NULLPTR;
+    if ((channel < HPS_DMA_CHANNEL_USER0) || (channel > HPS_DMA_CHANNEL_USER7)) return ERR_BADID;
+    if (!MaskCheck(ctx->chCircular, 0x1, channel)) return ERR_WRONGMODE;
+    *blocks = ctx->chBlocks[channel];
+    return ERR_SUCCESS;
+}
+
+// Get the utilisation statistics for a channel
+//  - Copies the statistics accumulated since the driver was initialised or
+//    HPS_DMA_clearStatsCh() was called to *stats.
+//  - Transfers are counted as they are found to be complete, which is at the
+//    channel interrupt if callbacks are enabled, otherwise when polled.
+//  - Custom program transfers are timed, but their bytes are not counted.
+HpsErr_t HPS_DMA_getStatsCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, HPSDmaChStats_t* stats) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!stats) return ERR_NULLPTR;
+    if ((channel < HPS_DMA_CHANNEL_USER0) || (channel > HPS_DMA_CHANNEL_USER7)) return ERR_BADID;
+    //Update the state so any finished transfers are counted, and take a
+    //consistent copy as the interrupts also update the statistics.
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    status = _HPS_DMA_checkState(ctx);
+    uint64_t now = time_now_cycles();
+    *stats = ctx->chStats[channel];
+    stats->elapsedCycles = now - ctx->chStatsSince[channel];
+    if (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_BUSY) {
+        stats->busyCycles += now - ctx->chStart[channel];
     }
-    //Create the default memory copy program
-    HPSDmaProgram_t* prog;
-    status = _HPS_DMA_generateMainProgram(ctx, xfer, &prog);
-    //Setup the transfer
-    HPSDmaChCtlParams_t* params = (HPSDmaChCtlParams_t*)xfer->params;
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return status;
+}
+
+// Clear the utilisation statistics for a channel
+//  - Restarts the elapsed time. A running transfer is timed from now.
+HpsErr_t HPS_DMA_clearStatsCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((channel < HPS_DMA_CHANNEL_USER0) || (channel > HPS_DMA_CHANNEL_USER7)) return ERR_BADID;
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    status = _HPS_DMA_checkState(ctx);
+    uint64_t now = time_now_cycles();
+    ctx->chStats[channel] = (HPSDmaChStats_t){0};
+    ctx->chStatsSince[channel] = now;
+    ctx->chStart[channel] = now;
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return status;
+}
+
+// Initialise a HPSDmaChCtlParams structure for an FPGA FIFO stream
+//  - periph is the FPGA DMA request interface (HPS_DMA_PERIPH_FPGA_0 to _7).
+//  - toFpga selects memory to FIFO (true) or FIFO to memory (false).
+//  - width is the FIFO data register width, which must not exceed the DMA word size.
+//  - burstLen is the number of words moved on each burst request (1 to 16).
+//    It must not exceed the space (or fill) at which the FIFO requests a burst.
+//  - The channel and other defaults are as for HPS_DMA_initParameters().
+HpsErr_t HPS_DMA_initFpgaFifoParams(HPSDmaCtx_t* ctx, HPSDmaChCtlParams_t* params, HPSDmaPeripheralId periph, bool toFpga, HPSDmaBurstSize width, unsigned int burstLen) {
+    if (periph > HPS_DMA_PERIPH_FPGA_7) return ERR_BADID;
+    if (!burstLen || (burstLen > HPS_DMA_BURSTLEN_MAX)) return ERR_OUTRANGE;
+    //Populate the defaults for the direction
+    HpsErr_t status;
+    if (toFpga) {
+        status = HPS_DMA_initParameters(ctx, params, HPS_DMA_SOURCE_MEMORY, HPS_DMA_DESTINATION_PERIPH);
+    } else {
+        status = HPS_DMA_initParameters(ctx, params, HPS_DMA_SOURCE_PERIPH, HPS_DMA_DESTINATION_MEMORY);
+    }
+    if (ERR_IS_ERROR(status)) return status;
+    if (width > ctx->wordSize) return ERR_OUTRANGE;
+    //Then the FIFO handshake
+    params->transferWidth = width;
+    params->periph = periph;
+    params->periphBurstLen = burstLen;
+    return ERR_SUCCESS;
+}
+
+// Configure a flow controlled stream between an FPGA FIFO and memory
+//  - params are from HPS_DMA_initFpgaFifoParams(), with any changes made.
+//  - fifoAddr is the bus address of the FIFO data register (e.g. in the H2F bridge).
+//  - blocks is an array of count memory blocks (1 to HPS_DMA_FPGA_STREAM_BLOCKS_MAX),
+//    each blockLen bytes, which must be a multiple of the FIFO width.
+//  - If circular, the blocks are streamed continuously as for HPS_DMA_setupCircular(),
+//    otherwise they are streamed once in order as for HPS_DMA_setupTransferList().
+//  - The blocks array is not needed once this returns.
+//  - If the data cache is enabled, memory blocks must be cache maintained (see
+//    Util/dma_buffer.h) or coherent (see Util/acp_buffer.h).
+//  - Returns ERR_WRONGMODE if params are not for an FPGA FIFO.
+//  - Returns ERR_ALIGNMENT if fifoAddr or blockLen are not a multiple of the FIFO width.
+HpsErr_t HPS_DMA_setupFpgaStream(HPSDmaCtx_t* ctx, HPSDmaChCtlParams_t* params, uint32_t fifoAddr, void* const* blocks, unsigned int count, unsigned int blockLen, bool circular, bool autoStart) {
+    if (!params || !blocks) return ERR_NULLPTR;
+    //Check the parameters describe an FPGA FIFO at one end
+    HpsErr_t status = ERR_SUCCESS;
+    bool toFpga = (params->destType == HPS_DMA_DESTINATION_PERIPH);
+    if (!count || !blockLen) {
+        status = ERR_TOOSMALL;
+    } else if (count > HPS_DMA_FPGA_STREAM_BLOCKS_MAX) {
+        status = ERR_TOOBIG;
+    } else if (toFpga == (params->srcType == HPS_DMA_SOURCE_PERIPH)) {
+        status = ERR_WRONGMODE;
+    } else if (params->periph > HPS_DMA_PERIPH_FPGA_7) {
+        status = ERR_BADID;
+    } else if (!addressIsAligned(blockLen, _BV(params->transferWidth)) || !addressIsAligned(fifoAddr, _BV(params->transferWidth))) {
+        status = ERR_ALIGNMENT;
+    }
+    //Each block shares a copy of the parameters, with the FIFO at the fixed end
     if (ERR_IS_SUCCESS(status)) {
-        status = _HPS_DMA_setupTransfer(ctx, prog, params, autoStart);
+        HPSDmaChCtlParams_t blockParams = *params;
+        blockParams.autoFreeParams = false;
+        DmaChunk_t chunks[HPS_DMA_FPGA_STREAM_BLOCKS_MAX];
+        for (unsigned int idx = 0; idx < count; idx++) {
+            uint32_t memAddr = (uint32_t)(uintptr_t)blocks[idx];
+            chunks[idx].readAddr  = toFpga ? memAddr : fifoAddr;
+            chunks[idx].writeAddr = toFpga ? fifoAddr : memAddr;
+            chunks[idx].length    = blockLen;
+            chunks[idx].isLast    = (idx == (count - 1));
+            chunks[idx].index     = idx;
+            chunks[idx].params    = &blockParams;
+        }
+        status = _HPS_DMA_setupTransferList(ctx, chunks, count, autoStart, circular, NULL);
     }
     //Free the optional parameters if required
     if (params->autoFreeParams) {
-        xfer->params = NULL;
-        free(params);
+        MemPool_free(params);
     }
     return status;
 }
@@ -788,13 +1615,16 @@ HpsErr_t HPS_DMA_setupTransferWithProgram(HPSDmaCtx_t* ctx, HPSDmaProgram_t* pro
 
 // Start the previously configured transfer
 //  - If not enough space to start, returns ERR_BUSY.
-//  - Standard API starts all prepared channels. The xxxCh() API can start any channel.
+//  - Standard API starts all prepared channels not allocated to a channel context.
+//    The xxxCh() API can start any channel.
 HpsErr_t HPS_DMA_startTransfer(HPSDmaCtx_t* ctx) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
     //Loop through starting all channels. Any not ready to start or busy will be skipped.
     for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        //Skip channels allocated to a channel context
+        if (ctx->chCtx[channel]) continue;
         status = _HPS_DMA_startTransferCh(ctx, (HPSDmaChannelId)channel);
         if (ERR_IS_ERROR(status) && (status != ERR_NOTREADY)) return status;
     }
@@ -815,8 +1645,12 @@ HpsErr_t HPS_DMA_startTransferCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
 //  - Will return ERR_BUSY if the DMA processor is busy.
 //  - Standard API returns busy if any channel is busy. The xxxCh() API can check a specific channel.
 HpsErr_t HPS_DMA_busy(HPSDmaCtx_t* ctx) {
-    HpsErr_t status;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
     for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        //Skip channels allocated to a channel context
+        if (ctx->chCtx[channel]) continue;
         status = HPS_DMA_busyCh(ctx, (HPSDmaChannelId)channel);
         if (ERR_IS_ERROR(status)) return status;
     }
@@ -860,8 +1694,12 @@ HpsErr_t HPS_DMA_checkState(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, unsigned
 //    - Optional second argument can be used to read error information.
 // - Non-stateful. Can be used to check at any time.
 HpsErr_t HPS_DMA_transferError(HPSDmaCtx_t* ctx, unsigned int* errorInfo) {
-    HpsErr_t status;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
     for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        //Skip channels allocated to a channel context
+        if (ctx->chCtx[channel]) continue;
         // Check the channel state
         status = HPS_DMA_checkState(ctx, (HPSDmaChannelId)channel, errorInfo);
         // If a general failure, return the error
@@ -886,6 +1724,8 @@ HpsErr_t HPS_DMA_completed(HPSDmaCtx_t* ctx) {
     //to check if they have just completed
     status = ERR_BUSY;
     for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        //Skip channels allocated to a channel context
+        if (ctx->chCtx[channel]) continue;
         //Check if transfer has just completed
         if (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_DONE) {
             //If so, success. Clear the channel state.
@@ -920,7 +1760,7 @@ HpsErr_t HPS_DMA_completedCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
 
 
 // Issue an abort request to the DMA controller
-//  - This will abort all channels.
+//  - This will abort all channels, except that DMA_ABORT_SAFE skips channels allocated to a channel context.
 //  - DMA_ABORT_NONE clears the abort request (whether or not it has actually completed). Must be called after DMA_ABORT_FORCE abort to release from reset.
 //  - DMA_ABORT_SAFE requests the controller stop once any outstanding bus requests are handled
 //  - DMA_ABORT_FORCE stops immediately which may require a wider reset.
@@ -930,24 +1770,30 @@ HpsErr_t HPS_DMA_abort(HPSDmaCtx_t* ctx, DmaAbortType abort) {
     if (ERR_IS_ERROR(status)) return status;
     //Check if clearing abort state
     if (abort == DMA_ABORT_NONE) {
-        //Clear the abort pending flag, whether or not we have actually competed
+        //Clear the abort pending flags, whether or not we have actually competed
         ctx->abortPending = false;
+        for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+            if (!ctx->chCtx[channel]) ctx->chAbortPending &= ~_BV(channel);
+        }
         //And release the DMA controller from reset in case it was put there by a forced abort.
         *HPS_DMA_RSTMGR_DMAREG &= ~HPS_DMA_RSTMGR_DMAMASK;
         //Refresh states
         return _HPS_DMA_checkState(ctx);
     }
-    //Mark as abort pending
-    ctx->abortPending = true;
     //Check the abort type
     if (abort == DMA_ABORT_SAFE) {
-        //For safe abort, issue kill instruction to all channels.
+        //For safe abort, mark as abort pending and issue kill instruction to all
+        //channels which are not allocated to a channel context.
         for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+            if (ctx->chCtx[channel]) continue;
+            ctx->chAbortPending |= _BV(channel);
             _HPS_DMA_killThread(ctx, HPS_DMA_THREADTYPE_CH, (HPSDmaChannelId)channel);
         }
         //Refresh states
         return _HPS_DMA_checkState(ctx);
     } else {
+        //Mark as abort pending
+        ctx->abortPending = true;
         //For forced abort, simply place in reset the whole DMA controller
         *HPS_DMA_RSTMGR_DMAREG |= HPS_DMA_RSTMGR_DMAMASK;
         //Mark all channels as aborted immediately.
@@ -973,10 +1819,13 @@ HpsErr_t HPS_DMA_aborted(HPSDmaCtx_t* ctx) {
     //to check if they have just aborted
     status = ERR_BUSY;
     for (unsigned int channel = HPS_DMA_CHANNEL_MIN; channel < HPS_DMA_CHANNEL_COUNT; channel++) {
+        //Skip channels allocated to a channel context
+        if (ctx->chCtx[channel]) continue;
         //Check if transfer has just aborted
-        if (!ctx->abortPending && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_ABORTED)) {
+        if (!_HPS_DMA_abortPending(ctx, (HPSDmaChannelId)channel) && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_ABORTED)) {
             //If so, success. Clear the channel state.
             ctx->channelState[channel] = HPS_DMA_STATE_CHNL_FREE;
+            ctx->chCircular &= ~_BV(channel);
             //If auto-free is enabled for the program, free it now we are finished with it.
             HPS_DMA_freeProgram(&ctx->chProg[channel], true);
             //We will return complete as none are busy and at least one is done.
@@ -995,9 +1844,10 @@ HpsErr_t HPS_DMA_abortedCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
     status = _HPS_DMA_checkState(ctx);
     if (ERR_IS_ERROR(status)) return status;
     //Check if transfer has just completed
-    if (!ctx->abortPending && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_ABORTED)) {
+    if (!_HPS_DMA_abortPending(ctx, channel) && (ctx->channelState[channel] == HPS_DMA_STATE_CHNL_ABORTED)) {
         //If so, success. Clear the channel state.
         ctx->channelState[channel] = HPS_DMA_STATE_CHNL_FREE;
+        ctx->chCircular &= ~_BV(channel);
         //If auto-free is enabled for the program, free it now we are finished with it.
         HPS_DMA_freeProgram(&ctx->chProg[channel], true);
         return ERR_SUCCESS;
@@ -1005,4 +1855,138 @@ HpsErr_t HPS_DMA_abortedCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel) {
     return ERR_BUSY;
 }
 
+// Allocate a DMA channel for exclusive use
+//  - Picks a free channel which has not already been allocated, and returns a
+//    new channel context for it to *pChCtx.
+//  - The ->dma member of the channel context provides the generic DMA interface
+//    for that channel alone, allowing several users to run transfers concurrently
+//    on separate channels. Any params->channel or xfer->index is ignored.
+//  - Allocated channels are skipped by the standard controller APIs, and
+//    HPS_DMA_setupTransfer*() will return ERR_INUSE if asked to use one.
+//  - Returns ERR_NOSPACE if there are no free channels.
+HpsErr_t HPS_DMA_allocateChannel(HPSDmaCtx_t* ctx, HPSDmaChCtx_t** pChCtx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!pChCtx) return ERR_NULLPTR;
+    //Refresh the channel states
+    status = _HPS_DMA_checkState(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Search the unallocated channels from the highest, as the standard API
+    //defaults to the lowest channels for low chunk indices.
+    unsigned int unallocated = MaskCreate(UINTN_MAX(HPS_DMA_CHANNEL_COUNT - HPS_DMA_CHANNEL_MIN), HPS_DMA_CHANNEL_MIN) & ~ctx->chAllocated;
+    for (int channel = findHighestBit(unallocated); channel >= HPS_DMA_CHANNEL_MIN; channel = findHighestBit(unallocated)) {
+        unallocated &= ~_BV(channel);
+        if (ctx->channelState[channel] != HPS_DMA_STATE_CHNL_FREE) continue;
+        //Allocate the channel context, validating return value.
+        status = DriverContextAllocateWithCleanup(pChCtx, &_HPS_DMA_channelCleanup);
+        if (ERR_IS_ERROR(status)) return status;
+        HPSDmaChCtx_t* chCtx = *pChCtx;
+        chCtx->dmaCtx = ctx;
+        chCtx->channel = (HPSDmaChannelId)channel;
+        chCtx->dma.ctx = chCtx;
+        chCtx->dma.transferSpace = NULL;
+        chCtx->dma.initXferParams = (DmaXferParamFunc_t)&_HPS_DMA_channelInitDmaChunkParam;
+        chCtx->dma.setupTransfer = (DmaXferFunc_t)&_HPS_DMA_channelSetupTransfer;
+        chCtx->dma.setupTransferList = (DmaXferListFunc_t)&_HPS_DMA_channelSetupTransferList;
+        chCtx->dma.startTransfer = (DmaXferStartFunc_t)&_HPS_DMA_channelStartTransfer;
+        chCtx->dma.abortTransfer = (DmaAbortFunc_t)&_HPS_DMA_channelAbort;
+        chCtx->dma.transferBusy = (DmaStatusFunc_t)&_HPS_DMA_channelBusy;
+        chCtx->dma.transferDone = (DmaStatusFunc_t)&_HPS_DMA_channelCompleted;
+        chCtx->dma.transferError = (DmaStatInfoFunc_t)&_HPS_DMA_channelTransferError;
+        chCtx->dma.transferAborted = (DmaStatusFunc_t)&_HPS_DMA_channelAborted;
+        //Claim the channel
+        ctx->chCtx[channel] = chCtx;
+        ctx->chAllocated |= _BV(channel);
+        ctx->chAbortPending &= ~_BV(channel);
+        //Initialised
+        DriverContextSetInit(chCtx);
+        return ERR_SUCCESS;
+    }
+    return ERR_NOSPACE;
+}
+
+// Release a previously allocated DMA channel
+//  - Returns the channel to the controller and frees the channel context.
+//  - Returns ERR_INUSE/ERR_BUSY if a transfer is queued or running on the channel.
+//  - If the controller has already been freed, only the channel context is freed.
+HpsErr_t HPS_DMA_releaseChannel(HPSDmaChCtx_t** pChCtx) {
+    if (!pChCtx) return ERR_NULLPTR;
+    HPSDmaChCtx_t* chCtx = *pChCtx;
+    //If still attached to the controller, the channel must be idle
+    if (ERR_IS_SUCCESS(_HPS_DMA_channelValidate(chCtx))) {
+        HPSDmaCtx_t* ctx = chCtx->dmaCtx;
+        HpsErr_t status = _HPS_DMA_channelAvailable(ctx, chCtx->channel);
+        if (ERR_IS_ERROR(status)) return status;
+        //Acknowledge any final state, freeing the program if required.
+        ctx->channelState[chCtx->channel] = HPS_DMA_STATE_CHNL_FREE;
+        if (ctx->chProg[chCtx->channel]) HPS_DMA_freeProgram(&ctx->chProg[chCtx->channel], true);
+    }
+    //Free the context. The cleanup function returns the channel.
+    return DriverContextFree(pChCtx);
+}
 
+// Enable interrupt driven completion callbacks
+//  - Registers handlers for the DMA channel and abort interrupts with HPS_IRQ,
+//    which must be initialised first.
+//  - If work is not NULL, callbacks are posted to the work queue and run from
+//    thread context (e.g. by Event_process() after EventMgr_setWorkQueue()).
+//    Otherwise they are called directly from the interrupt handler.
+//  - Calling again updates the work queue.
+HpsErr_t HPS_DMA_enableCallbacks(HPSDmaCtx_t* ctx, WorkQueueCtx_t* work) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->work = work;
+    if (ctx->irqRegistered) return ERR_SUCCESS;
+    //Register the channel event handlers, and the abort handler for faults
+    for (unsigned int channel = HPS_DMA_CHANNEL_MIN; ERR_IS_SUCCESS(status) && (channel < HPS_DMA_CHANNEL_COUNT); channel++) {
+        status = HPS_IRQ_registerHandler((HPSIRQSource)(IRQ_DMA0 + channel), &_HPS_DMA_channelIsr, ctx);
+    }
+    if (ERR_IS_SUCCESS(status)) {
+        status = HPS_IRQ_registerHandler(IRQ_DMA_ABORT, &_HPS_DMA_abortIsr, ctx);
+    }
+    if (ERR_IS_ERROR(status)) {
+        _HPS_DMA_unregisterIrqs(ctx);
+        return status;
+    }
+    ctx->irqRegistered = true;
+    return ERR_SUCCESS;
+}
+
+// Disable interrupt driven completion callbacks
+//  - Unregisters the DMA interrupts. Callbacks remain set, but are not called.
+//  - Returns ERR_SKIPPED if not enabled.
+HpsErr_t HPS_DMA_disableCallbacks(HPSDmaCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->irqRegistered) return ERR_SKIPPED;
+    _HPS_DMA_unregisterIrqs(ctx);
+    return ERR_SUCCESS;
+}
+
+// Set the completion callback for a channel
+//  - The callback is called once per transfer on the channel when it completes
+//    or faults. NULL removes the callback. The channel interrupt is enabled
+//    while a callback is set.
+//  - Completion is acknowledged before the callback is called, so that it can
+//    queue the next transfer. HPS_DMA_completed*() will not report it. A fault is
+//    left for HPS_DMA_transferError() to report.
+//  - The transfer must issue its done event, as standard transfers do by default.
+//  - For channel contexts, use chCtx->dmaCtx and chCtx->channel.
+HpsErr_t HPS_DMA_setCallbackCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, HPSDmaCallback_t callback, void* param) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Ensure valid channel
+    if ((channel < HPS_DMA_CHANNEL_USER0) || (channel > HPS_DMA_CHANNEL_USER7)) return ERR_BADID;
+    //Update the callback atomically with respect to the interrupt handler
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    ctx->chCallback[channel] = callback;
+    ctx->chCallbackParam[channel] = param;
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    //The done event raises the channel interrupt only while a callback is set
+    unsigned int mask = MaskCreate(0x1, channel);
+    return HPS_DMA_setInterruptEnable(ctx, callback ? mask : 0, mask);
+}
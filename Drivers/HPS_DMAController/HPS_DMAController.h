@@ -39,6 +39,71 @@
  * define HPS_DMA_DEFAULT_MEM_CACHE_VALUE to be one of the values
  * from the HPSDmaCacheable enum (see HPS_DMAControllerEnums.h).
  * 
+ * Programs for HPS_DMA_setupTransfer() are generated into a
+ * buffer kept for each channel, along with the shape of the
+ * transfer (source/destination types, settings, length and
+ * address alignment). If the next transfer on that channel has
+ * the same shape, such as repeated FIFO or buffer copies, the
+ * program is reused with only its source and destination
+ * addresses patched, avoiding regenerating it.
+ * 
+ * Several chunks can be performed back-to-back as a single
+ * program on one channel with HPS_DMA_setupTransferList().
+ * 
+ * To run independent transfers concurrently, for example a
+ * display blit alongside audio FIFO transfers, each user can
+ * allocate its own channel with HPS_DMA_allocateChannel(). This
+ * returns a channel context whose ->dma member is a generic DMA
+ * interface for that channel alone. Allocated channels are
+ * ignored by the standard controller APIs.
+ * 
+ * Instead of polling for completion, HPS_DMA_enableCallbacks()
+ * registers the DMA interrupts with HPS_IRQ, and a callback can
+ * then be set for each channel with HPS_DMA_setCallbackCh(). It
+ * is called when each transfer on that channel completes, and
+ * may queue the next one. Callbacks can optionally be deferred
+ * to a work queue (Util/work.h) to run from the main loop.
+ * 
+ * For continuous streams such as audio or display buffers,
+ * HPS_DMA_setupCircular() builds a program which loops over a
+ * set of blocks (e.g. ping-pong buffers) until aborted, issuing
+ * the channel event at the end of each block. With callbacks
+ * enabled, the channel callback is called at each boundary so
+ * the finished block can be refilled or consumed while the DMA
+ * carries on with the next one.
+ * 
+ * Transfers to or from peripherals with DMA request interfaces,
+ * such as the UART and SPI FIFOs, use the _PERIPH source or
+ * destination type with params->periph set to the request line
+ * (see HPS_DMAControllerPeriphCV.h). The transfer then waits for
+ * the peripheral to request each burst of params->periphBurstLen
+ * words (or each single word for the remainder), so never over-
+ * or under-runs the peripheral FIFO.
+ * 
+ * FPGA FIFOs with a DMA request interface (f2h_dma_req*) can be
+ * streamed with HPS_DMA_setupFpgaStream(), which takes the FIFO
+ * data register address and a set of memory blocks, and builds
+ * the peripheral transfers for each block. The stream can run
+ * once over the blocks, or continuously as a circular transfer:
+ * 
+ *    HPSDmaChCtlParams_t params;
+ *    HPS_DMA_initFpgaFifoParams(dmaCtx, &params, HPS_DMA_PERIPH_FPGA_0, false, HPS_DMA_BURSTSIZE_4BYTE, 8);
+ *    params.channel = HPS_DMA_CHANNEL_USER2;
+ *    HPS_DMA_setupFpgaStream(dmaCtx, &params, fifoAddr, pingPong, 2, 4096, true, true);
+ * 
+ * The FPGA IP should assert its burst request whenever the FIFO
+ * has room for (or holds) a burst of words, and its single request
+ * whenever it has room for (or holds) at least one word. The last
+ * words of a block which do not fill a burst are moved on single
+ * requests. Interfaces 4-7 are shared with other peripherals, so
+ * must be selected with periphMux when the controller is initialised.
+ * 
+ * Each channel keeps utilisation statistics, read with
+ * HPS_DMA_getStatsCh(): the bytes moved and transfers completed,
+ * the time spent running (from the global timer, Util/timestamp.h)
+ * and the number of faults and aborts. Comparing the busy time to
+ * the elapsed time shows whether a channel is saturated or idle.
+ * 
  * The DMA controller is a highly configurable device with its
  * own 8-core processor and custom instruction set to allow all
  * manner of weird transfers to be performed. This capability can
@@ -55,6 +120,16 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add per-channel utilisation statistics
+ * 14/10/2026 | Add FPGA FIFO streaming helpers
+ * 14/10/2026 | Find free channels with a bitmask
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Reuse cached per-channel program templates.
+ *            | Add scatter-gather transfers.
+ *            | Add per-channel contexts for concurrent transfers.
+ *            | Add interrupt driven completion callbacks.
+ *            | Add circular transfers for continuous streams.
+ *            | Add peripheral flow controlled transfers.
  * 18/02/2024 | Creation of driver.
  *
  */
@@ -64,6 +139,8 @@
 
 #include "Util/driver_ctx.h"
 #include "Util/driver_dma.h"
+#include "Util/work.h"
+#include "HPS_IRQ/HPS_IRQ.h"
 
 #include "Util/bit_helpers.h"
 #include "Util/macros.h"
@@ -112,6 +189,8 @@ typedef struct {
     bool             burstDisable;   // Whether bursting is allowed. If disabled, no transfer will be larger than a single "word".
     bool             doneEvent;      // If true, will issue an event for the current channel on transfer complete. Will trigger IRQ only if the corresponding IRQ is enabled.
     // Peripheral
+    HPSDmaPeripheralId periph;       // Request interface for _PERIPH source or destination types.
+    unsigned int     periphBurstLen; // Words per peripheral burst request (1 to 16). Must not exceed the peripheral burst size. 1 uses single requests only.
     DrvCtx_t*        periphCtx;      // Driver context for peripheral (e.g. I2C or UART) or NULL.
     void*            periphFunc;     // Callback function for peripherals (not yet implemented)
     // Internally set values for standard programs. Must be manually set for custom programs.
@@ -139,6 +218,35 @@ typedef struct PACKED {
     uint8_t buf[] ALIGNED(sizeof(uint32_t));
 } HPSDmaProgram_t;
 
+// Shape of a transfer generated by HPS_DMA_setupTransfer. Transfers with
+// the same shape have the same program except for their addresses.
+typedef struct {
+    HPSDmaDataSource srcType;
+    HPDDmaProtection srcProtCtrl;
+    HPSDmaCacheable  srcCacheCtrl;
+    HPSDmaDataDest   destType;
+    HPDDmaProtection destProtCtrl;
+    HPSDmaCacheable  destCacheCtrl;
+    HPSDmaBurstSize  transferWidth;
+    HPSDmaEndianSwap endian;
+    bool             burstDisable;
+    bool             doneEvent;
+    HPSDmaPeripheralId periph;
+    unsigned int     periphBurstLen;
+    uint8_t          readAlign;      // Source address modulo transfer width
+    uint8_t          writeAlign;     // Destination address modulo transfer width
+    uint64_t         length;
+} HPSDmaTemplateKey_t;
+
+// Cached program for a channel
+typedef struct {
+    HPSDmaProgram_t*    prog;        // Program buffer, allocated on first use
+    HPSDmaTemplateKey_t key;         // Shape of the program currently in the buffer
+    bool                valid;       // Whether the buffer holds a complete program for key
+    unsigned int        sarPos;      // Offset of the DMAMOV SAR instruction, or UINT32_MAX if none
+    unsigned int        darPos;      // Offset of the DMAMOV DAR instruction, or UINT32_MAX if none
+} HPSDmaTemplate_t;
+
 //HW initialisation parameters for driver.
 //  - For default values, initialise struct to all zeros (myStruct = {0})
 //  - Then modify any fields as desired.
@@ -149,6 +257,26 @@ typedef struct {
     HPSDmaPeriphMux periphMux      [HPS_DMA_PERMUX_COUNT];     // Peripheral multiplexer configuration. Indexed with multiplexed HPSDmaPeripheralId minus HPS_DMA_PERMUX_OFFSET
 } HPSDmaHwInit_t;
 
+// Completion callback
+//  - result is ERR_SUCCESS if the transfer completed, or ERR_IOFAIL if the
+//    channel faulted. param is the value given to HPS_DMA_setCallbackCh().
+//  - For circular transfers, result is ERR_AGAIN at the end of each block.
+typedef void (*HPSDmaCallback_t)(HPSDmaChannelId channel, HpsErr_t result, void* param);
+
+//Utilisation statistics for a channel. See HPS_DMA_getStatsCh().
+//  - Times are in global timer cycles (see Util/timestamp.h, time_cyclesToNs()).
+typedef struct {
+    uint64_t     bytes;         // Bytes moved by completed transfers. Circular transfers are counted each full loop.
+    uint64_t     busyCycles;    // Time channel has spent running transfers, including any running now.
+    uint64_t     elapsedCycles; // Time since the statistics were last cleared.
+    unsigned int transfers;     // Transfers completed. Circular transfers count each block.
+    unsigned int faults;        // Transfers ended by a channel fault.
+    unsigned int aborts;        // Transfers ended by an abort.
+} HPSDmaChStats_t;
+
+//Per-channel driver context. See HPS_DMA_allocateChannel().
+typedef struct HPSDmaChCtx_s HPSDmaChCtx_t;
+
 //Driver context
 typedef struct {
     //Header
@@ -166,10 +294,39 @@ typedef struct {
     unsigned int channelFault[HPS_DMA_CHANNEL_COUNT]; // Last reported fault state for channel. See HPSDmaChFault for flag bitmasks
     //Program memory pointers for each DMA channel
     HPSDmaProgram_t* chProg[HPS_DMA_CHANNEL_COUNT];
+    //Cached standard transfer program for each DMA channel
+    HPSDmaTemplate_t chTemplate[HPS_DMA_CHANNEL_COUNT];
     //Debug command buffer.
     HPSDmaProgram_t* dbgProg;
+    //Channel contexts allocated to each DMA channel, or NULL if unallocated.
+    HPSDmaChCtx_t* chCtx[HPS_DMA_CHANNEL_COUNT];
+    unsigned int chAllocated;    // Mask of channels allocated to a channel context.
+    unsigned int chAbortPending; // Mask of channels with a safe or channel abort pending.
+    //Completion callbacks for each DMA channel
+    HPSDmaCallback_t chCallback[HPS_DMA_CHANNEL_COUNT];
+    void* chCallbackParam[HPS_DMA_CHANNEL_COUNT];
+    WorkQueueCtx_t* work;  // Optional queue to defer callbacks to, or NULL to call from the IRQ.
+    bool irqRegistered;    // Whether the DMA interrupts are registered with HPS_IRQ.
+    //Circular transfer state
+    unsigned int chCircular; // Mask of channels running a circular transfer.
+    unsigned int chBlocks[HPS_DMA_CHANNEL_COUNT]; // Blocks completed by each circular transfer.
+    //Utilisation statistics
+    HPSDmaChStats_t chStats[HPS_DMA_CHANNEL_COUNT];
+    uint64_t chStatsSince[HPS_DMA_CHANNEL_COUNT]; // Time the statistics were last cleared.
+    uint64_t chStart[HPS_DMA_CHANNEL_COUNT];      // Time the current transfer was started.
+    uint64_t chLength[HPS_DMA_CHANNEL_COUNT];     // Bytes moved by the current transfer (or by each loop of a circular one).
+    unsigned int chLoopBlocks[HPS_DMA_CHANNEL_COUNT]; // Blocks in each loop of a circular transfer.
 } HPSDmaCtx_t;
 
+struct HPSDmaChCtx_s {
+    //Header
+    DrvCtx_t header;
+    //Body
+    HPSDmaCtx_t*    dmaCtx;  // Controller the channel belongs to. NULL once the controller is freed.
+    HPSDmaChannelId channel;
+    DmaCtx_t        dma;
+};
+
 // Initialise the HPS DMA Driver
 //  - base is a pointer to DMA peripheral in the HPS, both secure
 //    or non-secure controllers are supported.
@@ -229,6 +386,77 @@ HpsErr_t HPS_DMA_initParameters(HPSDmaCtx_t* ctx, HPSDmaChCtlParams_t* param, HP
 //    - Use HPS_DMA_abort() to stop any running transfers.
 HpsErr_t HPS_DMA_setupTransfer(HPSDmaCtx_t* ctx, DmaChunk_t* xfer, bool autoStart);
 
+// Configure a scatter-gather DMA transfer
+//  - Performs count chunks from the xfers array back-to-back as a single program
+//    on one channel, without CPU intervention between chunks.
+//  - The channel and done event are taken from the parameters of the first chunk,
+//    or (xfers[0].index % CH_COUNT) if it has none. Each chunk may have its own
+//    parameters for source/destination types and settings.
+//  - If selected DMA channel is in use, returns ERR_BUSY.
+//  - The xfers array is not needed once this returns.
+//  - Will return ERR_SUCCESS if the transfer was successfully queued, after which
+//    it is handled in the same way as HPS_DMA_setupTransfer().
+HpsErr_t HPS_DMA_setupTransferList(HPSDmaCtx_t* ctx, DmaChunk_t* xfers, unsigned int count, bool autoStart);
+
+// Configure a circular DMA transfer for a continuous stream
+//  - Performs count blocks from the blocks array in order, then starts again
+//    from the first block, repeating until aborted with HPS_DMA_abort*().
+//  - The channel event is issued at the end of every block (unless doneEvent is
+//    set in the parameters of the first block), so with HPS_DMA_enableCallbacks()
+//    the channel callback is called with ERR_AGAIN at each block boundary.
+//  - The channel is taken from the parameters of the first block, or from
+//    (blocks[0].index % CH_COUNT) if it has none, as for HPS_DMA_setupTransferList().
+//  - The looped blocks must fit in 255 bytes of program, returning ERR_OUTRANGE
+//    if not. A few simple memory or register blocks (e.g. two ping-pong buffers)
+//    fit comfortably.
+//  - The transfer never completes, so HPS_DMA_completed*() will not report it.
+HpsErr_t HPS_DMA_setupCircular(HPSDmaCtx_t* ctx, DmaChunk_t* blocks, unsigned int count, bool autoStart);
+
+// Get the number of blocks completed by a circular transfer
+//  - Blocks are counted by the channel interrupt, so callbacks must be enabled.
+//    The count restarts from zero each time a transfer is set up on the channel.
+//  - The block which has just finished is ((*blocks - 1) % count).
+//  - Returns ERR_WRONGMODE if the channel is not running a circular transfer.
+HpsErr_t HPS_DMA_circularBlocksCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, unsigned int* blocks);
+
+// Get the utilisation statistics for a channel
+//  - Copies the statistics accumulated since the driver was initialised or
+//    HPS_DMA_clearStatsCh() was called to *stats.
+//  - Transfers are counted as they are found to be complete, which is at the
+//    channel interrupt if callbacks are enabled, otherwise when polled.
+//  - Custom program transfers are timed, but their bytes are not counted.
+HpsErr_t HPS_DMA_getStatsCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, HPSDmaChStats_t* stats);
+
+// Clear the utilisation statistics for a channel
+//  - Restarts the elapsed time. A running transfer is timed from now.
+HpsErr_t HPS_DMA_clearStatsCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel);
+
+// Maximum number of blocks in an FPGA FIFO stream
+#define HPS_DMA_FPGA_STREAM_BLOCKS_MAX 8
+
+// Initialise a HPSDmaChCtlParams structure for an FPGA FIFO stream
+//  - periph is the FPGA DMA request interface (HPS_DMA_PERIPH_FPGA_0 to _7).
+//  - toFpga selects memory to FIFO (true) or FIFO to memory (false).
+//  - width is the FIFO data register width, which must not exceed the DMA word size.
+//  - burstLen is the number of words moved on each burst request (1 to 16).
+//    It must not exceed the space (or fill) at which the FIFO requests a burst.
+//  - The channel and other defaults are as for HPS_DMA_initParameters().
+HpsErr_t HPS_DMA_initFpgaFifoParams(HPSDmaCtx_t* ctx, HPSDmaChCtlParams_t* params, HPSDmaPeripheralId periph, bool toFpga, HPSDmaBurstSize width, unsigned int burstLen);
+
+// Configure a flow controlled stream between an FPGA FIFO and memory
+//  - params are from HPS_DMA_initFpgaFifoParams(), with any changes made.
+//  - fifoAddr is the bus address of the FIFO data register (e.g. in the H2F bridge).
+//  - blocks is an array of count memory blocks (1 to HPS_DMA_FPGA_STREAM_BLOCKS_MAX),
+//    each blockLen bytes, which must be a multiple of the FIFO width.
+//  - If circular, the blocks are streamed continuously as for HPS_DMA_setupCircular(),
+//    otherwise they are streamed once in order as for HPS_DMA_setupTransferList().
+//  - The blocks array is not needed once this returns.
+//  - If the data cache is enabled, memory blocks must be cache maintained (see
+//    Util/dma_buffer.h) or coherent (see Util/acp_buffer.h).
+//  - Returns ERR_WRONGMODE if params are not for an FPGA FIFO.
+//  - Returns ERR_ALIGNMENT if fifoAddr or blockLen are not a multiple of the FIFO width.
+HpsErr_t HPS_DMA_setupFpgaStream(HPSDmaCtx_t* ctx, HPSDmaChCtlParams_t* params, uint32_t fifoAddr, void* const* blocks, unsigned int count, unsigned int blockLen, bool circular, bool autoStart);
+
 // Configure a DMA transfer with a custom program
 //  - allows performing transfers with arbitrary programs.
 //  - Use HPS_DMA_instCh*() API from HPS_DMAControllerProgram.h to create these programs.
@@ -239,7 +467,8 @@ HpsErr_t HPS_DMA_setupTransferWithProgram(HPSDmaCtx_t* ctx, HPSDmaProgram_t* pro
 
 // Start the previously configured transfer
 //  - If not enough space to start, returns ERR_BUSY.
-//  - Standard API starts all prepared channels. The xxxCh() API can start any channel.
+//  - Standard API starts all prepared channels not allocated to a channel context.
+//    The xxxCh() API can start any channel.
 HpsErr_t HPS_DMA_startTransfer(HPSDmaCtx_t* ctx);
 HpsErr_t HPS_DMA_startTransferCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel);
 
@@ -271,7 +500,7 @@ HpsErr_t HPS_DMA_completed(HPSDmaCtx_t* ctx);
 HpsErr_t HPS_DMA_completedCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel);
 
 // Issue an abort request to the DMA controller
-//  - This will abort all channels.
+//  - This will abort all channels, except that DMA_ABORT_SAFE skips channels allocated to a channel context.
 //  - DMA_ABORT_NONE clears the abort request (whether or not it has actually completed). Must be called after DMA_ABORT_FORCE abort to release from reset.
 //  - DMA_ABORT_SAFE requests the controller stop once any outstanding bus requests are handled
 //  - DMA_ABORT_FORCE stops immediately which may require a wider reset.
@@ -285,5 +514,47 @@ HpsErr_t HPS_DMA_abort(HPSDmaCtx_t* ctx, DmaAbortType abort);
 HpsErr_t HPS_DMA_aborted(HPSDmaCtx_t* ctx);
 HpsErr_t HPS_DMA_abortedCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel);
 
+// Allocate a DMA channel for exclusive use
+//  - Picks a free channel which has not already been allocated, and returns a
+//    new channel context for it to *pChCtx.
+//  - The ->dma member of the channel context provides the generic DMA interface
+//    for that channel alone, allowing several users to run transfers concurrently
+//    on separate channels. Any params->channel or xfer->index is ignored.
+//  - Allocated channels are skipped by the standard controller APIs, and
+//    HPS_DMA_setupTransfer*() will return ERR_INUSE if asked to use one.
+//  - Returns ERR_NOSPACE if there are no free channels.
+HpsErr_t HPS_DMA_allocateChannel(HPSDmaCtx_t* ctx, HPSDmaChCtx_t** pChCtx);
+
+// Release a previously allocated DMA channel
+//  - Returns the channel to the controller and frees the channel context.
+//  - Returns ERR_INUSE/ERR_BUSY if a transfer is queued or running on the channel.
+//  - If the controller has already been freed, only the channel context is freed.
+HpsErr_t HPS_DMA_releaseChannel(HPSDmaChCtx_t** pChCtx);
+
+// Enable interrupt driven completion callbacks
+//  - Registers handlers for the DMA channel and abort interrupts with HPS_IRQ,
+//    which must be initialised first.
+//  - If work is not NULL, callbacks are posted to the work queue and run from
+//    thread context (e.g. by Event_process() after EventMgr_setWorkQueue()).
+//    Otherwise they are called directly from the interrupt handler.
+//  - Calling again updates the work queue.
+HpsErr_t HPS_DMA_enableCallbacks(HPSDmaCtx_t* ctx, WorkQueueCtx_t* work);
+
+// Disable interrupt driven completion callbacks
+//  - Unregisters the DMA interrupts. Callbacks remain set, but are not called.
+//  - Returns ERR_SKIPPED if not enabled.
+HpsErr_t HPS_DMA_disableCallbacks(HPSDmaCtx_t* ctx);
+
+// Set the completion callback for a channel
+//  - The callback is called once per transfer on the channel when it completes
+//    or faults. NULL removes the callback. The channel interrupt is enabled
+//    while a callback is set.
+//  - Completion is acknowledged before the callback is called, so that it can
+//    queue the next transfer. HPS_DMA_completed*() will not report it. A fault is
+//    left for HPS_DMA_transferError() to report.
+//  - The transfer must issue its done event, as standard transfers do by default.
+//  - For channel contexts, use chCtx->dmaCtx and chCtx->channel.
+HpsErr_t HPS_DMA_setCallbackCh(HPSDmaCtx_t* ctx, HPSDmaChannelId channel, HPSDmaCallback_t callback, void* param);
+
 #endif /* HPS_DMACONTROLLER_H_ */
 
@@ -12,6 +12,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Peripheral source/destination now supported.
  * 04/05/2024 | Creation of header.
  *
  */
@@ -44,7 +45,7 @@ typedef enum {
 typedef enum {
     HPS_DMA_SOURCE_MEMORY   = 0, // Data is read from a memory region (incrementing address)
     HPS_DMA_SOURCE_REGISTER = 1, // Data is read from a register (non-incrementing address)
-    HPS_DMA_SOURCE_PERIPH   = 2, // Data is written to a peripheral (custom, not yet supported)
+    HPS_DMA_SOURCE_PERIPH   = 2, // Data is read from a peripheral register, paced by its DMA requests
     HPS_DMA_SOURCE_ZERO     = 3  // Data will be just zeros.
 } HPSDmaDataSource;
 
@@ -52,7 +53,7 @@ typedef enum {
 typedef enum {
     HPS_DMA_DESTINATION_MEMORY   = 0, // Data is written to a memory region (incrementing address)
     HPS_DMA_DESTINATION_REGISTER = 1, // Data is written to a register (non-incrementing address)
-    HPS_DMA_DESTINATION_PERIPH   = 2  // Data is written to a peripheral (custom, not yet supported)
+    HPS_DMA_DESTINATION_PERIPH   = 2  // Data is written to a peripheral register, paced by its DMA requests
 } HPSDmaDataDest;
 
 // If unsure, use default Protection and Cacheable settings.
@@ -10,6 +10,40 @@
  * For Arria 10, The GPIO banks are 24bit wide, so in
  * the pin bit masks, bits 0-23 only are used.
  *
+ * The controller has no set/clear registers, so output changes
+ * are a read-modify-write of the data register. The output APIs
+ * mask interrupts around this so that updates from an ISR to
+ * other pins in the bank are not lost. HPS_GPIO_updateOutput()
+ * sets and clears pins in a single write.
+ *
+ * For bit-banged protocols, the unchecked fast path accessors
+ * in Util/driver_gpio.h can be used with ctx->gpio, e.g.:
+ *
+ *    GpioFast_t* fast = GPIO_getFast(&ctx->gpio);
+ *    GPIO_fastSet(fast, _BV(9));
+ *
+ * Edge Capture
+ * ------------
+ *
+ * Input edges can be captured into a ring buffer from the GPIO
+ * interrupt, each with the pin, the edge, and the lower word of
+ * the ARM global timer as a timestamp:
+ *
+ *    HPS_GPIO_startCapture(gpio, IRQ_GPIO1, events, 64);
+ *    HPS_GPIO_setCapture(gpio, GPIO_CAPTURE_BOTH, ENC_A | ENC_B);
+ *    ...
+ *    count = HPS_GPIO_readCapture(gpio, batch, 16);
+ *
+ * The controller can only interrupt on one edge of a pin, so for
+ * capturing both edges the polarity is swapped after each one. If
+ * a pin changes twice before the interrupt is handled, the edges
+ * are missed. Events which don't fit in the buffer are counted as
+ * lost. Timestamps are global timer ticks (see Util/profile.h for
+ * the rate), and wrap, so use the unsigned difference of two.
+ *
+ * Capture claims the GPIO interrupt for this bank. The interrupt
+ * configuration APIs must not be used for captured pins.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -17,6 +51,8 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add timestamped edge capture
+ *            | Add atomic bit set/clear and fast path
  * 30/12/2023 | Creation of driver
  *
  */
@@ -25,6 +61,10 @@
 
 #include "HPS_IRQ/HPS_IRQ.h"
 #include "Util/bit_helpers.h"
+#include "Util/hwlib/alt_globaltmr.h"
+
+// Published by hwlib, but not in the header
+extern bool alt_globaltmr_is_running(void);
 
 #define GPIO_OUTPUT     ( 0x0 / sizeof(unsigned int))
 #define GPIO_DIRECTION  ( 0x4 / sizeof(unsigned int))
@@ -57,9 +97,71 @@ static unsigned int _HPS_GPIO_setConfigFlag(unsigned int cur, unsigned int mask,
     return cur;
 }
 
+//Set and clear outputs
+// - Masks interrupts so that the read-modify-write is atomic
+static void _HPS_GPIO_updateOutput(HPSGPIOCtx_t* ctx, unsigned int set, unsigned int clear) {
+    //Inverted pins are cleared to set them, and vice versa
+    clear &= ~set;
+    unsigned int hi = (set & ~ctx->polarity) | (clear &  ctx->polarity);
+    unsigned int lo = (set &  ctx->polarity) | (clear & ~ctx->polarity);
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    ctx->base[GPIO_OUTPUT] = (ctx->base[GPIO_OUTPUT] | hi) & ~lo;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+}
+
+//Edge capture interrupt handler
+static __irq void _HPS_GPIO_captureIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    HPSGPIOCtx_t* ctx = (HPSGPIOCtx_t*)param;
+    if (!ctx) return;
+    unsigned int flags = ctx->base[GPIO_INTR_FLAGS] & ctx->capture.pins;
+    if (!flags) return;
+    *handled = true;
+    uint32_t timestamp = alt_globaltmr_counter_get_low32();
+    //Edge which fired, then swap polarity of pins capturing both edges to catch the next
+    ctx->base[GPIO_INTR_CLEAR] = flags;
+    unsigned int rising = ctx->base[GPIO_INTR_POL] & flags;
+    unsigned int both = flags & ctx->capture.both;
+    if (both) {
+        ctx->base[GPIO_INTR_POL] = ctx->base[GPIO_INTR_POL] ^ both;
+    }
+    //Report edges of the logical value
+    rising ^= (flags & ctx->polarity);
+    //Queue an event for each pin, lowest first
+    unsigned int head = ctx->capture.head;
+    while (flags) {
+        unsigned int bit = flags & -flags;
+        flags &= ~bit;
+        if ((head - ctx->capture.tail) > ctx->capture.mask) {
+            ctx->capture.lost++;
+            continue;
+        }
+        HPSGPIOCapture_t* event = &ctx->capture.buf[head & ctx->capture.mask];
+        event->timestamp = timestamp;
+        event->pin = 31 - __clz(bit);
+        event->edge = (rising & bit) ? GPIO_CAPTURE_RISING : GPIO_CAPTURE_FALLING;
+        head++;
+    }
+    ctx->capture.head = head;
+}
+
+//Stop edge capture
+static void _HPS_GPIO_stopCapture(HPSGPIOCtx_t* ctx) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    ctx->base[GPIO_INTR_EN] = ctx->base[GPIO_INTR_EN] & ~ctx->capture.pins;
+    ctx->base[GPIO_INTR_CLEAR] = ctx->capture.pins;
+    ctx->capture.pins = 0;
+    ctx->capture.both = 0;
+    ctx->capture.enabled = false;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    HPS_IRQ_unregisterHandler(ctx->capture.irqID);
+}
+
 static void _HPS_GPIO_cleanup(HPSGPIOCtx_t* ctx) {
     //Disable interrupts and set default output state
     if (ctx->base) {
+        if (ctx->capture.enabled) {
+            _HPS_GPIO_stopCapture(ctx);
+        }
         ctx->base[GPIO_INTR_EN  ] = 0x0;
         ctx->base[GPIO_DIRECTION] = ctx->initDir;
         ctx->base[GPIO_OUTPUT   ] = ctx->initPort ^ ctx->polarity;
@@ -101,6 +203,12 @@ HpsErr_t HPS_GPIO_initialise(void* base, unsigned int dir, unsigned int port, un
     ctx->gpio.setOutput = (GpioWriteFunc_t)&HPS_GPIO_setOutput;
     ctx->gpio.toggleOutput = (GpioToggleFunc_t)&HPS_GPIO_toggleOutput;
     ctx->gpio.getInput = (GpioReadFunc_t)&HPS_GPIO_getInput;
+    ctx->gpio.bitsetOutput = (GpioMaskFunc_t)&HPS_GPIO_bitsetOutput;
+    ctx->gpio.bitclearOutput = (GpioMaskFunc_t)&HPS_GPIO_bitclearOutput;
+    //No set/clear registers, so the fast path uses R-M-W
+    ctx->gpio.fast.out = &ctx->base[GPIO_OUTPUT];
+    ctx->gpio.fast.in = &ctx->base[GPIO_INPUT];
+    ctx->gpio.fast.polarity = polarity;
     //And initialised
     DriverContextSetInit(ctx);
     return ERR_SUCCESS;
@@ -142,30 +250,67 @@ HpsErr_t HPS_GPIO_getDirection(HPSGPIOCtx_t* ctx, unsigned int* dir, unsigned in
 //Set output value
 // - Sets or clears the output value of masked pins.
 // - Will perform read-modify-write such that only pins with
-//   their mask bit set will be changed.
+//   their mask bit set will be changed. Interrupts are masked
+//   during the read-modify-write.
 // - e.g. with mask of 0x00010002, pins [1] and [16] will be changed.
 HpsErr_t HPS_GPIO_setOutput(HPSGPIOCtx_t* ctx, unsigned int port, unsigned int mask) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
     //R-M-W output
-    port ^= ctx->polarity;
-    unsigned int curVal = ctx->base[GPIO_OUTPUT];
-    ctx->base[GPIO_OUTPUT] = ((port & mask) | (curVal & ~mask));
+    _HPS_GPIO_updateOutput(ctx, port & mask, ~port & mask);
     return ERR_SUCCESS;
 }
 
 //Toggle output value
 // - Toggles the output value of masked pins.
 // - Will perform read-modify-write such that only pins with
-//   their mask bit set will be toggled.
+//   their mask bit set will be toggled. Interrupts are masked
+//   during the read-modify-write.
 // - e.g. with mask of 0x00010002, pins [1] and [16] will be changed.
 HpsErr_t HPS_GPIO_toggleOutput(HPSGPIOCtx_t* ctx, unsigned int mask) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
     //Toggle outputs
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
     ctx->base[GPIO_OUTPUT] = (ctx->base[GPIO_OUTPUT] ^ mask);
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Set output bits
+// - Sets the output value of masked pins.
+HpsErr_t HPS_GPIO_bitsetOutput(HPSGPIOCtx_t* ctx, unsigned int mask) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Set outputs
+    _HPS_GPIO_updateOutput(ctx, mask, 0);
+    return ERR_SUCCESS;
+}
+
+//Clear output bits
+// - Clears the output value of masked pins.
+HpsErr_t HPS_GPIO_bitclearOutput(HPSGPIOCtx_t* ctx, unsigned int mask) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Clear outputs
+    _HPS_GPIO_updateOutput(ctx, 0, mask);
+    return ERR_SUCCESS;
+}
+
+//Update output bits
+// - Sets the output value of pins in set, and clears those in
+//   clear, with a single write to the output register.
+// - If a pin is in both, it is set.
+HpsErr_t HPS_GPIO_updateOutput(HPSGPIOCtx_t* ctx, unsigned int set, unsigned int clear) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Update outputs
+    _HPS_GPIO_updateOutput(ctx, set, clear);
     return ERR_SUCCESS;
 }
 
@@ -268,3 +413,114 @@ HpsErr_t HPS_GPIO_setDebounce(HPSGPIOCtx_t* ctx, unsigned int bounce, unsigned i
     return ERR_SUCCESS;
 }
 
+//Start edge capture
+// - irqID is the interrupt of this GPIO bank (e.g. IRQ_GPIO1).
+// - buf is the ring buffer for size events. size must be a power of two.
+// - No pins are captured until set with HPS_GPIO_setCapture().
+// - Requires HPS_IRQ to be initialised. Starts the global timer if not running.
+// - Returns ERR_BUSY if already started.
+HpsErr_t HPS_GPIO_startCapture(HPSGPIOCtx_t* ctx, HPSIRQSource irqID, HPSGPIOCapture_t* buf, unsigned int size) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!buf) return ERR_NULLPTR;
+    if (!size || (size & (size - 1))) return ERR_OUTRANGE;
+    if (ctx->capture.enabled) return ERR_BUSY;
+    //Timestamps come from the global timer
+    if (!alt_globaltmr_is_running()) {
+        alt_globaltmr_init();
+    }
+    ctx->capture.pins = 0;
+    ctx->capture.both = 0;
+    ctx->capture.buf = buf;
+    ctx->capture.mask = size - 1;
+    ctx->capture.head = 0;
+    ctx->capture.tail = 0;
+    ctx->capture.lost = 0;
+    //Register the interrupt handler
+    status = HPS_IRQ_registerHandler(irqID, &_HPS_GPIO_captureIsr, ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->capture.irqID = irqID;
+    ctx->capture.enabled = true;
+    return ERR_SUCCESS;
+}
+
+//Stop edge capture
+// - Disables interrupts for captured pins, and releases the interrupt.
+// - Returns ERR_SKIPPED if not started.
+HpsErr_t HPS_GPIO_stopCapture(HPSGPIOCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->capture.enabled) return ERR_SKIPPED;
+    _HPS_GPIO_stopCapture(ctx);
+    return ERR_SUCCESS;
+}
+
+//Set captured edges
+// - Sets which edges of the masked pins are captured,
+//   GPIO_CAPTURE_NONE to stop capturing them.
+// - Returns ERR_WRONGMODE if capture has not been started.
+HpsErr_t HPS_GPIO_setCapture(HPSGPIOCtx_t* ctx, GPIOCaptureEdge edges, unsigned int mask) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->capture.enabled) return ERR_WRONGMODE;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    //Disable the pins while we make changes
+    unsigned int enBits = ctx->base[GPIO_INTR_EN] & ~mask;
+    ctx->base[GPIO_INTR_EN] = enBits;
+    ctx->capture.pins &= ~mask;
+    ctx->capture.both &= ~mask;
+    if (edges != GPIO_CAPTURE_NONE) {
+        //Polarity of the physical edge to wait for. For both, the opposite of the current level.
+        unsigned int rising;
+        if (edges == GPIO_CAPTURE_BOTH) {
+            rising = ~ctx->base[GPIO_INPUT];
+            ctx->capture.both |= mask;
+        } else {
+            rising = (edges == GPIO_CAPTURE_RISING) ? ~ctx->polarity : ctx->polarity;
+        }
+        ctx->base[GPIO_INTR_POL  ] = (ctx->base[GPIO_INTR_POL] & ~mask) | (rising & mask);
+        ctx->base[GPIO_INTR_LEVEL] = ctx->base[GPIO_INTR_LEVEL] | mask;
+        ctx->base[GPIO_INTR_CLEAR] = mask;
+        ctx->capture.pins |= mask;
+        enBits |= mask;
+    }
+    ctx->base[GPIO_INTR_EN] = enBits;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Read captured edges
+// - Copies up to count of the oldest events to events, in order.
+// - Returns the number copied, or ERR_WRONGMODE if capture has not been started.
+HpsErr_t HPS_GPIO_readCapture(HPSGPIOCtx_t* ctx, HPSGPIOCapture_t* events, unsigned int count) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!events) return ERR_NULLPTR;
+    if (!ctx->capture.enabled) return ERR_WRONGMODE;
+    //Only the ISR moves the head, and only we move the tail
+    unsigned int tail = ctx->capture.tail;
+    unsigned int avail = ctx->capture.head - tail;
+    if (count > avail) count = avail;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        events[idx] = ctx->capture.buf[(tail + idx) & ctx->capture.mask];
+    }
+    ctx->capture.tail = tail + count;
+    return count;
+}
+
+//Get lost capture count
+// - Returns the number of events lost as the buffer was full, and resets it.
+HpsErr_t HPS_GPIO_captureLost(HPSGPIOCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    unsigned int lost = ctx->capture.lost;
+    ctx->capture.lost = 0;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return (HpsErr_t)lost;
+}
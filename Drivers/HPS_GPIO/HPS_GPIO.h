@@ -10,6 +10,40 @@
  * For Arria 10, The GPIO banks are 24bit wide, so in
  * the pin bit masks, bits 0-23 only are used.
  *
+ * The controller has no set/clear registers, so output changes
+ * are a read-modify-write of the data register. The output APIs
+ * mask interrupts around this so that updates from an ISR to
+ * other pins in the bank are not lost. HPS_GPIO_updateOutput()
+ * sets and clears pins in a single write.
+ *
+ * For bit-banged protocols, the unchecked fast path accessors
+ * in Util/driver_gpio.h can be used with ctx->gpio, e.g.:
+ *
+ *    GpioFast_t* fast = GPIO_getFast(&ctx->gpio);
+ *    GPIO_fastSet(fast, _BV(9));
+ *
+ * Edge Capture
+ * ------------
+ *
+ * Input edges can be captured into a ring buffer from the GPIO
+ * interrupt, each with the pin, the edge, and the lower word of
+ * the ARM global timer as a timestamp:
+ *
+ *    HPS_GPIO_startCapture(gpio, IRQ_GPIO1, events, 64);
+ *    HPS_GPIO_setCapture(gpio, GPIO_CAPTURE_BOTH, ENC_A | ENC_B);
+ *    ...
+ *    count = HPS_GPIO_readCapture(gpio, batch, 16);
+ *
+ * The controller can only interrupt on one edge of a pin, so for
+ * capturing both edges the polarity is swapped after each one. If
+ * a pin changes twice before the interrupt is handled, the edges
+ * are missed. Events which don't fit in the buffer are counted as
+ * lost. Timestamps are global timer ticks (see Util/profile.h for
+ * the rate), and wrap, so use the unsigned difference of two.
+ *
+ * Capture claims the GPIO interrupt for this bank. The interrupt
+ * configuration APIs must not be used for captured pins.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -17,6 +51,8 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add timestamped edge capture
+ *            | Add atomic bit set/clear and fast path
  * 30/12/2023 | Creation of driver
  *
  */
@@ -28,6 +64,7 @@
 #include "Util/driver_ctx.h"
 #include "Util/bit_helpers.h"
 #include "Util/driver_gpio.h"
+#include "HPS_IRQ/HPS_IRQ.h"
 
 //Modes for interrupts
 typedef enum {
@@ -43,6 +80,21 @@ typedef enum {
     GPIO_IRQ_EDGE_RISING  = GPIO_IRQ_ENBL_FLAG | GPIO_IRQ_EDGE_FLAG | GPIO_IRQ_POLR_FLAG
 } GPIOIRQPolarity;
 
+//Edges for capture
+typedef enum {
+    GPIO_CAPTURE_NONE    = 0,
+    GPIO_CAPTURE_RISING  = _BV(0),
+    GPIO_CAPTURE_FALLING = _BV(1),
+    GPIO_CAPTURE_BOTH    = GPIO_CAPTURE_RISING | GPIO_CAPTURE_FALLING
+} GPIOCaptureEdge;
+
+//Captured edge
+typedef struct {
+    uint32_t timestamp;  // Global timer ticks (lower word)
+    uint8_t  pin;
+    uint8_t  edge;       // GPIO_CAPTURE_RISING or GPIO_CAPTURE_FALLING
+} HPSGPIOCapture_t;
+
 // Driver context
 typedef struct {
     //Header
@@ -53,6 +105,18 @@ typedef struct {
     unsigned int initDir;
     unsigned int polarity;
     GpioCtx_t gpio;
+    // Edge capture
+    struct {
+        bool enabled;
+        HPSIRQSource irqID;
+        unsigned int pins;      // Pins being captured
+        unsigned int both;      // Pins capturing both edges
+        HPSGPIOCapture_t* buf;
+        unsigned int mask;      // Buffer size - 1
+        volatile unsigned int head;
+        volatile unsigned int tail;
+        volatile unsigned int lost;
+    } capture;
 } HPSGPIOCtx_t;
 
 //Initialise HPS GPIO Driver
@@ -80,17 +144,33 @@ HpsErr_t HPS_GPIO_getDirection(HPSGPIOCtx_t* ctx, unsigned int *dir, unsigned in
 //Set output value
 // - Sets or clears the output value of masked pins.
 // - Will perform read-modify-write such that only pins with
-//   their mask bit set will be changed.
+//   their mask bit set will be changed. Interrupts are masked
+//   during the read-modify-write.
 // - e.g. with mask of 0x00010002, pins [1] and [16] will be changed.
 HpsErr_t HPS_GPIO_setOutput(HPSGPIOCtx_t* ctx, unsigned int port, unsigned int mask);
 
 //Toggle output value
 // - Toggles the output value of masked pins.
 // - Will perform read-modify-write such that only pins with
-//   their mask bit set will be toggled.
+//   their mask bit set will be toggled. Interrupts are masked
+//   during the read-modify-write.
 // - e.g. with mask of 0x00010002, pins [1] and [16] will be changed.
 HpsErr_t HPS_GPIO_toggleOutput(HPSGPIOCtx_t* ctx, unsigned int mask);
 
+//Set output bits
+// - Sets the output value of masked pins.
+HpsErr_t HPS_GPIO_bitsetOutput(HPSGPIOCtx_t* ctx, unsigned int mask);
+
+//Clear output bits
+// - Clears the output value of masked pins.
+HpsErr_t HPS_GPIO_bitclearOutput(HPSGPIOCtx_t* ctx, unsigned int mask);
+
+//Update output bits
+// - Sets the output value of pins in set, and clears those in
+//   clear, with a single write to the output register.
+// - If a pin is in both, it is set.
+HpsErr_t HPS_GPIO_updateOutput(HPSGPIOCtx_t* ctx, unsigned int set, unsigned int clear);
+
 //Get output value
 // - Returns the current value of the masked output pins to *port
 HpsErr_t HPS_GPIO_getOutput(HPSGPIOCtx_t* ctx, unsigned int* port, unsigned int mask);
@@ -123,5 +203,33 @@ HpsErr_t HPS_GPIO_clearInterruptFlags(HPSGPIOCtx_t* ctx, unsigned int mask);
 // - e.g. with mask of 0x00010002, pins [1] and [16] will be changed.
 HpsErr_t HPS_GPIO_setDebounce(HPSGPIOCtx_t* ctx, unsigned int bounce, unsigned int mask);
 
+//Start edge capture
+// - irqID is the interrupt of this GPIO bank (e.g. IRQ_GPIO1).
+// - buf is the ring buffer for size events. size must be a power of two.
+// - No pins are captured until set with HPS_GPIO_setCapture().
+// - Requires HPS_IRQ to be initialised. Starts the global timer if not running.
+// - Returns ERR_BUSY if already started.
+HpsErr_t HPS_GPIO_startCapture(HPSGPIOCtx_t* ctx, HPSIRQSource irqID, HPSGPIOCapture_t* buf, unsigned int size);
+
+//Stop edge capture
+// - Disables interrupts for captured pins, and releases the interrupt.
+// - Returns ERR_SKIPPED if not started.
+HpsErr_t HPS_GPIO_stopCapture(HPSGPIOCtx_t* ctx);
+
+//Set captured edges
+// - Sets which edges of the masked pins are captured,
+//   GPIO_CAPTURE_NONE to stop capturing them.
+// - Returns ERR_WRONGMODE if capture has not been started.
+HpsErr_t HPS_GPIO_setCapture(HPSGPIOCtx_t* ctx, GPIOCaptureEdge edges, unsigned int mask);
+
+//Read captured edges
+// - Copies up to count of the oldest events to events, in order.
+// - Returns the number copied, or ERR_WRONGMODE if capture has not been started.
+HpsErr_t HPS_GPIO_readCapture(HPSGPIOCtx_t* ctx, HPSGPIOCapture_t* events, unsigned int count);
+
+//Get lost capture count
+// - Returns the number of events lost as the buffer was full, and resets it.
+HpsErr_t HPS_GPIO_captureLost(HPSGPIOCtx_t* ctx);
+
 
 #endif /* HPS_GPIO_H_ */
@@ -11,6 +11,7 @@
  *
  * Date       | Changes
  * -----------+-----------------------------------
+ * 14/10/2026 | Add interrupt driven transaction queue
  * 30/12/2023 | Switch to new driver context model
  *            | Add support for reading data
  *            | Change behaviour to non-blocking
@@ -23,6 +24,7 @@
 #include "HPS_I2C.h"
 #include "HPS_Watchdog/HPS_Watchdog.h"
 #include "Util/bit_helpers.h"
+#include "Util/macros.h"
 
 // Registers in I2C controller
 #define HPS_I2C_CON	    (0x00/sizeof(unsigned int))
@@ -33,9 +35,15 @@
 #define HPS_I2C_FSHCNT  (0x1C/sizeof(unsigned int))
 #define HPS_I2C_FSLCNT  (0x20/sizeof(unsigned int))
 #define HPS_I2C_IRQFLG  (0x2C/sizeof(unsigned int))
+#define HPS_I2C_IRQMASK (0x30/sizeof(unsigned int))
+#define HPS_I2C_RXTL    (0x38/sizeof(unsigned int))
+#define HPS_I2C_TXTL    (0x3C/sizeof(unsigned int))
+#define HPS_I2C_CLRIRQS (0x40/sizeof(unsigned int))
+#define HPS_I2C_CLRRXOV (0x48/sizeof(unsigned int))
 #define HPS_I2C_CLRRDRQ (0x50/sizeof(unsigned int))
 #define HPS_I2C_CLRTXA  (0x54/sizeof(unsigned int))
 #define HPS_I2C_CLRRXD  (0x58/sizeof(unsigned int))
+#define HPS_I2C_CLRSTOP (0x60/sizeof(unsigned int))
 #define HPS_I2C_ENABLE  (0x6C/sizeof(unsigned int))
 #define HPS_I2C_STATUS  (0x70/sizeof(unsigned int))
 #define HPS_I2C_TXFILL  (0x74/sizeof(unsigned int))
@@ -43,9 +51,16 @@
 #define HPS_I2C_TXABTSC (0x80/sizeof(unsigned int))
 
 // IRQ flags
+#define HPS_I2C_IRQFLAG_STOPDET  9
 #define HPS_I2C_IRQFLAG_ACTIVITY 8
 #define HPS_I2C_IRQFLAG_RXDONE   7
 #define HPS_I2C_IRQFLAG_TXABORT  6
+#define HPS_I2C_IRQFLAG_TXEMPTY  4
+#define HPS_I2C_IRQFLAG_RXFULL   2
+#define HPS_I2C_IRQFLAG_RXOVER   1
+
+// IRQ mask at reset, used by the polled read/write
+#define HPS_I2C_IRQMASK_DEFAULT  0x8FF
 
 // Status flags
 #define HPS_I2C_STATUS_TXEMPTY 2
@@ -82,12 +97,235 @@ enum {
  * Internal Functions
  */
 
+//Discard anything left in the RX FIFO
+static void _HPS_I2C_flushRx(HPSI2CCtx_t* ctx) {
+    unsigned int fifoFill = ctx->base[HPS_I2C_RXFILL];
+    while (fifoFill--) {
+        (ctx->base[HPS_I2C_DATCMD]);
+    }
+}
+
+//Progress the running transaction
+// - Drains the RX FIFO and tops up the TX FIFO, then sets which interrupts are
+//   needed to continue.
+// - Read commands in flight are limited so that the RX FIFO can't overflow.
+// - Must be called with IRQs masked.
+static void _HPS_I2C_queueService(HPSI2CCtx_t* ctx, HPSI2CTransaction_t* xact) {
+    volatile unsigned int* base = ctx->base;
+    unsigned int total = xact->txLen + xact->rxLen;
+    //Drain the RX FIFO
+    unsigned int fifoFill = base[HPS_I2C_RXFILL];
+    while (fifoFill-- && (xact->received < xact->rxLen)) {
+        xact->rx[xact->received++] = (uint8_t)base[HPS_I2C_DATCMD];
+    }
+    //Top up the TX FIFO
+    unsigned int space = HPS_I2C_FIFOSPACE - base[HPS_I2C_TXFILL];
+    bool blocked = false;
+    while (space && (xact->sent < total)) {
+        unsigned int idx = xact->sent;
+        unsigned int datcmd;
+        if (idx < xact->txLen) {
+            datcmd = xact->tx[idx];
+        } else {
+            if (((idx - xact->txLen) - xact->received) >= HPS_I2C_FIFOSPACE) {
+                blocked = true;
+                break;
+            }
+            datcmd = _BV(HPS_I2C_DATACMD_READ);
+            if (xact->txLen && (idx == xact->txLen)) datcmd |= _BV(HPS_I2C_DATACMD_RESTART);
+        }
+        //Must set the stop bit in the last word
+        if (idx == (total - 1)) datcmd |= _BV(HPS_I2C_DATACMD_STOP);
+        base[HPS_I2C_DATCMD] = datcmd;
+        xact->sent++;
+        space--;
+    }
+    //Interrupt when more data has arrived, or there is space to send more. If the
+    //RX FIFO is what is holding up sending, wait for that rather than the TX FIFO.
+    //The transaction is done once the stop condition has been sent.
+    unsigned int mask = _BV(HPS_I2C_IRQFLAG_TXABORT) | _BV(HPS_I2C_IRQFLAG_STOPDET) | _BV(HPS_I2C_IRQFLAG_RXOVER);
+    unsigned int readsSent = (xact->sent > xact->txLen) ? (xact->sent - xact->txLen) : 0;
+    unsigned int inFlight = readsSent - xact->received;
+    if (inFlight) {
+        base[HPS_I2C_RXTL] = min(inFlight, HPS_I2C_FIFOSPACE / 2) - 1;
+        mask |= _BV(HPS_I2C_IRQFLAG_RXFULL);
+    }
+    if ((xact->sent < total) && !blocked) {
+        mask |= _BV(HPS_I2C_IRQFLAG_TXEMPTY);
+    }
+    base[HPS_I2C_IRQMASK] = mask;
+}
+
+//Start the transaction at the head of the queue
+// - Must be called with IRQs masked.
+static void _HPS_I2C_queueStart(HPSI2CCtx_t* ctx, HPSI2CTransaction_t* xact) {
+    volatile unsigned int* base = ctx->base;
+    base[HPS_I2C_IRQMASK] = 0;
+    _HPS_I2C_flushRx(ctx);
+    (base[HPS_I2C_CLRIRQS]);
+    base[HPS_I2C_TAR] = xact->address; //Load the target address as 7bit address in master mode
+    //Interrupt when the TX FIFO is half empty
+    base[HPS_I2C_TXTL] = HPS_I2C_FIFOSPACE / 2;
+    xact->sent = 0;
+    xact->received = 0;
+    ctx->queue.active = true;
+    _HPS_I2C_queueService(ctx, xact);
+}
+
+//Stop the running transaction, and remove it from the queue
+// - Aborts the transfer if it failed part way through.
+// - Calls the callback with the result.
+// - Must be called with IRQs masked.
+static void _HPS_I2C_queuePop(HPSI2CCtx_t* ctx, HpsErr_t result) {
+    volatile unsigned int* base = ctx->base;
+    base[HPS_I2C_IRQMASK] = 0;
+    if (ctx->queue.active && ERR_IS_ERROR(result) &&
+        ((base[HPS_I2C_STATUS] & _BV(HPS_I2C_STATUS_MASBUSY)) || base[HPS_I2C_TXFILL])) {
+        base[HPS_I2C_ENABLE] = _BV(HPS_I2C_ENABLE_ABORT) | _BV(HPS_I2C_ENABLE_I2CEN);
+        while(base[HPS_I2C_ENABLE] & _BV(HPS_I2C_ENABLE_ABORT));
+    }
+    _HPS_I2C_flushRx(ctx);
+    (base[HPS_I2C_CLRIRQS]);
+    ctx->queue.active = false;
+    //Remove from the queue before the callback, so that it may queue more
+    HPSI2CTransaction_t* xact = ctx->queue.head;
+    if (!xact) return;
+    ctx->queue.head = xact->next;
+    if (!ctx->queue.head) ctx->queue.tail = NULL;
+    xact->next = NULL;
+    if (xact->callback) xact->callback(xact, result, xact->param);
+}
+
+//Start the next queued transaction if idle
+// - Must be called with IRQs masked.
+static void _HPS_I2C_queueNext(HPSI2CCtx_t* ctx) {
+    if (ctx->queue.head && !ctx->queue.active) {
+        _HPS_I2C_queueStart(ctx, ctx->queue.head);
+    }
+}
+
+//Transaction queue interrupt handler
+static __irq void _HPS_I2C_queueIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    HPSI2CCtx_t* ctx = (HPSI2CCtx_t*)param;
+    if (!ctx) return;
+    unsigned int irqs = ctx->base[HPS_I2C_IRQFLG];
+    if (!irqs) return;
+    *handled = true;
+    if (!ctx->queue.active) {
+        ctx->base[HPS_I2C_IRQMASK] = 0;
+        return;
+    }
+    //Slave didn't acknowledge, or arbitration lost. The controller has already stopped.
+    if (irqs & _BV(HPS_I2C_IRQFLAG_TXABORT)) {
+        ctx->abtStatus = ctx->base[HPS_I2C_TXABTSC];
+        (ctx->base[HPS_I2C_CLRTXA]);
+        _HPS_I2C_queuePop(ctx, ERR_ABORTED);
+        _HPS_I2C_queueNext(ctx);
+        return;
+    }
+    //Received data was lost
+    if (irqs & _BV(HPS_I2C_IRQFLAG_RXOVER)) {
+        (ctx->base[HPS_I2C_CLRRXOV]);
+        _HPS_I2C_queuePop(ctx, ERR_IOFAIL);
+        _HPS_I2C_queueNext(ctx);
+        return;
+    }
+    HPSI2CTransaction_t* xact = ctx->queue.head;
+    _HPS_I2C_queueService(ctx, xact);
+    //Done once the stop condition has been sent
+    if (irqs & _BV(HPS_I2C_IRQFLAG_STOPDET)) {
+        (ctx->base[HPS_I2C_CLRSTOP]);
+        bool done = (xact->sent >= (xact->txLen + xact->rxLen)) && (xact->received >= xact->rxLen);
+        _HPS_I2C_queuePop(ctx, done ? ERR_SUCCESS : ERR_IOFAIL);
+        _HPS_I2C_queueNext(ctx);
+    }
+}
+
+//Stop the transaction queue
+// - Aborts running and queued transactions.
+static void _HPS_I2C_stopQueue(HPSI2CCtx_t* ctx) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    ctx->queue.enabled = false;
+    while (ctx->queue.head) {
+        _HPS_I2C_queuePop(ctx, ERR_ABORTED);
+    }
+    //Make sure stopped if no transaction was running
+    _HPS_I2C_queuePop(ctx, ERR_ABORTED);
+    ctx->writeQueued = false;
+    ctx->readQueued = false;
+    //Back to the mask the polled APIs expect
+    ctx->base[HPS_I2C_IRQMASK] = HPS_I2C_IRQMASK_DEFAULT;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    HPS_IRQ_unregisterHandler(ctx->queue.irqID);
+}
+
+//Completion of a read or write made through the queue
+static void _HPS_I2C_polledDone(HPSI2CTransaction_t* xact, HpsErr_t result, void* param) {
+    HPSI2CCtx_t* ctx = (HPSI2CCtx_t*)param;
+    ctx->polled.result = result;
+}
+
+//Queue a read or write
+// - Data is copied, so the caller's buffer need not remain valid.
+static HpsErr_t _HPS_I2C_polledStart(HPSI2CCtx_t* ctx, unsigned short address, const unsigned char writeData[], unsigned int writeLen, unsigned int readLen) {
+    HPSI2CTransaction_t* xact = &ctx->polled.xact;
+    for (unsigned int idx = 0; idx < writeLen; idx++) {
+        ctx->polled.tx[idx] = writeData[idx];
+    }
+    xact->address = address;
+    xact->tx = ctx->polled.tx;
+    xact->txLen = writeLen;
+    xact->rx = ctx->polled.rx;
+    xact->rxLen = readLen;
+    xact->callback = &_HPS_I2C_polledDone;
+    xact->param = ctx;
+    ctx->polled.result = ERR_AGAIN;
+    if (readLen) {
+        ctx->readQueued = true;
+        ctx->readLength = readLen;
+    } else {
+        ctx->writeQueued = true;
+        ctx->writeLength = writeLen;
+    }
+    HpsErr_t status = HPS_I2C_queueTransaction(ctx, xact);
+    if (ERR_IS_ERROR(status)) {
+        ctx->readQueued = false;
+        ctx->writeQueued = false;
+        return status;
+    }
+    return ERR_AGAIN;
+}
+
+//Check if a read or write made through the queue is complete
+static HpsErr_t _HPS_I2C_polledResult(HPSI2CCtx_t* ctx, unsigned char data[], unsigned int dataLen) {
+    HpsErr_t result = ctx->polled.result;
+    if (result == ERR_AGAIN) return ERR_AGAIN;
+    if (ctx->readQueued) {
+        unsigned int readLen = ctx->readLength;
+        if (ERR_IS_SUCCESS(result)) {
+            for (unsigned int idx = 0; (idx < readLen) && (idx < dataLen) && data; idx++) {
+                data[idx] = ctx->polled.rx[idx];
+            }
+            result = readLen;
+        }
+        ctx->readQueued = false;
+    } else {
+        if (ERR_IS_SUCCESS(result)) result = ctx->writeLength;
+        ctx->writeQueued = false;
+    }
+    return result;
+}
+
 //Check if write complete
 static HpsErr_t _HPS_I2C_writeCheckResult(HPSI2CCtx_t* ctx) {
     //Check if there is a write queued
     if (!ctx->writeQueued) {
         return ERR_NOTFOUND; //Nothing running
     }
+    //Made through the transaction queue
+    if (ctx->queue.enabled) {
+        return _HPS_I2C_polledResult(ctx, NULL, 0);
+    }
     //Check for a TX abort IRQ
     if (ctx->base[HPS_I2C_IRQFLG] & _BV(HPS_I2C_IRQFLAG_TXABORT)){
         ctx->abtStatus = ctx->base[HPS_I2C_TXABTSC];
@@ -111,6 +349,10 @@ static HpsErr_t _HPS_I2C_readCheckResult(HPSI2CCtx_t* ctx, unsigned char data[],
     if (!ctx->readQueued) {
         return ERR_NOTFOUND; //Nothing running
     }
+    //Made through the transaction queue
+    if (ctx->queue.enabled) {
+        return _HPS_I2C_polledResult(ctx, data, dataLen);
+    }
     //Check for a TX abort IRQ
     if (ctx->base[HPS_I2C_IRQFLG] & _BV(HPS_I2C_IRQFLAG_TXABORT)){
         (ctx->base[HPS_I2C_CLRTXA]); //Clear TX abort flag.
@@ -142,6 +384,10 @@ static HpsErr_t _HPS_I2C_readCheckResult(HPSI2CCtx_t* ctx, unsigned char data[],
 }
 
 static void _HPS_I2C_cleanup(HPSI2CCtx_t* ctx) {
+    //Stop the transaction queue
+    if (ctx->queue.enabled) {
+        _HPS_I2C_stopQueue(ctx);
+    }
     //Disable the I2C controller.
     if (ctx->base) {
         ctx->base[HPS_I2C_ENABLE] = 0x0;
@@ -198,10 +444,12 @@ bool HPS_I2C_isInitialised(HPSI2CCtx_t* ctx){
 
 //Abort a pending read or write
 // - Aborts read if isRead, otherwise aborts write
+// - Returns ERR_BUSY if the queue is started, as queued reads/writes can't be aborted.
 HpsErr_t HPS_I2C_abort(HPSI2CCtx_t* ctx, bool isRead) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    if (ctx->queue.enabled) return (ctx->writeQueued || ctx->readQueued) ? ERR_BUSY : ERR_NOTFOUND;
     //Check if anything to abort
     if (isRead && !ctx->readQueued) return ctx->writeQueued ? ERR_BUSY : ERR_NOTFOUND;
     else if (!isRead && !ctx->writeQueued) return ctx->readQueued ? ERR_BUSY : ERR_NOTFOUND;
@@ -260,9 +508,14 @@ HpsErr_t HPS_I2C_write(HPSI2CCtx_t* ctx, unsigned short address, const unsigned
     }
     //Check if busy
     if (ctx->writeQueued || ctx->readQueued) return ERR_BUSY;
-    if (ctx->base[HPS_I2C_STATUS] & _BV(HPS_I2C_STATUS_MASBUSY)) return ERR_BUSY; //I2C master busy
     //Ensure arguments are valid
     if (!data) return ERR_NULLPTR;   //Empty array
+    //If the queue is running, the bus is shared so queue the write behind anything else
+    if (ctx->queue.enabled) {
+        if (length > HPS_I2C_FIFOSPACE) return ERR_NOSPACE;
+        return _HPS_I2C_polledStart(ctx, address, data, length, 0);
+    }
+    if (ctx->base[HPS_I2C_STATUS] & _BV(HPS_I2C_STATUS_MASBUSY)) return ERR_BUSY; //I2C master busy
     //Validate that there is space for the write request
     unsigned int txFifoSpace = (HPS_I2C_FIFOSPACE - ctx->base[HPS_I2C_TXFILL]);
     if (length > txFifoSpace) return ERR_NOSPACE; //Transfer too long. FIFO has space for 64 data words. Could add throttling later.
@@ -303,11 +556,16 @@ HpsErr_t HPS_I2C_read(HPSI2CCtx_t* ctx, unsigned short address, const unsigned c
     }
     //Check if busy
     if (ctx->writeQueued || ctx->readQueued) return ERR_BUSY;
-    if (ctx->base[HPS_I2C_STATUS] & _BV(HPS_I2C_STATUS_MASBUSY)) return ERR_BUSY; //I2C master busy
     //Ensure arguments are valid
     if (!writeData) return ERR_NULLPTR; //Empty array
     //Validate there is space for the read request
     if (!readLen) return ERR_TOOSMALL; //Transfer too short. Must have a read length of at least 1
+    //If the queue is running, the bus is shared so queue the read behind anything else
+    if (ctx->queue.enabled) {
+        if ((writeLen + readLen) > HPS_I2C_FIFOSPACE) return ERR_NOSPACE;
+        return _HPS_I2C_polledStart(ctx, address, writeData, writeLen, readLen);
+    }
+    if (ctx->base[HPS_I2C_STATUS] & _BV(HPS_I2C_STATUS_MASBUSY)) return ERR_BUSY; //I2C master busy
     unsigned int txFifoSpace = (HPS_I2C_FIFOSPACE - ctx->base[HPS_I2C_TXFILL]);
     unsigned int rxFifoSpace = (HPS_I2C_FIFOSPACE - ctx->base[HPS_I2C_RXFILL]);
     if ((writeLen + readLen) > txFifoSpace) return ERR_NOSPACE; //Transfer too long. FIFO has space for 64 data/cmd words. Could add throttling later.
@@ -338,3 +596,78 @@ HpsErr_t HPS_I2C_read(HPSI2CCtx_t* ctx, unsigned short address, const unsigned c
     //And done. Check if we succeeded
     return _HPS_I2C_readCheckResult(ctx, readData, readLen);
 }
+
+//Start the transaction queue
+// - irqID is the interrupt of this I2C controller (e.g. IRQ_I2C0).
+// - Requires HPS_IRQ to be initialised.
+// - Returns ERR_BUSY if a read or write is still running, or already started.
+HpsErr_t HPS_I2C_startQueue(HPSI2CCtx_t* ctx, HPSIRQSource irqID) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't be busy, which includes already started
+    if (ctx->queue.enabled || ctx->writeQueued || ctx->readQueued) return ERR_BUSY;
+    if (ctx->base[HPS_I2C_STATUS] & _BV(HPS_I2C_STATUS_MASBUSY)) return ERR_BUSY;
+    //Register the interrupt handler
+    ctx->base[HPS_I2C_IRQMASK] = 0;
+    status = HPS_IRQ_registerHandler(irqID, &_HPS_I2C_queueIsr, ctx);
+    if (ERR_IS_ERROR(status)) {
+        ctx->base[HPS_I2C_IRQMASK] = HPS_I2C_IRQMASK_DEFAULT;
+        return status;
+    }
+    ctx->queue.irqID = irqID;
+    ctx->queue.active = false;
+    ctx->queue.head = NULL;
+    ctx->queue.tail = NULL;
+    ctx->queue.enabled = true;
+    return ERR_SUCCESS;
+}
+
+//Stop the transaction queue
+// - Any running or queued transactions are aborted, with their callbacks
+//   called with ERR_ABORTED.
+// - Returns ERR_SKIPPED if not started.
+HpsErr_t HPS_I2C_stopQueue(HPSI2CCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->queue.enabled) return ERR_SKIPPED;
+    _HPS_I2C_stopQueue(ctx);
+    return ERR_SUCCESS;
+}
+
+//Queue a transaction
+// - The transaction is started immediately if the queue is idle, otherwise once
+//   those before it are done. It must remain valid until done.
+// - Returns ERR_WRONGMODE if the queue has not been started.
+HpsErr_t HPS_I2C_queueTransaction(HPSI2CCtx_t* ctx, HPSI2CTransaction_t* xact) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!xact) return ERR_NULLPTR;
+    if (!ctx->queue.enabled) return ERR_WRONGMODE;
+    if (!xact->txLen && !xact->rxLen) return ERR_TOOSMALL;
+    if ((xact->txLen && !xact->tx) || (xact->rxLen && !xact->rx)) return ERR_NULLPTR;
+    //Add to the queue, starting if idle
+    xact->next = NULL;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (ctx->queue.tail) {
+        ctx->queue.tail->next = xact;
+    } else {
+        ctx->queue.head = xact;
+    }
+    ctx->queue.tail = xact;
+    _HPS_I2C_queueNext(ctx);
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Check if the transaction queue is idle
+// - Returns ERR_SUCCESS if all queued transactions are done.
+// - Returns ERR_BUSY if any are queued or running.
+HpsErr_t HPS_I2C_queueIdle(HPSI2CCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return ctx->queue.head ? ERR_BUSY : ERR_SUCCESS;
+}
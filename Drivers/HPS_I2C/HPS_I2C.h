@@ -4,6 +4,31 @@
  *
  * Driver for the HPS embedded I2C controller
  *
+ * Transaction Queue
+ * -----------------
+ *
+ * The read and write APIs are non-blocking, but need to be polled
+ * until the transfer completes. Transactions can instead be queued
+ * and run back-to-back from the I2C interrupt. Start the queue with
+ * HPS_I2C_startQueue(), which registers the I2C interrupt with
+ * HPS_IRQ, then queue HPSI2CTransaction_t entries with
+ * HPS_I2C_queueTransaction(). Each entry writes txLen bytes to the
+ * slave, then if rxLen is non-zero restarts and reads rxLen bytes.
+ * The entries are owned by the caller, and must remain valid until
+ * their callback has been called (or HPS_I2C_queueIdle() returns
+ * success).
+ *
+ * The FIFO is refilled from the interrupt, so transactions are not
+ * limited to the FIFO size. The optional callback is called from the
+ * I2C interrupt once the transaction is done, and may queue further
+ * transactions. If the slave doesn't acknowledge, the callback is
+ * given ERR_ABORTED and HPS_I2C_abortStatus() returns the reason.
+ *
+ * While the queue is started, the polled read and write APIs (and so
+ * drivers using the generic I2C interface) still work, with each call
+ * queued as a transaction behind any others. They are limited to the
+ * FIFO size as before, and can't be aborted once queued.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -11,6 +36,7 @@
  *
  * Date       | Changes
  * -----------+-----------------------------------
+ * 14/10/2026 | Add interrupt driven transaction queue
  * 30/12/2023 | Switch to new driver context model
  *            | Add support for reading data
  *            | Change behaviour to non-blocking
@@ -24,8 +50,37 @@
 #define HPS_I2C_H_
 
 #include "Util/driver_i2c.h"
+#include <stdint.h>
 #include <stdbool.h>
 
+#include "HPS_IRQ/HPS_IRQ.h"
+
+//Max space in FIFO for read/write
+#define HPS_I2C_FIFOSPACE 64
+
+// Queued transaction
+typedef struct _HPSI2CTransaction_t HPSI2CTransaction_t;
+
+// Transaction completion callback
+//  - result is ERR_SUCCESS if the transaction completed, or an error code if it
+//    failed or was aborted. param is the value from the transaction.
+typedef void (*HPSI2CTransactionCallback_t)(HPSI2CTransaction_t* xact, HpsErr_t result, void* param);
+
+struct _HPSI2CTransaction_t {
+    // Set by user
+    unsigned short              address;    // 7bit I2C slave device address
+    const uint8_t*              tx;         // Data to write
+    unsigned int                txLen;      // Number of bytes to write
+    uint8_t*                    rx;         // Where to store read data
+    unsigned int                rxLen;      // Number of bytes to read after writing, or 0 for write only
+    HPSI2CTransactionCallback_t callback;   // Optional completion callback
+    void*                       param;      // Parameter for the callback
+    // Internal
+    struct _HPSI2CTransaction_t* next;
+    unsigned int                 sent;      // Commands loaded into the FIFO
+    unsigned int                 received;
+};
+
 // Driver context
 typedef struct {
     // Context Header
@@ -40,11 +95,23 @@ typedef struct {
     bool readQueued;
     unsigned int readLength;
     unsigned int abtStatus;
+    // Transaction Queue
+    struct {
+        bool                          enabled;
+        HPSIRQSource                  irqID;
+        bool                          active;   // Head transaction is running
+        HPSI2CTransaction_t* volatile head;
+        HPSI2CTransaction_t*          tail;
+    } queue;
+    // Read/Write through the queue
+    struct {
+        HPSI2CTransaction_t xact;
+        volatile HpsErr_t   result;
+        uint8_t             tx[HPS_I2C_FIFOSPACE];
+        uint8_t             rx[HPS_I2C_FIFOSPACE];
+    } polled;
 } HPSI2CCtx_t;
 
-//Max space in FIFO for read/write
-#define HPS_I2C_FIFOSPACE 64
-
 //Initialise HPS I2C Controller
 // - For base, DE1-SoC uses 0xFFC04000 for Accelerometer/VGA/Audio/ADC. 0xFFC05000 for LTC 14pin Hdr.
 // - Returns 0 if successful.
@@ -56,6 +123,7 @@ bool HPS_I2C_isInitialised(HPSI2CCtx_t* ctx);
 
 //Abort a pending read or write
 // - Aborts read if isRead, otherwise aborts write
+// - Returns ERR_BUSY if the queue is started, as queued reads/writes can't be aborted.
 HpsErr_t HPS_I2C_abort(HPSI2CCtx_t* ctx, bool isRead);
 
 //Returns the status flags from last abort
@@ -86,4 +154,27 @@ HpsErr_t HPS_I2C_write   (HPSI2CCtx_t* ctx, unsigned short address, const unsign
 //   - Returns number of bytes written if successful.
 HpsErr_t HPS_I2C_read(HPSI2CCtx_t* ctx, unsigned short address, const unsigned char writeData[], unsigned int writeLen, unsigned char readData[], unsigned int readLen);
 
+//Start the transaction queue
+// - irqID is the interrupt of this I2C controller (e.g. IRQ_I2C0).
+// - Requires HPS_IRQ to be initialised.
+// - Returns ERR_BUSY if a read or write is still running, or already started.
+HpsErr_t HPS_I2C_startQueue(HPSI2CCtx_t* ctx, HPSIRQSource irqID);
+
+//Stop the transaction queue
+// - Any running or queued transactions are aborted, with their callbacks
+//   called with ERR_ABORTED.
+// - Returns ERR_SKIPPED if not started.
+HpsErr_t HPS_I2C_stopQueue(HPSI2CCtx_t* ctx);
+
+//Queue a transaction
+// - The transaction is started immediately if the queue is idle, otherwise once
+//   those before it are done. It must remain valid until done.
+// - Returns ERR_WRONGMODE if the queue has not been started.
+HpsErr_t HPS_I2C_queueTransaction(HPSI2CCtx_t* ctx, HPSI2CTransaction_t* xact);
+
+//Check if the transaction queue is idle
+// - Returns ERR_SUCCESS if all queued transactions are done.
+// - Returns ERR_BUSY if any are queued or running.
+HpsErr_t HPS_I2C_queueIdle(HPSI2CCtx_t* ctx);
+
 #endif /* HPS_I2C_H_ */
@@ -0,0 +1,210 @@
+/*
+ * HPS I2C Sensor Polling Scheduler
+ * --------------------------------
+ * Description:
+ * Polls several I2C sensors on one HPS I2C bus at their own rates
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "HPS_I2CPoll.h"
+#include "Util/mem_pool.h"
+
+#include <string.h>
+
+/*
+ * Internal Functions
+ */
+
+//Transaction completion
+// - Called from the I2C interrupt. Result is delivered by I2CPoll_tick().
+static void _I2CPoll_complete( HPSI2CTransaction_t* xact, HpsErr_t result, void* param ) {
+    (void)xact;
+    I2CPollSensor_t* sensor = (I2CPollSensor_t*)param;
+    sensor->result = result;
+    sensor->done = true;
+    sensor->busy = false;
+}
+
+//Check if a tick has been reached, allowing for wrap around
+static inline bool _I2CPoll_reached( unsigned int now, unsigned int due ) {
+    return (int)(now - due) >= 0;
+}
+
+//Cleanup
+// - Transactions still queued must finish before their sensors are freed.
+static void _I2CPoll_cleanup( I2CPollCtx_t* ctx ) {
+    if (!ctx->sensors) return;
+    for (unsigned int idx = 0; idx < ctx->maxSensors; idx++) {
+        while (ctx->sensors[idx].busy);
+    }
+    MemPool_free(ctx->sensors);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the scheduler
+// - i2c must have its transaction queue started (see HPS_I2C_startQueue),
+//   otherwise returns ERR_WRONGMODE.
+// - maxSensors is the number of sensors which can be polled at once.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t I2CPoll_initialise( HPSI2CCtx_t* i2c, unsigned int maxSensors, I2CPollCtx_t** pCtx ) {
+    //Check if the I2C controller has been initialised and is queueing (required)
+    if (!HPS_I2C_isInitialised(i2c)) return ERR_BADDEVICE;
+    if (!i2c->queue.enabled) return ERR_WRONGMODE;
+    if (!maxSensors) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_I2CPoll_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    I2CPollCtx_t* ctx = *pCtx;
+    ctx->i2c = i2c;
+    ctx->now = 0;
+    ctx->maxSensors = maxSensors;
+    //Allocate sensors
+    ctx->sensors = MemPool_calloc(maxSensors, sizeof(I2CPollSensor_t));
+    if (!ctx->sensors) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool I2CPoll_isInitialised( I2CPollCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Add a sensor
+// - config is copied, so need not remain valid.
+// - Returns the sensor number (>= 0), or ERR_NOSPACE if all sensors are in use.
+HpsErr_t I2CPoll_addSensor( I2CPollCtx_t* ctx, const I2CPollSensorConfig_t* config ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!config || !config->callback) return ERR_NULLPTR;
+    if (!config->readLen || !config->period) return ERR_TOOSMALL;
+    if ((config->readLen > I2CPOLL_MAX_READ) || (config->cmdLen > I2CPOLL_MAX_CMD)) return ERR_TOOBIG;
+    //Find a free sensor. One which is still finishing a read can't be reused yet.
+    for (unsigned int idx = 0; idx < ctx->maxSensors; idx++) {
+        I2CPollSensor_t* sensor = &ctx->sensors[idx];
+        if (sensor->active || sensor->busy) continue;
+        sensor->config = *config;
+        sensor->nextDue = ctx->now + config->phase;
+        sensor->done = false;
+        sensor->stats = (I2CPollStats_t){0};
+        //Transaction is the same each time
+        sensor->xact = (HPSI2CTransaction_t){
+            .address  = config->address,
+            .tx       = sensor->config.cmd,
+            .txLen    = config->cmdLen,
+            .rx       = sensor->data,
+            .rxLen    = config->readLen,
+            .callback = &_I2CPoll_complete,
+            .param    = sensor
+        };
+        sensor->active = true;
+        return (HpsErr_t)idx;
+    }
+    return ERR_NOSPACE;
+}
+
+//Change the period of a sensor
+// - The next read is period ticks after the change.
+// - Returns ERR_NOTFOUND if the sensor is not active.
+HpsErr_t I2CPoll_setPeriod( I2CPollCtx_t* ctx, unsigned int sensor, unsigned int period ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((sensor >= ctx->maxSensors) || !ctx->sensors[sensor].active) return ERR_NOTFOUND;
+    if (!period) return ERR_TOOSMALL;
+    ctx->sensors[sensor].config.period = period;
+    ctx->sensors[sensor].nextDue = ctx->now + period;
+    return ERR_SUCCESS;
+}
+
+//Remove a sensor
+// - Returns ERR_BUSY if its read is still running. Try again later.
+// - Returns ERR_NOTFOUND if the sensor is not active.
+HpsErr_t I2CPoll_removeSensor( I2CPollCtx_t* ctx, unsigned int sensor ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((sensor >= ctx->maxSensors) || !ctx->sensors[sensor].active) return ERR_NOTFOUND;
+    if (ctx->sensors[sensor].busy) return ERR_BUSY;
+    ctx->sensors[sensor].active = false;
+    return ERR_SUCCESS;
+}
+
+//Advance the schedule by one tick
+// - Delivers the results of finished reads to their callbacks, then
+//   queues the reads which are now due.
+// - Returns the number of reads queued (>= 0), or an error code.
+HpsErr_t I2CPoll_tick( I2CPollCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Deliver results first, so each sensor's data is handed over before it is read again
+    for (unsigned int idx = 0; idx < ctx->maxSensors; idx++) {
+        I2CPollSensor_t* sensor = &ctx->sensors[idx];
+        if (!sensor->active || !sensor->done) continue;
+        sensor->done = false;
+        HpsErr_t result = sensor->result;
+        if (ERR_IS_ERROR(result)) {
+            sensor->stats.errors++;
+        } else {
+            sensor->stats.reads++;
+        }
+        sensor->config.callback(idx, result, sensor->data, sensor->config.readLen, sensor->config.param);
+    }
+    //Queue every read which is due, so they run back to back from the I2C interrupt
+    unsigned int now = ctx->now;
+    unsigned int queued = 0;
+    for (unsigned int idx = 0; idx < ctx->maxSensors; idx++) {
+        I2CPollSensor_t* sensor = &ctx->sensors[idx];
+        if (!sensor->active || !_I2CPoll_reached(now, sensor->nextDue)) continue;
+        sensor->nextDue += sensor->config.period;
+        //If we've fallen more than a period behind, resynchronise rather than catching up
+        if (_I2CPoll_reached(now, sensor->nextDue)) sensor->nextDue = now + sensor->config.period;
+        //Previous read (or its result) still outstanding
+        if (sensor->busy || sensor->done) {
+            sensor->stats.missed++;
+            continue;
+        }
+        sensor->busy = true;
+        status = HPS_I2C_queueTransaction(ctx->i2c, &sensor->xact);
+        if (ERR_IS_ERROR(status)) {
+            sensor->busy = false;
+            break;
+        }
+        queued++;
+    }
+    ctx->now = now + 1;
+    if (ERR_IS_ERROR(status)) return status;
+    return (HpsErr_t)queued;
+}
+
+//Get sensor statistics
+// - If clear is true, the counts are reset.
+// - Returns ERR_NOTFOUND if the sensor is not active.
+HpsErr_t I2CPoll_getStats( I2CPollCtx_t* ctx, unsigned int sensor, I2CPollStats_t* stats, bool clear ) {
+    if (!stats) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((sensor >= ctx->maxSensors) || !ctx->sensors[sensor].active) return ERR_NOTFOUND;
+    *stats = ctx->sensors[sensor].stats;
+    if (clear) ctx->sensors[sensor].stats = (I2CPollStats_t){0};
+    return ERR_SUCCESS;
+}
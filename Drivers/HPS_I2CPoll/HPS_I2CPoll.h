@@ -0,0 +1,157 @@
+/*
+ * HPS I2C Sensor Polling Scheduler
+ * --------------------------------
+ * Description:
+ * Polls several I2C sensors on one HPS I2C bus at their own rates
+ *
+ * Reading each sensor with its own polled HPS_I2C_read() call leaves
+ * the bus idle between reads while the main loop gets round to the next
+ * one, and blocks the main loop while each read runs. Instead, each
+ * sensor is given a register read and a period, and every tick the
+ * reads which are due are queued back to back on the HPS I2C transaction
+ * queue, so they run one after another from the I2C interrupt without
+ * gaps and without the CPU waiting.
+ *
+ * Results are delivered to each sensor's callback on the next call to
+ * I2CPoll_tick() (in the caller's context, not the interrupt), before
+ * that tick's reads are started. So a tick period at least as long as
+ * the chain of reads takes on the bus gives each result one tick later.
+ *
+ * Usage
+ * -----
+ *
+ * The HPS I2C transaction queue must already be started:
+ *
+ *    HPS_I2C_startQueue(i2c, IRQ_I2C0);
+ *    I2CPoll_initialise(i2c, 4, &poll);
+ *    I2CPoll_addSensor(poll, &(I2CPollSensorConfig_t){
+ *        .address = 0x53, .cmd = {0x32}, .cmdLen = 1, .readLen = 6,
+ *        .period = 10, .callback = &accelResult, .param = &accel
+ *    });
+ *    while (1) {
+ *        if (tickElapsed) I2CPoll_tick(poll);
+ *        ...
+ *    }
+ *
+ * Periods and phases are in ticks, so the tick rate (e.g. from a timer or
+ * a Util/event) sets the time base. If a sensor's previous read has not
+ * finished by the time it is next due, that read is skipped and counted
+ * as missed in its statistics.
+ *
+ * Sensor callbacks may not add or remove sensors.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef HPS_I2CPOLL_H_
+#define HPS_I2CPOLL_H_
+
+//Include required header files
+#include "HPS_I2C/HPS_I2C.h"
+#include "Util/driver_ctx.h"
+
+//Maximum length of the command (e.g. register address) sent before each read
+#define I2CPOLL_MAX_CMD   4
+
+//Maximum number of bytes read from each sensor
+#ifndef I2CPOLL_MAX_READ
+#define I2CPOLL_MAX_READ  32
+#endif
+
+// Result callback
+// - sensor is the number from I2CPoll_addSensor().
+// - result is ERR_SUCCESS if the read completed, or an error code.
+// - data holds the length bytes read. It is only valid during the callback.
+typedef void (*I2CPollCallback_t)(unsigned int sensor, HpsErr_t result, const uint8_t* data, unsigned int length, void* param);
+
+// Sensor settings
+typedef struct {
+    unsigned short address;             // 7bit I2C slave device address
+    uint8_t cmd[I2CPOLL_MAX_CMD];       // Written before the read, e.g. register address
+    unsigned int cmdLen;                // Number of cmd bytes, may be 0
+    unsigned int readLen;               // Number of bytes to read
+    unsigned int period;                // Ticks between reads
+    unsigned int phase;                 // Ticks until first read, to spread sensors with the same period
+    I2CPollCallback_t callback;
+    void* param;
+} I2CPollSensorConfig_t;
+
+// Sensor statistics
+typedef struct {
+    unsigned int reads;                 // Reads completed successfully
+    unsigned int errors;                // Reads which failed
+    unsigned int missed;                // Reads skipped as the previous was still running
+} I2CPollStats_t;
+
+// Polled sensor
+typedef struct {
+    bool active;
+    I2CPollSensorConfig_t config;
+    unsigned int nextDue;               // Tick of next read
+    HPSI2CTransaction_t xact;
+    volatile bool busy;                 // Queued or running
+    volatile bool done;                 // Finished, result not yet delivered
+    volatile HpsErr_t result;
+    uint8_t data[I2CPOLL_MAX_READ];
+    I2CPollStats_t stats;
+} I2CPollSensor_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    HPSI2CCtx_t* i2c;
+    unsigned int now;                   // Current tick
+    unsigned int maxSensors;
+    I2CPollSensor_t* sensors;
+} I2CPollCtx_t;
+
+//Initialise the scheduler
+// - i2c must have its transaction queue started (see HPS_I2C_startQueue),
+//   otherwise returns ERR_WRONGMODE.
+// - maxSensors is the number of sensors which can be polled at once.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t I2CPoll_initialise( HPSI2CCtx_t* i2c, unsigned int maxSensors, I2CPollCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool I2CPoll_isInitialised( I2CPollCtx_t* ctx );
+
+//Add a sensor
+// - config is copied, so need not remain valid.
+// - Returns the sensor number (>= 0), or ERR_NOSPACE if all sensors are in use.
+HpsErr_t I2CPoll_addSensor( I2CPollCtx_t* ctx, const I2CPollSensorConfig_t* config );
+
+//Change the period of a sensor
+// - The next read is period ticks after the change.
+// - Returns ERR_NOTFOUND if the sensor is not active.
+HpsErr_t I2CPoll_setPeriod( I2CPollCtx_t* ctx, unsigned int sensor, unsigned int period );
+
+//Remove a sensor
+// - Returns ERR_BUSY if its read is still running. Try again later.
+// - Returns ERR_NOTFOUND if the sensor is not active.
+HpsErr_t I2CPoll_removeSensor( I2CPollCtx_t* ctx, unsigned int sensor );
+
+//Advance the schedule by one tick
+// - Delivers the results of finished reads to their callbacks, then
+//   queues the reads which are now due.
+// - Returns the number of reads queued (>= 0), or an error code.
+HpsErr_t I2CPoll_tick( I2CPollCtx_t* ctx );
+
+//Get sensor statistics
+// - If clear is true, the counts are reset.
+// - Returns ERR_NOTFOUND if the sensor is not active.
+HpsErr_t I2CPoll_getStats( I2CPollCtx_t* ctx, unsigned int sensor, I2CPollStats_t* stats, bool clear );
+
+#endif /* HPS_I2CPOLL_H_ */
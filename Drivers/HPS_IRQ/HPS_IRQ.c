@@ -10,7 +10,7 @@
  * interrupt handlers for specific interrupt IDs.
  *
  * The driver supports both Cyclone V devices (default) or
- * Arria 10 devices (-D __ARRIA_10__).
+ * Arria 10 devices (-D __ARRIA10__).
  * 
  * ISR Handlers
  * ------------
@@ -40,9 +40,30 @@
  *    __abort void __pftcAb_isr(void){   }
  *    // Data Abort
  *    __abort void __dataAb_isr(void){   }
- *    // Fast IRQ
+ *    // Fast IRQ (requires -D HPS_IRQ_CUSTOM_FIQ, see below)
  *    __fiq   void __fiq_isr   (void){   }
  *
+ * FIQ Fast Path
+ * -------------
+ *
+ * A single interrupt source can be routed to the FIQ vector using
+ * HPS_IRQ_registerFiqHandler(). This places the source in GIC group
+ * 0 (signalled as FIQ) and all others in group 1 (signalled as IRQ).
+ * The FIQ vector provided by this driver acknowledges the interrupt
+ * and calls the handler directly, without any table lookup. As FIQ
+ * mode has banked copies of r8-r12, entry requires few registers to
+ * be saved.
+ *
+ * The FIQ handler is a plain function rather than an __irq one. It
+ * is run with both IRQs and FIQs masked, and cannot be masked by
+ * HPS_IRQ_globalEnable(false), so any data shared with the FIQ
+ * handler must be accessed carefully (e.g. single word updates).
+ *
+ * To use your own __fiq_isr implementation instead of the one in
+ * this driver, globally define:
+ *
+ *     -D HPS_IRQ_CUSTOM_FIQ
+ *
  * 
  * Software Interrupts
  * -------------------
@@ -88,6 +109,9 @@
  * processor state in SVC mode. You can decode the id in the SVC handler to
  * decide what operation to perform.
  * 
+ * Alternatively, Util/svc_dispatch provides __svc_handler as a table of
+ * handlers indexed directly by id, registered with SvcDispatch_register.
+ * 
  *
  * Company: University of Leeds
  * Author: T Carpenter
@@ -96,6 +120,16 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Batch multiple handler registration into one critical
+ *            | section with one distributor write per register.
+ * 14/10/2026 | Complete posted device writes before end of interrupt.
+ * 14/10/2026 | Add optional interrupted PC capture (HPS_IRQ_PC_SAMPLE).
+ * 14/10/2026 | Place IRQ/FIQ dispatch and handler table in on-chip RAM
+ *            | via HOT_CODE/HOT_BSS.
+ * 14/10/2026 | Add FIQ fast path for a single interrupt source.
+ * 14/10/2026 | Add interrupt priorities and nested preemptible handlers.
+ * 14/10/2026 | Use a directly indexed handler table for constant
+ *            | time interrupt dispatch.
  * 12/10/2024 | Add null-pointer checks to IRQ handler
  * 01/04/2024 | Add details about software interrupt calling convention.
  * 21/02/2024 | Fix software interrupt handler.
@@ -119,9 +153,14 @@
 #include "HPS_IRQ.h"
 
 #include "Util/lowlevel_arm.h"
+#include "Util/macros.h"
 
 #include <stdio.h>
 
+#ifdef HPS_IRQ_STATS
+#include "Util/timestamp.h"
+#endif
+
 //Default handler for unhandled interrupt callback.
 __irq void HPS_IRQ_unhandledIRQ(HPSIRQSource interruptID, void* param, bool* handled) {
     while(1); //Crash - use the watchdog timer to reset us.
@@ -150,21 +189,36 @@ __irq void HPS_IRQ_unhandledIRQ(HPSIRQSource interruptID, void* param, bool* han
 // Interrupt controller (GIC) CPU interface(s)
 #define ICCICR               (0x00/sizeof(unsigned int))  // + to CPU interface control
 #define ICCPMR               (0x04/sizeof(unsigned int))  // + to interrupt priority mask
+#define ICCBPR               (0x08/sizeof(unsigned int))  // + to binary point reg
 #define ICCIAR               (0x0C/sizeof(unsigned int))  // + to interrupt acknowledge
 #define ICCEOIR              (0x10/sizeof(unsigned int))  // + to end of interrupt reg
+#define ICCHPIR              (0x18/sizeof(unsigned int))  // + to highest pending interrupt reg
+
+#define ICCIAR_ID_MASK       0x3FF                         // Interrupt ID field of ICCIAR
+
+#define ICCICR_GROUPED       0x1F                          // Enable both groups, group 1 ack from secure, group 0 as FIQ, common binary point
+#define ICDDCR_GROUPED       0x3                           // Forward both group 0 and group 1
 
 // Interrupt (INT) controller (GIC) distributor interface(s)
 #define ICDDCR               (0x000/sizeof(unsigned int)) // + to distributor control reg
+#define ICDISR               (0x080/sizeof(unsigned int)) // + to INT security (group) regs
 #define ICDISER              (0x100/sizeof(unsigned int)) // + to INT set-enable regs
 #define ICDICER              (0x180/sizeof(unsigned int)) // + to INT clear-enable regs
+#define ICDIPR               (0x400/sizeof(unsigned int)) // + to INT priority regs
 #define ICDIPTR              (0x800/sizeof(unsigned int)) // + to INT processor targets regs
 #define ICDICFR              (0xC00/sizeof(unsigned int)) // + to INT configuration regs
+#define ICDSGIR              (0xF00/sizeof(unsigned int)) // + to software generated interrupt reg
+
+#define ICDSGIR_TARGET_OFFS  16                            // CPU target list field of ICDSGIR
+#define ICDSGIR_NSATT        (1 << 15)                     // Send SGI to group 1 sources
 
 
 #define IRQ_REG_BYTES        (sizeof(unsigned int))
 #define IRQ_REG_BYTEMASK     (IRQ_REG_BYTES - 1)
 #define IRQ_REG_BITS         (IRQ_REG_BYTES * 8)
 #define IRQ_REG_BITMASK      (IRQ_REG_BITS - 1)
+#define IRQ_REG_BANKS        (IRQ_SOURCE_COUNT / IRQ_REG_BITS)
+#define IRQ_REG_BYTES_ALL    ((1U << IRQ_REG_BYTES) - 1)
 
 /*
  * Global variables for the IRQ driver
@@ -176,29 +230,105 @@ __irq void HPS_IRQ_unhandledIRQ(HPSIRQSource interruptID, void* param, bool* han
 static bool __isInitialised = false;
 
 typedef struct {
-    HPSIRQSource interruptID; //The ID of the interrupt source this handler is for
     IsrHandlerFunc_t handler; //Function pointer to be called to handle this ID
     void* param;              //Parameters to pass to interrupt handler
     bool enabled;
+    bool preemptible;         //Whether handler runs with IRQs enabled
+    unsigned char target;     //CPU target mask for shared peripheral interrupts
 } IsrHandler_t;
 
-static unsigned int __isr_handler_count;
-static IsrHandler_t* __isr_handlers;
+//Pending distributor changes for a batch of IDs
+// - Each mask has one bit per ID, in the same layout as the set/clear enable banks.
+// - The priority and target bytes are only valid for IDs in the matching mask.
+typedef struct {
+    unsigned int enable[IRQ_REG_BANKS];
+    unsigned int disable[IRQ_REG_BANKS];
+    unsigned int setPriority[IRQ_REG_BANKS];
+    unsigned int setTarget[IRQ_REG_BANKS];
+    unsigned char priority[IRQ_SOURCE_COUNT];
+    unsigned char target[IRQ_SOURCE_COUNT];
+} IsrBatch_t;
+
+//Handler table is directly indexed by interrupt ID so that dispatch is constant time.
+static IsrHandler_t __isr_handlers[IRQ_SOURCE_COUNT] HOT_BSS;
 static IsrHandlerFunc_t __isr_unhandledIRQCallback;
 
+#ifdef HPS_IRQ_STATS
+//Handler statistics, kept apart from the handler table to keep that small.
+static HPSIRQStats_t __isr_stats[IRQ_SOURCE_COUNT];
+#endif
+
+#ifdef HPS_IRQ_PC_SAMPLE
+//Address interrupted by the latest IRQ on each core
+static volatile uintptr_t __isr_interruptedPc[SYSREG_MPIDR_MASK_CPUID + 1] HOT_BSS;
+#endif
+
+//FIQ handler. __fiq_source is IRQ_SOURCE_COUNT if no FIQ registered.
+static HPSIRQSource __fiq_source;
+static FiqHandlerFunc_t __fiq_handler;
+static void* __fiq_param;
+static bool __fiq_grouped;
+
 static volatile unsigned int* __gic_cpuif_ptr = (unsigned int *)MPCORE_GIC_CPUIF;
 static volatile unsigned int* __gic_dist_ptr  = (unsigned int *)MPCORE_GIC_DIST;
 
+/*
+ * Call a preemptible IRQ handler
+ *
+ * The handler is run in SVC mode with IRQs enabled. A nested IRQ will
+ * clobber LR_irq and SPSR_irq, so we save LR_irq here, and the outer
+ * __irq_isr restores SPSR_irq from its own copy. The SVC mode LR and
+ * SPSR are also saved in case the handler is itself pre-empted by a
+ * preemptible handler.
+ *
+ * Arguments are passed straight through to the handler in r0-r2, with
+ * the handler address in r3. Must be called from IRQ mode.
+ */
+
+static void __attribute__((naked)) HOT_CODE _HPS_IRQ_callPreemptible(HPSIRQSource interruptID, void* param, bool* handled, IsrHandlerFunc_t handler) {
+    __asm volatile (
+        // Save the return address to the IRQ stack. r4 is used to hold SPSR_svc.
+        "PUSH    {r4, LR}                      \n"
+        // Switch to SVC mode, still with IRQs masked
+        "CPS     %[SvcMode]                    \n"
+        // Save SPSR_svc and LR_svc, ensuring SVC stack is 8-byte aligned for the handler.
+        // r5 is pushed only to keep the frame a multiple of 8 bytes.
+        "MRS     r4, SPSR                      \n"
+        "MOV     r12, SP                       \n"
+        "AND     r12, r12, #4                  \n"
+        "SUB     SP, SP, r12                   \n"
+        "PUSH    {r4, r5, r12, LR}             \n"
+        // Enable IRQs. Handlers may restore CPSR from SPSR on return, so make sure
+        // the SPSR holds the current state.
+        "CPSIE   i                             \n"
+        "MRS     r4, CPSR                      \n"
+        "MSR     SPSR_cxsf, r4                 \n"
+        // Call the handler
+        "BLX     r3                            \n"
+        // Mask IRQs again, and restore SVC state
+        "CPSID   i                             \n"
+        "POP     {r4, r5, r12, LR}             \n"
+        "ADD     SP, SP, r12                   \n"
+        "MSR     SPSR_cxsf, r4                 \n"
+        // Return to IRQ mode, and then to caller
+        "CPS     %[IrqMode]                    \n"
+        "POP     {r4, PC}                      \n"
+        ::
+        [SvcMode] "i" (PROC_STATE_SVC),
+        [IrqMode] "i" (PROC_STATE_IRQ)
+    );
+}
+
 /*
  * Next we need our interrupt service routine for IRQs
  *
- * This will check the interrupt id against all registered handlers
- * and cause an unhandledIRQCallback call if it is an unhandled interrupt
+ * This will look up the interrupt id in the handler table and cause
+ * an unhandledIRQCallback call if it is an unhandled interrupt
  */
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wextra"
-__irq void __irq_isr (void) {
+HOT_CODE __irq void __irq_isr (void) {
     // If not initialised, jump to default ISR handler.
     if (!__isInitialised) {
         __BRANCH(__default_isr);
@@ -206,29 +336,52 @@ __irq void __irq_isr (void) {
     // Backup the SPSR from the caller as we will clobber this when calling
     // the IRQ handlers.
     unsigned int spsr = __GET_PROC_SPSR();
+#ifdef HPS_IRQ_PC_SAMPLE
+    // The IRQ returns to the instruction it interrupted
+    __isr_interruptedPc[__GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID] = (uintptr_t)__builtin_return_address(0);
+#endif
     // Otherwise initialised, handle IRQs
     bool isr_handled = false;
-    // Read the ICCIAR value to get interrupt ID
-    HPSIRQSource int_ID = (HPSIRQSource)__gic_cpuif_ptr[ICCIAR];
-    // Check to see if we have a registered handler
-    unsigned int handler;
-    for (handler = 0; handler < __isr_handler_count; handler++) {
-        IsrHandler_t* ctx = &__isr_handlers[handler];
-        if (!ctx->enabled) continue; // Skip disabled handler entries
-        if (int_ID == ctx->interruptID) {
+    // Read the ICCIAR value to get interrupt ID. The upper bits hold the source CPU
+    // for software generated interrupts, and must be written back to ICCEOIR.
+    unsigned int int_ACK = __gic_cpuif_ptr[ICCIAR];
+#ifdef HPS_IRQ_STATS
+    uint32_t ackTime = TIMESTAMP_CNTR_LO;
+#endif
+    HPSIRQSource int_ID = (HPSIRQSource)(int_ACK & ICCIAR_ID_MASK);
+    // Look up the handler directly. Spurious IDs (1023) fall outside of the table.
+    if (int_ID < IRQ_SOURCE_COUNT) {
+        IsrHandler_t* ctx = &__isr_handlers[int_ID];
+        if (ctx->enabled) {
             // If we have found a handler for this ID
             // Backup our CPSR to the SPSR as the handler will clobber CPSR
             // and restore from SPSR afterwards
             __SET_PROC_SPSR(__GET_PROC_CPSR());
+#ifdef HPS_IRQ_STATS
+            uint32_t startTime = TIMESTAMP_CNTR_LO;
+#endif
             // Check if we have a handler function
-            if (ctx->handler) {
+            if (ctx->handler && ctx->preemptible) {
+                // Preemptible handlers are called with IRQs enabled in SVC mode.
+                // The GIC will only signal higher priority interrupts until EOI.
+                _HPS_IRQ_callPreemptible(int_ID, ctx->param, &isr_handled, ctx->handler);
+            } else if (ctx->handler) {
                 // If so, call it and check status if we have a handler
-                ctx->handler(int_ID, ctx->param, &isr_handled);   
+                ctx->handler(int_ID, ctx->param, &isr_handled);
             } else {
                 // Otherwise assume handled
                 isr_handled = true;
             }
-            break;
+#ifdef HPS_IRQ_STATS
+            // Update statistics. 32-bit differences are fine for handlers under ~20s.
+            uint32_t cycles = TIMESTAMP_CNTR_LO - startTime;
+            uint32_t latency = startTime - ackTime;
+            HPSIRQStats_t* stats = &__isr_stats[int_ID];
+            stats->count++;
+            stats->totalCycles += cycles;
+            if (cycles > stats->maxCycles) stats->maxCycles = cycles;
+            if (latency > stats->maxLatency) stats->maxLatency = latency;
+#endif
         }
     }
     //Check if we have an unhandled interrupt
@@ -240,8 +393,11 @@ __irq void __irq_isr (void) {
         __isr_unhandledIRQCallback(int_ID, NULL, NULL);
     }
 
+    //Wait for posted writes over the FPGA bridges (e.g. clearing the source's
+    //flag) to complete, so the GIC does not see the interrupt again.
+    __DSB();
     //Otherwise write to the End of Interrupt Register (ICCEOIR) to mark as handled
-    __gic_cpuif_ptr[ICCEOIR] = (unsigned int)int_ID;
+    __gic_cpuif_ptr[ICCEOIR] = int_ACK;
     //Restore the SPSR state before returning from the IRQ.
     __SET_PROC_SPSR(spsr);
     //And done.
@@ -250,81 +406,173 @@ __irq void __irq_isr (void) {
 #pragma clang diagnostic pop
 
 
+/*
+ * FIQ fast path
+ *
+ * Only one source is in group 0, so no lookup is needed. The handler is
+ * called directly, and the FIQ attribute means only registers not banked in
+ * FIQ mode are saved.
+ */
+
+#ifndef HPS_IRQ_CUSTOM_FIQ
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra"
+HOT_CODE __fiq void __fiq_isr (void) {
+    // Read the ICCIAR value to acknowledge the interrupt
+    unsigned int int_ACK = __gic_cpuif_ptr[ICCIAR];
+    HPSIRQSource int_ID = (HPSIRQSource)(int_ACK & ICCIAR_ID_MASK);
+    // Handle unless spurious
+    if (int_ID == __fiq_source) {
+        __fiq_handler(int_ID, __fiq_param);
+    }
+    // Wait for any posted device writes by the handler
+    __DSB();
+    // Write to the End of Interrupt Register (ICCEOIR) to mark as handled
+    __gic_cpuif_ptr[ICCEOIR] = int_ACK;
+}
+#pragma clang diagnostic pop
+#endif
+
+
 /*
  * Internal Helper Functions
  */
 
+//Add a handler to the table, leaving the distributor unchanged.
+// - Must have interrupts masked before calling this
+// - interruptID must be less than IRQ_SOURCE_COUNT
+static void _HPS_IRQ_setHandler(HPSIRQSource interruptID, IsrHandlerFunc_t handlerFunction, void* handlerParam) {
+    //Add our new handler, replacing any existing one
+    __isr_handlers[interruptID].handler = handlerFunction;
+    __isr_handlers[interruptID].param = handlerParam;
+    __isr_handlers[interruptID].enabled = true;
+#ifdef HPS_IRQ_STATS
+    //Statistics start afresh for the new handler
+    __isr_stats[interruptID] = (HPSIRQStats_t){0};
+#endif
+}
+
+//Clear a handler from the table, leaving the distributor unchanged.
+// - Must have interrupts masked before calling this
+// - interruptID must be less than IRQ_SOURCE_COUNT
+static void _HPS_IRQ_clearHandler(HPSIRQSource interruptID) {
+    //Clear the handler pointer, and mark as disabled
+    __isr_handlers[interruptID].handler = 0x0;
+    __isr_handlers[interruptID].enabled = false;
+}
+
 //Register a new handler.
 // - Must have interrupts masked before calling this
-static void _HPS_IRQ_doRegister(unsigned int handler, HPSIRQSource interruptID, IsrHandlerFunc_t handlerFunction, void* handlerParam) {
+// - interruptID must be less than IRQ_SOURCE_COUNT
+static void _HPS_IRQ_doRegister(HPSIRQSource interruptID, IsrHandlerFunc_t handlerFunction, void* handlerParam) {
     volatile unsigned char* diptr;
-    //Add our new handler
-    __isr_handlers[handler].handler = handlerFunction;
-    __isr_handlers[handler].param = handlerParam;
-    __isr_handlers[handler].interruptID = interruptID;
-    __isr_handlers[handler].enabled = true;
-    //Assuming a valid ID
-    if (interruptID < IRQ_SOURCE_COUNT) {
-        //We need to enable the interrupt in the distributor
-        __gic_dist_ptr[ICDISER + (interruptID / IRQ_REG_BITS)] = 1 << (interruptID & IRQ_REG_BITMASK);
-        //And set the affinity to CPU0
-        diptr = (unsigned char*)&(__gic_dist_ptr[ICDIPTR + interruptID / IRQ_REG_BYTES]);
-        diptr[interruptID & IRQ_REG_BYTEMASK] = 0x1;
-    }
+    _HPS_IRQ_setHandler(interruptID, handlerFunction, handlerParam);
+    //We need to enable the interrupt in the distributor
+    __gic_dist_ptr[ICDISER + (interruptID / IRQ_REG_BITS)] = 1 << (interruptID & IRQ_REG_BITMASK);
+    //And set the affinity to the requested CPUs (CPU0 unless changed)
+    diptr = (unsigned char*)&(__gic_dist_ptr[ICDIPTR + interruptID / IRQ_REG_BYTES]);
+    diptr[interruptID & IRQ_REG_BYTEMASK] = __isr_handlers[interruptID].target;
     //Done
     return;
 }
 
-//Grow the handler table.
-// - Must have interrupts masked before calling this
-static HpsErr_t _HPS_IRQ_growTable(unsigned int growByN) {
-    IsrHandler_t* new_handlers;
-    //If length is correct, do nothing
-    if (!growByN) return ERR_SUCCESS;
-    //If we failed to find a match, we need to reallocated our handler array to gain more space
-    new_handlers = (IsrHandler_t*)realloc(__isr_handlers, (__isr_handler_count + growByN)*sizeof(IsrHandler_t) );
-    //We should be sure to check that reallocation was a success
-    if (!new_handlers) {
-        //If realloc returned null, then reallocation failed, cannot register new handler.
-        return ERR_ALLOCFAIL;
-    }
-    //If we were successful in making space, update our global pointer
-    __isr_handlers = new_handlers;
-    //Update the count of available handlers
-    __isr_handler_count = __isr_handler_count + growByN;
-    return ERR_SUCCESS;
-}
-
-//Find an existing IRQ handler
-static unsigned int _HPS_IRQ_findHandler(HPSIRQSource interruptID) {
-    unsigned int handler;
-    for (handler = 0; handler < __isr_handler_count; handler++) {
-        if (__isr_handlers[handler].interruptID == interruptID) {
-            //Found an existing one. We'll just overwrite it, instead of making new one.
-            break;
-        }
-    }
-    return handler;
+//Check if there is an existing IRQ handler
+static bool _HPS_IRQ_findHandler(HPSIRQSource interruptID) {
+    return (interruptID < IRQ_SOURCE_COUNT) && __isr_handlers[interruptID].enabled;
 }
 
 //Do the unregistering of an interrupt.
 // - Function will mask interrupts automatically.
-static void _HPS_IRQ_doUnregister(unsigned int handler, HPSIRQSource interruptID) {
+// - interruptID must be less than IRQ_SOURCE_COUNT
+static void _HPS_IRQ_doUnregister(HPSIRQSource interruptID) {
     //Before changing anything we need to mask interrupts temporarily while we change the handlers
     bool wasMasked = __disable_irq();
-    //Clear the handler pointer, and mark as disabled
-    __isr_handlers[handler].handler = 0x0;
-    __isr_handlers[handler].enabled = false;
+    _HPS_IRQ_clearHandler(interruptID);
     //Then we need to disable the interrupt in the distributor
-    if (interruptID < IRQ_SOURCE_COUNT) {
-        __gic_dist_ptr[ICDICER + (interruptID / IRQ_REG_BITS)] = 1 << (interruptID & IRQ_REG_BITMASK);
-    }
+    __gic_dist_ptr[ICDICER + (interruptID / IRQ_REG_BITS)] = 1 << (interruptID & IRQ_REG_BITMASK);
     //Finally we unmask interrupts to resume processing.
     if (!wasMasked) {
         __enable_irq();
     }
 }
 
+//Start an empty batch of distributor changes
+static void _HPS_IRQ_batchInit(IsrBatch_t* batch) {
+    for (unsigned int bank = 0; bank < IRQ_REG_BANKS; bank++) {
+        batch->enable[bank] = 0;
+        batch->disable[bank] = 0;
+        batch->setPriority[bank] = 0;
+        batch->setTarget[bank] = 0;
+    }
+}
+
+//Add an ID to be enabled (enable = true) or disabled in the distributor
+// - Later changes to the same ID replace earlier ones.
+static void _HPS_IRQ_batchEnable(IsrBatch_t* batch, HPSIRQSource interruptID, bool enable) {
+    unsigned int bank = interruptID / IRQ_REG_BITS;
+    unsigned int bit = 1U << (interruptID & IRQ_REG_BITMASK);
+    if (enable) {
+        batch->enable[bank] |= bit;
+        batch->disable[bank] &= ~bit;
+    } else {
+        batch->disable[bank] |= bit;
+        batch->enable[bank] &= ~bit;
+    }
+}
+
+//Add an ID to have a byte field set in the distributor
+static void _HPS_IRQ_batchByte(unsigned int* mask, unsigned char* values, HPSIRQSource interruptID, unsigned int value) {
+    mask[interruptID / IRQ_REG_BITS] |= 1U << (interruptID & IRQ_REG_BITMASK);
+    values[interruptID] = (unsigned char)value;
+}
+
+//Write a set or clear enable register for each bank with any IDs in mask
+static void _HPS_IRQ_writeBanks(unsigned int reg, const unsigned int* mask) {
+    for (unsigned int bank = 0; bank < IRQ_REG_BANKS; bank++) {
+        if (mask[bank]) {
+            __gic_dist_ptr[reg + bank] = mask[bank];
+        }
+    }
+}
+
+//Write the byte per ID fields for the IDs in mask
+// - Where all four IDs sharing a register are in the mask, the register is
+//   written as a whole word. Otherwise byte writes are used so that the other
+//   IDs are not changed (avoiding a slow read back from the distributor).
+static void _HPS_IRQ_writeBytes(unsigned int reg, const unsigned int* mask, const unsigned char* values) {
+    volatile unsigned char* dptr = (unsigned char*)&(__gic_dist_ptr[reg]);
+    for (unsigned int bank = 0; bank < IRQ_REG_BANKS; bank++) {
+        unsigned int bits = mask[bank];
+        for (unsigned int word = 0; bits; word++, bits >>= IRQ_REG_BYTES) {
+            unsigned int id = bank * IRQ_REG_BITS + word * IRQ_REG_BYTES;
+            unsigned int bytes = bits & IRQ_REG_BYTES_ALL;
+            if (bytes == IRQ_REG_BYTES_ALL) {
+                //Little endian, so the lowest ID is the lowest byte
+                __gic_dist_ptr[reg + id / IRQ_REG_BYTES] = (unsigned int)values[id]            |
+                                                           ((unsigned int)values[id + 1] << 8)  |
+                                                           ((unsigned int)values[id + 2] << 16) |
+                                                           ((unsigned int)values[id + 3] << 24);
+            } else {
+                for (unsigned int byte = 0; bytes; byte++, bytes >>= 1) {
+                    if (bytes & 1) {
+                        dptr[id + byte] = values[id + byte];
+                    }
+                }
+            }
+        }
+    }
+}
+
+//Apply a batch of distributor changes
+// - Must have interrupts masked before calling this
+// - IDs are disabled first, and enabled last once their priority and targets are set.
+static void _HPS_IRQ_batchApply(const IsrBatch_t* batch) {
+    _HPS_IRQ_writeBanks(ICDICER, batch->disable);
+    _HPS_IRQ_writeBytes(ICDIPR, batch->setPriority, batch->priority);
+    _HPS_IRQ_writeBytes(ICDIPTR, batch->setTarget, batch->target);
+    _HPS_IRQ_writeBanks(ICDISER, batch->enable);
+}
+
 /*
  * User Facing APIs
  */
@@ -337,15 +585,26 @@ HpsErr_t HPS_IRQ_initialise( bool enableIrqs, IsrHandlerFunc_t userUnhandledIRQC
     // Disable IRQ interrupts before configuring GIC
     __disable_irq();
 
-    // Ensure no interrupt sources were previously left enabled
+    // Ensure no interrupt sources were previously left enabled, and all are in group 0
     for (unsigned int idGroup = 0; idGroup < IRQ_SOURCE_COUNT/IRQ_REG_BITS; idGroup++) {
         __gic_dist_ptr[ICDICER + idGroup] = UINT32_MAX;
+        __gic_dist_ptr[ICDISR  + idGroup] = 0;
     }
         
+    // Set all sources to the default priority
+    volatile unsigned char* dipr = (unsigned char*)&(__gic_dist_ptr[ICDIPR]);
+    for (unsigned int id = 0; id < IRQ_SOURCE_COUNT; id++) {
+        dipr[id] = HPS_IRQ_PRIORITY_DEFAULT;
+    }
+
     // Set Interrupt Priority Mask Register (ICCPMR)
     // Enable interrupts of all priorities
     __gic_cpuif_ptr[ICCPMR] = 0xFFFF;
 
+    // Set Binary Point Register (ICCBPR)
+    // Use all implemented priority bits for pre-emption (clamped to minimum by GIC)
+    __gic_cpuif_ptr[ICCBPR] = 0x0;
+
     // Set CPU Interface Control Register (ICCICR)
     // Enable signalling of interrupts
     __gic_cpuif_ptr[ICCICR] = 0x1;
@@ -355,9 +614,20 @@ HpsErr_t HPS_IRQ_initialise( bool enableIrqs, IsrHandlerFunc_t userUnhandledIRQC
     __gic_dist_ptr[ICDDCR] = 0x1;
 
     // Initially no handlers
-    __isr_handler_count = 0;
-    __isr_handlers = NULL;
+    for (unsigned int id = 0; id < IRQ_SOURCE_COUNT; id++) {
+        __isr_handlers[id].handler = NULL;
+        __isr_handlers[id].param = NULL;
+        __isr_handlers[id].enabled = false;
+        __isr_handlers[id].preemptible = false;
+        __isr_handlers[id].target = HPS_IRQ_CPU0;
+    }
     
+    // Initially no FIQ handler
+    __fiq_source = (HPSIRQSource)IRQ_SOURCE_COUNT;
+    __fiq_handler = NULL;
+    __fiq_param = NULL;
+    __fiq_grouped = false;
+
     //Set up the unhandled IRQ callback
     if (userUnhandledIRQCallback != NULL) {
         //If the user has supplied one, use theirs
@@ -379,6 +649,41 @@ HpsErr_t HPS_IRQ_initialise( bool enableIrqs, IsrHandlerFunc_t userUnhandledIRQC
     return ERR_SUCCESS;
 }
 
+//Initialise the GIC CPU interface of a secondary core
+// - Must be called on the secondary core (e.g. CPU1) after HPS_IRQ_initialise()
+//   has been called on CPU0. Allows the core to take its private interrupts.
+// - The private interrupt IDs of this core start disabled at the default priority.
+// - enableIrqs controls whether to enable the IRQs on this core on return.
+// - Returns ERR_NOINIT if HPS_IRQ_initialise() has not been called.
+// - Returns ERR_WRONGMODE if called on CPU0.
+HpsErr_t HPS_IRQ_initialiseCpu(bool enableIrqs) {
+    if (!__isInitialised) return ERR_NOINIT;
+    if (!(__GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID)) return ERR_WRONGMODE;
+
+    // Disable IRQ interrupts on this core before configuring GIC
+    __disable_irq();
+
+    // The first distributor registers are banked for the private IDs of this
+    // core. Start them disabled, in the same group as all other sources.
+    __gic_dist_ptr[ICDICER] = UINT32_MAX;
+    __gic_dist_ptr[ICDISR]  = __fiq_grouped ? UINT32_MAX : 0;
+    volatile unsigned char* dipr = (unsigned char*)&(__gic_dist_ptr[ICDIPR]);
+    for (unsigned int id = 0; id < IRQ_REG_BITS; id++) {
+        dipr[id] = HPS_IRQ_PRIORITY_DEFAULT;
+    }
+
+    // Configure this core's CPU interface as for CPU0
+    __gic_cpuif_ptr[ICCPMR] = 0xFFFF;
+    __gic_cpuif_ptr[ICCBPR] = 0x0;
+    __gic_cpuif_ptr[ICCICR] = __fiq_grouped ? ICCICR_GROUPED : 0x1;
+
+    //Enable interrupts if requested
+    if (enableIrqs) {
+        __enable_irq();
+    }
+    return ERR_SUCCESS;
+}
+
 //Check if driver initialised
 // - returns true if initialised
 bool HPS_IRQ_isInitialised() {
@@ -406,25 +711,17 @@ HpsErr_t HPS_IRQ_globalEnable(bool enable) {
 
 //Register an IRQ handler
 HpsErr_t HPS_IRQ_registerHandler(HPSIRQSource interruptID, IsrHandlerFunc_t handlerFunction, void* handlerParam) {
-    unsigned int handler;
     bool wasMasked;
     if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
-
-    //First check if a handler already exists (we can overwrite it if it does)
-    handler = _HPS_IRQ_findHandler(interruptID);
+    //Ensure ID is one the GIC supports, and not used by FIQ
+    if (interruptID >= IRQ_SOURCE_COUNT) return ERR_BEYONDEND;
+    if (interruptID == __fiq_source) return ERR_INUSE;
 
     //Before changing anything we need to mask interrupts temporarily while we change the handlers
     wasMasked = __disable_irq();
 
-    //Grow the handler table if ID not found
-    if (handler == __isr_handler_count) {
-        //Grow the table by one
-        HpsErr_t status = _HPS_IRQ_growTable(1);
-        if (ERR_IS_ERROR(status)) return status;
-    }
-
-    //Add our new handler
-    _HPS_IRQ_doRegister(handler, interruptID, handlerFunction, handlerParam);
+    //Add our new handler (overwrites any existing one)
+    _HPS_IRQ_doRegister(interruptID, handlerFunction, handlerParam);
 
     //Finally we unmask interrupts to resume processing.
     if (!wasMasked) {
@@ -436,43 +733,38 @@ HpsErr_t HPS_IRQ_registerHandler(HPSIRQSource interruptID, IsrHandlerFunc_t hand
 
 //Register multiple IRQ handlers
 HpsErr_t HPS_IRQ_registerHandlers(HPSIRQSource* interruptIDs, IsrHandlerFunc_t* handlerFunctions, void** handlerParams, unsigned int count) {
-    unsigned int handlers [count];
+    IsrBatch_t batch;
     bool wasMasked;
     //Validate inputs
     if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
     if (!interruptIDs || !handlerFunctions) return ERR_NULLPTR;
-    //First check if any handlers already exist (we can overwrite any that do)
-    unsigned int growBy = 0;
+    //Check all IDs are valid before registering any of them
     for (unsigned int idx = 0; idx < count; idx++) {
-        unsigned int handler = _HPS_IRQ_findHandler(interruptIDs[idx]);
-        if (handler == __isr_handler_count) {
-            //Handler not found.
-            //Add on to handler amount we previously needed to grow by so that each subsequent
-            //not found goes after the next.
-            handler += growBy;
-            //And increment the number we need to grow the table by
-            growBy++;
-        }
-        handlers[idx] = handler;
+        if (interruptIDs[idx] >= IRQ_SOURCE_COUNT) return ERR_BEYONDEND;
+        if (interruptIDs[idx] == __fiq_source) return ERR_INUSE;
     }
 
     //Before changing anything we need to mask interrupts temporarily while we change the handlers
     wasMasked = __disable_irq();
 
-    //Ensure the handler table is big enough
-    HpsErr_t status = _HPS_IRQ_growTable(growBy);
-    if (ERR_IS_ERROR(status)) return status;
-
-    //Add our new handlers
+    //Add our new handlers, collecting the distributor changes to write together
+    _HPS_IRQ_batchInit(&batch);
     for (unsigned int idx = 0; idx < count; idx++) {
+        HPSIRQSource interruptID = interruptIDs[idx];
         void* param;
         if (!handlerParams) {
             param = NULL;
         } else {
             param = handlerParams[idx];
         }
-        _HPS_IRQ_doRegister(handlers[idx], interruptIDs[idx], handlerFunctions[idx], param);
+        _HPS_IRQ_setHandler(interruptID, handlerFunctions[idx], param);
+        _HPS_IRQ_batchEnable(&batch, interruptID, true);
+        //Private IDs always target their own core
+        if (interruptID >= HPS_IRQ_PRIVATE_COUNT) {
+            _HPS_IRQ_batchByte(batch.setTarget, batch.target, interruptID, __isr_handlers[interruptID].target);
+        }
     }
+    _HPS_IRQ_batchApply(&batch);
 
     //Finally we unmask interrupts to resume processing.
     if (!wasMasked) {
@@ -485,14 +777,11 @@ HpsErr_t HPS_IRQ_registerHandlers(HPSIRQSource* interruptIDs, IsrHandlerFunc_t*
 
 
 HpsErr_t HPS_IRQ_unregisterHandler(HPSIRQSource interruptID) {
-    unsigned int handler;
     if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
     //See if we can find the requested handler
-    handler = _HPS_IRQ_findHandler(interruptID);
-    //If so, unregister it
-    if (handler != __isr_handler_count) {
+    if (_HPS_IRQ_findHandler(interruptID)) {
         //Found it, so unregister
-        _HPS_IRQ_doUnregister(handler, interruptID);
+        _HPS_IRQ_doUnregister(interruptID);
         return ERR_SUCCESS;
     }
     //Whoops, handler doesn't exist.
@@ -500,25 +789,265 @@ HpsErr_t HPS_IRQ_unregisterHandler(HPSIRQSource interruptID) {
 }
 
 HpsErr_t HPS_IRQ_unregisterHandlers(HPSIRQSource* interruptIDs, unsigned int count) {
-    unsigned int handler;
+    IsrBatch_t batch;
     HPSIRQSource interruptID;
     HpsErr_t status = ERR_SUCCESS;
     //Validate inputs
     if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
     if (!interruptIDs) return ERR_NULLPTR;
+    //Mask interrupts once while we change all of the handlers
+    bool wasMasked = __disable_irq();
     //Loop through all interrupt IDs
+    _HPS_IRQ_batchInit(&batch);
     for (unsigned int idx = 0; idx < count; idx++) {
         interruptID = interruptIDs[idx];
-        handler = _HPS_IRQ_findHandler(interruptID);
-        if (handler != __isr_handler_count) {
+        if (_HPS_IRQ_findHandler(interruptID)) {
             //Found it, so unregister
-            _HPS_IRQ_doUnregister(handler, interruptID);
+            _HPS_IRQ_clearHandler(interruptID);
+            _HPS_IRQ_batchEnable(&batch, interruptID, false);
         } else {
             //Otherwise at least one was not found.
             status = ERR_NOTFOUND;
         }
     }
+    //Then disable them all in the distributor
+    _HPS_IRQ_batchApply(&batch);
+    //Finally we unmask interrupts to resume processing.
+    if (!wasMasked) {
+        __enable_irq();
+    }
     //Done. Return whether any were not found.
     return status;
 }
 
+//Configure multiple IRQ IDs
+HpsErr_t HPS_IRQ_configureHandlers(const HPSIRQConfig_t* configs, unsigned int count) {
+    IsrBatch_t batch;
+    bool wasMasked;
+    //Validate inputs
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    if (!configs) return ERR_NULLPTR;
+    //Check all entries are valid before changing any of them
+    for (unsigned int idx = 0; idx < count; idx++) {
+        const HPSIRQConfig_t* config = &configs[idx];
+        if (config->interruptID >= IRQ_SOURCE_COUNT) return ERR_BEYONDEND;
+        if (config->interruptID == __fiq_source) return ERR_INUSE;
+        if (config->priority > HPS_IRQ_PRIORITY_LOWEST) return ERR_TOOBIG;
+        if (config->cpuMask & ~HPS_IRQ_CPU_ALL) return ERR_BADID;
+        if (config->cpuMask && (config->interruptID < HPS_IRQ_PRIVATE_COUNT)) return ERR_NOSUPPORT;
+    }
+
+    //Mask interrupts once while we change all of the handlers
+    wasMasked = __disable_irq();
+
+    //Update the handler table, collecting the distributor changes to write together
+    _HPS_IRQ_batchInit(&batch);
+    for (unsigned int idx = 0; idx < count; idx++) {
+        const HPSIRQConfig_t* config = &configs[idx];
+        HPSIRQSource interruptID = config->interruptID;
+        if (config->cpuMask) {
+            __isr_handlers[interruptID].target = (unsigned char)config->cpuMask;
+        }
+        __isr_handlers[interruptID].preemptible = config->preemptible;
+        _HPS_IRQ_batchByte(batch.setPriority, batch.priority, interruptID, config->priority);
+        if (config->handlerFunction) {
+            _HPS_IRQ_setHandler(interruptID, config->handlerFunction, config->handlerParam);
+            _HPS_IRQ_batchEnable(&batch, interruptID, true);
+        } else {
+            _HPS_IRQ_clearHandler(interruptID);
+            _HPS_IRQ_batchEnable(&batch, interruptID, false);
+        }
+        //Registered shared IDs are routed to their targets, as by HPS_IRQ_registerHandler()
+        if ((interruptID >= HPS_IRQ_PRIVATE_COUNT) && (config->cpuMask || config->handlerFunction)) {
+            _HPS_IRQ_batchByte(batch.setTarget, batch.target, interruptID, __isr_handlers[interruptID].target);
+        }
+    }
+    _HPS_IRQ_batchApply(&batch);
+
+    //Finally we unmask interrupts to resume processing.
+    if (!wasMasked) {
+        __enable_irq();
+    }
+    return ERR_SUCCESS;
+}
+
+HpsErr_t HPS_IRQ_setPriority(HPSIRQSource interruptID, unsigned int priority, bool preemptible) {
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    //Validate inputs
+    if (interruptID >= IRQ_SOURCE_COUNT) return ERR_BEYONDEND;
+    if (priority > HPS_IRQ_PRIORITY_LOWEST) return ERR_TOOBIG;
+    //Mask interrupts while we change the priority so the handler is consistent
+    bool wasMasked = __disable_irq();
+    //Priority registers are byte accessible, one per ID
+    volatile unsigned char* dipr = (unsigned char*)&(__gic_dist_ptr[ICDIPR]);
+    dipr[interruptID] = (unsigned char)priority;
+    __isr_handlers[interruptID].preemptible = preemptible;
+    //Finally we unmask interrupts to resume processing.
+    if (!wasMasked) {
+        __enable_irq();
+    }
+    return ERR_SUCCESS;
+}
+
+HpsErr_t HPS_IRQ_setTarget(HPSIRQSource interruptID, unsigned int cpuMask) {
+    volatile unsigned char* diptr;
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    //Validate inputs. Private IDs always target their own core.
+    if (interruptID >= IRQ_SOURCE_COUNT) return ERR_BEYONDEND;
+    if (interruptID < HPS_IRQ_PRIVATE_COUNT) return ERR_NOSUPPORT;
+    if (!cpuMask || (cpuMask & ~HPS_IRQ_CPU_ALL)) return ERR_BADID;
+    if (interruptID == __fiq_source) return ERR_INUSE;
+    //Mask interrupts while we change the target so the handler table is consistent
+    bool wasMasked = __disable_irq();
+    __isr_handlers[interruptID].target = (unsigned char)cpuMask;
+    diptr = (unsigned char*)&(__gic_dist_ptr[ICDIPTR + interruptID / IRQ_REG_BYTES]);
+    diptr[interruptID & IRQ_REG_BYTEMASK] = (unsigned char)cpuMask;
+    //Finally we unmask interrupts to resume processing.
+    if (!wasMasked) {
+        __enable_irq();
+    }
+    return ERR_SUCCESS;
+}
+
+HpsErr_t HPS_IRQ_sendSoftware(HPSIRQSource sgiID, unsigned int cpuMask) {
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    //Validate inputs
+    if (sgiID >= HPS_IRQ_SGI_COUNT) return ERR_BEYONDEND;
+    if (!cpuMask || (cpuMask & ~HPS_IRQ_CPU_ALL)) return ERR_BADID;
+    unsigned int sgir = (cpuMask << ICDSGIR_TARGET_OFFS) | sgiID;
+    //Once sources are grouped for FIQ, SGIs for IRQ handlers are in group 1
+    if (__fiq_grouped && (sgiID != __fiq_source)) sgir |= ICDSGIR_NSATT;
+    //Ensure any data written for the handler is visible before it runs
+    __DSB();
+    __gic_dist_ptr[ICDSGIR] = sgir;
+    return ERR_SUCCESS;
+}
+
+HpsErr_t HPS_IRQ_getPending(HPSIRQSource* interruptID) {
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    if (!interruptID) return ERR_NULLPTR;
+    //Reading ICCHPIR does not acknowledge the interrupt
+    unsigned int id = __gic_cpuif_ptr[ICCHPIR] & ICCIAR_ID_MASK;
+    if (id >= IRQ_SOURCE_COUNT) return ERR_NOTFOUND;
+    *interruptID = (HPSIRQSource)id;
+    return ERR_SUCCESS;
+}
+
+HpsErr_t HPS_IRQ_getStats(HPSIRQSource interruptID, HPSIRQStats_t* stats) {
+#ifdef HPS_IRQ_STATS
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    if (!stats) return ERR_NULLPTR;
+    if (interruptID >= IRQ_SOURCE_COUNT) return ERR_BEYONDEND;
+    //Copy with IRQs masked so the count and times match
+    bool wasMasked = __disable_irq();
+    *stats = __isr_stats[interruptID];
+    if (!wasMasked) {
+        __enable_irq();
+    }
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+HpsErr_t HPS_IRQ_resetStats(void) {
+#ifdef HPS_IRQ_STATS
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    bool wasMasked = __disable_irq();
+    for (unsigned int id = 0; id < IRQ_SOURCE_COUNT; id++) {
+        __isr_stats[id] = (HPSIRQStats_t){0};
+    }
+    if (!wasMasked) {
+        __enable_irq();
+    }
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+uintptr_t HPS_IRQ_interruptedPc(void) {
+#ifdef HPS_IRQ_PC_SAMPLE
+    return __isr_interruptedPc[__GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID];
+#else
+    return 0;
+#endif
+}
+
+HpsErr_t HPS_IRQ_dumpStats(void) {
+#ifdef HPS_IRQ_STATS
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    printf("IRQ  Count       Total(ns)       Mean(ns)  Max(ns)   MaxLat(ns)\n");
+    for (unsigned int id = 0; id < IRQ_SOURCE_COUNT; id++) {
+        HPSIRQStats_t stats;
+        HPS_IRQ_getStats((HPSIRQSource)id, &stats);
+        if (!stats.count) continue;
+        unsigned long long totalNs = time_cyclesToNs(stats.totalCycles);
+        printf("%-4u %-11u %-15llu %-9llu %-9llu %llu\n", id, stats.count, totalNs, totalNs / stats.count,
+               (unsigned long long)time_cyclesToNs(stats.maxCycles),
+               (unsigned long long)time_cyclesToNs(stats.maxLatency));
+    }
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+HpsErr_t HPS_IRQ_registerFiqHandler(HPSIRQSource interruptID, FiqHandlerFunc_t handlerFunction, void* handlerParam) {
+    volatile unsigned char* diptr;
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    //Validate inputs
+    if (!handlerFunction) return ERR_NULLPTR;
+    if (interruptID >= IRQ_SOURCE_COUNT) return ERR_BEYONDEND;
+    if ((__fiq_source != IRQ_SOURCE_COUNT) && (__fiq_source != interruptID)) return ERR_INUSE;
+    if (_HPS_IRQ_findHandler(interruptID)) return ERR_INUSE;
+    //Mask both IRQs and FIQs while we reconfigure the GIC
+    bool wasMasked = __disable_irq();
+    __disable_fiq();
+    //The first time, move all sources to group 1 (IRQ), and enable group 0 as FIQ.
+    if (!__fiq_grouped) {
+        for (unsigned int idGroup = 0; idGroup < IRQ_SOURCE_COUNT/IRQ_REG_BITS; idGroup++) {
+            __gic_dist_ptr[ICDISR + idGroup] = UINT32_MAX;
+        }
+        __gic_cpuif_ptr[ICCICR] = ICCICR_GROUPED;
+        __gic_dist_ptr[ICDDCR] = ICDDCR_GROUPED;
+        __fiq_grouped = true;
+    }
+    //Save the handler
+    __fiq_handler = handlerFunction;
+    __fiq_param = handlerParam;
+    __fiq_source = interruptID;
+    //Move our source into group 0 at the highest priority
+    __gic_dist_ptr[ICDISR + (interruptID / IRQ_REG_BITS)] &= ~(1 << (interruptID & IRQ_REG_BITMASK));
+    volatile unsigned char* dipr = (unsigned char*)&(__gic_dist_ptr[ICDIPR]);
+    dipr[interruptID] = HPS_IRQ_PRIORITY_HIGHEST;
+    //Enable the interrupt in the distributor, with affinity to CPU0
+    __gic_dist_ptr[ICDISER + (interruptID / IRQ_REG_BITS)] = 1 << (interruptID & IRQ_REG_BITMASK);
+    diptr = (unsigned char*)&(__gic_dist_ptr[ICDIPTR + interruptID / IRQ_REG_BYTES]);
+    diptr[interruptID & IRQ_REG_BYTEMASK] = 0x1;
+    //Unmask FIQs, and IRQs if they were previously unmasked.
+    __enable_fiq();
+    if (!wasMasked) {
+        __enable_irq();
+    }
+    return ERR_SUCCESS;
+}
+
+HpsErr_t HPS_IRQ_unregisterFiqHandler(void) {
+    if (!HPS_IRQ_isInitialised()) return ERR_NOINIT;
+    if (__fiq_source == IRQ_SOURCE_COUNT) return ERR_NOTFOUND;
+    HPSIRQSource interruptID = __fiq_source;
+    //Mask FIQs, no longer needed.
+    __disable_fiq();
+    //Disable the interrupt in the distributor, and return to group 1 at the default priority.
+    __gic_dist_ptr[ICDICER + (interruptID / IRQ_REG_BITS)] = 1 << (interruptID & IRQ_REG_BITMASK);
+    __gic_dist_ptr[ICDISR + (interruptID / IRQ_REG_BITS)] |= (1 << (interruptID & IRQ_REG_BITMASK));
+    volatile unsigned char* dipr = (unsigned char*)&(__gic_dist_ptr[ICDIPR]);
+    dipr[interruptID] = HPS_IRQ_PRIORITY_DEFAULT;
+    //Clear the handler
+    __fiq_source = (HPSIRQSource)IRQ_SOURCE_COUNT;
+    __fiq_handler = NULL;
+    __fiq_param = NULL;
+    return ERR_SUCCESS;
+}
+
@@ -10,7 +10,7 @@
  * interrupt handlers for specific interrupt IDs.
  *
  * The driver supports both Cyclone V devices (default) or
- * Arria 10 devices (-D __ARRIA_10__).
+ * Arria 10 devices (-D __ARRIA10__).
  * 
  * ISR Handlers
  * ------------
@@ -21,6 +21,28 @@
  * the IRQ, and then calls the handler which has been
  * assigned for that interrupt ID.
  *
+ * Interrupt Priorities
+ * --------------------
+ *
+ * Each interrupt source has a GIC priority which can be set
+ * using HPS_IRQ_setPriority(). Lower values are higher priority.
+ * When several interrupts are pending, the highest priority one
+ * is handled first.
+ *
+ * By default handlers run with IRQs masked, so cannot be
+ * interrupted. A source may instead be marked as preemptible,
+ * in which case its handler is run with IRQs enabled, and may
+ * be interrupted by any source with a strictly higher priority.
+ * This allows latency critical sources (e.g. audio FIFOs) to
+ * pre-empt slow bulk handlers (e.g. display updates).
+ *
+ * Preemptible handlers are run in SVC mode on the SVC stack
+ * (in the IRQ_STACKS region), with the IRQ mode link register
+ * and SPSR saved so that nested IRQs cannot clobber them. As
+ * such, preemptible handlers must not make SVC calls (including
+ * semihosting, e.g. printf), and IRQ_STACK_SIZE must be large
+ * enough for all nested handlers.
+ *
  * For the other interrupts, FIQ, Data Abort, Prefetch Abort
  * and Undefined Instruction Interrupts, there is a default
  * handler which simply enters a while(1) loop to hang the
@@ -40,9 +62,113 @@
  *    __abort void __pftcAb_isr(void){   }
  *    // Data Abort
  *    __abort void __dataAb_isr(void){   }
- *    // Fast IRQ
+ *    // Fast IRQ (requires -D HPS_IRQ_CUSTOM_FIQ, see below)
  *    __fiq   void __fiq_isr   (void){   }
  *
+ * FIQ Fast Path
+ * -------------
+ *
+ * A single interrupt source can be routed to the FIQ vector using
+ * HPS_IRQ_registerFiqHandler(). This places the source in GIC group
+ * 0 (signalled as FIQ) and all others in group 1 (signalled as IRQ).
+ * The FIQ vector provided by this driver acknowledges the interrupt
+ * and calls the handler directly, without any table lookup. As FIQ
+ * mode has banked copies of r8-r12, entry requires few registers to
+ * be saved.
+ *
+ * The FIQ handler is a plain function rather than an __irq one. It
+ * is run with both IRQs and FIQs masked, and cannot be masked by
+ * HPS_IRQ_globalEnable(false), so any data shared with the FIQ
+ * handler must be accessed carefully (e.g. single word updates).
+ *
+ * To use your own __fiq_isr implementation instead of the one in
+ * this driver, globally define:
+ *
+ *     -D HPS_IRQ_CUSTOM_FIQ
+ *
+ * Handler Statistics
+ * ------------------
+ *
+ * If HPS_IRQ_STATS is globally defined, the dispatcher keeps for
+ * each source the number of times it has been handled, the total
+ * and longest time spent in its handler, and the longest entry
+ * latency from acknowledging the interrupt (reading ICCIAR) until
+ * its handler is called. Times are in global timer cycles, so the
+ * global timer must be running (see Util/timestamp.h), and the
+ * time of a preemptible handler includes any handlers which nest
+ * within it. The statistics can be read with HPS_IRQ_getStats()
+ * or printed with HPS_IRQ_dumpStats() to see which handlers take
+ * the most time. Statistics are updated without locks, so may be
+ * approximate if one source is handled on both cores.
+ *
+ * Enabling statistics adds two global timer reads and a few
+ * memory updates to each interrupt.
+ *
+ * Interrupted PC
+ * --------------
+ *
+ * If HPS_IRQ_PC_SAMPLE is globally defined, the dispatcher saves
+ * the address of the instruction each IRQ interrupted, for the
+ * core which took it. A handler can read it with
+ * HPS_IRQ_interruptedPc(), e.g. to build a statistical profile
+ * from a timer interrupt (see HPS_PCProfile). A nested interrupt
+ * replaces the value, so it should be read at the start of the
+ * handler.
+ *
+ * Secondary Cores
+ * ---------------
+ *
+ * HPS_IRQ_initialise() sets up the distributor and the GIC CPU
+ * interface of the calling core (CPU0). Shared peripheral
+ * interrupts are always routed to CPU0. The private interrupts
+ * (IDs below 32, e.g. IRQ_MPCORE_PRIVATE_TIMER) are banked, so
+ * each core has its own. For another core to take its private
+ * interrupts, call HPS_IRQ_initialiseCpu() on that core, then
+ * register handlers from it. The handler table is shared, so a
+ * handler for a private ID is called on whichever core raised it.
+ * Enabling and priorities of private IDs apply only to the core
+ * which registers them or sets the priority.
+ *
+ * Shared peripheral interrupts can instead be sent to CPU1 (or
+ * either core) with HPS_IRQ_setTarget(), e.g. to have CPU1 handle
+ * the audio FIFO while CPU0 handles the rest.
+ *
+ * Software generated interrupts (IRQ_SGI_0 to IRQ_SGI_15) can be
+ * sent to either or both cores with HPS_IRQ_sendSoftware(), which
+ * gives a doorbell between the cores. The handler is registered
+ * as for any other ID, from the core which is to receive it:
+ *
+ *    // On CPU1
+ *    HPS_IRQ_initialiseCpu(false);
+ *    HPS_IRQ_registerHandler(IRQ_SGI_0, &doorbellHandler, NULL);
+ *    HPS_IRQ_globalEnable(true);
+ *    // On CPU0
+ *    HPS_IRQ_sendSoftware(IRQ_SGI_0, HPS_IRQ_CPU1);
+ *
+ * A barrier is issued before the interrupt is sent, so data written
+ * before sending is visible to the handler.
+ *
+ * Batched Configuration
+ * ---------------------
+ *
+ * When several sources change at once, e.g. on a mode switch, use
+ * HPS_IRQ_configureHandlers() with a table of HPSIRQConfig_t entries
+ * to register or unregister handlers and set their priority and CPU
+ * targets in one call. IRQs are masked once for the whole table, and
+ * the distributor enables are written once per bank of 32 IDs rather
+ * than once per ID, so the IRQ-off window stays short:
+ *
+ *    static const HPSIRQConfig_t videoMode[] = {
+ *        //ID              Handler      Param    Priority                  Preempt Targets
+ *        { IRQ_DMA0,         &dmaIsr,     &dmaCtx, HPS_IRQ_PRIORITY_DEFAULT, false,  HPS_IRQ_CPU0 },
+ *        { IRQ_TIMER_L4SP_0, &frameTick,  NULL,    HPS_IRQ_PRIORITY_HIGHEST, true,   0 },
+ *        { IRQ_UART0,        NULL,        NULL,    HPS_IRQ_PRIORITY_DEFAULT, false,  0 } //Unregister
+ *    };
+ *    HPS_IRQ_configureHandlers(videoMode, 3);
+ *
+ * HPS_IRQ_registerHandlers() and HPS_IRQ_unregisterHandlers() are
+ * batched in the same way.
+ *
  * 
  * Software Interrupts
  * -------------------
@@ -90,6 +216,9 @@
  * processor state in SVC mode. You can decode the id in the SVC handler to
  * decide what operation to perform.
  * 
+ * Alternatively, Util/svc_dispatch provides __svc_handler as a table of
+ * handlers indexed directly by id, registered with SvcDispatch_register.
+ * 
  *
  * Company: University of Leeds
  * Author: T Carpenter
@@ -98,6 +227,18 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Batch multiple handler registration into one critical
+ *            | section with one distributor write per register.
+ * 14/10/2026 | Complete posted device writes before end of interrupt.
+ * 14/10/2026 | Add optional interrupted PC capture (HPS_IRQ_PC_SAMPLE).
+ * 14/10/2026 | Add HPS_IRQ_getPending to find the highest pending interrupt.
+ * 14/10/2026 | Add CPU target routing and software generated interrupts.
+ * 14/10/2026 | Add optional per-source handler statistics (HPS_IRQ_STATS).
+ * 14/10/2026 | Add HPS_IRQ_initialiseCpu for secondary core private interrupts.
+ * 14/10/2026 | Add FIQ fast path for a single interrupt source.
+ * 14/10/2026 | Add interrupt priorities and nested preemptible handlers.
+ * 14/10/2026 | Use a directly indexed handler table for constant
+ *            | time interrupt dispatch.
  * 12/10/2024 | Add null-pointer checks to IRQ handler
  * 01/04/2024 | Add details about software interrupt calling convention.
  * 21/02/2024 | Fix software interrupt handler.
@@ -121,6 +262,7 @@
 #ifndef HPS_IRQ_H_
 #define HPS_IRQ_H_
 
+#include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -138,12 +280,53 @@
 //Maximum number of IRQ IDs supported by hardware
 #define IRQ_SOURCE_COUNT 256
 
+//Number of private (banked per core) IDs, of which the first are software generated
+#define HPS_IRQ_PRIVATE_COUNT 32
+#define HPS_IRQ_SGI_COUNT     16
+
+//CPU target masks
+#define HPS_IRQ_CPU0    0x1
+#define HPS_IRQ_CPU1    0x2
+#define HPS_IRQ_CPU_ALL (HPS_IRQ_CPU0 | HPS_IRQ_CPU1)
+
+//Interrupt priorities
+// - Lower values are higher priority. The GIC implements the upper 5 bits,
+//   so priorities are in steps of HPS_IRQ_PRIORITY_STEP.
+// - The lowest level (0xF8) is not used as it is never above the priority mask.
+#define HPS_IRQ_PRIORITY_HIGHEST 0x00
+#define HPS_IRQ_PRIORITY_DEFAULT 0x80
+#define HPS_IRQ_PRIORITY_LOWEST  0xF0
+#define HPS_IRQ_PRIORITY_STEP    0x08
+
+//Per-source handler statistics (HPS_IRQ_STATS)
+// - Times are in global timer cycles.
+typedef struct {
+    unsigned int       count;       //Number of times handled
+    unsigned long long totalCycles; //Total time in handler
+    unsigned int       maxCycles;   //Longest time in handler
+    unsigned int       maxLatency;  //Longest time from acknowledge to handler call
+} HPSIRQStats_t;
+
 //Function Pointer Type for Interrupt Handlers
 // - interruptID is the ID of the interrupt that called the handler.
 // - param will be the pointer that was passed as handlerParam when registering
 //   the interrupt. This allows sharing data with an interrupt handler.
 // - set *handled = true if handled successfully (not setting will result in call to un-handled IRQ)
 typedef void (* __irq IsrHandlerFunc_t)(HPSIRQSource interruptID, void* param, bool* handled);
+//Function Pointer Type for FIQ Handler
+// - interruptID is the ID of the interrupt that called the handler.
+// - param will be the pointer that was passed as handlerParam when registering.
+// - Unlike IRQ handlers, this is a plain function. There is no unhandled callback.
+typedef void (* FiqHandlerFunc_t)(HPSIRQSource interruptID, void* param);
+//Interrupt ID configuration for HPS_IRQ_configureHandlers()
+typedef struct {
+    HPSIRQSource interruptID;         //ID to configure
+    IsrHandlerFunc_t handlerFunction; //Handler to register, or NULL to unregister the ID
+    void* handlerParam;               //Parameter passed to the handler
+    unsigned int priority;            //HPS_IRQ_PRIORITY_HIGHEST to HPS_IRQ_PRIORITY_LOWEST
+    bool preemptible;                 //Whether the handler runs with IRQs enabled
+    unsigned int cpuMask;             //CPU targets of a shared ID, or 0 to leave unchanged
+} HPSIRQConfig_t;
 // Two examples of IRQ handlers are as follows:
 /* ---Start Examples---
 //Handler not needing parameters
@@ -182,6 +365,15 @@ HPS_IRQ_registerHandler(IRQ_TIMER_L4SP_0, &exampleIRQHandlerWithNoParams, &thePa
 // - Returns Util/error Code
 HpsErr_t HPS_IRQ_initialise(bool enableIrqs, IsrHandlerFunc_t userUnhandledIRQCallback);
 
+//Initialise the GIC CPU interface of a secondary core
+// - Must be called on the secondary core (e.g. CPU1) after HPS_IRQ_initialise()
+//   has been called on CPU0. Allows the core to take its private interrupts.
+// - The private interrupt IDs of this core start disabled at the default priority.
+// - enableIrqs controls whether to enable the IRQs on this core on return.
+// - Returns ERR_NOINIT if HPS_IRQ_initialise() has not been called.
+// - Returns ERR_WRONGMODE if called on CPU0.
+HpsErr_t HPS_IRQ_initialiseCpu(bool enableIrqs);
+
 //Check if driver initialised
 // - Returns true if driver previously initialised
 bool HPS_IRQ_isInitialised(void);
@@ -210,7 +402,7 @@ HpsErr_t HPS_IRQ_globalEnable(bool enable);
 // - new one.
 // - the interrupt ID will be enabled in the GIC
 // - returns ERR_SUCCESS on success.
-// - returns ERR_ALLOCFAIL if failed to reallocated handler array.
+// - returns ERR_BEYONDEND if interruptID is not less than IRQ_SOURCE_COUNT.
 HpsErr_t HPS_IRQ_registerHandler(
     HPSIRQSource interruptID, IsrHandlerFunc_t handlerFunction, void* handlerParam);
 //Register multiple interrupt ID handlers
@@ -218,6 +410,9 @@ HpsErr_t HPS_IRQ_registerHandler(
 // - interruptIDs, handlerFunctions, and optionally handlerParams should be arrays of length 'count'
 //   with one entry per interrupt.
 // - handlerParams may be NULL if no handlers require parameters.
+// - IRQs are masked once for all IDs, and the GIC enables are written once per
+//   bank of 32 IDs.
+// - returns ERR_BEYONDEND without registering any handlers if any ID is invalid.
 HpsErr_t HPS_IRQ_registerHandlers(
     HPSIRQSource* interruptIDs, IsrHandlerFunc_t* handlerFunctions, void** handlerParams,
     unsigned int count);
@@ -231,8 +426,116 @@ HpsErr_t HPS_IRQ_unregisterHandler(HPSIRQSource interruptID);
 //Unregister multiple interrupt ID handlers
 // - same as above but allows removing multiple IDs and functions in a single call
 // - interruptIDs should be an array of length 'count'
+// - IRQs are masked once for all IDs, and the GIC enables are cleared once per
+//   bank of 32 IDs.
+// - returns ERR_NOTFOUND if any handler was not found. The others are still removed.
 HpsErr_t HPS_IRQ_unregisterHandlers(HPSIRQSource* interruptIDs, unsigned int count);
 
+//Configure multiple interrupt IDs
+// - configs is an array of length 'count', with one entry per ID. If an ID
+//   appears more than once, the last entry is used.
+// - For each entry with a handlerFunction, the handler is registered as with
+//   HPS_IRQ_registerHandler(). For each with a NULL handlerFunction, any existing
+//   handler is unregistered and the ID disabled in the GIC.
+// - The priority and preemptible flag are set as with HPS_IRQ_setPriority(), and
+//   if cpuMask is non-zero the targets as with HPS_IRQ_setTarget().
+// - All IDs are changed with IRQs masked once. The GIC enables are written once per
+//   bank of 32 IDs, and the priority and targets a word at a time where all four
+//   IDs sharing a register are configured.
+// - returns ERR_SUCCESS on success.
+// - returns without changing any IDs if any entry is invalid:
+//    - ERR_BEYONDEND if interruptID is not less than IRQ_SOURCE_COUNT.
+//    - ERR_INUSE if interruptID is routed to FIQ.
+//    - ERR_TOOBIG if priority is lower than HPS_IRQ_PRIORITY_LOWEST.
+//    - ERR_BADID if cpuMask includes a core which does not exist.
+//    - ERR_NOSUPPORT if cpuMask is non-zero for a private ID.
+HpsErr_t HPS_IRQ_configureHandlers(const HPSIRQConfig_t* configs, unsigned int count);
+
+//Set the priority of an interrupt ID
+// - interruptID is the number between 0 and 255 of the interrupt being configured
+// - priority is between HPS_IRQ_PRIORITY_HIGHEST and HPS_IRQ_PRIORITY_LOWEST.
+//   The lower 3 bits are ignored by the GIC.
+// - If preemptible is true, the handler for this ID will run with IRQs enabled
+//   and can be interrupted by any higher priority source. See notes at the top
+//   of this file.
+// - Can be called before or after registering the handler. All IDs default to
+//   HPS_IRQ_PRIORITY_DEFAULT and not preemptible.
+// - returns ERR_SUCCESS on success.
+// - returns ERR_BEYONDEND if interruptID is not less than IRQ_SOURCE_COUNT.
+// - returns ERR_TOOBIG if priority is lower than HPS_IRQ_PRIORITY_LOWEST.
+HpsErr_t HPS_IRQ_setPriority(HPSIRQSource interruptID, unsigned int priority, bool preemptible);
+
+//Set the CPU targets of an interrupt ID
+// - interruptID is a shared peripheral interrupt, from 32 to 255.
+// - cpuMask is a combination of HPS_IRQ_CPU0 and HPS_IRQ_CPU1. If both are
+//   set, the interrupt is handled by whichever core acknowledges it first.
+// - Can be called before or after registering the handler. All IDs default
+//   to HPS_IRQ_CPU0. A core other than CPU0 must call HPS_IRQ_initialiseCpu().
+// - returns ERR_SUCCESS on success.
+// - returns ERR_BEYONDEND if interruptID is not less than IRQ_SOURCE_COUNT.
+// - returns ERR_NOSUPPORT for private IDs, which always target their own core.
+// - returns ERR_BADID if cpuMask is zero or includes a core which does not exist.
+// - returns ERR_INUSE if the ID is routed to FIQ, which is only taken by CPU0.
+HpsErr_t HPS_IRQ_setTarget(HPSIRQSource interruptID, unsigned int cpuMask);
+
+//Send a software generated interrupt
+// - sgiID is the software interrupt to send, IRQ_SGI_0 to IRQ_SGI_15.
+// - cpuMask is a combination of HPS_IRQ_CPU0 and HPS_IRQ_CPU1. The calling
+//   core may include itself.
+// - Data written before the call is visible to the handler.
+// - returns ERR_SUCCESS on success.
+// - returns ERR_BEYONDEND if sgiID is not less than HPS_IRQ_SGI_COUNT.
+// - returns ERR_BADID if cpuMask is zero or includes a core which does not exist.
+HpsErr_t HPS_IRQ_sendSoftware(HPSIRQSource sgiID, unsigned int cpuMask);
+
+//Get the highest priority pending interrupt on the calling core
+// - The interrupt is not acknowledged, so its handler still runs once IRQs
+//   are unmasked. Useful to find what woke the core from WFI.
+// - returns ERR_SUCCESS with the ID in *interruptID on success.
+// - returns ERR_NOTFOUND if no interrupt is pending.
+HpsErr_t HPS_IRQ_getPending(HPSIRQSource* interruptID);
+
+//Get the handler statistics for an interrupt ID
+// - Requires HPS_IRQ_STATS to be globally defined.
+// - Statistics are cleared when a handler is registered for the ID.
+// - returns ERR_NOSUPPORT if statistics are not compiled in.
+// - returns ERR_BEYONDEND if interruptID is not less than IRQ_SOURCE_COUNT.
+HpsErr_t HPS_IRQ_getStats(HPSIRQSource interruptID, HPSIRQStats_t* stats);
+
+//Clear the handler statistics for all interrupt IDs
+// - returns ERR_NOSUPPORT if statistics are not compiled in.
+HpsErr_t HPS_IRQ_resetStats(void);
+
+//Get the address interrupted by the current IRQ
+// - Requires HPS_IRQ_PC_SAMPLE to be globally defined. Returns 0 otherwise.
+// - Only valid when called from an IRQ handler, for the core it runs on.
+uintptr_t HPS_IRQ_interruptedPc(void);
+
+//Print the handler statistics
+// - Prints one line with the statistics for each ID which has been handled,
+//   with times converted to nanoseconds (requires Util/timestamp).
+// - returns ERR_NOSUPPORT if statistics are not compiled in.
+HpsErr_t HPS_IRQ_dumpStats(void);
+
+//Register the FIQ handler
+// - interruptID is the number between 0 and 255 of the interrupt to route to FIQ.
+//   Only one interrupt can be routed to FIQ at a time.
+// - handlerFunction is called from the FIQ vector when the interrupt occurs.
+// - The interrupt ID will be enabled in the GIC at the highest priority, and
+//   FIQs will be unmasked on return.
+// - returns ERR_SUCCESS on success.
+// - returns ERR_BEYONDEND if interruptID is not less than IRQ_SOURCE_COUNT.
+// - returns ERR_INUSE if a different ID is already routed to FIQ, or if an IRQ
+//   handler is registered for this ID.
+HpsErr_t HPS_IRQ_registerFiqHandler(
+    HPSIRQSource interruptID, FiqHandlerFunc_t handlerFunction, void* handlerParam);
+
+//Unregister the FIQ handler
+// - the interrupt will be disabled in the GIC, and returned to the IRQ group.
+// - returns ERR_SUCCESS on success.
+// - returns ERR_NOTFOUND if no FIQ handler registered
+HpsErr_t HPS_IRQ_unregisterFiqHandler(void);
+
 //SVC Body Generation Macro
 // - This is the macro called in the body of SVC callers as described in the comments
 //   at the top of this file.
@@ -16,6 +16,24 @@
 
 typedef enum {
 
+    /* Software generated interrupts (see HPS_IRQ_sendSoftware) */
+        IRQ_SGI_0                       = 0,
+        IRQ_SGI_1                       = 1,
+        IRQ_SGI_2                       = 2,
+        IRQ_SGI_3                       = 3,
+        IRQ_SGI_4                       = 4,
+        IRQ_SGI_5                       = 5,
+        IRQ_SGI_6                       = 6,
+        IRQ_SGI_7                       = 7,
+        IRQ_SGI_8                       = 8,
+        IRQ_SGI_9                       = 9,
+        IRQ_SGI_10                      = 10,
+        IRQ_SGI_11                      = 11,
+        IRQ_SGI_12                      = 12,
+        IRQ_SGI_13                      = 13,
+        IRQ_SGI_14                      = 14,
+        IRQ_SGI_15                      = 15,
+
     /* ARM A9 MPCORE devices (0-15 are software, 16-31 are unused except for these three) */
     IRQ_MPCORE_GLOBAL_TIMER         = 27,
     IRQ_MPCORE_PRIVATE_TIMER        = 29,
@@ -0,0 +1,204 @@
+/*
+ * HPS PC Sampling Profiler
+ * ------------------------
+ * Description:
+ * Statistical profiler which samples the interrupted PC from a
+ * Cortex-A9 private timer interrupt
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "HPS_PCProfile.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+#include "Util/mem_pool.h"
+#include "Util/macros.h"
+#include "Util/bit_helpers.h"
+
+#include <stdio.h>
+
+/*
+ * Internal Functions
+ */
+
+//Timer callback
+// - Count the interrupted address in the bin of its region.
+static void HOT_CODE _PCProfile_sample( void* param ) {
+    PCProfileCtx_t* ctx = (PCProfileCtx_t*)param;
+    uintptr_t pc = HPS_IRQ_interruptedPc();
+    ctx->samples++;
+    for (unsigned int idx = 0; idx < ctx->numRegions; idx++) {
+        PCProfileRegion_t* region = &ctx->regions[idx];
+        uintptr_t offset = pc - region->base;
+        if (offset < region->size) {
+            region->bins[offset >> ctx->binShift]++;
+            return;
+        }
+    }
+    ctx->outside++;
+}
+
+//Cleanup
+static void _PCProfile_cleanup( PCProfileCtx_t* ctx ) {
+    if (ctx->running) {
+        Timer_disable(&ctx->timer->timer);
+        HPS_PrivateTimer_setCallback(ctx->timer, NULL, NULL);
+    }
+    for (unsigned int idx = 0; idx < ctx->numRegions; idx++) {
+        MemPool_free((void*)ctx->regions[idx].bins);
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the profiler
+// - timer is the private timer of the core to sample. Its interrupt
+//   callback is set while profiling.
+// - binShift sets the histogram resolution to 2^binShift bytes (2 for
+//   every ARM instruction).
+// - Returns ERR_NOSUPPORT if HPS_IRQ_PC_SAMPLE is not defined.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t PCProfile_initialise( HPSPrivTimerCtx_t* timer, unsigned int binShift, PCProfileCtx_t** pCtx ) {
+#ifndef HPS_IRQ_PC_SAMPLE
+    return ERR_NOSUPPORT;
+#else
+    //Check if the timer has been initialised (required)
+    if (!HPS_PrivateTimer_isInitialised(timer)) return ERR_BADDEVICE;
+    if ((binShift < 1) || (binShift > 16)) return ERR_OUTRANGE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_PCProfile_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    PCProfileCtx_t* ctx = *pCtx;
+    ctx->timer = timer;
+    ctx->binShift = binShift;
+    ctx->numRegions = 0;
+    ctx->running = false;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+#endif
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool PCProfile_isInitialised( PCProfileCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Add a code region to sample
+// - Allocates a histogram of size >> binShift bins.
+// - Returns ERR_BUSY while running, or ERR_NOSPACE if PCPROFILE_MAX_REGIONS
+//   have been added.
+HpsErr_t PCProfile_addRegion( PCProfileCtx_t* ctx, uintptr_t base, size_t size ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->running) return ERR_BUSY;
+    if (!size) return ERR_TOOSMALL;
+    if (ctx->numRegions >= PCPROFILE_MAX_REGIONS) return ERR_NOSPACE;
+    //Allocate a bin for each 2^binShift bytes, rounding up
+    unsigned int numBins = (size + _BV(ctx->binShift) - 1) >> ctx->binShift;
+    uint32_t* bins = MemPool_calloc(numBins, sizeof(uint32_t));
+    if (!bins) return ERR_ALLOCFAIL;
+    ctx->regions[ctx->numRegions++] = (PCProfileRegion_t){
+        .base = base, .size = size, .numBins = numBins, .bins = bins
+    };
+    return ERR_SUCCESS;
+}
+
+//Start sampling
+// - rate is the number of samples per second.
+// - Returns ERR_WRONGMODE if not called from the timer's core.
+HpsErr_t PCProfile_start( PCProfileCtx_t* ctx, unsigned int rate ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->running) return ERR_BUSY;
+    if (!rate) return ERR_TOOSMALL;
+    //Periodic interrupt at the sample rate
+    TimerCtx_t* timer = &ctx->timer->timer;
+    unsigned int clock;
+    status = Timer_getRate(timer, 0, &clock);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((clock / rate) < 2) return ERR_TOOBIG;
+    status = Timer_configure(timer, TIMER_MODE_FREERUN, 0, (clock / rate) - 1);
+    if (ERR_IS_ERROR(status)) return status;
+    status = HPS_PrivateTimer_setCallback(ctx->timer, &_PCProfile_sample, ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->running = true;
+    return Timer_enable(timer, 0);
+}
+
+//Stop sampling
+// - Returns ERR_SKIPPED if not running.
+HpsErr_t PCProfile_stop( PCProfileCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->running) return ERR_SKIPPED;
+    Timer_disable(&ctx->timer->timer);
+    status = HPS_PrivateTimer_setCallback(ctx->timer, NULL, NULL);
+    ctx->running = false;
+    return status;
+}
+
+//Clear the histograms and counts
+HpsErr_t PCProfile_clear( PCProfileCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Mask IRQs so a sample can't land half way through
+    status = HPS_IRQ_globalEnable(false);
+    for (unsigned int idx = 0; idx < ctx->numRegions; idx++) {
+        PCProfileRegion_t* region = &ctx->regions[idx];
+        for (unsigned int bin = 0; bin < region->numBins; bin++) {
+            region->bins[bin] = 0;
+        }
+    }
+    ctx->samples = 0;
+    ctx->outside = 0;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(status));
+    return ERR_SUCCESS;
+}
+
+//Get the sample counts
+// - Returns the total number of samples, and those outside of all regions
+//   in *outside (may be NULL).
+HpsErr_t PCProfile_getCounts( PCProfileCtx_t* ctx, unsigned int* outside ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (outside) *outside = ctx->outside;
+    return (HpsErr_t)(ctx->samples & INT32_MAX);
+}
+
+//Print the profile
+// - Prints a header line, then the address and count of each bin with at
+//   least minCount samples.
+HpsErr_t PCProfile_dump( PCProfileCtx_t* ctx, unsigned int minCount ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!minCount) minCount = 1;
+    printf("PCProfile samples %u outside %u bin %u\n", ctx->samples, ctx->outside, (unsigned int)_BV(ctx->binShift));
+    for (unsigned int idx = 0; idx < ctx->numRegions; idx++) {
+        PCProfileRegion_t* region = &ctx->regions[idx];
+        for (unsigned int bin = 0; bin < region->numBins; bin++) {
+            unsigned int count = region->bins[bin];
+            if (count < minCount) continue;
+            printf("0x%08lx %u\n", (unsigned long)(region->base + ((uintptr_t)bin << ctx->binShift)), count);
+        }
+    }
+    return ERR_SUCCESS;
+}
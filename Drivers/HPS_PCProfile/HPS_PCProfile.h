@@ -0,0 +1,126 @@
+/*
+ * HPS PC Sampling Profiler
+ * ------------------------
+ * Description:
+ * Statistical profiler which samples the interrupted PC from a
+ * Cortex-A9 private timer interrupt
+ *
+ * Section profiling (Util/profile) needs markers around the code of
+ * interest, so only measures what was already suspected to be slow.
+ * Instead, this samples the address the core was executing at a high
+ * rate from the private timer interrupt, and counts the samples in a
+ * histogram of each code region. Over many samples, the count of each
+ * bin is proportional to the time spent in it, showing the hotspots
+ * anywhere in the image without changing the code.
+ *
+ *    extern unsigned int Image$$APP_CODE$$Base, Image$$APP_CODE$$Length;
+ *    PCProfile_initialise(timer0, 4, &prof);   // 16 byte bins
+ *    PCProfile_addRegion(prof, (uintptr_t)&Image$$APP_CODE$$Base, (size_t)&Image$$APP_CODE$$Length);
+ *    PCProfile_addRegion(prof, 0xFFFF0000, 0x10000);   // HOT_OCRAM
+ *    PCProfile_start(prof, 10000);              // 10kHz
+ *    ...
+ *    PCProfile_stop(prof);
+ *    PCProfile_dump(prof, 1);
+ *
+ * PCProfile_dump() prints the non-empty bins with printf, so the
+ * profile can be captured over semihosting or a retargeted UART. The
+ * Tools/PCProfile/ResolvePCProfile.m script reads the dump and the
+ * image's ELF file and lists the functions by number of samples.
+ *
+ * Requires HPS_IRQ_PC_SAMPLE to be globally defined so that HPS_IRQ
+ * saves the interrupted address, otherwise PCProfile_initialise()
+ * returns ERR_NOSUPPORT. Only the core which owns the timer is
+ * sampled. The timer's callback is used, so it can't be shared with
+ * other users while profiling. Time in IRQ handlers which mask
+ * interrupts is not sampled, so appears in the code they interrupted.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef HPS_PCPROFILE_H_
+#define HPS_PCPROFILE_H_
+
+//Include required header files
+#include "HPS_PrivateTimer/HPS_PrivateTimer.h"
+#include "Util/driver_ctx.h"
+
+//Maximum number of code regions
+#ifndef PCPROFILE_MAX_REGIONS
+#define PCPROFILE_MAX_REGIONS  2
+#endif
+
+// Sampled code region
+typedef struct {
+    uintptr_t base;
+    size_t size;
+    unsigned int numBins;
+    volatile uint32_t* bins;
+} PCProfileRegion_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    HPSPrivTimerCtx_t* timer;
+    unsigned int binShift;          // Bin size is 2^binShift bytes
+    PCProfileRegion_t regions[PCPROFILE_MAX_REGIONS];
+    unsigned int numRegions;
+    bool running;
+    // Counts
+    volatile unsigned int samples;  // Total samples taken
+    volatile unsigned int outside;  // Samples outside of all regions
+} PCProfileCtx_t;
+
+//Initialise the profiler
+// - timer is the private timer of the core to sample. Its interrupt
+//   callback is set while profiling.
+// - binShift sets the histogram resolution to 2^binShift bytes (2 for
+//   every ARM instruction).
+// - Returns ERR_NOSUPPORT if HPS_IRQ_PC_SAMPLE is not defined.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t PCProfile_initialise( HPSPrivTimerCtx_t* timer, unsigned int binShift, PCProfileCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool PCProfile_isInitialised( PCProfileCtx_t* ctx );
+
+//Add a code region to sample
+// - Allocates a histogram of size >> binShift bins.
+// - Returns ERR_BUSY while running, or ERR_NOSPACE if PCPROFILE_MAX_REGIONS
+//   have been added.
+HpsErr_t PCProfile_addRegion( PCProfileCtx_t* ctx, uintptr_t base, size_t size );
+
+//Start sampling
+// - rate is the number of samples per second.
+// - Returns ERR_WRONGMODE if not called from the timer's core.
+HpsErr_t PCProfile_start( PCProfileCtx_t* ctx, unsigned int rate );
+
+//Stop sampling
+// - Returns ERR_SKIPPED if not running.
+HpsErr_t PCProfile_stop( PCProfileCtx_t* ctx );
+
+//Clear the histograms and counts
+HpsErr_t PCProfile_clear( PCProfileCtx_t* ctx );
+
+//Get the sample counts
+// - Returns the total number of samples, and those outside of all regions
+//   in *outside (may be NULL).
+HpsErr_t PCProfile_getCounts( PCProfileCtx_t* ctx, unsigned int* outside );
+
+//Print the profile
+// - Prints a header line, then the address and count of each bin with at
+//   least minCount samples.
+HpsErr_t PCProfile_dump( PCProfileCtx_t* ctx, unsigned int minCount );
+
+#endif /* HPS_PCPROFILE_H_ */
@@ -0,0 +1,323 @@
+/*
+ * Cortex-A9 Private Timer Driver
+ * ------------------------------
+ *
+ * Driver for the 32-bit private timer of each Cortex-A9 core,
+ * implementing the generic timer interface (Util/driver_timer.h).
+ *
+ * The control register value is kept in the context, so that
+ * starting and stopping the timer are single register writes.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "HPS_PrivateTimer.h"
+
+#include "Util/bit_helpers.h"
+#include "Util/lowlevel_arm.h"
+#include "Util/irq.h"
+
+/*
+ * Registers
+ */
+
+#define HPS_PRIVTIMER_REG_LOAD(base)     (*(((volatile uint32_t*)(base)) + (0x00 / sizeof(uint32_t))))
+#define HPS_PRIVTIMER_REG_COUNTER(base)  (*(((volatile uint32_t*)(base)) + (0x04 / sizeof(uint32_t))))
+#define HPS_PRIVTIMER_REG_CONTROL(base)  (*(((volatile uint32_t*)(base)) + (0x08 / sizeof(uint32_t))))
+#define HPS_PRIVTIMER_REG_INTSTAT(base)  (*(((volatile uint32_t*)(base)) + (0x0C / sizeof(uint32_t))))
+
+// Control register bits
+#define HPS_PRIVTIMER_CONTROL_ENABLE     (1U << 0)
+#define HPS_PRIVTIMER_CONTROL_AUTORELOAD (1U << 1)
+#define HPS_PRIVTIMER_CONTROL_IRQEN      (1U << 2)
+#define HPS_PRIVTIMER_CONTROL_PRESCALER_OFFS 8
+
+// Interrupt status register bits
+#define HPS_PRIVTIMER_INTSTAT_EVENT      (1U << 0)
+
+/*
+ * Global Variables
+ */
+
+// Context of each core's timer, for the shared interrupt handler
+static HPSPrivTimerCtx_t* __privtimer_ctx[HPS_PRIVTIMER_CPUS] = {NULL};
+static IrqSpinlock_t __privtimer_lock = IRQ_SPINLOCK_INIT;
+static bool __privtimer_isrRegistered = false;
+
+/*
+ * Internal Functions
+ */
+
+// Get the core this is running on
+static inline unsigned int _HPS_PrivateTimer_cpu(void) {
+    return __GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID;
+}
+
+// Stop the timer and clear its event flag
+//  - Must be called on the timer's core.
+static void _HPS_PrivateTimer_reset(HPSPrivTimerCtx_t* ctx) {
+    HPS_PRIVTIMER_REG_CONTROL(ctx->base) = ctx->control;
+    HPS_PRIVTIMER_REG_INTSTAT(ctx->base) = HPS_PRIVTIMER_INTSTAT_EVENT;
+    ctx->reset = true;
+}
+
+// Validate the context, and that it is being used from its core
+//  - The hardware is reset the first time it is used from its core.
+static HpsErr_t _HPS_PrivateTimer_claim(HPSPrivTimerCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (_HPS_PrivateTimer_cpu() != ctx->cpu) return ERR_WRONGMODE;
+    if (!ctx->reset) _HPS_PrivateTimer_reset(ctx);
+    return ERR_SUCCESS;
+}
+
+// Private timer interrupt
+//  - Shared by both cores. Each sees its own timer.
+static void __irq _HPS_PrivateTimer_isr(HPSIRQSource interruptID, void* param, bool* handled) {
+    HPSPrivTimerCtx_t* ctx = __privtimer_ctx[_HPS_PrivateTimer_cpu()];
+    if (!ctx) return;
+    HPS_PRIVTIMER_REG_INTSTAT(ctx->base) = HPS_PRIVTIMER_INTSTAT_EVENT;
+    if (ctx->callback) ctx->callback(ctx->param);
+    *handled = true;
+}
+
+/*
+ * Generic Timer Interface
+ */
+
+static HpsErr_t _HPS_PrivateTimer_enable(void* ctx, unsigned int fraction) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    HpsErr_t status = _HPS_PrivateTimer_claim(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int load = fraction ? (pt->load / fraction) : pt->load;
+    if (!load) load = 1;
+    //Stop, load (which also sets the counter), then start
+    HPS_PRIVTIMER_REG_CONTROL(pt->base) = pt->control;
+    HPS_PRIVTIMER_REG_LOAD(pt->base) = load;
+    HPS_PRIVTIMER_REG_CONTROL(pt->base) = pt->control | HPS_PRIVTIMER_CONTROL_ENABLE;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _HPS_PrivateTimer_disable(void* ctx) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    HpsErr_t status = _HPS_PrivateTimer_claim(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    HPS_PRIVTIMER_REG_CONTROL(pt->base) = pt->control;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _HPS_PrivateTimer_getLoad(void* ctx, unsigned int* time) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!time) return ERR_NULLPTR;
+    *time = pt->load;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _HPS_PrivateTimer_getTime(void* ctx, unsigned int* time) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!time) return ERR_NULLPTR;
+    *time = HPS_PRIVTIMER_REG_COUNTER(pt->base);
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _HPS_PrivateTimer_getRate(void* ctx, unsigned int prescalar, unsigned int* rate) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!rate) return ERR_NULLPTR;
+    if (prescalar == UINT32_MAX) prescalar = pt->prescaler;
+    if (prescalar > HPS_PRIVTIMER_PRESCALER_MAX) return ERR_TOOBIG;
+    *rate = pt->periphClk / (prescalar + 1);
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _HPS_PrivateTimer_getMode(void* ctx, TimerMode* mode) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!mode) return ERR_NULLPTR;
+    *mode = pt->mode;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _HPS_PrivateTimer_checkOverflow(void* ctx, bool autoClear) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    bool overflowed = HPS_PRIVTIMER_REG_INTSTAT(pt->base) & HPS_PRIVTIMER_INTSTAT_EVENT;
+    if (overflowed && autoClear) HPS_PRIVTIMER_REG_INTSTAT(pt->base) = HPS_PRIVTIMER_INTSTAT_EVENT;
+    return overflowed ? 1 : 0;
+}
+
+static HpsErr_t _HPS_PrivateTimer_configure(void* ctx, TimerMode mode, unsigned int prescalar, unsigned int loadValue) {
+    HPSPrivTimerCtx_t* pt = (HPSPrivTimerCtx_t*)ctx;
+    HpsErr_t status = _HPS_PrivateTimer_claim(pt);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((mode == TIMER_MODE_EVENT) && (loadValue != UINT32_MAX)) return ERR_WRONGMODE;
+    if ((mode != TIMER_MODE_EVENT) && (mode != TIMER_MODE_FREERUN) && (mode != TIMER_MODE_ONESHOT)) return ERR_BADID;
+    if (!loadValue) return ERR_TOOSMALL;
+    if (prescalar == UINT32_MAX) prescalar = pt->prescaler;
+    if (prescalar > HPS_PRIVTIMER_PRESCALER_MAX) return ERR_TOOBIG;
+    //One-shot waits to be enabled, others carry on running with the new settings
+    bool running = (mode != TIMER_MODE_ONESHOT) && (HPS_PRIVTIMER_REG_CONTROL(pt->base) & HPS_PRIVTIMER_CONTROL_ENABLE);
+    pt->mode = mode;
+    pt->prescaler = prescalar;
+    pt->load = loadValue;
+    unsigned int control = (prescalar << HPS_PRIVTIMER_CONTROL_PRESCALER_OFFS) | (pt->control & HPS_PRIVTIMER_CONTROL_IRQEN);
+    if (mode != TIMER_MODE_ONESHOT) control |= HPS_PRIVTIMER_CONTROL_AUTORELOAD;
+    pt->control = control;
+    HPS_PRIVTIMER_REG_CONTROL(pt->base) = control;
+    HPS_PRIVTIMER_REG_LOAD(pt->base) = loadValue;
+    HPS_PRIVTIMER_REG_INTSTAT(pt->base) = HPS_PRIVTIMER_INTSTAT_EVENT;
+    if (running) HPS_PRIVTIMER_REG_CONTROL(pt->base) = control | HPS_PRIVTIMER_CONTROL_ENABLE;
+    return ERR_SUCCESS;
+}
+
+/*
+ * Cleanup
+ */
+
+static void _HPS_PrivateTimer_cleanup(HPSPrivTimerCtx_t* ctx) {
+    //Stop the timer if on its core (otherwise it cannot be reached)
+    if (ctx->base && ctx->reset && (_HPS_PrivateTimer_cpu() == ctx->cpu)) {
+        ctx->control = 0;
+        _HPS_PrivateTimer_reset(ctx);
+    }
+    //Release this core's slot, and the handler once neither core uses it
+    HpsErr_t irqState = IRQ_spinLock(&__privtimer_lock);
+    if (__privtimer_ctx[ctx->cpu] == ctx) __privtimer_ctx[ctx->cpu] = NULL;
+    bool unregister = __privtimer_isrRegistered;
+    for (unsigned int cpu = 0; cpu < HPS_PRIVTIMER_CPUS; cpu++) {
+        if (__privtimer_ctx[cpu]) unregister = false;
+    }
+    if (unregister) __privtimer_isrRegistered = false;
+    IRQ_spinUnlock(&__privtimer_lock, irqState);
+    if (unregister) HPS_IRQ_unregisterHandler(IRQ_MPCORE_PRIVATE_TIMER);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise the Private Timer Driver
+//  - base is a pointer to the private timer (LSC_BASE_PRIV_TIM)
+//  - cpu is the core whose private timer this is. The context can be
+//    created on either core, but must then be used from this one.
+//  - periphClk is the PERIPHCLK rate in Hz (e.g. 200E6 = 200MHz for DE1-SoC)
+//  - The timer starts stopped in one-shot mode.
+//  - Returns ERR_INUSE if a context already exists for this core.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t HPS_PrivateTimer_initialise(void* base, unsigned int cpu, unsigned int periphClk, HPSPrivTimerCtx_t** pCtx) {
+    //Ensure user pointers valid
+    if (!base) return ERR_NULLPTR;
+    if (!pointerIsAligned(base, sizeof(unsigned int))) return ERR_ALIGNMENT;
+    if (cpu >= HPS_PRIVTIMER_CPUS) return ERR_BADID;
+    if (!periphClk) return ERR_TOOSMALL;
+    //Only one context per core
+    HpsErr_t irqState = IRQ_spinLock(&__privtimer_lock);
+    bool inUse = (__privtimer_ctx[cpu] != NULL);
+    IRQ_spinUnlock(&__privtimer_lock, irqState);
+    if (inUse) return ERR_INUSE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_HPS_PrivateTimer_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save context values
+    HPSPrivTimerCtx_t* ctx = *pCtx;
+    ctx->base = (volatile unsigned int*)base;
+    ctx->cpu = cpu;
+    ctx->periphClk = periphClk;
+    ctx->mode = TIMER_MODE_ONESHOT;
+    ctx->prescaler = 0;
+    ctx->load = UINT32_MAX;
+    ctx->control = 0;
+    ctx->reset = false;
+    ctx->callback = NULL;
+    ctx->param = NULL;
+    //Claim the slot for this core, checking again in case the other core got there first
+    irqState = IRQ_spinLock(&__privtimer_lock);
+    inUse = (__privtimer_ctx[cpu] != NULL);
+    if (!inUse) __privtimer_ctx[cpu] = ctx;
+    IRQ_spinUnlock(&__privtimer_lock, irqState);
+    if (inUse) return DriverContextInitFail(pCtx, ERR_INUSE);
+    //Stop the timer now if on its core, otherwise it is stopped when first used
+    if (_HPS_PrivateTimer_cpu() == cpu) _HPS_PrivateTimer_reset(ctx);
+    //Populate the generic timer interface
+    ctx->timer.ctx = ctx;
+    ctx->timer.enable = &_HPS_PrivateTimer_enable;
+    ctx->timer.disable = &_HPS_PrivateTimer_disable;
+    ctx->timer.getLoad = &_HPS_PrivateTimer_getLoad;
+    ctx->timer.getTime = &_HPS_PrivateTimer_getTime;
+    ctx->timer.getRate = &_HPS_PrivateTimer_getRate;
+    ctx->timer.getMode = &_HPS_PrivateTimer_getMode;
+    ctx->timer.checkOverflow = &_HPS_PrivateTimer_checkOverflow;
+    ctx->timer.configure = &_HPS_PrivateTimer_configure;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool HPS_PrivateTimer_isInitialised(HPSPrivTimerCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Set the timer interrupt callback
+//  - callback is called from the timer interrupt each time the timer
+//    expires, with param. Pass NULL to disable the interrupt.
+//  - Registers the shared handler and enables the interrupt on this core.
+//  - Returns ERR_WRONGMODE if not called from the timer's core.
+HpsErr_t HPS_PrivateTimer_setCallback(HPSPrivTimerCtx_t* ctx, HPSPrivTimerFunc_t callback, void* param) {
+    HpsErr_t status = _HPS_PrivateTimer_claim(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Mask the timer interrupt while the callback changes
+    unsigned int enable = HPS_PRIVTIMER_REG_CONTROL(ctx->base) & HPS_PRIVTIMER_CONTROL_ENABLE;
+    ctx->control &= ~HPS_PRIVTIMER_CONTROL_IRQEN;
+    HPS_PRIVTIMER_REG_CONTROL(ctx->base) = ctx->control | enable;
+    ctx->callback = callback;
+    ctx->param = param;
+    if (!callback) return ERR_SUCCESS;
+    //Registering from this core enables the interrupt in its banked distributor registers
+    status = HPS_IRQ_registerHandler(IRQ_MPCORE_PRIVATE_TIMER, &_HPS_PrivateTimer_isr, NULL);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqState = IRQ_spinLock(&__privtimer_lock);
+    __privtimer_isrRegistered = true;
+    IRQ_spinUnlock(&__privtimer_lock, irqState);
+    ctx->control |= HPS_PRIVTIMER_CONTROL_IRQEN;
+    HPS_PRIVTIMER_REG_CONTROL(ctx->base) = ctx->control | enable;
+    return ERR_SUCCESS;
+}
+
+// Change the peripheral clock rate
+//  - periphClk is the new PERIPHCLK rate in Hz, e.g. after a clock
+//    profile change (Util/clk_profile.h).
+//  - Only changes the rate reported by Timer_getRate(). Users of the
+//    timer should then reconfigure it for the new rate.
+HpsErr_t HPS_PrivateTimer_setPeriphClock(HPSPrivTimerCtx_t* ctx, unsigned int periphClk) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!periphClk) return ERR_TOOSMALL;
+    ctx->periphClk = periphClk;
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/*
+ * Cortex-A9 Private Timer Driver
+ * ------------------------------
+ *
+ * Driver for the 32-bit private timer of each Cortex-A9 core,
+ * implementing the generic timer interface (Util/driver_timer.h).
+ * The private timer is clocked from PERIPHCLK (1/4 of the MPU
+ * clock) with an 8-bit prescaler, and is read with a single
+ * load from the SCU, so has the lowest latency of the timers.
+ *
+ *    HPS_PrivateTimer_initialise(LSC_BASE_PRIV_TIM, 0, 200000000, &timer0);
+ *    Timer_configure(&timer0->timer, TIMER_MODE_EVENT, 0, UINT32_MAX);
+ *    Timer_enable(&timer0->timer, 0);
+ *    EventMgr_initialise(&timer0->timer, &evtMgr0);
+ *
+ * Per-Core Timers
+ * ---------------
+ *
+ * Each core has its own private timer at the same address, so a
+ * context is created for a given core, and the generic timer APIs
+ * and HPS_PrivateTimer APIs on it must be called from that core.
+ * Those which change the timer return ERR_WRONGMODE otherwise. The
+ * contexts for both cores may be created on CPU0 (as malloc is not
+ * safe to use from both cores), in which case the other core's timer
+ * is reset the first time it is configured.
+ *
+ * This allows each core to run its own event manager from its own
+ * timer, without sharing or locking the L4 SP timers.
+ *
+ * Interrupts
+ * ----------
+ *
+ * HPS_PrivateTimer_setCallback() registers a handler for the
+ * private timer interrupt and enables it on the calling core. The
+ * handler is shared between the cores, and calls the callback of
+ * the core which raised it. The event flag is cleared before the
+ * callback is called. On CPU1, HPS_IRQ_initialiseCpu() must have
+ * been called first.
+ *
+ * Drivers which register their own handler for the timer (e.g.
+ * EventMgr_setTickless() or VTimerMgr_initialise()) replace the
+ * shared handler, so should only be given the private timer of one
+ * core, and HPS_PrivateTimer_setCallback() should not then be used.
+ *
+ * Requires HPS_IRQ.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef HPS_PRIVATETIMER_H_
+#define HPS_PRIVATETIMER_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_timer.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Number of cores with a private timer
+#define HPS_PRIVTIMER_CPUS      2
+
+// Largest prescaler value
+#define HPS_PRIVTIMER_PRESCALER_MAX 0xFF
+
+// Private timer expiry callback
+//  - Called from the private timer interrupt on the core it belongs to.
+typedef void (*HPSPrivTimerFunc_t)(void* param);
+
+// Private Timer Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    volatile unsigned int* base;
+    TimerCtx_t         timer;      // Generic timer interface for this timer
+    unsigned int       cpu;        // Core to which the timer belongs
+    unsigned int       periphClk;  // PERIPHCLK rate in Hz
+    TimerMode          mode;
+    unsigned int       prescaler;
+    unsigned int       load;       // Configured load value
+    unsigned int       control;    // Control register value, less enable
+    bool               reset;      // Hardware reset since creation
+    HPSPrivTimerFunc_t callback;
+    void*              param;
+} HPSPrivTimerCtx_t;
+
+// Initialise the Private Timer Driver
+//  - base is a pointer to the private timer (LSC_BASE_PRIV_TIM)
+//  - cpu is the core whose private timer this is. The context can be
+//    created on either core, but must then be used from this one.
+//  - periphClk is the PERIPHCLK rate in Hz (e.g. 200E6 = 200MHz for DE1-SoC)
+//  - The timer starts stopped in one-shot mode.
+//  - Returns ERR_INUSE if a context already exists for this core.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t HPS_PrivateTimer_initialise(void* base, unsigned int cpu, unsigned int periphClk, HPSPrivTimerCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool HPS_PrivateTimer_isInitialised(HPSPrivTimerCtx_t* ctx);
+
+// Set the timer interrupt callback
+//  - callback is called from the timer interrupt each time the timer
+//    expires, with param. Pass NULL to disable the interrupt.
+//  - Registers the shared handler and enables the interrupt on this core.
+//  - Returns ERR_WRONGMODE if not called from the timer's core.
+HpsErr_t HPS_PrivateTimer_setCallback(HPSPrivTimerCtx_t* ctx, HPSPrivTimerFunc_t callback, void* param);
+
+// Change the peripheral clock rate
+//  - periphClk is the new PERIPHCLK rate in Hz, e.g. after a clock
+//    profile change (Util/clk_profile.h).
+//  - Only changes the rate reported by Timer_getRate(). Users of the
+//    timer should then reconfigure it for the new rate.
+HpsErr_t HPS_PrivateTimer_setPeriphClock(HPSPrivTimerCtx_t* ctx, unsigned int periphClk);
+
+#endif /* HPS_PRIVATETIMER_H_ */
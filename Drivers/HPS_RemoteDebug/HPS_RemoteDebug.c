@@ -0,0 +1,295 @@
+/*
+ * HPS Remote Debug Service
+ * ------------------------
+ * Description:
+ * Memory access, trace and profile export over an HPS_UARTLink
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "HPS_RemoteDebug.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+#include "Util/profile.h"
+#include "Util/macros.h"
+
+#include <string.h>
+
+//Sizes of table entries in replies
+#define REMOTEDBG_TRACE_HEADER  8
+#define REMOTEDBG_TRACE_RECORD  16
+#define REMOTEDBG_IRQ_RECORD    22
+
+/*
+ * Internal Functions
+ */
+
+//Little endian field helpers
+static inline void _RemoteDbg_put( uint8_t* dst, uint64_t val, unsigned int bytes ) {
+    for (unsigned int idx = 0; idx < bytes; idx++) {
+        dst[idx] = (uint8_t)(val >> (8 * idx));
+    }
+}
+
+static inline uint32_t _RemoteDbg_get( const uint8_t* src, unsigned int bytes ) {
+    uint32_t val = 0;
+    for (unsigned int idx = 0; idx < bytes; idx++) {
+        val |= (uint32_t)src[idx] << (8 * idx);
+    }
+    return val;
+}
+
+//Check a memory access is allowed
+static HpsErr_t _RemoteDbg_checkAccess( RemoteDbgCtx_t* ctx, uintptr_t addr, size_t len, unsigned int width, bool write ) {
+    if ((width != 1) && (width != 2) && (width != 4)) return ERR_NOSUPPORT;
+    if (!len) return ERR_TOOSMALL;
+    if ((addr | len) & (width - 1)) return ERR_ALIGNMENT;
+    for (unsigned int idx = 0; idx < ctx->numWindows; idx++) {
+        RemoteDbgWindow_t* window = &ctx->windows[idx];
+        if ((addr < window->base) || (len > window->size) || ((addr - window->base) > (window->size - len))) continue;
+        return (write && !window->writable) ? ERR_WRITEPROT : ERR_SUCCESS;
+    }
+    return ERR_OUTRANGE;
+}
+
+//Read memory
+// - Each element is read with a single load of width bytes.
+static HpsErr_t _RemoteDbg_peek( RemoteDbgCtx_t* ctx, const uint8_t* args, size_t argLen, uint8_t* reply, size_t* replyLen ) {
+    if (argLen < 7) return ERR_TOOSMALL;
+    uintptr_t addr = _RemoteDbg_get(&args[0], 4);
+    size_t len = _RemoteDbg_get(&args[4], 2);
+    unsigned int width = args[6];
+    if (len > UARTLINK_MAX_REPLY) return ERR_TOOBIG;
+    HpsErr_t status = _RemoteDbg_checkAccess(ctx, addr, len, width, false);
+    if (ERR_IS_ERROR(status)) return status;
+    for (size_t offset = 0; offset < len; offset += width) {
+        uintptr_t elem = addr + offset;
+        uint32_t val;
+        if (width == 1) {
+            val = *(volatile uint8_t*)elem;
+        } else if (width == 2) {
+            val = *(volatile uint16_t*)elem;
+        } else {
+            val = *(volatile uint32_t*)elem;
+        }
+        _RemoteDbg_put(&reply[offset], val, width);
+    }
+    *replyLen = len;
+    return ERR_SUCCESS;
+}
+
+//Write memory
+// - Each element is written with a single store of width bytes.
+static HpsErr_t _RemoteDbg_poke( RemoteDbgCtx_t* ctx, const uint8_t* args, size_t argLen ) {
+    if (argLen < 5) return ERR_TOOSMALL;
+    uintptr_t addr = _RemoteDbg_get(&args[0], 4);
+    unsigned int width = args[4];
+    const uint8_t* data = &args[5];
+    size_t len = argLen - 5;
+    HpsErr_t status = _RemoteDbg_checkAccess(ctx, addr, len, width, true);
+    if (ERR_IS_ERROR(status)) return status;
+    for (size_t offset = 0; offset < len; offset += width) {
+        uintptr_t elem = addr + offset;
+        uint32_t val = _RemoteDbg_get(&data[offset], width);
+        if (width == 1) {
+            *(volatile uint8_t*)elem = (uint8_t)val;
+        } else if (width == 2) {
+            *(volatile uint16_t*)elem = (uint16_t)val;
+        } else {
+            *(volatile uint32_t*)elem = val;
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+//Read unread trace records
+static HpsErr_t _RemoteDbg_trace( RemoteDbgCtx_t* ctx, const uint8_t* args, size_t argLen, uint8_t* reply, size_t* replyLen ) {
+    if (!ctx->trace) return ERR_NOINIT;
+    unsigned int max = (UARTLINK_MAX_REPLY - REMOTEDBG_TRACE_HEADER) / REMOTEDBG_TRACE_RECORD;
+    if (argLen >= 2) max = min(max, _RemoteDbg_get(args, 2));
+    size_t pos = REMOTEDBG_TRACE_HEADER;
+    for (unsigned int count = 0; count < max; count++) {
+        TraceRecord_t record;
+        HpsErr_t status = Trace_read(ctx->trace, &record);
+        if (status == ERR_ISEMPTY) break;
+        if (ERR_IS_ERROR(status)) return status;
+        _RemoteDbg_put(&reply[pos +  0], record.tag, 4);
+        _RemoteDbg_put(&reply[pos +  4], record.timestamp, 4);
+        _RemoteDbg_put(&reply[pos +  8], record.arg0, 4);
+        _RemoteDbg_put(&reply[pos + 12], record.arg1, 4);
+        pos += REMOTEDBG_TRACE_RECORD;
+    }
+    //Lost count covers everything skipped up to the records sent
+    _RemoteDbg_put(&reply[0], (uint32_t)Trace_getLost(ctx->trace, true), 4);
+    _RemoteDbg_put(&reply[4], ctx->trace->buffer->rate, 4);
+    *replyLen = pos;
+    return ERR_SUCCESS;
+}
+
+//Read profile section statistics
+static HpsErr_t _RemoteDbg_profile( const uint8_t* args, size_t argLen, uint8_t* reply, size_t* replyLen ) {
+    unsigned int start = (argLen >= 2) ? _RemoteDbg_get(args, 2) : 0;
+    const ProfileEvent* events;
+    unsigned int numEvents = Profile_getEvents(&events);
+    _RemoteDbg_put(&reply[2], Profile_timestampRate(), 4);
+    reply[6] = (uint8_t)numEvents;
+    size_t pos = 7;
+    for (unsigned int idx = 0; idx < numEvents; idx++) {
+        reply[pos++] = (uint8_t)events[idx];
+    }
+    //Add as many sections as fit, from start
+    unsigned int next = REMOTEDBG_END;
+    unsigned int idx = 0;
+    for (const ProfileSection_t* sect = Profile_getSections(); sect; sect = sect->next, idx++) {
+        if (idx < start) continue;
+        size_t nameLen = strlen(sect->name);
+        if (nameLen > REMOTEDBG_MAX_NAME) nameLen = REMOTEDBG_MAX_NAME;
+        size_t recLen = 29 + (8 * numEvents) + nameLen;
+        if ((pos + recLen) > UARTLINK_MAX_REPLY) {
+            next = idx;
+            break;
+        }
+        _RemoteDbg_put(&reply[pos +  0], sect->calls, 4);
+        _RemoteDbg_put(&reply[pos +  4], sect->cycles, 8);
+        _RemoteDbg_put(&reply[pos + 12], sect->calls ? sect->minCycles : 0, 4);
+        _RemoteDbg_put(&reply[pos + 16], sect->maxCycles, 4);
+        _RemoteDbg_put(&reply[pos + 20], sect->ticks, 8);
+        pos += 28;
+        for (unsigned int evt = 0; evt < numEvents; evt++) {
+            _RemoteDbg_put(&reply[pos], sect->events[evt], 8);
+            pos += 8;
+        }
+        reply[pos++] = (uint8_t)nameLen;
+        memcpy(&reply[pos], sect->name, nameLen);
+        pos += nameLen;
+    }
+    _RemoteDbg_put(&reply[0], next, 2);
+    *replyLen = pos;
+    return ERR_SUCCESS;
+}
+
+//Read IRQ handler statistics
+// - Only sources which have been handled are included.
+static HpsErr_t _RemoteDbg_irqStats( const uint8_t* args, size_t argLen, uint8_t* reply, size_t* replyLen ) {
+    unsigned int start = (argLen >= 2) ? _RemoteDbg_get(args, 2) : 0;
+    unsigned int next = REMOTEDBG_END;
+    size_t pos = 2;
+    for (unsigned int id = start; id < IRQ_SOURCE_COUNT; id++) {
+        HPSIRQStats_t stats;
+        HpsErr_t status = HPS_IRQ_getStats((HPSIRQSource)id, &stats);
+        if (ERR_IS_ERROR(status)) return status;
+        if (!stats.count) continue;
+        if ((pos + REMOTEDBG_IRQ_RECORD) > UARTLINK_MAX_REPLY) {
+            next = id;
+            break;
+        }
+        _RemoteDbg_put(&reply[pos +  0], id, 2);
+        _RemoteDbg_put(&reply[pos +  2], stats.count, 4);
+        _RemoteDbg_put(&reply[pos +  6], stats.totalCycles, 8);
+        _RemoteDbg_put(&reply[pos + 14], stats.maxCycles, 4);
+        _RemoteDbg_put(&reply[pos + 18], stats.maxLatency, 4);
+        pos += REMOTEDBG_IRQ_RECORD;
+    }
+    _RemoteDbg_put(&reply[0], next, 2);
+    *replyLen = pos;
+    return ERR_SUCCESS;
+}
+
+//Link command handler
+static HpsErr_t _RemoteDbg_command( void* param, uint16_t command, const uint8_t* args, size_t argLen, uint8_t* reply, size_t* replyLen ) {
+    RemoteDbgCtx_t* ctx = (RemoteDbgCtx_t*)param;
+    switch (command) {
+        case REMOTEDBG_CMD_PEEK:           return _RemoteDbg_peek(ctx, args, argLen, reply, replyLen);
+        case REMOTEDBG_CMD_POKE:           return _RemoteDbg_poke(ctx, args, argLen);
+        case REMOTEDBG_CMD_TRACE:          return _RemoteDbg_trace(ctx, args, argLen, reply, replyLen);
+        case REMOTEDBG_CMD_PROFILE:        return _RemoteDbg_profile(args, argLen, reply, replyLen);
+        case REMOTEDBG_CMD_PROFILE_RESET:  Profile_reset(); return ERR_SUCCESS;
+        case REMOTEDBG_CMD_IRQSTATS:       return _RemoteDbg_irqStats(args, argLen, reply, replyLen);
+        case REMOTEDBG_CMD_IRQSTATS_RESET: return HPS_IRQ_resetStats();
+        default:
+            if (command >= REMOTEDBG_CMD_BASE) return ERR_NOSUPPORT;
+            if (!ctx->userHandler) return ERR_NOSUPPORT;
+            return ctx->userHandler(ctx->userParam, command, args, argLen, reply, replyLen);
+    }
+}
+
+//Cleanup
+// - Stop handling commands from the link.
+static void _RemoteDbg_cleanup( RemoteDbgCtx_t* ctx ) {
+    if (ctx->link) UARTLink_setCommandHandler(ctx->link, NULL, NULL);
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the service
+// - Installs the service as the command handler of link.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t RemoteDbg_initialise( UARTLinkCtx_t* link, RemoteDbgCtx_t** pCtx ) {
+    //Check if the link has been initialised (required)
+    if (!UARTLink_isInitialised(link)) return ERR_BADDEVICE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_RemoteDbg_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    RemoteDbgCtx_t* ctx = *pCtx;
+    ctx->link = link;
+    ctx->numWindows = 0;
+    //Take over link commands
+    status = UARTLink_setCommandHandler(link, &_RemoteDbg_command, ctx);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool RemoteDbg_isInitialised( RemoteDbgCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Set the handler for application commands
+// - Called for commands below REMOTEDBG_CMD_BASE. May be NULL, in which
+//   case they are answered with ERR_NOSUPPORT.
+HpsErr_t RemoteDbg_setCommandHandler( RemoteDbgCtx_t* ctx, UARTLinkCommandFunc_t handler, void* param ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->userHandler = handler;
+    ctx->userParam = param;
+    return ERR_SUCCESS;
+}
+
+//Allow access to a range of memory
+// - Peek and poke are only allowed within windows. Poke also needs writable.
+// - Returns ERR_NOSPACE if REMOTEDBG_MAX_WINDOWS have been added.
+HpsErr_t RemoteDbg_addWindow( RemoteDbgCtx_t* ctx, uintptr_t base, size_t size, bool writable ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!size) return ERR_TOOSMALL;
+    if (ctx->numWindows >= REMOTEDBG_MAX_WINDOWS) return ERR_NOSPACE;
+    ctx->windows[ctx->numWindows++] = (RemoteDbgWindow_t){ .base = base, .size = size, .writable = writable };
+    return ERR_SUCCESS;
+}
+
+//Set the trace to export
+// - The service becomes the reader of trace. May be NULL.
+HpsErr_t RemoteDbg_setTrace( RemoteDbgCtx_t* ctx, TraceCtx_t* trace ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (trace && !Trace_isInitialised(trace)) return ERR_BADDEVICE;
+    ctx->trace = trace;
+    return ERR_SUCCESS;
+}
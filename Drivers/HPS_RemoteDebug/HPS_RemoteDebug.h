@@ -0,0 +1,148 @@
+/*
+ * HPS Remote Debug Service
+ * ------------------------
+ * Description:
+ * Memory access, trace and profile export over an HPS_UARTLink
+ *
+ * Adds a set of commands to a UART link so that a host tool can
+ * collect performance data from a board without a debugger attached.
+ * Unlike printing a report over semihosting, which stalls the core
+ * while the debugger services each call, the data is sent as binary
+ * response frames from the UART TX ring while the application runs.
+ *
+ * The service installs itself as the link's command handler. Commands
+ * from REMOTEDBG_CMD_BASE upwards are handled by the service, and any
+ * others are passed to the handler set with RemoteDbg_setCommandHandler().
+ *
+ *    UARTLink_initialise(uart, &link);
+ *    RemoteDbg_initialise(link, &dbg);
+ *    RemoteDbg_addWindow(dbg, 0xFF200000, 0x200000, true);  // Lightweight bridge
+ *    RemoteDbg_setTrace(dbg, trace);
+ *    while (1) {
+ *        UARTLink_process(link);
+ *        ...
+ *    }
+ *
+ * Commands
+ * --------
+ *
+ * Arguments and replies are little endian. Each reply is limited to
+ * UARTLINK_MAX_REPLY bytes, so the table commands take a starting index
+ * and return the index to ask for next, or REMOTEDBG_END when done.
+ *
+ *  Command               | Arguments                 | Reply
+ * -----------------------+---------------------------+-------------------------------------
+ *  REMOTEDBG_CMD_PEEK    | [addr:32][len:16][width:8]| [data]
+ *  REMOTEDBG_CMD_POKE    | [addr:32][width:8][data]  | -
+ *  REMOTEDBG_CMD_TRACE   | [max:16]                  | [lost:32][rate:32][record:128]...
+ *  REMOTEDBG_CMD_PROFILE | [start:16]                | [next:16][rate:32][nevt:8][evt:8]...
+ *                        |                           |   then per section [calls:32]
+ *                        |                           |   [cycles:64][min:32][max:32][ticks:64]
+ *                        |                           |   [events:64]...[nameLen:8][name]
+ *  REMOTEDBG_CMD_PROFILE_RESET | -                   | -
+ *  REMOTEDBG_CMD_IRQSTATS| [start:16]                | [next:16] then per handled source
+ *                        |                           |   [id:16][count:32][total:64][max:32]
+ *                        |                           |   [latency:32]
+ *  REMOTEDBG_CMD_IRQSTATS_RESET | -                  | -
+ *
+ * Memory is accessed with loads and stores of width (1, 2 or 4) bytes,
+ * so peripheral registers can be read and written safely. Only memory
+ * within a window added with RemoteDbg_addWindow() can be accessed, and
+ * only writable windows can be poked. By default there are no windows.
+ *
+ * Trace records are read with Trace_read(), so the service becomes the
+ * reader of the trace, and Trace_drain() must not also be used. Records
+ * are removed from the trace as they are put in the reply, so the UART TX
+ * ring should have room for a full reply frame when the host asks. Profile
+ * statistics come from Util/profile, and IRQ statistics need HPS_IRQ_STATS
+ * (otherwise the command replies ERR_NOSUPPORT).
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef HPS_REMOTEDEBUG_H_
+#define HPS_REMOTEDEBUG_H_
+
+//Include required header files
+#include "HPS_UARTLink/HPS_UARTLink.h"
+#include "Util/driver_ctx.h"
+#include "Util/trace.h"
+
+//Maximum number of memory windows
+#ifndef REMOTEDBG_MAX_WINDOWS
+#define REMOTEDBG_MAX_WINDOWS  4
+#endif
+
+//Maximum length of section names in profile replies
+#define REMOTEDBG_MAX_NAME  32
+
+//Next index returned once a table is complete
+#define REMOTEDBG_END  0xFFFF
+
+// Commands
+typedef enum {
+    REMOTEDBG_CMD_BASE           = 0xFF00,
+    REMOTEDBG_CMD_PEEK           = 0xFF00,
+    REMOTEDBG_CMD_POKE           = 0xFF01,
+    REMOTEDBG_CMD_TRACE          = 0xFF02,
+    REMOTEDBG_CMD_PROFILE        = 0xFF03,
+    REMOTEDBG_CMD_PROFILE_RESET  = 0xFF04,
+    REMOTEDBG_CMD_IRQSTATS       = 0xFF05,
+    REMOTEDBG_CMD_IRQSTATS_RESET = 0xFF06
+} RemoteDbgCommand;
+
+// Memory window
+typedef struct {
+    uintptr_t base;
+    size_t size;
+    bool writable;
+} RemoteDbgWindow_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    UARTLinkCtx_t* link;
+    TraceCtx_t* trace;
+    RemoteDbgWindow_t windows[REMOTEDBG_MAX_WINDOWS];
+    unsigned int numWindows;
+    // Handler for application commands
+    UARTLinkCommandFunc_t userHandler;
+    void* userParam;
+} RemoteDbgCtx_t;
+
+//Initialise the service
+// - Installs the service as the command handler of link.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t RemoteDbg_initialise( UARTLinkCtx_t* link, RemoteDbgCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool RemoteDbg_isInitialised( RemoteDbgCtx_t* ctx );
+
+//Set the handler for application commands
+// - Called for commands below REMOTEDBG_CMD_BASE. May be NULL, in which
+//   case they are answered with ERR_NOSUPPORT.
+HpsErr_t RemoteDbg_setCommandHandler( RemoteDbgCtx_t* ctx, UARTLinkCommandFunc_t handler, void* param );
+
+//Allow access to a range of memory
+// - Peek and poke are only allowed within windows. Poke also needs writable.
+// - Returns ERR_NOSPACE if REMOTEDBG_MAX_WINDOWS have been added.
+HpsErr_t RemoteDbg_addWindow( RemoteDbgCtx_t* ctx, uintptr_t base, size_t size, bool writable );
+
+//Set the trace to export
+// - The service becomes the reader of trace. May be NULL.
+HpsErr_t RemoteDbg_setTrace( RemoteDbgCtx_t* ctx, TraceCtx_t* trace );
+
+#endif /* HPS_REMOTEDEBUG_H_ */
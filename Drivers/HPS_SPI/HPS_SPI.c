@@ -11,6 +11,10 @@
  *
  * Date       | Changes
  * -----------+-----------------------------------
+ * 14/10/2026 | Add HPS_SPI_transferLanes for simultaneous multi-controller bursts
+ * 14/10/2026 | Add HPS_SPI_setPeriphClock for clock profile changes
+ * 14/10/2026 | Add buffer-level burst transfers
+ *            | Add queued asynchronous transactions
  * 14/01/2024 | Creation of driver
  *
  */
@@ -20,6 +24,7 @@
 #include "HPS_Watchdog/HPS_Watchdog.h"
 #include "Util/bit_helpers.h"
 #include "Util/macros.h"
+#include "Util/dma_buffer.h"
 
 #include <math.h>
 
@@ -34,13 +39,20 @@
 #define HPS_SPI_REG_MWCTRL   (0x0C/sizeof(unsigned int))
 #define HPS_SPI_REG_SLVSEL   (0x10/sizeof(unsigned int))
 #define HPS_SPI_REG_BAUDRT   (0x14/sizeof(unsigned int))
+#define HPS_SPI_REG_TXFTLR   (0x18/sizeof(unsigned int))
+#define HPS_SPI_REG_RXFTLR   (0x1C/sizeof(unsigned int))
 #define HPS_SPI_REG_TXFILL   (0x20/sizeof(unsigned int))
 #define HPS_SPI_REG_RXFILL   (0x24/sizeof(unsigned int))
 #define HPS_SPI_REG_STATUS   (0x28/sizeof(unsigned int))
+#define HPS_SPI_REG_IRQMASK  (0x2C/sizeof(unsigned int))
+#define HPS_SPI_REG_IRQSTAT  (0x30/sizeof(unsigned int))
 #define HPS_SPI_REG_CLRTXOVF (0x38/sizeof(unsigned int))
 #define HPS_SPI_REG_CLRRXOVF (0x3C/sizeof(unsigned int))
 #define HPS_SPI_REG_CLRRXUNF (0x40/sizeof(unsigned int))
 #define HPS_SPI_REG_CLRIRQS  (0x48/sizeof(unsigned int))
+#define HPS_SPI_REG_DMACTRL  (0x4C/sizeof(unsigned int))
+#define HPS_SPI_REG_DMATDLR  (0x50/sizeof(unsigned int))
+#define HPS_SPI_REG_DMARDLR  (0x54/sizeof(unsigned int))
 #define HPS_SPI_REG_DATAREG  (0x60/sizeof(unsigned int))
 #define HPS_SPI_REG_RXDLY    (0xF0/sizeof(unsigned int))
 
@@ -74,6 +86,23 @@
 #define HPS_SPI_STATUS_RXFULL  4
 #define HPS_SPI_STATUS_COLLISN 6
 
+// FIFO depth (in frames) of both TX and RX FIFOs
+#define HPS_SPI_FIFO_DEPTH 256
+
+// Max frames received after a command (EEPROM mode)
+#define HPS_SPI_FRAMES_MAX 0x10000
+
+// Interrupt flags (mask and status registers)
+#define HPS_SPI_IRQ_TXEMPTY 0
+#define HPS_SPI_IRQ_TXOVER  1
+#define HPS_SPI_IRQ_RXUNDER 2
+#define HPS_SPI_IRQ_RXOVER  3
+#define HPS_SPI_IRQ_RXFULL  4
+
+// DMA control flags
+#define HPS_SPI_DMACTRL_RDMAE 0
+#define HPS_SPI_DMACTRL_TDMAE 1
+
 // MW Control flags
 #define HPS_SPI_MWCTRL_SEQUENTIAL 0
 #define HPS_SPI_MWCTRL_DIRECTION  1
@@ -87,6 +116,8 @@
 //Check if busy, and if not disable the SPI
 // - if rxFill is true, will return RX fill level on success. Otherwise returns ERR_SUCCESS.
 static HpsErr_t _HPS_SPI_checkBusy(HPSSPICtx_t* ctx) {
+    //Controller is owned by the transaction queue while started
+    if (ctx->queue.enabled) return ERR_BUSY;
     //Can only update if SPI is disabled (i.e. not busy)
     if (ctx->base[HPS_SPI_REG_ENABLE] & _BV(HPS_SPI_ENABLE_SPIEN)) {
         //Busy if a transfer is still running
@@ -112,7 +143,7 @@ static inline HpsErr_t _HPS_SPI_checkWidth(unsigned int val, unsigned int minVal
 
 //Calculate the necessary clock divider
 // - returns false if can't find suitable rate
-static inline bool _HPS_SPI_calcDivider(HPSSPICtx_t* ctx, unsigned int clockFreq) {
+static inline bool _HPS_SPI_calcDivider(HPSSPICtx_t* ctx, HPSSPIConfig_t* config, unsigned int clockFreq) {
     //Divider is periphery clock over clock frequency, rounded up (to ensure we don't exceed clkFreq)
     unsigned int divider = CEIL_DIV(ctx->periphClk, clockFreq);
     //We also must be a multiple of 2, so round up if needed.
@@ -121,12 +152,13 @@ static inline bool _HPS_SPI_calcDivider(HPSSPICtx_t* ctx, unsigned int clockFreq
     if (!divider) return false;
     if (divider > HPS_SPI_BAUDDIV_MAX) return false;
     //Save divider value
-    ctx->config.clkDiv = divider;
+    config->clkDiv = divider;
+    config->clkFreq = clockFreq;
     return true;
 }
 
 //Set number of transfers and shift register width based on data width
-static HpsErr_t _HPS_SPI_setDataWidth(HPSSPICtx_t* ctx, unsigned int dataWidth) {
+static HpsErr_t _HPS_SPI_setDataWidth(HPSSPIConfig_t* config, unsigned int dataWidth) {
     //Width must be in range
     HpsErr_t status = _HPS_SPI_checkWidth(dataWidth, HPS_SPI_WIDTH_MIN, HPS_SPI_WIDTH_TOTAL_MAX);
     if (ERR_IS_ERROR(status)) return status;
@@ -154,9 +186,9 @@ static HpsErr_t _HPS_SPI_setDataWidth(HPSSPICtx_t* ctx, unsigned int dataWidth)
         shiftWidth = dataWidth;
     }
     //Save results
-    ctx->config.totalWidth = dataWidth;
-    ctx->config.width = shiftWidth;
-    ctx->config.xfers = xfers;
+    config->totalWidth = dataWidth;
+    config->width = shiftWidth;
+    config->xfers = xfers;
     return ERR_SUCCESS;
 }
 
@@ -177,32 +209,344 @@ static HpsErr_t _HPS_SPI_setMwCtrlWidth(HPSSPICtx_t* ctx, unsigned int mwCtrlWid
 }
 
 //Set config register. Requires SPI be disabled
-static void _HPS_SPI_configureFormat(HPSSPICtx_t* ctx) {
-    //Prepare config value
-    unsigned int config = 0;
+static void _HPS_SPI_configureFormat(HPSSPICtx_t* ctx, HPSSPIConfig_t* config) {
+    //Prepare control value
+    unsigned int control = 0;
     //Set transfer parameters. Default to TxRx mode
-    config |= ((ctx->config.width-1) & HPS_SPI_CONTROL_WIDTH_MASK) << HPS_SPI_CONTROL_WIDTH;
-    config |= (ctx->config.format & HPS_SPI_CONTROL_FORMAT_MASK) << HPS_SPI_CONTROL_FORMAT;
-    config |= (ctx->config.cpol == SPI_CPOL_HIGH ) ? _BV(HPS_SPI_CONTROL_CPOL) : 0;
-    config |= (ctx->config.cpha == SPI_CPHA_START) ? _BV(HPS_SPI_CONTROL_CPHA) : 0;
-    config |= (ctx->config.xferMode & HPS_SPI_CONTROL_XFERMODE_MASK) << HPS_SPI_CONTROL_XFERMODE;
+    control |= ((config->width-1) & HPS_SPI_CONTROL_WIDTH_MASK) << HPS_SPI_CONTROL_WIDTH;
+    control |= (config->format & HPS_SPI_CONTROL_FORMAT_MASK) << HPS_SPI_CONTROL_FORMAT;
+    control |= (config->cpol == SPI_CPOL_HIGH ) ? _BV(HPS_SPI_CONTROL_CPOL) : 0;
+    control |= (config->cpha == SPI_CPHA_START) ? _BV(HPS_SPI_CONTROL_CPHA) : 0;
+    control |= (config->xferMode & HPS_SPI_CONTROL_XFERMODE_MASK) << HPS_SPI_CONTROL_XFERMODE;
     //Only use mwCtrlWidth if in microwire mode
-    if (ctx->config.format == HPS_SPI_FORMAT_MICROWIRE) {
-        config |= ((ctx->config.mw.ctrlWidth-1) & HPS_SPI_CONTROL_WIDTH_MASK) << HPS_SPI_CONTROL_WIDTH;
+    if (config->format == HPS_SPI_FORMAT_MICROWIRE) {
+        control |= ((config->mw.ctrlWidth-1) & HPS_SPI_CONTROL_WIDTH_MASK) << HPS_SPI_CONTROL_WIDTH;
         //Also set MW control register
-        ctx->base[HPS_SPI_REG_MWCTRL] = (ctx->config.mw.seqTransfer  << HPS_SPI_MWCTRL_SEQUENTIAL) |
-                                        (ctx->config.mw.txMode       << HPS_SPI_MWCTRL_DIRECTION ) |
-                                        (ctx->config.mw.useHandshake << HPS_SPI_MWCTRL_HANDSHAKE );
+        ctx->base[HPS_SPI_REG_MWCTRL] = (config->mw.seqTransfer  << HPS_SPI_MWCTRL_SEQUENTIAL) |
+                                        (config->mw.txMode       << HPS_SPI_MWCTRL_DIRECTION ) |
+                                        (config->mw.useHandshake << HPS_SPI_MWCTRL_HANDSHAKE );
     }
     //Set baud rate
-    ctx->base[HPS_SPI_REG_BAUDRT] = ctx->config.clkDiv;
+    ctx->base[HPS_SPI_REG_BAUDRT] = config->clkDiv;
     //Update control register
-    ctx->base[HPS_SPI_REG_CONTROL] = config;
+    ctx->base[HPS_SPI_REG_CONTROL] = control;
     // Set the selected slaves
-    ctx->base[HPS_SPI_REG_SLVSEL] = ctx->config.selectedSlaves;
+    ctx->base[HPS_SPI_REG_SLVSEL] = config->selectedSlaves;
+}
+
+//Load one word into the TX FIFO as the required number of transfers
+// - Sent in reverse order as our transmission is MSB first.
+static inline void _HPS_SPI_pushWord(volatile unsigned int* base, uint64_t dataOut, unsigned int width, unsigned int xfers) {
+    unsigned int shift = width * xfers;
+    unsigned int xferMask = UINTN_MAX(width);
+    while (xfers--) {
+        shift -= width;
+        base[HPS_SPI_REG_DATAREG] = (unsigned int)(dataOut >> shift) & xferMask;
+    }
+}
+
+//Recombine one word from the required number of transfers in the RX FIFO
+static inline uint64_t _HPS_SPI_popWord(volatile unsigned int* base, unsigned int width, unsigned int xfers) {
+    unsigned int xferMask = UINTN_MAX(width);
+    uint64_t dataIn = 0;
+    while (xfers--) {
+        dataIn <<= width;
+        dataIn |= (base[HPS_SPI_REG_DATAREG] & xferMask);
+    }
+    return dataIn;
+}
+
+//Burst transfer state for one controller
+typedef struct {
+    volatile unsigned int* base;
+    const uint32_t* tx;
+    uint32_t* rx;
+    unsigned int width;
+    unsigned int xfers;
+    unsigned int stride;
+    unsigned int maxInFlight;
+    unsigned int sent;
+    unsigned int received;
+} HPSSPIBurst_t;
+
+//Set up a burst transfer
+// - Configures the controller and enables it. If holdSelect is true, slave
+//   select is left disabled so the transfer does not start until it is set.
+static void _HPS_SPI_burstStart(HPSSPICtx_t* ctx, HPSSPIBurst_t* burst, const uint32_t tx[], uint32_t rx[], bool holdSelect) {
+    //Update config register for this transfer
+    ctx->config.xferMode = rx ? HPS_SPI_XFERMODE_TXRX : HPS_SPI_XFERMODE_TXONLY;
+    _HPS_SPI_configureFormat(ctx, &ctx->config);
+    if (holdSelect) ctx->base[HPS_SPI_REG_SLVSEL] = 0;
+    //Enable SPI controller
+    ctx->base[HPS_SPI_REG_ENABLE] = _BV(HPS_SPI_ENABLE_SPIEN);
+    //Cache the configuration for the loop
+    burst->base = ctx->base;
+    burst->tx = tx;
+    burst->rx = rx;
+    burst->width = ctx->config.width;
+    burst->xfers = ctx->config.xfers;
+    burst->stride = (ctx->config.totalWidth > 32) ? 2 : 1;
+    //Limit words in flight so that the RX FIFO can't overflow
+    burst->maxInFlight = HPS_SPI_FIFO_DEPTH / burst->xfers;
+    burst->sent = 0;
+    burst->received = 0;
+}
+
+//Service a burst transfer
+// - Tops up the TX FIFO with as many words as will fit, then drains the RX FIFO.
+// - Returns true once all words have been sent (and received if reading).
+static inline bool _HPS_SPI_burstService(HPSSPIBurst_t* burst, unsigned int count) {
+    volatile unsigned int* base = burst->base;
+    unsigned int xfers = burst->xfers;
+    unsigned int stride = burst->stride;
+    //Top up the TX FIFO with as many words as will fit
+    unsigned int space = (HPS_SPI_FIFO_DEPTH - base[HPS_SPI_REG_TXFILL]) / xfers;
+    if (burst->rx) space = min(space, burst->maxInFlight - (burst->sent - burst->received));
+    space = min(space, count - burst->sent);
+    while (space--) {
+        uint64_t dataOut = 0;
+        if (burst->tx) {
+            dataOut = burst->tx[burst->sent * stride];
+            if (stride > 1) dataOut |= ((uint64_t)burst->tx[burst->sent * stride + 1]) << 32ULL;
+        }
+        _HPS_SPI_pushWord(base, dataOut, burst->width, xfers);
+        burst->sent++;
+    }
+    //Drain the RX FIFO
+    if (!burst->rx) return (burst->sent >= count);
+    unsigned int avail = base[HPS_SPI_REG_RXFILL] / xfers;
+    while (avail--) {
+        uint64_t dataIn = _HPS_SPI_popWord(base, burst->width, xfers);
+        burst->rx[burst->received * stride] = (uint32_t)dataIn;
+        if (stride > 1) burst->rx[burst->received * stride + 1] = (uint32_t)(dataIn >> 32ULL);
+        burst->received++;
+    }
+    return (burst->sent >= count) && (burst->received >= count);
+}
+
+//Number of words a transaction receives
+static inline unsigned int _HPS_SPI_xactRxCount(HPSSPITransaction_t* xact) {
+    if (xact->readCount) return xact->readCount;
+    return xact->rx ? xact->count : 0;
+}
+
+//Start a DMA transfer between a buffer and the data register
+static HpsErr_t _HPS_SPI_dmaStart(HPSSPICtx_t* ctx, HPSSPIDma_t* dma, bool tx, uintptr_t buf, unsigned int words) {
+    uintptr_t fifo = (uintptr_t)&ctx->base[HPS_SPI_REG_DATAREG];
+    dma->xfer.readAddr  = tx ? buf  : fifo;
+    dma->xfer.writeAddr = tx ? fifo : buf;
+    dma->xfer.length    = words * sizeof(uint32_t);
+    dma->xfer.isLast    = true;
+    dma->xfer.index     = tx ? 0 : 1;
+    dma->xfer.params    = dma->params;
+    dma->running = true;
+    HpsErr_t status = DmaBuffer_setupTransfer(dma->dma, &dma->xfer, true);
+    if ((status == ERR_SKIPPED) || ERR_IS_ERROR(status)) dma->running = false;
+    return status;
+}
+
+//Start the transaction at the head of the queue
+// - Must be called with IRQs masked.
+static HpsErr_t _HPS_SPI_queueStart(HPSSPICtx_t* ctx, HPSSPITransaction_t* xact) {
+    volatile unsigned int* base = ctx->base;
+    unsigned int xfers = xact->config.xfers;
+    unsigned int rxCount = _HPS_SPI_xactRxCount(xact);
+    bool txDma = xact->useDma && !xact->readCount;
+    bool rxDma = xact->useDma && rxCount;
+    xact->sent = 0;
+    xact->received = 0;
+    //Apply the format of this transaction
+    base[HPS_SPI_REG_ENABLE] = 0;
+    base[HPS_SPI_REG_IRQMASK] = 0;
+    _HPS_SPI_configureFormat(ctx, &xact->config);
+    if (xact->readCount) {
+        base[HPS_SPI_REG_FRAMES] = (xact->readCount * xfers) - 1;
+    }
+    //Interrupt when the TX FIFO is half empty, and when the RX FIFO holds the rest of the
+    //transaction (or is half full)
+    base[HPS_SPI_REG_TXFTLR] = HPS_SPI_FIFO_DEPTH / 2;
+    if (rxCount) {
+        base[HPS_SPI_REG_RXFTLR] = min(rxCount * xfers, HPS_SPI_FIFO_DEPTH / 2) - 1;
+    }
+    //DMA requests when the TX FIFO is half empty, and for every RX frame
+    base[HPS_SPI_REG_DMATDLR] = HPS_SPI_FIFO_DEPTH / 2;
+    base[HPS_SPI_REG_DMARDLR] = 0;
+    base[HPS_SPI_REG_DMACTRL] = (txDma ? _BV(HPS_SPI_DMACTRL_TDMAE) : 0) |
+                                (rxDma ? _BV(HPS_SPI_DMACTRL_RDMAE) : 0);
+    (void)base[HPS_SPI_REG_CLRIRQS];
+    base[HPS_SPI_REG_ENABLE] = _BV(HPS_SPI_ENABLE_SPIEN);
+    ctx->queue.active = true;
+    //Start the DMA, receive first so that it is ready for the data
+    HpsErr_t status;
+    if (rxDma) {
+        status = _HPS_SPI_dmaStart(ctx, &ctx->rxDma, false, (uintptr_t)xact->rx, rxCount);
+        if (ERR_IS_ERROR(status)) return status;
+        if (status == ERR_SKIPPED) xact->received = rxCount;
+    }
+    if (txDma) {
+        status = _HPS_SPI_dmaStart(ctx, &ctx->txDma, true, (uintptr_t)xact->tx, xact->count);
+        if (ERR_IS_ERROR(status)) return status;
+        if (status == ERR_SKIPPED) xact->sent = xact->count;
+    }
+    //Commands are loaded all at once, as the read starts when the TX FIFO empties
+    if (xact->readCount) {
+        for (unsigned int idx = 0; idx < xact->count; idx++) {
+            _HPS_SPI_pushWord(base, xact->tx[idx], xact->config.width, xfers);
+        }
+        xact->sent = xact->count;
+    }
+    //Interrupts for whatever is serviced by the CPU. The TX empty interrupt also
+    //detects the end of write-only transactions once everything is sent.
+    unsigned int mask = _BV(HPS_SPI_IRQ_RXOVER);
+    if (!rxDma && rxCount) mask |= _BV(HPS_SPI_IRQ_RXFULL);
+    if (xact->sent < xact->count) {
+        if (!txDma) mask |= _BV(HPS_SPI_IRQ_TXEMPTY);
+    } else if (!rxCount) {
+        mask |= _BV(HPS_SPI_IRQ_TXEMPTY);
+    }
+    base[HPS_SPI_REG_IRQMASK] = mask;
+    return ERR_SUCCESS;
+}
+
+//Stop the running transaction, and remove it from the queue
+// - Calls the callback with the result.
+// - Must be called with IRQs masked.
+static void _HPS_SPI_queuePop(HPSSPICtx_t* ctx, HpsErr_t result) {
+    //Stop the controller and any DMA
+    ctx->base[HPS_SPI_REG_IRQMASK] = 0;
+    ctx->base[HPS_SPI_REG_DMACTRL] = 0;
+    ctx->base[HPS_SPI_REG_ENABLE] = 0;
+    if (ctx->txDma.running) {
+        DMA_abortTransfer(ctx->txDma.dma, DMA_ABORT_FORCE);
+        ctx->txDma.running = false;
+    }
+    if (ctx->rxDma.running) {
+        DMA_abortTransfer(ctx->rxDma.dma, DMA_ABORT_FORCE);
+        ctx->rxDma.running = false;
+    }
+    ctx->queue.active = false;
+    //Remove from the queue before the callback, so that it may queue more
+    HPSSPITransaction_t* xact = ctx->queue.head;
+    if (!xact) return;
+    ctx->queue.head = xact->next;
+    if (!ctx->queue.head) ctx->queue.tail = NULL;
+    xact->next = NULL;
+    if (xact->callback) xact->callback(xact, result, xact->param);
+}
+
+//Start the next queued transaction if idle
+// - Transactions which fail to start are removed with their error.
+// - Must be called with IRQs masked.
+static void _HPS_SPI_queueNext(HPSSPICtx_t* ctx) {
+    while (ctx->queue.head && !ctx->queue.active) {
+        HpsErr_t status = _HPS_SPI_queueStart(ctx, ctx->queue.head);
+        if (ERR_IS_ERROR(status)) _HPS_SPI_queuePop(ctx, status);
+    }
+}
+
+//Progress the running transaction
+// - Moves data between the buffers and FIFOs for directions not using DMA, and
+//   completes the transaction once done.
+// - Must be called with IRQs masked.
+static void _HPS_SPI_queueService(HPSSPICtx_t* ctx, HPSSPITransaction_t* xact) {
+    volatile unsigned int* base = ctx->base;
+    unsigned int width = xact->config.width;
+    unsigned int xfers = xact->config.xfers;
+    unsigned int stride = (xact->config.totalWidth > 32) ? 2 : 1;
+    unsigned int rxCount = _HPS_SPI_xactRxCount(xact);
+    //Drain the RX FIFO
+    if (rxCount && !xact->useDma) {
+        unsigned int avail = min(base[HPS_SPI_REG_RXFILL] / xfers, rxCount - xact->received);
+        while (avail--) {
+            uint64_t dataIn = _HPS_SPI_popWord(base, width, xfers);
+            xact->rx[xact->received * stride] = (uint32_t)dataIn;
+            if (stride > 1) xact->rx[xact->received * stride + 1] = (uint32_t)(dataIn >> 32ULL);
+            xact->received++;
+        }
+    }
+    //Top up the TX FIFO, limiting words in flight so that the RX FIFO can't overflow
+    if (!xact->useDma && (xact->sent < xact->count)) {
+        unsigned int space = (HPS_SPI_FIFO_DEPTH - base[HPS_SPI_REG_TXFILL]) / xfers;
+        if (rxCount) space = min(space, (HPS_SPI_FIFO_DEPTH / xfers) - (xact->sent - xact->received));
+        space = min(space, xact->count - xact->sent);
+        while (space--) {
+            uint64_t dataOut = 0;
+            if (xact->tx) {
+                dataOut = xact->tx[xact->sent * stride];
+                if (stride > 1) dataOut |= ((uint64_t)xact->tx[xact->sent * stride + 1]) << 32ULL;
+            }
+            _HPS_SPI_pushWord(base, dataOut, width, xfers);
+            xact->sent++;
+        }
+    }
+    if (rxCount) {
+        //Done once everything is received, and the TX DMA (if any) has reported done
+        if ((xact->received >= rxCount) && !ctx->txDma.running) {
+            _HPS_SPI_queuePop(ctx, ERR_SUCCESS);
+            _HPS_SPI_queueNext(ctx);
+            return;
+        }
+        //Otherwise interrupt once the rest has arrived
+        if (!xact->useDma) {
+            base[HPS_SPI_REG_RXFTLR] = min((rxCount - xact->received) * xfers, HPS_SPI_FIFO_DEPTH / 2) - 1;
+        }
+        if (xact->sent >= xact->count) {
+            base[HPS_SPI_REG_IRQMASK] &= ~_BV(HPS_SPI_IRQ_TXEMPTY);
+        }
+    } else if (xact->sent >= xact->count) {
+        //Write-only is done once the FIFO has drained and the last frame is sent.
+        if (!base[HPS_SPI_REG_TXFILL]) {
+            while (base[HPS_SPI_REG_STATUS] & _BV(HPS_SPI_STATUS_BUSY));
+            _HPS_SPI_queuePop(ctx, ERR_SUCCESS);
+            _HPS_SPI_queueNext(ctx);
+            return;
+        }
+        //Otherwise interrupt once empty
+        base[HPS_SPI_REG_TXFTLR] = 0;
+        base[HPS_SPI_REG_IRQMASK] |= _BV(HPS_SPI_IRQ_TXEMPTY);
+    }
+}
+
+//Transaction queue interrupt handler
+static __irq void _HPS_SPI_queueIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    HPSSPICtx_t* ctx = (HPSSPICtx_t*)param;
+    if (!ctx) return;
+    unsigned int irqs = ctx->base[HPS_SPI_REG_IRQSTAT];
+    if (!irqs) return;
+    *handled = true;
+    if (!ctx->queue.active) {
+        ctx->base[HPS_SPI_REG_IRQMASK] = 0;
+        return;
+    }
+    //Received data was lost
+    if (irqs & _BV(HPS_SPI_IRQ_RXOVER)) {
+        (void)ctx->base[HPS_SPI_REG_CLRIRQS];
+        _HPS_SPI_queuePop(ctx, ERR_IOFAIL);
+        _HPS_SPI_queueNext(ctx);
+        return;
+    }
+    _HPS_SPI_queueService(ctx, ctx->queue.head);
+}
+
+//Stop the transaction queue
+// - Aborts running and queued transactions.
+static void _HPS_SPI_stopQueue(HPSSPICtx_t* ctx) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    ctx->queue.enabled = false;
+    while (ctx->queue.head) {
+        _HPS_SPI_queuePop(ctx, ERR_ABORTED);
+    }
+    //Make sure stopped if no transaction was running
+    _HPS_SPI_queuePop(ctx, ERR_ABORTED);
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    HPS_IRQ_unregisterHandler(ctx->queue.irqID);
 }
 
 static void _HPS_SPI_cleanup(HPSSPICtx_t* ctx) {
+    //Stop the transaction queue
+    if (ctx->queue.enabled) {
+        _HPS_SPI_stopQueue(ctx);
+    }
     //Disable the SPI controller.
     if (ctx->base) {
         ctx->base[HPS_SPI_REG_ENABLE] = 0x0;
@@ -255,7 +599,7 @@ HpsErr_t HPS_SPI_initialise(void* base, unsigned int periphClk, HPSSPIFormat for
     ctx->config.clkDiv = 0; //Clock disabled by default
     ctx->config.mw.ctrlWidth = 0;
     //Validate data and MW control widths
-    status = _HPS_SPI_setDataWidth(ctx, 8);
+    status = _HPS_SPI_setDataWidth(&ctx->config, 8);
     if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
     status =_HPS_SPI_setMwCtrlWidth(ctx, 0);
     if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
@@ -286,9 +630,9 @@ HpsErr_t HPS_SPI_configureFormat(HPSSPICtx_t* ctx, SpiSCLKPolarity cpol, SpiSCLK
     //Can't be busy
     if (ERR_IS_BUSY(_HPS_SPI_checkBusy(ctx))) return ERR_BUSY;
     //Calculate clock divider
-    if (!_HPS_SPI_calcDivider(ctx, clkFreq)) return ERR_NOSUPPORT;
+    if (!_HPS_SPI_calcDivider(ctx, &ctx->config, clkFreq)) return ERR_NOSUPPORT;
     //Set widths
-    status = _HPS_SPI_setDataWidth(ctx, dataWidth);
+    status = _HPS_SPI_setDataWidth(&ctx->config, dataWidth);
     if (ERR_IS_ERROR(status)) return status;
     status = _HPS_SPI_setMwCtrlWidth(ctx, mwCtrlWidth);
     if (ERR_IS_ERROR(status)) return status;
@@ -311,13 +655,34 @@ HpsErr_t HPS_SPI_setClockMode(HPSSPICtx_t* ctx, SpiSCLKPolarity cpol, SpiSCLKPha
     return ERR_SUCCESS;
 }
 
+// Change the peripheral clock rate
+// - periphClk is the new peripheral clock rate in Hz, e.g. after a clock
+//   profile change (Util/clk_profile.h).
+// - The clock divider is recalculated for the last requested SPI clock rate.
+//   Queued transactions with their own clkFreq are recalculated as they start.
+// - Returns ERR_BUSY if a transfer is in progress.
+HpsErr_t HPS_SPI_setPeriphClock(HPSSPICtx_t* ctx, unsigned int periphClk) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!periphClk) return ERR_TOOSMALL;
+    //Can't be busy
+    if (ctx->queue.active || ERR_IS_BUSY(_HPS_SPI_checkBusy(ctx))) return ERR_BUSY;
+    ctx->periphClk = periphClk;
+    //Recalculate the divider. If the old rate is now too slow to reach, use the slowest.
+    if (ctx->config.clkFreq && !_HPS_SPI_calcDivider(ctx, &ctx->config, ctx->config.clkFreq)) {
+        ctx->config.clkDiv = HPS_SPI_BAUDDIV_MAX & ~1U;
+    }
+    return ERR_SUCCESS;
+}
+
 //Change the SPI data width
 // - Change the data width without changing other formats
 HpsErr_t HPS_SPI_setDataWidth(HPSSPICtx_t* ctx, unsigned int dataWidth) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    return _HPS_SPI_setDataWidth(ctx, dataWidth);
+    return _HPS_SPI_setDataWidth(&ctx->config, dataWidth);
 }
 
 //Check if ready to write
@@ -344,7 +709,7 @@ HpsErr_t HPS_SPI_writeData(HPSSPICtx_t* ctx, uint32_t laneMask, uint32_t* data,
     if (ERR_IS_BUSY(_HPS_SPI_checkBusy(ctx))) return ERR_BUSY;
     //Update config register for this transfer
     ctx->config.xferMode = (type == SPI_TYPE_READWRITE) ? HPS_SPI_XFERMODE_TXRX : HPS_SPI_XFERMODE_TXONLY;
-    _HPS_SPI_configureFormat(ctx);
+    _HPS_SPI_configureFormat(ctx, &ctx->config);
     //Enable SPI controller
     ctx->base[HPS_SPI_REG_ENABLE] = _BV(HPS_SPI_ENABLE_SPIEN);
     //Split the data word into the number of width-bit transfers
@@ -369,6 +734,74 @@ HpsErr_t HPS_SPI_writeData(HPSSPICtx_t* ctx, uint32_t laneMask, uint32_t* data,
     return ERR_SUCCESS;
 }
 
+//Perform a burst transfer of multiple words
+// - Only one lane.
+// - tx is the data to send, or NULL to send zeros (read-only).
+// - rx is where to store read data, or NULL to discard (write-only).
+// - count is the number of words. For data widths between 33 and 64, each
+//   word is two 32-bit entries in tx/rx, as for HPS_SPI_writeData().
+// - Blocks until all words have been read, or for write-only until all words
+//   have been loaded into the TX FIFO (use HPS_SPI_writeReady() to wait for idle).
+// - Returns ERR_BUSY if a previous transfer is still running.
+HpsErr_t HPS_SPI_transfer(HPSSPICtx_t* ctx, const uint32_t tx[], uint32_t rx[], unsigned int count) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!count) return ERR_SUCCESS;
+    //Can't be busy
+    if (ERR_IS_BUSY(_HPS_SPI_checkBusy(ctx))) return ERR_BUSY;
+    //Run the transfer
+    HPSSPIBurst_t burst;
+    _HPS_SPI_burstStart(ctx, &burst, tx, rx, false);
+    while (!_HPS_SPI_burstService(&burst, count));
+    return ERR_SUCCESS;
+}
+
+//Perform a burst transfer on several controllers at once
+// - laneMask selects which entries of lanes, tx and rx are used. Bit n is lanes[n].
+// - Each lane is configured with its own format and slave select, as for HPS_SPI_transfer().
+// - tx[n] is the data to send on lane n, or NULL to send zeros. tx may be NULL
+//   for all lanes to send zeros.
+// - rx[n] is where to store read data from lane n, or NULL to discard. rx may
+//   be NULL for all lanes to be write-only.
+// - count is the number of words for every lane.
+// - Blocks until all lanes are complete, as for HPS_SPI_transfer().
+// - Returns ERR_BUSY if a previous transfer is still running on any lane.
+HpsErr_t HPS_SPI_transferLanes(HPSSPICtx_t* const lanes[], uint32_t laneMask, const uint32_t* const tx[], uint32_t* const rx[], unsigned int count) {
+    if (!lanes) return ERR_NULLPTR;
+    if (laneMask & ~UINTN_MAX(HPS_SPI_MAX_LANES)) return ERR_BADID;
+    //Ensure every lane is valid, initialised and not busy before starting any
+    for (unsigned int lane = 0; lane < HPS_SPI_MAX_LANES; lane++) {
+        if (!(laneMask & _BV(lane))) continue;
+        HpsErr_t status = DriverContextValidate(lanes[lane]);
+        if (ERR_IS_ERROR(status)) return status;
+        if (ERR_IS_BUSY(_HPS_SPI_checkBusy(lanes[lane]))) return ERR_BUSY;
+    }
+    if (!count || !laneMask) return ERR_SUCCESS;
+    //Configure each lane and preload its TX FIFO with slave select held off
+    HPSSPIBurst_t bursts[HPS_SPI_MAX_LANES];
+    unsigned int pending = 0;
+    for (unsigned int lane = 0; lane < HPS_SPI_MAX_LANES; lane++) {
+        if (!(laneMask & _BV(lane))) continue;
+        _HPS_SPI_burstStart(lanes[lane], &bursts[lane], tx ? tx[lane] : NULL, rx ? rx[lane] : NULL, true);
+        _HPS_SPI_burstService(&bursts[lane], count);
+        pending |= _BV(lane);
+    }
+    //Start all lanes together
+    for (unsigned int lane = 0; lane < HPS_SPI_MAX_LANES; lane++) {
+        if (!(pending & _BV(lane))) continue;
+        lanes[lane]->base[HPS_SPI_REG_SLVSEL] = lanes[lane]->config.selectedSlaves;
+    }
+    //Service the FIFOs round-robin until every lane is done
+    while (pending) {
+        for (unsigned int lane = 0; lane < HPS_SPI_MAX_LANES; lane++) {
+            if (!(pending & _BV(lane))) continue;
+            if (_HPS_SPI_burstService(&bursts[lane], count)) pending &= ~_BV(lane);
+        }
+    }
+    return ERR_SUCCESS;
+}
+
 //Check if there is any data in the read FIFO
 // - Only one lane. Ignores bits higher than 0 in lane mask.
 // - Returns the number of available words on success.
@@ -376,6 +809,8 @@ HpsErr_t HPS_SPI_readReady(HPSSPICtx_t* ctx, uint32_t laneMask) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    //FIFO is owned by the transaction queue while started
+    if (ctx->queue.enabled) return 0;
     //Return the number of full words available, accounting for transfers per word
     return ctx->base[HPS_SPI_REG_RXFILL] / ctx->config.xfers;
 }
@@ -388,6 +823,8 @@ HpsErr_t HPS_SPI_readData(HPSSPICtx_t* ctx, uint32_t laneMask, uint32_t* data) {
     if (ERR_IS_ERROR(status)) return status;
     if (!laneMask) return ERR_SUCCESS;
     if (!data) return ERR_NULLPTR;
+    //FIFO is owned by the transaction queue while started
+    if (ctx->queue.enabled) return ERR_BUSY;
     //Ensure there are enough words in the incoming FIFO
     unsigned int xfers = ctx->config.xfers;
     if (ctx->base[HPS_SPI_REG_RXFILL] < xfers) return ERR_AGAIN;
@@ -457,3 +894,154 @@ HpsErr_t HPS_SPI_abort(HPSSPICtx_t* ctx) {
     return ERR_SUCCESS;
 }
 
+//Start the transaction queue
+// - irqID is the interrupt of this SPI controller (e.g. IRQ_SPI0).
+// - Requires HPS_IRQ to be initialised.
+// - Returns ERR_BUSY if a transfer is still running, or already started.
+HpsErr_t HPS_SPI_startQueue(HPSSPICtx_t* ctx, HPSIRQSource irqID) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't be busy, which includes already started
+    if (ERR_IS_BUSY(_HPS_SPI_checkBusy(ctx))) return ERR_BUSY;
+    //Register the interrupt handler
+    ctx->base[HPS_SPI_REG_IRQMASK] = 0;
+    status = HPS_IRQ_registerHandler(irqID, &_HPS_SPI_queueIsr, ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->queue.irqID = irqID;
+    ctx->queue.active = false;
+    ctx->queue.head = NULL;
+    ctx->queue.tail = NULL;
+    ctx->queue.enabled = true;
+    return ERR_SUCCESS;
+}
+
+//Stop the transaction queue
+// - Any running or queued transactions are aborted, with their callbacks
+//   called with ERR_ABORTED.
+// - Returns ERR_SKIPPED if not started.
+HpsErr_t HPS_SPI_stopQueue(HPSSPICtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->queue.enabled) return ERR_SKIPPED;
+    _HPS_SPI_stopQueue(ctx);
+    return ERR_SUCCESS;
+}
+
+//Queue a transaction
+// - The transaction is started immediately if the queue is idle, otherwise once
+//   those before it are done. It must remain valid until done.
+// - Returns ERR_WRONGMODE if the queue has not been started.
+// - Returns ERR_TOOBIG if a command (readCount > 0) does not fit in the FIFO.
+HpsErr_t HPS_SPI_queueTransaction(HPSSPICtx_t* ctx, HPSSPITransaction_t* xact) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!xact) return ERR_NULLPTR;
+    if (!ctx->queue.enabled) return ERR_WRONGMODE;
+    if (!xact->count) return ERR_TOOSMALL;
+    if (!xact->tx && !xact->rx) return ERR_NULLPTR;
+    //Work out the format from the current config and the transaction
+    HPSSPIConfig_t* config = &xact->config;
+    *config = ctx->config;
+    if (xact->clkFreq && !_HPS_SPI_calcDivider(ctx, config, xact->clkFreq)) return ERR_NOSUPPORT;
+    if (!config->clkDiv) return ERR_NOSUPPORT;
+    if (xact->dataWidth) {
+        status = _HPS_SPI_setDataWidth(config, xact->dataWidth);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    config->cpol = xact->cpol;
+    config->cpha = xact->cpha;
+    config->selectedSlaves = xact->slaves & HPS_SPI_SS_MASK;
+    if (xact->readCount) {
+        //Command must fit in the FIFO, and be followed by a limited number of frames.
+        if (!xact->tx || !xact->rx) return ERR_NULLPTR;
+        if ((xact->count * config->xfers) > HPS_SPI_FIFO_DEPTH) return ERR_TOOBIG;
+        if ((xact->readCount * config->xfers) > HPS_SPI_FRAMES_MAX) return ERR_TOOBIG;
+        config->xferMode = HPS_SPI_XFERMODE_EEPROM;
+    } else {
+        config->xferMode = xact->rx ? HPS_SPI_XFERMODE_TXRX : HPS_SPI_XFERMODE_TXONLY;
+    }
+    //DMA is used for single frame words if there is a controller for each direction
+    //the CPU would otherwise service. Sending zeros is left to the CPU.
+    bool txNeeded = !xact->readCount;
+    bool rxNeeded = (xact->rx != NULL);
+    xact->useDma = (config->xfers == 1) &&
+                   (!txNeeded || (xact->tx && ctx->txDma.dma)) &&
+                   (!rxNeeded || ctx->rxDma.dma);
+    //Add to the queue, starting if idle
+    xact->next = NULL;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (ctx->queue.tail) {
+        ctx->queue.tail->next = xact;
+    } else {
+        ctx->queue.head = xact;
+    }
+    ctx->queue.tail = xact;
+    _HPS_SPI_queueNext(ctx);
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+//Check if the transaction queue is idle
+// - Returns ERR_SUCCESS if all queued transactions are done.
+// - Returns ERR_BUSY if any are queued or running.
+HpsErr_t HPS_SPI_queueIdle(HPSSPICtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return ctx->queue.head ? ERR_BUSY : ERR_SUCCESS;
+}
+
+//Assign a DMA controller for queued transactions
+// - tx selects whether this is for the TX (true) or RX (false) direction.
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transaction is running.
+HpsErr_t HPS_SPI_setDma(HPSSPICtx_t* ctx, bool tx, DmaCtx_t* dma, void* dmaParams) {
+    if (dma && !DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't change while transactions are queued
+    if (ctx->queue.head) return ERR_BUSY;
+    HPSSPIDma_t* dmaState = tx ? &ctx->txDma : &ctx->rxDma;
+    dmaState->dma = dma;
+    dmaState->params = dmaParams;
+    return ERR_SUCCESS;
+}
+
+//Signal that a DMA transfer has completed
+// - Must be called from the DMA completion callback, passing the callback result.
+// - tx selects whether this is the TX (true) or RX (false) direction.
+// - Returns the result, or ERR_SKIPPED if no transfer was running.
+HpsErr_t HPS_SPI_dmaCompleted(HPSSPICtx_t* ctx, bool tx, HpsErr_t result) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    HPSSPIDma_t* dma = tx ? &ctx->txDma : &ctx->rxDma;
+    HPSSPITransaction_t* xact = ctx->queue.head;
+    if (!dma->running || !ctx->queue.active || !xact) {
+        HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+        return ERR_SKIPPED;
+    }
+    dma->running = false;
+    if (ERR_IS_ERROR(result)) {
+        //Failed, so move on to the next transaction
+        _HPS_SPI_queuePop(ctx, result);
+        _HPS_SPI_queueNext(ctx);
+    } else {
+        //Completion maintenance, then mark that direction as done
+        DmaBuffer_complete(&dma->xfer);
+        if (tx) {
+            xact->sent = xact->count;
+        } else {
+            xact->received = _HPS_SPI_xactRxCount(xact);
+        }
+        _HPS_SPI_queueService(ctx, xact);
+    }
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return result;
+}
@@ -4,6 +4,70 @@
  *
  * Driver for the HPS embedded SPI controller
  *
+ * Burst Transfers
+ * ---------------
+ *
+ * HPS_SPI_writeData()/HPS_SPI_readData() transfer one word per
+ * call, which is too slow to keep the bus busy at high clock
+ * rates. HPS_SPI_transfer() instead moves a whole buffer of words,
+ * keeping the TX FIFO topped up and draining the RX FIFO in a
+ * tight loop, so that slave select remains asserted throughout
+ * and the clock runs back-to-back.
+ *
+ * Each HPS_SPI context is a single controller (lane), but several
+ * controllers (e.g. SPI master 0 and 1, or further instances of the
+ * same IP in the FPGA) can be run together with HPS_SPI_transferLanes(),
+ * e.g. to sample ADCs on different buses at the same instant. Bit n of
+ * laneMask selects lanes[n], each with its own tx and rx buffers. The
+ * TX FIFOs are loaded while slave select is held off, then slave select
+ * is enabled for each lane back to back, so the transfers start within a
+ * few bus cycles of each other. The FIFOs are then serviced round-robin
+ * until every lane is complete.
+ *
+ * Transaction Queue
+ * -----------------
+ *
+ * For devices sharing the bus, transactions can instead be queued
+ * and run back-to-back in the background. Start the queue with
+ * HPS_SPI_startQueue(), which registers the SPI interrupt with
+ * HPS_IRQ, then queue HPSSPITransaction_t entries with
+ * HPS_SPI_queueTransaction(). Each entry holds its own slave
+ * select mask, clock mode, clock rate and data width, which are
+ * applied automatically when the transaction starts, so devices
+ * with different formats can be mixed. The entries are owned by
+ * the caller, and must remain valid until their callback has been
+ * called (or HPS_SPI_queueIdle() returns success).
+ *
+ * Each entry transfers count words from tx while receiving into
+ * rx, as for HPS_SPI_transfer(). If readCount is non-zero, the
+ * count words from tx are instead a command (e.g. a flash read
+ * command and address), after which readCount words are received
+ * into rx with slave select held throughout. Commands must fit in
+ * the FIFO (256 frames).
+ *
+ * The optional callback is called from the SPI interrupt (or from
+ * HPS_SPI_dmaCompleted()) once the transaction is done, and may
+ * queue further transactions. While the queue is started, the
+ * polled APIs return ERR_BUSY.
+ *
+ * DMA can be used for the data by assigning a DMA controller to
+ * each direction with HPS_SPI_setDma(). It is used for entries
+ * with data widths up to 16 bits where the controllers for the
+ * directions needed are assigned; others are serviced by the
+ * interrupt. For HPS_DMAController, allocate a channel for each
+ * direction and pass its chCtx->dma, with dmaParams set up with
+ * HPS_DMA_initParameters() and then:
+ *
+ *  - transferWidth set to HPS_DMA_BURSTSIZE_4BYTE.
+ *  - For TX, destType HPS_DMA_DESTINATION_PERIPH, periph set to
+ *    HPS_DMA_PERIPH_SPI0_MASTER_TX (or SPI1), and periphBurstLen 16.
+ *  - For RX, srcType HPS_DMA_SOURCE_PERIPH, periph set to
+ *    HPS_DMA_PERIPH_SPI0_MASTER_RX (or SPI1), and periphBurstLen 1.
+ *
+ * and set a callback for each channel with HPS_DMA_setCallbackCh()
+ * which calls HPS_SPI_dmaCompleted(), as the queue is advanced by
+ * the DMA completion.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -11,6 +75,10 @@
  *
  * Date       | Changes
  * -----------+-----------------------------------
+ * 14/10/2026 | Add HPS_SPI_transferLanes for simultaneous multi-controller bursts
+ * 14/10/2026 | Add HPS_SPI_setPeriphClock for clock profile changes
+ * 14/10/2026 | Add buffer-level burst transfers
+ *            | Add queued asynchronous transactions
  * 14/01/2024 | Creation of driver
  *
  */
@@ -22,6 +90,8 @@
 #include <stdbool.h>
 
 #include "Util/driver_spi.h"
+#include "Util/driver_dma.h"
+#include "HPS_IRQ/HPS_IRQ.h"
 
 // SPI Formats
 typedef enum {
@@ -37,6 +107,9 @@ enum {
     HPS_SPI_WIDTH_TOTAL_MAX = 64  // Max width of a transfer. Widths > SHIFT_MAX will be performed as multiple transfers
 };
 
+// Maximum number of controllers in HPS_SPI_transferLanes()
+#define HPS_SPI_MAX_LANES 4
+
 // SPI Micro-wire control widths
 enum {
     HPS_SPI_MW_CNTRL_MIN = 1,
@@ -47,9 +120,69 @@ enum {
 typedef enum {
     HPS_SPI_XFERMODE_TXRX   = 0x0,
     HPS_SPI_XFERMODE_TXONLY = 0x1,
-    HPS_SPI_XFERMODE_RXONLY = 0x2
+    HPS_SPI_XFERMODE_RXONLY = 0x2,
+    HPS_SPI_XFERMODE_EEPROM = 0x3
 } HPSSPIXferMode;
 
+// Transfer Config (internal)
+typedef struct {
+    // General
+    unsigned int    totalWidth;
+    unsigned int    width;
+    unsigned int    xfers;
+    HPSSPIFormat    format;
+    SpiSCLKPolarity cpol;
+    SpiSCLKPhase    cpha;
+    unsigned int    selectedSlaves;
+    HPSSPIXferMode  xferMode;
+    unsigned int    clkDiv;
+    unsigned int    clkFreq;    // Requested clock rate that clkDiv was calculated for
+    // Microwire
+    struct {
+        unsigned int ctrlWidth;
+        bool         seqTransfer;
+        bool         useHandshake;
+        bool         txMode;
+    } mw;
+} HPSSPIConfig_t;
+
+// Queued transaction
+typedef struct _HPSSPITransaction_t HPSSPITransaction_t;
+
+// Transaction completion callback
+//  - result is ERR_SUCCESS if the transaction completed, or an error code if it
+//    failed or was aborted. param is the value from the transaction.
+typedef void (*HPSSPITransactionCallback_t)(HPSSPITransaction_t* xact, HpsErr_t result, void* param);
+
+struct _HPSSPITransaction_t {
+    // Set by user
+    uint32_t                    slaves;     // Slave select mask, bits 0-3
+    SpiSCLKPolarity             cpol;
+    SpiSCLKPhase                cpha;
+    unsigned int                clkFreq;    // Max SPI clock rate in Hz, or 0 to use the current rate
+    unsigned int                dataWidth;  // Bits per word, or 0 to use the current width
+    const uint32_t*             tx;         // Data to send, or NULL to send zeros
+    uint32_t*                   rx;         // Where to store read data, or NULL to discard
+    unsigned int                count;      // Number of words to send
+    unsigned int                readCount;  // Number of words to read after sending, or 0 to read while sending
+    HPSSPITransactionCallback_t callback;   // Optional completion callback
+    void*                       param;      // Parameter for the callback
+    // Internal
+    struct _HPSSPITransaction_t* next;
+    HPSSPIConfig_t               config;
+    bool                         useDma;
+    unsigned int                 sent;
+    unsigned int                 received;
+};
+
+// DMA transfer state for one direction
+typedef struct {
+    DmaCtx_t* dma;          // DMA controller, or NULL if not assigned
+    void* params;           // Optional DMA controller parameters
+    DmaChunk_t xfer;
+    bool running;
+} HPSSPIDma_t;
+
 // Driver context
 typedef struct {
     // Context Header
@@ -60,25 +193,17 @@ typedef struct {
     // SPI common interface
     SpiCtx_t spi;
     // Transfer Config
+    HPSSPIConfig_t config;
+    // Transaction Queue
     struct {
-        // General
-        unsigned int    totalWidth;
-        unsigned int    width;
-        unsigned int    xfers;
-        HPSSPIFormat    format;
-        SpiSCLKPolarity cpol;
-        SpiSCLKPhase    cpha;
-        unsigned int    selectedSlaves;
-        HPSSPIXferMode  xferMode;
-        unsigned int    clkDiv;
-        // Microwire
-        struct {
-            unsigned int ctrlWidth;
-            bool         seqTransfer;
-            bool         useHandshake;
-            bool         txMode;
-        } mw;
-    } config;
+        bool                          enabled;
+        HPSIRQSource                  irqID;
+        bool                          active;   // Head transaction is running
+        HPSSPITransaction_t* volatile head;
+        HPSSPITransaction_t*          tail;
+    } queue;
+    HPSSPIDma_t txDma;
+    HPSSPIDma_t rxDma;
 } HPSSPICtx_t;
 
 //Initialise HPS SPI Controller
@@ -106,6 +231,14 @@ HpsErr_t HPS_SPI_configureFormat(HPSSPICtx_t* ctx, SpiSCLKPolarity cpol, SpiSCLK
 // - Change the phase/polarity width without changing other formats
 HpsErr_t HPS_SPI_setClockMode(HPSSPICtx_t* ctx, SpiSCLKPolarity cpol, SpiSCLKPhase cpha);
 
+// Change the peripheral clock rate
+// - periphClk is the new peripheral clock rate in Hz, e.g. after a clock
+//   profile change (Util/clk_profile.h).
+// - The clock divider is recalculated for the last requested SPI clock rate.
+//   Queued transactions with their own clkFreq are recalculated as they start.
+// - Returns ERR_BUSY if a transfer is in progress.
+HpsErr_t HPS_SPI_setPeriphClock(HPSSPICtx_t* ctx, unsigned int periphClk);
+
 //Change the SPI data width
 // - Change the data width without changing other formats
 HpsErr_t HPS_SPI_setDataWidth(HPSSPICtx_t* ctx, unsigned int dataWidth);
@@ -121,6 +254,29 @@ HpsErr_t HPS_SPI_writeReady(HPSSPICtx_t* ctx, uint32_t laneMask);
 // - If write only, will not store read result to FIFO.
 HpsErr_t HPS_SPI_writeData(HPSSPICtx_t* ctx, uint32_t laneMask, uint32_t* data, SpiTransferType type);
 
+//Perform a burst transfer of multiple words
+// - Only one lane.
+// - tx is the data to send, or NULL to send zeros (read-only).
+// - rx is where to store read data, or NULL to discard (write-only).
+// - count is the number of words. For data widths between 33 and 64, each
+//   word is two 32-bit entries in tx/rx, as for HPS_SPI_writeData().
+// - Blocks until all words have been read, or for write-only until all words
+//   have been loaded into the TX FIFO (use HPS_SPI_writeReady() to wait for idle).
+// - Returns ERR_BUSY if a previous transfer is still running.
+HpsErr_t HPS_SPI_transfer(HPSSPICtx_t* ctx, const uint32_t tx[], uint32_t rx[], unsigned int count);
+
+//Perform a burst transfer on several controllers at once
+// - laneMask selects which entries of lanes, tx and rx are used. Bit n is lanes[n].
+// - Each lane is configured with its own format and slave select, as for HPS_SPI_transfer().
+// - tx[n] is the data to send on lane n, or NULL to send zeros. tx may be NULL
+//   for all lanes to send zeros.
+// - rx[n] is where to store read data from lane n, or NULL to discard. rx may
+//   be NULL for all lanes to be write-only.
+// - count is the number of words for every lane.
+// - Blocks until all lanes are complete, as for HPS_SPI_transfer().
+// - Returns ERR_BUSY if a previous transfer is still running on any lane.
+HpsErr_t HPS_SPI_transferLanes(HPSSPICtx_t* const lanes[], uint32_t laneMask, const uint32_t* const tx[], uint32_t* const rx[], unsigned int count);
+
 //Check if there is any data in the read FIFO
 // - Only one lane. Ignores bits higher than 0 in lane mask.
 // - Returns the number of available words on success.
@@ -149,4 +305,41 @@ HpsErr_t HPS_SPI_setMicrowireControl(HPSSPICtx_t* ctx, bool seqTransfer, bool us
 // - Immediately disables the SPI controller. This may cause partial transfers on the bus.
 HpsErr_t HPS_SPI_abort(HPSSPICtx_t* ctx);
 
+//Start the transaction queue
+// - irqID is the interrupt of this SPI controller (e.g. IRQ_SPI0).
+// - Requires HPS_IRQ to be initialised.
+// - Returns ERR_BUSY if a transfer is still running, or already started.
+HpsErr_t HPS_SPI_startQueue(HPSSPICtx_t* ctx, HPSIRQSource irqID);
+
+//Stop the transaction queue
+// - Any running or queued transactions are aborted, with their callbacks
+//   called with ERR_ABORTED.
+// - Returns ERR_SKIPPED if not started.
+HpsErr_t HPS_SPI_stopQueue(HPSSPICtx_t* ctx);
+
+//Queue a transaction
+// - The transaction is started immediately if the queue is idle, otherwise once
+//   those before it are done. It must remain valid until done.
+// - Returns ERR_WRONGMODE if the queue has not been started.
+// - Returns ERR_TOOBIG if a command (readCount > 0) does not fit in the FIFO.
+HpsErr_t HPS_SPI_queueTransaction(HPSSPICtx_t* ctx, HPSSPITransaction_t* xact);
+
+//Check if the transaction queue is idle
+// - Returns ERR_SUCCESS if all queued transactions are done.
+// - Returns ERR_BUSY if any are queued or running.
+HpsErr_t HPS_SPI_queueIdle(HPSSPICtx_t* ctx);
+
+//Assign a DMA controller for queued transactions
+// - tx selects whether this is for the TX (true) or RX (false) direction.
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transaction is running.
+HpsErr_t HPS_SPI_setDma(HPSSPICtx_t* ctx, bool tx, DmaCtx_t* dma, void* dmaParams);
+
+//Signal that a DMA transfer has completed
+// - Must be called from the DMA completion callback, passing the callback result.
+// - tx selects whether this is the TX (true) or RX (false) direction.
+// - Returns the result, or ERR_SKIPPED if no transfer was running.
+HpsErr_t HPS_SPI_dmaCompleted(HPSSPICtx_t* ctx, bool tx, HpsErr_t result);
+
 #endif /* HPS_SPI_H_ */
@@ -4,6 +4,10 @@
  *
  * Driver for the HPS embedded UART controller
  *
+ * An interrupt driven buffered mode is provided which services
+ * software ring buffers, and DMA transfers using the UART DMA
+ * request lines, see HPS_UART.h for details.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -11,14 +15,24 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add shared buffer descriptor DMA transfers
+ * 14/10/2026 | Add HPS_UART_setPeriphClock for clock profile changes
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Add interrupt driven buffered mode.
+ *            | Add DMA transfers.
  * 01/04/2024 | Creation of driver.
  *
  */
 
 #include "HPS_UART.h"
+#include "Util/mem_pool.h"
 
 #include "Util/bit_helpers.h"
 #include "Util/macros.h"
+#include "Util/lowlevel_arm.h"
+#include "Util/dma_buffer.h"
+
+#include <string.h>
 
 /*
  * Registers
@@ -380,9 +394,218 @@ static HpsErr_t _HPS_UART_read(HPSUARTCtx_t* ctx, uint8_t* data, uint8_t length)
     return (parityErr ? ERR_CHECKSUM : (frameErr ? ERR_CORRUPT : numRead));
 }
 
+// Set the FIFO interrupt thresholds
+// - FIFOCTRL is write-only, so FIFO enable and DMA mode must always be written too.
+static void _HPS_UART_setFifoThresholds(HPSUARTCtx_t* ctx, HPSUARTTxThreshold txThresh, HPSUARTRxThreshold rxThresh) {
+    bool dmaMode = (ctx->txDma.dma || ctx->rxDma.dma);
+    ctx->base[HPS_UART_REG_FIFOCTRL] = MaskInsert(txThresh, HPS_UART_FIFOCTRL_TET_MASK, HPS_UART_FIFOCTRL_TET_OFFS) |
+                                       MaskInsert(rxThresh, HPS_UART_FIFOCTRL_RT_MASK,  HPS_UART_FIFOCTRL_RT_OFFS ) |
+                                       MaskInsert(dmaMode,  HPS_UART_FIFOCTRL_DMAM_MASK, HPS_UART_FIFOCTRL_DMAM_OFFS) |
+                                       MaskCreate(HPS_UART_FIFOCTRL_FIFOE_MASK, HPS_UART_FIFOCTRL_FIFOE_OFFS); // FIFO enabled.
+}
+
+// Number of bytes in a ring
+static inline unsigned int _HPS_UART_ringFill(HPSUARTRing_t* ring) {
+    return ring->head - ring->tail;
+}
+
+// Number of free bytes in a ring
+static inline unsigned int _HPS_UART_ringSpace(HPSUARTRing_t* ring) {
+    return ring->size - _HPS_UART_ringFill(ring);
+}
+
+// Copy data into a ring
+// - Copies as much as there is space for, returning the amount copied.
+static unsigned int _HPS_UART_ringWrite(HPSUARTRing_t* ring, const uint8_t* data, unsigned int length) {
+    unsigned int count = min(length, _HPS_UART_ringSpace(ring));
+    unsigned int idx = ring->head & (ring->size - 1);
+    unsigned int first = min(count, ring->size - idx);
+    memcpy(&ring->buf[idx], data, first);
+    memcpy(ring->buf, data + first, count - first);
+    //Ensure data is written before the consumer can see it
+    __DMB();
+    ring->head = ring->head + count;
+    return count;
+}
+
+// Copy data out of a ring
+// - Copies as much as is available, returning the amount copied.
+static unsigned int _HPS_UART_ringRead(HPSUARTRing_t* ring, uint8_t* data, unsigned int length) {
+    unsigned int count = min(length, _HPS_UART_ringFill(ring));
+    //Ensure data is read only after the fill level
+    __DMB();
+    unsigned int idx = ring->tail & (ring->size - 1);
+    unsigned int first = min(count, ring->size - idx);
+    memcpy(data, &ring->buf[idx], first);
+    memcpy(data + first, ring->buf, count - first);
+    //Ensure data is read before the producer can overwrite it
+    __DMB();
+    ring->tail = ring->tail + count;
+    return count;
+}
+
+// Enable the TX empty interrupt
+// - IRQs disabled as the handler also modifies the enable register.
+static void _HPS_UART_startBufferedTx(HPSUARTCtx_t* ctx) {
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    ctx->base[HPS_UART_REG_IERDLH] = MaskSet(ctx->base[HPS_UART_REG_IERDLH], HPS_UART_IERDLH_ETBEI_MASK, HPS_UART_IERDLH_ETBEI_OFFS);
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+}
+
+// Buffered mode interrupt handler
+// - Moves data between the FIFOs and the rings
+static __irq void _HPS_UART_bufferedIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    HPSUARTCtx_t* ctx = (HPSUARTCtx_t*)param;
+    if (!ctx) return;
+    // Reading the IRQ ID clears a pending TX empty interrupt. Line status flags are kept for
+    // HPS_UART_getInterruptFlags, as reading clears them.
+    HPSUARTInterruptId irqId = MaskExtract(ctx->base[HPS_UART_REG_IRQID], HPS_UART_IRQID_ID_MASK, HPS_UART_IRQID_ID_OFFS);
+    ctx->irqFlags |= ctx->base[HPS_UART_REG_LINESTAT];
+    if (irqId == HPS_UART_IRQID_MODEMSTAT) {
+        ctx->irqFlags |= HPS_UART_IRQ_MODEM;
+        ctx->modemStat = ctx->base[HPS_UART_REG_MODEMSTAT];
+    } else if (irqId == HPS_UART_IRQID_BUSYDETECT) {
+        (void)ctx->base[HPS_UART_REG_STATUS]; // Reading clears busy detect.
+    }
+    // Drain the RX FIFO
+    HPSUARTRing_t* ring = &ctx->rxRing;
+    unsigned int avail = _HPS_UART_available(ctx);
+    unsigned int count = min(avail, _HPS_UART_ringSpace(ring));
+    unsigned int pos = ring->head;
+    for (unsigned int cnt = 0; cnt < count; cnt++) {
+        ring->buf[pos++ & (ring->size - 1)] = MaskExtract(ctx->base[HPS_UART_REG_DMABURST], HPS_UART_DMABURST_RX_MASK, HPS_UART_DMABURST_RX_OFFS);
+    }
+    __DMB();
+    ring->head = pos;
+    // Anything that doesn't fit must still be drained, or the IRQ will keep firing
+    for (unsigned int cnt = count; cnt < avail; cnt++) {
+        (void)ctx->base[HPS_UART_REG_DMABURST];
+    }
+    ctx->overruns += (avail - count);
+    // Refill the TX FIFO
+    ring = &ctx->txRing;
+    avail = _HPS_UART_ringFill(ring);
+    count = min(avail, _HPS_UART_writeSpace(ctx));
+    pos = ring->tail;
+    for (unsigned int cnt = 0; cnt < count; cnt++) {
+        ctx->base[HPS_UART_REG_DMABURST] = MaskInsert(ring->buf[pos++ & (ring->size - 1)], HPS_UART_DMABURST_TX_MASK, HPS_UART_DMABURST_TX_OFFS);
+    }
+    __DMB();
+    ring->tail = pos;
+    if (count) ctx->txRunning = true;
+    // If ring has run dry, stop TX interrupts until more data is written
+    if (count == avail) {
+        ctx->base[HPS_UART_REG_IERDLH] = MaskClear(ctx->base[HPS_UART_REG_IERDLH], HPS_UART_IERDLH_ETBEI_MASK, HPS_UART_IERDLH_ETBEI_OFFS);
+    }
+    *handled = true;
+}
+
+// Stop buffered mode
+static void _HPS_UART_stopBuffered(HPSUARTCtx_t* ctx) {
+    // Disable interrupts in the controller, then remove the handler
+    unsigned int irqEn = ctx->base[HPS_UART_REG_IERDLH];
+    irqEn = MaskClear(irqEn, HPS_UART_IERDLH_ERBFI_MASK, HPS_UART_IERDLH_ERBFI_OFFS);
+    irqEn = MaskClear(irqEn, HPS_UART_IERDLH_ETBEI_MASK, HPS_UART_IERDLH_ETBEI_OFFS);
+    irqEn = MaskClear(irqEn, HPS_UART_IERDLH_PTIME_MASK, HPS_UART_IERDLH_PTIME_OFFS);
+    ctx->base[HPS_UART_REG_IERDLH] = irqEn;
+    HPS_IRQ_unregisterHandler(ctx->irqID);
+    ctx->buffered = false;
+    // Restore the default thresholds
+    _HPS_UART_setFifoThresholds(ctx, HPS_UART_TXTHRESH_EMPTY, HPS_UART_RXTHRESH_CHAR1);
+    // Free the ring buffers
+    MemPool_free(ctx->txRing.buf);
+    ctx->txRing.buf = NULL;
+    MemPool_free(ctx->rxRing.buf);
+    ctx->rxRing.buf = NULL;
+}
+
+// Start a DMA transfer between a buffer and the FIFO
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - If desc is not NULL, the transfer holds a reference to it.
+static HpsErr_t _HPS_UART_dmaStart(HPSUARTCtx_t* ctx, HPSUARTDma_t* dma, bool tx, uintptr_t buf, size_t length, BufDesc_t* desc) {
+    uintptr_t fifo = (uintptr_t)&ctx->base[HPS_UART_REG_DMABURST];
+    dma->xfer.readAddr  = tx ? buf  : fifo;
+    dma->xfer.writeAddr = tx ? fifo : buf;
+    dma->xfer.length    = length;
+    dma->xfer.isLast    = true;
+    dma->xfer.index     = tx ? 0 : 1;
+    dma->xfer.params    = dma->params;
+    dma->running = true;
+    HpsErr_t status;
+    if (desc) {
+        // Length is set first, as the descriptor may be freed on completion
+        if (!tx) desc->length = length;
+        dma->buf = desc;
+        status = BufDesc_setupTransfer(dma->dma, &dma->xfer, desc, tx ? BUF_DEVICE_READS : BUF_DEVICE_WRITES, true);
+    } else {
+        status = DmaBuffer_setupTransfer(dma->dma, &dma->xfer, true);
+    }
+    if ((status == ERR_SKIPPED) || ERR_IS_ERROR(status)) {
+        dma->running = false;
+        dma->buf = NULL;
+    }
+    return status;
+}
+
+// Progress a DMA transfer
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+static HpsErr_t _HPS_UART_dmaProgress(HPSUARTDma_t* dma) {
+    if (!dma->running) return ERR_SUCCESS;
+    HpsErr_t status;
+    if (dma->buf) {
+        bool tx = (dma->xfer.index == 0);
+        status = BufDesc_transferDone(dma->dma, dma->buf, tx ? BUF_DEVICE_READS : BUF_DEVICE_WRITES);
+    } else {
+        status = DmaBuffer_transferDone(dma->dma, &dma->xfer);
+    }
+    if (status == ERR_BUSY) return ERR_BUSY;
+    dma->running = false;
+    dma->buf = NULL;
+    return ERR_IS_ERROR(status) ? status : ERR_SUCCESS;
+}
+
+// Setup a DMA transfer for either direction
+// - desc is the shared descriptor for buf, or NULL for a plain buffer.
+static HpsErr_t _HPS_UART_setupDma(HPSUARTCtx_t* ctx, bool tx, uintptr_t buf, size_t length, BufDesc_t* desc) {
+    if (!buf) return ERR_NULLPTR;
+    if (!length) return ERR_TOOSMALL;
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    // Can't access FIFOs directly while buffered
+    if (ctx->buffered) return ERR_WRONGMODE;
+    // Must have a DMA controller, and not be running
+    HPSUARTDma_t* dma = tx ? &ctx->txDma : &ctx->rxDma;
+    if (!dma->dma) return ERR_NOSUPPORT;
+    status = _HPS_UART_dmaProgress(dma);
+    if (ERR_IS_ERROR(status)) return status;
+    // Mark TX as running so that txIdle waits for the FIFO to drain afterwards
+    if (tx) {
+        _HPS_UART_getInterruptFlags(ctx, HPS_UART_IRQ_TXEMPTY, true);
+        ctx->txRunning = true;
+    }
+    return _HPS_UART_dmaStart(ctx, dma, tx, buf, length, desc);
+}
+
 static void _HPS_UART_cleanup(HPSUARTCtx_t* ctx) {
+    //Stop any DMA transfers
+    if (ctx->txDma.running) {
+        DMA_abortTransfer(ctx->txDma.dma, DMA_ABORT_FORCE);
+        if (ctx->txDma.buf) BufDesc_release(ctx->txDma.buf);
+    }
+    if (ctx->rxDma.running) {
+        DMA_abortTransfer(ctx->rxDma.dma, DMA_ABORT_FORCE);
+        if (ctx->rxDma.buf) {
+            BufDesc_completeDevice(ctx->rxDma.buf, BUF_DEVICE_WRITES);
+            BufDesc_release(ctx->rxDma.buf);
+        }
+    }
     //Disable interrupts and reset FIFOs
     if (ctx->base) {
+        if (ctx->buffered) {
+            _HPS_UART_stopBuffered(ctx);
+        }
         //Disabling FIFOs clears them.
         ctx->base[HPS_UART_REG_FIFOCTRL] = 0;
     }
@@ -395,6 +618,8 @@ static HpsErr_t _HPS_UART_txFifoSpace(HPSUARTCtx_t* ctx) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    // Return ring space if buffered
+    if (ctx->buffered) return (HpsErr_t)min(_HPS_UART_ringSpace(&ctx->txRing), (unsigned int)INT32_MAX);
     // Return FIFO space
     return (HpsErr_t)_HPS_UART_writeSpace(ctx);
 }
@@ -403,6 +628,8 @@ static HpsErr_t _HPS_UART_rxFifoAvailable(HPSUARTCtx_t* ctx) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    // Return ring availability if buffered
+    if (ctx->buffered) return (HpsErr_t)min(_HPS_UART_ringFill(&ctx->rxRing), (unsigned int)INT32_MAX);
     // Return FIFO availability
     return (HpsErr_t)_HPS_UART_available(ctx);
 }
@@ -413,7 +640,9 @@ static HpsErr_t _HPS_UART_txIdle(HPSUARTCtx_t* ctx, bool clearFlag) {
     if (ERR_IS_ERROR(status)) return status;
     // Check the Tx empty IRQ (clearing flag if requested). This will also update txRunning flag
     _HPS_UART_getInterruptFlags(ctx, HPS_UART_IRQ_TXEMPTY, clearFlag);
-    // Return whether TX is running
+    // Return whether TX is running. If buffered, the ring must also be empty, or if DMA the transfer done.
+    if (ctx->buffered && _HPS_UART_ringFill(&ctx->txRing)) return false;
+    if (_HPS_UART_dmaProgress(&ctx->txDma) == ERR_BUSY) return false;
     return !ctx->txRunning;
 }
 
@@ -422,6 +651,7 @@ static HpsErr_t _HPS_UART_rxReady(HPSUARTCtx_t* ctx, bool clearFlag) {
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
     // Ready whenever there is data available
+    if (ctx->buffered) return _HPS_UART_ringFill(&ctx->rxRing) > 0;
     return _HPS_UART_available(ctx) > 0;
 }
 
@@ -468,15 +698,14 @@ HpsErr_t HPS_UART_initialise(void* base, unsigned int periphClk, HPSUARTCtx_t**
     ctx->base[HPS_UART_REG_LINECTRL] = 0;
     ctx->base[HPS_UART_REG_IERDLH  ] = 0;
     //Initialise the FIFOs
-    ctx->base[HPS_UART_REG_FIFOCTRL] = MaskInsert(HPS_UART_TXTHRESH_EMPTY, HPS_UART_FIFOCTRL_TET_MASK, HPS_UART_FIFOCTRL_TET_OFFS) |
-                                       MaskInsert(HPS_UART_RXTHRESH_CHAR1, HPS_UART_FIFOCTRL_RT_MASK,  HPS_UART_FIFOCTRL_RT_OFFS ) |
-                                       MaskCreate(HPS_UART_FIFOCTRL_FIFOE_MASK, HPS_UART_FIFOCTRL_FIFOE_OFFS); // FIFO enabled.
+    _HPS_UART_setFifoThresholds(ctx, HPS_UART_TXTHRESH_EMPTY, HPS_UART_RXTHRESH_CHAR1);
     ctx->base[HPS_UART_REG_MODEMCTRL] = 0;
     //Clear IRQ flags
     (ctx->base[HPS_UART_REG_LINESTAT ]); // Reading clears flags in LSR.
     (ctx->base[HPS_UART_REG_MODEMSTAT]); // Reading clears flags in MSR.
     ctx->irqFlags = HPS_UART_IRQ_NONE;
     ctx->modemStat = 0;
+    ctx->buffered = false;
     //Initialised
     DriverContextSetInit(ctx);
     return ERR_SUCCESS;
@@ -531,6 +760,7 @@ HpsErr_t HPS_UART_setBaudRate(HPSUARTCtx_t* ctx, unsigned int baudRate) {
     //                      [Prescaler Timer Frequency]
     //    [Baud Divisor] = -----------------------------
     //                            16 x [Baud Rate]
+    ctx->baudRate = baudRate;
     unsigned int divisor;
     if (baudRate == UART_BAUD_MIN) {
         divisor = UINT16_MAX;
@@ -542,19 +772,35 @@ HpsErr_t HPS_UART_setBaudRate(HPSUARTCtx_t* ctx, unsigned int baudRate) {
             divisor = UINT16_MAX;
         }
     }
-    // Enable changing divisor
+    // Enable changing divisor. This hides the data registers, so the buffered mode handler must not run.
+    HpsErr_t irqStatus = ctx->buffered ? HPS_IRQ_globalEnable(false) : ERR_SKIPPED;
     ctx->base[HPS_UART_REG_LINECTRL ] = MaskSet(ctx->base[HPS_UART_REG_LINECTRL],HPS_UART_LINECTRL_DLAB_MASK,HPS_UART_LINECTRL_DLAB_OFFS);
     // Set lower and upper divisor bytes
     ctx->base[HPS_UART_REG_RBRTHRDLL] = MaskInsert(divisor,      HPS_UART_RBRTHRDLL_DLL_MASK, HPS_UART_RBRTHRDLL_DLL_OFFS);
     ctx->base[HPS_UART_REG_IERDLH   ] = MaskInsert(divisor >> 8, HPS_UART_IERDLH_DLH_MASK,    HPS_UART_IERDLH_DLH_OFFS   );
     // Disable changing divisor (restore access to TxRx data)
     ctx->base[HPS_UART_REG_LINECTRL ] = MaskClear(ctx->base[HPS_UART_REG_LINECTRL],HPS_UART_LINECTRL_DLAB_MASK,HPS_UART_LINECTRL_DLAB_OFFS);
+    if (ctx->buffered) HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
     // Convert back to baud rate to return to user
     baudRate = (ctx->baudClk / divisor);
     if (baudRate > INT32_MAX) baudRate = INT32_MAX;
     return (HpsErr_t) baudRate;
 }
 
+// Change the peripheral clock rate
+// - periphClk is the new peripheral clock rate in Hz, e.g. after a clock
+//   profile change (Util/clk_profile.h).
+// - The last requested baud rate is recalculated for the new clock.
+// - Returns the achieved baud rate, or ERR_SUCCESS if no rate has been set.
+HpsErr_t HPS_UART_setPeriphClock(HPSUARTCtx_t* ctx, unsigned int periphClk) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->baudClk = periphClk / HPS_UART_L4_SP_CLK_DIVISOR;
+    if (!ctx->baudRate) return ERR_SUCCESS;
+    return HPS_UART_setBaudRate(ctx, ctx->baudRate);
+}
+
 // Check UART Operation mode
 //  - UART core is always in full-duplex mode
 HpsErr_t HPS_UART_getTransferMode(HPSUARTCtx_t* ctx) {
@@ -619,8 +865,8 @@ HpsErr_t HPS_UART_writeSpace(HPSUARTCtx_t* ctx, unsigned int* space) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    // Check the space
-    unsigned int _space = _HPS_UART_writeSpace(ctx);
+    // Check the space, in the ring if buffered
+    unsigned int _space = ctx->buffered ? _HPS_UART_ringSpace(&ctx->txRing) : _HPS_UART_writeSpace(ctx);
     if (space) *space = _space;
     return _space ? ERR_SUCCESS : ERR_NOSPACE;
 }
@@ -635,6 +881,10 @@ HpsErr_t HPS_UART_write(HPSUARTCtx_t* ctx, const uint8_t data[], uint8_t length)
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    // Queue in the ring if buffered
+    if (ctx->buffered) return HPS_UART_writeBuffered(ctx, data, length);
+    // FIFO in use by DMA
+    if (ctx->txDma.running) return ERR_BUSY;
     // And write
     return _HPS_UART_write(ctx, data, length);
 }
@@ -646,8 +896,8 @@ HpsErr_t HPS_UART_available(HPSUARTCtx_t* ctx, unsigned int* available) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    // Read the FIFO available level
-    unsigned int _available = _HPS_UART_available(ctx);
+    // Read the FIFO available level, or ring level if buffered
+    unsigned int _available = ctx->buffered ? _HPS_UART_ringFill(&ctx->rxRing) : _HPS_UART_available(ctx);
     if (available) *available = _available;
     return _available ? ERR_SUCCESS : ERR_ISEMPTY;
 }
@@ -660,8 +910,15 @@ UartRxData_t HPS_UART_readWord(HPSUARTCtx_t* ctx) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_SUCCESS(status)) {
-        // And read
-        _HPS_UART_readWord(ctx, &data);
+        if (ctx->buffered) {
+            // Take from the ring if buffered. No per-word error information.
+            uint8_t byte;
+            data.valid = (_HPS_UART_ringRead(&ctx->rxRing, &byte, 1) > 0);
+            if (data.valid) data.rxData = byte;
+        } else if (!ctx->rxDma.running) {
+            // And read, unless the FIFO is in use by DMA
+            _HPS_UART_readWord(ctx, &data);
+        }
     }
     return data;
 }
@@ -676,6 +933,216 @@ HpsErr_t HPS_UART_read(HPSUARTCtx_t* ctx, uint8_t data[], uint8_t length) {
     // Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    // Take from the ring if buffered
+    if (ctx->buffered) return HPS_UART_readBuffered(ctx, data, length);
+    // FIFO in use by DMA
+    if (ctx->rxDma.running) return ERR_BUSY;
     // And read
     return _HPS_UART_read(ctx, data, length);
 }
+
+// Start interrupt driven buffered mode
+// - irqID is the interrupt ID of the UART controller (e.g. IRQ_UART0).
+// - txSize and rxSize are the ring buffer sizes in bytes, rounded up to a power of two.
+// - HPS_IRQ driver must be initialised first.
+// - Returns ERR_BUSY if already buffered.
+HpsErr_t HPS_UART_startBuffered(HPSUARTCtx_t* ctx, HPSIRQSource irqID, unsigned int txSize, unsigned int rxSize) {
+    if (!txSize || !rxSize) return ERR_TOOSMALL;
+    if ((txSize > _BV(31)) || (rxSize > _BV(31))) return ERR_TOOBIG;
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->buffered) return ERR_BUSY;
+    // FIFOs can't be shared with DMA transfers
+    if (ctx->txDma.running || ctx->rxDma.running) return ERR_BUSY;
+    // Round sizes up to a power of two so positions can be masked
+    unsigned int txLen = 1;
+    while (txLen < txSize) txLen = txLen * 2;
+    unsigned int rxLen = 1;
+    while (rxLen < rxSize) rxLen = rxLen * 2;
+    // Allocate the rings
+    ctx->txRing = (HPSUARTRing_t){ .buf = MemPool_malloc(txLen), .size = txLen, .head = 0, .tail = 0 };
+    ctx->rxRing = (HPSUARTRing_t){ .buf = MemPool_malloc(rxLen), .size = rxLen, .head = 0, .tail = 0 };
+    if (!ctx->txRing.buf || !ctx->rxRing.buf) {
+        MemPool_free(ctx->txRing.buf);
+        ctx->txRing.buf = NULL;
+        MemPool_free(ctx->rxRing.buf);
+        ctx->rxRing.buf = NULL;
+        return ERR_ALLOCFAIL;
+    }
+    ctx->overruns = 0;
+    // Register the handler
+    ctx->irqID = irqID;
+    status = HPS_IRQ_registerHandler(irqID, &_HPS_UART_bufferedIsr, ctx);
+    if (ERR_IS_ERROR(status)) {
+        MemPool_free(ctx->txRing.buf);
+        ctx->txRing.buf = NULL;
+        MemPool_free(ctx->rxRing.buf);
+        ctx->rxRing.buf = NULL;
+        return status;
+    }
+    ctx->buffered = true;
+    // Interrupt when TX FIFO drops below a quarter full (threshold mode), so it is refilled before it runs
+    // dry, and when RX FIFO is half full. The character timeout interrupt collects any stragglers.
+    _HPS_UART_setFifoThresholds(ctx, HPS_UART_TXTHRESH_QUART, HPS_UART_RXTHRESH_HALF);
+    // Enable RX interrupt. TX interrupt is enabled once there is data.
+    unsigned int irqEn = ctx->base[HPS_UART_REG_IERDLH];
+    irqEn = MaskSet(irqEn, HPS_UART_IERDLH_PTIME_MASK, HPS_UART_IERDLH_PTIME_OFFS);
+    irqEn = MaskSet(irqEn, HPS_UART_IERDLH_ERBFI_MASK, HPS_UART_IERDLH_ERBFI_OFFS);
+    ctx->base[HPS_UART_REG_IERDLH] = irqEn;
+    return ERR_SUCCESS;
+}
+
+// Stop interrupt driven buffered mode
+// - Unregisters the interrupt handler and frees the ring buffers.
+// - Any data still in the TX ring is not sent.
+// - Returns ERR_SKIPPED if not buffered.
+HpsErr_t HPS_UART_stopBuffered(HPSUARTCtx_t* ctx) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->buffered) return ERR_SKIPPED;
+    _HPS_UART_stopBuffered(ctx);
+    return ERR_SUCCESS;
+}
+
+// Queue data for buffered transmission
+// - Copies as much of data[] as fits in the TX ring, without waiting.
+// - Returns the number of bytes queued, or ERR_WRONGMODE if not buffered.
+HpsErr_t HPS_UART_writeBuffered(HPSUARTCtx_t* ctx, const uint8_t data[], size_t length) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->buffered) return ERR_WRONGMODE;
+    if (!length) return 0;
+    if (!data) return ERR_NULLPTR;
+    // Copy in what fits, and make sure the handler will send it
+    unsigned int count = _HPS_UART_ringWrite(&ctx->txRing, data, min(length, (size_t)INT32_MAX));
+    if (count) _HPS_UART_startBufferedTx(ctx);
+    return (HpsErr_t)count;
+}
+
+// Read buffered received data
+// - Copies up to length bytes from the RX ring, without waiting.
+// - Returns the number of bytes read, or ERR_WRONGMODE if not buffered.
+HpsErr_t HPS_UART_readBuffered(HPSUARTCtx_t* ctx, uint8_t data[], size_t length) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->buffered) return ERR_WRONGMODE;
+    if (!length) return 0;
+    if (!data) return ERR_NULLPTR;
+    // Copy out what is available
+    return (HpsErr_t)_HPS_UART_ringRead(&ctx->rxRing, data, min(length, (size_t)INT32_MAX));
+}
+
+// Get buffered mode error counts
+// - overruns is the number of received bytes dropped due to the RX ring being full.
+// - If clear is true, the count is reset.
+HpsErr_t HPS_UART_getBufferErrors(HPSUARTCtx_t* ctx, unsigned int* overruns, bool clear) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    // Read and optionally clear count. IRQs disabled as the handler also modifies it.
+    HpsErr_t irqStatus = HPS_IRQ_globalEnable(false);
+    if (overruns) *overruns = ctx->overruns;
+    if (clear) ctx->overruns = 0;
+    HPS_IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+// Assign a DMA controller for FIFO transfers
+// - tx selects whether this is for the TX (true) or RX (false) direction.
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transfer is running in this direction.
+HpsErr_t HPS_UART_setDma(HPSUARTCtx_t* ctx, bool tx, DmaCtx_t* dma, void* dmaParams) {
+    if (dma && !DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    // Can't change while running
+    HPSUARTDma_t* dmaState = tx ? &ctx->txDma : &ctx->rxDma;
+    status = _HPS_UART_dmaProgress(dmaState);
+    if (ERR_IS_ERROR(status)) return status;
+    dmaState->dma = dma;
+    dmaState->params = dmaParams;
+    // DMA handshaking is needed whenever either direction has a controller. Use the shadow
+    // register as FIFOCTRL is write-only.
+    bool dmaMode = (ctx->txDma.dma || ctx->rxDma.dma);
+    ctx->base[HPS_UART_REG_DMAMODE] = MaskInsert(dmaMode, HPS_UART_DMAMODE_MASK, HPS_UART_DMAMODE_OFFS);
+    return ERR_SUCCESS;
+}
+
+// Write a buffer to the TX FIFO using DMA
+// - Buffer must remain valid until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous TX transfer is still running.
+HpsErr_t HPS_UART_writeDma(HPSUARTCtx_t* ctx, const uint8_t data[], size_t length) {
+    return _HPS_UART_setupDma(ctx, true, (uintptr_t)data, length, NULL);
+}
+
+// Read into a buffer from the RX FIFO using DMA
+// - The transfer completes once length bytes have been received.
+// - Buffer must not be accessed until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous RX transfer is still running.
+HpsErr_t HPS_UART_readDma(HPSUARTCtx_t* ctx, uint8_t data[], size_t length) {
+    return _HPS_UART_setupDma(ctx, false, (uintptr_t)data, length, NULL);
+}
+
+// Write a shared buffer to the TX FIFO using DMA
+// - Sends buf->length bytes. A reference is held until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous TX transfer is still running.
+HpsErr_t HPS_UART_writeDmaBuf(HPSUARTCtx_t* ctx, BufDesc_t* buf) {
+    if (!buf) return ERR_NULLPTR;
+    return _HPS_UART_setupDma(ctx, true, (uintptr_t)buf->data, buf->length, buf);
+}
+
+// Read into a shared buffer from the RX FIFO using DMA
+// - The transfer completes once length bytes have been received, and
+//   buf->length is set to length. A reference is held until then.
+// - Returns ERR_TOOBIG if length exceeds the buffer size.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous RX transfer is still running.
+HpsErr_t HPS_UART_readDmaBuf(HPSUARTCtx_t* ctx, BufDesc_t* buf, size_t length) {
+    if (!buf) return ERR_NULLPTR;
+    if (length > buf->size) return ERR_TOOBIG;
+    return _HPS_UART_setupDma(ctx, false, (uintptr_t)buf->data, length, buf);
+}
+
+// Check if a DMA transfer is done
+// - tx selects whether to check the TX (true) or RX (false) direction.
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+HpsErr_t HPS_UART_dmaDone(HPSUARTCtx_t* ctx, bool tx) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    // Check progress
+    return _HPS_UART_dmaProgress(tx ? &ctx->txDma : &ctx->rxDma);
+}
+
+// Signal that a DMA transfer has completed
+// - For use from a DMA completion callback, passing the callback result.
+// - tx selects whether this is the TX (true) or RX (false) direction.
+// - Returns the result, or ERR_SKIPPED if no transfer was running.
+HpsErr_t HPS_UART_dmaCompleted(HPSUARTCtx_t* ctx, bool tx, HpsErr_t result) {
+    // Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HPSUARTDma_t* dma = tx ? &ctx->txDma : &ctx->rxDma;
+    if (!dma->running) return ERR_SKIPPED;
+    // Completion maintenance, as DmaBuffer_transferDone() or
+    // BufDesc_transferDone() would have done
+    if (dma->buf) {
+        BufDesc_completeDevice(dma->buf, tx ? BUF_DEVICE_READS : BUF_DEVICE_WRITES);
+        BufDesc_release(dma->buf);
+        dma->buf = NULL;
+    } else if (ERR_IS_SUCCESS(result)) {
+        DmaBuffer_complete(&dma->xfer);
+    }
+    dma->running = false;
+    return result;
+}
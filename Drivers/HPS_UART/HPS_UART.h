@@ -8,6 +8,68 @@
  * complex features like the full modem signals and
  * DMA configuration have not yet been implemented.
  *
+ * Buffered Mode
+ * -------------
+ *
+ * The basic write/read APIs only transfer as much as fits in the
+ * 128 byte hardware FIFOs. As an alternative, an interrupt driven
+ * buffered mode is available. Calling HPS_UART_startBuffered()
+ * registers an interrupt handler with the HPS_IRQ driver (which
+ * must already be initialised) and allocates a pair of software
+ * ring buffers, one for each direction.
+ *
+ * The interrupt handler drains the RX FIFO into the RX ring, and
+ * refills the TX FIFO from the TX ring whenever it drops below a
+ * quarter full, so transfers of any length can be queued without
+ * waiting:
+ *
+ *    HPS_UART_startBuffered(uart, IRQ_UART0, 4096, 1024);
+ *    ...
+ *    HPS_UART_writeBuffered(uart, telemetry, sizeof(telemetry));
+ *
+ * While buffered, HPS_UART_write/read (and so the generic UART
+ * interface) also go through the rings. The rings are single
+ * producer/single consumer, so the APIs must only be called from
+ * one (non-interrupt) context. If the RX ring is full, incoming
+ * bytes are dropped and counted, see HPS_UART_getBufferErrors().
+ *
+ * DMA Transfers
+ * -------------
+ *
+ * For bulk transfers such as log dumps and firmware uploads, a
+ * buffer can be moved between memory and the FIFOs by a DMA
+ * controller paced by the UART DMA request lines, so there is no
+ * per-byte CPU involvement. Assign a DMA controller to each
+ * direction with HPS_UART_setDma(), which also enables the UART
+ * DMA handshaking. For HPS_DMAController, allocate a channel
+ * for each direction (HPS_DMA_allocateChannel()) and pass its
+ * chCtx->dma, with dmaParams set up with HPS_DMA_initParameters()
+ * and then:
+ *
+ *  - transferWidth set to HPS_DMA_BURSTSIZE_1BYTE.
+ *  - For TX, destType HPS_DMA_DESTINATION_PERIPH, periph set to
+ *    HPS_DMA_PERIPH_UART0_TX (or UART1), and periphBurstLen 16.
+ *  - For RX, srcType HPS_DMA_SOURCE_PERIPH, periph set to
+ *    HPS_DMA_PERIPH_UART0_RX (or UART1), and periphBurstLen 1 as
+ *    the RX burst request is raised from a single character.
+ *
+ * Then call HPS_UART_writeDma()/HPS_UART_readDma() to start a
+ * transfer, and poll HPS_UART_dmaDone() for completion. Or, to be
+ * signalled instead, set a channel callback with
+ * HPS_DMA_setCallbackCh() which calls HPS_UART_dmaCompleted(). As
+ * the DMA driver acknowledges the completion before the callback,
+ * the UART driver must be told this way. Cache maintenance is
+ * handled automatically (Util/dma_buffer.h).
+ *
+ * HPS_UART_writeDmaBuf()/HPS_UART_readDmaBuf() take a shared buffer
+ * descriptor (Util/buf_desc.h) instead, holding a reference until the
+ * transfer is done, so a frame can be passed on from or to another
+ * driver without copying. Maintenance then follows the descriptor's
+ * cache state, so is skipped where it is not needed.
+ *
+ * While a DMA transfer is running, the polled APIs return ERR_BUSY
+ * for that direction. DMA and buffered mode cannot be combined.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -15,6 +77,11 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add shared buffer descriptor DMA transfers
+ * 14/10/2026 | Add HPS_UART_setPeriphClock for clock profile changes
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Add interrupt driven buffered mode.
+ *            | Add DMA transfers.
  * 01/04/2024 | Creation of driver.
  *
  */
@@ -29,6 +96,10 @@
 // UART Driver
 #include "Util/driver_ctx.h"
 #include "Util/driver_uart.h"
+#include "Util/driver_dma.h"
+#include "Util/buf_desc.h"
+
+#include "HPS_IRQ/HPS_IRQ.h"
 
 #include "Util/ct_assert.h"
 #include "Util/macros.h"
@@ -83,6 +154,25 @@ typedef enum {
     HPS_UART_IRQ_ALL     = (HPS_UART_IRQ_FIFOS   | HPS_UART_IRQ_ERRORS  | HPS_UART_IRQ_RXFIFO  | HPS_UART_IRQ_MODEM)
 } HPSUARTIrqSources;
 
+// Ring buffer for buffered mode
+// - size is a power of two. head and tail are free running
+//   positions, so (head - tail) is the fill level.
+typedef struct {
+    uint8_t* buf;
+    unsigned int size;
+    volatile unsigned int head; // Only written by producer
+    volatile unsigned int tail; // Only written by consumer
+} HPSUARTRing_t;
+
+// DMA transfer state for one direction
+typedef struct {
+    DmaCtx_t* dma;          // DMA controller, or NULL if not assigned
+    void* params;           // Optional DMA controller parameters
+    DmaChunk_t xfer;
+    BufDesc_t* buf;         // Descriptor held while running, or NULL for a plain buffer
+    bool running;
+} HPSUARTDma_t;
+
 typedef struct {
     //Header
     DrvCtx_t header;
@@ -94,10 +184,20 @@ typedef struct {
     // Config
     unsigned int fifoSize;
     unsigned int clkDiv;
+    unsigned int baudRate;      // Requested baud rate, or 0 if not yet set
     bool txRunning;
     // IRQ shadow
     HPSUARTIrqSources irqFlags;
     unsigned int modemStat;
+    // Buffered mode
+    bool buffered;
+    HPSIRQSource irqID;
+    HPSUARTRing_t txRing;       // Filled by HPS_UART_writeBuffered, emptied by IRQ
+    HPSUARTRing_t rxRing;       // Filled by IRQ, emptied by HPS_UART_readBuffered
+    volatile unsigned int overruns;
+    // DMA transfers
+    HPSUARTDma_t txDma;
+    HPSUARTDma_t rxDma;
 } HPSUARTCtx_t;
 
 
@@ -126,6 +226,13 @@ HpsErr_t HPS_UART_getInterruptFlags(HPSUARTCtx_t* ctx, HPSUARTIrqSources mask, b
 // - Returns the achieved baud rate
 HpsErr_t HPS_UART_setBaudRate(HPSUARTCtx_t* ctx, unsigned int baudRate);
 
+// Change the peripheral clock rate
+// - periphClk is the new peripheral clock rate in Hz, e.g. after a clock
+//   profile change (Util/clk_profile.h).
+// - The last requested baud rate is recalculated for the new clock.
+// - Returns the achieved baud rate, or ERR_SUCCESS if no rate has been set.
+HpsErr_t HPS_UART_setPeriphClock(HPSUARTCtx_t* ctx, unsigned int periphClk);
+
 // Check UART Operation mode
 //  - Always returns full-duplex
 HpsErr_t HPS_UART_getTransferMode(HPSUARTCtx_t* ctx);
@@ -173,4 +280,78 @@ UartRxData_t HPS_UART_readWord(HPSUARTCtx_t* ctx);
 //  - If the return value is negative, an error occurred in one of the words
 HpsErr_t HPS_UART_read(HPSUARTCtx_t* ctx, uint8_t data[], uint8_t length);
 
+// Start interrupt driven buffered mode
+// - irqID is the interrupt ID of the UART controller (e.g. IRQ_UART0).
+// - txSize and rxSize are the ring buffer sizes in bytes, rounded up to a power of two.
+// - HPS_IRQ driver must be initialised first.
+// - Returns ERR_BUSY if already buffered.
+HpsErr_t HPS_UART_startBuffered(HPSUARTCtx_t* ctx, HPSIRQSource irqID, unsigned int txSize, unsigned int rxSize);
+
+// Stop interrupt driven buffered mode
+// - Unregisters the interrupt handler and frees the ring buffers.
+// - Any data still in the TX ring is not sent.
+// - Returns ERR_SKIPPED if not buffered.
+HpsErr_t HPS_UART_stopBuffered(HPSUARTCtx_t* ctx);
+
+// Queue data for buffered transmission
+// - Copies as much of data[] as fits in the TX ring, without waiting.
+// - Returns the number of bytes queued, or ERR_WRONGMODE if not buffered.
+HpsErr_t HPS_UART_writeBuffered(HPSUARTCtx_t* ctx, const uint8_t data[], size_t length);
+
+// Read buffered received data
+// - Copies up to length bytes from the RX ring, without waiting.
+// - Returns the number of bytes read, or ERR_WRONGMODE if not buffered.
+HpsErr_t HPS_UART_readBuffered(HPSUARTCtx_t* ctx, uint8_t data[], size_t length);
+
+// Get buffered mode error counts
+// - overruns is the number of received bytes dropped due to the RX ring being full.
+// - If clear is true, the count is reset.
+HpsErr_t HPS_UART_getBufferErrors(HPSUARTCtx_t* ctx, unsigned int* overruns, bool clear);
+
+// Assign a DMA controller for FIFO transfers
+// - tx selects whether this is for the TX (true) or RX (false) direction.
+// - dma is the DMA controller to use, or NULL to remove.
+// - dmaParams are optional controller specific parameters. See notes at top of file.
+// - Returns ERR_BUSY if a transfer is running in this direction.
+HpsErr_t HPS_UART_setDma(HPSUARTCtx_t* ctx, bool tx, DmaCtx_t* dma, void* dmaParams);
+
+// Write a buffer to the TX FIFO using DMA
+// - Buffer must remain valid until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous TX transfer is still running.
+HpsErr_t HPS_UART_writeDma(HPSUARTCtx_t* ctx, const uint8_t data[], size_t length);
+
+// Read into a buffer from the RX FIFO using DMA
+// - The transfer completes once length bytes have been received.
+// - Buffer must not be accessed until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous RX transfer is still running.
+HpsErr_t HPS_UART_readDma(HPSUARTCtx_t* ctx, uint8_t data[], size_t length);
+
+// Write a shared buffer to the TX FIFO using DMA
+// - Sends buf->length bytes. A reference is held until the transfer is done.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous TX transfer is still running.
+HpsErr_t HPS_UART_writeDmaBuf(HPSUARTCtx_t* ctx, BufDesc_t* buf);
+
+// Read into a shared buffer from the RX FIFO using DMA
+// - The transfer completes once length bytes have been received, and
+//   buf->length is set to length. A reference is held until then.
+// - Returns ERR_TOOBIG if length exceeds the buffer size.
+// - Returns ERR_SKIPPED if the transfer completed immediately.
+// - Returns ERR_BUSY if a previous RX transfer is still running.
+HpsErr_t HPS_UART_readDmaBuf(HPSUARTCtx_t* ctx, BufDesc_t* buf, size_t length);
+
+// Check if a DMA transfer is done
+// - tx selects whether to check the TX (true) or RX (false) direction.
+// - Returns ERR_SUCCESS if no transfer is running.
+// - Returns ERR_BUSY if the transfer is still running.
+HpsErr_t HPS_UART_dmaDone(HPSUARTCtx_t* ctx, bool tx);
+
+// Signal that a DMA transfer has completed
+// - For use from a DMA completion callback, passing the callback result.
+// - tx selects whether this is the TX (true) or RX (false) direction.
+// - Returns the result, or ERR_SKIPPED if no transfer was running.
+HpsErr_t HPS_UART_dmaCompleted(HPSUARTCtx_t* ctx, bool tx, HpsErr_t result);
+
 #endif /* HPS_UART_H_ */
@@ -0,0 +1,274 @@
+/*
+ * HPS UART Framed Binary Link
+ * ---------------------------
+ * Description:
+ * COBS framed binary telemetry and command protocol over an HPS UART
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#include "HPS_UARTLink.h"
+#include "Util/crc32.h"
+#include "Util/macros.h"
+
+//Received data is read from the RX ring in chunks of this size
+#define UARTLINK_RX_CHUNK  64
+
+/*
+ * Internal Functions
+ */
+
+//Little endian field helpers
+static inline void _UARTLink_put16( uint8_t* dst, uint16_t val ) {
+    dst[0] = (uint8_t)val;
+    dst[1] = (uint8_t)(val >> 8);
+}
+
+static inline void _UARTLink_put32( uint8_t* dst, uint32_t val ) {
+    dst[0] = (uint8_t)val;
+    dst[1] = (uint8_t)(val >> 8);
+    dst[2] = (uint8_t)(val >> 16);
+    dst[3] = (uint8_t)(val >> 24);
+}
+
+static inline uint16_t _UARTLink_get16( const uint8_t* src ) {
+    return (uint16_t)(src[0] | (src[1] << 8));
+}
+
+static inline uint32_t _UARTLink_get32( const uint8_t* src ) {
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+//COBS output, straight into the TX ring
+static HpsErr_t _UARTLink_emit( void* param, const uint8_t* data, size_t len ) {
+    UARTLinkCtx_t* ctx = (UARTLinkCtx_t*)param;
+    HpsErr_t status = HPS_UART_writeBuffered(ctx->uart, data, len);
+    if (ERR_IS_ERROR(status)) return status;
+    return ((size_t)status == len) ? ERR_SUCCESS : ERR_NOSPACE;
+}
+
+//Encode and queue a frame with a given sequence number
+static HpsErr_t _UARTLink_sendFrame( UARTLinkCtx_t* ctx, uint8_t type, uint8_t seq, const UARTLinkSegment_t* segs, unsigned int count ) {
+    //Check the payload fits
+    size_t payloadLen = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        if (segs[idx].len && !segs[idx].data) return ERR_NULLPTR;
+        payloadLen += segs[idx].len;
+    }
+    if (payloadLen > UARTLINK_MAX_PAYLOAD) return ERR_TOOBIG;
+    //Only start if the whole frame will fit in the TX ring, so it is never split
+    unsigned int space;
+    HPS_UART_writeSpace(ctx->uart, &space);
+    if (space < COBS_MAX_ENCODED(payloadLen + UARTLINK_FRAME_OVERHEAD)) return ERR_NOSPACE;
+    //Encode header, payload segments and CRC, accumulating the CRC as we go
+    uint8_t header[2] = { type, seq };
+    uint32_t crc = crc32(0, header, sizeof(header));
+    cobs_encodeInit(&ctx->enc);
+    HpsErr_t status = cobs_encode(&ctx->enc, header, sizeof(header), &_UARTLink_emit, ctx);
+    for (unsigned int idx = 0; ERR_IS_SUCCESS(status) && (idx < count); idx++) {
+        if (!segs[idx].len) continue;
+        crc = crc32(crc, segs[idx].data, segs[idx].len);
+        status = cobs_encode(&ctx->enc, segs[idx].data, segs[idx].len, &_UARTLink_emit, ctx);
+    }
+    if (ERR_IS_SUCCESS(status)) {
+        uint8_t trailer[4];
+        _UARTLink_put32(trailer, crc);
+        status = cobs_encode(&ctx->enc, trailer, sizeof(trailer), &_UARTLink_emit, ctx);
+    }
+    if (ERR_IS_SUCCESS(status)) status = cobs_encodeEnd(&ctx->enc, &_UARTLink_emit, ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->stats.txFrames++;
+    return (HpsErr_t)seq;
+}
+
+//Run a received command and send its response
+static void _UARTLink_command( UARTLinkCtx_t* ctx, uint8_t seq, const uint8_t* payload, size_t len ) {
+    if (len < 2) {
+        ctx->stats.rxErrors++;
+        return;
+    }
+    uint16_t command = _UARTLink_get16(payload);
+    size_t replyLen = 0;
+    HpsErr_t result = ERR_NOSUPPORT;
+    if (ctx->commandHandler) {
+        result = ctx->commandHandler(ctx->commandParam, command, payload + 2, len - 2, ctx->reply, &replyLen);
+        replyLen = min(replyLen, sizeof(ctx->reply));
+    }
+    //Response echoes the command's sequence number
+    uint8_t header[6];
+    _UARTLink_put16(&header[0], command);
+    _UARTLink_put32(&header[2], (uint32_t)result);
+    UARTLinkSegment_t segs[2] = {
+        { header, sizeof(header) },
+        { ctx->reply, replyLen }
+    };
+    if (ERR_IS_ERROR(_UARTLink_sendFrame(ctx, UARTLINK_TYPE_RESPONSE, seq, segs, 2))) {
+        ctx->stats.txDropped++;
+    }
+}
+
+//Check and dispatch a decoded frame
+// - Returns true if the frame was valid
+static bool _UARTLink_dispatch( UARTLinkCtx_t* ctx, size_t len ) {
+    const uint8_t* frame = ctx->rxFrame;
+    if (len < UARTLINK_FRAME_OVERHEAD) {
+        //Back to back delimiters are just idle line, not an error
+        if (len) ctx->stats.rxErrors++;
+        return false;
+    }
+    size_t bodyLen = len - 4;
+    if (crc32(0, frame, bodyLen) != _UARTLink_get32(&frame[bodyLen])) {
+        ctx->stats.rxErrors++;
+        return false;
+    }
+    ctx->stats.rxFrames++;
+    uint8_t type = frame[0];
+    uint8_t seq = frame[1];
+    if (type == UARTLINK_TYPE_COMMAND) {
+        _UARTLink_command(ctx, seq, &frame[2], bodyLen - 2);
+    } else if (ctx->frameHandler) {
+        ctx->frameHandler(ctx->frameParam, type, seq, &frame[2], bodyLen - 2);
+    } else {
+        ctx->stats.rxUnhandled++;
+    }
+    return true;
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise the link
+// - uart must be in buffered mode (see HPS_UART_startBuffered), otherwise
+//   returns ERR_WRONGMODE.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t UARTLink_initialise( HPSUARTCtx_t* uart, UARTLinkCtx_t** pCtx ) {
+    //Check if the UART has been initialised and is buffered (required)
+    if (!HPS_UART_isInitialised(uart)) return ERR_BADDEVICE;
+    if (!uart->buffered) return ERR_WRONGMODE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, NULL);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save settings
+    UARTLinkCtx_t* ctx = *pCtx;
+    ctx->uart = uart;
+    ctx->txSeq = 0;
+    cobs_decodeInit(&ctx->dec, ctx->rxFrame, sizeof(ctx->rxFrame));
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - returns true if initialised
+bool UARTLink_isInitialised( UARTLinkCtx_t* ctx ) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Set the command handler
+// - Commands received with no handler are answered with ERR_NOSUPPORT.
+HpsErr_t UARTLink_setCommandHandler( UARTLinkCtx_t* ctx, UARTLinkCommandFunc_t handler, void* param ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->commandHandler = handler;
+    ctx->commandParam = param;
+    return ERR_SUCCESS;
+}
+
+//Set the frame handler
+// - Called for frames other than commands. May be NULL.
+HpsErr_t UARTLink_setFrameHandler( UARTLinkCtx_t* ctx, UARTLinkFrameFunc_t handler, void* param ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->frameHandler = handler;
+    ctx->frameParam = param;
+    return ERR_SUCCESS;
+}
+
+//Send a frame
+// - The payload is the count segments in order, up to UARTLINK_MAX_PAYLOAD
+//   bytes in total, otherwise returns ERR_TOOBIG.
+// - The frame is queued complete, or returns ERR_NOSPACE if the TX ring does
+//   not have room for it. Nothing is queued in that case.
+// - Returns the sequence number of the frame (>= 0), or an error code.
+HpsErr_t UARTLink_send( UARTLinkCtx_t* ctx, uint8_t type, const UARTLinkSegment_t* segs, unsigned int count ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (count && !segs) return ERR_NULLPTR;
+    //Sequence number only advances for frames actually sent
+    status = _UARTLink_sendFrame(ctx, type, ctx->txSeq, segs, count);
+    if (ERR_IS_SUCCESS(status)) ctx->txSeq++;
+    return status;
+}
+
+//Send a telemetry frame
+// - data is sent after the channel number.
+// - Returns the sequence number of the frame (>= 0), or an error code.
+HpsErr_t UARTLink_sendTelemetry( UARTLinkCtx_t* ctx, uint16_t channel, const void* data, size_t len ) {
+    uint8_t header[2];
+    _UARTLink_put16(header, channel);
+    UARTLinkSegment_t segs[2] = {
+        { header, sizeof(header) },
+        { data, len }
+    };
+    return UARTLink_send(ctx, UARTLINK_TYPE_TELEMETRY, segs, 2);
+}
+
+//Process received data
+// - Decodes everything in the RX ring, checks each frame and passes it to
+//   the command or frame handler.
+// - Returns the number of valid frames received (>= 0), or an error code.
+HpsErr_t UARTLink_process( UARTLinkCtx_t* ctx ) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int frames = 0;
+    uint8_t chunk[UARTLINK_RX_CHUNK];
+    while (true) {
+        status = HPS_UART_readBuffered(ctx->uart, chunk, sizeof(chunk));
+        if (ERR_IS_ERROR(status)) return status;
+        if (!status) break;
+        //A chunk may hold the end of one frame and the start of others
+        const uint8_t* in = chunk;
+        size_t len = (size_t)status;
+        while (len) {
+            size_t used;
+            HpsErr_t result = cobs_decode(&ctx->dec, in, len, &used);
+            in += used;
+            len -= used;
+            if (ERR_IS_RETRY(result)) break;
+            if (result == ERR_NOSPACE) {
+                ctx->stats.rxOverflows++;
+            } else if (ERR_IS_ERROR(result)) {
+                ctx->stats.rxErrors++;
+            } else if (_UARTLink_dispatch(ctx, (size_t)result)) {
+                frames++;
+            }
+        }
+    }
+    return (HpsErr_t)frames;
+}
+
+//Get link statistics
+// - If clear is true, the counts are reset.
+HpsErr_t UARTLink_getStats( UARTLinkCtx_t* ctx, UARTLinkStats_t* stats, bool clear ) {
+    if (!stats) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    *stats = ctx->stats;
+    if (clear) ctx->stats = (UARTLinkStats_t){0};
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,183 @@
+/*
+ * HPS UART Framed Binary Link
+ * ---------------------------
+ * Description:
+ * COBS framed binary telemetry and command protocol over an HPS UART
+ *
+ * Sending telemetry as text with printf() spends most of the link on
+ * formatting, and leaves the receiver to find where each message starts.
+ * Instead, each message is sent as a binary frame:
+ *
+ *    [type:8][seq:8][payload:0..UARTLINK_MAX_PAYLOAD][crc32:32]
+ *
+ * The CRC (little endian) covers the type, sequence number and payload.
+ * The frame is then COBS encoded (see Util/cobs) and ends with a zero
+ * byte, so the receiver can always find the next frame start, even after
+ * bytes are lost or corrupted.
+ *
+ * Frames are encoded straight from the caller's buffers into the UART
+ * TX ring. The payload may be given as a list of segments (e.g. a header
+ * struct followed by a sample buffer), which are never copied into a
+ * whole frame first. Before anything is queued the worst case encoded
+ * length is checked against the ring space, so a frame is either queued
+ * complete or not at all (ERR_NOSPACE), and the link is never left with
+ * half a frame.
+ *
+ * Usage
+ * -----
+ *
+ * The UART must already be in buffered mode:
+ *
+ *    HPS_UART_startBuffered(uart, IRQ_UART0, 4096, 1024);
+ *    UARTLink_initialise(uart, &link);
+ *    UARTLink_setCommandHandler(link, &runCommand, NULL);
+ *    while (1) {
+ *        UARTLink_process(link);
+ *        UARTLink_sendTelemetry(link, CHANNEL_ACCEL, &accel, sizeof(accel));
+ *        ...
+ *    }
+ *
+ * Telemetry frames carry a 16-bit channel number before the data. Command
+ * frames carry a 16-bit command number before the arguments. When one is
+ * received, UARTLink_process() calls the command handler, then sends a
+ * response frame with the same sequence number, holding the command number,
+ * the handler's 32-bit status and any reply data. Other frame types are
+ * passed to the frame handler. All multi-byte fields are little endian.
+ *
+ * The CRC uses Util/crc32, so crc32_setCtx() must have been called with
+ * a CRC processor, or FAILBACK_SOFTWARE_CRC32 defined.
+ *
+ * As with HPS_UART buffered mode, these APIs must only be called from one
+ * (non-interrupt) context.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver
+ *
+ */
+
+#ifndef HPS_UARTLINK_H_
+#define HPS_UARTLINK_H_
+
+//Include required header files
+#include "HPS_UART/HPS_UART.h"
+#include "Util/driver_ctx.h"
+#include "Util/cobs.h"
+
+//Maximum payload of a frame
+#ifndef UARTLINK_MAX_PAYLOAD
+#define UARTLINK_MAX_PAYLOAD  256
+#endif
+
+//Frame overhead before encoding: type, sequence number and CRC
+#define UARTLINK_FRAME_OVERHEAD  6
+
+//Maximum reply data from a command handler
+//  - Allows for the command number and status in the response payload.
+#define UARTLINK_MAX_REPLY  (UARTLINK_MAX_PAYLOAD - 6)
+
+// Frame types
+typedef enum {
+    UARTLINK_TYPE_TELEMETRY = 0x01,     // [channel:16][data]
+    UARTLINK_TYPE_COMMAND   = 0x02,     // [command:16][args]
+    UARTLINK_TYPE_RESPONSE  = 0x03,     // [command:16][status:32][reply]
+    UARTLINK_TYPE_USER      = 0x80      // 0x80 and above are free for applications
+} UARTLinkFrameType;
+
+// Payload segment
+typedef struct {
+    const void* data;
+    size_t len;
+} UARTLinkSegment_t;
+
+// Command handler
+// - args holds the argLen argument bytes following the command number.
+// - Up to UARTLINK_MAX_REPLY bytes of reply data may be written to reply, with
+//   *replyLen set to the number written. It is 0 by default.
+// - The returned status is sent back in the response.
+typedef HpsErr_t (*UARTLinkCommandFunc_t)(void* param, uint16_t command, const uint8_t* args, size_t argLen, uint8_t* reply, size_t* replyLen);
+
+// Frame handler
+// - Called for received frames other than commands.
+// - payload is only valid during the call.
+typedef void (*UARTLinkFrameFunc_t)(void* param, uint8_t type, uint8_t seq, const uint8_t* payload, size_t len);
+
+// Link statistics
+typedef struct {
+    unsigned int txFrames;              // Frames queued
+    unsigned int txDropped;             // Responses which did not fit in the TX ring
+    unsigned int rxFrames;              // Valid frames received
+    unsigned int rxErrors;              // Frames with bad CRC, encoding or length
+    unsigned int rxOverflows;           // Frames too long for the receive buffer
+    unsigned int rxUnhandled;           // Valid frames with no handler
+} UARTLinkStats_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    HPSUARTCtx_t* uart;
+    uint8_t txSeq;
+    CobsEncoder_t enc;
+    CobsDecoder_t dec;
+    uint8_t rxFrame[UARTLINK_MAX_PAYLOAD + UARTLINK_FRAME_OVERHEAD];
+    uint8_t reply[UARTLINK_MAX_REPLY];
+    // Handlers
+    UARTLinkCommandFunc_t commandHandler;
+    void* commandParam;
+    UARTLinkFrameFunc_t frameHandler;
+    void* frameParam;
+    // Statistics
+    UARTLinkStats_t stats;
+} UARTLinkCtx_t;
+
+//Initialise the link
+// - uart must be in buffered mode (see HPS_UART_startBuffered), otherwise
+//   returns ERR_WRONGMODE.
+// - Returns Util/error Code
+// - Returns context pointer to *ctx
+HpsErr_t UARTLink_initialise( HPSUARTCtx_t* uart, UARTLinkCtx_t** pCtx );
+
+//Check if driver initialised
+// - returns true if initialised
+bool UARTLink_isInitialised( UARTLinkCtx_t* ctx );
+
+//Set the command handler
+// - Commands received with no handler are answered with ERR_NOSUPPORT.
+HpsErr_t UARTLink_setCommandHandler( UARTLinkCtx_t* ctx, UARTLinkCommandFunc_t handler, void* param );
+
+//Set the frame handler
+// - Called for frames other than commands. May be NULL.
+HpsErr_t UARTLink_setFrameHandler( UARTLinkCtx_t* ctx, UARTLinkFrameFunc_t handler, void* param );
+
+//Send a frame
+// - The payload is the count segments in order, up to UARTLINK_MAX_PAYLOAD
+//   bytes in total, otherwise returns ERR_TOOBIG.
+// - The frame is queued complete, or returns ERR_NOSPACE if the TX ring does
+//   not have room for it. Nothing is queued in that case.
+// - Returns the sequence number of the frame (>= 0), or an error code.
+HpsErr_t UARTLink_send( UARTLinkCtx_t* ctx, uint8_t type, const UARTLinkSegment_t* segs, unsigned int count );
+
+//Send a telemetry frame
+// - data is sent after the channel number.
+// - Returns the sequence number of the frame (>= 0), or an error code.
+HpsErr_t UARTLink_sendTelemetry( UARTLinkCtx_t* ctx, uint16_t channel, const void* data, size_t len );
+
+//Process received data
+// - Decodes everything in the RX ring, checks each frame and passes it to
+//   the command or frame handler.
+// - Returns the number of valid frames received (>= 0), or an error code.
+HpsErr_t UARTLink_process( UARTLinkCtx_t* ctx );
+
+//Get link statistics
+// - If clear is true, the counts are reset.
+HpsErr_t UARTLink_getStats( UARTLinkCtx_t* ctx, UARTLinkStats_t* stats, bool clear );
+
+#endif /* HPS_UARTLINK_H_ */
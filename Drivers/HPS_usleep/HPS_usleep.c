@@ -35,6 +35,7 @@
 
 #include "HPS_usleep.h"
 
+#include "Util/lowlevel_arm.h"
 #include "Util/watchdog.h"
 
 #ifdef __ARRIA10__
@@ -102,6 +103,13 @@ void selectTimer(HpsBridgeTimer timer, unsigned int freq) {
     __timerFreqMhz = freq / 1E6;
 }
 
+//Change the frequency of the timer used for usleep
+// - Frequency is the new clock rate of the selected timer, e.g. after the
+//   L4 SP clock has been changed by Util/clk_profile.
+void setTimerFrequency(unsigned int freq) {
+    __timerFreqMhz = freq / 1E6;
+}
+
 //Microsecond sleep function based on Cyclone V HPS SP Timer 1
 void usleep(int x) //Max delay ~2.09 seconds
 {
@@ -111,6 +119,9 @@ void usleep(int x) //Max delay ~2.09 seconds
     
     //Reset the watchdog before we sleep
     ResetWDT();
+    //Complete any posted writes over the FPGA bridges (e.g. to a PIO) so the
+    //delay starts from when they have taken effect
+    __DSB();
     
     //Convert x from microseconds to ticks
     __timer[TIMER_LOAD] = (((unsigned int)x) * __timerFreqMhz) - 1;
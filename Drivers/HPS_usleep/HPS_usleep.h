@@ -50,4 +50,9 @@ typedef enum {
 
 void selectTimer(HpsBridgeTimer timer, unsigned int freq);
 
+//Change the frequency of the timer used for usleep
+// - Frequency is the new clock rate of the selected timer, e.g. after the
+//   L4 SP clock has been changed by Util/clk_profile.
+void setTimerFrequency(unsigned int freq);
+
 #endif //DELAY_H_
@@ -0,0 +1,353 @@
+/*
+ * SPI NOR Flash Driver
+ * --------------------
+ *
+ * Driver for serial NOR flash memories attached to an HPS
+ * SPI controller, see SPI_NorFlash.h for details.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "SPI_NorFlash.h"
+
+#include "Util/watchdog.h"
+#include "Util/macros.h"
+
+#include <string.h>
+
+/*
+ * Commands
+ */
+
+#define SPI_NORFLASH_CMD_WREN      0x06  // Write enable
+#define SPI_NORFLASH_CMD_RDSR      0x05  // Read status register
+#define SPI_NORFLASH_CMD_RDID      0x9F  // Read JEDEC ID
+#define SPI_NORFLASH_CMD_FASTREAD  0x0B  // Fast read, one dummy byte
+#define SPI_NORFLASH_CMD_PP        0x02  // Page program
+#define SPI_NORFLASH_CMD_SE        0x20  // Sector erase (4kB)
+#define SPI_NORFLASH_CMD_BE        0xD8  // Block erase (64kB)
+#define SPI_NORFLASH_CMD_CE        0xC7  // Chip erase
+#define SPI_NORFLASH_CMD_FASTREAD4 0x0C  // 4-byte address variants
+#define SPI_NORFLASH_CMD_PP4       0x12
+#define SPI_NORFLASH_CMD_SE4       0x21
+#define SPI_NORFLASH_CMD_BE4       0xDC
+
+// Status register flags
+#define SPI_NORFLASH_STATUS_WIP    0
+
+// Largest device addressable with 3-byte addresses
+#define SPI_NORFLASH_3BYTE_MAX     0x1000000
+
+// Bytes compared per read when verifying
+#define SPI_NORFLASH_VERIFY_CHUNK  256
+
+/*
+ * Internal Functions
+ */
+
+//Transaction completion callback
+static void _SPI_NorFlash_xactDone(HPSSPITransaction_t* xact, HpsErr_t result, void* param) {
+    SPINorFlashSlot_t* slot = (SPINorFlashSlot_t*)param;
+    slot->status = result;
+}
+
+//Set up a transaction in a slot
+// - Command is the opcode, then the address if addr is true, then dummy bytes.
+// - For writes, src is the data to follow the command. For reads, length bytes are
+//   read after the command.
+// - length must fit within the slot.
+static void _SPI_NorFlash_setup(SPINorFlashCtx_t* ctx, SPINorFlashSlot_t* slot, uint8_t opcode, bool addr, unsigned int address, unsigned int dummy, const uint8_t* src, unsigned int length, bool read) {
+    uint32_t* buf = slot->buf;
+    unsigned int count = 0;
+    buf[count++] = opcode;
+    if (addr) {
+        for (unsigned int byte = ctx->addrBytes; byte > 0; byte--) {
+            buf[count++] = (address >> ((byte - 1) * 8)) & 0xFF;
+        }
+    }
+    while (dummy--) {
+        buf[count++] = 0;
+    }
+    if (src) {
+        for (unsigned int idx = 0; idx < length; idx++) {
+            buf[count++] = src[idx];
+        }
+    }
+    HPSSPITransaction_t* xact = &slot->xact;
+    xact->slaves    = ctx->slaves;
+    xact->cpol      = SPI_CPOL_LOW;
+    xact->cpha      = SPI_CPHA_MID;
+    xact->clkFreq   = ctx->clkFreq;
+    xact->dataWidth = 8;
+    xact->tx        = buf;
+    xact->rx        = read ? &buf[SPI_NORFLASH_CMD_MAX] : NULL;
+    xact->count     = count;
+    xact->readCount = read ? length : 0;
+    xact->callback  = &_SPI_NorFlash_xactDone;
+    xact->param     = slot;
+    slot->length    = length;
+}
+
+//Queue the transaction in a slot
+static HpsErr_t _SPI_NorFlash_queue(SPINorFlashCtx_t* ctx, SPINorFlashSlot_t* slot) {
+    slot->status = ERR_BUSY;
+    HpsErr_t status = HPS_SPI_queueTransaction(ctx->spi, &slot->xact);
+    if (ERR_IS_ERROR(status)) slot->status = status;
+    return status;
+}
+
+//Wait for the transaction in a slot to complete
+static HpsErr_t _SPI_NorFlash_wait(SPINorFlashSlot_t* slot) {
+    while (slot->status == ERR_BUSY) {
+        ResetWDT();
+    }
+    return slot->status;
+}
+
+//Copy the read data from a slot
+static void _SPI_NorFlash_unpack(SPINorFlashSlot_t* slot, uint8_t* dest) {
+    const uint32_t* rx = &slot->buf[SPI_NORFLASH_CMD_MAX];
+    for (unsigned int idx = 0; idx < slot->length; idx++) {
+        dest[idx] = (uint8_t)rx[idx];
+    }
+}
+
+//Perform a single command and wait for it to complete
+// - If dest is not NULL, length bytes are read into it after the command.
+static HpsErr_t _SPI_NorFlash_command(SPINorFlashCtx_t* ctx, uint8_t opcode, bool addr, unsigned int address, const uint8_t* src, unsigned int length, uint8_t* dest) {
+    SPINorFlashSlot_t* slot = &ctx->slot[0];
+    _SPI_NorFlash_setup(ctx, slot, opcode, addr, address, 0, src, length, (dest != NULL));
+    HpsErr_t status = _SPI_NorFlash_queue(ctx, slot);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _SPI_NorFlash_wait(slot);
+    if (ERR_IS_ERROR(status)) return status;
+    if (dest) _SPI_NorFlash_unpack(slot, dest);
+    return ERR_SUCCESS;
+}
+
+//Wait for a program or erase to finish
+static HpsErr_t _SPI_NorFlash_waitReady(SPINorFlashCtx_t* ctx) {
+    uint8_t flashStatus;
+    do {
+        HpsErr_t status = _SPI_NorFlash_command(ctx, SPI_NORFLASH_CMD_RDSR, false, 0, NULL, 1, &flashStatus);
+        if (ERR_IS_ERROR(status)) return status;
+    } while (flashStatus & _BV(SPI_NORFLASH_STATUS_WIP));
+    return ERR_SUCCESS;
+}
+
+//Enable writes, then perform a program or erase command and wait for it to finish
+static HpsErr_t _SPI_NorFlash_modify(SPINorFlashCtx_t* ctx, uint8_t opcode, bool addr, unsigned int address, const uint8_t* src, unsigned int length) {
+    HpsErr_t status = _SPI_NorFlash_command(ctx, SPI_NORFLASH_CMD_WREN, false, 0, NULL, 0, NULL);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _SPI_NorFlash_command(ctx, opcode, addr, address, src, length, NULL);
+    if (ERR_IS_ERROR(status)) return status;
+    return _SPI_NorFlash_waitReady(ctx);
+}
+
+//Detect size from the JEDEC capacity code
+// - Most vendors use log2(size). Codes from 0x20 follow on from 0x19 (32MB).
+static unsigned int _SPI_NorFlash_detectSize(uint8_t capacity) {
+    if ((capacity >= 0x10) && (capacity <= 0x1F)) return 1U << capacity;
+    if ((capacity >= 0x20) && (capacity <= 0x22)) return 1U << (capacity - 6);
+    return 0;
+}
+
+/*
+ * User Facing APIs
+ */
+
+//Initialise SPI NOR Flash Driver
+// - spi is an initialised HPS SPI controller whose transaction queue has been started.
+// - slaves is the slave select mask for the flash.
+// - clkFreq is the max SPI clock rate in Hz.
+// - size is the device size in bytes, or 0 to detect from the JEDEC ID.
+// - Returns ERR_NOCONNECT if no flash responds.
+// - Returns ERR_NOSUPPORT if the size can't be detected.
+HpsErr_t SPI_NorFlash_initialise(HPSSPICtx_t* spi, uint32_t slaves, unsigned int clkFreq, unsigned int size, SPINorFlashCtx_t** pCtx) {
+    //Ensure user pointers valid
+    if (!HPS_SPI_isInitialised(spi)) return ERR_BADDEVICE;
+    if (!slaves) return ERR_NOSUPPORT;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    SPINorFlashCtx_t* ctx = *pCtx;
+    ctx->spi = spi;
+    ctx->slaves = slaves;
+    ctx->clkFreq = clkFreq;
+    ctx->addrBytes = 3;
+    //Identify the flash
+    status = _SPI_NorFlash_command(ctx, SPI_NORFLASH_CMD_RDID, false, 0, NULL, sizeof(ctx->jedecId), ctx->jedecId);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    if ((ctx->jedecId[0] == 0x00) || (ctx->jedecId[0] == 0xFF)) return DriverContextInitFail(pCtx, ERR_NOCONNECT);
+    if (!size) size = _SPI_NorFlash_detectSize(ctx->jedecId[2]);
+    if (size < SPI_NORFLASH_SECTOR_SIZE) return DriverContextInitFail(pCtx, ERR_NOSUPPORT);
+    ctx->size = size;
+    if (size > SPI_NORFLASH_3BYTE_MAX) ctx->addrBytes = 4;
+    //Whole device is one region
+    ctx->region.valid = true;
+    ctx->region.start = 0;
+    ctx->region.end = size - 1;
+    //Populate the flash interface
+    ctx->flash.ctx = ctx;
+    ctx->flash.initStatus = ERR_SUCCESS;
+    ctx->flash.wordSize = 1;
+    ctx->flash.blockSize = SPI_NORFLASH_SECTOR_SIZE;
+    ctx->flash.readOnly = false;
+    ctx->flash.writeProt = false;
+    ctx->flash.type = FLASH_TYPE_SPINOR;
+    ctx->flash.read   = (FlashReadFunc_t )&SPI_NorFlash_read;
+    ctx->flash.erase  = (FlashEraseFunc_t)&SPI_NorFlash_erase;
+    ctx->flash.write  = (FlashWriteFunc_t)&SPI_NorFlash_write;
+    ctx->flash.verify = (FlashWriteFunc_t)&SPI_NorFlash_verify;
+    //Make sure no operation from before a reset is still running
+    status = _SPI_NorFlash_waitReady(ctx);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //And initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+//Check if driver initialised
+// - Returns true if driver context is initialised
+bool SPI_NorFlash_isInitialised(SPINorFlashCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+//Read the JEDEC ID
+// - Manufacturer ID, memory type, and capacity code.
+HpsErr_t SPI_NorFlash_getId(SPINorFlashCtx_t* ctx, uint8_t id[3]) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!id) return ERR_NULLPTR;
+    memcpy(id, ctx->jedecId, sizeof(ctx->jedecId));
+    return ERR_SUCCESS;
+}
+
+//Read from the flash
+// - Uses Fast Read, chunked with two chunks in flight.
+HpsErr_t SPI_NorFlash_read(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length, uint8_t* dest) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!length) return ERR_SUCCESS;
+    if (!dest) return ERR_NULLPTR;
+    if (!FLASH_rangeInRegion(&ctx->region, address, length)) return ERR_BEYONDEND;
+    uint8_t opcode = (ctx->addrBytes > 3) ? SPI_NORFLASH_CMD_FASTREAD4 : SPI_NORFLASH_CMD_FASTREAD;
+    //Keep up to two chunks in flight. Chunks complete in the order queued.
+    unsigned int queued = 0;
+    unsigned int done = 0;
+    unsigned int inFlight = 0;
+    unsigned int head = 0;
+    while (done < length) {
+        while ((queued < length) && (inFlight < 2)) {
+            SPINorFlashSlot_t* slot = &ctx->slot[(head + inFlight) % 2];
+            unsigned int chunk = min(length - queued, (unsigned int)SPI_NORFLASH_CHUNK);
+            _SPI_NorFlash_setup(ctx, slot, opcode, true, address + queued, 1, NULL, chunk, true);
+            status = _SPI_NorFlash_queue(ctx, slot);
+            if (ERR_IS_ERROR(status)) break;
+            queued += chunk;
+            inFlight++;
+        }
+        if (!inFlight) return status;
+        //Copy out the oldest chunk once done
+        SPINorFlashSlot_t* slot = &ctx->slot[head];
+        status = _SPI_NorFlash_wait(slot);
+        inFlight--;
+        head = (head + 1) % 2;
+        if (ERR_IS_ERROR(status)) {
+            //Don't return until any other chunk in flight is done with the slot
+            if (inFlight) _SPI_NorFlash_wait(&ctx->slot[head]);
+            return status;
+        }
+        _SPI_NorFlash_unpack(slot, dest + done);
+        done += slot->length;
+    }
+    return ERR_SUCCESS;
+}
+
+//Erase a region of the flash
+// - Address and length must be aligned to the sector size (4kB).
+// - Uses block erase for whole 64kB blocks, and chip erase for the whole device.
+HpsErr_t SPI_NorFlash_erase(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->flash.writeProt) return ERR_WRITEPROT;
+    if (!length) return ERR_SUCCESS;
+    if (!FLASH_rangeInRegion(&ctx->region, address, length)) return ERR_BEYONDEND;
+    if ((address | length) & (SPI_NORFLASH_SECTOR_SIZE - 1)) return ERR_ALIGNMENT;
+    //Whole device
+    if ((address == 0) && (length == ctx->size)) {
+        return _SPI_NorFlash_modify(ctx, SPI_NORFLASH_CMD_CE, false, 0, NULL, 0);
+    }
+    //Otherwise the largest erase which fits at each address
+    bool addr4 = (ctx->addrBytes > 3);
+    while (length) {
+        unsigned int eraseSize;
+        uint8_t opcode;
+        if (!(address & (SPI_NORFLASH_BLOCK_SIZE - 1)) && (length >= SPI_NORFLASH_BLOCK_SIZE)) {
+            eraseSize = SPI_NORFLASH_BLOCK_SIZE;
+            opcode = addr4 ? SPI_NORFLASH_CMD_BE4 : SPI_NORFLASH_CMD_BE;
+        } else {
+            eraseSize = SPI_NORFLASH_SECTOR_SIZE;
+            opcode = addr4 ? SPI_NORFLASH_CMD_SE4 : SPI_NORFLASH_CMD_SE;
+        }
+        status = _SPI_NorFlash_modify(ctx, opcode, true, address, NULL, 0);
+        if (ERR_IS_ERROR(status)) return status;
+        address += eraseSize;
+        length -= eraseSize;
+    }
+    return ERR_SUCCESS;
+}
+
+//Write to the flash
+// - Region must have been erased first.
+// - Programs up to one page per command, split at page boundaries.
+HpsErr_t SPI_NorFlash_write(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->flash.writeProt) return ERR_WRITEPROT;
+    if (!length) return ERR_SUCCESS;
+    if (!src) return ERR_NULLPTR;
+    if (!FLASH_rangeInRegion(&ctx->region, address, length)) return ERR_BEYONDEND;
+    uint8_t opcode = (ctx->addrBytes > 3) ? SPI_NORFLASH_CMD_PP4 : SPI_NORFLASH_CMD_PP;
+    while (length) {
+        unsigned int chunk = min(length, SPI_NORFLASH_PAGE_SIZE - (address % SPI_NORFLASH_PAGE_SIZE));
+        status = _SPI_NorFlash_modify(ctx, opcode, true, address, src, chunk);
+        if (ERR_IS_ERROR(status)) return status;
+        address += chunk;
+        src += chunk;
+        length -= chunk;
+    }
+    return ERR_SUCCESS;
+}
+
+//Verify a region of the flash
+// - Returns ERR_SUCCESS if the flash matches src.
+// - On mismatch, returns the address of the first difference as a sign-magnitude error.
+HpsErr_t SPI_NorFlash_verify(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src) {
+    if (!src) return ERR_NULLPTR;
+    uint8_t buf[SPI_NORFLASH_VERIFY_CHUNK];
+    while (length) {
+        unsigned int chunk = min(length, (unsigned int)SPI_NORFLASH_VERIFY_CHUNK);
+        HpsErr_t status = SPI_NorFlash_read(ctx, address, chunk, buf);
+        if (ERR_IS_ERROR(status)) return status;
+        for (unsigned int idx = 0; idx < chunk; idx++) {
+            if (buf[idx] != src[idx]) return TO_SIGNMAG_ERR(address + idx);
+        }
+        address += chunk;
+        src += chunk;
+        length -= chunk;
+    }
+    return ERR_SUCCESS;
+}
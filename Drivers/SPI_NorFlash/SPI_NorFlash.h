@@ -0,0 +1,138 @@
+/*
+ * SPI NOR Flash Driver
+ * --------------------
+ *
+ * Driver for serial NOR flash memories (e.g. Winbond W25Q,
+ * Micron N25Q/MT25Q, Macronix MX25L) attached to an HPS SPI
+ * controller. The memory is accessed through the FlashCtx_t
+ * interface (Util/driver_flash.h):
+ *
+ *    HPS_SPI_initialise(LSC_BASE_SPIM0, 200000000, HPS_SPI_FORMAT_MOTOROLA, &spi);
+ *    HPS_SPI_startQueue(spi, IRQ_SPI0);
+ *    SPI_NorFlash_initialise(spi, 0x1, 25000000, 0, &nor);
+ *    FLASH_read(&nor->flash, address, length, buffer);
+ *
+ * All accesses are made through the HPS_SPI transaction queue,
+ * which must be started before initialising. Other devices on the
+ * same bus can share the queue. If DMA controllers have been
+ * assigned to the SPI with HPS_SPI_setDma(), they are used for the
+ * bulk data.
+ *
+ * Reads
+ * -----
+ *
+ * Reads use the Fast Read command (0x0B, or 0x0C for 4-byte
+ * addresses) which runs at the full SPI clock rate. Long reads are
+ * split into chunks with two in flight at once, so that the next
+ * chunk is clocked out while the previous one is being copied to
+ * the destination, keeping the bus busy.
+ *
+ * Programming and Erasing
+ * -----------------------
+ *
+ * Writes are split at page boundaries so that each program command
+ * fills as much of a page as possible. Flash must be erased before
+ * being written. Erases must be aligned to the sector size (the
+ * flash blockSize, 4kB). Whole 64kB blocks within the range use the
+ * block erase command, the rest of the range sector erase, and
+ * erasing the whole device uses chip erase.
+ *
+ * The capacity is detected from the JEDEC ID, or can be given
+ * explicitly. Devices larger than 16MB use the 4-byte address
+ * commands. The flash region is filled in to cover the whole
+ * device, and all accesses are checked against it.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef SPI_NORFLASH_H_
+#define SPI_NORFLASH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_flash.h"
+#include "HPS_SPI/HPS_SPI.h"
+
+// Geometry
+#define SPI_NORFLASH_PAGE_SIZE    256
+#define SPI_NORFLASH_SECTOR_SIZE  0x1000
+#define SPI_NORFLASH_BLOCK_SIZE   0x10000
+
+// Words per read chunk, and max command header (opcode, 4 address bytes, dummy byte)
+#define SPI_NORFLASH_CHUNK        512
+#define SPI_NORFLASH_CMD_MAX      6
+
+// Transfer slot, one for each transaction in flight
+typedef struct {
+    HPSSPITransaction_t xact;
+    volatile HpsErr_t   status;      // ERR_BUSY until the transaction is done
+    unsigned int        length;      // Data bytes
+    uint32_t            buf[SPI_NORFLASH_CMD_MAX + SPI_NORFLASH_CHUNK];
+} SPINorFlashSlot_t;
+
+// Driver context
+typedef struct {
+    // Context Header
+    DrvCtx_t header;
+    // Context Body
+    HPSSPICtx_t*  spi;
+    uint32_t      slaves;
+    unsigned int  clkFreq;
+    uint8_t       jedecId[3];
+    unsigned int  size;
+    unsigned int  addrBytes;
+    // Flash common interface
+    FlashCtx_t    flash;
+    FlashRegion_t region;
+    // Transfers
+    SPINorFlashSlot_t slot[2];
+} SPINorFlashCtx_t;
+
+//Initialise SPI NOR Flash Driver
+// - spi is an initialised HPS SPI controller whose transaction queue has been started.
+// - slaves is the slave select mask for the flash.
+// - clkFreq is the max SPI clock rate in Hz.
+// - size is the device size in bytes, or 0 to detect from the JEDEC ID.
+// - Returns ERR_NOCONNECT if no flash responds.
+// - Returns ERR_NOSUPPORT if the size can't be detected.
+HpsErr_t SPI_NorFlash_initialise(HPSSPICtx_t* spi, uint32_t slaves, unsigned int clkFreq, unsigned int size, SPINorFlashCtx_t** pCtx);
+
+//Check if driver initialised
+// - Returns true if driver context is initialised
+bool SPI_NorFlash_isInitialised(SPINorFlashCtx_t* ctx);
+
+//Read the JEDEC ID
+// - Manufacturer ID, memory type, and capacity code.
+HpsErr_t SPI_NorFlash_getId(SPINorFlashCtx_t* ctx, uint8_t id[3]);
+
+//Read from the flash
+// - Uses Fast Read, chunked with two chunks in flight.
+HpsErr_t SPI_NorFlash_read(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length, uint8_t* dest);
+
+//Erase a region of the flash
+// - Address and length must be aligned to the sector size (4kB).
+// - Uses block erase for whole 64kB blocks, and chip erase for the whole device.
+HpsErr_t SPI_NorFlash_erase(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length);
+
+//Write to the flash
+// - Region must have been erased first.
+// - Programs up to one page per command, split at page boundaries.
+HpsErr_t SPI_NorFlash_write(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src);
+
+//Verify a region of the flash
+// - Returns ERR_SUCCESS if the flash matches src.
+// - On mismatch, returns the address of the first difference as a sign-magnitude error.
+HpsErr_t SPI_NorFlash_verify(SPINorFlashCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src);
+
+#endif /* SPI_NORFLASH_H_ */
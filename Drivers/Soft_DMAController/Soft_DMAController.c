@@ -26,6 +26,22 @@
  * to perform a transfer using e.g. a timer interrupt
  * to transfer each chunk.
  * 
+ * Alternatively a time budget can be set for each poll
+ * with Soft_DMA_setTimeBudget(). Each chunk copied is then
+ * timed, and the chunk size adjusted from the measured
+ * bandwidth so that a poll takes around the budget.
+ * 
+ * By default each word is copied individually with an
+ * access of the word size, which is safe for peripheral
+ * memory. The copy can be changed by OR'ing a copy mode
+ * with the word size during init:
+ * 
+ *  - SOFT_DMA_COPY_BURST copies plain memory in bursts of
+ *    several words at a time (NEON or LDM/STM), moving
+ *    several times more data per poll.
+ *  - SOFT_DMA_COPY_FIFO writes every word to the same
+ *    destination address, e.g. a peripheral FIFO register.
+ * 
  *
  * Company: University of Leeds
  * Author: T Carpenter
@@ -34,6 +50,9 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add scatter-gather transfer lists.
+ *            | Add burst and FIFO copy modes.
+ *            | Add time budgeted chunk sizing.
  * 02/10/2024 | Creation of driver.
  *
  */
@@ -41,6 +60,12 @@
 #include "Soft_DMAController.h"
 #include "Util/irq.h"
 
+#include <string.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 /*
  * Default Copy Functions
  */
@@ -61,6 +86,70 @@ SOFT_DMA_MEMCPY_DEF(uint16_t)
 SOFT_DMA_MEMCPY_DEF(uint32_t)
 SOFT_DMA_MEMCPY_DEF(uint64_t)
 
+// FIFO copy, all words written to the first destination address
+#define SOFT_DMA_FIFOCPY_DEF(type) \
+static void* _Soft_DMA_fifocpy_##type(void* dest, void* src, size_t length, SoftDmaCtx_t* ctx) { \
+    volatile type* outPtr = dest;                                       \
+    volatile type* inPtr = src;                                         \
+    size_t nWords = length / ctx->wordSize;                             \
+    while (nWords--) {                                                  \
+        *outPtr = *inPtr++;                                             \
+    }                                                                   \
+    return dest;                                                        \
+}
+
+SOFT_DMA_FIFOCPY_DEF(uint8_t )
+SOFT_DMA_FIFOCPY_DEF(uint16_t)
+SOFT_DMA_FIFOCPY_DEF(uint32_t)
+SOFT_DMA_FIFOCPY_DEF(uint64_t)
+
+// Burst copy for plain memory
+//  - Moves 64 bytes per iteration with NEON if available, then 32 bytes
+//    per iteration using eight registers, which compiles to LDM/STM pairs.
+//  - Falls back to memcpy if the buffers are not word aligned.
+static void* _Soft_DMA_memcpy_burst(void* dest, void* src, size_t length, SoftDmaCtx_t* ctx) {
+    if (((uintptr_t)dest | (uintptr_t)src) & (sizeof(uint32_t) - 1)) {
+        return memcpy(dest, src, length);
+    }
+    uint32_t* outPtr = dest;
+    const uint32_t* inPtr = src;
+#if defined(__ARM_NEON)
+    while (length >= 16 * sizeof(uint32_t)) {
+        uint32x4_t v0 = vld1q_u32(inPtr     );
+        uint32x4_t v1 = vld1q_u32(inPtr +  4);
+        uint32x4_t v2 = vld1q_u32(inPtr +  8);
+        uint32x4_t v3 = vld1q_u32(inPtr + 12);
+        vst1q_u32(outPtr     , v0);
+        vst1q_u32(outPtr +  4, v1);
+        vst1q_u32(outPtr +  8, v2);
+        vst1q_u32(outPtr + 12, v3);
+        inPtr  += 16;
+        outPtr += 16;
+        length -= 16 * sizeof(uint32_t);
+    }
+#endif
+    while (length >= 8 * sizeof(uint32_t)) {
+        uint32_t w0 = inPtr[0], w1 = inPtr[1], w2 = inPtr[2], w3 = inPtr[3];
+        uint32_t w4 = inPtr[4], w5 = inPtr[5], w6 = inPtr[6], w7 = inPtr[7];
+        outPtr[0] = w0; outPtr[1] = w1; outPtr[2] = w2; outPtr[3] = w3;
+        outPtr[4] = w4; outPtr[5] = w5; outPtr[6] = w6; outPtr[7] = w7;
+        inPtr  += 8;
+        outPtr += 8;
+        length -= 8 * sizeof(uint32_t);
+    }
+    while (length >= sizeof(uint32_t)) {
+        *outPtr++ = *inPtr++;
+        length -= sizeof(uint32_t);
+    }
+    //Any remaining bytes for 8/16-bit word sizes
+    uint8_t* outByte = (uint8_t*)outPtr;
+    const uint8_t* inByte = (const uint8_t*)inPtr;
+    while (length--) {
+        *outByte++ = *inByte++;
+    }
+    return dest;
+}
+
 
 /*
  * Internal Functions
@@ -74,6 +163,53 @@ static HpsErr_t _Soft_DMA_setChunkSize(SoftDmaCtx_t* ctx, unsigned int chunkSize
     return ERR_SUCCESS;
 }
 
+// Adjust the chunk size from the time taken to copy a chunk
+//  - Moves half way from the current size towards the size which would take the
+//    budget at the measured bandwidth, growing by at most a factor of two.
+static void _Soft_DMA_adaptChunkSize(SoftDmaCtx_t* ctx, size_t copyLen, unsigned int startTime) {
+    unsigned int curTime;
+    if (ERR_IS_ERROR(Timer_getTime(ctx->timer, &curTime))) return;
+    // Timer counts down
+    unsigned int elapsed = startTime - curTime;
+    uint64_t target;
+    if (!elapsed) {
+        target = (uint64_t)ctx->chunkSize * 2;
+    } else {
+        target = ((uint64_t)(copyLen / ctx->wordSize) * ctx->budgetTicks) / elapsed;
+        target = min(target, (uint64_t)ctx->chunkSize * 2);
+    }
+    target = (target + ctx->chunkSize) / 2;
+    target = min(target, (uint64_t)(UINT32_MAX / ctx->wordSize));
+    ctx->chunkSize = target ? (unsigned int)target : 1;
+}
+
+// Validate a transfer request
+static HpsErr_t _Soft_DMA_validateChunk(SoftDmaCtx_t* ctx, DmaChunk_t* xfer) {
+    //Ensure transfer requests are aligned to DMA word size
+    if (!xfer->writeAddr || !xfer->readAddr) return ERR_NULLPTR;
+    if (!addressIsAligned64b(xfer->readAddr,  ctx->wordSize)) return ERR_ALIGNMENT;
+    if (!addressIsAligned64b(xfer->writeAddr, ctx->wordSize)) return ERR_ALIGNMENT;
+    if (!addressIsAligned64b(xfer->length,    ctx->wordSize)) return ERR_ALIGNMENT;
+    //Ensure source and destination don't overlap. A FIFO register is a single word.
+    uint64_t writeLength = ctx->fifoDest ? ctx->wordSize : xfer->length;
+    if ((xfer->writeAddr - xfer->readAddr) < writeLength) return ERR_NOSUPPORT;
+    //Can't support 64-bit transfers
+    if (xfer->readAddr  > UINTPTR_MAX) return ERR_TOOBIG;
+    if (xfer->writeAddr > UINTPTR_MAX) return ERR_TOOBIG;
+    if (xfer->length    > UINT32_MAX ) return ERR_TOOBIG;
+    //Ensure the transfer doesn't wrap through NULL
+    if (xfer->readAddr  + xfer->length > (1ULL << 32)) return ERR_BEYONDEND;
+    if (xfer->writeAddr + writeLength  > (1ULL << 32)) return ERR_BEYONDEND;
+    return ERR_SUCCESS;
+}
+
+// Load a transfer request as the current transfer
+static void _Soft_DMA_loadChunk(SoftDmaCtx_t* ctx, DmaChunk_t* xfer) {
+    ctx->source = (uintptr_t)xfer->readAddr;
+    ctx->dest   = (uintptr_t)xfer->writeAddr;
+    ctx->length = (size_t)(xfer->length);
+}
+
 // Send a chunk
 static HpsErr_t _Soft_DMA_transferChunk(SoftDmaCtx_t* ctx) {
     //Must have a transfer
@@ -83,16 +219,25 @@ static HpsErr_t _Soft_DMA_transferChunk(SoftDmaCtx_t* ctx) {
     size_t copyLen = (size_t)ctx->chunkSize * (size_t)ctx->wordSize;
     if (copyLen > ctx->length) copyLen = ctx->length;
     if (copyLen) {
-        //If remaining length is non-zero, perform the copy.
+        //If remaining length is non-zero, perform the copy. Time it if budgeted.
+        unsigned int startTime = 0;
+        bool timed = ctx->timer && ERR_IS_SUCCESS(Timer_getTime(ctx->timer, &startTime));
         if (!ctx->copyFunc((void*)ctx->dest, (void*)ctx->source, copyLen, ctx->copyFuncCtx)) {
             //Null return means copy failed.
             return ERR_IOFAIL;
         }
+        if (timed) _Soft_DMA_adaptChunkSize(ctx, copyLen, startTime);
         //Update transfer
-        ctx->dest   += copyLen;
+        if (!ctx->fifoDest) ctx->dest += copyLen;
         ctx->source += copyLen;
         ctx->length -= copyLen;
     }
+    //If the current chunk is done, move on to the next in the list
+    while (!ctx->length && ctx->listCount) {
+        _Soft_DMA_loadChunk(ctx, ctx->list);
+        ctx->list++;
+        ctx->listCount--;
+    }
     //If more to do, then we are still busy.
     if (ctx->length) return ERR_BUSY;
     //Otherwise we are done
@@ -106,7 +251,7 @@ static HpsErr_t _Soft_DMA_startTransfer(SoftDmaCtx_t* ctx) {
     // Check if accepting more
     if (ctx->transferRunning) return ERR_BUSY; // Can't start until previous done
     // Start the transfer.
-    ctx->transferRunning = (ctx->length > 0);
+    ctx->transferRunning = (ctx->length > 0) || (ctx->listCount > 0);
     HpsErr_t status = _Soft_DMA_transferChunk(ctx);
     // If successful, then transfer has already completed, so return skipped, otherwise
     // return status code
@@ -119,6 +264,8 @@ static HpsErr_t _Soft_DMA_startTransfer(SoftDmaCtx_t* ctx) {
 
 // Initialise DMA Controller Driver
 //  - wordSize is the width of the DMA word in bytes.
+//     - Can be OR'd with SOFT_DMA_COPY_BURST or SOFT_DMA_COPY_FIFO to select the
+//       copy function used when copyFunc is NULL.
 //  - chunkSize is the size of each chunk in wordSize words transferred when polling.
 //     - This can be overridden later by calling the Soft_DMA_setChunkSize() API.
 //  - copyFunc/copyFuncCtx are an optional pointer to a custom memory copy function.
@@ -140,29 +287,46 @@ HpsErr_t Soft_DMA_initialise(SoftDMAWordSize wordSize, unsigned int chunkSize, S
     SoftDmaCtx_t* ctx = *pCtx;
     ctx->dma.ctx = ctx;
     ctx->dma.setupTransfer = (DmaXferFunc_t)&Soft_DMA_setupTransfer;
+    ctx->dma.setupTransferList = (DmaXferListFunc_t)&Soft_DMA_setupTransferList;
     ctx->dma.startTransfer = (DmaXferStartFunc_t)&Soft_DMA_startTransfer;
     ctx->dma.abortTransfer = (DmaAbortFunc_t)&Soft_DMA_abort;
     ctx->dma.transferBusy = (DmaStatusFunc_t)&Soft_DMA_busy;
     ctx->dma.transferDone = (DmaStatusFunc_t)&Soft_DMA_completed;
-    //Validate and set the word size. Also pick appropriate default copy function
+    //Validate and set the word size and copy mode. Also pick appropriate default copy function
+    unsigned int copyMode = wordSize & SOFT_DMA_COPY_MASK;
+    wordSize &= SOFT_DMA_WORDSIZE_MASK;
+    bool fifo = (copyMode == SOFT_DMA_COPY_FIFO);
     SoftDmaMemcpyFunc_t defaultCopyFunc;
     switch (wordSize) {
         case SOFT_DMA_WORDSIZE_8BIT:
-            defaultCopyFunc = (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint8_t;
+            defaultCopyFunc = fifo ? (SoftDmaMemcpyFunc_t)&_Soft_DMA_fifocpy_uint8_t  : (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint8_t;
             break;
         case SOFT_DMA_WORDSIZE_16BIT:
-            defaultCopyFunc = (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint16_t;
+            defaultCopyFunc = fifo ? (SoftDmaMemcpyFunc_t)&_Soft_DMA_fifocpy_uint16_t : (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint16_t;
             break;
         case SOFT_DMA_WORDSIZE_32BIT:
-            defaultCopyFunc = (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint32_t;
+            defaultCopyFunc = fifo ? (SoftDmaMemcpyFunc_t)&_Soft_DMA_fifocpy_uint32_t : (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint32_t;
             break;
         case SOFT_DMA_WORDSIZE_64BIT:
-            defaultCopyFunc = (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint64_t;
+            defaultCopyFunc = fifo ? (SoftDmaMemcpyFunc_t)&_Soft_DMA_fifocpy_uint64_t : (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_uint64_t;
+            break;
+        default:
+            return DriverContextInitFail(pCtx, ERR_NOSUPPORT);
+    }
+    switch (copyMode) {
+        case SOFT_DMA_COPY_BURST:
+            defaultCopyFunc = (SoftDmaMemcpyFunc_t)&_Soft_DMA_memcpy_burst;
+            break;
+        case SOFT_DMA_COPY_FIFO:
+            //Chosen above based on word size.
+        case 0:
             break;
         default:
+            //Can't burst to a FIFO
             return DriverContextInitFail(pCtx, ERR_NOSUPPORT);
     }
     ctx->wordSize = wordSize;
+    ctx->fifoDest = fifo;
     //Save chunk size
     status = _Soft_DMA_setChunkSize(ctx, chunkSize);
     if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
@@ -199,6 +363,39 @@ HpsErr_t Soft_DMA_setChunkSize(SoftDmaCtx_t* ctx, unsigned int chunkSize) {
     return _Soft_DMA_setChunkSize(ctx, chunkSize);
 }
 
+// Set a time budget for each polled chunk
+//  - timer must be running in TIMER_MODE_EVENT. budget is in microseconds.
+//  - Each chunk copied is timed, and the chunk size adjusted towards the number
+//    of words which can be copied within the budget. The current chunk size is
+//    used as the starting point.
+//  - Passing a null pointer as timer, or a budget of 0, returns to a fixed chunk size.
+//  - Returns ERR_BUSY if a DMA transfer is already running.
+HpsErr_t Soft_DMA_setTimeBudget(SoftDmaCtx_t* ctx, TimerCtx_t* timer, unsigned int budget) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't be running
+    if (ctx->transferRunning) return ERR_BUSY;
+    //Check if disabling
+    ctx->timer = NULL;
+    if (!timer || !budget) return ERR_SUCCESS;
+    //Timer must be free running for event timing
+    TimerMode mode;
+    status = Timer_getMode(timer, &mode);
+    if (ERR_IS_ERROR(status)) return status;
+    if (mode != TIMER_MODE_EVENT) return ERR_WRONGMODE;
+    //Convert the budget to timer ticks
+    unsigned int rate;
+    status = Timer_getRate(timer, UINT32_MAX, &rate);
+    if (ERR_IS_ERROR(status)) return status;
+    uint64_t ticks = ((uint64_t)rate * budget) / 1000000;
+    if (!ticks) return ERR_TOOSMALL;
+    if (ticks > UINT32_MAX) return ERR_TOOBIG;
+    ctx->budgetTicks = (unsigned int)ticks;
+    ctx->timer = timer;
+    return ERR_SUCCESS;
+}
+
 // Configure a DMA transfer
 //  - If a transfer has already been queued but is not running it will be cancelled.
 //  - If the controller is already running, will return ERR_BUSY.
@@ -215,29 +412,56 @@ HpsErr_t Soft_DMA_setupTransfer(SoftDmaCtx_t* ctx, DmaChunk_t* xfer, bool autoSt
     if (ERR_IS_ERROR(status)) return status;
     //Can't be running
     if (ctx->transferRunning) return ERR_BUSY;
-    //Ensure transfer requests are aligned to DMA word size
-    if (!xfer->writeAddr || !xfer->readAddr) return ERR_NULLPTR;
-    if (!addressIsAligned64b(xfer->readAddr,  ctx->wordSize)) return ERR_ALIGNMENT;
-    if (!addressIsAligned64b(xfer->writeAddr, ctx->wordSize)) return ERR_ALIGNMENT;
-    if (!addressIsAligned64b(xfer->length,    ctx->wordSize)) return ERR_ALIGNMENT;
-    //Ensure source and destination don't overlap
-    if ((xfer->writeAddr - xfer->readAddr) < ctx->length) return ERR_NOSUPPORT;
-    //Can't support 64-bit transfers
-    if (xfer->readAddr  > UINTPTR_MAX) return ERR_TOOBIG;
-    if (xfer->writeAddr > UINTPTR_MAX) return ERR_TOOBIG;
-    if (xfer->length    > UINT32_MAX ) return ERR_TOOBIG;
-    //Ensure the transfer doesn't wrap through NULL
-    if (xfer->readAddr  + xfer->length > (1ULL << 32)) return ERR_BEYONDEND;
-    if (xfer->writeAddr + xfer->length > (1ULL << 32)) return ERR_BEYONDEND;
+    //Validate the transfer request
+    if (!xfer) return ERR_NULLPTR;
+    status = _Soft_DMA_validateChunk(ctx, xfer);
+    if (ERR_IS_ERROR(status)) return status;
     //Check if chunk size provided
     if (xfer->params) {
         status = _Soft_DMA_setChunkSize(ctx, (unsigned int)xfer->params);
         if (ERR_IS_ERROR(status)) return status;
     }
     //Set transfer parameters
-    ctx->source = (uintptr_t)xfer->readAddr;
-    ctx->dest   = (uintptr_t)xfer->writeAddr;
-    ctx->length = (size_t)(xfer->length);
+    _Soft_DMA_loadChunk(ctx, xfer);
+    ctx->list = NULL;
+    ctx->listCount = 0;
+    ctx->transferQueued = true;
+    //If not auto starting, then done
+    if (!autoStart) return ERR_SUCCESS;
+    //Otherwise start the transfer
+    return _Soft_DMA_startTransfer(ctx);
+}
+
+// Configure a scatter-gather DMA transfer
+//  - Performs count chunks from the xfers array in order as a single transfer,
+//    otherwise behaving as Soft_DMA_setupTransfer().
+//  - All chunks are validated before the transfer is queued.
+//  - The xfers array and the buffers it describes must remain valid throughout
+//    the transfer.
+//  - Can optionally override chunkSize by setting: `xfers[0].params = (void*)chunkSize;`
+//    The params of later chunks are ignored.
+HpsErr_t Soft_DMA_setupTransferList(SoftDmaCtx_t* ctx, DmaChunk_t* xfers, unsigned int count, bool autoStart) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Can't be running
+    if (ctx->transferRunning) return ERR_BUSY;
+    //Validate every transfer request before queuing any
+    if (!xfers) return ERR_NULLPTR;
+    if (!count) return ERR_TOOSMALL;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        status = _Soft_DMA_validateChunk(ctx, &xfers[idx]);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    //Check if chunk size provided
+    if (xfers[0].params) {
+        status = _Soft_DMA_setChunkSize(ctx, (unsigned int)xfers[0].params);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    //Set transfer parameters. Later chunks are loaded as each completes.
+    _Soft_DMA_loadChunk(ctx, &xfers[0]);
+    ctx->list = &xfers[1];
+    ctx->listCount = count - 1;
     ctx->transferQueued = true;
     //If not auto starting, then done
     if (!autoStart) return ERR_SUCCESS;
@@ -294,6 +518,8 @@ HpsErr_t Soft_DMA_abort(SoftDmaCtx_t* ctx, DmaAbortType abort) {
     if (ERR_IS_ERROR(status)) return status;
     if (abort == DMA_ABORT_NONE) return ERR_SKIPPED;
     //Stopped immediately.
+    ctx->list = NULL;
+    ctx->listCount = 0;
     ctx->transferQueued = false;
     ctx->transferRunning = false;
     return ERR_ABORTED;
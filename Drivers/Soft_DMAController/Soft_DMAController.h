@@ -26,6 +26,22 @@
  * to perform a transfer using e.g. a timer interrupt
  * to transfer each chunk.
  * 
+ * Alternatively a time budget can be set for each poll
+ * with Soft_DMA_setTimeBudget(). Each chunk copied is then
+ * timed, and the chunk size adjusted from the measured
+ * bandwidth so that a poll takes around the budget.
+ * 
+ * By default each word is copied individually with an
+ * access of the word size, which is safe for peripheral
+ * memory. The copy can be changed by OR'ing a copy mode
+ * with the word size during init:
+ * 
+ *  - SOFT_DMA_COPY_BURST copies plain memory in bursts of
+ *    several words at a time (NEON or LDM/STM), moving
+ *    several times more data per poll.
+ *  - SOFT_DMA_COPY_FIFO writes every word to the same
+ *    destination address, e.g. a peripheral FIFO register.
+ * 
  *
  * Company: University of Leeds
  * Author: T Carpenter
@@ -34,6 +50,9 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add scatter-gather transfer lists.
+ *            | Add burst and FIFO copy modes.
+ *            | Add time budgeted chunk sizing.
  * 02/10/2024 | Creation of driver.
  *
  */
@@ -43,6 +62,7 @@
 
 #include "Util/driver_ctx.h"
 #include "Util/driver_dma.h"
+#include "Util/driver_timer.h"
 #include "Util/bit_helpers.h"
 #include "Util/macros.h"
 
@@ -51,7 +71,12 @@ typedef enum {
     SOFT_DMA_WORDSIZE_16BIT = 2,
     SOFT_DMA_WORDSIZE_32BIT = 4,
     SOFT_DMA_WORDSIZE_64BIT = 8,
+    //Copy modes. Can be OR'd with the word size.
+    SOFT_DMA_COPY_BURST     = 0x100, // Multi-word memory to memory copy. Not for peripheral memory.
+    SOFT_DMA_COPY_FIFO      = 0x200  // Non-incrementing destination address.
 } SoftDMAWordSize;
+#define SOFT_DMA_WORDSIZE_MASK 0xFF
+#define SOFT_DMA_COPY_MASK     (SOFT_DMA_COPY_BURST | SOFT_DMA_COPY_FIFO)
 
 // Memory Copy Function Pointer
 //  - dest is a pointer to the start of the destination memory
@@ -67,7 +92,11 @@ typedef struct {
     DrvCtx_t header;
     //Body
     SoftDMAWordSize wordSize;
+    bool fifoDest;
     unsigned int chunkSize;
+    //Time budget for each chunk, if enabled
+    TimerCtx_t* timer;
+    unsigned int budgetTicks;
     SoftDmaMemcpyFunc_t copyFunc;
     void* copyFuncCtx;
     DmaCtx_t dma;
@@ -78,10 +107,15 @@ typedef struct {
     uintptr_t source;
     uintptr_t dest;
     size_t   length;
+    //Remaining chunks of a scatter-gather transfer
+    DmaChunk_t*  list;
+    unsigned int listCount;
 } SoftDmaCtx_t;
 
 // Initialise DMA Controller Driver
 //  - wordSize is the width of the DMA word in bytes.
+//     - Can be OR'd with SOFT_DMA_COPY_BURST or SOFT_DMA_COPY_FIFO to select the
+//       copy function used when copyFunc is NULL.
 //  - chunkSize is the size of each chunk in wordSize words transferred when polling.
 //     - This can be overridden later by calling the Soft_DMA_setChunkSize() API.
 //  - copyFunc/copyFuncCtx are an optional pointer to a custom memory copy function.
@@ -106,6 +140,15 @@ bool Soft_DMA_isInitialised(SoftDmaCtx_t* ctx);
 //  - Returns ERR_BUSY if a DMA transfer is already running (can't change size during run).
 HpsErr_t Soft_DMA_setChunkSize(SoftDmaCtx_t* ctx, unsigned int chunkSize);
 
+// Set a time budget for each polled chunk
+//  - timer must be running in TIMER_MODE_EVENT. budget is in microseconds.
+//  - Each chunk copied is timed, and the chunk size adjusted towards the number
+//    of words which can be copied within the budget. The current chunk size is
+//    used as the starting point.
+//  - Passing a null pointer as timer, or a budget of 0, returns to a fixed chunk size.
+//  - Returns ERR_BUSY if a DMA transfer is already running.
+HpsErr_t Soft_DMA_setTimeBudget(SoftDmaCtx_t* ctx, TimerCtx_t* timer, unsigned int budget);
+
 // Configure a DMA transfer
 //  - If a transfer has already been queued but is not running it will be cancelled.
 //  - If the controller is already running, will return ERR_BUSY.
@@ -118,6 +161,16 @@ HpsErr_t Soft_DMA_setChunkSize(SoftDmaCtx_t* ctx, unsigned int chunkSize);
 //    Soft_DMA_completed().
 HpsErr_t Soft_DMA_setupTransfer(SoftDmaCtx_t* ctx, DmaChunk_t* xfer, bool autoStart);
 
+// Configure a scatter-gather DMA transfer
+//  - Performs count chunks from the xfers array in order as a single transfer,
+//    otherwise behaving as Soft_DMA_setupTransfer().
+//  - All chunks are validated before the transfer is queued.
+//  - The xfers array and the buffers it describes must remain valid throughout
+//    the transfer.
+//  - Can optionally override chunkSize by setting: `xfers[0].params = (void*)chunkSize;`
+//    The params of later chunks are ignored.
+HpsErr_t Soft_DMA_setupTransferList(SoftDmaCtx_t* ctx, DmaChunk_t* xfers, unsigned int count, bool autoStart);
+
 // Start the previously configured transfer
 //  - If controller is busy and not able to start, returns ERR_BUSY.
 //  - Will return ERR_NOTFOUND if no transfer queued.
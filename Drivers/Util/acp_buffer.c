@@ -0,0 +1,153 @@
+/*
+ * ACP-Coherent Shared Buffers
+ * ---------------------------
+ *
+ * Provides buffers in HPS memory which FPGA masters can read
+ * and write through the Accelerator Coherency Port (ACP), so
+ * that the CPU can access them cached without any cache
+ * maintenance.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "acp_buffer.h"
+
+/*
+ * Internal Functions
+ */
+
+#if defined(__arm__) && !defined(__ARRIA10__)
+#define ACP_BUFFER_SUPPORTED
+#endif
+
+#if defined(ACP_BUFFER_SUPPORTED)
+
+// Register definitions from HWLib for reset manager
+#include "Util/hwlib/cv/socal/hps.h"
+#include "Util/hwlib/cv/socal/alt_rstmgr.h"
+
+// Reset Manager Miscellaneous Module Reset Register
+#define ACP_BUFFER_RSTMGR_MISCREG  (volatile unsigned int *)ALT_RSTMGR_MISCMODRST_ADDR
+#define ACP_BUFFER_RSTMGR_IDMAPMASK ALT_RSTMGR_MISCMODRST_ACPIDMAP_SET_MSK
+
+// ACP ID Mapper dynamic (unmapped ID) read and write configuration
+//  - HWLib does not provide the register fields, so defined here.
+#define ACP_BUFFER_IDMAP_DYNRD     (volatile unsigned int *)((uintptr_t)ALT_ACPIDMAP_ADDR + 0x28)
+#define ACP_BUFFER_IDMAP_DYNWR     (volatile unsigned int *)((uintptr_t)ALT_ACPIDMAP_ADDR + 0x2C)
+#define ACP_BUFFER_IDMAP_USER_OFS  4
+#define ACP_BUFFER_IDMAP_USER_MSK  (0x1F << ACP_BUFFER_IDMAP_USER_OFS)
+#define ACP_BUFFER_IDMAP_PAGE_OFS  12
+#define ACP_BUFFER_IDMAP_PAGE_MSK  (0x3 << ACP_BUFFER_IDMAP_PAGE_OFS)
+
+#endif
+
+// Page size of the ID mapper
+#define ACP_BUFFER_PAGE_MASK       (ACP_BUFFER_WINDOW_SIZE - 1)
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise ACP buffers
+//  - pool is a DMA buffer pool to allocate buffers from. It should be
+//    dedicated to the ACP, and must lie within one 1GB page of memory.
+//  - Configures the ACP ID mapper so the ACP window addresses the pool.
+//  - Returns ERR_BEYONDEND if the pool crosses a 1GB boundary.
+//  - Returns ERR_NOSUPPORT if not running on a Cyclone V HPS.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t AcpBuffer_initialise(DmaBufferCtx_t* pool, AcpBufferCtx_t** pCtx) {
+#if defined(ACP_BUFFER_SUPPORTED)
+    if (!DmaBuffer_isInitialised(pool)) return ERR_BADDEVICE;
+    //Pool must be within a single page of the ID mapper
+    uintptr_t first = (uintptr_t)pool->base;
+    uintptr_t last  = first + pool->size - 1;
+    if ((first & ~ACP_BUFFER_PAGE_MASK) != (last & ~ACP_BUFFER_PAGE_MASK)) return ERR_BEYONDEND;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Populate the context
+    AcpBufferCtx_t* ctx = *pCtx;
+    ctx->pool = pool;
+    ctx->page = first & ~ACP_BUFFER_PAGE_MASK;
+    //Release the ID mapper from reset, then map unmapped IDs to the pool's page
+    //with the coherent sideband forced.
+    *ACP_BUFFER_RSTMGR_MISCREG &= ~ACP_BUFFER_RSTMGR_IDMAPMASK;
+    unsigned int dyn = ((ACP_BUFFER_AXUSER << ACP_BUFFER_IDMAP_USER_OFS) & ACP_BUFFER_IDMAP_USER_MSK) |
+                       (((ctx->page >> 30) << ACP_BUFFER_IDMAP_PAGE_OFS) & ACP_BUFFER_IDMAP_PAGE_MSK);
+    *ACP_BUFFER_IDMAP_DYNRD = dyn;
+    *ACP_BUFFER_IDMAP_DYNWR = dyn;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+#else
+    (void)pool;
+    (void)pCtx;
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool AcpBuffer_isInitialised(AcpBufferCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Allocate a coherent buffer
+//  - Length will be rounded up to a multiple of the cache line size.
+//  - Returns the CPU pointer to *buf, and the address the FPGA should
+//    use to *fpgaAddr (optional, may be NULL).
+//  - Returns ERR_NOSPACE if there is no free region large enough.
+HpsErr_t AcpBuffer_alloc(AcpBufferCtx_t* ctx, size_t length, void** buf, uint32_t* fpgaAddr) {
+    if (!buf) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Allocate from the pool
+    status = DmaBuffer_alloc(ctx->pool, length, buf);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!fpgaAddr) return ERR_SUCCESS;
+    return AcpBuffer_toFpga(ctx, *buf, fpgaAddr);
+}
+
+// Free a coherent buffer
+//  - Returns ERR_NOTFOUND if the buffer was not allocated from this pool.
+HpsErr_t AcpBuffer_free(AcpBufferCtx_t* ctx, void* buf) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return DmaBuffer_free(ctx->pool, buf);
+}
+
+// Translate a CPU address to the FPGA ACP address
+//  - Returns ERR_BEYONDEND if the address is outside the mapped page.
+HpsErr_t AcpBuffer_toFpga(AcpBufferCtx_t* ctx, const void* cpuAddr, uint32_t* fpgaAddr) {
+    if (!fpgaAddr) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    uintptr_t addr = (uintptr_t)cpuAddr;
+    if ((addr & ~ACP_BUFFER_PAGE_MASK) != ctx->page) return ERR_BEYONDEND;
+    *fpgaAddr = ACP_BUFFER_WINDOW_BASE + (uint32_t)(addr & ACP_BUFFER_PAGE_MASK);
+    return ERR_SUCCESS;
+}
+
+// Translate an FPGA ACP address to the CPU address
+//  - Returns ERR_BEYONDEND if the address is outside the ACP window.
+HpsErr_t AcpBuffer_toCpu(AcpBufferCtx_t* ctx, uint32_t fpgaAddr, void** cpuAddr) {
+    if (!cpuAddr) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((fpgaAddr & ~ACP_BUFFER_PAGE_MASK) != ACP_BUFFER_WINDOW_BASE) return ERR_BEYONDEND;
+    *cpuAddr = (void*)(ctx->page + (fpgaAddr & ACP_BUFFER_PAGE_MASK));
+    return ERR_SUCCESS;
+}
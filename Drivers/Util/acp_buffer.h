@@ -0,0 +1,115 @@
+/*
+ * ACP-Coherent Shared Buffers
+ * ---------------------------
+ *
+ * Provides buffers in HPS memory which FPGA masters can read
+ * and write through the Accelerator Coherency Port (ACP), so
+ * that the CPU can access them cached without any cache
+ * maintenance, e.g. for Mandelbrot output or capture streams.
+ *
+ * Transactions from the FPGA-to-HPS bridge to the ACP window
+ * (0x80000000 to 0xBFFFFFFF) are passed through the ACP ID mapper
+ * into the SCU, which snoops the L1 data caches of both cores and
+ * forwards misses to the L2 cache. The ID mapper maps the window
+ * onto one 1GB page of the MPU address space, which must contain
+ * the buffer pool.
+ *
+ * Buffers are allocated from a Util/dma_buffer pool dedicated to
+ * the ACP, which keeps them cache line aligned:
+ *
+ *    DmaBuffer_initialise(acpPoolBase, acpPoolSize, &acpPool);
+ *    AcpBuffer_initialise(acpPool, &acpCtx);
+ *    AcpBuffer_alloc(acpCtx, 320*240*2, &frame, &frameFpga);
+ *    // Give frameFpga to the FPGA master, then read frame directly.
+ *
+ * Requirements
+ * ------------
+ *
+ *  - The FPGA master must access the buffer through the F2H bridge
+ *    using the address returned by AcpBuffer_alloc() or AcpBuffer_toFpga(),
+ *    not through the FPGA-to-SDRAM ports, which bypass the caches.
+ *  - For coherency the master should issue cacheable transactions
+ *    (AxCACHE = 0xF). The ID mapper also forces the AxUSER sideband to
+ *    shareable, inner write-back write-allocate.
+ *  - The F2H bridge must be released from reset (see Util/fpga_bridge.h).
+ *  - ACP accesses are only coherent with the L1 of a core which is in
+ *    SMP mode, which the startup code sets for CPU0.
+ *
+ * The buffers need no maintenance, so must not be passed to
+ * DmaBuffer_prepare()/DmaBuffer_complete() or DmaBuffer_setupTransfer().
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef ACP_BUFFER_H_
+#define ACP_BUFFER_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/dma_buffer.h"
+#include "Util/error.h"
+
+// ACP window as seen from the FPGA-to-HPS bridge
+#define ACP_BUFFER_WINDOW_BASE  0x80000000U
+#define ACP_BUFFER_WINDOW_SIZE  0x40000000U
+
+// AxUSER sideband forced by the ID mapper.
+//  - Shareable (bit 0), inner write-back write-allocate (bits 4:1).
+#ifndef ACP_BUFFER_AXUSER
+#define ACP_BUFFER_AXUSER       0x1F
+#endif
+
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    DmaBufferCtx_t* pool;    // Pool buffers are allocated from
+    uintptr_t       page;    // Base of the 1GB page mapped to the ACP window
+} AcpBufferCtx_t;
+
+// Initialise ACP buffers
+//  - pool is a DMA buffer pool to allocate buffers from. It should be
+//    dedicated to the ACP, and must lie within one 1GB page of memory.
+//  - Configures the ACP ID mapper so the ACP window addresses the pool.
+//  - Returns ERR_BEYONDEND if the pool crosses a 1GB boundary.
+//  - Returns ERR_NOSUPPORT if not running on a Cyclone V HPS.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t AcpBuffer_initialise(DmaBufferCtx_t* pool, AcpBufferCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool AcpBuffer_isInitialised(AcpBufferCtx_t* ctx);
+
+// Allocate a coherent buffer
+//  - Length will be rounded up to a multiple of the cache line size.
+//  - Returns the CPU pointer to *buf, and the address the FPGA should
+//    use to *fpgaAddr (optional, may be NULL).
+//  - Returns ERR_NOSPACE if there is no free region large enough.
+HpsErr_t AcpBuffer_alloc(AcpBufferCtx_t* ctx, size_t length, void** buf, uint32_t* fpgaAddr);
+
+// Free a coherent buffer
+//  - Returns ERR_NOTFOUND if the buffer was not allocated from this pool.
+HpsErr_t AcpBuffer_free(AcpBufferCtx_t* ctx, void* buf);
+
+// Translate a CPU address to the FPGA ACP address
+//  - Returns ERR_BEYONDEND if the address is outside the mapped page.
+HpsErr_t AcpBuffer_toFpga(AcpBufferCtx_t* ctx, const void* cpuAddr, uint32_t* fpgaAddr);
+
+// Translate an FPGA ACP address to the CPU address
+//  - Returns ERR_BEYONDEND if the address is outside the ACP window.
+HpsErr_t AcpBuffer_toCpu(AcpBufferCtx_t* ctx, uint32_t fpgaAddr, void** cpuAddr);
+
+#endif /* ACP_BUFFER_H_ */
@@ -0,0 +1,219 @@
+/*
+ * Deferred Format Binary Logging
+ * ------------------------------
+ *
+ * Provides log messages which are recorded into a trace buffer
+ * (Util/trace.h) as a pointer to their format string and the raw
+ * values of their arguments, rather than being formatted straight
+ * away.
+ *
+ * Messages are formatted one conversion at a time, passing each
+ * conversion specification to snprintf() with its argument word
+ * cast to the type that the conversion expects.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "binlog.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Util/macros.h"
+
+/*
+ * Internal Functions
+ */
+
+// Print a complete message
+//  - Returns true if printed.
+static bool _BinLog_printMessage(BinLogCtx_t* ctx) {
+    uint16_t id = TRACE_TAG_ID(ctx->records[0].tag);
+    unsigned int count = BINLOG_ID_COUNT(id);
+    if (!verbose_levelEnabled(BINLOG_ID_LEVEL(id))) return false;
+    //Unpack the format string and argument words
+    uint32_t words[2 * ((BINLOG_MAX_ARGS + 2) / 2)];
+    for (unsigned int idx = 0; idx < ((count + 2) / 2); idx++) {
+        words[2 * idx] = ctx->records[idx].arg0;
+        words[2 * idx + 1] = ctx->records[idx].arg1;
+    }
+    const char* fmt = (const char*)(uintptr_t)words[0];
+    if (!fmt) return false;
+    BinLog_format(ctx->line, sizeof(ctx->line), fmt, &words[1], count);
+    printf("%s", ctx->line);
+    return true;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Binary Log Reader
+//  - trace is the trace context to read messages from.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t BinLog_initialise(TraceCtx_t* trace, BinLogCtx_t** pCtx) {
+    if (!Trace_isInitialised(trace)) return ERR_BADDEVICE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Populate the context
+    BinLogCtx_t* ctx = *pCtx;
+    ctx->trace = trace;
+    ctx->have = 0;
+    ctx->dropped = 0;
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool BinLog_isInitialised(BinLogCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Format a message
+//  - fmt is the format string, and args the count argument words.
+//  - The formatted message is written to str, truncated to fit in size
+//    bytes including the null terminator.
+//  - Unsupported conversions are written as '?'.
+//  - Returns the length written.
+HpsErr_t BinLog_format(char* str, size_t size, const char* fmt, const uint32_t* args, unsigned int count) {
+    if (!str || !fmt || (count && !args)) return ERR_NULLPTR;
+    if (!size) return 0;
+    size_t len = 0;
+    unsigned int argIdx = 0;
+    while (*fmt && ((len + 1) < size)) {
+        if (*fmt != '%') {
+            str[len++] = *fmt++;
+            continue;
+        }
+        fmt++;
+        if (*fmt == '%') {
+            str[len++] = *fmt++;
+            continue;
+        }
+        //Copy the flags, width and precision. Length modifiers are dropped
+        //as every argument is a single word.
+        char spec[16];
+        size_t specLen = 0;
+        spec[specLen++] = '%';
+        while (*fmt && strchr("-+ #0123456789.", *fmt)) {
+            if (specLen < (sizeof(spec) - 2)) spec[specLen++] = *fmt;
+            fmt++;
+        }
+        while (*fmt && strchr("hljzt", *fmt)) {
+            fmt++;
+        }
+        char conv = *fmt;
+        if (conv) fmt++;
+        spec[specLen++] = conv;
+        spec[specLen] = '\0';
+        uint32_t arg = (argIdx < count) ? args[argIdx] : 0;
+        argIdx++;
+        int written;
+        switch (conv) {
+            case 'd':
+            case 'i':
+            case 'c':
+                written = snprintf(&str[len], size - len, spec, (int)(int32_t)arg);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                written = snprintf(&str[len], size - len, spec, (unsigned int)arg);
+                break;
+            case 'p':
+                written = snprintf(&str[len], size - len, spec, (void*)(uintptr_t)arg);
+                break;
+            case 's': {
+                const char* argStr = (const char*)(uintptr_t)arg;
+                written = snprintf(&str[len], size - len, spec, argStr ? argStr : "(null)");
+                break;
+            }
+            default:
+                written = snprintf(&str[len], size - len, "?");
+                break;
+        }
+        if (written < 0) break;
+        len += min((size_t)written, size - len - 1);
+    }
+    str[len] = '\0';
+    return (HpsErr_t)len;
+}
+
+// Print logged messages
+//  - Reads up to maxRecords trace records, printing each complete message
+//    whose level is enabled in the runtime verbosity mask.
+//  - A message which is still being written is finished on the next call.
+//  - Returns the number of messages printed, or an error code.
+HpsErr_t BinLog_print(BinLogCtx_t* ctx, unsigned int maxRecords) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t printed = 0;
+    for (unsigned int reads = 0; reads < maxRecords; reads++) {
+        TraceRecord_t* rec = &ctx->records[ctx->have];
+        status = Trace_read(ctx->trace, rec);
+        if (status == ERR_ISEMPTY) break;
+        if (ERR_IS_ERROR(status)) return status;
+        if (ctx->have) {
+            //Continuing a message, so must be the next position
+            uint32_t tag = ctx->records[0].tag + ((uint32_t)ctx->have << 16);
+            if (rec->tag == ((tag & 0xFFFF0000) | BINLOG_ID_CONT)) {
+                ctx->have++;
+            } else {
+                //The rest was overwritten. Start again from this record.
+                ctx->dropped++;
+                ctx->records[0] = *rec;
+                ctx->have = 0;
+            }
+        }
+        if (!ctx->have) {
+            uint16_t id = TRACE_TAG_ID(ctx->records[0].tag);
+            if (id == BINLOG_ID_CONT) {
+                //Start of the message was overwritten
+                continue;
+            } else if (!BINLOG_ID_IS_MSG(id)) {
+                //Other trace records
+                rec = &ctx->records[0];
+                printf("Trace 0x%04X: 0x%08X 0x%08X\n", id, (unsigned int)rec->arg0, (unsigned int)rec->arg1);
+                printed++;
+                continue;
+            } else if (BINLOG_ID_COUNT(id) > BINLOG_MAX_ARGS) {
+                //Not a valid message
+                continue;
+            }
+            ctx->have = 1;
+        }
+        //Print once the whole message has arrived
+        unsigned int count = BINLOG_ID_COUNT(TRACE_TAG_ID(ctx->records[0].tag));
+        if (ctx->have < ((count + 2) / 2)) continue;
+        ctx->have = 0;
+        if (_BinLog_printMessage(ctx)) printed++;
+    }
+    return printed;
+}
+
+// Get number of dropped messages
+//  - Returns the number of messages which were partly overwritten before
+//    they could be read. If clear is true, the count is reset.
+HpsErr_t BinLog_getDropped(BinLogCtx_t* ctx, bool clear) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t dropped = (HpsErr_t)min(ctx->dropped, (unsigned int)INT32_MAX);
+    if (clear) ctx->dropped = 0;
+    return dropped;
+}
@@ -0,0 +1,166 @@
+/*
+ * Deferred Format Binary Logging
+ * ------------------------------
+ *
+ * Provides log messages which are recorded into a trace buffer
+ * (Util/trace.h) as a pointer to their format string and the raw
+ * values of their arguments, rather than being formatted straight
+ * away. Adding a message costs about the same as a trace record,
+ * so logging can be left enabled in hot paths and IRQ handlers.
+ * The messages are formatted later, either in idle time on the
+ * target with BinLog_print(), or on the host from frames sent by
+ * Trace_drain() by looking up the format strings in the ELF file.
+ *
+ *    BINLOG(trace, VERBOSE_WARNING, "Underrun on channel %u after %d blocks", ch, blocks);
+ *    ...
+ *    // Idle loop
+ *    BinLog_print(binlog, 4);
+ *
+ * Levels
+ * ------
+ *
+ * Levels are the same VerbosityLevelMasks used by DbgPrintf. Any
+ * level not in BINLOG_LEVEL_MASK is removed at compile time, along
+ * with the evaluation of its arguments. By default all levels are
+ * kept in DEBUG builds, and only errors and warnings otherwise. The
+ * level is stored in each message, so BinLog_print() also checks it
+ * against the runtime verbosity mask before printing.
+ *
+ * Arguments
+ * ---------
+ *
+ * Up to BINLOG_MAX_ARGS arguments may be given, each of which is
+ * stored as a 32-bit word. Only integer, character, pointer and
+ * string conversions are supported, and floating point values must
+ * not be passed. Pointers, including strings, must be cast to
+ * uintptr_t. The format string, and any strings passed for %s,
+ * are read when the message is formatted, so must still be valid
+ * then, e.g. string literals.
+ *
+ * Records
+ * -------
+ *
+ * Each message is one trace record with ID BINLOG_ID(level, count),
+ * holding the format string address and the first argument, then
+ * one BINLOG_ID_CONT record for each further two arguments. These
+ * are claimed together, so always occupy consecutive positions.
+ *
+ * BinLog_print() reads from the trace buffer, so can't be used at
+ * the same time as Trace_read() or Trace_drain(). Other trace
+ * records are printed as their ID and arguments.
+ *
+ * Logging can be compiled out entirely by globally defining
+ * TRACE_DISABLE, or BINLOG_LEVEL_MASK as VERBOSE_DISABLED.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef BINLOG_H_
+#define BINLOG_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/trace.h"
+#include "Util/verbosity.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Levels kept at compile time
+#ifndef BINLOG_LEVEL_MASK
+#ifdef DEBUG
+#define BINLOG_LEVEL_MASK  VERBOSE_LEVEL4
+#else
+#define BINLOG_LEVEL_MASK  VERBOSE_LEVEL2
+#endif
+#endif
+
+// Maximum arguments per message
+#define BINLOG_MAX_ARGS    7
+
+// Maximum length of a formatted message
+#ifndef BINLOG_LINE_LENGTH
+#define BINLOG_LINE_LENGTH 128
+#endif
+
+// Trace event IDs. Level is a VerbosityLevelMasks value.
+#define BINLOG_ID(level, count) (TRACE_ID_RESERVED | (((level) & 0xF) << 4) | ((count) & 0xF))
+#define BINLOG_ID_CONT          (TRACE_ID_RESERVED | 0x100)
+#define BINLOG_ID_IS_MSG(id)    (((id) & 0xFF00) == TRACE_ID_RESERVED)
+#define BINLOG_ID_LEVEL(id)     ((VerbosityLevelMasks)(((id) >> 4) & 0xF))
+#define BINLOG_ID_COUNT(id)     ((id) & 0xF)
+
+// Binary Log Reader Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    TraceCtx_t*   trace;
+    TraceRecord_t records[(BINLOG_MAX_ARGS + 2) / 2]; // Message being gathered
+    unsigned int  have;          // Records of it gathered so far
+    unsigned int  dropped;       // Messages which were part overwritten
+    char          line[BINLOG_LINE_LENGTH];
+} BinLogCtx_t;
+
+// Log a message
+//  - trace is the trace context to record into.
+//  - level is a VerbosityLevelMasks value. Removed at compile time if not
+//    in BINLOG_LEVEL_MASK.
+//  - Arguments are converted to uint32_t.
+#ifndef TRACE_DISABLE
+#define BINLOG(trace, level, fmt, ...)                                                          \
+    do {                                                                                        \
+        if ((level) & (BINLOG_LEVEL_MASK)) {                                                    \
+            static const char _binlogFmt[] = fmt;                                               \
+            const uint32_t _binlogArgs[] = { (uint32_t)(uintptr_t)_binlogFmt, __VA_ARGS__ };    \
+            enum { _binlogCount = (sizeof(_binlogArgs) / sizeof(uint32_t)) - 1 };               \
+            (void)sizeof(char[(_binlogCount <= BINLOG_MAX_ARGS) ? 1 : -1]);                     \
+            Trace_eventMulti((trace), BINLOG_ID((level), _binlogCount), BINLOG_ID_CONT,          \
+                             _binlogArgs, _binlogCount + 1);                                    \
+        }                                                                                       \
+    } while (0)
+#else
+#define BINLOG(trace, level, fmt, ...) do {} while (0)
+#endif
+
+// Initialise Binary Log Reader
+//  - trace is the trace context to read messages from.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t BinLog_initialise(TraceCtx_t* trace, BinLogCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool BinLog_isInitialised(BinLogCtx_t* ctx);
+
+// Format a message
+//  - fmt is the format string, and args the count argument words.
+//  - The formatted message is written to str, truncated to fit in size
+//    bytes including the null terminator.
+//  - Unsupported conversions are written as '?'.
+//  - Returns the length written.
+HpsErr_t BinLog_format(char* str, size_t size, const char* fmt, const uint32_t* args, unsigned int count);
+
+// Print logged messages
+//  - Reads up to maxRecords trace records, printing each complete message
+//    whose level is enabled in the runtime verbosity mask.
+//  - A message which is still being written is finished on the next call.
+//  - Returns the number of messages printed, or an error code.
+HpsErr_t BinLog_print(BinLogCtx_t* ctx, unsigned int maxRecords);
+
+// Get number of dropped messages
+//  - Returns the number of messages which were partly overwritten before
+//    they could be read. If clear is true, the count is reset.
+HpsErr_t BinLog_getDropped(BinLogCtx_t* ctx, bool clear);
+
+#endif /* BINLOG_H_ */
@@ -11,6 +11,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add bitmap slot allocator
  * 03/02/2024 | Add countBits implementation
  * 28/12/2023 | Creation of header
  *
@@ -182,6 +183,66 @@ static inline unsigned int findFirstZero(unsigned int x) {
     return __clz(x);
 }
 
+// Bitmap slot allocator
+// - A bitmap is an array of words, one bit per slot (1 = in use), with
+//   slot n in bit (n % 32) of word (n / 32).
+// - Searches skip whole words at a time, using CLZ/RBIT within a word.
+// - Declare storage for count slots with BITMAP_WORDS(count), zeroed.
+#define BITMAP_WORD_BITS 32
+#define BITMAP_WORDS(count) (((count) + BITMAP_WORD_BITS - 1) / BITMAP_WORD_BITS)
+
+// Mark a slot as in use
+static inline void bitmapSet(unsigned int* map, unsigned int idx) {
+    map[idx / BITMAP_WORD_BITS] |= _BV(idx % BITMAP_WORD_BITS);
+}
+
+// Mark a slot as free
+static inline void bitmapClear(unsigned int* map, unsigned int idx) {
+    map[idx / BITMAP_WORD_BITS] &= ~_BV(idx % BITMAP_WORD_BITS);
+}
+
+// Check if a slot is in use
+static inline bool bitmapTest(const unsigned int* map, unsigned int idx) {
+    return !!(map[idx / BITMAP_WORD_BITS] & _BV(idx % BITMAP_WORD_BITS));
+}
+
+// Find the lowest free slot
+// - count is the number of slots in the bitmap
+// - Returns the slot index, or -1 if all are in use
+static inline signed int bitmapFindFirstZero(const unsigned int* map, unsigned int count) {
+    for (unsigned int word = 0; word < BITMAP_WORDS(count); word++) {
+        if (map[word] == UINT32_MAX) continue;
+        unsigned int idx = word * BITMAP_WORD_BITS + findFirstZero(map[word]);
+        return (idx < count) ? (signed int)idx : -1;
+    }
+    return -1;
+}
+
+// Find the lowest slot in use at or after start
+// - count is the number of slots in the bitmap
+// - Returns the slot index, or -1 if none are in use
+static inline signed int bitmapFindNextSet(const unsigned int* map, unsigned int count, unsigned int start) {
+    if (start >= count) return -1;
+    unsigned int word = start / BITMAP_WORD_BITS;
+    //Ignore bits below start in the first word
+    unsigned int bits = map[word] & (UINT32_MAX << (start % BITMAP_WORD_BITS));
+    while (!bits) {
+        if (++word >= BITMAP_WORDS(count)) return -1;
+        bits = map[word];
+    }
+    unsigned int idx = word * BITMAP_WORD_BITS + findLowestBit(bits);
+    return (idx < count) ? (signed int)idx : -1;
+}
+
+// Allocate the lowest free slot
+// - count is the number of slots in the bitmap
+// - Returns the slot index, now marked in use, or -1 if all are in use
+static inline signed int bitmapAllocate(unsigned int* map, unsigned int count) {
+    signed int idx = bitmapFindFirstZero(map, count);
+    if (idx >= 0) bitmapSet(map, idx);
+    return idx;
+}
+
 #if __BYTE_ORDER == __LITTLE_ENDIAN
 # define cpu_to_le16(x)     (x)
 # define cpu_to_le32(x)     (x)
@@ -0,0 +1,196 @@
+/*
+ * Shared Buffer Descriptor
+ * ------------------------
+ *
+ * A reference counted descriptor for a data buffer which is passed
+ * between drivers, so that a pipeline such as SD card -> audio codec
+ * or camera -> LT24 can hand the same memory from stage to stage
+ * without copying it.
+ *
+ *    BufDesc_alloc(dmaBufCtx, 4096, &buf);
+ *    f_read_buf(&file, buf, 4096, &br);     // FatFS/ff_bufdesc.h
+ *    HPS_UART_writeDmaBuf(uart, buf);       // Holds a reference while sending
+ *    BufDesc_release(buf);                  // Freed once the UART is done
+ *
+ * Each holder of the buffer takes a reference with BufDesc_retain()
+ * and drops it with BufDesc_release(). When the count reaches zero,
+ * the release callback given at initialisation is called to return
+ * the memory to wherever it came from. BufDesc_alloc() sets this up
+ * for buffers from a Util/dma_buffer pool.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "buf_desc.h"
+
+#include "Util/lowlevel_arm.h"
+#include "Util/mem_pool.h"
+
+/*
+ * Internal Functions
+ */
+
+// Release function for BufDesc_alloc()
+static void _BufDesc_free(BufDesc_t* buf, void* param) {
+    DmaBuffer_free((DmaBufferCtx_t*)param, buf->data);
+    MemPool_free(buf);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise a descriptor for an existing buffer
+//  - size is the capacity of the buffer in bytes, and length the number
+//    of valid bytes currently in it.
+//  - release is called (with param) when the last reference is dropped.
+//    May be NULL for a statically allocated buffer.
+//  - The descriptor starts with one reference held by the caller, and
+//    in the BUF_CACHE_CPU state.
+HpsErr_t BufDesc_init(BufDesc_t* buf, void* data, size_t size, size_t length, BufReleaseFunc_t release, void* param) {
+    if (!buf || !data) return ERR_NULLPTR;
+    if (length > size) return ERR_TOOBIG;
+    buf->data    = data;
+    buf->size    = size;
+    buf->length  = length;
+    buf->cache   = BUF_CACHE_CPU;
+    buf->refs    = 1;
+    buf->release = release;
+    buf->param   = param;
+    return ERR_SUCCESS;
+}
+
+// Allocate a buffer and descriptor
+//  - The data is allocated from the DMA buffer pool, and the descriptor
+//    from the memory pool. Both are freed when the last reference is
+//    dropped.
+//  - length is initially zero.
+//  - Returns descriptor pointer to *pBuf
+HpsErr_t BufDesc_alloc(DmaBufferCtx_t* pool, size_t size, BufDesc_t** pBuf) {
+    if (!pBuf) return ERR_NULLPTR;
+    BufDesc_t* buf = MemPool_malloc(sizeof(BufDesc_t));
+    if (!buf) return ERR_ALLOCFAIL;
+    void* data;
+    HpsErr_t status = DmaBuffer_alloc(pool, size, &data);
+    if (ERR_IS_ERROR(status)) {
+        MemPool_free(buf);
+        return status;
+    }
+    BufDesc_init(buf, data, size, 0, &_BufDesc_free, pool);
+    *pBuf = buf;
+    return ERR_SUCCESS;
+}
+
+// Take a reference to a buffer
+//  - Returns the new reference count.
+HpsErr_t BufDesc_retain(BufDesc_t* buf) {
+    if (!buf) return ERR_NULLPTR;
+    return (HpsErr_t)__ATOMIC_ADD32(&buf->refs, 1);
+}
+
+// Drop a reference to a buffer
+//  - Calls the release function if this was the last reference. The
+//    descriptor must not be used after that.
+//  - Returns the remaining reference count.
+HpsErr_t BufDesc_release(BufDesc_t* buf) {
+    if (!buf) return ERR_NULLPTR;
+    if (!buf->refs) return ERR_NOTFOUND;
+    unsigned int refs = __ATOMIC_ADD32(&buf->refs, -1);
+    if (!refs && buf->release) buf->release(buf, buf->param);
+    return (HpsErr_t)refs;
+}
+
+// Get the current reference count
+unsigned int BufDesc_refs(BufDesc_t* buf) {
+    return buf ? buf->refs : 0;
+}
+
+// Prepare a buffer for a device access
+//  - For BUF_DEVICE_READS, cleans the valid length if the CPU may have
+//    dirty lines.
+//  - For BUF_DEVICE_WRITES, purges the whole capacity unless a device
+//    has written it since the CPU last did.
+HpsErr_t BufDesc_prepareDevice(BufDesc_t* buf, BufAccess access) {
+    if (!buf) return ERR_NULLPTR;
+    if (access == BUF_DEVICE_READS) {
+        //Only the CPU can have made memory stale
+        if (buf->cache == BUF_CACHE_CPU) {
+            HpsErr_t status = DmaBuffer_cleanRange(buf->data, buf->length);
+            if (ERR_IS_ERROR(status)) return status;
+            buf->cache = BUF_CACHE_CLEAN;
+        }
+    } else if (buf->cache != BUF_CACHE_DEVICE) {
+        //No dirty line may later be evicted over the device data
+        HpsErr_t status = DmaBuffer_purgeRange(buf->data, buf->size);
+        if (ERR_IS_ERROR(status)) return status;
+        buf->cache = BUF_CACHE_CLEAN;
+    }
+    return ERR_SUCCESS;
+}
+
+// Complete a device access
+//  - After BUF_DEVICE_WRITES, marks the buffer as needing invalidation
+//    before the CPU reads it.
+HpsErr_t BufDesc_completeDevice(BufDesc_t* buf, BufAccess access) {
+    if (!buf) return ERR_NULLPTR;
+    if (access == BUF_DEVICE_WRITES) buf->cache = BUF_CACHE_DEVICE;
+    return ERR_SUCCESS;
+}
+
+// Prepare a buffer for CPU access
+//  - Invalidates the whole capacity if a device has written it.
+//  - If cpuWrites is true, the buffer is then marked as possibly dirty.
+HpsErr_t BufDesc_prepareCpu(BufDesc_t* buf, bool cpuWrites) {
+    if (!buf) return ERR_NULLPTR;
+    if (buf->cache == BUF_CACHE_DEVICE) {
+        //Discard lines speculatively fetched during the device write
+        HpsErr_t status = DmaBuffer_invalidateRange(buf->data, buf->size);
+        if (ERR_IS_ERROR(status)) return status;
+        buf->cache = BUF_CACHE_CLEAN;
+    }
+    if (cpuWrites) buf->cache = BUF_CACHE_CPU;
+    return ERR_SUCCESS;
+}
+
+// Configure a DMA transfer to or from a buffer
+//  - access says whether xfer reads from (BUF_DEVICE_READS) or writes
+//    to (BUF_DEVICE_WRITES) the buffer. The other side of xfer is not
+//    maintained, so should be a peripheral or another descriptor which
+//    has been prepared separately.
+//  - Takes a reference, which is dropped by BufDesc_transferDone().
+//  - If DMA_setupTransfer() returns ERR_SKIPPED or fails, the transfer
+//    is completed and the reference dropped before returning.
+HpsErr_t BufDesc_setupTransfer(DmaCtx_t* dma, DmaChunk_t* xfer, BufDesc_t* buf, BufAccess access, bool autoStart) {
+    if (!buf || !xfer) return ERR_NULLPTR;
+    HpsErr_t status = BufDesc_prepareDevice(buf, access);
+    if (ERR_IS_ERROR(status)) return status;
+    BufDesc_retain(buf);
+    status = DMA_setupTransfer(dma, xfer, autoStart);
+    if ((status == ERR_SKIPPED) || ERR_IS_ERROR(status)) {
+        BufDesc_completeDevice(buf, access);
+        BufDesc_release(buf);
+    }
+    return status;
+}
+
+// Check if a DMA transfer to or from a buffer is done
+//  - Calls DMA_transferDone(). Once no longer busy (whether successful
+//    or not), completes the access and drops the reference taken by
+//    BufDesc_setupTransfer().
+HpsErr_t BufDesc_transferDone(DmaCtx_t* dma, BufDesc_t* buf, BufAccess access) {
+    if (!buf) return ERR_NULLPTR;
+    HpsErr_t status = DMA_transferDone(dma);
+    if (status != ERR_BUSY) {
+        BufDesc_completeDevice(buf, access);
+        BufDesc_release(buf);
+    }
+    return status;
+}
@@ -0,0 +1,162 @@
+/*
+ * Shared Buffer Descriptor
+ * ------------------------
+ *
+ * A reference counted descriptor for a data buffer which is passed
+ * between drivers, so that a pipeline such as SD card -> audio codec
+ * or camera -> LT24 can hand the same memory from stage to stage
+ * without copying it.
+ *
+ *    BufDesc_alloc(dmaBufCtx, 4096, &buf);
+ *    f_read_buf(&file, buf, 4096, &br);     // FatFS/ff_bufdesc.h
+ *    HPS_UART_writeDmaBuf(uart, buf);       // Holds a reference while sending
+ *    BufDesc_release(buf);                  // Freed once the UART is done
+ *
+ * Each holder of the buffer takes a reference with BufDesc_retain()
+ * and drops it with BufDesc_release(). When the count reaches zero,
+ * the release callback given at initialisation is called to return
+ * the memory to wherever it came from. BufDesc_alloc() sets this up
+ * for buffers from a Util/dma_buffer pool.
+ *
+ * Cache State
+ * -----------
+ *
+ * The descriptor tracks which side last touched the data, so that
+ * each stage only performs the cache maintenance actually needed:
+ *
+ *  - BUF_CACHE_CPU:    The CPU may have dirty lines. A device reading
+ *                      the buffer needs a clean first.
+ *  - BUF_CACHE_CLEAN:  Memory matches the caches. Nothing needed for
+ *                      either side to read.
+ *  - BUF_CACHE_DEVICE: A device has written memory. The CPU needs to
+ *                      invalidate before reading.
+ *
+ * Drivers call BufDesc_prepareDevice() before starting a transfer and
+ * BufDesc_completeDevice() when it finishes. CPU code calls
+ * BufDesc_prepareCpu() before touching the data. So a buffer filled
+ * by one DMA and sent by another is never cleaned or invalidated in
+ * between, and a buffer sent twice is only cleaned once.
+ *
+ * For a DmaChunk_t based transfer, BufDesc_setupTransfer() and
+ * BufDesc_transferDone() replace DmaBuffer_setupTransfer() and
+ * DmaBuffer_transferDone(), holding a reference for the duration.
+ *
+ * The descriptor itself is not locked. A buffer should only have one
+ * writer at a time, although any number of holders may read it.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef BUF_DESC_H_
+#define BUF_DESC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "Util/driver_dma.h"
+#include "Util/dma_buffer.h"
+#include "Util/error.h"
+
+// Which side last touched the data
+typedef enum {
+    BUF_CACHE_CPU,      // CPU may hold dirty lines
+    BUF_CACHE_CLEAN,    // Memory matches the caches
+    BUF_CACHE_DEVICE    // Device has written memory, CPU must invalidate
+} BufCacheState;
+
+// Direction of a device access
+typedef enum {
+    BUF_DEVICE_READS,   // Device reads the buffer (e.g. UART transmit)
+    BUF_DEVICE_WRITES   // Device writes the buffer (e.g. UART receive)
+} BufAccess;
+
+typedef struct BufDesc_t BufDesc_t;
+
+// Called when the last reference is dropped
+typedef void (*BufReleaseFunc_t)(BufDesc_t* buf, void* param);
+
+// Buffer descriptor
+struct BufDesc_t {
+    void*                  data;
+    size_t                 length;  // Valid bytes
+    size_t                 size;    // Capacity in bytes
+    volatile BufCacheState cache;
+    volatile unsigned int  refs;
+    BufReleaseFunc_t       release;
+    void*                  param;
+};
+
+// Initialise a descriptor for an existing buffer
+//  - size is the capacity of the buffer in bytes, and length the number
+//    of valid bytes currently in it.
+//  - release is called (with param) when the last reference is dropped.
+//    May be NULL for a statically allocated buffer.
+//  - The descriptor starts with one reference held by the caller, and
+//    in the BUF_CACHE_CPU state.
+HpsErr_t BufDesc_init(BufDesc_t* buf, void* data, size_t size, size_t length, BufReleaseFunc_t release, void* param);
+
+// Allocate a buffer and descriptor
+//  - The data is allocated from the DMA buffer pool, and the descriptor
+//    from the memory pool. Both are freed when the last reference is
+//    dropped.
+//  - length is initially zero.
+//  - Returns descriptor pointer to *pBuf
+HpsErr_t BufDesc_alloc(DmaBufferCtx_t* pool, size_t size, BufDesc_t** pBuf);
+
+// Take a reference to a buffer
+//  - Returns the new reference count.
+HpsErr_t BufDesc_retain(BufDesc_t* buf);
+
+// Drop a reference to a buffer
+//  - Calls the release function if this was the last reference. The
+//    descriptor must not be used after that.
+//  - Returns the remaining reference count.
+HpsErr_t BufDesc_release(BufDesc_t* buf);
+
+// Get the current reference count
+unsigned int BufDesc_refs(BufDesc_t* buf);
+
+// Prepare a buffer for a device access
+//  - For BUF_DEVICE_READS, cleans the valid length if the CPU may have
+//    dirty lines.
+//  - For BUF_DEVICE_WRITES, purges the whole capacity unless a device
+//    has written it since the CPU last did.
+HpsErr_t BufDesc_prepareDevice(BufDesc_t* buf, BufAccess access);
+
+// Complete a device access
+//  - After BUF_DEVICE_WRITES, marks the buffer as needing invalidation
+//    before the CPU reads it.
+HpsErr_t BufDesc_completeDevice(BufDesc_t* buf, BufAccess access);
+
+// Prepare a buffer for CPU access
+//  - Invalidates the whole capacity if a device has written it.
+//  - If cpuWrites is true, the buffer is then marked as possibly dirty.
+HpsErr_t BufDesc_prepareCpu(BufDesc_t* buf, bool cpuWrites);
+
+// Configure a DMA transfer to or from a buffer
+//  - access says whether xfer reads from (BUF_DEVICE_READS) or writes
+//    to (BUF_DEVICE_WRITES) the buffer. The other side of xfer is not
+//    maintained, so should be a peripheral or another descriptor which
+//    has been prepared separately.
+//  - Takes a reference, which is dropped by BufDesc_transferDone().
+//  - If DMA_setupTransfer() returns ERR_SKIPPED or fails, the transfer
+//    is completed and the reference dropped before returning.
+HpsErr_t BufDesc_setupTransfer(DmaCtx_t* dma, DmaChunk_t* xfer, BufDesc_t* buf, BufAccess access, bool autoStart);
+
+// Check if a DMA transfer to or from a buffer is done
+//  - Calls DMA_transferDone(). Once no longer busy (whether successful
+//    or not), completes the access and drops the reference taken by
+//    BufDesc_setupTransfer().
+HpsErr_t BufDesc_transferDone(DmaCtx_t* dma, BufDesc_t* buf, BufAccess access);
+
+#endif /* BUF_DESC_H_ */
@@ -0,0 +1,355 @@
+/*
+ * Clock Profiles
+ * --------------
+ *
+ * Switches the HPS between a set of clock profiles at runtime
+ * by reprogramming the clock manager dividers, and notifies
+ * drivers whose timing depends on those clocks.
+ *
+ * On the Cyclone V, divider changes are made through the HWLib
+ * clock manager, which checks them against the frequency limits
+ * of each clock, and gates the L4 clocks while their dividers
+ * change. The Arria 10 HWLib can only read clock rates, so the
+ * MPU counter and NoC (L4) dividers are written directly.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add Arria 10 clock manager support
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "clk_profile.h"
+
+#include "Util/irq.h"
+#include "Util/timestamp.h"
+
+#if defined(__arm__)
+#define CLK_PROFILE_SUPPORTED
+#endif
+
+#if defined(CLK_PROFILE_SUPPORTED)
+
+#if defined(__ARRIA10__)
+
+#include "Util/hwlib/a10/alt_clock_manager.h"
+#include "Util/hwlib/a10/socal/hps.h"
+#include "Util/hwlib/a10/socal/alt_clkmgr.h"
+
+// Maximum L4 clock divider (NoC dividers are 1, 2, 4 or 8)
+#define CLK_PROFILE_L4_DIV_MAX 8
+
+// MPU clock source select, and the counters which divide it
+//  - The counter used depends on whether the source is the main or
+//    peripheral PLL. Both are in the alteragrp MPU clock register.
+#define CLK_PROFILE_MPU_SRC    (volatile uint32_t *)ALT_CLKMGR_MAINPLL_MPUCLK_ADDR
+#define CLK_PROFILE_MPU_CNT    (volatile uint32_t *)ALT_CLKMGR_ALTERA_ADDR
+#define CLK_PROFILE_MPU_PERI   ALT_CLKMGR_NOCCLK_PERICNT_LSB
+#define CLK_PROFILE_MPU_MASK   0x7FF
+
+// NoC clock divider register, holding the L4 MP and SP dividers
+#define CLK_PROFILE_NOCDIV     (volatile uint32_t *)ALT_CLKMGR_MAINPLL_NOCDIV_ADDR
+
+#else
+
+#include "Util/hwlib/cv/alt_clock_manager.h"
+
+// Initialises clock manager frequency limits from current configuration.
+// (Declared in the header as alt_clk_clkmgr_init, but defined under this name)
+extern ALT_STATUS_CODE alt_clk_clkmgr_reinit(void);
+
+// Maximum L4 clock divider
+#define CLK_PROFILE_L4_DIV_MAX 16
+
+#endif
+
+typedef struct {
+    ClkNotifyFunc_t func;
+    void*           param;
+} ClkNotify_t;
+
+static bool          _clkInit = false;
+static ClkProfile    _clkProfile = CLK_PROFILE_PERFORMANCE;
+static uint32_t      _clkBaseMpu;        // Boot dividers
+static uint32_t      _clkBaseL4mp;
+static uint32_t      _clkBaseL4sp;
+static ClkNotify_t   _clkNotify[CLK_PROFILE_MAX_NOTIFY];
+static IrqSpinlock_t _clkLock = {0};
+
+/*
+ * Internal Functions
+ */
+
+#if !defined(__ARRIA10__)
+// Convert HWLib status code
+static HpsErr_t _ClkProfile_status(ALT_STATUS_CODE status) {
+    switch (status) {
+        case ALT_E_SUCCESS:   return ERR_SUCCESS;
+        case ALT_E_ARG_RANGE: return ERR_OUTRANGE;
+        case ALT_E_BAD_ARG:   return ERR_BADID;
+        default:              return ERR_IOFAIL;
+    }
+}
+#endif
+
+// Get the rate of a clock in Hz
+static unsigned int _ClkProfile_freq(ALT_CLK_t clk) {
+    alt_freq_t freq = 0;
+    if (alt_clk_freq_get(clk, &freq) != ALT_E_SUCCESS) return 0;
+    return freq;
+}
+
+// Read the current clock rates
+static void _ClkProfile_rates(ClkRates_t* rates) {
+    rates->mpu    = _ClkProfile_freq(ALT_CLK_MPU);
+    rates->periph = _ClkProfile_freq(ALT_CLK_MPU_PERIPH);
+    rates->l4mp   = _ClkProfile_freq(ALT_CLK_L4_MP);
+    rates->l4sp   = _ClkProfile_freq(ALT_CLK_L4_SP);
+}
+
+#if defined(__ARRIA10__)
+
+// Get the position of the MPU counter for the current source
+//  - Returns ERR_NOSUPPORT if the MPU is not clocked from a PLL.
+static HpsErr_t _ClkProfile_mpuShift(void) {
+    switch (ALT_CLKMGR_MAINPLL_MPUCLK_SRC_GET(*CLK_PROFILE_MPU_SRC)) {
+        case ALT_CLKMGR_MAINPLL_MPUCLK_SRC_E_MAIN: return 0;
+        case ALT_CLKMGR_MAINPLL_MPUCLK_SRC_E_PERI: return CLK_PROFILE_MPU_PERI;
+        default:                                   return ERR_NOSUPPORT;
+    }
+}
+
+// Prepare the clock manager for divider changes
+static HpsErr_t _ClkProfile_clkmgrInit(void) {
+    HpsErr_t shift = _ClkProfile_mpuShift();
+    return ERR_IS_ERROR(shift) ? shift : ERR_SUCCESS;
+}
+
+// Read a clock divider
+static HpsErr_t _ClkProfile_getDivider(ALT_CLK_t clk, uint32_t* div) {
+    uint32_t nocdiv = *CLK_PROFILE_NOCDIV;
+    switch (clk) {
+        case ALT_CLK_MPU: {
+            HpsErr_t shift = _ClkProfile_mpuShift();
+            if (ERR_IS_ERROR(shift)) return shift;
+            *div = ((*CLK_PROFILE_MPU_CNT >> shift) & CLK_PROFILE_MPU_MASK) + 1;
+            return ERR_SUCCESS;
+        }
+        case ALT_CLK_L4_MP: *div = 1U << ALT_CLKMGR_MAINPLL_NOCDIV_L4MPCLK_GET(nocdiv); return ERR_SUCCESS;
+        case ALT_CLK_L4_SP: *div = 1U << ALT_CLKMGR_MAINPLL_NOCDIV_L4SPCLK_GET(nocdiv); return ERR_SUCCESS;
+        default:            return ERR_BADID;
+    }
+}
+
+// Change a clock divider
+//  - L4 dividers must be a power of two.
+static HpsErr_t _ClkProfile_setDivider(ALT_CLK_t clk, uint32_t div) {
+    if (!div) return ERR_OUTRANGE;
+    if (clk == ALT_CLK_MPU) {
+        HpsErr_t shift = _ClkProfile_mpuShift();
+        if (ERR_IS_ERROR(shift)) return shift;
+        if ((div - 1) > CLK_PROFILE_MPU_MASK) return ERR_OUTRANGE;
+        uint32_t cnt = *CLK_PROFILE_MPU_CNT & ~(CLK_PROFILE_MPU_MASK << shift);
+        *CLK_PROFILE_MPU_CNT = cnt | ((div - 1) << shift);
+        return ERR_SUCCESS;
+    }
+    if ((div > CLK_PROFILE_L4_DIV_MAX) || (div & (div - 1))) return ERR_OUTRANGE;
+    uint32_t log2div = 0;
+    while ((1U << log2div) < div) log2div++;
+    uint32_t nocdiv = *CLK_PROFILE_NOCDIV;
+    switch (clk) {
+        case ALT_CLK_L4_MP:
+            nocdiv = (nocdiv & ALT_CLKMGR_MAINPLL_NOCDIV_L4MPCLK_CLR_MSK) | ALT_CLKMGR_MAINPLL_NOCDIV_L4MPCLK_SET(log2div);
+            break;
+        case ALT_CLK_L4_SP:
+            nocdiv = (nocdiv & ALT_CLKMGR_MAINPLL_NOCDIV_L4SPCLK_CLR_MSK) | ALT_CLKMGR_MAINPLL_NOCDIV_L4SPCLK_SET(log2div);
+            break;
+        default:
+            return ERR_BADID;
+    }
+    *CLK_PROFILE_NOCDIV = nocdiv;
+    return ERR_SUCCESS;
+}
+
+#else
+
+// Prepare the clock manager for divider changes
+static HpsErr_t _ClkProfile_clkmgrInit(void) {
+    return _ClkProfile_status(alt_clk_clkmgr_reinit());
+}
+
+// Read a clock divider
+static HpsErr_t _ClkProfile_getDivider(ALT_CLK_t clk, uint32_t* div) {
+    return _ClkProfile_status(alt_clk_divider_get(clk, div));
+}
+
+// Change a clock divider
+static HpsErr_t _ClkProfile_setDivider(ALT_CLK_t clk, uint32_t div) {
+    return _ClkProfile_status(alt_clk_divider_set(clk, div));
+}
+
+#endif
+
+// Get the L4 divider for a profile
+//  - L4 dividers must be a power of two no larger than CLK_PROFILE_L4_DIV_MAX.
+static uint32_t _ClkProfile_l4Div(uint32_t base, uint32_t factor) {
+    uint32_t div = base * factor;
+    return (div > CLK_PROFILE_L4_DIV_MAX) ? CLK_PROFILE_L4_DIV_MAX : div;
+}
+
+#endif
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise clock profiles
+//  - Saves the current (preloader) clock configuration as the performance profile.
+//  - Returns ERR_NOSUPPORT if the clock manager is not supported.
+HpsErr_t ClkProfile_initialise(void) {
+#if defined(CLK_PROFILE_SUPPORTED)
+    if (_clkInit) return ERR_SUCCESS;
+    //Capture the frequency limits of the boot configuration
+    HpsErr_t status = _ClkProfile_clkmgrInit();
+    if (ERR_IS_ERROR(status)) return status;
+    //And the boot dividers, which are the performance profile
+    status = _ClkProfile_getDivider(ALT_CLK_MPU, &_clkBaseMpu);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _ClkProfile_getDivider(ALT_CLK_L4_MP, &_clkBaseL4mp);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _ClkProfile_getDivider(ALT_CLK_L4_SP, &_clkBaseL4sp);
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < CLK_PROFILE_MAX_NOTIFY; idx++) {
+        _clkNotify[idx].func = NULL;
+    }
+    _clkProfile = CLK_PROFILE_PERFORMANCE;
+    _clkInit = true;
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Switch clock profile
+//  - Reprograms the dividers for the profile, then calls each notify function.
+//  - Returns ERR_NOINIT if not initialised.
+HpsErr_t ClkProfile_set(ClkProfile profile) {
+#if defined(CLK_PROFILE_SUPPORTED)
+    if (!_clkInit) return ERR_NOINIT;
+    uint32_t mpuFactor, l4Factor;
+    switch (profile) {
+        case CLK_PROFILE_PERFORMANCE: mpuFactor = 1; l4Factor = 1; break;
+        case CLK_PROFILE_BALANCED:    mpuFactor = 2; l4Factor = 1; break;
+        case CLK_PROFILE_LOW_POWER:   mpuFactor = 4; l4Factor = 2; break;
+        default:                      return ERR_BADID;
+    }
+    //Change the dividers with interrupts masked so no handler runs with the
+    //clocks part way through changing.
+    HpsErr_t irqState = IRQ_spinLock(&_clkLock);
+    HpsErr_t status = _ClkProfile_setDivider(ALT_CLK_MPU, _clkBaseMpu * mpuFactor);
+    if (ERR_IS_SUCCESS(status)) {
+        status = _ClkProfile_setDivider(ALT_CLK_L4_MP, _ClkProfile_l4Div(_clkBaseL4mp, l4Factor));
+    }
+    if (ERR_IS_SUCCESS(status)) {
+        status = _ClkProfile_setDivider(ALT_CLK_L4_SP, _ClkProfile_l4Div(_clkBaseL4sp, l4Factor));
+    }
+    if (ERR_IS_SUCCESS(status)) {
+        _clkProfile = profile;
+    }
+    ClkRates_t rates;
+    _ClkProfile_rates(&rates);
+    //Keep timestamps converting correctly
+    if (rates.periph) time_setClock(rates.periph);
+    //Take a copy of the notify list so functions can be called unlocked
+    ClkNotify_t notify[CLK_PROFILE_MAX_NOTIFY];
+    for (unsigned int idx = 0; idx < CLK_PROFILE_MAX_NOTIFY; idx++) {
+        notify[idx] = _clkNotify[idx];
+    }
+    IRQ_spinUnlock(&_clkLock, irqState);
+    //Notify of the new rates. Done even on failure, as some dividers may
+    //have changed before it.
+    for (unsigned int idx = 0; idx < CLK_PROFILE_MAX_NOTIFY; idx++) {
+        if (notify[idx].func) notify[idx].func(&rates, notify[idx].param);
+    }
+    return status;
+#else
+    (void)profile;
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Get the current clock profile
+//  - Returns the profile, or ERR_NOINIT if not initialised.
+HpsErr_t ClkProfile_get(void) {
+#if defined(CLK_PROFILE_SUPPORTED)
+    if (!_clkInit) return ERR_NOINIT;
+    return (HpsErr_t)_clkProfile;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Get the current clock rates
+HpsErr_t ClkProfile_getRates(ClkRates_t* rates) {
+    if (!rates) return ERR_NULLPTR;
+#if defined(CLK_PROFILE_SUPPORTED)
+    _ClkProfile_rates(rates);
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Register a notify function
+//  - func is called with param after each profile change.
+//  - Returns ERR_NOSPACE if CLK_PROFILE_MAX_NOTIFY are already registered.
+HpsErr_t ClkProfile_registerNotify(ClkNotifyFunc_t func, void* param) {
+    if (!func) return ERR_NULLPTR;
+#if defined(CLK_PROFILE_SUPPORTED)
+    if (!_clkInit) return ERR_NOINIT;
+    HpsErr_t status = ERR_NOSPACE;
+    HpsErr_t irqState = IRQ_spinLock(&_clkLock);
+    for (unsigned int idx = 0; idx < CLK_PROFILE_MAX_NOTIFY; idx++) {
+        if (!_clkNotify[idx].func) {
+            _clkNotify[idx].func = func;
+            _clkNotify[idx].param = param;
+            status = ERR_SUCCESS;
+            break;
+        }
+    }
+    IRQ_spinUnlock(&_clkLock, irqState);
+    return status;
+#else
+    (void)param;
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Unregister a notify function
+//  - Returns ERR_NOTFOUND if func was not registered with param.
+HpsErr_t ClkProfile_unregisterNotify(ClkNotifyFunc_t func, void* param) {
+    if (!func) return ERR_NULLPTR;
+#if defined(CLK_PROFILE_SUPPORTED)
+    if (!_clkInit) return ERR_NOINIT;
+    HpsErr_t status = ERR_NOTFOUND;
+    HpsErr_t irqState = IRQ_spinLock(&_clkLock);
+    for (unsigned int idx = 0; idx < CLK_PROFILE_MAX_NOTIFY; idx++) {
+        if ((_clkNotify[idx].func == func) && (_clkNotify[idx].param == param)) {
+            _clkNotify[idx].func = NULL;
+            status = ERR_SUCCESS;
+            break;
+        }
+    }
+    IRQ_spinUnlock(&_clkLock, irqState);
+    return status;
+#else
+    (void)param;
+    return ERR_NOSUPPORT;
+#endif
+}
@@ -0,0 +1,131 @@
+/*
+ * Clock Profiles
+ * --------------
+ *
+ * Switches the HPS between a set of clock profiles at runtime
+ * by reprogramming the clock manager dividers, and notifies
+ * drivers whose timing depends on those clocks so that they
+ * can recalculate their own dividers.
+ *
+ *    ClkProfile_initialise();
+ *    ClkProfile_registerNotify(&uartClockChanged, uart);
+ *    ...
+ *    ClkProfile_set(CLK_PROFILE_LOW_POWER);     // Idle
+ *    ClkProfile_set(CLK_PROFILE_PERFORMANCE);   // Burst of work
+ *
+ *    static void uartClockChanged(const ClkRates_t* rates, void* param) {
+ *        HPS_UART_setPeriphClock((HPSUARTCtx_t*)param, rates->l4sp);
+ *    }
+ *
+ * Profiles
+ * --------
+ *
+ * The performance profile is the clock configuration chosen by
+ * the preloader, which already runs the MPU and L4 clocks at the
+ * highest rates the PLLs are configured for. The other profiles
+ * divide these down:
+ *
+ *   - CLK_PROFILE_PERFORMANCE: Boot MPU and L4 clocks.
+ *   - CLK_PROFILE_BALANCED:    MPU at 1/2. L4 clocks unchanged.
+ *   - CLK_PROFILE_LOW_POWER:   MPU at 1/4. L4 MP and SP at 1/2.
+ *
+ * Only the PLL output dividers are changed, never the PLL VCOs,
+ * so there is no PLL relock or bypass, and the L3, SDRAM and
+ * peripheral PLL clocks (e.g. SDMMC) are unaffected. The MPU
+ * divider is hardware managed, so changes glitch free. The L4
+ * dividers are changed with their clocks briefly gated, so any
+ * L4 peripheral transfers should be idle during a change.
+ *
+ * Dependent Clocks
+ * ----------------
+ *
+ * PERIPHCLK (the A9 private and global timers) is 1/4 of the MPU
+ * clock, so changes with it. Util/timestamp is updated for this
+ * automatically. Other drivers must register a notify function,
+ * which is called after each change with the new rates:
+ *
+ *   - HPS_UART and HPS_SPI (L4 SP): call HPS_UART_setPeriphClock()
+ *     or HPS_SPI_setPeriphClock() with rates->l4sp.
+ *   - HPS_usleep on an SP timer (L4 SP): call setTimerFrequency()
+ *     with rates->l4sp.
+ *   - Private timer users (PERIPHCLK): reconfigure with
+ *     rates->periph.
+ *
+ * The Cyclone V and Arria 10 (-D __ARRIA10__) clock managers are
+ * supported. On the Arria 10 the L4 clocks come from the NoC
+ * dividers, which can be at most 8, and the MPU must be clocked
+ * from the main or peripheral PLL. On other targets, or if the
+ * MPU is clocked from elsewhere, ClkProfile_initialise() returns
+ * ERR_NOSUPPORT.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add Arria 10 clock manager support
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef CLK_PROFILE_H_
+#define CLK_PROFILE_H_
+
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Maximum number of notify functions
+#ifndef CLK_PROFILE_MAX_NOTIFY
+#define CLK_PROFILE_MAX_NOTIFY 8
+#endif
+
+typedef enum {
+    CLK_PROFILE_PERFORMANCE,
+    CLK_PROFILE_BALANCED,
+    CLK_PROFILE_LOW_POWER,
+    CLK_PROFILE_COUNT
+} ClkProfile;
+
+// Clock rates in Hz
+typedef struct {
+    unsigned int mpu;       // MPU (CPU) clock
+    unsigned int periph;    // PERIPHCLK, for the private and global timers
+    unsigned int l4mp;      // L4 MP clock
+    unsigned int l4sp;      // L4 SP clock, for UART, SPI master and SP timers
+} ClkRates_t;
+
+// Clock change notify function
+//  - Called after each profile change with the new rates.
+typedef void (*ClkNotifyFunc_t)(const ClkRates_t* rates, void* param);
+
+// Initialise clock profiles
+//  - Saves the current (preloader) clock configuration as the performance profile.
+//  - Returns ERR_NOSUPPORT if the clock manager is not supported.
+HpsErr_t ClkProfile_initialise(void);
+
+// Switch clock profile
+//  - Reprograms the dividers for the profile, then calls each notify function.
+//  - Returns ERR_NOINIT if not initialised.
+HpsErr_t ClkProfile_set(ClkProfile profile);
+
+// Get the current clock profile
+//  - Returns the profile, or ERR_NOINIT if not initialised.
+HpsErr_t ClkProfile_get(void);
+
+// Get the current clock rates
+HpsErr_t ClkProfile_getRates(ClkRates_t* rates);
+
+// Register a notify function
+//  - func is called with param after each profile change.
+//  - Returns ERR_NOSPACE if CLK_PROFILE_MAX_NOTIFY are already registered.
+HpsErr_t ClkProfile_registerNotify(ClkNotifyFunc_t func, void* param);
+
+// Unregister a notify function
+//  - Returns ERR_NOTFOUND if func was not registered with param.
+HpsErr_t ClkProfile_unregisterNotify(ClkNotifyFunc_t func, void* param);
+
+#endif /* CLK_PROFILE_H_ */
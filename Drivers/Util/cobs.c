@@ -0,0 +1,160 @@
+/*
+ * COBS Framing
+ * ------------
+ *
+ * Consistent Overhead Byte Stuffing encoding and decoding, for
+ * packet framing over byte streams such as a UART.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "cobs.h"
+
+/*
+ * Internal Functions
+ */
+
+// Emit the current block and start a new one
+static HpsErr_t _cobs_flush(CobsEncoder_t* enc, CobsEmitFunc_t emit, void* param) {
+    enc->block[0] = (uint8_t)(enc->fill + 1);
+    HpsErr_t status = emit(param, enc->block, enc->fill + 1);
+    enc->fill = 0;
+    return status;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Start encoding a frame
+void cobs_encodeInit(CobsEncoder_t* enc) {
+    enc->fill = 0;
+}
+
+// Encode data
+//  - May be called any number of times per frame.
+//  - Returns ERR_SUCCESS, or the first error returned by emit.
+HpsErr_t cobs_encode(CobsEncoder_t* enc, const void* data, size_t len, CobsEmitFunc_t emit, void* param) {
+    if (!enc || !emit || (len && !data)) return ERR_NULLPTR;
+    const uint8_t* src = data;
+    const uint8_t* end = src + len;
+    unsigned int fill = enc->fill;
+    while (src != end) {
+        uint8_t byte = *src++;
+        if (byte == COBS_DELIMITER) {
+            // Zero ends the block, and is implied by its code
+            enc->fill = fill;
+            HpsErr_t status = _cobs_flush(enc, emit, param);
+            if (ERR_IS_ERROR(status)) return status;
+            fill = 0;
+            continue;
+        }
+        enc->block[++fill] = byte;
+        if (fill == COBS_BLOCK_MAX) {
+            // Full block, code 0xFF with no implied zero
+            enc->fill = fill;
+            HpsErr_t status = _cobs_flush(enc, emit, param);
+            if (ERR_IS_ERROR(status)) return status;
+            fill = 0;
+        }
+    }
+    enc->fill = fill;
+    return ERR_SUCCESS;
+}
+
+// Finish encoding a frame
+//  - Emits the last block and the delimiter. The encoder is ready for the
+//    next frame.
+//  - Returns ERR_SUCCESS, or the first error returned by emit.
+HpsErr_t cobs_encodeEnd(CobsEncoder_t* enc, CobsEmitFunc_t emit, void* param) {
+    if (!enc || !emit) return ERR_NULLPTR;
+    // The last block's implied zero is dropped by the decoder, so the block
+    // and delimiter can be sent together.
+    enc->block[enc->fill + 1] = COBS_DELIMITER;
+    enc->block[0] = (uint8_t)(enc->fill + 1);
+    HpsErr_t status = emit(param, enc->block, enc->fill + 2);
+    enc->fill = 0;
+    return status;
+}
+
+// Start decoding into a buffer
+//  - buf has space for size bytes of decoded frame.
+void cobs_decodeInit(CobsDecoder_t* dec, void* buf, size_t size) {
+    dec->buf = buf;
+    dec->size = size;
+    dec->len = 0;
+    dec->remaining = 0;
+    dec->zeroPending = false;
+    dec->overflow = false;
+    dec->done = false;
+}
+
+// Decode received bytes
+//  - Consumes bytes from in up to and including the first delimiter, and
+//    returns the number consumed in *used.
+//  - Returns the length of the decoded frame when a delimiter is reached,
+//    which may be 0 for back to back delimiters. The frame is in the buffer
+//    until the next call.
+//  - Returns ERR_AGAIN if all of in was used without reaching a delimiter.
+//  - Returns ERR_CORRUPT or ERR_NOSPACE at the delimiter of a frame which was
+//    malformed or too long for the buffer.
+HpsErr_t cobs_decode(CobsDecoder_t* dec, const void* in, size_t len, size_t* used) {
+    if (!dec || !used || (len && !in)) return ERR_NULLPTR;
+    const uint8_t* src = in;
+    size_t idx = 0;
+    // The previous frame has been handed over, so start a new one
+    if (dec->done) {
+        dec->len = 0;
+        dec->done = false;
+    }
+    while (idx < len) {
+        uint8_t byte = src[idx++];
+        if (byte == COBS_DELIMITER) {
+            // A frame can't end part way through a block
+            HpsErr_t result;
+            if (dec->overflow) {
+                result = ERR_NOSPACE;
+            } else if (dec->remaining) {
+                result = ERR_CORRUPT;
+            } else {
+                result = (HpsErr_t)dec->len;
+            }
+            dec->remaining = 0;
+            dec->zeroPending = false;
+            dec->overflow = false;
+            dec->done = true;
+            *used = idx;
+            return result;
+        }
+        if (dec->overflow) continue;
+        if (!dec->remaining) {
+            // Code byte. The previous block's zero is now known not to be the last.
+            if (dec->zeroPending) {
+                if (dec->len >= dec->size) {
+                    dec->overflow = true;
+                    continue;
+                }
+                dec->buf[dec->len++] = 0;
+            }
+            dec->remaining = byte - 1U;
+            dec->zeroPending = (byte != 0xFF);
+            continue;
+        }
+        if (dec->len >= dec->size) {
+            dec->overflow = true;
+            continue;
+        }
+        dec->buf[dec->len++] = byte;
+        dec->remaining--;
+    }
+    *used = idx;
+    return ERR_AGAIN;
+}
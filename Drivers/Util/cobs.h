@@ -0,0 +1,117 @@
+/*
+ * COBS Framing
+ * ------------
+ *
+ * Consistent Overhead Byte Stuffing encoding and decoding, for
+ * packet framing over byte streams such as a UART.
+ *
+ * COBS removes every zero byte from the data, so that a zero can
+ * be used as an unambiguous frame delimiter. The data is split into
+ * blocks of up to 254 non-zero bytes, each preceded by a code byte
+ * giving its length (plus one). A code below 0xFF means the block
+ * was followed by a zero. The overhead is at most one byte in 254,
+ * plus the delimiter, and a receiver can resynchronise at the next
+ * zero after any corruption.
+ *
+ * Both directions are streaming, so frames can be encoded from
+ * several buffers (e.g. a header, the caller's payload and a CRC)
+ * without first assembling them, and decoded as bytes arrive:
+ *
+ *    cobs_encodeInit(&enc);
+ *    cobs_encode(&enc, header, sizeof(header), &emit, param);
+ *    cobs_encode(&enc, payload, payloadLen, &emit, param);
+ *    cobs_encodeEnd(&enc, &emit, param);
+ *
+ * emit() is given each encoded block as it is completed, so only one
+ * block (255 bytes) is held by the encoder.
+ *
+ *    cobs_decodeInit(&dec, frame, sizeof(frame));
+ *    while (len) {
+ *        size_t used;
+ *        HpsErr_t frameLen = cobs_decode(&dec, rx, len, &used);
+ *        rx += used; len -= used;
+ *        if (frameLen > 0) ... frame[0..frameLen-1] is a complete frame
+ *    }
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef COBS_H_
+#define COBS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Frame delimiter
+#define COBS_DELIMITER    0x00
+
+// Maximum number of data bytes in a block
+#define COBS_BLOCK_MAX    254
+
+// Maximum encoded length of n bytes, including the delimiter
+#define COBS_MAX_ENCODED(n) ((n) + ((n) / COBS_BLOCK_MAX) + 2)
+
+// Encoded block output
+//  - Called with each completed block, and finally the delimiter.
+//  - Returns an error code to stop encoding.
+typedef HpsErr_t (*CobsEmitFunc_t)(void* param, const uint8_t* data, size_t len);
+
+// Streaming encoder state
+typedef struct {
+    uint8_t block[COBS_BLOCK_MAX + 1];  // Code byte then data
+    unsigned int fill;                  // Data bytes in block
+} CobsEncoder_t;
+
+// Streaming decoder state
+typedef struct {
+    uint8_t* buf;           // Decoded frame
+    size_t size;
+    size_t len;
+    unsigned int remaining; // Data bytes left in current block, 0 if next is a code
+    bool zeroPending;       // Current block is followed by a zero, unless the frame ends
+    bool overflow;          // Frame is too long for buf, skip to the next delimiter
+    bool done;              // buf holds a complete frame, cleared by the next call
+} CobsDecoder_t;
+
+// Start encoding a frame
+void cobs_encodeInit(CobsEncoder_t* enc);
+
+// Encode data
+//  - May be called any number of times per frame.
+//  - Returns ERR_SUCCESS, or the first error returned by emit.
+HpsErr_t cobs_encode(CobsEncoder_t* enc, const void* data, size_t len, CobsEmitFunc_t emit, void* param);
+
+// Finish encoding a frame
+//  - Emits the last block and the delimiter. The encoder is ready for the
+//    next frame.
+//  - Returns ERR_SUCCESS, or the first error returned by emit.
+HpsErr_t cobs_encodeEnd(CobsEncoder_t* enc, CobsEmitFunc_t emit, void* param);
+
+// Start decoding into a buffer
+//  - buf has space for size bytes of decoded frame.
+void cobs_decodeInit(CobsDecoder_t* dec, void* buf, size_t size);
+
+// Decode received bytes
+//  - Consumes bytes from in up to and including the first delimiter, and
+//    returns the number consumed in *used.
+//  - Returns the length of the decoded frame when a delimiter is reached,
+//    which may be 0 for back to back delimiters. The frame is in the buffer
+//    until the next call.
+//  - Returns ERR_AGAIN if all of in was used without reaching a delimiter.
+//  - Returns ERR_CORRUPT or ERR_NOSPACE at the delimiter of a frame which was
+//    malformed or too long for the buffer.
+HpsErr_t cobs_decode(CobsDecoder_t* dec, const void* in, size_t len, size_t* used);
+
+#endif /* COBS_H_ */
@@ -23,7 +23,15 @@
  * If `FAILBACK_SOFTWARE_CRC32` is defined for this files
  * compilation unit, a software based CRC32 calculation
  * routine is included as a failback when the CRC driver
- * context has not been set.
+ * context has not been set. This processes eight bytes
+ * per iteration (slicing-by-8), with tables generated
+ * in RAM on first use.
+ * 
+ * `crc32_wd()` streams the buffer through the CRC
+ * processor (see `CRC_streamInit()`), so it is only
+ * initialised once. If a timer has been set with
+ * `crc32_setTimer()`, the watchdog is reset once per
+ * interval of that timer rather than after every chunk.
  * 
  * (*) XOR with 0xFFFFFFFF is applied by the crc32 API
  * so should not be performed by the CRC driver.
@@ -35,6 +43,9 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Software failback uses slicing-by-8.
+ *            | crc32_wd streams through the CRC processor, with
+ *            | timer based watchdog resets.
  * 07/07/2024 | Creation of driver.
  */
 
@@ -94,7 +105,7 @@
  * Original file: http://www.opensource.apple.com/source/xnu/xnu-1456.1.26/bsd/libkern/crc32.c
  */
 
-static uint32_t crc32_tab[] = {
+static const uint32_t crc32_tab[] = {
     0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f,
     0xe963a535, 0x9e6495a3, 0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988,
     0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91, 0x1db71064, 0x6ab020f2,
@@ -140,28 +151,65 @@ static uint32_t crc32_tab[] = {
     0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
-// Note: Modified function name
-static uint32_t
-_crc32_failback(uint32_t crc, const void *buf, size_t size)
-{
-	const uint8_t *p;
-
-	p = buf;
-	crc = crc ^ ~0U;
+/*
+ * ----- End copyright included file ----
+ */
 
-	while (size--)
-		crc = crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+// Slicing-by-8 tables. crc32_slice[k][i] is the CRC of byte i followed
+// by k+1 zero bytes, allowing eight bytes to be processed per iteration
+// with eight independent table lookups. Generated from crc32_tab on first
+// use rather than stored, saving 7kB of image size.
+static uint32_t crc32_slice[7][256];
+static bool crc32_sliceReady = false;
 
-	return crc ^ ~0U;
+static void _crc32_failback_init(void) {
+    for (unsigned int idx = 0; idx < 256; idx++) {
+        uint32_t crc = crc32_tab[idx];
+        for (unsigned int slice = 0; slice < 7; slice++) {
+            crc = crc32_tab[crc & 0xFF] ^ (crc >> 8);
+            crc32_slice[slice][idx] = crc;
+        }
+    }
+    crc32_sliceReady = true;
 }
 
-/*
- * ----- End copyright included file ----
- */
+// Software CRC32 using slicing-by-8
+static uint32_t _crc32_failback(uint32_t crc, const void *buf, size_t size) {
+    const uint8_t *p = buf;
+    if (!crc32_sliceReady) _crc32_failback_init();
+    crc = crc ^ ~0U;
+    // Byte at a time until word aligned
+    while (size && ((uintptr_t)p & 3)) {
+        crc = crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        size--;
+    }
+    // Then eight bytes at a time (little endian)
+    while (size >= 8) {
+        uint32_t lo = *(const uint32_t*)p ^ crc;
+        uint32_t hi = *(const uint32_t*)(p + 4);
+        crc = crc32_slice[6][ lo        & 0xFF] ^
+              crc32_slice[5][(lo >>  8) & 0xFF] ^
+              crc32_slice[4][(lo >> 16) & 0xFF] ^
+              crc32_slice[3][ lo >> 24        ] ^
+              crc32_slice[2][ hi        & 0xFF] ^
+              crc32_slice[1][(hi >>  8) & 0xFF] ^
+              crc32_slice[0][(hi >> 16) & 0xFF] ^
+              crc32_tab     [ hi >> 24        ];
+        p += 8;
+        size -= 8;
+    }
+    // And any remaining bytes
+    while (size--) {
+        crc = crc32_tab[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ ~0U;
+}
 
 #endif
 
 static CRCCtx_t* _crc32Proc = NULL;
+static TimerCtx_t* _crc32Timer = NULL;
+static unsigned int _crc32WdInterval = 0;
 
 // Base CRC32 function for driver calls
 static uint32_t _crc32_driver(uint32_t crc, const uint8_t *p, uint32_t len) {
@@ -170,6 +218,18 @@ static uint32_t _crc32_driver(uint32_t crc, const uint8_t *p, uint32_t len) {
     return ERR_IS_ERROR(status) ? (uint32_t)-1 : (crc ^ ~0U);
 }
 
+// Reset the watchdog if due
+// - Without a timer, always resets.
+static void _crc32_kick(unsigned int* lastTime) {
+    unsigned int curTime;
+    if (_crc32Timer && ERR_IS_SUCCESS(Timer_getTime(_crc32Timer, &curTime))) {
+        // Timer counts down
+        if ((*lastTime - curTime) < _crc32WdInterval) return;
+        *lastTime = curTime;
+    }
+    ResetWDT();
+}
+
 /*
  * User Facing APIs
  */
@@ -208,23 +268,61 @@ uint32_t crc32(uint32_t crc, const uint8_t *p, uint32_t len) {
         return _crc32_driver(crc, p, len);
 }
 
+// Set the timer used to pace watchdog resets in crc32_wd
+// - The timer must be running in TIMER_MODE_EVENT.
+// - The watchdog is reset once interval ticks of the timer have elapsed.
+// - Passing a null pointer as timer returns to resetting after every chunk.
+HpsErr_t crc32_setTimer(TimerCtx_t* timer, unsigned int interval) {
+    _crc32Timer = NULL;
+    if (!timer) return ERR_SUCCESS;
+    if (!Timer_isInitialised(timer)) return ERR_NOINIT;
+    _crc32WdInterval = interval;
+    _crc32Timer = timer;
+    return ERR_SUCCESS;
+}
+
 // CRC32 calculation for large buffers
 // - Breaks the calculation into chunks interspersed with watchdog resets
+// - The CRC processor is not re-initialised between chunks. If a timer has
+//   been set, chunk_sz is how often the timer is checked, and the watchdog
+//   is only reset once the interval has elapsed.
 uint32_t crc32_wd(uint32_t crc, const uint8_t *buf, uint32_t len, uint32_t chunk_sz) {
+    unsigned int lastTime = 0;
+    if (_crc32Timer) Timer_getTime(_crc32Timer, &lastTime);
     ResetWDT();
+    if (!chunk_sz) chunk_sz = len;
+#ifdef FAILBACK_SOFTWARE_CRC32
+    if (!_crc32Proc) {
+        // Software calculation chains between chunks
+        while (len) {
+            uint32_t chunkLen = (len > chunk_sz) ? chunk_sz : len;
+            crc = _crc32_failback(crc, buf, chunkLen);
+            buf += chunkLen;
+            len -= chunkLen;
+            _crc32_kick(&lastTime);
+        }
+        ResetWDT();
+        return crc;
+    }
+#endif
+    // Stream through the CRC processor, initialising only once
+    CRCStream_t stream;
+    HpsErr_t status = CRC_streamInit(&stream, _crc32Proc, crc ^ ~0U);
     // Loop through the whole length
-    while (len) {
+    while (len && ERR_IS_SUCCESS(status)) {
         // How long is this chunk - the smaller of length and chunk size
         uint32_t chunkLen = len;
         if (chunkLen > chunk_sz) chunkLen = chunk_sz;
         // CRC this chunk
-        crc = crc32(crc, buf, chunkLen);
+        status = CRC_streamUpdate(&stream, buf, chunkLen);
         // Offset the buffer and length by how much we've processed
         buf += chunkLen;
         len -= chunkLen;
-        // And pat the doggy
-        ResetWDT();
+        // And pat the doggy if it's time
+        _crc32_kick(&lastTime);
     }
-    return crc;
+    unsigned int result;
+    if (ERR_IS_SUCCESS(status)) status = CRC_streamFinal(&stream, &result);
+    ResetWDT();
+    return ERR_IS_ERROR(status) ? (uint32_t)-1 : (result ^ ~0U);
 }
-
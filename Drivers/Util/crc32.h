@@ -23,7 +23,15 @@
  * If `FAILBACK_SOFTWARE_CRC32` is defined for this files
  * compilation unit, a software based CRC32 calculation
  * routine is included as a failback when the CRC driver
- * context has not been set.
+ * context has not been set. This processes eight bytes
+ * per iteration (slicing-by-8), with tables generated
+ * in RAM on first use.
+ * 
+ * `crc32_wd()` streams the buffer through the CRC
+ * processor (see `CRC_streamInit()`), so it is only
+ * initialised once. If a timer has been set with
+ * `crc32_setTimer()`, the watchdog is reset once per
+ * interval of that timer rather than after every chunk.
  * 
  * (*) XOR with 0xFFFFFFFF is applied by the crc32 API
  * so should not be performed by the CRC driver.
@@ -35,6 +43,9 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Software failback uses slicing-by-8.
+ *            | crc32_wd streams through the CRC processor, with
+ *            | timer based watchdog resets.
  * 07/07/2024 | Creation of driver.
  */
 
@@ -42,6 +53,7 @@
 #define CRC32_H_
 
 #include "Util/driver_crc.h"
+#include "Util/driver_timer.h"
 
 // Set the CRC processor context used by the CRC32 routines.
 // - If this returns an error code, the CRC32 functions will not work.
@@ -50,8 +62,17 @@ HpsErr_t crc32_setCtx(CRCCtx_t* ctx);
 // CRC32 calculation for small buffers
 uint32_t crc32(uint32_t crc, const uint8_t *p, uint32_t len);
 
+// Set the timer used to pace watchdog resets in crc32_wd
+// - The timer must be running in TIMER_MODE_EVENT.
+// - The watchdog is reset once interval ticks of the timer have elapsed.
+// - Passing a null pointer as timer returns to resetting after every chunk.
+HpsErr_t crc32_setTimer(TimerCtx_t* timer, unsigned int interval);
+
 // CRC32 calculation for large buffers
 // - Breaks the calculation into chunks interspersed with watchdog resets
+// - The CRC processor is not re-initialised between chunks. If a timer has
+//   been set, chunk_sz is how often the timer is checked, and the watchdog
+//   is only reset once the interval has elapsed.
 uint32_t crc32_wd(uint32_t crc, const uint8_t *buf, uint32_t len, uint32_t chunk_sz);
 
 
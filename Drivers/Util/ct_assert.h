@@ -20,6 +20,7 @@
  *
  * Date       | Changes
  * -----------+------------------------------------
+ * 14/10/2026 | Add ct_assert_expr
  * 05/10/2024 | Update comments and guard arguments
  * 28/12/2023 | Add ct_assert_aligned
  * 08/10/2014 | Creation of header
@@ -40,10 +41,12 @@
 //  - ct_assert_define(hashDefine, op)                  #define doesn't pass the operation:     ct_assert_define(MY_MACRO, <=6)       define must be less or equal 6
 //  - ct_assert_define_range(hashDefine, opmin, opmax)  #define doesn't pass two operations:    ct_assert_define(MY_MACRO, >2, <=5)   define must be in range (2 5]
 //  - ct_assert_aligned(name, val, 1<<width, rem)       Value masked to width equals remainder: ct_assert_aligned(NAME, 123, 1<<4, 0) value must be 4-bit aligned
+//  - ct_assert_expr(name, cond)                        Constant expression is false:           ct_assert_expr(NAME, MY_MACRO != 0)   define must be non-zero
 //----------------------------------------------------------------------------- 
 #define ct_assert(a,e) enum { ASSERT_CONCAT(assert_sizeof_, a) = 1/((size_t)!!(sizeof(a) == (e))) }
 #define ct_assert_define(a,op) enum { assert_define_##a = 1/((size_t)!!((a) op)) }
 #define ct_assert_define_range(a,opmin,opmax) enum { assert_define_min_##a = 1/((size_t)!!((a) opmin)), assert_define_max_##a = 1/((size_t)!!((a) opmax))}
 #define ct_assert_aligned(a,v,s,e) enum { ASSERT_CONCAT(assert_sizeof_, a) = 1/((size_t)!!(((v) & ((s)-1)) == (e))) }
+#define ct_assert_expr(a,c) enum { ASSERT_CONCAT(assert_expr_, a) = 1/((size_t)!!(c)) }
 
 #endif /* CT_ASSERT_H_ */
@@ -0,0 +1,304 @@
+/*
+ * Cache-Coherent DMA Buffer Allocator
+ * -----------------------------------
+ *
+ * Provides an allocator for buffers which are to be
+ * accessed by a DMA controller (or any other bus master
+ * such as the FPGA) while the L1/L2 data caches are
+ * enabled (see STARTUP_ENABLE_CACHES in Util/startup_arm.c).
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add range maintenance APIs
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "dma_buffer.h"
+
+#include "Util/bit_helpers.h"
+#include "Util/ct_assert.h"
+#include "Util/hwlib/alt_cache.h"
+
+// Line size must match hwlib
+ct_assert_define(DMA_BUFFER_LINE_SIZE, == ALT_CACHE_LINE_SIZE);
+
+// Cacheable memory windows (flat mapped, see Util/startup_arm.c)
+#define DMA_BUFFER_SDRAM_LIMIT  0xC0000000U
+#if defined(__ARRIA10__)
+#define DMA_BUFFER_OCRAM_BASE   0xFFE00000U
+#define DMA_BUFFER_OCRAM_LIMIT  0xFFE40000U
+#else
+#define DMA_BUFFER_OCRAM_BASE   0xFFFF0000U
+#define DMA_BUFFER_OCRAM_LIMIT  0x00000000U  // Runs to top of address space
+#endif
+
+// Convert between block header and data pointers
+#define DMA_BUFFER_DATA(blk)   ((void*)(((uint8_t*)(blk)) + DMA_BUFFER_LINE_SIZE))
+#define DMA_BUFFER_BLOCK(data) ((DmaBufBlock_t*)(((uint8_t*)(data)) - DMA_BUFFER_LINE_SIZE))
+
+/*
+ * Internal Functions
+ */
+
+// Check if an address range lies within cacheable memory
+static bool _DmaBuffer_isCacheable(uintptr_t start, size_t length) {
+    uintptr_t end = start + length - 1;
+    if (end < start) return false;
+    if (end < DMA_BUFFER_SDRAM_LIMIT) return true;
+    if (start < DMA_BUFFER_OCRAM_BASE) return false;
+    return (DMA_BUFFER_OCRAM_LIMIT == 0) || (end < DMA_BUFFER_OCRAM_LIMIT);
+}
+
+// Clean a range, aligning out to whole cache lines
+static void _DmaBuffer_clean(uintptr_t start, size_t length) {
+    uintptr_t end = (uintptr_t)alignPointer((void*)(start + length), DMA_BUFFER_LINE_SIZE, true);
+    start = (uintptr_t)alignPointer((void*)start, DMA_BUFFER_LINE_SIZE, false);
+    alt_cache_system_clean((void*)start, end - start);
+}
+
+// Purge a range, aligning out to whole cache lines
+static void _DmaBuffer_purge(uintptr_t start, size_t length) {
+    uintptr_t end = (uintptr_t)alignPointer((void*)(start + length), DMA_BUFFER_LINE_SIZE, true);
+    start = (uintptr_t)alignPointer((void*)start, DMA_BUFFER_LINE_SIZE, false);
+    alt_cache_system_purge((void*)start, end - start);
+}
+
+// Invalidate a range.
+//  - Any partial lines at either end are purged instead to preserve
+//    neighbouring data sharing the line.
+static void _DmaBuffer_invalidate(uintptr_t start, size_t length) {
+    uintptr_t end    = start + length;
+    uintptr_t inner0 = (uintptr_t)alignPointer((void*)start, DMA_BUFFER_LINE_SIZE, true );
+    uintptr_t inner1 = (uintptr_t)alignPointer((void*)end,   DMA_BUFFER_LINE_SIZE, false);
+    if (inner1 <= inner0) {
+        // Range is within one or two lines with no whole line. Purge them.
+        _DmaBuffer_purge(start, length);
+        return;
+    }
+    if (start != inner0) _DmaBuffer_purge(start, inner0 - start);
+    alt_cache_system_invalidate((void*)inner0, inner1 - inner0);
+    if (end   != inner1) _DmaBuffer_purge(inner1, end - inner1);
+}
+
+// Validate a transfer and extract the address ranges
+static HpsErr_t _DmaBuffer_checkXfer(DmaChunk_t* xfer) {
+    if (!xfer) return ERR_NULLPTR;
+    if (xfer->readAddr  > UINTPTR_MAX) return ERR_TOOBIG;
+    if (xfer->writeAddr > UINTPTR_MAX) return ERR_TOOBIG;
+    if (xfer->length    > UINT32_MAX ) return ERR_TOOBIG;
+    return ERR_SUCCESS;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise DMA buffer pool
+//  - base is a pointer to the start of the pool memory. Will be aligned up to a cache line.
+//  - size is the size of the pool memory in bytes.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t DmaBuffer_initialise(void* base, size_t size, DmaBufferCtx_t** pCtx) {
+    //Ensure user pointers valid
+    if (!base) return ERR_NULLPTR;
+    //Align the pool to whole cache lines
+    uint8_t* start = alignPointer(base, DMA_BUFFER_LINE_SIZE, true);
+    uint8_t* end   = alignPointer((uint8_t*)base + size, DMA_BUFFER_LINE_SIZE, false);
+    //Must have space for at least one header and one data line
+    if ((end <= start) || ((size_t)(end - start) < 2 * DMA_BUFFER_LINE_SIZE)) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Populate the context
+    DmaBufferCtx_t* ctx = *pCtx;
+    ctx->base = start;
+    ctx->size = end - start;
+    //Whole pool starts as one free block
+    ctx->blocks = (DmaBufBlock_t*)start;
+    ctx->blocks->next  = NULL;
+    ctx->blocks->size  = ctx->size - DMA_BUFFER_LINE_SIZE;
+    ctx->blocks->inUse = false;
+    ctx->freeSpace = ctx->blocks->size;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool DmaBuffer_isInitialised(DmaBufferCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Allocate a DMA buffer
+//  - Length will be rounded up to a multiple of the cache line size
+//  - Returned buffer is cache line aligned
+//  - Returns ERR_NOSPACE if there is no free region large enough
+HpsErr_t DmaBuffer_alloc(DmaBufferCtx_t* ctx, size_t length, void** buf) {
+    if (!buf) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!length) return ERR_TOOSMALL;
+    if (length > ctx->size) return ERR_NOSPACE;
+    //Round up to whole lines
+    length = (size_t)alignPointer((void*)length, DMA_BUFFER_LINE_SIZE, true);
+    //First-fit search
+    for (DmaBufBlock_t* blk = ctx->blocks; blk; blk = blk->next) {
+        if (blk->inUse || (blk->size < length)) continue;
+        //Split if there is room left over for another header and data line
+        if ((blk->size - length) >= 2 * DMA_BUFFER_LINE_SIZE) {
+            DmaBufBlock_t* split = (DmaBufBlock_t*)((uint8_t*)DMA_BUFFER_DATA(blk) + length);
+            split->next  = blk->next;
+            split->size  = blk->size - length - DMA_BUFFER_LINE_SIZE;
+            split->inUse = false;
+            blk->next = split;
+            blk->size = length;
+            ctx->freeSpace -= DMA_BUFFER_LINE_SIZE;
+        }
+        blk->inUse = true;
+        ctx->freeSpace -= blk->size;
+        *buf = DMA_BUFFER_DATA(blk);
+        return ERR_SUCCESS;
+    }
+    return ERR_NOSPACE;
+}
+
+// Free a DMA buffer
+//  - Returns ERR_NOTFOUND if the buffer was not allocated from this pool.
+HpsErr_t DmaBuffer_free(DmaBufferCtx_t* ctx, void* buf) {
+    if (!buf) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Find the block, tracking the previous one for merging
+    DmaBufBlock_t* target = DMA_BUFFER_BLOCK(buf);
+    DmaBufBlock_t* prev = NULL;
+    DmaBufBlock_t* blk = ctx->blocks;
+    while (blk && (blk != target)) {
+        prev = blk;
+        blk = blk->next;
+    }
+    if (!blk || !blk->inUse) return ERR_NOTFOUND;
+    //Release it
+    blk->inUse = false;
+    ctx->freeSpace += blk->size;
+    //Merge with following free block
+    DmaBufBlock_t* next = blk->next;
+    if (next && !next->inUse) {
+        blk->size += next->size + DMA_BUFFER_LINE_SIZE;
+        blk->next  = next->next;
+        ctx->freeSpace += DMA_BUFFER_LINE_SIZE;
+    }
+    //Merge with preceding free block
+    if (prev && !prev->inUse) {
+        prev->size += blk->size + DMA_BUFFER_LINE_SIZE;
+        prev->next  = blk->next;
+        ctx->freeSpace += DMA_BUFFER_LINE_SIZE;
+    }
+    return ERR_SUCCESS;
+}
+
+// Get the amount of free space in the pool
+//  - Returns total free bytes (not necessarily contiguous) in *space
+HpsErr_t DmaBuffer_freeSpace(DmaBufferCtx_t* ctx, size_t* space) {
+    if (!space) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    *space = ctx->freeSpace;
+    return ERR_SUCCESS;
+}
+
+// Prepare for a DMA transfer
+//  - Cleans the source range, and purges the destination range.
+//  - Call before the transfer is started.
+HpsErr_t DmaBuffer_prepare(DmaChunk_t* xfer) {
+    HpsErr_t status = _DmaBuffer_checkXfer(xfer);
+    if (ERR_IS_ERROR(status)) return status;
+    //Nothing to do if caches are off or zero length
+    if (!xfer->length || !alt_cache_l1_data_is_enabled()) return ERR_SUCCESS;
+    uintptr_t src = (uintptr_t)xfer->readAddr;
+    uintptr_t dst = (uintptr_t)xfer->writeAddr;
+    size_t    len = (size_t)xfer->length;
+    if (_DmaBuffer_isCacheable(src, len)) _DmaBuffer_clean(src, len);
+    if (_DmaBuffer_isCacheable(dst, len)) _DmaBuffer_purge(dst, len);
+    return ERR_SUCCESS;
+}
+
+// Complete a DMA transfer
+//  - Invalidates the destination range.
+//  - Call after the transfer completes, before the CPU reads the destination.
+HpsErr_t DmaBuffer_complete(DmaChunk_t* xfer) {
+    HpsErr_t status = _DmaBuffer_checkXfer(xfer);
+    if (ERR_IS_ERROR(status)) return status;
+    //Nothing to do if caches are off or zero length
+    if (!xfer->length || !alt_cache_l1_data_is_enabled()) return ERR_SUCCESS;
+    uintptr_t dst = (uintptr_t)xfer->writeAddr;
+    size_t    len = (size_t)xfer->length;
+    if (_DmaBuffer_isCacheable(dst, len)) _DmaBuffer_invalidate(dst, len);
+    return ERR_SUCCESS;
+}
+
+// Configure a DMA transfer with cache maintenance
+//  - Performs DmaBuffer_prepare() before calling DMA_setupTransfer().
+//  - The xfer structure must remain valid until DmaBuffer_transferDone()
+//    returns success, as it is used for the completion maintenance.
+//  - If DMA_setupTransfer() returns ERR_SKIPPED (completed immediately),
+//    completion maintenance is performed before returning.
+HpsErr_t DmaBuffer_setupTransfer(DmaCtx_t* dma, DmaChunk_t* xfer, bool autoStart) {
+    HpsErr_t status = DmaBuffer_prepare(xfer);
+    if (ERR_IS_ERROR(status)) return status;
+    status = DMA_setupTransfer(dma, xfer, autoStart);
+    if (status == ERR_SKIPPED) DmaBuffer_complete(xfer);
+    return status;
+}
+
+// Check if a DMA transfer is done, with cache maintenance
+//  - Calls DMA_transferDone(). If successful, performs DmaBuffer_complete()
+//    on the transfer before returning.
+HpsErr_t DmaBuffer_transferDone(DmaCtx_t* dma, DmaChunk_t* xfer) {
+    HpsErr_t status = DMA_transferDone(dma);
+    if (ERR_IS_SUCCESS(status)) {
+        HpsErr_t cacheStatus = DmaBuffer_complete(xfer);
+        if (ERR_IS_ERROR(cacheStatus)) return cacheStatus;
+    }
+    return status;
+}
+
+// Clean a range from the caches
+//  - Writes back dirty lines so that a bus master reads current data.
+//  - Does nothing if the caches are off or the range is not cacheable.
+HpsErr_t DmaBuffer_cleanRange(const void* addr, size_t length) {
+    if (!addr) return ERR_NULLPTR;
+    if (!length || !alt_cache_l1_data_is_enabled()) return ERR_SUCCESS;
+    if (_DmaBuffer_isCacheable((uintptr_t)addr, length)) _DmaBuffer_clean((uintptr_t)addr, length);
+    return ERR_SUCCESS;
+}
+
+// Purge (clean and invalidate) a range from the caches
+//  - Call before a bus master writes the range.
+//  - Does nothing if the caches are off or the range is not cacheable.
+HpsErr_t DmaBuffer_purgeRange(void* addr, size_t length) {
+    if (!addr) return ERR_NULLPTR;
+    if (!length || !alt_cache_l1_data_is_enabled()) return ERR_SUCCESS;
+    if (_DmaBuffer_isCacheable((uintptr_t)addr, length)) _DmaBuffer_purge((uintptr_t)addr, length);
+    return ERR_SUCCESS;
+}
+
+// Invalidate a range in the caches
+//  - Call after a bus master has written the range, before the CPU reads it.
+//  - Partial lines at either end are purged instead.
+//  - Does nothing if the caches are off or the range is not cacheable.
+HpsErr_t DmaBuffer_invalidateRange(void* addr, size_t length) {
+    if (!addr) return ERR_NULLPTR;
+    if (!length || !alt_cache_l1_data_is_enabled()) return ERR_SUCCESS;
+    if (_DmaBuffer_isCacheable((uintptr_t)addr, length)) _DmaBuffer_invalidate((uintptr_t)addr, length);
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/*
+ * Cache-Coherent DMA Buffer Allocator
+ * -----------------------------------
+ *
+ * Provides an allocator for buffers which are to be
+ * accessed by a DMA controller (or any other bus master
+ * such as the FPGA) while the L1/L2 data caches are
+ * enabled (see STARTUP_ENABLE_CACHES in Util/startup_arm.c).
+ *
+ * Buffers are handed out from a dedicated memory pool,
+ * and are always aligned to, and a multiple of, the cache
+ * line size. This guarantees that no two buffers (and no
+ * other variables) share a cache line, such that cache
+ * maintenance on one buffer can never corrupt another.
+ *
+ * The pool is typically an EMPTY region in the scatter file,
+ * for example the DMA_BUFFERS region in DDRRam.scat:
+ *
+ *    extern unsigned int SCATTER_REGION_BASE  (DMA_BUFFERS,ZI);
+ *    extern unsigned int SCATTER_REGION_LENGTH(DMA_BUFFERS,ZI);
+ *    DmaBuffer_initialise(&SCATTER_REGION_BASE(DMA_BUFFERS,ZI),
+ *                         (size_t)&SCATTER_REGION_LENGTH(DMA_BUFFERS,ZI),
+ *                         &dmaBufCtx);
+ *
+ * Cache Maintenance
+ * -----------------
+ *
+ * Rather than calling DMA_setupTransfer() and DMA_transferDone()
+ * directly, use DmaBuffer_setupTransfer() and DmaBuffer_transferDone().
+ * These perform the required maintenance automatically:
+ *
+ *  - On submission, the source is cleaned (dirty lines written
+ *    back to memory) and the destination is purged (so that no
+ *    dirty line can later be evicted over the DMA data).
+ *  - On completion, the destination is invalidated to discard
+ *    any lines speculatively fetched during the transfer.
+ *
+ * Maintenance is only performed for addresses in cacheable
+ * memory (HPS SDRAM and on-chip RAM), so transfers to/from
+ * peripheral FIFOs are unaffected. If the caches are disabled
+ * then maintenance is skipped completely.
+ *
+ * Any address range may be used with these APIs, not only
+ * buffers from the pool. However ranges which are not cache
+ * line aligned are purged rather than invalidated at their
+ * edges, so CPU writes to data sharing those lines during a
+ * transfer may overwrite DMA data.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add range maintenance APIs
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef DMA_BUFFER_H_
+#define DMA_BUFFER_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/macros.h"
+#include "Util/driver_ctx.h"
+#include "Util/driver_dma.h"
+#include "Util/error.h"
+
+// Allocation granularity. Matches the L1/L2 cache line size.
+#define DMA_BUFFER_LINE_SIZE 32
+
+// Block header. One per allocation, occupies its own cache line.
+typedef struct DmaBufBlock_t DmaBufBlock_t;
+struct DmaBufBlock_t {
+    DmaBufBlock_t* next;   // Next block in address order
+    size_t         size;   // Size of data area in bytes (multiple of line size)
+    bool           inUse;
+};
+
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    uint8_t*       base;
+    size_t         size;
+    DmaBufBlock_t* blocks;
+    size_t         freeSpace;
+} DmaBufferCtx_t;
+
+// Initialise DMA buffer pool
+//  - base is a pointer to the start of the pool memory. Will be aligned up to a cache line.
+//  - size is the size of the pool memory in bytes.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t DmaBuffer_initialise(void* base, size_t size, DmaBufferCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool DmaBuffer_isInitialised(DmaBufferCtx_t* ctx);
+
+// Allocate a DMA buffer
+//  - Length will be rounded up to a multiple of the cache line size
+//  - Returned buffer is cache line aligned
+//  - Returns ERR_NOSPACE if there is no free region large enough
+HpsErr_t DmaBuffer_alloc(DmaBufferCtx_t* ctx, size_t length, void** buf);
+
+// Free a DMA buffer
+//  - Returns ERR_NOTFOUND if the buffer was not allocated from this pool.
+HpsErr_t DmaBuffer_free(DmaBufferCtx_t* ctx, void* buf);
+
+// Get the amount of free space in the pool
+//  - Returns total free bytes (not necessarily contiguous) in *space
+HpsErr_t DmaBuffer_freeSpace(DmaBufferCtx_t* ctx, size_t* space);
+
+// Prepare for a DMA transfer
+//  - Cleans the source range, and purges the destination range.
+//  - Call before the transfer is started.
+HpsErr_t DmaBuffer_prepare(DmaChunk_t* xfer);
+
+// Complete a DMA transfer
+//  - Invalidates the destination range.
+//  - Call after the transfer completes, before the CPU reads the destination.
+HpsErr_t DmaBuffer_complete(DmaChunk_t* xfer);
+
+// Configure a DMA transfer with cache maintenance
+//  - Performs DmaBuffer_prepare() before calling DMA_setupTransfer().
+//  - The xfer structure must remain valid until DmaBuffer_transferDone()
+//    returns success, as it is used for the completion maintenance.
+//  - If DMA_setupTransfer() returns ERR_SKIPPED (completed immediately),
+//    completion maintenance is performed before returning.
+HpsErr_t DmaBuffer_setupTransfer(DmaCtx_t* dma, DmaChunk_t* xfer, bool autoStart);
+
+// Check if a DMA transfer is done, with cache maintenance
+//  - Calls DMA_transferDone(). If successful, performs DmaBuffer_complete()
+//    on the transfer before returning.
+HpsErr_t DmaBuffer_transferDone(DmaCtx_t* dma, DmaChunk_t* xfer);
+
+// Clean a range from the caches
+//  - Writes back dirty lines so that a bus master reads current data.
+//  - Does nothing if the caches are off or the range is not cacheable.
+HpsErr_t DmaBuffer_cleanRange(const void* addr, size_t length);
+
+// Purge (clean and invalidate) a range from the caches
+//  - Call before a bus master writes the range.
+//  - Does nothing if the caches are off or the range is not cacheable.
+HpsErr_t DmaBuffer_purgeRange(void* addr, size_t length);
+
+// Invalidate a range in the caches
+//  - Call after a bus master has written the range, before the CPU reads it.
+//  - Partial lines at either end are purged instead.
+//  - Does nothing if the caches are off or the range is not cacheable.
+HpsErr_t DmaBuffer_invalidateRange(void* addr, size_t length);
+
+#endif /* DMA_BUFFER_H_ */
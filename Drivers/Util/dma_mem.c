@@ -0,0 +1,230 @@
+/*
+ * DMA Memory Copy/Fill Offload
+ * ----------------------------
+ *
+ * Provides memcpy and memset equivalents which move the data
+ * with a DMA controller rather than the CPU, for bulk moves
+ * such as framebuffer copies, OCRAM backups and asset loads.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "dma_mem.h"
+
+#include <string.h>
+
+#include "Util/macros.h"
+#include "Util/dma_buffer.h"
+
+// Largest single DMA transfer. Longer operations are split into steps
+// so that each transfer program stays a manageable size.
+#define DMA_MEM_MAX_STEP 0x40000
+
+/*
+ * Internal Functions
+ */
+
+// Start the next transfer of the operation
+//  - Returns ERR_BUSY once a transfer is in progress, ERR_SUCCESS if the
+//    operation is complete, or an error code if a transfer failed to start.
+static HpsErr_t _DmaMem_next(DmaMemCtx_t* ctx) {
+    while (ctx->done < ctx->length) {
+        size_t len = min(ctx->length - ctx->done, (size_t)DMA_MEM_MAX_STEP);
+        // A fill copies the part already filled onto the part after it
+        if (ctx->fill) len = min(len, ctx->done);
+        ctx->xfer.readAddr  = ctx->fill ? ctx->src : (ctx->src + ctx->done);
+        ctx->xfer.writeAddr = ctx->dest + ctx->done;
+        ctx->xfer.length    = len;
+        ctx->xfer.isLast    = true;
+        ctx->xfer.index     = 0;
+        ctx->xfer.params    = NULL;
+        HpsErr_t status = DmaBuffer_setupTransfer(ctx->dma, &ctx->xfer, true);
+        if (status != ERR_SKIPPED) {
+            // Either started, or failed to start
+            return ERR_IS_ERROR(status) ? status : ERR_BUSY;
+        }
+        // Completed immediately by the DMA driver. Carry on with the next step.
+        ctx->done += len;
+    }
+    return ERR_SUCCESS;
+}
+
+// End the operation in progress, calling the callback if there is one
+static void _DmaMem_finish(DmaMemCtx_t* ctx, HpsErr_t result) {
+    DmaMemCallback_t cb = ctx->cb;
+    void* param = ctx->param;
+    ctx->result = result;
+    ctx->active = false;
+    // Callback may start another operation
+    if (cb) cb(result, param);
+}
+
+// Start an operation once the context has been populated
+//  - Returns ERR_SKIPPED if it completed before returning.
+static HpsErr_t _DmaMem_start(DmaMemCtx_t* ctx) {
+    ctx->active = true;
+    HpsErr_t status = _DmaMem_next(ctx);
+    if (status == ERR_BUSY) return ERR_SUCCESS;
+    // Completed or failed without waiting, so there is no callback.
+    ctx->result = status;
+    ctx->active = false;
+    return ERR_IS_ERROR(status) ? status : ERR_SKIPPED;
+}
+
+// Check whether a new operation can be started
+static HpsErr_t _DmaMem_checkStart(DmaMemCtx_t* ctx, void* dest) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!dest) return ERR_NULLPTR;
+    if (ctx->active) return ERR_BUSY;
+    return ERR_SUCCESS;
+}
+
+// Cleanup function called when driver destroyed.
+//  - Stops any operation in progress.
+static void _DmaMem_cleanup(DmaMemCtx_t* ctx) {
+    if (ctx->active) {
+        DMA_abortTransfer(ctx->dma, DMA_ABORT_SAFE);
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise DMA memory offload
+//  - dma is the DMA interface to perform transfers with. This should be
+//    reserved for the offload (e.g. a channel from HPS_DMA_allocateChannel()),
+//    and must not have completion callbacks set as completion is polled.
+//  - threshold is the length in bytes below which copies are performed by the
+//    CPU. 0 selects DMA_MEM_DEFAULT_THRESHOLD.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t DmaMem_initialise(DmaCtx_t* dma, size_t threshold, DmaMemCtx_t** pCtx) {
+    //Ensure user pointers valid
+    if (!dma) return ERR_NULLPTR;
+    if (!DMA_isInitialised(dma)) return ERR_BADDEVICE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_DmaMem_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Populate the context
+    DmaMemCtx_t* ctx = *pCtx;
+    ctx->dma = dma;
+    ctx->threshold = threshold ? threshold : DMA_MEM_DEFAULT_THRESHOLD;
+    ctx->active = false;
+    ctx->result = ERR_SUCCESS;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool DmaMem_isInitialised(DmaMemCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Start a memory copy
+//  - Copies n bytes from src to dest, which must not overlap. cb may be NULL.
+//  - Returns ERR_SKIPPED if performed immediately by the CPU (n below the
+//    threshold), in which case cb is not called.
+//  - Returns ERR_BUSY if an operation is already in progress.
+HpsErr_t DmaMem_memcpy(DmaMemCtx_t* ctx, void* dest, const void* src, size_t n, DmaMemCallback_t cb, void* param) {
+    HpsErr_t status = _DmaMem_checkStart(ctx, dest);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!src) return ERR_NULLPTR;
+    //Short copies are quicker on the CPU
+    if (n < ctx->threshold) {
+        memcpy(dest, src, n);
+        ctx->result = ERR_SUCCESS;
+        return ERR_SKIPPED;
+    }
+    ctx->src = (uintptr_t)src;
+    ctx->dest = (uintptr_t)dest;
+    ctx->length = n;
+    ctx->done = 0;
+    ctx->fill = false;
+    ctx->cb = cb;
+    ctx->param = param;
+    return _DmaMem_start(ctx);
+}
+
+// Start a memory fill
+//  - Sets n bytes at dest to the value c. cb may be NULL.
+//  - Returns ERR_SKIPPED if performed immediately by the CPU (n below the
+//    threshold), in which case cb is not called.
+//  - Returns ERR_BUSY if an operation is already in progress.
+HpsErr_t DmaMem_memset(DmaMemCtx_t* ctx, void* dest, int c, size_t n, DmaMemCallback_t cb, void* param) {
+    HpsErr_t status = _DmaMem_checkStart(ctx, dest);
+    if (ERR_IS_ERROR(status)) return status;
+    //Short fills are quicker on the CPU
+    if (n < ctx->threshold) {
+        memset(dest, c, n);
+        ctx->result = ERR_SUCCESS;
+        return ERR_SKIPPED;
+    }
+    //Seed the start of the buffer. The DMA doubles it from there.
+    size_t seed = min(n, (size_t)DMA_MEM_FILL_SEED);
+    memset(dest, c, seed);
+    ctx->src = (uintptr_t)dest;
+    ctx->dest = (uintptr_t)dest;
+    ctx->length = n;
+    ctx->done = seed;
+    ctx->fill = true;
+    ctx->cb = cb;
+    ctx->param = param;
+    return _DmaMem_start(ctx);
+}
+
+// Check for completion of the operation in progress
+//  - Starts the next step of the operation if needed, and calls the callback once complete.
+//  - Returns ERR_BUSY while in progress.
+//  - Returns the result of the last operation once complete, or ERR_SUCCESS if none.
+HpsErr_t DmaMem_poll(DmaMemCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->active) return ctx->result;
+    //Check the transfer in progress
+    status = DmaBuffer_transferDone(ctx->dma, &ctx->xfer);
+    if (ERR_IS_SUCCESS(status)) {
+        //Step done. Start the next one if there is more to do.
+        ctx->done += ctx->xfer.length;
+        status = _DmaMem_next(ctx);
+    } else if ((status == ERR_BUSY) && ERR_IS_ERROR(DMA_transferError(ctx->dma, NULL))) {
+        //Will never complete
+        status = ERR_IOFAIL;
+    }
+    if (status == ERR_BUSY) return ERR_BUSY;
+    //Operation complete
+    _DmaMem_finish(ctx, status);
+    return status;
+}
+
+// Wait for completion of the operation in progress
+//  - Blocks, polling until complete.
+//  - Returns the result of the operation.
+HpsErr_t DmaMem_wait(DmaMemCtx_t* ctx) {
+    HpsErr_t status;
+    do {
+        status = DmaMem_poll(ctx);
+    } while (status == ERR_BUSY);
+    return status;
+}
+
+// Task wait helper
+//  - Polls the operation. For use with Task_waitUntil (Util/task.h), passing
+//    the context as param.
+//  - Returns ERR_BUSY while in progress, or the result once complete.
+HpsErr_t DmaMem_done(void* param) {
+    return DmaMem_poll((DmaMemCtx_t*)param);
+}
@@ -0,0 +1,148 @@
+/*
+ * DMA Memory Copy/Fill Offload
+ * ----------------------------
+ *
+ * Provides memcpy and memset equivalents which move the data
+ * with a DMA controller rather than the CPU, for bulk moves
+ * such as framebuffer copies, OCRAM backups and asset loads.
+ *
+ * The offload is given a DMA interface to use, normally a
+ * channel reserved for it so that it does not interfere with
+ * other users of the controller:
+ *
+ *    HPS_DMA_allocateChannel(dmaCtx, &memChCtx);
+ *    DmaMem_initialise(&memChCtx->dma, 0, &dmaMemCtx);
+ *
+ * Copies shorter than the size threshold are not worth the
+ * DMA setup overhead, so are performed by the CPU instead,
+ * returning ERR_SKIPPED as they are already complete.
+ *
+ * Asynchronous Completion
+ * -----------------------
+ *
+ * DmaMem_memcpy() and DmaMem_memset() start the operation and
+ * return straight away. Completion can be checked by:
+ *
+ *   - Calling DmaMem_poll() from the main loop, which calls the
+ *     optional callback once complete.
+ *   - Waiting in a task with Task_waitUntil(mgr, &DmaMem_done, ctx).
+ *   - Blocking with DmaMem_wait().
+ *
+ * Only one operation may be in progress at a time for each
+ * context, others return ERR_BUSY until it completes.
+ *
+ * A fill is performed by setting the first DMA_MEM_FILL_SEED
+ * bytes with the CPU, then repeatedly copying the filled part
+ * of the buffer onto the part after it, doubling each time. The
+ * poll function starts each step once the previous is complete.
+ *
+ * Cache maintenance is performed on the source and destination
+ * with DmaBuffer_prepare()/DmaBuffer_complete(), so buffers do
+ * not need to come from a DMA buffer pool. The destination must
+ * not be accessed by the CPU while the operation is in progress.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef DMA_MEM_H_
+#define DMA_MEM_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_dma.h"
+#include "Util/error.h"
+
+// Default size threshold in bytes, below which the CPU is used.
+// Globally define to override.
+#ifndef DMA_MEM_DEFAULT_THRESHOLD
+#define DMA_MEM_DEFAULT_THRESHOLD 1024
+#endif
+
+// Number of bytes of a fill set by the CPU before doubling with the DMA.
+#ifndef DMA_MEM_FILL_SEED
+#define DMA_MEM_FILL_SEED 256
+#endif
+
+// Completion callback
+//  - result is ERR_SUCCESS if the operation completed, or an error code if
+//    the DMA transfer failed. param is the value given when it was started.
+//  - Called from DmaMem_poll(). A new operation may be started from the callback.
+typedef void (*DmaMemCallback_t)(HpsErr_t result, void* param);
+
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    DmaCtx_t*        dma;
+    size_t           threshold;
+    //Operation in progress
+    volatile bool    active;
+    DmaChunk_t       xfer;     // Transfer in progress, kept for cache maintenance
+    uintptr_t        src;      // Start of the source (the destination for fills)
+    uintptr_t        dest;     // Start of the destination
+    size_t           length;   // Total length of the operation
+    size_t           done;     // Bytes of the destination completed so far
+    bool             fill;     // Fill (true) or copy (false)
+    DmaMemCallback_t cb;
+    void*            param;
+    HpsErr_t         result;   // Result of the last completed operation
+} DmaMemCtx_t;
+
+// Initialise DMA memory offload
+//  - dma is the DMA interface to perform transfers with. This should be
+//    reserved for the offload (e.g. a channel from HPS_DMA_allocateChannel()),
+//    and must not have completion callbacks set as completion is polled.
+//  - threshold is the length in bytes below which copies are performed by the
+//    CPU. 0 selects DMA_MEM_DEFAULT_THRESHOLD.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t DmaMem_initialise(DmaCtx_t* dma, size_t threshold, DmaMemCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool DmaMem_isInitialised(DmaMemCtx_t* ctx);
+
+// Start a memory copy
+//  - Copies n bytes from src to dest, which must not overlap. cb may be NULL.
+//  - Returns ERR_SKIPPED if performed immediately by the CPU (n below the
+//    threshold), in which case cb is not called.
+//  - Returns ERR_BUSY if an operation is already in progress.
+HpsErr_t DmaMem_memcpy(DmaMemCtx_t* ctx, void* dest, const void* src, size_t n, DmaMemCallback_t cb, void* param);
+
+// Start a memory fill
+//  - Sets n bytes at dest to the value c. cb may be NULL.
+//  - Returns ERR_SKIPPED if performed immediately by the CPU (n below the
+//    threshold), in which case cb is not called.
+//  - Returns ERR_BUSY if an operation is already in progress.
+HpsErr_t DmaMem_memset(DmaMemCtx_t* ctx, void* dest, int c, size_t n, DmaMemCallback_t cb, void* param);
+
+// Check for completion of the operation in progress
+//  - Starts the next step of the operation if needed, and calls the callback once complete.
+//  - Returns ERR_BUSY while in progress.
+//  - Returns the result of the last operation once complete, or ERR_SUCCESS if none.
+HpsErr_t DmaMem_poll(DmaMemCtx_t* ctx);
+
+// Wait for completion of the operation in progress
+//  - Blocks, polling until complete.
+//  - Returns the result of the operation.
+HpsErr_t DmaMem_wait(DmaMemCtx_t* ctx);
+
+// Task wait helper
+//  - Polls the operation. For use with Task_waitUntil (Util/task.h), passing
+//    the context as param.
+//  - Returns ERR_BUSY while in progress, or the result once complete.
+HpsErr_t DmaMem_done(void* param);
+
+#endif /* DMA_MEM_H_ */
@@ -12,6 +12,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add streaming CRC calculation.
  * 03/01/2024 | Creation of driver.
  */
 
@@ -62,4 +63,57 @@ HpsErr_t CRC_getWidth(CRCCtx_t* crcCtx) {
     return crcCtx->getWidth(crcCtx->ctx);
 }
 
+// Start a streaming CRC calculation
+//  - initVal is the initial CRC value.
+HpsErr_t CRC_streamInit(CRCStream_t* stream, CRCCtx_t* crcCtx, unsigned int initVal) {
+    if (!stream || !crcCtx) return ERR_NULLPTR;
+    // Ensure we have required function handles for calculation
+    if (crcCtx->mode == CRC_FUNC_COMBINED) {
+        if (!crcCtx->combined.calculate) return ERR_NOSUPPORT;
+    } else {
+        if (!crcCtx->split.calculate) return ERR_NOSUPPORT;
+        if (!crcCtx->split.getResult) return ERR_NOSUPPORT;
+    }
+    stream->crcCtx = crcCtx;
+    stream->value = initVal;
+    stream->started = false;
+    return ERR_SUCCESS;
+}
+
+// Add length bytes from *data to a streaming CRC calculation
+HpsErr_t CRC_streamUpdate(CRCStream_t* stream, const uint8_t * data, unsigned int length) {
+    if (!stream || !stream->crcCtx) return ERR_NULLPTR;
+    if (!length) return ERR_SUCCESS;
+    CRCCtx_t* crcCtx = stream->crcCtx;
+    HpsErr_t status;
+    if (crcCtx->mode == CRC_FUNC_COMBINED) {
+        // Chain from the previous result
+        status = crcCtx->combined.calculate(crcCtx->ctx, data, length, &stream->value);
+    } else {
+        bool reset = !stream->started;
+        if (reset && crcCtx->split.initialise) {
+            //ERR_NOSUPPORT from init is acceptable, it just means that the init value is fixed.
+            status = crcCtx->split.initialise(crcCtx->ctx, stream->value);
+            if ((status != ERR_NOSUPPORT) && ERR_IS_ERROR(status)) return status;
+        }
+        // Only the first update resets the processor, later ones carry on from its state
+        status = crcCtx->split.calculate(crcCtx->ctx, data, length, reset);
+    }
+    if (ERR_IS_ERROR(status)) return status;
+    stream->started = true;
+    return ERR_SUCCESS;
+}
+
+// Finish a streaming CRC calculation
+//  - Result is returned to (*crc). If no data was processed, this is the
+//    initial value.
+HpsErr_t CRC_streamFinal(CRCStream_t* stream, unsigned int* crc) {
+    if (!stream || !stream->crcCtx || !crc) return ERR_NULLPTR;
+    CRCCtx_t* crcCtx = stream->crcCtx;
+    if (!stream->started || (crcCtx->mode == CRC_FUNC_COMBINED)) {
+        *crc = stream->value;
+        return ERR_SUCCESS;
+    }
+    return crcCtx->split.getResult(crcCtx->ctx, crc);
+}
 
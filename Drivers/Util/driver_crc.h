@@ -12,6 +12,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add streaming CRC calculation.
  * 03/01/2024 | Creation of driver.
  */
 
@@ -83,5 +84,30 @@ HpsErr_t CRC_calculate(CRCCtx_t* crcCtx, bool init, const uint8_t * data, unsign
 //  - Maximum width is 32 for the generic CRC driver.
 HpsErr_t CRC_getWidth(CRCCtx_t* crcCtx);
 
+// Streaming CRC calculation
+//  - Calculates a CRC across several buffers without re-initialising the
+//    CRC processor between them, e.g. to interleave watchdog resets.
+//  - In split mode, the processor state is kept between updates, so it must
+//    not be used for anything else until CRC_streamFinal is called.
+//  - In combined mode, each update is chained from the previous result.
+//    This requires a CRC with no output XOR.
+typedef struct {
+    CRCCtx_t* crcCtx;
+    unsigned int value;     // Initial value, or running result in combined mode
+    bool started;           // Whether any data has been processed
+} CRCStream_t;
+
+// Start a streaming CRC calculation
+//  - initVal is the initial CRC value.
+HpsErr_t CRC_streamInit(CRCStream_t* stream, CRCCtx_t* crcCtx, unsigned int initVal);
+
+// Add length bytes from *data to a streaming CRC calculation
+HpsErr_t CRC_streamUpdate(CRCStream_t* stream, const uint8_t * data, unsigned int length);
+
+// Finish a streaming CRC calculation
+//  - Result is returned to (*crc). If no data was processed, this is the
+//    initial value.
+HpsErr_t CRC_streamFinal(CRCStream_t* stream, unsigned int* crc);
+
 
 #endif /* DRIVER_CRC_H_ */
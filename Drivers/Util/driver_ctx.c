@@ -11,14 +11,163 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add instrumented builds with per context call and cycle counts
+ * 14/10/2026 | Add static driver contexts
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Inline context checks and add unchecked build option
  * 29/12/2023 | Creation of driver.
  */
 
 #include "driver_ctx.h"
+#include "Util/mem_pool.h"
 
-#define DRV_MAGIC_HEADER_WORD  0xF00DCAFE
+#include <string.h>
 
-#define DRV_ValidHeader(ctx) ((ctx)->__magic == DRV_MAGIC_HEADER_WORD)
+#ifdef DRIVER_CTX_INSTRUMENT
+
+#include <stdio.h>
+#include "Util/irq.h"
+#include "Util/bit_helpers.h"
+
+// Number of cores tracked
+#define DRV_INSTRUMENT_CORES 2
+
+// Last context validated on each core, and when
+typedef struct {
+    DrvCtx_t* ctx;      // NULL if outside of drivers
+    uint32_t  stamp;
+} DrvInstrumentCore_t;
+
+static DrvCtx_t* _DRV_contexts = NULL;
+static IrqSpinlock_t _DRV_contextsLock = IRQ_SPINLOCK_INIT;
+static DrvInstrumentCore_t _DRV_core[DRV_INSTRUMENT_CORES];
+static uint64_t _DRV_outsideCycles = 0;
+
+// Read the cycle counter of this core
+static inline uint32_t _DRV_cycles(void) {
+#if defined(__arm__)
+    return __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+#else
+    return 0;
+#endif
+}
+
+// Get the tracking of this core
+static inline DrvInstrumentCore_t* _DRV_thisCore(void) {
+#if defined(__arm__)
+    return &_DRV_core[__GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID & (DRV_INSTRUMENT_CORES - 1)];
+#else
+    return &_DRV_core[0];
+#endif
+}
+
+// Charge the cycles since the last validation on this core, then move the charge to ctx
+// - Must be called with interrupts masked.
+static void _DRV_charge(DrvCtx_t* ctx) {
+    DrvInstrumentCore_t* core = _DRV_thisCore();
+    uint32_t now = _DRV_cycles();
+    uint32_t elapsed = now - core->stamp;
+    if (core->ctx) {
+        core->ctx->cycles += elapsed;
+    } else {
+        _DRV_outsideCycles += elapsed;
+    }
+    core->ctx = ctx;
+    core->stamp = now;
+}
+
+// Add a context to the list of all contexts
+static void _DRV_listAdd(DrvCtx_t* ctx) {
+    HpsErr_t irqState = IRQ_spinLock(&_DRV_contextsLock);
+    DrvCtx_t* entry = _DRV_contexts;
+    while (entry && (entry != ctx)) entry = entry->__next;
+    //Static storage may be claimed again without having been freed
+    if (!entry) {
+        ctx->__next = _DRV_contexts;
+        _DRV_contexts = ctx;
+    }
+    IRQ_spinUnlock(&_DRV_contextsLock, irqState);
+}
+
+// Remove a context from the list, and stop charging it
+static void _DRV_listRemove(DrvCtx_t* ctx) {
+    HpsErr_t irqState = IRQ_spinLock(&_DRV_contextsLock);
+    for (DrvCtx_t** link = &_DRV_contexts; *link; link = &(*link)->__next) {
+        if (*link == ctx) {
+            *link = ctx->__next;
+            break;
+        }
+    }
+    for (unsigned int idx = 0; idx < DRV_INSTRUMENT_CORES; idx++) {
+        if (_DRV_core[idx].ctx == ctx) _DRV_core[idx].ctx = NULL;
+    }
+    IRQ_spinUnlock(&_DRV_contextsLock, irqState);
+}
+
+// Check a driver context, counting the call
+HpsErr_t DRV_instrumentContext(DrvCtx_t* ctx) {
+    HpsErr_t status = DRV_checkContext(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqState = IRQ_globalEnable(false);
+    ctx->calls++;
+    _DRV_charge(ctx);
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+    return ERR_SUCCESS;
+}
+
+// Charge the cycles since the last validation on this core
+void DRV_instrumentMark(void) {
+    HpsErr_t irqState = IRQ_globalEnable(false);
+    _DRV_charge(NULL);
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+}
+
+// Clear all counts and enable the cycle counter on this core
+void DRV_instrumentReset(void) {
+#if defined(__arm__)
+    //Leave the counter running if Util/profile already started it
+    __SET_SYSREG(SYSREG_COPROC, PMCR, __GET_SYSREG(SYSREG_COPROC, PMCR) | _BV(SYSREG_PMCR_BIT_E));
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENSET, _BV(SYSREG_PMCNTEN_BIT_C));
+#endif
+    HpsErr_t irqState = IRQ_spinLock(&_DRV_contextsLock);
+    for (DrvCtx_t* ctx = _DRV_contexts; ctx; ctx = ctx->__next) {
+        ctx->calls = 0;
+        ctx->cycles = 0;
+    }
+    _DRV_outsideCycles = 0;
+    uint32_t now = _DRV_cycles();
+    for (unsigned int idx = 0; idx < DRV_INSTRUMENT_CORES; idx++) {
+        _DRV_core[idx].ctx = NULL;
+        _DRV_core[idx].stamp = now;
+    }
+    IRQ_spinUnlock(&_DRV_contextsLock, irqState);
+}
+
+// Print the calls and cycles of every context
+HpsErr_t DRV_instrumentReport(void) {
+    //Bring this core's charge up to date
+    DRV_instrumentMark();
+    HpsErr_t irqState = IRQ_spinLock(&_DRV_contextsLock);
+    uint64_t total = _DRV_outsideCycles;
+    for (DrvCtx_t* ctx = _DRV_contexts; ctx; ctx = ctx->__next) {
+        total += ctx->cycles;
+    }
+    if (!total) total = 1;
+    unsigned int count = 0;
+    printf("%-16s %-10s %-10s %10s %16s %6s\n", "Driver", "Context", "Type", "Calls", "Cycles", "%");
+    for (DrvCtx_t* ctx = _DRV_contexts; ctx; ctx = ctx->__next) {
+        //Unnamed contexts are identified by their cleanup function
+        printf("%-16s %-10p %-10p %10lu %16llu %6.2f\n", ctx->__name ? ctx->__name : "-", (void*)ctx, (void*)ctx->__destroy,
+               (unsigned long)ctx->calls, (unsigned long long)ctx->cycles, 100.0 * (double)ctx->cycles / (double)total);
+        count++;
+    }
+    printf("%-16s %-10s %-10s %10s %16llu %6.2f\n", "(outside)", "-", "-", "-",
+           (unsigned long long)_DRV_outsideCycles, 100.0 * (double)_DRV_outsideCycles / (double)total);
+    IRQ_spinUnlock(&_DRV_contextsLock, irqState);
+    return (HpsErr_t)count;
+}
+
+#endif
 
 // Allocate context
 HpsErr_t DRV_allocateContext(unsigned int drvSize, DrvCtx_t** pCtx, ContextCleanupFunc_t destroy) {
@@ -26,16 +175,40 @@ HpsErr_t DRV_allocateContext(unsigned int drvSize, DrvCtx_t** pCtx, ContextClean
     if (!pCtx) return ERR_NULLPTR;
     *pCtx = NULL;
     // Allocate the main context
-    DrvCtx_t* ctx = calloc(1, drvSize);
+    DrvCtx_t* ctx = MemPool_calloc(1, drvSize);
     if (!ctx) return ERR_ALLOCFAIL;
     // Allocated
     ctx->__magic = DRV_MAGIC_HEADER_WORD;
     ctx->__size = drvSize;
     ctx->__destroy = destroy;
+#ifdef DRIVER_CTX_INSTRUMENT
+    _DRV_listAdd(ctx);
+#endif
     *pCtx = ctx;
     return ERR_SUCCESS;
 }
 
+// Claim static context storage
+HpsErr_t DRV_claimStaticContext(DrvCtx_t* store, unsigned int drvSize, DrvCtx_t** pCtx, ContextCleanupFunc_t destroy) {
+    // Must have a return pointer
+    if (!pCtx) return ERR_NULLPTR;
+    *pCtx = NULL;
+    if (!store) return ERR_NULLPTR;
+    // Storage must not already be in use
+    if (DRV_isInitialised(store)) return ERR_INUSE;
+    // Start from a clean context, as for an allocated one
+    memset(store, 0, drvSize);
+    store->__magic = DRV_MAGIC_HEADER_WORD;
+    store->__size = drvSize;
+    store->__destroy = destroy;
+    store->isStatic = true;
+#ifdef DRIVER_CTX_INSTRUMENT
+    _DRV_listAdd(store);
+#endif
+    *pCtx = store;
+    return ERR_SUCCESS;
+}
+
 // Cleanup a context
 HpsErr_t DRV_freeContext(DrvCtx_t** pCtx) {
     // Must have a return pointer
@@ -48,23 +221,13 @@ HpsErr_t DRV_freeContext(DrvCtx_t** pCtx) {
     // Call user cleanup if we have one
     if (ctx->__destroy) ctx->__destroy(ctx);
     // Be free driver context
+#ifdef DRIVER_CTX_INSTRUMENT
+    _DRV_listRemove(ctx);
+#endif
     ctx->initialised = false;
     ctx->__magic = 0x0;
-    free(ctx);
+    if (!ctx->isStatic) MemPool_free(ctx);
     *pCtx = NULL;
     return ERR_SUCCESS;
 }
 
-// Check if the driver context is initialised
-bool DRV_isInitialised(DrvCtx_t* ctx) {
-    return (ctx && DRV_ValidHeader(ctx) && ctx->initialised);
-}
-
-// Get the driver context, validating that it is initialised
-HpsErr_t DRV_checkContext(DrvCtx_t* ctx) {
-    if (!ctx) return ERR_NULLPTR;
-    if (!DRV_ValidHeader(ctx)) return ERR_BADDEVICE;
-    if (!ctx->initialised) return ERR_NOINIT;
-    return ERR_SUCCESS;
-}
-
@@ -4,6 +4,81 @@
  * Provides common driver context logic for drivers using
  * context pointers and functions returning Util/error Code.
  *
+ * Contexts are allocated with Util/mem_pool.h, so come from a
+ * static pool rather than the heap if MEM_POOL_SIZE is defined.
+ *
+ * Unchecked Builds
+ * ----------------
+ *
+ * Each public driver API validates its context before use. The
+ * check is inlined, but once an application has checked that its
+ * drivers initialised, it can be removed entirely by globally
+ * defining:
+ *
+ *     -D DRIVER_CTX_UNCHECKED
+ *
+ * DriverContextValidate() then always succeeds, so passing a NULL,
+ * freed or uninitialised context to a driver API is undefined. The
+ * initialisation and DriverContextCheckInit() checks are kept.
+ *
+ * Static Contexts
+ * ---------------
+ *
+ * Drivers which support it can instead be given statically
+ * allocated storage for their context, so that bring-up does not
+ * allocate. The driver's initialise function claims the storage
+ * with DriverContextAllocateStatic() in place of the allocation:
+ *
+ *     status = store ? DriverContextAllocateStatic(store, pCtx, &_MY_cleanup)
+ *                    : DriverContextAllocateWithCleanup(pCtx, &_MY_cleanup);
+ *
+ * The storage must be zero-initialised or previously freed, and
+ * is returned as *pCtx. Freeing a static context runs its cleanup
+ * but does not release the storage, which can be claimed again.
+ *
+ * Such drivers provide a *_STATIC() declaration macro which places
+ * the instance's base address and configuration in a const
+ * descriptor, with the storage, checking constant arguments with
+ * Util/ct_assert.h. Hot path helpers given the descriptor can then
+ * have the base address folded in by the compiler.
+ *
+ * Instrumented Builds
+ * -------------------
+ *
+ * To find which drivers use the most CPU time, globally define:
+ *
+ *     -D DRIVER_CTX_INSTRUMENT
+ *
+ * Every context then counts the calls made to its APIs, as each
+ * passes through DriverContextValidate(), and accumulates cycles
+ * from the PMU cycle counter. Contexts are also kept in a list,
+ * so that a single call prints a table of every instance:
+ *
+ *     DriverContextInstrumentReset();  // Enables the cycle counter
+ *     DriverContextSetName(lt24, "lt24");
+ *     while (1) {
+ *         DriverContextInstrumentMark();  // Back in application code
+ *         ...
+ *         if (done) DriverContextInstrumentReport();
+ *     }
+ *
+ * Only the entry to a driver API is seen, so the cycles from one
+ * validation to the next on the same core are charged to the
+ * instance validated first. DriverContextInstrumentMark() ends the
+ * charge, with the time until the next validation counted as
+ * outside of drivers, so it should be called wherever the
+ * application regains control (e.g. the top of the main loop and
+ * in Util/idle). Calls made by a driver into another driver are
+ * charged to the inner one from that point. The figures are for
+ * finding hot spots, not exact timings; Util/profile.h gives exact
+ * times of marked sections.
+ *
+ * The cycle counter is per core, and shared with Util/profile.h,
+ * which must not reset it while instrumenting. Cycles are only
+ * counted on ARM targets. Validation in instrumented builds is
+ * always checked, even if DRIVER_CTX_UNCHECKED is also defined.
+ * Without DRIVER_CTX_INSTRUMENT the macros compile to nothing.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -11,6 +86,10 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add instrumented builds with per context call and cycle counts
+ * 14/10/2026 | Add static driver contexts
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Inline context checks and add unchecked build option
  * 29/12/2023 | Creation of driver.
  */
 
@@ -114,7 +193,7 @@
 typedef void (*ContextCleanupFunc_t)(void* ctx);
 
 // This must be the first field in any driver context structure
-typedef struct {
+typedef struct DrvCtx_s {
     // Magic word
     unsigned int __magic;
     // Size of the context
@@ -123,6 +202,17 @@ typedef struct {
     ContextCleanupFunc_t __destroy;
     // Whether initialised
     bool initialised;
+    // Whether the context storage is static rather than allocated
+    bool isStatic;
+#ifdef DRIVER_CTX_INSTRUMENT
+    // Next context in the list of all contexts
+    struct DrvCtx_s* __next;
+    // Name given by DriverContextSetName(), or NULL
+    const char* __name;
+    // Number of validated calls, and cycles charged to them
+    uint32_t calls;
+    uint64_t cycles;
+#endif
 } DrvCtx_t;
 
 
@@ -134,8 +224,15 @@ typedef struct {
 // - Returns success or error code
 HpsErr_t DRV_allocateContext(unsigned int drvSize, DrvCtx_t** pCtx, ContextCleanupFunc_t destroy);
 
+// Claim static context storage
+// - Prepares store (of drvSize bytes) as a context, and returns it to *pCtx.
+// - Returns ERR_INUSE if store is already an initialised context.
+// - Returns success or error code
+HpsErr_t DRV_claimStaticContext(DrvCtx_t* store, unsigned int drvSize, DrvCtx_t** pCtx, ContextCleanupFunc_t destroy);
+
 // Cleanup a context
 // - Will set *pCtx to null once freed.
+// - Static contexts are cleaned up but not freed.
 // - Returns success or error code
 HpsErr_t DRV_freeContext(DrvCtx_t** pCtx);
 
@@ -147,12 +244,41 @@ static inline HpsErr_t DRV_freeContextWithStatus(DrvCtx_t** pCtx, HpsErr_t retVa
     return retVal;
 }
 
+#ifdef DRIVER_CTX_INSTRUMENT
+// Check a driver context, counting the call
+// - Returns success or error code
+HpsErr_t DRV_instrumentContext(DrvCtx_t* ctx);
+
+// Charge the cycles since the last validation on this core, then
+// count the time until the next one as outside of drivers
+void DRV_instrumentMark(void);
+
+// Clear all counts and enable the cycle counter on this core
+void DRV_instrumentReset(void);
+
+// Print the calls and cycles of every context
+// - Returns the number of contexts listed.
+HpsErr_t DRV_instrumentReport(void);
+#endif
+
+// Magic word of an allocated context
+#define DRV_MAGIC_HEADER_WORD  0xF00DCAFE
+
+#define DRV_ValidHeader(ctx) ((ctx)->__magic == DRV_MAGIC_HEADER_WORD)
+
 // Check if the driver context is initialised
-bool DRV_isInitialised(DrvCtx_t* ctx);
+static inline bool DRV_isInitialised(DrvCtx_t* ctx) {
+    return (ctx && DRV_ValidHeader(ctx) && ctx->initialised);
+}
 
 // Checks that a driver context is valid
 // - Returns success or error code
-HpsErr_t DRV_checkContext(DrvCtx_t* ctx);
+static inline HpsErr_t DRV_checkContext(DrvCtx_t* ctx) {
+    if (!ctx) return ERR_NULLPTR;
+    if (!DRV_ValidHeader(ctx)) return ERR_BADDEVICE;
+    if (!ctx->initialised) return ERR_NOINIT;
+    return ERR_SUCCESS;
+}
 
 
 /*
@@ -169,6 +295,13 @@ HpsErr_t DRV_checkContext(DrvCtx_t* ctx);
 #define DriverContextAllocateWithCleanup(pCtx, cleanupFunc) \
     DRV_allocateContext(sizeof(**(pCtx)),(DrvCtx_t**)(pCtx),(ContextCleanupFunc_t)(cleanupFunc))
 
+// Claim static storage for a context pointer with cleanup function
+// - store must point to storage of the same type as *pCtx.
+// - Returns HpsErr_t
+#define DriverContextAllocateStatic(store, pCtx, cleanupFunc) \
+    ((void)sizeof((store) == *(pCtx)), \
+     DRV_claimStaticContext((DrvCtx_t*)(store),sizeof(**(pCtx)),(DrvCtx_t**)(pCtx),(ContextCleanupFunc_t)(cleanupFunc)))
+
 // Free a context pointer
 // - Call during initialisation function if there is an
 //   error after the context has been allocated.
@@ -197,8 +330,43 @@ HpsErr_t DRV_checkContext(DrvCtx_t* ctx);
 
 // Ensure driver context is valid
 // - Returns HpsErr_t
+// - Always succeeds if DRIVER_CTX_UNCHECKED is defined.
+// - Also counts the call if DRIVER_CTX_INSTRUMENT is defined.
+#if defined(DRIVER_CTX_INSTRUMENT)
+#define DriverContextValidate(ctx) \
+    DRV_instrumentContext((DrvCtx_t*)(ctx))
+#elif defined(DRIVER_CTX_UNCHECKED)
+#define DriverContextValidate(ctx) \
+    ((void)(ctx), ERR_SUCCESS)
+#else
 #define DriverContextValidate(ctx) \
     DRV_checkContext((DrvCtx_t*)(ctx))
+#endif
+
+// Instrumentation (see Instrumented Builds)
+// - SetName gives a context a name for the report. The string is not copied.
+// - Mark ends the charge to the last validated context on this core.
+// - Reset clears all counts and enables the cycle counter on this core.
+// - Report prints the table, returning HpsErr_t (ERR_NOSUPPORT if not instrumented).
+#ifdef DRIVER_CTX_INSTRUMENT
+#define DriverContextSetName(ctx, name) \
+    (((DrvCtx_t*)(ctx))->__name = (name))
+#define DriverContextInstrumentMark() \
+    DRV_instrumentMark()
+#define DriverContextInstrumentReset() \
+    DRV_instrumentReset()
+#define DriverContextInstrumentReport() \
+    DRV_instrumentReport()
+#else
+#define DriverContextSetName(ctx, name) \
+    ((void)(ctx), (void)(name))
+#define DriverContextInstrumentMark() \
+    ((void)0)
+#define DriverContextInstrumentReset() \
+    ((void)0)
+#define DriverContextInstrumentReport() \
+    ((HpsErr_t)ERR_NOSUPPORT)
+#endif
 
 #endif /* DRIVER_CTX_H */
 
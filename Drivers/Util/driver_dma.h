@@ -12,6 +12,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add scatter-gather transfer lists.
  * 15/02/2024 | Creation of driver.
  */
 
@@ -46,6 +47,7 @@ typedef enum {
 // IO Function Templates
 typedef HpsErr_t (*DmaXferParamFunc_t)(void* ctx, DmaChunk_t* xfer);
 typedef HpsErr_t (*DmaXferFunc_t)     (void* ctx, DmaChunk_t* xfer, bool autoStart);
+typedef HpsErr_t (*DmaXferListFunc_t) (void* ctx, DmaChunk_t* xfers, unsigned int count, bool autoStart);
 typedef HpsErr_t (*DmaXferStartFunc_t)(void* ctx);
 typedef HpsErr_t (*DmaXferSpaceFunc_t)(void* ctx, unsigned int* space);
 typedef HpsErr_t (*DmaAbortFunc_t)    (void* ctx, DmaAbortType abort);
@@ -60,6 +62,7 @@ typedef struct {
     DmaXferParamFunc_t  initXferParams;
     DmaXferSpaceFunc_t  transferSpace;
     DmaXferFunc_t       setupTransfer;
+    DmaXferListFunc_t   setupTransferList;
     DmaXferStartFunc_t  startTransfer;
     DmaAbortFunc_t      abortTransfer;
     // Status Functions
@@ -106,6 +109,19 @@ static inline HpsErr_t DMA_setupTransfer(DmaCtx_t* dma, DmaChunk_t* xfer, bool a
     return dma->setupTransfer(dma->ctx, xfer, autoStart);
 }
 
+// Configure a scatter-gather DMA transfer from an array of DmaChunk structures
+// - The count chunks are performed in order as a single transfer, which is
+//   started, checked and aborted as with DMA_setupTransfer.
+// - Whether the xfers array must remain valid until the transfer is done
+//   is implementation defined.
+// - Returns ERR_NOSUPPORT if the driver cannot chain transfers.
+// - Returns ERR_BUSY if not enough space to start a new Xfer
+static inline HpsErr_t DMA_setupTransferList(DmaCtx_t* dma, DmaChunk_t* xfers, unsigned int count, bool autoStart) {
+    if (!dma) return ERR_NULLPTR;
+    if (!dma->setupTransferList) return ERR_NOSUPPORT;
+    return dma->setupTransferList(dma->ctx, xfers, count, autoStart);
+}
+
 // Perform the previously configured transfer
 // - Returns ERR_BUSY if not enough space to start a new Xfer
 static inline HpsErr_t DMA_startTransfer(DmaCtx_t* dma) {
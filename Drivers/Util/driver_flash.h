@@ -12,6 +12,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add SPI NOR flash type.
  * 12/10/2024 | Add read-only/write-protect APIs.
  * 01/01/2024 | Creation of driver.
  */
@@ -40,7 +41,8 @@ typedef HpsErr_t (*FlashWriteFunc_t )(void* ctx, unsigned int address, unsigned
 typedef enum {
     FLASH_TYPE_UNKNOWN,
     FLASH_TYPE_EPCQ,
-    FLASH_TYPE_CFI
+    FLASH_TYPE_CFI,
+    FLASH_TYPE_SPINOR
 } FlashType;
 
 // Flash Region
@@ -5,6 +5,27 @@
  * drivers to allow them to be used as a generic
  * handler.
  *
+ * Fast Path
+ * ---------
+ *
+ * For bit-banged protocols, the per-call overhead of the
+ * checked APIs can limit the speed rather than the hardware.
+ * Drivers which support it provide a fast path description
+ * of their registers, which can be fetched once with
+ * GPIO_getFast() and then used with the inline unchecked
+ * GPIO_fast*() accessors, avoiding both the validation and
+ * the driver function pointers:
+ *
+ *    GpioFast_t* fast = GPIO_getFast(gpio);
+ *    if (!fast) return ERR_NOSUPPORT;
+ *    GPIO_fastSet(fast, SCK);
+ *    bit = GPIO_fastRead(fast, MISO);
+ *
+ * The fast accessors perform no validation, and where the
+ * hardware has no set/clear registers are a plain
+ * read-modify-write. Either the pins must not be shared
+ * with interrupt handlers, or interrupts masked around use.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -12,6 +33,8 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Allow fast path with output cache, or input only
+ * 14/10/2026 | Add bit set/clear and unchecked fast path accessors
  * 30/12/2023 | Creation of driver.
  */
 
@@ -30,6 +53,22 @@
 typedef HpsErr_t (*GpioWriteFunc_t )(void* ctx, unsigned int out, unsigned int mask);
 typedef HpsErr_t (*GpioToggleFunc_t)(void* ctx, unsigned int mask);
 typedef HpsErr_t (*GpioReadFunc_t  )(void* ctx, unsigned int* in, unsigned int mask);
+typedef HpsErr_t (*GpioMaskFunc_t  )(void* ctx, unsigned int mask);
+
+// GPIO Fast Path
+//  - out/in are NULL if the pins can't be written/read. The driver
+//    has no fast path if both are NULL.
+//  - outSet/outClear are NULL if the hardware has no set/clear registers.
+//  - cache is NULL unless the output register can't be read back, in which
+//    case it points to the driver's copy of the output value.
+typedef struct {
+    volatile unsigned int* out;      // Output data register
+    volatile unsigned int* in;       // Input data register
+    volatile unsigned int* outSet;   // Writing 1 sets output bit
+    volatile unsigned int* outClear; // Writing 1 clears output bit
+    unsigned int* cache;             // Copy of output value
+    unsigned int polarity;           // Pins which are inverted
+} GpioFast_t;
 
 // GPIO Context
 typedef struct {
@@ -42,6 +81,10 @@ typedef struct {
     GpioReadFunc_t   getOutput;
     GpioToggleFunc_t toggleOutput;
     GpioReadFunc_t   getInput;
+    GpioMaskFunc_t   bitsetOutput;
+    GpioMaskFunc_t   bitclearOutput;
+    // Fast Path
+    GpioFast_t       fast;
 } GpioCtx_t;
 
 // Check if driver initialised
@@ -86,5 +129,81 @@ static inline HpsErr_t GPIO_getInput(GpioCtx_t* gpio, unsigned int* in, unsigned
     return gpio->getInput(gpio->ctx,in,mask);
 }
 
+// Set masked output bits
+//  - Falls back to setOutput if the driver has no bit set function
+static inline HpsErr_t GPIO_bitsetOutput(GpioCtx_t* gpio, unsigned int mask) {
+    if (!gpio) return ERR_NULLPTR;
+    if (gpio->bitsetOutput) return gpio->bitsetOutput(gpio->ctx,mask);
+    if (!gpio->setOutput) return ERR_NOSUPPORT;
+    return gpio->setOutput(gpio->ctx,mask,mask);
+}
+
+// Clear masked output bits
+//  - Falls back to setOutput if the driver has no bit clear function
+static inline HpsErr_t GPIO_bitclearOutput(GpioCtx_t* gpio, unsigned int mask) {
+    if (!gpio) return ERR_NULLPTR;
+    if (gpio->bitclearOutput) return gpio->bitclearOutput(gpio->ctx,mask);
+    if (!gpio->setOutput) return ERR_NOSUPPORT;
+    return gpio->setOutput(gpio->ctx,0,mask);
+}
+
+// Get the fast path
+//  - Returns NULL if the driver is not initialised or has no fast path
+static inline GpioFast_t* GPIO_getFast(GpioCtx_t* gpio) {
+    if (!GPIO_isInitialised(gpio)) return NULL;
+    if (!gpio->fast.out && !gpio->fast.in) return NULL;
+    return &gpio->fast;
+}
+
+// Fast path: set and clear output bits
+//  - Pins in set are set, and those in clear are cleared. Set takes priority.
+//  - Unchecked. Not atomic unless the hardware has set/clear registers.
+static inline void GPIO_fastUpdate(GpioFast_t* fast, unsigned int set, unsigned int clear) {
+    // Inverted pins are cleared to set them, and vice versa
+    clear &= ~set;
+    unsigned int hi = (set & ~fast->polarity) | (clear &  fast->polarity);
+    unsigned int lo = (set &  fast->polarity) | (clear & ~fast->polarity);
+    if (fast->outSet) {
+        if (hi) *fast->outSet   = hi;
+        if (lo) *fast->outClear = lo;
+        if (fast->cache) *fast->cache = (*fast->cache | hi) & ~lo;
+    } else if (fast->cache) {
+        *fast->cache = (*fast->cache | hi) & ~lo;
+        *fast->out = *fast->cache;
+    } else {
+        *fast->out = (*fast->out | hi) & ~lo;
+    }
+}
+
+// Fast path: set output bits
+static inline void GPIO_fastSet(GpioFast_t* fast, unsigned int mask) {
+    GPIO_fastUpdate(fast, mask, 0);
+}
+
+// Fast path: clear output bits
+static inline void GPIO_fastClear(GpioFast_t* fast, unsigned int mask) {
+    GPIO_fastUpdate(fast, 0, mask);
+}
+
+// Fast path: write masked output bits
+static inline void GPIO_fastWrite(GpioFast_t* fast, unsigned int port, unsigned int mask) {
+    GPIO_fastUpdate(fast, port & mask, ~port & mask);
+}
+
+// Fast path: toggle output bits
+static inline void GPIO_fastToggle(GpioFast_t* fast, unsigned int mask) {
+    if (fast->cache) {
+        *fast->cache = *fast->cache ^ mask;
+        *fast->out = *fast->cache;
+    } else {
+        *fast->out = *fast->out ^ mask;
+    }
+}
+
+// Fast path: read masked input bits
+static inline unsigned int GPIO_fastRead(GpioFast_t* fast, unsigned int mask) {
+    return (*fast->in ^ fast->polarity) & mask;
+}
+
 
 #endif /* DRIVER_GPIO_H_ */
@@ -0,0 +1,795 @@
+/*
+ * Block Based Fixed-Point DSP Kernels
+ * -----------------------------------
+ *
+ * Provides block oriented fixed-point signal processing
+ * kernels for audio, intended to be used with blocks of
+ * samples from the WM8731 audio driver.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add radix-4 FFT, window and magnitude kernels.
+ * 14/10/2026 | Add polyphase sample rate converter.
+ * 14/10/2026 | Add scaled accumulate for multi-voice mixing.
+ * 14/10/2026 | Add NEON oscillator blocks and multi-voice tone generation.
+ * 14/10/2026 | Place block kernels in on-chip RAM via HOT_CODE.
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "dsp.h"
+
+#include "Util/macros.h"
+
+#include <string.h>
+#include <math.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// 2*Pi for sine table generation
+#define DSP_2PI 6.283185307179586
+
+// Saturate to Q15
+static inline q15_t _DSP_satQ15(int64_t val) {
+    if (val > INT16_MAX) return INT16_MAX;
+    if (val < INT16_MIN) return INT16_MIN;
+    return (q15_t)val;
+}
+
+// Saturate to Q31
+static inline q31_t _DSP_satQ31(int64_t val) {
+    if (val > INT32_MAX) return INT32_MAX;
+    if (val < INT32_MIN) return INT32_MIN;
+    return (q31_t)val;
+}
+
+/*
+ * FIR Filters
+ */
+
+// Initialise a FIR filter (Q15)
+//  - coeffs is an array of numTaps coefficients, coeffs[0] applies to the newest sample.
+//  - state is an array of (numTaps + blockSize - 1) samples. Will be cleared.
+//  - blockSize is the maximum number of samples processed per call.
+HpsErr_t DSP_firInitQ15(DspFirQ15_t* fir, const q15_t* coeffs, unsigned int numTaps, q15_t* state, unsigned int blockSize) {
+    if (!fir || !coeffs || !state) return ERR_NULLPTR;
+    if (!numTaps || !blockSize) return ERR_TOOSMALL;
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->numTaps = numTaps;
+    fir->blockSize = blockSize;
+    memset(state, 0, (numTaps + blockSize - 1) * sizeof(q15_t));
+    return ERR_SUCCESS;
+}
+
+// Run a FIR filter (Q15)
+//  - Processes count samples from in to out. count must not exceed blockSize.
+//  - in and out may be the same array.
+HOT_CODE HpsErr_t DSP_firQ15(DspFirQ15_t* fir, const q15_t* in, q15_t* out, unsigned int count) {
+    if (!fir || !in || !out) return ERR_NULLPTR;
+    if (count > fir->blockSize) return ERR_TOOBIG;
+    unsigned int numTaps = fir->numTaps;
+    const q15_t* coeffs = fir->coeffs;
+    q15_t* hist = fir->state;
+    //Append the new samples after the history. Sample n is then at hist[n + numTaps - 1].
+    memcpy(&hist[numTaps - 1], in, count * sizeof(q15_t));
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    //Four outputs at a time, with 64-bit accumulators
+    for (; n + 4 <= count; n += 4) {
+        int64x2_t accLo = vdupq_n_s64(0);
+        int64x2_t accHi = vdupq_n_s64(0);
+        const q15_t* x = &hist[n + numTaps - 1];
+        for (unsigned int k = 0; k < numTaps; k++) {
+            int32x4_t prod = vmull_n_s16(vld1_s16(x - k), coeffs[k]);
+            accLo = vaddw_s32(accLo, vget_low_s32(prod));
+            accHi = vaddw_s32(accHi, vget_high_s32(prod));
+        }
+        int32x4_t res = vcombine_s32(vqshrn_n_s64(accLo, 15), vqshrn_n_s64(accHi, 15));
+        vst1_s16(&out[n], vqmovn_s32(res));
+    }
+#endif
+    //Remaining outputs
+    for (; n < count; n++) {
+        int64_t acc = 0;
+        const q15_t* x = &hist[n + numTaps - 1];
+        for (unsigned int k = 0; k < numTaps; k++) {
+            acc += (int32_t)coeffs[k] * x[-(int)k];
+        }
+        out[n] = _DSP_satQ15(acc >> 15);
+    }
+    //Keep the last (numTaps - 1) samples as history
+    memmove(hist, &hist[count], (numTaps - 1) * sizeof(q15_t));
+    return ERR_SUCCESS;
+}
+
+// Initialise a FIR filter (Q31)
+//  - coeffs is an array of numTaps coefficients, coeffs[0] applies to the newest sample.
+//  - state is an array of (numTaps + blockSize - 1) samples. Will be cleared.
+//  - blockSize is the maximum number of samples processed per call.
+HpsErr_t DSP_firInitQ31(DspFirQ31_t* fir, const q31_t* coeffs, unsigned int numTaps, q31_t* state, unsigned int blockSize) {
+    if (!fir || !coeffs || !state) return ERR_NULLPTR;
+    if (!numTaps || !blockSize) return ERR_TOOSMALL;
+    fir->coeffs = coeffs;
+    fir->state = state;
+    fir->numTaps = numTaps;
+    fir->blockSize = blockSize;
+    memset(state, 0, (numTaps + blockSize - 1) * sizeof(q31_t));
+    return ERR_SUCCESS;
+}
+
+// Run a FIR filter (Q31)
+//  - Processes count samples from in to out. count must not exceed blockSize.
+//  - in and out may be the same array.
+HOT_CODE HpsErr_t DSP_firQ31(DspFirQ31_t* fir, const q31_t* in, q31_t* out, unsigned int count) {
+    if (!fir || !in || !out) return ERR_NULLPTR;
+    if (count > fir->blockSize) return ERR_TOOBIG;
+    unsigned int numTaps = fir->numTaps;
+    const q31_t* coeffs = fir->coeffs;
+    q31_t* hist = fir->state;
+    //Append the new samples after the history. Sample n is then at hist[n + numTaps - 1].
+    memcpy(&hist[numTaps - 1], in, count * sizeof(q31_t));
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    //Four outputs at a time, with 64-bit accumulators
+    for (; n + 4 <= count; n += 4) {
+        int64x2_t accLo = vdupq_n_s64(0);
+        int64x2_t accHi = vdupq_n_s64(0);
+        const q31_t* x = &hist[n + numTaps - 1];
+        for (unsigned int k = 0; k < numTaps; k++) {
+            int32x4_t samples = vld1q_s32(x - k);
+            accLo = vmlal_n_s32(accLo, vget_low_s32(samples),  coeffs[k]);
+            accHi = vmlal_n_s32(accHi, vget_high_s32(samples), coeffs[k]);
+        }
+        vst1q_s32(&out[n], vcombine_s32(vqshrn_n_s64(accLo, 31), vqshrn_n_s64(accHi, 31)));
+    }
+#endif
+    //Remaining outputs
+    for (; n < count; n++) {
+        int64_t acc = 0;
+        const q31_t* x = &hist[n + numTaps - 1];
+        for (unsigned int k = 0; k < numTaps; k++) {
+            acc += (int64_t)coeffs[k] * x[-(int)k];
+        }
+        out[n] = _DSP_satQ31(acc >> 31);
+    }
+    //Keep the last (numTaps - 1) samples as history
+    memmove(hist, &hist[count], (numTaps - 1) * sizeof(q31_t));
+    return ERR_SUCCESS;
+}
+
+/*
+ * Polyphase Resampler
+ */
+
+// Tap of a Blackman windowed sinc filter
+static double _DSP_sincTap(unsigned int tap, unsigned int numTaps, double cutoff) {
+    double t = tap - (numTaps - 1) / 2.0;
+    double sinc = (t == 0) ? (2 * cutoff) : (sin(DSP_2PI * cutoff * t) / (DSP_2PI / 2 * t));
+    double pos = (tap + 0.5) / numTaps;
+    return sinc * (0.42 - 0.5 * cos(DSP_2PI * pos) + 0.08 * cos(2 * DSP_2PI * pos));
+}
+
+// Design resampler coefficients (Q31)
+//  - Fills coeffs with (interp * tapsPerPhase) coefficients of a Blackman
+//    windowed sinc low-pass filter for a ratio of interp/decim, cutting off
+//    just below the lower of the two Nyquist rates.
+//  - Each phase has a DC gain of 1. More taps per phase give a sharper
+//    cut-off; 16 to 32 is typical for audio.
+//  - Uses floating point, so call once during setup.
+HpsErr_t DSP_resampleDesignQ31(q31_t* coeffs, unsigned int interp, unsigned int decim, unsigned int tapsPerPhase) {
+    if (!coeffs) return ERR_NULLPTR;
+    if (!interp || !decim || !tapsPerPhase) return ERR_TOOSMALL;
+    unsigned int numTaps = interp * tapsPerPhase;
+    //Cut-off as a fraction of the upsampled rate, with 10% for the transition band
+    double cutoff = 0.45 / ((interp > decim) ? interp : decim);
+    for (unsigned int phase = 0; phase < interp; phase++) {
+        //Normalise so that each phase passes DC at unity gain
+        double sum = 0;
+        for (unsigned int k = 0; k < tapsPerPhase; k++) {
+            sum += _DSP_sincTap(k * interp + phase, numTaps, cutoff);
+        }
+        //Taps of the phase are stored oldest sample first
+        q31_t* h = &coeffs[phase * tapsPerPhase];
+        for (unsigned int k = 0; k < tapsPerPhase; k++) {
+            double val = _DSP_sincTap((tapsPerPhase - 1 - k) * interp + phase, numTaps, cutoff) / sum;
+            h[k] = (val >= 1.0) ? INT32_MAX : (q31_t)(val * 2147483648.0);
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+// Initialise a resampler (Q31)
+//  - Converts the sample rate by interp/decim (L/M), e.g. 160/147 for 44.1kHz
+//    to 48kHz. The ratio should be in its lowest terms.
+//  - coeffs is (interp * tapsPerPhase) coefficients in polyphase order, as made
+//    by DSP_resampleDesignQ31(). For a prototype filter h[] at interp times the
+//    input rate, coeffs[p * tapsPerPhase + k] = h[(tapsPerPhase - 1 - k) * interp + p].
+//    They may be shared by several resamplers (e.g. left and right).
+//  - state is an array of (tapsPerPhase + blockSize - 1) samples. Will be cleared.
+//  - blockSize is the maximum number of input samples processed per call.
+HpsErr_t DSP_resampleInitQ31(DspResampleQ31_t* rs, const q31_t* coeffs, unsigned int interp, unsigned int decim, unsigned int tapsPerPhase, q31_t* state, unsigned int blockSize) {
+    if (!rs || !coeffs || !state) return ERR_NULLPTR;
+    if (!interp || !decim || !tapsPerPhase || !blockSize) return ERR_TOOSMALL;
+    rs->coeffs = coeffs;
+    rs->state = state;
+    rs->tapsPerPhase = tapsPerPhase;
+    rs->blockSize = blockSize;
+    rs->interp = interp;
+    rs->decim = decim;
+    rs->phase = 0;
+    rs->index = 0;
+    memset(state, 0, (tapsPerPhase + blockSize - 1) * sizeof(q31_t));
+    return ERR_SUCCESS;
+}
+
+// Run a resampler (Q31)
+//  - Converts count input samples, which must not exceed blockSize.
+//  - out must have space for DSP_RESAMPLE_MAX_OUT(rs, count) samples.
+//  - Returns the number of output samples written (>= 0). This varies from
+//    call to call when the ratio does not divide count.
+HOT_CODE HpsErr_t DSP_resampleQ31(DspResampleQ31_t* rs, const q31_t* in, q31_t* out, unsigned int count) {
+    if (!rs || !in || !out) return ERR_NULLPTR;
+    if (count > rs->blockSize) return ERR_TOOBIG;
+    unsigned int taps = rs->tapsPerPhase;
+    unsigned int interp = rs->interp;
+    unsigned int decim = rs->decim;
+    unsigned int phase = rs->phase;
+    unsigned int idx = rs->index;
+    q31_t* hist = rs->state;
+    //Append the new samples after the history. Sample n is then at hist[n + taps - 1].
+    memcpy(&hist[taps - 1], in, count * sizeof(q31_t));
+    unsigned int n = 0;
+    while (idx < count) {
+        //Taps of this phase are stored oldest first, so both run forwards
+        const q31_t* h = &rs->coeffs[phase * taps];
+        const q31_t* x = &hist[idx];
+        int64_t acc = 0;
+        unsigned int k = 0;
+#if defined(__ARM_NEON)
+        int64x2_t accV = vdupq_n_s64(0);
+        for (; k + 4 <= taps; k += 4) {
+            int32x4_t hv = vld1q_s32(&h[k]);
+            int32x4_t xv = vld1q_s32(&x[k]);
+            accV = vmlal_s32(accV, vget_low_s32(hv),  vget_low_s32(xv));
+            accV = vmlal_s32(accV, vget_high_s32(hv), vget_high_s32(xv));
+        }
+        acc = vgetq_lane_s64(accV, 0) + vgetq_lane_s64(accV, 1);
+#endif
+        for (; k < taps; k++) {
+            acc += (int64_t)h[k] * x[k];
+        }
+        out[n++] = _DSP_satQ31(acc >> 31);
+        //Step by M/L input samples. No divide, as the Cortex-A9 has none.
+        phase += decim;
+        while (phase >= interp) {
+            phase -= interp;
+            idx++;
+        }
+    }
+    rs->phase = phase;
+    rs->index = idx - count;
+    //Keep the last (taps - 1) samples as history
+    memmove(hist, &hist[count], (taps - 1) * sizeof(q31_t));
+    return (HpsErr_t)n;
+}
+
+/*
+ * Biquad IIR Filters
+ */
+
+// Initialise a biquad cascade (Q31)
+//  - coeffs is an array of (5 * numStages) coefficients.
+//  - state is an array of (4 * numStages) values. Will be cleared.
+//  - postShift is the number of bits the coefficients have been scaled down by.
+HpsErr_t DSP_biquadInitQ31(DspBiquadQ31_t* iir, const q31_t* coeffs, unsigned int numStages, q31_t* state, unsigned int postShift) {
+    if (!iir || !coeffs || !state) return ERR_NULLPTR;
+    if (!numStages) return ERR_TOOSMALL;
+    if (postShift > 30) return ERR_TOOBIG;
+    iir->coeffs = coeffs;
+    iir->state = state;
+    iir->numStages = numStages;
+    iir->postShift = postShift;
+    memset(state, 0, 4 * numStages * sizeof(q31_t));
+    return ERR_SUCCESS;
+}
+
+// Run a biquad cascade (Q31)
+//  - Processes count samples from in to out.
+//  - in and out may be the same array.
+HOT_CODE HpsErr_t DSP_biquadQ31(DspBiquadQ31_t* iir, const q31_t* in, q31_t* out, unsigned int count) {
+    if (!iir || !in || !out) return ERR_NULLPTR;
+    unsigned int shift = 31 - iir->postShift;
+    const q31_t* coeffs = iir->coeffs;
+    q31_t* state = iir->state;
+    //Each stage processes the whole block, with later stages working in place on the output
+    const q31_t* src = in;
+    for (unsigned int stage = 0; stage < iir->numStages; stage++) {
+        q31_t b0 = coeffs[0], b1 = coeffs[1], b2 = coeffs[2], a1 = coeffs[3], a2 = coeffs[4];
+        q31_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+        for (unsigned int n = 0; n < count; n++) {
+            q31_t x = src[n];
+            int64_t acc = (int64_t)b0 * x + (int64_t)b1 * x1 + (int64_t)b2 * x2 + (int64_t)a1 * y1 + (int64_t)a2 * y2;
+            q31_t y = _DSP_satQ31(acc >> shift);
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            out[n] = y;
+        }
+        state[0] = x1;
+        state[1] = x2;
+        state[2] = y1;
+        state[3] = y2;
+        coeffs += 5;
+        state += 4;
+        src = out;
+    }
+    return ERR_SUCCESS;
+}
+
+/*
+ * Gain and Mix
+ */
+
+// Apply gain (Q15)
+//  - out[n] = in[n] * gain, saturated.
+//  - in and out may be the same array.
+HOT_CODE void DSP_gainQ15(const q15_t* in, q15_t* out, q15_t gain, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 8 <= count; n += 8) {
+        vst1q_s16(&out[n], vqdmulhq_n_s16(vld1q_s16(&in[n]), gain));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = _DSP_satQ15(((int32_t)in[n] * gain) >> 15);
+    }
+}
+
+// Apply gain (Q31)
+//  - out[n] = in[n] * gain, saturated.
+//  - in and out may be the same array.
+HOT_CODE void DSP_gainQ31(const q31_t* in, q31_t* out, q31_t gain, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_s32(&out[n], vqdmulhq_n_s32(vld1q_s32(&in[n]), gain));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = _DSP_satQ31(((int64_t)in[n] * gain) >> 31);
+    }
+}
+
+// Mix two signals (Q15)
+//  - out[n] = a[n] * gainA + b[n] * gainB, saturated.
+//  - out may be the same array as a or b.
+HOT_CODE void DSP_mixQ15(const q15_t* a, q15_t gainA, const q15_t* b, q15_t gainB, q15_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 8 <= count; n += 8) {
+        int16x8_t va = vqdmulhq_n_s16(vld1q_s16(&a[n]), gainA);
+        int16x8_t vb = vqdmulhq_n_s16(vld1q_s16(&b[n]), gainB);
+        vst1q_s16(&out[n], vqaddq_s16(va, vb));
+    }
+#endif
+    for (; n < count; n++) {
+        q15_t va = _DSP_satQ15(((int32_t)a[n] * gainA) >> 15);
+        q15_t vb = _DSP_satQ15(((int32_t)b[n] * gainB) >> 15);
+        out[n] = _DSP_satQ15((int32_t)va + vb);
+    }
+}
+
+// Mix two signals (Q31)
+//  - out[n] = a[n] * gainA + b[n] * gainB, saturated.
+//  - out may be the same array as a or b.
+HOT_CODE void DSP_mixQ31(const q31_t* a, q31_t gainA, const q31_t* b, q31_t gainB, q31_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        int32x4_t va = vqdmulhq_n_s32(vld1q_s32(&a[n]), gainA);
+        int32x4_t vb = vqdmulhq_n_s32(vld1q_s32(&b[n]), gainB);
+        vst1q_s32(&out[n], vqaddq_s32(va, vb));
+    }
+#endif
+    for (; n < count; n++) {
+        q31_t va = _DSP_satQ31(((int64_t)a[n] * gainA) >> 31);
+        q31_t vb = _DSP_satQ31(((int64_t)b[n] * gainB) >> 31);
+        out[n] = _DSP_satQ31((int64_t)va + vb);
+    }
+}
+
+// Accumulate a scaled signal (Q31)
+//  - acc[n] = acc[n] + in[n] * gain, saturated.
+//  - For mixing any number of signals into one buffer.
+HOT_CODE void DSP_macQ31(const q31_t* in, q31_t gain, q31_t* acc, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        int32x4_t va = vqdmulhq_n_s32(vld1q_s32(&in[n]), gain);
+        vst1q_s32(&acc[n], vqaddq_s32(vld1q_s32(&acc[n]), va));
+    }
+#endif
+    for (; n < count; n++) {
+        q31_t va = _DSP_satQ31(((int64_t)in[n] * gain) >> 31);
+        acc[n] = _DSP_satQ31((int64_t)acc[n] + va);
+    }
+}
+
+/*
+ * Tone Generation
+ */
+
+// Sine table with one extra entry for interpolation. Generated on first use.
+static q31_t _DSP_sineTable[DSP_SINE_TABLE_SIZE + 1];
+static bool _DSP_sineTableInit = false;
+
+// Initialise a numerically controlled oscillator
+//  - freq is the tone frequency in Hz, and sampleRate the sample rate in Hz.
+//  - amplitude is the peak amplitude (Q31).
+//  - Returns ERR_TOOBIG if freq is not below the Nyquist rate.
+HpsErr_t DSP_ncoInit(DspNco_t* nco, unsigned int freq, unsigned int sampleRate, q31_t amplitude) {
+    if (!nco) return ERR_NULLPTR;
+    if (!sampleRate) return ERR_TOOSMALL;
+    if ((2ULL * freq) >= sampleRate) return ERR_TOOBIG;
+    if (!_DSP_sineTableInit) {
+        for (unsigned int idx = 0; idx <= DSP_SINE_TABLE_SIZE; idx++) {
+            _DSP_sineTable[idx] = (q31_t)(sin((DSP_2PI * idx) / DSP_SINE_TABLE_SIZE) * INT32_MAX);
+        }
+        _DSP_sineTableInit = true;
+    }
+    //Phase is a 32-bit fraction of a full cycle
+    nco->phase = 0;
+    nco->phaseInc = (uint32_t)(((uint64_t)freq << 32) / sampleRate);
+    nco->amplitude = amplitude;
+    return ERR_SUCCESS;
+}
+
+// Change the frequency of an oscillator
+//  - Phase is kept, so the tone changes without a discontinuity.
+//  - Returns ERR_TOOBIG if freq is not below the Nyquist rate.
+HpsErr_t DSP_ncoSetFreq(DspNco_t* nco, unsigned int freq, unsigned int sampleRate) {
+    if (!nco) return ERR_NULLPTR;
+    if (!sampleRate) return ERR_TOOSMALL;
+    if ((2ULL * freq) >= sampleRate) return ERR_TOOBIG;
+    nco->phaseInc = (uint32_t)(((uint64_t)freq << 32) / sampleRate);
+    return ERR_SUCCESS;
+}
+
+// Generate a block of one oscillator, optionally adding it to out with saturation
+static HOT_CODE void _DSP_ncoBlock(DspNco_t* nco, q31_t* out, unsigned int count, bool accumulate) {
+    uint32_t phase = nco->phase;
+    uint32_t inc = nco->phaseInc;
+    q31_t amplitude = nco->amplitude;
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    //Four consecutive phases at once. Table lookups are per lane, the
+    //interpolation and scaling are vectorised.
+    if (count >= 4) {
+        uint32_t phases[4] = { phase, phase + inc, phase + 2 * inc, phase + 3 * inc };
+        uint32x4_t vphase = vld1q_u32(phases);
+        uint32x4_t vinc = vdupq_n_u32(4 * inc);
+        int32x4_t vamp = vdupq_n_s32(amplitude);
+        for (; n + 4 <= count; n += 4) {
+            uint32x4_t idx = vshrq_n_u32(vphase, 32 - DSP_SINE_TABLE_BITS);
+            //Bits below the index as a positive Q31 fraction
+            int32x4_t frac = vreinterpretq_s32_u32(vshrq_n_u32(vshlq_n_u32(vphase, DSP_SINE_TABLE_BITS), 1));
+            int32x4_t s0 = vdupq_n_s32(0);
+            int32x4_t s1 = vdupq_n_s32(0);
+            s0 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 0)], s0, 0);
+            s1 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 0) + 1], s1, 0);
+            s0 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 1)], s0, 1);
+            s1 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 1) + 1], s1, 1);
+            s0 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 2)], s0, 2);
+            s1 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 2) + 1], s1, 2);
+            s0 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 3)], s0, 3);
+            s1 = vld1q_lane_s32(&_DSP_sineTable[vgetq_lane_u32(idx, 3) + 1], s1, 3);
+            int32x4_t val = vaddq_s32(s0, vqdmulhq_s32(vsubq_s32(s1, s0), frac));
+            val = vqdmulhq_s32(val, vamp);
+            if (accumulate) val = vqaddq_s32(val, vld1q_s32(&out[n]));
+            vst1q_s32(&out[n], val);
+            vphase = vaddq_u32(vphase, vinc);
+        }
+        phase = vgetq_lane_u32(vphase, 0);
+    }
+#endif
+    for (; n < count; n++) {
+        //Top bits index the table, next 15 bits interpolate between entries
+        unsigned int idx = phase >> (32 - DSP_SINE_TABLE_BITS);
+        int32_t frac = (phase >> (32 - DSP_SINE_TABLE_BITS - 15)) & 0x7FFF;
+        q31_t s0 = _DSP_sineTable[idx];
+        q31_t s1 = _DSP_sineTable[idx + 1];
+        q31_t val = s0 + (q31_t)(((int64_t)(s1 - s0) * frac) >> 15);
+        val = (q31_t)(((int64_t)val * amplitude) >> 31);
+        out[n] = accumulate ? _DSP_satQ31((int64_t)out[n] + val) : val;
+        phase += inc;
+    }
+    nco->phase = phase;
+}
+
+// Generate samples from an oscillator (Q31)
+//  - Writes count samples of the tone to out, continuing from the previous call.
+HOT_CODE void DSP_ncoQ31(DspNco_t* nco, q31_t* out, unsigned int count) {
+    _DSP_ncoBlock(nco, out, count, false);
+}
+
+// Generate the sum of several oscillators (Q31)
+//  - Writes count samples of the sum of numVoices tones to out, saturated.
+//  - Each voice continues from the previous call.
+HOT_CODE void DSP_ncoMixQ31(DspNco_t* voices, unsigned int numVoices, q31_t* out, unsigned int count) {
+    if (!numVoices) {
+        memset(out, 0, count * sizeof(q31_t));
+        return;
+    }
+    //First voice sets the block, the rest are added to it
+    _DSP_ncoBlock(&voices[0], out, count, false);
+    for (unsigned int voice = 1; voice < numVoices; voice++) {
+        _DSP_ncoBlock(&voices[voice], out, count, true);
+    }
+}
+
+/*
+ * Fast Fourier Transform
+ */
+
+// Initialise an FFT (Q31)
+//  - size is the number of complex points, a power of 4 from 16 to 4096.
+//  - twiddles is an array of DSP_FFT_TWIDDLE_SIZE(size) values, which is
+//    filled in. It may be shared by several FFTs of the same size.
+//  - Uses floating point, so call once during setup.
+HpsErr_t DSP_fftInitQ31(DspFftQ31_t* fft, unsigned int size, q31_t* twiddles) {
+    if (!fft || !twiddles) return ERR_NULLPTR;
+    if (size < 16) return ERR_TOOSMALL;
+    if (size > 4096) return ERR_TOOBIG;
+    //Power of 4 has a single bit set in an even position
+    if ((size & (size - 1)) || (size & 0xAAAAAAAAU)) return ERR_NOSUPPORT;
+    fft->size = size;
+    fft->twiddles = twiddles;
+    //Each stage has {w1 real, w1 imag, w2 real, w2 imag, w3 real, w3 imag},
+    //for each of the quarter length of the stage.
+    q31_t* tw = twiddles;
+    for (unsigned int len = size; len >= 4; len >>= 2) {
+        unsigned int quarter = len >> 2;
+        for (unsigned int m = 1; m <= 3; m++) {
+            q31_t* wr = &tw[(2 * m - 2) * quarter];
+            q31_t* wi = &tw[(2 * m - 1) * quarter];
+            for (unsigned int j = 0; j < quarter; j++) {
+                double angle = (DSP_2PI * m * j) / len;
+                double re = cos(angle);
+                wr[j] = (re >= 1.0) ? INT32_MAX : (q31_t)(re * 2147483648.0);
+                wi[j] = (q31_t)(-sin(angle) * 2147483648.0);
+            }
+        }
+        tw += 6 * quarter;
+    }
+    return ERR_SUCCESS;
+}
+
+// Complex multiply (Q31), saturated
+static inline void _DSP_cmplxMulQ31(q31_t* yr, q31_t* yi, q31_t vr, q31_t vi, q31_t wr, q31_t wi) {
+    *yr = _DSP_satQ31(((int64_t)vr * wr - (int64_t)vi * wi) >> 31);
+    *yi = _DSP_satQ31(((int64_t)vr * wi + (int64_t)vi * wr) >> 31);
+}
+
+#if defined(__ARM_NEON)
+// Complex multiply of four values (Q31), saturated
+static inline int32x4x2_t _DSP_cmplxMulQ31x4(int32x4x2_t v, int32x4_t wr, int32x4_t wi) {
+    int32x4x2_t y;
+    y.val[0] = vqsubq_s32(vqrdmulhq_s32(v.val[0], wr), vqrdmulhq_s32(v.val[1], wi));
+    y.val[1] = vqaddq_s32(vqrdmulhq_s32(v.val[0], wi), vqrdmulhq_s32(v.val[1], wr));
+    return y;
+}
+#endif
+
+// Run an FFT (Q31)
+//  - data is an array of size complex values {real, imag}, transformed in place.
+//  - The output is in natural order, scaled by 1/size. Each stage scales by 1/4
+//    before its butterflies, so the transform cannot overflow.
+HOT_CODE HpsErr_t DSP_fftQ31(const DspFftQ31_t* fft, q31_t* data) {
+    if (!fft || !data) return ERR_NULLPTR;
+    unsigned int size = fft->size;
+    const q31_t* tw = fft->twiddles;
+    //Radix-4 decimation in frequency
+    for (unsigned int len = size; len >= 4; len >>= 2) {
+        unsigned int quarter = len >> 2;
+        const q31_t* w1r = &tw[0];
+        const q31_t* w1i = &tw[quarter];
+        const q31_t* w2r = &tw[2 * quarter];
+        const q31_t* w2i = &tw[3 * quarter];
+        const q31_t* w3r = &tw[4 * quarter];
+        const q31_t* w3i = &tw[5 * quarter];
+        for (unsigned int base = 0; base < size; base += len) {
+            q31_t* x0 = &data[2 * base];
+            q31_t* x1 = &x0[2 * quarter];
+            q31_t* x2 = &x1[2 * quarter];
+            q31_t* x3 = &x2[2 * quarter];
+            unsigned int j = 0;
+#if defined(__ARM_NEON)
+            //Four butterflies at a time. Only the last stage is too short.
+            for (; j + 4 <= quarter; j += 4) {
+                int32x4x2_t a = vld2q_s32(&x0[2 * j]);
+                int32x4x2_t b = vld2q_s32(&x1[2 * j]);
+                int32x4x2_t c = vld2q_s32(&x2[2 * j]);
+                int32x4x2_t d = vld2q_s32(&x3[2 * j]);
+                int32x4_t ar = vshrq_n_s32(a.val[0], 2), ai = vshrq_n_s32(a.val[1], 2);
+                int32x4_t br = vshrq_n_s32(b.val[0], 2), bi = vshrq_n_s32(b.val[1], 2);
+                int32x4_t cr = vshrq_n_s32(c.val[0], 2), ci = vshrq_n_s32(c.val[1], 2);
+                int32x4_t dr = vshrq_n_s32(d.val[0], 2), di = vshrq_n_s32(d.val[1], 2);
+                int32x4_t t0r = vaddq_s32(ar, cr), t0i = vaddq_s32(ai, ci);
+                int32x4_t t1r = vsubq_s32(ar, cr), t1i = vsubq_s32(ai, ci);
+                int32x4_t t2r = vaddq_s32(br, dr), t2i = vaddq_s32(bi, di);
+                int32x4_t t3r = vsubq_s32(br, dr), t3i = vsubq_s32(bi, di);
+                int32x4x2_t y0 = { { vaddq_s32(t0r, t2r), vaddq_s32(t0i, t2i) } };
+                int32x4x2_t v1 = { { vaddq_s32(t1r, t3i), vsubq_s32(t1i, t3r) } };
+                int32x4x2_t v2 = { { vsubq_s32(t0r, t2r), vsubq_s32(t0i, t2i) } };
+                int32x4x2_t v3 = { { vsubq_s32(t1r, t3i), vaddq_s32(t1i, t3r) } };
+                vst2q_s32(&x0[2 * j], y0);
+                vst2q_s32(&x1[2 * j], _DSP_cmplxMulQ31x4(v2, vld1q_s32(&w2r[j]), vld1q_s32(&w2i[j])));
+                vst2q_s32(&x2[2 * j], _DSP_cmplxMulQ31x4(v1, vld1q_s32(&w1r[j]), vld1q_s32(&w1i[j])));
+                vst2q_s32(&x3[2 * j], _DSP_cmplxMulQ31x4(v3, vld1q_s32(&w3r[j]), vld1q_s32(&w3i[j])));
+            }
+#endif
+            for (; j < quarter; j++) {
+                q31_t ar = x0[2 * j] >> 2, ai = x0[2 * j + 1] >> 2;
+                q31_t br = x1[2 * j] >> 2, bi = x1[2 * j + 1] >> 2;
+                q31_t cr = x2[2 * j] >> 2, ci = x2[2 * j + 1] >> 2;
+                q31_t dr = x3[2 * j] >> 2, di = x3[2 * j + 1] >> 2;
+                q31_t t0r = ar + cr, t0i = ai + ci;
+                q31_t t1r = ar - cr, t1i = ai - ci;
+                q31_t t2r = br + dr, t2i = bi + di;
+                q31_t t3r = br - dr, t3i = bi - di;
+                x0[2 * j]     = t0r + t2r;
+                x0[2 * j + 1] = t0i + t2i;
+                //Outputs 1 and 2 are swapped, so that the digit reversal is a plain base 4 reversal
+                _DSP_cmplxMulQ31(&x1[2 * j], &x1[2 * j + 1], t0r - t2r, t0i - t2i, w2r[j], w2i[j]);
+                _DSP_cmplxMulQ31(&x2[2 * j], &x2[2 * j + 1], t1r + t3i, t1i - t3r, w1r[j], w1i[j]);
+                _DSP_cmplxMulQ31(&x3[2 * j], &x3[2 * j + 1], t1r - t3i, t1i + t3r, w3r[j], w3i[j]);
+            }
+        }
+        tw += 6 * quarter;
+    }
+    //Reorder from bit reversed
+    unsigned int bits = 0;
+    while ((1U << bits) < size) bits++;
+    for (unsigned int i = 1; i < size - 1; i++) {
+        unsigned int rev = 0;
+        for (unsigned int t = i, n = 0; n < bits; n++, t >>= 1) {
+            rev = (rev << 1) | (t & 1);
+        }
+        if (rev > i) {
+            q31_t re = data[2 * i], im = data[2 * i + 1];
+            data[2 * i]       = data[2 * rev];
+            data[2 * i + 1]   = data[2 * rev + 1];
+            data[2 * rev]     = re;
+            data[2 * rev + 1] = im;
+        }
+    }
+    return ERR_SUCCESS;
+}
+
+// Make a Hann window (Q31)
+//  - Fills window with size values, for use with DSP_fftLoadRealQ31().
+//  - Uses floating point, so call once during setup.
+HpsErr_t DSP_windowHannQ31(q31_t* window, unsigned int size) {
+    if (!window) return ERR_NULLPTR;
+    if (!size) return ERR_TOOSMALL;
+    for (unsigned int n = 0; n < size; n++) {
+        double val = 0.5 - 0.5 * cos((DSP_2PI * n) / size);
+        window[n] = (val >= 1.0) ? INT32_MAX : (q31_t)(val * 2147483648.0);
+    }
+    return ERR_SUCCESS;
+}
+
+// Load real samples for an FFT (Q31)
+//  - out[2n] = in[n] * window[n], out[2n+1] = 0, for count samples.
+//  - window may be NULL for a rectangular window.
+HOT_CODE void DSP_fftLoadRealQ31(const q31_t* in, const q31_t* window, q31_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    int32x4x2_t px;
+    px.val[1] = vdupq_n_s32(0);
+    for (; n + 4 <= count; n += 4) {
+        px.val[0] = vld1q_s32(&in[n]);
+        if (window) px.val[0] = vqrdmulhq_s32(px.val[0], vld1q_s32(&window[n]));
+        vst2q_s32(&out[2 * n], px);
+    }
+#endif
+    for (; n < count; n++) {
+        out[2 * n]     = window ? (q31_t)(((int64_t)in[n] * window[n]) >> 31) : in[n];
+        out[2 * n + 1] = 0;
+    }
+}
+
+// Squared magnitude of complex values (Q31)
+//  - out[n] = in[2n]^2 + in[2n+1]^2, saturated, for count values.
+//  - in and out may be the same array.
+HOT_CODE void DSP_cmplxMagSqQ31(const q31_t* in, q31_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        int32x4x2_t px = vld2q_s32(&in[2 * n]);
+        vst1q_s32(&out[n], vqaddq_s32(vqdmulhq_s32(px.val[0], px.val[0]), vqdmulhq_s32(px.val[1], px.val[1])));
+    }
+#endif
+    for (; n < count; n++) {
+        int64_t re = in[2 * n], im = in[2 * n + 1];
+        out[n] = _DSP_satQ31((re * re + im * im) >> 31);
+    }
+}
+
+/*
+ * Codec Sample Conversion
+ */
+
+// Convert codec samples to Q31
+//  - in is an array of 24-bit samples in 32-bit words (e.g. from WM8731_readSample).
+//  - in and out may be the same array.
+HOT_CODE void DSP_fromCodec(const uint32_t* in, q31_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_s32(&out[n], vreinterpretq_s32_u32(vshlq_n_u32(vld1q_u32(&in[n]), 8)));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = (q31_t)(in[n] << 8);
+    }
+}
+
+// Convert Q31 samples to codec format
+//  - out is an array of 24-bit samples in 32-bit words (e.g. for WM8731_writeSample).
+//  - in and out may be the same array.
+HOT_CODE void DSP_toCodec(const q31_t* in, uint32_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_u32(&out[n], vreinterpretq_u32_s32(vshrq_n_s32(vld1q_s32(&in[n]), 8)));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = (uint32_t)(in[n] >> 8);
+    }
+}
+
+// Convert interleaved stereo codec samples to Q31
+//  - in is an array of count {left, right} pairs (e.g. WM8731Sample_t).
+HOT_CODE void DSP_fromCodecStereo(const uint32_t* in, q31_t* left, q31_t* right, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        uint32x4x2_t pairs = vld2q_u32(&in[2 * n]);
+        vst1q_s32(&left[n],  vreinterpretq_s32_u32(vshlq_n_u32(pairs.val[0], 8)));
+        vst1q_s32(&right[n], vreinterpretq_s32_u32(vshlq_n_u32(pairs.val[1], 8)));
+    }
+#endif
+    for (; n < count; n++) {
+        left[n]  = (q31_t)(in[2 * n]     << 8);
+        right[n] = (q31_t)(in[2 * n + 1] << 8);
+    }
+}
+
+// Convert Q31 samples to interleaved stereo codec format
+//  - out is an array of count {left, right} pairs (e.g. WM8731Sample_t).
+HOT_CODE void DSP_toCodecStereo(const q31_t* left, const q31_t* right, uint32_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        uint32x4x2_t pairs;
+        pairs.val[0] = vreinterpretq_u32_s32(vshrq_n_s32(vld1q_s32(&left[n]),  8));
+        pairs.val[1] = vreinterpretq_u32_s32(vshrq_n_s32(vld1q_s32(&right[n]), 8));
+        vst2q_u32(&out[2 * n], pairs);
+    }
+#endif
+    for (; n < count; n++) {
+        out[2 * n]     = (uint32_t)(left[n]  >> 8);
+        out[2 * n + 1] = (uint32_t)(right[n] >> 8);
+    }
+}
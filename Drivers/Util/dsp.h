@@ -0,0 +1,307 @@
+/*
+ * Block Based Fixed-Point DSP Kernels
+ * -----------------------------------
+ *
+ * Provides block oriented fixed-point signal processing
+ * kernels for audio, intended to be used with blocks of
+ * samples from the WM8731 audio driver.
+ *
+ * Sample Formats
+ * --------------
+ *
+ * Samples are signed fractional values:
+ *   - q15_t is 1.15 format, range [-1, 1)
+ *   - q31_t is 1.31 format, range [-1, 1)
+ *
+ * The WM8731 codec uses 24-bit samples in 32-bit words. To
+ * convert these to/from Q31, use DSP_fromCodec()/DSP_toCodec().
+ * The interleaved variants DSP_fromCodecStereo() and
+ * DSP_toCodecStereo() work directly on arrays of WM8731Sample_t.
+ *
+ * Kernels
+ * -------
+ *
+ *  - FIR filters (Q15 and Q31). Use 64-bit accumulators. The
+ *    sum of the coefficient magnitudes should be less than 1 to
+ *    avoid saturation of the output.
+ *  - Polyphase sample rate conversion (Q31) by a fixed ratio of
+ *    L/M, e.g. 160/147 for 44.1kHz to 48kHz, or 4/1 for 4x
+ *    oversampling. Only the taps of the one phase needed for each
+ *    output are evaluated, rather than filtering the zero-stuffed
+ *    signal at L times the rate.
+ *  - Radix-4 complex FFT (Q31), in place, with a Hann window and
+ *    squared magnitude for spectrum analysis. Each stage scales by
+ *    1/4, so the output is scaled by 1/size and cannot overflow.
+ *  - Biquad IIR cascade (Q31, Direct Form I). Coefficients are
+ *    in 1.31 format scaled down by 2^postShift, allowing
+ *    coefficients in the range [-2^postShift, 2^postShift).
+ *  - Gain and two channel mix (Q15 and Q31) with saturation, and
+ *    scaled accumulate (Q31) for mixing any number of channels.
+ *  - Tone generation using a numerically controlled oscillator
+ *    with an interpolated sine table, replacing a call to sin()
+ *    and a phase wrap for every sample. Several oscillators can
+ *    be summed into one block for simple synthesis.
+ *
+ * NEON
+ * ----
+ *
+ * Where the compiler has NEON enabled (e.g. -mfpu=neon, which
+ * defines __ARM_NEON), the FIR, gain, mix and conversion kernels
+ * are vectorised to process four samples at a time. The resampler
+ * vectorises the taps of each output, four at a time, and the FFT
+ * does four butterflies at a time in all but the last stage. Otherwise a
+ * portable C implementation is used. The NCO generates four
+ * samples at a time, with the table lookups done per lane and the
+ * interpolation vectorised. The biquad is scalar as its recursion
+ * does not map well to SIMD for a single channel.
+ *
+ * NEON requires CP10/CP11 access and the FPU to be enabled, which
+ * is performed by Util/startup_arm.c.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add radix-4 FFT, window and magnitude kernels.
+ * 14/10/2026 | Add polyphase sample rate converter.
+ * 14/10/2026 | Add scaled accumulate for multi-voice mixing.
+ * 14/10/2026 | Add NEON oscillator blocks and multi-voice tone generation.
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef DSP_H_
+#define DSP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Fixed point sample types
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+// Maximum number of outputs from DSP_resampleQ31() for count input samples
+#define DSP_RESAMPLE_MAX_OUT(rs, count) ((((count) * (rs)->interp) + (rs)->decim - 1) / (rs)->decim)
+
+// Number of twiddle factors for an FFT of size points
+#define DSP_FFT_TWIDDLE_SIZE(size) (2 * (size))
+
+// Size of NCO sine table. Must be a power of two.
+#define DSP_SINE_TABLE_BITS 8
+#define DSP_SINE_TABLE_SIZE (1U << DSP_SINE_TABLE_BITS)
+
+// FIR filter instance (Q15)
+//  - state must have space for (numTaps + blockSize - 1) samples
+typedef struct {
+    const q15_t* coeffs;
+    q15_t* state;
+    unsigned int numTaps;
+    unsigned int blockSize;
+} DspFirQ15_t;
+
+// FIR filter instance (Q31)
+//  - state must have space for (numTaps + blockSize - 1) samples
+typedef struct {
+    const q31_t* coeffs;
+    q31_t* state;
+    unsigned int numTaps;
+    unsigned int blockSize;
+} DspFirQ31_t;
+
+// Polyphase resampler instance (Q31)
+//  - coeffs has tapsPerPhase entries for each of the L phases.
+//  - state must have space for (tapsPerPhase + blockSize - 1) samples
+typedef struct {
+    const q31_t* coeffs;
+    q31_t* state;
+    unsigned int tapsPerPhase;
+    unsigned int blockSize;
+    unsigned int interp;        // L
+    unsigned int decim;         // M
+    unsigned int phase;         // Phase of the next output, 0 to L-1
+    unsigned int index;         // Input sample of the next output, relative to the next block
+} DspResampleQ31_t;
+
+// Biquad cascade instance (Q31)
+//  - coeffs has 5 entries per stage: {b0, b1, b2, a1, a2}
+//    where y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2]
+//    (i.e. a1 and a2 are the negated denominator coefficients)
+//  - state has 4 entries per stage: {x[n-1], x[n-2], y[n-1], y[n-2]}
+typedef struct {
+    const q31_t* coeffs;
+    q31_t* state;
+    unsigned int numStages;
+    unsigned int postShift;
+} DspBiquadQ31_t;
+
+// FFT instance (Q31)
+typedef struct {
+    const q31_t* twiddles;
+    unsigned int size;
+} DspFftQ31_t;
+
+// Numerically controlled oscillator
+typedef struct {
+    uint32_t phase;
+    uint32_t phaseInc;
+    q31_t amplitude;
+} DspNco_t;
+
+// Initialise a FIR filter (Q15)
+//  - coeffs is an array of numTaps coefficients, coeffs[0] applies to the newest sample.
+//  - state is an array of (numTaps + blockSize - 1) samples. Will be cleared.
+//  - blockSize is the maximum number of samples processed per call.
+HpsErr_t DSP_firInitQ15(DspFirQ15_t* fir, const q15_t* coeffs, unsigned int numTaps, q15_t* state, unsigned int blockSize);
+
+// Run a FIR filter (Q15)
+//  - Processes count samples from in to out. count must not exceed blockSize.
+//  - in and out may be the same array.
+HpsErr_t DSP_firQ15(DspFirQ15_t* fir, const q15_t* in, q15_t* out, unsigned int count);
+
+// Initialise a FIR filter (Q31)
+//  - coeffs is an array of numTaps coefficients, coeffs[0] applies to the newest sample.
+//  - state is an array of (numTaps + blockSize - 1) samples. Will be cleared.
+//  - blockSize is the maximum number of samples processed per call.
+HpsErr_t DSP_firInitQ31(DspFirQ31_t* fir, const q31_t* coeffs, unsigned int numTaps, q31_t* state, unsigned int blockSize);
+
+// Run a FIR filter (Q31)
+//  - Processes count samples from in to out. count must not exceed blockSize.
+//  - in and out may be the same array.
+HpsErr_t DSP_firQ31(DspFirQ31_t* fir, const q31_t* in, q31_t* out, unsigned int count);
+
+// Design resampler coefficients (Q31)
+//  - Fills coeffs with (interp * tapsPerPhase) coefficients of a Blackman
+//    windowed sinc low-pass filter for a ratio of interp/decim, cutting off
+//    just below the lower of the two Nyquist rates.
+//  - Each phase has a DC gain of 1. More taps per phase give a sharper
+//    cut-off; 16 to 32 is typical for audio.
+//  - Uses floating point, so call once during setup.
+HpsErr_t DSP_resampleDesignQ31(q31_t* coeffs, unsigned int interp, unsigned int decim, unsigned int tapsPerPhase);
+
+// Initialise a resampler (Q31)
+//  - Converts the sample rate by interp/decim (L/M), e.g. 160/147 for 44.1kHz
+//    to 48kHz. The ratio should be in its lowest terms.
+//  - coeffs is (interp * tapsPerPhase) coefficients in polyphase order, as made
+//    by DSP_resampleDesignQ31(). For a prototype filter h[] at interp times the
+//    input rate, coeffs[p * tapsPerPhase + k] = h[(tapsPerPhase - 1 - k) * interp + p].
+//    They may be shared by several resamplers (e.g. left and right).
+//  - state is an array of (tapsPerPhase + blockSize - 1) samples. Will be cleared.
+//  - blockSize is the maximum number of input samples processed per call.
+HpsErr_t DSP_resampleInitQ31(DspResampleQ31_t* rs, const q31_t* coeffs, unsigned int interp, unsigned int decim, unsigned int tapsPerPhase, q31_t* state, unsigned int blockSize);
+
+// Run a resampler (Q31)
+//  - Converts count input samples, which must not exceed blockSize.
+//  - out must have space for DSP_RESAMPLE_MAX_OUT(rs, count) samples.
+//  - Returns the number of output samples written (>= 0). This varies from
+//    call to call when the ratio does not divide count.
+HpsErr_t DSP_resampleQ31(DspResampleQ31_t* rs, const q31_t* in, q31_t* out, unsigned int count);
+
+// Initialise a biquad cascade (Q31)
+//  - coeffs is an array of (5 * numStages) coefficients.
+//  - state is an array of (4 * numStages) values. Will be cleared.
+//  - postShift is the number of bits the coefficients have been scaled down by.
+HpsErr_t DSP_biquadInitQ31(DspBiquadQ31_t* iir, const q31_t* coeffs, unsigned int numStages, q31_t* state, unsigned int postShift);
+
+// Run a biquad cascade (Q31)
+//  - Processes count samples from in to out.
+//  - in and out may be the same array.
+HpsErr_t DSP_biquadQ31(DspBiquadQ31_t* iir, const q31_t* in, q31_t* out, unsigned int count);
+
+// Apply gain (Q15)
+//  - out[n] = in[n] * gain, saturated.
+//  - in and out may be the same array.
+void DSP_gainQ15(const q15_t* in, q15_t* out, q15_t gain, unsigned int count);
+
+// Apply gain (Q31)
+//  - out[n] = in[n] * gain, saturated.
+//  - in and out may be the same array.
+void DSP_gainQ31(const q31_t* in, q31_t* out, q31_t gain, unsigned int count);
+
+// Mix two signals (Q15)
+//  - out[n] = a[n] * gainA + b[n] * gainB, saturated.
+//  - out may be the same array as a or b.
+void DSP_mixQ15(const q15_t* a, q15_t gainA, const q15_t* b, q15_t gainB, q15_t* out, unsigned int count);
+
+// Mix two signals (Q31)
+//  - out[n] = a[n] * gainA + b[n] * gainB, saturated.
+//  - out may be the same array as a or b.
+void DSP_mixQ31(const q31_t* a, q31_t gainA, const q31_t* b, q31_t gainB, q31_t* out, unsigned int count);
+
+// Accumulate a scaled signal (Q31)
+//  - acc[n] = acc[n] + in[n] * gain, saturated.
+//  - For mixing any number of signals into one buffer.
+void DSP_macQ31(const q31_t* in, q31_t gain, q31_t* acc, unsigned int count);
+
+// Initialise a numerically controlled oscillator
+//  - freq is the tone frequency in Hz, and sampleRate the sample rate in Hz.
+//  - amplitude is the peak amplitude (Q31).
+//  - Returns ERR_TOOBIG if freq is not below the Nyquist rate.
+HpsErr_t DSP_ncoInit(DspNco_t* nco, unsigned int freq, unsigned int sampleRate, q31_t amplitude);
+
+// Change the frequency of an oscillator
+//  - Phase is kept, so the tone changes without a discontinuity.
+//  - Returns ERR_TOOBIG if freq is not below the Nyquist rate.
+HpsErr_t DSP_ncoSetFreq(DspNco_t* nco, unsigned int freq, unsigned int sampleRate);
+
+// Generate samples from an oscillator (Q31)
+//  - Writes count samples of the tone to out, continuing from the previous call.
+void DSP_ncoQ31(DspNco_t* nco, q31_t* out, unsigned int count);
+
+// Generate the sum of several oscillators (Q31)
+//  - Writes count samples of the sum of numVoices tones to out, saturated.
+//  - Each voice continues from the previous call.
+void DSP_ncoMixQ31(DspNco_t* voices, unsigned int numVoices, q31_t* out, unsigned int count);
+
+// Initialise an FFT (Q31)
+//  - size is the number of complex points, a power of 4 from 16 to 4096.
+//  - twiddles is an array of DSP_FFT_TWIDDLE_SIZE(size) values, which is
+//    filled in. It may be shared by several FFTs of the same size.
+//  - Uses floating point, so call once during setup.
+HpsErr_t DSP_fftInitQ31(DspFftQ31_t* fft, unsigned int size, q31_t* twiddles);
+
+// Run an FFT (Q31)
+//  - data is an array of size complex values {real, imag}, transformed in place.
+//  - The output is in natural order, scaled by 1/size. Each stage scales by 1/4
+//    before its butterflies, so the transform cannot overflow.
+HpsErr_t DSP_fftQ31(const DspFftQ31_t* fft, q31_t* data);
+
+// Make a Hann window (Q31)
+//  - Fills window with size values, for use with DSP_fftLoadRealQ31().
+//  - Uses floating point, so call once during setup.
+HpsErr_t DSP_windowHannQ31(q31_t* window, unsigned int size);
+
+// Load real samples for an FFT (Q31)
+//  - out[2n] = in[n] * window[n], out[2n+1] = 0, for count samples.
+//  - window may be NULL for a rectangular window.
+void DSP_fftLoadRealQ31(const q31_t* in, const q31_t* window, q31_t* out, unsigned int count);
+
+// Squared magnitude of complex values (Q31)
+//  - out[n] = in[2n]^2 + in[2n+1]^2, saturated, for count values.
+//  - in and out may be the same array.
+void DSP_cmplxMagSqQ31(const q31_t* in, q31_t* out, unsigned int count);
+
+// Convert codec samples to Q31
+//  - in is an array of 24-bit samples in 32-bit words (e.g. from WM8731_readSample).
+//  - in and out may be the same array.
+void DSP_fromCodec(const uint32_t* in, q31_t* out, unsigned int count);
+
+// Convert Q31 samples to codec format
+//  - out is an array of 24-bit samples in 32-bit words (e.g. for WM8731_writeSample).
+//  - in and out may be the same array.
+void DSP_toCodec(const q31_t* in, uint32_t* out, unsigned int count);
+
+// Convert interleaved stereo codec samples to Q31
+//  - in is an array of count {left, right} pairs (e.g. WM8731Sample_t).
+void DSP_fromCodecStereo(const uint32_t* in, q31_t* left, q31_t* right, unsigned int count);
+
+// Convert Q31 samples to interleaved stereo codec format
+//  - out is an array of count {left, right} pairs (e.g. WM8731Sample_t).
+void DSP_toCodecStereo(const q31_t* left, const q31_t* right, uint32_t* out, unsigned int count);
+
+#endif /* DSP_H_ */
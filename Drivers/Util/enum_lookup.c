@@ -6,6 +6,23 @@
  * a macro to define the entries and values. This
  * same macro can then be used to generate a string
  * lookup table for the enum values.
+ *
+ * Indexed Lookups
+ * ---------------
+ *
+ * The plain lookup functions search the table from the start
+ * for every call. Where lookups are made often, e.g. parsing
+ * commands, an index can be generated alongside the table:
+ *
+ *     GENERATE_ENUM_LOOKUP_INDEX_SOURCE(MyEnum, MY_ENUM_LIST);
+ *     ...
+ *     MyEnum val = stringToEnumIndexed(str, &MyEnum_Index, MY_UNKNOWN);
+ *
+ * The index holds the table entries sorted by value, and by a
+ * hash of their string. It is sorted on first use (or by calling
+ * enumLookupIndexBuild() at start-up), after which lookups are a
+ * binary search plus a single strcmp() to confirm a match. If
+ * used from more than one core, build the index before sharing.
  * 
  * Company: University of Leeds
  * Author: T Carpenter
@@ -14,6 +31,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add sorted lookup indexes
  * 30/01/2024 | Adapt for embedded code from DLL
  * 30/01/2018 | Creation of utility
  *
@@ -73,3 +91,106 @@ size_t stringToEnum(const char* str, const EnumLookupTable_t* lookupTable, size_
     return notFoundValue;
 }
 #endif
+
+#ifndef enumLookupIndexBuild
+
+// FNV-1a hash of a string
+static uint32_t _enumLookupHash(const char* str) {
+    uint32_t hash = 2166136261U;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+void enumLookupIndexBuild(EnumLookupIndex_t* index) {
+    const EnumLookupTable_t* table = index->lookupTable;
+    size_t length = index->lookupTableLength;
+    //Insertion sort both orders. Only done once, and tables are short.
+    for (size_t idx = 0; idx < length; idx++) {
+        size_t enumVal = table[idx].enumVal;
+        uint32_t hash = _enumLookupHash(table[idx].str);
+        size_t pos = idx;
+        while (pos && (table[index->byValue[pos - 1]].enumVal > enumVal)) {
+            index->byValue[pos] = index->byValue[pos - 1];
+            pos--;
+        }
+        index->byValue[pos] = (uint16_t)idx;
+        pos = idx;
+        while (pos && (index->hashes[pos - 1] > hash)) {
+            index->byString[pos] = index->byString[pos - 1];
+            index->hashes[pos] = index->hashes[pos - 1];
+            pos--;
+        }
+        index->byString[pos] = (uint16_t)idx;
+        index->hashes[pos] = hash;
+    }
+    index->built = true;
+}
+#endif
+
+#ifndef enumToStringIndexed
+const char* enumToStringIndexed(size_t enumVal, EnumLookupIndex_t* index) {
+    if (!index->built) enumLookupIndexBuild(index);
+    const EnumLookupTable_t* table = index->lookupTable;
+    //Find the first entry with the value. The sort is stable, so for
+    //duplicate values this matches the first in the table, as enumToString().
+    size_t lo = 0;
+    size_t hi = index->lookupTableLength;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (table[index->byValue[mid]].enumVal < enumVal) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < index->lookupTableLength) {
+        const EnumLookupTable_t* entry = &table[index->byValue[lo]];
+        if (entry->enumVal == enumVal) {
+            DLLDbgPrintEx("Matched enumVal %d to string %s\n", enumVal, entry->str);
+            return entry->str;
+        }
+    }
+    DLLDbgPrintEx("Could not match enumVal %d to string.\n",enumVal);
+    return NULL;
+}
+#endif
+
+#ifndef enumToStringSafeIndexed
+const char* enumToStringSafeIndexed(size_t enumVal, EnumLookupIndex_t* index) {
+    const char* str = enumToStringIndexed(enumVal, index);
+    if (!str) return UNKNOWN_STR;
+    return str;
+}
+#endif
+
+#ifndef stringToEnumIndexed
+size_t stringToEnumIndexed(const char* str, EnumLookupIndex_t* index, size_t notFoundValue) {
+    if (!index->built) enumLookupIndexBuild(index);
+    const EnumLookupTable_t* table = index->lookupTable;
+    uint32_t hash = _enumLookupHash(str);
+    //Find the first entry with a matching hash
+    size_t lo = 0;
+    size_t hi = index->lookupTableLength;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (index->hashes[mid] < hash) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    //Then confirm the string, in case of a collision
+    for (; (lo < index->lookupTableLength) && (index->hashes[lo] == hash); lo++) {
+        const EnumLookupTable_t* entry = &table[index->byString[lo]];
+        if (!strcmp(str, entry->str)) {
+            DLLDbgPrintEx("Matched string %s to enumVal %d\n", str, entry->enumVal);
+            return entry->enumVal;
+        }
+    }
+    DLLDbgPrintEx("Could not match string %s to enumVal. Using notFoundValue of %d\n", str, notFoundValue);
+    return notFoundValue;
+}
+#endif
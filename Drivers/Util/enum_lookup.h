@@ -6,6 +6,23 @@
  * a macro to define the entries and values. This
  * same macro can then be used to generate a string
  * lookup table for the enum values.
+ *
+ * Indexed Lookups
+ * ---------------
+ *
+ * The plain lookup functions search the table from the start
+ * for every call. Where lookups are made often, e.g. parsing
+ * commands, an index can be generated alongside the table:
+ *
+ *     GENERATE_ENUM_LOOKUP_INDEX_SOURCE(MyEnum, MY_ENUM_LIST);
+ *     ...
+ *     MyEnum val = stringToEnumIndexed(str, &MyEnum_Index, MY_UNKNOWN);
+ *
+ * The index holds the table entries sorted by value, and by a
+ * hash of their string. It is sorted on first use (or by calling
+ * enumLookupIndexBuild() at start-up), after which lookups are a
+ * binary search plus a single strcmp() to confirm a match. If
+ * used from more than one core, build the index before sharing.
  * 
  * Company: University of Leeds
  * Author: T Carpenter
@@ -14,6 +31,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add sorted lookup indexes
  * 30/01/2024 | Adapt for embedded code from DLL
  * 30/01/2018 | Creation of utility
  *
@@ -29,6 +47,7 @@
  //Include standard libraries
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 #include <string.h>
 #elif defined(__NIOS2__) || defined(__AVR__)
  //For Nios/Arm HPS/AVR, include the UsefulDefines.h header which has everything we need.
@@ -46,6 +65,7 @@ extern "C" {
 #define   GENERATE_ENUM(PFX,NAME,SFX,VAL)   PFX ##  NAME ##  SFX VAL,
 #define GENERATE_STRING(PFX,NAME,SFX,...)  #PFX    #NAME    #SFX,
 #define GENERATE_LOOKUP(PFX,NAME,SFX,...) {#PFX    #NAME    #SFX, (size_t) PFX ## NAME ## SFX},
+#define   GENERATE_COUNT(PFX,NAME,SFX,...)  +1
 
 #define UNKNOWN_STR "???"
 
@@ -54,6 +74,15 @@ typedef struct {
     size_t      enumVal;
 } EnumLookupTable_t;
 
+typedef struct {
+    const EnumLookupTable_t* lookupTable;
+    size_t                   lookupTableLength;
+    uint16_t*                byValue;   // Table indices sorted by enumVal
+    uint16_t*                byString;  // Table indices sorted by hash
+    uint32_t*                hashes;    // Hash of each byString entry
+    volatile bool            built;
+} EnumLookupIndex_t;
+
 #if defined(ENUM_LOOKUP_ENABLED) || defined(PCIEUARPLIBSYNC_EXPORTS)
 
 //Convert an enum to string.
@@ -68,6 +97,22 @@ const char* enumToStringSafe(size_t enumVal, const EnumLookupTable_t* lookupTabl
 // - Returns `notFoundVal` if not found.
 size_t stringToEnum(const char* str, const EnumLookupTable_t* lookupTable, size_t lookupTableLength, size_t notFoundValue);
 
+//Sort a lookup index
+// - Called automatically by the indexed lookups if not yet built.
+void enumLookupIndexBuild(EnumLookupIndex_t* index);
+
+//Convert an enum to string using a lookup index.
+// - Returns NULL if not found
+const char* enumToStringIndexed(size_t enumVal, EnumLookupIndex_t* index);
+
+//Convert an enum to string using a lookup index.
+// - Retruns `UNKNWONW_STR` if not found
+const char* enumToStringSafeIndexed(size_t enumVal, EnumLookupIndex_t* index);
+
+//Convert a string to an enum value using a lookup index
+// - Returns `notFoundVal` if not found.
+size_t stringToEnumIndexed(const char* str, EnumLookupIndex_t* index, size_t notFoundValue);
+
 //Pass this to above functions to provide arguments 2 and 3 for a given enum type.
 #define EnumLookupTableAndSize(enumType) enumType##_Lookup, enumType##_Lookup_Length
 
@@ -83,14 +128,39 @@ const EnumLookupTable_t enumType##_Lookup [] = {  \
 };                                        \
 const size_t enumType##_Lookup_Length = sizeof(enumType##_Lookup) / sizeof(EnumLookupTable_t)
 
+// Generate lookup index header file
+#define GENERATE_ENUM_LOOKUP_INDEX_HEADER(enumType, lookupMacro) \
+extern EnumLookupIndex_t enumType##_Index
+
+// Generate lookup index source file
+#define GENERATE_ENUM_LOOKUP_INDEX_SOURCE(enumType, lookupMacro) \
+static uint16_t enumType##_Index_byValue  [0 lookupMacro(GENERATE_COUNT,enumType)]; \
+static uint16_t enumType##_Index_byString [0 lookupMacro(GENERATE_COUNT,enumType)]; \
+static uint32_t enumType##_Index_hashes   [0 lookupMacro(GENERATE_COUNT,enumType)]; \
+EnumLookupIndex_t enumType##_Index = {           \
+    enumType##_Lookup,                           \
+    0 lookupMacro(GENERATE_COUNT,enumType),      \
+    enumType##_Index_byValue,                    \
+    enumType##_Index_byString,                   \
+    enumType##_Index_hashes,                     \
+    false                                        \
+}
+
 #else
 // Otherwise don't generate the lookups if not needed.
 #define enumToString(...)     (NULL)
 #define enumToStringSafe(...) UNKNOWN_STR
 #define stringToEnum(...)     (-1)
 
+#define enumLookupIndexBuild(...)
+#define enumToStringIndexed(...)     (NULL)
+#define enumToStringSafeIndexed(...) UNKNOWN_STR
+#define stringToEnumIndexed(...)     (-1)
+
 #define GENERATE_ENUM_LOOKUP_TABLE_HEADER(...)
 #define GENERATE_ENUM_LOOKUP_TABLE_SOURCE(...)
+#define GENERATE_ENUM_LOOKUP_INDEX_HEADER(...)
+#define GENERATE_ENUM_LOOKUP_INDEX_SOURCE(...)
 
 #endif
 
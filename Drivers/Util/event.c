@@ -30,6 +30,69 @@
  * Manual events are requeued only if the call to Event_checkState
  * requests it.
  * 
+ * Registered events are stored in a pool preallocated when the
+ * event manager is initialised, and scheduled using a min-heap
+ * ordered by deadline. Event_process only touches events which
+ * are due, so the cost of polling does not grow with the number
+ * of registered events.
+ * 
+ * Tickless Mode
+ * -------------
+ * Rather than calling Event_process in a busy loop, a second timer
+ * (the "alarm") can be attached with EventMgr_setTickless. The main
+ * loop then calls Event_sleep before each Event_process:
+ * 
+ *     while (1) {
+ *         Event_sleep(evtMgr);
+ *         Event_process(evtMgr);
+ *     }
+ * 
+ * Event_sleep programs the alarm as a one-shot for the next event
+ * deadline and sleeps the processor (WFI) until the alarm or any
+ * other interrupt fires. The alarm rate must match the event timer.
+ * Tickless mode is currently supported on the HPS (HPS_IRQ) only.
+ * 
+ * If an idle context (Util/idle.h) is attached with EventMgr_setIdle,
+ * Event_sleep sleeps through it, so time asleep and the sources which
+ * wake the core are recorded.
+ * 
+ * Event Groups
+ * ------------
+ * Registered events can be placed in up to 32 groups using
+ * Event_setGroups. EventMgr_groupState then applies the same control
+ * operation to every event in a set of groups in one go:
+ * 
+ *     Event_setGroups(ledEvt,  EVENT_GROUP(MODE_RUN));
+ *     Event_setGroups(pollEvt, EVENT_GROUP(MODE_RUN));
+ *     ...
+ *     EventMgr_groupState(evtMgr, EVENT_GROUP(MODE_RUN), EVENT_CNTRL_RESTART, EVENT_INTERVAL_UNCHANGED);
+ * 
+ * The timer is read once, so restarted events share a time base and
+ * stay in phase with each other, and the schedule is rebuilt once
+ * rather than per event.
+ * 
+ * Scheduling Metrics
+ * ------------------
+ * EventMgr_setMetrics enables measurement of how well registered
+ * events with handlers keep to their schedule. For each event the
+ * manager records how late the handler started compared with the
+ * deadline, how long the handler took, and how many periods were
+ * missed (the handler started after the next deadline had already
+ * passed). All times are in event timer cycles. Use Event_getStats
+ * to read them.
+ * 
+ * An overrun handler can also be set with EventMgr_setOverrunHandler,
+ * which is called whenever a period is missed or a handler runs for
+ * longer than its own interval. Metrics add two timer reads to each
+ * handled event, so are disabled by default.
+ * 
+ * Deferred Work
+ * -------------
+ * A work queue (Util/work.h) can be attached to the event manager
+ * using EventMgr_setWorkQueue. Any work items posted by interrupt
+ * handlers will then be run by Event_process before checking the
+ * registered events.
+ * 
  *
  * Company: University of Leeds
  * Author: T Carpenter
@@ -38,18 +101,53 @@
  *
  * Date       | Changes
  * -----------+----------------------------------------
+ * 14/10/2026 | Add per core inboxes for cross-core posting
+ * 14/10/2026 | Add idle accounting for tickless sleep
+ * 14/10/2026 | Add deadline miss detection and scheduling metrics
+ * 14/10/2026 | Add event groups with batched control
+ * 14/10/2026 | Track free pool entries with a bitmap
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Add tickless interrupt driven mode
+ * 14/10/2026 | Use a deadline min-heap and preallocated event pool
+ * 14/10/2026 | Add option to drain a deferred work queue
  * 09/03/2024 | Split out event handling from HPS Timer
  *
  */
 
 
 #include "event.h"
+#include "Util/mem_pool.h"
+#include "Util/bit_helpers.h"
+
+#include "Util/irq.h"
+#include "Util/lowlevel_arm.h"
+#include "Util/smp.h"
 
 
 /*
  * Internal Functions
  */
 
+// Record scheduling metrics for a handler run
+//  - late and exec are in timer cycles.
+static void _Event_recordRun(Event_t* evt, unsigned int late, unsigned int exec, unsigned int interval) {
+    EventMgrCtx_t* mgr = evt->evtMgrCtx;
+    EventStats_t* stats = &evt->stats;
+    // A run is a miss if it started after the following deadline
+    bool missed = (late >= interval);
+    if (mgr->metrics) {
+        stats->runs++;
+        if (missed) stats->missed++;
+        if (late > stats->lateMax) stats->lateMax = late;
+        stats->lateTotal += late;
+        if (exec > stats->execMax) stats->execMax = exec;
+        stats->execTotal += exec;
+    }
+    if (mgr->overrun && (missed || (exec > interval))) {
+        mgr->overrun(evt, late, exec, mgr->overrunParam);
+    }
+}
+
 // Check if the task has reached its interval
 //  - If so, update its state and call any handler
 //  - Event must be validated before calling this.
@@ -64,8 +162,22 @@ static void _Event_checkOccured(Event_t* evt, unsigned int curTime) {
         if (evt->type != EVENT_TYPE_MANUAL) {
             // Call handler if there is one
             if (evt->handler) {
+                // Time the handler if measuring metrics
+                EventMgrCtx_t* mgr = evt->evtMgrCtx;
+                bool measure = mgr && (mgr->metrics || mgr->overrun);
+                unsigned int interval = evt->interval;
+                unsigned int start = curTime;
+                if (measure) Timer_getTime(evt->timerCtx, &start);
+                // Counter is going down, so lateness is the time since the last
+                // run beyond the interval.
+                unsigned int late = (evt->lastTime - start) - interval;
                 // Call the handler and check if we should repeat
                 HpsErr_t evtStatus = evt->handler(evt, evt->param);
+                if (measure) {
+                    unsigned int end = start;
+                    Timer_getTime(evt->timerCtx, &end);
+                    _Event_recordRun(evt, late, start - end, interval);
+                }
                 if (evtStatus == ERR_AGAIN) {
                     // Handler requested task repeat. Set to pending an update type
                     evt->state = EVENT_STATE_PENDING;
@@ -90,22 +202,177 @@ static void _Event_checkOccured(Event_t* evt, unsigned int curTime) {
     }
 }
 
+// Check if event should be scheduled in the heap
+static bool _EventMgr_isScheduled(Event_t* evt) {
+    return !EVENT_STATE_ISDISABLED(evt->state) && (evt->type != EVENT_TYPE_DISABLED) && (evt->type != EVENT_TYPE_MANUAL);
+}
+
+// Check if event a is due before event b
+//  - Timer counts down, so the deadline is the last time minus the interval,
+//    and later deadlines have lower counter values.
+static bool _EventMgr_isEarlier(Event_t* a, Event_t* b) {
+    unsigned int deadlineA = a->lastTime - a->interval;
+    unsigned int deadlineB = b->lastTime - b->interval;
+    return (int)(deadlineA - deadlineB) > 0;
+}
+
+// Place an event at a heap position
+static inline void _EventMgr_heapSet(EventMgrCtx_t* ctx, unsigned int idx, Event_t* evt) {
+    ctx->heap[idx] = evt;
+    evt->heapIdx = idx;
+}
+
+// Move heap entry up until it is after its parent
+static void _EventMgr_siftUp(EventMgrCtx_t* ctx, unsigned int idx) {
+    Event_t* evt = ctx->heap[idx];
+    while (idx > 0) {
+        unsigned int parent = (idx - 1) / 2;
+        if (!_EventMgr_isEarlier(evt, ctx->heap[parent])) break;
+        _EventMgr_heapSet(ctx, idx, ctx->heap[parent]);
+        idx = parent;
+    }
+    _EventMgr_heapSet(ctx, idx, evt);
+}
+
+// Move heap entry down until it is before its children
+static void _EventMgr_siftDown(EventMgrCtx_t* ctx, unsigned int idx) {
+    Event_t* evt = ctx->heap[idx];
+    while (true) {
+        unsigned int child = 2 * idx + 1;
+        if (child >= ctx->heapCount) break;
+        if (((child + 1) < ctx->heapCount) && _EventMgr_isEarlier(ctx->heap[child + 1], ctx->heap[child])) {
+            child++;
+        }
+        if (!_EventMgr_isEarlier(ctx->heap[child], evt)) break;
+        _EventMgr_heapSet(ctx, idx, ctx->heap[child]);
+        idx = child;
+    }
+    _EventMgr_heapSet(ctx, idx, evt);
+}
+
+// Remove an event from the heap if present
+static void _EventMgr_heapRemove(EventMgrCtx_t* ctx, Event_t* evt) {
+    unsigned int idx = evt->heapIdx;
+    if ((idx >= ctx->heapCount) || (ctx->heap[idx] != evt)) return;
+    evt->heapIdx = EVENT_HEAP_NONE;
+    // Move the last entry into the gap, then restore heap order
+    ctx->heapCount--;
+    if (idx == ctx->heapCount) return;
+    _EventMgr_heapSet(ctx, idx, ctx->heap[ctx->heapCount]);
+    // The moved entry may need to go either way
+    Event_t* moved = ctx->heap[idx];
+    _EventMgr_siftDown(ctx, idx);
+    _EventMgr_siftUp(ctx, moved->heapIdx);
+}
+
+// Update position of a registered event in the heap
+//  - Call after anything which changes the state, type, interval or last time of an event.
+static void _EventMgr_reschedule(Event_t* evt) {
+    EventMgrCtx_t* ctx = evt->evtMgrCtx;
+    if (!ctx || !ctx->heap) return;
+    _EventMgr_heapRemove(ctx, evt);
+    if (_EventMgr_isScheduled(evt) && (ctx->heapCount < ctx->size)) {
+        _EventMgr_heapSet(ctx, ctx->heapCount, evt);
+        ctx->heapCount++;
+        _EventMgr_siftUp(ctx, evt->heapIdx);
+    }
+}
+
+// Rebuild the heap from all scheduled events in the pool
+//  - Cheaper than rescheduling events one by one when many have changed.
+static void _EventMgr_rebuildHeap(EventMgrCtx_t* ctx) {
+    ctx->heapCount = 0;
+    for (unsigned int poolIdx = 0; poolIdx < ctx->size; poolIdx++) {
+        Event_t* evt = &ctx->pool[poolIdx];
+        evt->heapIdx = EVENT_HEAP_NONE;
+        if (EVENT_STATE_ISINVALID(evt->state) || !_EventMgr_isScheduled(evt)) continue;
+        _EventMgr_heapSet(ctx, ctx->heapCount, evt);
+        ctx->heapCount++;
+    }
+    // Then heapify from the last parent upwards
+    for (unsigned int idx = ctx->heapCount / 2; idx > 0; idx--) {
+        _EventMgr_siftDown(ctx, idx - 1);
+    }
+}
+
+#if defined(__arm__)
+// Tickless mode alarm handler
+//  - Clears the alarm flag, and marks that it fired. Event_process does the rest.
+static void __irq _EventMgr_alarmIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    EventMgrCtx_t* ctx = (EventMgrCtx_t*)param;
+    if (!ctx) return;
+    Timer_checkOverflow(ctx->alarm, true);
+    ctx->alarmFired = true;
+    *handled = true;
+}
+#endif
+
+#if defined(__arm__)
+// Cross-core doorbell handler
+//  - Only needs to wake the core. Event_process runs the posted work.
+static void __irq _EventMgr_doorbellIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    *handled = true;
+}
+#endif
+
+// Run posted event controls
+//  - param is the event, and arg the interval.
+static void _EventMgr_postCancel(void* param, unsigned int arg) {
+    Event_state((Event_t*)param, EVENT_CNTRL_CANCEL, arg);
+}
+static void _EventMgr_postEnqueue(void* param, unsigned int arg) {
+    Event_state((Event_t*)param, EVENT_CNTRL_ENQUEUE, arg);
+}
+static void _EventMgr_postRestart(void* param, unsigned int arg) {
+    Event_state((Event_t*)param, EVENT_CNTRL_RESTART, arg);
+}
+
+// Disable tickless mode alarm if enabled
+static void _EventMgr_stopAlarm(EventMgrCtx_t* ctx) {
+    if (!ctx->alarm) return;
+    Timer_disable(ctx->alarm);
+#if defined(__arm__)
+    HPS_IRQ_unregisterHandler((HPSIRQSource)ctx->alarmIrq);
+#endif
+    ctx->alarm = NULL;
+}
+
 static void _EventMgr_cleanup(EventMgrCtx_t* ctx) {
+    //Stop the tickless alarm
+    _EventMgr_stopAlarm(ctx);
+    //Stop cross-core posting
+    if (ctx->inbox) {
+#if defined(__arm__)
+        if (ctx->inboxSgi != EVENTMGR_DOORBELL_NONE) {
+            HPS_IRQ_unregisterHandler((HPSIRQSource)ctx->inboxSgi);
+        }
+#endif
+        DriverContextFree(&ctx->inbox);
+    }
     //Clean up any event handler contexts
-    if (ctx->events) {
-        //Loop through the table deleting any valid entries
-        for (unsigned int tableIdx = 0; tableIdx < ctx->count; tableIdx++) {
-            Event_t* evt = ctx->events[tableIdx];
-            if (evt) {
-                evt->state = EVENT_STATE_INVALID;
-                free(evt);
-            }
+    if (ctx->pool) {
+        //Mark all events as invalid in case anyone still has a pointer to them
+        for (unsigned int poolIdx = 0; poolIdx < ctx->size; poolIdx++) {
+            ctx->pool[poolIdx].state = EVENT_STATE_INVALID;
         }
-        //And then delete the table.
-        free(ctx->events);
-        ctx->count = 0;
-        ctx->events = NULL;
+        //And then delete the pool.
+        MemPool_free(ctx->pool);
+        ctx->pool = NULL;
     }
+    if (ctx->poolUsed) {
+        MemPool_free(ctx->poolUsed);
+        ctx->poolUsed = NULL;
+    }
+    if (ctx->heap) {
+        MemPool_free(ctx->heap);
+        ctx->heap = NULL;
+    }
+    if (ctx->due) {
+        MemPool_free(ctx->due);
+        ctx->due = NULL;
+    }
+    ctx->size = 0;
+    ctx->heapCount = 0;
 }
 
 /*
@@ -118,9 +385,17 @@ static void _EventMgr_cleanup(EventMgrCtx_t* ctx) {
 //    Can use Manual events without a manager.
 //  - timer is a pointer to the timer to use.
 //    - Must be configured in event mode.
+//  - Space for EVENTMGR_DEFAULT_EVENTS registered events is preallocated.
 //  - Returns Util/error Code
 //  - Returns context pointer to *ctx
 HpsErr_t EventMgr_initialise(TimerCtx_t* timer, EventMgrCtx_t** pCtx) {
+    return EventMgr_initialiseSized(timer, EVENTMGR_DEFAULT_EVENTS, pCtx);
+}
+
+// Initialise Event Manager with a given pool size
+//  - Same as EventMgr_initialise, but with space for maxEvents registered events.
+HpsErr_t EventMgr_initialiseSized(TimerCtx_t* timer, unsigned int maxEvents, EventMgrCtx_t** pCtx) {
+    if (!maxEvents) return ERR_TOOSMALL;
     //Ensure timer is valid
     TimerMode mode;
     HpsErr_t status = Timer_getMode(timer, &mode);
@@ -132,6 +407,14 @@ HpsErr_t EventMgr_initialise(TimerCtx_t* timer, EventMgrCtx_t** pCtx) {
     //Save context values
     EventMgrCtx_t* ctx = *pCtx;
     ctx->timer = timer;
+    //Allocate the event pool. All entries start invalid (zeroed).
+    ctx->pool = (Event_t*)MemPool_calloc(maxEvents, sizeof(*ctx->pool));
+    ctx->heap = (Event_t**)MemPool_malloc(maxEvents * sizeof(*ctx->heap));
+    ctx->due  = (Event_t**)MemPool_malloc(maxEvents * sizeof(*ctx->due));
+    ctx->poolUsed = (unsigned int*)MemPool_calloc(BITMAP_WORDS(maxEvents), sizeof(*ctx->poolUsed));
+    if (!ctx->pool || !ctx->heap || !ctx->due || !ctx->poolUsed) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->size = maxEvents;
+    ctx->heapCount = 0;
     //Now initialised
     DriverContextSetInit(ctx);
     return ERR_SUCCESS;
@@ -142,15 +425,248 @@ bool EventMgr_isInitialised(EventMgrCtx_t* ctx) {
     return DriverContextCheckInit(ctx);
 }
 
+// Attach a deferred work queue
+//  - Pending work items in the queue will be run by Event_process.
+//  - Pass NULL to detach the queue.
+HpsErr_t EventMgr_setWorkQueue(EventMgrCtx_t* ctx, WorkQueueCtx_t* work) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Ensure work queue is valid if provided
+    if (work && !WorkQueue_isInitialised(work)) return ERR_BADDEVICE;
+    ctx->work = work;
+    return ERR_SUCCESS;
+}
+
+// Enable cross-core posting
+//  - Must be called on the core which runs this manager's Event_process.
+//  - queueLength is the most posts which can be pending. Must be a power
+//    of two, at least 2.
+//  - sgiID is a software interrupt (IRQ_SGI_0 to IRQ_SGI_15) to send to
+//    this core on each post from another core, so that Event_sleep wakes.
+//    A handler is registered on the calling core. Each manager must have
+//    its own ID. Pass EVENTMGR_DOORBELL_NONE if only polling.
+//  - Returns ERR_INUSE if an inbox is already enabled.
+HpsErr_t EventMgr_setInbox(EventMgrCtx_t* ctx, unsigned int queueLength, unsigned int sgiID) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->inbox) return ERR_INUSE;
+#if defined(__arm__)
+    if ((sgiID != EVENTMGR_DOORBELL_NONE) && (sgiID >= HPS_IRQ_SGI_COUNT)) return ERR_BEYONDEND;
+    ctx->inboxCpu = SMP_getCpuId();
+#else
+    if (sgiID != EVENTMGR_DOORBELL_NONE) return ERR_NOSUPPORT;
+    ctx->inboxCpu = 0;
+#endif
+    WorkQueueCtx_t* inbox;
+    status = WorkQueue_initialise(queueLength, &inbox);
+    if (ERR_IS_ERROR(status)) return status;
+#if defined(__arm__)
+    if (sgiID != EVENTMGR_DOORBELL_NONE) {
+        status = HPS_IRQ_registerHandler((HPSIRQSource)sgiID, &_EventMgr_doorbellIsr, ctx);
+        if (ERR_IS_ERROR(status)) {
+            DriverContextFree(&inbox);
+            return status;
+        }
+    }
+#endif
+    ctx->inboxSgi = sgiID;
+    //Publish the inbox last, so posts only see it once ready
+    __DMB();
+    ctx->inbox = inbox;
+    return ERR_SUCCESS;
+}
+
+// Post a callback to an event manager
+//  - func(param, arg) is run by the next Event_process of ctx, on its own core.
+//  - May be called from any core or context, including interrupt handlers.
+//  - Returns ERR_WRONGMODE if no inbox is enabled.
+//  - Returns ERR_NOSPACE if the inbox is full.
+HpsErr_t EventMgr_post(EventMgrCtx_t* ctx, WorkFunc_t func, void* param, unsigned int arg) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    WorkQueueCtx_t* inbox = ctx->inbox;
+    if (!inbox) return ERR_WRONGMODE;
+    status = Work_post(inbox, func, param, arg);
+    if (ERR_IS_ERROR(status)) return status;
+#if defined(__arm__)
+    //Ring the doorbell if the owner is another core. Work_post has already
+    //published the item, and the send issues a barrier first.
+    if ((ctx->inboxSgi != EVENTMGR_DOORBELL_NONE) && (SMP_getCpuId() != ctx->inboxCpu)) {
+        HPS_IRQ_sendSoftware((HPSIRQSource)ctx->inboxSgi, 1U << ctx->inboxCpu);
+    }
+#endif
+    return ERR_SUCCESS;
+}
+
+// Post a control operation to a registered event
+//  - As Event_state(evt, op, interval), but performed by the next
+//    Event_process of the manager which owns evt, on its own core.
+//  - op must not be EVENT_CNTRL_CHECK, as the result is not returned.
+//  - Otherwise as EventMgr_post.
+HpsErr_t Event_post(Event_t* evt, EventControl op, unsigned int interval) {
+    if (!Event_validate(evt)) return ERR_BADID;
+    if (evt->type == EVENT_TYPE_MANUAL) return ERR_WRONGMODE;
+    switch (op) {
+        case EVENT_CNTRL_CANCEL:  return EventMgr_post(evt->evtMgrCtx, &_EventMgr_postCancel,  evt, interval);
+        case EVENT_CNTRL_ENQUEUE: return EventMgr_post(evt->evtMgrCtx, &_EventMgr_postEnqueue, evt, interval);
+        case EVENT_CNTRL_RESTART: return EventMgr_post(evt->evtMgrCtx, &_EventMgr_postRestart, evt, interval);
+        default:                  return ERR_NOSUPPORT;
+    }
+}
+
+// Enable tickless mode
+//  - alarm is a timer to be used in one-shot mode for the next event deadline.
+//    Pass NULL to disable tickless mode.
+//  - prescaler is the value to configure the alarm with. The resulting rate
+//    must match that of the event timer.
+//  - irqID is the interrupt ID of the alarm timer. A handler will be registered.
+//  - Returns ERR_MISMATCH if the alarm and event timer rates are different.
+//  - Returns ERR_NOSUPPORT if not running on the HPS.
+HpsErr_t EventMgr_setTickless(EventMgrCtx_t* ctx, TimerCtx_t* alarm, unsigned int prescaler, unsigned int irqID) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Stop any existing alarm
+    _EventMgr_stopAlarm(ctx);
+    if (!alarm) return ERR_SUCCESS;
+#if defined(__arm__)
+    if (alarm == ctx->timer) return ERR_INUSE;
+    //Ensure the alarm ticks at the same rate as the event timer
+    unsigned int eventRate, alarmRate;
+    status = Timer_getRate(ctx->timer, UINT32_MAX, &eventRate);
+    if (ERR_IS_ERROR(status)) return status;
+    status = Timer_getRate(alarm, prescaler, &alarmRate);
+    if (ERR_IS_ERROR(status)) return status;
+    if (eventRate != alarmRate) return ERR_MISMATCH;
+    //Start with the alarm stopped
+    status = Timer_configure(alarm, TIMER_MODE_ONESHOT, prescaler, UINT32_MAX);
+    if (ERR_IS_ERROR(status)) return status;
+    Timer_checkOverflow(alarm, true);
+    //Register the alarm interrupt
+    ctx->alarmFired = false;
+    status = HPS_IRQ_registerHandler((HPSIRQSource)irqID, &_EventMgr_alarmIsr, ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->alarm = alarm;
+    ctx->alarmPrescaler = prescaler;
+    ctx->alarmIrq = irqID;
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Enable scheduling metrics
+//  - When enabled, Event_process measures the lateness and execution time of
+//    each registered event handler. See notes at top of file.
+HpsErr_t EventMgr_setMetrics(EventMgrCtx_t* ctx, bool enable) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->metrics = enable;
+    return ERR_SUCCESS;
+}
+
+// Set the overrun handler
+//  - handler is called when a registered event misses a period or its handler
+//    runs for longer than its interval. Pass NULL to remove.
+//  - Lateness is measured while a handler is set, even if metrics are disabled.
+HpsErr_t EventMgr_setOverrunHandler(EventMgrCtx_t* ctx, EventOverrunFunc_t handler, void* param) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->overrun = handler;
+    ctx->overrunParam = param;
+    return ERR_SUCCESS;
+}
+
+// Attach idle accounting
+//  - Event_sleep will sleep using Idle_wfi, recording idle time and wake sources.
+//  - Pass NULL to detach.
+HpsErr_t EventMgr_setIdle(EventMgrCtx_t* ctx, IdleCtx_t* idle) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Ensure idle context is valid if provided
+    if (idle && !Idle_isInitialised(idle)) return ERR_BADDEVICE;
+    ctx->idle = idle;
+    return ERR_SUCCESS;
+}
+
+// Sleep until the next event is due
+//  - Requires tickless mode to be enabled.
+//  - Programs the alarm for the next event deadline, then waits for
+//    an interrupt. Returns immediately if an event is already due or
+//    deferred work is pending.
+//  - Will also return early on any other interrupt, so call Event_process
+//    after this returns.
+HpsErr_t Event_sleep(EventMgrCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->alarm) return ERR_WRONGMODE;
+#if defined(__arm__)
+    //Stop the previous alarm
+    Timer_disable(ctx->alarm);
+    ctx->alarmFired = false;
+    //Find the time to the next deadline, if there is one.
+    if (ctx->heapCount) {
+        unsigned int curTime;
+        status = Timer_getTime(ctx->timer, &curTime);
+        if (ERR_IS_ERROR(status)) return status;
+        Event_t* evt = ctx->heap[0];
+        unsigned int elapsed = evt->lastTime - curTime;
+        //Already due, so don't sleep
+        if (elapsed >= evt->interval) return ERR_SUCCESS;
+        //Program alarm as one-shot for the remaining time
+        status = Timer_configure(ctx->alarm, TIMER_MODE_ONESHOT, ctx->alarmPrescaler, evt->interval - elapsed);
+        if (ERR_IS_ERROR(status)) return status;
+        status = Timer_enable(ctx->alarm, 0);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    //Mask IRQs while checking if we can sleep, so that an interrupt arriving
+    //between the check and WFI still wakes us. WFI wakes even with IRQs masked,
+    //and the handler runs once we unmask.
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    bool workPending = (ctx->work && (ctx->work->head != ctx->work->tail)) ||
+                       (ctx->inbox && (ctx->inbox->head != ctx->inbox->tail));
+    if (!ctx->alarmFired && !workPending) {
+        if (ctx->idle) {
+            Idle_wfi(ctx->idle);
+        } else {
+            __WFI();
+        }
+    }
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
 // Registered event polling function
 //  - If using registered events (CreateEvent), this is the processing
 //    function which handles callbacks for those events.
 //  - Must call this function repeatedly in the main loop to keep checking
 //    if any event has occurred
+//  - Runs any pending deferred work if a work queue is attached.
+//  - Then runs anything posted to the inbox by EventMgr_post or Event_post.
 HpsErr_t Event_process(EventMgrCtx_t* ctx) {
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
+    //Run any deferred work first
+    if (ctx->work) {
+        status = Work_process(ctx->work);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    //Then anything posted from other cores
+    if (ctx->inbox) {
+        status = Work_process(ctx->inbox);
+        if (ERR_IS_ERROR(status)) return status;
+    }
     //Ensure timer is in correct mode
     TimerMode mode;
     status = Timer_getMode(ctx->timer, &mode);
@@ -160,18 +676,30 @@ HpsErr_t Event_process(EventMgrCtx_t* ctx) {
     unsigned int curTime;
     status = Timer_getTime(ctx->timer, &curTime);
     if (ERR_IS_ERROR(status)) return status;
-    // Check if it is time to run each task
-    for (unsigned int taskID = 0; (taskID < ctx->count) && ctx->events; taskID++) {
-        // Skip any invalid or disabled tasks
-        Event_t* evt = ctx->events[taskID];
+    // Take all events which are due off the heap. The earliest deadline is always
+    // at the top, so we stop as soon as we find one that isn't due yet.
+    unsigned int dueCount = 0;
+    while (ctx->heapCount) {
+        Event_t* evt = ctx->heap[0];
+        if ((evt->lastTime - curTime) < evt->interval) break;
+        _EventMgr_heapRemove(ctx, evt);
+        ctx->due[dueCount++] = evt;
+    }
+    // Then handle each one, and put it back into the heap if it is to run again.
+    // Handlers may alter or destroy other events, so recheck validity of each.
+    status = ERR_SUCCESS;
+    for (unsigned int dueIdx = 0; dueIdx < dueCount; dueIdx++) {
+        Event_t* evt = ctx->due[dueIdx];
         if (!Event_validate(evt) || (evt->type == EVENT_TYPE_DISABLED)) {
             continue;
         }
-        // Check if the task has reached its interval
+        // Handle the event
         _Event_checkOccured(evt, curTime);
-        // If a fatal error in the event handler occurred, give up.
-        if (ERR_IS_ERROR(evt->state)) return evt->state;
+        _EventMgr_reschedule(evt);
+        // If a fatal error in the event handler occurred, give up once all are rescheduled.
+        if (ERR_IS_ERROR(evt->state) && ERR_IS_SUCCESS(status)) status = evt->state;
     }
+    if (ERR_IS_ERROR(status)) return status;
     //Keep the timer interrupt flag clear
     Timer_checkOverflow(ctx->timer, true);
     return ERR_SUCCESS;
@@ -189,42 +717,10 @@ HpsErr_t Event_create(EventMgrCtx_t* ctx, EventType type, unsigned int interval,
     //Ensure context valid and initialised
     HpsErr_t status = DriverContextValidate(ctx);
     if (ERR_IS_ERROR(status)) return status;
-    //If there is no handler table, ensure length is zero in case realloc fails
-    if (!ctx->events) {
-        ctx->count = 0;
-    }
-    //See if there is an invalid handler we can reuse
-    Event_t* evt = NULL;
-    unsigned int tableIdx = 0;
-    for (; tableIdx < ctx->count; tableIdx++) {
-        Event_t* checkCtx = ctx->events[tableIdx];
-        if (!checkCtx) {
-            //Empty table entry. Will reuse table index, but make a new entry
-            break;
-        } else if ((checkCtx->state == EVENT_STATE_INVALID) || !checkCtx->evtMgrCtx || !checkCtx->timerCtx) {
-            //Invalid entry that belongs to nobody. We will reuse.
-            evt = checkCtx;
-            break;
-        }
-    }
-    //If a free index was not found, grow the table
-    if (tableIdx == ctx->count) {
-        //Increase the size of the table by 1
-        unsigned int count = ctx->count + 1;
-        Event_t** newTable = (Event_t**)realloc(ctx->events, count * sizeof(*ctx->events));
-        if (!newTable) {
-            return ERR_ALLOCFAIL;
-        }
-        //Save the new table
-        ctx->events = newTable;
-        ctx->count = count;
-    }
-    //If we have no event context, allocate a new one and assign to table
-    if (!evt) {
-        evt = (Event_t*)malloc(sizeof(*evt));
-        ctx->events[tableIdx] = evt;
-        if (!evt) return ERR_ALLOCFAIL;
-    }
+    //Claim a free entry in the pool
+    signed int poolIdx = bitmapAllocate(ctx->poolUsed, ctx->size);
+    if (poolIdx < 0) return ERR_NOSPACE;
+    Event_t* evt = &ctx->pool[poolIdx];
     //Initialise the (new) event
     evt->evtMgrCtx = ctx;
     evt->timerCtx = ctx->timer;
@@ -234,6 +730,9 @@ HpsErr_t Event_create(EventMgrCtx_t* ctx, EventType type, unsigned int interval,
     evt->param = param;
     evt->state = EVENT_STATE_DISABLED;
     evt->lastTime = 0;
+    evt->heapIdx = EVENT_HEAP_NONE;
+    evt->groups = EVENT_GROUP_NONE;
+    memset(&evt->stats, 0, sizeof(evt->stats));
     //And return the new event context
     *pEvtCtx = evt;
     return ERR_SUCCESS;
@@ -254,6 +753,9 @@ HpsErr_t Event_init(Event_t* evt, TimerCtx_t* timer, unsigned int interval, bool
     evt->param = NULL;
     evt->state = EVENT_STATE_DISABLED;
     evt->lastTime = 0;
+    evt->evtMgrCtx = NULL;
+    evt->heapIdx = EVENT_HEAP_NONE;
+    evt->groups = EVENT_GROUP_NONE;
     // If we are requesting automatic start, do it
     if (enqueue) {
         return Event_state(evt, EVENT_CNTRL_ENQUEUE, EVENT_INTERVAL_UNCHANGED);
@@ -271,6 +773,16 @@ bool Event_validate(Event_t* evt) {
 //  - Cancels the event by zeroing out its structure.
 //  - Do NOT destroy an event from within its own handler function!
 void Event_destroy(Event_t* evt) {
+    if (!evt) return;
+    //Remove registered events from the schedule
+    if (!EVENT_STATE_ISINVALID(evt->state) && evt->evtMgrCtx && evt->evtMgrCtx->heap) {
+        _EventMgr_heapRemove(evt->evtMgrCtx, evt);
+    }
+    //Return registered events to the pool
+    EventMgrCtx_t* ctx = evt->evtMgrCtx;
+    if (ctx && ctx->poolUsed && (evt >= ctx->pool) && (evt < &ctx->pool[ctx->size])) {
+        bitmapClear(ctx->poolUsed, (unsigned int)(evt - ctx->pool));
+    }
     //Zero out the structure. This will mark it as invalid.
     memset(evt, 0, sizeof(*evt));
 }
@@ -279,15 +791,10 @@ void Event_destroy(Event_t* evt) {
 //  - Pass in a event context returned from Event_create or Event_init.
 //  - Returns the state of the event before any op was performed
 //  - Performs control operation on event if not EVENT_CNTRL_CHECK.
-HpsErr_t Event_state(Event_t* evt, EventControl op, unsigned int interval) {
-    //Check if this is a valid event
-    if (!Event_validate(evt)) return EVENT_STATE_INVALID;
+//  - curTime is the current timer value. Event must be validated before calling this.
+static HpsErr_t _Event_stateAt(Event_t* evt, EventControl op, unsigned int interval, unsigned int curTime) {
     // Read the current state.
     HpsErr_t curState = evt->state;
-    // Get the restart time
-    unsigned int curTime;
-    HpsErr_t status = Timer_getTime(evt->timerCtx, &curTime);
-    if (ERR_IS_ERROR(status)) return EVENT_STATE_ERROR;
     // Check what operation we are performing
     switch (op) {
         case EVENT_CNTRL_CANCEL:
@@ -355,6 +862,33 @@ HpsErr_t Event_state(Event_t* evt, EventControl op, unsigned int interval) {
     return curState;
 }
 
+// Check or control an event
+//  - Pass in a event context returned from Event_create or Event_init.
+//  - Returns the state of the event before any op was performed
+//  - Performs control operation on event if not EVENT_CNTRL_CHECK.
+static HpsErr_t _Event_state(Event_t* evt, EventControl op, unsigned int interval) {
+    //Check if this is a valid event
+    if (!Event_validate(evt)) return EVENT_STATE_INVALID;
+    // Get the restart time
+    unsigned int curTime;
+    HpsErr_t status = Timer_getTime(evt->timerCtx, &curTime);
+    if (ERR_IS_ERROR(status)) return EVENT_STATE_ERROR;
+    return _Event_stateAt(evt, op, interval, curTime);
+}
+
+// Check or control an event
+//  - Pass in a event context returned from Event_create or Event_init.
+//  - Returns the state of the event before any op was performed
+//  - Performs control operation on event if not EVENT_CNTRL_CHECK.
+HpsErr_t Event_state(Event_t* evt, EventControl op, unsigned int interval) {
+    HpsErr_t curState = _Event_state(evt, op, interval);
+    //Update the schedule of registered events
+    if (!EVENT_STATE_ISINVALID(curState) && (evt->type != EVENT_TYPE_MANUAL)) {
+        _EventMgr_reschedule(evt);
+    }
+    return curState;
+}
+
 // Change mode for a timer event
 //  - Pass in a timer event context returned from createEvent.
 //  - Setting an interval of EVENT_INTERVAL_UNCHANGED (0) means keep the
@@ -367,7 +901,65 @@ HpsErr_t Event_setMode(Event_t* evt, EventType type, unsigned int interval) {
     if (interval != EVENT_INTERVAL_UNCHANGED) {
         evt->interval = interval;
     }
+    //Update the schedule of registered events
+    _EventMgr_reschedule(evt);
+    return ERR_SUCCESS;
+}
+
+// Get the scheduling metrics of an event
+//  - Copies the metrics recorded since creation or the last Event_clearStats.
+HpsErr_t Event_getStats(Event_t* evt, EventStats_t* stats) {
+    if (!stats) return ERR_NULLPTR;
+    // Ensure event valid
+    if (!Event_validate(evt)) return ERR_NOTFOUND;
+    *stats = evt->stats;
     return ERR_SUCCESS;
 }
 
+// Clear the scheduling metrics of an event
+HpsErr_t Event_clearStats(Event_t* evt) {
+    // Ensure event valid
+    if (!Event_validate(evt)) return ERR_NOTFOUND;
+    memset(&evt->stats, 0, sizeof(evt->stats));
+    return ERR_SUCCESS;
+}
 
+// Set the groups of a registered event
+//  - groups is a mask of EVENT_GROUP(n) values, replacing any previous groups.
+//  - Returns ERR_WRONGMODE for manual events.
+HpsErr_t Event_setGroups(Event_t* evt, unsigned int groups) {
+    // Ensure event valid
+    if (!Event_validate(evt)) return ERR_NOTFOUND;
+    if (evt->type == EVENT_TYPE_MANUAL) return ERR_WRONGMODE;
+    evt->groups = groups;
+    return ERR_SUCCESS;
+}
+
+// Check or control a group of registered events
+//  - Performs op on every registered event belonging to any of the groups.
+//  - All events are updated using the same time, so restarting keeps them in
+//    phase with each other.
+//  - If interval != EVENT_INTERVAL_UNCHANGED (0) and the op restarts an event,
+//    its interval will be updated to match.
+//  - Returns number of events in the groups, or error code.
+HpsErr_t EventMgr_groupState(EventMgrCtx_t* ctx, unsigned int groups, EventControl op, unsigned int interval) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //One time base for the whole group
+    unsigned int curTime;
+    status = Timer_getTime(ctx->timer, &curTime);
+    if (ERR_IS_ERROR(status)) return status;
+    //Update each member. They all share the manager's timer, so only need
+    //checking for still being in use.
+    HpsErr_t count = 0;
+    for (unsigned int poolIdx = 0; poolIdx < ctx->size; poolIdx++) {
+        Event_t* evt = &ctx->pool[poolIdx];
+        if (EVENT_STATE_ISINVALID(evt->state) || !(evt->groups & groups)) continue;
+        _Event_stateAt(evt, op, interval, curTime);
+        count++;
+    }
+    //Then reschedule everything at once
+    if (count) _EventMgr_rebuildHeap(ctx);
+    return count;
+}
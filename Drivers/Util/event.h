@@ -30,6 +30,99 @@
  * Manual events are requeued only if the call to Event_checkState
  * requests it.
  * 
+ * Registered events are stored in a pool preallocated when the
+ * event manager is initialised, and scheduled using a min-heap
+ * ordered by deadline. Event_process only touches events which
+ * are due, so the cost of polling does not grow with the number
+ * of registered events.
+ * 
+ * Tickless Mode
+ * -------------
+ * Rather than calling Event_process in a busy loop, a second timer
+ * (the "alarm") can be attached with EventMgr_setTickless. The main
+ * loop then calls Event_sleep before each Event_process:
+ * 
+ *     while (1) {
+ *         Event_sleep(evtMgr);
+ *         Event_process(evtMgr);
+ *     }
+ * 
+ * Event_sleep programs the alarm as a one-shot for the next event
+ * deadline and sleeps the processor (WFI) until the alarm or any
+ * other interrupt fires. The alarm rate must match the event timer.
+ * Tickless mode is currently supported on the HPS (HPS_IRQ) only.
+ * 
+ * If an idle context (Util/idle.h) is attached with EventMgr_setIdle,
+ * Event_sleep sleeps through it, so time asleep and the sources which
+ * wake the core are recorded.
+ * 
+ * Event Groups
+ * ------------
+ * Registered events can be placed in up to 32 groups using
+ * Event_setGroups. EventMgr_groupState then applies the same control
+ * operation to every event in a set of groups in one go:
+ * 
+ *     Event_setGroups(ledEvt,  EVENT_GROUP(MODE_RUN));
+ *     Event_setGroups(pollEvt, EVENT_GROUP(MODE_RUN));
+ *     ...
+ *     EventMgr_groupState(evtMgr, EVENT_GROUP(MODE_RUN), EVENT_CNTRL_RESTART, EVENT_INTERVAL_UNCHANGED);
+ * 
+ * The timer is read once, so restarted events share a time base and
+ * stay in phase with each other, and the schedule is rebuilt once
+ * rather than per event.
+ * 
+ * Scheduling Metrics
+ * ------------------
+ * EventMgr_setMetrics enables measurement of how well registered
+ * events with handlers keep to their schedule. For each event the
+ * manager records how late the handler started compared with the
+ * deadline, how long the handler took, and how many periods were
+ * missed (the handler started after the next deadline had already
+ * passed). All times are in event timer cycles. Use Event_getStats
+ * to read them.
+ * 
+ * An overrun handler can also be set with EventMgr_setOverrunHandler,
+ * which is called whenever a period is missed or a handler runs for
+ * longer than its own interval. Metrics add two timer reads to each
+ * handled event, so are disabled by default.
+ * 
+ * Deferred Work
+ * -------------
+ * A work queue (Util/work.h) can be attached to the event manager
+ * using EventMgr_setWorkQueue. Any work items posted by interrupt
+ * handlers will then be run by Event_process before checking the
+ * registered events.
+ * 
+ * Cross-Core Posting
+ * ------------------
+ * For SMP (Util/smp.h), each core can run its own event manager
+ * from its own private timer (HPS_PrivateTimer), so periodic work
+ * is split across the cores with no shared state. To let other
+ * cores hand work to a manager, give it an inbox with
+ * EventMgr_setInbox, called on the core which runs it:
+ * 
+ *     // On CPU1
+ *     HPS_IRQ_initialiseCpu(false);
+ *     EventMgr_initialise(cpu1Timer, &cpu1Mgr);
+ *     EventMgr_setInbox(cpu1Mgr, 16, IRQ_SGI_2);
+ *     while (1) {
+ *         Event_process(cpu1Mgr);
+ *     }
+ *     // On CPU0 (or any ISR on either core)
+ *     EventMgr_post(cpu1Mgr, &startCapture, buffer, length);
+ *     Event_post(cpu1Evt, EVENT_CNTRL_RESTART, newInterval);
+ * 
+ * EventMgr_post queues a callback in the inbox, and Event_post a
+ * control operation on one of the manager's events. Both are run by
+ * the owning core's Event_process, before its due events, so events
+ * are only ever touched by the core that owns them. The inbox is a
+ * lock-free work queue (Util/work.h), so posting never waits for or
+ * blocks the other core, and may be done from interrupt handlers.
+ * If a doorbell is given, posting from another core also sends it a
+ * software generated interrupt, which wakes it from Event_sleep.
+ * Each manager needs its own doorbell ID, as the handler table is
+ * shared between the cores.
+ * 
  *
  * Company: University of Leeds
  * Author: T Carpenter
@@ -38,6 +131,15 @@
  *
  * Date       | Changes
  * -----------+----------------------------------------
+ * 14/10/2026 | Add per core inboxes for cross-core posting
+ * 14/10/2026 | Add idle accounting for tickless sleep
+ * 14/10/2026 | Add deadline miss detection and scheduling metrics
+ * 14/10/2026 | Add event groups with batched control
+ * 14/10/2026 | Track free pool entries with a bitmap
+ * 14/10/2026 | Allocate from Util/mem_pool
+ * 14/10/2026 | Add tickless interrupt driven mode
+ * 14/10/2026 | Use a deadline min-heap and preallocated event pool
+ * 14/10/2026 | Add option to drain a deferred work queue
  * 09/03/2024 | Split out event handling from HPS Timer
  *
  */
@@ -48,6 +150,8 @@
 #include "Util/macros.h"
 #include "Util/driver_ctx.h"
 #include "Util/driver_timer.h"
+#include "Util/work.h"
+#include "Util/idle.h"
 
 #include <stdbool.h>
 
@@ -81,6 +185,11 @@ typedef enum {
 
 #define EVENT_INTERVAL_UNCHANGED  0
 
+// Event group masks
+#define EVENT_GROUP(n)    (1U << (n))
+#define EVENT_GROUP_NONE  0U
+#define EVENT_GROUP_ALL   UINT32_MAX
+
 // Event timing handler function
 //  - Called when a registered event hits the timeout
 //  - Return ERR_SUCCESS to stop handling the event
@@ -88,14 +197,62 @@ typedef enum {
 typedef struct _Event_t Event_t;
 typedef HpsErr_t (*EventFunc_t)(Event_t* event, void* param);
 
+// Event overrun handler function
+//  - Called after a registered event's handler if the event missed a period,
+//    or if the handler ran for longer than the event interval.
+//  - late is how long after the deadline the handler started, and exec how
+//    long it ran for, in timer cycles.
+typedef void (*EventOverrunFunc_t)(Event_t* event, unsigned int late, unsigned int exec, void* param);
+
+// Event scheduling metrics
+//  - All times are in timer cycles.
+typedef struct {
+    unsigned int runs;       // Number of times the handler was called
+    unsigned int missed;     // Number of runs which started after the next deadline
+    unsigned int lateMax;    // Longest delay from deadline to handler start
+    uint64_t     lateTotal;  // Total delay, for averaging over runs
+    unsigned int execMax;    // Longest handler execution time
+    uint64_t     execTotal;  // Total handler execution time
+} EventStats_t;
+
+// Default number of registered events in event manager pool
+#ifndef EVENTMGR_DEFAULT_EVENTS
+#define EVENTMGR_DEFAULT_EVENTS 32
+#endif
+
+// Doorbell value for an inbox with no software interrupt
+#define EVENTMGR_DOORBELL_NONE UINT32_MAX
+
+// Heap index of events not currently scheduled
+#define EVENT_HEAP_NONE UINT32_MAX
+
 // Event Handling Context
 typedef struct {
     //Header
     DrvCtx_t header;
     //Body
-    TimerCtx_t*  timer;  // Timer used by this event manager.
-    Event_t**    events; // "Registered" type events
-    unsigned int count;
+    TimerCtx_t*  timer;     // Timer used by this event manager.
+    Event_t*     pool;      // "Registered" type events
+    unsigned int size;      // Number of events in pool
+    unsigned int* poolUsed; // Bitmap of pool entries in use
+    Event_t**    heap;      // Scheduled events, ordered by deadline
+    unsigned int heapCount;
+    Event_t**    due;       // Events being handled by Event_process
+    WorkQueueCtx_t* work;   // Optional deferred work queue
+    // Tickless mode
+    TimerCtx_t*   alarm;          // One-shot timer for next deadline
+    unsigned int  alarmPrescaler;
+    unsigned int  alarmIrq;
+    volatile bool alarmFired;
+    IdleCtx_t*    idle;           // Optional idle accounting
+    // Scheduling metrics
+    bool          metrics;        // Whether to measure registered event handlers
+    EventOverrunFunc_t overrun;   // Optional overrun handler
+    void*         overrunParam;
+    // Cross-core posting
+    WorkQueueCtx_t* inbox;        // Work posted by other cores, or NULL if not enabled
+    unsigned int  inboxCpu;       // Core which runs this manager
+    unsigned int  inboxSgi;       // Doorbell sent on post, or EVENTMGR_DOORBELL_NONE
 } EventMgrCtx_t;
 
 // Event structure
@@ -109,19 +266,108 @@ typedef struct _Event_t{
     EventFunc_t    handler;      // Optional handler to call when event occurs
     void*          param;        // Optional parameter for handler
     EventMgrCtx_t* evtMgrCtx;    // Event Manager context
+    unsigned int   heapIdx;      // Position in event manager heap
+    unsigned int   groups;       // Mask of groups this event belongs to
+    EventStats_t   stats;        // Scheduling metrics, if enabled
 } Event_t;
 
+// Initialise Event Manager (Optional)
+//  - An event manager instance is required only for registered events.
+//    Can use Manual events without a manager.
+//  - timer is a pointer to the timer to use.
+//    - Must be configured in event mode.
+//  - Space for EVENTMGR_DEFAULT_EVENTS registered events is preallocated.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t EventMgr_initialise(TimerCtx_t* timer, EventMgrCtx_t** pCtx);
+
+// Initialise Event Manager with a given pool size
+//  - Same as EventMgr_initialise, but with space for maxEvents registered events.
+HpsErr_t EventMgr_initialiseSized(TimerCtx_t* timer, unsigned int maxEvents, EventMgrCtx_t** pCtx);
+
+//Check if driver initialised
+//  - Returns true if driver previously initialised
+bool EventMgr_isInitialised(EventMgrCtx_t* ctx);
+
 // Event polling function
 //  - Must call this function repeatedly in the main loop to keep checking
 //    if any event has occurred
+//  - Runs any pending deferred work if a work queue is attached.
+//  - Then runs anything posted to the inbox by EventMgr_post or Event_post.
 HpsErr_t Event_process(EventMgrCtx_t* ctx);
 
+// Attach a deferred work queue
+//  - Pending work items in the queue will be run by Event_process.
+//  - Pass NULL to detach the queue.
+HpsErr_t EventMgr_setWorkQueue(EventMgrCtx_t* ctx, WorkQueueCtx_t* work);
+
+// Enable cross-core posting
+//  - Must be called on the core which runs this manager's Event_process.
+//  - queueLength is the most posts which can be pending. Must be a power
+//    of two, at least 2.
+//  - sgiID is a software interrupt (IRQ_SGI_0 to IRQ_SGI_15) to send to
+//    this core on each post from another core, so that Event_sleep wakes.
+//    A handler is registered on the calling core. Each manager must have
+//    its own ID. Pass EVENTMGR_DOORBELL_NONE if only polling.
+//  - Returns ERR_INUSE if an inbox is already enabled.
+HpsErr_t EventMgr_setInbox(EventMgrCtx_t* ctx, unsigned int queueLength, unsigned int sgiID);
+
+// Post a callback to an event manager
+//  - func(param, arg) is run by the next Event_process of ctx, on its own core.
+//  - May be called from any core or context, including interrupt handlers.
+//  - Returns ERR_WRONGMODE if no inbox is enabled.
+//  - Returns ERR_NOSPACE if the inbox is full.
+HpsErr_t EventMgr_post(EventMgrCtx_t* ctx, WorkFunc_t func, void* param, unsigned int arg);
+
+// Post a control operation to a registered event
+//  - As Event_state(evt, op, interval), but performed by the next
+//    Event_process of the manager which owns evt, on its own core.
+//  - op must not be EVENT_CNTRL_CHECK, as the result is not returned.
+//  - Otherwise as EventMgr_post.
+HpsErr_t Event_post(Event_t* evt, EventControl op, unsigned int interval);
+
+// Enable tickless mode
+//  - alarm is a timer to be used in one-shot mode for the next event deadline.
+//    Pass NULL to disable tickless mode.
+//  - prescaler is the value to configure the alarm with. The resulting rate
+//    must match that of the event timer.
+//  - irqID is the interrupt ID of the alarm timer. A handler will be registered.
+//  - Returns ERR_MISMATCH if the alarm and event timer rates are different.
+//  - Returns ERR_NOSUPPORT if not running on the HPS.
+HpsErr_t EventMgr_setTickless(EventMgrCtx_t* ctx, TimerCtx_t* alarm, unsigned int prescaler, unsigned int irqID);
+
+// Enable scheduling metrics
+//  - When enabled, Event_process measures the lateness and execution time of
+//    each registered event handler. See notes at top of file.
+HpsErr_t EventMgr_setMetrics(EventMgrCtx_t* ctx, bool enable);
+
+// Set the overrun handler
+//  - handler is called when a registered event misses a period or its handler
+//    runs for longer than its interval. Pass NULL to remove.
+//  - Lateness is measured while a handler is set, even if metrics are disabled.
+HpsErr_t EventMgr_setOverrunHandler(EventMgrCtx_t* ctx, EventOverrunFunc_t handler, void* param);
+
+// Attach idle accounting
+//  - Event_sleep will sleep using Idle_wfi, recording idle time and wake sources.
+//  - Pass NULL to detach.
+HpsErr_t EventMgr_setIdle(EventMgrCtx_t* ctx, IdleCtx_t* idle);
+
+// Sleep until the next event is due
+//  - Requires tickless mode to be enabled.
+//  - Programs the alarm for the next event deadline, then waits for
+//    an interrupt. Returns immediately if an event is already due or
+//    deferred work is pending.
+//  - Will also return early on any other interrupt, so call Event_process
+//    after this returns.
+HpsErr_t Event_sleep(EventMgrCtx_t* ctx);
+
 // Create a registered event
 //  - Timer must be configured to TIMER_MODE_EVENT
 //  - interval is the number of timer clock cycles before the event occurs. Must be >0.
 //  - mode sets the initial state of the event (whether disabled, enabled once, or enabled repeating)
-//  - Multiple events can be registered
+//  - Multiple events can be registered, up to the size of the event pool
 //  - Will return event context to *pEvtCtx
+//  - Returns ERR_NOSPACE if the event pool is full.
 HpsErr_t Event_create(EventMgrCtx_t* ctx, EventType type, unsigned int interval, EventFunc_t handler, void* param, Event_t** pEvtCtx);
 
 // Initialise a manual event
@@ -147,6 +393,27 @@ bool Event_validate(Event_t* evt);
 //    the interval of the event will be updated to match.
 HpsErr_t Event_state(Event_t* evt, EventControl op, unsigned int interval);
 
+// Get the scheduling metrics of an event
+//  - Copies the metrics recorded since creation or the last Event_clearStats.
+HpsErr_t Event_getStats(Event_t* evt, EventStats_t* stats);
+
+// Clear the scheduling metrics of an event
+HpsErr_t Event_clearStats(Event_t* evt);
+
+// Set the groups of a registered event
+//  - groups is a mask of EVENT_GROUP(n) values, replacing any previous groups.
+//  - Returns ERR_WRONGMODE for manual events.
+HpsErr_t Event_setGroups(Event_t* evt, unsigned int groups);
+
+// Check or control a group of registered events
+//  - Performs op on every registered event belonging to any of the groups.
+//  - All events are updated using the same time, so restarting keeps them in
+//    phase with each other.
+//  - If interval != EVENT_INTERVAL_UNCHANGED (0) and the op restarts an event,
+//    its interval will be updated to match.
+//  - Returns number of events in the groups, or error code.
+HpsErr_t EventMgr_groupState(EventMgrCtx_t* ctx, unsigned int groups, EventControl op, unsigned int interval);
+
 // Change mode for a timer event
 //  - Pass in a timer event context returned from createEvent.
 //  - Setting an interval of EVENT_INTERVAL_UNCHANGED (0) means keep the
@@ -0,0 +1,120 @@
+/*
+ * Fixed-Point and Fast Approximate Maths
+ * --------------------------------------
+ *
+ * Block functions for the fast maths approximations. The
+ * scalar and four lane versions themselves are inline in
+ * fastmath.h.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "fastmath.h"
+
+#include "Util/macros.h"
+
+// Apply Math_sinf to count values from in to out
+//  - in and out may be the same array.
+HOT_CODE void Math_sinfBlock(const float* in, float* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_f32(&out[n], Math_sinfx4(vld1q_f32(&in[n])));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = Math_sinf(in[n]);
+    }
+}
+
+// Apply Math_cosf to count values from in to out
+//  - in and out may be the same array.
+HOT_CODE void Math_cosfBlock(const float* in, float* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_f32(&out[n], Math_cosfx4(vld1q_f32(&in[n])));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = Math_cosf(in[n]);
+    }
+}
+
+// Apply Math_atan2f to count pairs from y and x to out
+//  - out may be the same array as y or x.
+HOT_CODE void Math_atan2fBlock(const float* y, const float* x, float* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_f32(&out[n], Math_atan2fx4(vld1q_f32(&y[n]), vld1q_f32(&x[n])));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = Math_atan2f(y[n], x[n]);
+    }
+}
+
+// Apply Math_sqrtf to count values from in to out
+//  - in and out may be the same array.
+HOT_CODE void Math_sqrtfBlock(const float* in, float* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_f32(&out[n], Math_sqrtfx4(vld1q_f32(&in[n])));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = Math_sqrtf(in[n]);
+    }
+}
+
+// Apply Math_recipf to count values from in to out
+//  - in and out may be the same array.
+HOT_CODE void Math_recipfBlock(const float* in, float* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_f32(&out[n], Math_recipfx4(vld1q_f32(&in[n])));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = Math_recipf(in[n]);
+    }
+}
+
+// Saturating multiply of count Q15 values, out[n] = a[n] * b[n]
+//  - out may be the same array as a or b.
+HOT_CODE void Math_mulBlockQ15(const q15_t* a, const q15_t* b, q15_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 8 <= count; n += 8) {
+        vst1q_s16(&out[n], Math_mulQ15x8(vld1q_s16(&a[n]), vld1q_s16(&b[n])));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = Math_mulQ15(a[n], b[n]);
+    }
+}
+
+// Saturating multiply of count Q31 values, out[n] = a[n] * b[n]
+//  - out may be the same array as a or b.
+HOT_CODE void Math_mulBlockQ31(const q31_t* a, const q31_t* b, q31_t* out, unsigned int count) {
+    unsigned int n = 0;
+#if defined(__ARM_NEON)
+    for (; n + 4 <= count; n += 4) {
+        vst1q_s32(&out[n], Math_mulQ31x4(vld1q_s32(&a[n]), vld1q_s32(&b[n])));
+    }
+#endif
+    for (; n < count; n++) {
+        out[n] = Math_mulQ31(a[n], b[n]);
+    }
+}
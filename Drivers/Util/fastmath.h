@@ -0,0 +1,409 @@
+/*
+ * Fixed-Point and Fast Approximate Maths
+ * --------------------------------------
+ *
+ * Provides saturating Q15/Q31 arithmetic and fast float
+ * approximations of common maths functions, to be used in
+ * place of the double precision C library in DSP, graphics
+ * and Mandelbrot style inner loops.
+ *
+ *    float s = Math_sinf(phase);
+ *    q31_t y = Math_addQ31(Math_mulQ31(a, gain), b);
+ *
+ * Fixed Point
+ * -----------
+ *
+ * Q15 and Q31 use the q15_t/q31_t types of Util/dsp.h. All
+ * operations saturate to the range of the type rather than
+ * wrapping. Where the compiler provides the ARM saturating
+ * instructions (__ARM_FEATURE_QBIT), they are used directly.
+ *
+ * Approximations
+ * --------------
+ *
+ * The float functions trade accuracy for speed, and do not set
+ * errno or handle infinities and NaNs:
+ *
+ *   - Math_sinf/Math_cosf: Reduced to [-pi/4, pi/4] then a
+ *     polynomial. Absolute error below 1e-6 for |x| < 8192.
+ *   - Math_atan2f: Reduced to one octant then a polynomial.
+ *     Error below 2e-5 radians. Returns 0 for (0, 0).
+ *   - Math_recipf/Math_rsqrtf: An initial estimate refined with
+ *     two Newton-Raphson steps. Relative error below 1e-5.
+ *   - Math_sqrtf: x * rsqrt(x). Returns 0 for x <= 0.
+ *
+ * NEON
+ * ----
+ *
+ * Where the compiler has NEON enabled (__ARM_NEON), each function
+ * also has a four lane variant with an "x4" suffix (or "x8" for
+ * Q15) taking and returning NEON vectors, computed in the same
+ * way as the scalar one except that the reciprocal estimates use
+ * the VRECPE/VRSQRTE instructions. These can be used directly in
+ * vectorised loops. Block functions (e.g. Math_sinfBlock()) apply
+ * a function to an array, using the NEON variant four at a time
+ * when available, and the scalar one otherwise.
+ *
+ * NEON requires CP10/CP11 access and the FPU to be enabled, which
+ * is performed by Util/startup_arm.c.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef FASTMATH_H_
+#define FASTMATH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "Util/dsp.h"
+
+#if defined(__ARM_FEATURE_QBIT)
+#include <arm_acle.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Constants
+#define MATH_PI      3.14159265358979f
+#define MATH_PI_2    1.57079632679490f
+#define MATH_2_PI    0.63661977236758f
+
+// Pi/2 split into parts for exact range reduction
+#define MATH_PI_2_A  1.5703125f
+#define MATH_PI_2_B  4.837512969970703125e-4f
+#define MATH_PI_2_C  7.54978995489188216e-8f
+
+// Sine and cosine polynomial coefficients for [-pi/4, pi/4]
+#define MATH_SIN_C1 -1.6666654611e-1f
+#define MATH_SIN_C2  8.3321608736e-3f
+#define MATH_SIN_C3 -1.9515295891e-4f
+#define MATH_COS_C1  4.166664568298827e-2f
+#define MATH_COS_C2 -1.388731625493765e-3f
+#define MATH_COS_C3  2.443315711809948e-5f
+
+// Arctangent polynomial coefficients for [0, 1]
+#define MATH_ATAN_C1  0.9998660f
+#define MATH_ATAN_C3 -0.3302995f
+#define MATH_ATAN_C5  0.1801410f
+#define MATH_ATAN_C7 -0.0851330f
+#define MATH_ATAN_C9  0.0208351f
+
+// Initial estimates for reciprocal and reciprocal square root
+#define MATH_RECIP_MAGIC 0x7EF311C7U
+#define MATH_RSQRT_MAGIC 0x5F3759DFU
+
+/*
+ * Saturating Fixed Point
+ */
+
+// Saturate to Q15
+static inline q15_t Math_satQ15(int32_t val) {
+    if (val > INT16_MAX) return INT16_MAX;
+    if (val < INT16_MIN) return INT16_MIN;
+    return (q15_t)val;
+}
+
+// Saturate to Q31
+static inline q31_t Math_satQ31(int64_t val) {
+    if (val > INT32_MAX) return INT32_MAX;
+    if (val < INT32_MIN) return INT32_MIN;
+    return (q31_t)val;
+}
+
+// Saturating add (Q15)
+static inline q15_t Math_addQ15(q15_t a, q15_t b) {
+    return Math_satQ15((int32_t)a + b);
+}
+
+// Saturating subtract (Q15)
+static inline q15_t Math_subQ15(q15_t a, q15_t b) {
+    return Math_satQ15((int32_t)a - b);
+}
+
+// Saturating multiply (Q15)
+//  - Only -1 * -1 saturates.
+static inline q15_t Math_mulQ15(q15_t a, q15_t b) {
+    return Math_satQ15(((int32_t)a * b) >> 15);
+}
+
+// Saturating add (Q31)
+static inline q31_t Math_addQ31(q31_t a, q31_t b) {
+#if defined(__ARM_FEATURE_QBIT)
+    return __qadd(a, b);
+#else
+    return Math_satQ31((int64_t)a + b);
+#endif
+}
+
+// Saturating subtract (Q31)
+static inline q31_t Math_subQ31(q31_t a, q31_t b) {
+#if defined(__ARM_FEATURE_QBIT)
+    return __qsub(a, b);
+#else
+    return Math_satQ31((int64_t)a - b);
+#endif
+}
+
+// Saturating multiply (Q31)
+//  - Only -1 * -1 saturates.
+static inline q31_t Math_mulQ31(q31_t a, q31_t b) {
+    return Math_satQ31(((int64_t)a * b) >> 31);
+}
+
+// Convert float in [-1, 1) to Q15, saturating
+static inline q15_t Math_floatToQ15(float x) {
+    float v = x * 32768.0f;
+    if (v >= 32767.0f) return INT16_MAX;
+    if (v <= -32768.0f) return INT16_MIN;
+    return (q15_t)v;
+}
+
+// Convert float in [-1, 1) to Q31, saturating
+static inline q31_t Math_floatToQ31(float x) {
+    float v = x * 2147483648.0f;
+    if (v >= 2147483647.0f) return INT32_MAX;
+    if (v <= -2147483648.0f) return INT32_MIN;
+    return (q31_t)v;
+}
+
+// Convert Q15 to float
+static inline float Math_q15ToFloat(q15_t x) {
+    return (float)x * (1.0f / 32768.0f);
+}
+
+// Convert Q31 to float
+static inline float Math_q31ToFloat(q31_t x) {
+    return (float)x * (1.0f / 2147483648.0f);
+}
+
+/*
+ * Fast Float Approximations
+ */
+
+// Reinterpret float bits
+static inline uint32_t _Math_floatBits(float x) {
+    uint32_t i;
+    memcpy(&i, &x, sizeof(i));
+    return i;
+}
+static inline float _Math_bitsFloat(uint32_t i) {
+    float x;
+    memcpy(&x, &i, sizeof(x));
+    return x;
+}
+
+// Sine or cosine of x, offset by a number of quadrants
+//  - Reduces x to r in [-pi/4, pi/4] in quadrant j, then evaluates
+//    sin(r) or cos(r) as needed for quadrant (j + quadrant).
+static inline float _Math_sinQuadrant(float x, int quadrant) {
+    int j = (int)(x * MATH_2_PI + ((x < 0.0f) ? -0.5f : 0.5f));
+    float fj = (float)j;
+    float r = ((x - fj * MATH_PI_2_A) - fj * MATH_PI_2_B) - fj * MATH_PI_2_C;
+    float z = r * r;
+    float res;
+    j += quadrant;
+    if (j & 1) {
+        res = 1.0f - 0.5f * z + z * z * (MATH_COS_C1 + z * (MATH_COS_C2 + z * MATH_COS_C3));
+    } else {
+        res = r + r * z * (MATH_SIN_C1 + z * (MATH_SIN_C2 + z * MATH_SIN_C3));
+    }
+    return (j & 2) ? -res : res;
+}
+
+// Fast sine
+static inline float Math_sinf(float x) {
+    return _Math_sinQuadrant(x, 0);
+}
+
+// Fast cosine
+static inline float Math_cosf(float x) {
+    return _Math_sinQuadrant(x, 1);
+}
+
+// Fast reciprocal estimate (1 / x)
+static inline float Math_recipf(float x) {
+    float y = _Math_bitsFloat(MATH_RECIP_MAGIC - _Math_floatBits(x));
+    y = y * (2.0f - x * y);
+    y = y * (2.0f - x * y);
+    return y;
+}
+
+// Fast reciprocal square root estimate (1 / sqrt(x))
+//  - x must be positive.
+static inline float Math_rsqrtf(float x) {
+    float y = _Math_bitsFloat(MATH_RSQRT_MAGIC - (_Math_floatBits(x) >> 1));
+    y = y * (1.5f - 0.5f * x * y * y);
+    y = y * (1.5f - 0.5f * x * y * y);
+    return y;
+}
+
+// Fast square root
+//  - Returns 0 for x <= 0.
+static inline float Math_sqrtf(float x) {
+    if (x <= 0.0f) return 0.0f;
+    return x * Math_rsqrtf(x);
+}
+
+// Fast arctangent of y/x, in the range [-pi, pi]
+//  - Returns 0 if both x and y are zero.
+static inline float Math_atan2f(float y, float x) {
+    float ax = (x < 0.0f) ? -x : x;
+    float ay = (y < 0.0f) ? -y : y;
+    float mx = (ax > ay) ? ax : ay;
+    float mn = (ax > ay) ? ay : ax;
+    if (mx == 0.0f) return 0.0f;
+    float a = mn / mx;
+    float s = a * a;
+    float r = a * (MATH_ATAN_C1 + s * (MATH_ATAN_C3 + s * (MATH_ATAN_C5 + s * (MATH_ATAN_C7 + s * MATH_ATAN_C9))));
+    if (ay > ax) r = MATH_PI_2 - r;
+    if (x < 0.0f) r = MATH_PI - r;
+    return (y < 0.0f) ? -r : r;
+}
+
+/*
+ * NEON Variants
+ */
+
+#if defined(__ARM_NEON)
+
+// Saturating fixed point, eight Q15 or four Q31 lanes
+static inline int16x8_t Math_addQ15x8(int16x8_t a, int16x8_t b) { return vqaddq_s16(a, b); }
+static inline int16x8_t Math_subQ15x8(int16x8_t a, int16x8_t b) { return vqsubq_s16(a, b); }
+static inline int16x8_t Math_mulQ15x8(int16x8_t a, int16x8_t b) { return vqdmulhq_s16(a, b); }
+static inline int32x4_t Math_addQ31x4(int32x4_t a, int32x4_t b) { return vqaddq_s32(a, b); }
+static inline int32x4_t Math_subQ31x4(int32x4_t a, int32x4_t b) { return vqsubq_s32(a, b); }
+static inline int32x4_t Math_mulQ31x4(int32x4_t a, int32x4_t b) { return vqdmulhq_s32(a, b); }
+
+// Sine or cosine of four lanes, offset by a number of quadrants
+static inline float32x4_t _Math_sinQuadrantx4(float32x4_t x, int quadrant) {
+    //Round to nearest quadrant by adding +/-0.5 with the sign of x
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x80000000U));
+    float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(0.5f)), sign));
+    int32x4_t j = vcvtq_s32_f32(vmlaq_n_f32(half, x, MATH_2_PI));
+    float32x4_t fj = vcvtq_f32_s32(j);
+    float32x4_t r = vmlsq_n_f32(x, fj, MATH_PI_2_A);
+    r = vmlsq_n_f32(r, fj, MATH_PI_2_B);
+    r = vmlsq_n_f32(r, fj, MATH_PI_2_C);
+    float32x4_t z = vmulq_f32(r, r);
+    //Both polynomials, then select per lane
+    float32x4_t ps = vmlaq_n_f32(vdupq_n_f32(MATH_SIN_C2), z, MATH_SIN_C3);
+    ps = vmlaq_f32(vdupq_n_f32(MATH_SIN_C1), z, ps);
+    ps = vmlaq_f32(r, vmulq_f32(r, z), ps);
+    float32x4_t pc = vmlaq_n_f32(vdupq_n_f32(MATH_COS_C2), z, MATH_COS_C3);
+    pc = vmlaq_f32(vdupq_n_f32(MATH_COS_C1), z, pc);
+    pc = vmlaq_f32(vmlsq_n_f32(vdupq_n_f32(1.0f), z, 0.5f), vmulq_f32(z, z), pc);
+    uint32x4_t q = vreinterpretq_u32_s32(vaddq_s32(j, vdupq_n_s32(quadrant)));
+    uint32x4_t useCos = vtstq_u32(q, vdupq_n_u32(1));
+    float32x4_t res = vbslq_f32(useCos, pc, ps);
+    //Negate in the lower half of the circle
+    uint32x4_t neg = vshlq_n_u32(vandq_u32(q, vdupq_n_u32(2)), 30);
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(res), neg));
+}
+
+// Fast sine, four lanes
+static inline float32x4_t Math_sinfx4(float32x4_t x) {
+    return _Math_sinQuadrantx4(x, 0);
+}
+
+// Fast cosine, four lanes
+static inline float32x4_t Math_cosfx4(float32x4_t x) {
+    return _Math_sinQuadrantx4(x, 1);
+}
+
+// Fast reciprocal estimate, four lanes
+static inline float32x4_t Math_recipfx4(float32x4_t x) {
+    float32x4_t y = vrecpeq_f32(x);
+    y = vmulq_f32(y, vrecpsq_f32(x, y));
+    y = vmulq_f32(y, vrecpsq_f32(x, y));
+    return y;
+}
+
+// Fast reciprocal square root estimate, four lanes
+//  - x must be positive.
+static inline float32x4_t Math_rsqrtfx4(float32x4_t x) {
+    float32x4_t y = vrsqrteq_f32(x);
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+    y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+    return y;
+}
+
+// Fast square root, four lanes
+//  - Returns 0 for lanes <= 0.
+static inline float32x4_t Math_sqrtfx4(float32x4_t x) {
+    uint32x4_t positive = vcgtq_f32(x, vdupq_n_f32(0.0f));
+    float32x4_t res = vmulq_f32(x, Math_rsqrtfx4(x));
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(res), positive));
+}
+
+// Fast arctangent of y/x, four lanes
+//  - Returns 0 for lanes where both x and y are zero.
+static inline float32x4_t Math_atan2fx4(float32x4_t y, float32x4_t x) {
+    float32x4_t ax = vabsq_f32(x);
+    float32x4_t ay = vabsq_f32(y);
+    float32x4_t mx = vmaxq_f32(ax, ay);
+    float32x4_t mn = vminq_f32(ax, ay);
+    //Where both are zero, mn is zero, so a is zero if mx is made non-zero
+    uint32x4_t zero = vceqq_f32(mx, vdupq_n_f32(0.0f));
+    mx = vbslq_f32(zero, vdupq_n_f32(1.0f), mx);
+    float32x4_t a = vmulq_f32(mn, Math_recipfx4(mx));
+    float32x4_t s = vmulq_f32(a, a);
+    float32x4_t p = vmlaq_n_f32(vdupq_n_f32(MATH_ATAN_C7), s, MATH_ATAN_C9);
+    p = vmlaq_f32(vdupq_n_f32(MATH_ATAN_C5), s, p);
+    p = vmlaq_f32(vdupq_n_f32(MATH_ATAN_C3), s, p);
+    p = vmlaq_f32(vdupq_n_f32(MATH_ATAN_C1), s, p);
+    float32x4_t r = vmulq_f32(a, p);
+    //Octant, quadrant, then sign of y
+    r = vbslq_f32(vcgtq_f32(ay, ax), vsubq_f32(vdupq_n_f32(MATH_PI_2), r), r);
+    r = vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.0f)), vsubq_f32(vdupq_n_f32(MATH_PI), r), r);
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(y), vdupq_n_u32(0x80000000U));
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(r), sign));
+}
+
+#endif /* __ARM_NEON */
+
+/*
+ * Block Functions
+ */
+
+// Apply Math_sinf to count values from in to out
+//  - in and out may be the same array.
+void Math_sinfBlock(const float* in, float* out, unsigned int count);
+
+// Apply Math_cosf to count values from in to out
+//  - in and out may be the same array.
+void Math_cosfBlock(const float* in, float* out, unsigned int count);
+
+// Apply Math_atan2f to count pairs from y and x to out
+//  - out may be the same array as y or x.
+void Math_atan2fBlock(const float* y, const float* x, float* out, unsigned int count);
+
+// Apply Math_sqrtf to count values from in to out
+//  - in and out may be the same array.
+void Math_sqrtfBlock(const float* in, float* out, unsigned int count);
+
+// Apply Math_recipf to count values from in to out
+//  - in and out may be the same array.
+void Math_recipfBlock(const float* in, float* out, unsigned int count);
+
+// Saturating multiply of count Q15 values, out[n] = a[n] * b[n]
+//  - out may be the same array as a or b.
+void Math_mulBlockQ15(const q15_t* a, const q15_t* b, q15_t* out, unsigned int count);
+
+// Saturating multiply of count Q31 values, out[n] = a[n] * b[n]
+//  - out may be the same array as a or b.
+void Math_mulBlockQ31(const q31_t* a, const q31_t* b, q31_t* out, unsigned int count);
+
+#endif /* FASTMATH_H_ */
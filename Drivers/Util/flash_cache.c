@@ -0,0 +1,361 @@
+/*
+ * Flash Block Cache
+ * -----------------
+ *
+ * Wraps a flash driver (FlashCtx_t) with a write-back cache of
+ * recently used blocks, itself providing a FlashCtx_t which can
+ * be used in place of the underlying flash.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "flash_cache.h"
+#include "Util/mem_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Util/macros.h"
+
+/*
+ * Internal Functions
+ */
+
+// Page dirty bitmap helpers
+static inline void _FlashCache_markPages(FlashCacheCtx_t* ctx, FlashCacheLine_t* line, unsigned int offset, unsigned int length) {
+    unsigned int last = (offset + length - 1) / ctx->pageSize;
+    for (unsigned int page = offset / ctx->pageSize; page <= last; page++) {
+        line->dirtyPages[page / 32] |= (1UL << (page % 32));
+    }
+}
+
+static inline bool _FlashCache_pageDirty(FlashCacheLine_t* line, unsigned int page) {
+    return !!(line->dirtyPages[page / 32] & (1UL << (page % 32)));
+}
+
+// Check if a page of a cached block is blank (all ones)
+static bool _FlashCache_pageBlank(FlashCacheCtx_t* ctx, FlashCacheLine_t* line, unsigned int page) {
+    const uint8_t* data = line->data + (page * ctx->pageSize);
+    for (unsigned int idx = 0; idx < ctx->pageSize; idx++) {
+        if (data[idx] != 0xFF) return false;
+    }
+    return true;
+}
+
+// Find the cache line holding a block
+//  - Returns NULL if not cached.
+static FlashCacheLine_t* _FlashCache_find(FlashCacheCtx_t* ctx, unsigned int block) {
+    for (unsigned int idx = 0; idx < ctx->lineCount; idx++) {
+        FlashCacheLine_t* line = &ctx->lines[idx];
+        if (line->valid && (line->address == block)) {
+            line->lastUsed = ++ctx->tick;
+            return line;
+        }
+    }
+    return NULL;
+}
+
+// Write back a cache line if dirty
+//  - Erases the block if required, then programs runs of dirty pages as single writes.
+//  - Line stays dirty on failure so that the write back can be retried.
+static HpsErr_t _FlashCache_flushLine(FlashCacheCtx_t* ctx, FlashCacheLine_t* line) {
+    if (!line->valid || !line->dirty) return ERR_SUCCESS;
+    HpsErr_t status;
+    unsigned int words = (ctx->pageCount + 31) / 32;
+    if (line->erase) {
+        status = FLASH_erase(ctx->backing, line->address, ctx->blockSize);
+        if (ERR_IS_ERROR(status)) return status;
+        line->erase = false;
+        //Now blank, every page with data needs programming
+        memset(line->dirtyPages, 0, words * sizeof(uint32_t));
+        for (unsigned int page = 0; page < ctx->pageCount; page++) {
+            if (!_FlashCache_pageBlank(ctx, line, page)) {
+                line->dirtyPages[page / 32] |= (1UL << (page % 32));
+            }
+        }
+    }
+    unsigned int page = 0;
+    while (page < ctx->pageCount) {
+        if (!_FlashCache_pageDirty(line, page)) {
+            page++;
+            continue;
+        }
+        //Combine consecutive dirty pages into one write
+        unsigned int first = page;
+        while ((page < ctx->pageCount) && _FlashCache_pageDirty(line, page)) {
+            page++;
+        }
+        unsigned int offset = first * ctx->pageSize;
+        status = FLASH_write(ctx->backing, line->address + offset, (page - first) * ctx->pageSize, line->data + offset);
+        if (ERR_IS_ERROR(status)) return status;
+        //Clear the pages written so a retry doesn't program them again
+        for (unsigned int done = first; done < page; done++) {
+            line->dirtyPages[done / 32] &= ~(1UL << (done % 32));
+        }
+    }
+    line->dirty = false;
+    return ERR_SUCCESS;
+}
+
+// Get the cache line for a block
+//  - If not cached, the least recently used line is written back and reused.
+//  - If load is true, a newly allocated line is read from the flash.
+static HpsErr_t _FlashCache_getLine(FlashCacheCtx_t* ctx, unsigned int block, bool load, FlashCacheLine_t** pLine) {
+    FlashCacheLine_t* line = _FlashCache_find(ctx, block);
+    if (!line) {
+        //Pick a free line, else the least recently used
+        line = &ctx->lines[0];
+        for (unsigned int idx = 0; (idx < ctx->lineCount) && line->valid; idx++) {
+            FlashCacheLine_t* next = &ctx->lines[idx];
+            if (!next->valid || ((int)(next->lastUsed - line->lastUsed) < 0)) {
+                line = next;
+            }
+        }
+        HpsErr_t status = _FlashCache_flushLine(ctx, line);
+        if (ERR_IS_ERROR(status)) return status;
+        line->valid = false;
+        if (load) {
+            status = FLASH_read(ctx->backing, block, ctx->blockSize, line->data);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        line->address = block;
+        line->dirty = false;
+        line->erase = false;
+        line->valid = true;
+        line->lastUsed = ++ctx->tick;
+    }
+    *pLine = line;
+    return ERR_SUCCESS;
+}
+
+// Start modifying a block
+//  - Writes back the block previously modified if it is a different one, so
+//    sequential writes are programmed at each block boundary.
+static HpsErr_t _FlashCache_moveTo(FlashCacheCtx_t* ctx, unsigned int block) {
+    FlashCacheLine_t* last = ctx->lastLine;
+    if (!last || (last->valid && (last->address == block))) return ERR_SUCCESS;
+    ctx->lastLine = NULL;
+    return _FlashCache_flushLine(ctx, last);
+}
+
+// Check the cache can be modified
+static HpsErr_t _FlashCache_checkWritable(FlashCacheCtx_t* ctx) {
+    HpsErr_t status = FLASH_checkReadOnly(&ctx->flash);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->flash.writeProt) return ERR_WRITEPROT;
+    return ERR_SUCCESS;
+}
+
+// Cleanup function called when driver destroyed.
+//  - Writes back any dirty blocks. Errors can't be reported, so
+//    call FlashCache_flush() first to check.
+static void _FlashCache_cleanup(FlashCacheCtx_t* ctx) {
+    if (ctx->lines) {
+        if (ctx->backing) FlashCache_flush(ctx);
+        for (unsigned int idx = 0; idx < ctx->lineCount; idx++) {
+            MemPool_free(ctx->lines[idx].data);
+            MemPool_free(ctx->lines[idx].dirtyPages);
+        }
+        MemPool_free(ctx->lines);
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Flash Cache
+//  - backing is the flash to cache. It must have a power of two block size.
+//  - lines is the number of blocks to cache.
+//  - pageSize is the program page size of the flash (e.g. 256). It must be a
+//    multiple of the word size, and divide the block size.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t FlashCache_initialise(FlashCtx_t* backing, unsigned int lines, unsigned int pageSize, FlashCacheCtx_t** pCtx) {
+    //Ensure that the backing flash is valid
+    if (!FLASH_isInitialised(backing)) return ERR_BADDEVICE;
+    unsigned int blockSize;
+    unsigned int wordSize;
+    FLASH_blockSize(backing, &blockSize);
+    FLASH_wordSize(backing, &wordSize);
+    if (!lines) return ERR_TOOSMALL;
+    if (!blockSize || (blockSize & (blockSize - 1))) return ERR_NOSUPPORT;
+    if (!pageSize || !wordSize || (pageSize % wordSize) || (blockSize % pageSize)) return ERR_ALIGNMENT;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_FlashCache_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    FlashCacheCtx_t* ctx = *pCtx;
+    ctx->blockSize = blockSize;
+    ctx->pageSize = pageSize;
+    ctx->pageCount = blockSize / pageSize;
+    //Allocate the cache lines
+    ctx->lines = MemPool_calloc(lines, sizeof(FlashCacheLine_t));
+    if (!ctx->lines) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->lineCount = lines;
+    unsigned int words = (ctx->pageCount + 31) / 32;
+    for (unsigned int idx = 0; idx < lines; idx++) {
+        ctx->lines[idx].data = MemPool_malloc(blockSize);
+        ctx->lines[idx].dirtyPages = MemPool_calloc(words, sizeof(uint32_t));
+        if (!ctx->lines[idx].data || !ctx->lines[idx].dirtyPages) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    }
+    //Only write back once everything allocated
+    ctx->backing = backing;
+    //Populate the flash interface
+    ctx->flash.ctx = ctx;
+    ctx->flash.initStatus = ERR_SUCCESS;
+    ctx->flash.wordSize = wordSize;
+    ctx->flash.blockSize = blockSize;
+    ctx->flash.readOnly = backing->readOnly;
+    ctx->flash.writeProt = backing->writeProt;
+    ctx->flash.type = backing->type;
+    ctx->flash.read   = (FlashReadFunc_t )&FlashCache_read;
+    ctx->flash.erase  = (FlashEraseFunc_t)&FlashCache_erase;
+    ctx->flash.write  = (FlashWriteFunc_t)&FlashCache_write;
+    ctx->flash.verify = (FlashWriteFunc_t)&FlashCache_verify;
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool FlashCache_isInitialised(FlashCacheCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Read from the flash through the cache
+HpsErr_t FlashCache_read(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length, uint8_t* dest) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!dest) return ERR_NULLPTR;
+    while (length) {
+        unsigned int block = address & ~(ctx->blockSize - 1);
+        unsigned int offset = address - block;
+        unsigned int chunk = min(length, ctx->blockSize - offset);
+        FlashCacheLine_t* line = _FlashCache_find(ctx, block);
+        if (!line && (chunk == ctx->blockSize)) {
+            //Whole blocks which aren't cached are read directly, as one read
+            while (((chunk + ctx->blockSize) <= length) && !_FlashCache_find(ctx, block + chunk)) {
+                chunk += ctx->blockSize;
+            }
+            status = FLASH_read(ctx->backing, address, chunk, dest);
+            if (ERR_IS_ERROR(status)) return status;
+        } else {
+            if (!line) {
+                status = _FlashCache_getLine(ctx, block, true, &line);
+                if (ERR_IS_ERROR(status)) return status;
+            }
+            memcpy(dest, line->data + offset, chunk);
+        }
+        address += chunk;
+        dest += chunk;
+        length -= chunk;
+    }
+    return ERR_SUCCESS;
+}
+
+// Erase a flash region through the cache
+//  - Address and length must be aligned to the block size.
+//  - Erases of cached blocks are deferred until they are written back.
+HpsErr_t FlashCache_erase(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _FlashCache_checkWritable(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!addressIsAligned(address, ctx->blockSize) || !addressIsAligned(length, ctx->blockSize)) return ERR_ALIGNMENT;
+    while (length) {
+        status = _FlashCache_moveTo(ctx, address);
+        if (ERR_IS_ERROR(status)) return status;
+        unsigned int chunk = ctx->blockSize;
+        FlashCacheLine_t* line = _FlashCache_find(ctx, address);
+        if (line) {
+            //Defer until written back, so following writes are merged with it
+            memset(line->data, 0xFF, ctx->blockSize);
+            line->erase = true;
+            line->dirty = true;
+            ctx->lastLine = line;
+        } else {
+            //Pass runs of blocks which aren't cached straight to the flash
+            while ((chunk < length) && !_FlashCache_find(ctx, address + chunk)) {
+                chunk += ctx->blockSize;
+            }
+            status = FLASH_erase(ctx->backing, address, chunk);
+            if (ERR_IS_ERROR(status)) return status;
+        }
+        address += chunk;
+        length -= chunk;
+    }
+    return ERR_SUCCESS;
+}
+
+// Write to a flash region through the cache
+//  - Address and length must be aligned to the word size.
+//  - As with the flash, bits can only be cleared unless erased first.
+HpsErr_t FlashCache_write(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!src) return ERR_NULLPTR;
+    status = _FlashCache_checkWritable(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ERR_IS_ERROR(FLASH_checkAlignment(&ctx->flash, address)) || ERR_IS_ERROR(FLASH_checkAlignment(&ctx->flash, length))) return ERR_ALIGNMENT;
+    while (length) {
+        unsigned int block = address & ~(ctx->blockSize - 1);
+        unsigned int offset = address - block;
+        unsigned int chunk = min(length, ctx->blockSize - offset);
+        status = _FlashCache_moveTo(ctx, block);
+        if (ERR_IS_ERROR(status)) return status;
+        FlashCacheLine_t* line;
+        status = _FlashCache_getLine(ctx, block, true, &line);
+        if (ERR_IS_ERROR(status)) return status;
+        //Programming can only clear bits
+        uint8_t* data = line->data + offset;
+        for (unsigned int idx = 0; idx < chunk; idx++) {
+            data[idx] &= src[idx];
+        }
+        _FlashCache_markPages(ctx, line, offset, chunk);
+        line->dirty = true;
+        ctx->lastLine = line;
+        address += chunk;
+        src += chunk;
+        length -= chunk;
+    }
+    return ERR_SUCCESS;
+}
+
+// Verify a flash region
+//  - Writes back all dirty blocks, then verifies the flash itself.
+HpsErr_t FlashCache_verify(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Write back everything so the flash holds what was written
+    status = FlashCache_flush(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return FLASH_verify(ctx->backing, address, length, src);
+}
+
+// Write back all dirty blocks
+//  - Returns the first error encountered, if any.
+HpsErr_t FlashCache_flush(FlashCacheCtx_t* ctx) {
+    //Ensure context valid. Also called during cleanup before initialised.
+    if (!ctx) return ERR_NULLPTR;
+    if (!ctx->lines || !ctx->backing) return ERR_NOINIT;
+    HpsErr_t result = ERR_SUCCESS;
+    for (unsigned int idx = 0; idx < ctx->lineCount; idx++) {
+        HpsErr_t status = _FlashCache_flushLine(ctx, &ctx->lines[idx]);
+        if (ERR_IS_SUCCESS(result)) result = status;
+    }
+    ctx->lastLine = NULL;
+    return result;
+}
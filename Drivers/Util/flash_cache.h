@@ -0,0 +1,126 @@
+/*
+ * Flash Block Cache
+ * -----------------
+ *
+ * Wraps a flash driver (FlashCtx_t) with a write-back cache of
+ * recently used blocks, itself providing a FlashCtx_t which can
+ * be used in place of the underlying flash:
+ *
+ *    FlashCache_initialise(&nor->flash, 4, 256, &cache);
+ *    FLASH_read(&cache->flash, address, length, buffer);
+ *    ...
+ *    FlashCache_flush(cache);
+ *
+ * Reads
+ * -----
+ *
+ * Partial block reads load the block into the cache, so small
+ * repeated reads are served from RAM. Reads of whole blocks which
+ * are not cached go straight to the flash, so that bulk reads
+ * don't evict the working set.
+ *
+ * Writes and Erases
+ * -----------------
+ *
+ * Writes are merged into the cached block. As with NOR flash,
+ * writing can only clear bits, so the cached data is what the
+ * flash would hold. Erasing a cached block is deferred. When a
+ * dirty block is written back, it is erased if needed, then its
+ * modified pages are programmed, with consecutive pages combined
+ * into one write. So an erase followed by a series of small writes
+ * (e.g. updating a config block) costs one erase and the pages
+ * programmed, rather than one program per write.
+ *
+ * Dirty blocks are written back when evicted, when a write or
+ * erase moves on to a different block (so sequential logs are
+ * written back at each block boundary), when FlashCache_flush()
+ * is called, and when the cache is destroyed. Erases of blocks
+ * which are not cached are passed straight to the flash.
+ *
+ * Errors from deferred operations are reported by the call which
+ * causes the write-back.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef FLASH_CACHE_H_
+#define FLASH_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_flash.h"
+#include "Util/error.h"
+
+// Cached block
+typedef struct {
+    uint8_t*     data;
+    uint32_t*    dirtyPages;  // Bitmap of pages which need programming
+    unsigned int address;     // Start address of block
+    unsigned int lastUsed;
+    bool         valid;
+    bool         dirty;
+    bool         erase;       // Block must be erased before programming
+} FlashCacheLine_t;
+
+// Flash Cache Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    FlashCtx_t*       backing;
+    FlashCtx_t        flash;      // Cached flash interface
+    unsigned int      blockSize;
+    unsigned int      pageSize;
+    unsigned int      pageCount;  // Pages per block
+    FlashCacheLine_t* lines;
+    unsigned int      lineCount;
+    unsigned int      tick;
+    FlashCacheLine_t* lastLine;   // Block last written or erased
+} FlashCacheCtx_t;
+
+// Initialise Flash Cache
+//  - backing is the flash to cache. It must have a power of two block size.
+//  - lines is the number of blocks to cache.
+//  - pageSize is the program page size of the flash (e.g. 256). It must be a
+//    multiple of the word size, and divide the block size.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t FlashCache_initialise(FlashCtx_t* backing, unsigned int lines, unsigned int pageSize, FlashCacheCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool FlashCache_isInitialised(FlashCacheCtx_t* ctx);
+
+// Read from the flash through the cache
+HpsErr_t FlashCache_read(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length, uint8_t* dest);
+
+// Erase a flash region through the cache
+//  - Address and length must be aligned to the block size.
+//  - Erases of cached blocks are deferred until they are written back.
+HpsErr_t FlashCache_erase(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length);
+
+// Write to a flash region through the cache
+//  - Address and length must be aligned to the word size.
+//  - As with the flash, bits can only be cleared unless erased first.
+HpsErr_t FlashCache_write(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src);
+
+// Verify a flash region
+//  - Writes back all dirty blocks, then verifies the flash itself.
+HpsErr_t FlashCache_verify(FlashCacheCtx_t* ctx, unsigned int address, unsigned int length, const uint8_t* src);
+
+// Write back all dirty blocks
+//  - Returns the first error encountered, if any.
+HpsErr_t FlashCache_flush(FlashCacheCtx_t* ctx);
+
+#endif /* FLASH_CACHE_H_ */
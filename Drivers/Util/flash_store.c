@@ -0,0 +1,553 @@
+/*
+ * Flash Record Store
+ * ------------------
+ *
+ * Log structured key-value store over a flash driver (FlashCtx_t)
+ * for configuration and telemetry values.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "flash_store.h"
+#include "Util/mem_pool.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "Util/crc32.h"
+#include "Util/macros.h"
+
+// Largest supported record alignment
+#define FLASH_STORE_MAX_ALIGN 16
+
+// Result of checking a record header
+typedef enum {
+    FLASH_STORE_REC_VALID,
+    FLASH_STORE_REC_END,     // Blank, end of the log in this sector
+    FLASH_STORE_REC_CLOSED,  // Sector closed early
+    FLASH_STORE_REC_BAD
+} FlashStoreRecCheck;
+
+/*
+ * Internal Functions
+ */
+
+static inline unsigned int _FlashStore_alignUp(FlashStoreCtx_t* ctx, unsigned int val) {
+    return (val + ctx->align - 1) & ~(ctx->align - 1);
+}
+
+static inline unsigned int _FlashStore_address(FlashStoreCtx_t* ctx, unsigned int sector, unsigned int pos) {
+    return ctx->base + (sector * ctx->sectorSize) + pos;
+}
+
+// Size of a record in flash, including header and padding
+static inline unsigned int _FlashStore_recordSize(FlashStoreCtx_t* ctx, unsigned int length) {
+    if (length == FLASH_STORE_TOMBSTONE) length = 0;
+    return _FlashStore_alignUp(ctx, sizeof(FlashStoreRecord_t) + length);
+}
+
+// CRC of a record, covering the key, length and data
+static uint32_t _FlashStore_crc(const FlashStoreRecord_t* rec, const uint8_t* data) {
+    uint32_t crc = crc32(0, (const uint8_t*)rec, offsetof(FlashStoreRecord_t, crc));
+    if ((rec->length != FLASH_STORE_TOMBSTONE) && rec->length) {
+        crc = crc32(crc, data, rec->length);
+    }
+    return crc;
+}
+
+// Check a record header found at pos in a sector
+//  - Returns the record size to *size if valid.
+static FlashStoreRecCheck _FlashStore_checkRecord(FlashStoreCtx_t* ctx, const FlashStoreRecord_t* rec, unsigned int pos, unsigned int* size) {
+    if ((rec->key == 0xFFFF) && (rec->length == 0xFFFF) && (rec->crc == 0xFFFFFFFF)) return FLASH_STORE_REC_END;
+    if (!rec->key && !rec->length && !rec->crc) return FLASH_STORE_REC_CLOSED;
+    if (rec->key == 0xFFFF) return FLASH_STORE_REC_BAD;
+    *size = _FlashStore_recordSize(ctx, rec->length);
+    if ((pos + *size) > ctx->sectorSize) return FLASH_STORE_REC_BAD;
+    return FLASH_STORE_REC_VALID;
+}
+
+// Close a sector at pos
+//  - Overwrites whatever is there with zeros, which can always be programmed,
+//    marking the rest of the sector as unused.
+static HpsErr_t _FlashStore_closeSector(FlashStoreCtx_t* ctx, unsigned int sector, unsigned int pos) {
+    static const uint8_t zeros[FLASH_STORE_MAX_ALIGN] = {0};
+    return FLASH_write(ctx->flash, _FlashStore_address(ctx, sector, pos), _FlashStore_alignUp(ctx, sizeof(FlashStoreRecord_t)), zeros);
+}
+
+// Open a new sector for appending
+//  - Picks the next free sector after the active one, to spread wear.
+static HpsErr_t _FlashStore_openSector(FlashStoreCtx_t* ctx) {
+    unsigned int sector = ctx->active;
+    for (unsigned int idx = 0; idx < ctx->sectorCount; idx++) {
+        sector = (sector + 1) % ctx->sectorCount;
+        if (!ctx->sectors[sector].inUse) break;
+    }
+    FlashStoreSectorState_t* state = &ctx->sectors[sector];
+    if (state->inUse) return ERR_NOSPACE;
+    HpsErr_t status;
+    unsigned int address = _FlashStore_address(ctx, sector, 0);
+    if (!state->erased) {
+        status = FLASH_erase(ctx->flash, address, ctx->sectorSize);
+        if (ERR_IS_ERROR(status)) return status;
+        state->erased = true;
+    }
+    //Write the sector header
+    uint8_t header[FLASH_STORE_MAX_ALIGN];
+    memset(header, 0xFF, sizeof(header));
+    FlashStoreSector_t* sectorHdr = (FlashStoreSector_t*)header;
+    sectorHdr->magic = FLASH_STORE_MAGIC;
+    sectorHdr->seq = ctx->seq + 1;
+    state->erased = false;
+    status = FLASH_write(ctx->flash, address, ctx->hdrSize, header);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->seq++;
+    state->seq = ctx->seq;
+    state->inUse = true;
+    ctx->freeCount--;
+    ctx->active = sector;
+    ctx->writePos = ctx->hdrSize;
+    return ERR_SUCCESS;
+}
+
+// Append the record staged in the buffer
+//  - Space must have been reserved first.
+//  - Returns the address of the record.
+static HpsErr_t _FlashStore_append(FlashStoreCtx_t* ctx, unsigned int size, unsigned int* address) {
+    *address = _FlashStore_address(ctx, ctx->active, ctx->writePos);
+    HpsErr_t status = FLASH_write(ctx->flash, *address, size, ctx->buf);
+    if (ERR_IS_ERROR(status)) {
+        //May be partly programmed. Don't append after it.
+        ctx->writePos = ctx->sectorSize;
+        return status;
+    }
+    ctx->writePos += size;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _FlashStore_reserve(FlashStoreCtx_t* ctx, unsigned int size, bool compacting);
+
+// Run one step of compaction
+//  - Continues compacting the oldest sector, copying up to *budget live records,
+//    then erases it once all are copied. Erasing uses one from the budget.
+//  - Returns ERR_ISEMPTY if there is nothing to compact.
+static HpsErr_t _FlashStore_compactStep(FlashStoreCtx_t* ctx, unsigned int* budget) {
+    HpsErr_t status;
+    if (!ctx->compact.running) {
+        //Find the oldest sector in use
+        unsigned int oldest = ctx->sectorCount;
+        for (unsigned int idx = 0; idx < ctx->sectorCount; idx++) {
+            if (!ctx->sectors[idx].inUse) continue;
+            if ((oldest == ctx->sectorCount) || ((int32_t)(ctx->sectors[idx].seq - ctx->sectors[oldest].seq) < 0)) {
+                oldest = idx;
+            }
+        }
+        if (oldest == ctx->sectorCount) return ERR_ISEMPTY;
+        //If it is the only one, close it so the copies go to a new sector
+        if (oldest == ctx->active) {
+            ctx->writePos = ctx->sectorSize;
+        }
+        ctx->compact.running = true;
+        ctx->compact.sector = oldest;
+        ctx->compact.pos = ctx->hdrSize;
+    }
+    unsigned int sector = ctx->compact.sector;
+    while (*budget) {
+        unsigned int pos = ctx->compact.pos;
+        unsigned int address = _FlashStore_address(ctx, sector, pos);
+        unsigned int size = 0;
+        FlashStoreRecord_t rec;
+        if ((pos + sizeof(rec)) > ctx->sectorSize) break;
+        status = FLASH_read(ctx->flash, address, sizeof(rec), (uint8_t*)&rec);
+        if (ERR_IS_ERROR(status)) return status;
+        if (_FlashStore_checkRecord(ctx, &rec, pos, &size) != FLASH_STORE_REC_VALID) break;
+        //Copy if live. Tombstones in the oldest sector have nothing older to hide.
+        FlashStoreIndex_t* entry = (rec.key < ctx->keyCount) ? &ctx->index[rec.key] : NULL;
+        if ((rec.length != FLASH_STORE_TOMBSTONE) && entry && (entry->address == address)) {
+            status = FLASH_read(ctx->flash, address, size, ctx->buf);
+            if (ERR_IS_ERROR(status)) return status;
+            const FlashStoreRecord_t* copy = (const FlashStoreRecord_t*)ctx->buf;
+            if (_FlashStore_crc(copy, ctx->buf + sizeof(rec)) != copy->crc) {
+                //Corrupt, so the value is lost
+                entry->address = 0;
+                ctx->liveBytes -= size;
+            } else {
+                status = _FlashStore_reserve(ctx, size, true);
+                if (ERR_IS_ERROR(status)) return status;
+                unsigned int newAddress;
+                status = _FlashStore_append(ctx, size, &newAddress);
+                if (ERR_IS_ERROR(status)) return status;
+                entry->address = newAddress;
+            }
+            (*budget)--;
+        }
+        ctx->compact.pos = pos + size;
+    }
+    if (!*budget) return ERR_SUCCESS;
+    //All live records copied, so reclaim the sector
+    status = FLASH_erase(ctx->flash, _FlashStore_address(ctx, sector, 0), ctx->sectorSize);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->sectors[sector].inUse = false;
+    ctx->sectors[sector].erased = true;
+    ctx->freeCount++;
+    ctx->compact.running = false;
+    (*budget)--;
+    return ERR_SUCCESS;
+}
+
+// Reserve space for a record of size bytes in the active sector
+//  - Opens a new sector if needed. Writes always leave one free sector so
+//    that compaction has somewhere to copy to, and if there isn't one they
+//    compact in the foreground until there is room.
+static HpsErr_t _FlashStore_reserve(FlashStoreCtx_t* ctx, unsigned int size, bool compacting) {
+    unsigned int attempts = ctx->sectorCount + 1;
+    while ((ctx->writePos + size) > ctx->sectorSize) {
+        if (compacting || (ctx->freeCount > 1)) {
+            return _FlashStore_openSector(ctx);
+        }
+        if (!attempts--) return ERR_NOSPACE;
+        unsigned int budget = UINT_MAX;
+        HpsErr_t status = _FlashStore_compactStep(ctx, &budget);
+        if (status == ERR_ISEMPTY) return ERR_NOSPACE;
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ERR_SUCCESS;
+}
+
+// Check the store can be modified
+static HpsErr_t _FlashStore_checkWritable(FlashStoreCtx_t* ctx) {
+    if (ctx->readOnly) return ERR_WRONGMODE;
+    if (ctx->flash->writeProt) return ERR_WRITEPROT;
+    return ERR_SUCCESS;
+}
+
+// Replay one sector into the index
+//  - If newest, every record is checked against its CRC, and the sector
+//    closed at the first bad one.
+//  - Returns the offset after the last record.
+static HpsErr_t _FlashStore_replay(FlashStoreCtx_t* ctx, unsigned int sector, bool newest, unsigned int* end) {
+    HpsErr_t status;
+    unsigned int pos = ctx->hdrSize;
+    while ((pos + sizeof(FlashStoreRecord_t)) <= ctx->sectorSize) {
+        unsigned int address = _FlashStore_address(ctx, sector, pos);
+        unsigned int size = 0;
+        FlashStoreRecord_t rec;
+        status = FLASH_read(ctx->flash, address, sizeof(rec), (uint8_t*)&rec);
+        if (ERR_IS_ERROR(status)) return status;
+        FlashStoreRecCheck check = _FlashStore_checkRecord(ctx, &rec, pos, &size);
+        if (check == FLASH_STORE_REC_END) break;
+        if ((check == FLASH_STORE_REC_VALID) && newest) {
+            status = FLASH_read(ctx->flash, address, size, ctx->buf);
+            if (ERR_IS_ERROR(status)) return status;
+            if (_FlashStore_crc(&rec, ctx->buf + sizeof(rec)) != rec.crc) check = FLASH_STORE_REC_BAD;
+        }
+        if (check != FLASH_STORE_REC_VALID) {
+            //Interrupted write. Close it so it isn't replayed once no longer newest.
+            if ((check == FLASH_STORE_REC_BAD) && newest && !ctx->readOnly) {
+                status = _FlashStore_closeSector(ctx, sector, pos);
+                if (ERR_IS_ERROR(status)) return status;
+            }
+            pos = ctx->sectorSize;
+            break;
+        }
+        //Newer records replace older ones. Unknown keys are skipped.
+        if (rec.key < ctx->keyCount) {
+            FlashStoreIndex_t* entry = &ctx->index[rec.key];
+            if (rec.length == FLASH_STORE_TOMBSTONE) {
+                entry->address = 0;
+            } else {
+                entry->address = address;
+                entry->length = rec.length;
+            }
+        }
+        pos += size;
+    }
+    *end = pos;
+    return ERR_SUCCESS;
+}
+
+// Mount the store, rebuilding the index
+static HpsErr_t _FlashStore_mount(FlashStoreCtx_t* ctx) {
+    HpsErr_t status;
+    unsigned int* order = MemPool_malloc(ctx->sectorCount * sizeof(unsigned int));
+    if (!order) return ERR_ALLOCFAIL;
+    //Read sector headers, sorting those in use by sequence number
+    unsigned int used = 0;
+    ctx->freeCount = 0;
+    for (unsigned int sector = 0; sector < ctx->sectorCount; sector++) {
+        FlashStoreSectorState_t* state = &ctx->sectors[sector];
+        FlashStoreSector_t hdr;
+        status = FLASH_read(ctx->flash, _FlashStore_address(ctx, sector, 0), sizeof(hdr), (uint8_t*)&hdr);
+        if (ERR_IS_ERROR(status)) {
+            MemPool_free(order);
+            return status;
+        }
+        state->inUse = false;
+        state->erased = false;
+        if (hdr.magic == FLASH_STORE_MAGIC) {
+            state->inUse = true;
+            state->seq = hdr.seq;
+            unsigned int idx = used++;
+            while (idx && ((int32_t)(hdr.seq - ctx->sectors[order[idx - 1]].seq) < 0)) {
+                order[idx] = order[idx - 1];
+                idx--;
+            }
+            order[idx] = sector;
+            continue;
+        }
+        if (((hdr.magic != 0xFFFFFFFF) || (hdr.seq != 0xFFFFFFFF)) && !ctx->readOnly) {
+            //Corrupt header
+            status = FLASH_erase(ctx->flash, _FlashStore_address(ctx, sector, 0), ctx->sectorSize);
+            if (ERR_IS_ERROR(status)) {
+                MemPool_free(order);
+                return status;
+            }
+            state->erased = true;
+        }
+        ctx->freeCount++;
+    }
+    //Replay oldest to newest
+    ctx->seq = 0;
+    ctx->active = 0;
+    ctx->writePos = ctx->sectorSize;
+    for (unsigned int idx = 0; idx < used; idx++) {
+        bool newest = (idx == (used - 1));
+        unsigned int end;
+        status = _FlashStore_replay(ctx, order[idx], newest, &end);
+        if (ERR_IS_ERROR(status)) {
+            MemPool_free(order);
+            return status;
+        }
+        if (newest) {
+            ctx->seq = ctx->sectors[order[idx]].seq;
+            ctx->active = order[idx];
+            ctx->writePos = end;
+        }
+    }
+    MemPool_free(order);
+    //Total size of the live records
+    ctx->liveBytes = 0;
+    for (unsigned int key = 0; key < ctx->keyCount; key++) {
+        if (ctx->index[key].address) {
+            ctx->liveBytes += _FlashStore_recordSize(ctx, ctx->index[key].length);
+        }
+    }
+    //Format if empty
+    if (!used && !ctx->readOnly) {
+        ctx->active = ctx->sectorCount - 1;
+        return _FlashStore_openSector(ctx);
+    }
+    return ERR_SUCCESS;
+}
+
+// Append a record for the key
+//  - data is NULL for a tombstone.
+static HpsErr_t _FlashStore_put(FlashStoreCtx_t* ctx, unsigned int key, const void* data, unsigned int length) {
+    FlashStoreIndex_t* entry = &ctx->index[key];
+    unsigned int size = _FlashStore_recordSize(ctx, length);
+    unsigned int oldSize = entry->address ? _FlashStore_recordSize(ctx, entry->length) : 0;
+    //Live records must fit, leaving a sector for compaction
+    if ((ctx->liveBytes - oldSize + size) > ((ctx->sectorCount - 1) * (ctx->sectorSize - ctx->hdrSize))) return ERR_NOSPACE;
+    HpsErr_t status = _FlashStore_reserve(ctx, size, false);
+    if (ERR_IS_ERROR(status)) return status;
+    //Stage the record after reserving, as compaction uses the buffer
+    FlashStoreRecord_t* rec = (FlashStoreRecord_t*)ctx->buf;
+    memset(ctx->buf, 0xFF, size);
+    rec->key = key;
+    rec->length = length;
+    if (data) memcpy(ctx->buf + sizeof(*rec), data, length);
+    rec->crc = _FlashStore_crc(rec, ctx->buf + sizeof(*rec));
+    unsigned int address;
+    status = _FlashStore_append(ctx, size, &address);
+    if (ERR_IS_ERROR(status)) return status;
+    //Update the index
+    ctx->liveBytes -= oldSize;
+    if (data) {
+        entry->address = address;
+        entry->length = length;
+        ctx->liveBytes += size;
+    } else {
+        entry->address = 0;
+    }
+    return ERR_SUCCESS;
+}
+
+// Cleanup function called when driver destroyed.
+static void _FlashStore_cleanup(FlashStoreCtx_t* ctx) {
+    MemPool_free(ctx->index);
+    MemPool_free(ctx->sectors);
+    MemPool_free(ctx->buf);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Flash Store
+//  - Mounts the store held in flash, from base for size bytes. Both must be
+//    aligned to the flash block size, with at least two blocks.
+//  - keyCount is the number of keys, which are numbered 0 to keyCount-1.
+//  - Formats the region if it doesn't hold a store.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t FlashStore_initialise(FlashCtx_t* flash, unsigned int base, unsigned int size, unsigned int keyCount, FlashStoreCtx_t** pCtx) {
+    //Ensure that the flash is valid
+    if (!FLASH_isInitialised(flash)) return ERR_BADDEVICE;
+    unsigned int blockSize;
+    unsigned int wordSize;
+    FLASH_blockSize(flash, &blockSize);
+    FLASH_wordSize(flash, &wordSize);
+    unsigned int align = max(wordSize, sizeof(uint32_t));
+    if ((align & (align - 1)) || (align > FLASH_STORE_MAX_ALIGN)) return ERR_NOSUPPORT;
+    if (!blockSize || (blockSize % align) || (blockSize > 0x10000)) return ERR_NOSUPPORT;
+    if ((base % blockSize) || (size % blockSize)) return ERR_ALIGNMENT;
+    if ((size / blockSize) < 2) return ERR_TOOSMALL;
+    if (!keyCount || (keyCount > 0xFFFF)) return ERR_OUTRANGE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_FlashStore_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    FlashStoreCtx_t* ctx = *pCtx;
+    ctx->flash = flash;
+    ctx->base = base;
+    ctx->sectorSize = blockSize;
+    ctx->sectorCount = size / blockSize;
+    ctx->align = align;
+    ctx->hdrSize = _FlashStore_alignUp(ctx, sizeof(FlashStoreSector_t));
+    ctx->keyCount = keyCount;
+    ctx->readOnly = flash->readOnly;
+    ctx->target = (ctx->sectorCount > 2) ? 2 : 1;
+    if ((ctx->hdrSize + _FlashStore_recordSize(ctx, 0)) > blockSize) return DriverContextInitFail(pCtx, ERR_NOSUPPORT);
+    //Allocate index and buffers
+    ctx->index = MemPool_calloc(keyCount, sizeof(FlashStoreIndex_t));
+    ctx->sectors = MemPool_calloc(ctx->sectorCount, sizeof(FlashStoreSectorState_t));
+    ctx->buf = MemPool_malloc(blockSize);
+    if (!ctx->index || !ctx->sectors || !ctx->buf) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    //Rebuild the index from flash
+    status = _FlashStore_mount(ctx);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool FlashStore_isInitialised(FlashStoreCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Write a value
+//  - Appends a record replacing any previous value of the key.
+//  - length may be 0. The largest length is returned by FlashStore_maxLength().
+//  - Returns ERR_NOSPACE if the live values would not fit.
+HpsErr_t FlashStore_write(FlashStoreCtx_t* ctx, unsigned int key, const void* data, unsigned int length) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!data && length) return ERR_NULLPTR;
+    status = _FlashStore_checkWritable(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (key >= ctx->keyCount) return ERR_OUTRANGE;
+    if (length > (unsigned int)FlashStore_maxLength(ctx)) return ERR_TOOBIG;
+    return _FlashStore_put(ctx, key, data ? data : "", length);
+}
+
+// Read a value
+//  - Copies the value into data, which holds size bytes.
+//  - Returns the length of the value, or ERR_NOTFOUND if the key has no value.
+//  - Returns ERR_TOOSMALL if size is less than the length.
+//  - Returns ERR_CHECKSUM if the record is corrupt.
+HpsErr_t FlashStore_read(FlashStoreCtx_t* ctx, unsigned int key, void* data, unsigned int size) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!data && size) return ERR_NULLPTR;
+    if (key >= ctx->keyCount) return ERR_OUTRANGE;
+    FlashStoreIndex_t* entry = &ctx->index[key];
+    if (!entry->address) return ERR_NOTFOUND;
+    if (size < entry->length) return ERR_TOOSMALL;
+    //Read header and data, checking the CRC
+    FlashStoreRecord_t rec;
+    status = FLASH_read(ctx->flash, entry->address, sizeof(rec), (uint8_t*)&rec);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((rec.key != key) || (rec.length != entry->length)) return ERR_CHECKSUM;
+    if (rec.length) {
+        status = FLASH_read(ctx->flash, entry->address + sizeof(rec), rec.length, (uint8_t*)data);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    if (_FlashStore_crc(&rec, (const uint8_t*)data) != rec.crc) return ERR_CHECKSUM;
+    return rec.length;
+}
+
+// Get the length of a value
+//  - Returns the length, or ERR_NOTFOUND if the key has no value.
+HpsErr_t FlashStore_length(FlashStoreCtx_t* ctx, unsigned int key) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (key >= ctx->keyCount) return ERR_OUTRANGE;
+    if (!ctx->index[key].address) return ERR_NOTFOUND;
+    return ctx->index[key].length;
+}
+
+// Delete a value
+//  - Returns ERR_NOTFOUND if the key has no value.
+HpsErr_t FlashStore_delete(FlashStoreCtx_t* ctx, unsigned int key) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _FlashStore_checkWritable(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (key >= ctx->keyCount) return ERR_OUTRANGE;
+    if (!ctx->index[key].address) return ERR_NOTFOUND;
+    return _FlashStore_put(ctx, key, NULL, FLASH_STORE_TOMBSTONE);
+}
+
+// Largest value length
+HpsErr_t FlashStore_maxLength(FlashStoreCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int length = ctx->sectorSize - ctx->hdrSize - sizeof(FlashStoreRecord_t);
+    return min(length, FLASH_STORE_TOMBSTONE - 1);
+}
+
+// Set the number of free sectors compaction maintains
+//  - Default is 2, or 1 for a two sector store.
+HpsErr_t FlashStore_setCompactTarget(FlashStoreCtx_t* ctx, unsigned int freeSectors) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!freeSectors || (freeSectors >= ctx->sectorCount)) return ERR_OUTRANGE;
+    ctx->target = freeSectors;
+    return ERR_SUCCESS;
+}
+
+// Run background compaction
+//  - Copies up to budget live records (erasing a sector counts as one),
+//    while fewer than the target number of sectors are free.
+//  - Returns the number of sectors still to be reclaimed, 0 when done.
+HpsErr_t FlashStore_compact(FlashStoreCtx_t* ctx, unsigned int budget) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    status = _FlashStore_checkWritable(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Finish any sector started, even once the target is reached
+    while (budget && (ctx->compact.running || (ctx->freeCount < ctx->target))) {
+        status = _FlashStore_compactStep(ctx, &budget);
+        if (status == ERR_ISEMPTY) return 0;
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    if (ctx->freeCount < ctx->target) return ctx->target - ctx->freeCount;
+    return ctx->compact.running ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * Flash Record Store
+ * ------------------
+ *
+ * Log structured key-value store over a flash driver (FlashCtx_t)
+ * for configuration and telemetry values. Rather than rewriting
+ * a whole block for every change, each write appends a record
+ * to the log, and an index in RAM points at the newest record
+ * for each key:
+ *
+ *    crc32_setCtx(crc);
+ *    FlashStore_initialise(&nor->flash, 0x100000, 0x10000, 64, &store);
+ *    FlashStore_write(store, KEY_GAIN, &gain, sizeof(gain));
+ *    FlashStore_read(store, KEY_GAIN, &gain, sizeof(gain));
+ *
+ * Keys are numbers from 0 up to the key count given when initialising.
+ * The index holds one entry per key, so size it for the keys in use.
+ *
+ * Layout
+ * ------
+ *
+ * The store region is split into sectors, each one flash block. A
+ * sector starts with a header holding a sequence number, followed
+ * by records. Each record has a header with its key, length and a
+ * CRC32 (Util/crc32.h) of the key, length and data, then the data
+ * padded to the word size (at least 4 bytes). Deleting a key appends
+ * a tombstone record. Records are appended to the newest sector until
+ * it is full, then the next free sector is opened.
+ *
+ * Writes are a single program of the record, with erases only done
+ * when a whole sector is reclaimed.
+ *
+ * Mounting
+ * --------
+ *
+ * When initialised, the sectors are replayed in sequence order to
+ * rebuild the index. Only record headers are read, apart from the
+ * newest sector whose records are all checked against their CRC,
+ * so the boot time is bounded by the number of records plus one
+ * sector. A write which was interrupted part way through can only be
+ * in the newest sector. If one is found, the sector is closed so
+ * appends continue in a new sector. Reads always check the CRC.
+ *
+ * If the region holds no store, it is formatted. Sectors with a
+ * corrupt header are erased.
+ *
+ * Compaction
+ * ----------
+ *
+ * Old sectors fill with records superseded by newer ones. These are
+ * reclaimed by copying the live records in the oldest sector to the
+ * end of the log, then erasing it. Compaction is incremental: call
+ * FlashStore_compact() periodically from the main loop (or a work
+ * item) with a budget of records to copy, so that enough sectors are
+ * kept free that writes never wait for an erase. If a write needs
+ * space and none is free, compaction runs in the foreground.
+ *
+ * Note: crc32_setCtx() must be called before use, unless the
+ * software failback is enabled in crc32.c.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef FLASH_STORE_H_
+#define FLASH_STORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_flash.h"
+#include "Util/error.h"
+
+// Sector header magic number ("FSTR")
+#define FLASH_STORE_MAGIC      0x52545346
+
+// Record length used for tombstones
+#define FLASH_STORE_TOMBSTONE  0xFFFF
+
+// Sector header, at the start of each sector
+typedef struct {
+    uint32_t magic;
+    uint32_t seq;       // Increments each time a sector is opened
+} FlashStoreSector_t;
+
+// Record header, followed by the data
+typedef struct {
+    uint16_t key;
+    uint16_t length;    // Data bytes, or FLASH_STORE_TOMBSTONE if deleted
+    uint32_t crc;       // CRC32 of key, length and data
+} FlashStoreRecord_t;
+
+// Index entry
+//  - address is 0 if the key has no value.
+typedef struct {
+    uint32_t address;
+    uint16_t length;
+} FlashStoreIndex_t;
+
+// Sector state
+typedef struct {
+    uint32_t seq;
+    bool     inUse;
+    bool     erased;    // Known to be erased
+} FlashStoreSectorState_t;
+
+// Flash Store Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    FlashCtx_t*              flash;
+    unsigned int             base;
+    unsigned int             sectorSize;
+    unsigned int             sectorCount;
+    unsigned int             align;        // Record alignment
+    unsigned int             hdrSize;      // Sector header size, aligned
+    unsigned int             keyCount;
+    bool                     readOnly;
+    FlashStoreIndex_t*       index;
+    FlashStoreSectorState_t* sectors;
+    uint8_t*                 buf;          // Record staging, one sector
+    // Log head
+    uint32_t                 seq;
+    unsigned int             active;       // Sector being appended to
+    unsigned int             writePos;     // Offset of next record in active sector
+    unsigned int             freeCount;
+    unsigned int             liveBytes;    // Size of records in the index
+    // Compaction
+    unsigned int             target;       // Free sectors for compaction to maintain
+    struct {
+        bool                 running;
+        unsigned int         sector;
+        unsigned int         pos;
+    } compact;
+} FlashStoreCtx_t;
+
+// Initialise Flash Store
+//  - Mounts the store held in flash, from base for size bytes. Both must be
+//    aligned to the flash block size, with at least two blocks.
+//  - keyCount is the number of keys, which are numbered 0 to keyCount-1.
+//  - Formats the region if it doesn't hold a store.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t FlashStore_initialise(FlashCtx_t* flash, unsigned int base, unsigned int size, unsigned int keyCount, FlashStoreCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool FlashStore_isInitialised(FlashStoreCtx_t* ctx);
+
+// Write a value
+//  - Appends a record replacing any previous value of the key.
+//  - length may be 0. The largest length is returned by FlashStore_maxLength().
+//  - Returns ERR_NOSPACE if the live values would not fit.
+HpsErr_t FlashStore_write(FlashStoreCtx_t* ctx, unsigned int key, const void* data, unsigned int length);
+
+// Read a value
+//  - Copies the value into data, which holds size bytes.
+//  - Returns the length of the value, or ERR_NOTFOUND if the key has no value.
+//  - Returns ERR_TOOSMALL if size is less than the length.
+//  - Returns ERR_CHECKSUM if the record is corrupt.
+HpsErr_t FlashStore_read(FlashStoreCtx_t* ctx, unsigned int key, void* data, unsigned int size);
+
+// Get the length of a value
+//  - Returns the length, or ERR_NOTFOUND if the key has no value.
+HpsErr_t FlashStore_length(FlashStoreCtx_t* ctx, unsigned int key);
+
+// Delete a value
+//  - Returns ERR_NOTFOUND if the key has no value.
+HpsErr_t FlashStore_delete(FlashStoreCtx_t* ctx, unsigned int key);
+
+// Largest value length
+HpsErr_t FlashStore_maxLength(FlashStoreCtx_t* ctx);
+
+// Set the number of free sectors compaction maintains
+//  - Default is 2, or 1 for a two sector store.
+HpsErr_t FlashStore_setCompactTarget(FlashStoreCtx_t* ctx, unsigned int freeSectors);
+
+// Run background compaction
+//  - Copies up to budget live records (erasing a sector counts as one),
+//    while fewer than the target number of sectors are free.
+//  - Returns the number of sectors still to be reclaimed, 0 when done.
+HpsErr_t FlashStore_compact(FlashStoreCtx_t* ctx, unsigned int budget);
+
+#endif /* FLASH_STORE_H_ */
@@ -0,0 +1,240 @@
+/*
+ * HPS-to-FPGA Bridge Access
+ * -------------------------
+ *
+ * Helpers for moving bulk data over the heavyweight HPS-to-FPGA
+ * (H2F) AXI bridge, e.g. to feed FPGA accelerators or to fill
+ * framebuffers held in FPGA memory.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add FpgaBridge_sync for posted Device writes.
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "fpga_bridge.h"
+
+#include "Util/macros.h"
+#include "Util/memcpy_v.h"
+
+/*
+ * Internal Functions
+ */
+
+#if defined(__arm__) && !defined(__ARRIA10__)
+#define FPGA_BRIDGE_SUPPORTED
+#endif
+
+#if defined(FPGA_BRIDGE_SUPPORTED)
+
+// Register definitions from HWLib for reset manager and FPGA manager
+#include "Util/hwlib/cv/socal/hps.h"
+#include "Util/hwlib/cv/socal/alt_rstmgr.h"
+#include "Util/hwlib/cv/socal/alt_fpgamgr.h"
+
+// Reset Manager Bridge Module Reset Register
+//  - FPGA_BRIDGE_* values match the register bits.
+#define FPGA_BRIDGE_RSTMGR_BRGREG  (volatile unsigned int *)ALT_RSTMGR_BRGMODRST_ADDR
+#define FPGA_BRIDGE_RSTMGR_BRGMASK (ALT_RSTMGR_BRGMODRST_H2F_SET_MSK | ALT_RSTMGR_BRGMODRST_LWH2F_SET_MSK | ALT_RSTMGR_BRGMODRST_F2H_SET_MSK)
+
+// FPGA Manager Status Register
+#define FPGA_BRIDGE_FPGAMGR_STAT   (volatile unsigned int *)ALT_FPGAMGR_STAT_ADDR
+
+#endif
+
+// Copy whole bursts
+//  - dest and src must be 8-byte aligned. Both are advanced past the copy.
+static HOT_CODE void _FpgaBridge_burst(volatile uint8_t** pDest, const volatile uint8_t** pSrc, size_t bursts) {
+    volatile uint8_t* dest = *pDest;
+    const volatile uint8_t* src = *pSrc;
+#if defined(__ARM_NEON)
+    __asm__ __volatile__ (
+        "1:                                \n\t"
+        "VLD1.64  {d0-d3}, [%[src]:64]!    \n\t"
+        "VST1.64  {d0-d3}, [%[dest]:64]!   \n\t"
+        "SUBS     %[bursts], %[bursts], #1 \n\t"
+        "BNE      1b                       \n\t"
+        : [src] "+r" (src), [dest] "+r" (dest), [bursts] "+r" (bursts)
+        :
+        : "d0", "d1", "d2", "d3", "cc", "memory"
+    );
+#elif defined(__arm__)
+    // r7 is avoided as it is the frame pointer in Thumb code.
+    __asm__ __volatile__ (
+        "1:                                \n\t"
+        "LDMIA    %[src]!, {r4-r6, r8}     \n\t"
+        "STMIA    %[dest]!, {r4-r6, r8}    \n\t"
+        "LDMIA    %[src]!, {r4-r6, r8}     \n\t"
+        "STMIA    %[dest]!, {r4-r6, r8}    \n\t"
+        "SUBS     %[bursts], %[bursts], #1 \n\t"
+        "BNE      1b                       \n\t"
+        : [src] "+r" (src), [dest] "+r" (dest), [bursts] "+r" (bursts)
+        :
+        : "r4", "r5", "r6", "r8", "cc", "memory"
+    );
+#else
+    while (bursts--) {
+        for (unsigned int word = 0; word < FPGA_BRIDGE_BURST_SIZE / sizeof(uint64_t); word++) {
+            *(volatile uint64_t*)dest = *(const volatile uint64_t*)src;
+            dest += sizeof(uint64_t);
+            src  += sizeof(uint64_t);
+        }
+    }
+#endif
+    *pDest = dest;
+    *pSrc = src;
+}
+
+// Copy with bursts where alignment allows
+static void _FpgaBridge_copy(volatile void* dest, const volatile void* src, size_t n) {
+    volatile uint8_t* dest_c = dest;
+    const volatile uint8_t* src_c = src;
+    if (!(((uintptr_t)dest_c ^ (uintptr_t)src_c) & (sizeof(uint64_t) - 1))) {
+        // Same double-word alignment. Up to the first double-word boundary.
+        size_t head = (0 - (uintptr_t)dest_c) & (sizeof(uint64_t) - 1);
+        if (head > n) head = n;
+        memcpy_v2v(dest_c, src_c, head);
+        dest_c += head;
+        src_c  += head;
+        n      -= head;
+        // Then as many bursts as possible
+        size_t bursts = n / FPGA_BRIDGE_BURST_SIZE;
+        if (bursts) {
+            _FpgaBridge_burst(&dest_c, &src_c, bursts);
+            n -= bursts * FPGA_BRIDGE_BURST_SIZE;
+        }
+    }
+    // Anything left, or all of a misaligned copy
+    memcpy_v2v(dest_c, src_c, n);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Release bridges from reset
+//  - bridges is a mask of FPGA_BRIDGE_* values.
+//  - Returns ERR_NOTREADY if the FPGA is not configured and in user mode.
+//  - Returns ERR_NOSUPPORT if not running on a Cyclone V HPS.
+HpsErr_t FpgaBridge_enable(unsigned int bridges) {
+#if defined(FPGA_BRIDGE_SUPPORTED)
+    if (bridges & ~FPGA_BRIDGE_ALL) return ERR_BADID;
+    // Bridges must only be used once the FPGA is configured
+    if (ALT_FPGAMGR_STAT_MOD_GET(*FPGA_BRIDGE_FPGAMGR_STAT) != ALT_FPGAMGR_STAT_MOD_E_USERMOD) return ERR_NOTREADY;
+    *FPGA_BRIDGE_RSTMGR_BRGREG &= ~(bridges & FPGA_BRIDGE_RSTMGR_BRGMASK);
+    return ERR_SUCCESS;
+#else
+    (void)bridges;
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Place bridges into reset
+//  - bridges is a mask of FPGA_BRIDGE_* values.
+//  - Any transfers in progress over the bridges must be complete first.
+//  - Returns ERR_NOSUPPORT if not running on a Cyclone V HPS.
+HpsErr_t FpgaBridge_disable(unsigned int bridges) {
+#if defined(FPGA_BRIDGE_SUPPORTED)
+    if (bridges & ~FPGA_BRIDGE_ALL) return ERR_BADID;
+    *FPGA_BRIDGE_RSTMGR_BRGREG |= (bridges & FPGA_BRIDGE_RSTMGR_BRGMASK);
+    return ERR_SUCCESS;
+#else
+    (void)bridges;
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Check if bridges are out of reset
+//  - Returns true if all of the requested bridges are enabled.
+bool FpgaBridge_isEnabled(unsigned int bridges) {
+#if defined(FPGA_BRIDGE_SUPPORTED)
+    if (!bridges || (bridges & ~FPGA_BRIDGE_ALL)) return false;
+    return !(*FPGA_BRIDGE_RSTMGR_BRGREG & bridges);
+#else
+    (void)bridges;
+    return false;
+#endif
+}
+
+// Copy to the FPGA with burst accesses
+//  - Writes n bytes from src to dest, in increasing address order.
+//  - See notes at top of file for alignment requirements for bursts.
+//  - Returns dest.
+HOT_CODE volatile void* FpgaBridge_write(volatile void* dest, const void* src, size_t n) {
+    _FpgaBridge_copy(dest, src, n);
+    return dest;
+}
+
+// Copy from the FPGA with burst accesses
+//  - Reads n bytes from src to dest, in increasing address order.
+//  - See notes at top of file for alignment requirements for bursts.
+//  - Returns dest.
+HOT_CODE void* FpgaBridge_read(void* dest, const volatile void* src, size_t n) {
+    _FpgaBridge_copy(dest, src, n);
+    return dest;
+}
+
+// Fill FPGA memory with a 32-bit value using burst accesses
+//  - Writes value to n bytes of dest, e.g. to clear a framebuffer.
+//  - dest and n must be a multiple of 4 bytes, otherwise returns NULL.
+//  - Returns dest.
+HOT_CODE volatile void* FpgaBridge_fill32(volatile void* dest, uint32_t value, size_t n) {
+    if (((uintptr_t)dest | n) & (sizeof(uint32_t) - 1)) return NULL;
+    volatile uint32_t* dest_w = dest;
+    // Word up to the first double-word boundary
+    if (n && ((uintptr_t)dest_w & (sizeof(uint64_t) - 1))) {
+        *dest_w++ = value;
+        n -= sizeof(uint32_t);
+    }
+    size_t bursts = n / FPGA_BRIDGE_BURST_SIZE;
+    if (bursts) {
+#if defined(__ARM_NEON)
+        __asm__ __volatile__ (
+            "VDUP.32  q0, %[value]             \n\t"
+            "VMOV     q1, q0                   \n\t"
+            "1:                                \n\t"
+            "VST1.64  {d0-d3}, [%[dest]:64]!   \n\t"
+            "SUBS     %[bursts], %[bursts], #1 \n\t"
+            "BNE      1b                       \n\t"
+            : [dest] "+r" (dest_w), [bursts] "+r" (bursts)
+            : [value] "r" (value)
+            : "d0", "d1", "d2", "d3", "cc", "memory"
+        );
+#elif defined(__arm__)
+        // r7 is avoided as it is the frame pointer in Thumb code.
+        __asm__ __volatile__ (
+            "MOV      r4, %[value]             \n\t"
+            "MOV      r5, %[value]             \n\t"
+            "MOV      r6, %[value]             \n\t"
+            "MOV      r8, %[value]             \n\t"
+            "1:                                \n\t"
+            "STMIA    %[dest]!, {r4-r6, r8}    \n\t"
+            "STMIA    %[dest]!, {r4-r6, r8}    \n\t"
+            "SUBS     %[bursts], %[bursts], #1 \n\t"
+            "BNE      1b                       \n\t"
+            : [dest] "+r" (dest_w), [bursts] "+r" (bursts)
+            : [value] "r" (value)
+            : "r4", "r5", "r6", "r8", "cc", "memory"
+        );
+#else
+        while (bursts--) {
+            for (unsigned int word = 0; word < FPGA_BRIDGE_BURST_SIZE / sizeof(uint32_t); word++) {
+                *dest_w++ = value;
+            }
+        }
+#endif
+        n &= FPGA_BRIDGE_BURST_SIZE - 1;
+    }
+    // Remaining words
+    while (n) {
+        *dest_w++ = value;
+        n -= sizeof(uint32_t);
+    }
+    return dest;
+}
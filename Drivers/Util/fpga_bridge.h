@@ -0,0 +1,153 @@
+/*
+ * HPS-to-FPGA Bridge Access
+ * -------------------------
+ *
+ * Helpers for moving bulk data over the heavyweight HPS-to-FPGA
+ * (H2F) AXI bridge, e.g. to feed FPGA accelerators or to fill
+ * framebuffers held in FPGA memory.
+ *
+ * The lightweight bridge (0xFF200000) is a 32-bit master intended
+ * for control registers, so every access is a single 32-bit beat.
+ * The H2F bridge (0xC0000000) can be configured in Qsys as 32, 64
+ * or 128 bits wide and accepts bursts, so bulk transfers should go
+ * through it using the widest accesses possible:
+ *
+ *    FpgaBridge_enable(FPGA_BRIDGE_H2F);
+ *    FpgaBridge_write(FPGA_BRIDGE_H2F_ADDR(0x08000000), frame, sizeof(frame));
+ *    FpgaBridge_fill32(FPGA_BRIDGE_H2F_ADDR(0x08000000), 0, sizeof(frame));
+ *
+ * The bridges are both mapped as Device memory by the startup code,
+ * so each LDM/STM or VLD1/VST1 instruction is issued as its own burst,
+ * and writes are posted without waiting for each to complete.
+ * FpgaBridge_write() and FpgaBridge_read() use 32-byte NEON bursts
+ * (four 64-bit beats) if available, otherwise LDM/STM bursts of four
+ * words. Bursts require the source and destination to share the same
+ * 8-byte alignment, otherwise the copy falls back to memcpy_v, which
+ * uses the widest access the alignment allows.
+ *
+ * Bridge Reset
+ * ------------
+ *
+ * The bridges are held in reset until released, which is normally
+ * done by the preloader once the FPGA is configured. FpgaBridge_enable()
+ * releases the requested bridges, checking first that the FPGA is in
+ * user mode, as the bridges must not be used before then. The bridges
+ * must also be made visible in the L3 interconnect remap register by
+ * the preloader (it is write-only, so cannot be safely changed here).
+ *
+ * Posted Writes
+ * -------------
+ *
+ * Writes to one bridge stay in order, but may still be in flight when
+ * the core next accesses the other bridge, an HPS peripheral or memory.
+ * Call FpgaBridge_sync() where that order matters, for example between
+ * filling a buffer over the H2F bridge and starting an accelerator
+ * through a control register on the LW bridge:
+ *
+ *    FpgaBridge_write(FPGA_BRIDGE_H2F_ADDR(0x08000000), data, sizeof(data));
+ *    FpgaBridge_sync();
+ *    accel[ACCEL_START] = 1;    // LW bridge
+ *
+ * DMA Targets
+ * -----------
+ *
+ * The bridge windows are not cached, so no cache maintenance is needed
+ * on the FPGA side of a DMA transfer. Addresses from FPGA_BRIDGE_H2F_ADDR()
+ * can be used directly in a DmaChunk_t or with DmaMem_memcpy(), and
+ * FpgaBridge_inH2F() can be used to check a transfer stays in the window.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Add FpgaBridge_sync for posted Device writes.
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef FPGA_BRIDGE_H_
+#define FPGA_BRIDGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+#include "Util/lowlevel_arm.h"
+
+// Bridge windows as seen from the MPU
+#define FPGA_BRIDGE_H2F_BASE    0xC0000000U
+#define FPGA_BRIDGE_H2F_SIZE    0x3C000000U
+#define FPGA_BRIDGE_LW_BASE     0xFF200000U
+#define FPGA_BRIDGE_LW_SIZE     0x00200000U
+
+// Address of an offset within a bridge window
+#define FPGA_BRIDGE_H2F_ADDR(offset) ((volatile void*)(uintptr_t)(FPGA_BRIDGE_H2F_BASE + (offset)))
+#define FPGA_BRIDGE_LW_ADDR(offset)  ((volatile void*)(uintptr_t)(FPGA_BRIDGE_LW_BASE  + (offset)))
+
+// Size in bytes of each burst used for bulk copies
+#define FPGA_BRIDGE_BURST_SIZE  32
+
+// Bridges. Can be ORed together.
+#define FPGA_BRIDGE_H2F         (1 << 0)   // Heavyweight HPS-to-FPGA
+#define FPGA_BRIDGE_LWH2F       (1 << 1)   // Lightweight HPS-to-FPGA
+#define FPGA_BRIDGE_F2H         (1 << 2)   // FPGA-to-HPS
+#define FPGA_BRIDGE_ALL         (FPGA_BRIDGE_H2F | FPGA_BRIDGE_LWH2F | FPGA_BRIDGE_F2H)
+
+// Release bridges from reset
+//  - bridges is a mask of FPGA_BRIDGE_* values.
+//  - Returns ERR_NOTREADY if the FPGA is not configured and in user mode.
+//  - Returns ERR_NOSUPPORT if not running on a Cyclone V HPS.
+HpsErr_t FpgaBridge_enable(unsigned int bridges);
+
+// Place bridges into reset
+//  - bridges is a mask of FPGA_BRIDGE_* values.
+//  - Any transfers in progress over the bridges must be complete first.
+//  - Returns ERR_NOSUPPORT if not running on a Cyclone V HPS.
+HpsErr_t FpgaBridge_disable(unsigned int bridges);
+
+// Check if bridges are out of reset
+//  - Returns true if all of the requested bridges are enabled.
+bool FpgaBridge_isEnabled(unsigned int bridges);
+
+// Check if a region is within the H2F or LW bridge windows
+//  - Returns true if all of the n bytes at addr are in the window.
+static inline bool FpgaBridge_inH2F(const volatile void* addr, size_t n) {
+    uintptr_t offset = (uintptr_t)addr - FPGA_BRIDGE_H2F_BASE;
+    return ((uintptr_t)addr >= FPGA_BRIDGE_H2F_BASE) && (offset <= FPGA_BRIDGE_H2F_SIZE) && (n <= (FPGA_BRIDGE_H2F_SIZE - offset));
+}
+static inline bool FpgaBridge_inLW(const volatile void* addr, size_t n) {
+    uintptr_t offset = (uintptr_t)addr - FPGA_BRIDGE_LW_BASE;
+    return ((uintptr_t)addr >= FPGA_BRIDGE_LW_BASE) && (offset <= FPGA_BRIDGE_LW_SIZE) && (n <= (FPGA_BRIDGE_LW_SIZE - offset));
+}
+
+// Wait for posted bridge writes to complete
+//  - Issues a DSB, so all earlier writes over the bridges have completed
+//    before any later access. See notes at top of file.
+static inline void FpgaBridge_sync(void) {
+    __DSB();
+}
+
+// Copy to the FPGA with burst accesses
+//  - Writes n bytes from src to dest, in increasing address order.
+//  - See notes at top of file for alignment requirements for bursts.
+//  - Returns dest.
+volatile void* FpgaBridge_write(volatile void* dest, const void* src, size_t n);
+
+// Copy from the FPGA with burst accesses
+//  - Reads n bytes from src to dest, in increasing address order.
+//  - See notes at top of file for alignment requirements for bursts.
+//  - Returns dest.
+void* FpgaBridge_read(void* dest, const volatile void* src, size_t n);
+
+// Fill FPGA memory with a 32-bit value using burst accesses
+//  - Writes value to n bytes of dest, e.g. to clear a framebuffer.
+//  - dest and n must be a multiple of 4 bytes, otherwise returns NULL.
+//  - Returns dest.
+volatile void* FpgaBridge_fill32(volatile void* dest, uint32_t value, size_t n);
+
+#endif /* FPGA_BRIDGE_H_ */
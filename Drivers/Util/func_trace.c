@@ -0,0 +1,108 @@
+/*
+ * Function Entry/Exit Tracing
+ * ---------------------------
+ *
+ * Implements the __cyg_profile_func_enter/exit hooks called by
+ * code built with -finstrument-functions, adding a record to a
+ * trace buffer (Util/trace.h) for each function entry and exit.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "func_trace.h"
+
+#include "Util/bit_helpers.h"
+
+// Module address range
+typedef struct {
+    uintptr_t    base;
+    size_t       size;
+    unsigned int module;
+} FuncTraceRange_t;
+
+static TraceCtx_t* volatile _trace = NULL;
+static volatile uint32_t    _mask  = 0;       // 0 while stopped
+static FuncTraceRange_t     _ranges[FUNCTRACE_MAX_RANGES];
+static unsigned int         _numRanges = 0;
+
+/*
+ * Internal Functions
+ */
+
+// Check if a function's module is enabled
+static inline bool FUNCTRACE_NO_INSTRUMENT _FuncTrace_enabled(uint32_t mask, uintptr_t func) {
+    unsigned int count = __atomic_load_n(&_numRanges, __ATOMIC_ACQUIRE);
+    for (unsigned int idx = 0; idx < count; idx++) {
+        if ((func - _ranges[idx].base) < _ranges[idx].size) {
+            return mask & _BV(_ranges[idx].module);
+        }
+    }
+    return mask & _BV(FUNCTRACE_MODULE_OTHER);
+}
+
+// Add a record if the function's module is enabled
+static inline void FUNCTRACE_NO_INSTRUMENT _FuncTrace_record(uint16_t id, void* func, void* callSite) {
+    uint32_t mask = _mask;
+    if (!mask || !_FuncTrace_enabled(mask, (uintptr_t)func)) return;
+    Trace_event(_trace, id, (uint32_t)(uintptr_t)func, (uint32_t)(uintptr_t)callSite);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Start tracing
+//  - Instrumented functions of the modules in mask are traced to trace.
+HpsErr_t FuncTrace_start(TraceCtx_t* trace, uint32_t mask) {
+    if (!Trace_isInitialised(trace)) return ERR_BADDEVICE;
+    // Stop first so the hooks never see the new trace with the old mask
+    _mask = 0;
+    _trace = trace;
+    __atomic_store_n(&_mask, mask, __ATOMIC_RELEASE);
+    return ERR_SUCCESS;
+}
+
+// Stop tracing
+HpsErr_t FuncTrace_stop(void) {
+    _mask = 0;
+    return ERR_SUCCESS;
+}
+
+// Change the modules being traced
+//  - Returns ERR_NOINIT if not started.
+HpsErr_t FuncTrace_setMask(uint32_t mask) {
+    if (!_trace) return ERR_NOINIT;
+    _mask = mask;
+    return ERR_SUCCESS;
+}
+
+// Add an address range to a module
+//  - module is from 0 to 30. A module may have several ranges.
+//  - Returns ERR_NOSPACE if FUNCTRACE_MAX_RANGES have been added.
+HpsErr_t FuncTrace_addModule(unsigned int module, uintptr_t base, size_t size) {
+    if (module >= FUNCTRACE_MODULE_OTHER) return ERR_OUTRANGE;
+    if (!size) return ERR_TOOSMALL;
+    if (_numRanges >= FUNCTRACE_MAX_RANGES) return ERR_NOSPACE;
+    // Fill in the range before the hooks can see it
+    _ranges[_numRanges] = (FuncTraceRange_t){ .base = base, .size = size, .module = module };
+    __atomic_store_n(&_numRanges, _numRanges + 1, __ATOMIC_RELEASE);
+    return ERR_SUCCESS;
+}
+
+// Function entry hook
+void __cyg_profile_func_enter(void* func, void* callSite) {
+    _FuncTrace_record(FUNCTRACE_ID_ENTER, func, callSite);
+}
+
+// Function exit hook
+void __cyg_profile_func_exit(void* func, void* callSite) {
+    _FuncTrace_record(FUNCTRACE_ID_EXIT, func, callSite);
+}
@@ -0,0 +1,106 @@
+/*
+ * Function Entry/Exit Tracing
+ * ---------------------------
+ *
+ * Implements the __cyg_profile_func_enter/exit hooks called by
+ * code built with -finstrument-functions, adding a record to a
+ * trace buffer (Util/trace.h) for each function entry and exit.
+ * Each is timestamped with the global timer by Trace_event(), so
+ * the trace gives a full call timeline of the instrumented code
+ * for latency investigations, without adding markers by hand.
+ *
+ * Only the source files of interest need to be built with the
+ * flag (e.g. from the file's build settings in Arm DS):
+ *
+ *    -finstrument-functions
+ *
+ * Util/trace.c, Util/driver_ctx.c and this file must not be
+ * instrumented, otherwise each record would recurse. Nor should anything the trace is read
+ * from if it is drained in the instrumented code.
+ *
+ * Modules
+ * -------
+ *
+ * The hooks are given only the address of the function, so the
+ * modules are defined as address ranges, e.g. from the limits of a
+ * scatter file execution region holding a module's code. Each range
+ * is given a module number (0 to 30), and a function is only traced
+ * if the bit of its module is set in the enable mask:
+ *
+ *    extern unsigned int Image$$AUDIO_CODE$$Base, Image$$AUDIO_CODE$$Length;
+ *    FuncTrace_addModule(1, (uintptr_t)&Image$$AUDIO_CODE$$Base, (size_t)&Image$$AUDIO_CODE$$Length);
+ *    FuncTrace_start(trace, _BV(1));
+ *
+ * Functions outside of every range belong to FUNCTRACE_MODULE_OTHER.
+ * Instrumented functions which are not enabled cost an address check
+ * on entry and exit.
+ *
+ * Records
+ * -------
+ *
+ * Entry records have ID FUNCTRACE_ID_ENTER, and exit records
+ * FUNCTRACE_ID_EXIT, with the function address as the first
+ * argument and the call site as the second. The host can resolve
+ * both from the ELF file. Records may be added from any context,
+ * so the call timelines of IRQ handlers and the other core are
+ * interleaved with the rest, in the order they occurred.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef FUNC_TRACE_H_
+#define FUNC_TRACE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+#include "Util/trace.h"
+
+// Trace record IDs
+#define FUNCTRACE_ID_ENTER     (TRACE_ID_RESERVED | 0x200)
+#define FUNCTRACE_ID_EXIT      (TRACE_ID_RESERVED | 0x201)
+
+// Module of functions outside of every range
+#define FUNCTRACE_MODULE_OTHER 31
+
+// Maximum number of module address ranges
+#ifndef FUNCTRACE_MAX_RANGES
+#define FUNCTRACE_MAX_RANGES   8
+#endif
+
+// Mark a function which must never be instrumented
+#define FUNCTRACE_NO_INSTRUMENT __attribute__((no_instrument_function))
+
+// Start tracing
+//  - Instrumented functions of the modules in mask are traced to trace.
+HpsErr_t FuncTrace_start(TraceCtx_t* trace, uint32_t mask);
+
+// Stop tracing
+HpsErr_t FuncTrace_stop(void);
+
+// Change the modules being traced
+//  - Returns ERR_NOINIT if not started.
+HpsErr_t FuncTrace_setMask(uint32_t mask);
+
+// Add an address range to a module
+//  - module is from 0 to 30. A module may have several ranges.
+//  - Returns ERR_NOSPACE if FUNCTRACE_MAX_RANGES have been added.
+HpsErr_t FuncTrace_addModule(unsigned int module, uintptr_t base, size_t size);
+
+// Instrumentation hooks
+//  - Called by code built with -finstrument-functions.
+void __cyg_profile_func_enter(void* func, void* callSite) FUNCTRACE_NO_INSTRUMENT;
+void __cyg_profile_func_exit(void* func, void* callSite) FUNCTRACE_NO_INSTRUMENT;
+
+#endif /* FUNC_TRACE_H_ */
@@ -77,6 +77,20 @@
 
 #define ALT_SDMMC_DMA_SEGMENT_SIZE      512
 #define ALT_SDMMC_DMA_DESC_COUNT        128
+#if ALT_SDMMC_DMA_MAX_TRANSFER != (ALT_SDMMC_DMA_SEGMENT_SIZE * ALT_SDMMC_DMA_DESC_COUNT)
+#error "ALT_SDMMC_DMA_MAX_TRANSFER must match the DMA descriptor ring capacity"
+#endif
+
+/*  Interrupt status bits which indicate a transfer error*/
+#define ALT_SDMMC_ASYNC_INT_ERRORS      (  ALT_SDMMC_INT_STATUS_RE   \
+                                         | ALT_SDMMC_INT_STATUS_RCRC \
+                                         | ALT_SDMMC_INT_STATUS_DCRC \
+                                         | ALT_SDMMC_INT_STATUS_RTO  \
+                                         | ALT_SDMMC_INT_STATUS_DRTO \
+                                         | ALT_SDMMC_INT_STATUS_FRUN \
+                                         | ALT_SDMMC_INT_STATUS_HLE  \
+                                         | ALT_SDMMC_INT_STATUS_SBE  \
+                                         | ALT_SDMMC_INT_STATUS_EBE)
 
 #define ALT_SDMMC_FSM_IDLE              0
 #define ALT_SDMMC_DMA_FSM_IDLE          0
@@ -669,6 +683,31 @@ static ALT_SDMMC_CMD_CONFIG_t acmd_default_cfg[] =
         ALT_DEFAULT_RESERVED,
         ALT_DEFAULT_START_BIT
     },
+    {
+        ALT_SD_SET_WR_BLK_ERASE_COUNT, /* .cmd_index */
+        true, /* .response_expect */
+        ALT_DEFAULT_RESPONSE_LENGTH_LONG,
+        ALT_DEFAULT_CHECK_RESPONSE_CRC,
+        ALT_DEFAULT_DATA_EXPECTED,
+        ALT_DEFAULT_WRITE_ACTIVE,
+        ALT_DEFAULT_STREAM_MODE_ACTIVE,
+        ALT_DEFAULT_SEND_AUTO_STOP,
+        true, /* .wait_prvdata_complete */
+        ALT_DEFAULT_STOP_ABORT_CMD,
+        ALT_DEFAULT_SEND_INITIALIZATION,
+        0, /* .card_number */
+        ALT_DEFAULT_UPDATE_CLOCK_REGISTERS_ONLY,
+        ALT_DEFAULT_READ_CEATA_DEVICE,
+        ALT_DEFAULT_CSS_EXPECTED,
+        ALT_DEFAULT_ENABLE_BOOT,
+        ALT_DEFAULT_EXPECT_BOOT_ACK,
+        ALT_DEFAULT_DISABLE_BOOT,
+        ALT_DEFAULT_BOOT_MODE,
+        ALT_DEFAULT_VOLT_SWITCH,
+        true, /* .use_hold_reg */
+        ALT_DEFAULT_RESERVED,
+        ALT_DEFAULT_START_BIT
+    },
     {
         ALT_SD_SD_STATUS, /* .cmd_index */
         true, /* .response_expect */
@@ -751,6 +790,7 @@ static uint32_t                    rca_number; /*!< Relative card address.  */
 static ALT_SDMMC_DMA_BUF_DESC_t    dma_descriptors[ALT_SDMMC_DMA_DESC_COUNT] __attribute__ ((aligned (ALT_CACHE_LINE_SIZE)));
                                         /*!< Array of DMA descriptors.  */
 static ALT_SDMMC_DMA_BUF_DESC_t    *dma_cur_descr __attribute__ ((aligned (ALT_CACHE_LINE_SIZE)));
+static volatile bool               dma_async_pending = false; /*!< Transfer started by alt_sdmmc_transfer_start() in progress. */
                                         /*!< Current descriptor.  */
 #define ALT_SDMMC_DMA_BUF_DESC_CACHE_SIZE (((ALT_SDMMC_DMA_DESC_COUNT*sizeof(ALT_SDMMC_DMA_BUF_DESC_t)) + ALT_CACHE_LINE_SIZE - 1) & ~(ALT_CACHE_LINE_SIZE-1))
 
@@ -1119,7 +1159,8 @@ uint32_t alt_sdmmc_card_speed_get(void)
     uint32_t clk_div = alt_sdmmc_card_clk_div_get();
 
     /*  The sdmmc_clk(clock_freq) is divided by 4, then further divided by 2*clk_div inside the controller.*/
-    uint32_t speed_bps = clock_freq / (4 * 2 * clk_div);
+    /*  A clk_div of 0 bypasses the divider.*/
+    uint32_t speed_bps = (clk_div == 0) ? (clock_freq / 4) : (clock_freq / (4 * 2 * clk_div));
 
     return speed_bps;
 }
@@ -1130,7 +1171,7 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(ALT_SDMMC_CARD_INFO_t * card_info, uint
 ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_INFO_t * card_info, uint32_t xfer_speed)
 #endif
 {
-    uint32_t        clk_div = clock_freq / (4 * 2 * xfer_speed);
+    uint32_t        clk_div;
     ALT_STATUS_CODE status = ALT_E_SUCCESS;
     uint32_t        current_clk_div;
     bool            clock_disabled = false;
@@ -1140,6 +1181,21 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_I
        uint8_t switch_function[64] = {0}; /* switch function status 64 bytes long */
 #endif
 
+    if (xfer_speed == 0)
+    {
+        return ALT_E_BAD_ARG;
+    }
+    /*  Round the divider up so that the card is never clocked faster than requested.*/
+    /*  Only the full rate (divider bypassed) is high speed.*/
+    if (xfer_speed >= (clock_freq / 4))
+    {
+        clk_div = 0;
+    }
+    else
+    {
+        clk_div = (clock_freq + (4 * 2 * xfer_speed) - 1) / (4 * 2 * xfer_speed);
+    }
+
     current_clk_div = alt_sdmmc_card_clk_div_get();
     if (current_clk_div != clk_div)
     {
@@ -1184,11 +1240,13 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_I
                 else
                 {
                     dprintf("Switching to high speed failed, switch_function[16] = 0x%x\n", (int)switch_function[16]);
+                    status = ALT_E_ERROR;
                 }
             }
             else
             {
                 dprintf("High speed not supported.\n");
+                status = ALT_E_BAD_ARG;
             }
         }
         else if (current_clk_div == 0) /*  need to switch from 50MHz to 25MHz*/
@@ -1217,6 +1275,7 @@ ALT_STATUS_CODE alt_sdmmc_card_speed_set(__attribute__((unused))ALT_SDMMC_CARD_I
             else
             {
                 dprintf("Switching to default speed failed\n");
+                if (status == ALT_E_SUCCESS) status = ALT_E_ERROR;
             }
         }
 #endif
@@ -1715,6 +1774,17 @@ ALT_STATUS_CODE alt_sdmmc_int_enable(const uint32_t mask)
     return ALT_E_SUCCESS;
 }
 
+/*
+// Stop the SD/MMC controller raising its interrupt signal, without changing the
+// interrupt mask. Re-enabled by the next call to alt_sdmmc_int_enable().
+*/
+ALT_STATUS_CODE alt_sdmmc_int_signal_disable(void)
+{
+    alt_clrbits_word(ALT_SDMMC_CTL_ADDR, ALT_SDMMC_CTL_INT_EN_SET_MSK);
+
+    return ALT_E_SUCCESS;
+}
+
 /*
 //Returns true if SD/MMC controller FIFO has reached the receive watermark level
 //otherwise returns false.
@@ -3152,8 +3222,9 @@ static ALT_STATUS_CODE alt_sdmmc_card_read_switch(ALT_SDMMC_CARD_INFO_t * card_i
     card_info->high_speed = false;
     if ((card_info->scr_sd_spec == 0) || !(card_info->csd_ccc & (CCC_CLASS_10 | CCC_CLASS_11)) )/*  version 1.01 or ! Class 10*/
     {
+        /*  No CMD6, so card is limited to default speed. Not an error.*/
         dprintf("High speed not supported\n");
-        return ALT_E_BAD_ARG;
+        return ALT_E_SUCCESS;
     }
     if (card_info->card_type == ALT_SDMMC_CARD_TYPE_MMC) {
         if (card_info->mmc_spec >= 4) {
@@ -3387,11 +3458,30 @@ ALT_STATUS_CODE alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_t command_type,
     return status;
 }
 
-static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
-                                          uint32_t start_addr,
-                                          uint32_t buffer[],
-                                          const size_t buf_len,
-                                          ALT_SDMMC_TMOD_t transfer_mode)
+/*
+// Convert a byte address on the card to a block number
+*/
+static ALT_STATUS_CODE alt_sdmmc_addr_to_block(uint32_t addr, uint32_t * block)
+{
+    uint16_t block_size = alt_sdmmc_block_size_get();
+    if ((block_size == 0) || (addr % block_size != 0))
+    {
+        return ALT_E_BAD_ARG;
+    }
+    *block = addr / block_size;
+    return ALT_E_SUCCESS;
+}
+
+/*
+// Set up the controller and send the read/write command for a transfer. The
+// data must then be moved by alt_sdmmc_dma_trans_helper/alt_sdmmc_transfer_helper.
+// start_blk is in units of the controller block size.
+*/
+static ALT_STATUS_CODE alt_sdmmc_transfer_issue(ALT_SDMMC_CARD_INFO_t * card_info,
+                                                uint32_t start_blk,
+                                                const size_t buf_len,
+                                                ALT_SDMMC_TMOD_t transfer_mode,
+                                                uint32_t * xfer_len)
 {
     ALT_STATUS_CODE status = ALT_E_SUCCESS;
     uint32_t block_count;
@@ -3399,23 +3489,22 @@ static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
     uint16_t block_size;
     uint32_t cmd_index = 0;
 
-    if (buf_len == 0)
-    {
-        return ALT_E_SUCCESS;
-    }
-
-    if (!alt_sdmmc_is_idle())
+    if (!alt_sdmmc_is_idle() || dma_async_pending)
     {
         return ALT_E_ERROR;
     }
 
     block_size = alt_sdmmc_block_size_get();
 
-    if (   (start_addr % block_size != 0) 
-        || (buf_len    % block_size != 0))
+    if (buf_len % block_size != 0)
     {
         return ALT_E_BAD_ARG;
     }
+    /*  Standard capacity cards are byte addressed, so must be below 4GB*/
+    if (!card_info->high_capacity && (start_blk > (UINT32_MAX / block_size)))
+    {
+        return ALT_E_ARG_RANGE;
+    }
 
     /*  Number of block to transfer*/
     block_count = buf_len / block_size;
@@ -3467,20 +3556,41 @@ static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
     }
 
 #ifdef LOGGER
-    dprintf("\nstart_addr = %d\n", (int)start_addr);
+    dprintf("\nstart_blk = %d\n", (int)start_blk);
 #endif
 
     /* Send transfer command*/
 
     if (card_info->high_capacity)
     {
-        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_addr / block_size, NULL);
+        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_blk, NULL);
     }
     else
     {
-        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_addr, NULL);
+        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, (ALT_SDMMC_CMD_INDEX_t)cmd_index, start_blk * block_size, NULL);
     }
 
+    *xfer_len = byte_count;
+
+    return status;
+}
+
+static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
+                                          uint32_t start_blk,
+                                          uint32_t buffer[],
+                                          const size_t buf_len,
+                                          ALT_SDMMC_TMOD_t transfer_mode)
+{
+    ALT_STATUS_CODE status;
+    uint32_t byte_count;
+
+    if (buf_len == 0)
+    {
+        return ALT_E_SUCCESS;
+    }
+
+    status = alt_sdmmc_transfer_issue(card_info, start_blk, buf_len, transfer_mode, &byte_count);
+
     if (status != ALT_E_SUCCESS)
     {
         return status;
@@ -3513,7 +3623,13 @@ static ALT_STATUS_CODE alt_sdmmc_transfer(ALT_SDMMC_CARD_INFO_t * card_info,
 */
 ALT_STATUS_CODE alt_sdmmc_write(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, void *src, const size_t size)
 {
-    return alt_sdmmc_transfer(card_info, (uint32_t)dest, src, size, ALT_SDMMC_TMOD_WRITE);
+    uint32_t block;
+    ALT_STATUS_CODE status = alt_sdmmc_addr_to_block((uint32_t)dest, &block);
+    if (status != ALT_E_SUCCESS)
+    {
+        return status;
+    }
+    return alt_sdmmc_transfer(card_info, block, src, size, ALT_SDMMC_TMOD_WRITE);
 }
 
 /*
@@ -3521,7 +3637,285 @@ ALT_STATUS_CODE alt_sdmmc_write(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, v
 */
 ALT_STATUS_CODE alt_sdmmc_read(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, void *src, const size_t size)
 {
-    return alt_sdmmc_transfer(card_info, (uint32_t)src, dest, size, ALT_SDMMC_TMOD_READ);
+    uint32_t block;
+    ALT_STATUS_CODE status = alt_sdmmc_addr_to_block((uint32_t)src, &block);
+    if (status != ALT_E_SUCCESS)
+    {
+        return status;
+    }
+    return alt_sdmmc_transfer(card_info, block, dest, size, ALT_SDMMC_TMOD_READ);
+}
+
+/*
+// This function performs SDMMC write by block number.
+*/
+ALT_STATUS_CODE alt_sdmmc_block_write(ALT_SDMMC_CARD_INFO_t * card_info, uint32_t dest, void *src, const size_t size)
+{
+    return alt_sdmmc_transfer(card_info, dest, src, size, ALT_SDMMC_TMOD_WRITE);
+}
+
+/*
+// This function performs SDMMC read by block number.
+*/
+ALT_STATUS_CODE alt_sdmmc_block_read(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, uint32_t src, const size_t size)
+{
+    return alt_sdmmc_transfer(card_info, src, dest, size, ALT_SDMMC_TMOD_READ);
+}
+
+/*
+// End a transfer started by alt_sdmmc_transfer_start(), clearing its interrupts.
+*/
+static void alt_sdmmc_transfer_finish(void)
+{
+    alt_sdmmc_int_disable(ALT_SDMMC_INT_STATUS_ALL);
+    alt_sdmmc_dma_int_disable(ALT_SDMMC_DMA_INT_STATUS_ALL);
+    alt_sdmmc_dma_int_clear(ALT_SDMMC_DMA_INT_STATUS_ALL);
+    dma_async_pending = false;
+}
+
+/*
+// Start a DMA transfer without waiting for it to complete. The whole transfer
+// must fit in the descriptor ring so that no descriptors need refilling.
+*/
+static ALT_STATUS_CODE alt_sdmmc_transfer_start(ALT_SDMMC_CARD_INFO_t * card_info,
+                                                uint32_t start_blk,
+                                                uint32_t buffer[],
+                                                const size_t buf_len,
+                                                ALT_SDMMC_TMOD_t transfer_mode)
+{
+    ALT_STATUS_CODE status;
+    uint32_t byte_count;
+
+    if (alt_sdmmc_is_dma_enabled() != ALT_E_TRUE)
+    {
+        return ALT_E_BAD_OPERATION;
+    }
+
+    if ((buf_len == 0) || (buf_len > ALT_SDMMC_DMA_MAX_TRANSFER))
+    {
+        return ALT_E_BAD_ARG;
+    }
+
+    status = alt_sdmmc_transfer_issue(card_info, start_blk, buf_len, transfer_mode, &byte_count);
+
+    if (status == ALT_E_SUCCESS)
+    {
+        /* Descriptor ring is empty, so this fills it without waiting*/
+        status = alt_sdmmc_dma_trans_helper(buffer, byte_count);
+    }
+
+    if (status != ALT_E_SUCCESS)
+    {
+        return status;
+    }
+
+    /* Only interrupt on completion or error from now on*/
+    alt_sdmmc_int_disable(ALT_SDMMC_INT_STATUS_ALL);
+    alt_sdmmc_int_clear(ALT_SDMMC_INT_STATUS_CMD);
+    alt_sdmmc_int_enable(ALT_SDMMC_INT_STATUS_DTO | ALT_SDMMC_ASYNC_INT_ERRORS);
+    alt_sdmmc_dma_int_disable(ALT_SDMMC_DMA_INT_STATUS_ALL);
+    alt_sdmmc_dma_int_enable(  ALT_SDMMC_DMA_INT_STATUS_FBE
+                             | ALT_SDMMC_DMA_INT_STATUS_DU
+                             | ALT_SDMMC_DMA_INT_STATUS_CES
+                             | ALT_SDMMC_DMA_INT_STATUS_AI);
+
+    dma_async_pending = true;
+
+    return ALT_E_SUCCESS;
+}
+
+/*
+// This function starts an SDMMC write without waiting for completion.
+*/
+ALT_STATUS_CODE alt_sdmmc_write_start(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, void *src, const size_t size)
+{
+    uint32_t block;
+    ALT_STATUS_CODE status = alt_sdmmc_addr_to_block((uint32_t)dest, &block);
+    if (status != ALT_E_SUCCESS)
+    {
+        return status;
+    }
+    return alt_sdmmc_transfer_start(card_info, block, src, size, ALT_SDMMC_TMOD_WRITE);
+}
+
+/*
+// This function starts an SDMMC read without waiting for completion.
+*/
+ALT_STATUS_CODE alt_sdmmc_read_start(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, void *src, const size_t size)
+{
+    uint32_t block;
+    ALT_STATUS_CODE status = alt_sdmmc_addr_to_block((uint32_t)src, &block);
+    if (status != ALT_E_SUCCESS)
+    {
+        return status;
+    }
+    return alt_sdmmc_transfer_start(card_info, block, dest, size, ALT_SDMMC_TMOD_READ);
+}
+
+/*
+// This function starts an SDMMC write by block number without waiting for completion.
+*/
+ALT_STATUS_CODE alt_sdmmc_block_write_start(ALT_SDMMC_CARD_INFO_t * card_info, uint32_t dest, void *src, const size_t size)
+{
+    return alt_sdmmc_transfer_start(card_info, dest, src, size, ALT_SDMMC_TMOD_WRITE);
+}
+
+/*
+// This function starts an SDMMC read by block number without waiting for completion.
+*/
+ALT_STATUS_CODE alt_sdmmc_block_read_start(ALT_SDMMC_CARD_INFO_t * card_info, void *dest, uint32_t src, const size_t size)
+{
+    return alt_sdmmc_transfer_start(card_info, src, dest, size, ALT_SDMMC_TMOD_READ);
+}
+
+/*
+// Check whether a transfer started by alt_sdmmc_read_start/alt_sdmmc_write_start
+// has completed. Does not block.
+*/
+ALT_STATUS_CODE alt_sdmmc_transfer_is_done(void)
+{
+    uint32_t idmac_status;
+
+    if (!dma_async_pending)
+    {
+        return ALT_E_TRUE;
+    }
+
+    if (alt_sdmmc_error_status_detect() != ALT_E_SUCCESS)
+    {
+        alt_sdmmc_transfer_finish();
+        return ALT_E_ERROR;
+    }
+
+    idmac_status = alt_sdmmc_dma_int_status_get();
+
+    /*  If DMA stalled on a descriptor before it was owned then resume*/
+    if (idmac_status & ALT_SDMMC_DMA_INT_STATUS_DU)
+    {
+        alt_sdmmc_dma_int_clear(ALT_SDMMC_DMA_INT_STATUS_DU | ALT_SDMMC_DMA_INT_STATUS_AI);
+        alt_sdmmc_poll_demand_set(0x1);
+        return ALT_E_FALSE;
+    }
+    /*  If DMA status is another abnormal then transfer complete with error*/
+    else if (idmac_status & ALT_SDMMC_DMA_INT_STATUS_AI)
+    {
+        alt_sdmmc_transfer_finish();
+        return ALT_E_ERROR;
+    }
+
+    /*  Data transfer over, done once the controller returns to idle*/
+    if ((alt_sdmmc_int_status_get() & ALT_SDMMC_INT_STATUS_DTO) && alt_sdmmc_is_idle())
+    {
+        alt_sdmmc_int_clear(ALT_SDMMC_INT_STATUS_DTO);
+        alt_sdmmc_transfer_finish();
+        return ALT_E_TRUE;
+    }
+
+    return ALT_E_FALSE;
+}
+
+/*
+// Returns true if the card is signalling busy (e.g. programming written data).
+*/
+bool alt_sdmmc_card_is_busy(void)
+{
+    return (alt_sdmmc_is_busy() == ALT_E_TRUE);
+}
+
+/*
+// Set the number of blocks to pre-erase for the next multiple block write (ACMD23).
+*/
+ALT_STATUS_CODE alt_sdmmc_card_pre_erase_set(uint32_t blocks)
+{
+    ALT_STATUS_CODE status;
+
+    if ((blocks == 0) || (blocks > ALT_SDMMC_PRE_ERASE_MAX))
+    {
+        return ALT_E_BAD_ARG;
+    }
+
+    /*  Activate ACMD commands*/
+    status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, ALT_SDMMC_APP_CMD, rca_number, NULL);
+    if (status != ALT_E_SUCCESS)
+    {
+        return status;
+    }
+
+    return alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_ACMD, ALT_SD_SET_WR_BLK_ERASE_COUNT, blocks, NULL);
+}
+
+/*
+// Read the SD status register from the card (ACMD13).
+*/
+ALT_STATUS_CODE alt_sdmmc_card_sd_status_get(uint32_t *sd_status)
+{
+    ALT_STATUS_CODE status = ALT_E_SUCCESS;
+    uint16_t prev_blk_size = 0;
+
+    if (sd_status == NULL)
+    {
+        return ALT_E_BAD_ARG;
+    }
+
+    /*  Save current block size and change it*/
+    prev_blk_size = alt_sdmmc_block_size_get();
+    alt_sdmmc_block_size_set(ALT_SDMMC_SD_STATUS_SIZE);
+    alt_sdmmc_byte_count_set(ALT_SDMMC_SD_STATUS_SIZE);
+
+    /*  reset FIFO*/
+    status = alt_sdmmc_fifo_reset();
+
+    /*  reset DMA*/
+    if ((status == ALT_E_SUCCESS) && alt_sdmmc_is_dma_enabled())
+    {
+        status = alt_sdmmc_dma_reset();
+        if (status == ALT_E_SUCCESS)
+        {
+            /*  Clean descriptor chain*/
+            alt_sdmmc_desc_chain_clear();
+
+            alt_sdmmc_dma_start(dma_cur_descr, 0x0,
+                                ALT_SDMMC_DMA_PBL_1, false);
+            /* Enable all dma interrupt status*/
+            alt_sdmmc_dma_int_enable(ALT_SDMMC_DMA_INT_STATUS_ALL);
+        }
+    }
+
+    /*  Activate ACMD commands*/
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_BASIC, ALT_SDMMC_APP_CMD, rca_number, NULL);
+    }
+
+    /*  Send request for read SD status register*/
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_sdmmc_command_send(ALT_SDMMC_CMD_TYPE_ACMD, ALT_SD_SD_STATUS, 0x0, NULL);
+    }
+
+    /* Read SD status register*/
+    if (status == ALT_E_SUCCESS)
+    {
+        if (alt_sdmmc_is_dma_enabled())
+        {
+            status = alt_sdmmc_dma_trans_helper(sd_status, ALT_SDMMC_SD_STATUS_SIZE);
+        }
+        else
+        {
+            status = alt_sdmmc_transfer_helper(sd_status, ALT_SDMMC_SD_STATUS_SIZE, ALT_SDMMC_TMOD_READ);
+        }
+    }
+
+    /*  Transfer complete*/
+    if (status == ALT_E_SUCCESS)
+    {
+        status = alt_sdmmc_data_done_waiter();
+    }
+
+    /*  Re-change block size*/
+    alt_sdmmc_block_size_set(prev_blk_size);
+
+    return status;
 }
 
 /*
@@ -351,6 +351,7 @@ typedef enum ALT_SDMMC_CMD_INDEX_e
     ALT_MMC_SEND_OP_COND             = 1,
     ALT_SD_SET_BUS_WIDTH             = 6,
     ALT_SD_SD_STATUS                 = 13,
+    ALT_SD_SET_WR_BLK_ERASE_COUNT    = 23,
     ALT_SD_SEND_OP_COND              = 41,
     ALT_SD_SEND_SCR                  = 51,
 
@@ -580,6 +581,19 @@ ALT_STATUS_CODE alt_sdmmc_int_disable(const uint32_t mask);
  */
 ALT_STATUS_CODE alt_sdmmc_int_enable(const uint32_t mask);
 
+/*!
+ * Stop the SD/MMC controller from raising its interrupt signal, without
+ * changing the interrupt mask or status. The signal is enabled again by the
+ * next call to alt_sdmmc_int_enable(), which is made whenever a command is
+ * sent.
+ *
+ * This is useful in an interrupt handler to quieten the controller while a
+ * blocking transfer is polling the interrupt status.
+ *
+ * \retval      ALT_E_SUCCESS   The operation was successful.
+ */
+ALT_STATUS_CODE alt_sdmmc_int_signal_disable(void);
+
 /*!
  * This type definition enumerates the interrupt status conditions that contribute
  * to the \b ALT_INT_INTERRUPT_SDMMC_IRQ signal state.
@@ -1663,6 +1677,212 @@ ALT_STATUS_CODE alt_sdmmc_read(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, voi
  */
 ALT_STATUS_CODE alt_sdmmc_write(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, void *src, const size_t size);
 
+/*!
+ * Reads blocks of data from the SD/MMC flash card.
+ *
+ * As alt_sdmmc_read(), but the flash address is given as a block number in
+ * units of the configured block size, rather than a byte address. This allows
+ * the whole of a high capacity card to be accessed, beyond the 4GB reach of a
+ * 32-bit byte address.
+ *
+ * \param       card_info
+ *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
+ *              identification and device property information for any detected
+ *              card.
+ *
+ * \param       dest
+ *              The address of a caller supplied destination buffer in system
+ *              memory large enough to contain the requested blocks of flash data.
+ *
+ * \param       src
+ *              The flash block number to begin reading data from.
+ *
+ * \param       size
+ *              The requested number of data bytes to read from the flash device.
+ *
+ * 
+etval      ALT_E_SUCCESS   The operation was successful.
+ * 
+etval      ALT_E_ARG_RANGE The block is beyond the reach of a standard
+ *                              capacity (byte addressed) card.
+ * 
+etval      ALT_E_ERROR     The operation failed.
+ */
+ALT_STATUS_CODE alt_sdmmc_block_read(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, uint32_t src, const size_t size);
+
+/*!
+ * Writes blocks of data to the SD/MMC flash card.
+ *
+ * As alt_sdmmc_write(), but the flash address is given as a block number. See
+ * alt_sdmmc_block_read() for details.
+ *
+ * \param       card_info
+ *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
+ *              identification and device property information for any detected
+ *              card.
+ *
+ * \param       dest
+ *              The flash block number to begin writing data to.
+ *
+ * \param       src
+ *              The source address in system memory to begin writing data from.
+ *
+ * \param       size
+ *              The requested number of data bytes to write to the flash device.
+ *
+ * 
+etval      ALT_E_SUCCESS   Indicates successful completion.
+ * 
+etval      ALT_E_ARG_RANGE The block is beyond the reach of a standard
+ *                              capacity (byte addressed) card.
+ * 
+etval      ALT_E_ERROR     Indicates an error occurred.
+ */
+ALT_STATUS_CODE alt_sdmmc_block_write(ALT_SDMMC_CARD_INFO_t *card_info, uint32_t dest, void *src, const size_t size);
+
+/*!
+ * Maximum size in bytes of a transfer started by alt_sdmmc_read_start() or
+ * alt_sdmmc_write_start(). This is the capacity of the DMA descriptor ring.
+ */
+#define ALT_SDMMC_DMA_MAX_TRANSFER  (512 * 128)
+
+/*!
+ * Start reading a block of data from the SD/MMC flash card.
+ *
+ * As alt_sdmmc_read(), but returns once the read command has been sent and
+ * the DMA descriptors filled, rather than waiting for the data. Completion
+ * is checked with alt_sdmmc_transfer_is_done(). The internal DMA must be
+ * enabled, and \e size must not exceed ALT_SDMMC_DMA_MAX_TRANSFER.
+ *
+ * While the transfer is in progress, the SD/MMC controller interrupt is only
+ * raised for data transfer over or errors, so alt_sdmmc_transfer_is_done() may
+ * be called from its interrupt handler. The destination buffer must not be
+ * accessed until the transfer completes.
+ *
+ * \param       card_info
+ *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
+ *              identification and device property information for any detected
+ *              card.
+ *
+ * \param       dest
+ *              The address of a caller supplied destination buffer in system
+ *              memory large enough to contain the requested block of flash data.
+ *
+ * \param       src
+ *              The flash memory address to begin reading data from.
+ *
+ * \param       size
+ *              The requested number of data bytes to read from the flash device.
+ *
+ * \retval      ALT_E_SUCCESS       The transfer was started.
+ * \retval      ALT_E_BAD_ARG       The size is zero or too large.
+ * \retval      ALT_E_BAD_OPERATION The internal DMA is not enabled.
+ * \retval      ALT_E_ERROR         The controller is busy or the command failed.
+ */
+ALT_STATUS_CODE alt_sdmmc_read_start(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, void *src, const size_t size);
+
+/*!
+ * Start writing a block of data to the SD/MMC flash card.
+ *
+ * As alt_sdmmc_write(), but returns without waiting for the data to be sent.
+ * See alt_sdmmc_read_start() for details.
+ *
+ * \param       card_info
+ *              A pointer to a ALT_SDMMC_CARD_INFO_t structure that holds
+ *              identification and device property information for any detected
+ *              card.
+ *
+ * \param       dest
+ *              The destination flash memory address to begin writing data to.
+ *
+ * \param       src
+ *              The source address in system memory to begin writing data from.
+ *
+ * \param       size
+ *              The requested number of data bytes to write to the flash device.
+ *
+ * \retval      ALT_E_SUCCESS       The transfer was started.
+ * \retval      ALT_E_BAD_ARG       The size is zero or too large.
+ * \retval      ALT_E_BAD_OPERATION The internal DMA is not enabled.
+ * \retval      ALT_E_ERROR         The controller is busy or the command failed.
+ */
+ALT_STATUS_CODE alt_sdmmc_write_start(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, void *src, const size_t size);
+
+/*!
+ * Start reading blocks of data from the SD/MMC flash card.
+ *
+ * As alt_sdmmc_read_start(), but the flash address is given as a block
+ * number. See alt_sdmmc_block_read() for details.
+ */
+ALT_STATUS_CODE alt_sdmmc_block_read_start(ALT_SDMMC_CARD_INFO_t *card_info, void *dest, uint32_t src, const size_t size);
+
+/*!
+ * Start writing blocks of data to the SD/MMC flash card.
+ *
+ * As alt_sdmmc_write_start(), but the flash address is given as a block
+ * number. See alt_sdmmc_block_read() for details.
+ */
+ALT_STATUS_CODE alt_sdmmc_block_write_start(ALT_SDMMC_CARD_INFO_t *card_info, uint32_t dest, void *src, const size_t size);
+
+/*!
+ * Check whether a transfer started by alt_sdmmc_read_start() or
+ * alt_sdmmc_write_start() has completed. This function does not block.
+ *
+ * \retval      ALT_E_TRUE      The transfer has completed, or none was started.
+ * \retval      ALT_E_FALSE     The transfer is still in progress.
+ * \retval      ALT_E_ERROR     The transfer failed.
+ */
+ALT_STATUS_CODE alt_sdmmc_transfer_is_done(void);
+
+/*!
+ * Returns true if the card is signalling busy, for example while it
+ * programs data from a completed write. Commands which transfer data wait
+ * for the card to stop being busy before they are sent.
+ *
+ * \retval      true    The card is busy.
+ * \retval      false   The card is not busy.
+ */
+bool alt_sdmmc_card_is_busy(void);
+
+/*!
+ * The largest number of blocks which can be pre-erased by
+ * alt_sdmmc_card_pre_erase_set().
+ */
+#define ALT_SDMMC_PRE_ERASE_MAX     0x7FFFFF
+
+/*!
+ * Size in bytes of the SD status register read by alt_sdmmc_card_sd_status_get().
+ */
+#define ALT_SDMMC_SD_STATUS_SIZE    64
+
+/*!
+ * Tell an SD card how many blocks the next multiple block write will
+ * cover (SET_WR_BLK_ERASE_COUNT, ACMD23), so that it can erase them
+ * ahead of the data arriving. The count applies only to the next write.
+ *
+ * \param       blocks
+ *              The number of blocks, from 1 to ALT_SDMMC_PRE_ERASE_MAX.
+ *
+ * etval      ALT_E_SUCCESS   The card accepted the count.
+ * etval      ALT_E_BAD_ARG   The count is out of range.
+ * etval      ALT_E_ERROR     The command failed (e.g. not an SD card).
+ */
+ALT_STATUS_CODE alt_sdmmc_card_pre_erase_set(uint32_t blocks);
+
+/*!
+ * Read the 512-bit SD status register of an SD card (SD_STATUS, ACMD13),
+ * which holds the allocation unit size among other properties. The
+ * bytes are returned in the order sent by the card, most significant
+ * first.
+ *
+ * \param       sd_status
+ *              [out] A 32-bit aligned buffer of ALT_SDMMC_SD_STATUS_SIZE bytes.
+ *
+ * etval      ALT_E_SUCCESS   The register was read.
+ * etval      ALT_E_ERROR     The command failed (e.g. not an SD card).
+ */
+ALT_STATUS_CODE alt_sdmmc_card_sd_status_get(uint32_t *sd_status);
+
 /*! @} */
 
 /*! @} */
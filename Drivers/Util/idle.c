@@ -0,0 +1,158 @@
+/*
+ * Idle Loop with Wake Source Accounting
+ * -------------------------------------
+ *
+ * Puts the core to sleep with WFI when it has nothing to do, rather
+ * than spinning on Event_process() or a driver's busy function.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "idle.h"
+
+#include <string.h>
+
+#include "Util/irq.h"
+#include "Util/timestamp.h"
+#include "Util/lowlevel_arm.h"
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise idle loop accounting
+//  - Returns ERR_NOSUPPORT if not running on the HPS.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t Idle_initialise(IdleCtx_t** pCtx) {
+#if defined(__arm__)
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Statistics start now
+    IdleCtx_t* ctx = *pCtx;
+    ctx->since = time_now_cycles();
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+#else
+    (void)pCtx;
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool Idle_isInitialised(IdleCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Sleep until an interrupt, with IRQs already masked
+//  - For use by callers which have checked for work with IRQs masked.
+//    The wake source's handler runs once the caller unmasks IRQs.
+//  - Returns the ID of the interrupt which woke the core, or ERR_NOTFOUND
+//    if there was none pending.
+HpsErr_t Idle_wfi(IdleCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+#if defined(__arm__)
+    uint64_t start = time_now_cycles();
+    __WFI();
+    ctx->idleCycles += time_now_cycles() - start;
+    ctx->sleeps++;
+    //The wake source is still pending, as IRQs are masked
+    HPSIRQSource wake;
+    status = HPS_IRQ_getPending(&wake);
+    if (ERR_IS_ERROR(status)) {
+        ctx->unknown++;
+        return status;
+    }
+    ctx->wakes[wake]++;
+    return (HpsErr_t)wake;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Sleep until the next interrupt
+//  - Masks IRQs, sleeps, then restores them so the wake source is handled.
+//  - Returns the ID of the interrupt which woke the core, or ERR_NOTFOUND
+//    if there was none pending.
+HpsErr_t Idle_sleep(IdleCtx_t* ctx) {
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    HpsErr_t status = Idle_wfi(ctx);
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return status;
+}
+
+// Sleep until a condition is met
+//  - cond is checked with IRQs masked, and the core sleeps until the next
+//    interrupt each time it returns ERR_BUSY or ERR_AGAIN.
+//  - Functions such as DMA_transferDone can be used directly.
+//  - Returns the final value from cond.
+HpsErr_t Idle_waitUntil(IdleCtx_t* ctx, IdleWaitFunc_t cond, void* param) {
+    if (!cond) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    while (true) {
+        //Check with IRQs masked so that completion between the check and WFI
+        //still wakes us.
+        HpsErr_t irqStatus = IRQ_globalEnable(false);
+        status = cond(param);
+        bool waiting = (status == ERR_BUSY) || (status == ERR_AGAIN);
+        if (waiting) {
+            HpsErr_t wake = Idle_wfi(ctx);
+            if (wake == ERR_NOSUPPORT) waiting = false;
+        }
+        IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+        if (!waiting) return status;
+    }
+}
+
+// Get the idle statistics
+HpsErr_t Idle_getStats(IdleCtx_t* ctx, IdleStats_t* stats) {
+    if (!stats) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    stats->idleCycles = ctx->idleCycles;
+    stats->elapsedCycles = time_now_cycles() - ctx->since;
+    stats->sleeps = ctx->sleeps;
+    stats->unknown = ctx->unknown;
+    return ERR_SUCCESS;
+}
+
+// Get the number of times an interrupt woke the core
+//  - interruptID is between 0 and IDLE_WAKE_SOURCES - 1.
+HpsErr_t Idle_getWakeCount(IdleCtx_t* ctx, unsigned int interruptID, unsigned int* count) {
+    if (!count) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (interruptID >= IDLE_WAKE_SOURCES) return ERR_BEYONDEND;
+    *count = ctx->wakes[interruptID];
+    return ERR_SUCCESS;
+}
+
+// Clear the idle statistics and wake counts
+HpsErr_t Idle_clearStats(IdleCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->idleCycles = 0;
+    ctx->sleeps = 0;
+    ctx->unknown = 0;
+    memset(ctx->wakes, 0, sizeof(ctx->wakes));
+    ctx->since = time_now_cycles();
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,129 @@
+/*
+ * Idle Loop with Wake Source Accounting
+ * -------------------------------------
+ *
+ * Puts the core to sleep with WFI when it has nothing to do, rather
+ * than spinning on Event_process() or a driver's busy function. A
+ * sleeping core stops fetching, so frees L2 and interconnect bandwidth
+ * for the other core and the DMA, and saves power.
+ *
+ * The core wakes on any interrupt which is enabled in the GIC for it,
+ * i.e. any source with a handler registered with HPS_IRQ. Each sleep
+ * is timed with the global timer (see Util/timestamp.h), and the
+ * source which woke the core is recorded:
+ *
+ *    Idle_initialise(&idle);
+ *    EventMgr_setIdle(evtMgr, idle);   // Event_sleep() sleeps through Idle
+ *    while (1) {
+ *        Event_sleep(evtMgr);
+ *        Event_process(evtMgr);
+ *    }
+ *
+ * Waiting for a driver which signals completion with an interrupt:
+ *
+ *    Idle_waitUntil(idle, (IdleWaitFunc_t)&DMA_transferDone, dma);
+ *
+ * As in Event_sleep(), each sleep is entered with IRQs masked, so
+ * that an interrupt arriving between checking for work and the WFI
+ * still wakes the core. The time asleep and the highest priority
+ * pending interrupt are read before IRQs are unmasked, so idle time
+ * does not include the handler of the wake source.
+ *
+ * Only the calling core's interrupts wake it. A condition which only
+ * changes without an interrupt (e.g. a DMA transfer with its interrupt
+ * disabled) must not be waited on with Idle_waitUntil().
+ *
+ * Supported on the Cyclone V/Arria 10 HPS (HPS_IRQ) only.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include "Util/driver_ctx.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Number of interrupt IDs wake counts are kept for
+#define IDLE_WAKE_SOURCES 256
+
+// Idle wait condition
+//  - Return ERR_BUSY or ERR_AGAIN to keep waiting
+//  - Any other value ends the wait, and is returned from Idle_waitUntil.
+typedef HpsErr_t (*IdleWaitFunc_t)(void* param);
+
+// Idle statistics
+//  - Times are in global timer cycles.
+typedef struct {
+    uint64_t     idleCycles;    // Time spent asleep
+    uint64_t     elapsedCycles; // Time since the statistics were cleared
+    unsigned int sleeps;        // Number of times WFI was executed
+    unsigned int unknown;       // Wakes without a pending interrupt (e.g. FIQ or debug)
+} IdleStats_t;
+
+// Idle Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    uint64_t     since;         // Global timer when statistics were cleared
+    uint64_t     idleCycles;
+    unsigned int sleeps;
+    unsigned int unknown;
+    unsigned int wakes[IDLE_WAKE_SOURCES];
+} IdleCtx_t;
+
+// Initialise idle loop accounting
+//  - Returns ERR_NOSUPPORT if not running on the HPS.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t Idle_initialise(IdleCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool Idle_isInitialised(IdleCtx_t* ctx);
+
+// Sleep until an interrupt, with IRQs already masked
+//  - For use by callers which have checked for work with IRQs masked.
+//    The wake source's handler runs once the caller unmasks IRQs.
+//  - Returns the ID of the interrupt which woke the core, or ERR_NOTFOUND
+//    if there was none pending.
+HpsErr_t Idle_wfi(IdleCtx_t* ctx);
+
+// Sleep until the next interrupt
+//  - Masks IRQs, sleeps, then restores them so the wake source is handled.
+//  - Returns the ID of the interrupt which woke the core, or ERR_NOTFOUND
+//    if there was none pending.
+HpsErr_t Idle_sleep(IdleCtx_t* ctx);
+
+// Sleep until a condition is met
+//  - cond is checked with IRQs masked, and the core sleeps until the next
+//    interrupt each time it returns ERR_BUSY or ERR_AGAIN.
+//  - Functions such as DMA_transferDone can be used directly.
+//  - Returns the final value from cond.
+HpsErr_t Idle_waitUntil(IdleCtx_t* ctx, IdleWaitFunc_t cond, void* param);
+
+// Get the idle statistics
+HpsErr_t Idle_getStats(IdleCtx_t* ctx, IdleStats_t* stats);
+
+// Get the number of times an interrupt woke the core
+//  - interruptID is between 0 and IDLE_WAKE_SOURCES - 1.
+HpsErr_t Idle_getWakeCount(IdleCtx_t* ctx, unsigned int interruptID, unsigned int* count);
+
+// Clear the idle statistics and wake counts
+HpsErr_t Idle_clearStats(IdleCtx_t* ctx);
+
+#endif /* IDLE_H_ */
@@ -0,0 +1,281 @@
+/*
+ * RGB565 Image Scaling
+ * --------------------
+ *
+ * Scales RGB565 images up or down to any size.
+ *
+ * Positions in the image are 16.16 fixed point. The source column
+ * and blend weight of each scaled column are worked out once for a
+ * span of up to IMAGE_SCALE_SPAN columns, then used for every row of
+ * the window. Bilinear filtering blends across each image row into a
+ * line buffer, then blends the two line buffers for each scaled row.
+ * The NEON versions gather 8 pixels of each neighbour with lane
+ * loads, split the channels into 16-bit lanes, and blend them with
+ * multiply-accumulate and a rounding shift.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "image_scale.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Scaled columns mapped at a time
+#define IMAGE_SCALE_SPAN 64
+
+// Weight of a whole pixel
+#define IMAGE_SCALE_ONE  256
+
+// Mapping from scaled to image positions along one axis
+typedef struct {
+    int32_t start;   // Position of scaled pixel 0
+    int32_t step;    // Distance between scaled pixels
+    int32_t max;     // Last valid position
+    unsigned int last;  // Last image pixel
+} ImageScaleAxis_t;
+
+// Source columns of a span of scaled columns
+typedef struct {
+    uint16_t left[IMAGE_SCALE_SPAN];
+    uint16_t right[IMAGE_SCALE_SPAN];
+    uint16_t weight[IMAGE_SCALE_SPAN];   // Weight of the right pixel
+} ImageScaleMap_t;
+
+/*
+ * Internal Functions
+ */
+
+// Set up the mapping for one axis
+//  - Nearest takes the pixel under the centre of each scaled pixel.
+//    Bilinear is offset by half a pixel so that the weight is that
+//    of the next pixel, and clamped so the edge pixels aren't blended
+//    with anything beyond the image.
+static void _ImageScale_axis(ImageScaleAxis_t* axis, unsigned int size, unsigned int scaled, ImageScaleFilter filter) {
+    axis->step = (int32_t)(((uint64_t)size << 16) / scaled);
+    axis->last = size - 1;
+    if (filter == IMAGE_SCALE_BILINEAR) {
+        axis->start = axis->step / 2 - 0x8000;
+        axis->max = (int32_t)(axis->last << 16);
+    } else {
+        axis->start = axis->step / 2;
+        axis->max = (int32_t)((size << 16) - 1);
+    }
+}
+
+// Get the image pixel for a scaled pixel
+//  - Returns the integer pixel to *index, and the 8-bit weight of the next pixel.
+static unsigned int _ImageScale_position(const ImageScaleAxis_t* axis, unsigned int pixel, unsigned int* index) {
+    int32_t pos = axis->start + (int32_t)pixel * axis->step;
+    if (pos < 0) pos = 0;
+    if (pos > axis->max) pos = axis->max;
+    *index = (unsigned int)pos >> 16;
+    return ((unsigned int)pos >> 8) & 0xFF;
+}
+
+// Map a span of scaled columns to the image
+static void _ImageScale_mapSpan(ImageScaleMap_t* map, const ImageScaleAxis_t* axis, unsigned int first, unsigned int count) {
+    for (unsigned int x = 0; x < count; x++) {
+        unsigned int left;
+        map->weight[x] = (uint16_t)_ImageScale_position(axis, first + x, &left);
+        map->left[x]   = (uint16_t)left;
+        map->right[x]  = (uint16_t)((left < axis->last) ? (left + 1) : left);
+    }
+}
+
+// Blend two pixels
+//  - weight is that of b, from 0 to IMAGE_SCALE_ONE.
+static inline unsigned short _ImageScale_blend(unsigned int a, unsigned int b, unsigned int weight) {
+    unsigned int inv = IMAGE_SCALE_ONE - weight;
+    unsigned int r = (((a >> 11)        ) * inv + ((b >> 11)        ) * weight + 0x80) >> 8;
+    unsigned int g = (((a >>  5) & 0x3F) * inv + ((b >>  5) & 0x3F) * weight + 0x80) >> 8;
+    unsigned int c = (((a      ) & 0x1F) * inv + ((b      ) & 0x1F) * weight + 0x80) >> 8;
+    return (unsigned short)((r << 11) | (g << 5) | c);
+}
+
+#if defined(__ARM_NEON)
+// Gather 8 pixels from a row
+static inline uint16x8_t _ImageScale_gather8(const unsigned short* src, const uint16_t* index) {
+    uint16x8_t out = vdupq_n_u16(0);
+    out = vld1q_lane_u16(&src[index[0]], out, 0);
+    out = vld1q_lane_u16(&src[index[1]], out, 1);
+    out = vld1q_lane_u16(&src[index[2]], out, 2);
+    out = vld1q_lane_u16(&src[index[3]], out, 3);
+    out = vld1q_lane_u16(&src[index[4]], out, 4);
+    out = vld1q_lane_u16(&src[index[5]], out, 5);
+    out = vld1q_lane_u16(&src[index[6]], out, 6);
+    out = vld1q_lane_u16(&src[index[7]], out, 7);
+    return out;
+}
+
+// Blend 8 pairs of pixels
+//  - weight is that of b, inv that of a. Each channel times the weight still
+//    fits in 16 bits, so the sum of both terms can't overflow.
+static inline uint16x8_t _ImageScale_blend8(uint16x8_t a, uint16x8_t b, uint16x8_t weight, uint16x8_t inv) {
+    uint16x8_t mask5 = vdupq_n_u16(0x1F);
+    uint16x8_t mask6 = vdupq_n_u16(0x3F);
+    uint16x8_t r = vmlaq_u16(vmulq_u16(vshrq_n_u16(a, 11), inv), vshrq_n_u16(b, 11), weight);
+    uint16x8_t g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(a, 5), mask6), inv), vandq_u16(vshrq_n_u16(b, 5), mask6), weight);
+    uint16x8_t c = vmlaq_u16(vmulq_u16(vandq_u16(a, mask5), inv), vandq_u16(b, mask5), weight);
+    //Back to 565. Weights sum to 256, so each channel is in range after the shift.
+    uint16x8_t out = vshlq_n_u16(vrshrq_n_u16(r, 8), 11);
+    out = vorrq_u16(out, vshlq_n_u16(vrshrq_n_u16(g, 8), 5));
+    return vorrq_u16(out, vrshrq_n_u16(c, 8));
+}
+#endif
+
+// Scale a span of an image row with bilinear filtering
+static void _ImageScale_rowBilinear(unsigned short* dst, const unsigned short* src, const ImageScaleMap_t* map, unsigned int count) {
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint16x8_t one = vdupq_n_u16(IMAGE_SCALE_ONE);
+    for (; x + 8 <= count; x += 8) {
+        uint16x8_t a = _ImageScale_gather8(src, &map->left[x]);
+        uint16x8_t b = _ImageScale_gather8(src, &map->right[x]);
+        uint16x8_t weight = vld1q_u16(&map->weight[x]);
+        vst1q_u16(&dst[x], _ImageScale_blend8(a, b, weight, vsubq_u16(one, weight)));
+    }
+#endif
+    for (; x < count; x++) {
+        dst[x] = _ImageScale_blend(src[map->left[x]], src[map->right[x]], map->weight[x]);
+    }
+}
+
+// Blend two rows with a constant weight
+static void _ImageScale_rowBlend(unsigned short* dst, const unsigned short* top, const unsigned short* bottom, unsigned int count, unsigned int weight) {
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint16x8_t weights = vdupq_n_u16(weight);
+    uint16x8_t invs    = vdupq_n_u16(IMAGE_SCALE_ONE - weight);
+    for (; x + 8 <= count; x += 8) {
+        vst1q_u16(&dst[x], _ImageScale_blend8(vld1q_u16(&top[x]), vld1q_u16(&bottom[x]), weights, invs));
+    }
+#endif
+    for (; x < count; x++) {
+        dst[x] = _ImageScale_blend(top[x], bottom[x], weight);
+    }
+}
+
+// Scale a span of columns for every row of the window with nearest filtering
+static void _ImageScale_spanNearest(unsigned short* dst, unsigned int dstStride, const unsigned short* src, unsigned int srcStride,
+                                    const ImageScaleMap_t* map, unsigned int count, const ImageScaleAxis_t* yAxis, unsigned int yoff, unsigned int height) {
+    unsigned int prevRow = UINT32_MAX;
+    for (unsigned int row = 0; row < height; row++) {
+        unsigned int srcRow;
+        _ImageScale_position(yAxis, yoff + row, &srcRow);
+        if (srcRow == prevRow) {
+            //Same image row as the row above
+            memcpy(dst, dst - dstStride, count * sizeof(unsigned short));
+        } else {
+            const unsigned short* line = &src[srcRow * srcStride];
+            for (unsigned int x = 0; x < count; x++) {
+                dst[x] = line[map->left[x]];
+            }
+            prevRow = srcRow;
+        }
+        dst += dstStride;
+    }
+}
+
+// Scale a span of columns for every row of the window with bilinear filtering
+//  - The two image rows in use are kept scaled across in line buffers. When
+//    moving down to the next pair, the lower row becomes the upper one.
+static void _ImageScale_spanBilinear(unsigned short* dst, unsigned int dstStride, const unsigned short* src, unsigned int srcStride,
+                                     const ImageScaleMap_t* map, unsigned int count, const ImageScaleAxis_t* yAxis, unsigned int yoff, unsigned int height) {
+    unsigned short buf[2][IMAGE_SCALE_SPAN];
+    unsigned short* line[2] = { buf[0], buf[1] };
+    unsigned int lineRow[2] = { UINT32_MAX, UINT32_MAX };
+    for (unsigned int row = 0; row < height; row++) {
+        unsigned int top;
+        unsigned int weight = _ImageScale_position(yAxis, yoff + row, &top);
+        if (lineRow[0] != top) {
+            if (lineRow[1] == top) {
+                unsigned short* swap = line[0];
+                line[0] = line[1];
+                line[1] = swap;
+                lineRow[1] = lineRow[0];
+            } else {
+                _ImageScale_rowBilinear(line[0], &src[top * srcStride], map, count);
+            }
+            lineRow[0] = top;
+        }
+        if (!weight) {
+            memcpy(dst, line[0], count * sizeof(unsigned short));
+        } else {
+            unsigned int bottom = (top < yAxis->last) ? (top + 1) : top;
+            if (lineRow[1] != bottom) {
+                _ImageScale_rowBilinear(line[1], &src[bottom * srcStride], map, count);
+                lineRow[1] = bottom;
+            }
+            _ImageScale_rowBlend(dst, line[0], line[1], count, weight);
+        }
+        dst += dstStride;
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Draw a window of a scaled RGB565 image
+//  - dst is the top left pixel of the window, with dstStride pixels between rows.
+//  - src is a srcWidth x srcHeight image with srcStride pixels between rows.
+//    A stride of 0 means the same as the width.
+//  - Returns ERR_SKIPPED if the window is empty.
+//  - Returns ERR_TOOSMALL if the image or scaled size is 0.
+//  - Returns ERR_TOOBIG if the image or scaled size is over IMAGE_SCALE_MAX_SIZE.
+//  - Returns ERR_OUTRANGE if the window is not within the scaled image,
+//    or a stride is less than the width.
+HpsErr_t ImageScale_rgb565(unsigned short* dst, unsigned int dstStride, const unsigned short* src, unsigned int srcStride,
+                           unsigned int srcWidth, unsigned int srcHeight, const ImageScaleWindow_t* window, ImageScaleFilter filter) {
+    if (!dst || !src || !window) return ERR_NULLPTR;
+    if (!srcWidth || !srcHeight || !window->scaledWidth || !window->scaledHeight) return ERR_TOOSMALL;
+    if ((srcWidth  > IMAGE_SCALE_MAX_SIZE) || (window->scaledWidth  > IMAGE_SCALE_MAX_SIZE) ||
+        (srcHeight > IMAGE_SCALE_MAX_SIZE) || (window->scaledHeight > IMAGE_SCALE_MAX_SIZE)) return ERR_TOOBIG;
+    if (!srcStride) srcStride = srcWidth;
+    if (srcStride < srcWidth) return ERR_OUTRANGE;
+    if (!window->width || !window->height) return ERR_SKIPPED;
+    if (dstStride < window->width) return ERR_OUTRANGE;
+    if (((uint64_t)window->xoff + window->width  > window->scaledWidth ) ||
+        ((uint64_t)window->yoff + window->height > window->scaledHeight)) return ERR_OUTRANGE;
+    //Unscaled, so just copy the window
+    if ((window->scaledWidth == srcWidth) && (window->scaledHeight == srcHeight)) {
+        src += window->yoff * srcStride + window->xoff;
+        for (unsigned int row = 0; row < window->height; row++) {
+            memcpy(dst, src, window->width * sizeof(unsigned short));
+            dst += dstStride;
+            src += srcStride;
+        }
+        return ERR_SUCCESS;
+    }
+    ImageScaleAxis_t xAxis;
+    ImageScaleAxis_t yAxis;
+    _ImageScale_axis(&xAxis, srcWidth,  window->scaledWidth,  filter);
+    _ImageScale_axis(&yAxis, srcHeight, window->scaledHeight, filter);
+    //Draw the window a span of columns at a time
+    ImageScaleMap_t map;
+    for (unsigned int col = 0; col < window->width; col += IMAGE_SCALE_SPAN) {
+        unsigned int count = window->width - col;
+        if (count > IMAGE_SCALE_SPAN) count = IMAGE_SCALE_SPAN;
+        _ImageScale_mapSpan(&map, &xAxis, window->xoff + col, count);
+        if (filter == IMAGE_SCALE_BILINEAR) {
+            _ImageScale_spanBilinear(&dst[col], dstStride, src, srcStride, &map, count, &yAxis, window->yoff, window->height);
+        } else {
+            _ImageScale_spanNearest(&dst[col], dstStride, src, srcStride, &map, count, &yAxis, window->yoff, window->height);
+        }
+    }
+    return ERR_SUCCESS;
+}
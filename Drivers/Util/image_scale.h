@@ -0,0 +1,97 @@
+/*
+ * RGB565 Image Scaling
+ * --------------------
+ *
+ * Scales RGB565 images up or down to any size, e.g. for gallery
+ * thumbnails or zoomed views of an image, drawing straight into a
+ * frame buffer, a region of one, or a band of scanlines.
+ *
+ *    //Draw the part of an image zoomed to 640x480 which is visible
+ *    //in a 320x240 frame buffer, panned 100 pixels across.
+ *    ImageScaleWindow_t window = { 640, 480, 100, 0, 320, 240 };
+ *    ImageScale_rgb565(fb, 320, image, 0, 160, 120, &window, IMAGE_SCALE_BILINEAR);
+ *
+ * The scaled size need not be a multiple of the image size, and can
+ * differ in each direction. Only the window of the scaled image being
+ * drawn is computed, so an image which is mostly off screen, or only
+ * partly within a band, costs nothing for the hidden part.
+ *
+ * Filters
+ * -------
+ *
+ *  - IMAGE_SCALE_NEAREST:  Each pixel is a copy of the nearest image
+ *                          pixel. Fast, and keeps pixel art sharp.
+ *  - IMAGE_SCALE_BILINEAR: Each pixel is blended from the four nearest
+ *                          image pixels with 8-bit weights, for smooth
+ *                          zooming. When shrinking by more than half,
+ *                          image pixels between samples are skipped,
+ *                          so fine detail will alias.
+ *
+ * Pixel centres are aligned, so the scaled image is not shifted by
+ * half a pixel relative to the original. When the scaled size equals
+ * the image size, the window is copied directly.
+ *
+ * NEON
+ * ----
+ *
+ * Where the compiler has NEON enabled (__ARM_NEON), the bilinear
+ * blends are vectorised to process 8 pixels at a time. Each image row
+ * is only scaled across once, and is kept while the scaled rows which
+ * use it are drawn, so enlarging costs little more than a copy. With
+ * nearest filtering, scaled rows which repeat are copied from the one
+ * above.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef IMAGE_SCALE_H_
+#define IMAGE_SCALE_H_
+
+#include <stdint.h>
+
+#include "Util/error.h"
+
+// Largest image or scaled width or height
+#define IMAGE_SCALE_MAX_SIZE 32767
+
+// Scaling filter
+typedef enum {
+    IMAGE_SCALE_NEAREST,   // Nearest neighbour
+    IMAGE_SCALE_BILINEAR   // Blend of the four nearest pixels
+} ImageScaleFilter;
+
+// Window of a scaled image
+//  - The image is scaled to scaledWidth x scaledHeight, and the
+//    width x height pixels starting from (xoff,yoff) within the
+//    scaled image are drawn.
+typedef struct {
+    unsigned int scaledWidth;
+    unsigned int scaledHeight;
+    unsigned int xoff;
+    unsigned int yoff;
+    unsigned int width;
+    unsigned int height;
+} ImageScaleWindow_t;
+
+// Draw a window of a scaled RGB565 image
+//  - dst is the top left pixel of the window, with dstStride pixels between rows.
+//  - src is a srcWidth x srcHeight image with srcStride pixels between rows.
+//    A stride of 0 means the same as the width.
+//  - Returns ERR_SKIPPED if the window is empty.
+//  - Returns ERR_TOOSMALL if the image or scaled size is 0.
+//  - Returns ERR_TOOBIG if the image or scaled size is over IMAGE_SCALE_MAX_SIZE.
+//  - Returns ERR_OUTRANGE if the window is not within the scaled image,
+//    or a stride is less than the width.
+HpsErr_t ImageScale_rgb565(unsigned short* dst, unsigned int dstStride, const unsigned short* src, unsigned int srcStride,
+                           unsigned int srcWidth, unsigned int srcHeight, const ImageScaleWindow_t* window, ImageScaleFilter filter);
+
+#endif /* IMAGE_SCALE_H_ */
@@ -0,0 +1,190 @@
+/*
+ * Parallel Driver Initialisation
+ * ------------------------------
+ *
+ * Runs the initialisation of several drivers at the same time
+ * from an event manager, rather than one after another with
+ * blocking delays.
+ *
+ * A single repeating event polls all of the tasks. Each task
+ * keeps the timer value it was last stepped at and the number
+ * of ticks it asked to wait, and is stepped again once that
+ * has elapsed. The event stops itself once no task is running,
+ * and is restarted when another is added.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "init_seq.h"
+#include "Util/mem_pool.h"
+
+/*
+ * Internal Functions
+ */
+
+static void _InitSeq_cleanup(InitSeqCtx_t* ctx) {
+    //Stop stepping tasks
+    if (ctx->event) {
+        Event_destroy(ctx->event);
+        ctx->event = NULL;
+    }
+    //Free the task list
+    if (ctx->tasks) {
+        MemPool_free(ctx->tasks);
+        ctx->tasks = NULL;
+    }
+}
+
+// Convert microseconds to event timer ticks, rounding up
+static unsigned int _InitSeq_ticks(InitSeqCtx_t* ctx, unsigned int delay) {
+    unsigned long long ticks = ((unsigned long long)delay * ctx->rate + 999999ULL) / 1000000ULL;
+    return (ticks > UINT32_MAX) ? UINT32_MAX : (unsigned int)ticks;
+}
+
+// Step any tasks which are due
+//  - Called from the init sequencer event.
+static HpsErr_t _InitSeq_poll(Event_t* event, void* param) {
+    InitSeqCtx_t* ctx = (InitSeqCtx_t*)param;
+    unsigned int curTime;
+    if (ERR_IS_ERROR(Timer_getTime(ctx->evtMgr->timer, &curTime))) return ERR_AGAIN;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        InitTask_t* task = &ctx->tasks[idx];
+        if (!ERR_IS_RETRY(task->status)) continue;
+        //Timer counts down, so elapsed time is last minus current
+        if ((task->lastTime - curTime) < task->wait) continue;
+        unsigned int delay = 0;
+        task->status = task->step(task->ctx, &delay);
+        if (ERR_IS_RETRY(task->status)) {
+            //Wait from now, as the step itself may have taken some time
+            Timer_getTime(ctx->evtMgr->timer, &task->lastTime);
+            task->wait = _InitSeq_ticks(ctx, delay);
+            continue;
+        }
+        //Finished. Keep the first error.
+        if (ERR_IS_ERROR(task->status) && ERR_IS_SUCCESS(ctx->status)) ctx->status = task->status;
+        ctx->pending--;
+    }
+    //Stop polling once everything is done
+    return ctx->pending ? ERR_AGAIN : ERR_SUCCESS;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Init Sequencer
+//  - evtMgr is the event manager used to step the tasks.
+//  - maxTasks is the maximum number of drivers to be initialised.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t InitSeq_initialise(EventMgrCtx_t* evtMgr, unsigned int maxTasks, InitSeqCtx_t** pCtx) {
+    if (!maxTasks) return ERR_TOOSMALL;
+    if (!EventMgr_isInitialised(evtMgr)) return ERR_BADDEVICE;
+    //Need the timer rate to convert delays
+    unsigned int rate;
+    HpsErr_t status = Timer_getRate(evtMgr->timer, UINT32_MAX, &rate);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!rate) return ERR_NOSUPPORT;
+    //Allocate the driver context, validating return value.
+    status = DriverContextAllocateWithCleanup(pCtx, &_InitSeq_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save context values
+    InitSeqCtx_t* ctx = *pCtx;
+    ctx->evtMgr = evtMgr;
+    ctx->rate = rate;
+    //Allocate the task list
+    ctx->tasks = (InitTask_t*)MemPool_calloc(maxTasks, sizeof(*ctx->tasks));
+    if (!ctx->tasks) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->size = maxTasks;
+    ctx->count = 0;
+    ctx->pending = 0;
+    ctx->status = ERR_SUCCESS;
+    //Create the polling event, which starts disabled until a task is added
+    unsigned int interval = _InitSeq_ticks(ctx, INIT_SEQ_POLL_US);
+    status = Event_create(evtMgr, EVENT_TYPE_REPEAT, interval ? interval : 1, &_InitSeq_poll, ctx, &ctx->event);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool InitSeq_isInitialised(InitSeqCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Add a driver initialisation task
+//  - step is the driver step function, and drvCtx the context returned by
+//    its start function.
+//  - The first step is made on the next poll.
+//  - Returns ERR_NOSPACE if maxTasks have already been added.
+HpsErr_t InitSeq_add(InitSeqCtx_t* ctx, InitStepFunc_t step, void* drvCtx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!step || !drvCtx) return ERR_NULLPTR;
+    if (ctx->count >= ctx->size) return ERR_NOSPACE;
+    //Add the task, due straight away
+    InitTask_t* task = &ctx->tasks[ctx->count];
+    task->step = step;
+    task->ctx = drvCtx;
+    task->status = ERR_AGAIN;
+    task->lastTime = 0;
+    task->wait = 0;
+    ctx->count++;
+    ctx->pending++;
+    //Start polling if not already
+    if (ctx->pending == 1) {
+        status = Event_setMode(ctx->event, EVENT_TYPE_REPEAT, EVENT_INTERVAL_UNCHANGED);
+        if (ERR_IS_ERROR(status)) return status;
+        if (!EVENT_STATE_SUCCESS(Event_state(ctx->event, EVENT_CNTRL_RESTART, EVENT_INTERVAL_UNCHANGED))) return ERR_UNKNOWN;
+    }
+    return ERR_SUCCESS;
+}
+
+// Get overall initialisation status
+//  - Returns ERR_AGAIN while any task is still running.
+//  - Otherwise returns the first task error, or ERR_SUCCESS if all succeeded.
+HpsErr_t InitSeq_status(InitSeqCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return ctx->pending ? ERR_AGAIN : ctx->status;
+}
+
+// Get initialisation status of a single driver
+//  - Returns ERR_AGAIN while running, then the result of its initialisation.
+//  - Returns ERR_NOTFOUND if drvCtx was not added.
+HpsErr_t InitSeq_taskStatus(InitSeqCtx_t* ctx, void* drvCtx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        if (ctx->tasks[idx].ctx == drvCtx) return ctx->tasks[idx].status;
+    }
+    return ERR_NOTFOUND;
+}
+
+// Wait for all tasks to finish
+//  - Calls Event_process() until no task is still running.
+//  - Returns as InitSeq_status(), or an error from Event_process().
+HpsErr_t InitSeq_wait(InitSeqCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    while (ctx->pending) {
+        status = Event_process(ctx->evtMgr);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    return ctx->status;
+}
@@ -0,0 +1,131 @@
+/*
+ * Parallel Driver Initialisation
+ * ------------------------------
+ *
+ * Runs the initialisation of several drivers at the same time
+ * from an event manager, rather than one after another with
+ * blocking delays. Peripherals such as the LT24 LCD need long
+ * power-up waits (over 250ms), and codecs need a sequence of
+ * I2C writes, so starting them all together and stepping each
+ * when it is ready greatly reduces boot time.
+ *
+ * Drivers which support this provide a pair of functions:
+ *
+ *    X_initialiseStart(..., &ctx)
+ *        Checks the arguments and allocates the context, but does
+ *        not wait for the hardware. The context is not yet initialised.
+ *
+ *    X_initialiseStep(ctx, &delay)
+ *        Makes the next step of initialisation. Returns ERR_AGAIN
+ *        with the number of microseconds until it should next be
+ *        called in *delay, ERR_SUCCESS once initialised, or an error.
+ *
+ * These are then added as tasks to an init sequencer:
+ *
+ *    InitSeq_initialise(evtMgr, 4, &initSeq);
+ *    LT24_initialiseStart(gpio, lcdBase, &lt24);
+ *    InitSeq_add(initSeq, (InitStepFunc_t)&LT24_initialiseStep, lt24);
+ *    WM8731_initialiseStart(audioBase, i2c, &audio);
+ *    InitSeq_add(initSeq, (InitStepFunc_t)&WM8731_initialiseStep, audio);
+ *    ...
+ *    // Either carry on with other work, calling Event_process() as
+ *    // normal until InitSeq_status() is no longer ERR_AGAIN, or:
+ *    status = InitSeq_wait(initSeq);
+ *
+ * Tasks are polled every INIT_SEQ_POLL_US microseconds (default 100)
+ * from a repeating event, so delays are rounded up to this. If a task
+ * fails, its driver context is left uninitialised and should be freed
+ * by the caller with DriverContextFree(). Other tasks keep running.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef INIT_SEQ_H_
+#define INIT_SEQ_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/event.h"
+
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Polling interval for init tasks in microseconds
+#ifndef INIT_SEQ_POLL_US
+#define INIT_SEQ_POLL_US 100
+#endif
+
+// Initialisation step function
+//  - ctx is the driver context passed to InitSeq_add().
+//  - Return ERR_AGAIN to be called again after *delay microseconds.
+//    *delay is 0 on entry, meaning call again on the next poll.
+//  - Return ERR_SUCCESS once initialised, or an error code if failed.
+typedef HpsErr_t (*InitStepFunc_t)(void* ctx, unsigned int* delay);
+
+// Init task
+typedef struct {
+    InitStepFunc_t step;
+    void*          ctx;
+    HpsErr_t       status;    // ERR_AGAIN while running, then the result
+    unsigned int   lastTime;  // Timer value when last stepped
+    unsigned int   wait;      // Timer ticks to wait from lastTime
+} InitTask_t;
+
+// Init Sequencer Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    EventMgrCtx_t* evtMgr;
+    Event_t*       event;     // Repeating event which steps the tasks
+    unsigned int   rate;      // Event timer ticks per second
+    InitTask_t*    tasks;
+    unsigned int   size;      // Maximum number of tasks
+    unsigned int   count;     // Number of tasks added
+    unsigned int   pending;   // Number of tasks still running
+    HpsErr_t       status;    // First task error, if any
+} InitSeqCtx_t;
+
+// Initialise Init Sequencer
+//  - evtMgr is the event manager used to step the tasks.
+//  - maxTasks is the maximum number of drivers to be initialised.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t InitSeq_initialise(EventMgrCtx_t* evtMgr, unsigned int maxTasks, InitSeqCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool InitSeq_isInitialised(InitSeqCtx_t* ctx);
+
+// Add a driver initialisation task
+//  - step is the driver step function, and drvCtx the context returned by
+//    its start function.
+//  - The first step is made on the next poll.
+//  - Returns ERR_NOSPACE if maxTasks have already been added.
+HpsErr_t InitSeq_add(InitSeqCtx_t* ctx, InitStepFunc_t step, void* drvCtx);
+
+// Get overall initialisation status
+//  - Returns ERR_AGAIN while any task is still running.
+//  - Otherwise returns the first task error, or ERR_SUCCESS if all succeeded.
+HpsErr_t InitSeq_status(InitSeqCtx_t* ctx);
+
+// Get initialisation status of a single driver
+//  - Returns ERR_AGAIN while running, then the result of its initialisation.
+//  - Returns ERR_NOTFOUND if drvCtx was not added.
+HpsErr_t InitSeq_taskStatus(InitSeqCtx_t* ctx, void* drvCtx);
+
+// Wait for all tasks to finish
+//  - Calls Event_process() until no task is still running.
+//  - Returns as InitSeq_status(), or an error from Event_process().
+HpsErr_t InitSeq_wait(InitSeqCtx_t* ctx);
+
+#endif /* INIT_SEQ_H_ */
@@ -0,0 +1,221 @@
+/*
+ * Aggregated Input Scanner
+ * ------------------------
+ *
+ * Debounces a set of board inputs together from a single event,
+ * and reports changes to a callback.
+ *
+ * Each pin has a two bit vertical counter (cnt1:cnt0), which is
+ * held at 3 while the pin reads its debounced state, and counts
+ * down on each sample which differs. When it wraps back round to
+ * 3, the pin has differed for INPUT_SCAN_SAMPLES samples, so its
+ * state is toggled. The scan event stops itself once all counters
+ * are at rest, if every source can wake it again by interrupt.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "input_scan.h"
+#include "Util/mem_pool.h"
+#include "Util/work.h"
+
+/*
+ * Internal Functions
+ */
+
+static void _InputScan_cleanup(InputScanCtx_t* ctx) {
+    //Stop scanning
+    if (ctx->event) {
+        Event_destroy(ctx->event);
+        ctx->event = NULL;
+    }
+    //Free the source list
+    if (ctx->sources) {
+        MemPool_free(ctx->sources);
+        ctx->sources = NULL;
+    }
+}
+
+// Read the current pin values of a source, 1 meaning pressed or on
+static HpsErr_t _InputScan_read(InputSource_t* src, unsigned int* value) {
+    unsigned int raw;
+    HpsErr_t status = GPIO_getInput(src->gpio, &raw, src->mask);
+    if (ERR_IS_ERROR(status)) return status;
+    *value = (raw ^ src->activeLow) & src->mask;
+    return ERR_SUCCESS;
+}
+
+// Start the scan event if not already running
+//  - Called from thread context only.
+static void _InputScan_start(InputScanCtx_t* ctx) {
+    if (ctx->running) return;
+    if (ERR_IS_ERROR(Event_setMode(ctx->event, EVENT_TYPE_REPEAT, EVENT_INTERVAL_UNCHANGED))) return;
+    if (!EVENT_STATE_SUCCESS(Event_state(ctx->event, EVENT_CNTRL_RESTART, EVENT_INTERVAL_UNCHANGED))) return;
+    ctx->running = true;
+}
+
+// Work item posted by InputScan_wake()
+static void _InputScan_wakeWork(void* param, unsigned int arg) {
+    (void)arg;
+    _InputScan_start((InputScanCtx_t*)param);
+}
+
+// Sample and debounce all sources
+//  - Called from the scan event.
+static HpsErr_t _InputScan_poll(Event_t* event, void* param) {
+    (void)event;
+    InputScanCtx_t* ctx = (InputScanCtx_t*)param;
+    unsigned int active = 0;
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        InputSource_t* src = &ctx->sources[idx];
+        unsigned int value;
+        if (ERR_IS_ERROR(_InputScan_read(src, &value))) continue;
+        //Count down pins which differ from their state, and reset the others
+        unsigned int differ = value ^ src->state;
+        src->cnt0 = ~(src->cnt0 & differ);
+        src->cnt1 = src->cnt0 ^ (src->cnt1 & differ);
+        //Pins whose counter has wrapped have changed
+        unsigned int changed = differ & src->cnt0 & src->cnt1;
+        src->state ^= changed;
+        //Any counter not at rest still needs sampling
+        active |= ~(src->cnt0 & src->cnt1) & src->mask;
+        if (changed && ctx->callback) {
+            ctx->callback(idx, changed & src->state, changed & ~src->state, ctx->param);
+        }
+    }
+    //Stop once idle if every source can wake us
+    if (!active && ctx->canIdle && ctx->evtMgr->work) {
+        ctx->running = false;
+        return ERR_SUCCESS;
+    }
+    return ERR_AGAIN;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Input Scanner
+//  - evtMgr is the event manager used to run the scan.
+//  - maxSources is the maximum number of GPIO sources.
+//  - periodUs is the scan period in microseconds, or 0 for INPUT_SCAN_PERIOD_US.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t InputScan_initialise(EventMgrCtx_t* evtMgr, unsigned int maxSources, unsigned int periodUs, InputScanCtx_t** pCtx) {
+    if (!maxSources) return ERR_TOOSMALL;
+    if (!EventMgr_isInitialised(evtMgr)) return ERR_BADDEVICE;
+    //Need the timer rate to convert the period
+    unsigned int rate;
+    HpsErr_t status = Timer_getRate(evtMgr->timer, UINT32_MAX, &rate);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!rate) return ERR_NOSUPPORT;
+    if (!periodUs) periodUs = INPUT_SCAN_PERIOD_US;
+    unsigned long long interval = ((unsigned long long)periodUs * rate + 999999ULL) / 1000000ULL;
+    if (interval > UINT32_MAX) return ERR_TOOBIG;
+    //Allocate the driver context, validating return value.
+    status = DriverContextAllocateWithCleanup(pCtx, &_InputScan_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save context values
+    InputScanCtx_t* ctx = *pCtx;
+    ctx->evtMgr = evtMgr;
+    //Allocate the source list
+    ctx->sources = (InputSource_t*)MemPool_calloc(maxSources, sizeof(*ctx->sources));
+    if (!ctx->sources) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->size = maxSources;
+    ctx->count = 0;
+    ctx->canIdle = true;
+    ctx->running = false;
+    //Create the scan event, which starts disabled until a source is added
+    status = Event_create(evtMgr, EVENT_TYPE_REPEAT, interval ? (unsigned int)interval : 1, &_InputScan_poll, ctx, &ctx->event);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool InputScan_isInitialised(InputScanCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Set the input change callback
+//  - callback is called with param whenever a source changes. NULL to disable.
+HpsErr_t InputScan_setCallback(InputScanCtx_t* ctx, InputScanFunc_t callback, void* param) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->callback = callback;
+    ctx->param = param;
+    return ERR_SUCCESS;
+}
+
+// Add an input source
+//  - gpio is the GPIO to read, and mask the pins to watch.
+//  - activeLow are the pins which read 0 when pressed or on.
+//  - hasIrq is true if an edge interrupt will call InputScan_wake() for
+//    changes on these pins. See notes at top of file.
+//  - The current state of the pins is taken as the initial debounced state.
+//  - Returns the source index to *pSource, if not NULL.
+//  - Returns ERR_NOSPACE if maxSources have already been added.
+HpsErr_t InputScan_addSource(InputScanCtx_t* ctx, GpioCtx_t* gpio, unsigned int mask, unsigned int activeLow, bool hasIrq, unsigned int* pSource) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!GPIO_isInitialised(gpio)) return ERR_BADDEVICE;
+    if (!mask) return ERR_TOOSMALL;
+    if (ctx->count >= ctx->size) return ERR_NOSPACE;
+    //Take the current value as the initial state, with counters at rest
+    InputSource_t* src = &ctx->sources[ctx->count];
+    src->gpio = gpio;
+    src->mask = mask;
+    src->activeLow = activeLow;
+    src->hasIrq = hasIrq;
+    src->cnt0 = UINT32_MAX;
+    src->cnt1 = UINT32_MAX;
+    status = _InputScan_read(src, &src->state);
+    if (ERR_IS_ERROR(status)) return status;
+    if (pSource) *pSource = ctx->count;
+    ctx->count++;
+    if (!hasIrq) ctx->canIdle = false;
+    //Scan straight away, in case an edge was missed before the interrupt was enabled
+    _InputScan_start(ctx);
+    return ctx->running ? ERR_SUCCESS : ERR_UNKNOWN;
+}
+
+// Get the debounced state of a source
+//  - Returns state of the watched pins to *state, with 1 meaning pressed or on.
+//  - Returns ERR_BADID if source does not exist.
+HpsErr_t InputScan_getState(InputScanCtx_t* ctx, unsigned int source, unsigned int* state) {
+    if (!state) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (source >= ctx->count) return ERR_BADID;
+    *state = ctx->sources[source].state;
+    return ERR_SUCCESS;
+}
+
+// Wake the scanner after an input edge
+//  - May be called from an interrupt handler.
+//  - Returns ERR_NOSUPPORT if the event manager has no work queue, in which
+//    case the scan is running anyway.
+//  - Returns ERR_NOSPACE if the work queue is full.
+HpsErr_t InputScan_wake(InputScanCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->evtMgr->work) return ERR_NOSUPPORT;
+    //Already scanning, so the edge will be seen
+    if (ctx->running) return ERR_SUCCESS;
+    return Work_post(ctx->evtMgr->work, &_InputScan_wakeWork, ctx, 0);
+}
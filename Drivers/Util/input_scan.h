@@ -0,0 +1,150 @@
+/*
+ * Aggregated Input Scanner
+ * ------------------------
+ *
+ * Debounces a set of board inputs (e.g. KEYs and slide switches
+ * on FPGA_PIO, or HPS GPIO keys) together from a single event,
+ * and reports changes to a callback, rather than each input
+ * being polled separately.
+ *
+ *    InputScan_initialise(evtMgr, 4, 0, &inputs);
+ *    InputScan_setCallback(inputs, &onInput, NULL);
+ *    InputScan_addSource(inputs, &keys->gpio, 0xF, 0xF, true, &keySrc);
+ *    InputScan_addSource(inputs, &switches->gpio, 0x3FF, 0, false, &swSrc);
+ *
+ * Each source is any generic GPIO (Util/driver_gpio.h) with a mask
+ * of the pins to watch. Pins given as active low are inverted, so
+ * that a 1 always means pressed or on.
+ *
+ * Debouncing
+ * ----------
+ *
+ * All sources are sampled on each scan tick (INPUT_SCAN_PERIOD_US
+ * by default), and a pin only changes state once it has read the
+ * new value for INPUT_SCAN_SAMPLES (4) ticks in a row. The count
+ * is kept as a two bit vertical counter per pin, so all 32 pins of
+ * a source are debounced with a handful of logic operations.
+ *
+ * Edge Interrupts
+ * ---------------
+ *
+ * Sources marked as having an interrupt stop being scanned once
+ * all of their pins are stable. Their edge capture interrupt should
+ * then clear its flags and call InputScan_wake(), which restarts the
+ * scan from the main loop via the event manager's work queue (see
+ * EventMgr_setWorkQueue()). For example, with FPGA_PIO keys:
+ *
+ *    void keyIsr(HPSIRQSource id, void* param, bool* handled) {
+ *        FPGA_PIO_clearInterruptFlags(keys, 0xF);
+ *        InputScan_wake(inputs);
+ *        *handled = true;
+ *    }
+ *    FPGA_PIO_setInterruptEnable(keys, 0xF, 0xF);
+ *
+ * If every source has an interrupt, no scanning is done at all
+ * while the inputs are idle. Otherwise, or if the event manager
+ * has no work queue, the scan runs continuously.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef INPUT_SCAN_H_
+#define INPUT_SCAN_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_gpio.h"
+#include "Util/event.h"
+
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Default scan period in microseconds
+#ifndef INPUT_SCAN_PERIOD_US
+#define INPUT_SCAN_PERIOD_US 5000
+#endif
+
+// Number of matching samples before a pin changes state
+#define INPUT_SCAN_SAMPLES 4
+
+// Input change callback
+//  - Called from the scan event when any pin of a source changes state.
+//  - source is the index returned by InputScan_addSource().
+//  - pressed and released are the pins which have become 1 and 0.
+typedef void (*InputScanFunc_t)(unsigned int source, unsigned int pressed, unsigned int released, void* param);
+
+// Input source
+typedef struct {
+    GpioCtx_t*   gpio;
+    unsigned int mask;       // Pins being watched
+    unsigned int activeLow;  // Pins which are inverted
+    bool         hasIrq;     // Whether an edge interrupt wakes the scanner
+    unsigned int state;      // Debounced state
+    unsigned int cnt0;       // Vertical counter bit 0
+    unsigned int cnt1;       // Vertical counter bit 1
+} InputSource_t;
+
+// Input Scanner Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    EventMgrCtx_t*  evtMgr;
+    Event_t*        event;      // Repeating scan event
+    InputSource_t*  sources;
+    unsigned int    size;       // Maximum number of sources
+    unsigned int    count;      // Number of sources added
+    bool            canIdle;    // All sources have an interrupt
+    bool            running;    // Scan event is enabled
+    InputScanFunc_t callback;
+    void*           param;
+} InputScanCtx_t;
+
+// Initialise Input Scanner
+//  - evtMgr is the event manager used to run the scan.
+//  - maxSources is the maximum number of GPIO sources.
+//  - periodUs is the scan period in microseconds, or 0 for INPUT_SCAN_PERIOD_US.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t InputScan_initialise(EventMgrCtx_t* evtMgr, unsigned int maxSources, unsigned int periodUs, InputScanCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool InputScan_isInitialised(InputScanCtx_t* ctx);
+
+// Set the input change callback
+//  - callback is called with param whenever a source changes. NULL to disable.
+HpsErr_t InputScan_setCallback(InputScanCtx_t* ctx, InputScanFunc_t callback, void* param);
+
+// Add an input source
+//  - gpio is the GPIO to read, and mask the pins to watch.
+//  - activeLow are the pins which read 0 when pressed or on.
+//  - hasIrq is true if an edge interrupt will call InputScan_wake() for
+//    changes on these pins. See notes at top of file.
+//  - The current state of the pins is taken as the initial debounced state.
+//  - Returns the source index to *pSource, if not NULL.
+//  - Returns ERR_NOSPACE if maxSources have already been added.
+HpsErr_t InputScan_addSource(InputScanCtx_t* ctx, GpioCtx_t* gpio, unsigned int mask, unsigned int activeLow, bool hasIrq, unsigned int* pSource);
+
+// Get the debounced state of a source
+//  - Returns state of the watched pins to *state, with 1 meaning pressed or on.
+//  - Returns ERR_BADID if source does not exist.
+HpsErr_t InputScan_getState(InputScanCtx_t* ctx, unsigned int source, unsigned int* state);
+
+// Wake the scanner after an input edge
+//  - May be called from an interrupt handler.
+//  - Returns ERR_NOSUPPORT if the event manager has no work queue, in which
+//    case the scan is running anyway.
+//  - Returns ERR_NOSPACE if the work queue is full.
+HpsErr_t InputScan_wake(InputScanCtx_t* ctx);
+
+#endif /* INPUT_SCAN_H_ */
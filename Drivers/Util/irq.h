@@ -12,6 +12,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add IRQ-safe spinlocks
  * 12/10/2024 | Add support for Nios2
  * 09/04/2024 | Creation of header
  * 
@@ -28,6 +29,7 @@
 #if defined(__arm__)
 // ARM uses HPS IRQ Header
 #include "HPS_IRQ/HPS_IRQ.h"
+#include "Util/lowlevel_arm.h"
 #elif defined(__NIOS2__)
 // Nios IRQ Header
 #include "NIOS_IRQ/NIOS_IRQ.h"
@@ -52,4 +54,38 @@ static inline HpsErr_t IRQ_globalEnable(bool enable) {
 #endif
 }
 
+//IRQ-safe spinlock
+// - Protects data shared between thread context, ISRs and (on ARM) the other core.
+// - Must be initialised to IRQ_SPINLOCK_INIT.
+typedef volatile unsigned int IrqSpinlock_t;
+
+#define IRQ_SPINLOCK_INIT 0
+
+//Acquire a spinlock with interrupts masked
+// - Masks interrupts on this core, then waits for the lock.
+// - Returns the previous interrupt state, which must be passed to
+//   IRQ_spinUnlock() to restore it.
+// - Interrupts are only masked while the lock is held, so this keeps
+//   the latency impact to the length of the critical section.
+static inline HpsErr_t IRQ_spinLock(IrqSpinlock_t* lock) {
+    HpsErr_t irqState = IRQ_globalEnable(false);
+#if defined(__arm__)
+    __SPIN_LOCK(lock);
+#else
+    *lock = 1;
+#endif
+    return irqState;
+}
+
+//Release a spinlock and restore interrupts
+// - irqState is the value returned by IRQ_spinLock().
+static inline void IRQ_spinUnlock(IrqSpinlock_t* lock, HpsErr_t irqState) {
+#if defined(__arm__)
+    __SPIN_UNLOCK(lock);
+#else
+    *lock = 0;
+#endif
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqState));
+}
+
 #endif /* UTIL_IRQ_H */
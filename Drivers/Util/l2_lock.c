@@ -0,0 +1,258 @@
+/*
+ * L2 Cache Way Lockdown
+ * ---------------------
+ *
+ * Preloads address ranges into the PL310 L2 cache and locks
+ * them there, so that latency critical data and code such as
+ * audio ring buffers, DSP coefficient tables and IRQ handlers
+ * always hit in L2, regardless of what else (e.g. display code)
+ * is evicting lines at the time.
+ *
+ * The L2 is 8-way set associative (64kB per way on Cyclone V).
+ * Locking works on whole ways: the ranges are loaded into a set
+ * of reserved ways, which are then excluded from allocation for
+ * all masters. Other data can then only use the remaining ways.
+ * Each way can hold one line for every set, so several small
+ * ranges share a way as long as they don't fall in the same sets,
+ * and the number of ways used by a lock is the largest number of
+ * lines any one set needs.
+ *
+ *    L2LockRange_t hot[] = {
+ *        {audioRing, sizeof(audioRing)},
+ *        {firCoeffs, sizeof(firCoeffs)},
+ *        {(const void*)&audioIsr, 512}
+ *    };
+ *    L2Lock_lockRanges(hot, ARRAYSIZE(hot), &ways);
+ *    ...
+ *    L2Lock_unlock(ways);
+ *
+ * At most L2_LOCK_MAX_WAYS ways (default 4) can be locked at once,
+ * which can be changed by globally defining it. Each lock takes
+ * at least one way, so combine ranges into a single call where
+ * possible.
+ *
+ * Requirements
+ * ------------
+ *
+ * The caches must be enabled (STARTUP_ENABLE_CACHES in
+ * Util/startup_arm.c) and the ranges must be in cacheable memory
+ * (HPS SDRAM). Addresses are taken as physical, as the startup
+ * translation table is flat.
+ *
+ * The preload runs with interrupts masked, and the L1 and L2
+ * prefetchers paused, so that nothing else is allocated into the
+ * reserved ways. The other core should not be running, or be idle
+ * (e.g. in SMP_wait()), while locking, otherwise its allocations
+ * may take some of the reserved lines.
+ *
+ * Locked lines still take part in coherency, so writes to them
+ * are fine, and DMA cache maintenance on them (Util/dma_buffer)
+ * will evict them. Lock again after such maintenance.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Fix Arria 10 controller address selection
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "l2_lock.h"
+
+#include "Util/irq.h"
+#include "Util/macros.h"
+#include "Util/lowlevel_arm.h"
+#include "Util/bit_helpers.h"
+#include "Util/hwlib/alt_cache.h"
+
+// PL310 L2 cache controller
+#if defined(__ARRIA10__)
+#define L2_LOCK_BASE          0xFFFFF000
+#else
+#define L2_LOCK_BASE          0xFFFEF000
+#endif
+
+// Register word offsets
+#define L2_AUX_CONTROL        (0x104/sizeof(uint32_t))
+#define L2_D_LOCKDOWN(master) ((0x900/sizeof(uint32_t)) + (2 * (master)))
+#define L2_I_LOCKDOWN(master) ((0x904/sizeof(uint32_t)) + (2 * (master)))
+
+// Lockdown register pairs, one per master
+#define L2_LOCK_MASTERS       8
+
+// Auxiliary control geometry fields
+#define L2_AUX_ASSOC_16WAY    (1 << 16)
+#define L2_AUX_WAYSIZE_OFFS   17
+#define L2_AUX_WAYSIZE_MASK   0x7
+
+#define L2_LINE_SIZE          32
+
+static volatile uint32_t* _L2Lock_regs = (uint32_t*)L2_LOCK_BASE;
+static unsigned int _L2Lock_locked = 0;
+static IrqSpinlock_t _L2Lock_lock = IRQ_SPINLOCK_INIT;
+
+/*
+ * Internal Functions
+ */
+
+// Read the number of ways and sets from the controller
+static void _L2Lock_geometry(unsigned int* numWays, unsigned int* numSets) {
+    uint32_t aux = _L2Lock_regs[L2_AUX_CONTROL];
+    *numWays = (aux & L2_AUX_ASSOC_16WAY) ? 16 : 8;
+    // Way size is 8kB << field, e.g. 3 for 64kB
+    unsigned int waySize = 0x2000U << ((aux >> L2_AUX_WAYSIZE_OFFS) & L2_AUX_WAYSIZE_MASK);
+    *numSets = waySize / L2_LINE_SIZE;
+}
+
+// Largest number of lines needed in any set to hold all the ranges
+//  - Each range fills every set (size / way size) times, plus once more
+//    for a window of sets starting at its first line. The sum is largest
+//    at the start of one of these windows.
+static unsigned int _L2Lock_waysNeeded(const L2LockRange_t* ranges, unsigned int count, unsigned int numSets) {
+    unsigned int needed = 0;
+    for (unsigned int candidate = 0; candidate <= count; candidate++) {
+        unsigned int set = 0;
+        if (candidate < count) {
+            if (!ranges[candidate].size) continue;
+            set = ((uintptr_t)ranges[candidate].addr / L2_LINE_SIZE) % numSets;
+        }
+        unsigned int occupancy = 0;
+        for (unsigned int idx = 0; idx < count; idx++) {
+            if (!ranges[idx].size) continue;
+            uintptr_t first = (uintptr_t)ranges[idx].addr / L2_LINE_SIZE;
+            uintptr_t last  = ((uintptr_t)ranges[idx].addr + ranges[idx].size - 1) / L2_LINE_SIZE;
+            size_t lines = (last - first) + 1;
+            unsigned int start = first % numSets;
+            occupancy += lines / numSets;
+            if (((set + numSets - start) % numSets) < (lines % numSets)) occupancy++;
+        }
+        if (occupancy > needed) needed = occupancy;
+    }
+    return needed;
+}
+
+// Set the ways which no master may allocate into
+static void _L2Lock_setLockdown(uint32_t mask) {
+    for (unsigned int master = 0; master < L2_LOCK_MASTERS; master++) {
+        _L2Lock_regs[L2_D_LOCKDOWN(master)] = mask;
+        _L2Lock_regs[L2_I_LOCKDOWN(master)] = mask;
+    }
+    __DSB();
+}
+
+// Read every line of a range so that it is allocated into the cache
+//  - Kept out of line and small so that once run it stays in the L1
+//    instruction cache, and fetching it doesn't allocate into L2.
+static void __attribute__((noinline)) _L2Lock_touch(const void* addr, size_t size) {
+    uintptr_t line = (uintptr_t)addr & ~(uintptr_t)(L2_LINE_SIZE - 1);
+    uintptr_t end = (uintptr_t)addr + size;
+    for (; line < end; line += L2_LINE_SIZE) {
+        (void)*(volatile uint32_t*)line;
+    }
+    __DSB();
+}
+
+// Check the caches are on
+static bool _L2Lock_cachesEnabled(void) {
+    return alt_cache_l1_data_is_enabled() && alt_cache_l2_is_enabled();
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Preload and lock a set of address ranges into the L2 cache
+//  - Returns the locked ways as a bit mask to *ways, for use with L2Lock_unlock()
+//  - Returns ERR_NOSUPPORT if the caches are not enabled.
+//  - Returns ERR_NOSPACE if the ranges need more ways than are free.
+HpsErr_t L2Lock_lockRanges(const L2LockRange_t* ranges, unsigned int count, unsigned int* ways) {
+    if ((count && !ranges) || !ways) return ERR_NULLPTR;
+    if (!_L2Lock_cachesEnabled()) return ERR_NOSUPPORT;
+    unsigned int numWays, numSets;
+    _L2Lock_geometry(&numWays, &numSets);
+    unsigned int needed = _L2Lock_waysNeeded(ranges, count, numSets);
+    *ways = 0;
+    if (!needed) return ERR_SUCCESS;
+    HpsErr_t irqState = IRQ_spinLock(&_L2Lock_lock);
+    //Pick free ways from the top down
+    uint32_t allWays = (1U << numWays) - 1;
+    if ((needed + __popcount(_L2Lock_locked)) > min(L2_LOCK_MAX_WAYS, numWays - 1)) {
+        IRQ_spinUnlock(&_L2Lock_lock, irqState);
+        return ERR_NOSPACE;
+    }
+    uint32_t target = 0;
+    for (unsigned int way = numWays; needed && way--; ) {
+        if (!(_L2Lock_locked & (1U << way))) {
+            target |= (1U << way);
+            needed--;
+        }
+    }
+    //Pause the prefetchers so they don't allocate unrelated lines
+    bool l1Prefetch = alt_cache_l1_prefetch_is_enabled();
+    bool l2Prefetch = alt_cache_l2_prefetch_is_enabled();
+    if (l1Prefetch) alt_cache_l1_prefetch_disable();
+    if (l2Prefetch) alt_cache_l2_prefetch_disable();
+    //Bring the preload loop into the L1 instruction cache
+    _L2Lock_touch(ranges[0].addr, 0);
+    //Evict the ranges so they are reloaded into the target ways only
+    for (unsigned int idx = 0; idx < count; idx++) {
+        if (!ranges[idx].size) continue;
+        uintptr_t start = (uintptr_t)ranges[idx].addr & ~(uintptr_t)(L2_LINE_SIZE - 1);
+        uintptr_t end = ((uintptr_t)ranges[idx].addr + ranges[idx].size + L2_LINE_SIZE - 1) & ~(uintptr_t)(L2_LINE_SIZE - 1);
+        alt_cache_system_purge((void*)start, end - start);
+    }
+    _L2Lock_setLockdown(allWays & ~target);
+    for (unsigned int idx = 0; idx < count; idx++) {
+        if (ranges[idx].size) _L2Lock_touch(ranges[idx].addr, ranges[idx].size);
+    }
+    //Then lock the target ways, leaving the rest for normal use
+    _L2Lock_locked |= target;
+    _L2Lock_setLockdown(_L2Lock_locked);
+    if (l2Prefetch) alt_cache_l2_prefetch_enable();
+    if (l1Prefetch) alt_cache_l1_prefetch_enable();
+    IRQ_spinUnlock(&_L2Lock_lock, irqState);
+    *ways = target;
+    return ERR_SUCCESS;
+}
+
+// Preload and lock a single address range into the L2 cache
+//  - As L2Lock_lockRanges()
+HpsErr_t L2Lock_lockRange(const void* addr, size_t size, unsigned int* ways) {
+    L2LockRange_t range = {addr, size};
+    return L2Lock_lockRanges(&range, 1, ways);
+}
+
+// Unlock ways locked by L2Lock_lockRanges()
+//  - The lines stay in the cache, but may now be evicted.
+//  - Returns ERR_NOTFOUND if any of the ways are not locked.
+HpsErr_t L2Lock_unlock(unsigned int ways) {
+    HpsErr_t irqState = IRQ_spinLock(&_L2Lock_lock);
+    if (ways & ~_L2Lock_locked) {
+        IRQ_spinUnlock(&_L2Lock_lock, irqState);
+        return ERR_NOTFOUND;
+    }
+    _L2Lock_locked &= ~ways;
+    _L2Lock_setLockdown(_L2Lock_locked);
+    IRQ_spinUnlock(&_L2Lock_lock, irqState);
+    return ERR_SUCCESS;
+}
+
+// Get the mask of ways currently locked
+unsigned int L2Lock_lockedWays(void) {
+    return _L2Lock_locked;
+}
+
+// Get the number of ways which would be needed to lock a set of ranges
+//  - Returns ERR_NOSUPPORT if the caches are not enabled.
+HpsErr_t L2Lock_waysNeeded(const L2LockRange_t* ranges, unsigned int count) {
+    if (count && !ranges) return ERR_NULLPTR;
+    if (!_L2Lock_cachesEnabled()) return ERR_NOSUPPORT;
+    unsigned int numWays, numSets;
+    _L2Lock_geometry(&numWays, &numSets);
+    return (HpsErr_t)_L2Lock_waysNeeded(ranges, count, numSets);
+}
@@ -0,0 +1,107 @@
+/*
+ * L2 Cache Way Lockdown
+ * ---------------------
+ *
+ * Preloads address ranges into the PL310 L2 cache and locks
+ * them there, so that latency critical data and code such as
+ * audio ring buffers, DSP coefficient tables and IRQ handlers
+ * always hit in L2, regardless of what else (e.g. display code)
+ * is evicting lines at the time.
+ *
+ * The L2 is 8-way set associative (64kB per way on Cyclone V).
+ * Locking works on whole ways: the ranges are loaded into a set
+ * of reserved ways, which are then excluded from allocation for
+ * all masters. Other data can then only use the remaining ways.
+ * Each way can hold one line for every set, so several small
+ * ranges share a way as long as they don't fall in the same sets,
+ * and the number of ways used by a lock is the largest number of
+ * lines any one set needs.
+ *
+ *    L2LockRange_t hot[] = {
+ *        {audioRing, sizeof(audioRing)},
+ *        {firCoeffs, sizeof(firCoeffs)},
+ *        {(const void*)&audioIsr, 512}
+ *    };
+ *    L2Lock_lockRanges(hot, ARRAYSIZE(hot), &ways);
+ *    ...
+ *    L2Lock_unlock(ways);
+ *
+ * At most L2_LOCK_MAX_WAYS ways (default 4) can be locked at once,
+ * which can be changed by globally defining it. Each lock takes
+ * at least one way, so combine ranges into a single call where
+ * possible.
+ *
+ * Requirements
+ * ------------
+ *
+ * The caches must be enabled (STARTUP_ENABLE_CACHES in
+ * Util/startup_arm.c) and the ranges must be in cacheable memory
+ * (HPS SDRAM). Addresses are taken as physical, as the startup
+ * translation table is flat.
+ *
+ * The preload runs with interrupts masked, and the L1 and L2
+ * prefetchers paused, so that nothing else is allocated into the
+ * reserved ways. The other core should not be running, or be idle
+ * (e.g. in SMP_wait()), while locking, otherwise its allocations
+ * may take some of the reserved lines.
+ *
+ * Locked lines still take part in coherency, so writes to them
+ * are fine, and DMA cache maintenance on them (Util/dma_buffer)
+ * will evict them. Lock again after such maintenance.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Fix Arria 10 controller address selection
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef L2_LOCK_H_
+#define L2_LOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "Util/error.h"
+
+// Maximum number of ways which may be locked
+#ifndef L2_LOCK_MAX_WAYS
+#define L2_LOCK_MAX_WAYS 4
+#endif
+
+// Address range to lock
+typedef struct {
+    const void* addr;
+    size_t      size;
+} L2LockRange_t;
+
+// Preload and lock a set of address ranges into the L2 cache
+//  - Returns the locked ways as a bit mask to *ways, for use with L2Lock_unlock()
+//  - Returns ERR_NOSUPPORT if the caches are not enabled.
+//  - Returns ERR_NOSPACE if the ranges need more ways than are free.
+HpsErr_t L2Lock_lockRanges(const L2LockRange_t* ranges, unsigned int count, unsigned int* ways);
+
+// Preload and lock a single address range into the L2 cache
+//  - As L2Lock_lockRanges()
+HpsErr_t L2Lock_lockRange(const void* addr, size_t size, unsigned int* ways);
+
+// Unlock ways locked by L2Lock_lockRanges()
+//  - The lines stay in the cache, but may now be evicted.
+//  - Returns ERR_NOTFOUND if any of the ways are not locked.
+HpsErr_t L2Lock_unlock(unsigned int ways);
+
+// Get the mask of ways currently locked
+unsigned int L2Lock_lockedWays(void);
+
+// Get the number of ways which would be needed to lock a set of ranges
+//  - Returns ERR_NOSUPPORT if the caches are not enabled.
+HpsErr_t L2Lock_waysNeeded(const L2LockRange_t* ranges, unsigned int count);
+
+#endif /* L2_LOCK_H_ */
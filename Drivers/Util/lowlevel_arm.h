@@ -13,6 +13,13 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add TLB lockdown and invalidate by MVA registers
+ * 14/10/2026 | Add performance monitor (PMU) registers
+ * 14/10/2026 | Add exclusive access atomics and spinlocks
+ * 14/10/2026 | Add wait for event, send event and MPIDR register
+ * 14/10/2026 | Add wait for interrupt
+ * 14/10/2026 | Add data memory barrier
+ * 14/10/2026 | Add MMU translation table and TLB registers
  * 31/01/2024 | Include ISR attributes header
  * 14/01/2024 | Creation of header
  *
@@ -29,6 +36,7 @@
  * Provides low level macros such as __disable_irq()
  */
 #include <arm_compat.h>
+#include <stdbool.h>
 
 #define __disable_bothirqs() __asm( "CPSID if")
 
@@ -174,6 +182,128 @@ __MOV_REG_GEN(pc)
 // Data barrier
 
 #define __DSB()       __dsb(15)
+// Memory barrier
+#define __DMB()       __dmb(15)
+
+// Wait for interrupt (wakes on pending IRQ even if masked)
+#define __WFI()       __asm__ __volatile__ ("WFI" ::: "memory")
+
+// Wait for event (wakes on SEV from another core, or pending IRQ)
+#define __WFE()       __asm__ __volatile__ ("WFE" ::: "memory")
+// Send event to all cores
+#define __SEV()       __asm__ __volatile__ ("SEV" ::: "memory")
+// Clear exclusive monitor
+#define __CLREX()     __asm__ __volatile__ ("CLREX" ::: "memory")
+
+/*
+ * Atomic Operations
+ *
+ * Built on LDREX/STREX so are safe against both interrupts and
+ * the other core, without masking interrupts. Between cores,
+ * the MMU and caches must be enabled (STARTUP_ENABLE_CACHES) as
+ * the SDRAM does not support exclusive accesses to uncached
+ * memory.
+ */
+
+//Helper APIs
+static __inline__ unsigned int __attribute__((__always_inline__, __nodebug__))
+__atomic_add32(volatile unsigned int* ptr, unsigned int val) {
+    unsigned int result, failed;
+    do {
+        __asm__ __volatile__(
+            "LDREX   %[res], [%[ptr]]         \n"
+            "ADD     %[res], %[res], %[val]   \n"
+            "STREX   %[fail], %[res], [%[ptr]]\n"
+            : [res] "=&r" (result), [fail] "=&r" (failed)
+            : [ptr] "r" (ptr), [val] "r" (val)
+            : "memory"
+        );
+    } while (failed);
+    return result;
+}
+
+static __inline__ bool __attribute__((__always_inline__, __nodebug__))
+__atomic_cas32(volatile unsigned int* ptr, unsigned int expected, unsigned int desired) {
+    unsigned int current, failed;
+    do {
+        __asm__ __volatile__(
+            "LDREX   %[cur], [%[ptr]]           \n"
+            "MOV     %[fail], #0                \n"
+            "TEQ     %[cur], %[exp]             \n"
+            "STREXEQ %[fail], %[des], [%[ptr]]  \n"
+            : [cur] "=&r" (current), [fail] "=&r" (failed)
+            : [ptr] "r" (ptr), [exp] "r" (expected), [des] "r" (desired)
+            : "cc", "memory"
+        );
+    } while (failed);
+    if (current != expected) __CLREX();
+    return (current == expected);
+}
+
+static __inline__ unsigned int __attribute__((__always_inline__, __nodebug__))
+__atomic_swap32(volatile unsigned int* ptr, unsigned int val) {
+    unsigned int previous, failed;
+    do {
+        __asm__ __volatile__(
+            "LDREX   %[prev], [%[ptr]]        \n"
+            "STREX   %[fail], %[val], [%[ptr]]\n"
+            : [prev] "=&r" (previous), [fail] "=&r" (failed)
+            : [ptr] "r" (ptr), [val] "r" (val)
+            : "memory"
+        );
+    } while (failed);
+    return previous;
+}
+
+// Access macros
+//  - Barriers are included so these can be used to publish data.
+//  - __ATOMIC_ADD32 returns the new value, __ATOMIC_SWAP32 the previous value.
+//  - __ATOMIC_CAS32 returns true if *ptr was equal to exp and has been set to des.
+#define __ATOMIC_ADD32(ptr, val)       __extension__({ __DMB(); unsigned int __r = __atomic_add32((ptr), (val));        __DMB(); __r; })
+#define __ATOMIC_CAS32(ptr, exp, des)  __extension__({ __DMB(); bool         __r = __atomic_cas32((ptr), (exp), (des)); __DMB(); __r; })
+#define __ATOMIC_SWAP32(ptr, val)      __extension__({ __DMB(); unsigned int __r = __atomic_swap32((ptr), (val));       __DMB(); __r; })
+
+/*
+ * Spinlocks
+ *
+ * A lock is an unsigned int which is 0 when free. Waiting cores
+ * sleep with WFE and are woken by the SEV on unlock. These do not
+ * mask interrupts, so a lock taken in an ISR must not be held by
+ * code which that ISR can interrupt. See IRQ_spinLock() in Util/irq.h
+ * for variants which also mask interrupts.
+ */
+
+#define __SPINLOCK_FREE   0
+#define __SPINLOCK_HELD   1
+
+//Helper APIs
+static __inline__ bool __attribute__((__always_inline__, __nodebug__))
+__spin_trylock(volatile unsigned int* lock) {
+    if (!__atomic_cas32(lock, __SPINLOCK_FREE, __SPINLOCK_HELD)) return false;
+    __DMB();
+    return true;
+}
+
+static __inline__ void __attribute__((__always_inline__, __nodebug__))
+__spin_lock(volatile unsigned int* lock) {
+    while (!__spin_trylock(lock)) {
+        // Sleep until the holder releases the lock
+        while (*lock != __SPINLOCK_FREE) __WFE();
+    }
+}
+
+static __inline__ void __attribute__((__always_inline__, __nodebug__))
+__spin_unlock(volatile unsigned int* lock) {
+    __DMB();
+    *lock = __SPINLOCK_FREE;
+    __DSB();
+    __SEV();
+}
+
+// Access macros
+#define __SPIN_TRYLOCK(lock)   __spin_trylock(lock)
+#define __SPIN_LOCK(lock)      __spin_lock(lock)
+#define __SPIN_UNLOCK(lock)    __spin_unlock(lock)
 
 // Stack Init Functions
 #define __INIT_SP_SYS(top) __asm__ __volatile__("MOV SP, %[sp]\n" ::[sp] "r" (top):)
@@ -231,6 +361,14 @@ __MOV_REG_GEN(pc)
 #define SYSREG_ACTLR_BIT_L2PREFETCHEN       1
 #define SYSREG_ACTLR_BIT_FW                 0
 
+// MPIDR - Multiprocessor Affinity Register
+#define SYSREG_MPIDR_CP        0
+#define SYSREG_MPIDR_CP_OP     0
+#define SYSREG_MPIDR_CPA       0
+#define SYSREG_MPIDR_CPA_OP    5
+
+#define SYSREG_MPIDR_MASK_CPUID 0x3
+
 // VBAR - Vector Base Address Register
 #define SYSREG_VBAR_CP         12
 #define SYSREG_VBAR_CP_OP      0
@@ -261,6 +399,110 @@ __MOV_REG_GEN(pc)
 #define SYSREG_BPIALL_CPA_OP    6
 #define SYSREG_BPIALL_CLEAR     0
 
+// TTBR0 - Translation Table Base Register 0
+#define SYSREG_TTBR0_CP         2
+#define SYSREG_TTBR0_CP_OP      0
+#define SYSREG_TTBR0_CPA        0
+#define SYSREG_TTBR0_CPA_OP     0
+
+#define SYSREG_TTBR0_BIT_IRGN1  0
+#define SYSREG_TTBR0_BIT_S      1
+#define SYSREG_TTBR0_BIT_RGN    3
+#define SYSREG_TTBR0_MASK_RGN   0x3
+#define SYSREG_TTBR0_BIT_NOS    5
+#define SYSREG_TTBR0_BIT_IRGN0  6
+#define SYSREG_TTBR0_RGN_WBWA   0x1  // Outer Write-Back, Write-Allocate table walks
+
+// TTBCR - Translation Table Base Control Register
+#define SYSREG_TTBCR_CP         2
+#define SYSREG_TTBCR_CP_OP      0
+#define SYSREG_TTBCR_CPA        0
+#define SYSREG_TTBCR_CPA_OP     2
+#define SYSREG_TTBCR_TTBR0_ONLY 0    // N=0, always use TTBR0
+
+// DACR - Domain Access Control Register
+#define SYSREG_DACR_CP          3
+#define SYSREG_DACR_CP_OP       0
+#define SYSREG_DACR_CPA         0
+#define SYSREG_DACR_CPA_OP      0
+#define SYSREG_DACR_MASK_D      0x3
+#define SYSREG_DACR_BIT_D(x)    (2 * (x))
+
+// TLBIALL - Invalidate Entire Unified TLB
+#define SYSREG_TLBIALL_CP       8
+#define SYSREG_TLBIALL_CP_OP    0
+#define SYSREG_TLBIALL_CPA      7
+#define SYSREG_TLBIALL_CPA_OP   0
+#define SYSREG_TLBIALL_CLEAR    0
+
+// TLBIMVA - Invalidate Unified TLB Entry by MVA (and ASID)
+#define SYSREG_TLBIMVA_CP       8
+#define SYSREG_TLBIMVA_CP_OP    0
+#define SYSREG_TLBIMVA_CPA      7
+#define SYSREG_TLBIMVA_CPA_OP   1
+
+// TLBLR - TLB Lockdown Register (Cortex-A9)
+#define SYSREG_TLBLR_CP         10
+#define SYSREG_TLBLR_CP_OP      0
+#define SYSREG_TLBLR_CPA        0
+#define SYSREG_TLBLR_CPA_OP     0
+#define SYSREG_TLBLR_BIT_P      0    // Preserve: walks are placed in the victim entry and locked
+#define SYSREG_TLBLR_BIT_VICTIM 28   // Lockable entry to fill next
+#define SYSREG_TLBLR_MASK_VICTIM 0x7
+
+// PMCR - Performance Monitor Control Register
+#define SYSREG_PMCR_CP          9
+#define SYSREG_PMCR_CP_OP       0
+#define SYSREG_PMCR_CPA         12
+#define SYSREG_PMCR_CPA_OP      0
+
+#define SYSREG_PMCR_BIT_E       0    // Enable all counters
+#define SYSREG_PMCR_BIT_P       1    // Reset event counters
+#define SYSREG_PMCR_BIT_C       2    // Reset cycle counter
+#define SYSREG_PMCR_BIT_D       3    // Cycle counter counts every 64th cycle
+#define SYSREG_PMCR_BIT_N       11   // Number of event counters
+#define SYSREG_PMCR_MASK_N      0x1F
+
+// PMCNTENSET/PMCNTENCLR - Performance Monitor Count Enable Set/Clear Registers
+#define SYSREG_PMCNTENSET_CP     9
+#define SYSREG_PMCNTENSET_CP_OP  0
+#define SYSREG_PMCNTENSET_CPA    12
+#define SYSREG_PMCNTENSET_CPA_OP 1
+#define SYSREG_PMCNTENCLR_CP     9
+#define SYSREG_PMCNTENCLR_CP_OP  0
+#define SYSREG_PMCNTENCLR_CPA    12
+#define SYSREG_PMCNTENCLR_CPA_OP 2
+
+#define SYSREG_PMCNTEN_BIT_C     31   // Cycle counter. Event counters are bits 0 to N-1.
+
+// PMOVSR - Performance Monitor Overflow Flag Status Register
+#define SYSREG_PMOVSR_CP        9
+#define SYSREG_PMOVSR_CP_OP     0
+#define SYSREG_PMOVSR_CPA       12
+#define SYSREG_PMOVSR_CPA_OP    3
+
+// PMSELR - Performance Monitor Event Counter Selection Register
+#define SYSREG_PMSELR_CP        9
+#define SYSREG_PMSELR_CP_OP     0
+#define SYSREG_PMSELR_CPA       12
+#define SYSREG_PMSELR_CPA_OP    5
+
+// PMCCNTR - Performance Monitor Cycle Count Register
+#define SYSREG_PMCCNTR_CP       9
+#define SYSREG_PMCCNTR_CP_OP    0
+#define SYSREG_PMCCNTR_CPA      13
+#define SYSREG_PMCCNTR_CPA_OP   0
+
+// PMXEVTYPER/PMXEVCNTR - Event Type/Count of the counter selected by PMSELR
+#define SYSREG_PMXEVTYPER_CP     9
+#define SYSREG_PMXEVTYPER_CP_OP  0
+#define SYSREG_PMXEVTYPER_CPA    13
+#define SYSREG_PMXEVTYPER_CPA_OP 1
+#define SYSREG_PMXEVCNTR_CP      9
+#define SYSREG_PMXEVCNTR_CP_OP   0
+#define SYSREG_PMXEVCNTR_CPA     13
+#define SYSREG_PMXEVCNTR_CPA_OP  2
+
 // Access macros
 //   Converts to MCR/MRC instructions
 #define __SET_SYSREG(coProc, regName, val) __arm_mcr(coProc, SYSREG_##regName##_CP_OP, (val), SYSREG_##regName##_CP, SYSREG_##regName##_CPA, SYSREG_##regName##_CPA_OP)
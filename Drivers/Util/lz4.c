@@ -0,0 +1,225 @@
+/*
+ * LZ4 Decompression
+ * -----------------
+ *
+ * Provides decompression of LZ4 compressed data, either as raw
+ * blocks or in the LZ4 frame format.
+ *
+ * The fast copies are fixed size memcpy() calls, which the
+ * compiler turns into a pair of unaligned word loads and stores
+ * (or a NEON load/store) rather than a library call.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "lz4.h"
+
+#include <string.h>
+#include <stdbool.h>
+
+// Each match is at least this long
+#define LZ4_MIN_MATCH   4
+// Fast copies are done this many bytes at a time
+#define LZ4_COPY_SIZE   8
+
+// Frame descriptor flags
+#define LZ4_FLG_VERSION_MASK 0xC0
+#define LZ4_FLG_VERSION      0x40
+#define LZ4_FLG_BLOCK_CSUM   0x10
+#define LZ4_FLG_CONTENT_SIZE 0x08
+#define LZ4_FLG_CONTENT_CSUM 0x04
+#define LZ4_FLG_DICT_ID      0x01
+
+// Block size word
+#define LZ4_BLOCK_UNCOMPRESSED 0x80000000U
+
+/*
+ * Internal Functions
+ */
+
+// Copy a fixed size chunk
+static inline void _lz4_copy(uint8_t* dst, const uint8_t* src) {
+    memcpy(dst, src, LZ4_COPY_SIZE);
+}
+
+// Read a little endian word
+static inline uint32_t _lz4_read32(const uint8_t* src) {
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+// Read an extended length
+//  - Adds bytes to *len until one is not 255.
+//  - Returns false if the source ran out first.
+static inline bool _lz4_readLength(const uint8_t** pIp, const uint8_t* ipEnd, size_t* len) {
+    const uint8_t* ip = *pIp;
+    unsigned int byte;
+    do {
+        if (ip >= ipEnd) return false;
+        byte = *ip++;
+        *len += byte;
+    } while (byte == 255);
+    *pIp = ip;
+    return true;
+}
+
+// Decompress a block
+//  - Output starts at *pOp, and matches may refer back as far as opStart.
+//  - *pOp is advanced past the decompressed data.
+static HpsErr_t _lz4_block(const uint8_t* ip, const uint8_t* ipEnd, uint8_t** pOp, uint8_t* opStart, uint8_t* opEnd) {
+    uint8_t* op = *pOp;
+    while (ip < ipEnd) {
+        unsigned int token = *ip++;
+        //Literals
+        size_t len = token >> 4;
+        if ((len == 15) && !_lz4_readLength(&ip, ipEnd, &len)) return ERR_CORRUPT;
+        if ((size_t)(ipEnd - ip) < len) return ERR_CORRUPT;
+        if ((size_t)(opEnd - op) < len) return ERR_NOSPACE;
+        if (((size_t)(ipEnd - ip) >= (len + LZ4_COPY_SIZE)) && ((size_t)(opEnd - op) >= (len + LZ4_COPY_SIZE))) {
+            //Room to copy past the end
+            uint8_t* end = op + len;
+            const uint8_t* src = ip;
+            while (op < end) {
+                _lz4_copy(op, src);
+                op += LZ4_COPY_SIZE;
+                src += LZ4_COPY_SIZE;
+            }
+            op = end;
+        } else {
+            memcpy(op, ip, len);
+            op += len;
+        }
+        ip += len;
+        //Last sequence has no match
+        if (ip >= ipEnd) break;
+        if ((ipEnd - ip) < 2) return ERR_CORRUPT;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (!offset || (offset > (size_t)(op - opStart))) return ERR_CORRUPT;
+        len = token & 0xF;
+        if ((len == 15) && !_lz4_readLength(&ip, ipEnd, &len)) return ERR_CORRUPT;
+        len += LZ4_MIN_MATCH;
+        if ((size_t)(opEnd - op) < len) return ERR_NOSPACE;
+        const uint8_t* match = op - offset;
+        if (offset < LZ4_COPY_SIZE) {
+            //Short overlapping match repeats the last offset bytes. Copy whole repeats
+            //byte by byte until they are far enough back to copy in chunks.
+            size_t step = offset * ((LZ4_COPY_SIZE + offset - 1) / offset);
+            size_t count = (len < step) ? len : step;
+            len -= count;
+            while (count--) *op++ = *match++;
+            match = op - step;
+        }
+        if ((size_t)(opEnd - op) >= (len + LZ4_COPY_SIZE)) {
+            //Room to copy past the end
+            uint8_t* end = op + len;
+            while (op < end) {
+                _lz4_copy(op, match);
+                op += LZ4_COPY_SIZE;
+                match += LZ4_COPY_SIZE;
+            }
+            op = end;
+        } else {
+            while (len--) *op++ = *match++;
+        }
+    }
+    *pOp = op;
+    return ERR_SUCCESS;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Decompress an LZ4 block
+//  - Decompresses srcLen bytes from src to dst, which has space for dstSize bytes.
+//  - Returns the decompressed length.
+//  - Returns ERR_CORRUPT if the data is invalid, or ERR_NOSPACE if it
+//    doesn't fit in dst.
+HpsErr_t lz4_decompressBlock(const void* src, size_t srcLen, void* dst, size_t dstSize) {
+    if (!src || !dst) return ERR_NULLPTR;
+    if (dstSize > INT32_MAX) dstSize = INT32_MAX;
+    const uint8_t* ip = (const uint8_t*)src;
+    uint8_t* op = (uint8_t*)dst;
+    HpsErr_t status = _lz4_block(ip, ip + srcLen, &op, (uint8_t*)dst, (uint8_t*)dst + dstSize);
+    if (ERR_IS_ERROR(status)) return status;
+    return (HpsErr_t)(op - (uint8_t*)dst);
+}
+
+// Decompress LZ4 frames
+//  - Decompresses all of the frames in srcLen bytes from src to dst, which has
+//    space for dstSize bytes. Skippable frames are ignored.
+//  - Returns the decompressed length.
+//  - Returns ERR_CORRUPT if the data is invalid, or ERR_NOSPACE if it
+//    doesn't fit in dst.
+//  - Returns ERR_NOSUPPORT if a frame needs a preset dictionary.
+HpsErr_t lz4_decompressFrame(const void* src, size_t srcLen, void* dst, size_t dstSize) {
+    if (!src || !dst) return ERR_NULLPTR;
+    if (dstSize > INT32_MAX) dstSize = INT32_MAX;
+    const uint8_t* ip = (const uint8_t*)src;
+    const uint8_t* ipEnd = ip + srcLen;
+    uint8_t* op = (uint8_t*)dst;
+    uint8_t* opEnd = op + dstSize;
+    if (srcLen < 4) return ERR_CORRUPT;
+    while ((ipEnd - ip) >= 4) {
+        uint32_t magic = _lz4_read32(ip);
+        ip += 4;
+        if ((magic & LZ4_SKIPPABLE_MAGIC_MASK) == LZ4_SKIPPABLE_MAGIC) {
+            //Skip user data
+            if ((ipEnd - ip) < 4) return ERR_CORRUPT;
+            uint32_t size = _lz4_read32(ip);
+            ip += 4;
+            if ((size_t)(ipEnd - ip) < size) return ERR_CORRUPT;
+            ip += size;
+            continue;
+        }
+        if (magic != LZ4_FRAME_MAGIC) return ERR_CORRUPT;
+        //Frame descriptor. The header checksum is not checked.
+        if ((ipEnd - ip) < 3) return ERR_CORRUPT;
+        unsigned int flags = ip[0];
+        if ((flags & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION) return ERR_CORRUPT;
+        if (flags & LZ4_FLG_DICT_ID) return ERR_NOSUPPORT;
+        size_t descLen = 3 + ((flags & LZ4_FLG_CONTENT_SIZE) ? 8 : 0);
+        if ((size_t)(ipEnd - ip) < descLen) return ERR_CORRUPT;
+        ip += descLen;
+        //Blocks
+        while (true) {
+            if ((ipEnd - ip) < 4) return ERR_CORRUPT;
+            uint32_t size = _lz4_read32(ip);
+            ip += 4;
+            if (!size) break;
+            bool raw = size & LZ4_BLOCK_UNCOMPRESSED;
+            size &= ~LZ4_BLOCK_UNCOMPRESSED;
+            if ((size_t)(ipEnd - ip) < size) return ERR_CORRUPT;
+            if (raw) {
+                if ((size_t)(opEnd - op) < size) return ERR_NOSPACE;
+                memcpy(op, ip, size);
+                op += size;
+            } else {
+                //Decompress straight after the previous block, so linked blocks work too
+                HpsErr_t status = _lz4_block(ip, ip + size, &op, (uint8_t*)dst, opEnd);
+                if (ERR_IS_ERROR(status)) return status;
+            }
+            ip += size;
+            if (flags & LZ4_FLG_BLOCK_CSUM) {
+                if ((ipEnd - ip) < 4) return ERR_CORRUPT;
+                ip += 4;
+            }
+        }
+        if (flags & LZ4_FLG_CONTENT_CSUM) {
+            if ((ipEnd - ip) < 4) return ERR_CORRUPT;
+            ip += 4;
+        }
+    }
+    //Anything left over is too short to be a frame
+    if (ip != ipEnd) return ERR_CORRUPT;
+    return (HpsErr_t)(op - (uint8_t*)dst);
+}
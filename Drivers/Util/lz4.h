@@ -0,0 +1,66 @@
+/*
+ * LZ4 Decompression
+ * -----------------
+ *
+ * Provides decompression of LZ4 compressed data, either as raw
+ * blocks or in the LZ4 frame format produced by the lz4 tool
+ * (and so by "mkimage -C lz4").
+ *
+ *    HpsErr_t len = lz4_decompressFrame(src, srcLen, dst, dstSize);
+ *    if (ERR_IS_ERROR(len)) ...
+ *
+ * Decompression is straight to the destination, so linked blocks
+ * need no separate dictionary: matches simply refer back to the
+ * data already written. Literals and matches are copied eight
+ * bytes at a time wherever there is room to do so, with a byte
+ * by byte copy only near the ends of the buffers and for short
+ * overlapping matches.
+ *
+ * Every length and offset is checked against the buffers, so
+ * corrupt data can't cause reads or writes outside of them. The
+ * optional xxHash32 block and content checksums in frames are
+ * skipped rather than checked, so if integrity matters check the
+ * compressed data first (e.g. the U-Boot image data CRC).
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef LZ4_H_
+#define LZ4_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Util/error.h"
+
+// LZ4 frame magic numbers
+#define LZ4_FRAME_MAGIC          0x184D2204U
+#define LZ4_SKIPPABLE_MAGIC      0x184D2A50U
+#define LZ4_SKIPPABLE_MAGIC_MASK 0xFFFFFFF0U
+
+// Decompress an LZ4 block
+//  - Decompresses srcLen bytes from src to dst, which has space for dstSize bytes.
+//  - Returns the decompressed length.
+//  - Returns ERR_CORRUPT if the data is invalid, or ERR_NOSPACE if it
+//    doesn't fit in dst.
+HpsErr_t lz4_decompressBlock(const void* src, size_t srcLen, void* dst, size_t dstSize);
+
+// Decompress LZ4 frames
+//  - Decompresses all of the frames in srcLen bytes from src to dst, which has
+//    space for dstSize bytes. Skippable frames are ignored.
+//  - Returns the decompressed length.
+//  - Returns ERR_CORRUPT if the data is invalid, or ERR_NOSPACE if it
+//    doesn't fit in dst.
+//  - Returns ERR_NOSUPPORT if a frame needs a preset dictionary.
+HpsErr_t lz4_decompressFrame(const void* src, size_t srcLen, void* dst, size_t dstSize);
+
+#endif /* LZ4_H_ */
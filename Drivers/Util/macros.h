@@ -11,6 +11,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add HOT_CODE/HOT_DATA on-chip RAM placement
  * 28/12/2023 | Creation of header
  *
  */
@@ -63,6 +64,20 @@
 #define SCATTER_REGION_LENGTH(region, type) _SCATTER_REGION_HELPER(region, type, Length)
 #define SCATTER_REGION_LIMIT(region, type)  _SCATTER_REGION_HELPER(region, type, Limit)
 
+//Hot code and data placement
+// - Places the function or variable in a named section which the scatter file can
+//   put in the on-chip RAM (see HOT_OCRAM in ScatterFiles/DDRRam.scat), where it is
+//   copied at startup. Use for ISRs, DSP kernels and audio buffers on latency
+//   critical paths. Scatter files without such a region place these sections with
+//   the rest of the code/data, so the attributes are always safe to use.
+// - HOT_CODE for functions, HOT_RODATA for constant tables, HOT_DATA for initialised
+//   variables, and HOT_BSS for zero initialised variables (e.g. sample buffers) which
+//   then take no space in the image.
+#define HOT_CODE   __attribute__ ((section(".hot_code")))
+#define HOT_RODATA __attribute__ ((section(".hot_rodata")))
+#define HOT_DATA   __attribute__ ((section(".hot_data")))
+#define HOT_BSS    __attribute__ ((section(".bss.hot")))
+
 //Size of fixed array
 #define ARRAYSIZE(arr) (sizeof((arr))/sizeof(*(arr)))
 #define ARRAYWITHSIZE(arr) arr, ARRAYSIZE(arr)
@@ -0,0 +1,193 @@
+/*
+ * Static Memory Pool
+ * ------------------
+ *
+ * Allocation routines used by the drivers for their contexts
+ * and buffers. By default these are the C library heap, but
+ * for real-time builds a static pool can be used instead by
+ * globally defining its size in bytes:
+ *
+ *     -D MEM_POOL_SIZE=65536
+ *
+ * The pool is split into power of two size classes, from 16
+ * bytes up. Each allocation is rounded up to the next class
+ * (including an 8 byte header), and freed blocks are kept on
+ * a free list for their class to be reused by the next
+ * allocation of that class. Blocks are never split or merged,
+ * so allocating and freeing take a bounded time and the pool
+ * cannot fragment, at the cost of up to half of each block.
+ *
+ * New blocks are carved from the end of the used part of the
+ * pool. If the pool is exhausted, a free block of a larger
+ * class is used instead, otherwise NULL is returned.
+ *
+ * Allocations are 8 byte aligned. The routines are safe to
+ * call with interrupts enabled and from both cores.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "mem_pool.h"
+
+#ifdef MEM_POOL_SIZE
+
+#include <string.h>
+
+#include "Util/irq.h"
+#include "Util/bit_helpers.h"
+
+// Smallest block is 2^4 = 16 bytes, including the header
+#define MEM_POOL_MIN_CLASS 4
+#define MEM_POOL_CLASSES   (32 - MEM_POOL_MIN_CLASS)
+
+// Marks an allocated block, to catch bad or double frees
+#define MEM_POOL_MAGIC     0x4D504F4C
+#define MEM_POOL_FREED     0x46524545
+
+// Block header, 8 bytes to keep allocations aligned
+//  - While free, the first word after the header links to the next
+//    free block of the same class.
+typedef struct {
+    uint32_t sizeClass;
+    uint32_t magic;
+} MemPoolBlock_t;
+
+#define _MemPool_next(block) (*(MemPoolBlock_t**)((block) + 1))
+
+static uint64_t _MemPool_pool[(MEM_POOL_SIZE + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+static size_t _MemPool_used = 0;
+static MemPoolBlock_t* _MemPool_free[MEM_POOL_CLASSES];
+static IrqSpinlock_t _MemPool_lock = IRQ_SPINLOCK_INIT;
+
+// Size class of a block holding size bytes
+//  - Returns MEM_POOL_CLASSES if too big
+static unsigned int _MemPool_class(size_t size) {
+    if (size > (0x80000000U - sizeof(MemPoolBlock_t))) return MEM_POOL_CLASSES;
+    size += sizeof(MemPoolBlock_t);
+    unsigned int log2 = 32 - __clz((uint32_t)(size - 1));
+    if (log2 < MEM_POOL_MIN_CLASS) log2 = MEM_POOL_MIN_CLASS;
+    return log2 - MEM_POOL_MIN_CLASS;
+}
+
+// Bytes available to the caller in a block of a class
+static inline size_t _MemPool_capacity(unsigned int sizeClass) {
+    return ((size_t)1 << (sizeClass + MEM_POOL_MIN_CLASS)) - sizeof(MemPoolBlock_t);
+}
+
+// Allocate a block of a class
+//  - Must be called with the lock held.
+static MemPoolBlock_t* _MemPool_take(unsigned int sizeClass) {
+    MemPoolBlock_t* block = _MemPool_free[sizeClass];
+    if (block) {
+        _MemPool_free[sizeClass] = _MemPool_next(block);
+    } else {
+        //Carve a new block if there is space, otherwise use a larger free one
+        size_t blockSize = (size_t)1 << (sizeClass + MEM_POOL_MIN_CLASS);
+        if (blockSize <= (sizeof(_MemPool_pool) - _MemPool_used)) {
+            block = (MemPoolBlock_t*)((uint8_t*)_MemPool_pool + _MemPool_used);
+            _MemPool_used += blockSize;
+        } else {
+            for (unsigned int larger = sizeClass + 1; larger < MEM_POOL_CLASSES; larger++) {
+                block = _MemPool_free[larger];
+                if (block) {
+                    _MemPool_free[larger] = _MemPool_next(block);
+                    sizeClass = larger;
+                    break;
+                }
+            }
+            if (!block) return NULL;
+        }
+    }
+    block->sizeClass = sizeClass;
+    block->magic = MEM_POOL_MAGIC;
+    return block;
+}
+
+// Get the header of an allocation
+//  - Returns NULL if not allocated from the pool
+static MemPoolBlock_t* _MemPool_header(void* ptr) {
+    uintptr_t addr = (uintptr_t)ptr;
+    uintptr_t base = (uintptr_t)_MemPool_pool;
+    if (addr & (sizeof(MemPoolBlock_t) - 1)) return NULL;
+    if ((addr < (base + sizeof(MemPoolBlock_t))) || (addr >= (base + _MemPool_used))) return NULL;
+    MemPoolBlock_t* block = (MemPoolBlock_t*)ptr - 1;
+    if ((block->magic != MEM_POOL_MAGIC) || (block->sizeClass >= MEM_POOL_CLASSES)) return NULL;
+    return block;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Allocate size bytes
+//  - Returns NULL if there is no space.
+void* MemPool_malloc(size_t size) {
+    unsigned int sizeClass = _MemPool_class(size);
+    if (sizeClass >= MEM_POOL_CLASSES) return NULL;
+    HpsErr_t irqState = IRQ_spinLock(&_MemPool_lock);
+    MemPoolBlock_t* block = _MemPool_take(sizeClass);
+    IRQ_spinUnlock(&_MemPool_lock, irqState);
+    return block ? (void*)(block + 1) : NULL;
+}
+
+// Allocate count elements of size bytes, initialised to zero
+//  - Returns NULL if there is no space.
+void* MemPool_calloc(size_t count, size_t size) {
+    if (size && (count > (SIZE_MAX / size))) return NULL;
+    void* ptr = MemPool_malloc(count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+// Resize an allocation
+//  - Returns the same pointer if it already fits, otherwise moves it.
+//  - Returns NULL if there is no space, leaving ptr allocated.
+void* MemPool_realloc(void* ptr, size_t size) {
+    if (!ptr) return MemPool_malloc(size);
+    if (!size) {
+        MemPool_free(ptr);
+        return NULL;
+    }
+    HpsErr_t irqState = IRQ_spinLock(&_MemPool_lock);
+    MemPoolBlock_t* block = _MemPool_header(ptr);
+    size_t capacity = block ? _MemPool_capacity(block->sizeClass) : 0;
+    IRQ_spinUnlock(&_MemPool_lock, irqState);
+    if (!block) return NULL;
+    if (size <= capacity) return ptr;
+    void* moved = MemPool_malloc(size);
+    if (!moved) return NULL;
+    memcpy(moved, ptr, capacity);
+    MemPool_free(ptr);
+    return moved;
+}
+
+// Free an allocation
+//  - ptr may be NULL.
+void MemPool_free(void* ptr) {
+    if (!ptr) return;
+    HpsErr_t irqState = IRQ_spinLock(&_MemPool_lock);
+    MemPoolBlock_t* block = _MemPool_header(ptr);
+    if (block) {
+        unsigned int sizeClass = block->sizeClass;
+        block->magic = MEM_POOL_FREED;
+        _MemPool_next(block) = _MemPool_free[sizeClass];
+        _MemPool_free[sizeClass] = block;
+    }
+    IRQ_spinUnlock(&_MemPool_lock, irqState);
+}
+
+// Get the number of pool bytes which have never been allocated
+size_t MemPool_unused(void) {
+    return sizeof(_MemPool_pool) - _MemPool_used;
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Static Memory Pool
+ * ------------------
+ *
+ * Allocation routines used by the drivers for their contexts
+ * and buffers. By default these are the C library heap, but
+ * for real-time builds a static pool can be used instead by
+ * globally defining its size in bytes:
+ *
+ *     -D MEM_POOL_SIZE=65536
+ *
+ * The pool is split into power of two size classes, from 16
+ * bytes up. Each allocation is rounded up to the next class
+ * (including an 8 byte header), and freed blocks are kept on
+ * a free list for their class to be reused by the next
+ * allocation of that class. Blocks are never split or merged,
+ * so allocating and freeing take a bounded time and the pool
+ * cannot fragment, at the cost of up to half of each block.
+ *
+ * New blocks are carved from the end of the used part of the
+ * pool. If the pool is exhausted, a free block of a larger
+ * class is used instead, otherwise NULL is returned.
+ *
+ * Allocations are 8 byte aligned. The routines are safe to
+ * call with interrupts enabled and from both cores.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef MEM_POOL_H_
+#define MEM_POOL_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef MEM_POOL_SIZE
+
+// Allocate size bytes
+//  - Returns NULL if there is no space.
+void* MemPool_malloc(size_t size);
+
+// Allocate count elements of size bytes, initialised to zero
+//  - Returns NULL if there is no space.
+void* MemPool_calloc(size_t count, size_t size);
+
+// Resize an allocation
+//  - Returns the same pointer if it already fits, otherwise moves it.
+//  - Returns NULL if there is no space, leaving ptr allocated.
+void* MemPool_realloc(void* ptr, size_t size);
+
+// Free an allocation
+//  - ptr may be NULL.
+void MemPool_free(void* ptr);
+
+// Get the number of pool bytes which have never been allocated
+size_t MemPool_unused(void);
+
+#else
+
+// Use the C library heap
+
+static inline void* MemPool_malloc(size_t size) {
+    return malloc(size);
+}
+
+static inline void* MemPool_calloc(size_t count, size_t size) {
+    return calloc(count, size);
+}
+
+static inline void* MemPool_realloc(void* ptr, size_t size) {
+    return realloc(ptr, size);
+}
+
+static inline void MemPool_free(void* ptr) {
+    free(ptr);
+}
+
+#endif
+
+#endif /* MEM_POOL_H_ */
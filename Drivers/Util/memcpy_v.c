@@ -5,6 +5,10 @@
  * Provides an instantiation of memcpy which does not
  * discard the volatile qualifier
  *
+ * Copies use the widest access which the relative
+ * alignment of source and destination allows, with
+ * LDM/STM bursts for aligned blocks on ARM.
+ *
  * Based on sample from StackOverflow. Licensed under
  * CC BY-SA 4.0
  * https://stackoverflow.com/a/54965696/1557472
@@ -13,44 +17,139 @@
 
 #include "memcpy_v.h"
 
-// memcpy for Volatile Source/Destiation
-volatile void *memcpy_v2v(volatile void *restrict dest,
+#include <stdint.h>
+
+// Copy with accesses of the widest size allowed by alignment
+//  - Copies in increasing address order. Each location is accessed once.
+//  - Non-volatile pointers are passed in as volatile, which only stops the
+//    accesses being merged or reordered.
+static volatile void* _memcpy_v(volatile void *restrict dest,
             const volatile void *restrict src, size_t n
 ) {
     const volatile unsigned char *src_c = src;
     volatile unsigned char *dest_c      = dest;
+    uintptr_t misalign = (uintptr_t)src_c ^ (uintptr_t)dest_c;
 
+    if (!(misalign & (sizeof(uint32_t) - 1))) {
+        // Same word alignment. Bytes up to the first word boundary.
+        while (n && ((uintptr_t)dest_c & (sizeof(uint32_t) - 1))) {
+            *dest_c++ = *src_c++;
+            n--;
+        }
+#if defined(__arm__)
+        // Bursts of four words. The compiler won't merge volatile accesses,
+        // so the LDM/STM pair is issued explicitly. r7 is avoided as it is
+        // the frame pointer in Thumb code.
+        while (n >= 4 * sizeof(uint32_t)) {
+            __asm__ __volatile__ (
+                "ldmia %[src]!, {r4-r6, r8}\n\t"
+                "stmia %[dest]!, {r4-r6, r8}\n\t"
+                : [src] "+r" (src_c), [dest] "+r" (dest_c)
+                :
+                : "r4", "r5", "r6", "r8", "memory"
+            );
+            n -= 4 * sizeof(uint32_t);
+        }
+#endif
+        // Double words (LDRD/STRD), then words
+        while (n >= sizeof(uint64_t)) {
+            *(volatile uint64_t*)dest_c = *(const volatile uint64_t*)src_c;
+            dest_c += sizeof(uint64_t);
+            src_c  += sizeof(uint64_t);
+            n      -= sizeof(uint64_t);
+        }
+        while (n >= sizeof(uint32_t)) {
+            *(volatile uint32_t*)dest_c = *(const volatile uint32_t*)src_c;
+            dest_c += sizeof(uint32_t);
+            src_c  += sizeof(uint32_t);
+            n      -= sizeof(uint32_t);
+        }
+    }
+    if (!(misalign & (sizeof(uint16_t) - 1))) {
+        // Same half-word alignment. Byte up to the first half-word boundary.
+        if (n && ((uintptr_t)dest_c & (sizeof(uint16_t) - 1))) {
+            *dest_c++ = *src_c++;
+            n--;
+        }
+        while (n >= sizeof(uint16_t)) {
+            *(volatile uint16_t*)dest_c = *(const volatile uint16_t*)src_c;
+            dest_c += sizeof(uint16_t);
+            src_c  += sizeof(uint16_t);
+            n      -= sizeof(uint16_t);
+        }
+    }
+    // Anything left
     while (n > 0) {
         n--;
-        dest_c[n] = src_c[n];
+        *dest_c++ = *src_c++;
     }
     return  dest;
 }
 
+// FIFO copy helper for each access width
+//  - If fifoDest, all writes go to dest, otherwise all reads come from src.
+#define MEMCPY_V_FIFO_DEF(type) \
+static void _memcpy_fifo_##type(volatile void* dest, const volatile void* src, size_t n, bool fifoDest) { \
+    volatile type* dest_w = dest;                                  \
+    const volatile type* src_w = src;                              \
+    size_t count = n / sizeof(type);                               \
+    while (count--) {                                              \
+        *dest_w = *src_w;                                          \
+        if (!fifoDest) dest_w++;                                   \
+        if ( fifoDest) src_w++;                                    \
+    }                                                              \
+}
+
+MEMCPY_V_FIFO_DEF(uint8_t )
+MEMCPY_V_FIFO_DEF(uint16_t)
+MEMCPY_V_FIFO_DEF(uint32_t)
+MEMCPY_V_FIFO_DEF(uint64_t)
+
+// Copy to or from a FIFO register with accesses of the given width
+static volatile void* _memcpy_fifo(volatile void* dest, const volatile void* src, size_t n, size_t width, bool fifoDest) {
+    // Length and both pointers must be a multiple of the width
+    if ((n | (uintptr_t)dest | (uintptr_t)src) & (width - 1)) return NULL;
+    switch (width) {
+        case sizeof(uint8_t ): _memcpy_fifo_uint8_t (dest, src, n, fifoDest); break;
+        case sizeof(uint16_t): _memcpy_fifo_uint16_t(dest, src, n, fifoDest); break;
+        case sizeof(uint32_t): _memcpy_fifo_uint32_t(dest, src, n, fifoDest); break;
+        case sizeof(uint64_t): _memcpy_fifo_uint64_t(dest, src, n, fifoDest); break;
+        default: return NULL;
+    }
+    return dest;
+}
+
+// memcpy for Volatile Source/Destiation
+volatile void *memcpy_v2v(volatile void *restrict dest,
+            const volatile void *restrict src, size_t n
+) {
+    return _memcpy_v(dest, src, n);
+}
+
 // memcpy for Volatile Source
 volatile void *memcpy_v2(void *restrict dest,
             const volatile void *restrict src, size_t n
 ) {
-    const volatile unsigned char *src_c = src;
-    unsigned char *dest_c               = dest;
-
-    while (n > 0) {
-        n--;
-        dest_c[n] = src_c[n];
-    }
-    return  dest;
+    return _memcpy_v(dest, src, n);
 }
 
 // memcpy for Volatile Destination
 volatile void *memcpy_2v(volatile void *restrict dest,
             const void *restrict src, size_t n
 ) {
-    const unsigned char *src_c     = src;
-    volatile unsigned char *dest_c = dest;
+    return _memcpy_v(dest, src, n);
+}
+
+// Copy to a FIFO (non-incrementing destination)
+volatile void *memcpy_2fifo(volatile void *restrict fifo,
+            const volatile void *restrict src, size_t n, size_t width
+) {
+    return _memcpy_fifo(fifo, src, n, width, true);
+}
 
-    while (n > 0) {
-        n--;
-        dest_c[n] = src_c[n];
-    }
-    return  dest;
+// Copy from a FIFO (non-incrementing source)
+volatile void *memcpy_fifo2(volatile void *restrict dest,
+            const volatile void *restrict fifo, size_t n, size_t width
+) {
+    return _memcpy_fifo(dest, fifo, n, width, false);
 }
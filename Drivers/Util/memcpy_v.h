@@ -5,6 +5,16 @@
  * Provides an instantiation of memcpy which does not
  * discard the volatile qualifier
  *
+ * Copies use the widest access which the relative
+ * alignment of source and destination allows (64-bit,
+ * 32-bit, 16-bit or bytes), with LDM/STM bursts for
+ * aligned blocks on ARM. Each location is accessed once,
+ * in increasing address order.
+ *
+ * For peripheral FIFO registers, memcpy_2fifo and
+ * memcpy_fifo2 access the register repeatedly with a
+ * fixed access width.
+ *
  * Based on sample from StackOverflow. Licensed under
  * CC BY-SA 4.0
  * https://stackoverflow.com/a/54965696/1557472
@@ -15,6 +25,7 @@
 #define MEMCPY_V_
 
 #include <stddef.h>
+#include <stdbool.h>
 
 // memcpy for Volatile Source/Destiation
 volatile void *memcpy_v2v(volatile void *restrict dest,
@@ -28,4 +39,16 @@ volatile void *memcpy_v2(void *restrict dest,
 volatile void *memcpy_2v(volatile void *restrict dest,
             const void *restrict src, size_t n);
 
+// Copy to a FIFO (non-incrementing destination)
+//  - Writes n bytes from src to the fifo register, width bytes (1, 2, 4 or 8) at a time.
+//  - Returns NULL if n, fifo or src are not a multiple of width.
+volatile void *memcpy_2fifo(volatile void *restrict fifo,
+            const volatile void *restrict src, size_t n, size_t width);
+
+// Copy from a FIFO (non-incrementing source)
+//  - Reads n bytes from the fifo register to dest, width bytes (1, 2, 4 or 8) at a time.
+//  - Returns NULL if n, fifo or dest are not a multiple of width.
+volatile void *memcpy_fifo2(volatile void *restrict dest,
+            const volatile void *restrict fifo, size_t n, size_t width);
+
 #endif /* MEMCPY_V_ */
@@ -0,0 +1,253 @@
+/*
+ * Performance Baseline
+ * --------------------
+ *
+ * Stores the results of a benchmark run as a CSV file on a FatFS
+ * volume, and compares each result of the next run against it, so
+ * that a board can check its own throughput after a firmware update
+ * without a host attached.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "perf_baseline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FatFS/ff.h"
+#include "Util/mem_pool.h"
+
+// Header row of the file
+#define PERF_BASELINE_HEADER  "metric,value,direction\n"
+
+// Longest line in the file
+#define PERF_BASELINE_LINE_MAX (PERF_BASELINE_NAME_MAX + 40)
+
+/*
+ * Internal Functions
+ */
+
+//Convert a FatFS result into an error code
+static HpsErr_t _PerfBaseline_result( FRESULT res ) {
+    switch (res) {
+        case FR_OK:              return ERR_SUCCESS;
+        case FR_NO_FILE:
+        case FR_NO_PATH:
+        case FR_INVALID_NAME:
+        case FR_INVALID_DRIVE:   return ERR_NOTFOUND;
+        case FR_NOT_READY:       return ERR_NOTREADY;
+        case FR_NOT_ENABLED:
+        case FR_NO_FILESYSTEM:   return ERR_BADDISK;
+        case FR_WRITE_PROTECTED: return ERR_WRITEPROT;
+        case FR_TIMEOUT:         return ERR_TIMEOUT;
+        case FR_NOT_ENOUGH_CORE: return ERR_ALLOCFAIL;
+        default:                 return ERR_IOFAIL;
+    }
+}
+
+//Copy a metric name, truncating and replacing commas
+static void _PerfBaseline_copyName( char* dest, const char* src, size_t len ) {
+    size_t idx = 0;
+    for (; (idx < PERF_BASELINE_NAME_MAX - 1) && (idx < len) && src[idx]; idx++) {
+        dest[idx] = (src[idx] == ',') ? ' ' : src[idx];
+    }
+    dest[idx] = '\0';
+}
+
+//Find a metric by name, adding it if not found
+// - Returns NULL if the table is full.
+static PerfMetric_t* _PerfBaseline_find( PerfBaselineCtx_t* ctx, const char* name ) {
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        if (!strcmp(ctx->metrics[idx].name, name)) return &ctx->metrics[idx];
+    }
+    if (ctx->count >= ctx->size) return NULL;
+    PerfMetric_t* metric = &ctx->metrics[ctx->count++];
+    memset(metric, 0, sizeof(*metric));
+    strcpy(metric->name, name);
+    return metric;
+}
+
+//Load the baseline file
+// - Returns ERR_SUCCESS if the file does not exist.
+static HpsErr_t _PerfBaseline_load( PerfBaselineCtx_t* ctx ) {
+    FIL file;
+    char line[PERF_BASELINE_LINE_MAX];
+    char name[PERF_BASELINE_NAME_MAX];
+    FRESULT res = f_open(&file, ctx->path, FA_READ);
+    if (res == FR_NO_FILE) return ERR_SUCCESS;
+    if (res != FR_OK) return _PerfBaseline_result(res);
+    HpsErr_t status = ERR_SUCCESS;
+    bool header = true;
+    while (f_gets(line, sizeof(line), &file)) {
+        //Skip the header row
+        if (header) {
+            header = false;
+            if (!strncmp(line, PERF_BASELINE_HEADER, strlen(PERF_BASELINE_HEADER) - 1)) continue;
+        }
+        //metric,value,direction
+        char* valueStr = strchr(line, ',');
+        if (!valueStr) {
+            status = ERR_CORRUPT;
+            break;
+        }
+        char* end;
+        double value = strtod(valueStr + 1, &end);
+        if ((end == valueStr + 1) || (*end != ',')) {
+            status = ERR_CORRUPT;
+            break;
+        }
+        _PerfBaseline_copyName(name, line, valueStr - line);
+        PerfMetric_t* metric = _PerfBaseline_find(ctx, name);
+        if (!metric) {
+            status = ERR_NOSPACE;
+            break;
+        }
+        metric->direction   = !strncmp(end + 1, "lower", 5) ? PERF_LOWER_BETTER : PERF_HIGHER_BETTER;
+        metric->baseline    = value;
+        metric->hasBaseline = true;
+    }
+    if ((status == ERR_SUCCESS) && f_error(&file)) status = ERR_IOFAIL;
+    f_close(&file);
+    return status;
+}
+
+//Get the change of a result from its baseline
+// - Returns the percentage by which the result is worse (negative if better).
+static double _PerfBaseline_worse( const PerfMetric_t* metric ) {
+    if (metric->baseline == 0.0) return 0.0;
+    double change = 100.0 * (metric->value - metric->baseline) / metric->baseline;
+    return (metric->direction == PERF_HIGHER_BETTER) ? -change : change;
+}
+
+//Cleanup
+static void _PerfBaseline_cleanup( PerfBaselineCtx_t* ctx ) {
+    if (ctx->metrics) {
+        MemPool_free(ctx->metrics);
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise the baseline
+//  - path is the CSV file on a mounted volume. It is loaded if it exists.
+//  - maxMetrics is the most metrics that can be recorded (including those
+//    only in the loaded baseline).
+//  - threshold is the percentage by which a result may be worse than its
+//    baseline before it is flagged.
+//  - Returns ERR_CORRUPT if the file exists but can't be parsed.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t PerfBaseline_initialise(const char* path, unsigned int maxMetrics, double threshold, PerfBaselineCtx_t** pCtx) {
+    //Ensure user pointers valid
+    if (!path) return ERR_NULLPTR;
+    if (strlen(path) >= PERF_BASELINE_PATH_MAX) return ERR_TOOBIG;
+    if (!maxMetrics) return ERR_TOOSMALL;
+    if (threshold < 0.0) return ERR_OUTRANGE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_PerfBaseline_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Populate the context
+    PerfBaselineCtx_t* ctx = *pCtx;
+    strcpy(ctx->path, path);
+    ctx->threshold = threshold;
+    ctx->size = maxMetrics;
+    ctx->count = 0;
+    ctx->regressions = 0;
+    ctx->metrics = MemPool_calloc(maxMetrics, sizeof(PerfMetric_t));
+    if (!ctx->metrics) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    //Load the previous run
+    status = _PerfBaseline_load(ctx);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool PerfBaseline_isInitialised(PerfBaselineCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Record a result
+//  - Compares value against the baseline of the metric with the same name.
+//  - Returns 1 if the result is a regression, 0 if not (or no baseline).
+//  - Returns ERR_NOSPACE if maxMetrics have been recorded.
+HpsErr_t PerfBaseline_record(PerfBaselineCtx_t* ctx, const char* name, double value, PerfDirection direction) {
+    char key[PERF_BASELINE_NAME_MAX];
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!name) return ERR_NULLPTR;
+    _PerfBaseline_copyName(key, name, PERF_BASELINE_NAME_MAX);
+    PerfMetric_t* metric = _PerfBaseline_find(ctx, key);
+    if (!metric) return ERR_NOSPACE;
+    //A repeated result replaces the earlier one
+    bool wasRegression = metric->hasValue && metric->hasBaseline && (_PerfBaseline_worse(metric) > ctx->threshold);
+    metric->direction = direction;
+    metric->value = value;
+    metric->hasValue = true;
+    bool regression = metric->hasBaseline && (_PerfBaseline_worse(metric) > ctx->threshold);
+    ctx->regressions = ctx->regressions - wasRegression + regression;
+    return regression ? 1 : 0;
+}
+
+// Print the comparison
+//  - Prints each result with its baseline and change, marking regressions.
+//  - Returns the number of regressions.
+HpsErr_t PerfBaseline_report(PerfBaselineCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    printf("%-*s %14s %14s %9s\n", PERF_BASELINE_NAME_MAX - 1, "Metric", "Value", "Baseline", "Worse %");
+    for (unsigned int idx = 0; idx < ctx->count; idx++) {
+        PerfMetric_t* metric = &ctx->metrics[idx];
+        if (!metric->hasValue) continue;
+        if (!metric->hasBaseline) {
+            printf("%-*s %14.3f %14s %9s\n", PERF_BASELINE_NAME_MAX - 1, metric->name, metric->value, "-", "new");
+            continue;
+        }
+        double worse = _PerfBaseline_worse(metric);
+        printf("%-*s %14.3f %14.3f %9.1f%s\n", PERF_BASELINE_NAME_MAX - 1, metric->name, metric->value,
+               metric->baseline, worse, (worse > ctx->threshold) ? " REGRESSION" : "");
+    }
+    printf("%u regression(s) beyond %.1f%%\n", ctx->regressions, ctx->threshold);
+    return (HpsErr_t)ctx->regressions;
+}
+
+// Save the results as the new baseline
+//  - Overwrites the file with this run's results. Metrics in the old
+//    baseline which were not recorded this run keep their old value.
+//  - Returns ERR_IOFAIL (or another code) if the file can't be written.
+HpsErr_t PerfBaseline_save(PerfBaselineCtx_t* ctx) {
+    FIL file;
+    char line[PERF_BASELINE_LINE_MAX];
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    FRESULT res = f_open(&file, ctx->path, FA_WRITE | FA_CREATE_ALWAYS);
+    if (res != FR_OK) return _PerfBaseline_result(res);
+    if (f_puts(PERF_BASELINE_HEADER, &file) < 0) status = ERR_IOFAIL;
+    for (unsigned int idx = 0; ERR_IS_SUCCESS(status) && (idx < ctx->count); idx++) {
+        PerfMetric_t* metric = &ctx->metrics[idx];
+        double value = metric->hasValue ? metric->value : metric->baseline;
+        snprintf(line, sizeof(line), "%s,%.6g,%s\n", metric->name, value,
+                 (metric->direction == PERF_LOWER_BETTER) ? "lower" : "higher");
+        if (f_puts(line, &file) < 0) status = ERR_IOFAIL;
+    }
+    res = f_close(&file);
+    if (ERR_IS_SUCCESS(status) && (res != FR_OK)) status = _PerfBaseline_result(res);
+    return status;
+}
@@ -0,0 +1,122 @@
+/*
+ * Performance Baseline
+ * --------------------
+ *
+ * Stores the results of a benchmark run as a CSV file on a FatFS
+ * volume, and compares each result of the next run against it, so
+ * that a board can check its own throughput after a firmware update
+ * without a host attached.
+ *
+ *    f_mount(&fs, "0:", 1);
+ *    PerfBaseline_initialise("0:/bench.csv", 64, 10.0, &base);  // 10% threshold
+ *    ...
+ *    PerfBaseline_record(base, "memcpy/4096", mbps, PERF_HIGHER_BETTER);
+ *    PerfBaseline_record(base, "irq_latency", ns, PERF_LOWER_BETTER);
+ *    ...
+ *    if (PerfBaseline_report(base) == 0) {
+ *        PerfBaseline_save(base);   // Only move the baseline on if clean
+ *    }
+ *
+ * The previous results are loaded when the context is initialised.
+ * A result which is worse than its baseline by more than the threshold
+ * percentage is flagged as a regression. Results with no baseline (the
+ * first run, or a new metric) are recorded but never flagged.
+ *
+ * The file has one "metric,value,direction" row per result after a
+ * header row, so it can be opened on a PC to track values over time.
+ * Direction is "higher" or "lower", for which way is better. Metric
+ * names are truncated to PERF_BASELINE_NAME_MAX - 1 characters, and
+ * commas are replaced by spaces.
+ *
+ * The volume must already be mounted. Requires FF_USE_STRFUNC.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef PERF_BASELINE_H_
+#define PERF_BASELINE_H_
+
+#include "Util/driver_ctx.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Longest metric name, including the terminator
+#define PERF_BASELINE_NAME_MAX  48
+
+// Longest file path, including the terminator
+#define PERF_BASELINE_PATH_MAX  64
+
+// Which direction is an improvement
+typedef enum {
+    PERF_HIGHER_BETTER,     // e.g. throughput
+    PERF_LOWER_BETTER       // e.g. latency or cycles
+} PerfDirection;
+
+// Metric
+typedef struct {
+    char          name[PERF_BASELINE_NAME_MAX];
+    PerfDirection direction;
+    double        value;        // Result of this run
+    double        baseline;     // Result of the previous run
+    bool          hasValue;
+    bool          hasBaseline;
+} PerfMetric_t;
+
+// Baseline Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    char          path[PERF_BASELINE_PATH_MAX];
+    double        threshold;    // Percentage
+    PerfMetric_t* metrics;
+    unsigned int  size;         // Number of metrics allocated
+    unsigned int  count;        // Number in use
+    unsigned int  regressions;
+} PerfBaselineCtx_t;
+
+// Initialise the baseline
+//  - path is the CSV file on a mounted volume. It is loaded if it exists.
+//  - maxMetrics is the most metrics that can be recorded (including those
+//    only in the loaded baseline).
+//  - threshold is the percentage by which a result may be worse than its
+//    baseline before it is flagged.
+//  - Returns ERR_CORRUPT if the file exists but can't be parsed.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t PerfBaseline_initialise(const char* path, unsigned int maxMetrics, double threshold, PerfBaselineCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool PerfBaseline_isInitialised(PerfBaselineCtx_t* ctx);
+
+// Record a result
+//  - Compares value against the baseline of the metric with the same name.
+//  - Returns 1 if the result is a regression, 0 if not (or no baseline).
+//  - Returns ERR_NOSPACE if maxMetrics have been recorded.
+HpsErr_t PerfBaseline_record(PerfBaselineCtx_t* ctx, const char* name, double value, PerfDirection direction);
+
+// Print the comparison
+//  - Prints each result with its baseline and change, marking regressions.
+//  - Returns the number of regressions.
+HpsErr_t PerfBaseline_report(PerfBaselineCtx_t* ctx);
+
+// Save the results as the new baseline
+//  - Overwrites the file with this run's results. Metrics in the old
+//    baseline which were not recorded this run keep their old value.
+//  - Returns ERR_IOFAIL (or another code) if the file can't be written.
+HpsErr_t PerfBaseline_save(PerfBaselineCtx_t* ctx);
+
+#endif /* PERF_BASELINE_H_ */
@@ -0,0 +1,181 @@
+/*
+ * Pixel Format Conversion
+ * -----------------------
+ *
+ * Converts rows of pixels from common image formats into the
+ * RGB565 format used by the LT24 display.
+ *
+ * Each channel has the dither threshold added with saturation,
+ * then is truncated to its top 5 or 6 bits. The NEON versions
+ * widen each channel into the top of a 16-bit lane, then use
+ * shift-right-and-insert to pack the three together.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "pixel_convert.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// 4x4 Bayer thresholds scaled to the bits dropped from each channel.
+// Each row is repeated so that 8 pixels can be loaded at once.
+static const uint8_t _Pixel_dither5[4][8] = {
+    { 0, 4, 1, 5, 0, 4, 1, 5 },
+    { 6, 2, 7, 3, 6, 2, 7, 3 },
+    { 1, 5, 0, 4, 1, 5, 0, 4 },
+    { 7, 3, 6, 2, 7, 3, 6, 2 }
+};
+static const uint8_t _Pixel_dither6[4][8] = {
+    { 0, 2, 0, 2, 0, 2, 0, 2 },
+    { 3, 1, 3, 1, 3, 1, 3, 1 },
+    { 0, 2, 0, 2, 0, 2, 0, 2 },
+    { 3, 1, 3, 1, 3, 1, 3, 1 }
+};
+static const uint8_t _Pixel_noDither[8] = { 0 };
+
+/*
+ * Internal Functions
+ */
+
+// Get the dither thresholds for a row
+static void _Pixel_ditherRow(unsigned int row, PixelDither dither, const uint8_t** d5, const uint8_t** d6) {
+    if (dither == PIXEL_DITHER_ORDERED) {
+        *d5 = _Pixel_dither5[row & 3];
+        *d6 = _Pixel_dither6[row & 3];
+    } else {
+        *d5 = _Pixel_noDither;
+        *d6 = _Pixel_noDither;
+    }
+}
+
+// Saturating add of a dither threshold to a channel
+static inline unsigned int _Pixel_addSat(unsigned int val, unsigned int add) {
+    val += add;
+    return (val > 0xFF) ? 0xFF : val;
+}
+
+// Convert pixels from separate channel pointers
+//  - r, g and b point to the channels of pixel x, and step is the bytes between pixels.
+static void _Pixel_convertScalar(unsigned short* dst, const uint8_t* r, const uint8_t* g, const uint8_t* b, unsigned int step, unsigned int x, unsigned int count, const uint8_t* d5, const uint8_t* d6) {
+    for (; x < count; x++) {
+        unsigned int red   = _Pixel_addSat(*r, d5[x & 7]);
+        unsigned int green = _Pixel_addSat(*g, d6[x & 7]);
+        unsigned int blue  = _Pixel_addSat(*b, d5[x & 7]);
+        dst[x] = (unsigned short)(((red >> 3) << 11) | ((green >> 2) << 5) | (blue >> 3));
+        r += step;
+        g += step;
+        b += step;
+    }
+}
+
+#if defined(__ARM_NEON)
+// Dither and pack 8 pixels of separate channels into RGB565
+static inline uint16x8_t _Pixel_pack8(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t d5, uint8x8_t d6) {
+    r = vqadd_u8(r, d5);
+    g = vqadd_u8(g, d6);
+    b = vqadd_u8(b, d5);
+    //Red stays in the top 5 bits, then insert green below it, then blue below that
+    uint16x8_t out = vsriq_n_u16(vshll_n_u8(r, 8), vshll_n_u8(g, 8), 5);
+    return vsriq_n_u16(out, vshll_n_u8(b, 8), 11);
+}
+#endif
+
+/*
+ * User Facing APIs
+ */
+
+// Convert a row of RGB888 pixels to RGB565
+//  - src is count pixels of 3 bytes each, dst is count pixels.
+//  - row is the y coordinate of the row, used for dithering.
+HpsErr_t Pixel_rgb888ToRgb565(unsigned short* dst, const uint8_t* src, unsigned int count, unsigned int row, PixelDither dither) {
+    if (!dst || !src) return ERR_NULLPTR;
+    const uint8_t* d5;
+    const uint8_t* d6;
+    _Pixel_ditherRow(row, dither, &d5, &d6);
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint8x8_t v5 = vld1_u8(d5);
+    uint8x8_t v6 = vld1_u8(d6);
+    for (; x + 8 <= count; x += 8) {
+        uint8x8x3_t px = vld3_u8(&src[3 * x]);
+        vst1q_u16(&dst[x], _Pixel_pack8(px.val[0], px.val[1], px.val[2], v5, v6));
+    }
+#endif
+    _Pixel_convertScalar(dst, &src[3 * x], &src[3 * x + 1], &src[3 * x + 2], 3, x, count, d5, d6);
+    return ERR_SUCCESS;
+}
+
+// Convert a row of BGR888 pixels to RGB565
+//  - As Pixel_rgb888ToRgb565(), with blue as the first byte of each pixel.
+HpsErr_t Pixel_bgr888ToRgb565(unsigned short* dst, const uint8_t* src, unsigned int count, unsigned int row, PixelDither dither) {
+    if (!dst || !src) return ERR_NULLPTR;
+    const uint8_t* d5;
+    const uint8_t* d6;
+    _Pixel_ditherRow(row, dither, &d5, &d6);
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint8x8_t v5 = vld1_u8(d5);
+    uint8x8_t v6 = vld1_u8(d6);
+    for (; x + 8 <= count; x += 8) {
+        uint8x8x3_t px = vld3_u8(&src[3 * x]);
+        vst1q_u16(&dst[x], _Pixel_pack8(px.val[2], px.val[1], px.val[0], v5, v6));
+    }
+#endif
+    _Pixel_convertScalar(dst, &src[3 * x + 2], &src[3 * x + 1], &src[3 * x], 3, x, count, d5, d6);
+    return ERR_SUCCESS;
+}
+
+// Convert a row of ARGB8888 pixels to RGB565
+//  - src is count 32-bit pixels of 0xAARRGGBB. Alpha is ignored.
+//  - row is the y coordinate of the row, used for dithering.
+HpsErr_t Pixel_argb8888ToRgb565(unsigned short* dst, const uint32_t* src, unsigned int count, unsigned int row, PixelDither dither) {
+    if (!dst || !src) return ERR_NULLPTR;
+    const uint8_t* d5;
+    const uint8_t* d6;
+    _Pixel_ditherRow(row, dither, &d5, &d6);
+    //Little endian, so the bytes of each word are blue, green, red, alpha
+    const uint8_t* bytes = (const uint8_t*)src;
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint8x8_t v5 = vld1_u8(d5);
+    uint8x8_t v6 = vld1_u8(d6);
+    for (; x + 8 <= count; x += 8) {
+        uint8x8x4_t px = vld4_u8(&bytes[4 * x]);
+        vst1q_u16(&dst[x], _Pixel_pack8(px.val[2], px.val[1], px.val[0], v5, v6));
+    }
+#endif
+    _Pixel_convertScalar(dst, &bytes[4 * x + 2], &bytes[4 * x + 1], &bytes[4 * x], 4, x, count, d5, d6);
+    return ERR_SUCCESS;
+}
+
+// Convert a row of greyscale pixels to RGB565
+//  - src is count 8-bit luminance values.
+//  - row is the y coordinate of the row, used for dithering.
+HpsErr_t Pixel_grey8ToRgb565(unsigned short* dst, const uint8_t* src, unsigned int count, unsigned int row, PixelDither dither) {
+    if (!dst || !src) return ERR_NULLPTR;
+    const uint8_t* d5;
+    const uint8_t* d6;
+    _Pixel_ditherRow(row, dither, &d5, &d6);
+    unsigned int x = 0;
+#if defined(__ARM_NEON)
+    uint8x8_t v5 = vld1_u8(d5);
+    uint8x8_t v6 = vld1_u8(d6);
+    for (; x + 8 <= count; x += 8) {
+        uint8x8_t px = vld1_u8(&src[x]);
+        vst1q_u16(&dst[x], _Pixel_pack8(px, px, px, v5, v6));
+    }
+#endif
+    _Pixel_convertScalar(dst, &src[x], &src[x], &src[x], 1, x, count, d5, d6);
+    return ERR_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/*
+ * Pixel Format Conversion
+ * -----------------------
+ *
+ * Converts rows of pixels from common image formats into the
+ * RGB565 format used by the LT24 display, e.g. when loading
+ * bitmaps from an SD card.
+ *
+ * Formats
+ * -------
+ *
+ *  - RGB888:   3 bytes per pixel, red first.
+ *  - BGR888:   3 bytes per pixel, blue first (24-bit BMP files).
+ *  - ARGB8888: 32-bit words of 0xAARRGGBB (32-bit BMP files). The alpha
+ *              channel is ignored.
+ *  - Grey8:    1 byte per pixel luminance.
+ *
+ * Dithering
+ * ---------
+ *
+ * Reducing 8-bit channels to 5 or 6 bits causes visible banding on
+ * smooth gradients. With PIXEL_DITHER_ORDERED, a 4x4 Bayer threshold
+ * is added to each channel before it is truncated, trading banding
+ * for a fine regular pattern. The pattern depends on the position of
+ * the pixel, so each row is converted with its y coordinate, and the
+ * first pixel of the row is taken to be in a column which is a
+ * multiple of 4.
+ *
+ * NEON
+ * ----
+ *
+ * Where the compiler has NEON enabled (__ARM_NEON), the conversions
+ * are vectorised to process 8 pixels at a time, using the structure
+ * loads to split the channels. Otherwise a portable C implementation
+ * is used.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef PIXEL_CONVERT_H_
+#define PIXEL_CONVERT_H_
+
+#include <stdint.h>
+
+#include "Util/error.h"
+
+// Dithering mode
+typedef enum {
+    PIXEL_DITHER_NONE,     // Truncate each channel
+    PIXEL_DITHER_ORDERED   // 4x4 ordered (Bayer) dither
+} PixelDither;
+
+// Convert a row of RGB888 pixels to RGB565
+//  - src is count pixels of 3 bytes each, dst is count pixels.
+//  - row is the y coordinate of the row, used for dithering.
+HpsErr_t Pixel_rgb888ToRgb565(unsigned short* dst, const uint8_t* src, unsigned int count, unsigned int row, PixelDither dither);
+
+// Convert a row of BGR888 pixels to RGB565
+//  - As Pixel_rgb888ToRgb565(), with blue as the first byte of each pixel.
+HpsErr_t Pixel_bgr888ToRgb565(unsigned short* dst, const uint8_t* src, unsigned int count, unsigned int row, PixelDither dither);
+
+// Convert a row of ARGB8888 pixels to RGB565
+//  - src is count 32-bit pixels of 0xAARRGGBB. Alpha is ignored.
+//  - row is the y coordinate of the row, used for dithering.
+HpsErr_t Pixel_argb8888ToRgb565(unsigned short* dst, const uint32_t* src, unsigned int count, unsigned int row, PixelDither dither);
+
+// Convert a row of greyscale pixels to RGB565
+//  - src is count 8-bit luminance values.
+//  - row is the y coordinate of the row, used for dithering.
+HpsErr_t Pixel_grey8ToRgb565(unsigned short* dst, const uint8_t* src, unsigned int count, unsigned int row, PixelDither dither);
+
+#endif /* PIXEL_CONVERT_H_ */
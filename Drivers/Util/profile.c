@@ -0,0 +1,355 @@
+/*
+ * Cycle Accurate Profiling
+ * ------------------------
+ *
+ * Measures the execution time of sections of code using the
+ * Cortex-A9 Performance Monitor Unit (PMU) cycle counter, and
+ * optionally PMU event counters (e.g. cache misses and branch
+ * mispredictions). Each section is also timestamped with the
+ * 64-bit ARM global timer, so that long sections can be timed
+ * in real time units.
+ *
+ * Counters and histograms published by drivers are printed in the
+ * report after the sections.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add section and event accessors for exporting.
+ * 14/10/2026 | Add published counters and histograms.
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "profile.h"
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "Util/lowlevel_arm.h"
+#include "Util/macros.h"
+#include "Util/bit_helpers.h"
+#include "Util/ct_assert.h"
+#include "Util/hwlib/alt_globaltmr.h"
+
+// The Cortex-A9 has six event counters
+ct_assert_define(PROFILE_EVENT_COUNT, <= 6);
+
+// Published by hwlib, but not in the header
+extern bool alt_globaltmr_is_running(void);
+
+// Number of empty sections measured to calibrate overhead
+#define PROFILE_CALIBRATE_RUNS 8
+
+static bool              _initialised = false;
+static unsigned int      _eventCount  = 0;
+static ProfileEvent      _events[PROFILE_EVENT_COUNT];
+static uint32_t          _overhead    = 0;     // Cycles measured for an empty section
+static ProfileSection_t* _sections    = NULL;  // List of sections for report
+static ProfileCounter_t*   _counters   = NULL;  // List of counters for report
+static ProfileHistogram_t* _histograms = NULL;  // List of histograms for report
+
+/*
+ * Internal Functions
+ */
+
+// Read an event counter
+static inline uint32_t _Profile_readEvent(unsigned int idx) {
+    __SET_SYSREG(SYSREG_COPROC, PMSELR, idx);
+    __ISB();
+    return __GET_SYSREG(SYSREG_COPROC, PMXEVCNTR);
+}
+
+// Take counter values at the start of a section
+//  - Cycle counter read last so that as little of this as possible is measured.
+static inline void _Profile_snap(ProfileSnap_t* snap) {
+    snap->ticks = alt_globaltmr_get64();
+    for (unsigned int idx = 0; idx < _eventCount; idx++) {
+        snap->events[idx] = _Profile_readEvent(idx);
+    }
+    __ISB();
+    snap->cycles = __GET_SYSREG(SYSREG_COPROC, PMCCNTR);
+}
+
+// Add the measurement since the snapshot to a section
+//  - Cycle counter read first, the reverse order of the snapshot.
+static inline void _Profile_accumulate(ProfileSection_t* sect, ProfileSnap_t* snap) {
+    __ISB();
+    uint32_t cycles = __GET_SYSREG(SYSREG_COPROC, PMCCNTR) - snap->cycles;
+    for (unsigned int idx = 0; idx < _eventCount; idx++) {
+        sect->events[idx] += _Profile_readEvent(idx) - snap->events[idx];
+    }
+    sect->ticks += alt_globaltmr_get64() - snap->ticks;
+    //Remove overhead of the measurement itself
+    cycles = (cycles > _overhead) ? (cycles - _overhead) : 0;
+    sect->cycles += cycles;
+    sect->minCycles = min(sect->minCycles, cycles);
+    sect->maxCycles = max(sect->maxCycles, cycles);
+    sect->calls++;
+}
+
+// Clear the statistics of a section
+static void _Profile_clear(ProfileSection_t* sect) {
+    sect->calls = 0;
+    sect->cycles = 0;
+    sect->minCycles = UINT32_MAX;
+    sect->maxCycles = 0;
+    sect->ticks = 0;
+    for (unsigned int idx = 0; idx < PROFILE_EVENT_COUNT; idx++) {
+        sect->events[idx] = 0;
+    }
+}
+
+// Short name of event for report
+static const char* _Profile_eventName(ProfileEvent event) {
+    switch (event) {
+        case PROFILE_EVT_L1I_REFILL:     return "L1I miss";
+        case PROFILE_EVT_ITLB_REFILL:    return "ITLB miss";
+        case PROFILE_EVT_L1D_REFILL:     return "L1D miss";
+        case PROFILE_EVT_L1D_ACCESS:     return "L1D access";
+        case PROFILE_EVT_DTLB_REFILL:    return "DTLB miss";
+        case PROFILE_EVT_EXCEPTION:      return "Exceptions";
+        case PROFILE_EVT_BRANCH_MISPRED: return "Br mispred";
+        case PROFILE_EVT_BRANCH_PRED:    return "Branches";
+        case PROFILE_EVT_ICACHE_STALL:   return "I stall";
+        case PROFILE_EVT_DCACHE_STALL:   return "D stall";
+        case PROFILE_EVT_TLB_STALL:      return "TLB stall";
+        case PROFILE_EVT_L1D_EVICT:      return "L1D evict";
+        case PROFILE_EVT_INSTRUCTIONS:   return "Instrs";
+        case PROFILE_EVT_NEON_INSTR:     return "NEON instr";
+        default:                         return "Event";
+    }
+}
+
+// Print the table of sections
+static void _Profile_reportSections(void) {
+    unsigned int rate = Profile_timestampRate();
+    printf("Profile (overhead %u cycles removed)\n", (unsigned int)_overhead);
+    printf("%-16s %8s %14s %10s %10s %10s %12s", "Section", "Calls", "Total cyc", "Avg cyc", "Min cyc", "Max cyc", "Total us");
+    for (unsigned int idx = 0; idx < _eventCount; idx++) {
+        printf(" %10s", _Profile_eventName(_events[idx]));
+    }
+    printf("\n");
+    for (ProfileSection_t* sect = _sections; sect; sect = sect->next) {
+        unsigned int calls = sect->calls;
+        uint64_t us = (sect->ticks * 1000000ULL) / rate;
+        printf("%-16s %8u %14llu %10llu %10lu %10lu %12llu",
+               sect->name, calls,
+               (unsigned long long)sect->cycles,
+               (unsigned long long)(calls ? (sect->cycles / calls) : 0),
+               (unsigned long)(calls ? sect->minCycles : 0),
+               (unsigned long)sect->maxCycles,
+               (unsigned long long)us);
+        for (unsigned int idx = 0; idx < _eventCount; idx++) {
+            printf(" %10llu", (unsigned long long)(calls ? (sect->events[idx] / calls) : 0));
+        }
+        printf("\n");
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise profiling
+//  - Enables the PMU cycle counter, and the event counters for each of the
+//    count events (up to PROFILE_EVENT_COUNT). events may be NULL if count is 0.
+//  - Starts the global timer if not already running.
+//  - Can be called again to change the events, which resets all sections.
+//  - Returns ERR_NOSUPPORT if the PMU has fewer than count event counters.
+HpsErr_t Profile_initialise(const ProfileEvent* events, unsigned int count) {
+    if (count && !events) return ERR_NULLPTR;
+    if (count > PROFILE_EVENT_COUNT) return ERR_TOOBIG;
+    unsigned int pmcr = __GET_SYSREG(SYSREG_COPROC, PMCR);
+    if (count > ((pmcr >> SYSREG_PMCR_BIT_N) & SYSREG_PMCR_MASK_N)) return ERR_NOSUPPORT;
+    //Start the global timer. Leave it alone if already running, as it may be in use.
+    if (!alt_globaltmr_is_running()) {
+        alt_globaltmr_init();
+    }
+    //Stop and reset the PMU counters. Cycle counter counts every cycle.
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENCLR, UINT32_MAX);
+    __SET_SYSREG(SYSREG_COPROC, PMCR, _BV(SYSREG_PMCR_BIT_E) | _BV(SYSREG_PMCR_BIT_P) | _BV(SYSREG_PMCR_BIT_C));
+    //Select the events
+    unsigned int enable = _BV(SYSREG_PMCNTEN_BIT_C);
+    for (unsigned int idx = 0; idx < count; idx++) {
+        __SET_SYSREG(SYSREG_COPROC, PMSELR, idx);
+        __ISB();
+        __SET_SYSREG(SYSREG_COPROC, PMXEVTYPER, events[idx]);
+        _events[idx] = events[idx];
+        enable |= _BV(idx);
+    }
+    __SET_SYSREG(SYSREG_COPROC, PMCNTENSET, enable);
+    __ISB();
+    _eventCount = count;
+    //Calibrate the overhead with empty sections, keeping the fastest
+    ProfileSection_t calibrate = PROFILE_SECTION_INIT("calibrate");
+    ProfileSnap_t snap;
+    _overhead = 0;
+    for (unsigned int run = 0; run < PROFILE_CALIBRATE_RUNS; run++) {
+        _Profile_snap(&snap);
+        _Profile_accumulate(&calibrate, &snap);
+    }
+    _overhead = calibrate.minCycles;
+    //Existing measurements no longer compatible
+    _initialised = true;
+    Profile_reset();
+    return ERR_SUCCESS;
+}
+
+// Check if profiling initialised
+bool Profile_isInitialised(void) {
+    return _initialised;
+}
+
+// Start a section
+//  - Normally called through PROFILE_BEGIN.
+void Profile_begin(ProfileSection_t* sect, ProfileSnap_t* snap) {
+    if (!_initialised) return;
+    //Add to the report on first use
+    if (!sect->registered) {
+        sect->registered = true;
+        sect->next = _sections;
+        _sections = sect;
+    }
+    _Profile_snap(snap);
+}
+
+// End a section
+//  - Adds the measurement since the matching Profile_begin to the section.
+//  - Normally called through PROFILE_END.
+void Profile_end(ProfileSection_t* sect, ProfileSnap_t* snap) {
+    if (!_initialised || !sect->registered) return;
+    _Profile_accumulate(sect, snap);
+}
+
+// Clear the statistics of all sections
+//  - Histograms in the report are also cleared. Counters belong to their
+//    drivers, so are not.
+void Profile_reset(void) {
+    for (ProfileSection_t* sect = _sections; sect; sect = sect->next) {
+        _Profile_clear(sect);
+    }
+    for (ProfileHistogram_t* hist = _histograms; hist; hist = hist->next) {
+        Profile_histogramClear(hist);
+    }
+}
+
+// Print a report of all sections with printf
+//  - Calls, total/average/min/max cycles, total time, and average of each event per call.
+//  - Followed by the value of each counter, and the non-empty bins of each histogram.
+void Profile_report(void) {
+    if (_initialised) _Profile_reportSections();
+    if (_counters) {
+        printf("%-24s %10s\n", "Counter", "Value");
+        for (ProfileCounter_t* counter = _counters; counter; counter = counter->next) {
+            printf("%-24s %10u\n", counter->name, *counter->value);
+        }
+    }
+    for (ProfileHistogram_t* hist = _histograms; hist; hist = hist->next) {
+        printf("Histogram %s (%u samples, max %u)\n", hist->name, hist->samples, hist->maxValue);
+        unsigned int last = hist->numBins - 1;
+        for (unsigned int bin = 0; bin <= last; bin++) {
+            unsigned int count = hist->bins[bin];
+            if (!count) continue;
+            unsigned int low = bin * hist->binWidth;
+            if (bin == last) {
+                printf("  %10u+        %10u\n", low, count);
+            } else {
+                printf("  %10u - %-10u %10u\n", low, low + hist->binWidth - 1, count);
+            }
+        }
+    }
+}
+
+// Get the list of sections
+//  - Sections are added to the list the first time they are run. Follow
+//    next for the rest of the list. Returns NULL if there are none.
+//  - Allows the statistics to be exported rather than printed.
+const ProfileSection_t* Profile_getSections(void) {
+    return _sections;
+}
+
+// Get the PMU events being counted for each section
+//  - Returns the number of events, with a pointer to them in *events.
+unsigned int Profile_getEvents(const ProfileEvent** events) {
+    if (events) *events = _events;
+    return _eventCount;
+}
+
+// Get the current timestamp from the 64-bit global timer
+uint64_t Profile_timestamp(void) {
+    return alt_globaltmr_get64();
+}
+
+// Get the global timer rate in Hz
+unsigned int Profile_timestampRate(void) {
+    return PROFILE_GLOBALTMR_FREQ / (alt_globaltmr_prescaler_get() + 1);
+}
+
+// Add a counter to the report
+//  - The counter must remain valid until removed.
+//  - Returns ERR_SKIPPED if already added.
+HpsErr_t Profile_addCounter(ProfileCounter_t* counter) {
+    if (!counter || !counter->value) return ERR_NULLPTR;
+    if (counter->registered) return ERR_SKIPPED;
+    counter->registered = true;
+    counter->next = _counters;
+    _counters = counter;
+    return ERR_SUCCESS;
+}
+
+// Remove a counter from the report
+//  - Returns ERR_SKIPPED if not added.
+HpsErr_t Profile_removeCounter(ProfileCounter_t* counter) {
+    if (!counter) return ERR_NULLPTR;
+    if (!counter->registered) return ERR_SKIPPED;
+    for (ProfileCounter_t** link = &_counters; *link; link = &(*link)->next) {
+        if (*link == counter) {
+            *link = counter->next;
+            break;
+        }
+    }
+    counter->registered = false;
+    return ERR_SUCCESS;
+}
+
+// Add a histogram to the report
+//  - The histogram and its bins must remain valid until removed.
+//  - Returns ERR_SKIPPED if already added.
+HpsErr_t Profile_addHistogram(ProfileHistogram_t* hist) {
+    if (!hist || !hist->bins) return ERR_NULLPTR;
+    if (!hist->numBins || !hist->binWidth) return ERR_TOOSMALL;
+    if (hist->registered) return ERR_SKIPPED;
+    hist->registered = true;
+    hist->next = _histograms;
+    _histograms = hist;
+    return ERR_SUCCESS;
+}
+
+// Remove a histogram from the report
+//  - Returns ERR_SKIPPED if not added.
+HpsErr_t Profile_removeHistogram(ProfileHistogram_t* hist) {
+    if (!hist) return ERR_NULLPTR;
+    if (!hist->registered) return ERR_SKIPPED;
+    for (ProfileHistogram_t** link = &_histograms; *link; link = &(*link)->next) {
+        if (*link == hist) {
+            *link = hist->next;
+            break;
+        }
+    }
+    hist->registered = false;
+    return ERR_SUCCESS;
+}
+
+// Clear the bins of a histogram
+void Profile_histogramClear(ProfileHistogram_t* hist) {
+    for (unsigned int bin = 0; bin < hist->numBins; bin++) {
+        hist->bins[bin] = 0;
+    }
+    hist->samples = 0;
+    hist->maxValue = 0;
+}
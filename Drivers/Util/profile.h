@@ -0,0 +1,254 @@
+/*
+ * Cycle Accurate Profiling
+ * ------------------------
+ *
+ * Measures the execution time of sections of code using the
+ * Cortex-A9 Performance Monitor Unit (PMU) cycle counter, and
+ * optionally PMU event counters (e.g. cache misses and branch
+ * mispredictions). Each section is also timestamped with the
+ * 64-bit ARM global timer, so that long sections can be timed
+ * in real time units.
+ *
+ * Sections are marked with a pair of macros, each named section
+ * accumulating statistics over all of the times it is run:
+ *
+ *    ProfileEvent events[] = {PROFILE_EVT_L1D_REFILL, PROFILE_EVT_BRANCH_MISPRED};
+ *    Profile_initialise(events, 2);
+ *    while (1) {
+ *        PROFILE_BEGIN(audio);
+ *        processAudio();
+ *        PROFILE_END(audio);
+ *        if (done) Profile_report();
+ *    }
+ *
+ * The measured time of an empty section is calibrated during
+ * initialisation and subtracted from each measurement.
+ *
+ * The PMU counts for the core it is read from, so sections should
+ * only be profiled from a single core. Sections are not reentrant;
+ * a section profiled in an ISR must not also be profiled in code
+ * which the ISR can interrupt. Any interrupts occurring during a
+ * section are included in its measurement.
+ *
+ * The cycle counter is 32-bit, so sections should be shorter than
+ * 2^32 cycles (~5s at 800MHz). The global timer measurement is
+ * not limited.
+ *
+ * Profiling can be compiled out without removing the markers by
+ * globally defining PROFILE_DISABLE.
+ *
+ * Counters and Histograms
+ * -----------------------
+ *
+ * Drivers can also publish event counts and histograms of values
+ * (e.g. buffer fill levels) to be printed in the report alongside
+ * the sections. The storage is owned by the caller, and must stay
+ * valid until removed:
+ *
+ *    static unsigned int bins[16];
+ *    static ProfileHistogram_t fill = PROFILE_HISTOGRAM_INIT("fill", bins, 16, 8);
+ *    Profile_addHistogram(&fill);
+ *    ...
+ *    Profile_histogramAdd(&fill, level);
+ *
+ * Profile_histogramAdd() is safe to call from an ISR, but each
+ * histogram should only be updated from one context. Counters and
+ * histograms do not need the PMU, so are reported even if profiling
+ * has not been initialised.
+ *
+ * Requires Util/hwlib/alt_globaltmr.c for the global timer.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add section and event accessors for exporting.
+ * 14/10/2026 | Add published counters and histograms.
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Number of PMU event counters recorded for each section.
+// Globally define to override (the Cortex-A9 has 6 counters).
+#ifndef PROFILE_EVENT_COUNT
+#define PROFILE_EVENT_COUNT 2
+#endif
+
+// Global timer input clock frequency (PERIPHCLK, 1/4 of the MPU clock)
+// in Hz. Globally define to override if the MPU clock is changed.
+#ifndef PROFILE_GLOBALTMR_FREQ
+#define PROFILE_GLOBALTMR_FREQ 200000000
+#endif
+
+// Cortex-A9 PMU events
+typedef enum {
+    PROFILE_EVT_L1I_REFILL      = 0x01, // Instruction cache miss
+    PROFILE_EVT_ITLB_REFILL     = 0x02, // Instruction micro-TLB miss
+    PROFILE_EVT_L1D_REFILL      = 0x03, // Data cache miss
+    PROFILE_EVT_L1D_ACCESS      = 0x04, // Data cache access
+    PROFILE_EVT_DTLB_REFILL     = 0x05, // Data micro-TLB miss
+    PROFILE_EVT_EXCEPTION       = 0x09, // Exception taken
+    PROFILE_EVT_BRANCH_MISPRED  = 0x10, // Branch mispredicted or not predicted
+    PROFILE_EVT_BRANCH_PRED     = 0x12, // Predictable branch executed
+    PROFILE_EVT_ICACHE_STALL    = 0x60, // Cycles stalled waiting for instruction cache
+    PROFILE_EVT_DCACHE_STALL    = 0x61, // Cycles stalled waiting for data cache
+    PROFILE_EVT_TLB_STALL       = 0x62, // Cycles stalled waiting for main TLB
+    PROFILE_EVT_L1D_EVICT       = 0x65, // Data cache line eviction
+    PROFILE_EVT_INSTRUCTIONS    = 0x68, // Instructions executed (out of rename stage)
+    PROFILE_EVT_NEON_INSTR      = 0x74  // NEON instructions executed
+} ProfileEvent;
+
+// Accumulated statistics for a section
+typedef struct _ProfileSection_t {
+    const char*               name;
+    struct _ProfileSection_t* next;        // Next in list of sections for report
+    bool                      registered;  // In list of sections
+    unsigned int              calls;
+    uint64_t                  cycles;      // Total cycles over all calls
+    uint32_t                  minCycles;
+    uint32_t                  maxCycles;
+    uint64_t                  ticks;       // Total global timer ticks over all calls
+    uint64_t                  events[PROFILE_EVENT_COUNT];
+} ProfileSection_t;
+
+// Counter values at the start of a section
+typedef struct {
+    uint64_t ticks;
+    uint32_t cycles;
+    uint32_t events[PROFILE_EVENT_COUNT];
+} ProfileSnap_t;
+
+#define PROFILE_SECTION_INIT(sectName) { .name = (sectName), .minCycles = UINT32_MAX }
+
+// Published counter
+//  - value is read when the report is printed.
+typedef struct _ProfileCounter_t {
+    const char*                  name;
+    struct _ProfileCounter_t*    next;        // Next in list of counters for report
+    bool                         registered;  // In list of counters
+    const volatile unsigned int* value;
+} ProfileCounter_t;
+
+#define PROFILE_COUNTER_INIT(cntName, cntValue) { .name = (cntName), .value = (cntValue) }
+
+// Published histogram
+//  - bins[i] counts values from i*binWidth to (i+1)*binWidth-1. The last
+//    bin also counts all values above its range.
+typedef struct _ProfileHistogram_t {
+    const char*                  name;
+    struct _ProfileHistogram_t*  next;        // Next in list of histograms for report
+    bool                         registered;  // In list of histograms
+    volatile unsigned int*       bins;
+    unsigned int                 numBins;
+    unsigned int                 binWidth;
+    volatile unsigned int        samples;     // Total values added
+    volatile unsigned int        maxValue;    // Largest value added
+} ProfileHistogram_t;
+
+#define PROFILE_HISTOGRAM_INIT(histName, histBins, histNumBins, histBinWidth) \
+    { .name = (histName), .bins = (histBins), .numBins = (histNumBins), .binWidth = (histBinWidth) }
+
+// Section markers
+//  - name must be a valid identifier, and each section may only be begun once in a scope.
+//  - PROFILE_END must be in the same scope as the PROFILE_BEGIN.
+#ifndef PROFILE_DISABLE
+#define PROFILE_BEGIN(name)                                                    \
+    static ProfileSection_t _profileSect_##name = PROFILE_SECTION_INIT(#name); \
+    ProfileSnap_t _profileSnap_##name;                                         \
+    Profile_begin(&_profileSect_##name, &_profileSnap_##name)
+#define PROFILE_END(name) Profile_end(&_profileSect_##name, &_profileSnap_##name)
+#else
+#define PROFILE_BEGIN(name) do {} while (0)
+#define PROFILE_END(name)   do {} while (0)
+#endif
+
+// Initialise profiling
+//  - Enables the PMU cycle counter, and the event counters for each of the
+//    count events (up to PROFILE_EVENT_COUNT). events may be NULL if count is 0.
+//  - Starts the global timer if not already running.
+//  - Can be called again to change the events, which resets all sections.
+//  - Returns ERR_NOSUPPORT if the PMU has fewer than count event counters.
+HpsErr_t Profile_initialise(const ProfileEvent* events, unsigned int count);
+
+// Check if profiling initialised
+bool Profile_isInitialised(void);
+
+// Start a section
+//  - Normally called through PROFILE_BEGIN.
+void Profile_begin(ProfileSection_t* sect, ProfileSnap_t* snap);
+
+// End a section
+//  - Adds the measurement since the matching Profile_begin to the section.
+//  - Normally called through PROFILE_END.
+void Profile_end(ProfileSection_t* sect, ProfileSnap_t* snap);
+
+// Clear the statistics of all sections
+//  - Histograms in the report are also cleared. Counters belong to their
+//    drivers, so are not.
+void Profile_reset(void);
+
+// Print a report of all sections with printf
+//  - Calls, total/average/min/max cycles, total time, and average of each event per call.
+//  - Followed by the value of each counter, and the non-empty bins of each histogram.
+void Profile_report(void);
+
+// Get the list of sections
+//  - Sections are added to the list the first time they are run. Follow
+//    next for the rest of the list. Returns NULL if there are none.
+//  - Allows the statistics to be exported rather than printed.
+const ProfileSection_t* Profile_getSections(void);
+
+// Get the PMU events being counted for each section
+//  - Returns the number of events, with a pointer to them in *events.
+unsigned int Profile_getEvents(const ProfileEvent** events);
+
+// Get the current timestamp from the 64-bit global timer
+uint64_t Profile_timestamp(void);
+
+// Get the global timer rate in Hz
+unsigned int Profile_timestampRate(void);
+
+// Add a counter to the report
+//  - The counter must remain valid until removed.
+//  - Returns ERR_SKIPPED if already added.
+HpsErr_t Profile_addCounter(ProfileCounter_t* counter);
+
+// Remove a counter from the report
+//  - Returns ERR_SKIPPED if not added.
+HpsErr_t Profile_removeCounter(ProfileCounter_t* counter);
+
+// Add a histogram to the report
+//  - The histogram and its bins must remain valid until removed.
+//  - Returns ERR_SKIPPED if already added.
+HpsErr_t Profile_addHistogram(ProfileHistogram_t* hist);
+
+// Remove a histogram from the report
+//  - Returns ERR_SKIPPED if not added.
+HpsErr_t Profile_removeHistogram(ProfileHistogram_t* hist);
+
+// Clear the bins of a histogram
+void Profile_histogramClear(ProfileHistogram_t* hist);
+
+// Add a value to a histogram
+//  - Can be used whether or not the histogram has been added to the report.
+static inline void Profile_histogramAdd(ProfileHistogram_t* hist, unsigned int value) {
+    unsigned int bin = value / hist->binWidth;
+    if (bin >= hist->numBins) bin = hist->numBins - 1;
+    hist->bins[bin]++;
+    hist->samples++;
+    if (value > hist->maxValue) hist->maxValue = value;
+}
+
+#endif /* PROFILE_H_ */
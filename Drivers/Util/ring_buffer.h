@@ -0,0 +1,243 @@
+/*
+ * Typed Lock-Free Ring Buffers
+ * ----------------------------
+ *
+ * Generates single producer, single consumer ring buffers
+ * specialised for an element type. Each buffer type is made
+ * with RING_BUFFER_DEF(), which defines a struct and a set of
+ * inline functions prefixed with the given name:
+ *
+ *    RING_BUFFER_DEF(SampleRing, int32_t)
+ *
+ *    static int32_t sampleStore[1024];
+ *    static SampleRing_t samples;
+ *    SampleRing_init(&samples, sampleStore, 1024);
+ *    // Producer (e.g. an ISR)
+ *    SampleRing_push(&samples, sample);
+ *    // Consumer (e.g. the main loop)
+ *    int32_t block[64];
+ *    unsigned int count = SampleRing_popBulk(&samples, block, 64);
+ *
+ * The length must be a power of two, so that indices are masked
+ * rather than divided. The head and tail are free-running counters,
+ * so all of the storage can be used.
+ *
+ * Concurrency
+ * -----------
+ *
+ * Only one context may push (the producer) and only one may pop
+ * (the consumer) for a given buffer, but these may be on different
+ * cores, or one may be an ISR. No locks or interrupt masking are
+ * needed. Elements are published with a release store of the head
+ * and freed with a release store of the tail, each paired with an
+ * acquire load on the other side, which on the Cortex-A9 places a
+ * DMB where one is needed.
+ *
+ * The head and tail are kept on separate cache lines, each with a
+ * copy of the other side's index. A side only reads the other's
+ * index (causing its line to move between cores) when its copy
+ * shows the buffer to be full or empty.
+ *
+ * Zero-Copy Regions
+ * -----------------
+ *
+ * Data can be written or read in place, e.g. by a DMA transfer or an
+ * FFT, using reserve/commit (producer) and peek/release (consumer).
+ * Each returns the largest contiguous region, which stops at the end
+ * of the storage, so may be shorter than the full free or used count:
+ *
+ *    int32_t* region;
+ *    unsigned int space = SampleRing_reserve(&samples, &region);
+ *    unsigned int written = readCodec(region, space);
+ *    SampleRing_commit(&samples, written);
+ *
+ * Functions
+ * ---------
+ *
+ * For RING_BUFFER_DEF(name, type), the following are defined:
+ *
+ *   HpsErr_t     name_init     (name_t* rb, type* storage, unsigned int length)
+ *   void         name_reset    (name_t* rb)                      - Empty. Neither side may be in use.
+ *   unsigned int name_count    (name_t* rb)                      - Elements used
+ *   unsigned int name_space    (name_t* rb)                      - Elements free
+ *   bool         name_push     (name_t* rb, type value)          - Producer. false if full.
+ *   unsigned int name_pushBulk (name_t* rb, const type* src, unsigned int n)
+ *   unsigned int name_reserve  (name_t* rb, type** region)       - Producer
+ *   void         name_commit   (name_t* rb, unsigned int n)      - Producer
+ *   bool         name_pop      (name_t* rb, type* value)         - Consumer. false if empty.
+ *   unsigned int name_popBulk  (name_t* rb, type* dest, unsigned int n)
+ *   unsigned int name_peek     (name_t* rb, type** region)       - Consumer
+ *   void         name_release  (name_t* rb, unsigned int n)      - Consumer
+ *
+ * The bulk functions transfer as many of the n elements as will fit
+ * or are available, and return the number transferred. commit and
+ * release must not be given more than the preceding reserve or peek
+ * returned.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef RING_BUFFER_H_
+#define RING_BUFFER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Util/macros.h"
+#include "Util/error.h"
+
+// Size of the cache lines the head and tail are separated by
+#ifndef RING_BUFFER_LINE_SIZE
+#define RING_BUFFER_LINE_SIZE 32
+#endif
+
+// Define a ring buffer type and its functions
+//  - name is the prefix for the type (name_t) and functions.
+//  - type is the element type.
+#define RING_BUFFER_DEF(name, type)                                                                 \
+typedef struct {                                                                                    \
+    /* Producer line */                                                                             \
+    unsigned int head ALIGNED(RING_BUFFER_LINE_SIZE); /* Next element to push */                    \
+    unsigned int tailCache;                            /* Producer's copy of tail */                \
+    /* Consumer line */                                                                             \
+    unsigned int tail ALIGNED(RING_BUFFER_LINE_SIZE); /* Next element to pop */                     \
+    unsigned int headCache;                            /* Consumer's copy of head */                \
+    /* Read only once initialised */                                                                \
+    type*        buf ALIGNED(RING_BUFFER_LINE_SIZE);                                                \
+    unsigned int mask;                                 /* Length - 1 */                             \
+} name##_t;                                                                                         \
+                                                                                                    \
+static inline HpsErr_t name##_init(name##_t* rb, type* storage, unsigned int length) {              \
+    if (!rb || !storage) return ERR_NULLPTR;                                                        \
+    if (length < 2) return ERR_TOOSMALL;                                                            \
+    if (length & (length - 1)) return ERR_NOSUPPORT;                                                \
+    rb->buf = storage;                                                                              \
+    rb->mask = length - 1;                                                                          \
+    rb->head = 0;                                                                                   \
+    rb->tailCache = 0;                                                                              \
+    rb->tail = 0;                                                                                   \
+    rb->headCache = 0;                                                                              \
+    __atomic_thread_fence(__ATOMIC_RELEASE);                                                        \
+    return ERR_SUCCESS;                                                                             \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_reset(name##_t* rb) {                                                     \
+    rb->head = 0;                                                                                   \
+    rb->tailCache = 0;                                                                              \
+    rb->tail = 0;                                                                                   \
+    rb->headCache = 0;                                                                              \
+    __atomic_thread_fence(__ATOMIC_RELEASE);                                                        \
+}                                                                                                   \
+                                                                                                    \
+static inline unsigned int name##_count(name##_t* rb) {                                             \
+    unsigned int tail = __atomic_load_n(&rb->tail, __ATOMIC_ACQUIRE);                               \
+    return __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE) - tail;                                     \
+}                                                                                                   \
+                                                                                                    \
+static inline unsigned int name##_space(name##_t* rb) {                                             \
+    return (rb->mask + 1) - name##_count(rb);                                                       \
+}                                                                                                   \
+                                                                                                    \
+/* Producer: free elements from head, re-reading tail only if the copy is not enough */             \
+static inline unsigned int name##_spaceFrom(name##_t* rb, unsigned int head, unsigned int want) {   \
+    unsigned int space = (rb->mask + 1) - (head - rb->tailCache);                                   \
+    if (space < want) {                                                                             \
+        rb->tailCache = __atomic_load_n(&rb->tail, __ATOMIC_ACQUIRE);                               \
+        space = (rb->mask + 1) - (head - rb->tailCache);                                            \
+    }                                                                                               \
+    return space;                                                                                   \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_push(name##_t* rb, type value) {                                          \
+    unsigned int head = __atomic_load_n(&rb->head, __ATOMIC_RELAXED);                               \
+    if (!name##_spaceFrom(rb, head, 1)) return false;                                               \
+    rb->buf[head & rb->mask] = value;                                                               \
+    __atomic_store_n(&rb->head, head + 1, __ATOMIC_RELEASE);                                        \
+    return true;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+static inline unsigned int name##_pushBulk(name##_t* rb, const type* src, unsigned int n) {         \
+    unsigned int head = __atomic_load_n(&rb->head, __ATOMIC_RELAXED);                               \
+    unsigned int space = name##_spaceFrom(rb, head, n);                                             \
+    if (n > space) n = space;                                                                       \
+    if (!n) return 0;                                                                               \
+    unsigned int idx = head & rb->mask;                                                             \
+    unsigned int first = (rb->mask + 1) - idx;                                                      \
+    if (first > n) first = n;                                                                       \
+    memcpy(&rb->buf[idx], src, first * sizeof(type));                                               \
+    memcpy(&rb->buf[0], src + first, (n - first) * sizeof(type));                                   \
+    __atomic_store_n(&rb->head, head + n, __ATOMIC_RELEASE);                                        \
+    return n;                                                                                       \
+}                                                                                                   \
+                                                                                                    \
+static inline unsigned int name##_reserve(name##_t* rb, type** region) {                            \
+    unsigned int head = __atomic_load_n(&rb->head, __ATOMIC_RELAXED);                               \
+    unsigned int idx = head & rb->mask;                                                             \
+    unsigned int contig = (rb->mask + 1) - idx;                                                     \
+    unsigned int space = name##_spaceFrom(rb, head, contig);                                        \
+    *region = &rb->buf[idx];                                                                        \
+    return (space < contig) ? space : contig;                                                       \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_commit(name##_t* rb, unsigned int n) {                                    \
+    unsigned int head = __atomic_load_n(&rb->head, __ATOMIC_RELAXED);                               \
+    __atomic_store_n(&rb->head, head + n, __ATOMIC_RELEASE);                                        \
+}                                                                                                   \
+                                                                                                    \
+/* Consumer: used elements from tail, re-reading head only if the copy is not enough */             \
+static inline unsigned int name##_usedFrom(name##_t* rb, unsigned int tail, unsigned int want) {    \
+    unsigned int used = rb->headCache - tail;                                                       \
+    if (used < want) {                                                                              \
+        rb->headCache = __atomic_load_n(&rb->head, __ATOMIC_ACQUIRE);                               \
+        used = rb->headCache - tail;                                                                \
+    }                                                                                               \
+    return used;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+static inline bool name##_pop(name##_t* rb, type* value) {                                          \
+    unsigned int tail = __atomic_load_n(&rb->tail, __ATOMIC_RELAXED);                               \
+    if (!name##_usedFrom(rb, tail, 1)) return false;                                                \
+    *value = rb->buf[tail & rb->mask];                                                              \
+    __atomic_store_n(&rb->tail, tail + 1, __ATOMIC_RELEASE);                                        \
+    return true;                                                                                    \
+}                                                                                                   \
+                                                                                                    \
+static inline unsigned int name##_popBulk(name##_t* rb, type* dest, unsigned int n) {               \
+    unsigned int tail = __atomic_load_n(&rb->tail, __ATOMIC_RELAXED);                               \
+    unsigned int used = name##_usedFrom(rb, tail, n);                                               \
+    if (n > used) n = used;                                                                         \
+    if (!n) return 0;                                                                               \
+    unsigned int idx = tail & rb->mask;                                                             \
+    unsigned int first = (rb->mask + 1) - idx;                                                      \
+    if (first > n) first = n;                                                                       \
+    memcpy(dest, &rb->buf[idx], first * sizeof(type));                                              \
+    memcpy(dest + first, &rb->buf[0], (n - first) * sizeof(type));                                  \
+    __atomic_store_n(&rb->tail, tail + n, __ATOMIC_RELEASE);                                        \
+    return n;                                                                                       \
+}                                                                                                   \
+                                                                                                    \
+static inline unsigned int name##_peek(name##_t* rb, type** region) {                               \
+    unsigned int tail = __atomic_load_n(&rb->tail, __ATOMIC_RELAXED);                               \
+    unsigned int idx = tail & rb->mask;                                                             \
+    unsigned int contig = (rb->mask + 1) - idx;                                                     \
+    unsigned int used = name##_usedFrom(rb, tail, contig);                                          \
+    *region = &rb->buf[idx];                                                                        \
+    return (used < contig) ? used : contig;                                                         \
+}                                                                                                   \
+                                                                                                    \
+static inline void name##_release(name##_t* rb, unsigned int n) {                                   \
+    unsigned int tail = __atomic_load_n(&rb->tail, __ATOMIC_RELAXED);                               \
+    __atomic_store_n(&rb->tail, tail + n, __ATOMIC_RELEASE);                                        \
+}
+
+#endif /* RING_BUFFER_H_ */
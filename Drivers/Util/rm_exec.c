@@ -0,0 +1,318 @@
+/*
+ * Rate-Monotonic Periodic Executive
+ * ---------------------------------
+ *
+ * Runs periodic tasks with fixed, rate-monotonic priorities, so that
+ * a short period control loop pre-empts slower work and keeps its
+ * period regardless of what the main loop is doing.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "rm_exec.h"
+
+#include <string.h>
+
+#include "Util/irq.h"
+#include "Util/bit_helpers.h"
+#include "Util/timestamp.h"
+#include "Util/lowlevel_arm.h"
+
+/*
+ * Internal Functions
+ */
+
+#if defined(__arm__)
+
+// Record a task run in its metrics
+static void _RMExec_record(RMTask_t* task, uint64_t start, uint64_t end) {
+    EventStats_t* stats = &task->stats;
+    unsigned int late = (unsigned int)min(start - task->release, (uint64_t)UINT32_MAX);
+    unsigned int exec = (unsigned int)min(end - start, (uint64_t)UINT32_MAX);
+    stats->runs++;
+    if (late > stats->lateMax) stats->lateMax = late;
+    stats->lateTotal += late;
+    if (exec > stats->execMax) stats->execMax = exec;
+    stats->execTotal += exec;
+}
+
+// Task software interrupt handler
+//  - Runs preemptible, so may be interrupted by the tick or shorter period tasks.
+static void __irq _RMExec_taskIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    RMTask_t* task = (RMTask_t*)param;
+    if (!task) return;
+    uint64_t start = time_now_cycles();
+    task->func(task->param);
+    _RMExec_record(task, start, time_now_cycles());
+    task->pending = false;
+    *handled = true;
+}
+
+// Tick interrupt handler
+//  - Releases each task which has reached the end of its period.
+static void __irq _RMExec_tickIsr(HPSIRQSource interruptID, void* param, bool* handled) {
+    RMExecCtx_t* ctx = (RMExecCtx_t*)param;
+    if (!ctx) return;
+    Timer_checkOverflow(ctx->tick, true);
+    ctx->ticks++;
+    uint64_t now = time_now_cycles();
+    for (unsigned int idx = 0; idx < ctx->taskCount; idx++) {
+        RMTask_t* task = &ctx->tasks[idx];
+        if (--task->countdown) continue;
+        task->countdown = task->period;
+        if (task->pending) {
+            // Previous release hasn't finished, so skip this one
+            task->stats.missed++;
+            continue;
+        }
+        task->pending = true;
+        task->release = now;
+        HPS_IRQ_sendSoftware((HPSIRQSource)task->sgi, _BV(ctx->cpu));
+    }
+    *handled = true;
+}
+
+#endif
+
+// Unregister the interrupts of a started executive
+static void _RMExec_release(RMExecCtx_t* ctx) {
+#if defined(__arm__)
+    HPS_IRQ_unregisterHandler((HPSIRQSource)ctx->tickIrq);
+    for (unsigned int idx = 0; idx < ctx->taskCount; idx++) {
+        HPS_IRQ_unregisterHandler((HPSIRQSource)ctx->tasks[idx].sgi);
+    }
+#else
+    (void)ctx;
+#endif
+}
+
+static void _RMExec_cleanup(RMExecCtx_t* ctx) {
+    if (!ctx->running) return;
+    Timer_disable(ctx->tick);
+    _RMExec_release(ctx);
+    ctx->running = false;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise the periodic executive
+//  - tick is a timer to be used in free-running mode for the tick. It is
+//    reconfigured, so must not be used by anything else.
+//  - prescaler is the value to configure the tick timer with.
+//  - irqID is the interrupt ID of the tick timer. A handler will be registered
+//    when started.
+//  - tickPeriod is the number of timer cycles per tick.
+//  - Must be called from the core which is to run the tasks.
+//  - Returns ERR_NOSUPPORT if not running on the HPS.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t RMExec_initialise(TimerCtx_t* tick, unsigned int prescaler, unsigned int irqID, unsigned int tickPeriod, RMExecCtx_t** pCtx) {
+#if defined(__arm__)
+    if (!Timer_isInitialised(tick)) return ERR_BADDEVICE;
+    if (!tickPeriod) return ERR_TOOSMALL;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_RMExec_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Populate the context. No tasks yet.
+    RMExecCtx_t* ctx = *pCtx;
+    ctx->tick = tick;
+    ctx->prescaler = prescaler;
+    ctx->tickIrq = irqID;
+    ctx->tickPeriod = tickPeriod;
+    ctx->cpu = __GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID;
+    ctx->running = false;
+    ctx->taskCount = 0;
+    //Initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+#else
+    (void)tick;
+    (void)prescaler;
+    (void)irqID;
+    (void)tickPeriod;
+    (void)pCtx;
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool RMExec_isInitialised(RMExecCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Add a periodic task
+//  - period is the number of ticks between releases. Must be >0.
+//  - Tasks must be added before the executive is started.
+//  - Returns pointer to the task to *pTask (optional, may be NULL).
+//  - Returns ERR_NOSPACE if RMEXEC_MAX_TASKS tasks already exist.
+//  - Returns ERR_INUSE if the executive is running.
+HpsErr_t RMExec_addTask(RMExecCtx_t* ctx, RMTaskFunc_t func, void* param, unsigned int period, RMTask_t** pTask) {
+    if (!func) return ERR_NULLPTR;
+    if (!period) return ERR_TOOSMALL;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->running) return ERR_INUSE;
+    if (ctx->taskCount >= RMEXEC_MAX_TASKS) return ERR_NOSPACE;
+    RMTask_t* task = &ctx->tasks[ctx->taskCount];
+    memset(task, 0, sizeof(*task));
+    task->func = func;
+    task->param = param;
+    task->period = period;
+    task->order = ctx->taskCount++;
+    if (pTask) *pTask = task;
+    return ERR_SUCCESS;
+}
+
+// Start the executive
+//  - Assigns rate-monotonic priorities, registers the tick and task
+//    interrupts, and starts the tick timer.
+//  - Every task is first released on the first tick.
+HpsErr_t RMExec_start(RMExecCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->running) return ERR_INUSE;
+    if (!ctx->taskCount) return ERR_NOTFOUND;
+#if defined(__arm__)
+    //Rate-monotonic rank of each task is the number of tasks with a shorter
+    //period, or the same period but added earlier.
+    for (unsigned int idx = 0; idx < ctx->taskCount; idx++) {
+        RMTask_t* task = &ctx->tasks[idx];
+        unsigned int rank = 0;
+        for (unsigned int other = 0; other < ctx->taskCount; other++) {
+            RMTask_t* cmp = &ctx->tasks[other];
+            if ((cmp->period < task->period) || ((cmp->period == task->period) && (cmp->order < task->order))) rank++;
+        }
+        task->sgi = RMEXEC_SGI_FIRST + rank;
+        task->countdown = 1;
+        task->pending = false;
+    }
+    //Stop the tick while setting up
+    status = Timer_configure(ctx->tick, TIMER_MODE_FREERUN, ctx->prescaler, ctx->tickPeriod);
+    if (ERR_IS_ERROR(status)) return status;
+    Timer_checkOverflow(ctx->tick, true);
+    //Register each task on its SGI, at its rank's priority, preemptible
+    for (unsigned int idx = 0; idx < ctx->taskCount; idx++) {
+        RMTask_t* task = &ctx->tasks[idx];
+        unsigned int priority = RMEXEC_TASK_PRIORITY + (task->sgi - RMEXEC_SGI_FIRST) * HPS_IRQ_PRIORITY_STEP;
+        status = HPS_IRQ_registerHandler((HPSIRQSource)task->sgi, &_RMExec_taskIsr, task);
+        if (ERR_IS_SUCCESS(status)) status = HPS_IRQ_setPriority((HPSIRQSource)task->sgi, priority, true);
+        if (ERR_IS_ERROR(status)) {
+            _RMExec_release(ctx);
+            return status;
+        }
+    }
+    //Then the tick, above all tasks
+    status = HPS_IRQ_registerHandler((HPSIRQSource)ctx->tickIrq, &_RMExec_tickIsr, ctx);
+    if (ERR_IS_SUCCESS(status)) status = HPS_IRQ_setPriority((HPSIRQSource)ctx->tickIrq, RMEXEC_TICK_PRIORITY, false);
+    if (ERR_IS_ERROR(status)) {
+        _RMExec_release(ctx);
+        return status;
+    }
+    //Start the load window and the tick
+    ctx->ticks = 0;
+    ctx->loadStart = time_now_cycles();
+    ctx->loadIdle = ctx->idleCycles;
+    ctx->running = true;
+    status = Timer_enable(ctx->tick, 0);
+    if (ERR_IS_ERROR(status)) _RMExec_cleanup(ctx);
+    return status;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Stop the executive
+//  - Stops the tick timer and unregisters the interrupts. Any task which
+//    is running will finish first if called from lower priority code.
+HpsErr_t RMExec_stop(RMExecCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    _RMExec_cleanup(ctx);
+    return ERR_SUCCESS;
+}
+
+// Idle until the next interrupt
+//  - Call from the main loop whenever there is nothing else to do. The
+//    time spent asleep is counted as idle for RMExec_getLoad().
+HpsErr_t RMExec_idle(RMExecCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+#if defined(__arm__)
+    //Sleep with IRQs masked. WFI still wakes on an interrupt, but its handler
+    //(and any task it releases) only runs once unmasked, after the idle time
+    //has been added.
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    uint64_t start = time_now_cycles();
+    __WFI();
+    ctx->idleCycles += time_now_cycles() - start;
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Get the CPU load
+//  - Returns via *percent the percentage of time not spent in RMExec_idle()
+//    since the previous call (or start), then begins a new window.
+HpsErr_t RMExec_getLoad(RMExecCtx_t* ctx, unsigned int* percent) {
+    if (!percent) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Snapshot both counters together. idleCycles is only updated from thread
+    //context, but masking keeps the window consistent if called from a task.
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    uint64_t now = time_now_cycles();
+    uint64_t idle = ctx->idleCycles;
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    uint64_t elapsed = now - ctx->loadStart;
+    idle -= ctx->loadIdle;
+    *percent = elapsed ? (unsigned int)(((elapsed - min(idle, elapsed)) * 100) / elapsed) : 0;
+    ctx->loadStart = now;
+    ctx->loadIdle = ctx->idleCycles;
+    return ERR_SUCCESS;
+}
+
+// Get the metrics of a task
+//  - Copies the metrics since start or the last RMExec_clearStats().
+HpsErr_t RMExec_getStats(RMExecCtx_t* ctx, RMTask_t* task, EventStats_t* stats) {
+    if (!stats) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((task < ctx->tasks) || (task >= &ctx->tasks[ctx->taskCount])) return ERR_NOTFOUND;
+    //Copy with IRQs masked so the counts and times match
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    *stats = task->stats;
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
+
+// Clear the metrics of all tasks
+HpsErr_t RMExec_clearStats(RMExecCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqStatus = IRQ_globalEnable(false);
+    for (unsigned int idx = 0; idx < ctx->taskCount; idx++) {
+        memset(&ctx->tasks[idx].stats, 0, sizeof(ctx->tasks[idx].stats));
+    }
+    IRQ_globalEnable(ERR_IS_SUCCESS(irqStatus));
+    return ERR_SUCCESS;
+}
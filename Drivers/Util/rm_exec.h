@@ -0,0 +1,190 @@
+/*
+ * Rate-Monotonic Periodic Executive
+ * ---------------------------------
+ *
+ * Runs periodic tasks with fixed, rate-monotonic priorities, so that
+ * a short period control loop pre-empts slower work and keeps its
+ * period regardless of what the main loop is doing.
+ *
+ *    RMExec_initialise(&timer0->timer, 0, IRQ_MPCORE_PRIVATE_TIMER, rate / 1000, &rmExec);
+ *    RMExec_addTask(rmExec, &controlLoop, motor, 1,   NULL);  // 1kHz
+ *    RMExec_addTask(rmExec, &updateUi,    ui,    50,  NULL);  // 20Hz
+ *    RMExec_start(rmExec);
+ *    while (1) {
+ *        Event_process(evtMgr);   // Background work
+ *        RMExec_idle(rmExec);
+ *    }
+ *
+ * Operation
+ * ---------
+ *
+ * A timer (e.g. the private timer) runs in free-running mode at the
+ * tick rate. Each task has a period in ticks, and is released by the
+ * tick interrupt by raising a software generated interrupt (SGI) on
+ * the calling core. The task function is the handler for that SGI.
+ *
+ * RMExec_start() sorts the tasks by period, shortest first, and gives
+ * each a GIC priority in that order with its handler marked
+ * preemptible (see HPS_IRQ). A task therefore pre-empts any running
+ * task with a longer period, and the GIC runs released tasks highest
+ * priority first. The tick interrupt is above all tasks and is not
+ * preemptible. Tasks released together with the same period run in
+ * the order they were added.
+ *
+ * Tasks run in SVC mode on the IRQ stacks, so must follow the rules
+ * for preemptible handlers: no SVC calls (including semihosting), and
+ * IRQ_STACK_SIZE large enough for every task nesting at once.
+ *
+ * If a task is still running, or waiting to run, when it is next
+ * released, that release is skipped and counted as a missed period.
+ *
+ * Metrics
+ * -------
+ *
+ * Each task keeps EventStats_t metrics (see Util/event.h), measured
+ * with the global timer (see Util/timestamp.h), which must be running:
+ *
+ *  - lateMax/lateTotal are the delay from release to the task starting.
+ *  - execMax/execTotal are the time from start to finish, including
+ *    any time spent pre-empted by higher priority tasks.
+ *  - missed counts skipped releases.
+ *
+ * RMExec_idle() sleeps the processor (WFI) until the next interrupt,
+ * timing how long it slept with IRQs masked so that task time is not
+ * included. RMExec_getLoad() converts the time not spent idle into a
+ * CPU load percentage. Load is only accurate if the main loop calls
+ * RMExec_idle() whenever it has nothing to do.
+ *
+ * Supported on the Cyclone V/Arria 10 HPS (HPS_IRQ) only.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef RM_EXEC_H_
+#define RM_EXEC_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_timer.h"
+#include "Util/event.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Software generated interrupts used for tasks
+//  - Task n uses SGI RMEXEC_SGI_FIRST + n in priority order.
+#ifndef RMEXEC_SGI_FIRST
+#define RMEXEC_SGI_FIRST    8
+#endif
+#define RMEXEC_MAX_TASKS    (16 - RMEXEC_SGI_FIRST)
+
+// GIC priorities used
+//  - Tasks take consecutive levels from RMEXEC_TASK_PRIORITY downwards.
+#ifndef RMEXEC_TICK_PRIORITY
+#define RMEXEC_TICK_PRIORITY 0x20
+#endif
+#ifndef RMEXEC_TASK_PRIORITY
+#define RMEXEC_TASK_PRIORITY 0x40
+#endif
+
+// Periodic task function
+//  - Called once per period from the task's software interrupt.
+typedef void (*RMTaskFunc_t)(void* param);
+
+// Periodic task
+typedef struct {
+    RMTaskFunc_t    func;
+    void*           param;
+    unsigned int    period;     // Period in ticks
+    unsigned int    countdown;  // Ticks until next release
+    unsigned int    order;      // Order added, for equal periods
+    unsigned int    sgi;        // Software interrupt, once started
+    volatile bool   pending;    // Released and not yet finished
+    uint64_t        release;    // Global timer at last release
+    EventStats_t    stats;
+} RMTask_t;
+
+// Executive Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    TimerCtx_t*   tick;         // Tick timer
+    unsigned int  prescaler;
+    unsigned int  tickPeriod;   // Timer cycles per tick
+    unsigned int  tickIrq;
+    unsigned int  cpu;          // Core running the executive
+    bool          running;
+    RMTask_t      tasks[RMEXEC_MAX_TASKS];
+    unsigned int  taskCount;
+    volatile unsigned int ticks;  // Ticks since start
+    // Load metering
+    uint64_t      idleCycles;   // Total time spent idle
+    uint64_t      loadStart;    // Global timer at start of load window
+    uint64_t      loadIdle;     // idleCycles at start of load window
+} RMExecCtx_t;
+
+// Initialise the periodic executive
+//  - tick is a timer to be used in free-running mode for the tick. It is
+//    reconfigured, so must not be used by anything else.
+//  - prescaler is the value to configure the tick timer with.
+//  - irqID is the interrupt ID of the tick timer. A handler will be registered
+//    when started.
+//  - tickPeriod is the number of timer cycles per tick.
+//  - Must be called from the core which is to run the tasks.
+//  - Returns ERR_NOSUPPORT if not running on the HPS.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t RMExec_initialise(TimerCtx_t* tick, unsigned int prescaler, unsigned int irqID, unsigned int tickPeriod, RMExecCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool RMExec_isInitialised(RMExecCtx_t* ctx);
+
+// Add a periodic task
+//  - period is the number of ticks between releases. Must be >0.
+//  - Tasks must be added before the executive is started.
+//  - Returns pointer to the task to *pTask (optional, may be NULL).
+//  - Returns ERR_NOSPACE if RMEXEC_MAX_TASKS tasks already exist.
+//  - Returns ERR_INUSE if the executive is running.
+HpsErr_t RMExec_addTask(RMExecCtx_t* ctx, RMTaskFunc_t func, void* param, unsigned int period, RMTask_t** pTask);
+
+// Start the executive
+//  - Assigns rate-monotonic priorities, registers the tick and task
+//    interrupts, and starts the tick timer.
+//  - Every task is first released on the first tick.
+HpsErr_t RMExec_start(RMExecCtx_t* ctx);
+
+// Stop the executive
+//  - Stops the tick timer and unregisters the interrupts. Any task which
+//    is running will finish first if called from lower priority code.
+HpsErr_t RMExec_stop(RMExecCtx_t* ctx);
+
+// Idle until the next interrupt
+//  - Call from the main loop whenever there is nothing else to do. The
+//    time spent asleep is counted as idle for RMExec_getLoad().
+HpsErr_t RMExec_idle(RMExecCtx_t* ctx);
+
+// Get the CPU load
+//  - Returns via *percent the percentage of time not spent in RMExec_idle()
+//    since the previous call (or start), then begins a new window.
+HpsErr_t RMExec_getLoad(RMExecCtx_t* ctx, unsigned int* percent);
+
+// Get the metrics of a task
+//  - Copies the metrics since start or the last RMExec_clearStats().
+HpsErr_t RMExec_getStats(RMExecCtx_t* ctx, RMTask_t* task, EventStats_t* stats);
+
+// Clear the metrics of all tasks
+HpsErr_t RMExec_clearStats(RMExecCtx_t* ctx);
+
+#endif /* RM_EXEC_H_ */
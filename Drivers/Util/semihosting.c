@@ -26,6 +26,8 @@
  *
  * Date       | Changes
  * -----------+------------------------------------
+ * 14/10/2026 | Add bulk host file I/O and a streaming reader.
+ * 14/10/2026 | Add buffered stdout (SEMIHOST_BUFFERED_STDOUT).
  * 31/03/2024 | Creation of file
  *
  */
@@ -64,6 +66,25 @@ bool checkIfSemihostingConnected(void) {
 }
 
 
+// Semihosting call parameters
+typedef struct {
+    unsigned int handle;
+    const char* str;
+    unsigned int len;
+} WriteParams_t;
+
+typedef struct {
+    const char* str;
+    unsigned int mode;
+    unsigned int len;
+} OpenParams_t;
+
+typedef struct {
+    unsigned int handle;
+    char* str;
+    unsigned int len;
+} ReadParams_t;
+
 // Default write handler
 // - assumes everything was written.
 HpsErr_t semihostWriteStr(const char* str, unsigned int len, bool block) __attribute__((weak));
@@ -94,6 +115,7 @@ void semihostExit() {
 __asm(".global __use_no_semihosting\n\t");
 
 void _sys_exit(int status) {
+    semihostFlush();
     IRQ_globalEnable(false);
     while (1);
 }
@@ -106,24 +128,6 @@ void _ttywrch(int ch){
 // Failback Semihosting Handler Routines
 #include <errno.h>
 
-typedef struct {
-    unsigned int handle;
-    char* str;
-    unsigned int len;
-} ReadParams_t;
-
-typedef struct {
-    unsigned int handle;
-    const char* str;
-    unsigned int len;
-} WriteParams_t;
-
-typedef struct {
-    const char* str;
-    unsigned int mode;
-    unsigned int len;
-} OpenParams_t;
-
 enum {
     HANDLE_INVALID = -1,
     HANDLE_STDIN,
@@ -295,6 +299,7 @@ signed int __svc_semihost(unsigned int id, unsigned int* val) {
             status = INT32_MAX; // Can write as much as you like to UART.
             break;
         case SEMIHOST_OP_SYS_EXIT:
+            semihostFlush();
             semihostExit();
             status = SEMIHOST_SUCCESS;
             break;
@@ -313,3 +318,339 @@ signed int __svc_semihost(unsigned int id, unsigned int* val) {
 
 #endif
 
+/*
+ * Debugger Calls
+ */
+
+#if !defined(SEMIHOST_DISABLED)
+// Make a semihosting call to the debugger
+static signed int _semihost_call(SemihostOpIDs op, void* arg) {
+    register unsigned int r0 __asm("r0") = op;
+    register void* r1 __asm("r1") = arg;
+    __asm volatile (
+        "SVC  %[svcId]     ;"
+        : "+r" (r0)
+#ifdef __thumb__
+        : [svcId] "i" (SVC_ID_SEMIHOST_THUMB),
+#else
+        : [svcId] "i" (SVC_ID_SEMIHOST_ARM),
+#endif
+          "r" (r1)
+        : "memory"
+    );
+    return (signed int)r0;
+}
+#endif
+
+/*
+ * Buffered Stdout
+ */
+
+#if defined(SEMIHOST_BUFFERED_STDOUT)
+
+#include <stdio.h>
+
+// Stdout handle states
+enum {
+    STDOUT_HANDLE_UNKNOWN  = -2,  // Not yet checked for debugger
+    STDOUT_HANDLE_FAILBACK = -1   // No debugger, use semihostWriteStr()
+};
+
+static char _stdoutBuf[SEMIHOST_STDOUT_BUFFER];
+static unsigned int _stdoutLen = 0;
+static unsigned int _stdoutLines = 0;
+static unsigned int _flushLines = SEMIHOST_STDOUT_FLUSH_LINES;
+static signed int _stdoutHandle = STDOUT_HANDLE_UNKNOWN;
+
+// Write to the console
+// - The first write checks for a debugger, and if found opens the console
+//   for our writes. Otherwise writes go straight to the user handler.
+static void _semihost_stdoutWrite(const char* str, unsigned int len) {
+#if !defined(SEMIHOST_DISABLED)
+    if (_stdoutHandle == STDOUT_HANDLE_UNKNOWN) {
+        _stdoutHandle = STDOUT_HANDLE_FAILBACK;
+        if (checkIfSemihostingConnected()) {
+            OpenParams_t popen = { ":tt", 4, 3 };
+            signed int handle = _semihost_call(SEMIHOST_OP_SYS_OPEN, &popen);
+            if (handle >= 0) _stdoutHandle = handle;
+        }
+    }
+    if (_stdoutHandle >= 0) {
+        WriteParams_t pwrite = { (unsigned int)_stdoutHandle, str, len };
+        _semihost_call(SEMIHOST_OP_SYS_WRITE, &pwrite);
+        return;
+    }
+#endif
+    semihostWriteStr(str, len, true);
+}
+
+// Flush buffered stdout
+// - Sends anything buffered in a single write.
+HpsErr_t semihostFlush(void) {
+    if (_stdoutLen) _semihost_stdoutWrite(_stdoutBuf, _stdoutLen);
+    _stdoutLen = 0;
+    _stdoutLines = 0;
+    return ERR_SUCCESS;
+}
+
+// Set the number of lines after which buffered stdout is flushed
+// - 0 only flushes when the buffer is full or semihostFlush() is called.
+HpsErr_t semihostSetFlushLines(unsigned int lines) {
+    _flushLines = lines;
+    if (_flushLines && (_stdoutLines >= _flushLines)) semihostFlush();
+    return ERR_SUCCESS;
+}
+
+// Retargeted character output
+// - stdout is buffered. Anything else is written through, after stdout.
+int fputc(int ch, FILE* f) {
+    char c = (char)ch;
+    if (f != stdout) {
+        semihostFlush();
+        _semihost_stdoutWrite(&c, 1);
+        return (unsigned char)c;
+    }
+    _stdoutBuf[_stdoutLen++] = c;
+    if (c == '\n') _stdoutLines++;
+    if ((_stdoutLen >= SEMIHOST_STDOUT_BUFFER) || (_flushLines && (_stdoutLines >= _flushLines))) {
+        semihostFlush();
+    }
+    return (unsigned char)c;
+}
+
+#else
+
+// Flush buffered stdout
+// - Buffering not compiled in.
+HpsErr_t semihostFlush(void) {
+    return ERR_NOSUPPORT;
+}
+
+// Set the number of lines after which buffered stdout is flushed
+// - Buffering not compiled in.
+HpsErr_t semihostSetFlushLines(unsigned int lines) {
+    return ERR_NOSUPPORT;
+}
+
+#endif
+
+/*
+ * Host File I/O
+ */
+
+#if !defined(SEMIHOST_DISABLED)
+
+#include "Util/bit_helpers.h"
+#include "Util/watchdog.h"
+#include "Util/hwlib/alt_cache.h"
+
+typedef struct {
+    unsigned int handle;
+    unsigned int pos;
+} SeekParams_t;
+
+// Purge or clean a buffer, aligning out to whole cache lines
+// - The debugger may access memory through the debug port rather than the
+//   core, so the buffer must not be held in the caches during the call.
+static void _semihost_cacheRange(const void* buf, unsigned int len, bool purge) {
+    if (!len || !alt_cache_l1_data_is_enabled()) return;
+    uintptr_t end = (uintptr_t)alignPointer((void*)((uintptr_t)buf + len), ALT_CACHE_LINE_SIZE, true);
+    uintptr_t start = (uintptr_t)alignPointer((void*)buf, ALT_CACHE_LINE_SIZE, false);
+    if (purge) {
+        alt_cache_system_purge((void*)start, end - start);
+    } else {
+        alt_cache_system_clean((void*)start, end - start);
+    }
+}
+
+// Open a file on the host
+// - Returns the file handle, which is 0 or greater.
+// - Returns ERR_NOCONNECT if no debugger is connected.
+// - Returns ERR_NOTFOUND if the host couldn't open the file.
+HpsErr_t semihostFileOpen(const char* path, SemihostFileMode mode) {
+    if (!path) return ERR_NULLPTR;
+    //Without a debugger the call would go to the failback handler
+    if (!checkIfSemihostingConnected()) return ERR_NOCONNECT;
+    OpenParams_t popen = { path, (unsigned int)mode, strlen(path) };
+    signed int handle = _semihost_call(SEMIHOST_OP_SYS_OPEN, &popen);
+    if (handle < 0) return ERR_NOTFOUND;
+    return handle;
+}
+
+// Close a file on the host
+HpsErr_t semihostFileClose(signed int handle) {
+    if (handle < 0) return ERR_BADID;
+    unsigned int pclose = (unsigned int)handle;
+    if (_semihost_call(SEMIHOST_OP_SYS_CLOSE, &pclose) != SEMIHOST_SUCCESS) return ERR_IOFAIL;
+    return ERR_SUCCESS;
+}
+
+// Read from a file on the host
+// - Reads len bytes into buf, in calls of up to SEMIHOST_IO_BLOCK bytes.
+// - Returns the number of bytes read, which is less than len at the end of the file.
+HpsErr_t semihostFileRead(signed int handle, void* buf, unsigned int len) {
+    if (!buf) return ERR_NULLPTR;
+    if (handle < 0) return ERR_BADID;
+    if (len > INT32_MAX) return ERR_TOOBIG;
+    _semihost_cacheRange(buf, len, true);
+    unsigned int done = 0;
+    while (done < len) {
+        unsigned int block = len - done;
+        if (block > SEMIHOST_IO_BLOCK) block = SEMIHOST_IO_BLOCK;
+        ReadParams_t pread = { (unsigned int)handle, (char*)buf + done, block };
+        //Returns the number of bytes not read
+        signed int left = _semihost_call(SEMIHOST_OP_SYS_READ, &pread);
+        if ((left < 0) || ((unsigned int)left > block)) return ERR_IOFAIL;
+        done += block - left;
+        ResetWDT();
+        if (left) break;
+    }
+    return (HpsErr_t)done;
+}
+
+// Write to a file on the host
+// - Writes len bytes from buf, in calls of up to SEMIHOST_IO_BLOCK bytes.
+// - Returns the number of bytes written.
+HpsErr_t semihostFileWrite(signed int handle, const void* buf, unsigned int len) {
+    if (!buf) return ERR_NULLPTR;
+    if (handle < 0) return ERR_BADID;
+    if (len > INT32_MAX) return ERR_TOOBIG;
+    _semihost_cacheRange(buf, len, false);
+    unsigned int done = 0;
+    while (done < len) {
+        unsigned int block = len - done;
+        if (block > SEMIHOST_IO_BLOCK) block = SEMIHOST_IO_BLOCK;
+        WriteParams_t pwrite = { (unsigned int)handle, (const char*)buf + done, block };
+        //Returns the number of bytes not written
+        signed int left = _semihost_call(SEMIHOST_OP_SYS_WRITE, &pwrite);
+        if ((left < 0) || ((unsigned int)left > block)) return ERR_IOFAIL;
+        done += block - left;
+        ResetWDT();
+        if (left) break;
+    }
+    return (HpsErr_t)done;
+}
+
+// Move to a position in a file on the host
+// - pos is the byte offset from the start of the file.
+HpsErr_t semihostFileSeek(signed int handle, unsigned int pos) {
+    if (handle < 0) return ERR_BADID;
+    if (pos > INT32_MAX) return ERR_TOOBIG;
+    SeekParams_t pseek = { (unsigned int)handle, pos };
+    if (_semihost_call(SEMIHOST_OP_SYS_SEEK, &pseek) != SEMIHOST_SUCCESS) return ERR_IOFAIL;
+    return ERR_SUCCESS;
+}
+
+// Get the length of a file on the host
+// - Returns the length in bytes.
+HpsErr_t semihostFileLength(signed int handle) {
+    if (handle < 0) return ERR_BADID;
+    unsigned int pflen = (unsigned int)handle;
+    signed int len = _semihost_call(SEMIHOST_OP_SYS_FLEN, &pflen);
+    if (len < 0) return ERR_IOFAIL;
+    return len;
+}
+
+// Load a whole file from the host
+// - Reads the file into buf, which is size bytes.
+// - Returns the length of the file.
+// - Returns ERR_TOOBIG if the file is larger than size. Nothing is read.
+HpsErr_t semihostFileLoad(const char* path, void* buf, unsigned int size) {
+    if (!buf) return ERR_NULLPTR;
+    HpsErr_t handle = semihostFileOpen(path, SEMIHOST_MODE_READ);
+    if (ERR_IS_ERROR(handle)) return handle;
+    HpsErr_t status = semihostFileLength(handle);
+    if (ERR_IS_SUCCESS(status) && ((unsigned int)status > size)) status = ERR_TOOBIG;
+    if (ERR_IS_SUCCESS(status)) {
+        unsigned int len = (unsigned int)status;
+        status = semihostFileRead(handle, buf, len);
+        if (ERR_IS_SUCCESS(status) && ((unsigned int)status != len)) status = ERR_IOFAIL;
+    }
+    semihostFileClose(handle);
+    return status;
+}
+
+// Open a file on the host for streaming
+// - The file is read in blocks of size bytes into buf.
+HpsErr_t semihostStreamOpen(SemihostStream_t* stream, const char* path, void* buf, unsigned int size) {
+    if (!stream || !buf) return ERR_NULLPTR;
+    if (!size) return ERR_TOOSMALL;
+    HpsErr_t handle = semihostFileOpen(path, SEMIHOST_MODE_READ);
+    if (ERR_IS_ERROR(handle)) return handle;
+    stream->handle = handle;
+    stream->buf = (uint8_t*)buf;
+    stream->size = size;
+    stream->pos = 0;
+    stream->end = false;
+    return ERR_SUCCESS;
+}
+
+// Read the next block of a stream
+// - Returns a pointer to the block in *data, which is valid until the next call.
+// - Returns the number of bytes in the block, which is 0 at the end of the file.
+HpsErr_t semihostStreamNext(SemihostStream_t* stream, const void** data) {
+    if (!stream || !data) return ERR_NULLPTR;
+    if (stream->handle < 0) return ERR_NOTREADY;
+    *data = stream->buf;
+    if (stream->end) return 0;
+    HpsErr_t status = semihostFileRead(stream->handle, stream->buf, stream->size);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((unsigned int)status < stream->size) stream->end = true;
+    stream->pos += status;
+    return status;
+}
+
+// Close a stream
+HpsErr_t semihostStreamClose(SemihostStream_t* stream) {
+    if (!stream) return ERR_NULLPTR;
+    if (stream->handle < 0) return ERR_SUCCESS;
+    HpsErr_t status = semihostFileClose(stream->handle);
+    stream->handle = -1;
+    return status;
+}
+
+#else
+
+// Host file I/O
+// - Semihosting disabled.
+HpsErr_t semihostFileOpen(const char* path, SemihostFileMode mode) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostFileClose(signed int handle) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostFileRead(signed int handle, void* buf, unsigned int len) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostFileWrite(signed int handle, const void* buf, unsigned int len) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostFileSeek(signed int handle, unsigned int pos) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostFileLength(signed int handle) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostFileLoad(const char* path, void* buf, unsigned int size) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostStreamOpen(SemihostStream_t* stream, const char* path, void* buf, unsigned int size) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostStreamNext(SemihostStream_t* stream, const void** data) {
+    return ERR_NOSUPPORT;
+}
+
+HpsErr_t semihostStreamClose(SemihostStream_t* stream) {
+    return ERR_NOSUPPORT;
+}
+
+#endif
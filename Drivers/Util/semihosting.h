@@ -20,6 +20,55 @@
  * to see if a debugger is connected and semihosting
  * is enabled. This API is always available.
  * 
+ * Buffered Stdout
+ * ---------------
+ * 
+ * Each semihosting write traps to the debugger, stalling the
+ * core while it is serviced, and printf may write a line or
+ * even a character at a time. If SEMIHOST_BUFFERED_STDOUT is
+ * defined, fputc() is retargeted so that stdout is collected
+ * in a RAM buffer of SEMIHOST_STDOUT_BUFFER bytes, and sent in
+ * one write when the buffer fills or after a number of lines
+ * (see semihostSetFlushLines()). Call semihostFlush() from
+ * the idle loop so that output is not held for long, and before
+ * waiting for input after a prompt. stderr is never buffered,
+ * but flushes stdout first so the order is kept.
+ * 
+ * If no debugger is connected, the buffer is written with
+ * semihostWriteStr() directly rather than through the failback
+ * handler. stdout must only be written from one context.
+ * 
+ * Host File I/O
+ * -------------
+ * 
+ * Files on the host can be read and written through the debugger,
+ * e.g. to load test vectors for a regression run:
+ * 
+ *    len = semihostFileLoad("vectors/fir_in.bin", ddrBuf, ddrSize);
+ *    ...
+ *    semihostStreamOpen(&stream, "vectors/long.bin", blockBuf, 1 << 20);
+ *    while ((len = semihostStreamNext(&stream, &data)) > 0) {
+ *        runBlock(data, len);
+ *    }
+ *    semihostStreamClose(&stream);
+ * 
+ * Each semihosting call stops the core while the debugger services
+ * it, and that overhead is much the same for a few bytes as for a
+ * few megabytes. The C library fread() goes through a small stdio
+ * buffer, so makes a call every few hundred bytes. These APIs
+ * instead transfer straight to or from the caller's buffer in calls
+ * of up to SEMIHOST_IO_BLOCK bytes, so loading is limited only by
+ * the debug link. The watchdog is reset between calls.
+ * 
+ * The buffer is cleaned (write) or purged (read) from the caches
+ * first, as the debugger might access memory through the debug port
+ * rather than the core. Cache line aligned buffers avoid sharing a
+ * line with other data during the call.
+ * 
+ * The file APIs need a debugger, and return ERR_NOCONNECT when opening
+ * a file without one. They return ERR_NOSUPPORT if SEMIHOST_DISABLED
+ * is defined.
+ * 
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -27,6 +76,8 @@
  *
  * Date       | Changes
  * -----------+------------------------------------
+ * 14/10/2026 | Add bulk host file I/O and a streaming reader.
+ * 14/10/2026 | Add buffered stdout (SEMIHOST_BUFFERED_STDOUT).
  * 31/03/2024 | Creation of file
  *
  */
@@ -98,6 +149,94 @@ HpsErr_t semihostWriteStr(const char* str, unsigned int len, bool block);
 // - returns number of bytes not read.
 HpsErr_t semihostReadStr(char* str, unsigned int len, bool block);
 
+// Size of the stdout buffer (SEMIHOST_BUFFERED_STDOUT)
+#ifndef SEMIHOST_STDOUT_BUFFER
+#define SEMIHOST_STDOUT_BUFFER 1024
+#endif
+
+// Default number of lines after which stdout is flushed (SEMIHOST_BUFFERED_STDOUT)
+#ifndef SEMIHOST_STDOUT_FLUSH_LINES
+#define SEMIHOST_STDOUT_FLUSH_LINES 16
+#endif
+
+// Flush buffered stdout
+// - Sends anything buffered in a single write.
+// - returns ERR_NOSUPPORT if SEMIHOST_BUFFERED_STDOUT is not defined.
+HpsErr_t semihostFlush(void);
+
+// Set the number of lines after which buffered stdout is flushed
+// - 0 only flushes when the buffer is full or semihostFlush() is called.
+// - returns ERR_NOSUPPORT if SEMIHOST_BUFFERED_STDOUT is not defined.
+HpsErr_t semihostSetFlushLines(unsigned int lines);
+
+// Largest transfer in a single host file I/O call
+#ifndef SEMIHOST_IO_BLOCK
+#define SEMIHOST_IO_BLOCK (4 * 1024 * 1024)
+#endif
+
+// Host file open modes
+//  - All are binary, so no newline translation is done by the host.
+typedef enum {
+    SEMIHOST_MODE_READ   = 1,   // "rb"
+    SEMIHOST_MODE_UPDATE = 3,   // "r+b"
+    SEMIHOST_MODE_WRITE  = 5,   // "wb"
+    SEMIHOST_MODE_APPEND = 9    // "ab"
+} SemihostFileMode;
+
+// Host file stream
+typedef struct {
+    signed int   handle;
+    uint8_t*     buf;       // Block buffer
+    unsigned int size;      // Size of block buffer
+    unsigned int pos;       // Bytes read so far
+    bool         end;       // End of the file reached
+} SemihostStream_t;
+
+// Open a file on the host
+// - Returns the file handle, which is 0 or greater.
+// - Returns ERR_NOCONNECT if no debugger is connected.
+// - Returns ERR_NOTFOUND if the host couldn't open the file.
+HpsErr_t semihostFileOpen(const char* path, SemihostFileMode mode);
+
+// Close a file on the host
+HpsErr_t semihostFileClose(signed int handle);
+
+// Read from a file on the host
+// - Reads len bytes into buf, in calls of up to SEMIHOST_IO_BLOCK bytes.
+// - Returns the number of bytes read, which is less than len at the end of the file.
+HpsErr_t semihostFileRead(signed int handle, void* buf, unsigned int len);
+
+// Write to a file on the host
+// - Writes len bytes from buf, in calls of up to SEMIHOST_IO_BLOCK bytes.
+// - Returns the number of bytes written.
+HpsErr_t semihostFileWrite(signed int handle, const void* buf, unsigned int len);
+
+// Move to a position in a file on the host
+// - pos is the byte offset from the start of the file.
+HpsErr_t semihostFileSeek(signed int handle, unsigned int pos);
+
+// Get the length of a file on the host
+// - Returns the length in bytes.
+HpsErr_t semihostFileLength(signed int handle);
+
+// Load a whole file from the host
+// - Reads the file into buf, which is size bytes.
+// - Returns the length of the file.
+// - Returns ERR_TOOBIG if the file is larger than size. Nothing is read.
+HpsErr_t semihostFileLoad(const char* path, void* buf, unsigned int size);
+
+// Open a file on the host for streaming
+// - The file is read in blocks of size bytes into buf.
+HpsErr_t semihostStreamOpen(SemihostStream_t* stream, const char* path, void* buf, unsigned int size);
+
+// Read the next block of a stream
+// - Returns a pointer to the block in *data, which is valid until the next call.
+// - Returns the number of bytes in the block, which is 0 at the end of the file.
+HpsErr_t semihostStreamNext(SemihostStream_t* stream, const void** data);
+
+// Close a stream
+HpsErr_t semihostStreamClose(SemihostStream_t* stream);
+
 // System exit callback
 // - Can be used to cleanup any driver instances used for read/write APIs.
 void semihostExit(void);
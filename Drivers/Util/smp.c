@@ -0,0 +1,510 @@
+/*
+ * Dual Core (SMP) Support
+ * -----------------------
+ *
+ * Provides support for running code on the second core (CPU1)
+ * of the Cortex-A9 MPCore, and for passing work between cores.
+ *
+ * CPU1 is released from reset via the reset manager. On release
+ * the boot ROM jumps to address 0x0, where we place a trampoline
+ * which loads the entry address from the system manager CPU1
+ * start address register and branches to it. The entry code then
+ * sets up the CPU1 stacks, vector table, MMU/caches and VFP before
+ * calling the user function.
+ *
+ * The work queues are single producer, single consumer rings.
+ * The producer only writes the head, and the consumer only writes
+ * the tail, so memory barriers are enough to keep the two cores in
+ * step without exclusive accesses.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add Arria 10 support
+ * 14/10/2026 | Add optional software interrupt doorbell for work queues
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "smp.h"
+#include "Util/mem_pool.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * Internal Functions
+ */
+
+#if defined(__arm__)
+#define SMP_SUPPORTED
+#endif
+
+#if defined(SMP_SUPPORTED)
+
+#include "Util/lowlevel_arm.h"
+#include "Util/bit_helpers.h"
+#include "Util/hwlib/alt_cache.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+
+#if defined(__ARRIA10__)
+
+// Register definitions from HWLib for reset manager
+#include "Util/hwlib/a10/socal/hps.h"
+#include "Util/hwlib/a10/socal/alt_rstmgr.h"
+
+// Reset Manager MPU Module Reset Register
+#define SMP_RSTMGR_MPUREG     (volatile unsigned int *)ALT_RSTMGR_MPUMODRST_ADDR
+#define SMP_RSTMGR_CPU1MASK   ALT_RSTMGR_MPUMODRST_CPU1_SET_MSK
+
+// System Manager CPU1 Start Address Register
+//  - Not provided by the A10 HWLib (romcodegrp.cpu1startaddr), so defined here.
+#define SMP_SYSMGR_CPU1START  (volatile unsigned int *)0xFFD06230
+
+// Snoop Control Unit Control Register
+//  - A10 MPU private memory region starts at 0xFFFFC000.
+#define SMP_SCU_CTRL          (volatile unsigned int *)0xFFFFC000
+#define SMP_SCU_CTRL_ENABLE   0x1
+
+#else
+
+// Register definitions from HWLib for reset manager, system manager and SCU
+#include "Util/hwlib/cv/socal/hps.h"
+#include "Util/hwlib/cv/socal/alt_sysmgr.h"
+#include "Util/hwlib/cv/socal/alt_rstmgr.h"
+
+// Reset Manager MPU Module Reset Register
+#define SMP_RSTMGR_MPUREG     (volatile unsigned int *)ALT_RSTMGR_MPUMODRST_ADDR
+#define SMP_RSTMGR_CPU1MASK   ALT_RSTMGR_MPUMODRST_CPU1_SET_MSK
+
+// System Manager CPU1 Start Address Register
+#define SMP_SYSMGR_CPU1START  (volatile unsigned int *)ALT_SYSMGR_ROMCODE_CPU1STARTADDR_ADDR
+
+// Snoop Control Unit Control Register
+#define SMP_SCU_CTRL          (volatile unsigned int *)ALT_MPUSCU_ADDR
+#define SMP_SCU_CTRL_ENABLE   0x1
+
+#endif
+
+// Address jumped to by CPU1 on release from reset
+#define SMP_TRAMPOLINE_ADDR   0x0
+
+// Barriers for the work queues
+#define _SMP_barrier()        __DMB()
+#define _SMP_signal()         do { __DSB(); __SEV(); } while (0)
+#define _SMP_sleep()          __WFE()
+
+// Start of the vector table (see Util/startup_arm.c)
+extern void __vector_table(void);
+
+// Boot parameters for CPU1
+//  - Read by CPU1 before it has joined the coherency domain, so is
+//    cleaned to memory by CPU0 when caches are enabled. Aligned to a
+//    cache line to allow this.
+//  - sysStackTop must be the first member as it is loaded by the entry code.
+typedef struct {
+    unsigned int sysStackTop;  // CPU1 main stack
+    unsigned int irqStackTop;  // CPU1 exception mode stacks
+    SmpCtx_t*    ctx;
+    SmpCpuFunc_t func;
+    void*        param;
+    bool         mmuEnabled;   // Copy MMU configuration from CPU0
+    unsigned int ttbr0;
+    unsigned int ttbcr;
+    unsigned int dacr;
+} __attribute__((aligned(ALT_CACHE_LINE_SIZE))) SmpBoot_t;
+
+static SmpBoot_t __smp_boot __attribute__((used));
+
+// Trampoline placed at SMP_TRAMPOLINE_ADDR
+//  - Final word is filled with the address of the CPU1 start address register.
+#define SMP_TRAMPOLINE_WORDS  4
+static const unsigned int __smp_trampoline[SMP_TRAMPOLINE_WORDS - 1] = {
+    0xE59F0004, // LDR r0, [PC, #4]    ; Load address of CPU1 start address register
+    0xE5901000, // LDR r1, [r0]        ; Load CPU1 entry address from register
+    0xE12FFF11  // BX  r1              ; And jump to it
+};
+
+// Clean (or clean and invalidate) a region from the caches
+//  - Region is expanded to cache line boundaries.
+static void _SMP_cacheFlush(void* start, unsigned int length, bool invalidate) {
+    if (!alt_cache_l1_data_is_enabled()) return;
+    uintptr_t base = (uintptr_t)start & ~(ALT_CACHE_LINE_SIZE - 1);
+    uintptr_t end = ((uintptr_t)start + length + ALT_CACHE_LINE_SIZE - 1) & ~(ALT_CACHE_LINE_SIZE - 1);
+    if (invalidate) {
+        alt_cache_system_purge((void*)base, end - base);
+    } else {
+        alt_cache_system_clean((void*)base, end - base);
+    }
+}
+
+// CPU1 main function
+//  - Entered on the CPU1 main stack in system mode with interrupts masked.
+static void __attribute__((used, noreturn)) _SMP_cpu1Main(void) {
+    SmpBoot_t* boot = &__smp_boot;
+    // Set the location of the vector table, enable VBAR and non-aligned access
+    __SET_SYSREG(SYSREG_COPROC, VBAR, (unsigned int)&__vector_table);
+    unsigned int sctlr = __GET_SYSREG(SYSREG_COPROC, SCTLR);
+    sctlr = MaskClear(sctlr, 0x1, SYSREG_SCTLR_BIT_A);
+    sctlr = MaskClear(sctlr, 0x1, SYSREG_SCTLR_BIT_V);
+    __SET_SYSREG(SYSREG_COPROC, SCTLR, sctlr);
+    // Initialise all exception mode stack pointers
+    unsigned int stackTop = boot->irqStackTop;
+    __INIT_SP_MODE(PROC_STATE_FIQ, stackTop);
+    __INIT_SP_MODE(PROC_STATE_IRQ, stackTop - SMP_IRQ_STACK_SIZE);
+    __INIT_SP_MODE(PROC_STATE_SVC, stackTop - 2*SMP_IRQ_STACK_SIZE);
+    __INIT_SP_MODE(PROC_STATE_ABT, stackTop - 3*SMP_IRQ_STACK_SIZE);
+    __INIT_SP_MODE(PROC_STATE_UND, stackTop - 4*SMP_IRQ_STACK_SIZE);
+    // Join the SCU coherency domain. Must be done before enabling caches.
+    unsigned int actlr = __GET_SYSREG(SYSREG_COPROC, ACTLR);
+    actlr = MaskSet(actlr, 0x1, SYSREG_ACTLR_BIT_SMP);
+    actlr = MaskSet(actlr, 0x1, SYSREG_ACTLR_BIT_FW);
+    __SET_SYSREG(SYSREG_COPROC, ACTLR, actlr);
+    __ISB();
+    // If CPU0 has the MMU on, use the same translation table and enable L1 caches.
+    // The L2 cache is shared, and has already been enabled by CPU0.
+    if (boot->mmuEnabled) {
+        __SET_SYSREG(SYSREG_COPROC, TTBCR, boot->ttbcr);
+        __SET_SYSREG(SYSREG_COPROC, TTBR0, boot->ttbr0);
+        __SET_SYSREG(SYSREG_COPROC, DACR,  boot->dacr );
+        __SET_SYSREG(SYSREG_COPROC, TLBIALL, SYSREG_TLBIALL_CLEAR);
+        __SET_SYSREG(SYSREG_COPROC, ICIALLU, SYSREG_ICIALLU_CLEAR);
+        __SET_SYSREG(SYSREG_COPROC, BPIALL,  SYSREG_BPIALL_CLEAR );
+        __DSB();
+        __ISB();
+        sctlr = MaskSet(sctlr, 0x1, SYSREG_SCTLR_BIT_M);
+        __SET_SYSREG(SYSREG_COPROC, SCTLR, sctlr);
+        __ISB();
+        alt_cache_l1_enable_all();
+    }
+    // Enable access to the CP10/CP11 co-processors (VFP/SIMD)
+    unsigned int cpacr = __GET_SYSREG(SYSREG_COPROC, CPACR);
+    cpacr |= (SYSREG_CPACR_MASK_NS << SYSREG_CPACR_BIT_CP(10)) | (SYSREG_CPACR_MASK_NS << SYSREG_CPACR_BIT_CP(11));
+    cpacr &= ~(_BV(SYSREG_CPACR_BIT_D32DIS) | _BV(SYSREG_CPACR_BIT_ASEDIS));
+    __SET_SYSREG(SYSREG_COPROC, CPACR, cpacr);
+    __ISB();
+#if defined(__ARM_PCS_VFP) || defined(__TARGET_FPU_VFP)
+    unsigned int fpexc = __GET_PROC_FPEXC();
+    fpexc = MaskSet(fpexc, 0x1, __PROC_FPEXC_BIT_EN);
+    __SET_PROC_FPEXC(fpexc);
+#endif
+    // Run the user function
+    SmpCtx_t* ctx = boot->ctx;
+    boot->func(ctx, boot->param);
+    // Ensure everything we wrote is in memory, in case we are put back in reset
+    if (boot->mmuEnabled) {
+        alt_cache_l1_data_clean_all();
+    }
+    ctx->cpu1Finished = true;
+    _SMP_signal();
+    while (1) {
+        _SMP_sleep();
+    }
+}
+
+// CPU1 entry point
+//  - Jumped to from the trampoline in SVC mode. Moves to system mode on
+//    the CPU1 main stack and continues in C.
+static void __attribute__((naked, noreturn)) _SMP_cpu1Entry(void) {
+    __asm volatile (
+        "CPSID   if                            \n"
+        "CPS     %[sys]                        \n"
+        "LDR     r0, =__smp_boot               \n"
+        "LDR     SP, [r0]                      \n"
+        "B       _SMP_cpu1Main                 \n"
+        :: [sys] "i" (PROC_STATE_SYS)
+    );
+}
+
+#else
+
+#define _SMP_barrier()
+#define _SMP_signal()
+#define _SMP_sleep()
+
+#endif
+
+static void _SMP_cleanup(SmpCtx_t* ctx) {
+#if defined(SMP_SUPPORTED)
+    //Place CPU1 back in reset before freeing anything it might use
+    if (ctx->cpu1Running) {
+        *SMP_RSTMGR_MPUREG |= SMP_RSTMGR_CPU1MASK;
+        __DSB();
+        ctx->cpu1Running = false;
+    }
+#endif
+    if (ctx->cpu1Stack) {
+        MemPool_free(ctx->cpu1Stack);
+        ctx->cpu1Stack = NULL;
+    }
+    //Free the queue storage
+    for (unsigned int cpu = 0; cpu < SMP_CPU_COUNT; cpu++) {
+        if (ctx->queue[cpu].items) {
+            MemPool_free(ctx->queue[cpu].items);
+            ctx->queue[cpu].items = NULL;
+        }
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise SMP Support
+//  - queueLength is the length of each core's work queue. Must be a power of two, at least 2.
+//  - Must be called from CPU0.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t SMP_initialise(unsigned int queueLength, SmpCtx_t** pCtx) {
+#if defined(SMP_SUPPORTED)
+    //Ensure length is a power of two
+    if (queueLength < 2) return ERR_TOOSMALL;
+    if (queueLength & (queueLength - 1)) return ERR_NOSUPPORT;
+    if (SMP_getCpuId() != SMP_CPU0) return ERR_WRONGMODE;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_SMP_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Allocate the queue storage
+    SmpCtx_t* ctx = *pCtx;
+    for (unsigned int cpu = 0; cpu < SMP_CPU_COUNT; cpu++) {
+        SmpQueue_t* queue = &ctx->queue[cpu];
+        queue->items = (SmpWorkItem_t*)MemPool_malloc(queueLength * sizeof(*queue->items));
+        if (!queue->items) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+        queue->mask = queueLength - 1;
+        queue->head = 0;
+        queue->tail = 0;
+        queue->dropped = 0;
+        ctx->doorbell[cpu] = SMP_DOORBELL_NONE;
+    }
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool SMP_isInitialised(SmpCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Start CPU1
+//  - Releases CPU1 from reset and runs func(ctx, param) on it.
+//  - stackSize is the total CPU1 stack allocation in bytes, at least SMP_MIN_STACK_SIZE.
+//  - Must be called from CPU0. Returns ERR_INUSE if CPU1 is already running.
+HpsErr_t SMP_startCpu1(SmpCtx_t* ctx, SmpCpuFunc_t func, void* param, unsigned int stackSize) {
+    if (!func) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (SMP_getCpuId() != SMP_CPU0) return ERR_WRONGMODE;
+    if (ctx->cpu1Running) return ERR_INUSE;
+    if (stackSize < SMP_MIN_STACK_SIZE) return ERR_TOOSMALL;
+#if defined(SMP_SUPPORTED)
+    //Ensure CPU1 is held in reset (may still be running from a previous program load)
+    *SMP_RSTMGR_MPUREG |= SMP_RSTMGR_CPU1MASK;
+    __DSB();
+    //Allocate the CPU1 stacks. Exception mode stacks are at the top.
+    ctx->cpu1Stack = MemPool_malloc(stackSize);
+    if (!ctx->cpu1Stack) return ERR_ALLOCFAIL;
+    unsigned int stackTop = ((uintptr_t)ctx->cpu1Stack + stackSize) & ~0x7U;
+    __smp_boot.irqStackTop = stackTop;
+    __smp_boot.sysStackTop = stackTop - 5*SMP_IRQ_STACK_SIZE;
+    __smp_boot.ctx = ctx;
+    __smp_boot.func = func;
+    __smp_boot.param = param;
+    //Share our MMU configuration with CPU1
+    __smp_boot.mmuEnabled = !!(__GET_SYSREG(SYSREG_COPROC, SCTLR) & _BV(SYSREG_SCTLR_BIT_M));
+    __smp_boot.ttbr0 = __GET_SYSREG(SYSREG_COPROC, TTBR0);
+    __smp_boot.ttbcr = __GET_SYSREG(SYSREG_COPROC, TTBCR);
+    __smp_boot.dacr  = __GET_SYSREG(SYSREG_COPROC, DACR );
+    ctx->cpu1Finished = false;
+    //Place the trampoline, and point it at the CPU1 entry code
+    volatile unsigned int* trampoline = (volatile unsigned int*)SMP_TRAMPOLINE_ADDR;
+    for (unsigned int idx = 0; idx < SMP_TRAMPOLINE_WORDS - 1; idx++) {
+        trampoline[idx] = __smp_trampoline[idx];
+    }
+    trampoline[SMP_TRAMPOLINE_WORDS - 1] = (unsigned int)SMP_SYSMGR_CPU1START;
+    *SMP_SYSMGR_CPU1START = (unsigned int)&_SMP_cpu1Entry;
+    //Enable the SCU so the L1 data caches are kept coherent. Anything CPU0 cached
+    //before then is not known to the SCU, so must be written back.
+    if (!(*SMP_SCU_CTRL & SMP_SCU_CTRL_ENABLE)) {
+        *SMP_SCU_CTRL |= SMP_SCU_CTRL_ENABLE;
+        __DSB();
+        if (alt_cache_l1_data_is_enabled()) {
+            alt_cache_l1_data_purge_all();
+        }
+    }
+    //CPU1 runs uncached until it has enabled its MMU, so ensure the boot data and
+    //trampoline are in memory, and that no stale stack lines are left in the caches.
+    _SMP_cacheFlush(&__smp_boot, sizeof(__smp_boot), false);
+    _SMP_cacheFlush((void*)trampoline, SMP_TRAMPOLINE_WORDS * sizeof(*trampoline), false);
+    _SMP_cacheFlush(ctx->cpu1Stack, stackSize, true);
+    __DSB();
+    //And release CPU1
+    ctx->cpu1Running = true;
+    *SMP_RSTMGR_MPUREG &= ~SMP_RSTMGR_CPU1MASK;
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Stop CPU1
+//  - Places CPU1 back into reset and frees its stack. Any pending work for CPU1 is discarded.
+//  - If CPU1 has not finished, returns ERR_BUSY unless force is true. Forcing a stop may
+//    lose data written by CPU1 which is still in its L1 cache.
+//  - Must be called from CPU0.
+HpsErr_t SMP_stopCpu1(SmpCtx_t* ctx, bool force) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (SMP_getCpuId() != SMP_CPU0) return ERR_WRONGMODE;
+    if (!ctx->cpu1Running) return ERR_SUCCESS;
+    if (!ctx->cpu1Finished && !force) return ERR_BUSY;
+#if defined(SMP_SUPPORTED)
+    *SMP_RSTMGR_MPUREG |= SMP_RSTMGR_CPU1MASK;
+    __DSB();
+#endif
+    ctx->cpu1Running = false;
+    MemPool_free(ctx->cpu1Stack);
+    ctx->cpu1Stack = NULL;
+    //Discard any work which CPU1 did not get to
+    ctx->queue[SMP_CPU1].tail = ctx->queue[SMP_CPU1].head;
+    return ERR_SUCCESS;
+}
+
+// Check if CPU1 has finished
+//  - Returns true once the CPU1 main function has returned.
+bool SMP_cpu1Finished(SmpCtx_t* ctx) {
+    if (!SMP_isInitialised(ctx)) return false;
+    return ctx->cpu1Finished;
+}
+
+// Get ID of the calling core
+SmpCpuId SMP_getCpuId(void) {
+#if defined(SMP_SUPPORTED)
+    return (SmpCpuId)(__GET_SYSREG(SYSREG_COPROC, MPIDR) & SYSREG_MPIDR_MASK_CPUID);
+#else
+    return SMP_CPU0;
+#endif
+}
+
+// Post work to a core
+//  - Must be called from the other core (e.g. CPU0 posts to SMP_CPU1).
+//  - Only one context on the posting core may post to a given core.
+//  - func will be called with param and arg on the target core.
+//  - Returns ERR_NOSPACE if the queue is full.
+HpsErr_t SMP_post(SmpCtx_t* ctx, SmpCpuId cpu, WorkFunc_t func, void* param, unsigned int arg) {
+    if (!func) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (cpu >= SMP_CPU_COUNT) return ERR_BEYONDEND;
+    if (cpu == SMP_getCpuId()) return ERR_WRONGMODE;
+    //Check there is space. Tail is only moved forward by the consumer.
+    SmpQueue_t* queue = &ctx->queue[cpu];
+    unsigned int head = queue->head;
+    if ((head - queue->tail) > queue->mask) {
+        queue->dropped++;
+        return ERR_NOSPACE;
+    }
+    //Fill the slot, and ensure it is visible before publishing it
+    SmpWorkItem_t* item = &queue->items[head & queue->mask];
+    item->func = func;
+    item->param = param;
+    item->arg = arg;
+    _SMP_barrier();
+    queue->head = head + 1;
+    //Wake the other core if it is waiting
+    _SMP_signal();
+#if defined(SMP_SUPPORTED)
+    //And interrupt it if it has a doorbell
+    if (ctx->doorbell[cpu] != SMP_DOORBELL_NONE) {
+        HPS_IRQ_sendSoftware((HPSIRQSource)ctx->doorbell[cpu], 1U << cpu);
+    }
+#endif
+    return ERR_SUCCESS;
+}
+
+// Set the doorbell for a core
+//  - When work is posted to cpu, software interrupt sgiID (IRQ_SGI_0 to
+//    IRQ_SGI_15) is also sent to it, so an interrupt handler can run the
+//    work straight away instead of waiting for SMP_process() to be polled.
+//  - The handler must be registered on cpu (see HPS_IRQ_sendSoftware()).
+//  - Pass SMP_DOORBELL_NONE to only send the wake event.
+HpsErr_t SMP_setDoorbell(SmpCtx_t* ctx, SmpCpuId cpu, unsigned int sgiID) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (cpu >= SMP_CPU_COUNT) return ERR_BEYONDEND;
+#if defined(SMP_SUPPORTED)
+    if ((sgiID != SMP_DOORBELL_NONE) && (sgiID >= HPS_IRQ_SGI_COUNT)) return ERR_BADID;
+    ctx->doorbell[cpu] = sgiID;
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Run pending work for the calling core
+//  - Runs at most one queue length of items per call.
+//  - Returns the number of items run, or an error code.
+HpsErr_t SMP_process(SmpCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    SmpQueue_t* queue = &ctx->queue[SMP_getCpuId()];
+    unsigned int tail = queue->tail;
+    HpsErr_t count = 0;
+    while ((unsigned int)count <= queue->mask) {
+        //Check if the next slot has been published
+        if (tail == queue->head) break;
+        _SMP_barrier();
+        //Copy out the item, then free the slot
+        SmpWorkItem_t* item = &queue->items[tail & queue->mask];
+        WorkFunc_t func = item->func;
+        void* param = item->param;
+        unsigned int arg = item->arg;
+        _SMP_barrier();
+        queue->tail = ++tail;
+        //And run it
+        func(param, arg);
+        count++;
+    }
+    return count;
+}
+
+// Wait for and run work for the calling core
+//  - Sleeps (WFE) until there is work, then runs it as SMP_process().
+//  - May also return early with 0 on other wake events (e.g. interrupts).
+HpsErr_t SMP_wait(SmpCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //If nothing is pending, sleep. If work was posted since we checked, the
+    //event flag will already be set so WFE returns immediately.
+    SmpQueue_t* queue = &ctx->queue[SMP_getCpuId()];
+    if (queue->tail == queue->head) {
+        _SMP_sleep();
+    }
+    return SMP_process(ctx);
+}
+
+// Get number of dropped work items
+//  - Returns the number of items which could not be posted to a core as
+//    its queue was full.
+HpsErr_t SMP_getDropped(SmpCtx_t* ctx, SmpCpuId cpu) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (cpu >= SMP_CPU_COUNT) return ERR_BEYONDEND;
+    return (HpsErr_t)(ctx->queue[cpu].dropped & INT32_MAX);
+}
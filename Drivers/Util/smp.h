@@ -0,0 +1,209 @@
+/*
+ * Dual Core (SMP) Support
+ * -----------------------
+ *
+ * The Cortex-A9 MPCore in the Cyclone V and Arria 10 HPS has two cores. At
+ * startup only CPU0 runs, and CPU1 is held in reset. This module
+ * releases CPU1 from reset, gives it its own stacks, and runs a
+ * user function on it:
+ *
+ *    void audioCore(SmpCtx_t* smp, void* param) {
+ *        while (1) {
+ *            // Run any work sent from CPU0, sleeping until some arrives
+ *            SMP_wait(smp);
+ *        }
+ *    }
+ *
+ *    SMP_initialise(64, &smp);
+ *    SMP_startCpu1(smp, &audioCore, NULL, 0x10000);
+ *    // Ask CPU1 to run processBlock(buffer, length)
+ *    SMP_post(smp, SMP_CPU1, (WorkFunc_t)&processBlock, buffer, length);
+ *
+ * Work Queues
+ * -----------
+ *
+ * Each core has a work queue. Work is posted to a core with
+ * SMP_post() from the *other* core, and is run when the core
+ * calls SMP_process() or SMP_wait(). Each queue has a single
+ * producer and a single consumer, so requires no locks or
+ * atomic read-modify-write, only memory barriers. This means
+ * that only one context (e.g. the main loop, not also an ISR)
+ * on each core may post work to the other core.
+ *
+ * Posting work sends an event (SEV) to wake a core which is
+ * waiting in SMP_wait(). A core which is busy with other work
+ * can instead be given a doorbell with SMP_setDoorbell(), in which
+ * case posting also sends it a software generated interrupt (see
+ * HPS_IRQ_sendSoftware()), and its handler calls SMP_process():
+ *
+ *    // On CPU1, after HPS_IRQ_initialiseCpu()
+ *    HPS_IRQ_registerHandler(IRQ_SGI_1, &workDoorbell, smp);
+ *    SMP_setDoorbell(smp, SMP_CPU1, IRQ_SGI_1);
+ *
+ * The work then runs in interrupt context, so must be short, and
+ * that core should no longer call SMP_process() or SMP_wait().
+ *
+ * CPU1 Environment
+ * ----------------
+ *
+ * CPU1 uses the same vector table as CPU0. It starts with IRQ and
+ * FIQ masked, and all interrupts remain routed to CPU0. To take its
+ * own private interrupts (e.g. from HPS_PrivateTimer), CPU1 should
+ * call HPS_IRQ_initialiseCpu() from its main function. The exception
+ * mode stacks are taken from the top of the CPU1 stack allocation,
+ * each being SMP_IRQ_STACK_SIZE bytes.
+ *
+ * If the startup code has enabled the MMU and caches (STARTUP_ENABLE_CACHES),
+ * CPU1 uses the same translation table and enables its L1 caches, which are
+ * kept coherent with CPU0 by the Snoop Control Unit (SCU).
+ *
+ * The C library is not thread safe, so functions such as malloc()
+ * and printf() should only be called on one of the cores.
+ *
+ * CPU1 is started by placing a small trampoline at address 0x0, which
+ * the boot ROM jumps to when CPU1 is released from reset. Address 0x0
+ * must be SDRAM which is not used by the program (as with the default
+ * scatter files, which start the load region at 0x02000040).
+ *
+ * Supported on the Cyclone V and Arria 10 (-D __ARRIA10__) HPS.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add Arria 10 support
+ * 14/10/2026 | Add optional software interrupt doorbell for work queues
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef SMP_H_
+#define SMP_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/work.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Size of each CPU1 exception mode stack. There are five such stacks.
+#ifndef SMP_IRQ_STACK_SIZE
+#define SMP_IRQ_STACK_SIZE 0x400
+#endif
+
+// Doorbell value for no software interrupt
+#define SMP_DOORBELL_NONE UINT32_MAX
+
+// Minimum CPU1 stack allocation in bytes (exception stacks plus main stack)
+#define SMP_MIN_STACK_SIZE (6 * SMP_IRQ_STACK_SIZE)
+
+// Core IDs
+typedef enum {
+    SMP_CPU0,
+    SMP_CPU1,
+    SMP_CPU_COUNT
+} SmpCpuId;
+
+typedef struct _SmpCtx_t SmpCtx_t;
+
+// CPU1 main function
+//  - Runs on CPU1. CPU1 sleeps (WFE) once this returns.
+typedef void (*SmpCpuFunc_t)(SmpCtx_t* ctx, void* param);
+
+// Work queue slot
+typedef struct {
+    WorkFunc_t   func;
+    void*        param;
+    unsigned int arg;
+} SmpWorkItem_t;
+
+// Single producer, single consumer work queue
+//  - head is only written by the producer, tail only by the consumer.
+typedef struct {
+    SmpWorkItem_t*        items;   // Queue storage
+    unsigned int          mask;    // Queue length - 1
+    volatile unsigned int head;    // Next slot to post to
+    volatile unsigned int tail;    // Next slot to run
+    volatile unsigned int dropped; // Number of items dropped as queue was full
+} SmpQueue_t;
+
+// SMP Context
+typedef struct _SmpCtx_t {
+    //Header
+    DrvCtx_t header;
+    //Body
+    SmpQueue_t            queue[SMP_CPU_COUNT]; // Work queue for each core
+    unsigned int          doorbell[SMP_CPU_COUNT]; // Software interrupt sent on post, or SMP_DOORBELL_NONE
+    void*                 cpu1Stack;            // CPU1 stack allocation
+    volatile bool         cpu1Running;          // CPU1 released from reset
+    volatile bool         cpu1Finished;         // CPU1 main function has returned
+} SmpCtx_t;
+
+// Initialise SMP Support
+//  - queueLength is the length of each core's work queue. Must be a power of two, at least 2.
+//  - Must be called from CPU0.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t SMP_initialise(unsigned int queueLength, SmpCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool SMP_isInitialised(SmpCtx_t* ctx);
+
+// Start CPU1
+//  - Releases CPU1 from reset and runs func(ctx, param) on it.
+//  - stackSize is the total CPU1 stack allocation in bytes, at least SMP_MIN_STACK_SIZE.
+//  - Must be called from CPU0. Returns ERR_INUSE if CPU1 is already running.
+HpsErr_t SMP_startCpu1(SmpCtx_t* ctx, SmpCpuFunc_t func, void* param, unsigned int stackSize);
+
+// Stop CPU1
+//  - Places CPU1 back into reset and frees its stack. Any pending work for CPU1 is discarded.
+//  - If CPU1 has not finished, returns ERR_BUSY unless force is true. Forcing a stop may
+//    lose data written by CPU1 which is still in its L1 cache.
+//  - Must be called from CPU0.
+HpsErr_t SMP_stopCpu1(SmpCtx_t* ctx, bool force);
+
+// Check if CPU1 has finished
+//  - Returns true once the CPU1 main function has returned.
+bool SMP_cpu1Finished(SmpCtx_t* ctx);
+
+// Get ID of the calling core
+SmpCpuId SMP_getCpuId(void);
+
+// Post work to a core
+//  - Must be called from the other core (e.g. CPU0 posts to SMP_CPU1).
+//  - Only one context on the posting core may post to a given core.
+//  - func will be called with param and arg on the target core.
+//  - Returns ERR_NOSPACE if the queue is full.
+HpsErr_t SMP_post(SmpCtx_t* ctx, SmpCpuId cpu, WorkFunc_t func, void* param, unsigned int arg);
+
+// Set the doorbell for a core
+//  - When work is posted to cpu, software interrupt sgiID (IRQ_SGI_0 to
+//    IRQ_SGI_15) is also sent to it, so an interrupt handler can run the
+//    work straight away instead of waiting for SMP_process() to be polled.
+//  - The handler must be registered on cpu (see HPS_IRQ_sendSoftware()).
+//  - Pass SMP_DOORBELL_NONE to only send the wake event.
+HpsErr_t SMP_setDoorbell(SmpCtx_t* ctx, SmpCpuId cpu, unsigned int sgiID);
+
+// Run pending work for the calling core
+//  - Runs at most one queue length of items per call.
+//  - Returns the number of items run, or an error code.
+HpsErr_t SMP_process(SmpCtx_t* ctx);
+
+// Wait for and run work for the calling core
+//  - Sleeps (WFE) until there is work, then runs it as SMP_process().
+//  - May also return early with 0 on other wake events (e.g. interrupts).
+HpsErr_t SMP_wait(SmpCtx_t* ctx);
+
+// Get number of dropped work items
+//  - Returns the number of items which could not be posted to a core as
+//    its queue was full.
+HpsErr_t SMP_getDropped(SmpCtx_t* ctx, SmpCpuId cpu);
+
+#endif /* SMP_H_ */
@@ -44,6 +44,112 @@
  *
  *      -D IRQ_STACK_SIZE=0x100
  *
+ * MMU and Caches
+ * --------------
+ *
+ * By default the MMU is left disabled and the L1/L2 caches are
+ * turned off during startup, so all code runs uncached. To have
+ * the startup code instead build a flat (VA == PA) translation
+ * table, enable the MMU, and leave the L1 I/D and L2 caches on,
+ * globally define:
+ *
+ *      -D STARTUP_ENABLE_CACHES
+ *
+ * HPS SDRAM and the processor on-chip RAM are mapped as normal
+ * write-back, write-allocate memory. The heavyweight (0xC0000000) and
+ * lightweight (0xFF200000) FPGA bridge windows are mapped as shareable
+ * Device memory, so writes to them are posted rather than stalling
+ * the core until each one completes. Everything else (HPS peripherals,
+ * GIC/SCU/L2 controller) is mapped strongly-ordered. None of these are
+ * executable.
+ *
+ * Device accesses stay in program order with respect to each other,
+ * but a write may not have reached the FPGA by the time later code
+ * runs. Use a DSB (e.g. FpgaBridge_sync()) where that matters, such as
+ * before polling a different peripheral for the effect of a write.
+ * HPS_IRQ issues one before ending each interrupt, so that a flag
+ * cleared by the handler is cleared before the GIC can signal it again.
+ * To map the bridges strongly-ordered as before, globally define:
+ *
+ *      -D STARTUP_BRIDGES_STRONGLY_ORDERED
+ *
+ * Regions which are aligned to 16MB (HPS SDRAM and the heavyweight
+ * bridge) are mapped with 16MB supersections, and the split final 1MB
+ * with 64kB large pages, so that the whole of SDRAM needs only 192
+ * TLB entries rather than 3072 and fewer table walks are needed by
+ * code and data spread over large buffers. To map everything with
+ * 1MB sections and 4kB pages instead, globally define:
+ *
+ *      -D STARTUP_MMU_NO_SUPERSECTIONS
+ *
+ * Translations for the hottest regions can additionally be locked
+ * into the main TLB, so that they can never miss, by globally
+ * defining:
+ *
+ *      -D STARTUP_TLB_LOCK
+ *
+ * This locks the vector table, the IRQ mode stacks and the on-chip
+ * RAM (HOT_CODE/HOT_BSS) using Util/tlb_lock.c, which must then be
+ * included in the build. Requires STARTUP_ENABLE_CACHES. Further
+ * regions such as the main stack can be locked from the application
+ * with TlbLock_lock().
+ *
+ * The translation table requires 0x4400 bytes (16kB first level
+ * plus 1kB second level) aligned to a 16kB boundary, which must not
+ * be zero-initialised by the C runtime. Its location is set in the
+ * same way as the IRQ stacks using either MMU_TTB_BASE (an exact
+ * address), or MMU_TTB_SCATTER (an EMPTY scatter file region, default
+ * of MMU_TTB):
+ *
+ *      -D MMU_TTB_BASE=0x3FFF0000
+ *      -D MMU_TTB_SCATTER=MMU_TTB
+ *
+ * For higher bandwidth on large sequential streams (frame buffers,
+ * file buffers), the L2 prefetch and linefill features can also be
+ * turned on by globally defining:
+ *
+ *      -D STARTUP_CACHE_TUNING
+ *
+ * This enables PL310 instruction/data prefetch with a prefetch offset
+ * of STARTUP_L2_PREFETCH_OFFSET lines (default 7, should be one of 7,
+ * 15, 23 or 31), prefetch dropping, double linefills (including for
+ * incrementing bursts), and "full line of zero" writes. On the A9 the
+ * L1 data prefetcher, L2 prefetch hints and full line of zero writes
+ * are enabled for CPU0. Has no effect unless STARTUP_ENABLE_CACHES is
+ * also defined.
+ *
+ * Note that once caches are enabled, any buffers accessed by DMA or
+ * FPGA masters must be cleaned/invalidated using Util/hwlib/alt_cache.h.
+ *
+ * Cacheable regions are marked shareable, and CPU0 is placed in SMP
+ * mode during startup, so that the L1 data caches are kept coherent
+ * by the SCU if the second core is started (see Util/smp.h).
+ *
+ * Section Initialisation
+ * ----------------------
+ *
+ * By default the C library __main() scatter-loading routines copy
+ * the RW (and any relocated RO) sections and zero the ZI sections.
+ * For a faster cold start with large static buffers, the startup
+ * code can instead do this itself with NEON (or LDM/STM) bursts,
+ * and then call the C library entry __rt_entry() directly, by
+ * globally defining:
+ *
+ *      -D STARTUP_FAST_SCATTERLOAD
+ *
+ * The execution regions to initialise are listed by the macro
+ * STARTUP_SCATTER_REGIONS, which by default is APP_DATA and
+ * HOT_OCRAM to match the provided scatter files. Regions not in
+ * the image are skipped. For custom scatter files, globally define
+ * the list, e.g.:
+ *
+ *      -D STARTUP_SCATTER_REGIONS(m)="m(APP_DATA) m(MY_REGION)"
+ *
+ * Every region that needs initialising must be listed, and be
+ * marked NOCOMPRESS in the scatter file, as compressed RW data
+ * is not supported. EMPTY regions (stack/heap) are not zeroed in
+ * either case.
+ *
  * To delay startup (to aid in connecting and testing with
  * the debugger), define the symbol STARTUP_WAIT. This will
  * compile in a busy loop which halts execution until the
@@ -57,6 +163,15 @@
  *
  * Date       | Changes
  * -----------+------------------------------------
+ * 14/10/2026 | Lock the Arria 10 on-chip RAM address
+ * 14/10/2026 | Map with supersections and large pages, and add
+ *            | optional TLB lockdown of hot regions
+ * 14/10/2026 | Map FPGA bridges as Device memory
+ * 14/10/2026 | Add burst section initialisation option
+ * 14/10/2026 | Add L2 prefetch, double linefill and full line of
+ *            | zero tuning option
+ * 14/10/2026 | Join SMP coherency domain for CPU1 support
+ * 14/10/2026 | Add opt-in MMU and cache enable mode
  * 31/03/2024 | Split out semi-hosting handler
  * 31/01/2024 | Correct ISR attributes
  * 14/01/2023 | Split startup routines from IRQ
@@ -71,6 +186,7 @@
 #include "Util/semihosting.h"
 #include "Util/watchdog.h"
 #include "Util/hwlib/alt_cache.h"
+#include "Util/hwlib/alt_mmu.h"
 
 #include <stdio.h>
 #include <stdbool.h>
@@ -87,6 +203,17 @@
 #define IRQ_STACK_SCATTER IRQ_STACKS
 #endif
 
+//Location of the MMU translation table in memory (only if caches are enabled).
+//Could be exact address (e.g  0x3FFF0000  ), or scatter file entry (e.g. MMU_TTB  )
+#if defined(STARTUP_ENABLE_CACHES) && !defined(MMU_TTB_BASE) && !defined(MMU_TTB_SCATTER)
+#define MMU_TTB_SCATTER MMU_TTB
+#endif
+
+//L2 prefetch offset in cache lines (only if cache tuning is enabled).
+#ifndef STARTUP_L2_PREFETCH_OFFSET
+#define STARTUP_L2_PREFETCH_OFFSET 7
+#endif
+
 /*
  * Add the default handler for unused ISRs.
  *
@@ -179,6 +306,280 @@ extern unsigned int IRQ_STACK_TOP_LINK;
 
 #endif
 
+#ifdef STARTUP_ENABLE_CACHES
+
+#if defined(MMU_TTB_SCATTER)
+
+#define MMU_TTB_BASE_LINK SCATTER_REGION_BASE(MMU_TTB_SCATTER,ZI)
+#define MMU_TTB_ADDR (unsigned int)&MMU_TTB_BASE_LINK
+
+extern unsigned int MMU_TTB_BASE_LINK;
+
+#else
+
+#define MMU_TTB_ADDR (unsigned int)MMU_TTB_BASE
+
+#endif
+
+// Number of entries in first and second level tables
+#define MMU_TTB1_ENTRIES (ALT_MMU_TTB1_SIZE / sizeof(uint32_t))
+#define MMU_TTB2_ENTRIES (ALT_MMU_TTB2_SIZE / sizeof(uint32_t))
+
+// Descriptor types
+#define MMU_TTB1_TYPE_PAGE_TBL  0x1
+#define MMU_TTB1_TYPE_SECTION   0x2
+#define MMU_TTB2_TYPE_LARGEPAGE 0x1
+#define MMU_TTB2_TYPE_SMALLPAGE 0x2
+
+// Supersection flag in a section descriptor
+#define MMU_TTB1_BIT_SUPERSECTION 18
+
+// Number of identical entries needed for each supersection/large page
+#define MMU_SUPERSECTION_ENTRIES (ALT_MMU_SUPERSECTION_SIZE / ALT_MMU_SECTION_SIZE)
+#define MMU_LARGEPAGE_ENTRIES    (ALT_MMU_LARGE_PAGE_SIZE / ALT_MMU_SMALL_PAGE_SIZE)
+
+// Split ALT_MMU_ATTR_t into TEX/C/B fields
+#define MMU_ATTR_TEX(attr) (((attr) >> 4) & 0x7)
+#define MMU_ATTR_C(attr)   (((attr) >> 1) & 0x1)
+#define MMU_ATTR_B(attr)   (((attr) >> 0) & 0x1)
+
+// Flat memory map regions
+//  - base/count are in units of 1MB sections.
+//  - Sections not covered by a region will generate a translation fault.
+typedef struct {
+    unsigned int   base;
+    unsigned int   count;
+    ALT_MMU_ATTR_t attr;
+    bool           xn;
+} MmuRegion_t;
+
+// FPGA bridge windows are Device (posted writes) unless asked otherwise
+#ifdef STARTUP_BRIDGES_STRONGLY_ORDERED
+#define MMU_ATTR_BRIDGE ALT_MMU_ATTR_STRONG
+#else
+#define MMU_ATTR_BRIDGE ALT_MMU_ATTR_DEVICE
+#endif
+
+static const MmuRegion_t __mmu_regions[] = {
+#if defined(__ARRIA10__)
+    {0x000, 0xC00, ALT_MMU_ATTR_WBA,    false}, // HPS SDRAM
+    {0xC00, 0x3C0, MMU_ATTR_BRIDGE,     true }, // H2F bridge (0xC0000000-0xFBFFFFFF)
+    {0xFC0, 0x032, ALT_MMU_ATTR_STRONG, true }, // HPS peripherals
+    {0xFF2, 0x002, MMU_ATTR_BRIDGE,     true }, // LW bridge (0xFF200000-0xFF3FFFFF)
+    {0xFF4, 0x00A, ALT_MMU_ATTR_STRONG, true }, // HPS peripherals
+    {0xFFE, 0x001, ALT_MMU_ATTR_WBA,    false}, // On-chip RAM
+    {0xFFF, 0x001, ALT_MMU_ATTR_STRONG, true }, // MPU peripherals (GIC/SCU/L2) and Boot ROM
+#else
+    {0x000, 0xC00, ALT_MMU_ATTR_WBA,    false}, // HPS SDRAM
+    {0xC00, 0x3C0, MMU_ATTR_BRIDGE,     true }, // H2F bridge (0xC0000000-0xFBFFFFFF)
+    {0xFC0, 0x032, ALT_MMU_ATTR_STRONG, true }, // HPS peripherals
+    {0xFF2, 0x002, MMU_ATTR_BRIDGE,     true }, // LW bridge (0xFF200000-0xFF3FFFFF)
+    {0xFF4, 0x00B, ALT_MMU_ATTR_STRONG, true }, // HPS peripherals
+    // Final section (0xFFF00000) is split using second level table below
+#endif
+};
+
+#if !defined(__ARRIA10__)
+// Final 1MB contains both the MPU peripherals and the on-chip RAM
+#define MMU_SPLIT_SECTION    0xFFF
+#define MMU_SPLIT_LOW_PAGES  0xF0                   // 0xFFF00000-0xFFFEFFFF
+#define MMU_SPLIT_LOW_ATTR   ALT_MMU_ATTR_STRONG    // MPU peripherals (GIC/SCU/L2), Boot ROM
+#define MMU_SPLIT_HIGH_ATTR  ALT_MMU_ATTR_WBA       // On-chip RAM (0xFFFF0000-0xFFFFFFFF)
+#endif
+
+static uint32_t __mmu_section(unsigned int section, ALT_MMU_ATTR_t attr, bool xn) {
+    return ALT_MMU_TTB1_TYPE_SET(MMU_TTB1_TYPE_SECTION)       |
+           ALT_MMU_TTB1_SECTION_B_SET(MMU_ATTR_B(attr))       |
+           ALT_MMU_TTB1_SECTION_C_SET(MMU_ATTR_C(attr))       |
+           ALT_MMU_TTB1_SECTION_XN_SET(xn)                    |
+           ALT_MMU_TTB1_SECTION_DOMAIN_SET(0)                 |
+           ALT_MMU_TTB1_SECTION_AP_SET(ALT_MMU_AP_FULL_ACCESS) |
+           ALT_MMU_TTB1_SECTION_TEX_SET(MMU_ATTR_TEX(attr))   |
+           ALT_MMU_TTB1_SECTION_S_SET(1)                      |
+           ALT_MMU_TTB1_SECTION_BASE_ADDR_SET(section);
+}
+
+#ifndef STARTUP_MMU_NO_SUPERSECTIONS
+static uint32_t __mmu_supersection(unsigned int section, ALT_MMU_ATTR_t attr, bool xn) {
+    return ALT_MMU_TTB1_TYPE_SET(MMU_TTB1_TYPE_SECTION)            |
+           _BV(MMU_TTB1_BIT_SUPERSECTION)                          |
+           ALT_MMU_TTB1_SUPERSECTION_B_SET(MMU_ATTR_B(attr))       |
+           ALT_MMU_TTB1_SUPERSECTION_C_SET(MMU_ATTR_C(attr))       |
+           ALT_MMU_TTB1_SUPERSECTION_XN_SET(xn)                    |
+           ALT_MMU_TTB1_SUPERSECTION_AP_SET(ALT_MMU_AP_FULL_ACCESS) |
+           ALT_MMU_TTB1_SUPERSECTION_TEX_SET(MMU_ATTR_TEX(attr))   |
+           ALT_MMU_TTB1_SUPERSECTION_S_SET(1)                      |
+           ALT_MMU_TTB1_SUPERSECTION_BASE_ADDR_SET(section / MMU_SUPERSECTION_ENTRIES);
+}
+#endif
+
+#if defined(MMU_SPLIT_SECTION) && !defined(STARTUP_MMU_NO_SUPERSECTIONS)
+static uint32_t __mmu_largePage(unsigned int page, ALT_MMU_ATTR_t attr, bool xn) {
+    return ALT_MMU_TTB2_TYPE_SET(MMU_TTB2_TYPE_LARGEPAGE)        |
+           ALT_MMU_TTB2_LARGE_PAGE_XN_SET(xn)                    |
+           ALT_MMU_TTB2_LARGE_PAGE_B_SET(MMU_ATTR_B(attr))       |
+           ALT_MMU_TTB2_LARGE_PAGE_C_SET(MMU_ATTR_C(attr))       |
+           ALT_MMU_TTB2_LARGE_PAGE_AP_SET(ALT_MMU_AP_FULL_ACCESS) |
+           ALT_MMU_TTB2_LARGE_PAGE_TEX_SET(MMU_ATTR_TEX(attr))   |
+           ALT_MMU_TTB2_LARGE_PAGE_S_SET(1)                      |
+           ALT_MMU_TTB2_LARGE_PAGE_BASE_ADDR_SET(page / MMU_LARGEPAGE_ENTRIES);
+}
+#elif defined(MMU_SPLIT_SECTION)
+static uint32_t __mmu_smallPage(unsigned int page, ALT_MMU_ATTR_t attr, bool xn) {
+    return ALT_MMU_TTB2_TYPE_SET(MMU_TTB2_TYPE_SMALLPAGE)        |
+           ALT_MMU_TTB2_SMALL_PAGE_XN_SET(xn)                    |
+           ALT_MMU_TTB2_SMALL_PAGE_B_SET(MMU_ATTR_B(attr))       |
+           ALT_MMU_TTB2_SMALL_PAGE_C_SET(MMU_ATTR_C(attr))       |
+           ALT_MMU_TTB2_SMALL_PAGE_AP_SET(ALT_MMU_AP_FULL_ACCESS) |
+           ALT_MMU_TTB2_SMALL_PAGE_TEX_SET(MMU_ATTR_TEX(attr))   |
+           ALT_MMU_TTB2_SMALL_PAGE_S_SET(1)                      |
+           ALT_MMU_TTB2_SMALL_PAGE_BASE_ADDR_SET(page);
+}
+#endif
+
+// Build the flat translation table and enable the MMU.
+//  - Must be called with the L1/L2 caches disabled.
+static void __init_mmu(void) {
+    volatile uint32_t* ttb1 = (uint32_t*)MMU_TTB_ADDR;
+    // Ensure MMU is off while we modify the table (may be on from previous run)
+    unsigned int sctlr = __GET_SYSREG(SYSREG_COPROC, SCTLR);
+    if (sctlr & _BV(SYSREG_SCTLR_BIT_M)) {
+        sctlr = MaskClear(sctlr, 0x1, SYSREG_SCTLR_BIT_M);
+        __SET_SYSREG(SYSREG_COPROC, SCTLR, sctlr);
+        __ISB();
+    }
+    // Populate first level table. Unlisted sections generate faults.
+    for (unsigned int section = 0; section < MMU_TTB1_ENTRIES; section++) {
+        ttb1[section] = 0;
+    }
+    for (unsigned int region = 0; region < ARRAYSIZE(__mmu_regions); region++) {
+        const MmuRegion_t* map = &__mmu_regions[region];
+        unsigned int end = map->base + map->count;
+        for (unsigned int section = map->base; section < end; section++) {
+#ifndef STARTUP_MMU_NO_SUPERSECTIONS
+            // Supersections must be repeated in all 16 entries they cover
+            if (!(section % MMU_SUPERSECTION_ENTRIES) && (section + MMU_SUPERSECTION_ENTRIES <= end)) {
+                uint32_t desc = __mmu_supersection(section, map->attr, map->xn);
+                for (unsigned int entry = 0; entry < MMU_SUPERSECTION_ENTRIES; entry++) {
+                    ttb1[section + entry] = desc;
+                }
+                section += MMU_SUPERSECTION_ENTRIES - 1;
+                continue;
+            }
+#endif
+            ttb1[section] = __mmu_section(section, map->attr, map->xn);
+        }
+    }
+#ifdef MMU_SPLIT_SECTION
+    // Second level table immediately follows the first level table.
+    volatile uint32_t* ttb2 = ttb1 + MMU_TTB1_ENTRIES;
+    unsigned int pageBase = MMU_SPLIT_SECTION * MMU_TTB2_ENTRIES;
+    for (unsigned int page = 0; page < MMU_TTB2_ENTRIES; page++) {
+        bool isLow = (page < MMU_SPLIT_LOW_PAGES);
+#ifndef STARTUP_MMU_NO_SUPERSECTIONS
+        // Large pages must be repeated in all 16 entries they cover
+        ttb2[page] = __mmu_largePage(pageBase + (page & ~(MMU_LARGEPAGE_ENTRIES - 1)), isLow ? MMU_SPLIT_LOW_ATTR : MMU_SPLIT_HIGH_ATTR, isLow);
+#else
+        ttb2[page] = __mmu_smallPage(pageBase + page, isLow ? MMU_SPLIT_LOW_ATTR : MMU_SPLIT_HIGH_ATTR, isLow);
+#endif
+    }
+    ttb1[MMU_SPLIT_SECTION] = ALT_MMU_TTB1_TYPE_SET(MMU_TTB1_TYPE_PAGE_TBL) |
+                              ALT_MMU_TTB1_PAGE_TBL_DOMAIN_SET(0)          |
+                              ALT_MMU_TTB1_PAGE_TBL_BASE_ADDR_SET((unsigned int)ttb2 >> 10);
+#endif
+    __DSB();
+    // Use TTBR0 only, with cacheable (write-back, write-allocate) table walks
+    __SET_SYSREG(SYSREG_COPROC, TTBCR, SYSREG_TTBCR_TTBR0_ONLY);
+    __SET_SYSREG(SYSREG_COPROC, TTBR0, (unsigned int)ttb1 |
+                                       _BV(SYSREG_TTBR0_BIT_IRGN0) |
+                                       (SYSREG_TTBR0_RGN_WBWA << SYSREG_TTBR0_BIT_RGN));
+    // All sections are in domain 0 as a client (permissions checked)
+    __SET_SYSREG(SYSREG_COPROC, DACR, ALT_MMU_DAP_CLIENT << SYSREG_DACR_BIT_D(0));
+    // Discard any stale translations and predictions
+    __SET_SYSREG(SYSREG_COPROC, TLBIALL, SYSREG_TLBIALL_CLEAR);
+    __SET_SYSREG(SYSREG_COPROC, ICIALLU, SYSREG_ICIALLU_CLEAR);
+    __SET_SYSREG(SYSREG_COPROC, BPIALL,  SYSREG_BPIALL_CLEAR );
+    __DSB();
+    __ISB();
+    // And turn on the MMU
+    sctlr = MaskSet(sctlr, 0x1, SYSREG_SCTLR_BIT_M);
+    __SET_SYSREG(SYSREG_COPROC, SCTLR, sctlr);
+    __ISB();
+}
+
+#ifdef STARTUP_CACHE_TUNING
+
+// PL310 L2 cache controller registers
+#if defined(__ARRIA10__)
+#define L2C_BASE             0xFFFFF000
+#else
+#define L2C_BASE             0xFFFEF000
+#endif
+#define L2C_AUX_CONTROL      (0x104/sizeof(uint32_t))
+#define L2C_PREFETCH_CTRL    (0xF60/sizeof(uint32_t))
+
+#define L2C_AUX_BIT_FULLLINEOFZERO  0
+#define L2C_PF_BIT_DLINEFILL        30
+#define L2C_PF_BIT_IPREFETCH        29
+#define L2C_PF_BIT_DPREFETCH        28
+#define L2C_PF_BIT_PREFETCHDROP     24
+#define L2C_PF_BIT_INCRDLINEFILL    23
+#define L2C_PF_MASK_OFFSET          0x1F
+
+// Configure the L2 prefetch and linefill features.
+//  - Must be called with the L2 cache disabled, as the auxiliary
+//    control register can't be changed once enabled.
+static void __init_cache_tuning_l2(void) {
+    volatile uint32_t* l2c = (uint32_t*)L2C_BASE;
+    l2c[L2C_AUX_CONTROL] = MaskSet(l2c[L2C_AUX_CONTROL], 0x1, L2C_AUX_BIT_FULLLINEOFZERO);
+    l2c[L2C_PREFETCH_CTRL] = _BV(L2C_PF_BIT_DLINEFILL)     |
+                             _BV(L2C_PF_BIT_IPREFETCH)     |
+                             _BV(L2C_PF_BIT_DPREFETCH)     |
+                             _BV(L2C_PF_BIT_PREFETCHDROP)  |
+                             _BV(L2C_PF_BIT_INCRDLINEFILL) |
+                             (STARTUP_L2_PREFETCH_OFFSET & L2C_PF_MASK_OFFSET);
+    __DSB();
+}
+
+// Configure the A9 prefetch and full line of zero features.
+//  - Must be called after the L2 cache is enabled, as full line of zero
+//    writes must be enabled in the L2 first.
+static void __init_cache_tuning_cpu(void) {
+    unsigned int actlr = __GET_SYSREG(SYSREG_COPROC, ACTLR);
+    actlr = MaskSet(actlr, 0x1, SYSREG_ACTLR_BIT_L1PREFETCHEN);
+    actlr = MaskSet(actlr, 0x1, SYSREG_ACTLR_BIT_L2PREFETCHEN);
+    actlr = MaskSet(actlr, 0x1, SYSREG_ACTLR_BIT_WRITEFULLLINEZEROS);
+    __SET_SYSREG(SYSREG_COPROC, ACTLR, actlr);
+    __ISB();
+}
+
+#endif
+
+#ifdef STARTUP_TLB_LOCK
+
+#include "Util/tlb_lock.h"
+
+// On-chip RAM, holding HOT_CODE/HOT_BSS
+#if defined(__ARRIA10__)
+#define TLB_LOCK_OCRAM 0xFFE00000
+#else
+#define TLB_LOCK_OCRAM 0xFFFF0000
+#endif
+
+// Lock the vector table, IRQ mode stacks and on-chip RAM translations.
+//  - Must be called after the MMU is enabled. Regions sharing a
+//    mapping only use one entry.
+static void __init_tlb_lock(void) {
+    TlbLock_lock((const void*)&__vector_table);
+    TlbLock_lock((const void*)(IRQ_STACK_TOP - 1));
+    TlbLock_lock((const void*)(IRQ_STACK_TOP - 5*IRQ_STACK_SIZE));
+    TlbLock_lock((const void*)TLB_LOCK_OCRAM);
+}
+
+#endif
+
+#endif
+
 /*
  * Main Reset Entry Point
  *
@@ -188,6 +589,7 @@ extern unsigned int IRQ_STACK_TOP_LINK;
 
 void __init_stacks(void) __attribute__((noreturn));
 void __main       (void) __attribute__((noreturn));
+void __rt_entry   (void) __attribute__((noreturn));
 
 void __reset_isr (void) {
     // Mask fast and normal interrupts
@@ -206,6 +608,114 @@ void __reset_isr (void) {
 #define CPACR_REQSET_MASK   ((SYSREG_CPACR_MASK_NS << SYSREG_CPACR_BIT_CP(10)) | /* Must enable User and Privileged access for CP10 */ \
                              (SYSREG_CPACR_MASK_NS << SYSREG_CPACR_BIT_CP(11)))  /* Must enable User and Privileged access for CP11*/
 
+#ifdef STARTUP_FAST_SCATTERLOAD
+
+#include "Util/memcpy_v.h"
+
+//Execution regions initialised at startup
+#ifndef STARTUP_SCATTER_REGIONS
+#define STARTUP_SCATTER_REGIONS(m) m(APP_DATA) m(HOT_OCRAM)
+#endif
+
+// Linker symbols for each region. Weak so that regions not in the image are zero.
+#define __SCATTER_REGION_EXTERN(region) \
+    extern unsigned int Load$$##region##$$Base       __attribute__((weak)); \
+    extern unsigned int Load$$##region##$$Length     __attribute__((weak)); \
+    extern unsigned int Image$$##region##$$Base      __attribute__((weak)); \
+    extern unsigned int Image$$##region##$$ZI$$Base   __attribute__((weak)); \
+    extern unsigned int Image$$##region##$$ZI$$Length __attribute__((weak));
+
+#define __SCATTER_REGION_ENTRY(region) { \
+    (uintptr_t)&Load$$##region##$$Base,       \
+    (uintptr_t)&Load$$##region##$$Length,     \
+    (uintptr_t)&Image$$##region##$$Base,      \
+    (uintptr_t)&Image$$##region##$$ZI$$Base,   \
+    (uintptr_t)&Image$$##region##$$ZI$$Length  \
+},
+
+STARTUP_SCATTER_REGIONS(__SCATTER_REGION_EXTERN)
+
+typedef struct {
+    uintptr_t loadBase;
+    uintptr_t loadLength;   // RO+RW bytes, excluding ZI
+    uintptr_t execBase;
+    uintptr_t ziBase;
+    uintptr_t ziLength;
+} ScatterRegion_t;
+
+static const ScatterRegion_t __scatter_regions[] = {
+    STARTUP_SCATTER_REGIONS(__SCATTER_REGION_ENTRY)
+};
+
+// Zero memory with 32 byte bursts
+static void __init_zero(uint8_t* dest, size_t n) {
+    while (n && ((uintptr_t)dest & (sizeof(uint64_t) - 1))) {
+        *dest++ = 0;
+        n--;
+    }
+    size_t bursts = n / 32;
+    if (bursts) {
+#if defined(__ARM_NEON)
+        __asm__ __volatile__ (
+            "VMOV.I8  q0, #0                   \n\t"
+            "VMOV.I8  q1, #0                   \n\t"
+            "1:                                \n\t"
+            "VST1.64  {d0-d3}, [%[dest]:64]!   \n\t"
+            "SUBS     %[bursts], %[bursts], #1 \n\t"
+            "BNE      1b                       \n\t"
+            : [dest] "+r" (dest), [bursts] "+r" (bursts)
+            :
+            : "d0", "d1", "d2", "d3", "cc", "memory"
+        );
+#else
+        // r7 is avoided as it is the frame pointer in Thumb code.
+        __asm__ __volatile__ (
+            "MOV      r4, #0                   \n\t"
+            "MOV      r5, #0                   \n\t"
+            "MOV      r6, #0                   \n\t"
+            "MOV      r8, #0                   \n\t"
+            "1:                                \n\t"
+            "STMIA    %[dest]!, {r4-r6, r8}    \n\t"
+            "STMIA    %[dest]!, {r4-r6, r8}    \n\t"
+            "SUBS     %[bursts], %[bursts], #1 \n\t"
+            "BNE      1b                       \n\t"
+            : [dest] "+r" (dest), [bursts] "+r" (bursts)
+            :
+            : "r4", "r5", "r6", "r8", "cc", "memory"
+        );
+#endif
+        n &= 31;
+    }
+    while (n--) {
+        *dest++ = 0;
+    }
+}
+
+// Copy RW/RO sections from their load address, and zero ZI sections
+//  - Must be called after VFP/NEON access has been enabled.
+static void __init_sections(void) {
+    for (unsigned int region = 0; region < ARRAYSIZE(__scatter_regions); region++) {
+        const ScatterRegion_t* map = &__scatter_regions[region];
+        if (map->loadLength && (map->loadBase != map->execBase)) {
+            memcpy_v2v((void*)map->execBase, (const void*)map->loadBase, map->loadLength);
+        }
+        if (map->ziLength) {
+            __init_zero((uint8_t*)map->ziBase, map->ziLength);
+        }
+    }
+    __DSB();
+#ifdef STARTUP_ENABLE_CACHES
+    // Copied code must be visible to instruction fetches
+    alt_cache_l1_data_clean_all();
+    __SET_SYSREG(SYSREG_COPROC, ICIALLU, SYSREG_ICIALLU_CLEAR);
+    __SET_SYSREG(SYSREG_COPROC, BPIALL,  SYSREG_BPIALL_CLEAR );
+    __DSB();
+    __ISB();
+#endif
+}
+
+#endif
+
 #ifdef STARTUP_WAIT
 // Defaults to 0 to halt first startup.
 // Can be set to 0 again before resetting PC to entry point to halt again.
@@ -251,11 +761,38 @@ void __init_stacks (void) {
     // Reset the watchdog
     ResetWDT();
 
+    // Take part in SCU coherency and broadcast cache/TLB maintenance to the
+    // other core. Must be done before the caches are enabled. Has no effect
+    // unless CPU1 is started using Util/smp.h.
+    unsigned int actlr = __GET_SYSREG(SYSREG_COPROC, ACTLR);
+    actlr = MaskSet(actlr, 0x1, SYSREG_ACTLR_BIT_SMP);
+    actlr = MaskSet(actlr, 0x1, SYSREG_ACTLR_BIT_FW);
+    __SET_SYSREG(SYSREG_COPROC, ACTLR, actlr);
+    __ISB();
+
     // Ensure data cache is disabled. We must enable first otherwise disable leaves something
     // somewhere in the HPS in a weird state causing sporadic crashes (instruction cache corruption).
     alt_cache_system_enable();
     alt_cache_system_disable();
 
+#ifdef STARTUP_ENABLE_CACHES
+    // Map memory and turn the MMU on, then re-enable the L1 and L2 caches.
+    // Data caching requires the MMU as otherwise all data accesses are
+    // treated as strongly-ordered.
+    __init_mmu();
+#ifdef STARTUP_CACHE_TUNING
+    __init_cache_tuning_l2();
+#endif
+    alt_cache_system_enable();
+#ifdef STARTUP_CACHE_TUNING
+    __init_cache_tuning_cpu();
+#endif
+#ifdef STARTUP_TLB_LOCK
+    // Lock the translations used by every interrupt into the TLB
+    __init_tlb_lock();
+#endif
+#endif
+
     // Call board specific initialisation
     __init_board();
 
@@ -281,7 +818,12 @@ void __init_stacks (void) {
     __SET_PROC_FPEXC(fpexc);
 #endif
     // Launch the C entry point
+#ifdef STARTUP_FAST_SCATTERLOAD
+    __init_sections();
+    __rt_entry();
+#else
     __main();
+#endif
 }
 
 
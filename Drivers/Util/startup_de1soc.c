@@ -6,7 +6,9 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "Util/macros.h"
+#include "Util/memcpy_v.h"
 
 #include "DE1SoC_Addresses/DE1SoC_Addresses.h"
 
@@ -20,17 +22,64 @@ extern unsigned int __LOAD_LEN;
 #define LOAD_BASE (uintptr_t)&__LOAD_BASE
 #define LOAD_LEN  (uintptr_t)&__LOAD_LEN
 
+// Backup record, kept in the last bytes of the Bootloader Cache
+//  - A Fletcher style checksum is used rather than a CRC as the latter
+//    would take longer than the copy without the C runtime to build its
+//    tables.
+#define BACKUP_MAGIC 0x424B5550
+typedef struct {
+    uint32_t magic;
+    uint32_t length;
+    uint32_t sumA;
+    uint32_t sumB;
+} OcramBackup_t;
+
+#define BACKUP_RECORD ((volatile OcramBackup_t*)(LSC_BASE_BOOTLDR_CACHE + LSC_SIZE_BOOTLDR_CACHE - sizeof(OcramBackup_t)))
+
+// Checksum the load region in the on-chip RAM
+static void _ocramChecksum(uint32_t length, uint32_t* sumA, uint32_t* sumB) {
+    const uint32_t* hpsOcram = (const uint32_t*)LSC_BASE_PROC_OCRAM;
+    uint32_t a = 0;
+    uint32_t b = 0;
+    for (uint32_t words = CEIL_DIV(length, sizeof(uint32_t)); words; words--) {
+        a += *hpsOcram++;
+        b += a;
+    }
+    *sumA = a;
+    *sumB = b;
+}
+
 // Board specific initialisation routines used during startup
 void __init_board() {
     // For DE1-SoC, backup OCRAM to Bootloader Cache if we are using
     // the on-chip RAM. This is to allow loading programs with the
     // debugger whilst allowing watchdog reset.
     if (LOAD_BASE == (uintptr_t)LSC_BASE_PROC_OCRAM) {
-        volatile unsigned int* bootldrCache = (unsigned int*)LSC_BASE_BOOTLDR_CACHE;
-        volatile unsigned int* hpsOcram     = (unsigned int*)LSC_BASE_PROC_OCRAM;
-        uintptr_t memSize = CEIL_DIV(LOAD_LEN, sizeof(unsigned int));
-        while (memSize--) {
-            *bootldrCache++ = *hpsOcram++;
+        uint32_t length = CEIL_DIV(LOAD_LEN, sizeof(uint32_t)) * sizeof(uint32_t);
+        // If there is room for a backup record after the copy, skip the copy
+        // when it shows the backup already matches (e.g. after a watchdog
+        // reset). Reading the on-chip RAM is much faster than writing over
+        // the bridge to the Bootloader Cache.
+        bool hasRecord = (length <= (LSC_SIZE_BOOTLDR_CACHE - sizeof(OcramBackup_t)));
+        uint32_t sumA, sumB;
+        if (hasRecord) {
+            _ocramChecksum(length, &sumA, &sumB);
+            volatile OcramBackup_t* record = BACKUP_RECORD;
+            if ((record->magic == BACKUP_MAGIC) && (record->length == length) &&
+                (record->sumA == sumA) && (record->sumB == sumB)) {
+                return;
+            }
+            // Invalidate the record until the copy is complete
+            record->magic = 0;
+        }
+        // Copy with burst accesses
+        memcpy_v2v(LSC_BASE_BOOTLDR_CACHE, LSC_BASE_PROC_OCRAM, length);
+        if (hasRecord) {
+            volatile OcramBackup_t* record = BACKUP_RECORD;
+            record->length = length;
+            record->sumA = sumA;
+            record->sumB = sumB;
+            record->magic = BACKUP_MAGIC;
         }
     }
 }
@@ -0,0 +1,108 @@
+/*
+ * SVC Dispatch Table
+ * ------------------
+ *
+ * Provides the user software interrupt handler (__svc_handler, see
+ * HPS_IRQ/HPS_IRQ.h) as a table of handlers indexed directly by the
+ * ID in the SVC instruction. Each call then costs the trap plus one
+ * bounds check and an indexed branch, however many IDs are in use,
+ * so privileged operations such as cache maintenance or masking IRQs
+ * are cheap to offer to tasks running in user mode.
+ *
+ *    // Handler, run in SVC mode
+ *    static HpsErr_t _cleanCache(unsigned int argc, unsigned int* argv, void* param) {
+ *        ...
+ *    }
+ *    // Caller, usable from user mode
+ *    static HpsErr_t cleanCache(unsigned int argc, unsigned int* argv) {
+ *        HPS_IRQ_svcBody(SVC_ID_CLEAN_CACHE, argc, argv);
+ *    }
+ *    ...
+ *    SvcDispatch_register(SVC_ID_CLEAN_CACHE, &_cleanCache, NULL);
+ *
+ * IDs must be less than SVC_DISPATCH_SIZE (32 by default, which may
+ * be changed with a compiler define). A call with an ID which has no
+ * handler returns ERR_NOSUPPORT. The semi-hosting IDs are handled by
+ * the startup code before the table is reached.
+ *
+ * Handlers are called with the argc and argv of the SVC handler and
+ * the param given when registered. They run in SVC mode on the SVC
+ * stack with IRQs masked, so should be kept short.
+ *
+ * As this module provides __svc_handler, it replaces any application
+ * definition of that function. Register handlers from privileged code
+ * before they are first called.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "svc_dispatch.h"
+
+#include "Util/macros.h"
+#include "Util/lowlevel_arm.h"
+
+// Table entry
+typedef struct {
+    SvcHandlerFunc_t handler;
+    void*            param;
+} SvcDispatchEntry_t;
+
+static volatile SvcDispatchEntry_t _SvcDispatch_table[SVC_DISPATCH_SIZE] HOT_BSS;
+
+/*
+ * Internal Functions
+ */
+
+// Software IRQ Handler
+//  - Called by __svc_isr in Util/startup_arm.c for any non semi-hosting ID.
+HOT_CODE HpsErr_t __svc_handler(unsigned int id, unsigned int argc, unsigned int* argv) {
+    if (id >= SVC_DISPATCH_SIZE) return ERR_NOSUPPORT;
+    SvcHandlerFunc_t handler = _SvcDispatch_table[id].handler;
+    if (!handler) return ERR_NOSUPPORT;
+    return handler(argc, argv, _SvcDispatch_table[id].param);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Register a handler for an SVC ID
+//  - Replaces any handler already registered for the ID.
+//  - returns ERR_NULLPTR if handler is NULL.
+//  - returns ERR_BEYONDEND if id is not less than SVC_DISPATCH_SIZE.
+HpsErr_t SvcDispatch_register(unsigned int id, SvcHandlerFunc_t handler, void* param) {
+    if (id >= SVC_DISPATCH_SIZE) return ERR_BEYONDEND;
+    if (!handler) return ERR_NULLPTR;
+    //Clear the handler while the param is changed so a call never sees a mismatched pair
+    _SvcDispatch_table[id].handler = NULL;
+    __DMB();
+    _SvcDispatch_table[id].param = param;
+    __DMB();
+    _SvcDispatch_table[id].handler = handler;
+    return ERR_SUCCESS;
+}
+
+// Unregister the handler for an SVC ID
+//  - Later calls with the ID return ERR_NOSUPPORT.
+//  - returns ERR_NOTFOUND if no handler is registered.
+HpsErr_t SvcDispatch_unregister(unsigned int id) {
+    if (id >= SVC_DISPATCH_SIZE) return ERR_BEYONDEND;
+    if (!_SvcDispatch_table[id].handler) return ERR_NOTFOUND;
+    _SvcDispatch_table[id].handler = NULL;
+    __DMB();
+    return ERR_SUCCESS;
+}
+
+// Check if an SVC ID has a handler
+bool SvcDispatch_isRegistered(unsigned int id) {
+    return (id < SVC_DISPATCH_SIZE) && _SvcDispatch_table[id].handler;
+}
@@ -0,0 +1,80 @@
+/*
+ * SVC Dispatch Table
+ * ------------------
+ *
+ * Provides the user software interrupt handler (__svc_handler, see
+ * HPS_IRQ/HPS_IRQ.h) as a table of handlers indexed directly by the
+ * ID in the SVC instruction. Each call then costs the trap plus one
+ * bounds check and an indexed branch, however many IDs are in use,
+ * so privileged operations such as cache maintenance or masking IRQs
+ * are cheap to offer to tasks running in user mode.
+ *
+ *    // Handler, run in SVC mode
+ *    static HpsErr_t _cleanCache(unsigned int argc, unsigned int* argv, void* param) {
+ *        ...
+ *    }
+ *    // Caller, usable from user mode
+ *    static HpsErr_t cleanCache(unsigned int argc, unsigned int* argv) {
+ *        HPS_IRQ_svcBody(SVC_ID_CLEAN_CACHE, argc, argv);
+ *    }
+ *    ...
+ *    SvcDispatch_register(SVC_ID_CLEAN_CACHE, &_cleanCache, NULL);
+ *
+ * IDs must be less than SVC_DISPATCH_SIZE (32 by default, which may
+ * be changed with a compiler define). A call with an ID which has no
+ * handler returns ERR_NOSUPPORT. The semi-hosting IDs are handled by
+ * the startup code before the table is reached.
+ *
+ * Handlers are called with the argc and argv of the SVC handler and
+ * the param given when registered. They run in SVC mode on the SVC
+ * stack with IRQs masked, so should be kept short.
+ *
+ * As this module provides __svc_handler, it replaces any application
+ * definition of that function. Register handlers from privileged code
+ * before they are first called.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef SVC_DISPATCH_H_
+#define SVC_DISPATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Number of table entries (highest ID + 1)
+#ifndef SVC_DISPATCH_SIZE
+#define SVC_DISPATCH_SIZE 32
+#endif
+
+// SVC handler function
+//  - argc and argv are as passed to __svc_handler.
+//  - The return value is returned to the caller in r0.
+typedef HpsErr_t (*SvcHandlerFunc_t)(unsigned int argc, unsigned int* argv, void* param);
+
+// Register a handler for an SVC ID
+//  - Replaces any handler already registered for the ID.
+//  - returns ERR_NULLPTR if handler is NULL.
+//  - returns ERR_BEYONDEND if id is not less than SVC_DISPATCH_SIZE.
+HpsErr_t SvcDispatch_register(unsigned int id, SvcHandlerFunc_t handler, void* param);
+
+// Unregister the handler for an SVC ID
+//  - Later calls with the ID return ERR_NOSUPPORT.
+//  - returns ERR_NOTFOUND if no handler is registered.
+HpsErr_t SvcDispatch_unregister(unsigned int id);
+
+// Check if an SVC ID has a handler
+bool SvcDispatch_isRegistered(unsigned int id);
+
+#endif /* SVC_DISPATCH_H_ */
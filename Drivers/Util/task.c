@@ -0,0 +1,332 @@
+/*
+ * Cooperative Task Scheduler
+ * --------------------------
+ *
+ * Provides lightweight cooperative tasks (coroutines), each
+ * with its own stack, built on top of the event manager.
+ *
+ * Switching between Task_process and a task is done by saving
+ * the callee saved registers to the current stack, swapping
+ * stack pointers, and restoring the registers from the other
+ * stack. As the switch is a normal function call from the point
+ * of view of the compiler, the caller saved registers do not
+ * need to be saved.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "task.h"
+#include "Util/mem_pool.h"
+
+/*
+ * Internal Functions
+ */
+
+#if defined(__arm__)
+
+// Number of words in the saved register frame (r3-r11, lr)
+//  - r3 is not callee saved, but keeps the frame a multiple of 8 bytes.
+#define TASK_FRAME_WORDS   10
+#define TASK_FRAME_R4      1
+#define TASK_FRAME_LR      9
+// Number of words of saved VFP registers (d8-d15)
+#if defined(__ARM_FP)
+#define TASK_VFP_WORDS     16
+#else
+#define TASK_VFP_WORDS     0
+#endif
+
+// Switch stacks
+//  - Saves callee saved registers to the current stack, and stores the stack pointer to *saveSp
+//  - Then loads loadSp, and restores registers from it. Returns into the other context.
+static void __attribute__((naked)) _Task_switch(unsigned int** saveSp, unsigned int* loadSp) {
+    __asm volatile (
+        "PUSH    {r3-r11, LR}                  \n"
+#if defined(__ARM_FP)
+        "VPUSH   {d8-d15}                      \n"
+#endif
+        "STR     SP, [r0]                      \n"
+        "MOV     SP, r1                        \n"
+#if defined(__ARM_FP)
+        "VPOP    {d8-d15}                      \n"
+#endif
+        "POP     {r3-r11, PC}                  \n"
+    );
+}
+
+// Task main function
+//  - Runs the task function, then marks the task finished and switches out for good.
+static void __attribute__((used, noreturn)) _Task_main(Task_t* task) {
+    task->func(task->mgr, task->param);
+    task->state = TASK_STATE_FINISHED;
+    _Task_switch(&task->sp, task->mgr->schedSp);
+    while(1);
+}
+
+// Task entry trampoline
+//  - First switch to a new task lands here, with the task pointer in r4.
+static void __attribute__((naked, noreturn)) _Task_entry(void) {
+    __asm volatile (
+        "MOV     r0, r4                        \n"
+        "B       _Task_main                    \n"
+    );
+}
+
+#endif
+
+// Leave the current task, returning to Task_process
+//  - Task state should be set before calling.
+static HpsErr_t _Task_block(TaskMgrCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Must be called from a task
+    Task_t* task = ctx->current;
+    if (!task) return ERR_WRONGMODE;
+#if defined(__arm__)
+    _Task_switch(&task->sp, ctx->schedSp);
+#endif
+    return ERR_SUCCESS;
+}
+
+// Event handler for sleeping tasks
+//  - Marks the task as ready again. Returning success disables the event.
+static HpsErr_t _Task_wake(Event_t* event, void* param) {
+    Task_t* task = (Task_t*)param;
+    if (task->state == TASK_STATE_SLEEPING) {
+        task->state = TASK_STATE_READY;
+    }
+    return ERR_SUCCESS;
+}
+
+static void _TaskMgr_cleanup(TaskMgrCtx_t* ctx) {
+    //Free all tasks
+    Task_t* task = ctx->tasks;
+    while (task) {
+        Task_t* next = task->next;
+        Event_destroy(task->event);
+        MemPool_free(task->stack);
+        MemPool_free(task);
+        task = next;
+    }
+    ctx->tasks = NULL;
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Task Manager
+//  - evtMgr is an initialised event manager used for task sleeping.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t TaskMgr_initialise(EventMgrCtx_t* evtMgr, TaskMgrCtx_t** pCtx) {
+    //Ensure event manager is valid
+    if (!EventMgr_isInitialised(evtMgr)) return ERR_BADDEVICE;
+#if defined(__arm__)
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_TaskMgr_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save context values
+    TaskMgrCtx_t* ctx = *pCtx;
+    ctx->evtMgr = evtMgr;
+    ctx->tasks = NULL;
+    ctx->current = NULL;
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool TaskMgr_isInitialised(TaskMgrCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Create a task
+//  - func is called with param the first time the task runs.
+//  - stackSize is the size of the task stack in bytes. Must be at least TASK_MIN_STACK_SIZE.
+//  - The task starts ready to run.
+//  - Will return task to *pTask
+HpsErr_t Task_create(TaskMgrCtx_t* ctx, TaskFunc_t func, void* param, unsigned int stackSize, Task_t** pTask) {
+    if (!pTask || !func) return ERR_NULLPTR;
+    *pTask = NULL;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (stackSize < TASK_MIN_STACK_SIZE) return ERR_TOOSMALL;
+#if defined(__arm__)
+    //Allocate the task and its stack. Stack size is rounded down to 8-byte multiple.
+    stackSize = stackSize & ~7U;
+    Task_t* task = (Task_t*)MemPool_calloc(1, sizeof(*task));
+    if (!task) return ERR_ALLOCFAIL;
+    task->stack = MemPool_malloc(stackSize);
+    if (!task->stack) {
+        MemPool_free(task);
+        return ERR_ALLOCFAIL;
+    }
+    //Create the event used for sleeping
+    status = Event_create(ctx->evtMgr, EVENT_TYPE_ONESHOT, 1, &_Task_wake, task, &task->event);
+    if (ERR_IS_ERROR(status)) {
+        MemPool_free(task->stack);
+        MemPool_free(task);
+        return status;
+    }
+    //Build an initial register frame so the first switch lands in _Task_entry
+    unsigned int* sp = (unsigned int*)((unsigned char*)task->stack + stackSize);
+    sp -= TASK_FRAME_WORDS;
+    for (unsigned int idx = 0; idx < TASK_FRAME_WORDS; idx++) {
+        sp[idx] = 0;
+    }
+    sp[TASK_FRAME_R4] = (unsigned int)task;
+    sp[TASK_FRAME_LR] = (unsigned int)&_Task_entry;
+    sp -= TASK_VFP_WORDS;
+    for (unsigned int idx = 0; idx < TASK_VFP_WORDS; idx++) {
+        sp[idx] = 0;
+    }
+    task->sp = sp;
+    task->func = func;
+    task->param = param;
+    task->mgr = ctx;
+    task->state = TASK_STATE_READY;
+    //Add to the end of the task list so tasks run in creation order
+    Task_t** tail = &ctx->tasks;
+    while (*tail) tail = &(*tail)->next;
+    *tail = task;
+    *pTask = task;
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Destroy a task
+//  - Frees the task stack. Task must not be running (cannot destroy self).
+HpsErr_t Task_destroy(TaskMgrCtx_t* ctx, Task_t* task) {
+    if (!task) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (task == ctx->current) return ERR_INUSE;
+    //Find and remove the task from the list
+    Task_t** entry = &ctx->tasks;
+    while (*entry && (*entry != task)) entry = &(*entry)->next;
+    if (!*entry) return ERR_NOTFOUND;
+    *entry = task->next;
+    //Then free it
+    Event_destroy(task->event);
+    MemPool_free(task->stack);
+    MemPool_free(task);
+    return ERR_SUCCESS;
+}
+
+// Run tasks
+//  - Call repeatedly from the main loop (not from a task or ISR).
+//  - Calls Event_process(), then runs each ready task until it next blocks.
+//  - Returns the number of tasks run, or an error code.
+HpsErr_t Task_process(TaskMgrCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (ctx->current) return ERR_WRONGMODE;
+    //Wake any sleeping tasks which are due
+    status = Event_process(ctx->evtMgr);
+    if (ERR_IS_ERROR(status)) return status;
+    //Run each task that is ready
+    HpsErr_t count = 0;
+    for (Task_t* task = ctx->tasks; task; task = task->next) {
+        //Check any wait condition
+        if (task->state == TASK_STATE_WAITING) {
+            HpsErr_t waitStatus = task->waitFunc(task->waitParam);
+            if (ERR_IS_BUSY(waitStatus) || ERR_IS_RETRY(waitStatus)) continue;
+            task->waitStatus = waitStatus;
+            task->state = TASK_STATE_READY;
+        }
+        if (task->state != TASK_STATE_READY) continue;
+        //Switch to the task until it blocks
+        task->state = TASK_STATE_RUNNING;
+        ctx->current = task;
+#if defined(__arm__)
+        _Task_switch(&ctx->schedSp, task->sp);
+#endif
+        ctx->current = NULL;
+        count++;
+    }
+    return count;
+}
+
+// Yield to other tasks
+//  - Must be called from a task. Task will run again on next Task_process.
+HpsErr_t Task_yield(TaskMgrCtx_t* ctx) {
+    if (ctx && ctx->current) ctx->current->state = TASK_STATE_READY;
+    return _Task_block(ctx);
+}
+
+// Sleep for a number of timer ticks
+//  - Must be called from a task.
+HpsErr_t Task_sleep(TaskMgrCtx_t* ctx, unsigned int ticks) {
+    if (!ticks) return Task_yield(ctx);
+    if (!ctx || !ctx->current) return ERR_WRONGMODE;
+    Task_t* task = ctx->current;
+    //Start the one-shot wakeup event
+    HpsErr_t status = Event_setMode(task->event, EVENT_TYPE_ONESHOT, ticks);
+    if (ERR_IS_ERROR(status)) return status;
+    status = Event_state(task->event, EVENT_CNTRL_RESTART, ticks);
+    if (EVENT_STATE_ISINVALID(status) || ERR_IS_ERROR(status)) return ERR_UNKNOWN;
+    task->state = TASK_STATE_SLEEPING;
+    return _Task_block(ctx);
+}
+
+// Sleep until the event timer reaches a particular value
+//  - Must be called from a task. Event timer counts down, so deadline
+//    is in the future if it is below the current time.
+//  - Yields if the deadline has already passed.
+HpsErr_t Task_sleepUntil(TaskMgrCtx_t* ctx, unsigned int deadline) {
+    if (!ctx || !ctx->current) return ERR_WRONGMODE;
+    unsigned int curTime;
+    HpsErr_t status = Timer_getTime(ctx->evtMgr->timer, &curTime);
+    if (ERR_IS_ERROR(status)) return status;
+    //Ticks remaining. If negative the deadline has passed.
+    int ticks = (int)(curTime - deadline);
+    if (ticks <= 0) return Task_yield(ctx);
+    return Task_sleep(ctx, (unsigned int)ticks);
+}
+
+// Wait for a condition
+//  - Must be called from a task.
+//  - waitFunc(waitParam) is checked each Task_process until it no longer
+//    returns ERR_BUSY or ERR_AGAIN.
+//  - Returns the final value returned by waitFunc.
+HpsErr_t Task_waitUntil(TaskMgrCtx_t* ctx, TaskWaitFunc_t waitFunc, void* waitParam) {
+    if (!waitFunc) return ERR_NULLPTR;
+    if (!ctx || !ctx->current) return ERR_WRONGMODE;
+    //Check once first in case no wait is needed
+    HpsErr_t waitStatus = waitFunc(waitParam);
+    if (!ERR_IS_BUSY(waitStatus) && !ERR_IS_RETRY(waitStatus)) return waitStatus;
+    //Otherwise block until Task_process sees the condition met
+    Task_t* task = ctx->current;
+    task->waitFunc = waitFunc;
+    task->waitParam = waitParam;
+    task->state = TASK_STATE_WAITING;
+    HpsErr_t status = _Task_block(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    return task->waitStatus;
+}
+
+// Check if a task has finished
+//  - Returns true once the task function has returned.
+bool Task_isFinished(Task_t* task) {
+    return task && (task->state == TASK_STATE_FINISHED);
+}
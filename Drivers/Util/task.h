@@ -0,0 +1,161 @@
+/*
+ * Cooperative Task Scheduler
+ * --------------------------
+ *
+ * Provides lightweight cooperative tasks (coroutines), each
+ * with its own stack, built on top of the event manager.
+ *
+ * Rather than writing state machines driven by event callbacks,
+ * each task is written as straight line code which can give up
+ * the processor while it waits:
+ *
+ *    void myTask(TaskMgrCtx_t* mgr, void* param) {
+ *        while (1) {
+ *            startSomeDma(dma);
+ *            // Let other tasks run until the DMA finishes
+ *            Task_waitUntil(mgr, (TaskWaitFunc_t)&DMA_transferDone, dma);
+ *            // Wait for 1ms worth of timer ticks
+ *            Task_sleep(mgr, ticksPerMs);
+ *        }
+ *    }
+ *
+ * Tasks are run by calling Task_process() from the main loop. This
+ * calls Event_process() for the underlying event manager, and then
+ * switches to each task which is ready to run. A task runs until it
+ * calls one of Task_yield(), Task_sleep(), Task_sleepUntil() or
+ * Task_waitUntil(), or returns from its task function.
+ *
+ * Sleeping tasks use a registered event (see Util/event.h), so each
+ * task requires one entry in the event manager's event pool.
+ *
+ * Context switches only save the callee saved registers (and the
+ * callee saved VFP registers if the FPU is in use), so take a few
+ * dozen cycles.
+ *
+ * Tasks are currently supported on ARM only.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef TASK_H_
+#define TASK_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/event.h"
+
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Minimum task stack size in bytes
+#define TASK_MIN_STACK_SIZE 256
+
+typedef enum {
+    TASK_STATE_READY,    // Waiting to be run by Task_process
+    TASK_STATE_RUNNING,  // Currently running
+    TASK_STATE_SLEEPING, // Waiting for its event to occur
+    TASK_STATE_WAITING,  // Waiting for a condition
+    TASK_STATE_FINISHED  // Task function has returned
+} TaskState;
+
+typedef struct _TaskMgrCtx_t TaskMgrCtx_t;
+typedef struct _Task_t Task_t;
+
+// Task function
+//  - Runs on the tasks own stack. Task finishes when this returns.
+typedef void (*TaskFunc_t)(TaskMgrCtx_t* mgr, void* param);
+
+// Task wait condition
+//  - Return ERR_BUSY or ERR_AGAIN to keep waiting
+//  - Any other value ends the wait, and is returned from Task_waitUntil.
+//  - Functions such as DMA_transferDone can be used directly.
+typedef HpsErr_t (*TaskWaitFunc_t)(void* param);
+
+// Task structure
+typedef struct _Task_t {
+    unsigned int*  sp;        // Saved stack pointer while not running
+    void*          stack;     // Stack allocation
+    TaskState      state;
+    TaskFunc_t     func;
+    void*          param;
+    Event_t*       event;     // Event used for sleeping
+    TaskWaitFunc_t waitFunc;  // Condition being waited for
+    void*          waitParam;
+    HpsErr_t       waitStatus;
+    TaskMgrCtx_t*  mgr;
+    Task_t*        next;
+} Task_t;
+
+// Task Manager Context
+typedef struct _TaskMgrCtx_t {
+    //Header
+    DrvCtx_t header;
+    //Body
+    EventMgrCtx_t* evtMgr;    // Event manager used for sleeping
+    Task_t*        tasks;     // List of tasks
+    Task_t*        current;   // Currently running task
+    unsigned int*  schedSp;   // Saved stack pointer of Task_process
+} TaskMgrCtx_t;
+
+// Initialise Task Manager
+//  - evtMgr is an initialised event manager used for task sleeping.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t TaskMgr_initialise(EventMgrCtx_t* evtMgr, TaskMgrCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool TaskMgr_isInitialised(TaskMgrCtx_t* ctx);
+
+// Create a task
+//  - func is called with param the first time the task runs.
+//  - stackSize is the size of the task stack in bytes. Must be at least TASK_MIN_STACK_SIZE.
+//  - The task starts ready to run.
+//  - Will return task to *pTask
+HpsErr_t Task_create(TaskMgrCtx_t* ctx, TaskFunc_t func, void* param, unsigned int stackSize, Task_t** pTask);
+
+// Destroy a task
+//  - Frees the task stack. Task must not be running (cannot destroy self).
+HpsErr_t Task_destroy(TaskMgrCtx_t* ctx, Task_t* task);
+
+// Run tasks
+//  - Call repeatedly from the main loop (not from a task or ISR).
+//  - Calls Event_process(), then runs each ready task until it next blocks.
+//  - Returns the number of tasks run, or an error code.
+HpsErr_t Task_process(TaskMgrCtx_t* ctx);
+
+// Yield to other tasks
+//  - Must be called from a task. Task will run again on next Task_process.
+HpsErr_t Task_yield(TaskMgrCtx_t* ctx);
+
+// Sleep for a number of timer ticks
+//  - Must be called from a task.
+HpsErr_t Task_sleep(TaskMgrCtx_t* ctx, unsigned int ticks);
+
+// Sleep until the event timer reaches a particular value
+//  - Must be called from a task. Event timer counts down, so deadline
+//    is in the future if it is below the current time.
+//  - Yields if the deadline has already passed.
+HpsErr_t Task_sleepUntil(TaskMgrCtx_t* ctx, unsigned int deadline);
+
+// Wait for a condition
+//  - Must be called from a task.
+//  - waitFunc(waitParam) is checked each Task_process until it no longer
+//    returns ERR_BUSY or ERR_AGAIN.
+//  - Returns the final value returned by waitFunc.
+HpsErr_t Task_waitUntil(TaskMgrCtx_t* ctx, TaskWaitFunc_t waitFunc, void* waitParam);
+
+// Check if a task has finished
+//  - Returns true once the task function has returned.
+bool Task_isFinished(Task_t* task);
+
+#endif /* TASK_H_ */
@@ -0,0 +1,140 @@
+/*
+ * Monotonic Timestamps
+ * --------------------
+ *
+ * Provides a cheap 64-bit monotonic "now" from the Cortex-A9
+ * global timer, in timer cycles or nanoseconds.
+ *
+ * Each conversion is x * mult / 2^shift, with the largest shift
+ * that keeps mult within 32 bits. The 64-bit value is split in
+ * to two 32-bit halves so that each product fits in 64 bits.
+ * Low bits of the upper product are lost when shift exceeds 32,
+ * so the result may be up to 1 below the rounded product.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add time_setClock for clock profile changes
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "timestamp.h"
+
+#include "Util/hwlib/alt_globaltmr.h"
+
+// Published by hwlib, but not in the header
+extern bool alt_globaltmr_is_running(void);
+
+// Fixed point scale factor
+typedef struct {
+    uint32_t     mult;
+    unsigned int shift;
+} TimeScale_t;
+
+static unsigned int _time_periphClk = TIMESTAMP_GLOBALTMR_FREQ;
+static unsigned int _time_rate = 0;
+static TimeScale_t  _time_toNs = {0, 0};
+static TimeScale_t  _time_toCycles = {0, 0};
+
+/*
+ * Internal Functions
+ */
+
+// Calculate the scale factor for num / den
+//  - num and den must be non-zero and less than 2^32.
+static TimeScale_t _time_scale(uint64_t num, uint64_t den) {
+    TimeScale_t scale;
+    unsigned int shift = 32;
+    uint64_t quot = (num << 32) / den;
+    uint64_t rem = (num << 32) % den;
+    if (quot > UINT32_MAX) {
+        //Too large. Use fewer fractional bits.
+        do {
+            shift--;
+            quot = ((num << shift) + (den / 2)) / den;
+        } while (quot > UINT32_MAX);
+    } else {
+        //Room for more fractional bits. Long divide them from the remainder.
+        while ((quot <= (UINT32_MAX >> 1)) && (shift < 63)) {
+            rem = rem << 1;
+            quot = quot << 1;
+            if (rem >= den) {
+                rem = rem - den;
+                quot = quot | 1;
+            }
+            shift++;
+        }
+        //Round to nearest
+        if ((rem << 1) >= den) quot++;
+        if (quot > UINT32_MAX) {
+            quot = quot >> 1;
+            shift--;
+        }
+    }
+    scale.mult = (uint32_t)quot;
+    scale.shift = shift;
+    return scale;
+}
+
+// Apply a scale factor
+static inline uint64_t _time_apply(TimeScale_t scale, uint64_t val) {
+    uint64_t hi = (val >> 32) * scale.mult;
+    uint64_t lo = (val & UINT32_MAX) * scale.mult;
+    if (scale.shift > 32) {
+        return (hi >> (scale.shift - 32)) + (lo >> scale.shift);
+    }
+    return (hi << (32 - scale.shift)) + (lo >> scale.shift);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise timestamps
+//  - Starts the global timer if not already running, and calculates the
+//    conversion factors for the current timer rate.
+//  - Call once before reading timestamps. Can be called from either core.
+HpsErr_t time_initialise(void) {
+    //Start the global timer. Leave it alone if already running, as it may be in use.
+    if (!alt_globaltmr_is_running()) {
+        alt_globaltmr_init();
+    }
+    unsigned int rate = _time_periphClk / (alt_globaltmr_prescaler_get() + 1);
+    if (!rate) return ERR_NOSUPPORT;
+    _time_toNs = _time_scale(1000000000ULL, rate);
+    _time_toCycles = _time_scale(rate, 1000000000ULL);
+    _time_rate = rate;
+    return ERR_SUCCESS;
+}
+
+// Set the global timer input clock rate
+//  - periphClk is the new PERIPHCLK rate in Hz. Recalculates the conversion
+//    factors, as time_initialise() does.
+HpsErr_t time_setClock(unsigned int periphClk) {
+    if (!periphClk) return ERR_TOOSMALL;
+    _time_periphClk = periphClk;
+    return time_initialise();
+}
+
+// Get the global timer rate
+//  - Returns the number of cycles per second, or 0 if not initialised.
+unsigned int time_rate(void) {
+    return _time_rate;
+}
+
+// Convert global timer cycles to nanoseconds
+uint64_t time_cyclesToNs(uint64_t cycles) {
+    return _time_apply(_time_toNs, cycles);
+}
+
+// Convert nanoseconds to global timer cycles
+//  - Accurate to better than 1 part in 2^31.
+uint64_t time_nsToCycles(uint64_t ns) {
+    return _time_apply(_time_toCycles, ns);
+}
@@ -0,0 +1,120 @@
+/*
+ * Monotonic Timestamps
+ * --------------------
+ *
+ * Provides a cheap 64-bit monotonic "now" from the Cortex-A9
+ * global timer, in timer cycles or nanoseconds.
+ *
+ *    time_initialise();
+ *    ...
+ *    uint64_t start = time_now_cycles();
+ *    doWork();
+ *    uint64_t ns = time_cyclesToNs(time_now_cycles() - start);
+ *
+ * The global timer is a single 64-bit up-counter shared by both
+ * cores, so timestamps from either core (or from ISRs) can be
+ * compared directly. It never wraps in practice (over 2900 years
+ * at 200MHz).
+ *
+ * Reading
+ * -------
+ *
+ * time_now_cycles() is inline, and reads the counter directly
+ * with no locks: the upper word is read either side of the lower
+ * word, and the read is retried only if the lower word wrapped in
+ * between. It is therefore safe from any context on either core.
+ *
+ * Conversion
+ * ----------
+ *
+ * Cycles are converted to nanoseconds with a 32-bit multiplier
+ * and shift calculated once by time_initialise(), rather than
+ * with a 64-bit division. This is exact when the timer period is
+ * a whole number of nanoseconds (e.g. 5ns at 200MHz), and is
+ * otherwise accurate to better than 1 part in 2^31. The timer
+ * clock is PERIPHCLK (1/4 of the MPU clock) divided by the global
+ * timer prescaler. If the prescaler is changed, call
+ * time_initialise() again. If PERIPHCLK is changed (e.g. by
+ * Util/clk_profile), call time_setClock() with the new rate.
+ * Intervals which span a change are not converted correctly.
+ *
+ * Requires Util/hwlib/alt_globaltmr.c to start the global timer.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add time_setClock for clock profile changes
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef TIMESTAMP_H_
+#define TIMESTAMP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Global timer input clock frequency (PERIPHCLK, 1/4 of the MPU clock)
+// in Hz. Globally define to override if the MPU clock is changed.
+#ifndef TIMESTAMP_GLOBALTMR_FREQ
+#define TIMESTAMP_GLOBALTMR_FREQ 200000000
+#endif
+
+// Global timer counter registers
+#ifdef __ARRIA10__
+#define TIMESTAMP_GLOBALTMR_BASE 0xFFFFC200
+#else
+#define TIMESTAMP_GLOBALTMR_BASE 0xFFFEC200
+#endif
+#define TIMESTAMP_CNTR_LO (*(volatile uint32_t*)(TIMESTAMP_GLOBALTMR_BASE + 0x0))
+#define TIMESTAMP_CNTR_HI (*(volatile uint32_t*)(TIMESTAMP_GLOBALTMR_BASE + 0x4))
+
+// Initialise timestamps
+//  - Starts the global timer if not already running, and calculates the
+//    conversion factors for the current timer rate.
+//  - Call once before reading timestamps. Can be called from either core.
+HpsErr_t time_initialise(void);
+
+// Get the current time in global timer cycles
+//  - Safe to call from any context on either core.
+static inline uint64_t time_now_cycles(void) {
+    uint32_t hi = TIMESTAMP_CNTR_HI;
+    while (true) {
+        uint32_t lo = TIMESTAMP_CNTR_LO;
+        uint32_t check = TIMESTAMP_CNTR_HI;
+        if (check == hi) return ((uint64_t)hi << 32) | lo;
+        //Lower word wrapped while reading. Try again.
+        hi = check;
+    }
+}
+
+// Set the global timer input clock rate
+//  - periphClk is the new PERIPHCLK rate in Hz. Recalculates the conversion
+//    factors, as time_initialise() does.
+HpsErr_t time_setClock(unsigned int periphClk);
+
+// Get the global timer rate
+//  - Returns the number of cycles per second, or 0 if not initialised.
+unsigned int time_rate(void);
+
+// Convert global timer cycles to nanoseconds
+uint64_t time_cyclesToNs(uint64_t cycles);
+
+// Convert nanoseconds to global timer cycles
+//  - Accurate to better than 1 part in 2^31.
+uint64_t time_nsToCycles(uint64_t ns);
+
+// Get the current time in nanoseconds
+//  - Safe to call from any context on either core.
+static inline uint64_t time_now_ns(void) {
+    return time_cyclesToNs(time_now_cycles());
+}
+
+#endif /* TIMESTAMP_H_ */
@@ -0,0 +1,192 @@
+/*
+ * TLB Lockdown
+ * ------------
+ *
+ * Locks translations for latency critical regions such as the
+ * vector table, IRQ handlers and stacks into the Cortex-A9 main
+ * TLB, so that accessing them never needs a translation table
+ * walk, regardless of how many other pages have been touched
+ * since they were last used.
+ *
+ *    TlbLock_lock((const void*)&audioIsr);
+ *    TlbLock_lock(audioRing);
+ *    ...
+ *    TlbLock_unlockAll();
+ *
+ * The A9 main TLB has TLB_LOCK_ENTRIES (4) lockable entries. Each
+ * entry holds one whole mapping from the translation table, so with
+ * the startup table (16MB supersections for SDRAM, 64kB large pages
+ * for the on-chip RAM) a single entry covers a large region. An
+ * address which falls within an already locked mapping does not use
+ * another entry.
+ *
+ * Requirements
+ * ------------
+ *
+ * The MMU must be enabled (STARTUP_ENABLE_CACHES in Util/startup_arm.c)
+ * and the address must be mapped. Locking runs with interrupts masked.
+ * The lockdown is per core, so CPU1 must lock its own entries.
+ *
+ * Locked entries are not removed by a full TLB invalidate, so if the
+ * translation table is changed for a locked region, call
+ * TlbLock_unlockAll() first and lock again afterwards.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "tlb_lock.h"
+
+#include "Util/irq.h"
+#include "Util/macros.h"
+#include "Util/lowlevel_arm.h"
+#include "Util/bit_helpers.h"
+#include "Util/hwlib/alt_mmu.h"
+
+// Descriptor type fields
+#define TLB_TTB1_TYPE_MASK      0x3
+#define TLB_TTB1_TYPE_PAGE_TBL  0x1
+#define TLB_TTB1_TYPE_SECTION   0x2
+#define TLB_TTB1_BIT_SUPER      18
+#define TLB_TTB2_TYPE_MASK      0x3
+#define TLB_TTB2_TYPE_LARGEPAGE 0x1
+
+// Translation table base address in TTBR0
+#define TLB_TTBR0_BASE_MASK     (~(uintptr_t)(ALT_MMU_TTB1_SIZE - 1))
+
+typedef struct {
+    uintptr_t base;
+    size_t    size;
+} TlbLockEntry_t;
+
+static TlbLockEntry_t _TlbLock_entries[TLB_LOCK_ENTRIES];
+static unsigned int _TlbLock_count = 0;
+static IrqSpinlock_t _TlbLock_lock = IRQ_SPINLOCK_INIT;
+
+/*
+ * Internal Functions
+ */
+
+// Find the mapping which translates an address
+//  - Walks the current translation table to find the size of the
+//    section or page, as one TLB entry holds the whole mapping.
+//  - Returns ERR_NOTFOUND if the address would fault.
+static HpsErr_t _TlbLock_mapping(uintptr_t addr, TlbLockEntry_t* entry) {
+    const volatile uint32_t* ttb1 = (const uint32_t*)(__GET_SYSREG(SYSREG_COPROC, TTBR0) & TLB_TTBR0_BASE_MASK);
+    uint32_t desc = ttb1[addr / ALT_MMU_SECTION_SIZE];
+    switch (desc & TLB_TTB1_TYPE_MASK) {
+        case TLB_TTB1_TYPE_SECTION:
+            entry->size = (desc & _BV(TLB_TTB1_BIT_SUPER)) ? ALT_MMU_SUPERSECTION_SIZE : ALT_MMU_SECTION_SIZE;
+            break;
+        case TLB_TTB1_TYPE_PAGE_TBL: {
+            const volatile uint32_t* ttb2 = (const uint32_t*)(desc & ALT_MMU_TTB1_PAGE_TBL_BASE_ADDR_MASK);
+            desc = ttb2[(addr % ALT_MMU_SECTION_SIZE) / ALT_MMU_SMALL_PAGE_SIZE];
+            if (!(desc & TLB_TTB2_TYPE_MASK)) return ERR_NOTFOUND;
+            entry->size = ((desc & TLB_TTB2_TYPE_MASK) == TLB_TTB2_TYPE_LARGEPAGE) ? ALT_MMU_LARGE_PAGE_SIZE : ALT_MMU_SMALL_PAGE_SIZE;
+            break;
+        }
+        default:
+            return ERR_NOTFOUND;
+    }
+    entry->base = addr & ~(uintptr_t)(entry->size - 1);
+    return ERR_SUCCESS;
+}
+
+// Walk an address into a lockable entry
+//  - With the preserve bit set, the walk triggered by the load is
+//    placed in the victim entry, which is then kept until invalidated
+//    by MVA. The victim is then moved on with preserve cleared so that
+//    normal walks go to the unlocked entries again.
+//  - Kept out of line and small so that its own fetches don't walk.
+static void __attribute__((noinline)) _TlbLock_load(uintptr_t addr, unsigned int victim) {
+    __SET_SYSREG(SYSREG_COPROC, TLBIMVA, addr);
+    __DSB();
+    __ISB();
+    __SET_SYSREG(SYSREG_COPROC, TLBLR, (victim << SYSREG_TLBLR_BIT_VICTIM) | _BV(SYSREG_TLBLR_BIT_P));
+    __ISB();
+    (void)*(const volatile uint8_t*)addr;
+    __DSB();
+    __SET_SYSREG(SYSREG_COPROC, TLBLR, ((victim + 1) & SYSREG_TLBLR_MASK_VICTIM) << SYSREG_TLBLR_BIT_VICTIM);
+    __ISB();
+}
+
+// Check the MMU is on
+static bool _TlbLock_mmuEnabled(void) {
+    return !!(__GET_SYSREG(SYSREG_COPROC, SCTLR) & _BV(SYSREG_SCTLR_BIT_M));
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Lock the translation of an address into the TLB
+//  - Returns the index of the entry holding it (which may be one
+//    locked previously by an address in the same mapping).
+//  - Returns ERR_NOSUPPORT if the MMU is not enabled.
+//  - Returns ERR_NOTFOUND if the address is not mapped.
+//  - Returns ERR_NOSPACE if all entries are in use.
+HpsErr_t TlbLock_lock(const void* addr) {
+    if (!_TlbLock_mmuEnabled()) return ERR_NOSUPPORT;
+    TlbLockEntry_t mapping;
+    HpsErr_t status = _TlbLock_mapping((uintptr_t)addr, &mapping);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqState = IRQ_spinLock(&_TlbLock_lock);
+    //Already covered by a locked entry?
+    for (unsigned int idx = 0; idx < _TlbLock_count; idx++) {
+        if (_TlbLock_entries[idx].base == mapping.base) {
+            IRQ_spinUnlock(&_TlbLock_lock, irqState);
+            return (HpsErr_t)idx;
+        }
+    }
+    if (_TlbLock_count >= TLB_LOCK_ENTRIES) {
+        IRQ_spinUnlock(&_TlbLock_lock, irqState);
+        return ERR_NOSPACE;
+    }
+    unsigned int entry = _TlbLock_count;
+    _TlbLock_load((uintptr_t)addr, entry);
+    _TlbLock_entries[entry] = mapping;
+    _TlbLock_count++;
+    IRQ_spinUnlock(&_TlbLock_lock, irqState);
+    return (HpsErr_t)entry;
+}
+
+// Unlock all locked entries
+//  - The translations are removed from the TLB and will be walked
+//    again when next used.
+HpsErr_t TlbLock_unlockAll(void) {
+    HpsErr_t irqState = IRQ_spinLock(&_TlbLock_lock);
+    __SET_SYSREG(SYSREG_COPROC, TLBLR, 0);
+    __ISB();
+    for (unsigned int idx = 0; idx < _TlbLock_count; idx++) {
+        __SET_SYSREG(SYSREG_COPROC, TLBIMVA, _TlbLock_entries[idx].base);
+    }
+    __DSB();
+    __ISB();
+    _TlbLock_count = 0;
+    IRQ_spinUnlock(&_TlbLock_lock, irqState);
+    return ERR_SUCCESS;
+}
+
+// Get the number of entries currently locked
+unsigned int TlbLock_lockedCount(void) {
+    return _TlbLock_count;
+}
+
+// Get the region covered by a locked entry
+//  - Returns the start address to *base and size in bytes to *size.
+//  - Returns ERR_NOTFOUND if the entry is not locked.
+HpsErr_t TlbLock_getEntry(unsigned int entry, uintptr_t* base, size_t* size) {
+    if (!base || !size) return ERR_NULLPTR;
+    if (entry >= _TlbLock_count) return ERR_NOTFOUND;
+    *base = _TlbLock_entries[entry].base;
+    *size = _TlbLock_entries[entry].size;
+    return ERR_SUCCESS;
+}
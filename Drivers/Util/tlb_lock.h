@@ -0,0 +1,79 @@
+/*
+ * TLB Lockdown
+ * ------------
+ *
+ * Locks translations for latency critical regions such as the
+ * vector table, IRQ handlers and stacks into the Cortex-A9 main
+ * TLB, so that accessing them never needs a translation table
+ * walk, regardless of how many other pages have been touched
+ * since they were last used.
+ *
+ *    TlbLock_lock((const void*)&audioIsr);
+ *    TlbLock_lock(audioRing);
+ *    ...
+ *    TlbLock_unlockAll();
+ *
+ * The A9 main TLB has TLB_LOCK_ENTRIES (4) lockable entries. Each
+ * entry holds one whole mapping from the translation table, so with
+ * the startup table (16MB supersections for SDRAM, 64kB large pages
+ * for the on-chip RAM) a single entry covers a large region. An
+ * address which falls within an already locked mapping does not use
+ * another entry.
+ *
+ * Requirements
+ * ------------
+ *
+ * The MMU must be enabled (STARTUP_ENABLE_CACHES in Util/startup_arm.c)
+ * and the address must be mapped. Locking runs with interrupts masked.
+ * The lockdown is per core, so CPU1 must lock its own entries.
+ *
+ * Locked entries are not removed by a full TLB invalidate, so if the
+ * translation table is changed for a locked region, call
+ * TlbLock_unlockAll() first and lock again afterwards.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef TLB_LOCK_H_
+#define TLB_LOCK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "Util/error.h"
+
+// Number of lockable main TLB entries
+#define TLB_LOCK_ENTRIES 4
+
+// Lock the translation of an address into the TLB
+//  - Returns the index of the entry holding it (which may be one
+//    locked previously by an address in the same mapping).
+//  - Returns ERR_NOSUPPORT if the MMU is not enabled.
+//  - Returns ERR_NOTFOUND if the address is not mapped.
+//  - Returns ERR_NOSPACE if all entries are in use.
+HpsErr_t TlbLock_lock(const void* addr);
+
+// Unlock all locked entries
+//  - The translations are removed from the TLB and will be walked
+//    again when next used.
+HpsErr_t TlbLock_unlockAll(void);
+
+// Get the number of entries currently locked
+unsigned int TlbLock_lockedCount(void);
+
+// Get the region covered by a locked entry
+//  - Returns the start address to *base and size in bytes to *size.
+//  - Returns ERR_NOTFOUND if the entry is not locked.
+HpsErr_t TlbLock_getEntry(unsigned int entry, uintptr_t* base, size_t* size);
+
+#endif /* TLB_LOCK_H_ */
@@ -0,0 +1,586 @@
+/*
+ * TLSF Heap Allocator
+ * -------------------
+ *
+ * Two-level segregated fit allocator, with constant time
+ * allocation and free, and good resistance to fragmentation
+ * for long running images.
+ *
+ * Free blocks are kept in lists by size. The first level splits
+ * sizes by power of two, and the second level splits each power
+ * of two into 32 linear ranges, with a bitmap of non-empty lists
+ * at each level. Allocation rounds the size up to the next range
+ * and takes the first block of the first non-empty list at or
+ * above it, so never searches a list. Blocks are split when
+ * allocated, and merged with free neighbours when freed.
+ *
+ * Pools
+ * -----
+ *
+ * The control structure is placed at the start of the pool memory,
+ * so no other heap is needed to create one. Separate pools can be
+ * made for different memories, e.g. a small fast pool in the
+ * on-chip RAM alongside the main heap in DDR:
+ *
+ *    Tlsf_initialise(ocramBuf, sizeof(ocramBuf), &fastHeap);
+ *    p = Tlsf_malloc(fastHeap, 256);
+ *
+ * More memory can be added to a pool with Tlsf_addPool(). Each pool
+ * may be up to 2GB. All of the APIs are safe to call with interrupts
+ * enabled and from both cores.
+ *
+ * C Library Heap
+ * --------------
+ *
+ * To replace the C library heap (malloc, free, calloc, realloc),
+ * globally define:
+ *
+ *     -D TLSF_HEAP
+ *
+ * The heap is then created on first use from the ARM_LIB_STACKHEAP
+ * scatter region (see ScatterFiles/DDRRam.scat), leaving the top
+ * TLSF_HEAP_STACK_SIZE bytes (default 64kB) for the application stack
+ * which grows down from the top of the region. A different region can
+ * be used by globally defining TLSF_HEAP_SCATTER, in which case set
+ * TLSF_HEAP_STACK_SIZE to 0 if the stack is elsewhere. Tlsf_heap()
+ * returns the heap pool so that its statistics can be read.
+ *
+ * Note for OnChipRam.scat, the region is only 0x3B00 bytes, so the
+ * stack size must be reduced to leave room for a heap.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "tlsf.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "Util/macros.h"
+#include "Util/bit_helpers.h"
+
+// Context magic word ("TLSF")
+#define TLSF_MAGIC        0x464C5354
+
+// Block header size, and smallest data size (room for the free list links)
+#define TLSF_HDR_SIZE     offsetof(TlsfBlock_t, nextFree)
+#define TLSF_MIN_SIZE     (sizeof(TlsfBlock_t) - TLSF_HDR_SIZE)
+
+// Largest allocation, such that the rounded size fits the first level
+#define TLSF_MAX_SIZE     (((size_t)1 << 30) + ((size_t)1 << 29))
+
+// Block free flag in size
+#define TLSF_FREE_FLAG    1U
+
+/*
+ * Internal Functions
+ */
+
+static inline unsigned int _Tlsf_fls(uint32_t x) {
+    return 31 - __clz(x);
+}
+
+static inline unsigned int _Tlsf_ffs(uint32_t x) {
+    return 31 - __clz(x & -x);
+}
+
+static inline size_t _Tlsf_size(TlsfBlock_t* block) {
+    return block->size & ~(size_t)TLSF_FREE_FLAG;
+}
+
+static inline bool _Tlsf_isFree(TlsfBlock_t* block) {
+    return block->size & TLSF_FREE_FLAG;
+}
+
+static inline void* _Tlsf_toPtr(TlsfBlock_t* block) {
+    return (uint8_t*)block + TLSF_HDR_SIZE;
+}
+
+static inline TlsfBlock_t* _Tlsf_fromPtr(void* ptr) {
+    return (TlsfBlock_t*)((uint8_t*)ptr - TLSF_HDR_SIZE);
+}
+
+static inline TlsfBlock_t* _Tlsf_next(TlsfBlock_t* block) {
+    return (TlsfBlock_t*)((uint8_t*)_Tlsf_toPtr(block) + _Tlsf_size(block));
+}
+
+// Round a requested size to a block size
+//  - Returns 0 if too big
+static size_t _Tlsf_adjustSize(size_t size) {
+    if (size > TLSF_MAX_SIZE) return 0;
+    size = (size + TLSF_ALIGN - 1) & ~(size_t)(TLSF_ALIGN - 1);
+    return max(size, TLSF_MIN_SIZE);
+}
+
+// List which holds blocks of a size
+static void _Tlsf_mapInsert(size_t size, unsigned int* fl, unsigned int* sl) {
+    if (size < (1U << TLSF_FL_SHIFT)) {
+        //Small sizes are split linearly in the first list
+        *fl = 0;
+        *sl = size >> TLSF_ALIGN_LOG2;
+    } else {
+        unsigned int log2 = _Tlsf_fls(size);
+        *sl = (size >> (log2 - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+        *fl = log2 - TLSF_FL_SHIFT + 1;
+    }
+}
+
+// First list whose blocks are all at least size
+static void _Tlsf_mapSearch(size_t size, unsigned int* fl, unsigned int* sl) {
+    if (size >= (1U << TLSF_FL_SHIFT)) {
+        size += (1U << (_Tlsf_fls(size) - TLSF_SL_LOG2)) - 1;
+    }
+    _Tlsf_mapInsert(size, fl, sl);
+}
+
+// Add a block to its free list
+static void _Tlsf_insert(TlsfCtx_t* ctx, TlsfBlock_t* block) {
+    unsigned int fl, sl;
+    _Tlsf_mapInsert(_Tlsf_size(block), &fl, &sl);
+    TlsfBlock_t* head = ctx->blocks[fl][sl];
+    block->nextFree = head;
+    block->prevFree = NULL;
+    if (head) head->prevFree = block;
+    ctx->blocks[fl][sl] = block;
+    ctx->flBitmap |= (1U << fl);
+    ctx->slBitmap[fl] |= (1U << sl);
+    ctx->freeBlocks++;
+}
+
+// Remove a block from its free list
+static void _Tlsf_remove(TlsfCtx_t* ctx, TlsfBlock_t* block) {
+    unsigned int fl, sl;
+    _Tlsf_mapInsert(_Tlsf_size(block), &fl, &sl);
+    if (block->nextFree) block->nextFree->prevFree = block->prevFree;
+    if (block->prevFree) {
+        block->prevFree->nextFree = block->nextFree;
+    } else {
+        ctx->blocks[fl][sl] = block->nextFree;
+        if (!block->nextFree) {
+            ctx->slBitmap[fl] &= ~(1U << sl);
+            if (!ctx->slBitmap[fl]) ctx->flBitmap &= ~(1U << fl);
+        }
+    }
+    ctx->freeBlocks--;
+}
+
+// Find a free block of at least size
+//  - Returns NULL if none.
+static TlsfBlock_t* _Tlsf_findFree(TlsfCtx_t* ctx, size_t size) {
+    unsigned int fl, sl;
+    _Tlsf_mapSearch(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) return NULL;
+    uint32_t slMap = ctx->slBitmap[fl] & (~0U << sl);
+    if (!slMap) {
+        //Nothing at this level, take the next larger non-empty one
+        uint32_t flMap = ((fl + 1) < 32) ? (ctx->flBitmap & (~0U << (fl + 1))) : 0;
+        if (!flMap) return NULL;
+        fl = _Tlsf_ffs(flMap);
+        slMap = ctx->slBitmap[fl];
+    }
+    sl = _Tlsf_ffs(slMap);
+    return ctx->blocks[fl][sl];
+}
+
+// Merge a free block with the next block if it is free
+//  - The block must not be in a free list.
+static void _Tlsf_mergeNext(TlsfCtx_t* ctx, TlsfBlock_t* block) {
+    TlsfBlock_t* next = _Tlsf_next(block);
+    if (!_Tlsf_isFree(next)) return;
+    _Tlsf_remove(ctx, next);
+    block->size += TLSF_HDR_SIZE + _Tlsf_size(next);
+    _Tlsf_next(block)->prevPhys = block;
+}
+
+// Split the end off a block if there is room for another
+//  - The remainder is freed.
+static void _Tlsf_split(TlsfCtx_t* ctx, TlsfBlock_t* block, size_t size) {
+    size_t blockSize = _Tlsf_size(block);
+    if (blockSize < (size + TLSF_HDR_SIZE + TLSF_MIN_SIZE)) return;
+    TlsfBlock_t* rem = (TlsfBlock_t*)((uint8_t*)_Tlsf_toPtr(block) + size);
+    rem->prevPhys = block;
+    rem->size = (blockSize - size - TLSF_HDR_SIZE) | TLSF_FREE_FLAG;
+    _Tlsf_next(rem)->prevPhys = rem;
+    block->size = size | (block->size & TLSF_FREE_FLAG);
+    _Tlsf_mergeNext(ctx, rem);
+    _Tlsf_insert(ctx, rem);
+}
+
+// Mark a block as allocated
+static void* _Tlsf_use(TlsfCtx_t* ctx, TlsfBlock_t* block, size_t size) {
+    _Tlsf_split(ctx, block, size);
+    block->size &= ~(size_t)TLSF_FREE_FLAG;
+    ctx->usedBlocks++;
+    ctx->used += _Tlsf_size(block) + TLSF_HDR_SIZE;
+    if (ctx->used > ctx->peakUsed) ctx->peakUsed = ctx->used;
+    return _Tlsf_toPtr(block);
+}
+
+// Allocate a block
+//  - Must be called with the lock held.
+static void* _Tlsf_malloc(TlsfCtx_t* ctx, size_t size) {
+    TlsfBlock_t* block = _Tlsf_findFree(ctx, size);
+    if (!block) return NULL;
+    _Tlsf_remove(ctx, block);
+    return _Tlsf_use(ctx, block, size);
+}
+
+// Free a block
+//  - Must be called with the lock held.
+static void _Tlsf_free(TlsfCtx_t* ctx, TlsfBlock_t* block) {
+    ctx->usedBlocks--;
+    ctx->used -= _Tlsf_size(block) + TLSF_HDR_SIZE;
+    block->size |= TLSF_FREE_FLAG;
+    //Merge with the previous block if free
+    TlsfBlock_t* prev = block->prevPhys;
+    if (prev && _Tlsf_isFree(prev)) {
+        _Tlsf_remove(ctx, prev);
+        prev->size += TLSF_HDR_SIZE + _Tlsf_size(block);
+        _Tlsf_next(prev)->prevPhys = prev;
+        block = prev;
+    }
+    //And the next
+    _Tlsf_mergeNext(ctx, block);
+    _Tlsf_insert(ctx, block);
+}
+
+// Find the block of an allocation
+//  - Returns NULL if not an in use block, e.g. freed twice.
+static TlsfBlock_t* _Tlsf_block(void* ptr) {
+    if (!ptr || ((uintptr_t)ptr & (TLSF_ALIGN - 1))) return NULL;
+    TlsfBlock_t* block = _Tlsf_fromPtr(ptr);
+    if (_Tlsf_isFree(block)) return NULL;
+    return block;
+}
+
+// Check a pool context is valid
+static inline bool _Tlsf_valid(TlsfCtx_t* ctx) {
+    return ctx && (ctx->magic == TLSF_MAGIC);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise a TLSF pool
+//  - mem is the pool memory of size bytes. The context is placed at its start.
+//  - Returns ERR_TOOSMALL if there is no room for blocks after the context.
+//  - Returns context pointer to *ctx
+HpsErr_t Tlsf_initialise(void* mem, size_t size, TlsfCtx_t** pCtx) {
+    //Ensure user pointers valid
+    if (!mem || !pCtx) return ERR_NULLPTR;
+    //Context goes at the start, aligned
+    uintptr_t base = ((uintptr_t)mem + TLSF_ALIGN - 1) & ~(uintptr_t)(TLSF_ALIGN - 1);
+    size_t ctxSize = (sizeof(TlsfCtx_t) + TLSF_ALIGN - 1) & ~(size_t)(TLSF_ALIGN - 1);
+    size_t skip = (base - (uintptr_t)mem) + ctxSize;
+    if (size < skip) return ERR_TOOSMALL;
+    TlsfCtx_t* ctx = (TlsfCtx_t*)base;
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->lock = IRQ_SPINLOCK_INIT;
+    ctx->magic = TLSF_MAGIC;
+    //Then the rest is the first pool
+    HpsErr_t status = Tlsf_addPool(ctx, (uint8_t*)mem + skip, size - skip);
+    if (ERR_IS_ERROR(status)) {
+        ctx->magic = 0;
+        return status;
+    }
+    *pCtx = ctx;
+    return ERR_SUCCESS;
+}
+
+// Check if pool initialised
+bool Tlsf_isInitialised(TlsfCtx_t* ctx) {
+    return _Tlsf_valid(ctx);
+}
+
+// Add memory to a pool
+//  - mem is size bytes, which need not be next to the existing memory.
+HpsErr_t Tlsf_addPool(TlsfCtx_t* ctx, void* mem, size_t size) {
+    if (!_Tlsf_valid(ctx)) return ERR_BADDEVICE;
+    if (!mem) return ERR_NULLPTR;
+    //Align the start, then room for the pool header, first block and end sentinel
+    uintptr_t base = ((uintptr_t)mem + TLSF_ALIGN - 1) & ~(uintptr_t)(TLSF_ALIGN - 1);
+    size_t overhead = (base - (uintptr_t)mem) + sizeof(TlsfPool_t) + 2 * TLSF_HDR_SIZE;
+    if (size < (overhead + TLSF_MIN_SIZE)) return ERR_TOOSMALL;
+    size_t blockSize = (size - overhead) & ~(size_t)(TLSF_ALIGN - 1);
+    if (blockSize > TLSF_MAX_SIZE) blockSize = TLSF_MAX_SIZE;
+    TlsfPool_t* pool = (TlsfPool_t*)base;
+    pool->size = blockSize + 2 * TLSF_HDR_SIZE;
+    //One free block spanning the pool, followed by an in use sentinel of size 0
+    TlsfBlock_t* block = (TlsfBlock_t*)(pool + 1);
+    block->prevPhys = NULL;
+    block->size = blockSize | TLSF_FREE_FLAG;
+    TlsfBlock_t* sentinel = _Tlsf_next(block);
+    sentinel->prevPhys = block;
+    sentinel->size = 0;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    pool->next = ctx->pools;
+    ctx->pools = pool;
+    ctx->total += blockSize;
+    _Tlsf_insert(ctx, block);
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    return ERR_SUCCESS;
+}
+
+// Allocate size bytes
+//  - Returns NULL if there is no space.
+void* Tlsf_malloc(TlsfCtx_t* ctx, size_t size) {
+    if (!_Tlsf_valid(ctx)) return NULL;
+    size = _Tlsf_adjustSize(size);
+    if (!size) return NULL;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    void* ptr = _Tlsf_malloc(ctx, size);
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    return ptr;
+}
+
+// Allocate size bytes aligned to align
+//  - align must be a power of two.
+//  - Returns NULL if there is no space.
+void* Tlsf_memalign(TlsfCtx_t* ctx, size_t align, size_t size) {
+    if (!_Tlsf_valid(ctx)) return NULL;
+    if (!align || (align & (align - 1))) return NULL;
+    if (align <= TLSF_ALIGN) return Tlsf_malloc(ctx, size);
+    size = _Tlsf_adjustSize(size);
+    if (!size || (align > TLSF_MAX_SIZE)) return NULL;
+    //Room to move the start up to the alignment, leaving a free block before it
+    size_t gapMin = TLSF_HDR_SIZE + TLSF_MIN_SIZE;
+    size_t search = size + align + gapMin;
+    if (search > TLSF_MAX_SIZE) return NULL;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    TlsfBlock_t* block = _Tlsf_findFree(ctx, search);
+    void* ptr = NULL;
+    if (block) {
+        _Tlsf_remove(ctx, block);
+        uintptr_t start = (uintptr_t)_Tlsf_toPtr(block);
+        uintptr_t aligned = (start + align - 1) & ~(uintptr_t)(align - 1);
+        if (aligned != start) {
+            if ((aligned - start) < gapMin) {
+                aligned = (start + gapMin + align - 1) & ~(uintptr_t)(align - 1);
+            }
+            //Free the gap as a block of its own
+            size_t gap = aligned - start;
+            TlsfBlock_t* moved = _Tlsf_fromPtr((void*)aligned);
+            moved->prevPhys = block;
+            moved->size = _Tlsf_size(block) - gap;
+            _Tlsf_next(moved)->prevPhys = moved;
+            block->size = (gap - TLSF_HDR_SIZE) | TLSF_FREE_FLAG;
+            _Tlsf_insert(ctx, block);
+            block = moved;
+        }
+        ptr = _Tlsf_use(ctx, block, size);
+    }
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    return ptr;
+}
+
+// Allocate count elements of size bytes, initialised to zero
+//  - Returns NULL if there is no space.
+void* Tlsf_calloc(TlsfCtx_t* ctx, size_t count, size_t size) {
+    if (size && (count > (SIZE_MAX / size))) return NULL;
+    void* ptr = Tlsf_malloc(ctx, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+// Resize an allocation
+//  - Grows in place if the next block is free, otherwise moves it.
+//  - Returns NULL if there is no space, leaving ptr allocated.
+void* Tlsf_realloc(TlsfCtx_t* ctx, void* ptr, size_t size) {
+    if (!ptr) return Tlsf_malloc(ctx, size);
+    if (!size) {
+        Tlsf_free(ctx, ptr);
+        return NULL;
+    }
+    if (!_Tlsf_valid(ctx)) return NULL;
+    TlsfBlock_t* block = _Tlsf_block(ptr);
+    size = _Tlsf_adjustSize(size);
+    if (!block || !size) return NULL;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    size_t current = _Tlsf_size(block);
+    TlsfBlock_t* next = _Tlsf_next(block);
+    if ((size > current) && (!_Tlsf_isFree(next) || ((current + TLSF_HDR_SIZE + _Tlsf_size(next)) < size))) {
+        //Doesn't fit in place, so move it
+        void* moved = _Tlsf_malloc(ctx, size);
+        if (moved) {
+            memcpy(moved, ptr, current);
+            _Tlsf_free(ctx, block);
+        }
+        IRQ_spinUnlock(&ctx->lock, irqState);
+        return moved;
+    }
+    //Grow into the next block if needed, then trim to size
+    if (size > current) {
+        _Tlsf_remove(ctx, next);
+        block->size += TLSF_HDR_SIZE + _Tlsf_size(next);
+        _Tlsf_next(block)->prevPhys = block;
+    }
+    _Tlsf_split(ctx, block, size);
+    ctx->used = ctx->used + _Tlsf_size(block) - current;
+    if (ctx->used > ctx->peakUsed) ctx->peakUsed = ctx->used;
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    return ptr;
+}
+
+// Free an allocation
+//  - ptr may be NULL.
+void Tlsf_free(TlsfCtx_t* ctx, void* ptr) {
+    if (!_Tlsf_valid(ctx)) return;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    TlsfBlock_t* block = _Tlsf_block(ptr);
+    if (block) _Tlsf_free(ctx, block);
+    IRQ_spinUnlock(&ctx->lock, irqState);
+}
+
+// Get the usable size of an allocation
+size_t Tlsf_blockSize(void* ptr) {
+    TlsfBlock_t* block = _Tlsf_block(ptr);
+    return block ? _Tlsf_size(block) : 0;
+}
+
+// Get pool statistics
+HpsErr_t Tlsf_getStats(TlsfCtx_t* ctx, TlsfStats_t* stats) {
+    if (!_Tlsf_valid(ctx)) return ERR_BADDEVICE;
+    if (!stats) return ERR_NULLPTR;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    stats->total = ctx->total;
+    stats->used = ctx->used;
+    stats->peakUsed = ctx->peakUsed;
+    stats->usedBlocks = ctx->usedBlocks;
+    stats->freeBlocks = ctx->freeBlocks;
+    stats->free = 0;
+    stats->largestFree = 0;
+    for (unsigned int fl = 0; fl < TLSF_FL_COUNT; fl++) {
+        for (unsigned int sl = 0; sl < TLSF_SL_COUNT; sl++) {
+            for (TlsfBlock_t* block = ctx->blocks[fl][sl]; block; block = block->nextFree) {
+                size_t blockSize = _Tlsf_size(block);
+                stats->free += blockSize;
+                if (blockSize > stats->largestFree) stats->largestFree = blockSize;
+            }
+        }
+    }
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    stats->fragmentation = stats->free ? (unsigned int)(100 - ((uint64_t)stats->largestFree * 100) / stats->free) : 0;
+    return ERR_SUCCESS;
+}
+
+// Check pool integrity
+//  - Walks every block, checking the links and free lists agree.
+//  - Returns ERR_CORRUPT if not.
+HpsErr_t Tlsf_check(TlsfCtx_t* ctx) {
+    if (!_Tlsf_valid(ctx)) return ERR_BADDEVICE;
+    HpsErr_t status = ERR_SUCCESS;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    //Physical blocks
+    unsigned int freeCount = 0;
+    unsigned int usedCount = 0;
+    for (TlsfPool_t* pool = ctx->pools; pool && ERR_IS_SUCCESS(status); pool = pool->next) {
+        uint8_t* end = (uint8_t*)(pool + 1) + pool->size;
+        TlsfBlock_t* prev = NULL;
+        TlsfBlock_t* block = (TlsfBlock_t*)(pool + 1);
+        while (true) {
+            if (((uint8_t*)block + TLSF_HDR_SIZE) > end) { status = ERR_CORRUPT; break; }
+            if (block->prevPhys != prev) { status = ERR_CORRUPT; break; }
+            if (!_Tlsf_size(block)) {
+                //Sentinel must be at the end
+                if ((((uint8_t*)block + TLSF_HDR_SIZE) != end) || _Tlsf_isFree(block)) status = ERR_CORRUPT;
+                break;
+            }
+            if (_Tlsf_isFree(block)) {
+                //Neighbouring free blocks should have been merged
+                if (prev && _Tlsf_isFree(prev)) { status = ERR_CORRUPT; break; }
+                freeCount++;
+            } else {
+                usedCount++;
+            }
+            prev = block;
+            block = _Tlsf_next(block);
+        }
+    }
+    //Free lists
+    unsigned int listCount = 0;
+    for (unsigned int fl = 0; (fl < TLSF_FL_COUNT) && ERR_IS_SUCCESS(status); fl++) {
+        if (!ctx->slBitmap[fl] != !(ctx->flBitmap & (1U << fl))) status = ERR_CORRUPT;
+        for (unsigned int sl = 0; sl < TLSF_SL_COUNT; sl++) {
+            TlsfBlock_t* block = ctx->blocks[fl][sl];
+            if (!block != !(ctx->slBitmap[fl] & (1U << sl))) status = ERR_CORRUPT;
+            for (; block && (listCount <= freeCount); block = block->nextFree) {
+                unsigned int blockFl, blockSl;
+                _Tlsf_mapInsert(_Tlsf_size(block), &blockFl, &blockSl);
+                if (!_Tlsf_isFree(block) || (blockFl != fl) || (blockSl != sl)) status = ERR_CORRUPT;
+                listCount++;
+            }
+        }
+    }
+    if ((listCount != freeCount) || (freeCount != ctx->freeBlocks) || (usedCount != ctx->usedBlocks)) status = ERR_CORRUPT;
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    return status;
+}
+
+/*
+ * C Library Heap
+ */
+
+#ifdef TLSF_HEAP
+
+#ifndef TLSF_HEAP_SCATTER
+#define TLSF_HEAP_SCATTER ARM_LIB_STACKHEAP
+#endif
+
+// Reserved at the top of the region for the stack
+#ifndef TLSF_HEAP_STACK_SIZE
+#define TLSF_HEAP_STACK_SIZE 0x10000
+#endif
+
+#define TLSF_HEAP_BASE_LINK  SCATTER_REGION_BASE(TLSF_HEAP_SCATTER,ZI)
+#define TLSF_HEAP_LIMIT_LINK SCATTER_REGION_LIMIT(TLSF_HEAP_SCATTER,ZI)
+
+extern unsigned int TLSF_HEAP_BASE_LINK;
+extern unsigned int TLSF_HEAP_LIMIT_LINK;
+
+#if defined(__ARMCC_VERSION)
+// Stop the C library setting up its own heap in the region
+__asm(".global __use_no_heap_region\n\t");
+#endif
+
+static TlsfCtx_t* _Tlsf_heapCtx = NULL;
+
+// Get the C library heap pool
+//  - Creates the heap if not already.
+TlsfCtx_t* Tlsf_heap(void) {
+    if (!_Tlsf_heapCtx) {
+        uintptr_t base  = (uintptr_t)&TLSF_HEAP_BASE_LINK;
+        uintptr_t limit = (uintptr_t)&TLSF_HEAP_LIMIT_LINK;
+        if ((limit - base) > TLSF_HEAP_STACK_SIZE) {
+            Tlsf_initialise((void*)base, (limit - base) - TLSF_HEAP_STACK_SIZE, &_Tlsf_heapCtx);
+        }
+    }
+    return _Tlsf_heapCtx;
+}
+
+void* malloc(size_t size) {
+    return Tlsf_malloc(Tlsf_heap(), size);
+}
+
+void* calloc(size_t count, size_t size) {
+    return Tlsf_calloc(Tlsf_heap(), count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    return Tlsf_realloc(Tlsf_heap(), ptr, size);
+}
+
+void free(void* ptr) {
+    Tlsf_free(Tlsf_heap(), ptr);
+}
+
+#endif
@@ -0,0 +1,184 @@
+/*
+ * TLSF Heap Allocator
+ * -------------------
+ *
+ * Two-level segregated fit allocator, with constant time
+ * allocation and free, and good resistance to fragmentation
+ * for long running images.
+ *
+ * Free blocks are kept in lists by size. The first level splits
+ * sizes by power of two, and the second level splits each power
+ * of two into 32 linear ranges, with a bitmap of non-empty lists
+ * at each level. Allocation rounds the size up to the next range
+ * and takes the first block of the first non-empty list at or
+ * above it, so never searches a list. Blocks are split when
+ * allocated, and merged with free neighbours when freed.
+ *
+ * Pools
+ * -----
+ *
+ * The control structure is placed at the start of the pool memory,
+ * so no other heap is needed to create one. Separate pools can be
+ * made for different memories, e.g. a small fast pool in the
+ * on-chip RAM alongside the main heap in DDR:
+ *
+ *    Tlsf_initialise(ocramBuf, sizeof(ocramBuf), &fastHeap);
+ *    p = Tlsf_malloc(fastHeap, 256);
+ *
+ * More memory can be added to a pool with Tlsf_addPool(). Each pool
+ * may be up to 2GB. All of the APIs are safe to call with interrupts
+ * enabled and from both cores.
+ *
+ * C Library Heap
+ * --------------
+ *
+ * To replace the C library heap (malloc, free, calloc, realloc),
+ * globally define:
+ *
+ *     -D TLSF_HEAP
+ *
+ * The heap is then created on first use from the ARM_LIB_STACKHEAP
+ * scatter region (see ScatterFiles/DDRRam.scat), leaving the top
+ * TLSF_HEAP_STACK_SIZE bytes (default 64kB) for the application stack
+ * which grows down from the top of the region. A different region can
+ * be used by globally defining TLSF_HEAP_SCATTER, in which case set
+ * TLSF_HEAP_STACK_SIZE to 0 if the stack is elsewhere. Tlsf_heap()
+ * returns the heap pool so that its statistics can be read.
+ *
+ * Note for OnChipRam.scat, the region is only 0x3B00 bytes, so the
+ * stack size must be reduced to leave room for a heap.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef TLSF_H_
+#define TLSF_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/irq.h"
+#include "Util/error.h"
+
+// Allocation alignment
+#define TLSF_ALIGN_LOG2   3
+#define TLSF_ALIGN        (1U << TLSF_ALIGN_LOG2)
+
+// Second level lists per power of two
+#define TLSF_SL_LOG2      5
+#define TLSF_SL_COUNT     (1U << TLSF_SL_LOG2)
+
+// First level lists. Sizes below 2^TLSF_FL_SHIFT are all in the first.
+#define TLSF_FL_SHIFT     (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_COUNT     (32 - TLSF_FL_SHIFT)
+
+// Memory block
+//  - The header is prevPhys and size. For free blocks the links to
+//    the neighbouring blocks in the free list follow in the data.
+typedef struct TlsfBlock_t TlsfBlock_t;
+struct TlsfBlock_t {
+    TlsfBlock_t* prevPhys;  // Previous block in memory, NULL if first in pool
+    size_t       size;      // Data bytes, bit 0 set if free
+    TlsfBlock_t* nextFree;
+    TlsfBlock_t* prevFree;
+};
+
+// Pool memory, at the start of each added region
+typedef struct TlsfPool_t TlsfPool_t;
+struct TlsfPool_t {
+    TlsfPool_t* next;
+    size_t      size;       // Bytes of blocks following
+};
+
+// Pool statistics
+typedef struct {
+    size_t total;        // Bytes in all pools, excluding control structures
+    size_t used;         // Bytes allocated, including block headers
+    size_t peakUsed;     // Highest ever used
+    size_t free;         // Bytes available to allocate, excluding headers
+    size_t largestFree;  // Largest free block. Sizes are rounded up to the next list
+                         // when allocating, so up to 1/32 less than this will fit.
+    unsigned int usedBlocks;
+    unsigned int freeBlocks;
+    unsigned int fragmentation; // Percentage of free space not in the largest block
+} TlsfStats_t;
+
+// TLSF Pool Context
+typedef struct {
+    uint32_t     magic;
+    IrqSpinlock_t lock;
+    TlsfPool_t*  pools;
+    uint32_t     flBitmap;
+    uint32_t     slBitmap[TLSF_FL_COUNT];
+    TlsfBlock_t* blocks[TLSF_FL_COUNT][TLSF_SL_COUNT];
+    // Statistics
+    size_t       total;
+    size_t       used;
+    size_t       peakUsed;
+    unsigned int usedBlocks;
+    unsigned int freeBlocks;
+} TlsfCtx_t;
+
+// Initialise a TLSF pool
+//  - mem is the pool memory of size bytes. The context is placed at its start.
+//  - Returns ERR_TOOSMALL if there is no room for blocks after the context.
+//  - Returns context pointer to *ctx
+HpsErr_t Tlsf_initialise(void* mem, size_t size, TlsfCtx_t** pCtx);
+
+// Check if pool initialised
+bool Tlsf_isInitialised(TlsfCtx_t* ctx);
+
+// Add memory to a pool
+//  - mem is size bytes, which need not be next to the existing memory.
+HpsErr_t Tlsf_addPool(TlsfCtx_t* ctx, void* mem, size_t size);
+
+// Allocate size bytes
+//  - Returns NULL if there is no space.
+void* Tlsf_malloc(TlsfCtx_t* ctx, size_t size);
+
+// Allocate size bytes aligned to align
+//  - align must be a power of two.
+//  - Returns NULL if there is no space.
+void* Tlsf_memalign(TlsfCtx_t* ctx, size_t align, size_t size);
+
+// Allocate count elements of size bytes, initialised to zero
+//  - Returns NULL if there is no space.
+void* Tlsf_calloc(TlsfCtx_t* ctx, size_t count, size_t size);
+
+// Resize an allocation
+//  - Grows in place if the next block is free, otherwise moves it.
+//  - Returns NULL if there is no space, leaving ptr allocated.
+void* Tlsf_realloc(TlsfCtx_t* ctx, void* ptr, size_t size);
+
+// Free an allocation
+//  - ptr may be NULL.
+void Tlsf_free(TlsfCtx_t* ctx, void* ptr);
+
+// Get the usable size of an allocation
+size_t Tlsf_blockSize(void* ptr);
+
+// Get pool statistics
+HpsErr_t Tlsf_getStats(TlsfCtx_t* ctx, TlsfStats_t* stats);
+
+// Check pool integrity
+//  - Walks every block, checking the links and free lists agree.
+//  - Returns ERR_CORRUPT if not.
+HpsErr_t Tlsf_check(TlsfCtx_t* ctx);
+
+#ifdef TLSF_HEAP
+// Get the C library heap pool
+//  - Creates the heap if not already.
+TlsfCtx_t* Tlsf_heap(void);
+#endif
+
+#endif /* TLSF_H_ */
@@ -0,0 +1,239 @@
+/*
+ * Binary Trace Buffer
+ * -------------------
+ *
+ * Provides a low overhead in-RAM trace of timestamped binary
+ * records, as an alternative to printf over semihosting for
+ * telemetry. Semihosting traps to the debugger, stalling the
+ * core for milliseconds, whereas adding a trace record takes
+ * tens of cycles.
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add multi-record events
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "trace.h"
+
+#include <string.h>
+
+#include "Util/macros.h"
+#include "Util/profile.h"
+#include "Util/hwlib/alt_globaltmr.h"
+
+// Published by hwlib, but not in the header
+extern bool alt_globaltmr_is_running(void);
+
+// Most records in a buffer. Positions are kept to 16 bits in each record's
+// tag, so this must be small enough for stale tags to never match.
+#define TRACE_MAX_RECORDS 0x8000
+
+/*
+ * Internal Functions
+ */
+
+// Write a record at a claimed position
+static void _Trace_write(TraceCtx_t* ctx, unsigned int pos, uint16_t id, uint32_t timestamp, uint32_t arg0, uint32_t arg1) {
+    TraceRecord_t* rec = &ctx->buffer->records[pos & ctx->mask];
+    //Mark as being written with a tag which no reader expects, so a reader
+    //part way through copying the old record sees that it changed.
+    __atomic_store_n(&rec->tag, TRACE_TAG(pos - 1, id), __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    rec->timestamp = timestamp;
+    rec->arg0 = arg0;
+    rec->arg1 = arg1;
+    //Publish
+    __atomic_store_n(&rec->tag, TRACE_TAG(pos, id), __ATOMIC_RELEASE);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Trace
+//  - buffer is the memory to hold the trace, of size bytes. It must be word aligned.
+//  - The record count is the largest power of two that fits after the header, at least 2.
+//  - Starts the global timer if not already running.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t Trace_initialise(void* buffer, size_t size, TraceCtx_t** pCtx) {
+    //Ensure user pointers valid
+    if (!buffer) return ERR_NULLPTR;
+    if ((uintptr_t)buffer & (sizeof(uint32_t) - 1)) return ERR_ALIGNMENT;
+    if (size < (sizeof(TraceBuffer_t) + 2 * sizeof(TraceRecord_t))) return ERR_TOOSMALL;
+    //Largest power of two number of records that fits
+    size_t fits = (size - sizeof(TraceBuffer_t)) / sizeof(TraceRecord_t);
+    unsigned int count = 2;
+    while ((count < TRACE_MAX_RECORDS) && ((count * 2) <= fits)) {
+        count = count * 2;
+    }
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Timestamps come from the global timer
+    if (!alt_globaltmr_is_running()) {
+        alt_globaltmr_init();
+    }
+    //Populate the buffer. Magic last so a debugger only sees a complete header.
+    TraceBuffer_t* buf = (TraceBuffer_t*)buffer;
+    buf->magic = 0;
+    buf->count = count;
+    buf->head = 0;
+    buf->rate = Profile_timestampRate();
+    for (unsigned int idx = 0; idx < count; idx++) {
+        buf->records[idx].tag = 0;
+    }
+    __atomic_store_n(&buf->magic, TRACE_MAGIC, __ATOMIC_RELEASE);
+    //Populate the context
+    TraceCtx_t* ctx = *pCtx;
+    ctx->buffer = buf;
+    ctx->mask = count - 1;
+    ctx->tail = 0;
+    ctx->lost = 0;
+    ctx->uart = NULL;
+    ctx->frameSent = sizeof(ctx->frame);
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool Trace_isInitialised(TraceCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Add a trace record
+//  - Safe to call from any context. Overwrites the oldest record if full.
+HpsErr_t Trace_event(TraceCtx_t* ctx, uint16_t id, uint32_t arg0, uint32_t arg1) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    uint32_t timestamp = alt_globaltmr_counter_get_low32();
+    //Claim the next position. Never fails, the oldest record is overwritten.
+    unsigned int pos = __atomic_fetch_add(&ctx->buffer->head, 1, __ATOMIC_RELAXED);
+    _Trace_write(ctx, pos, id, timestamp, arg0, arg1);
+    return ERR_SUCCESS;
+}
+
+// Add consecutive trace records
+//  - The first record has event ID id, and the rest contId. Each holds two
+//    of the count args in turn, the last padded with 0 if count is odd.
+//  - All records have the same timestamp.
+//  - Safe to call from any context. Overwrites the oldest records if full.
+//  - Returns ERR_TOOBIG if there are more records than fit in the buffer.
+HpsErr_t Trace_eventMulti(TraceCtx_t* ctx, uint16_t id, uint16_t contId, const uint32_t* args, unsigned int count) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (count && !args) return ERR_NULLPTR;
+    unsigned int records = count ? ((count + 1) / 2) : 1;
+    if (records > (ctx->mask + 1)) return ERR_TOOBIG;
+    uint32_t timestamp = alt_globaltmr_counter_get_low32();
+    //Claim all of the positions at once so that they are consecutive
+    unsigned int pos = __atomic_fetch_add(&ctx->buffer->head, records, __ATOMIC_RELAXED);
+    for (unsigned int idx = 0; idx < records; idx++) {
+        uint32_t arg0 = ((2 * idx) < count) ? args[2 * idx] : 0;
+        uint32_t arg1 = ((2 * idx + 1) < count) ? args[2 * idx + 1] : 0;
+        _Trace_write(ctx, pos + idx, idx ? contId : id, timestamp, arg0, arg1);
+    }
+    return ERR_SUCCESS;
+}
+
+// Read the next trace record
+//  - Copies the oldest unread record to *record.
+//  - Returns ERR_ISEMPTY if there are no unread records.
+HpsErr_t Trace_read(TraceCtx_t* ctx, TraceRecord_t* record) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!record) return ERR_NULLPTR;
+    TraceBuffer_t* buf = ctx->buffer;
+    unsigned int count = ctx->mask + 1;
+    while (true) {
+        unsigned int head = __atomic_load_n(&buf->head, __ATOMIC_ACQUIRE);
+        //Skip anything which has been overwritten
+        if ((head - ctx->tail) > count) {
+            ctx->lost += (head - count) - ctx->tail;
+            ctx->tail = head - count;
+        }
+        if (head == ctx->tail) return ERR_ISEMPTY;
+        //Copy the record, checking it was complete and unchanged throughout
+        TraceRecord_t* rec = &buf->records[ctx->tail & ctx->mask];
+        uint32_t tag = __atomic_load_n(&rec->tag, __ATOMIC_ACQUIRE);
+        if ((tag >> 16) == (TRACE_TAG(ctx->tail, 0) >> 16)) {
+            record->timestamp = rec->timestamp;
+            record->arg0 = rec->arg0;
+            record->arg1 = rec->arg1;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&rec->tag, __ATOMIC_RELAXED) == tag) {
+                record->tag = tag;
+                ctx->tail++;
+                return ERR_SUCCESS;
+            }
+        } else if ((__atomic_load_n(&buf->head, __ATOMIC_ACQUIRE) - ctx->tail) <= count) {
+            //Not overwritten, so still being written. Try again later.
+            return ERR_ISEMPTY;
+        }
+        //Overwritten while reading. Skip ahead.
+    }
+}
+
+// Set the UART used by Trace_drain()
+//  - uart may be NULL to stop draining.
+HpsErr_t Trace_setUart(TraceCtx_t* ctx, UartCtx_t* uart) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    ctx->uart = uart;
+    return ERR_SUCCESS;
+}
+
+// Drain unread records to the UART
+//  - Sends as many frames as fit in the UART TX FIFO without waiting.
+//    A partly sent frame is completed on the next call.
+//  - Returns the number of records started, or an error code.
+HpsErr_t Trace_drain(TraceCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ctx->uart) return ERR_NOTREADY;
+    HpsErr_t count = 0;
+    while (true) {
+        if (ctx->frameSent >= sizeof(ctx->frame)) {
+            //Start the next frame
+            TraceRecord_t rec;
+            if (Trace_read(ctx, &rec) != ERR_SUCCESS) break;
+            ctx->frame[0] = TRACE_FRAME_SYNC0;
+            ctx->frame[1] = TRACE_FRAME_SYNC1;
+            memcpy(&ctx->frame[2], &rec, sizeof(rec));
+            ctx->frameSent = 0;
+            count++;
+        }
+        //Send as much of it as will fit
+        status = UART_transmit(ctx->uart, &ctx->frame[ctx->frameSent], sizeof(ctx->frame) - ctx->frameSent);
+        if (ERR_IS_ERROR(status)) return status;
+        ctx->frameSent += status;
+        if (ctx->frameSent < sizeof(ctx->frame)) break;
+    }
+    return count;
+}
+
+// Get number of lost records
+//  - Returns the number of records overwritten before being read.
+//    If clear is true, the count is reset.
+HpsErr_t Trace_getLost(TraceCtx_t* ctx, bool clear) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t lost = (HpsErr_t)min(ctx->lost, (unsigned int)INT32_MAX);
+    if (clear) ctx->lost = 0;
+    return lost;
+}
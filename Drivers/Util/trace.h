@@ -0,0 +1,184 @@
+/*
+ * Binary Trace Buffer
+ * -------------------
+ *
+ * Provides a low overhead in-RAM trace of timestamped binary
+ * records, as an alternative to printf over semihosting for
+ * telemetry. Semihosting traps to the debugger, stalling the
+ * core for milliseconds, whereas adding a trace record takes
+ * tens of cycles.
+ *
+ * Each record holds an event ID, two 32-bit arguments, and a
+ * timestamp from the lower word of the ARM global timer:
+ *
+ *    static uint8_t traceMem[4096];
+ *    Trace_initialise(traceMem, sizeof(traceMem), &trace);
+ *    Trace_setUart(trace, &uart->uart);
+ *    ...
+ *    TRACE(trace, MY_ID_BLOCK_DONE, blockIdx, samples);
+ *    ...
+ *    // Main loop
+ *    Trace_drain(trace);
+ *
+ * Adding Records
+ * --------------
+ *
+ * Trace_event() may be called from any context, including IRQ
+ * handlers and the other core, without masking interrupts. The
+ * buffer is a ring which overwrites its oldest records when full,
+ * so adding a record never fails or blocks. A reader which falls
+ * behind skips the overwritten records, counting them as lost.
+ *
+ * Trace_eventMulti() adds several records at consecutive positions,
+ * for events with more than two arguments. Event IDs from
+ * TRACE_ID_RESERVED upwards are used by Util/binlog and
+ * Util/func_trace.
+ *
+ * Reading Records
+ * ---------------
+ *
+ * Records can be read in order with Trace_read(), or drained
+ * asynchronously to a UART with Trace_drain(), which sends only
+ * as much as the TX FIFO has space for. Each record is sent as
+ * a frame of the two TRACE_FRAME_SYNC bytes followed by the
+ * record bytes (little endian). Only one context may read.
+ *
+ * Post-Mortem
+ * -----------
+ *
+ * The buffer starts with a TraceBuffer_t header holding the magic
+ * word TRACE_MAGIC, the record count, the position of the next
+ * record to write (head), and the timestamp rate. A debugger can
+ * read the buffer from memory after a crash: the newest record is
+ * at index (head - 1) modulo count, and the valid records are the
+ * count (or head if smaller) before it. Each record's tag encodes
+ * its position, so partially written records can be discarded.
+ *
+ * Tracing can be compiled out without removing the TRACE() calls
+ * by globally defining TRACE_DISABLE.
+ *
+ * Requires Util/hwlib/alt_globaltmr.c for the global timer.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Add multi-record events
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_uart.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Magic word at the start of the buffer ("TRCE")
+#define TRACE_MAGIC        0x45435254
+
+// Frame sync bytes sent before each record by Trace_drain()
+#define TRACE_FRAME_SYNC0  0xA5
+#define TRACE_FRAME_SYNC1  0x5A
+
+// Record tag is (position + 1) in the upper 16 bits, and the event ID in the lower 16 bits.
+#define TRACE_TAG(pos, id) ((((uint32_t)(pos) + 1) << 16) | ((uint32_t)(id) & 0xFFFF))
+#define TRACE_TAG_ID(tag)  ((uint16_t)((tag) & 0xFFFF))
+
+// First of the event IDs reserved for other utilities
+#define TRACE_ID_RESERVED  0xF000
+
+// Trace record
+typedef struct {
+    volatile uint32_t tag;        // Written last once the rest of the record is valid
+    uint32_t          timestamp;  // Global timer ticks (lower word)
+    uint32_t          arg0;
+    uint32_t          arg1;
+} TraceRecord_t;
+
+// Trace buffer in memory, as seen by a debugger
+typedef struct {
+    uint32_t          magic;      // TRACE_MAGIC
+    uint32_t          count;      // Number of records (power of two)
+    volatile uint32_t head;       // Position of next record to write
+    uint32_t          rate;       // Timestamp rate in Hz
+    TraceRecord_t     records[];
+} TraceBuffer_t;
+
+// Trace Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    TraceBuffer_t* buffer;
+    unsigned int   mask;          // Record count - 1
+    unsigned int   tail;          // Position of next record to read
+    unsigned int   lost;          // Records overwritten before being read
+    //UART drain
+    UartCtx_t*     uart;
+    uint8_t        frame[2 + sizeof(TraceRecord_t)];
+    unsigned int   frameSent;     // Bytes of frame sent. sizeof(frame) if none pending.
+} TraceCtx_t;
+
+// Trace macro
+//  - Adds a record, or does nothing if TRACE_DISABLE is defined.
+#ifndef TRACE_DISABLE
+#define TRACE(ctx, id, arg0, arg1) Trace_event((ctx), (id), (arg0), (arg1))
+#else
+#define TRACE(ctx, id, arg0, arg1) do {} while (0)
+#endif
+
+// Initialise Trace
+//  - buffer is the memory to hold the trace, of size bytes. It must be word aligned.
+//  - The record count is the largest power of two that fits after the header, at least 2.
+//  - Starts the global timer if not already running.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t Trace_initialise(void* buffer, size_t size, TraceCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool Trace_isInitialised(TraceCtx_t* ctx);
+
+// Add a trace record
+//  - Safe to call from any context. Overwrites the oldest record if full.
+HpsErr_t Trace_event(TraceCtx_t* ctx, uint16_t id, uint32_t arg0, uint32_t arg1);
+
+// Add consecutive trace records
+//  - The first record has event ID id, and the rest contId. Each holds two
+//    of the count args in turn, the last padded with 0 if count is odd.
+//  - All records have the same timestamp.
+//  - Safe to call from any context. Overwrites the oldest records if full.
+//  - Returns ERR_TOOBIG if there are more records than fit in the buffer.
+HpsErr_t Trace_eventMulti(TraceCtx_t* ctx, uint16_t id, uint16_t contId, const uint32_t* args, unsigned int count);
+
+// Read the next trace record
+//  - Copies the oldest unread record to *record.
+//  - Returns ERR_ISEMPTY if there are no unread records.
+HpsErr_t Trace_read(TraceCtx_t* ctx, TraceRecord_t* record);
+
+// Set the UART used by Trace_drain()
+//  - uart may be NULL to stop draining.
+HpsErr_t Trace_setUart(TraceCtx_t* ctx, UartCtx_t* uart);
+
+// Drain unread records to the UART
+//  - Sends as many frames as fit in the UART TX FIFO without waiting.
+//    A partly sent frame is completed on the next call.
+//  - Returns the number of records started, or an error code.
+HpsErr_t Trace_drain(TraceCtx_t* ctx);
+
+// Get number of lost records
+//  - Returns the number of records overwritten before being read.
+//    If clear is true, the count is reset.
+HpsErr_t Trace_getLost(TraceCtx_t* ctx, bool clear);
+
+#endif /* TRACE_H_ */
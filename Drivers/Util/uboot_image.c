@@ -9,6 +9,7 @@
 
 #include "uboot_image.h"
 #include "crc32.h"
+#include "lz4.h"
 #include <string.h>
 
 /*****************************************************************************/
@@ -36,3 +37,48 @@ int image_check_dcrc(const struct legacy_img_hdr *hdr)
     ulong dcrc = crc32_wd(0, (unsigned char *)data, len, CHUNKSZ_CRC32);
     return (dcrc == image_get_dcrc(hdr));
 }
+
+void image_dcrc_stream_init(struct image_dcrc_stream *stream, const struct legacy_img_hdr *hdr)
+{
+    stream->crc = 0;
+    stream->done = 0;
+    stream->size = image_get_data_size(hdr);
+    stream->dcrc = image_get_dcrc(hdr);
+}
+
+void image_dcrc_stream_update(struct image_dcrc_stream *stream, const void *data, uint32_t len)
+{
+    /* Anything past the end of the data is padding, so ignored */
+    if (len > stream->size - stream->done)
+        len = stream->size - stream->done;
+    if (!len)
+        return;
+    stream->crc = crc32(stream->crc, (const unsigned char *)data, len);
+    stream->done += len;
+}
+
+int image_dcrc_stream_check(const struct image_dcrc_stream *stream)
+{
+    return (stream->done == stream->size) && (stream->crc == stream->dcrc);
+}
+
+HpsErr_t image_decomp(const struct legacy_img_hdr *hdr, void *dest, uint32_t size)
+{
+    const void *data = (const void *)image_get_data(hdr);
+    uint32_t len = image_get_data_size(hdr);
+
+    if (!dest)
+        return ERR_NULLPTR;
+    switch (image_get_comp(hdr)) {
+    case IH_COMP_NONE:
+        if (len > size)
+            return ERR_NOSPACE;
+        /* Load address may overlap where the image was read to */
+        memmove(dest, data, len);
+        return (HpsErr_t)len;
+    case IH_COMP_LZ4:
+        return lz4_decompressFrame(data, len, dest, size);
+    default:
+        return ERR_NOSUPPORT;
+    }
+}
@@ -15,6 +15,7 @@
 
 #include "Util/ct_assert.h"
 #include "Util/bit_helpers.h"
+#include "Util/error.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -402,6 +403,30 @@ static inline void image_set_name(struct legacy_img_hdr *hdr, const char *name)
 int image_check_hcrc(const struct legacy_img_hdr *hdr);
 int image_check_dcrc(const struct legacy_img_hdr *hdr);
 
+/*
+ * Streaming data CRC check. Allows the data CRC to be calculated
+ * a piece at a time while the image is still being loaded, e.g.
+ * checking one chunk while the next is being read.
+ */
+struct image_dcrc_stream {
+    uint32_t crc;               /* Running data CRC          */
+    uint32_t done;              /* Data bytes processed      */
+    uint32_t size;              /* Data size from header     */
+    uint32_t dcrc;              /* Expected CRC from header  */
+};
+
+void image_dcrc_stream_init(struct image_dcrc_stream *stream, const struct legacy_img_hdr *hdr);
+void image_dcrc_stream_update(struct image_dcrc_stream *stream, const void *data, uint32_t len);
+int image_dcrc_stream_check(const struct image_dcrc_stream *stream);
+
+/*
+ * Decompress the image data to dest, which has space for size bytes,
+ * e.g. to (void *)image_get_load(hdr). Supports IH_COMP_NONE and
+ * IH_COMP_LZ4 (Util/lz4.h). Returns the decompressed length, or an
+ * error code (ERR_NOSUPPORT for other compression types).
+ */
+HpsErr_t image_decomp(const struct legacy_img_hdr *hdr, void *dest, uint32_t size);
+
 static inline int image_check_magic(const struct legacy_img_hdr *hdr)
 {
     return (image_get_magic(hdr) == IH_MAGIC);
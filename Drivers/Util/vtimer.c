@@ -0,0 +1,466 @@
+/*
+ * Virtual Timer Multiplexer
+ * -------------------------
+ *
+ * Provides any number of virtual timers running from a single
+ * hardware timer. Each virtual timer implements the generic
+ * timer interface (Util/driver_timer.h).
+ *
+ * Virtual timer deadlines are kept as 64-bit hardware tick
+ * counts, so they never wrap, and the heap only needs to
+ * compare them directly.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "vtimer.h"
+#include "Util/mem_pool.h"
+
+/*
+ * Internal Functions
+ */
+
+// Place a virtual timer at a heap position
+static inline void _VTimerMgr_heapSet(VTimerMgrCtx_t* ctx, unsigned int idx, VTimerCtx_t* vt) {
+    ctx->heap[idx] = vt;
+    vt->heapIdx = idx;
+}
+
+// Move heap entry up until it is after its parent
+static void _VTimerMgr_siftUp(VTimerMgrCtx_t* ctx, unsigned int idx) {
+    VTimerCtx_t* vt = ctx->heap[idx];
+    while (idx) {
+        unsigned int parent = (idx - 1) / 2;
+        if (vt->deadline >= ctx->heap[parent]->deadline) break;
+        _VTimerMgr_heapSet(ctx, idx, ctx->heap[parent]);
+        idx = parent;
+    }
+    _VTimerMgr_heapSet(ctx, idx, vt);
+}
+
+// Move heap entry down until it is before its children
+static void _VTimerMgr_siftDown(VTimerMgrCtx_t* ctx, unsigned int idx) {
+    VTimerCtx_t* vt = ctx->heap[idx];
+    while (true) {
+        unsigned int child = 2 * idx + 1;
+        if (child >= ctx->heapCount) break;
+        if (((child + 1) < ctx->heapCount) && (ctx->heap[child + 1]->deadline < ctx->heap[child]->deadline)) {
+            child++;
+        }
+        if (ctx->heap[child]->deadline >= vt->deadline) break;
+        _VTimerMgr_heapSet(ctx, idx, ctx->heap[child]);
+        idx = child;
+    }
+    _VTimerMgr_heapSet(ctx, idx, vt);
+}
+
+// Remove a virtual timer from the heap if present
+static void _VTimerMgr_heapRemove(VTimerMgrCtx_t* ctx, VTimerCtx_t* vt) {
+    unsigned int idx = vt->heapIdx;
+    if ((idx >= ctx->heapCount) || (ctx->heap[idx] != vt)) return;
+    vt->heapIdx = VTIMER_HEAP_NONE;
+    // Move the last entry into the gap, then restore heap order
+    ctx->heapCount--;
+    if (idx == ctx->heapCount) return;
+    _VTimerMgr_heapSet(ctx, idx, ctx->heap[ctx->heapCount]);
+    _VTimerMgr_siftDown(ctx, idx);
+    VTimerCtx_t* moved = ctx->heap[idx];
+    _VTimerMgr_siftUp(ctx, moved->heapIdx);
+}
+
+// Add a virtual timer to the heap
+//  - Must not already be in the heap. There is always space, as the heap
+//    is sized for every virtual timer.
+static void _VTimerMgr_heapInsert(VTimerMgrCtx_t* ctx, VTimerCtx_t* vt) {
+    _VTimerMgr_heapSet(ctx, ctx->heapCount, vt);
+    ctx->heapCount++;
+    _VTimerMgr_siftUp(ctx, vt->heapIdx);
+}
+
+// Get the current time base
+//  - Lock must be held.
+static unsigned long long _VTimerMgr_now(VTimerMgrCtx_t* ctx) {
+    unsigned int remaining = 0;
+    Timer_getTime(ctx->hw, &remaining);
+    unsigned long long now = ctx->base;
+    if (Timer_checkOverflow(ctx->hw, false) > 0) {
+        //Wrapped, but not yet handled. Read again to be sure the count is
+        //from after the wrap.
+        Timer_getTime(ctx->hw, &remaining);
+        now += ctx->hwLoad + 1ULL;
+    }
+    if (remaining > ctx->hwLoad) remaining = ctx->hwLoad;
+    return now + (ctx->hwLoad - remaining);
+}
+
+// Reload the hardware timer for the earliest deadline
+//  - Lock must be held.
+static void _VTimerMgr_rearm(VTimerMgrCtx_t* ctx) {
+    unsigned long long now = _VTimerMgr_now(ctx);
+    unsigned long long wait = UINT32_MAX;
+    if (ctx->heapCount) {
+        unsigned long long deadline = ctx->heap[0]->deadline;
+        wait = (deadline > now) ? (deadline - now) : 0;
+        if (wait > UINT32_MAX) wait = UINT32_MAX;
+    }
+    //Load value of at least 1, as the period is one more than it
+    unsigned int load = (wait > 2) ? (unsigned int)(wait - 1) : 1;
+    Timer_disable(ctx->hw);
+    Timer_checkOverflow(ctx->hw, true);
+    Timer_configure(ctx->hw, TIMER_MODE_FREERUN, ctx->prescaler, load);
+    ctx->base = now;
+    ctx->hwLoad = load;
+    Timer_enable(ctx->hw, 0);
+}
+
+// Get the length of a virtual timer period in hardware ticks
+static inline unsigned long long _VTimer_period(VTimerCtx_t* vt) {
+    return (vt->runLoad + 1ULL) * (vt->prescaler + 1ULL);
+}
+
+// Start a virtual timer from now
+//  - Lock must be held.
+static void _VTimer_start(VTimerCtx_t* vt) {
+    VTimerMgrCtx_t* mgr = vt->mgr;
+    _VTimerMgr_heapRemove(mgr, vt);
+    vt->start = _VTimerMgr_now(mgr);
+    vt->deadline = vt->start + _VTimer_period(vt);
+    vt->running = true;
+    _VTimerMgr_heapInsert(mgr, vt);
+    //Only need to reload the hardware if it is now the earliest
+    if (vt->heapIdx == 0) _VTimerMgr_rearm(mgr);
+}
+
+#if defined(__arm__)
+// Hardware timer interrupt
+static void __irq _VTimerMgr_isr(HPSIRQSource interruptID, void* param, bool* handled) {
+    VTimerMgrCtx_t* ctx = (VTimerMgrCtx_t*)param;
+    if (!ctx) return;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    //Account for the completed hardware period
+    if (Timer_checkOverflow(ctx->hw, true) > 0) {
+        ctx->base += ctx->hwLoad + 1ULL;
+    }
+    //Handle each virtual timer which is due
+    while (ctx->heapCount) {
+        VTimerCtx_t* vt = ctx->heap[0];
+        unsigned long long now = _VTimerMgr_now(ctx);
+        if (vt->deadline > now) break;
+        _VTimerMgr_heapRemove(ctx, vt);
+        if (vt->mode == TIMER_MODE_ONESHOT) {
+            vt->running = false;
+        } else {
+            //Next period, skipping any which have been missed
+            unsigned long long period = _VTimer_period(vt);
+            vt->start = vt->deadline + (((now - vt->deadline) / period) * period);
+            vt->deadline = vt->start + period;
+            _VTimerMgr_heapInsert(ctx, vt);
+        }
+        vt->overflowed = true;
+        //Callback without the lock, as it may use the virtual timers
+        VTimerFunc_t callback = vt->callback;
+        void* cbParam = vt->param;
+        if (callback) {
+            IRQ_spinUnlock(&ctx->lock, irqState);
+            callback(cbParam);
+            irqState = IRQ_spinLock(&ctx->lock);
+        }
+    }
+    _VTimerMgr_rearm(ctx);
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    *handled = true;
+}
+#endif
+
+/*
+ * Generic Timer Interface
+ */
+
+static HpsErr_t _VTimer_enable(void* ctx, unsigned int fraction) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqState = IRQ_spinLock(&vt->mgr->lock);
+    vt->runLoad = fraction ? (vt->load / fraction) : vt->load;
+    _VTimer_start(vt);
+    IRQ_spinUnlock(&vt->mgr->lock, irqState);
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _VTimer_disable(void* ctx) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqState = IRQ_spinLock(&vt->mgr->lock);
+    _VTimerMgr_heapRemove(vt->mgr, vt);
+    vt->running = false;
+    IRQ_spinUnlock(&vt->mgr->lock, irqState);
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _VTimer_getLoad(void* ctx, unsigned int* time) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!time) return ERR_NULLPTR;
+    *time = vt->load;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _VTimer_getTime(void* ctx, unsigned int* time) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!time) return ERR_NULLPTR;
+    HpsErr_t irqState = IRQ_spinLock(&vt->mgr->lock);
+    if (!vt->running) {
+        //Stopped one-shot timers finish at zero
+        *time = vt->overflowed ? 0 : vt->runLoad;
+    } else {
+        //Count down from the load value, as a hardware timer would
+        unsigned long long elapsed = (_VTimerMgr_now(vt->mgr) - vt->start) / (vt->prescaler + 1ULL);
+        if (elapsed > vt->runLoad) {
+            //Expiry not yet handled
+            elapsed = (vt->mode == TIMER_MODE_ONESHOT) ? vt->runLoad : (elapsed % (vt->runLoad + 1ULL));
+        }
+        *time = vt->runLoad - (unsigned int)elapsed;
+    }
+    IRQ_spinUnlock(&vt->mgr->lock, irqState);
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _VTimer_getRate(void* ctx, unsigned int prescalar, unsigned int* rate) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!rate) return ERR_NULLPTR;
+    if (prescalar == UINT32_MAX) prescalar = vt->prescaler;
+    *rate = (unsigned int)(vt->mgr->rate / (prescalar + 1ULL));
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _VTimer_getMode(void* ctx, TimerMode* mode) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!mode) return ERR_NULLPTR;
+    *mode = vt->mode;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t _VTimer_checkOverflow(void* ctx, bool autoClear) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqState = IRQ_spinLock(&vt->mgr->lock);
+    bool overflowed = vt->overflowed;
+    if (autoClear) vt->overflowed = false;
+    IRQ_spinUnlock(&vt->mgr->lock, irqState);
+    return overflowed ? 1 : 0;
+}
+
+static HpsErr_t _VTimer_configure(void* ctx, TimerMode mode, unsigned int prescalar, unsigned int loadValue) {
+    VTimerCtx_t* vt = (VTimerCtx_t*)ctx;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(vt);
+    if (ERR_IS_ERROR(status)) return status;
+    if ((mode == TIMER_MODE_EVENT) && (loadValue != UINT32_MAX)) return ERR_WRONGMODE;
+    if ((mode != TIMER_MODE_EVENT) && (mode != TIMER_MODE_FREERUN) && (mode != TIMER_MODE_ONESHOT)) return ERR_BADID;
+    if (!loadValue) return ERR_TOOSMALL;
+    HpsErr_t irqState = IRQ_spinLock(&vt->mgr->lock);
+    vt->mode = mode;
+    if (prescalar != UINT32_MAX) vt->prescaler = prescalar;
+    vt->load = loadValue;
+    vt->runLoad = loadValue;
+    vt->overflowed = false;
+    if (mode == TIMER_MODE_ONESHOT) {
+        //One-shot waits to be enabled
+        _VTimerMgr_heapRemove(vt->mgr, vt);
+        vt->running = false;
+    } else if (vt->running) {
+        //Others carry on running with the new settings
+        _VTimer_start(vt);
+    }
+    IRQ_spinUnlock(&vt->mgr->lock, irqState);
+    return ERR_SUCCESS;
+}
+
+/*
+ * Cleanup
+ */
+
+static void _VTimerMgr_cleanup(VTimerMgrCtx_t* ctx) {
+    //Stop the hardware timer
+    if (ctx->hw) {
+        Timer_disable(ctx->hw);
+#if defined(__arm__)
+        HPS_IRQ_unregisterHandler((HPSIRQSource)ctx->irqID);
+#endif
+    }
+    if (ctx->heap) {
+        MemPool_free(ctx->heap);
+        ctx->heap = NULL;
+    }
+}
+
+static void _VTimer_cleanup(VTimerCtx_t* ctx) {
+    VTimerMgrCtx_t* mgr = ctx->mgr;
+    if (!mgr) return;
+    HpsErr_t irqState = IRQ_spinLock(&mgr->lock);
+    _VTimerMgr_heapRemove(mgr, ctx);
+    ctx->running = false;
+    mgr->timers--;
+    IRQ_spinUnlock(&mgr->lock, irqState);
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Virtual Timer Manager
+//  - hw is the hardware timer to multiplex. It is reconfigured, so must
+//    not be used by anything else.
+//  - prescaler is the value to configure the hardware timer with.
+//  - irqID is the interrupt ID of the hardware timer. A handler will be registered.
+//  - maxTimers is the maximum number of virtual timers.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t VTimerMgr_initialise(TimerCtx_t* hw, unsigned int prescaler, unsigned int irqID, unsigned int maxTimers, VTimerMgrCtx_t** pCtx) {
+    if (!maxTimers) return ERR_TOOSMALL;
+    if (!Timer_isInitialised(hw)) return ERR_BADDEVICE;
+#if defined(__arm__)
+    //Need the timer rate for virtual timers to report
+    unsigned int rate;
+    HpsErr_t status = Timer_getRate(hw, prescaler, &rate);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!rate) return ERR_NOSUPPORT;
+    //Allocate the driver context, validating return value.
+    status = DriverContextAllocateWithCleanup(pCtx, &_VTimerMgr_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save context values
+    VTimerMgrCtx_t* ctx = *pCtx;
+    ctx->prescaler = prescaler;
+    ctx->rate = rate;
+    ctx->irqID = irqID;
+    ctx->lock = IRQ_SPINLOCK_INIT;
+    ctx->heap = (VTimerCtx_t**)MemPool_calloc(maxTimers, sizeof(*ctx->heap));
+    if (!ctx->heap) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->size = maxTimers;
+    ctx->heapCount = 0;
+    ctx->timers = 0;
+    //Start the time base with the hardware timer stopped
+    status = Timer_configure(hw, TIMER_MODE_FREERUN, prescaler, UINT32_MAX);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    Timer_disable(hw);
+    Timer_checkOverflow(hw, true);
+    ctx->hw = hw;
+    ctx->base = 0;
+    ctx->hwLoad = UINT32_MAX;
+    status = HPS_IRQ_registerHandler((HPSIRQSource)irqID, &_VTimerMgr_isr, ctx);
+    if (ERR_IS_ERROR(status)) {
+        ctx->hw = NULL;
+        return DriverContextInitFail(pCtx, status);
+    }
+    status = Timer_enable(hw, 0);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool VTimerMgr_isInitialised(VTimerMgrCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Get the current time
+//  - Returns via *ticks the number of hardware timer ticks since the
+//    manager was initialised.
+HpsErr_t VTimerMgr_now(VTimerMgrCtx_t* ctx, unsigned long long* ticks) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!ticks) return ERR_NULLPTR;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    *ticks = _VTimerMgr_now(ctx);
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    return ERR_SUCCESS;
+}
+
+// Create a virtual timer
+//  - callback is optionally called from the hardware timer interrupt each
+//    time the virtual timer expires, with param.
+//  - The virtual timer starts stopped in one-shot mode. Use the generic
+//    timer APIs on &(*pCtx)->timer to configure and start it.
+//  - Returns ERR_NOSPACE if maxTimers virtual timers already exist.
+//  - Returns context pointer to *ctx
+HpsErr_t VTimer_create(VTimerMgrCtx_t* mgr, VTimerFunc_t callback, void* param, VTimerCtx_t** pCtx) {
+    //Ensure manager valid and initialised
+    HpsErr_t status = DriverContextValidate(mgr);
+    if (ERR_IS_ERROR(status)) return status;
+    //Claim a slot in the heap
+    HpsErr_t irqState = IRQ_spinLock(&mgr->lock);
+    bool full = (mgr->timers >= mgr->size);
+    if (!full) mgr->timers++;
+    IRQ_spinUnlock(&mgr->lock, irqState);
+    if (full) return ERR_NOSPACE;
+    //Allocate the driver context, validating return value.
+    status = DriverContextAllocateWithCleanup(pCtx, &_VTimer_cleanup);
+    if (ERR_IS_ERROR(status)) {
+        irqState = IRQ_spinLock(&mgr->lock);
+        mgr->timers--;
+        IRQ_spinUnlock(&mgr->lock, irqState);
+        return status;
+    }
+    //Save context values
+    VTimerCtx_t* ctx = *pCtx;
+    ctx->mgr = mgr;
+    ctx->callback = callback;
+    ctx->param = param;
+    ctx->mode = TIMER_MODE_ONESHOT;
+    ctx->prescaler = 0;
+    ctx->load = UINT32_MAX;
+    ctx->runLoad = UINT32_MAX;
+    ctx->running = false;
+    ctx->overflowed = false;
+    ctx->heapIdx = VTIMER_HEAP_NONE;
+    //Populate the generic timer interface
+    ctx->timer.ctx = ctx;
+    ctx->timer.enable = &_VTimer_enable;
+    ctx->timer.disable = &_VTimer_disable;
+    ctx->timer.getLoad = &_VTimer_getLoad;
+    ctx->timer.getTime = &_VTimer_getTime;
+    ctx->timer.getRate = &_VTimer_getRate;
+    ctx->timer.getMode = &_VTimer_getMode;
+    ctx->timer.checkOverflow = &_VTimer_checkOverflow;
+    ctx->timer.configure = &_VTimer_configure;
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool VTimer_isInitialised(VTimerCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
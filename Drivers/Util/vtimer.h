@@ -0,0 +1,159 @@
+/*
+ * Virtual Timer Multiplexer
+ * -------------------------
+ *
+ * Provides any number of virtual timers running from a single
+ * hardware timer. Each virtual timer implements the generic
+ * timer interface (Util/driver_timer.h), so can be given to
+ * anything which takes a TimerCtx_t, such as an event manager,
+ * crc32_setTimer() or Soft_DMA_setTimeBudget(), leaving the
+ * other hardware timers free.
+ *
+ *    VTimerMgr_initialise(hpsTimer, 0, IRQ_TIMER_L4SP_1, 8, &vtMgr);
+ *    VTimer_create(vtMgr, NULL, NULL, &evtTimer);
+ *    Timer_configure(&evtTimer->timer, TIMER_MODE_EVENT, 0, UINT32_MAX);
+ *    Timer_enable(&evtTimer->timer, 0);
+ *    EventMgr_initialise(&evtTimer->timer, &evtMgr);
+ *    ...
+ *    VTimer_create(vtMgr, &blinkLed, leds, &blink);
+ *    Timer_configure(&blink->timer, TIMER_MODE_FREERUN, 0, rate / 2);
+ *    Timer_enable(&blink->timer, 0);
+ *
+ * Operation
+ * ---------
+ *
+ * Running virtual timers are kept in a min-heap ordered by their
+ * next deadline, so arming or stopping one takes O(log n). The
+ * hardware timer runs in free-running mode with its load value
+ * set to the time until the earliest deadline, and its interrupt
+ * handles every virtual timer which is due, then loads the time
+ * to the next. With nothing due, the longest period is used so
+ * the time base keeps running.
+ *
+ * The time base is a 64-bit count of hardware timer ticks made
+ * from the hardware periods completed so far plus the progress
+ * through the current one, and can be read with VTimerMgr_now().
+ * Reloading the hardware timer for a new earliest deadline loses
+ * the few ticks taken to reload it, so the time base runs slightly
+ * slow if the earliest deadline is changed very often.
+ *
+ * Virtual Timers
+ * --------------
+ *
+ * Virtual timers behave as the hardware timer types would. They
+ * are created stopped in one-shot mode. The prescaler divides the
+ * hardware timer rate by (prescaler + 1). When a virtual timer
+ * expires its overflow flag is set and, if given, its callback is
+ * called from the hardware timer interrupt. The callback may start
+ * or stop any virtual timer, including its own.
+ *
+ * All virtual timers should be freed before their manager. The
+ * manager is protected by an IRQ-safe spinlock, so virtual timers
+ * may be used from either core, although callbacks always run on
+ * the core which handles the hardware timer interrupt.
+ *
+ * Requires HPS_IRQ.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef VTIMER_H_
+#define VTIMER_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/driver_timer.h"
+#include "Util/irq.h"
+
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Heap index of virtual timers not currently running
+#define VTIMER_HEAP_NONE UINT32_MAX
+
+// Virtual timer expiry callback
+//  - Called from the hardware timer interrupt.
+typedef void (*VTimerFunc_t)(void* param);
+
+struct _VTimerCtx_t;
+
+// Virtual Timer Manager Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    TimerCtx_t*   hw;           // Hardware timer
+    unsigned int  prescaler;    // Hardware timer prescaler
+    unsigned int  rate;         // Hardware timer ticks per second
+    unsigned int  irqID;
+    IrqSpinlock_t lock;
+    struct _VTimerCtx_t** heap; // Running virtual timers, ordered by deadline
+    unsigned int  size;         // Maximum number of virtual timers
+    unsigned int  heapCount;
+    unsigned int  timers;       // Number of virtual timers created
+    unsigned long long base;    // Time base at the start of the current hardware period
+    unsigned int  hwLoad;       // Hardware load value for the current period
+} VTimerMgrCtx_t;
+
+// Virtual Timer Context
+typedef struct _VTimerCtx_t {
+    //Header
+    DrvCtx_t header;
+    //Body
+    TimerCtx_t      timer;      // Generic timer interface for this virtual timer
+    VTimerMgrCtx_t* mgr;
+    VTimerFunc_t    callback;
+    void*           param;
+    TimerMode       mode;
+    unsigned int    prescaler;
+    unsigned int    load;       // Configured load value
+    unsigned int    runLoad;    // Load value for the current run
+    bool            running;
+    volatile bool   overflowed;
+    unsigned long long start;    // Time base at the start of the current period
+    unsigned long long deadline; // Time base at the end of the current period
+    unsigned int    heapIdx;    // Position in manager heap
+} VTimerCtx_t;
+
+// Initialise Virtual Timer Manager
+//  - hw is the hardware timer to multiplex. It is reconfigured, so must
+//    not be used by anything else.
+//  - prescaler is the value to configure the hardware timer with.
+//  - irqID is the interrupt ID of the hardware timer. A handler will be registered.
+//  - maxTimers is the maximum number of virtual timers.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t VTimerMgr_initialise(TimerCtx_t* hw, unsigned int prescaler, unsigned int irqID, unsigned int maxTimers, VTimerMgrCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool VTimerMgr_isInitialised(VTimerMgrCtx_t* ctx);
+
+// Get the current time
+//  - Returns via *ticks the number of hardware timer ticks since the
+//    manager was initialised.
+HpsErr_t VTimerMgr_now(VTimerMgrCtx_t* ctx, unsigned long long* ticks);
+
+// Create a virtual timer
+//  - callback is optionally called from the hardware timer interrupt each
+//    time the virtual timer expires, with param.
+//  - The virtual timer starts stopped in one-shot mode. Use the generic
+//    timer APIs on &(*pCtx)->timer to configure and start it.
+//  - Returns ERR_NOSPACE if maxTimers virtual timers already exist.
+//  - Returns context pointer to *ctx
+HpsErr_t VTimer_create(VTimerMgrCtx_t* mgr, VTimerFunc_t callback, void* param, VTimerCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool VTimer_isInitialised(VTimerCtx_t* ctx);
+
+#endif /* VTIMER_H_ */
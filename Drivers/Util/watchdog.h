@@ -5,6 +5,12 @@
  * Maps APIs specific to different CPU types to a
  * common set of APIs.
  *
+ * ResetWDT() is used by drivers to reset the watchdog
+ * during long operations. If the watchdog is serviced
+ * by Util/wdt_supervisor instead, globally define
+ * WDT_SUPERVISED so that ResetWDT() does nothing and
+ * only the supervisor touches the watchdog.
+ *
  * Company: University of Leeds
  * Author: T Carpenter
  *
@@ -12,6 +18,7 @@
  *
  * Date       | Changes
  * -----------+----------------------------------
+ * 14/10/2026 | Add WDT_SUPERVISED option
  * 09/04/2024 | Creation of header
  * 
  */
@@ -28,14 +35,21 @@
 // ARM uses HPS Watchdog
 #include "HPS_Watchdog/HPS_Watchdog.h"
 
-// Reset the Watchdog Timer
-#define ResetWDT() HPS_ResetWatchdog()
+// Service the Watchdog Timer
+#define ServiceWDT() HPS_ResetWatchdog()
 
 #else
 
 // No watchdog. Do nothing.
-#define ResetWDT() ((void)0)
+#define ServiceWDT() ((void)0)
+
+#endif
 
+// Reset the Watchdog Timer
+#ifdef WDT_SUPERVISED
+#define ResetWDT() ((void)0)
+#else
+#define ResetWDT() ServiceWDT()
 #endif
 
 #endif /* UTIL_WATCHDOG_H */
@@ -0,0 +1,197 @@
+/*
+ * Watchdog Supervisor
+ * -------------------
+ *
+ * Services the watchdog from a timer interrupt for as long as
+ * every registered task keeps checking in within its deadline.
+ *
+ * Deadlines are kept as 64-bit global timer timestamps, so are
+ * the same on both cores and never wrap.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "wdt_supervisor.h"
+
+#include "Util/mem_pool.h"
+#include "Util/timestamp.h"
+#include "Util/watchdog.h"
+
+/*
+ * Internal Functions
+ */
+
+// Supervisor timer callback
+//  - Called from the virtual timer interrupt every period.
+static void _WdtSupervisor_service(void* param) {
+    WdtSupCtx_t* ctx = (WdtSupCtx_t*)param;
+    if (ctx->bitten) return;
+    uint64_t now = time_now_cycles();
+    WdtSupTask_t* expired = NULL;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    for (unsigned int idx = 0; idx < ctx->size; idx++) {
+        WdtSupTask_t* task = &ctx->tasks[idx];
+        if (!task->used) continue;
+        uint32_t checkIns = task->checkIns;
+        if (checkIns != task->seen) {
+            //Checked in since last period. Restart the deadline.
+            task->seen = checkIns;
+            task->deadline = now + task->timeout;
+        } else if (now > task->deadline) {
+            task->expired = true;
+        }
+        if (task->expired && !expired) expired = task;
+    }
+    if (expired) ctx->bitten = true;
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    if (!expired) {
+        //All tasks healthy
+        ServiceWDT();
+    } else if (ctx->expired) {
+        //Watchdog will now reset the system
+        ctx->expired(expired, ctx->param);
+    }
+}
+
+/*
+ * Cleanup
+ */
+
+static void _WdtSupervisor_cleanup(WdtSupCtx_t* ctx) {
+    //Stop supervising
+    if (ctx->timer) {
+        DriverContextFree(&ctx->timer);
+    }
+    if (ctx->tasks) {
+        MemPool_free(ctx->tasks);
+        ctx->tasks = NULL;
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Watchdog Supervisor
+//  - mgr is the virtual timer manager to create the supervisor timer on.
+//  - period_us is how often to check the tasks and service the watchdog.
+//  - maxTasks is the maximum number of tasks which can be registered.
+//  - expired is optionally called with param once a task misses its deadline.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t WdtSupervisor_initialise(VTimerMgrCtx_t* mgr, unsigned int period_us, unsigned int maxTasks, WdtSupExpiredFunc_t expired, void* param, WdtSupCtx_t** pCtx) {
+    if (!maxTasks || !period_us) return ERR_TOOSMALL;
+    if (!VTimerMgr_isInitialised(mgr)) return ERR_BADDEVICE;
+    //Deadlines are measured with timestamps
+    HpsErr_t status = time_initialise();
+    if (ERR_IS_ERROR(status)) return status;
+    //Allocate the driver context, validating return value.
+    status = DriverContextAllocateWithCleanup(pCtx, &_WdtSupervisor_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Save context values
+    WdtSupCtx_t* ctx = *pCtx;
+    ctx->lock = IRQ_SPINLOCK_INIT;
+    ctx->tasks = (WdtSupTask_t*)MemPool_calloc(maxTasks, sizeof(*ctx->tasks));
+    if (!ctx->tasks) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    ctx->size = maxTasks;
+    ctx->expired = expired;
+    ctx->param = param;
+    ctx->bitten = false;
+    //Create the supervisor timer
+    status = VTimer_create(mgr, &_WdtSupervisor_service, ctx, &ctx->timer);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    unsigned int rate;
+    status = Timer_getRate(&ctx->timer->timer, UINT32_MAX, &rate);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    unsigned long long load = ((unsigned long long)rate * period_us) / 1000000;
+    if (!load) return DriverContextInitFail(pCtx, ERR_TOOSMALL);
+    if (load > UINT32_MAX) return DriverContextInitFail(pCtx, ERR_TOOBIG);
+    status = Timer_configure(&ctx->timer->timer, TIMER_MODE_FREERUN, UINT32_MAX, (unsigned int)load);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Service the watchdog now, then from the timer
+    ServiceWDT();
+    status = Timer_enable(&ctx->timer->timer, 0);
+    if (ERR_IS_ERROR(status)) return DriverContextInitFail(pCtx, status);
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool WdtSupervisor_isInitialised(WdtSupCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Register a task
+//  - name is used for diagnostics only, and must remain valid.
+//  - timeout_us is the longest time allowed between check ins. The first
+//    deadline starts from the next supervisor period.
+//  - Returns ERR_NOSPACE if maxTasks tasks are already registered.
+//  - Returns task handle to *pTask
+HpsErr_t WdtSupervisor_register(WdtSupCtx_t* ctx, const char* name, unsigned int timeout_us, WdtSupTask_t** pTask) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    if (!pTask) return ERR_NULLPTR;
+    if (!timeout_us) return ERR_TOOSMALL;
+    uint64_t timeout = time_nsToCycles((uint64_t)timeout_us * 1000);
+    //Claim a free task slot
+    WdtSupTask_t* task = NULL;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    for (unsigned int idx = 0; idx < ctx->size; idx++) {
+        if (!ctx->tasks[idx].used) {
+            task = &ctx->tasks[idx];
+            break;
+        }
+    }
+    if (task) {
+        task->sup = ctx;
+        task->name = name;
+        task->timeout = timeout;
+        task->expired = false;
+        //Counts as checked in, so the deadline starts on the next period.
+        task->seen = task->checkIns - 1;
+        task->deadline = 0;
+        task->used = true;
+    }
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    if (!task) return ERR_NOSPACE;
+    *pTask = task;
+    return ERR_SUCCESS;
+}
+
+// Unregister a task
+//  - The task is no longer supervised, and the handle must not be used again.
+//  - Returns ERR_BUSY if the task has expired, as the watchdog will still reset.
+HpsErr_t WdtSupervisor_unregister(WdtSupTask_t* task) {
+    if (!task || !task->used) return ERR_NULLPTR;
+    WdtSupCtx_t* ctx = task->sup;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t irqState = IRQ_spinLock(&ctx->lock);
+    if (task->expired) {
+        status = ERR_BUSY;
+    } else {
+        task->used = false;
+    }
+    IRQ_spinUnlock(&ctx->lock, irqState);
+    return status;
+}
+
+// Check if a task has expired
+//  - Returns true if any task has missed its deadline
+bool WdtSupervisor_hasExpired(WdtSupCtx_t* ctx) {
+    if (!WdtSupervisor_isInitialised(ctx)) return false;
+    return ctx->bitten;
+}
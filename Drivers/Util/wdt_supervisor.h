@@ -0,0 +1,132 @@
+/*
+ * Watchdog Supervisor
+ * -------------------
+ *
+ * Services the watchdog from a timer interrupt for as long as
+ * every registered task keeps checking in within its deadline.
+ * Long running loops then no longer need to reset the watchdog
+ * themselves, but a task which really hangs still stops the
+ * watchdog being serviced, so the system is reset.
+ *
+ *    VTimerMgr_initialise(hpsTimer, 0, IRQ_TIMER_L4SP_1, 8, &vtMgr);
+ *    WdtSupervisor_initialise(vtMgr, 100000, 4, &logHang, NULL, &wdtSup);
+ *    WdtSupervisor_register(wdtSup, "main", 2000000, &mainTask);
+ *    while (1) {
+ *        WdtSupervisor_checkIn(mainTask);
+ *        ...
+ *    }
+ *
+ * Operation
+ * ---------
+ *
+ * The supervisor runs from a virtual timer (Util/vtimer.h) every
+ * period. A task checks in by incrementing its own counter, so
+ * checking in is lock-free and costs a single store. Each period
+ * the supervisor restarts the deadline of any task whose counter
+ * has changed, measured from Util/timestamp. If no task is past
+ * its deadline the watchdog is serviced.
+ *
+ * Once any task misses its deadline it is marked as expired, and
+ * the watchdog is never serviced again. The optional expired
+ * handler is called once from the timer interrupt, e.g. to log
+ * which task hung before the watchdog resets the system.
+ *
+ * The watchdog timeout must be longer than the supervisor period.
+ * Globally define WDT_SUPERVISED so that ResetWDT() in drivers
+ * does nothing, otherwise their loops still service the watchdog.
+ *
+ * Requires HPS_IRQ.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef WDT_SUPERVISOR_H_
+#define WDT_SUPERVISOR_H_
+
+#include "Util/driver_ctx.h"
+#include "Util/vtimer.h"
+#include "Util/irq.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+struct _WdtSupCtx_t;
+
+// Supervised Task
+typedef struct {
+    struct _WdtSupCtx_t* sup;
+    const char*       name;
+    volatile uint32_t checkIns;  // Incremented by the task
+    uint32_t          seen;      // Value of checkIns at the last change
+    uint64_t          timeout;   // Deadline in timestamp cycles
+    uint64_t          deadline;  // Timestamp by which the next check in is due
+    bool              used;
+    bool              expired;
+} WdtSupTask_t;
+
+// Expired task handler
+//  - Called once from the timer interrupt when the first task misses its deadline.
+typedef void (*WdtSupExpiredFunc_t)(WdtSupTask_t* task, void* param);
+
+// Watchdog Supervisor Context
+typedef struct _WdtSupCtx_t {
+    //Header
+    DrvCtx_t header;
+    //Body
+    VTimerCtx_t*        timer;
+    IrqSpinlock_t       lock;
+    WdtSupTask_t*       tasks;
+    unsigned int        size;    // Maximum number of tasks
+    WdtSupExpiredFunc_t expired;
+    void*               param;
+    volatile bool       bitten;  // A task has expired. Watchdog no longer serviced.
+} WdtSupCtx_t;
+
+// Initialise Watchdog Supervisor
+//  - mgr is the virtual timer manager to create the supervisor timer on.
+//  - period_us is how often to check the tasks and service the watchdog.
+//  - maxTasks is the maximum number of tasks which can be registered.
+//  - expired is optionally called with param once a task misses its deadline.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t WdtSupervisor_initialise(VTimerMgrCtx_t* mgr, unsigned int period_us, unsigned int maxTasks, WdtSupExpiredFunc_t expired, void* param, WdtSupCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool WdtSupervisor_isInitialised(WdtSupCtx_t* ctx);
+
+// Register a task
+//  - name is used for diagnostics only, and must remain valid.
+//  - timeout_us is the longest time allowed between check ins. The first
+//    deadline starts from the next supervisor period.
+//  - Returns ERR_NOSPACE if maxTasks tasks are already registered.
+//  - Returns task handle to *pTask
+HpsErr_t WdtSupervisor_register(WdtSupCtx_t* ctx, const char* name, unsigned int timeout_us, WdtSupTask_t** pTask);
+
+// Unregister a task
+//  - The task is no longer supervised, and the handle must not be used again.
+//  - Returns ERR_BUSY if the task has expired, as the watchdog will still reset.
+HpsErr_t WdtSupervisor_unregister(WdtSupTask_t* task);
+
+// Check in a task
+//  - Must only be called by the task itself, but is safe from any context.
+static inline void WdtSupervisor_checkIn(WdtSupTask_t* task) {
+    task->checkIns = task->checkIns + 1;
+}
+
+// Check if a task has expired
+//  - Returns true if any task has missed its deadline
+bool WdtSupervisor_hasExpired(WdtSupCtx_t* ctx);
+
+#endif /* WDT_SUPERVISOR_H_ */
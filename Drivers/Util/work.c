@@ -0,0 +1,158 @@
+/*
+ * Deferred Work Queue
+ * -------------------
+ *
+ * Provides a lock-free queue of small work items which can
+ * be posted from interrupt handlers and run later from the
+ * main loop (thread context).
+ *
+ * The queue is a bounded ring where each slot carries a
+ * sequence number. A slot is free to post into when its
+ * sequence equals the head position, and ready to run when
+ * it equals the tail position + 1. Posters reserve a slot by
+ * atomically advancing the head, so handlers which pre-empt
+ * one another cannot corrupt the queue.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#include "work.h"
+#include "Util/mem_pool.h"
+
+/*
+ * Internal Functions
+ */
+
+static void _WorkQueue_cleanup(WorkQueueCtx_t* ctx) {
+    //Free the queue storage
+    if (ctx->items) {
+        MemPool_free(ctx->items);
+        ctx->items = NULL;
+    }
+}
+
+/*
+ * User Facing APIs
+ */
+
+// Initialise Work Queue
+//  - length is the maximum number of pending work items. Must be a power of two, at least 2.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t WorkQueue_initialise(unsigned int length, WorkQueueCtx_t** pCtx) {
+    //Ensure length is a power of two, at least 2 so free and full slots can be told apart
+    if (length < 2) return ERR_TOOSMALL;
+    if (length & (length - 1)) return ERR_NOSUPPORT;
+    //Allocate the driver context, validating return value.
+    HpsErr_t status = DriverContextAllocateWithCleanup(pCtx, &_WorkQueue_cleanup);
+    if (ERR_IS_ERROR(status)) return status;
+    //Allocate the queue storage
+    WorkQueueCtx_t* ctx = *pCtx;
+    ctx->items = (WorkItem_t*)MemPool_malloc(length * sizeof(*ctx->items));
+    if (!ctx->items) return DriverContextInitFail(pCtx, ERR_ALLOCFAIL);
+    //Each slot starts free for the position matching its index
+    for (unsigned int idx = 0; idx < length; idx++) {
+        ctx->items[idx].seq = idx;
+    }
+    ctx->mask = length - 1;
+    ctx->head = 0;
+    ctx->tail = 0;
+    ctx->dropped = 0;
+    //Now initialised
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool WorkQueue_isInitialised(WorkQueueCtx_t* ctx) {
+    return DriverContextCheckInit(ctx);
+}
+
+// Post a work item
+//  - Safe to call from interrupt handlers.
+//  - func will be called with param and arg from Work_process()
+//  - Returns ERR_NOSPACE if the queue is full.
+HpsErr_t Work_post(WorkQueueCtx_t* ctx, WorkFunc_t func, void* param, unsigned int arg) {
+    if (!func) return ERR_NULLPTR;
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    //Reserve a slot by advancing the head. Retry if another handler got there first.
+    unsigned int pos = __atomic_load_n(&ctx->head, __ATOMIC_RELAXED);
+    WorkItem_t* item;
+    while (true) {
+        item = &ctx->items[pos & ctx->mask];
+        unsigned int seq = __atomic_load_n(&item->seq, __ATOMIC_ACQUIRE);
+        if (seq != pos) {
+            if ((int)(seq - pos) < 0) {
+                //Slot still holds an item yet to be run. Queue is full.
+                __atomic_fetch_add(&ctx->dropped, 1, __ATOMIC_RELAXED);
+                return ERR_NOSPACE;
+            }
+            //Head moved on since we read it. Try again.
+            pos = __atomic_load_n(&ctx->head, __ATOMIC_RELAXED);
+        } else if (__atomic_compare_exchange_n(&ctx->head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            //Slot reserved
+            break;
+        }
+    }
+    //Fill the slot, then publish it to Work_process()
+    item->func = func;
+    item->param = param;
+    item->arg = arg;
+    __atomic_store_n(&item->seq, pos + 1, __ATOMIC_RELEASE);
+    return ERR_SUCCESS;
+}
+
+// Run pending work items
+//  - Must be called from thread context (not an ISR).
+//  - Runs at most one queue length of items per call, so that work
+//    which reposts itself cannot stall the caller.
+//  - Returns the number of items run, or an error code.
+HpsErr_t Work_process(WorkQueueCtx_t* ctx) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    HpsErr_t count = 0;
+    while ((unsigned int)count <= ctx->mask) {
+        //Check if the next slot has been published
+        WorkItem_t* item = &ctx->items[ctx->tail & ctx->mask];
+        if (__atomic_load_n(&item->seq, __ATOMIC_ACQUIRE) != (ctx->tail + 1)) break;
+        //Copy out the item, then free the slot for the next lap of the ring
+        WorkFunc_t func = item->func;
+        void* param = item->param;
+        unsigned int arg = item->arg;
+        __atomic_store_n(&item->seq, ctx->tail + ctx->mask + 1, __ATOMIC_RELEASE);
+        ctx->tail++;
+        //And run it
+        func(param, arg);
+        count++;
+    }
+    return count;
+}
+
+// Get number of dropped work items
+//  - Returns the number of items which could not be posted as the
+//    queue was full. If clear is true, the count is reset.
+HpsErr_t Work_getDropped(WorkQueueCtx_t* ctx, bool clear) {
+    //Ensure context valid and initialised
+    HpsErr_t status = DriverContextValidate(ctx);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int dropped;
+    if (clear) {
+        dropped = __atomic_exchange_n(&ctx->dropped, 0, __ATOMIC_RELAXED);
+    } else {
+        dropped = ctx->dropped;
+    }
+    return (HpsErr_t)(dropped & INT32_MAX);
+}
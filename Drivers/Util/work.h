@@ -0,0 +1,108 @@
+/*
+ * Deferred Work Queue
+ * -------------------
+ *
+ * Provides a lock-free queue of small work items which can
+ * be posted from interrupt handlers and run later from the
+ * main loop (thread context).
+ *
+ * This allows an ISR to do only the minimum required to
+ * service the hardware (e.g. copy data out of a FIFO and
+ * clear the interrupt flag), deferring any heavy processing
+ * until interrupts are enabled again.
+ *
+ * Posting Work
+ * ------------
+ *
+ * Work_post() may be called from any context, including IRQ
+ * handlers which may pre-empt one another (see HPS_IRQ priority
+ * support). Posting is O(1) and does not mask interrupts. If the
+ * queue is full, ERR_NOSPACE is returned and the item is dropped.
+ *
+ * Running Work
+ * ------------
+ *
+ * Work items are run in the order posted by calling Work_process()
+ * from the main loop. Alternatively the queue can be attached to an
+ * event manager with EventMgr_setWorkQueue(), in which case it is
+ * drained on each call to Event_process().
+ *
+ * Only one context may call Work_process() for a given queue.
+ *
+ *
+ * Company: University of Leeds
+ * Author: T Carpenter
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------------
+ * 14/10/2026 | Creation of driver.
+ *
+ */
+
+#ifndef WORK_H_
+#define WORK_H_
+
+#include "Util/driver_ctx.h"
+
+#include <stdbool.h>
+
+#include "Util/error.h"
+
+// Work item function
+//  - Called from Work_process() for each posted item.
+//  - param and arg are the values passed to Work_post().
+typedef void (*WorkFunc_t)(void* param, unsigned int arg);
+
+// Work queue slot
+//  - seq is used to track which slots are free or ready to run
+//    without needing a lock.
+typedef struct {
+    volatile unsigned int seq;
+    WorkFunc_t   func;
+    void*        param;
+    unsigned int arg;
+} WorkItem_t;
+
+// Work Queue Context
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    WorkItem_t*           items;   // Queue storage
+    unsigned int          mask;    // Queue length - 1
+    volatile unsigned int head;    // Next slot to post to
+    unsigned int          tail;    // Next slot to run
+    volatile unsigned int dropped; // Number of items dropped as queue was full
+} WorkQueueCtx_t;
+
+// Initialise Work Queue
+//  - length is the maximum number of pending work items. Must be a power of two, at least 2.
+//  - Returns Util/error Code
+//  - Returns context pointer to *ctx
+HpsErr_t WorkQueue_initialise(unsigned int length, WorkQueueCtx_t** pCtx);
+
+// Check if driver initialised
+//  - Returns true if driver previously initialised
+bool WorkQueue_isInitialised(WorkQueueCtx_t* ctx);
+
+// Post a work item
+//  - Safe to call from interrupt handlers.
+//  - func will be called with param and arg from Work_process()
+//  - Returns ERR_NOSPACE if the queue is full.
+HpsErr_t Work_post(WorkQueueCtx_t* ctx, WorkFunc_t func, void* param, unsigned int arg);
+
+// Run pending work items
+//  - Must be called from thread context (not an ISR).
+//  - Runs at most one queue length of items per call, so that work
+//    which reposts itself cannot stall the caller.
+//  - Returns the number of items run, or an error code.
+HpsErr_t Work_process(WorkQueueCtx_t* ctx);
+
+// Get number of dropped work items
+//  - Returns the number of items which could not be posted as the
+//    queue was full. If clear is true, the count is reset.
+HpsErr_t Work_getDropped(WorkQueueCtx_t* ctx, bool clear);
+
+#endif /* WORK_H_ */
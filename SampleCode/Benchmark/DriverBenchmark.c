@@ -0,0 +1,483 @@
+/*
+ * Driver Hot Path Benchmarks
+ * --------------------------
+ *
+ * Measures the hot paths of the drivers with the PMU profiling
+ * harness (Util/profile.h), printing a table of results so that
+ * regressions between driver versions are visible. Output goes
+ * through printf, so over semihosting when a debugger is attached,
+ * or to a UART if the semihosting failback is enabled.
+ *
+ * Each benchmark prints its own rows of average cycles per call
+ * and throughput, then the full profile report is printed with
+ * the event counts. Benchmarks whose hardware fails to initialise
+ * (e.g. no SD card inserted) are reported as skipped.
+ *
+ * Requires the LT24 on JP1, and an SD card for the disk_read rows.
+ * Sector reads start at BENCH_SD_SECTOR and only read the card.
+ *
+ * If the SD card has a FAT filesystem, the throughput of each row is
+ * also compared against the previous run stored in BENCH_BASELINE
+ * (Util/perf_baseline.h), and any which are more than
+ * BENCH_BASELINE_THRESHOLD percent slower are flagged. The file is
+ * only updated when there are no regressions, so a board keeps
+ * flagging a slow build until it is fixed. Delete the file to accept
+ * new results.
+ */
+
+#include "DE1SoC_Addresses/DE1SoC_Addresses.h"
+#include "DE1SoC_LT24/DE1SoC_LT24.h"
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "FPGA_PIO/FPGA_PIO.h"
+#include "HPS_DMAController/HPS_DMAController.h"
+#include "HPS_I2C/HPS_I2C.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+#include "Soft_DMAController/Soft_DMAController.h"
+#include "FatFS/ff.h"
+#include "FatFS/diskio.h"
+#include "Util/dma_buffer.h"
+#include "Util/event.h"
+#include "Util/perf_baseline.h"
+#include "Util/profile.h"
+#include "Util/watchdog.h"
+
+#ifdef __ARRIA10__
+#include "Util/hwlib/a10/socal/hps.h"
+#define BENCH_GIC_DIST 0xFFFFD000
+#else
+#include "Util/hwlib/cv/socal/hps.h"
+#define BENCH_GIC_DIST 0xFFFED000
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+// First SD card sector read by the disk_read benchmark
+#ifndef BENCH_SD_SECTOR
+#define BENCH_SD_SECTOR 8192
+#endif
+
+// Number of times each measurement is repeated
+#define BENCH_RUNS 8
+
+// Largest memory copy, and largest disk read in sectors
+#define BENCH_MEM_MAX   0x100000
+#define BENCH_SD_MAX    128
+
+// Most registered events, and number of Event_process calls measured
+#define BENCH_EVENT_MAX   128
+#define BENCH_EVENT_CALLS 256
+
+#define BENCH_COUNT(arr) (sizeof(arr)/sizeof((arr)[0]))
+
+// Stored results of the previous run, and percentage slower to flag
+#ifndef BENCH_BASELINE
+#define BENCH_BASELINE           "0:/benchmark.csv"
+#endif
+#ifndef BENCH_BASELINE_THRESHOLD
+#define BENCH_BASELINE_THRESHOLD 10.0
+#endif
+#define BENCH_BASELINE_METRICS   64
+
+// GIC software generated interrupt used for IRQ latency
+#define BENCH_SGI_ID        0
+#define BENCH_GIC_ICDSGIR   (0xF00/sizeof(unsigned int))
+#define BENCH_SGI_TO_SELF   (0x2 << 24)
+
+#define BENCH_LT24_PIXELS   (LT24_WIDTH * LT24_HEIGHT)
+
+static unsigned short frameBuffer[BENCH_LT24_PIXELS];
+static unsigned char  memSrc[BENCH_MEM_MAX] __attribute__((aligned(64)));
+static unsigned char  memDest[BENCH_MEM_MAX] __attribute__((aligned(64)));
+
+static FATFS benchFs;
+static PerfBaselineCtx_t* baseline = NULL;
+
+/*
+ * Result Table
+ */
+
+// Print the table heading
+static void benchHeading(const char* title) {
+    printf("\n%s\n", title);
+    printf("%-28s %10s %14s %16s\n", "Benchmark", "Param", "Avg cycles", "Throughput");
+}
+
+// Print a result row
+//  - units is the quantity (e.g. bytes or pixels) processed by each call of the section.
+static void benchRow(const char* name, unsigned int param, ProfileSection_t* sect, double units, const char* unitName) {
+    if (!sect->calls || !sect->ticks) {
+        printf("%-28s %10u %14s %16s\n", name, param, "-", "-");
+        return;
+    }
+    double seconds = (double)sect->ticks / (double)Profile_timestampRate();
+    double rate = (units * sect->calls) / seconds;
+    printf("%-28s %10u %14llu %12.1f %s\n", name, param,
+           (unsigned long long)(sect->cycles / sect->calls), rate, unitName);
+    if (baseline) {
+        char metric[PERF_BASELINE_NAME_MAX];
+        snprintf(metric, sizeof(metric), "%s/%u %s", name, param, unitName);
+        PerfBaseline_record(baseline, metric, rate, PERF_HIGHER_BETTER);
+    }
+}
+
+// Print a skipped row
+static void benchSkipped(const char* name, HpsErr_t status) {
+    printf("%-28s skipped (error %d)\n", name, (int)status);
+}
+
+/*
+ * Global Timer as a Generic Timer
+ *
+ * The event manager needs an event mode timer, which counts down
+ * from UINT32_MAX. The lower word of the global timer is inverted
+ * to give one.
+ */
+
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    TimerCtx_t timer;
+} BenchTimerCtx_t;
+
+static HpsErr_t benchTimerGetLoad(void* ctx, unsigned int* time) {
+    *time = UINT32_MAX;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t benchTimerGetTime(void* ctx, unsigned int* time) {
+    *time = UINT32_MAX - (unsigned int)Profile_timestamp();
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t benchTimerGetRate(void* ctx, unsigned int prescaler, unsigned int* rate) {
+    *rate = Profile_timestampRate();
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t benchTimerGetMode(void* ctx, TimerMode* mode) {
+    *mode = TIMER_MODE_EVENT;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t benchTimerInitialise(BenchTimerCtx_t** pCtx) {
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    BenchTimerCtx_t* ctx = *pCtx;
+    ctx->timer.ctx     = ctx;
+    ctx->timer.getLoad = &benchTimerGetLoad;
+    ctx->timer.getTime = &benchTimerGetTime;
+    ctx->timer.getRate = &benchTimerGetRate;
+    ctx->timer.getMode = &benchTimerGetMode;
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+/*
+ * LT24 Display
+ */
+
+static void benchLT24(void) {
+    static ProfileSection_t writeSect = PROFILE_SECTION_INIT("LT24_write");
+    static ProfileSection_t copySect  = PROFILE_SECTION_INIT("LT24_copyFrameBuffer");
+    ProfileSnap_t snap;
+    FPGAPIOCtx_t* gpio;
+    LT24Ctx_t* lt24;
+    benchHeading("LT24 Display");
+    HpsErr_t status = FPGA_PIO_initialise(LSC_BASE_GPIO_JP1, LSC_CONFIG_GPIO, &gpio);
+    if (ERR_IS_SUCCESS(status)) status = LT24_initialise(&gpio->gpio, LSC_BASE_LT24HWDATA, &lt24);
+    if (ERR_IS_ERROR(status)) {
+        benchSkipped("LT24", status);
+        return;
+    }
+    for (unsigned int idx = 0; idx < BENCH_LT24_PIXELS; idx++) {
+        frameBuffer[idx] = (unsigned short)(idx * 7);
+    }
+    //Pixel rate of individual data writes
+    for (unsigned int run = 0; run < BENCH_RUNS; run++) {
+        LT24_setWindow(lt24, 0, 0, LT24_WIDTH, LT24_HEIGHT);
+        Profile_begin(&writeSect, &snap);
+        for (unsigned int idx = 0; idx < BENCH_LT24_PIXELS; idx++) {
+            LT24_write(lt24, true, frameBuffer[idx]);
+        }
+        Profile_end(&writeSect, &snap);
+        ResetWDT();
+    }
+    benchRow("LT24_write", BENCH_LT24_PIXELS, &writeSect, BENCH_LT24_PIXELS, "px/s");
+    //Full frame copies
+    for (unsigned int run = 0; run < BENCH_RUNS; run++) {
+        Profile_begin(&copySect, &snap);
+        LT24_copyFrameBuffer(lt24, frameBuffer, 0, 0, LT24_WIDTH, LT24_HEIGHT);
+        Profile_end(&copySect, &snap);
+        ResetWDT();
+    }
+    benchRow("LT24_copyFrameBuffer", BENCH_LT24_PIXELS, &copySect, 1, "FPS");
+}
+
+/*
+ * WM8731 Audio
+ */
+
+static void benchWM8731(void) {
+    static ProfileSection_t sampleSect = PROFILE_SECTION_INIT("WM8731_writeSample");
+    ProfileSnap_t snap;
+    HPSI2CCtx_t* i2c;
+    WM8731Ctx_t* audio;
+    benchHeading("WM8731 Audio");
+    HpsErr_t status = HPS_I2C_initialise(LSC_BASE_I2C_GENERAL, I2C_SPEED_STANDARD, &i2c);
+    if (ERR_IS_SUCCESS(status)) status = WM8731_initialise(LSC_BASE_AUDIOCODEC, &i2c->i2c, &audio);
+    if (ERR_IS_ERROR(status)) {
+        benchSkipped("WM8731", status);
+        return;
+    }
+    //Each run fills the empty DAC FIFO, so measures the CPU side rate
+    //rather than the codec sample rate.
+    unsigned int space = 0;
+    for (unsigned int run = 0; run < BENCH_RUNS; run++) {
+        WM8731_clearFIFO(audio, false, true);
+        WM8731_getFIFOSpace(audio, &space);
+        Profile_begin(&sampleSect, &snap);
+        for (unsigned int idx = 0; idx < space; idx++) {
+            WM8731_writeSample(audio, idx, idx);
+        }
+        Profile_end(&sampleSect, &snap);
+    }
+    benchRow("WM8731_writeSample", space, &sampleSect, space, "smp/s");
+    unsigned int sampleRate = 0;
+    WM8731_getSampleRate(audio, &sampleRate);
+    printf("%-28s %10u\n", "Codec sample rate", sampleRate);
+}
+
+/*
+ * SD Card
+ */
+
+static void benchDisk(void) {
+    static const unsigned int counts[] = {1, 8, 32, BENCH_SD_MAX};
+    static ProfileSection_t readSect[BENCH_COUNT(counts)];
+    ProfileSnap_t snap;
+    benchHeading("SD Card");
+    DSTATUS dstatus = disk_initialize(0);
+    if (dstatus & STA_NOINIT) {
+        benchSkipped("disk_read", ERR_NOTFOUND);
+        return;
+    }
+    for (unsigned int cnt = 0; cnt < BENCH_COUNT(counts); cnt++) {
+        readSect[cnt] = (ProfileSection_t)PROFILE_SECTION_INIT("disk_read");
+        for (unsigned int run = 0; run < BENCH_RUNS; run++) {
+            Profile_begin(&readSect[cnt], &snap);
+            DRESULT res = disk_read(0, memDest, BENCH_SD_SECTOR, counts[cnt]);
+            Profile_end(&readSect[cnt], &snap);
+            ResetWDT();
+            if (res != RES_OK) {
+                benchSkipped("disk_read", ERR_IOFAIL);
+                return;
+            }
+        }
+        benchRow("disk_read (sectors)", counts[cnt], &readSect[cnt], counts[cnt] * 512.0 / 1e6, "MB/s");
+    }
+}
+
+/*
+ * Memory Copy Bandwidth
+ */
+
+// Perform a copy with a DMA controller, waiting for completion
+static HpsErr_t benchDmaCopy(DmaCtx_t* dma, void* dest, const void* src, size_t len) {
+    DmaChunk_t xfer = {
+        .readAddr  = (uintptr_t)src,
+        .writeAddr = (uintptr_t)dest,
+        .length    = len,
+        .isLast    = true,
+        .index     = 0,
+        .params    = NULL
+    };
+    HpsErr_t status = DmaBuffer_setupTransfer(dma, &xfer, true);
+    if (status == ERR_SKIPPED) return ERR_SUCCESS;
+    if (ERR_IS_ERROR(status)) return status;
+    do {
+        status = DmaBuffer_transferDone(dma, &xfer);
+    } while (status == ERR_BUSY);
+    return status;
+}
+
+static void benchMemory(void) {
+    static const unsigned int sizes[] = {256, 4096, 65536, BENCH_MEM_MAX};
+    static ProfileSection_t cpuSect[BENCH_COUNT(sizes)];
+    static ProfileSection_t hpsSect[BENCH_COUNT(sizes)];
+    static ProfileSection_t softSect[BENCH_COUNT(sizes)];
+    ProfileSnap_t snap;
+    HPSDmaCtx_t* hpsDma = NULL;
+    SoftDmaCtx_t* softDma = NULL;
+    benchHeading("Memory Copy");
+    HpsErr_t status = HPS_DMA_initialise(ALT_DMASECURE_ADDR, HPS_DMA_BURSTSIZE_8BYTE, NULL, &hpsDma);
+    if (ERR_IS_ERROR(status)) {
+        benchSkipped("HPS_DMA", status);
+        hpsDma = NULL;
+    }
+    status = Soft_DMA_initialise(SOFT_DMA_WORDSIZE_32BIT | SOFT_DMA_COPY_BURST, BENCH_MEM_MAX / 4, NULL, NULL, &softDma);
+    if (ERR_IS_ERROR(status)) {
+        benchSkipped("Soft_DMA", status);
+        softDma = NULL;
+    }
+    memset(memSrc, 0x5A, sizeof(memSrc));
+    for (unsigned int sz = 0; sz < BENCH_COUNT(sizes); sz++) {
+        cpuSect[sz]  = (ProfileSection_t)PROFILE_SECTION_INIT("memcpy");
+        hpsSect[sz]  = (ProfileSection_t)PROFILE_SECTION_INIT("HPS_DMA copy");
+        softSect[sz] = (ProfileSection_t)PROFILE_SECTION_INIT("Soft_DMA copy");
+        for (unsigned int run = 0; run < BENCH_RUNS; run++) {
+            Profile_begin(&cpuSect[sz], &snap);
+            memcpy(memDest, memSrc, sizes[sz]);
+            Profile_end(&cpuSect[sz], &snap);
+            if (hpsDma) {
+                Profile_begin(&hpsSect[sz], &snap);
+                benchDmaCopy(&hpsDma->dma, memDest, memSrc, sizes[sz]);
+                Profile_end(&hpsSect[sz], &snap);
+            }
+            if (softDma) {
+                Profile_begin(&softSect[sz], &snap);
+                benchDmaCopy(&softDma->dma, memDest, memSrc, sizes[sz]);
+                Profile_end(&softSect[sz], &snap);
+            }
+            ResetWDT();
+        }
+        benchRow("memcpy (bytes)",        sizes[sz], &cpuSect[sz],  sizes[sz] / 1e6, "MB/s");
+        benchRow("HPS_DMA copy (bytes)",  sizes[sz], &hpsSect[sz],  sizes[sz] / 1e6, "MB/s");
+        benchRow("Soft_DMA copy (bytes)", sizes[sz], &softSect[sz], sizes[sz] / 1e6, "MB/s");
+    }
+}
+
+/*
+ * IRQ Latency
+ *
+ * A software generated interrupt is sent to this core, and the
+ * section ended at the start of its handler, so measures from the
+ * request to the handler being called by HPS_IRQ.
+ */
+
+static ProfileSection_t irqSect = PROFILE_SECTION_INIT("IRQ latency");
+static ProfileSnap_t irqSnap;
+static volatile bool irqDone;
+
+__irq void benchIrqHandler(HPSIRQSource interruptID, void* param, bool* handled) {
+    Profile_end(&irqSect, &irqSnap);
+    irqDone = true;
+    *handled = true;
+}
+
+static void benchIrq(void) {
+    volatile unsigned int* gicDist = (unsigned int*)BENCH_GIC_DIST;
+    benchHeading("IRQ Latency");
+    HpsErr_t status = HPS_IRQ_registerHandler((HPSIRQSource)BENCH_SGI_ID, &benchIrqHandler, NULL);
+    if (ERR_IS_ERROR(status)) {
+        benchSkipped("IRQ latency", status);
+        return;
+    }
+    HPS_IRQ_globalEnable(true);
+    for (unsigned int run = 0; run < BENCH_RUNS; run++) {
+        irqDone = false;
+        Profile_begin(&irqSect, &irqSnap);
+        gicDist[BENCH_GIC_ICDSGIR] = BENCH_SGI_TO_SELF | BENCH_SGI_ID;
+        while (!irqDone);
+    }
+    HPS_IRQ_globalEnable(false);
+    HPS_IRQ_unregisterHandler((HPSIRQSource)BENCH_SGI_ID);
+    benchRow("IRQ entry to handler", BENCH_SGI_ID, &irqSect, 1, "IRQ/s");
+    printf("%-28s %10s %14lu %16lu\n", "  min/max cycles", "",
+           (unsigned long)irqSect.minCycles, (unsigned long)irqSect.maxCycles);
+}
+
+/*
+ * Event Manager
+ */
+
+static HpsErr_t benchEventHandler(Event_t* event, void* param) {
+    return ERR_AGAIN;
+}
+
+static void benchEvents(void) {
+    static const unsigned int counts[] = {1, 8, 32, BENCH_EVENT_MAX};
+    static ProfileSection_t pendSect[BENCH_COUNT(counts)];
+    static ProfileSection_t dueSect[BENCH_COUNT(counts)];
+    static Event_t* events[BENCH_EVENT_MAX];
+    ProfileSnap_t snap;
+    BenchTimerCtx_t* timer;
+    EventMgrCtx_t* mgr;
+    benchHeading("Event Manager");
+    HpsErr_t status = benchTimerInitialise(&timer);
+    if (ERR_IS_SUCCESS(status)) status = EventMgr_initialiseSized(&timer->timer, BENCH_EVENT_MAX, &mgr);
+    if (ERR_IS_ERROR(status)) {
+        benchSkipped("Event_process", status);
+        return;
+    }
+    for (unsigned int cnt = 0; cnt < BENCH_COUNT(counts); cnt++) {
+        pendSect[cnt] = (ProfileSection_t)PROFILE_SECTION_INIT("Event_process pending");
+        dueSect[cnt]  = (ProfileSection_t)PROFILE_SECTION_INIT("Event_process due");
+        //Events which are never due, so measures checking the schedule
+        for (unsigned int evt = 0; evt < counts[cnt]; evt++) {
+            Event_create(mgr, EVENT_TYPE_REPEAT, UINT32_MAX / 2, &benchEventHandler, NULL, &events[evt]);
+        }
+        for (unsigned int call = 0; call < BENCH_EVENT_CALLS; call++) {
+            Profile_begin(&pendSect[cnt], &snap);
+            Event_process(mgr);
+            Profile_end(&pendSect[cnt], &snap);
+        }
+        //Events which are all due every call, so measures handling
+        for (unsigned int evt = 0; evt < counts[cnt]; evt++) {
+            Event_setMode(events[evt], EVENT_TYPE_REPEAT, 1);
+        }
+        for (unsigned int call = 0; call < BENCH_EVENT_CALLS; call++) {
+            Profile_begin(&dueSect[cnt], &snap);
+            Event_process(mgr);
+            Profile_end(&dueSect[cnt], &snap);
+        }
+        for (unsigned int evt = 0; evt < counts[cnt]; evt++) {
+            Event_destroy(events[evt]);
+        }
+        ResetWDT();
+        benchRow("Event_process pending (evts)", counts[cnt], &pendSect[cnt], 1, "calls/s");
+        benchRow("Event_process due (evts)",     counts[cnt], &dueSect[cnt],  counts[cnt], "evts/s");
+    }
+}
+
+/*
+ * Main
+ */
+
+int main(void) {
+    static const ProfileEvent profileEvents[] = {PROFILE_EVT_L1D_REFILL, PROFILE_EVT_BRANCH_MISPRED};
+    HPS_IRQ_initialise(false, NULL);
+    HpsErr_t status = Profile_initialise(profileEvents, BENCH_COUNT(profileEvents));
+    if (ERR_IS_ERROR(status)) {
+        printf("Profiling unavailable (error %d)\n", (int)status);
+        while (1);
+    }
+    printf("Driver Benchmarks (global timer %u Hz)\n", Profile_timestampRate());
+    //Load the previous results if there is a filesystem
+    if (f_mount(&benchFs, "0:", 1) == FR_OK) {
+        status = PerfBaseline_initialise(BENCH_BASELINE, BENCH_BASELINE_METRICS, BENCH_BASELINE_THRESHOLD, &baseline);
+        if (ERR_IS_ERROR(status)) {
+            printf("Baseline unavailable (error %d)\n", (int)status);
+            baseline = NULL;
+        }
+    }
+    benchLT24();
+    benchWM8731();
+    benchDisk();
+    benchMemory();
+    benchIrq();
+    benchEvents();
+    printf("\n");
+    Profile_report();
+    if (baseline) {
+        printf("\nBaseline %s\n", BENCH_BASELINE);
+        if (PerfBaseline_report(baseline) == 0) {
+            status = PerfBaseline_save(baseline);
+            if (ERR_IS_ERROR(status)) printf("Baseline not saved (error %d)\n", (int)status);
+        }
+    }
+    while (1) {
+        ResetWDT();
+    }
+}
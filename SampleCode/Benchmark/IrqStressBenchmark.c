@@ -0,0 +1,346 @@
+/*
+ * IRQ Storm and Event Manager Scaling Benchmark
+ * ---------------------------------------------
+ *
+ * Stresses the interrupt dispatch (HPS_IRQ) and the event manager
+ * (Util/event) together at increasing levels of load, printing the
+ * dispatch latency percentiles and missed deadlines at each level,
+ * so changes to __irq_isr and Event_process can be compared on a
+ * reproducible workload.
+ *
+ * At each load level:
+ *
+ *   - The private timer interrupts at STRESS_TIMER rate. Its lateness
+ *     is how far each period between callbacks is from the configured
+ *     one, and a period of twice that or more is a missed tick.
+ *   - Each timer callback sends every one of the level's software
+ *     generated interrupts to this core. Their latency is from the send
+ *     to the SGI handler, and an SGI sent again before it was handled is
+ *     missed.
+ *   - The level's number of repeating events are registered with the
+ *     event manager, with intervals from 100us to 1.6ms, and the main
+ *     loop runs Event_process for STRESS_WINDOW_MS. Their lateness is
+ *     how far past its interval each handler was called, and missed
+ *     periods come from the manager's scheduling metrics.
+ *
+ * Latencies are recorded in a histogram of STRESS_BIN_CYCLES global
+ * timer cycles per bin, and percentiles are the upper edge of the bin
+ * they fall in. If HPS_IRQ_STATS is defined, the per-source handler
+ * statistics are also printed after each level.
+ *
+ * SGI 0 is used by the IRQ latency row of DriverBenchmark, so the
+ * same ID gives comparable results between the two.
+ */
+
+#include "DE1SoC_Addresses/DE1SoC_Addresses.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+#include "HPS_PrivateTimer/HPS_PrivateTimer.h"
+#include "Util/event.h"
+#include "Util/profile.h"
+#include "Util/watchdog.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// PERIPHCLK rate of the private timer
+#ifndef STRESS_PERIPH_CLK
+#define STRESS_PERIPH_CLK 200000000U
+#endif
+
+// Time each load level runs for
+#define STRESS_WINDOW_MS   500
+
+// Histogram resolution and size. Longer latencies go in the last bin.
+#define STRESS_BIN_CYCLES  8
+#define STRESS_BINS        1024
+
+// Largest number of events in any level
+#define STRESS_EVENT_MAX   512
+
+#define STRESS_COUNT(arr) (sizeof(arr)/sizeof((arr)[0]))
+
+// Load levels
+typedef struct {
+    unsigned int sgis;       // Number of SGIs sent per timer tick
+    unsigned int timerRate;  // Private timer rate in Hz
+    unsigned int events;     // Registered repeating events
+} StressLevel_t;
+
+static const StressLevel_t levels[] = {
+    { 1,   1000,  32},
+    { 4,  10000, 128},
+    { 8,  20000, 256},
+    {16,  50000, 384},
+    {16, 100000, STRESS_EVENT_MAX}
+};
+
+/*
+ * Latency Histogram
+ */
+
+typedef struct {
+    unsigned int samples;
+    unsigned int missed;
+    unsigned int max;
+    unsigned int bins[STRESS_BINS];
+} StressHist_t;
+
+static void histClear(StressHist_t* hist) {
+    memset(hist, 0, sizeof(*hist));
+}
+
+static inline void histAdd(StressHist_t* hist, unsigned int cycles) {
+    unsigned int bin = cycles / STRESS_BIN_CYCLES;
+    if (bin >= STRESS_BINS) bin = STRESS_BINS - 1;
+    hist->bins[bin]++;
+    hist->samples++;
+    if (cycles > hist->max) hist->max = cycles;
+}
+
+// Latency below which the given fraction of samples fall, in cycles
+static unsigned int histPercentile(const StressHist_t* hist, double fraction) {
+    unsigned long long target = (unsigned long long)(hist->samples * fraction);
+    unsigned long long count = 0;
+    for (unsigned int bin = 0; bin < STRESS_BINS - 1; bin++) {
+        count += hist->bins[bin];
+        if (count > target) return (bin + 1) * STRESS_BIN_CYCLES;
+    }
+    return hist->max;
+}
+
+/*
+ * Result Table
+ */
+
+static double stressNs(unsigned int cycles) {
+    return cycles * 1e9 / (double)Profile_timestampRate();
+}
+
+// Print the table heading
+static void stressHeading(const StressLevel_t* level) {
+    printf("\nLoad: %u SGIs x %u Hz timer, %u events\n", level->sgis, level->timerRate, level->events);
+    printf("%-16s %10s %8s %9s %9s %9s %9s %10s\n", "Source", "Samples", "Missed",
+           "p50 ns", "p90 ns", "p99 ns", "p99.9 ns", "max ns");
+}
+
+// Print a result row
+static void stressRow(const char* name, const StressHist_t* hist) {
+    if (!hist->samples) {
+        printf("%-16s %10u %8u %9s %9s %9s %9s %10s\n", name, 0U, hist->missed, "-", "-", "-", "-", "-");
+        return;
+    }
+    printf("%-16s %10u %8u %9.0f %9.0f %9.0f %9.0f %10.0f\n", name, hist->samples, hist->missed,
+           stressNs(histPercentile(hist, 0.5)),  stressNs(histPercentile(hist, 0.9)),
+           stressNs(histPercentile(hist, 0.99)), stressNs(histPercentile(hist, 0.999)),
+           stressNs(hist->max));
+}
+
+/*
+ * Global Timer as a Generic Timer
+ *
+ * The event manager needs an event mode timer, which counts down
+ * from UINT32_MAX. The lower word of the global timer is inverted
+ * to give one.
+ */
+
+typedef struct {
+    //Header
+    DrvCtx_t header;
+    //Body
+    TimerCtx_t timer;
+} StressTimerCtx_t;
+
+static HpsErr_t stressTimerGetLoad(void* ctx, unsigned int* time) {
+    *time = UINT32_MAX;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t stressTimerGetTime(void* ctx, unsigned int* time) {
+    *time = UINT32_MAX - (unsigned int)Profile_timestamp();
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t stressTimerGetRate(void* ctx, unsigned int prescaler, unsigned int* rate) {
+    *rate = Profile_timestampRate();
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t stressTimerGetMode(void* ctx, TimerMode* mode) {
+    *mode = TIMER_MODE_EVENT;
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t stressTimerInitialise(StressTimerCtx_t** pCtx) {
+    HpsErr_t status = DriverContextAllocate(pCtx);
+    if (ERR_IS_ERROR(status)) return status;
+    StressTimerCtx_t* ctx = *pCtx;
+    ctx->timer.ctx     = ctx;
+    ctx->timer.getLoad = &stressTimerGetLoad;
+    ctx->timer.getTime = &stressTimerGetTime;
+    ctx->timer.getRate = &stressTimerGetRate;
+    ctx->timer.getMode = &stressTimerGetMode;
+    DriverContextSetInit(ctx);
+    return ERR_SUCCESS;
+}
+
+/*
+ * Interrupt Sources
+ */
+
+static StressHist_t sgiHist;
+static StressHist_t timerHist;
+static StressHist_t eventHist;
+
+static volatile unsigned int sgiCount;               // SGIs sent each tick
+static volatile unsigned int sgiSent[HPS_IRQ_SGI_COUNT];
+static volatile bool sgiPending[HPS_IRQ_SGI_COUNT];
+
+static unsigned int timerPeriod;                     // Expected period in global timer cycles
+static unsigned int timerLast;
+static bool timerStarted;
+
+__irq void stressSgiHandler(HPSIRQSource interruptID, void* param, bool* handled) {
+    unsigned int now = (unsigned int)Profile_timestamp();
+    histAdd(&sgiHist, now - sgiSent[interruptID]);
+    sgiPending[interruptID] = false;
+    *handled = true;
+}
+
+// Private timer callback. Measures its own period, then sends the SGIs.
+static void stressTimerTick(void* param) {
+    unsigned int now = (unsigned int)Profile_timestamp();
+    if (timerStarted) {
+        unsigned int period = now - timerLast;
+        histAdd(&timerHist, (period > timerPeriod) ? (period - timerPeriod) : (timerPeriod - period));
+        if (period >= 2 * timerPeriod) timerHist.missed++;
+    }
+    timerLast = now;
+    timerStarted = true;
+    for (unsigned int sgi = 0; sgi < sgiCount; sgi++) {
+        if (sgiPending[sgi]) {
+            sgiHist.missed++;
+            continue;
+        }
+        sgiPending[sgi] = true;
+        sgiSent[sgi] = (unsigned int)Profile_timestamp();
+        HPS_IRQ_sendSoftware((HPSIRQSource)(IRQ_SGI_0 + sgi), HPS_IRQ_CPU0);
+    }
+}
+
+/*
+ * Events
+ */
+
+typedef struct {
+    unsigned int interval;   // In global timer cycles
+    unsigned int last;       // Time of last call
+    bool started;
+} StressEvent_t;
+
+static Event_t* events[STRESS_EVENT_MAX];
+static StressEvent_t eventInfo[STRESS_EVENT_MAX];
+
+static HpsErr_t stressEventHandler(Event_t* event, void* param) {
+    StressEvent_t* info = (StressEvent_t*)param;
+    unsigned int now = (unsigned int)Profile_timestamp();
+    if (info->started) {
+        unsigned int period = now - info->last;
+        histAdd(&eventHist, (period > info->interval) ? (period - info->interval) : 0);
+    }
+    info->last = now;
+    info->started = true;
+    return ERR_AGAIN;
+}
+
+/*
+ * Load Level
+ */
+
+static HpsErr_t stressLevel(const StressLevel_t* level, HPSPrivTimerCtx_t* timer, EventMgrCtx_t* mgr) {
+    unsigned int rate = Profile_timestampRate();
+    unsigned int clock;
+    stressHeading(level);
+    histClear(&sgiHist);
+    histClear(&timerHist);
+    histClear(&eventHist);
+    HPS_IRQ_resetStats();
+    //Events from 100us to 1.6ms
+    for (unsigned int evt = 0; evt < level->events; evt++) {
+        eventInfo[evt] = (StressEvent_t){ .interval = (rate / 10000) * (1 + (evt % 16)) };
+        HpsErr_t status = Event_create(mgr, EVENT_TYPE_REPEAT, eventInfo[evt].interval, &stressEventHandler, &eventInfo[evt], &events[evt]);
+        if (ERR_IS_ERROR(status)) return status;
+    }
+    //Timer and SGIs
+    HpsErr_t status = Timer_getRate(&timer->timer, 0, &clock);
+    if (ERR_IS_ERROR(status)) return status;
+    unsigned int load = (clock / level->timerRate) - 1;
+    timerPeriod = (unsigned int)(((unsigned long long)(load + 1) * rate) / clock);
+    timerStarted = false;
+    sgiCount = level->sgis;
+    for (unsigned int sgi = 0; sgi < HPS_IRQ_SGI_COUNT; sgi++) {
+        sgiPending[sgi] = false;
+    }
+    status = Timer_configure(&timer->timer, TIMER_MODE_FREERUN, 0, load);
+    if (ERR_IS_SUCCESS(status)) status = HPS_PrivateTimer_setCallback(timer, &stressTimerTick, NULL);
+    if (ERR_IS_SUCCESS(status)) status = Timer_enable(&timer->timer, 0);
+    if (ERR_IS_ERROR(status)) return status;
+    //Run the main loop for the window
+    unsigned long long start = Profile_timestamp();
+    unsigned long long window = (unsigned long long)rate * STRESS_WINDOW_MS / 1000;
+    while ((Profile_timestamp() - start) < window) {
+        Event_process(mgr);
+        ResetWDT();
+    }
+    Timer_disable(&timer->timer);
+    HPS_PrivateTimer_setCallback(timer, NULL, NULL);
+    //Missed periods from the manager's metrics
+    for (unsigned int evt = 0; evt < level->events; evt++) {
+        EventStats_t stats;
+        if (ERR_IS_SUCCESS(Event_getStats(events[evt], &stats))) {
+            eventHist.missed += stats.missed;
+        }
+        Event_destroy(events[evt]);
+    }
+    stressRow("SGI dispatch", &sgiHist);
+    stressRow("Private timer", &timerHist);
+    stressRow("Event_process", &eventHist);
+    HPS_IRQ_dumpStats();
+    return ERR_SUCCESS;
+}
+
+/*
+ * Main
+ */
+
+int main(void) {
+    HPSPrivTimerCtx_t* timer;
+    StressTimerCtx_t* evtTimer;
+    EventMgrCtx_t* mgr;
+    HPS_IRQ_initialise(false, NULL);
+    HpsErr_t status = Profile_initialise(NULL, 0);
+    if (ERR_IS_SUCCESS(status)) status = HPS_PrivateTimer_initialise(LSC_BASE_PRIV_TIM, 0, STRESS_PERIPH_CLK, &timer);
+    if (ERR_IS_SUCCESS(status)) status = stressTimerInitialise(&evtTimer);
+    if (ERR_IS_SUCCESS(status)) status = EventMgr_initialiseSized(&evtTimer->timer, STRESS_EVENT_MAX, &mgr);
+    if (ERR_IS_SUCCESS(status)) status = EventMgr_setMetrics(mgr, true);
+    for (unsigned int sgi = 0; ERR_IS_SUCCESS(status) && (sgi < HPS_IRQ_SGI_COUNT); sgi++) {
+        status = HPS_IRQ_registerHandler((HPSIRQSource)(IRQ_SGI_0 + sgi), &stressSgiHandler, NULL);
+    }
+    if (ERR_IS_ERROR(status)) {
+        printf("Stress benchmark setup failed (error %d)\n", (int)status);
+        while (1);
+    }
+    printf("IRQ Storm and Event Scaling (global timer %u Hz, %u ms per level)\n", Profile_timestampRate(), STRESS_WINDOW_MS);
+    HPS_IRQ_globalEnable(true);
+    for (unsigned int lvl = 0; lvl < STRESS_COUNT(levels); lvl++) {
+        status = stressLevel(&levels[lvl], timer, mgr);
+        if (ERR_IS_ERROR(status)) {
+            printf("Load level %u failed (error %d)\n", lvl, (int)status);
+            break;
+        }
+    }
+    HPS_IRQ_globalEnable(false);
+    printf("\nDone\n");
+    while (1) {
+        ResetWDT();
+    }
+}
@@ -0,0 +1,573 @@
+/*
+ * Memory System Benchmarks
+ * ------------------------
+ *
+ * Characterises the bandwidth and latency of each memory the
+ * HPS can reach, printing matrices of results so that the cost
+ * of placing a buffer in each memory (and of each way of moving
+ * data between them) can be compared directly.
+ *
+ * Regions measured:
+ *
+ *   OCRAM          - HOT_BSS buffer in the 64kB on-chip RAM (only if
+ *                    the scatter file has a HOT region, otherwise DDR).
+ *   DDR cached     - MEMBENCH_DDR_BASE with the normal write-back map.
+ *   DDR uncached   - The same memory through a non-cacheable alias at
+ *                    MEMBENCH_DDR_ALIAS, made by switching the alias's
+ *                    1MB section in the MMU table while measuring.
+ *   H2F bridge     - FPGA on-chip RAM over the heavyweight bridge.
+ *   LW bridge      - System ID register over the lightweight bridge
+ *                    (read only, as there is no memory on it by default).
+ *
+ * Matrices printed:
+ *
+ *   Access size    - Sequential read/write MB/s with 8, 32, 64 and
+ *                    128-bit (NEON) accesses over a span of the region.
+ *   Read stride    - 32-bit read MB/s of useful data with increasing
+ *                    strides between accesses (prefetcher and line fill
+ *                    effects).
+ *   Latency        - ns per dependent 32-bit load with each stride, as
+ *                    each address depends on the previous load.
+ *   Copy engine    - MB/s copying within the region with memcpy (CPU),
+ *                    a NEON loop, Soft_DMA and HPS_DMA.
+ *
+ * Each result is the best of MEMBENCH_RUNS runs, timed with the global
+ * timer. The span of each region is limited to MEMBENCH_SPAN, so choose
+ * a span below 32kB to see L1 rather than L2 hits in the cached region.
+ *
+ * MEMBENCH_DDR_BASE and MEMBENCH_DDR_ALIAS must be 1MB aligned sections
+ * of DDR not used by the image (the defaults are the two below the
+ * top 1MB of the first 1GB, where MMU_TTB is often placed). The alias
+ * needs the MMU table built with STARTUP_ENABLE_CACHES. Without it the
+ * MMU is off so all of DDR is uncached, and the cached row is skipped.
+ */
+
+#include "DE1SoC_Addresses/DE1SoC_Addresses.h"
+#include "HPS_DMAController/HPS_DMAController.h"
+#include "HPS_IRQ/HPS_IRQ.h"
+#include "Soft_DMAController/Soft_DMAController.h"
+#include "Util/dma_buffer.h"
+#include "Util/fpga_bridge.h"
+#include "Util/lowlevel_arm.h"
+#include "Util/macros.h"
+#include "Util/profile.h"
+#include "Util/watchdog.h"
+#include "Util/hwlib/alt_cache.h"
+#include "Util/hwlib/alt_mmu.h"
+
+#ifdef __ARRIA10__
+#include "Util/hwlib/a10/socal/hps.h"
+#else
+#include "Util/hwlib/cv/socal/hps.h"
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+// DDR section measured, and the section used as its uncached alias (1MB each)
+#ifndef MEMBENCH_DDR_BASE
+#define MEMBENCH_DDR_BASE   0x3FD00000U
+#endif
+#ifndef MEMBENCH_DDR_ALIAS
+#define MEMBENCH_DDR_ALIAS  0x3FE00000U
+#endif
+#define MEMBENCH_DDR_SIZE   0x00100000U
+
+// FPGA memory measured over the H2F bridge, and register over the LW bridge
+#ifndef MEMBENCH_H2F_BASE
+#define MEMBENCH_H2F_BASE   LSC_BASE_FPGA_OCRAM
+#define MEMBENCH_H2F_SIZE   LSC_SIZE_FPGA_OCRAM
+#endif
+#ifndef MEMBENCH_LW_BASE
+#define MEMBENCH_LW_BASE    LSC_BASE_SYSTEM_ID
+#define MEMBENCH_LW_SIZE    0x8
+#endif
+
+// OCRAM buffer size
+#define MEMBENCH_OCRAM_SIZE 0x8000
+
+// Largest span of each region used for sequential accesses
+#ifndef MEMBENCH_SPAN
+#define MEMBENCH_SPAN       0x80000
+#endif
+
+// Number of times each measurement is repeated (best is kept)
+#define MEMBENCH_RUNS       8
+
+// Number of accesses in each stride and latency measurement
+#define MEMBENCH_ACCESSES   8192
+
+#define MEMBENCH_COUNT(arr) (sizeof(arr)/sizeof((arr)[0]))
+
+static unsigned char ocramBuf[MEMBENCH_OCRAM_SIZE] HOT_BSS __attribute__((aligned(64)));
+
+// Always zero, but unknown to the compiler so that loads can be chained
+static volatile uint32_t benchZero = 0;
+static volatile uint32_t benchSink;
+
+/*
+ * Regions
+ */
+
+typedef struct {
+    const char* name;
+    uintptr_t base;         // CPU address
+    uintptr_t dmaBase;      // Address as seen by the DMA controller
+    size_t size;            // Power of two
+    bool readOnly;
+    HpsErr_t status;        // Error if not available
+} MemRegion_t;
+
+enum {
+    MEMBENCH_OCRAM,
+    MEMBENCH_DDR_CACHED,
+    MEMBENCH_DDR_UNCACHED,
+    MEMBENCH_H2F,
+    MEMBENCH_LW,
+    MEMBENCH_REGIONS
+};
+
+static MemRegion_t regions[MEMBENCH_REGIONS] = {
+    [MEMBENCH_OCRAM]        = {"OCRAM",        0, 0, MEMBENCH_OCRAM_SIZE, false, ERR_SUCCESS},
+    [MEMBENCH_DDR_CACHED]   = {"DDR cached",   MEMBENCH_DDR_BASE,  MEMBENCH_DDR_BASE, MEMBENCH_DDR_SIZE, false, ERR_SUCCESS},
+    [MEMBENCH_DDR_UNCACHED] = {"DDR uncached", MEMBENCH_DDR_ALIAS, MEMBENCH_DDR_BASE, MEMBENCH_DDR_SIZE, false, ERR_SUCCESS},
+    [MEMBENCH_H2F]          = {"H2F bridge",   (uintptr_t)MEMBENCH_H2F_BASE, (uintptr_t)MEMBENCH_H2F_BASE, MEMBENCH_H2F_SIZE, false, ERR_SUCCESS},
+    [MEMBENCH_LW]           = {"LW bridge",    (uintptr_t)MEMBENCH_LW_BASE,  (uintptr_t)MEMBENCH_LW_BASE,  MEMBENCH_LW_SIZE,  true,  ERR_SUCCESS}
+};
+
+// Span of the region used for sequential accesses
+static size_t memSpan(const MemRegion_t* region) {
+    return min(region->size, (size_t)MEMBENCH_SPAN);
+}
+
+/*
+ * Uncached DDR Alias
+ *
+ * The startup code maps all of DDR write-back. The alias section is
+ * remapped to the physical address of MEMBENCH_DDR_BASE as normal
+ * non-cacheable memory, so both rows measure the same DRAM.
+ */
+
+static volatile uint32_t* aliasEntry = NULL;
+static uint32_t aliasSaved;
+
+static void memTlbFlush(void) {
+    __DSB();
+    __SET_SYSREG(SYSREG_COPROC, TLBIALL, SYSREG_TLBIALL_CLEAR);
+    __SET_SYSREG(SYSREG_COPROC, BPIALL,  SYSREG_BPIALL_CLEAR );
+    __DSB();
+    __ISB();
+}
+
+static HpsErr_t memAliasCreate(void) {
+    unsigned int sctlr = __GET_SYSREG(SYSREG_COPROC, SCTLR);
+    if (!(sctlr & _BV(SYSREG_SCTLR_BIT_M))) {
+        //MMU off, so DDR is already uncached. Use it directly.
+        regions[MEMBENCH_DDR_UNCACHED].base = MEMBENCH_DDR_BASE;
+        return ERR_NOTREADY;
+    }
+    volatile uint32_t* ttb1 = (uint32_t*)(__GET_SYSREG(SYSREG_COPROC, TTBR0) & ~(ALT_MMU_TTB1_SIZE - 1));
+    volatile uint32_t* entry = &ttb1[MEMBENCH_DDR_ALIAS >> 20];
+    uint32_t desc = *entry;
+    //Only a flat section map can be aliased
+    if ((desc & 0x3) != 0x2) return ERR_NOSUPPORT;
+    //Write back anything cached from the section before it is seen uncached
+    alt_cache_system_purge((void*)MEMBENCH_DDR_BASE, MEMBENCH_DDR_SIZE);
+    aliasSaved = desc;
+    aliasEntry = entry;
+    desc &= ~(ALT_MMU_TTB1_SECTION_BASE_ADDR_MASK | ALT_MMU_TTB1_SECTION_TEX_MASK |
+              ALT_MMU_TTB1_SECTION_C_MASK | ALT_MMU_TTB1_SECTION_B_MASK);
+    desc |= ALT_MMU_TTB1_SECTION_BASE_ADDR_SET(MEMBENCH_DDR_BASE >> 20) |
+            ALT_MMU_TTB1_SECTION_TEX_SET(ALT_MMU_ATTR_NC >> 4);
+    *entry = desc;
+    alt_cache_system_clean((void*)entry, sizeof(*entry));
+    memTlbFlush();
+    return ERR_SUCCESS;
+}
+
+static void memAliasRestore(void) {
+    if (!aliasEntry) return;
+    *aliasEntry = aliasSaved;
+    alt_cache_system_clean((void*)aliasEntry, sizeof(*aliasEntry));
+    memTlbFlush();
+    aliasEntry = NULL;
+}
+
+/*
+ * Access Kernels
+ *
+ * Each performs count accesses of the region, starting from the base,
+ * and stepping by stride bytes wrapped by mask.
+ */
+
+typedef void (*MemKernel_t)(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count);
+
+static void memRead8(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uint32_t acc = 0;
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        acc += *(volatile uint8_t*)(base + off);
+        off = (off + stride) & mask;
+    }
+    benchSink = acc;
+}
+
+static void memRead32(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uint32_t acc = 0;
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        acc += *(volatile uint32_t*)(base + off);
+        off = (off + stride) & mask;
+    }
+    benchSink = acc;
+}
+
+static void memRead64(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uint64_t acc = 0;
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        acc += *(volatile uint64_t*)(base + off);
+        off = (off + stride) & mask;
+    }
+    benchSink = (uint32_t)acc;
+}
+
+static void memWrite8(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        *(volatile uint8_t*)(base + off) = (uint8_t)idx;
+        off = (off + stride) & mask;
+    }
+}
+
+static void memWrite32(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        *(volatile uint32_t*)(base + off) = idx;
+        off = (off + stride) & mask;
+    }
+}
+
+static void memWrite64(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        *(volatile uint64_t*)(base + off) = idx;
+        off = (off + stride) & mask;
+    }
+}
+
+#if defined(__ARM_NEON)
+static void memRead128(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uint32x4_t acc = vdupq_n_u32(0);
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        acc = veorq_u32(acc, vld1q_u32((const uint32_t*)(base + off)));
+        off = (off + stride) & mask;
+    }
+    benchSink = vgetq_lane_u32(acc, 0);
+}
+
+static void memWrite128(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uint32x4_t val = vdupq_n_u32(benchZero);
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        vst1q_u32((uint32_t*)(base + off), val);
+        off = (off + stride) & mask;
+    }
+}
+#endif
+
+// Dependent loads, so each must complete before the next address is known
+static void memLatency(uintptr_t base, uintptr_t mask, unsigned int stride, unsigned int count) {
+    uint32_t zero = benchZero;
+    uintptr_t off = 0;
+    for (unsigned int idx = 0; idx < count; idx++) {
+        uint32_t val = *(volatile uint32_t*)(base + off);
+        off = (off + stride + (val & zero)) & mask;
+    }
+}
+
+/*
+ * Copy Engines
+ */
+
+typedef struct {
+    HPSDmaCtx_t* hpsDma;
+    SoftDmaCtx_t* softDma;
+} MemEngines_t;
+
+typedef HpsErr_t (*MemCopy_t)(MemEngines_t* eng, const MemRegion_t* region, size_t len);
+
+static HpsErr_t memCopyCpu(MemEngines_t* eng, const MemRegion_t* region, size_t len) {
+    memcpy((void*)(region->base + len), (const void*)region->base, len);
+    return ERR_SUCCESS;
+}
+
+static HpsErr_t memCopyNeon(MemEngines_t* eng, const MemRegion_t* region, size_t len) {
+#if defined(__ARM_NEON)
+    const uint32_t* src = (const uint32_t*)region->base;
+    uint32_t* dest = (uint32_t*)(region->base + len);
+    //Four quad words (one cache line) at a time
+    for (size_t idx = 0; idx < len / sizeof(uint32_t); idx += 16) {
+        uint32x4_t q0 = vld1q_u32(&src[idx +  0]);
+        uint32x4_t q1 = vld1q_u32(&src[idx +  4]);
+        uint32x4_t q2 = vld1q_u32(&src[idx +  8]);
+        uint32x4_t q3 = vld1q_u32(&src[idx + 12]);
+        vst1q_u32(&dest[idx +  0], q0);
+        vst1q_u32(&dest[idx +  4], q1);
+        vst1q_u32(&dest[idx +  8], q2);
+        vst1q_u32(&dest[idx + 12], q3);
+    }
+    return ERR_SUCCESS;
+#else
+    return ERR_NOSUPPORT;
+#endif
+}
+
+// Perform a copy with a DMA controller, waiting for completion
+static HpsErr_t memDmaCopy(DmaCtx_t* dma, uintptr_t dest, uintptr_t src, size_t len) {
+    DmaChunk_t xfer = {
+        .readAddr  = src,
+        .writeAddr = dest,
+        .length    = len,
+        .isLast    = true,
+        .index     = 0,
+        .params    = NULL
+    };
+    HpsErr_t status = DmaBuffer_setupTransfer(dma, &xfer, true);
+    if (status == ERR_SKIPPED) return ERR_SUCCESS;
+    if (ERR_IS_ERROR(status)) return status;
+    do {
+        status = DmaBuffer_transferDone(dma, &xfer);
+    } while (status == ERR_BUSY);
+    return status;
+}
+
+// Soft_DMA copies with the CPU, so uses the CPU addresses
+static HpsErr_t memCopySoftDma(MemEngines_t* eng, const MemRegion_t* region, size_t len) {
+    if (!eng->softDma) return ERR_NOINIT;
+    return memDmaCopy(&eng->softDma->dma, region->base + len, region->base, len);
+}
+
+static HpsErr_t memCopyHpsDma(MemEngines_t* eng, const MemRegion_t* region, size_t len) {
+    if (!eng->hpsDma) return ERR_NOINIT;
+    return memDmaCopy(&eng->hpsDma->dma, region->dmaBase + len, region->dmaBase, len);
+}
+
+/*
+ * Measurement
+ */
+
+static double memSeconds(uint64_t ticks) {
+    return (double)ticks / (double)Profile_timestampRate();
+}
+
+// Best time of a kernel in seconds
+static double memTimeKernel(MemKernel_t kernel, const MemRegion_t* region, size_t span, unsigned int stride, unsigned int count) {
+    uint64_t best = UINT64_MAX;
+    for (unsigned int run = 0; run < MEMBENCH_RUNS; run++) {
+        uint64_t start = Profile_timestamp();
+        kernel(region->base, span - 1, stride, count);
+        uint64_t ticks = Profile_timestamp() - start;
+        if (ticks < best) best = ticks;
+        ResetWDT();
+    }
+    return memSeconds(best);
+}
+
+// Best time of a copy in seconds, or negative if it failed
+static double memTimeCopy(MemCopy_t copy, MemEngines_t* eng, const MemRegion_t* region, size_t len) {
+    uint64_t best = UINT64_MAX;
+    for (unsigned int run = 0; run < MEMBENCH_RUNS; run++) {
+        uint64_t start = Profile_timestamp();
+        HpsErr_t status = copy(eng, region, len);
+        uint64_t ticks = Profile_timestamp() - start;
+        if (ERR_IS_ERROR(status)) return -1.0;
+        if (ticks < best) best = ticks;
+        ResetWDT();
+    }
+    return memSeconds(best);
+}
+
+/*
+ * Result Matrix
+ */
+
+// Print the matrix heading
+static void memHeading(const char* title, const char* units, const char* const* cols, unsigned int numCols) {
+    printf("\n%s (%s)\n", title, units);
+    printf("%-14s", "Region");
+    for (unsigned int col = 0; col < numCols; col++) {
+        printf(" %9s", cols[col]);
+    }
+    printf("\n");
+}
+
+// Print the start of a row, returning false if the region is unavailable
+static bool memRowStart(const MemRegion_t* region) {
+    printf("%-14s", region->name);
+    if (ERR_IS_ERROR(region->status)) {
+        printf(" skipped (error %d)\n", (int)region->status);
+        return false;
+    }
+    return true;
+}
+
+// Print a cell. Negative values are not measured.
+static void memCell(double value) {
+    if (value < 0) {
+        printf(" %9s", "-");
+    } else {
+        printf(" %9.1f", value);
+    }
+}
+
+/*
+ * Benchmarks
+ */
+
+static void benchAccessSize(void) {
+    static const char* const cols[] = {"rd8", "rd32", "rd64", "rd128", "wr8", "wr32", "wr64", "wr128"};
+    static const unsigned int widths[] = {1, 4, 8, 16};
+    static const MemKernel_t reads[] = {
+        &memRead8, &memRead32, &memRead64,
+#if defined(__ARM_NEON)
+        &memRead128
+#else
+        NULL
+#endif
+    };
+    static const MemKernel_t writes[] = {
+        &memWrite8, &memWrite32, &memWrite64,
+#if defined(__ARM_NEON)
+        &memWrite128
+#else
+        NULL
+#endif
+    };
+    memHeading("Sequential access size", "MB/s", cols, MEMBENCH_COUNT(cols));
+    for (unsigned int reg = 0; reg < MEMBENCH_REGIONS; reg++) {
+        const MemRegion_t* region = &regions[reg];
+        if (!memRowStart(region)) continue;
+        size_t span = memSpan(region);
+        for (unsigned int dir = 0; dir < 2; dir++) {
+            const MemKernel_t* kernels = dir ? writes : reads;
+            for (unsigned int wid = 0; wid < MEMBENCH_COUNT(widths); wid++) {
+                if (!kernels[wid] || (dir && region->readOnly) || (widths[wid] > span)) {
+                    memCell(-1.0);
+                    continue;
+                }
+                unsigned int count = span / widths[wid];
+                double seconds = memTimeKernel(kernels[wid], region, span, widths[wid], count);
+                memCell(span / seconds / 1e6);
+            }
+        }
+        printf("\n");
+    }
+}
+
+static const unsigned int strides[] = {4, 16, 32, 64, 256, 4096, 4160};
+static const char* const strideCols[] = {"4B", "16B", "32B", "64B", "256B", "4kB", "4kB+64"};
+
+static void benchStride(void) {
+    memHeading("32-bit read stride", "MB/s", strideCols, MEMBENCH_COUNT(strideCols));
+    for (unsigned int reg = 0; reg < MEMBENCH_REGIONS; reg++) {
+        const MemRegion_t* region = &regions[reg];
+        if (!memRowStart(region)) continue;
+        size_t span = memSpan(region);
+        for (unsigned int str = 0; str < MEMBENCH_COUNT(strides); str++) {
+            double seconds = memTimeKernel(&memRead32, region, span, strides[str], MEMBENCH_ACCESSES);
+            memCell(MEMBENCH_ACCESSES * sizeof(uint32_t) / seconds / 1e6);
+        }
+        printf("\n");
+    }
+}
+
+static void benchLatency(void) {
+    memHeading("Dependent load latency", "ns", strideCols, MEMBENCH_COUNT(strideCols));
+    for (unsigned int reg = 0; reg < MEMBENCH_REGIONS; reg++) {
+        const MemRegion_t* region = &regions[reg];
+        if (!memRowStart(region)) continue;
+        size_t span = memSpan(region);
+        for (unsigned int str = 0; str < MEMBENCH_COUNT(strides); str++) {
+            double seconds = memTimeKernel(&memLatency, region, span, strides[str], MEMBENCH_ACCESSES);
+            memCell(seconds * 1e9 / MEMBENCH_ACCESSES);
+        }
+        printf("\n");
+    }
+}
+
+static void benchCopy(MemEngines_t* eng) {
+    static const char* const cols[] = {"memcpy", "NEON", "Soft_DMA", "HPS_DMA"};
+    static const MemCopy_t copies[] = {&memCopyCpu, &memCopyNeon, &memCopySoftDma, &memCopyHpsDma};
+    memHeading("Copy engine", "MB/s", cols, MEMBENCH_COUNT(cols));
+    for (unsigned int reg = 0; reg < MEMBENCH_REGIONS; reg++) {
+        const MemRegion_t* region = &regions[reg];
+        if (!memRowStart(region)) continue;
+        //Copy the first half of the span onto the second
+        size_t len = memSpan(region) / 2;
+        for (unsigned int idx = 0; idx < MEMBENCH_COUNT(copies); idx++) {
+            if (region->readOnly) {
+                memCell(-1.0);
+                continue;
+            }
+            double seconds = memTimeCopy(copies[idx], eng, region, len);
+            memCell((seconds > 0) ? (len / seconds / 1e6) : -1.0);
+        }
+        printf("\n");
+    }
+}
+
+/*
+ * Main
+ */
+
+int main(void) {
+    MemEngines_t eng = {NULL, NULL};
+    HPS_IRQ_initialise(false, NULL);
+    HpsErr_t status = Profile_initialise(NULL, 0);
+    if (ERR_IS_ERROR(status)) {
+        printf("Profiling unavailable (error %d)\n", (int)status);
+        while (1);
+    }
+    printf("Memory Benchmarks (global timer %u Hz, span %u bytes)\n", Profile_timestampRate(), (unsigned int)MEMBENCH_SPAN);
+    //Regions
+    regions[MEMBENCH_OCRAM].base = (uintptr_t)ocramBuf;
+    regions[MEMBENCH_OCRAM].dmaBase = (uintptr_t)ocramBuf;
+    if (!alt_cache_l1_data_is_enabled()) {
+        regions[MEMBENCH_DDR_CACHED].status = ERR_NOTREADY;
+    }
+    status = memAliasCreate();
+    if (ERR_IS_ERROR(status) && (status != ERR_NOTREADY)) {
+        regions[MEMBENCH_DDR_UNCACHED].status = status;
+    }
+    status = FpgaBridge_enable(FPGA_BRIDGE_H2F | FPGA_BRIDGE_LWH2F);
+    if (ERR_IS_ERROR(status)) {
+        regions[MEMBENCH_H2F].status = status;
+        regions[MEMBENCH_LW].status = status;
+    }
+    //Copy engines
+    status = HPS_DMA_initialise(ALT_DMASECURE_ADDR, HPS_DMA_BURSTSIZE_8BYTE, NULL, &eng.hpsDma);
+    if (ERR_IS_ERROR(status)) {
+        printf("HPS_DMA unavailable (error %d)\n", (int)status);
+        eng.hpsDma = NULL;
+    }
+    status = Soft_DMA_initialise(SOFT_DMA_WORDSIZE_32BIT | SOFT_DMA_COPY_BURST, MEMBENCH_SPAN / 4, NULL, NULL, &eng.softDma);
+    if (ERR_IS_ERROR(status)) {
+        printf("Soft_DMA unavailable (error %d)\n", (int)status);
+        eng.softDma = NULL;
+    }
+    benchAccessSize();
+    benchStride();
+    benchLatency();
+    benchCopy(&eng);
+    memAliasRestore();
+    printf("\nDone\n");
+    while (1) {
+        ResetWDT();
+    }
+}
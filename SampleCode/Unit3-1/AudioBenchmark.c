@@ -14,4 +14,20 @@ if (space > 0) {
     // Output tone to left and right channels.
     WM8731_writeSample(audioCtx, audio_sample, audio_sample);
     /******* And Here *******/
-}
\ No newline at end of file
+}
+
+//Table driven alternative using the oscillator from Util/dsp.h, for comparison.
+//Set up once before the loop with:  DSP_ncoInit(&nco, freq, sampleRate, ampl_q31);
+//The phase is kept as a 32-bit fraction of a cycle, so wraps for free.
+if (space > 0) {
+
+    /******* Time Code Execution Between Here *******/
+    q31_t tone;
+    //Calculate next sample of the output tone from the interpolated sine table.
+    DSP_ncoQ31(&nco, &tone, 1);
+    //Convert from Q31 to a 24-bit codec sample.
+    audio_sample = tone >> 8;
+    // Output tone to left and right channels.
+    WM8731_writeSample(audioCtx, audio_sample, audio_sample);
+    /******* And Here *******/
+}
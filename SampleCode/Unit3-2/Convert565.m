@@ -1,10 +1,25 @@
 %Converts Image to RGB565 C file. Make sure image correct size.
-function Convert565(inputFileName, variableName)
+%Pass format as 'rle' to generate a run-length encoded image for the
+%DE1SoC_LT24Image driver, rather than a raw pixel array. Pass 'rlebin'
+%to write the encoded image to a binary file for DE1SoC_LT24ImageFile.
+function Convert565(inputFileName, variableName, format)
+    if (nargin < 3)
+        format = 'raw';
+    end
     A = imread( inputFileName );
     h = double(A)/255; %Convert from 0-255 to 0-1
     rgb565=uint16( 2048*uint16(h(:,:,1)*31) + ...
                      32*uint16(h(:,:,2)*63) + ...
                         uint16(h(:,:,3)*31))';
+    if strcmp(format, 'rle') || strcmp(format, 'rlebin')
+        rgb565 = EncodeRle565(rgb565(:), size(A,2), size(A,1));
+    end
+    if strcmp(format, 'rlebin')
+        fd=fopen([variableName '.bin'],'w');
+        fwrite(fd, rgb565, 'uint16', 'ieee-le');
+        fclose(fd);
+        return;
+    end
     arraySize = numel(rgb565);
     fd=fopen([variableName '.c'],'wt');
     fprintf(fd,['const unsigned short ' variableName ' [%d]={'],arraySize );
@@ -18,4 +33,49 @@ function Convert565(inputFileName, variableName)
     end
     fprintf(fd,' 0x%04X\n};\n',rgb565(end));
     fclose(fd);
-end
\ No newline at end of file
+end
+
+%Run-length encode pixels in the DE1SoC_LT24Image format.
+%Repeated colours become run packets, everything else literal packets.
+function data = EncodeRle565(pixels, width, height)
+    maxCount = 32768;
+    numPixels = numel(pixels);
+    data = zeros(1, 3 + 2*numPixels, 'uint16');
+    data(1:3) = [hex2dec('524C') width height];
+    len = 3;
+    litStart = 1;
+    idx = 1;
+    while (idx <= numPixels)
+        %Length of run of the current colour
+        runEnd = idx;
+        while ((runEnd < numPixels) && (pixels(runEnd+1) == pixels(idx)) && (runEnd - idx + 1 < maxCount))
+            runEnd = runEnd + 1;
+        end
+        runLen = runEnd - idx + 1;
+        if ((runLen >= 2) || (idx - litStart >= maxCount))
+            %Flush any pending literal pixels first
+            [data, len] = AddLiteral(data, len, pixels, litStart, idx - 1);
+            litStart = idx;
+        end
+        if (runLen >= 2)
+            data(len+1:len+2) = [uint16(32768 + runLen - 1) pixels(idx)];
+            len = len + 2;
+            idx = runEnd + 1;
+            litStart = idx;
+        else
+            idx = idx + 1;
+        end
+    end
+    [data, len] = AddLiteral(data, len, pixels, litStart, numPixels);
+    data = data(1:len);
+end
+
+%Append a literal packet for pixels(first:last), if there are any.
+function [data, len] = AddLiteral(data, len, pixels, first, last)
+    count = last - first + 1;
+    if (count > 0)
+        data(len+1) = uint16(count - 1);
+        data(len+2:len+1+count) = pixels(first:last);
+        len = len + 1 + count;
+    end
+end
@@ -0,0 +1,70 @@
+%Resolves a PC sampling profile from the HPS_PCProfile driver to functions.
+%dumpFile is a text file holding the output of PCProfile_dump(), and elfFile
+%is the image (.axf) which was running. Prints the top functions by number
+%of samples (20 by default), and returns all of them as a table.
+%Each bin is counted in the function containing its start address, so use
+%small bins (binShift of 2 to 4) for short functions.
+function result = ResolvePCProfile(dumpFile, elfFile, top)
+    if (nargin < 3)
+        top = 20;
+    end
+    %Read the profile
+    dump = fileread(dumpFile);
+    header = regexp(dump, 'PCProfile samples (\d+) outside (\d+) bin (\d+)', 'tokens', 'once');
+    if isempty(header)
+        error('No PCProfile dump found in %s', dumpFile);
+    end
+    total = str2double(header{1});
+    outside = str2double(header{2});
+    binSize = str2double(header{3});
+    bins = regexp(dump, '0x([0-9a-fA-F]+) (\d+)', 'tokens');
+    binAddr = cellfun(@(t) hex2dec(t{1}), bins);
+    binCount = cellfun(@(t) str2double(t{2}), bins);
+    %Read the function symbols with readelf
+    [funcAddr, funcSize, funcName] = ReadFunctions(elfFile);
+    %Count the samples in each function
+    counts = zeros(size(funcAddr));
+    unknown = 0;
+    for idx = 1:numel(binAddr)
+        func = find(funcAddr <= binAddr(idx), 1, 'last');
+        if ~isempty(func) && (binAddr(idx) < funcAddr(func) + max(funcSize(func), binSize))
+            counts(func) = counts(func) + binCount(idx);
+        else
+            unknown = unknown + binCount(idx);
+        end
+    end
+    %Sort by samples
+    [counts, order] = sort(counts, 'descend');
+    keep = counts > 0;
+    result = table(funcName(order(keep)), counts(keep), 100 * counts(keep) / max(total, 1), ...
+                   'VariableNames', {'Function', 'Samples', 'Percent'});
+    fprintf('%d samples, %d outside code regions, %d not in a function\n', total, outside, unknown);
+    fprintf('%8s %7s  %s\n', 'Samples', '%', 'Function');
+    for idx = 1:min(top, height(result))
+        fprintf('%8d %6.2f%%  %s\n', result.Samples(idx), result.Percent(idx), result.Function{idx});
+    end
+end
+
+%Read the function symbols of an ELF file, sorted by address.
+%Uses readelf from Tools/ImageGen on Windows, otherwise from the path.
+function [funcAddr, funcSize, funcName] = ReadFunctions(elfFile)
+    readelf = fullfile(fileparts(mfilename('fullpath')), '..', 'ImageGen', 'readelf.exe');
+    if ~ispc || ~isfile(readelf)
+        readelf = 'readelf';
+    end
+    [status, symbols] = system(['"' readelf '" -sW "' elfFile '"']);
+    if (status ~= 0)
+        error('readelf failed: %s', symbols);
+    end
+    funcs = regexp(symbols, '\d+:\s+([0-9a-fA-F]+)\s+(\d+)\s+FUNC\s+\S+\s+\S+\s+\S+\s+(\S+)', 'tokens');
+    %Clear the Thumb bit from addresses
+    funcAddr = cellfun(@(t) hex2dec(t{1}), funcs);
+    funcAddr = funcAddr - mod(funcAddr, 2);
+    funcSize = cellfun(@(t) str2double(t{2}), funcs);
+    funcName = cellfun(@(t) t{3}, funcs, 'UniformOutput', false);
+    [funcAddr, order] = sort(funcAddr(:));
+    funcSize = funcSize(order);
+    funcSize = funcSize(:);
+    funcName = funcName(order);
+    funcName = funcName(:);
+end